@@ -33,6 +33,18 @@ class Capture {
       : logger_{&logger}, severity_{severity}, category_{category}, data_type_{dataType}, location_{location} {
   }
 
+  /**
+     Initializes a new instance of the Capture class for a message that is replayed, e.g. by a sink that sends messages
+     after they were logged. The message is not sent to a logger when the instance is destroyed.
+     @param severity The severity.
+     @param category The category.
+     @param dataType Type of the data.
+     @param location The file location the log message is coming from.
+  */
+  Capture(logging::Severity severity, const char* category, logging::DataType dataType, const CodeLocation& location)
+      : logger_{nullptr}, severity_{severity}, category_{category}, data_type_{dataType}, location_{location} {
+  }
+
   /**
      The stream that can capture the message via operator<<.
      @returns Output stream.
@@ -20,16 +20,18 @@ struct OrtArenaCfg {
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
                   initial_growth_chunk_size_bytes(-1),
-                  max_power_of_two_extend_bytes(-1) {}
+                  max_power_of_two_extend_bytes(-1),
+                  small_block_cache_bytes(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
               int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
-              int64_t max_power_of_two_extend_bytes)
+              int64_t max_power_of_two_extend_bytes, int64_t small_block_cache_bytes = -1)
       : max_mem(max_mem),
         arena_extend_strategy(arena_extend_strategy),
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
         initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
-        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes) {}
+        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes),
+        small_block_cache_bytes(small_block_cache_bytes) {}
 
   size_t max_mem;                         // use 0 to allow ORT to choose the default
   int arena_extend_strategy;              // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
@@ -37,6 +39,7 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  int64_t small_block_cache_bytes;        // use -1 to allow ORT to choose the default (disabled), 0 = disabled
 };
 
 namespace onnxruntime {
@@ -91,6 +94,16 @@ class IAllocator {
   // By default, the base implementation  just calls Alloc().
   virtual void* Reserve(size_t size) { return Alloc(size); }
 
+  // Device allocators that order their allocations on a stream, like the CUDA memory pool allocator, can return
+  // true here to be given the stream through AllocOnStream. Allocations made through it may only be used on that
+  // stream until ReleaseStreamBuffers is called for it at the end of the run.
+  // BFC arenas are handled separately through StreamAwareArena.
+  virtual bool IsStreamAware() const { return false; }
+
+  virtual void* AllocOnStream(size_t size, Stream* /*stream*/) { return Alloc(size); }
+
+  virtual void ReleaseStreamBuffers(Stream* /*stream*/) {}
+
   const OrtMemoryInfo& Info() const { return memory_info_; };
 
   // Each implementation of IAllocator can override and provide their own implementation
@@ -6,6 +6,7 @@
 #include <string_view>
 
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -106,7 +107,7 @@ class KernelRegistry {
   static bool VerifyKernelDef(const Node& node, const KernelDef& kernel_def,
                               const IKernelTypeStrResolver* kernel_type_str_resolver,
                               const TypeConstraintMap* type_constraints,
-                              std::string& error_str);
+                              std::string* error_str);
 
   static std::string GetMapKey(std::string_view op_name, std::string_view domain, std::string_view provider) {
     std::string key(op_name);
@@ -121,5 +122,10 @@ class KernelRegistry {
   // Kernel create function map from op name to kernel creation info.
   // key is opname+domain_name+provider_name
   KernelCreateMap kernel_creator_fn_map_;
+
+  // Kernels matched by TryFindKernel with a kernel type string resolver, keyed by the map key, the since version of
+  // the node and the types of its arguments. Registries are shared by sessions that are created concurrently.
+  mutable OrtMutex kernel_lookup_cache_mutex_;
+  mutable InlinedHashMap<std::string, const KernelCreateInfo*> kernel_lookup_cache_;
 };
 }  // namespace onnxruntime
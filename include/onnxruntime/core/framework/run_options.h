@@ -13,6 +13,7 @@
 namespace onnxruntime {
 namespace lora {
 class LoraAdapter;
+class LoraAdapterCache;
 }
 }  // namespace onnxruntime
 
@@ -50,6 +51,9 @@ struct OrtRunOptions {
 
   onnxruntime::InlinedVector<const onnxruntime::lora::LoraAdapter*> active_adapters;
 
+  // When set, the active adapters are fed from the device copies in this cache.
+  onnxruntime::lora::LoraAdapterCache* lora_adapter_cache = nullptr;
+
   OrtRunOptions() = default;
   ~OrtRunOptions() = default;
 };
@@ -635,6 +635,10 @@ class Node {
   // Node::ToProto when running onnx::check_node in the first Graph::Resolve. At that point we know all the nodes are
   // unchanged from the original model.
   const ONNX_NAMESPACE::NodeProto* original_node_proto_ = nullptr;
+
+  // Hash of the inputs, outputs and attributes of the node after its last type and shape inferencing in
+  // Graph::Resolve. Inferencing is skipped while the hash matches as it would give the same result. 0 if none.
+  size_t inference_signature_ = 0;
 #endif
 
   // Execution priority, lower value for higher priority
@@ -53,6 +53,7 @@
 #include "core/platform/ort_mutex.h"
 #include "core/platform/ort_spin_lock.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -78,6 +79,11 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   With ThreadOptions::adaptive_spinning each worker instead sizes
+//   its spin budget from how long it has recently waited for work:
+//   the budget is halved each time the worker waited long enough to
+//   block after spinning in vain, and doubled when work arrives close
+//   to the end of the budget or shortly after the worker blocked.
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -222,14 +228,15 @@ class ThreadPoolProfiler {
   ThreadPoolProfiler(int, const CHAR_TYPE*) {};
   ~ThreadPoolProfiler() = default;
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
-  void Start() {};
-  std::string Stop() { return "not available for minimal build"; }
+  void Start(bool) {};
+  std::string Stop(std::vector<ThreadPoolTaskSpan>*) { return "not available for minimal build"; }
   void LogStart() {};
   void LogEnd(ThreadPoolEvent){};
   void LogEndAndStart(ThreadPoolEvent){};
   void LogStartAndCoreAndBlock(std::ptrdiff_t){};
   void LogCoreAndBlock(std::ptrdiff_t){};
   void LogThreadId(int) {};
+  void LogTaskStart(int) {};
   void LogRun(int) {};
   std::string DumpChildThreadStat() { return {}; }
 };
@@ -248,14 +255,15 @@ class ThreadPoolProfiler {
   ~ThreadPoolProfiler();
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
   using Clock = std::chrono::high_resolution_clock;
-  void Start();                  // called by executor to start profiling
-  std::string Stop();            // called by executor to stop profiling and return collected numbers
+  void Start(bool record_task_spans);                            // called by executor to start profiling
+  std::string Stop(std::vector<ThreadPoolTaskSpan>* task_spans);  // called by executor to stop profiling and return collected numbers
   void LogStart();               // called in main thread to record the starting time point
   void LogEnd(ThreadPoolEvent);  // called in main thread to calculate and save the time elapsed from last start point
   void LogEndAndStart(ThreadPoolEvent);
   void LogStartAndCoreAndBlock(std::ptrdiff_t block_size);
   void LogCoreAndBlock(std::ptrdiff_t block_size);  // called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 // called in child thread to log its id
+  void LogTaskStart(int thread_idx);                // called in child thread before running a task
   void LogRun(int thread_idx);                      // called in child thread to log num of run
   std::string DumpChildThreadStat();                // return all child statitics collected so far
 
@@ -286,12 +294,17 @@ class ThreadPoolProfiler {
     uint64_t num_run_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  // core that the child thread is running on
+    onnxruntime::TimePoint task_start_;
   };
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif  // _MSC_VER
   std::vector<ChildThreadStat> child_thread_stats_;
   std::string thread_pool_name_;
+  // the tasks of the child threads, only recorded between Start(true) and Stop(...)
+  std::atomic<bool> record_task_spans_{false};
+  OrtMutex task_spans_mutex_;
+  std::vector<ThreadPoolTaskSpan> task_spans_;
 };
 #endif
 
@@ -316,10 +329,13 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
   // RunInParallelSection returns.
   //
   // The parameter idx provides a loop-local thread ID in the range
-  // [0,k) where k<=n.
+  // [0,k) where k<=n.  fn must be able to complete the whole loop
+  // from idx 0 alone, since low priority loops may be run with less
+  // parallelism than requested (see ThreadPool::ScopedLoopBudget).
   virtual void RunInParallelSection(ThreadPoolParallelSection& ps,
                                     std::function<void(unsigned idx)> fn,
-                                    unsigned n, std::ptrdiff_t block_size) = 0;
+                                    unsigned n, std::ptrdiff_t block_size,
+                                    ThreadPool::LoopPriority priority) = 0;
 
   // Special case alternative to RunInParallelSection for use without
   // an existing parallel section.  Ideally we would use a single
@@ -336,9 +352,11 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
   // [ Note that this 20% overhead is more than paid for when we have
   // two loops execute in series in a parallel section. ]
   virtual void RunInParallel(std::function<void(unsigned idx)> fn,
-                             unsigned n, std::ptrdiff_t block_size) = 0;
-  virtual void StartProfiling() = 0;
-  virtual std::string StopProfiling() = 0;
+                             unsigned n, std::ptrdiff_t block_size,
+                             ThreadPool::LoopPriority priority) = 0;
+  virtual void GetStats(ThreadPoolStats& stats) const = 0;
+  virtual void StartProfiling(bool record_task_spans) = 0;
+  virtual std::string StopProfiling(std::vector<ThreadPoolTaskSpan>* task_spans) = 0;
 };
 
 class ThreadPoolParallelSection {
@@ -722,12 +740,29 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   }
 
  public:
-  void StartProfiling() override {
-    profiler_.Start();
+  void GetStats(ThreadPoolStats& stats) const override {
+    stats.workers.resize(num_threads_);
+    for (unsigned i = 0; i < num_threads_; ++i) {
+      const WorkerData& td = worker_data_[i];
+      ThreadPoolWorkerStats& worker = stats.workers[i];
+      worker.tasks_run = td.counters.tasks_run.load(std::memory_order_relaxed);
+      worker.tasks_stolen = td.counters.tasks_stolen.load(std::memory_order_relaxed);
+      worker.run_ns = td.counters.run_ns.load(std::memory_order_relaxed);
+      worker.spin_ns = td.counters.spin_ns.load(std::memory_order_relaxed);
+      worker.blocked_ns = td.counters.blocked_ns.load(std::memory_order_relaxed);
+      worker.queue_depth = td.queue.Size();
+    }
+    stats.parallel_loops = parallel_loops_.load(std::memory_order_relaxed);
+    stats.loop_dispatch_ns = loop_dispatch_ns_.load(std::memory_order_relaxed);
+    stats.loop_wait_ns = loop_wait_ns_.load(std::memory_order_relaxed);
+  }
+
+  void StartProfiling(bool record_task_spans) override {
+    profiler_.Start(record_task_spans);
   }
 
-  std::string StopProfiling() override {
-    return profiler_.Stop();
+  std::string StopProfiling(std::vector<ThreadPoolTaskSpan>* task_spans) override {
+    return profiler_.Stop(task_spans);
   }
 
   struct Tag {
@@ -773,6 +808,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(thread_options.adaptive_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -1233,6 +1269,42 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
+  // Tracks the high priority loops running in the pool for the lifetime
+  // of the object.  While any is running, low priority loops are
+  // reduced to the calling thread so that the workers stay available
+  // to the high priority one.  This is safe because the work items of
+  // a loop claim iterations dynamically, so the loop completes even if
+  // only work item 0 runs.
+  class HighPriorityLoopScope {
+   public:
+    HighPriorityLoopScope(ThreadPoolTempl& pool, ThreadPool::LoopPriority priority)
+        : pool_(pool), priority_(priority) {
+      if (priority_ == ThreadPool::LoopPriority::kHigh) {
+        pool_.active_high_priority_loops_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    ~HighPriorityLoopScope() {
+      if (priority_ == ThreadPool::LoopPriority::kHigh) {
+        pool_.active_high_priority_loops_.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+
+    unsigned AdjustDegreeOfParallelism(unsigned n) const {
+      if (priority_ == ThreadPool::LoopPriority::kLow &&
+          pool_.active_high_priority_loops_.load(std::memory_order_relaxed) > 0) {
+        return 1;
+      }
+      return n;
+    }
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HighPriorityLoopScope);
+
+   private:
+    ThreadPoolTempl& pool_;
+    const ThreadPool::LoopPriority priority_;
+  };
+
   // Run a single parallel loop in an existing parallel section.  This
   // maps directly onto SummonWorkers to create sufficient worker
   // threads for the desired degree of parallelism, followed by
@@ -1240,12 +1312,15 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   void RunInParallelSection(ThreadPoolParallelSection& ps,
                             std::function<void(unsigned idx)> fn,
                             unsigned n,
-                            std::ptrdiff_t block_size) override {
+                            std::ptrdiff_t block_size,
+                            ThreadPool::LoopPriority priority) override {
     ORT_ENFORCE(n <= num_threads_ + 1, "More work items than threads");
     profiler_.LogStartAndCoreAndBlock(block_size);
     PerThread* pt = GetPerThread();
     assert(pt->leading_par_section && "RunInParallel, but not in parallel section");
     assert((n > 1) && "Trivial parallel section; should be avoided by caller");
+    HighPriorityLoopScope high_priority_scope(*this, priority);
+    n = high_priority_scope.AdjustDegreeOfParallelism(n);
 
     // Publish the work to any existing workers in the parallel
     // section, and ensure it is visible to any new threads created
@@ -1270,13 +1345,16 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         }
       }
     };
+    const uint64_t dispatch_start = NowNs();
     RunInParallelInternal(*pt, ps, n, false, std::move(worker_fn));
     assert(ps.dispatch_q_idx == -1);
     profiler_.LogEndAndStart(ThreadPoolProfiler::DISTRIBUTION);
+    const uint64_t run_start = NowNs();
 
     // Run work in the main thread
     loop.fn(0);
     profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
+    const uint64_t wait_start = NowNs();
 
     // Wait for workers to exit the loop
     ps.current_loop = 0;
@@ -1284,6 +1362,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       onnxruntime::concurrency::SpinPause();
     }
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    CountParallelLoop(run_start - dispatch_start, NowNs() - wait_start);
   }
 
   // Run a single parallel loop _without_ a parallel section.  This is a
@@ -1298,18 +1377,30 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   //  2. run fn(...) itself.
   // For all other threads:
   //  1. run fn(...);
-  void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) override {
+  void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size,
+                     ThreadPool::LoopPriority priority) override {
     ORT_ENFORCE(n <= num_threads_ + 1, "More work items than threads");
+    HighPriorityLoopScope high_priority_scope(*this, priority);
+    const unsigned requested_n = n;
+    n = high_priority_scope.AdjustDegreeOfParallelism(n);
+    if (n < requested_n && n == 1) {
+      fn(0);
+      return;
+    }
     profiler_.LogStartAndCoreAndBlock(block_size);
+    const uint64_t dispatch_start = NowNs();
     PerThread* pt = GetPerThread();
     ThreadPoolParallelSection ps;
     StartParallelSectionInternal(*pt, ps);
     RunInParallelInternal(*pt, ps, n, true, fn);  // select dispatcher and do job distribution;
     profiler_.LogEndAndStart(ThreadPoolProfiler::DISTRIBUTION);
+    const uint64_t run_start = NowNs();
     fn(0);  // run fn(0)
     profiler_.LogEndAndStart(ThreadPoolProfiler::RUN);
+    const uint64_t wait_start = NowNs();
     EndParallelSectionInternal(*pt, ps);  // wait for all
     profiler_.LogEnd(ThreadPoolProfiler::WAIT);
+    CountParallelLoop(run_start - dispatch_start, NowNs() - wait_start);
   }
 
   int NumThreads() const final {
@@ -1483,20 +1574,52 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       status.store(ThreadStatus::Spinning, std::memory_order_relaxed);
     }
 
+    // Counters of the work loop, only updated by the thread itself. See GetStats.
+    struct Counters {
+      std::atomic<uint64_t> tasks_run{0};
+      std::atomic<uint64_t> tasks_stolen{0};
+      std::atomic<uint64_t> run_ns{0};
+      std::atomic<uint64_t> spin_ns{0};
+      std::atomic<uint64_t> blocked_ns{0};
+
+      // there is a single writer, so this avoids the cost of an atomic read-modify-write
+      static void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+      }
+    };
+    Counters counters;
+
    private:
     std::atomic<ThreadStatus> status{ThreadStatus::Spinning};
     OrtMutex mutex;
     OrtCondVar cv;
   };
 
+  static uint64_t NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+  }
+
+  void CountParallelLoop(uint64_t dispatch_ns, uint64_t wait_ns) {
+    parallel_loops_.fetch_add(1, std::memory_order_relaxed);
+    loop_dispatch_ns_.fetch_add(dispatch_ns, std::memory_order_relaxed);
+    loop_wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+  }
+
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
+  std::atomic<int> active_high_priority_loops_{0};
   std::atomic<bool> done_;
+  std::atomic<uint64_t> parallel_loops_{0};
+  std::atomic<uint64_t> loop_dispatch_ns_{0};
+  std::atomic<uint64_t> loop_wait_ns_{0};
 
   // SpinLoopStatus indicates whether the main worker spinning (inner) loop should exit immediately when there is
   // no work available (kIdle) or whether it should follow the configured spin-then-block policy (kBusy).
@@ -1536,29 +1659,55 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     const int spin_count = allow_spinning_ ? (1ull << log2_spin) : 0;
     const int steal_count = spin_count / 100;
 
+    // The spin budget of this worker, between min_spin_count and spin_count with adaptive spinning
+    constexpr int log2_min_spin = 14;
+    const int min_spin_count = adaptive_spinning_ ? std::min(spin_count, 1 << log2_min_spin) : spin_count;
+    int current_spin_count = spin_count;
+    uint64_t spin_ns_per_iteration = 0;
+
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
 
+    auto& counters = td.counters;
+
     while (!should_exit) {
       Task t = q.PopFront();
+      bool stolen = false;
       if (!t) {
         // Spin waiting for work.
-        for (int i = 0; i < spin_count && !done_; i++) {
-          if (((i + 1) % steal_count == 0)) {
+        const uint64_t spin_start = current_spin_count > 0 ? NowNs() : 0;
+        int spins = 0;
+        bool spin_stopped = false;
+        for (; spins < current_spin_count && !done_; spins++) {
+          if (((spins + 1) % steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
+            stolen = static_cast<bool>(t);
           } else {
             t = q.PopFront();
           }
           if (t) break;
 
           if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
+            spin_stopped = true;
             break;
           }
           onnxruntime::concurrency::SpinPause();
         }
+        if (current_spin_count > 0) {
+          const uint64_t spin_ns = NowNs() - spin_start;
+          WorkerData::Counters::Add(counters.spin_ns, spin_ns);
+          if (adaptive_spinning_ && spins > 0) {
+            spin_ns_per_iteration = std::max<uint64_t>(spin_ns / static_cast<uint64_t>(spins), 1);
+          }
+        }
+        if (adaptive_spinning_ && t && spins > current_spin_count / 2) {
+          // the work arrived late in the spin budget, allow waiting longer next time
+          current_spin_count = std::min(spin_count, current_spin_count * 2);
+        }
 
         // Attempt to block
         if (!t) {
+          const uint64_t block_start = NowNs();
           td.SetBlocked(  // Pre-block test
               [&]() -> bool {
                 bool should_block = true;
@@ -1615,17 +1764,39 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
               [&]() {
                 blocked_--;
               });
+          const uint64_t blocked_ns = NowNs() - block_start;
+          WorkerData::Counters::Add(counters.blocked_ns, blocked_ns);
+          if (adaptive_spinning_ && !spin_stopped && spin_ns_per_iteration > 0) {
+            // Spinning is only worth its CPU time when it bridges the wait. If work came within another budget's
+            // worth of spinning, spin longer. Otherwise the wait is too long to bridge, so back off.
+            const uint64_t budget_ns = static_cast<uint64_t>(current_spin_count) * spin_ns_per_iteration;
+            if (blocked_ns < budget_ns) {
+              current_spin_count = std::min(spin_count, current_spin_count * 2);
+            } else {
+              current_spin_count = std::max(min_spin_count, current_spin_count / 2);
+            }
+          }
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
           if (!t) t = q.PopFront();
-          if (!t) t = Steal(StealAttemptKind::TRY_ALL);
+          if (!t) {
+            t = Steal(StealAttemptKind::TRY_ALL);
+            stolen = static_cast<bool>(t);
+          }
         }
       }
 
       if (t) {
         td.SetActive();
+        profiler_.LogTaskStart(thread_id);
+        const uint64_t run_start = NowNs();
         t();
+        WorkerData::Counters::Add(counters.run_ns, NowNs() - run_start);
+        WorkerData::Counters::Add(counters.tasks_run, 1);
+        if (stolen) {
+          WorkerData::Counters::Add(counters.tasks_stolen, 1);
+        }
         profiler_.LogRun(thread_id);
         td.SetSpinning();
       }
@@ -132,10 +132,46 @@ namespace concurrency {
 template <typename Environment>
 class ThreadPoolTempl;
 
+class AdaptiveCostModel;
 class ExtendedThreadPoolInterface;
 class LoopCounter;
 class ThreadPoolParallelSection;
 
+// A task run by a worker thread of the pool while task spans were being recorded.
+// See ThreadPool::StartProfiling.
+struct ThreadPoolTaskSpan {
+  unsigned thread_id;  // logging::GetThreadId() of the worker thread
+  TimePoint start;
+  TimePoint end;
+};
+
+// Counters of a worker thread of the pool, accumulated since the pool was created.
+struct ThreadPoolWorkerStats {
+  uint64_t tasks_run = 0;
+  // the tasks among tasks_run that the worker took from the queue of another worker
+  uint64_t tasks_stolen = 0;
+  uint64_t run_ns = 0;
+  // time spent spinning while waiting for work, see kOrtSessionOptionsConfigAllowIntraOpSpinning
+  uint64_t spin_ns = 0;
+  // time spent blocked while waiting for work
+  uint64_t blocked_ns = 0;
+  // the number of tasks in the queue of the worker when the stats were read
+  uint64_t queue_depth = 0;
+};
+
+// Counters of a thread pool, accumulated since it was created. See ThreadPool::GetStats.
+struct ThreadPoolStats {
+  std::vector<ThreadPoolWorkerStats> workers;
+  // the loops handed out to the workers, by ParallelFor and in parallel sections
+  uint64_t parallel_loops = 0;
+  // time the threads running the loops spent handing them out to the workers
+  uint64_t loop_dispatch_ns = 0;
+  // time the threads running the loops spent waiting for the workers to finish them
+  uint64_t loop_wait_ns = 0;
+
+  std::string ToJson() const;
+};
+
 class ThreadPool {
  public:
 #ifdef _WIN32
@@ -362,9 +398,43 @@ class ThreadPool {
 
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ThreadPool);
 
+  // Scheduling priority of the parallel loops started by a thread, see ScopedLoopBudget.
+  enum class LoopPriority {
+    kLow,
+    kNormal,
+    kHigh,
+  };
+
+  // Restricts the parallel loops started by the calling thread, on any thread pool, for the lifetime of the object.
+  // This is how a Run() sharing the intra-op pool with other concurrent runs gets its own budget:
+  //
+  // - max_degree_of_parallelism caps the degree of parallelism of each loop, including the calling thread.
+  //   0 means no cap, 1 runs all loops on the calling thread.
+  //
+  // - While a kHigh priority loop runs in a pool, kLow priority loops started in the same pool do not recruit
+  //   worker threads and run on their calling thread only.
+  //
+  // Loops started from other threads, e.g. by the inter-op pool in parallel execution mode, are not affected.
+  class ScopedLoopBudget {
+   public:
+    ScopedLoopBudget(int max_degree_of_parallelism, LoopPriority priority);
+    ~ScopedLoopBudget();
+
+   private:
+    int prev_max_degree_of_parallelism_;
+    LoopPriority prev_priority_;
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScopedLoopBudget);
+  };
+
+  // Returns the counters of the pool. They are always collected, and can be read at any time from any thread.
+  // The stats are empty if tp is null or runs everything on the calling thread.
+  static ThreadPoolStats GetStats(const concurrency::ThreadPool* tp);
+
   // StartProfiling and StopProfiling are not to be consumed as public-facing API
-  static void StartProfiling(concurrency::ThreadPool* tp);
-  static std::string StopProfiling(concurrency::ThreadPool* tp);
+  // If record_task_spans is true, the tasks run by the worker threads until StopProfiling are returned in task_spans.
+  static void StartProfiling(concurrency::ThreadPool* tp, bool record_task_spans = false);
+  static std::string StopProfiling(concurrency::ThreadPool* tp, std::vector<ThreadPoolTaskSpan>* task_spans = nullptr);
 
  private:
   friend class LoopCounter;
@@ -411,9 +481,9 @@ class ThreadPool {
 
   void Schedule(std::function<void()> fn);
 
-  void StartProfiling();
+  void StartProfiling(bool record_task_spans);
 
-  std::string StopProfiling();
+  std::string StopProfiling(std::vector<ThreadPoolTaskSpan>* task_spans);
 
   ThreadOptions thread_options_;
 
@@ -428,6 +498,9 @@ class ThreadPool {
 
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
+
+  // Measured per call site costs used by ParallelFor, only created if ThreadOptions::adaptive_cost_model is set.
+  std::unique_ptr<AdaptiveCostModel> adaptive_cost_model_;
 };
 
 }  // namespace concurrency
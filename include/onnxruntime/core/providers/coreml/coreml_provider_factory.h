@@ -36,9 +36,15 @@ enum COREMLFlags {
   // there are four compute units:
   // MLComputeUnitsCPUAndNeuralEngine|MLComputeUnitsCPUAndGPU|MLComputeUnitsCPUOnly|MLComputeUnitsAll
   COREML_FLAG_USE_CPU_AND_GPU = 0x020,
+
+  // Keep the compiled CoreML models in the caches directory of the user, and reuse them in the sessions created by
+  // later launches of the application instead of compiling the models again. A compiled model is looked up by a hash
+  // of the CoreML model created for the partition and the OS version.
+  COREML_FLAG_ENABLE_MODEL_CACHE = 0x040,
+
   // Keep COREML_FLAG_LAST at the end of the enum definition
   // And assign the last COREMLFlag to it
-  COREML_FLAG_LAST = COREML_FLAG_USE_CPU_AND_GPU,
+  COREML_FLAG_LAST = COREML_FLAG_ENABLE_MODEL_CACHE,
 };
 
 #ifdef __cplusplus
@@ -40,4 +40,7 @@ struct OrtCUDAProviderOptionsV2 {
   int use_tf32 = 1;                                                                                            // use TF32
   int fuse_conv_bias = 0;                                                                                      // Enable CUDNN Frontend kernel fusing, results in JIT compiles
   int sdpa_kernel = 0;                                                                                         // Scaled Dot Product Attention kernel option
+  int use_pinned_staging_for_host_copies = 0;                                                                  // stage stream copies from pageable host memory in pooled pinned memory
+  int use_cuda_mempool = 0;                                                                                    // allocate from a CUDA memory pool instead of the BFC Arena
+  size_t cuda_mempool_release_threshold = 0;                                                                   // bytes of free memory the CUDA memory pool keeps when a stream synchronizes
 };
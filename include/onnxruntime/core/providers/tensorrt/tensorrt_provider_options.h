@@ -75,7 +75,8 @@ struct OrtTensorRTProviderOptionsV2 {
   const char* trt_ep_context_file_path{nullptr};    // Specify file name to dump EP context node model. Can be a path or a file name or a file name with path.
   int trt_ep_context_embed_mode{0};                 // Specify EP context embed mode. Default 0 = context is engine cache path, 1 = context is engine binary data
   int trt_weight_stripped_engine_enable{0};         // Enable weight-stripped engine build. Default 0 = false,
-                                                    // nonzero = true
+                                                    // nonzero = true. Only the weight-stripped engine is cached,
+                                                    // it is refitted with the ONNX weights every time it is loaded
   const char* trt_onnx_model_folder_path{nullptr};  // Folder path relative to the current working directory for
                                                     // the ONNX model containing the weights (applicable only when
                                                     // the "trt_weight_stripped_engine_enable" option is enabled)
@@ -88,4 +89,7 @@ struct OrtTensorRTProviderOptionsV2 {
 
   const char* trt_engine_cache_prefix{nullptr};  // specify engine cache prefix
   int trt_engine_hw_compatible{0};               // Enable hardware compatibility. Default 0 = false, nonzero = true
+  int trt_widen_profile_ranges{0};               // Widen the dynamic dimensions of a rebuilt engine's profile to the
+                                                 // enclosing power of 2 range, so that nearby input shapes don't
+                                                 // trigger more rebuilds. Default 0 = false, nonzero = true
 };
@@ -305,6 +305,9 @@ ORT_RUNTIME_CLASS(OpAttr);
 ORT_RUNTIME_CLASS(Logger);
 ORT_RUNTIME_CLASS(ShapeInferContext);
 ORT_RUNTIME_CLASS(LoraAdapter);
+ORT_RUNTIME_CLASS(LoraAdapterCache);
+ORT_RUNTIME_CLASS(RunContext);
+ORT_RUNTIME_CLASS(SessionPipeline);
 
 #ifdef _WIN32
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -2805,6 +2808,9 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "small_block_cache_bytes": Size of a pool reserved up front for allocations of up to 4KB.
+   *  Such allocations are served from per size-class lock-free free lists without taking the arena lock,
+   *  and fall back to the arena once the pool is exhausted. Use 0 or -1 to disable (the default).
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -3567,6 +3573,10 @@ struct OrtApi {
    * \param[in] output_count Number of outputs
    * \param[out] ort_op Operator that has been created
    *
+   * An operator created with the same execution provider, name, domain, version, type constraints, attributes and
+   * numbers of inputs and outputs as one that has not been released yet shares its kernel, which is only constructed
+   * once. Each one must still be released with OrtApi::ReleaseOp.
+   *
    * \since Version 1.12.
    */
   ORT_API2_STATUS(CreateOp,
@@ -4751,6 +4761,338 @@ struct OrtApi {
    */
   ORT_API2_STATUS(SetEpDynamicOptions, _Inout_ OrtSession* sess, _In_reads_(kv_len) const char* const* keys,
                   _In_reads_(kv_len) const char* const* values, _In_ size_t kv_len);
+
+  /// @}
+  /// \name OrtValue
+  /// @{
+
+  /** \brief Set all strings at once in a string tensor from a contiguous buffer and an offsets array
+   *
+   * The layout matches the Apache Arrow large_string (int64 offsets) layout, so a string column can be handed over
+   * without building an array of null terminated strings first.
+   * String i is the byte range [offsets[i], offsets[i + 1]) in \p data. Strings do not have to be null terminated.
+   *
+   * An example:<br>
+   * Given \p data is "Thisisatest" and \p offsets is { 0, 4, 6, 7, 11 }<br>
+   * The tensor will contain the strings { "This" "is" "a" "test" }
+   *
+   * \param[in,out] value A tensor of type ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING
+   * \param[in] data Buffer holding the bytes of all strings back to back
+   * \param[in] data_len Number of bytes in \p data
+   * \param[in] offsets Array of monotonically increasing offsets into \p data. offsets[0] must be 0.
+   * \param[in] offsets_len Number of elements in \p offsets. Must be the size of \p value's tensor shape plus one.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(FillStringTensorFromOffsets, _Inout_ OrtValue* value, _In_reads_bytes_(data_len) const void* data,
+                  size_t data_len, _In_reads_(offsets_len) const int64_t* offsets, size_t offsets_len);
+
+  /** \brief Create an OrtLoraAdapter that stacks the parameters of several adapters
+   *
+   * Every parameter of the new adapter has a new leading dimension of size \p num_adapters and holds the parameters
+   * of the same name of \p adapters, in order. It is meant for models that serve many adapters in one batch with
+   * the com.microsoft.BatchedLoRA operator, where an adapter_indices model input selects the adapter of each row.
+   * The new adapter is activated with OrtApi::RunOptionsAddActiveLoraAdapter as any other adapter.
+   *
+   * All adapters must have the same parameter names, and a parameter must have the same shape and type in all of
+   * them. The data is copied, so \p adapters can be released afterwards.
+   *
+   * \param[in] adapters Array of OrtLoraAdapter instances created with OrtApi::CreateLoraAdapter or FromArray.
+   * \param[in] num_adapters Number of elements in \p adapters. Must be at least 1.
+   * \param[in] allocator optional pointer to a device allocator. If specified the stacked data is copied to the
+   *            device. If nullptr, data stays on CPU.
+   * \param[out] out A pointer to a newly created OrtLoraAdapter instance. Must be released with
+   *                  OrtApi::ReleaseLoraAdapter.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(CreateStackedLoraAdapter, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                  size_t num_adapters, _In_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** out);
+
+  /** \brief Create an OrtLoraAdapterCache
+   *
+   * The cache keeps device copies of the parameters of the most recently used adapters, so that activating an
+   * adapter that is already cached costs no copy. Once the copies exceed \p capacity_bytes, the least recently used
+   * adapters are evicted. Device copies that adapters made on creation are shared and not accounted for.
+   * A copy that is in use by a Run() stays valid until the Run() returns, even if it is evicted.
+   *
+   * \param[in] allocator Device allocator the copies are made with. Required.
+   * \param[in] capacity_bytes Total size of the device copies above which adapters are evicted.
+   * \param[out] out A pointer to a newly created OrtLoraAdapterCache instance. Must be released with
+   *                  OrtApi::ReleaseLoraAdapterCache.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(CreateLoraAdapterCache, _In_ OrtAllocator* allocator, size_t capacity_bytes,
+                  _Outptr_ OrtLoraAdapterCache** out);
+
+  /** \brief Release an ::OrtLoraAdapterCache obtained from OrtApi::CreateLoraAdapterCache
+   *
+   * \since Version 1.21.
+   */
+  ORT_CLASS_RELEASE(LoraAdapterCache);
+
+  /** \brief Start copying an adapter to the device ahead of its use
+   *
+   * The copy is made on a thread of the cache and the function returns immediately. A Run() that needs the adapter
+   * before the copy is done waits for it. The adapter must not be released until the copy is done, i.e. until a
+   * Run() used it or the cache is released.
+   *
+   * \param[in] cache OrtLoraAdapterCache instance
+   * \param[in] adapter OrtLoraAdapter instance
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(LoraAdapterCachePrefetch, _Inout_ OrtLoraAdapterCache* cache, _In_ const OrtLoraAdapter* adapter);
+
+  /** \brief Feed the active adapters of the Run() calls from an OrtLoraAdapterCache
+   *
+   * Adapters that are not cached yet are copied to the device on the first Run() that uses them.
+   * The cache must outlive the Run() calls that use \p options. Pass nullptr to stop using a cache.
+   *
+   * \param[in] options OrtRunOptions instance
+   * \param[in] cache OrtLoraAdapterCache instance or nullptr
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(RunOptionsSetLoraAdapterCache, _Inout_ OrtRunOptions* options, _In_opt_ OrtLoraAdapterCache* cache);
+
+  /** \brief Get the kernel latency statistics of the session
+   *
+   * The statistics are collected when the session option "session.node_latency_sampling_interval" is set, and
+   * can be read at any time, including while other threads call Run(). The result is a JSON array with one object
+   * per op type and execution provider, with the fields "op_type", "provider", "count", "mean_us", "p50_us",
+   * "p90_us", "p99_us" and "max_us". It is empty if the statistics are disabled.
+   *
+   * \param[in] session OrtSession instance
+   * \param[in] allocator Allocator used to allocate the returned string
+   * \param[out] out Null terminated JSON string. Must be freed with \p allocator
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(SessionGetNodeLatencyStats, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the counters of the thread pools used by the session
+   *
+   * The counters are always collected and accumulate from the creation of the thread pools. They can be read at
+   * any time, including while other threads call Run(). Pools shared through the environment report the work of
+   * all the sessions that use them.
+   *
+   * The result is a JSON object with the fields "intra_op" and "inter_op", each with the fields:
+   * - "parallel_loops": the number of loops handed out to the worker threads.
+   * - "loop_dispatch_us" and "loop_wait_us": the time the threads running the loops spent handing them out to the
+   *   workers and waiting for the workers to finish them.
+   * - "workers": an array with one object per worker thread, with the fields "tasks_run", "tasks_stolen",
+   *   "run_us", "spin_us", "blocked_us" and "queue_depth".
+   *
+   * The workers array is empty for a pool that runs everything on the calling thread, or that is not used.
+   *
+   * \param[in] session OrtSession instance
+   * \param[in] allocator Allocator used to allocate the returned string
+   * \param[out] out Null terminated JSON string. Must be freed with \p allocator
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(SessionGetThreadPoolStats, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Create an ::OrtRunContext for repeated runs with the same inputs and outputs
+   *
+   * The names are resolved once, here, so OrtApi::RunWithContext skips the name lookups and the allocations
+   * OrtApi::Run makes on every call. Inputs and outputs are then bound by their index in \p input_names and
+   * \p output_names. This is meant for small models, where these are a measurable part of the latency.
+   *
+   * An ::OrtRunContext can be used by one run at a time. Create one per thread to run concurrently.
+   *
+   * \param[in] session OrtSession instance, it must outlive the ::OrtRunContext
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input_len Number of elements in the input_names array
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names array
+   * \param[out] out Newly created ::OrtRunContext. Must be freed with OrtApi::ReleaseRunContext
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(CreateRunContext, _In_ OrtSession* session,
+                  _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Outptr_ OrtRunContext** out);
+
+  /** \brief Release an ::OrtRunContext obtained from OrtApi::CreateRunContext
+   *
+   * \since Version 1.21.
+   */
+  ORT_CLASS_RELEASE(RunContext);
+
+  /** \brief Bind an input of an ::OrtRunContext
+   *
+   * The value is used by every run with the context until it is replaced by another call. The context keeps a
+   * reference to \p value, so it is fine to release \p value after the call, but not to modify its data while a
+   * run uses it.
+   *
+   * \param[in] run_context OrtRunContext instance
+   * \param[in] index Index of the input in the input names the context was created with
+   * \param[in] value OrtValue instance
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(RunContextBindInput, _Inout_ OrtRunContext* run_context, size_t index,
+                  _In_ const OrtValue* value);
+
+  /** \brief Bind an output of an ::OrtRunContext to a pre-allocated value
+   *
+   * Every run with the context writes the output to \p value. Outputs that are not bound are allocated by each run.
+   *
+   * \param[in] run_context OrtRunContext instance
+   * \param[in] index Index of the output in the output names the context was created with
+   * \param[in] value Pre-allocated OrtValue instance
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(RunContextBindOutput, _Inout_ OrtRunContext* run_context, size_t index,
+                  _In_ const OrtValue* value);
+
+  /** \brief Get an output of the last run with an ::OrtRunContext
+   *
+   * \param[in] run_context OrtRunContext instance
+   * \param[in] index Index of the output in the output names the context was created with
+   * \param[out] out The output, owned by the context. It stays valid until the next run with the context or until
+   *                  the context is released. Use OrtApi::RunContextBindOutput to keep outputs across runs.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(RunContextGetOutput, _In_ const OrtRunContext* run_context, size_t index,
+                  _Outptr_ const OrtValue** out);
+
+  /** \brief Run the model with the inputs and outputs bound to an ::OrtRunContext
+   *
+   * \param[in] session OrtSession instance the context was created with
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+   * \param[in] run_context OrtRunContext instance, all of its inputs must be bound
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(RunWithContext, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _Inout_ OrtRunContext* run_context);
+
+  /** \brief Warm up the session before it serves requests
+   *
+   * Runs the model once with zero filled inputs and discards the outputs. The lazy initialization of the first run is
+   * done by this run, e.g. the arenas are extended to its peak, the weights are prepacked, the execution providers
+   * search their algorithms and compile their graphs, so that the first request doesn't pay for it.
+   *
+   * The inputs without a shape here use the shapes that the session recorded in the
+   * "session.warmup_shapes_file" session config file, else their static shape in the model.
+   * As the inputs are zeros, paths of the model that depend on the input data may not be warmed up.
+   *
+   * \param[in] session
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input_shapes Array of the input shapes, input_shapes[i] has input_shape_lens[i] dimensions
+   * \param[in] input_shape_lens Array of the number of dimensions of each input shape
+   * \param[in] input_len Number of elements in the input_names, input_shapes and input_shape_lens arrays
+   * \param[in] callback If not nullptr, the warmup runs in a thread of the intra op thread pool and this function
+   *                     returns at once. The callback is called with no outputs and the status of the warmup when it
+   *                     is done. The session should not serve requests until then.
+   * \param[in] user_data User data passed to the callback
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(WarmupSession, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const int64_t* const* input_shapes,
+                  _In_reads_(input_len) const size_t* input_shape_lens, size_t input_len,
+                  _In_opt_ RunAsyncCallbackFn callback, _In_opt_ void* user_data);
+
+  /** \brief Create an ::OrtSessionPipeline that runs several sessions one after the other
+   *
+   * The outputs of a session are fed to the inputs of the later sessions linked with
+   * OrtApi::SessionPipelineLink. A linked output is allocated on the device where the consuming session reads it
+   * and is fed to it as is, so values that stay on a device are not copied from one session to the next through
+   * the host.
+   *
+   * \param[in] sessions Array of initialized OrtSession instances, in the order they are run. They must outlive the
+   *                     pipeline.
+   * \param[in] num_sessions Number of elements in the sessions array
+   * \param[out] out Must be freed by OrtApi::ReleaseSessionPipeline
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(CreateSessionPipeline, _In_reads_(num_sessions) OrtSession* const* sessions, size_t num_sessions,
+                  _Outptr_ OrtSessionPipeline** out);
+
+  ORT_CLASS_RELEASE(SessionPipeline);
+
+  /** \brief Feed an output of a session of the pipeline to an input of a later session
+   *
+   * \param[in] pipeline
+   * \param[in] from_session Index of the session that produces the output
+   * \param[in] output_name Name of the output
+   * \param[in] to_session Index of the later session that consumes the output
+   * \param[in] input_name Name of the input of to_session, it can only be linked once
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(SessionPipelineLink, _Inout_ OrtSessionPipeline* pipeline, size_t from_session,
+                  _In_ const char* output_name, size_t to_session, _In_ const char* input_name);
+
+  /** \brief Run the sessions of the pipeline
+   *
+   * Every input is fed to all the sessions with an input of that name that is not linked. Every output is taken from
+   * the last session with an output of that name, on the CPU unless the output is linked. Every session but the last
+   * synchronizes its execution providers at the end of its run, so the next session reads complete values.
+   * A pipeline can be run by one thread at a time.
+   *
+   * \param[in] pipeline
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] inputs Array of ::OrtValue%s of the input values
+   * \param[in] input_len Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names and outputs array
+   * \param[out] outputs Array of ::OrtValue%s that the outputs are stored in. Every element is set to a new
+   *                     ::OrtValue that must be freed with OrtApi::ReleaseValue.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(RunSessionPipeline, _Inout_ OrtSessionPipeline* pipeline, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Out_writes_all_(output_names_len) OrtValue** outputs);
 };
 
 /*
@@ -509,6 +509,7 @@ ORT_DEFINE_RELEASE(ThreadingOptions);
 ORT_DEFINE_RELEASE(Env);
 ORT_DEFINE_RELEASE(RunOptions);
 ORT_DEFINE_RELEASE(LoraAdapter);
+ORT_DEFINE_RELEASE(LoraAdapterCache);
 ORT_DEFINE_RELEASE(Session);
 ORT_DEFINE_RELEASE(SessionOptions);
 ORT_DEFINE_RELEASE(TensorTypeAndShapeInfo);
@@ -518,6 +519,8 @@ ORT_DEFINE_RELEASE(TypeInfo);
 ORT_DEFINE_RELEASE(Value);
 ORT_DEFINE_RELEASE(ModelMetadata);
 ORT_DEFINE_RELEASE(IoBinding);
+ORT_DEFINE_RELEASE(RunContext);
+ORT_DEFINE_RELEASE(SessionPipeline);
 ORT_DEFINE_RELEASE(ArenaCfg);
 ORT_DEFINE_RELEASE(Status);
 ORT_DEFINE_RELEASE(OpAttr);
@@ -761,6 +764,29 @@ struct LoraAdapter : detail::Base<OrtLoraAdapter> {
   ///        be copied to device if required by the model at inference time.
   static LoraAdapter CreateLoraAdapterFromArray(const void* bytes, size_t num_bytes,
                                                 OrtAllocator* allocator);
+
+  /// \brief Wraps OrtApi::CreateStackedLoraAdapter
+  ///
+  /// The function stacks the parameters of the adapters for use with the BatchedLoRA operator.
+  /// \param adapters The adapters to stack, in the order of the adapter indices
+  /// \param allocator optional pointer to a device allocator. If nullptr, the data stays on CPU.
+  static LoraAdapter CreateStackedLoraAdapter(const std::vector<LoraAdapter>& adapters,
+                                              OrtAllocator* allocator);
+};
+
+/// \brief LoraAdapterCache keeps device copies of the parameters of recently used LoraAdapters
+struct LoraAdapterCache : detail::Base<OrtLoraAdapterCache> {
+  using Base = detail::Base<OrtLoraAdapterCache>;
+  using Base::Base;
+
+  explicit LoraAdapterCache(std::nullptr_t) {}  ///< Create an empty LoraAdapterCache object, must be assigned a valid one to be used
+  /// \brief Wraps OrtApi::CreateLoraAdapterCache
+  /// \param allocator The device allocator the copies are made with
+  /// \param capacity_bytes Total size of the copies above which the least recently used adapters are evicted
+  LoraAdapterCache(OrtAllocator* allocator, size_t capacity_bytes);
+
+  /// \brief Wraps OrtApi::LoraAdapterCachePrefetch
+  LoraAdapterCache& Prefetch(const LoraAdapter& adapter);
 };
 
 /** \brief RunOptions
@@ -801,6 +827,13 @@ struct RunOptions : detail::Base<OrtRunOptions> {
    * \param adapter The LoraAdapter to be used as the active adapter
    */
   RunOptions& AddActiveLoraAdapter(const LoraAdapter& adapter);
+
+  /** \brief Feed the active adapters from the device copies in the cache.
+   *
+   * Wraps OrtApi::RunOptionsSetLoraAdapterCache
+   * \param cache The cache, it must outlive the Run() calls that use these options
+   */
+  RunOptions& SetLoraAdapterCache(LoraAdapterCache& cache);
 };
 
 namespace detail {
@@ -1029,6 +1062,7 @@ struct ModelMetadata : detail::Base<OrtModelMetadata> {
 };
 
 struct IoBinding;
+struct RunContext;
 
 namespace detail {
 
@@ -1071,6 +1105,16 @@ struct ConstSessionImpl : Base<T> {
   AllocatedStringPtr GetOverridableInitializerNameAllocated(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
 
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
+  /** \brief Returns the kernel latency statistics as JSON, see OrtApi::SessionGetNodeLatencyStats
+   *
+   * \param allocator to allocate memory for the returned string
+   */
+  AllocatedStringPtr GetNodeLatencyStatsAllocated(OrtAllocator* allocator) const;
+  /** \brief Returns the counters of the thread pools as JSON, see OrtApi::SessionGetThreadPoolStats
+   *
+   * \param allocator to allocate memory for the returned string
+   */
+  AllocatedStringPtr GetThreadPoolStatsAllocated(OrtAllocator* allocator) const;
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
@@ -1110,6 +1154,7 @@ struct SessionImpl : ConstSessionImpl<T> {
            const char* const* output_names, Value* output_values, size_t output_count);
 
   void Run(const RunOptions& run_options, const IoBinding&);  ///< Wraps OrtApi::RunWithBinding
+  void Run(const RunOptions& run_options, RunContext&);       ///< Wraps OrtApi::RunWithContext
 
   /** \brief Run the model asynchronously in a thread owned by intra op thread pool
    *
@@ -1133,6 +1178,23 @@ struct SessionImpl : ConstSessionImpl<T> {
   void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
                 const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data);
 
+  /** \brief Warm up the session with zero filled inputs before it serves requests
+   *
+   * Wraps OrtApi::WarmupSession
+   *
+   * \param[in] run_options
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input_shapes Array of the input shapes, input_shapes[i] has input_shape_lens[i] dimensions
+   * \param[in] input_shape_lens Array of the number of dimensions of each input shape
+   * \param[in] input_count Number of elements in the input_names, input_shapes and input_shape_lens arrays.
+   *                        The inputs that are not given use the recorded or the static shapes.
+   * \param[in] callback If not nullptr, the warmup is asynchronous and the callback is called when it is done
+   * \param[in] user_data User data that pass back to the callback
+   */
+  void Warmup(const RunOptions& run_options, const char* const* input_names, const int64_t* const* input_shapes,
+              const size_t* input_shape_lens, size_t input_count, RunAsyncCallbackFn callback = nullptr,
+              void* user_data = nullptr);
+
   /** \brief End profiling and return a copy of the profiling file name.
    *
    * \param allocator to allocate memory for the copy of the string returned
@@ -1552,6 +1614,16 @@ struct ValueImpl : ConstValueImpl<T> {
   /// <param name="s_len">[in] Count of strings in s (Must match the size of \p value's tensor shape)</param>
   void FillStringTensor(const char* const* s, size_t s_len);
 
+  /// <summary>
+  /// Set all strings at once in a string tensor from a contiguous buffer and an Arrow style offsets array.
+  /// String i is the byte range [offsets[i], offsets[i + 1]) of data.
+  /// </summary>
+  /// <param name="data">[in] Bytes of all strings back to back. Strings are not null terminated.</param>
+  /// <param name="data_len">[in] Number of bytes in data</param>
+  /// <param name="offsets">[in] Offsets into data, starting at 0</param>
+  /// <param name="offsets_len">[in] Number of offsets (Must be the size of \p value's tensor shape plus one)</param>
+  void FillStringTensorFromOffsets(const void* data, size_t data_len, const int64_t* offsets, size_t offsets_len);
+
   /// <summary>
   /// Set a single string in a string tensor
   /// </summary>
@@ -1916,6 +1988,39 @@ struct IoBinding : detail::IoBindingImpl<OrtIoBinding> {
   UnownedIoBinding GetUnowned() const { return UnownedIoBinding{this->p_}; }
 };
 
+/** \brief Wrapper around ::OrtRunContext, for repeated runs with the same inputs and outputs
+ *
+ * Inputs and outputs are bound by their index in the names the context is created with.
+ */
+struct RunContext : detail::Base<OrtRunContext> {
+  explicit RunContext(std::nullptr_t) {}  ///< Create an empty object, must be assigned a valid one to be used
+  /// \brief Wraps OrtApi::CreateRunContext
+  RunContext(Session& session, const char* const* input_names, size_t input_count,
+             const char* const* output_names, size_t output_count);
+
+  void BindInput(size_t index, const Value& value);   ///< Wraps OrtApi::RunContextBindInput
+  void BindOutput(size_t index, const Value& value);  ///< Wraps OrtApi::RunContextBindOutput
+  /// \brief Wraps OrtApi::RunContextGetOutput, the output is valid until the next run with the context
+  ConstValue GetOutput(size_t index) const;
+};
+
+/** \brief Wrapper around ::OrtSessionPipeline, to run several sessions with outputs linked to inputs
+ *
+ * The sessions must outlive the pipeline.
+ */
+struct SessionPipeline : detail::Base<OrtSessionPipeline> {
+  explicit SessionPipeline(std::nullptr_t) {}  ///< Create an empty object, must be assigned a valid one to be used
+  /// \brief Wraps OrtApi::CreateSessionPipeline
+  SessionPipeline(const std::vector<Session*>& sessions);
+
+  /// \brief Wraps OrtApi::SessionPipelineLink
+  void Link(size_t from_session, const char* output_name, size_t to_session, const char* input_name);
+
+  /// \brief Wraps OrtApi::RunSessionPipeline
+  std::vector<Value> Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                         size_t input_count, const char* const* output_names, size_t output_count);
+};
+
 /*! \struct Ort::ArenaCfg
  * \brief it is a structure that represents the configuration of an arena based allocator
  * \details Please see docs/C_API.md for details
@@ -2096,6 +2201,19 @@ struct Logger {
   OrtLoggingLevel cached_severity_level_{};
 };
 
+namespace detail {
+struct ScratchBufferDeleter {
+  std::shared_ptr<OrtAllocator> allocator;
+  void operator()(void* p) const;
+};
+}  // namespace detail
+
+/// <summary>
+/// A buffer allocated by KernelContext::GetScratchBuffer(), returned to its allocator when it goes out of scope.
+/// </summary>
+template <typename T>
+using ScratchBuffer = std::unique_ptr<T[], detail::ScratchBufferDeleter>;
+
 /// <summary>
 /// This class wraps a raw pointer OrtKernelContext* that is being passed
 /// to the custom kernel Compute() method. Use it to safely access context
@@ -2119,6 +2237,21 @@ struct KernelContext {
   OrtKernelContext* GetOrtKernelContext() const { return ctx_; }
   void ParallelFor(void (*fn)(void*, size_t), size_t total, size_t num_batch, void* usr_data) const;
 
+  /// <summary>
+  /// Runs fn(i) for every i in [0, total) on the intra-op thread pool of the session, in at most num_batch batches,
+  /// or without a limit when num_batch is 0. fn must not throw.
+  /// </summary>
+  template <typename Fn>
+  void ParallelFor(size_t total, size_t num_batch, Fn&& fn) const;
+
+  /// <summary>
+  /// Allocates a buffer of count elements from the allocator of the kernel for memory_info, e.g. the arena of the
+  /// session for the CPU. The buffer is returned to the allocator when the ScratchBuffer is destroyed, so it is meant
+  /// to live within the Compute() call.
+  /// </summary>
+  template <typename T>
+  ScratchBuffer<T> GetScratchBuffer(const OrtMemoryInfo& memory_info, size_t count) const;
+
  private:
   OrtKernelContext* ctx_;
 };
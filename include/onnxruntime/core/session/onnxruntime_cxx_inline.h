@@ -434,6 +434,54 @@ inline IoBinding::IoBinding(Session& session) {
   ThrowOnError(GetApi().CreateIoBinding(session, &this->p_));
 }
 
+inline RunContext::RunContext(Session& session, const char* const* input_names, size_t input_count,
+                              const char* const* output_names, size_t output_count) {
+  ThrowOnError(GetApi().CreateRunContext(session, input_names, input_count, output_names, output_count, &this->p_));
+}
+
+inline void RunContext::BindInput(size_t index, const Value& value) {
+  ThrowOnError(GetApi().RunContextBindInput(this->p_, index, value));
+}
+
+inline void RunContext::BindOutput(size_t index, const Value& value) {
+  ThrowOnError(GetApi().RunContextBindOutput(this->p_, index, value));
+}
+
+inline ConstValue RunContext::GetOutput(size_t index) const {
+  const OrtValue* out;
+  ThrowOnError(GetApi().RunContextGetOutput(this->p_, index, &out));
+  return ConstValue{out};
+}
+
+inline SessionPipeline::SessionPipeline(const std::vector<Session*>& sessions) {
+  std::vector<OrtSession*> ort_sessions;
+  ort_sessions.reserve(sessions.size());
+  for (Session* session : sessions) {
+    ort_sessions.push_back(*session);
+  }
+  ThrowOnError(GetApi().CreateSessionPipeline(ort_sessions.data(), ort_sessions.size(), &this->p_));
+}
+
+inline void SessionPipeline::Link(size_t from_session, const char* output_name, size_t to_session,
+                                  const char* input_name) {
+  ThrowOnError(GetApi().SessionPipelineLink(this->p_, from_session, output_name, to_session, input_name));
+}
+
+inline std::vector<Value> SessionPipeline::Run(const RunOptions& run_options, const char* const* input_names,
+                                               const Value* input_values, size_t input_count,
+                                               const char* const* output_names, size_t output_count) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  std::vector<Value> output_values;
+  output_values.reserve(output_count);
+  for (size_t i = 0; i < output_count; i++)
+    output_values.emplace_back(nullptr);
+  ThrowOnError(GetApi().RunSessionPipeline(this->p_, run_options, input_names,
+                                           reinterpret_cast<const OrtValue* const*>(input_values), input_count,
+                                           output_names, output_count,
+                                           reinterpret_cast<OrtValue**>(output_values.data())));
+  return output_values;
+}
+
 inline ArenaCfg::ArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes, int max_dead_bytes_per_chunk) {
   ThrowOnError(GetApi().CreateArenaCfg(max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk, &p_));
 }
@@ -571,6 +619,27 @@ inline LoraAdapter LoraAdapter::CreateLoraAdapterFromArray(const void* bytes, si
   return LoraAdapter{p};
 }
 
+inline LoraAdapter LoraAdapter::CreateStackedLoraAdapter(const std::vector<LoraAdapter>& adapters,
+                                                         OrtAllocator* allocator) {
+  std::vector<const OrtLoraAdapter*> ort_adapters;
+  ort_adapters.reserve(adapters.size());
+  for (const auto& adapter : adapters) {
+    ort_adapters.push_back(adapter);
+  }
+  OrtLoraAdapter* p;
+  ThrowOnError(GetApi().CreateStackedLoraAdapter(ort_adapters.data(), ort_adapters.size(), allocator, &p));
+  return LoraAdapter{p};
+}
+
+inline LoraAdapterCache::LoraAdapterCache(OrtAllocator* allocator, size_t capacity_bytes) {
+  ThrowOnError(GetApi().CreateLoraAdapterCache(allocator, capacity_bytes, &p_));
+}
+
+inline LoraAdapterCache& LoraAdapterCache::Prefetch(const LoraAdapter& adapter) {
+  ThrowOnError(GetApi().LoraAdapterCachePrefetch(p_, adapter));
+  return *this;
+}
+
 inline RunOptions::RunOptions() {
   ThrowOnError(GetApi().CreateRunOptions(&p_));
 }
@@ -628,6 +697,11 @@ inline RunOptions& RunOptions::AddActiveLoraAdapter(const LoraAdapter& adapter)
   return *this;
 }
 
+inline RunOptions& RunOptions::SetLoraAdapterCache(LoraAdapterCache& cache) {
+  ThrowOnError(GetApi().RunOptionsSetLoraAdapterCache(p_, cache));
+  return *this;
+}
+
 namespace detail {
 
 template <typename T>
@@ -1023,6 +1097,20 @@ inline uint64_t ConstSessionImpl<T>::GetProfilingStartTimeNs() const {
   return out;
 }
 
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetNodeLatencyStatsAllocated(OrtAllocator* allocator) const {
+  char* out;
+  ThrowOnError(GetApi().SessionGetNodeLatencyStats(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetThreadPoolStatsAllocated(OrtAllocator* allocator) const {
+  char* out;
+  ThrowOnError(GetApi().SessionGetThreadPoolStats(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
 template <typename T>
 inline ModelMetadata ConstSessionImpl<T>::GetModelMetadata() const {
   OrtModelMetadata* out;
@@ -1076,6 +1164,19 @@ inline void SessionImpl<T>::Run(const RunOptions& run_options, const IoBinding&
   ThrowOnError(GetApi().RunWithBinding(this->p_, run_options, io_binding));
 }
 
+template <typename T>
+inline void SessionImpl<T>::Run(const RunOptions& run_options, RunContext& run_context) {
+  ThrowOnError(GetApi().RunWithContext(this->p_, run_options, run_context));
+}
+
+template <typename T>
+inline void SessionImpl<T>::Warmup(const RunOptions& run_options, const char* const* input_names,
+                                   const int64_t* const* input_shapes, const size_t* input_shape_lens,
+                                   size_t input_count, RunAsyncCallbackFn callback, void* user_data) {
+  ThrowOnError(GetApi().WarmupSession(this->p_, run_options, input_names, input_shapes, input_shape_lens, input_count,
+                                      callback, user_data));
+}
+
 template <typename T>
 inline void SessionImpl<T>::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
                                      const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data) {
@@ -1475,6 +1576,12 @@ void ValueImpl<T>::FillStringTensor(const char* const* s, size_t s_len) {
   ThrowOnError(GetApi().FillStringTensor(this->p_, s, s_len));
 }
 
+template <typename T>
+void ValueImpl<T>::FillStringTensorFromOffsets(const void* data, size_t data_len,
+                                               const int64_t* offsets, size_t offsets_len) {
+  ThrowOnError(GetApi().FillStringTensorFromOffsets(this->p_, data, data_len, offsets, offsets_len));
+}
+
 template <typename T>
 void ValueImpl<T>::FillStringTensorElement(const char* s, size_t index) {
   ThrowOnError(GetApi().FillStringTensorElement(this->p_, s, index));
@@ -1756,6 +1863,32 @@ inline void KernelContext::ParallelFor(void (*fn)(void*, size_t), size_t total,
   ThrowOnError(GetApi().KernelContext_ParallelFor(ctx_, fn, total, num_batch, usr_data));
 }
 
+template <typename Fn>
+inline void KernelContext::ParallelFor(size_t total, size_t num_batch, Fn&& fn) const {
+  using FnType = std::remove_reference_t<Fn>;
+  ParallelFor([](void* usr_data, size_t ith) { (*static_cast<FnType*>(usr_data))(ith); }, total, num_batch,
+              const_cast<void*>(static_cast<const void*>(&fn)));
+}
+
+inline void detail::ScratchBufferDeleter::operator()(void* p) const {
+  if (p) {
+    allocator->Free(allocator.get(), p);
+  }
+}
+
+template <typename T>
+inline ScratchBuffer<T> KernelContext::GetScratchBuffer(const OrtMemoryInfo& memory_info, size_t count) const {
+  OrtAllocator* out = nullptr;
+  ThrowOnError(GetApi().KernelContext_GetAllocator(ctx_, &memory_info, &out));
+  std::shared_ptr<OrtAllocator> allocator(out, [](OrtAllocator* a) { GetApi().ReleaseAllocator(a); });
+
+  void* p = count ? allocator->Alloc(allocator.get(), count * sizeof(T)) : nullptr;
+  if (count && !p) {
+    ORT_CXX_API_THROW("Failed to allocate a scratch buffer", ORT_FAIL);
+  }
+  return ScratchBuffer<T>(static_cast<T*>(p), detail::ScratchBufferDeleter{std::move(allocator)});
+}
+
 inline OpAttr::OpAttr(const char* name, const void* data, int len, OrtOpAttrType type) {
   Ort::ThrowOnError(GetApi().CreateOpAttr(name, data, len, type, &p_));
 }
@@ -26,15 +26,60 @@
 // By default, the value for this key is empty (i.e.) no memory arenas are shrunk
 static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memory.enable_memory_arena_shrinkage";
 
+// Key for limiting the shrinkage requested via kOrtRunOptionsConfigEnableMemoryArenaShrinkage to the memory above a
+// high-watermark. Unused arena regions are only released, most recently added first, while the total allocated bytes
+// of the arena exceeds the watermark, which keeps enough memory around for the next run to avoid re-extending the
+// arena. Only relevant if kOrtRunOptionsConfigEnableMemoryArenaShrinkage is set.
+// The value is either a number of bytes, or "peak" to use the peak bytes in use recorded in the arena's statistics.
+// By default, the value for this key is empty (i.e.) all unused memory arena regions are released
+static const char* const kOrtRunOptionsConfigMemoryArenaShrinkageHighWatermark =
+    "memory.memory_arena_shrinkage_high_watermark";
+
 // Set to '1' to not synchronize execution providers with CPU at the end of session run.
 // Per default it will be set to '0'
 // Taking CUDA EP as an example, it omit triggering cudaStreamSynchronize on the compute stream.
 static const char* const kOrtRunOptionsConfigDisableSynchronizeExecutionProviders = "disable_synchronize_execution_providers";
 
+// Set to '1' to drop the state kept by kOrtSessionOptionsConfigStreamingState before the run, e.g. to start a new
+// stream. The state inputs then have to be fed again unless they have an initializer.
+// Per default it will be set to '0'
+static const char* const kOrtRunOptionsConfigResetStreamingState = "session.reset_streaming_state";
+
+// Cap the degree of parallelism of the intra-op thread pool loops of this run, including the thread calling Run().
+// Concurrent runs share the intra-op thread pool of the session, this keeps a large request from monopolizing it.
+// "0" means no cap, "1" runs the kernels of this run on the calling thread only.
+// Only the kernels run on the calling thread are affected, i.e. it has no effect in parallel execution mode.
+// Per default it will be set to '0'
+static const char* const kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism = "intra_op.max_degree_of_parallelism";
+
+// Priority of the intra-op thread pool loops of this run: "low", "normal" or "high".
+// While a loop of a "high" priority run is executing, loops of "low" priority runs do not use the worker threads of
+// the pool and run on their calling thread, so latency critical runs are not slowed down by bulk ones.
+// Only the kernels run on the calling thread are affected, i.e. it has no effect in parallel execution mode.
+// Per default it will be set to 'normal'
+static const char* const kOrtRunOptionsConfigIntraOpPriority = "intra_op.priority";
+
+// Split the run into this number of micro-batches that run concurrently, so that with a model partitioned over
+// several devices, e.g. a GPU and the CPU, the stages on the devices overlap instead of waiting for each other.
+// The feeds whose first dimension is the batch size, i.e. the first dimension of the first feed, are split along it,
+// the other feeds are fed whole to every micro-batch. The fetches are concatenated along their first dimension and
+// returned as CPU tensors, so they must not be pre-allocated.
+// Per default it will be set to '1', which runs the request as one batch.
+static const char* const kOrtRunOptionsConfigMicroBatchCount = "session.micro_batch_count";
+
+// Tune the TunableOps that have no result for their shapes yet during this run, for the execution providers that
+// support TunableOp. TunableOp stays enabled afterwards, so the later runs use the tuned results, and the results are
+// written to the kOrtSessionOptionsTuningResultsFile file if the session has one.
+// Tuning switches the execution providers for the whole session, so no other run should be in flight meanwhile.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtRunOptionsConfigTuningWarmup = "session.tuning_warmup";
+
 // Set HTP performance mode for QNN HTP backend before session run.
 // options for HTP performance mode: "burst", "balanced", "default", "high_performance",
 // "high_power_saver", "low_balanced", "extreme_power_saver", "low_power_saver", "power_saver",
 // "sustained_high_performance". Default to "default".
+// "auto" uses "burst" during the session run and "power_saver" post session run unless "qnn.htp_perf_mode_post_run"
+// is set, for latency sensitive runs that should not keep the HTP at a high power level while idle.
 static const char* const kOrtRunOptionsConfigQnnPerfMode = "qnn.htp_perf_mode";
 
 // Set HTP performance mode for QNN HTP backend post session run.
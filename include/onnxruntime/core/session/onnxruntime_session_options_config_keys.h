@@ -67,6 +67,39 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable the fusion of chains of float elementwise ops into FusedElementwise nodes on CPU.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsEnableElementwiseFusion = "optimization.enable_elementwise_fusion";
+
+// Enable or disable the conversion of float Conv and FusedConv nodes on CPU to NhwcFusedConv by the level 3 NHWC
+// transformer, which runs depthwise convolutions with the NHWC depthwise kernels. It applies to the convolutions
+// that the NCHWc transformer doesn't take, e.g. on platforms without NCHWc kernels such as ARM64. The other layout
+// sensitive nodes between the convolutions, e.g. float pooling, stay NCHW with transposes around them.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsEnableNhwcFloatConv = "optimization.enable_nhwc_float_conv";
+
+// Enable or disable the fusion of float8 DequantizeLinear -> MatMul/Gemm into GemmFloat8 on CUDA.
+// GemmFloat8 needs a GPU with float8 tensor cores (compute capability 8.9 or above), so this is opt-in.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsEnableQDQFloat8GemmFusion = "optimization.enable_qdq_float8_gemm_fusion";
+
+// Enable or disable running CUDA fp16/bf16 MatMul with a 2:4 structured sparse weight initializer on cuSPARSELt.
+// The weight is checked for the 2:4 pattern and compressed when the session is created, and the dense copy is
+// released. Only available in builds with cuSPARSELt (USE_CUSPARSELT), and needs an Ampere or newer GPU.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsCudaSparseMatMul = "ep.cuda.enable_sparse_matmul";
+
+// The number of experts of each CUDA MoE node kept in device memory, in builds where the MoE expert weights stay in
+// host memory (USE_CUDA_MOE_EXPERT_OFFLOAD). The experts picked by the routing are paged in with LRU replacement.
+// The default is "8".
+static const char* const kOrtSessionOptionsCudaMoEExpertCacheSize = "ep.cuda.moe_expert_cache_size";
+
+// The file where CUDA Conv persists the cuDNN frontend execution plans picked with cudnn_conv_algo_search=EXHAUSTIVE.
+// The plans in the file are loaded when the first Conv of a session is created, and plans of new convolutions are
+// added to it, so the search runs once per GPU, cuDNN version and convolution. The default is "", to keep the
+// plans in the process only.
+static const char* const kOrtSessionOptionsCudnnConvPlanCacheFile = "ep.cuda.cudnn_conv_plan_cache_file";
+
 // This setting controls whether to enable AheadOfTime function inlining.
 // AOT function inlining examines the graph and attempts to inline as many locally defined functions in the model
 // as possible with the help of enabled execution providers.
@@ -77,6 +110,27 @@ static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimizati
 // Its default value is "0".
 static const char* const kOrtSessionOptionsDisableAheadOfTimeFunctionInlining = "session.disable_aot_function_inlining";
 
+// The maximum total size in bytes of the initializers that constant folding creates and keeps in memory.
+// A node whose folded outputs don't fit in the remaining budget is left in the graph. The initializers written to
+// the file of "session.constant_folding_external_data_file" don't count. The default is "0", for no limit.
+static const char* const kOrtSessionOptionsConstantFoldingMemoryBudget =
+    "session.constant_folding_memory_budget_in_bytes";
+
+// The file where constant folding writes the data of the folded initializers of at least
+// "session.constant_folding_external_data_min_size_in_bytes" bytes, instead of keeping it in memory. The folded
+// initializers refer to the file as external data, so the session memory maps it like the other external
+// initializers. A relative path is relative to the directory of the model, or to the current directory for a model
+// loaded from bytes. The file is overwritten by each session and must stay unchanged while the session is used, so
+// sessions must not share a file. Use an absolute path if the optimized model is saved to another directory.
+// The default is "", to keep the folded initializers in memory.
+static const char* const kOrtSessionOptionsConstantFoldingExternalDataFile =
+    "session.constant_folding_external_data_file";
+
+// The minimum size in bytes of the folded initializers written to "session.constant_folding_external_data_file".
+// The default is "1024".
+static const char* const kOrtSessionOptionsConstantFoldingExternalDataMinSizeInBytes =
+    "session.constant_folding_external_data_min_size_in_bytes";
+
 #ifdef ENABLE_TRAINING
 // Specifies a path of the file containing a list of memory optimization configurations.
 // The value should be a string indicating the file path of the config file.
@@ -88,7 +142,8 @@ static const char* const kOrtSessionOptionsDisableAheadOfTimeFunctionInlining =
 // Taking the example of "Gelu+Cast+:1:0",
 // > "Gelu+Cast+" is the subgraph string, a valid "subgraph string" should be one subgraph representation
 //    output by ORT graph transformations.
-// > "1" is "optimization strategy", valid values: 0 - disabled, 1 - recompute.
+// > "1" is "optimization strategy", valid values: 0 - disabled, 1 - recompute, 2 - recompute with compromise,
+//    3 - offload the stashed activations of the node to pinned host memory (CUDA and ROCm providers only).
 // > "0" is "number of subgraph to apply" which is used to control how many subgraphs to apply optimization,
 //    to avoid "oversaving" the memory.
 static const char* const kOrtSessionOptionsMemoryOptimizerApplyConfig = "optimization.memory_optimizer_config";
@@ -96,6 +151,13 @@ static const char* const kOrtSessionOptionsMemoryOptimizerApplyConfig = "optimiz
 // Specifies the config for detecting subgraphs for memory footprint reduction.
 // The value should be a string contains int separated using commas. The default value is "0:0".
 static const char* const kOrtSessionOptionsMemoryOptimizerProbeConfig = "optimization.enable_memory_probe_recompute_config";
+
+// Accumulate the gradients of the training graph in bfloat16 buffers instead of float buffers, which halves the
+// memory of the gradient accumulation buffers that are kept between training steps. The float gradients are added in
+// float and rounded stochastically to bfloat16 by the accumulating InPlaceAccumulatorV2 node, and cast back to float
+// in the optimizer graph. Applies to the accumulation nodes assigned to the CPU execution provider.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsBFloat16GradientAccumulation = "optimization.bf16_gradient_accumulation";
 #endif
 
 // This setting if set should contain a comma separated list of optimizers names that should be disabled.
@@ -111,6 +173,37 @@ static const char* const kOrtSessionOptionsDisableSpecifiedOptimizers = "optimiz
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
 
+// Enable or disable backing the large CPU allocations of the session with huge pages. "1": enable; "0": disable.
+// The default is "0".
+// When enabled, the allocations of 2MB or more made by the CPU allocator that the session creates for the default CPU
+// execution provider, including the regions of the CPU arena and the initializers, use huge pages, which reduces the
+// TLB misses of kernels that go through large weights, e.g. GEMMs. On Linux the reserved hugetlb pages
+// (/proc/sys/vm/nr_hugepages) are used if available, and transparent huge pages otherwise. On Windows large pages
+// are used, which requires the 'Lock pages in memory' privilege. An allocation falls back to regular pages if huge
+// pages can't be allocated.
+static const char* const kOrtSessionOptionsUseHugePagesForCpuMemory = "session.use_huge_pages_for_cpu_memory";
+
+// Enable or disable loading initializers with external data on first use. "1": enable; "0": disable. The default is "0".
+// When enabled, initializers in an external data file are not read or copied to their device during session
+// initialization. Each one is loaded the first time a node that consumes it runs, so the weights of branches that
+// are rarely taken (e.g. an If subgraph) only take memory once they are needed. Kernels pre-pack such an
+// initializer when it is loaded instead of during session initialization, and can't read it in their constructor.
+// An initializer used by a subgraph from the outer scope is loaded when the control flow node runs.
+// Initializers that are graph outputs or have a requested allocation order are always loaded eagerly.
+static const char* const kOrtSessionOptionsLazyLoadExternalInitializers = "session.lazy_load_external_initializers";
+
+// Enable or disable sharing initializers with the other sessions in the process that enable it. "1": enable; "0":
+// disable. The default is "0".
+// When enabled, an initializer is looked up by the hash of its content, its type and shape, and its device before it
+// is allocated, and an identical initializer that another session created is used instead of a new copy. Unlike
+// AddInitializer, this shares the initializers produced by the graph optimizers, e.g. constant folding, and the
+// copies on a device, so sessions of the same model with different execution providers or optimization levels share
+// the weights that ended up identical. Only initializers of at least 1KB that have raw data or data in an external
+// file are shared, and not the ones that are loaded lazily. The initializers must not be modified, which holds unless
+// a kernel writes to its inputs.
+static const char* const kOrtSessionOptionsShareInitializersAcrossSessions =
+    "session.share_initializers_across_sessions";
+
 // Configure whether to allow the inter_op/intra_op threads spinning a number of times before blocking
 // "0": thread will block if found no job to run
 // "1": default, thread will spin a number of times before blocking
@@ -135,6 +228,16 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
 
+// Minimum size in bytes of the inline data of an initializer that is left in the ONNX model file when the model is
+// loaded from a path. The initializer is changed to external data referring to the model file, and its data is
+// memory mapped when the session creates it, instead of being copied into the parsed model first. This avoids having
+// the weights of the model in memory twice during the load.
+// "0": the default. Only models larger than 2GB, which protobuf can't parse in one message, are loaded this way,
+//      with a minimum size of 1024 bytes.
+// Not used for models loaded from bytes or a stream, or for ORT format models.
+static const char* const kOrtSessionOptionsConfigMapInlineInitializersMinSize =
+    "session.map_inline_initializers_min_size";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -166,6 +269,23 @@ static const char* const kOrtSessionOptionsConfigMinimalBuildOptimizations =
 // exclusion, set the value to "".
 static const char* const kOrtSessionOptionsConfigNnapiEpPartitioningStopOps = "ep.nnapi.partitioning_stop_ops";
 
+// Directory in which the NNAPI drivers cache the compiled NNAPI models, so the sessions created by later launches of
+// the app load the compilation instead of compiling the models again. The cache token of a partition is a hash of the
+// NNAPI model built for it. The directory should be owned by the app, e.g. the code_cache directory of the app.
+// Only used on Android API level 29+. If not specified or empty, the compilation is not cached.
+static const char* const kOrtSessionOptionsConfigNnapiEpCompilationCacheDir = "ep.nnapi.compilation_cache_dir";
+
+// Enable the cost based refinement of the graph partitioning. Once the execution providers claimed their nodes, the
+// nodes assigned to the kernels of a device execution provider (e.g. CUDA) that are estimated to finish sooner on CPU,
+// once the copies of their inputs and outputs between host and device memory are taken into account, are moved to
+// the CPU execution provider. This mostly affects small isolated ops next to CPU nodes, which would otherwise be
+// surrounded by Memcpy nodes. The estimates use the static shapes of the graph and have no effect on nodes with
+// dynamic shapes, compiled nodes, compute bound ops or nodes in subgraphs.
+// Option values:
+// - "0": Assign the nodes greedily in the order of the execution providers. [DEFAULT]
+// - "1": Move the nodes that are cheaper on CPU.
+static const char* const kOrtSessionOptionsConfigCostBasedPartitioning = "session.cost_based_partitioning";
+
 // Enabling dynamic block-sizing for multithreading.
 // With a positive value, thread pool will split a task of N iterations to blocks of size starting from:
 // N / (num_of_threads * dynamic_block_base)
@@ -176,6 +296,25 @@ static const char* const kOrtSessionOptionsConfigNnapiEpPartitioningStopOps = "e
 // Available since version 1.11.
 static const char* const kOrtSessionOptionsConfigDynamicBlockBase = "session.dynamic_block_base";
 
+// Refine the cost estimates that kernels pass to the intra-op thread pool with measured execution times.
+// The thread pool samples the time per unit of work of each parallel loop call site and uses it, instead of the
+// static estimate, to decide whether to parallelize the loop at all and which block size to use.
+// When profiling is enabled the per call site estimates are included in the thread pool profiling output.
+// Option values:
+// - "0": Use the kernel provided cost estimates. [DEFAULT]
+// - "1": Use measured cost estimates once available.
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveCostModel = "session.intra_op.adaptive_cost_model";
+
+// Size the spinning of the intra-op thread pool workers from how long they wait for work.
+// A worker halves its spin budget each time it spun in vain and then blocked for longer than it spun, down to 1/64 of
+// the default, and doubles it again when work arrives late in the budget or soon after it blocked.
+// This keeps the low wake-up latency of spinning for back-to-back parallel sections, while workers that wait for
+// long stop burning CPU that other processes on a shared host could use. Ignored if spinning is not allowed.
+// Option values:
+// - "0": Spin for the fixed count before blocking. [DEFAULT]
+// - "1": Adapt the spin budget of each worker.
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveSpinning = "session.intra_op.adaptive_spinning";
+
 // This option allows to decrease CPU usage between infrequent
 // requests and forces any TP threads spinning stop immediately when the last of
 // concurrent Run() call returns.
@@ -197,6 +336,89 @@ static const char* const kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly =
 // The file saves configuration for partitioning node among logic streams
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
+// Path of a file used to persist the memory patterns of the main graph across sessions, e.g. between process
+// restarts. Memory patterns are generated on the first Run for each set of input shapes and let later Runs allocate
+// all the activations of a device in one block. With this option the patterns are saved to the file as they are
+// generated, and a new session of the same model loads them during initialization so it doesn't need a warm-up Run.
+// The file is ignored if it was generated for a different execution plan, and has no effect if memory patterns
+// are disabled. Not supported in a minimal build.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheFile = "session.memory_pattern_cache_file";
+
+// The maximum number of memory patterns a session keeps, one per set of input shapes or bucket of them. When a new
+// one is generated beyond this number, the least recently used pattern is dropped. The default is "0", no limit.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheSize = "session.memory_pattern_cache_size";
+
+// Comma separated list of sizes, e.g. "64,128,256,512", that the input dims are rounded up to when looking up the
+// memory pattern of a Run. All the input shapes that round to the same sizes share one pattern, so inputs with
+// varying dims, e.g. sequence lengths, reuse a planned block instead of allocating their activations. The pattern
+// of a bucket is generated again by a Run whose inputs are larger than those it was generated for, until it fits
+// the largest inputs of the bucket. Dims above the largest size are not rounded.
+// The default is "", to use a pattern per exact set of input shapes.
+static const char* const kOrtSessionOptionsConfigMemoryPatternDimBuckets = "session.memory_pattern_dim_buckets";
+
+// Plans the memory patterns of new input shapes from the symbolic dims of the graph, e.g. {batch, seq_len, 768},
+// instead of generating them during the first Run with these shapes. The allocations of the first Run that generates
+// a pattern are recorded, and replayed with the sizes evaluated for the shapes of later Runs, so a Run with new input
+// shapes already allocates its activations in one block per device. Tensors with sizes that can't be expressed with
+// the symbolic dims of the graph inputs are allocated when they are created. Only applies to the main graph.
+// "0": disabled. (default)
+// "1": enabled.
+static const char* const kOrtSessionOptionsConfigSymbolicMemoryPlanning = "session.symbolic_memory_planning";
+
+// Path of a file used to share the pre-packed weights of CPU kernels between processes that run the same model.
+// The session memory maps the file and its kernels use the packed weights in the mapping, so they are backed by the
+// page cache instead of a private copy in every process. Weights packed by the session that are not in the file yet
+// are added to it at the end of session initialization. The file is ignored if it was written on a CPU with
+// different instruction sets. Pre-packed weights shared through a PrepackedWeightsContainer take precedence.
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsCacheFile = "session.prepacked_weights_cache_file";
+
+// Shape buckets for sessions that capture a graph, e.g. with the CUDA EP option enable_cuda_graph.
+// The value has the form "<axis>:<size>,<size>,...", e.g. "1:32,64,128,256". The feeds of a run are padded with
+// zeros along the axis to the smallest size that fits them, a graph is captured once per size and replayed for later
+// runs that fit the same size, and fetches that have that size along the axis are sliced back.
+// Runs that set the "gpu_graph_id" run option, or that don't fit the largest size, don't use the buckets.
+// The padding only leaves the results unchanged for models that don't combine values along the axis or that mask
+// the padded values.
+static const char* const kOrtSessionOptionsConfigGraphCaptureShapeBuckets = "session.graph_capture_shape_buckets";
+
+// Keeps the state of streaming models (e.g. Scan or Loop based audio models) inside the session across runs.
+// The value is a list of semi-colon separated pairs "<output>:<input>", each naming a graph output whose value is fed
+// to a graph input in the next run, e.g. "state_out:state_in;cache_out:cache_in".
+// The state is handed over without copying it, and the caller only feeds the chunk inputs after the first run.
+// A state input that the caller feeds overrides the kept state. Before the first run, the state inputs must be fed
+// unless they have an initializer. See kOrtRunOptionsConfigResetStreamingState to start a new stream.
+// Runs of the session are serialized.
+static const char* const kOrtSessionOptionsConfigStreamingState = "session.streaming_state";
+
+// Controls how nodes are dispatched in ExecutionMode::ORT_PARALLEL when all the nodes run on the CPU.
+// "1": each node is scheduled on the inter-op thread pool as soon as the nodes it depends on have completed, and idle
+//      inter-op threads steal ready nodes from busy ones. This lets independent branches of the graph run
+//      concurrently. [DEFAULT]
+// "0": the nodes of a logic stream run in the order of the execution plan.
+// The option has no effect if the graph is partitioned into more than one logic stream.
+static const char* const kOrtSessionOptionsConfigDynamicInterOpScheduling = "session.dynamic_inter_op_scheduling";
+
+// Copies the feeds of a run to the device on a stream dedicated to the copies, one per device, instead of on the
+// stream that consumes them. The consuming streams wait for the copies on the device through stream events, so the
+// uploads of a run proceed while the device is busy with the work of other runs, and the host no longer waits for
+// the copy of a feed that is consumed by several streams.
+// Requires an EP with device streams, e.g. CUDA. It has no effect with the EP level unified stream of CUDA, where
+// all the runs share one stream.
+// "0": feeds are copied on the stream that consumes them. [DEFAULT]
+// "1": feeds are copied on a copy stream.
+static const char* const kOrtSessionOptionsConfigUseCopyStreamForFeeds = "session.use_copy_stream_for_feeds";
+
+// Runs the model tensor parallel over several CUDA devices of one process. Each device is driven by its own session,
+// created from the same model with the same world size and the rank of the device, and the sessions of all the ranks
+// run concurrently, e.g. one thread per rank. The constant MatMul weights of the model are sharded over the ranks,
+// with the AllReduce and AllGather collectives inserted to combine the partial results, and the collectives of the
+// ranks are connected through NCCL communicators created in the process. Rank r must use CUDA device r.
+// Requires a build with NCCL.
+// "session.tensor_parallel_world_size": the number of ranks. "0" or "1" disables tensor parallelism. [DEFAULT = "0"]
+// "session.tensor_parallel_rank": the rank of the session, in [0, world size). [DEFAULT = "0"]
+static const char* const kOrtSessionOptionsConfigTensorParallelWorldSize = "session.tensor_parallel_world_size";
+static const char* const kOrtSessionOptionsConfigTensorParallelRank = "session.tensor_parallel_rank";
+
 // This Option allows setting affinities for intra op threads.
 // Affinity string follows format:
 // logical_processor_id,logical_processor_id;logical_processor_id,logical_processor_id
@@ -214,6 +436,22 @@ static const char* const kNodePartitionConfigFile = "session.node_partition_conf
 //    Hence 64-65 is an invalid configuration, because a windows thread cannot be attached to processors across group boundary.
 static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "session.intra_op_thread_affinities";
 
+// This option binds the intra op threads to the physical cores of one NUMA node.
+// The value is the zero based index of the NUMA node. If the number of intra op threads is not set, one thread is
+// created per physical core of the node. As arena memory is first-touched by the threads that compute with it,
+// running one session per NUMA node keeps weights and activations node-local and avoids cross-socket traffic.
+// Ignored if kOrtSessionOptionsConfigIntraOpThreadAffinities is set, or if the node does not exist or NUMA topology
+// information is not available on the platform (currently it is only available on Linux).
+static const char* const kOrtSessionOptionsConfigIntraOpThreadNumaNode = "session.intra_op_thread_numa_node";
+
+// This option binds the intra op threads to the performance cores of a hybrid CPU (e.g. Intel P-cores or Arm "big"
+// cores). Every ParallelFor shard then runs at the same speed, so a loop no longer waits for the shards that landed
+// on efficiency cores. If the number of intra op threads is not set, one thread is created per performance core.
+// Ignored if kOrtSessionOptionsConfigIntraOpThreadAffinities or kOrtSessionOptionsConfigIntraOpThreadNumaNode is
+// set, or if the CPU does not have cores of different classes.
+// "0": disabled (default), "1": enabled.
+static const char* const kOrtSessionOptionsConfigIntraOpPerformanceCoresOnly = "session.intra_op.performance_cores_only";
+
 // This option will dump out the model to assist debugging any issues with layout transformation,
 // and is primarily intended for developer usage. It is only relevant if an execution provider that requests
 // NHWC layout is enabled such as NNAPI, XNNPACK or QNN.
@@ -250,6 +488,16 @@ static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersFil
 static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersMinSizeInBytes =
     "session.optimized_model_external_initializers_min_size_in_bytes";
 
+// Directory of a cache of optimized models. When set, a session looks up the model in the directory before running
+// the graph optimizations, and loads the optimized model instead if it was saved by an earlier session. Otherwise
+// the model is optimized as usual and saved to the directory for later sessions.
+// Models are keyed by a hash of the model file (or the model bytes) together with the onnxruntime version, the
+// execution providers and their options, the instruction sets of the CPU, the graph optimization level and the other
+// session config entries, so a change to any of them optimizes the model again.
+// The cache is not used for models with compiled nodes, with user provided initializers, or when
+// SessionOptions.optimized_model_filepath is set. Errors reading or writing the cache are logged and ignored.
+static const char* const kOrtSessionOptionsOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
 // Enable EP context feature to dump the partitioned graph which includes the EP context into Onnx file.
 // The dumped Onnx model with EP context can be used for future inference to avoid the EP graph partitioning/compile overhead.
 // "0": disable. (default)
@@ -272,17 +520,122 @@ static const char* const kOrtSessionOptionEpContextNodeNamePrefix = "ep.context_
 // Share EP related resources across EPs
 static const char* const kOrtSessionOptionShareEpContexts = "ep.share_ep_contexts";
 
+// Set on the last session sharing EP related resources with ep.share_ep_contexts, so that the resources are released
+// once the session is initialized and later sessions do not share them.
+// e.g. with QNN EP, the sessions generating EP context models for the prefill and decode graphs of one LLM compile
+// all the graphs into one QNN context binary with shared weights, which is complete once the last session is created.
+// Option values:
+// - "0": Keep sharing the EP related resources with later sessions. [DEFAULT]
+// - "1": Stop sharing the EP related resources after this session.
+static const char* const kOrtSessionOptionStopShareEpContexts = "ep.stop_share_ep_contexts";
+
 // Gemm fastmath mode provides fp32 gemm acceleration with bfloat16 based matmul.
 // Option values:
 // - "0": Gemm FastMath mode is not enabled. [DEFAULT]
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
 
+// Gemm fastmath mode on any platform with bfloat16 acceleration, currently ARM64 with BF16 and x64 with AVX512_BF16.
+// Option values are the same as for kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16, either of them enables it.
+static const char* const kOrtSessionOptionsMlasGemmFastMathBfloat16 = "mlas.enable_gemm_fastmath_bfloat16";
+
+// Density threshold below which the float weight initializer of a CPU MatMul, FusedMatMul or Gemm is packed in
+// blocked CSR form and multiplied with a sparse-dense kernel, instead of being packed for the dense MLAS GEMM.
+// The density is the fraction of non-zero elements of the weight, e.g. "0.2" for pruned weights with at least 80%
+// zeros. Only 2D weights are packed. The sparse kernel accumulates in a different order than the dense GEMM.
+// The value is a float in [0, 1]. The default is "0", which disables the sparse packing.
+static const char* const kOrtSessionOptionsSparseWeightDensityThreshold = "session.sparse_weight_density_threshold";
+
 // When converting DQ + MatMul -> MatMulNBits, the accuracy level of the MatMulNBits is controlled by this option.
 // Refer to MatMulNBits op schema for more details.
 // If not provided, default is 4.
 static const char* const kOrtSessionOptionsQDQMatMulNBitsAccuracyLevel = "session.qdq_matmulnbits_accuracy_level";
 
+// Enable TunableOp for the CPU execution provider. Kernels with a tunable implementation (e.g. the float MatMul
+// thread partitioning) use the fastest candidate recorded in the tuning results, if there is one for the shape.
+// Tuning results can be retrieved with GetTuningResults and embedded into the model metadata, in which case they are
+// loaded and TunableOp is enabled automatically.
+// Option values:
+// - "0": TunableOp is disabled. [DEFAULT]
+// - "1": TunableOp is enabled.
+static const char* const kOrtSessionOptionsCpuTunableOpEnable = "session.cpu_tunable_op_enable";
+
+// Benchmark the candidates of a CPU TunableOp the first time a shape is seen and record the winner.
+// Only takes effect when kOrtSessionOptionsCpuTunableOpEnable is "1".
+// Option values:
+// - "0": Tuning is disabled. [DEFAULT]
+// - "1": Tuning is enabled.
+static const char* const kOrtSessionOptionsCpuTunableOpTuningEnable = "session.cpu_tunable_op_tuning_enable";
+
+// Upper bound in milliseconds of the time spent benchmarking each candidate of a CPU TunableOp.
+// Values <= 0 mean no limit. Default is "0".
+static const char* const kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs =
+    "session.cpu_tunable_op_max_tuning_duration_ms";
+
+// The file where the session persists the TunableOp results of its execution providers, e.g. to tune once per GPU
+// type and distribute the file. The valid entries of the file are loaded when the session is initialized and
+// TunableOp is enabled for them. The results tuned by the session, e.g. in a run with
+// kOrtRunOptionsConfigTuningWarmup, are written back to the file when the session is destroyed. The entries of an
+// execution provider that fail validation, e.g. because they come from another GPU, are replaced.
+// The default is "", to not persist the tuning results.
+static const char* const kOrtSessionOptionsTuningResultsFile = "session.tuning_results_file";
+
+// The file where the session persists the input shapes of its largest run, for OrtApi::WarmupSession. The shapes are
+// loaded when the session is initialized and used for the inputs that the warmup doesn't give a shape for. The shapes
+// of the run with the most input elements are written back to the file when the session is destroyed, if a run was
+// larger than the shapes of the file.
+// The default is "", to not record the input shapes.
+static const char* const kOrtSessionOptionsWarmupShapesFile = "session.warmup_shapes_file";
+
+// Record the kernel latencies of 1 in N graph executions into per (op type, execution provider) histograms, which
+// can be read at any time with OrtApi::SessionGetNodeLatencyStats. Unlike the profiler, nothing is written out and
+// the memory used does not grow with the number of runs, so it can be left on in production.
+// For execution providers that run kernels asynchronously, the latency is the time taken to launch the kernel.
+// Subgraph executions are counted separately from the executions of the main graph.
+// Option values:
+// - "0": The node latency stats are disabled. [DEFAULT]
+// - "N" (N >= 1): The kernels of every Nth graph execution are timed.
+static const char* const kOrtSessionOptionsNodeLatencySamplingInterval = "session.node_latency_sampling_interval";
+
+// Record which tensors are allocated when, during the runs of the session. When the session is destroyed, the run
+// with the highest peak memory is written to this file in Chrome trace format: the live bytes per device over time,
+// the lifetime of every tensor with its size and producer node, and under "peakMemory" the largest tensors that are
+// live at the peak of each device. Tensors allocated inside subgraphs and by the kernels themselves, e.g. scratch
+// buffers, are not recorded.
+// The default is "", to not record the allocations.
+static const char* const kOrtSessionOptionsMemoryTraceFile = "session.memory_trace_file";
+
+// The number of tensors listed for the peak of each device in the memory trace. Default is "20".
+static const char* const kOrtSessionOptionsMemoryTraceTopN = "session.memory_trace_top_n";
+
+// The format of the profile file written when profiling is enabled.
+// Option values:
+// - "event_list": A JSON array of complete events in Chrome trace format. [DEFAULT]
+// - "timeline": A JSON trace that loads as one timeline in Perfetto and chrome://tracing. The events of the EP
+//   profilers, e.g. the CUDA kernels, are on one track per device stream, each task run by the intra-op thread pool
+//   for a node is an event on the track of its worker thread, and every node event has a correlation id and a flow
+//   to the kernels and tasks it started.
+static const char* const kOrtSessionOptionsProfilingTraceFormat = "session.profiling_trace_format";
+
+// The maximum number of execution frames a session keeps from completed runs for the next runs to reuse.
+// A run whose inputs have the same shapes as the run of a pooled frame reuses the frame, with its OrtValue slots and
+// the memory pattern buffers already allocated, instead of building a new one. A pooled frame holds on to the
+// memory pattern buffers between runs, so the session uses that much more memory per pooled frame.
+// Frames are not pooled for runs on device streams, with custom output allocators, or that record a memory trace.
+// Option values:
+// - "0": Every run builds its own execution frame. [DEFAULT]
+// - "N" (N >= 1): Up to N frames are kept, e.g. the number of threads that call Run() concurrently.
+static const char* const kOrtSessionOptionsConfigExecutionFramePoolSize = "session.execution_frame_pool_size";
+
+// Use the counter based Philox4x32-10 engine in the CPU RandomNormal, RandomUniform, RandomNormalLike,
+// RandomUniformLike and Multinomial kernels. Each block of the output only depends on the seed and on its position in
+// the sequence of the node, so large tensors are generated in parallel and the values don't depend on the number of
+// threads. The values differ from the ones of the default std::default_random_engine based generation.
+// Option values:
+// - "0": Use std::default_random_engine. [DEFAULT]
+// - "1": Use the Philox engine.
+static const char* const kOrtSessionOptionsUsePhiloxRandomGenerator = "session.use_philox_random_generator";
+
 // THIS OPTION IS NOT A REGULAR SESSION OPTION SINCE IT CAN BE MODIFIED AT ANY TIME
 // Meant to be used with SetEpDynamicOptions
 // Specify the type of workload for this session.
@@ -9,7 +9,9 @@
 #include "run_options_helper.h"
 #include "session_options_helper.h"
 #include "tensor_helper.h"
+#include <memory>
 #include <string>
+#include <vector>
 
 Napi::FunctionReference InferenceSessionWrap::constructor;
 
@@ -46,7 +48,7 @@ Napi::Object InferenceSessionWrap::Init(Napi::Env env, Napi::Object exports) {
 }
 
 InferenceSessionWrap::InferenceSessionWrap(const Napi::CallbackInfo& info)
-    : Napi::ObjectWrap<InferenceSessionWrap>(info), initialized_(false), disposed_(false), session_(nullptr), defaultRunOptions_(nullptr) {}
+    : Napi::ObjectWrap<InferenceSessionWrap>(info), initialized_(false), disposed_(false), session_(nullptr) {}
 
 Napi::Value InferenceSessionWrap::LoadModel(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
@@ -59,7 +61,6 @@ Napi::Value InferenceSessionWrap::LoadModel(const Napi::CallbackInfo& info) {
   ORT_NAPI_THROW_TYPEERROR_IF(argsLength == 0, env, "Expect argument: model file path or buffer.");
 
   try {
-    defaultRunOptions_.reset(new Ort::RunOptions{});
     Ort::SessionOptions sessionOptions;
 
     if (argsLength == 2 && info[0].IsString() && info[1].IsObject()) {
@@ -145,6 +146,101 @@ Napi::Value InferenceSessionWrap::GetOutputNames(const Napi::CallbackInfo& info)
   return scope.Escape(CreateNapiArrayFrom(env, outputNames_));
 }
 
+namespace {
+// Runs a session in a thread of the libuv pool, so the event loop isn't blocked by the inference.
+class RunWorker : public Napi::AsyncWorker {
+ public:
+  RunWorker(Napi::Env env, std::shared_ptr<Ort::Session> session, Ort::RunOptions runOptions)
+      : Napi::AsyncWorker(env, "onnxruntime-node:run"),
+        deferred_(Napi::Promise::Deferred::New(env)),
+        session_(std::move(session)),
+        runOptions_(std::move(runOptions)) {}
+
+  Napi::Promise GetPromise() const { return deferred_.Promise(); }
+
+  void AddInput(const std::string& name, Napi::Value value, OrtMemoryInfo* memoryInfo) {
+    inputNames_.push_back(name);
+    inputValues_.push_back(NapiValueToOrtValue(Env(), value, memoryInfo));
+    KeepDataAlive(value);
+  }
+
+  // a null value is allocated by the run, any other value is a tensor that the run writes in place
+  void AddOutput(const std::string& name, Napi::Value value, OrtMemoryInfo* memoryInfo) {
+    outputNames_.push_back(name);
+    if (value.IsNull()) {
+      outputValues_.emplace_back(nullptr);
+      preallocatedOutputs_.emplace_back();
+    } else {
+      outputValues_.push_back(NapiValueToOrtValue(Env(), value, memoryInfo));
+      preallocatedOutputs_.push_back(Napi::Persistent(value.As<Napi::Object>()));
+      KeepDataAlive(value);
+    }
+  }
+
+ protected:
+  void Execute() override {
+    std::vector<const char*> inputNames;
+    for (const auto& name : inputNames_) {
+      inputNames.push_back(name.c_str());
+    }
+    std::vector<const char*> outputNames;
+    for (const auto& name : outputNames_) {
+      outputNames.push_back(name.c_str());
+    }
+
+    try {
+      session_->Run(runOptions_, inputNames.empty() ? nullptr : &inputNames[0],
+                    inputValues_.empty() ? nullptr : &inputValues_[0], inputValues_.size(),
+                    outputNames.empty() ? nullptr : &outputNames[0], outputValues_.empty() ? nullptr : &outputValues_[0],
+                    outputValues_.size());
+    } catch (std::exception const& e) {
+      SetError(e.what());
+    }
+  }
+
+  void OnOK() override {
+    Napi::Env env = Env();
+    Napi::HandleScope scope(env);
+    try {
+      Napi::Object result = Napi::Object::New(env);
+      for (size_t i = 0; i < outputNames_.size(); i++) {
+        result.Set(outputNames_[i], preallocatedOutputs_[i].IsEmpty() ? OrtValueToNapiValue(env, outputValues_[i])
+                                                                       : preallocatedOutputs_[i].Value());
+      }
+      deferred_.Resolve(result);
+    } catch (Napi::Error const& e) {
+      deferred_.Reject(e.Value());
+    } catch (std::exception const& e) {
+      deferred_.Reject(Napi::Error::New(env, e.what()).Value());
+    }
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+ private:
+  // the tensors are created over the buffers of the typed arrays, which must outlive the run
+  void KeepDataAlive(Napi::Value value) {
+    auto data = value.As<Napi::Object>().Get("data");
+    if (data.IsTypedArray()) {
+      dataReferences_.push_back(Napi::Persistent(data.As<Napi::Object>()));
+    }
+  }
+
+  Napi::Promise::Deferred deferred_;
+  // shared with the session wrap, so that a dispose during the run doesn't release the session
+  std::shared_ptr<Ort::Session> session_;
+  Ort::RunOptions runOptions_;
+  std::vector<std::string> inputNames_;
+  std::vector<Ort::Value> inputValues_;
+  std::vector<std::string> outputNames_;
+  std::vector<Ort::Value> outputValues_;
+  std::vector<Napi::ObjectReference> preallocatedOutputs_;
+  std::vector<Napi::ObjectReference> dataReferences_;
+};
+}  // namespace
+
 Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
@@ -160,52 +256,34 @@ Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo& info) {
   auto feed = info[0].As<Napi::Object>();
   auto fetch = info[1].As<Napi::Object>();
 
-  std::vector<const char*> inputNames_cstr;
-  std::vector<Ort::Value> inputValues;
-  std::vector<const char*> outputNames_cstr;
-  std::vector<Ort::Value> outputValues;
-  std::vector<bool> reuseOutput;
-  size_t inputIndex = 0;
-  size_t outputIndex = 0;
-  OrtMemoryInfo* memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault).release();
-
   try {
-    for (auto& name : inputNames_) {
-      if (feed.Has(name)) {
-        inputIndex++;
-        inputNames_cstr.push_back(name.c_str());
-        auto value = feed.Get(name);
-        inputValues.push_back(NapiValueToOrtValue(env, value, memory_info));
-      }
-    }
-    for (auto& name : outputNames_) {
-      if (fetch.Has(name)) {
-        outputIndex++;
-        outputNames_cstr.push_back(name.c_str());
-        auto value = fetch.Get(name);
-        reuseOutput.push_back(!value.IsNull());
-        outputValues.emplace_back(value.IsNull() ? Ort::Value{nullptr} : NapiValueToOrtValue(env, value, memory_info));
-      }
-    }
-
-    Ort::RunOptions runOptions{nullptr};
+    Ort::RunOptions runOptions;
     if (info.Length() > 2) {
-      runOptions = Ort::RunOptions{};
       ParseRunOptions(info[2].As<Napi::Object>(), runOptions);
     }
 
-    session_->Run(runOptions == nullptr ? *defaultRunOptions_.get() : runOptions,
-                  inputIndex == 0 ? nullptr : &inputNames_cstr[0], inputIndex == 0 ? nullptr : &inputValues[0],
-                  inputIndex, outputIndex == 0 ? nullptr : &outputNames_cstr[0],
-                  outputIndex == 0 ? nullptr : &outputValues[0], outputIndex);
-
-    Napi::Object result = Napi::Object::New(env);
-
-    for (size_t i = 0; i < outputIndex; i++) {
-      result.Set(outputNames_[i], OrtValueToNapiValue(env, outputValues[i]));
+    Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    // the queue takes the ownership of the worker, which deletes itself when it completes
+    auto worker = new RunWorker(env, session_, std::move(runOptions));
+    try {
+      for (auto& name : inputNames_) {
+        if (feed.Has(name)) {
+          worker->AddInput(name, feed.Get(name), memoryInfo);
+        }
+      }
+      for (auto& name : outputNames_) {
+        if (fetch.Has(name)) {
+          worker->AddOutput(name, fetch.Get(name), memoryInfo);
+        }
+      }
+    } catch (...) {
+      delete worker;
+      throw;
     }
 
-    return scope.Escape(result);
+    auto promise = worker->GetPromise();
+    worker->Queue();
+    return scope.Escape(promise);
   } catch (Napi::Error const& e) {
     throw e;
   } catch (std::exception const& e) {
@@ -218,8 +296,8 @@ Napi::Value InferenceSessionWrap::Dispose(const Napi::CallbackInfo& info) {
   ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
   ORT_NAPI_THROW_ERROR_IF(this->disposed_, env, "Session already disposed.");
 
-  this->defaultRunOptions_.reset(nullptr);
-  this->session_.reset(nullptr);
+  // a run in progress keeps its own reference to the session
+  this->session_.reset();
 
   this->disposed_ = true;
   return env.Undefined();
@@ -47,11 +47,13 @@ class InferenceSessionWrap : public Napi::ObjectWrap<InferenceSessionWrap> {
   Napi::Value GetOutputNames(const Napi::CallbackInfo& info);
 
   /**
-   * [sync] run the model.
+   * [async] run the model in a thread of the libuv pool.
    * @param arg0 input object: all keys must present, value is object
    * @param arg1 output object: at least one key must present, value can be null.
-   * @returns an object that every output specified will present and value must be object
-   * @throw error if status code != 0
+   * @returns a promise of an object that every output specified will present and value must be object. The tensors
+   * that the run allocated own the output data without a copy. A pre-allocated output is written in place and
+   * returned as is.
+   * @throw error if the arguments are invalid. The promise is rejected if status code != 0
    */
   Napi::Value Run(const Napi::CallbackInfo& info);
 
@@ -71,8 +73,7 @@ class InferenceSessionWrap : public Napi::ObjectWrap<InferenceSessionWrap> {
   // session objects
   bool initialized_;
   bool disposed_;
-  std::unique_ptr<Ort::Session> session_;
-  std::unique_ptr<Ort::RunOptions> defaultRunOptions_;
+  std::shared_ptr<Ort::Session> session_;
 
   // input/output metadata
   std::vector<std::string> inputNames_;
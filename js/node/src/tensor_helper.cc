@@ -236,11 +236,29 @@ Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value& value) {
     }
     returnValue.Set("data", Napi::Value(env, stringArray));
   } else {
-    // number data
-    // TODO: optimize memory
-    auto arrayBuffer = Napi::ArrayBuffer::New(env, size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
-    if (size > 0) {
-      memcpy(arrayBuffer.Data(), value.GetTensorRawData(), size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+    // number data, which the array buffer owns without a copy when the runtime allows external buffers
+    const size_t byteLength = size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType];
+    napi_value arrayBuffer = nullptr;
+    if (byteLength > 0) {
+      auto ownedValue = std::make_unique<Ort::Value>(std::move(value));
+      napi_status status = napi_create_external_arraybuffer(
+          env, ownedValue->GetTensorMutableRawData(), byteLength,
+          [](napi_env /*env*/, void* /*data*/, void* hint) { delete static_cast<Ort::Value*>(hint); },
+          ownedValue.get(), &arrayBuffer);
+      if (status == napi_ok) {
+        ownedValue.release();
+      } else {
+        // e.g. Electron doesn't allow external buffers
+        value = std::move(*ownedValue);
+        arrayBuffer = nullptr;
+      }
+    }
+    if (arrayBuffer == nullptr) {
+      auto copiedBuffer = Napi::ArrayBuffer::New(env, byteLength);
+      if (byteLength > 0) {
+        memcpy(copiedBuffer.Data(), value.GetTensorRawData(), byteLength);
+      }
+      arrayBuffer = copiedBuffer;
     }
     napi_value typedArrayData;
     napi_status status =
@@ -12,4 +12,5 @@
 Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value, OrtMemoryInfo* memory_info);
 
 // convert an OrtValue object to a Javascript OnnxValue object
+// the data of a numeric tensor is moved into the returned object without a copy, which leaves `value` empty
 Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value& value);
@@ -91,6 +91,9 @@ struct DecoderMaskedMultiHeadAttentionParams : AttentionParameters {
   bool is_cross_attention = false;
   bool is_packed_qkv = false;
 
+  // The cross attention key and value have batch_size / beam_width entries, shared by the beams of each batch.
+  bool cross_kv_shared_across_beams = false;
+
   // Useful to better use global memory bandwidth on certain CUDA architectures.
   // Turned off by default for now until we fully understand performance implications
   // for all types of workloads.
@@ -164,6 +167,8 @@ struct GroupQueryAttentionParameters {
   AttentionQkvFormat past_kv_format;
   int zeros_count;
   int* zero_ptr;
+  int kv_cache_block_size;     // block size of a paged KV cache, 0 if the KV cache is not paged
+  int max_num_blocks_per_seq;  // dimension 1 of the block table of a paged KV cache
 };
 
 // Parameters for sparse attention.
@@ -257,6 +262,19 @@ constexpr const char* kMinSeqLenForFlashAttentionPackedQKV = "ORT_MIN_SEQ_LEN_FL
 // Default value for the above setting.
 constexpr int kDefaultMinSeqLenForFlashAttentionPackedQKV = 513;
 
+// Minimum total sequence length to select lean attention automatically for token generation in GroupQueryAttention,
+// when the batch and KV heads alone cannot fill the SMs. 0 disables the automatic selection.
+constexpr const char* kMinSeqLenForLeanAttention = "ORT_MIN_SEQ_LEN_LEAN_ATTENTION";
+
+// Default value for the above setting.
+constexpr int kDefaultMinSeqLenForLeanAttention = 32768;
+
+// Maximum number of splits of the KV sequence in the split-KV kernel of flash attention. 1 disables split-KV.
+constexpr const char* kMaxNumSplitsForFlashAttention = "ORT_MAX_NUM_SPLITS_FLASH_ATTENTION";
+
+// Default value for the above setting.
+constexpr int kDefaultMaxNumSplitsForFlashAttention = 128;
+
 // Environment variable to enable loading more KV data in flight in
 // DecoderMaskedMultiHeadAttention/DecoderMaskedSelfAttention kernels
 constexpr const char* kDecoderMaskedAttentionLoadKVDataInFlight = "ORT_DECODER_MASKED_ATTENTION_LOAD_KV_DATA_IN_FLIGHT";
@@ -8,6 +8,8 @@
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/env.h"
+#include "core/platform/env_var_utils.h"
 #include "contrib_ops/cpu/utils/dump_tensor.h"
 
 namespace onnxruntime {
@@ -16,7 +18,9 @@ namespace contrib {
 class AttentionCPUBase : public AttentionBase {
  protected:
   AttentionCPUBase(const OpKernelInfo& info, bool require_same_hidden_size)
-      : AttentionBase(info, require_same_hidden_size) {}
+      : AttentionBase(info, require_same_hidden_size),
+        disable_flash_{ParseEnvironmentVariableWithDefault<bool>(attention::kDisableFlashAttention, false)},
+        l2_cache_size_{Env::Default().GetL2CacheSize()} {}
 
   template <typename T>
   Status ApplyAttention(const T* Q,                // Q data with shape BxNxSxH
@@ -57,6 +61,26 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
+    // Used for DecoderMaskedMultiHeadAttention
+    int max_sequence_length = 0;
+    if (past_present_share_buffer) {
+      ORT_ENFORCE(past_key != nullptr && past_value != nullptr);
+      max_sequence_length = static_cast<int>(past_key->Shape().GetDims()[2]);
+    }
+
+    if constexpr (std::is_same_v<T, float>) {
+      // The tiled kernel doesn't materialize the BxNxSxT attention probabilities, which can't be output then.
+      if (!disable_flash_ && l2_cache_size_ > 0 && output_qk == nullptr &&
+          (mask_index == nullptr || mask_index->Shape().NumDimensions() <= 3)) {
+        const bool causal = is_unidirectional_ && sequence_length > 1;
+        return ApplyFlashAttention(Q, K, V, mask_index, past, past_key, past_value, present, present_key,
+                                   present_value, output, batch_size, sequence_length, kv_sequence_length,
+                                   past_sequence_length, qk_head_size == 0 ? v_head_size : qk_head_size,
+                                   v_head_size, attn_bias, causal, past_present_share_buffer, max_sequence_length,
+                                   allocator, tp);
+      }
+    }
+
     // Merge causal mask with padding mask, and convert values from 0/1 to -inf/0, then broadcast to 3D (BxSxT).
     bool causal = (is_unidirectional_ && sequence_length > 1);
     void* mask_data = nullptr;
@@ -94,13 +118,6 @@ class AttentionCPUBase : public AttentionBase {
     const T* attn_bias_data = (attn_bias != nullptr) ? attn_bias->Data<T>() : nullptr;
     auto attn_bias_dims = (attn_bias != nullptr) ? attn_bias->Shape().GetDims() : gsl::span<const int64_t>{};
 
-    // Used for DecoderMaskedMultiHeadAttention
-    int max_sequence_length = 0;
-    if (past_present_share_buffer) {
-      ORT_ENFORCE(past_key != nullptr && past_value != nullptr);
-      max_sequence_length = static_cast<int>(past_key->Shape().GetDims()[2]);
-    }
-
     // Compute the attention score.
     size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
     auto attention_probs = allocator->Alloc(bytes);
@@ -125,7 +142,177 @@ class AttentionCPUBase : public AttentionBase {
     return Status::OK();
   }
 
+  bool disable_flash_;  // whether to disable MlasFlashAttention for float
+  int l2_cache_size_;   // used to choose the block sizes of MlasFlashAttention
+
  private:
+  // Computes the attention of float inputs with the tiled online softmax kernel of MLAS. Only the mask, which is
+  // shared by the heads, is materialized: (B)xT for a key padding mask, or BxSxT for a 3D mask. The causal mask
+  // is applied by the kernel, which skips the blocks of keys after the last query of a block.
+  Status ApplyFlashAttention(const float* Q,                // Q data with shape BxNxSxH
+                             const float* K,                // K data with shape BxNxLxH
+                             const float* V,                // V value with size BxNxLxH_v
+                             const Tensor* mask_index,      // mask index with 1, 2 or 3 dimensions
+                             const Tensor* past,            // past state
+                             const Tensor* past_key,        // past K input tensor (if not using past state)
+                             const Tensor* past_value,      // past V input tensor (if not using past state)
+                             Tensor* present,               // present state
+                             Tensor* present_key,           // present K output tensor (if separating present KV)
+                             Tensor* present_value,         // present V output tensor (if separating present KV)
+                             Tensor* output,                // output tensor with shape BxSxNxH_v
+                             int batch_size,                // batch size (B)
+                             int sequence_length,           // sequence length of Q (S)
+                             int kv_sequence_length,        // sequence length of K or V (L)
+                             int past_sequence_length,      // sequence length of past state (P)
+                             int qk_head_size,              // head size of Q or K (H)
+                             int v_head_size,               // head size of V (H_v)
+                             const Tensor* attn_bias,       // additive bias applied on scaled QK.
+                             bool causal,                   // whether to apply the causal mask
+                             bool past_present_share_buffer,
+                             int max_sequence_length,       // sequence length of the shared buffer (M)
+                             AllocatorPtr allocator,
+                             ThreadPool* tp) const {
+    const int total_sequence_length = past_sequence_length + kv_sequence_length;  // T = P + L
+    const ptrdiff_t loop_len = SafeInt<ptrdiff_t>(batch_size) * num_heads_;
+
+    // Concatenate the past and new keys and values of each head into the present state, if any.
+    const float* key = K;
+    const float* value = V;
+    int kv_buffer_sequence_length = kv_sequence_length;
+    const float* past_data = past != nullptr ? past->Data<float>() : nullptr;
+    float* present_k = present != nullptr ? present->MutableData<float>()
+                                          : (present_key != nullptr ? present_key->MutableData<float>() : nullptr);
+    if (present_k != nullptr) {
+      const float* past_k = present != nullptr ? past_data : (past_key != nullptr ? past_key->Data<float>() : nullptr);
+      const float* past_v = nullptr;
+      float* present_v = nullptr;
+      if (present != nullptr) {
+        past_v = past_data != nullptr ? past_data + loop_len * past_sequence_length * v_head_size : nullptr;
+        present_v = present_k + loop_len * total_sequence_length * v_head_size;
+      } else {
+        past_v = past_value != nullptr ? past_value->Data<float>() : nullptr;
+        present_v = present_value->MutableData<float>();
+      }
+
+      kv_buffer_sequence_length = past_present_share_buffer ? max_sequence_length : total_sequence_length;
+      const size_t k_chunk_length = static_cast<size_t>(kv_sequence_length) * qk_head_size;
+      const size_t v_chunk_length = static_cast<size_t>(kv_sequence_length) * v_head_size;
+
+      TensorOpCost unit_cost;
+      unit_cost.bytes_loaded = static_cast<double>(
+          (static_cast<size_t>(past_present_share_buffer ? kv_sequence_length : total_sequence_length) *
+           (qk_head_size + v_head_size)) * sizeof(float));
+      unit_cost.bytes_stored = unit_cost.bytes_loaded;
+      unit_cost.compute_cycles = 0;
+      ThreadPool::TryParallelFor(tp, loop_len, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          if (past_present_share_buffer) {
+            // The past is already in the buffer, append the new keys and values after it.
+            const size_t k_offset = (static_cast<size_t>(max_sequence_length) * i + past_sequence_length) *
+                                    qk_head_size;
+            const size_t v_offset = (static_cast<size_t>(max_sequence_length) * i + past_sequence_length) *
+                                    v_head_size;
+            memcpy(present_k + k_offset, K + k_chunk_length * i, k_chunk_length * sizeof(float));
+            memcpy(present_v + v_offset, V + v_chunk_length * i, v_chunk_length * sizeof(float));
+          } else {
+            ConcatStateChunk(past_k, K + k_chunk_length * i, present_k,
+                             static_cast<size_t>(past_sequence_length) * qk_head_size,
+                             static_cast<size_t>(total_sequence_length) * qk_head_size, i);
+            ConcatStateChunk(past_v, V + v_chunk_length * i, present_v,
+                             static_cast<size_t>(past_sequence_length) * v_head_size,
+                             static_cast<size_t>(total_sequence_length) * v_head_size, i);
+          }
+        }
+      });
+
+      key = present_k;
+      value = present_v;
+    }
+
+    MlasFlashAttentionThreadedArgs args;
+    args.batch_size = batch_size;
+    args.num_heads = num_heads_;
+    args.q_sequence_length = sequence_length;
+    args.kv_sequence_length = total_sequence_length;
+    args.qk_head_size = qk_head_size;
+    args.v_head_size = v_head_size;
+    args.scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(qk_head_size)) : scale_;
+    /*
+      q_block_size, kv_block_size correspond to Br, Bc in the FlashAttention paper.
+      Let M = l2_cache_size / sizeof(float)
+      In the FlashAttention kernel, there are 5 big matrices that we need to keep in L2 cache:
+        slice of Q -- [Br, qk_head_size]
+        slice of K -- [Bc, qk_head_size]
+        slice of V -- [Bc, v_head_size]
+        result of QK -- [Br, Bc]
+        temporary output (same shape as QKV) -- [Br, v_head_size]
+      The total size of these matrices is (Br + Bc) * (qk_head_size + v_head_size) + Br * Bc
+      By taking Bc = M / (4 * (qk_head_size + v_head_size)), and Br = min(Bc, qk_head_size + v_head_size), we have
+        (Br + Bc) * (qk_head_size + v_head_size) + Br * Bc
+        <= 2 * Bc * (qk_head_size + v_head_size) + Br * Bc
+        <= 2 * Bc * (qk_head_size + v_head_size) + M/4
+        <= 2 * M/4 + M/4 = M * (3/4)
+
+      We leave 1/4 of the L2 cache for
+        1. storing small tensors l and m
+        2. instruction (code)
+      The slices of the mask and the attention bias are streamed once per block of keys.
+    */
+    args.kv_block_size = l2_cache_size_ / (static_cast<int>(sizeof(float)) * 4 * (qk_head_size + v_head_size));
+    args.kv_block_size = std::max(args.kv_block_size, 1);  // avoid kv_block_size = 0
+    args.q_block_size = std::min(args.kv_block_size, qk_head_size + v_head_size);
+    args.kv_block_size = std::min(args.kv_block_size, total_sequence_length);  // No point to have kv_block_size > T
+    args.q_block_size = std::min(args.q_block_size, sequence_length);          // No point to have q_block_size > S
+
+    args.thread_count = concurrency::ThreadPool::DegreeOfParallelism(tp);
+    args.buffer_size_per_thread = (static_cast<size_t>(args.q_block_size) * 2 +
+                                   static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.kv_block_size) +
+                                   static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.v_head_size)) *
+                                  sizeof(float);
+    IAllocatorUniquePtr<void> buffer = IAllocator::MakeUniquePtr<void>(
+        allocator, SafeInt<size_t>(args.buffer_size_per_thread) * args.thread_count);
+    args.buffer = reinterpret_cast<float*>(buffer.get());
+
+    args.query = Q;
+    args.key = key;
+    args.value = value;
+    args.output = output->MutableData<float>();
+    args.kv_buffer_sequence_length = kv_buffer_sequence_length;
+    args.is_causal = causal;
+    args.causal_offset = past_sequence_length;
+
+    IAllocatorUniquePtr<float> mask;
+    if (mask_index != nullptr) {
+      // Convert the mask from boolean (0/1) to float (mask_filter_value/0.0f) without broadcasting it to the
+      // queries, unless it is already 3D (BxSxT).
+      const auto mask_index_dims = mask_index->Shape().GetDims();
+      const bool is_3d_mask = mask_index_dims.size() == 3;
+      const int mask_rows = is_3d_mask ? sequence_length : 1;
+      const size_t mask_size = SafeInt<size_t>(batch_size) * mask_rows * total_sequence_length;
+      mask = IAllocator::MakeUniquePtr<float>(allocator, mask_size);
+      memset(mask.get(), 0, mask_size * sizeof(float));
+      PrepareMask(mask_index->Data<int32_t>(), mask_index_dims, mask.get(), false, batch_size, mask_rows,
+                  total_sequence_length - mask_rows, mask_filter_value_);
+
+      args.mask = mask.get();
+      args.mask_batch_stride = static_cast<size_t>(mask_rows) * total_sequence_length;
+      args.mask_row_stride = is_3d_mask ? static_cast<size_t>(total_sequence_length) : 0;
+    }
+
+    if (attn_bias != nullptr) {
+      // Attention bias has shape (B or 1, N or 1, S, T)
+      const auto attn_bias_dims = attn_bias->Shape().GetDims();
+      const size_t probs_matrix_size = static_cast<size_t>(sequence_length) * total_sequence_length;
+      args.attn_bias = attn_bias->Data<float>();
+      args.attn_bias_head_stride = attn_bias_dims[1] != 1 ? probs_matrix_size : 0;
+      args.attn_bias_batch_stride = attn_bias_dims[0] != 1 ? static_cast<size_t>(attn_bias_dims[1]) * probs_matrix_size
+                                                           : 0;
+    }
+
+    MlasFlashAttention(&args, tp);
+    return Status::OK();
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) +
   //                                1 x mask_data(B, N, S, T)
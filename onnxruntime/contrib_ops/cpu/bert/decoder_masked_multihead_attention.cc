@@ -169,6 +169,18 @@ Status DecoderMaskedMultiHeadAttention<T>::Compute(OpKernelContext* context) con
     beam_width_value = static_cast<int>(*beam_width->Data<int32_t>());
   }
 
+  // Cross attention key and value computed once per batch and shared by its beams
+  bool cross_kv_shared_across_beams = false;
+  if (parameters.is_cross_attention && key->Shape()[0] != batch_size) {
+    if (key->Shape()[0] * beam_width_value != batch_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'key' and 'value' dimension 0 shall be batch_size or batch_size / beam_width "
+                             "for cross attention, got ",
+                             key->Shape()[0]);
+    }
+    cross_kv_shared_across_beams = true;
+  }
+
   // Cache indirection (in case we are using this op inside BeamSearch)
   if (beam_width_value > 1 && cache_indir == nullptr) {
     // If beam width > 1, then cache indirection buffer MUST be present
@@ -184,6 +196,14 @@ Status DecoderMaskedMultiHeadAttention<T>::Compute(OpKernelContext* context) con
       context, allocator, batch_size, num_heads_, 1, head_size, query, bias, 0, Q));
 
   // Cross-attention case
+  if (cross_kv_shared_across_beams) {
+    return ApplyCrossAttentionWithSharedKV(Q.GetMutable<Tensor>()->MutableData<T>(),
+                                           key->Data<T>(),
+                                           value->Data<T>(),
+                                           mask_index, output, batch_size, parameters.kv_sequence_length,
+                                           head_size, v_head_size, context, beam_width_value, output_qk);
+  }
+
   if (parameters.is_cross_attention) {
     return ApplyAttention(Q.GetMutable<Tensor>()->MutableData<T>(),
                           key->Data<T>(),
@@ -276,6 +296,82 @@ Status DecoderMaskedMultiHeadAttention<T>::ApplyAttentionWithBeams(
   return Status::OK();
 }
 
+template <typename T>
+Status DecoderMaskedMultiHeadAttention<T>::ApplyCrossAttentionWithSharedKV(
+    const T* Q,
+    const T* K,
+    const T* V,
+    const Tensor* mask_index,
+    Tensor* output,
+    int batch_size,
+    int kv_sequence_length,
+    int head_size,
+    int v_head_size,
+    OpKernelContext* context,
+    int beam_width,
+    Tensor* output_qk) const {
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto* tp = context->GetOperatorThreadPool();
+
+  size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * kv_sequence_length * sizeof(T);
+  auto attention_probs = allocator->Alloc(bytes);
+  BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(std::move(allocator)));
+  T* attention_probs_data = static_cast<T*>(attention_probs);
+
+  const int32_t* mask_index_data = mask_index != nullptr ? mask_index->Data<int32_t>() : nullptr;
+  float scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+
+  TensorOpCost unit_cost;
+  unit_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(2) * head_size * kv_sequence_length);
+  unit_cost.bytes_loaded = static_cast<double>(SafeInt<ptrdiff_t>(head_size) * kv_sequence_length * sizeof(T));
+  unit_cost.bytes_stored = static_cast<double>(SafeInt<ptrdiff_t>(kv_sequence_length) * sizeof(T));
+
+  // attention_probs(B, N, 1, L) = scale * Q(B, N, 1, H) x K(B / beam_width, N, L, H)^T + mask
+  ThreadPool::TryParallelFor(
+      tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const std::ptrdiff_t batch_index = i / num_heads_;
+          const std::ptrdiff_t head_index = i % num_heads_;
+          const std::ptrdiff_t beam_batch_index = batch_index / beam_width;
+          const T* q_vec = Q + i * head_size;
+          const T* k_matrix = K + (beam_batch_index * num_heads_ + head_index) * kv_sequence_length * head_size;
+          T* probs = attention_probs_data + i * kv_sequence_length;
+          for (std::ptrdiff_t j = 0; j < kv_sequence_length; ++j) {
+            math::Dot<float, CPUMathUtil>(head_size, q_vec, k_matrix + j * head_size, probs + j, nullptr);
+            probs[j] *= scale;
+            if (mask_index_data != nullptr && mask_index_data[batch_index * kv_sequence_length + j] == 0) {
+              probs[j] += mask_filter_value_;
+            }
+          }
+        }
+      });
+
+  if (output_qk != nullptr) {
+    // Output the scaled Q*K^T if needed.
+    memcpy(output_qk->MutableData<T>(), attention_probs_data, bytes);
+  }
+
+  ComputeAttentionSoftmaxInplace(attention_probs_data, batch_size * num_heads_, kv_sequence_length, tp);
+
+  // output(B, 1, N, H_v) = attention_probs(B, N, 1, L) x V(B / beam_width, N, L, H_v)
+  T* output_data = output->MutableData<T>();
+  ThreadPool::TryParallelFor(
+      tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const std::ptrdiff_t batch_index = i / num_heads_;
+          const std::ptrdiff_t head_index = i % num_heads_;
+          const std::ptrdiff_t beam_batch_index = batch_index / beam_width;
+          const T* v_matrix = V + (beam_batch_index * num_heads_ + head_index) * kv_sequence_length * v_head_size;
+          math::MatMul<T>(1, v_head_size, kv_sequence_length, attention_probs_data + i * kv_sequence_length,
+                          v_matrix, output_data + i * v_head_size, nullptr);
+        }
+      });
+
+  return Status::OK();
+}
+
 template <typename T>
 void DecoderMaskedMultiHeadAttention<T>::ComputeAttentionProbsWithBeams(
     T* attention_probs,
@@ -34,6 +34,18 @@ class DecoderMaskedMultiHeadAttention final : public OpKernel, public AttentionC
                                  OpKernelContext* context,
                                  int beam_width,
                                  Tensor* scaled_qk = nullptr) const;
+  Status ApplyCrossAttentionWithSharedKV(const T* Q,
+                                         const T* K,
+                                         const T* V,
+                                         const Tensor* mask_index,
+                                         Tensor* output,
+                                         int batch_size,
+                                         int kv_sequence_length,
+                                         int head_size,
+                                         int v_head_size,
+                                         OpKernelContext* context,
+                                         int beam_width,
+                                         Tensor* output_qk = nullptr) const;
   void ComputeAttentionProbsWithBeams(T* attention_probs,
                                       const T* Q,
                                       const T* K,
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include "contrib_ops/cpu/bert/attention_base.h"
 #include "contrib_ops/cpu/bert/attention_helper.h"
 
@@ -102,7 +105,393 @@ class GQAAttentionBase {
     return Status::OK();
   }
 
+  // Same as ApplyAttention with a paged KV cache: past_key and past_value are pools of blocks with shape
+  // (num_blocks, block_size, N_kv, H), the new K and V are written to the blocks listed in block_table, and the
+  // attention is computed block by block from the pools without gathering each sequence into a contiguous buffer.
+  template <typename T>
+  Status ApplyPagedAttention(const T* Q,                                 // Q data with shape BxNxSxH
+                             const T* K,                                 // K data with shape BxN_kvxSxH
+                             const T* V,                                 // V data with shape BxN_kvxSxH
+                             const Tensor* past_key,                     // pool of key blocks
+                             const Tensor* past_value,                   // pool of value blocks
+                             Tensor* output,                             // output tensor
+                             Tensor* present_key,                        // updated pool of key blocks
+                             Tensor* present_value,                      // updated pool of value blocks
+                             const Tensor* seqlens_k,                    // past sequence lengths tensor
+                             const Tensor* block_table,                  // blocks of each sequence
+                             GroupQueryAttentionParameters& parameters,  // attention parameters
+                             AllocatorPtr allocator,                     // allocator for temporary tensors
+                             OpKernelContext* context) const {
+    const bool is_prompt = parameters.is_first_prompt;
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const size_t batch_size = parameters.batch_size;
+    const size_t sequence_length = parameters.sequence_length;
+    const size_t head_size = parameters.head_size;
+    const size_t hidden_size = parameters.hidden_size;
+    const size_t block_size = parameters.kv_cache_block_size;
+    const size_t max_num_blocks_per_seq = parameters.max_num_blocks_per_seq;
+    const size_t capacity = block_size * max_num_blocks_per_seq;
+    const int64_t num_blocks = past_key->Shape()[0];
+    const int32_t* blocks = block_table->Data<int32_t>();
+    const int32_t* seqlens_k_data = seqlens_k->Data<int32_t>();
+
+    for (size_t b = 0; b < batch_size; ++b) {
+      const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[b]) + 1;
+      ORT_RETURN_IF(total_seqlen > capacity, "Sequence ", b, " has ", total_seqlen,
+                    " tokens which exceeds the capacity of its blocks: ", capacity);
+      for (size_t j = 0; j < (total_seqlen + block_size - 1) / block_size; ++j) {
+        const int32_t block = blocks[b * max_num_blocks_per_seq + j];
+        ORT_RETURN_IF(block < 0 || block >= num_blocks, "Invalid block ", block, " in block_table for sequence ", b);
+      }
+    }
+
+    T* key_cache = present_key->MutableData<T>();
+    T* value_cache = present_value->MutableData<T>();
+    if (key_cache != past_key->Data<T>()) {
+      // the pools are updated in place when present shares buffer with past, which avoids this copy
+      memcpy(key_cache, past_key->Data<T>(), past_key->SizeInBytes());
+    }
+    if (value_cache != past_value->Data<T>()) {
+      memcpy(value_cache, past_value->Data<T>(), past_value->SizeInBytes());
+    }
+
+    auto* tp = context->GetOperatorThreadPool();
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t kv_row_stride = static_cast<size_t>(kv_num_heads_) * head_size;  // between tokens of a block
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const T* k_input = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const T* v_input = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+
+    auto new_kv = [&](const T* input, size_t batch_index, size_t kv_head_index) {
+      return packed_qkv ? input + packed_batch_stride * batch_index + sequence_length * head_size * kv_head_index
+                        : input + sequence_length * head_size * (batch_index * kv_num_heads_ + kv_head_index);
+    };
+    auto past_seqlen_of = [&](size_t total_seqlen) {
+      return is_prompt ? size_t{0} : total_seqlen - sequence_length;  // Assume no padding sequence length
+    };
+    // the rows of kv head `kv_head_index` in the `j`-th block of sequence `batch_index`
+    auto block_rows = [&](T* cache, size_t batch_index, size_t j, size_t kv_head_index) {
+      const size_t block = static_cast<size_t>(blocks[batch_index * max_num_blocks_per_seq + j]);
+      return cache + block * block_size * kv_row_stride + kv_head_index * head_size;
+    };
+
+    // Write the new K and V into their blocks.
+    TensorOpCost copy_cost;
+    copy_cost.bytes_loaded = static_cast<double>(2 * sequence_length * head_size * sizeof(T));
+    copy_cost.bytes_stored = copy_cost.bytes_loaded;
+    ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, copy_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t kv_head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[batch_index]) + 1;
+        const size_t past_seqlen = past_seqlen_of(total_seqlen);
+        const size_t num_new = std::min(sequence_length, total_seqlen - past_seqlen);
+        const T* k = new_kv(k_input, batch_index, kv_head_index);
+        const T* v = new_kv(v_input, batch_index, kv_head_index);
+        for (size_t s = 0; s < num_new; ++s) {
+          const size_t pos = past_seqlen + s;
+          const size_t row_offset = (pos % block_size) * kv_row_stride;
+          memcpy(block_rows(key_cache, batch_index, pos / block_size, kv_head_index) + row_offset,
+                 k + s * head_size, head_size * sizeof(T));
+          memcpy(block_rows(value_cache, batch_index, pos / block_size, kv_head_index) + row_offset,
+                 v + s * head_size, head_size * sizeof(T));
+        }
+      }
+    });
+
+    size_t probs_bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * capacity * sizeof(float);
+    auto attention_probs = static_cast<float*>(allocator->Alloc(probs_bytes));
+    BufferUniquePtr probs_buffer(attention_probs, BufferDeleter(allocator));
+
+    size_t output_fp32_bytes = 0;
+    if constexpr (std::is_same<T, MLFloat16>::value) {
+      output_fp32_bytes = SafeInt<size_t>(sequence_length) * batch_size * num_heads_ * head_size * sizeof(float);
+    }
+    auto output_fp32 = static_cast<float*>(allocator->Alloc(output_fp32_bytes));
+    BufferUniquePtr output_fp32_buffer(output_fp32, BufferDeleter(allocator));
+
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(4) * sequence_length * head_size * capacity);
+    unit_cost.bytes_loaded = static_cast<double>((sequence_length + 2 * capacity) * head_size * sizeof(T));
+    unit_cost.bytes_stored = static_cast<double>(sequence_length * (capacity + head_size) * sizeof(float));
+
+    ThreadPool::TryParallelFor(tp, batch_size * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      // fp16 blocks are converted to fp32 one at a time
+      size_t scratch_bytes = 0;
+      if constexpr (std::is_same<T, MLFloat16>::value) {
+        scratch_bytes = SafeInt<size_t>(head_size) * (sequence_length + block_size) * sizeof(float);
+      }
+      auto scratch = static_cast<float*>(allocator->Alloc(scratch_bytes));
+      BufferUniquePtr scratch_buffer(scratch, BufferDeleter(allocator));
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / num_heads_;
+        const size_t head_index = i % num_heads_;
+        const size_t kv_head_index = head_index / kv_num_heads_factor;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[batch_index]) + 1;
+        const size_t past_seqlen = past_seqlen_of(total_seqlen);
+        const size_t num_used_blocks = (total_seqlen + block_size - 1) / block_size;
+
+        const T* q = packed_qkv ? Q + packed_batch_stride * batch_index + sequence_length * head_size * head_index
+                                : Q + sequence_length * head_size * i;
+        float* probs = attention_probs + SafeInt<ptrdiff_t>(i) * sequence_length * capacity;
+
+        // attention_probs(S, T) = alpha * Q(S, H) x K'(H, T), one block of T at a time
+        for (size_t j = 0; j < num_used_blocks; ++j) {
+          const size_t n = std::min(block_size, total_seqlen - j * block_size);
+          const T* k = block_rows(key_cache, batch_index, j, kv_head_index);
+          if constexpr (std::is_same<T, float>::value) {
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, n, head_size, alpha, q,
+                                            static_cast<int>(head_size), k, static_cast<int>(kv_row_stride),
+                                            0.0f /*beta*/, probs + j * block_size, static_cast<int>(capacity),
+                                            nullptr);
+          } else {
+            float* q_fp32 = scratch;
+            float* k_fp32 = scratch + sequence_length * head_size;
+            if (j == 0) {
+              MlasConvertHalfToFloatBuffer(q, q_fp32, head_size * sequence_length);
+            }
+            for (size_t r = 0; r < n; ++r) {
+              MlasConvertHalfToFloatBuffer(k + r * kv_row_stride, k_fp32 + r * head_size, head_size);
+            }
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, n, head_size, alpha, q_fp32,
+                                            static_cast<int>(head_size), k_fp32, static_cast<int>(head_size),
+                                            0.0f /*beta*/, probs + j * block_size, static_cast<int>(capacity),
+                                            nullptr);
+          }
+        }
+
+        ComputeCausalSoftmax(probs, past_seqlen, sequence_length, total_seqlen, capacity);
+
+        // out(S, H) = attention_probs(S, T) x V(T, H), accumulated over the blocks of T
+        for (size_t j = 0; j < num_used_blocks; ++j) {
+          const size_t n = std::min(block_size, total_seqlen - j * block_size);
+          const T* v = block_rows(value_cache, batch_index, j, kv_head_index);
+          const float beta = j == 0 ? 0.0f : 1.0f;
+          if constexpr (std::is_same<T, float>::value) {
+            T* output_current =
+                output->MutableData<T>() + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, n, 1.f,
+                                            probs + j * block_size, static_cast<int>(capacity), v,
+                                            static_cast<int>(kv_row_stride), beta, output_current,
+                                            static_cast<int>(hidden_size), nullptr);
+          } else {
+            float* v_fp32 = scratch + sequence_length * head_size;
+            for (size_t r = 0; r < n; ++r) {
+              MlasConvertHalfToFloatBuffer(v + r * kv_row_stride, v_fp32 + r * head_size, head_size);
+            }
+            float* output_fp32_current =
+                output_fp32 + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, n, 1.f,
+                                            probs + j * block_size, static_cast<int>(capacity), v_fp32,
+                                            static_cast<int>(head_size), beta, output_fp32_current,
+                                            static_cast<int>(hidden_size), nullptr);
+          }
+        }
+      }
+    });
+
+    if constexpr (std::is_same<T, MLFloat16>::value) {
+      MlasConvertFloatToHalfBuffer(output_fp32, output->MutableData<T>(),
+                                   SafeInt<size_t>(sequence_length) * batch_size * num_heads_ * head_size);
+    }
+
+    return Status::OK();
+  }
+
+  // Same as ApplyAttention with a quantized KV cache: past and present key and value are int8 or float8, with the
+  // scales in k_scale and v_scale of shape (1) or (N_kv). The new K and V are quantized into present, and each KV head
+  // is dequantized to fp32 once for all the query heads of its group.
+  template <typename T, typename TCache>
+  Status ApplyQuantizedKVAttention(const T* Q,                                 // Q data with shape BxNxSxH
+                                   const T* K,                                 // K data with shape BxN_kvxSxH
+                                   const T* V,                                 // V data with shape BxN_kvxSxH
+                                   const Tensor* past_key,                     // past K input tensor
+                                   const Tensor* past_value,                   // past V input tensor
+                                   Tensor* output,                             // output tensor
+                                   Tensor* present_key,                        // present K output tensor
+                                   Tensor* present_value,                      // present V output tensor
+                                   const Tensor* seqlens_k,                    // past sequence lengths tensor
+                                   const Tensor* k_scale,                      // scales of the key cache
+                                   const Tensor* v_scale,                      // scales of the value cache
+                                   GroupQueryAttentionParameters& parameters,  // attention parameters
+                                   AllocatorPtr allocator,                     // allocator for temporary tensors
+                                   OpKernelContext* context) const {
+    const bool is_prompt = parameters.is_first_prompt;
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const size_t batch_size = parameters.batch_size;
+    const size_t sequence_length = parameters.sequence_length;
+    const size_t head_size = parameters.head_size;
+    const size_t hidden_size = parameters.hidden_size;
+    const size_t past_buffer_sequence_length = static_cast<size_t>(past_key->Shape()[2]);
+    const size_t present_buffer_sequence_length = static_cast<size_t>(present_key->Shape()[2]);
+    const int32_t* seqlens_k_data = seqlens_k->Data<int32_t>();
+    const float* k_scales = k_scale->Data<float>();
+    const float* v_scales = v_scale->Data<float>();
+    const bool per_head_scales = k_scale->Shape().Size() > 1 || v_scale->Shape().Size() > 1;
+
+    const TCache* past_key_data = past_key->Data<TCache>();
+    const TCache* past_value_data = past_value->Data<TCache>();
+    TCache* present_key_data = present_key->MutableData<TCache>();
+    TCache* present_value_data = present_value->MutableData<TCache>();
+    const bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
+
+    auto* tp = context->GetOperatorThreadPool();
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const T* k_input = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const T* v_input = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+
+    auto new_kv = [&](const T* input, size_t batch_index, size_t kv_head_index) {
+      return packed_qkv ? input + packed_batch_stride * batch_index + sequence_length * head_size * kv_head_index
+                        : input + sequence_length * head_size * (batch_index * kv_num_heads_ + kv_head_index);
+    };
+    auto past_seqlen_of = [&](size_t total_seqlen) {
+      return is_prompt ? size_t{0} : total_seqlen - sequence_length;  // Assume no padding sequence length
+    };
+    auto scale_of = [&](const float* scales, size_t kv_head_index) {
+      return per_head_scales ? scales[kv_head_index] : scales[0];
+    };
+
+    // Quantize the new K and V into present, after the past K and V when present does not share buffer with past.
+    TensorOpCost copy_cost;
+    copy_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(4) * sequence_length * head_size);
+    copy_cost.bytes_loaded = static_cast<double>(2 * sequence_length * head_size * sizeof(T));
+    copy_cost.bytes_stored = static_cast<double>(2 * sequence_length * head_size * sizeof(TCache));
+    if (!past_present_share_buffer) {
+      const double bytes_to_copy = static_cast<double>(2 * past_buffer_sequence_length * head_size * sizeof(TCache));
+      copy_cost.bytes_loaded += bytes_to_copy;
+      copy_cost.bytes_stored += bytes_to_copy;
+    }
+    ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, copy_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t kv_head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[batch_index]) + 1;
+        const size_t past_seqlen = past_seqlen_of(total_seqlen);
+        const size_t num_new = std::min(sequence_length, total_seqlen - past_seqlen);
+        TCache* present_k = present_key_data + SafeInt<ptrdiff_t>(i) * present_buffer_sequence_length * head_size;
+        TCache* present_v = present_value_data + SafeInt<ptrdiff_t>(i) * present_buffer_sequence_length * head_size;
+        if (!past_present_share_buffer) {
+          const ptrdiff_t past_offset = SafeInt<ptrdiff_t>(i) * past_buffer_sequence_length * head_size;
+          memcpy(present_k, past_key_data + past_offset, past_seqlen * head_size * sizeof(TCache));
+          memcpy(present_v, past_value_data + past_offset, past_seqlen * head_size * sizeof(TCache));
+        }
+        QuantizeKV(new_kv(k_input, batch_index, kv_head_index), present_k + past_seqlen * head_size,
+                   num_new * head_size, 1.0f / scale_of(k_scales, kv_head_index));
+        QuantizeKV(new_kv(v_input, batch_index, kv_head_index), present_v + past_seqlen * head_size,
+                   num_new * head_size, 1.0f / scale_of(v_scales, kv_head_index));
+      }
+    });
+
+    size_t output_fp32_bytes = 0;
+    if constexpr (std::is_same<T, MLFloat16>::value) {
+      output_fp32_bytes = SafeInt<size_t>(sequence_length) * batch_size * num_heads_ * head_size * sizeof(float);
+    }
+    auto output_fp32 = static_cast<float*>(allocator->Alloc(output_fp32_bytes));
+    BufferUniquePtr output_fp32_buffer(output_fp32, BufferDeleter(allocator));
+    float* output_data = output_fp32;
+    if constexpr (std::is_same<T, float>::value) {
+      output_data = output->MutableData<T>();
+    }
+
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(4) * kv_num_heads_factor * sequence_length *
+                                                   head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded = static_cast<double>(kv_num_heads_factor * sequence_length * head_size * sizeof(T) +
+                                                 2 * present_buffer_sequence_length * head_size * sizeof(TCache));
+    unit_cost.bytes_stored = static_cast<double>(kv_num_heads_factor * sequence_length *
+                                                 (present_buffer_sequence_length + head_size) * sizeof(float));
+
+    ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      // K and V of a KV head, and Q and the attention probs of a query head, in fp32
+      size_t scratch_bytes = SafeInt<size_t>(sequence_length + 2 * head_size) * present_buffer_sequence_length;
+      if constexpr (std::is_same<T, MLFloat16>::value) {
+        scratch_bytes += SafeInt<size_t>(sequence_length) * head_size;
+      }
+      scratch_bytes *= sizeof(float);
+      auto scratch = static_cast<float*>(allocator->Alloc(scratch_bytes));
+      BufferUniquePtr scratch_buffer(scratch, BufferDeleter(allocator));
+      float* k_fp32 = scratch;
+      float* v_fp32 = k_fp32 + present_buffer_sequence_length * head_size;
+      float* probs = v_fp32 + present_buffer_sequence_length * head_size;
+      float* q_fp32 = probs + sequence_length * present_buffer_sequence_length;
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t kv_head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[batch_index]) + 1;
+        const size_t past_seqlen = past_seqlen_of(total_seqlen);
+        const ptrdiff_t present_offset = SafeInt<ptrdiff_t>(i) * present_buffer_sequence_length * head_size;
+        DequantizeKV(present_key_data + present_offset, k_fp32, total_seqlen * head_size,
+                     scale_of(k_scales, kv_head_index));
+        DequantizeKV(present_value_data + present_offset, v_fp32, total_seqlen * head_size,
+                     scale_of(v_scales, kv_head_index));
+
+        for (size_t g = 0; g < kv_num_heads_factor; ++g) {
+          const size_t head_index = kv_head_index * kv_num_heads_factor + g;
+          const T* q = packed_qkv ? Q + packed_batch_stride * batch_index + sequence_length * head_size * head_index
+                                  : Q + sequence_length * head_size * (batch_index * num_heads_ + head_index);
+          const float* q_data;
+          if constexpr (std::is_same<T, float>::value) {
+            q_data = q;
+          } else {
+            MlasConvertHalfToFloatBuffer(q, q_fp32, head_size * sequence_length);
+            q_data = q_fp32;
+          }
+
+          // attention_probs(S, T) = alpha * Q(S, H) x K'(H, T)
+          math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seqlen, head_size, alpha,
+                                          q_data, static_cast<int>(head_size), k_fp32, static_cast<int>(head_size),
+                                          0.0f /*beta*/, probs, static_cast<int>(total_seqlen), nullptr);
+
+          ComputeCausalSoftmax(probs, past_seqlen, sequence_length, total_seqlen, total_seqlen);
+
+          // out(S, H) = attention_probs(S, T) x V(T, H)
+          float* output_current = output_data + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+          math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, total_seqlen, 1.f,
+                                          probs, static_cast<int>(total_seqlen), v_fp32, static_cast<int>(head_size),
+                                          0.0f /*beta*/, output_current, static_cast<int>(hidden_size), nullptr);
+        }
+      }
+    });
+
+    if constexpr (std::is_same<T, MLFloat16>::value) {
+      MlasConvertFloatToHalfBuffer(output_fp32, output->MutableData<T>(),
+                                   SafeInt<size_t>(sequence_length) * batch_size * num_heads_ * head_size);
+    }
+
+    return Status::OK();
+  }
+
  private:
+  // Quantizes `count` elements of K or V to the type of a quantized KV cache, rounding to nearest.
+  template <typename T, typename TCache>
+  static void QuantizeKV(const T* input, TCache* output, size_t count, float inv_scale) {
+    for (size_t j = 0; j < count; ++j) {
+      const float x = static_cast<float>(input[j]) * inv_scale;
+      if constexpr (std::is_same<TCache, int8_t>::value) {
+        output[j] = static_cast<int8_t>(std::clamp(std::nearbyint(x), -127.0f, 127.0f));
+      } else {
+        output[j] = TCache(x, true /*saturate*/);
+      }
+    }
+  }
+
+  template <typename TCache>
+  static void DequantizeKV(const TCache* input, float* output, size_t count, float scale) {
+    for (size_t j = 0; j < count; ++j) {
+      output[j] = static_cast<float>(input[j]) * scale;
+    }
+  }
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
@@ -214,45 +603,50 @@ class GQAAttentionBase {
                                           output, static_cast<int>(present_buffer_sequence_length), nullptr);
         }
 
-        // compute Softmax
-        float* output_softmax = output;
-        for (size_t seq = 0; seq < sequence_length; seq++) {
-          size_t seq_causal_length = past_seqlen + seq + 1;
-          if (local_window_size_ > 0 && seq_causal_length > static_cast<size_t>(local_window_size_) + 1) {
-            for (size_t total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_ - 1; total_seq_id++) {
-              output_softmax[total_seq_id] = 0.f;
-            }
-            if (softcap_ > 0.f) {
-              ComputeAttentionSoftcapInplace(output_softmax + seq_causal_length - local_window_size_ - 1,
-                                             local_window_size_ + 1, softcap_);
-            }
-            if (use_smooth_softmax_) {
-              ComputeSmoothSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
-                                          local_window_size_ + 1, nullptr);
-            } else {
-              ComputeAttentionSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
-                                             local_window_size_ + 1, nullptr);
-            }
-          } else {
-            if (softcap_ > 0.f) {
-              ComputeAttentionSoftcapInplace(output_softmax, static_cast<int>(seq_causal_length), softcap_);
-            }
-            if (use_smooth_softmax_) {
-              ComputeSmoothSoftmaxInplace(output_softmax, 1, static_cast<int>(seq_causal_length), nullptr);
-            } else {
-              ComputeAttentionSoftmaxInplace(output_softmax, 1, static_cast<int>(seq_causal_length), nullptr);
-            }
-          }
-
-          // set causal [seq_causal_length, total_seqlen) to 0.f
-          for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
-            output_softmax[total_seq_id] = 0.f;
-          }
+        ComputeCausalSoftmax(output, past_seqlen, sequence_length, total_seqlen, present_buffer_sequence_length);
+      }
+    });
+  }
 
-          output_softmax += present_buffer_sequence_length;
+  // Applies the causal mask, local window, softcap and softmax to the attention probs of one head.
+  // Rows of the probs are `row_stride` apart.
+  void ComputeCausalSoftmax(float* output_softmax, size_t past_seqlen, size_t sequence_length, size_t total_seqlen,
+                            size_t row_stride) const {
+    for (size_t seq = 0; seq < sequence_length; seq++) {
+      size_t seq_causal_length = past_seqlen + seq + 1;
+      if (local_window_size_ > 0 && seq_causal_length > static_cast<size_t>(local_window_size_) + 1) {
+        for (size_t total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_ - 1; total_seq_id++) {
+          output_softmax[total_seq_id] = 0.f;
+        }
+        if (softcap_ > 0.f) {
+          ComputeAttentionSoftcapInplace(output_softmax + seq_causal_length - local_window_size_ - 1,
+                                         local_window_size_ + 1, softcap_);
+        }
+        if (use_smooth_softmax_) {
+          ComputeSmoothSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
+                                      local_window_size_ + 1, nullptr);
+        } else {
+          ComputeAttentionSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
+                                         local_window_size_ + 1, nullptr);
+        }
+      } else {
+        if (softcap_ > 0.f) {
+          ComputeAttentionSoftcapInplace(output_softmax, static_cast<int>(seq_causal_length), softcap_);
+        }
+        if (use_smooth_softmax_) {
+          ComputeSmoothSoftmaxInplace(output_softmax, 1, static_cast<int>(seq_causal_length), nullptr);
+        } else {
+          ComputeAttentionSoftmaxInplace(output_softmax, 1, static_cast<int>(seq_causal_length), nullptr);
         }
       }
-    });
+
+      // set causal [seq_causal_length, total_seqlen) to 0.f
+      for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
+        output_softmax[total_seq_id] = 0.f;
+      }
+
+      output_softmax += row_stride;
+    }
   }
 
   template <typename T>
@@ -21,6 +21,18 @@ using onnxruntime::concurrency::ThreadPool;
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+// The KV cache is either of the type of query or quantized.
+template <typename T>
+std::vector<MLDataType> KVCacheTypes() {
+  return {DataTypeImpl::GetTensorType<T>(),
+#if !defined(DISABLE_FLOAT8_TYPES)
+          DataTypeImpl::GetTensorType<Float8E4M3FN>(),
+#endif
+          DataTypeImpl::GetTensorType<int8_t>()};
+}
+}  // namespace
+
 // These ops are internal-only, so register outside of onnx
 #define REGISTER_KERNEL_TYPED(T)                                        \
   ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
@@ -31,6 +43,7 @@ namespace contrib {
       kCpuExecutionProvider,                                            \
       KernelDefBuilder()                                                \
           .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
+          .TypeConstraint("T_CACHE", KVCacheTypes<T>())                 \
           .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()), \
       GroupQueryAttention<T>);
 
@@ -52,6 +65,9 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const Tensor* total_seqlen_tensor = context->Input<Tensor>(6);
   const Tensor* cos_cache = context->Input<Tensor>(7);
   const Tensor* sin_cache = context->Input<Tensor>(8);
+  const Tensor* block_table = context->Input<Tensor>(9);
+  const Tensor* k_scale = context->Input<Tensor>(10);
+  const Tensor* v_scale = context->Input<Tensor>(11);
 
   GroupQueryAttentionParameters parameters = {};
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
@@ -67,7 +83,17 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
                                                                 seqlens_k,
                                                                 total_seqlen_tensor,
                                                                 scale_,
-                                                                softcap_));
+                                                                softcap_,
+                                                                block_table));
+
+  const bool is_quantized_kv_cache = k_scale != nullptr || v_scale != nullptr;
+  if (is_quantized_kv_cache) {
+    ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckQuantizedKVCacheInputs(
+        past_key, past_value, k_scale, v_scale, kv_num_heads_, block_table != nullptr));
+  } else if (past_key != nullptr && !past_key->IsDataType<T>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'k_scale' and 'v_scale' are required when past_key is not of the type of query.");
+  }
 
   const int batch_size = parameters.batch_size;
   const int sequence_length = parameters.sequence_length;
@@ -82,10 +108,15 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   output_shape[2] = static_cast<int64_t>(q_hidden_size);
   Tensor* output = context->Output(0, output_shape);
 
+  const bool is_paged_kv_cache = block_table != nullptr;
   std::vector<int64_t> present_k_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(head_size)});
   std::vector<int64_t> present_v_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(head_size)});
-  Tensor* present_k = context->Output(1, present_k_shape);
-  Tensor* present_v = context->Output(2, present_v_shape);
+  Tensor* present_k = context->Output(1, is_paged_kv_cache ? past_key->Shape() : TensorShape(present_k_shape));
+  Tensor* present_v = context->Output(2, is_paged_kv_cache ? past_value->Shape() : TensorShape(present_v_shape));
+  if (is_paged_kv_cache && (present_k == nullptr || present_v == nullptr)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Output 'present_key' and 'present_value' are required with a paged KV cache.");
+  }
 
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
@@ -94,14 +125,19 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   OrtValue Q;
   OrtValue K;
   OrtValue V;
+  // With rotary embedding, Q and K are transposed to BNSH by the rotary embedding pass below.
   if (packed_qkv) {
-    ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
-        allocator, batch_size, num_heads_ + 2 * kv_num_heads_, sequence_length, head_size, query, Q));
+    if (!do_rotary_) {
+      ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
+          allocator, batch_size, num_heads_ + 2 * kv_num_heads_, sequence_length, head_size, query, Q));
+    }
   } else {
-    ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
-        allocator, batch_size, num_heads_, sequence_length, head_size, query, Q));
-    ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
-        allocator, batch_size, kv_num_heads_, sequence_length, head_size, key, K));
+    if (!do_rotary_) {
+      ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
+          allocator, batch_size, num_heads_, sequence_length, head_size, query, Q));
+      ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
+          allocator, batch_size, kv_num_heads_, sequence_length, head_size, key, K));
+    }
     ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
         allocator, batch_size, kv_num_heads_, sequence_length, head_size, value, V));
   }
@@ -109,8 +145,8 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   OrtValue RotaryQKV;
   OrtValue RotaryQ;
   OrtValue RotaryK;
-  T* q_rotary = Q.GetMutable<Tensor>()->MutableData<T>();
-  T* k_rotary = packed_qkv ? nullptr : K.GetMutable<Tensor>()->MutableData<T>();
+  T* q_rotary = do_rotary_ ? nullptr : Q.GetMutable<Tensor>()->MutableData<T>();
+  T* k_rotary = (do_rotary_ || packed_qkv) ? nullptr : K.GetMutable<Tensor>()->MutableData<T>();
   if (do_rotary_) {
     // Initialize rotary parameters
     rotary_embedding_helper::RotaryParameters rotary_params = {};
@@ -121,11 +157,16 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
     rotary_params.rotary_embedding_dim = parameters.rotary_dim;
     rotary_params.num_heads = num_heads_;
     rotary_params.max_sequence_length = sequence_length;  // unused
-    rotary_params.seq_stride = head_size;
-    rotary_params.head_stride = sequence_length * rotary_params.seq_stride;
-    rotary_params.batch_stride = (packed_qkv ? (num_heads_ + 2 * kv_num_heads_) : num_heads_) * rotary_params.head_stride;
+    // The input is BSNH, from query (and key), and the output is BNSH.
+    const int q_num_heads = packed_qkv ? (num_heads_ + 2 * kv_num_heads_) : num_heads_;
+    rotary_params.head_stride = head_size;
+    rotary_params.seq_stride = q_num_heads * head_size;
+    rotary_params.batch_stride = sequence_length * rotary_params.seq_stride;
     rotary_params.position_ids_format = !parameters.is_first_prompt ? 1 : 0;
-    rotary_params.transposed = true;
+    rotary_params.transposed = false;
+    const int output_seq_stride = head_size;
+    const int output_head_stride = sequence_length * output_seq_stride;
+    int output_batch_stride = q_num_heads * output_head_stride;
     auto* tp = context->GetOperatorThreadPool();
     // Generate position ids
     const int pos_ids_size = parameters.is_first_prompt ? 1 : batch_size * sequence_length;
@@ -151,47 +192,78 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
     const T* k_input;
     if (packed_qkv) {
       Tensor::InitOrtValue(element_type, TensorShape({batch_size, num_heads_ + 2 * kv_num_heads_, sequence_length, head_size}), allocator, RotaryQKV);
-      q_input = Q.Get<Tensor>().Data<T>();
-      k_input = q_input + num_heads_ * sequence_length * head_size;
+      q_input = query->Data<T>();
+      k_input = q_input + num_heads_ * head_size;
       q_rotary = RotaryQKV.GetMutable<Tensor>()->MutableData<T>();
       k_rotary = q_rotary + num_heads_ * sequence_length * head_size;
     } else {
       Tensor::InitOrtValue(element_type, TensorShape({batch_size, num_heads_, sequence_length, head_size}), allocator, RotaryQ);
       Tensor::InitOrtValue(element_type, TensorShape({batch_size, kv_num_heads_, sequence_length, head_size}), allocator, RotaryK);
-      q_input = Q.Get<Tensor>().Data<T>();
-      k_input = K.Get<Tensor>().Data<T>();
+      q_input = query->Data<T>();
+      k_input = key->Data<T>();
       q_rotary = RotaryQ.GetMutable<Tensor>()->MutableData<T>();
       k_rotary = RotaryK.GetMutable<Tensor>()->MutableData<T>();
     }
     // Run rotary embedding for Q and K
     ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, q_input,
                                               pos_ids.data(), cos_cache->Data<T>(),
-                                              sin_cache->Data<T>(), q_rotary, rotary_interleaved_));
+                                              sin_cache->Data<T>(), q_rotary,
+                                              output_head_stride, output_seq_stride, output_batch_stride,
+                                              rotary_interleaved_));
 
     rotary_params.num_heads = kv_num_heads_;
     rotary_params.hidden_size = parameters.kv_hidden_size;
     if (!packed_qkv) {
-      rotary_params.batch_stride = kv_num_heads_ * rotary_params.head_stride;
+      rotary_params.seq_stride = kv_num_heads_ * head_size;
+      rotary_params.batch_stride = sequence_length * rotary_params.seq_stride;
+      output_batch_stride = kv_num_heads_ * output_head_stride;
     }
     ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, k_input,
                                               pos_ids.data(), cos_cache->Data<T>(),
-                                              sin_cache->Data<T>(), k_rotary, rotary_interleaved_));
-    // Pack V into rotary QKV buffer
+                                              sin_cache->Data<T>(), k_rotary,
+                                              output_head_stride, output_seq_stride, output_batch_stride,
+                                              rotary_interleaved_));
+    // Transpose V into rotary QKV buffer
     if (packed_qkv) {
-      const T* v_input = k_input + kv_num_heads_ * sequence_length * head_size;
+      const T* v_input = k_input + kv_num_heads_ * head_size;
       T* v_rotary = k_rotary + kv_num_heads_ * sequence_length * head_size;
-      ORT_RETURN_IF_ERROR(rotary_helper::PackVIntoRotaryQKV<T>(tp,
-                                                               parameters.batch_size,
-                                                               parameters.sequence_length,
-                                                               parameters.num_heads,
-                                                               parameters.kv_num_heads,
-                                                               parameters.head_size,
-                                                               v_input,
-                                                               v_rotary));
+      ORT_RETURN_IF_ERROR(rotary_helper::TransposeVIntoRotaryQKV<T>(tp,
+                                                                    parameters.batch_size,
+                                                                    parameters.sequence_length,
+                                                                    parameters.num_heads,
+                                                                    parameters.kv_num_heads,
+                                                                    parameters.head_size,
+                                                                    v_input,
+                                                                    v_rotary));
     }
   }
 
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  if (is_paged_kv_cache) {
+    return ApplyPagedAttention(q_rotary, packed_qkv ? nullptr : k_rotary,
+                               packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(), past_key, past_value, output,
+                               present_k, present_v, seqlens_k, block_table, parameters, allocator, context);
+  }
+
+  if (is_quantized_kv_cache) {
+    ORT_RETURN_IF_NOT(present_k != nullptr && present_v != nullptr &&
+                          present_k->GetElementType() == past_key->GetElementType() &&
+                          present_v->GetElementType() == past_value->GetElementType(),
+                      "Output 'present_key' and 'present_value' shall have the type of the quantized KV cache.");
+    const T* k_data = packed_qkv ? nullptr : k_rotary;
+    const T* v_data = packed_qkv ? nullptr : V.Get<Tensor>().Data<T>();
+#if !defined(DISABLE_FLOAT8_TYPES)
+    if (past_key->IsDataType<Float8E4M3FN>()) {
+      return ApplyQuantizedKVAttention<T, Float8E4M3FN>(q_rotary, k_data, v_data, past_key, past_value, output,
+                                                        present_k, present_v, seqlens_k, k_scale, v_scale,
+                                                        parameters, allocator, context);
+    }
+#endif
+    return ApplyQuantizedKVAttention<T, int8_t>(q_rotary, k_data, v_data, past_key, past_value, output, present_k,
+                                                present_v, seqlens_k, k_scale, v_scale, parameters, allocator,
+                                                context);
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(q_rotary, packed_qkv ? nullptr : k_rotary, packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
                         past_key, past_value, output, present_k, present_v,
@@ -24,10 +24,15 @@ Status CheckInputs(const Tensor* query,
                    const Tensor* seqlens_k,
                    const Tensor* total_seqlen,
                    float scale,
-                   float softcap) {
+                   float softcap,
+                   const Tensor* block_table = nullptr) {
   // Note: Here S* is seqlen_past_kv_cache, S+ is seqlen_present_kv_cache
   //     past_key                   : (B, N_k, S*, H) or (B, N_k, S+, H) or nullptr
   //     past_value                 : (B, N_k, S*, H) or (B, N_k, S+, H) or nullptr
+  // paged KV cache:
+  //     block_table                : (B, max_num_blocks_per_seq)
+  //     past_key                   : (num_blocks, block_size, N_k, H)
+  //     past_value                 : (num_blocks, block_size, N_k, H)
   // no packing for q/k/v:
   //     query            (Q)       : (B, S, D) or (B, S, (D_q + 2 D_kv))
   //     key              (K)       : (B, S, D_kv) or nullptr
@@ -110,7 +115,38 @@ Status CheckInputs(const Tensor* query,
 
   // Check past-present KV
   int32_t past_sequence_length = 0;
-  if (past_key != nullptr && past_value != nullptr) {
+  int kv_cache_block_size = 0;
+  int max_num_blocks_per_seq = 0;
+  if (block_table != nullptr) {
+    if (past_key == nullptr || past_value == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_key' and 'past_value' shall be present with a paged KV cache.");
+    }
+
+    const auto& block_table_dims = block_table->Shape().GetDims();
+    if (block_table_dims.size() != 2 || block_table_dims[0] != batch_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'block_table' is expected to have shape (batch_size, max_num_blocks_per_seq).");
+    }
+
+    const auto& past_key_dims = past_key->Shape().GetDims();
+    if (past_key_dims.size() != 4 || past_key->Shape() != past_value->Shape()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_key' and 'past_value' of a paged KV cache shall have the same shape "
+                             "(num_blocks, block_size, kv_num_heads, head_size).");
+    }
+    if (past_key_dims[2] != kv_num_heads || past_key_dims[3] != head_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_key' of a paged KV cache shall have kv_num_heads in dimension 2 and "
+                             "head_size in dimension 3.");
+    }
+
+    kv_cache_block_size = static_cast<int>(past_key_dims[1]);
+    max_num_blocks_per_seq = static_cast<int>(block_table_dims[1]);
+    // capacity of each sequence
+    past_sequence_length = kv_cache_block_size * max_num_blocks_per_seq;
+    past_kv_format = Q_K_V_BSNH;
+  } else if (past_key != nullptr && past_value != nullptr) {
     const auto& past_key_dims = past_key->Shape().GetDims();
     const auto& past_value_dims = past_value->Shape().GetDims();
 
@@ -181,6 +217,11 @@ Status CheckInputs(const Tensor* query,
   }
   int total_sequence_length = *((*total_seqlen).template Data<int32_t>());
   int present_sequence_length = std::max(total_sequence_length, past_sequence_length);
+  if (block_table != nullptr && total_sequence_length > past_sequence_length) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "total_sequence_length ", total_sequence_length,
+                           " exceeds the capacity of the blocks in block_table: ", past_sequence_length);
+  }
 
   int rotary_dim = 0;
   if (cos_cache != nullptr && sin_cache != nullptr) {
@@ -260,6 +301,8 @@ Status CheckInputs(const Tensor* query,
     output_parameters->softcap = softcap;
     output_parameters->qkv_format = qkv_format;
     output_parameters->past_kv_format = past_kv_format;
+    output_parameters->kv_cache_block_size = kv_cache_block_size;
+    output_parameters->max_num_blocks_per_seq = max_num_blocks_per_seq;
   }
 
   return Status::OK();
@@ -279,13 +322,58 @@ Status CheckInputs(const Tensor* query,
                    const Tensor* total_seqlen,
                    float scale,
                    float softcap,
-                   int max_threads_per_block) {
+                   int max_threads_per_block,
+                   const Tensor* block_table = nullptr) {
   if (max_threads_per_block > 0 && num_heads > max_threads_per_block) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "num_heads should be no larger than ", max_threads_per_block);
   }
 
-  return CheckInputs(query, key, value, past_key, past_value, cos_cache, sin_cache, parameters, num_heads, kv_num_heads, seqlens_k, total_seqlen, scale, softcap);
+  return CheckInputs(query, key, value, past_key, past_value, cos_cache, sin_cache, parameters, num_heads, kv_num_heads, seqlens_k, total_seqlen, scale, softcap, block_table);
+}
+
+// Checks the inputs of a quantized KV cache, where past and present key and value are int8 or float8 and k_scale and
+// v_scale have one scale for all heads or one per KV head.
+inline Status CheckQuantizedKVCacheInputs(const Tensor* past_key,
+                                          const Tensor* past_value,
+                                          const Tensor* k_scale,
+                                          const Tensor* v_scale,
+                                          int kv_num_heads,
+                                          bool is_paged_kv_cache) {
+  if (k_scale == nullptr || v_scale == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'k_scale' and 'v_scale' shall be both present or both absent.");
+  }
+  if (is_paged_kv_cache) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "A quantized KV cache is not supported with a paged KV cache.");
+  }
+  if (past_key == nullptr || past_value == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall be present with a quantized KV cache.");
+  }
+  if (past_key->GetElementType() != past_value->GetElementType()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall have the same type with a quantized KV cache.");
+  }
+  bool is_quantized_type = past_key->IsDataType<int8_t>();
+#if !defined(DISABLE_FLOAT8_TYPES)
+  is_quantized_type = is_quantized_type || past_key->IsDataType<Float8E4M3FN>();
+#endif
+  if (!is_quantized_type) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall be int8 or float8e4m3fn with a quantized KV cache.");
+  }
+  for (const Tensor* scale : {k_scale, v_scale}) {
+    const auto& dims = scale->Shape().GetDims();
+    if (dims.size() != 1 || (dims[0] != 1 && dims[0] != kv_num_heads)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'k_scale' and 'v_scale' shall have shape (1) or (kv_num_heads), got ",
+                             scale->Shape());
+    }
+  }
+
+  return Status::OK();
 }
+
 }  // namespace group_query_attention_helper
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -62,7 +62,8 @@ Status Check_Q_KV(const T* query, const T* packed_kv, int num_heads, int head_si
 
 template <typename T>
 Status Check_Q_K_V(const T* query, const T* key, const T* value, int num_heads, int head_size,
-                   AttentionQkvFormat& qkv_format, int& kv_sequence_length, int& v_hidden_size) {
+                   AttentionQkvFormat& qkv_format, int& kv_sequence_length, int& v_hidden_size,
+                   bool allow_shared_kv_batch = false) {
   const auto& query_dims = query->Shape().GetDims();
   const auto& key_dims = key->Shape().GetDims();
   const auto& value_dims = value->Shape().GetDims();
@@ -76,7 +77,11 @@ Status Check_Q_K_V(const T* query, const T* key, const T* value, int num_heads,
                            "Expect rank of key and value be same, and either 3 or 4");
   }
 
-  if (key_dims[0] != query_dims[0] || value_dims[0] != query_dims[0]) {
+  // BNSH key and value may be shared by several query batch entries (like the beams of beam search), in which case
+  // the batch size of the query is a multiple of theirs. The caller checks the actual multiple.
+  const bool shared_kv_batch = allow_shared_kv_batch && key_dims.size() == 4 && value_dims[0] == key_dims[0] &&
+                               key_dims[0] > 0 && query_dims[0] % key_dims[0] == 0;
+  if (!shared_kv_batch && (key_dims[0] != query_dims[0] || value_dims[0] != query_dims[0])) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                            "Input 'query', 'key' and 'value' shall have same dim 0 (batch_size)");
   }
@@ -344,7 +349,8 @@ Status CheckInputs(const T* query,
       ORT_RETURN_IF_ERROR(Check_Q_KV<T>(query, key, num_heads, head_size, qkv_format, kv_sequence_length));
     } else {
       ORT_RETURN_IF_ERROR(Check_Q_K_V<T>(query, key, value, num_heads, head_size,
-                                         qkv_format, kv_sequence_length, v_hidden_size));
+                                         qkv_format, kv_sequence_length, v_hidden_size,
+                                         operator_type == kDecoderMaskedMultiHeadAttention && past_key == nullptr));
     }
   } else if (value == nullptr) {  // no key and value
     ORT_RETURN_IF_ERROR(Check_QKV<T>(query, qkv_format));
@@ -4,8 +4,14 @@
 #include "contrib_ops/cpu/bert/rotary_embedding.h"
 #include "contrib_ops/cpu/bert/rotary_embedding_helper.h"
 
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 using onnxruntime::concurrency::ThreadPool;
 using namespace onnxruntime::contrib::rotary_embedding_helper;
 
@@ -41,10 +47,36 @@ RotaryEmbedding<T>::RotaryEmbedding(const OpKernelInfo& info) : OpKernel(info) {
   }
 }
 
-// TODO: rotary embedding in place
+namespace {
+// Rotates the (x1, x2) pairs of one head, which are the adjacent elements (2i, 2i + 1) when interleaved, or the
+// elements (i, i + half_rotary_emb_dim) otherwise. Both loops have no data dependent branch or index computation,
+// so compilers vectorize them for the target instruction set.
+void ApplyRotary(const float* input, const float* cos_data, const float* sin_data, float* output,
+                 int half_rotary_emb_dim, bool interleaved) {
+  if (interleaved) {
+    for (int i = 0; i < half_rotary_emb_dim; i++) {
+      const float x1 = input[2 * i];
+      const float x2 = input[2 * i + 1];
+      output[2 * i] = x1 * cos_data[i] - x2 * sin_data[i];
+      output[2 * i + 1] = x2 * cos_data[i] + x1 * sin_data[i];
+    }
+  } else {
+    const float* input_2 = input + half_rotary_emb_dim;
+    float* output_2 = output + half_rotary_emb_dim;
+    for (int i = 0; i < half_rotary_emb_dim; i++) {
+      const float x1 = input[i];
+      const float x2 = input_2[i];
+      output[i] = x1 * cos_data[i] - x2 * sin_data[i];
+      output_2[i] = x2 * cos_data[i] + x1 * sin_data[i];
+    }
+  }
+}
+}  // namespace
+
 template <typename T>
 Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters parameters, const T* input,
                           const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
+                          int output_head_stride, int output_seq_stride, int output_batch_stride,
                           bool interleaved) {
   const int batch_size = parameters.batch_size;
   const int sequence_length = parameters.sequence_length;
@@ -60,15 +92,20 @@ Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters paramete
   const int loop_len = batch_size * sequence_length * n_heads;
   const double cost = static_cast<double>(rotary_emb_dim);
   ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    // fp16 heads are rotated in float, converted with the vectorized MLAS routines.
+    // The buffer holds the input and output of the head, then the cos and sin of the position.
+    std::vector<float> fp32_buffer;
+    if constexpr (!std::is_same_v<T, float>) {
+      fp32_buffer.resize(SafeInt<size_t>(rotary_emb_dim) * 3);
+    }
+
     for (std::ptrdiff_t ptr = begin; ptr != end; ++ptr) {
       const int b = static_cast<int>((ptr / n_heads) / sequence_length);
       const int s = static_cast<int>((ptr / n_heads) % sequence_length);
       const int n = static_cast<int>(ptr % n_heads);
 
-      const int block_offset = b * batch_stride + s * seq_stride + n * head_stride;
-
-      const T* input_data = input + block_offset;
-      T* output_data = output + block_offset;
+      const T* input_data = input + b * batch_stride + s * seq_stride + n * head_stride;
+      T* output_data = output + b * output_batch_stride + s * output_seq_stride + n * output_head_stride;
 
       // Cache is (M, H/2) or (M, rotary_embedding_dim/2)
       const int position_id = (position_ids_format == 0)
@@ -78,31 +115,22 @@ Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters paramete
       const T* cos_data = cos_cache + cache_offset;
       const T* sin_data = sin_cache + cache_offset;
 
-      int cache_idx = 0;
-      bool sign = false;
-      int j = 0;
-      for (int i = 0; i < rotary_emb_dim; i++) {
-        if (interleaved) {
-          cache_idx = (i / 2) % half_rotary_emb_dim;
-          sign = i & 1;
-          j = sign ? i - 1 : i + 1;  // i - sign
-        } else {
-          cache_idx = i % half_rotary_emb_dim;
-          sign = (i >= half_rotary_emb_dim);
-          j = (i + half_rotary_emb_dim) % rotary_emb_dim;
-        }
-        float output_data_i = static_cast<float>(input_data[i]) * static_cast<float>(cos_data[cache_idx]);
-        float input_data_j = static_cast<float>(input_data[j]);
-        float sin_data_cache_idx = static_cast<float>(sin_data[cache_idx]);
-        if (sign) {
-          output_data_i += input_data_j * sin_data_cache_idx;
-        } else {
-          output_data_i -= input_data_j * sin_data_cache_idx;
-        }
-        output_data[i] = static_cast<T>(output_data_i);
+      if constexpr (std::is_same_v<T, float>) {
+        ApplyRotary(input_data, cos_data, sin_data, output_data, half_rotary_emb_dim, interleaved);
+      } else {
+        float* input_fp32 = fp32_buffer.data();
+        float* output_fp32 = input_fp32 + rotary_emb_dim;
+        float* cos_fp32 = output_fp32 + rotary_emb_dim;
+        float* sin_fp32 = cos_fp32 + half_rotary_emb_dim;
+        MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(input_data), input_fp32, rotary_emb_dim);
+        MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(cos_data), cos_fp32, half_rotary_emb_dim);
+        MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(sin_data), sin_fp32, half_rotary_emb_dim);
+        ApplyRotary(input_fp32, cos_fp32, sin_fp32, output_fp32, half_rotary_emb_dim, interleaved);
+        MlasConvertFloatToHalfBuffer(output_fp32, reinterpret_cast<MLAS_FP16*>(output_data), rotary_emb_dim);
       }
-      for (int i = rotary_emb_dim; i < head_size; i++) {
-        output_data[i] = input_data[i];
+
+      if (rotary_emb_dim < head_size) {
+        std::copy(input_data + rotary_emb_dim, input_data + head_size, output_data + rotary_emb_dim);
       }
     }
   });
@@ -110,6 +138,14 @@ Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters paramete
   return Status::OK();
 }
 
+template <typename T>
+Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters parameters, const T* input,
+                          const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
+                          bool interleaved) {
+  return RunRotaryEmbedding<T>(tp, parameters, input, position_ids, cos_cache, sin_cache, output,
+                               parameters.head_stride, parameters.seq_stride, parameters.batch_stride, interleaved);
+}
+
 template Status RunRotaryEmbedding<float>(concurrency::ThreadPool* tp, RotaryParameters parameters, const float* input,
                                           const int64_t* position_ids, const float* cos_cache, const float* sin_cache, float* output,
                                           bool interleaved);
@@ -118,6 +154,16 @@ template Status RunRotaryEmbedding<MLFloat16>(concurrency::ThreadPool* tp, Rotar
                                               const int64_t* position_ids, const MLFloat16* cos_cache, const MLFloat16* sin_cache,
                                               MLFloat16* output, bool interleaved);
 
+template Status RunRotaryEmbedding<float>(concurrency::ThreadPool* tp, RotaryParameters parameters, const float* input,
+                                          const int64_t* position_ids, const float* cos_cache, const float* sin_cache, float* output,
+                                          int output_head_stride, int output_seq_stride, int output_batch_stride,
+                                          bool interleaved);
+
+template Status RunRotaryEmbedding<MLFloat16>(concurrency::ThreadPool* tp, RotaryParameters parameters, const MLFloat16* input,
+                                              const int64_t* position_ids, const MLFloat16* cos_cache, const MLFloat16* sin_cache,
+                                              MLFloat16* output, int output_head_stride, int output_seq_stride,
+                                              int output_batch_stride, bool interleaved);
+
 template <typename T>
 Status RotaryEmbedding<T>::Compute(OpKernelContext* context) const {
   const Tensor* input = context->Input<Tensor>(0);
@@ -14,6 +14,14 @@ Status RunRotaryEmbedding(onnxruntime::concurrency::ThreadPool* tp, rotary_embed
                           const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
                           bool interleaved);
 
+// Same as above, with the output written with its own strides instead of the input strides of parameters, so that the
+// input can be transposed (like from BSNH to BNSH) by the same pass.
+template <typename T>
+Status RunRotaryEmbedding(onnxruntime::concurrency::ThreadPool* tp, rotary_embedding_helper::RotaryParameters parameters, const T* input,
+                          const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
+                          int output_head_stride, int output_seq_stride, int output_batch_stride,
+                          bool interleaved);
+
 template <typename T>
 class RotaryEmbedding final : public OpKernel {
  public:
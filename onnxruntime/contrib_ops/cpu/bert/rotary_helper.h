@@ -42,6 +42,39 @@ Status PackVIntoRotaryQKV(concurrency::ThreadPool* tp,
   return Status::OK();
 }
 
+// Same as PackVIntoRotaryQKV, with V read from the packed QKV input of shape
+// (batch_size, sequence_length, (num_heads + 2 * kv_num_heads) * head_size) instead of its BNSH transpose.
+template <typename T>
+Status TransposeVIntoRotaryQKV(concurrency::ThreadPool* tp,
+                               int batch_size,
+                               int sequence_length,
+                               int num_heads,
+                               int kv_num_heads,
+                               int head_size,
+                               const T* input,
+                               T* output) {
+  int input_seq_stride = (num_heads + 2 * kv_num_heads) * head_size;
+  int input_batch_stride = sequence_length * input_seq_stride;
+  int output_head_stride = sequence_length * head_size;
+  int output_batch_stride = (num_heads + 2 * kv_num_heads) * output_head_stride;
+
+  const int loop_len = batch_size * sequence_length * kv_num_heads;
+  const double cost = static_cast<double>(head_size);
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t ptr = begin; ptr != end; ++ptr) {
+      const int b = static_cast<int>((ptr / kv_num_heads) / sequence_length);
+      const int s = static_cast<int>((ptr / kv_num_heads) % sequence_length);
+      const int n = static_cast<int>(ptr % kv_num_heads);
+      const T* input_data = input + b * input_batch_stride + s * input_seq_stride + n * head_size;
+      T* output_data = output + b * output_batch_stride + n * output_head_stride + s * head_size;
+      for (int i = 0; i < head_size; i++) {
+        output_data[i] = input_data[i];
+      }
+    }
+  });
+  return Status::OK();
+}
+
 }  // namespace rotary_helper
 }  // namespace contrib
 }  // namespace onnxruntime
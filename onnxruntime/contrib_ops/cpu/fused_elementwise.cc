@@ -0,0 +1,238 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/element_wise_ranged_transform.h"
+#include "core/providers/cpu/math/element_wise_ops.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+using FloatTransform = functors::ElementWiseRangedTransform<float>;
+
+struct ErfTransform final : public FloatTransform {
+  float Cost() const final { return 25.0f; }
+
+  GSL_SUPPRESS(r.11)
+  FloatTransform* Copy() const final { return new ErfTransform(*this); }
+
+  void operator()(std::ptrdiff_t first, std::ptrdiff_t last) const final {
+    MlasComputeErf(this->input + first, this->output + first, narrow<size_t>(last - first));
+  }
+};
+
+Status CreateUnaryTransform(const std::string& op, std::unique_ptr<FloatTransform>& out) {
+  if (op == "Abs") {
+    out = std::make_unique<functors::Abs<float>>();
+  } else if (op == "Neg") {
+    out = std::make_unique<functors::Neg<float>>();
+  } else if (op == "Floor") {
+    out = std::make_unique<functors::Floor<float>>();
+  } else if (op == "Ceil") {
+    out = std::make_unique<functors::Ceil<float>>();
+  } else if (op == "Reciprocal") {
+    out = std::make_unique<functors::Reciprocal<float>>();
+  } else if (op == "Sqrt") {
+    out = std::make_unique<functors::Sqrt<float>>();
+  } else if (op == "Exp") {
+    out = std::make_unique<functors::Exp<float>>();
+  } else if (op == "Log") {
+    out = std::make_unique<functors::Log<float>>();
+  } else if (op == "Erf") {
+    out = std::make_unique<ErfTransform>();
+  } else if (op == "Relu" || op == "Sigmoid" || op == "Tanh") {
+    NodeAttributes attributes;
+    return FloatTransform::Create(op, attributes, out);
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise does not support op ", op);
+  }
+  return Status::OK();
+}
+
+// elements per tile. small enough that the tile of Y stays in L1/L2 while all the steps run over it.
+constexpr std::ptrdiff_t kTileSize = 4096;
+}  // namespace
+
+// Evaluates a chain of elementwise ops tile by tile. The first step reads X and writes Y, the following steps
+// update the tile of Y in place, so the intermediate values of the chain are never written out as full tensors.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    std::vector<float> scalars;
+    std::vector<int64_t> operand_first;
+    ORT_ENFORCE(info.GetAttrs("ops", ops).IsOK() && !ops.empty(), "ops attribute is required");
+    ORT_ENFORCE(info.GetAttrs("operands", operands).IsOK(), "operands attribute is required");
+    ORT_ENFORCE(info.GetAttrs("scalars", scalars).IsOK(), "scalars attribute is required");
+    ORT_ENFORCE(info.GetAttrs("operand_first", operand_first).IsOK(), "operand_first attribute is required");
+    ORT_ENFORCE(operands.size() == ops.size() && scalars.size() == ops.size() && operand_first.size() == ops.size(),
+                "ops, operands, scalars and operand_first must have the same length");
+
+    const int64_t num_inputs = static_cast<int64_t>(info.GetInputCount());
+    steps_.resize(ops.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+      Step& step = steps_[i];
+      step.operand = operands[i];
+      step.scalar = scalars[i];
+      step.operand_first = operand_first[i] != 0;
+      ORT_ENFORCE(step.operand >= -1 && step.operand < num_inputs, "Invalid operand index ", step.operand,
+                  " for op ", ops[i]);
+
+      if (ops[i] == "Add") {
+        step.kind = StepKind::Add;
+      } else if (ops[i] == "Sub") {
+        step.kind = StepKind::Sub;
+      } else if (ops[i] == "Mul") {
+        step.kind = StepKind::Mul;
+      } else if (ops[i] == "Div") {
+        step.kind = StepKind::Div;
+      } else {
+        ORT_THROW_IF_ERROR(CreateUnaryTransform(ops[i], step.unary));
+        ORT_ENFORCE(step.operand == -1, "Unary op ", ops[i], " can not have an operand");
+        step.kind = StepKind::Unary;
+      }
+    }
+  }
+
+  Status Compute(OpKernelContext* context) const override {
+    const Tensor* X = context->Input<Tensor>(0);
+    const TensorShape& shape = X->Shape();
+    const int input_count = context->InputCount();
+    InlinedVector<const float*> inputs(input_count);
+    for (int i = 0; i < input_count; ++i) {
+      const Tensor* input = context->Input<Tensor>(i);
+      ORT_RETURN_IF_NOT(input->Shape() == shape, "All the inputs of FusedElementwise must have the shape of X. Got ",
+                        input->Shape(), " and ", shape);
+      inputs[i] = input->Data<float>();
+    }
+
+    Tensor* Y = context->Output(0, shape);
+    const std::ptrdiff_t elem_count = narrow<std::ptrdiff_t>(shape.Size());
+    if (elem_count == 0) {
+      return Status::OK();
+    }
+
+    float* y_data = Y->MutableData<float>();
+    double cost = 0;
+    for (const Step& step : steps_) {
+      cost += step.kind == StepKind::Unary ? step.unary->Cost() : 1.0;
+    }
+
+    const std::ptrdiff_t tile_count = (elem_count + kTileSize - 1) / kTileSize;
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), tile_count,
+        {static_cast<double>(kTileSize) * sizeof(float) * 2, static_cast<double>(kTileSize) * sizeof(float),
+         static_cast<double>(kTileSize) * cost},
+        [&](std::ptrdiff_t first_tile, std::ptrdiff_t last_tile) {
+          // the functors hold the input and output pointers, so each range uses its own copies
+          InlinedVector<std::unique_ptr<FloatTransform>> unary(steps_.size());
+          for (size_t i = 0; i < steps_.size(); ++i) {
+            if (steps_[i].kind == StepKind::Unary) {
+              unary[i].reset(steps_[i].unary->Copy());
+              unary[i]->output = y_data;
+            }
+          }
+
+          for (std::ptrdiff_t tile = first_tile; tile < last_tile; ++tile) {
+            const std::ptrdiff_t start = tile * kTileSize;
+            const std::ptrdiff_t end = std::min(start + kTileSize, elem_count);
+            for (size_t i = 0; i < steps_.size(); ++i) {
+              const float* src = i == 0 ? inputs[0] : y_data;
+              if (steps_[i].kind == StepKind::Unary) {
+                unary[i]->input = src;
+                (*unary[i])(start, end);
+              } else {
+                RunBinaryStep(steps_[i], src + start, inputs, start, end - start, y_data + start);
+              }
+            }
+          }
+        });
+
+    return Status::OK();
+  }
+
+ private:
+  enum class StepKind {
+    Unary,
+    Add,
+    Sub,
+    Mul,
+    Div,
+  };
+
+  struct Step {
+    StepKind kind;
+    std::unique_ptr<FloatTransform> unary;
+    // index of the input used as the other operand of a binary op, -1 for the scalar
+    int64_t operand;
+    float scalar;
+    // whether the operand is the first input of the binary op, e.g. scalar - x
+    bool operand_first;
+  };
+
+  static void RunBinaryStep(const Step& step, const float* src, gsl::span<const float* const> inputs,
+                            std::ptrdiff_t offset, std::ptrdiff_t len, float* dst) {
+    ConstEigenVectorArrayMap<float> a(src, len);
+    EigenVectorArrayMap<float> y(dst, len);
+    if (step.operand < 0) {
+      const float b = step.scalar;
+      switch (step.kind) {
+        case StepKind::Add:
+          y = a + b;
+          break;
+        case StepKind::Sub:
+          y = step.operand_first ? b - a : a - b;
+          break;
+        case StepKind::Mul:
+          y = a * b;
+          break;
+        default:
+          y = step.operand_first ? b / a : a / b;
+          break;
+      }
+      return;
+    }
+
+    ConstEigenVectorArrayMap<float> b(inputs[narrow<size_t>(step.operand)] + offset, len);
+    switch (step.kind) {
+      case StepKind::Add:
+        y = a + b;
+        break;
+      case StepKind::Sub:
+        y = step.operand_first ? b - a : a - b;
+        break;
+      case StepKind::Mul:
+        y = a * b;
+        break;
+      default:
+        y = step.operand_first ? b / a : a / b;
+        break;
+    }
+  }
+
+  std::vector<Step> steps_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+}  // namespace contrib
+}  // namespace onnxruntime
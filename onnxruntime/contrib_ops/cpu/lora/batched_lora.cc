@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/lora/batched_lora.h"
+
+#include <algorithm>
+
+#include "contrib_ops/cpu/lora/batched_lora_helper.h"
+#include "core/common/safeint.h"
+#include "core/util/math.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    BatchedLoRA,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    BatchedLoRA<float>);
+
+template <typename T>
+Status BatchedLoRA<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* lora_a = context->Input<Tensor>(1);
+  const Tensor* lora_b = context->Input<Tensor>(2);
+  const Tensor* adapter_indices = context->Input<Tensor>(3);
+
+  batched_lora_helper::Parameters parameters;
+  ORT_RETURN_IF_ERROR(batched_lora_helper::CheckInputs(input->Shape(), lora_a->Shape(), lora_b->Shape(),
+                                                       adapter_indices->Shape(), parameters));
+
+  TensorShapeVector output_dims = input->Shape().AsShapeVector();
+  output_dims.back() = parameters.output_size;
+  Tensor* output = context->Output(0, output_dims);
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<batched_lora_helper::Segment> segments;
+  ORT_RETURN_IF_ERROR(batched_lora_helper::GetSegments(adapter_indices->DataAsSpan<int32_t>(),
+                                                       parameters.num_adapters, segments));
+
+  const ptrdiff_t hidden_size = narrow<ptrdiff_t>(parameters.hidden_size);
+  const ptrdiff_t rank = narrow<ptrdiff_t>(parameters.rank);
+  const ptrdiff_t output_size = narrow<ptrdiff_t>(parameters.output_size);
+  const ptrdiff_t rows_per_batch = narrow<ptrdiff_t>(parameters.rows_per_batch);
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  // input * lora_a of the rows of one segment, the largest segment is at most the whole batch
+  auto intermediate = IAllocator::MakeUniquePtr<T>(
+      allocator, SafeInt<size_t>(parameters.batch_size) * rows_per_batch * rank);
+
+  const T* input_data = input->Data<T>();
+  const T* lora_a_data = lora_a->Data<T>();
+  const T* lora_b_data = lora_b->Data<T>();
+  T* output_data = output->MutableData<T>();
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  for (const auto& segment : segments) {
+    const ptrdiff_t row_begin = narrow<ptrdiff_t>(segment.begin) * rows_per_batch;
+    const ptrdiff_t num_rows = narrow<ptrdiff_t>(segment.end - segment.begin) * rows_per_batch;
+    T* segment_output = output_data + row_begin * output_size;
+
+    if (segment.adapter_index < 0 || rank == 0) {
+      std::fill_n(segment_output, num_rows * output_size, T{});
+      continue;
+    }
+
+    const T* a = lora_a_data + segment.adapter_index * hidden_size * rank;
+    const T* b = lora_b_data + segment.adapter_index * rank * output_size;
+    math::Gemm<T, concurrency::ThreadPool>(CblasNoTrans, CblasNoTrans, num_rows, rank, hidden_size, T{1},
+                                           input_data + row_begin * hidden_size, a, T{0}, intermediate.get(),
+                                           thread_pool);
+    math::Gemm<T, concurrency::ThreadPool>(CblasNoTrans, CblasNoTrans, num_rows, output_size, rank,
+                                           static_cast<T>(scale_), intermediate.get(), b, T{0}, segment_output,
+                                           thread_pool);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
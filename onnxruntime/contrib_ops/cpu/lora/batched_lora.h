@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class BatchedLoRA final : public OpKernel {
+ public:
+  explicit BatchedLoRA(const OpKernelInfo& info) : OpKernel(info) {
+    scale_ = info.GetAttrOrDefault<float>("scale", 1.0f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
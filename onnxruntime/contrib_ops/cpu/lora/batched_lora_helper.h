@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace batched_lora_helper {
+
+struct Parameters {
+  int64_t batch_size = 0;
+  // sequence_length for a 3D input, 1 for a 2D input
+  int64_t rows_per_batch = 0;
+  int64_t hidden_size = 0;
+  int64_t rank = 0;
+  int64_t output_size = 0;
+  int64_t num_adapters = 0;
+};
+
+// Consecutive batch rows [begin, end) that select the same adapter, computed with one pair of GEMMs.
+struct Segment {
+  int64_t begin;
+  int64_t end;
+  int32_t adapter_index;
+};
+
+inline Status CheckInputs(const TensorShape& input_shape,
+                          const TensorShape& lora_a_shape,
+                          const TensorShape& lora_b_shape,
+                          const TensorShape& adapter_indices_shape,
+                          Parameters& parameters) {
+  //   input           : (B, D) or (B, S, D)
+  //   lora_a          : (A, D, R)
+  //   lora_b          : (A, R, N)
+  //   adapter_indices : (B)
+  const auto input_dims = input_shape.GetDims();
+  if (input_dims.size() != 2 && input_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'input' is expected to have 2 or 3 dimensions, got ", input_dims.size());
+  }
+  if (lora_a_shape.NumDimensions() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'lora_a' is expected to have 3 dimensions, got ", lora_a_shape.NumDimensions());
+  }
+  if (lora_b_shape.NumDimensions() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'lora_b' is expected to have 3 dimensions, got ", lora_b_shape.NumDimensions());
+  }
+
+  const int64_t batch_size = input_dims[0];
+  const int64_t hidden_size = input_dims.back();
+  if (lora_a_shape[0] != lora_b_shape[0]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Inputs 'lora_a' and 'lora_b' must have the same number of adapters, got ",
+                           lora_a_shape[0], " and ", lora_b_shape[0]);
+  }
+  if (lora_a_shape[1] != hidden_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Dimension 1 of input 'lora_a' must be the hidden size ", hidden_size, ", got ",
+                           lora_a_shape[1]);
+  }
+  if (lora_a_shape[2] != lora_b_shape[1]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Inputs 'lora_a' and 'lora_b' must have the same rank, got ", lora_a_shape[2], " and ",
+                           lora_b_shape[1]);
+  }
+  if (adapter_indices_shape.NumDimensions() != 1 || adapter_indices_shape[0] != batch_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'adapter_indices' is expected to have shape (", batch_size, "), got ",
+                           adapter_indices_shape);
+  }
+
+  parameters.batch_size = batch_size;
+  parameters.rows_per_batch = input_dims.size() == 3 ? input_dims[1] : 1;
+  parameters.hidden_size = hidden_size;
+  parameters.rank = lora_a_shape[2];
+  parameters.output_size = lora_b_shape[2];
+  parameters.num_adapters = lora_a_shape[0];
+  return Status::OK();
+}
+
+// Splits the batch into runs of rows with the same adapter index.
+inline Status GetSegments(gsl::span<const int32_t> adapter_indices, int64_t num_adapters,
+                          InlinedVector<Segment>& segments) {
+  segments.clear();
+  const int64_t batch_size = static_cast<int64_t>(adapter_indices.size());
+  for (int64_t begin = 0; begin < batch_size;) {
+    const int32_t adapter_index = adapter_indices[narrow<size_t>(begin)];
+    if (adapter_index < -1 || adapter_index >= num_adapters) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Adapter index ", adapter_index, " of batch row ", begin,
+                             " is out of range [-1, ", num_adapters, ")");
+    }
+
+    int64_t end = begin + 1;
+    while (end < batch_size && adapter_indices[narrow<size_t>(end)] == adapter_index) {
+      ++end;
+    }
+
+    segments.push_back({begin, end, adapter_index});
+    begin = end;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace batched_lora_helper
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,315 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+enum class MoEActivationType {
+  Relu,
+  Gelu,
+  Silu,
+  Identity,
+};
+
+// y = act(y + bias), optionally followed by y *= gate + gate_bias, over one row of the first expert GEMM.
+void ApplyBiasAndActivation(MoEActivationType activation_type, const float* bias, const float* gate,
+                            const float* gate_bias, float* y, float* scratch, size_t n) {
+  if (bias != nullptr) {
+    for (size_t i = 0; i < n; ++i) {
+      y[i] += bias[i];
+    }
+  }
+
+  switch (activation_type) {
+    case MoEActivationType::Relu:
+      for (size_t i = 0; i < n; ++i) {
+        y[i] = std::max(y[i], 0.0f);
+      }
+      break;
+    case MoEActivationType::Gelu: {
+      constexpr float kSqrtHalf = 0.7071067811865476f;
+      for (size_t i = 0; i < n; ++i) {
+        scratch[i] = y[i] * kSqrtHalf;
+      }
+      MlasComputeErf(scratch, scratch, n);
+      for (size_t i = 0; i < n; ++i) {
+        y[i] = 0.5f * y[i] * (1.0f + scratch[i]);
+      }
+      break;
+    }
+    case MoEActivationType::Silu:
+      MlasComputeLogistic(y, scratch, n);
+      for (size_t i = 0; i < n; ++i) {
+        y[i] *= scratch[i];
+      }
+      break;
+    case MoEActivationType::Identity:
+      break;
+  }
+
+  if (gate != nullptr) {
+    for (size_t i = 0; i < n; ++i) {
+      y[i] *= gate[i] + (gate_bias != nullptr ? gate_bias[i] : 0.0f);
+    }
+  }
+}
+
+}  // namespace
+
+// Mixture of experts on CPU. Each row is routed to its top k experts, the rows are sorted by expert, and every
+// active expert runs its FFN as MLAS GEMMs over the contiguous block of rows routed to it, so the weights of
+// experts without any row are never read.
+// As in the CUDA kernel, the weights of each expert are read as column major, i.e. the data of expert e in
+// fc1_experts_weights is laid out as (inter_size, hidden_size) and in fc2_experts_weights as (hidden_size, inter_size).
+class MoE final : public OpKernel {
+ public:
+  explicit MoE(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t k_;
+  MoEActivationType activation_type_;
+  bool normalize_routing_weights_;
+};
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MoE,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MoE);
+
+MoE::MoE(const OpKernelInfo& info) : OpKernel(info) {
+  ORT_ENFORCE(info.GetAttr<int64_t>("k", &k_).IsOK());
+  ORT_ENFORCE(k_ > 0, "k must be positive, got ", k_);
+
+  std::string activation_type_str;
+  ORT_ENFORCE(info.GetAttr<std::string>("activation_type", &activation_type_str).IsOK());
+  if (activation_type_str == "relu") {
+    activation_type_ = MoEActivationType::Relu;
+  } else if (activation_type_str == "gelu") {
+    activation_type_ = MoEActivationType::Gelu;
+  } else if (activation_type_str == "silu") {
+    activation_type_ = MoEActivationType::Silu;
+  } else if (activation_type_str == "identity") {
+    activation_type_ = MoEActivationType::Identity;
+  } else {
+    ORT_THROW("Unsupported MoE activation type: ", activation_type_str);
+  }
+
+  normalize_routing_weights_ = info.GetAttrOrDefault<int64_t>("normalize_routing_weights", 0) == 1;
+  ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("use_sparse_mixer", 0) == 0,
+              "use_sparse_mixer is not supported by the CPU MoE kernel.");
+}
+
+Status MoE::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* router_probs = context->Input<Tensor>(1);
+  const Tensor* fc1_experts_weights = context->Input<Tensor>(2);
+  const Tensor* fc1_experts_bias = context->Input<Tensor>(3);
+  const Tensor* fc2_experts_weights = context->Input<Tensor>(4);
+  const Tensor* fc2_experts_bias = context->Input<Tensor>(5);
+  const Tensor* fc3_experts_weights = context->Input<Tensor>(6);
+  const Tensor* fc3_experts_bias = context->Input<Tensor>(7);
+
+  const auto& input_shape = input->Shape();
+  const auto& router_probs_shape = router_probs->Shape();
+  const auto& fc1_shape = fc1_experts_weights->Shape();
+  const auto& fc2_shape = fc2_experts_weights->Shape();
+  ORT_RETURN_IF_NOT(input_shape.NumDimensions() == 2 || input_shape.NumDimensions() == 3,
+                    "input must be 2D or 3D, got ", input_shape);
+  ORT_RETURN_IF_NOT(router_probs_shape.NumDimensions() == 2, "router_probs must be 2D, got ", router_probs_shape);
+  ORT_RETURN_IF_NOT(fc1_shape.NumDimensions() == 3 && fc2_shape.NumDimensions() == 3,
+                    "fc1_experts_weights and fc2_experts_weights must be 3D, got ", fc1_shape, " and ", fc2_shape);
+
+  const int64_t hidden_size = input_shape[input_shape.NumDimensions() - 1];
+  const int64_t num_rows = input_shape.SizeToDimension(input_shape.NumDimensions() - 1);
+  const int64_t num_experts = router_probs_shape[1];
+  const int64_t inter_size = fc1_shape[2];
+  ORT_RETURN_IF_NOT(router_probs_shape[0] == num_rows, "router_probs_dims[0] must be equal to num_rows, got ",
+                    router_probs_shape[0], " and ", num_rows);
+  ORT_RETURN_IF_NOT(fc1_shape[0] == num_experts && fc1_shape[1] == hidden_size,
+                    "fc1_experts_weights must have shape (num_experts, hidden_size, inter_size), got ", fc1_shape);
+  ORT_RETURN_IF_NOT(fc2_shape[0] == num_experts && fc2_shape[1] == inter_size && fc2_shape[2] == hidden_size,
+                    "fc2_experts_weights must have shape (num_experts, inter_size, hidden_size), got ", fc2_shape);
+  ORT_RETURN_IF_NOT(fc3_experts_weights == nullptr || fc3_experts_weights->Shape() == fc1_shape,
+                    "fc3_experts_weights must have the shape of fc1_experts_weights");
+  ORT_RETURN_IF_NOT(fc1_experts_bias == nullptr || fc1_experts_bias->Shape() == TensorShape({num_experts, inter_size}),
+                    "fc1_experts_bias must have shape (num_experts, inter_size)");
+  ORT_RETURN_IF_NOT(fc3_experts_bias == nullptr || fc3_experts_bias->Shape() == TensorShape({num_experts, inter_size}),
+                    "fc3_experts_bias must have shape (num_experts, inter_size)");
+  ORT_RETURN_IF_NOT(fc2_experts_bias == nullptr ||
+                        fc2_experts_bias->Shape() == TensorShape({num_experts, hidden_size}),
+                    "fc2_experts_bias must have shape (num_experts, hidden_size)");
+  ORT_RETURN_IF_NOT(k_ <= num_experts, "k must not be greater than num_experts, got ", k_, " and ", num_experts);
+
+  Tensor* output = context->Output(0, input_shape);
+  if (num_rows == 0) {
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+  const size_t k = narrow<size_t>(k_);
+  const size_t rows = narrow<size_t>(num_rows);
+  const size_t experts = narrow<size_t>(num_experts);
+  const size_t hidden = narrow<size_t>(hidden_size);
+  const size_t inter = narrow<size_t>(inter_size);
+  const size_t expanded_rows = rows * k;
+
+  // Routing: softmax over the router logits of each row, then the top k experts with their probabilities.
+  const float* logits = router_probs->Data<float>();
+  std::vector<int64_t> expert_for_row(expanded_rows);
+  std::vector<float> routing_weights(expanded_rows);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(rows),
+      TensorOpCost{static_cast<double>(experts * sizeof(float)), static_cast<double>(k * sizeof(float)),
+                   static_cast<double>(experts * 8)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> probs(experts);
+        std::vector<int64_t> order(experts);
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const float* row_logits = logits + row * experts;
+          const float max_logit = *std::max_element(row_logits, row_logits + experts);
+          float sum = 0.0f;
+          for (size_t e = 0; e < experts; ++e) {
+            probs[e] = std::exp(row_logits[e] - max_logit);
+            sum += probs[e];
+          }
+
+          std::iota(order.begin(), order.end(), int64_t{0});
+          std::partial_sort(order.begin(), order.begin() + k, order.end(), [&probs](int64_t a, int64_t b) {
+            return probs[a] > probs[b] || (probs[a] == probs[b] && a < b);
+          });
+
+          float selected_sum = 0.0f;
+          for (size_t j = 0; j < k; ++j) {
+            selected_sum += probs[order[j]] / sum;
+          }
+          for (size_t j = 0; j < k; ++j) {
+            const float weight = probs[order[j]] / sum;
+            expert_for_row[row * k + j] = order[j];
+            routing_weights[row * k + j] = normalize_routing_weights_ ? weight / selected_sum : weight;
+          }
+        }
+      });
+
+  // Sort the expanded rows by expert. expert_offsets[e] is the first permuted row of expert e.
+  std::vector<size_t> expert_offsets(experts + 1, 0);
+  for (int64_t expert : expert_for_row) {
+    ++expert_offsets[expert + 1];
+  }
+  std::partial_sum(expert_offsets.begin(), expert_offsets.end(), expert_offsets.begin());
+
+  std::vector<size_t> permuted_for_expanded(expanded_rows);
+  {
+    std::vector<size_t> cursor(expert_offsets.begin(), expert_offsets.end() - 1);
+    for (size_t i = 0; i < expanded_rows; ++i) {
+      permuted_for_expanded[i] = cursor[expert_for_row[i]]++;
+    }
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  const bool has_fc3 = fc3_experts_weights != nullptr;
+  auto permuted_input = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * hidden);
+  auto fc1_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * inter);
+  auto fc3_output = has_fc3 ? IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * inter)
+                            : IAllocatorUniquePtr<float>{};
+  auto fc2_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * hidden);
+
+  const float* input_data = input->Data<float>();
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(expanded_rows),
+      TensorOpCost{static_cast<double>(hidden * sizeof(float)), static_cast<double>(hidden * sizeof(float)), 0.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          std::memcpy(permuted_input.get() + permuted_for_expanded[i] * hidden, input_data + (i / k) * hidden,
+                      hidden * sizeof(float));
+        }
+      });
+
+  const float* fc1_weights = fc1_experts_weights->Data<float>();
+  const float* fc2_weights = fc2_experts_weights->Data<float>();
+  const float* fc3_weights = has_fc3 ? fc3_experts_weights->Data<float>() : nullptr;
+  const float* fc1_bias = fc1_experts_bias != nullptr ? fc1_experts_bias->Data<float>() : nullptr;
+  const float* fc3_bias = fc3_experts_bias != nullptr ? fc3_experts_bias->Data<float>() : nullptr;
+  for (size_t e = 0; e < experts; ++e) {
+    const size_t begin = expert_offsets[e];
+    const size_t m = expert_offsets[e + 1] - begin;
+    if (m == 0) {
+      continue;
+    }
+
+    const float* a = permuted_input.get() + begin * hidden;
+    float* fc1_rows = fc1_output.get() + begin * inter;
+    float* fc3_rows = has_fc3 ? fc3_output.get() + begin * inter : nullptr;
+    MlasGemm(CblasNoTrans, CblasTrans, m, inter, hidden, 1.0f, a, hidden, fc1_weights + e * hidden * inter, hidden,
+             0.0f, fc1_rows, inter, thread_pool);
+    if (has_fc3) {
+      MlasGemm(CblasNoTrans, CblasTrans, m, inter, hidden, 1.0f, a, hidden, fc3_weights + e * hidden * inter, hidden,
+               0.0f, fc3_rows, inter, thread_pool);
+    }
+
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(m),
+        TensorOpCost{static_cast<double>(inter * sizeof(float)), static_cast<double>(inter * sizeof(float)),
+                     static_cast<double>(inter * 10)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          std::vector<float> scratch(inter);
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            ApplyBiasAndActivation(activation_type_, fc1_bias != nullptr ? fc1_bias + e * inter : nullptr,
+                                   has_fc3 ? fc3_rows + i * inter : nullptr,
+                                   fc3_bias != nullptr ? fc3_bias + e * inter : nullptr, fc1_rows + i * inter,
+                                   scratch.data(), inter);
+          }
+        });
+
+    MlasGemm(CblasNoTrans, CblasTrans, m, hidden, inter, 1.0f, fc1_rows, inter, fc2_weights + e * inter * hidden,
+             inter, 0.0f, fc2_output.get() + begin * hidden, hidden, thread_pool);
+  }
+
+  // Combine the k expert outputs of each row, adding the fc2 bias of each expert.
+  const float* fc2_bias = fc2_experts_bias != nullptr ? fc2_experts_bias->Data<float>() : nullptr;
+  float* output_data = output->MutableData<float>();
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(rows),
+      TensorOpCost{static_cast<double>(k * hidden * sizeof(float)), static_cast<double>(hidden * sizeof(float)),
+                   static_cast<double>(k * hidden * 2)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          float* out = output_data + row * hidden;
+          std::fill_n(out, hidden, 0.0f);
+          for (size_t j = 0; j < k; ++j) {
+            const size_t expanded = row * k + j;
+            const float weight = routing_weights[expanded];
+            const float* expert_out = fc2_output.get() + permuted_for_expanded[expanded] * hidden;
+            const float* bias = fc2_bias != nullptr ? fc2_bias + expert_for_row[expanded] * hidden : nullptr;
+            for (size_t h = 0; h < hidden; ++h) {
+              out[h] += weight * (expert_out[h] + (bias != nullptr ? bias[h] : 0.0f));
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
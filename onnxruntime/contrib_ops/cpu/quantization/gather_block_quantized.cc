@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 
@@ -16,6 +18,18 @@
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+// the idx-th quantized value of data, which packs two elements per byte for the 4-bit types
+template <typename T1>
+inline int32_t GetQuantizedValue(const T1* data, int64_t idx) {
+  if constexpr (std::is_same_v<T1, uint8_t> || std::is_same_v<T1, int8_t>) {
+    return static_cast<int32_t>(data[idx]);
+  } else {
+    return static_cast<int32_t>(data[idx >> 1].GetElem(narrow<size_t>(idx & 1)));
+  }
+}
+}  // namespace
+
 template <typename T1, typename Tind>
 class GatherBlockQuantized : public OpKernel {
  public:
@@ -161,22 +175,45 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
       return;
     }
 
-    // TODO(fajin): use SIMD
-    int64_t output_idx = output_idx_base;
-    int64_t data_idx = data_idx_base;
-    for (int64_t i = 0; i < gather_block; ++i, ++output_idx, ++data_idx) {
-      auto data_val = static_cast<int32_t>(data_ptr[data_idx >> 1].GetElem(narrow<size_t>(data_idx & 1)));
-
-      int64_t x = data_idx / quantize_full_block;
-      int64_t y = data_idx % quantize_full_block / quantize_N;
-      int64_t z = data_idx % quantize_N;
-      int64_t scale_idx = x * scale_full_block + y / block_size_ * quantize_N + z;
-      auto scale_val = static_cast<float>(scales_ptr[scale_idx]);
-      auto zp_val = static_cast<int32_t>(zero_points_ptr
-                                             ? zero_points_ptr[scale_idx >> 1].GetElem(narrow<size_t>(scale_idx & 1))
-                                             : 0);
-
-      output_ptr[output_idx] = static_cast<T2>(static_cast<float>(data_val - zp_val) * scale_val);
+    if (quantize_N == 1) {
+      // quantized along the last axis, e.g. the rows of an embedding table. consecutive elements share the scale
+      // and zero point for up to block_size_ elements, so look them up once per run.
+      int64_t output_idx = output_idx_base;
+      int64_t data_idx = data_idx_base;
+      int64_t remaining = gather_block;
+      while (remaining > 0) {
+        const int64_t row = data_idx / quantize_axis_dim;
+        const int64_t col = data_idx % quantize_axis_dim;
+        const int64_t run = std::min({remaining, block_size_ - (col & (block_size_ - 1)), quantize_axis_dim - col});
+        const int64_t scale_idx = row * scale_full_block + col / block_size_;
+        const auto scale_val = static_cast<float>(scales_ptr[scale_idx]);
+        const int32_t zp_val = zero_points_ptr ? GetQuantizedValue(zero_points_ptr, scale_idx) : 0;
+
+        T2* output = output_ptr + output_idx;
+        for (int64_t i = 0; i < run; ++i) {
+          output[i] = static_cast<T2>(static_cast<float>(GetQuantizedValue(data_ptr, data_idx + i) - zp_val) *
+                                      scale_val);
+        }
+
+        output_idx += run;
+        data_idx += run;
+        remaining -= run;
+      }
+    } else {
+      int64_t output_idx = output_idx_base;
+      int64_t data_idx = data_idx_base;
+      for (int64_t i = 0; i < gather_block; ++i, ++output_idx, ++data_idx) {
+        auto data_val = GetQuantizedValue(data_ptr, data_idx);
+
+        int64_t x = data_idx / quantize_full_block;
+        int64_t y = data_idx % quantize_full_block / quantize_N;
+        int64_t z = data_idx % quantize_N;
+        int64_t scale_idx = x * scale_full_block + y / block_size_ * quantize_N + z;
+        auto scale_val = static_cast<float>(scales_ptr[scale_idx]);
+        auto zp_val = zero_points_ptr ? GetQuantizedValue(zero_points_ptr, scale_idx) : 0;
+
+        output_ptr[output_idx] = static_cast<T2>(static_cast<float>(data_val - zp_val) * scale_val);
+      }
     }
 
     cache[data_idx_base] = output_idx_base;
@@ -277,6 +314,10 @@ REGISTER_GATHERBLOCKQUANTIZED(UInt4x2, int32_t);
 REGISTER_GATHERBLOCKQUANTIZED(UInt4x2, int64_t);
 REGISTER_GATHERBLOCKQUANTIZED(Int4x2, int32_t);
 REGISTER_GATHERBLOCKQUANTIZED(Int4x2, int64_t);
+REGISTER_GATHERBLOCKQUANTIZED(uint8_t, int32_t);
+REGISTER_GATHERBLOCKQUANTIZED(uint8_t, int64_t);
+REGISTER_GATHERBLOCKQUANTIZED(int8_t, int32_t);
+REGISTER_GATHERBLOCKQUANTIZED(int8_t, int64_t);
 
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -89,8 +89,8 @@ class MatMulNBits final : public OpKernel {
       has_unquantized_zero_point_ = type != ONNX_NAMESPACE::TensorProto_DataType_UINT8;
     }
 
-    ORT_ENFORCE(nbits_ == 4,
-                "Only 4b quantization is supported for MatMulNBits op, additional bits support is planned.");
+    ORT_ENFORCE(nbits_ == 2 || nbits_ == 3 || nbits_ == 4,
+                "Only 2b, 3b and 4b quantization is supported for MatMulNBits op, got bits=", nbits_);
     const Tensor* tensor_zero_point = nullptr;
     has_zp_input_ = info.TryGetConstantInput(InputIndex::zero_points, &tensor_zero_point);
   }
@@ -411,8 +411,8 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
   // TODO(fajin): move B dequant to prepack
   auto tmp_b_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(K_) * N_, true);
 
-  if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<float>())) {
-    // dequantize b, only 4b quantization is supported for now
+  if (nbits_ == 4 && (reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<float>())) {
+    // dequantize b, MlasDequantizeBlockwise only supports 4b quantization
     MlasDequantizeBlockwise<float, 4>(
         tmp_b_data_ptr.get(),                           // dequantized output
         b_data,                                         // quantized input
@@ -433,6 +433,7 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
           scales_data,                                  // quantization scales
           static_cast<const float*>(zero_points_data),  // quantization zero points
           reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
           static_cast<int32_t>(block_size_),  // quantization block size
           column_wise_quant_,                 // columnwise quantization or row-wise
           static_cast<int32_t>(K_),           // number of rows in quantized input
@@ -445,6 +446,7 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
           scales_data,                                    // quantization scales
           static_cast<const uint8_t*>(zero_points_data),  // quantization zero points
           reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
           static_cast<int32_t>(block_size_),  // quantization block size
           column_wise_quant_,                 // columnwise quantization or row-wise
           static_cast<int32_t>(K_),           // number of rows in quantized input
@@ -529,8 +531,8 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
   // TODO(fajin): move B dequant to prepack
   auto tmp_b_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(K_) * N_, true);
 
-  if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<MLFloat16>())) {
-    // dequantize b, only 4b quantization is supported for now
+  if (nbits_ == 4 && (reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<MLFloat16>())) {
+    // dequantize b, MlasDequantizeBlockwise only supports 4b quantization
     MlasDequantizeBlockwise<float, 4>(
         tmp_b_data_ptr.get(),                           // dequantized output
         b_data,                                         // quantized input
@@ -551,6 +553,7 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
           scales_ptr,                                       // quantization scales
           static_cast<const MLFloat16*>(zero_points_data),  // quantization zero points
           reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
           static_cast<int32_t>(block_size_),  // quantization block size
           column_wise_quant_,                 // columnwise quantization or row-wise
           static_cast<int32_t>(K_),           // number of rows in quantized input
@@ -563,6 +566,7 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
           scales_ptr,                                     // quantization scales
           static_cast<const uint8_t*>(zero_points_data),  // quantization zero points
           reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
           static_cast<int32_t>(block_size_),  // quantization block size
           column_wise_quant_,                 // columnwise quantization or row-wise
           static_cast<int32_t>(K_),           // number of rows in quantized input
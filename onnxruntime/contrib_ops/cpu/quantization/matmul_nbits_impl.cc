@@ -73,6 +73,49 @@ void Dequantize4BitsKernelReOrder(
   }
 }
 
+template <class T, class zeroT>
+void DequantizeNBitsKernelReOrder(
+    T* output, const uint8_t* quant_data, const T* scale_data,
+    const zeroT* zero_points, const int32_t* reorder_idx, int bits, int block_size,
+    int out_rows, int out_cols, int row) {
+  // Each block is a little-endian bit stream of block_size values of `bits` bits, see MatMulNBits.
+  const int scales_shape_x = (out_cols + block_size - 1) / block_size;
+  const int blob_size = block_size * bits / 8;
+  const int zero_point_row_size = (scales_shape_x * bits + 7) / 8;
+  const int default_zp = 1 << (bits - 1);
+  const uint32_t mask = (1u << bits) - 1;
+  auto get_value = [bits, mask](const uint8_t* data, int index) {
+    const int bit_offset = index * bits;
+    uint32_t value = data[bit_offset / 8];
+    if ((bit_offset % 8) + bits > 8) {
+      value |= static_cast<uint32_t>(data[bit_offset / 8 + 1]) << 8;
+    }
+    return static_cast<int>((value >> (bit_offset % 8)) & mask);
+  };
+
+  if (row >= out_rows) {
+    return;
+  }
+  const uint8_t* quant_row = quant_data + static_cast<size_t>(row) * scales_shape_x * blob_size;
+  T* output_row = output + static_cast<size_t>(row) * out_cols;
+  for (int k = 0; k < out_cols; k++) {
+    const int kb_idx = k / block_size;
+    const int32_t rid = reorder_idx ? reorder_idx[k] : kb_idx;
+    const float scale = static_cast<float>(scale_data[row * scales_shape_x + rid]);
+    float zp_f = static_cast<float>(default_zp);
+    if (zero_points) {
+      if constexpr (std::is_same_v<zeroT, uint8_t>) {
+        zp_f = static_cast<float>(get_value(zero_points + static_cast<size_t>(row) * zero_point_row_size, rid));
+      } else {
+        zp_f = static_cast<float>(zero_points[row * scales_shape_x + rid]);
+      }
+    }
+
+    const int value = get_value(quant_row + kb_idx * blob_size, k % block_size);
+    output_row[k] = static_cast<T>((static_cast<float>(value) - zp_f) * scale);
+  }
+}
+
 template <typename inputT, typename zeroT>
 void DequantizeBlockwise(
     inputT* output,              // dequantized output
@@ -80,11 +123,22 @@ void DequantizeBlockwise(
     const inputT* scales_data,   // quantization scales
     const zeroT* zero_points,    // quantization zero points
     const int32_t* reorder_idx,  // reorder_idx for groupwise quantization
+    int32_t bits,                // number of bits per quantized value
     int32_t block_size,          // quantization block size
     bool,                        // columnwise quantization or row-wise
     int32_t K,                   // number of rows in quantized input
     int32_t N,                   // number of columns in quantized input
     onnxruntime::concurrency::ThreadPool* pool) {
+  if (bits != 4) {
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        pool, static_cast<std::ptrdiff_t>(N),
+        [&](std::ptrdiff_t row) {
+          DequantizeNBitsKernelReOrder(output, quant_data, scales_data, zero_points, reorder_idx, bits,
+                                       block_size, N, K, static_cast<int>(row));
+        });
+    return;
+  }
+
   auto ceildiv = [](int a, int b) { return (a + b - 1) / b; };
   constexpr int element_per_thread = 8;
   int groups_per_threadblock = 256 * element_per_thread / block_size;
@@ -104,18 +158,18 @@ void DequantizeBlockwise(
 
 template void DequantizeBlockwise<float, uint8_t>(
     float* output, const uint8_t* quant_data, const float* scales_data,
-    const uint8_t* zero_points, const int32_t* reorder_idx, int32_t block_size,
-    bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
+    const uint8_t* zero_points, const int32_t* reorder_idx, int32_t bits,
+    int32_t block_size, bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
 
 template void DequantizeBlockwise<float, float>(
     float* output, const uint8_t* quant_data, const float* scales_data,
-    const float* zero_points, const int32_t* reorder_idx, int32_t block_size,
-    bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
+    const float* zero_points, const int32_t* reorder_idx, int32_t bits,
+    int32_t block_size, bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
 
 template void DequantizeBlockwise<float, MLFloat16>(
     float* output, const uint8_t* quant_data, const float* scales_data,
-    const MLFloat16* zero_points, const int32_t* reorder_idx, int32_t block_size,
-    bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
+    const MLFloat16* zero_points, const int32_t* reorder_idx, int32_t bits,
+    int32_t block_size, bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
 
 }  // namespace contrib
 }  // namespace onnxruntime
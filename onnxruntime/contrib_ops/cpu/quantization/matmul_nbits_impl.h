@@ -13,6 +13,7 @@ void DequantizeBlockwise(
     const inputT* scales_data,   // quantization scales
     const zeroT* zero_points,    // quantization zero points
     const int32_t* reorder_idx,  // quantization zero points
+    int32_t bits,                // number of bits per quantized value, 2, 3 or 4
     int32_t block_size,          // quantization block size
     bool,                        // columnwise quantization or row-wise
     int32_t K,                   // number of rows in quantized input
@@ -4,6 +4,9 @@
 #include "qlinear_activations.h"
 #include "qlinear_lookup_table.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "core/common/narrow.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
@@ -97,6 +100,113 @@ Status QLinearSigmoid<T>::Compute(OpKernelContext* context) const {
   });
 }
 
+namespace {
+
+LookupTableArrayTransformer MakeElementwiseTransformer(std::function<float(float)> fn) {
+  return [fn = std::move(fn)](const float* input, float* output, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+      output[i] = fn(input[i]);
+    }
+  };
+}
+
+float Softplus(float v) {
+  // log(1 + exp(v)) without overflowing for large v
+  return v > 0.0f ? v + std::log1p(std::exp(-v)) : std::log1p(std::exp(v));
+}
+
+// the function applied by a QLinearUnary node, from its op_type and the attributes of that op
+LookupTableArrayTransformer CreateUnaryTransformer(const OpKernelInfo& info, const std::string& op_type) {
+  if (op_type == "Erf") {
+    return [](const float* input, float* output, size_t length) { MlasComputeErf(input, output, length); };
+  }
+  if (op_type == "Exp") {
+    return [](const float* input, float* output, size_t length) { MlasComputeExp(input, output, length); };
+  }
+  if (op_type == "Tanh") {
+    return [](const float* input, float* output, size_t length) { MlasComputeTanh(input, output, length); };
+  }
+  if (op_type == "Gelu") {
+    if (info.GetAttrOrDefault<std::string>("approximate", "none") == "tanh") {
+      return MakeElementwiseTransformer([](float v) {
+        return 0.5f * v * (1.0f + std::tanh(0.7978845608f * (v + 0.044715f * v * v * v)));
+      });
+    }
+    return MakeElementwiseTransformer([](float v) { return 0.5f * v * (1.0f + std::erf(v * 0.7071067812f)); });
+  }
+  if (op_type == "Abs") {
+    return MakeElementwiseTransformer([](float v) { return std::abs(v); });
+  }
+  if (op_type == "Neg") {
+    return MakeElementwiseTransformer([](float v) { return -v; });
+  }
+  if (op_type == "Log") {
+    return MakeElementwiseTransformer([](float v) { return std::log(v); });
+  }
+  if (op_type == "Sqrt") {
+    return MakeElementwiseTransformer([](float v) { return std::sqrt(v); });
+  }
+  if (op_type == "Reciprocal") {
+    return MakeElementwiseTransformer([](float v) { return 1.0f / v; });
+  }
+  if (op_type == "Sin") {
+    return MakeElementwiseTransformer([](float v) { return std::sin(v); });
+  }
+  if (op_type == "Cos") {
+    return MakeElementwiseTransformer([](float v) { return std::cos(v); });
+  }
+  if (op_type == "Softplus") {
+    return MakeElementwiseTransformer(Softplus);
+  }
+  if (op_type == "Softsign") {
+    return MakeElementwiseTransformer([](float v) { return v / (1.0f + std::abs(v)); });
+  }
+  if (op_type == "Mish") {
+    return MakeElementwiseTransformer([](float v) { return v * std::tanh(Softplus(v)); });
+  }
+  if (op_type == "HardSwish") {
+    return MakeElementwiseTransformer([](float v) { return v * std::clamp(v / 6.0f + 0.5f, 0.0f, 1.0f); });
+  }
+  if (op_type == "HardSigmoid") {
+    const float alpha = info.GetAttrOrDefault("alpha", 0.2f);
+    const float beta = info.GetAttrOrDefault("beta", 0.5f);
+    return MakeElementwiseTransformer([alpha, beta](float v) { return std::clamp(alpha * v + beta, 0.0f, 1.0f); });
+  }
+  if (op_type == "Elu") {
+    const float alpha = info.GetAttrOrDefault("alpha", 1.0f);
+    return MakeElementwiseTransformer([alpha](float v) { return v >= 0.0f ? v : alpha * (std::exp(v) - 1.0f); });
+  }
+  if (op_type == "Celu") {
+    const float alpha = info.GetAttrOrDefault("alpha", 1.0f);
+    return MakeElementwiseTransformer([alpha](float v) {
+      return std::max(0.0f, v) + std::min(0.0f, alpha * (std::exp(v / alpha) - 1.0f));
+    });
+  }
+  if (op_type == "Selu") {
+    const float alpha = info.GetAttrOrDefault("alpha", 1.67326319217681884765625f);
+    const float gamma = info.GetAttrOrDefault("gamma", 1.05070102214813232421875f);
+    return MakeElementwiseTransformer([alpha, gamma](float v) {
+      return v > 0.0f ? gamma * v : gamma * (alpha * std::exp(v) - alpha);
+    });
+  }
+
+  ORT_THROW("QLinearUnary: unsupported op_type ", op_type);
+}
+
+}  // namespace
+
+template <typename T>
+QLinearUnary<T>::QLinearUnary(const OpKernelInfo& info)
+    : QLinearLookupBase<T>(info),
+      transformer_(CreateUnaryTransformer(info, info.GetAttrOrDefault<std::string>("op_type", ""))) {
+  this->BuildLookupTableIfFixed(info, transformer_);
+}
+
+template <typename T>
+Status QLinearUnary<T>::Compute(OpKernelContext* context) const {
+  return this->ComputeBase(context, transformer_);
+}
+
 #define REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(op_name, version, data_type, KERNEL_CLASS) \
   ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                                         \
       op_name, version, data_type,                                                           \
@@ -108,6 +218,8 @@ REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearLeakyRelu, 1, int8_t, QLinearLe
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearLeakyRelu, 1, uint8_t, QLinearLeakyRelu);
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearSigmoid, 1, int8_t, QLinearSigmoid);
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearSigmoid, 1, uint8_t, QLinearSigmoid);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearUnary, 1, int8_t, QLinearUnary);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearUnary, 1, uint8_t, QLinearUnary);
 
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core/framework/op_kernel.h"
+#include "qlinear_lookup_table.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -49,5 +50,17 @@ class QLinearSigmoid final : public QLinearLookupBase<T> {
   Status Compute(OpKernelContext* context) const override;
 };
 
+// Any unary elementwise op, named by the op_type attribute, through a lookup table.
+template <typename T>
+class QLinearUnary final : public QLinearLookupBase<T> {
+ public:
+  QLinearUnary(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  LookupTableArrayTransformer transformer_;
+};
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -6,11 +6,17 @@
 #include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 
+#if defined(MLAS_TARGET_ARM64)
+#include <arm_neon.h>
+#endif
+
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+
 template <typename TOutput>
-void QLinearLookupTableTransform(const uint8_t* x, const TOutput* table, TOutput* y, size_t n) {
+void LookupTableTransform(const uint8_t* x, const TOutput* table, TOutput* y, size_t n) {
   for (; n >= 4; n -= 4) {
     const size_t x_value0 = x[0];
     const size_t x_value1 = x[1];
@@ -35,7 +41,44 @@ void QLinearLookupTableTransform(const uint8_t* x, const TOutput* table, TOutput
   }
 }
 
-template void QLinearLookupTableTransform(const uint8_t* x, const uint8_t* table, uint8_t* y, size_t n);
+}  // namespace
+
+template <typename TOutput>
+void QLinearLookupTableTransform(const uint8_t* x, const TOutput* table, TOutput* y, size_t n) {
+  LookupTableTransform(x, table, y, n);
+}
+
+template <>
+void QLinearLookupTableTransform(const uint8_t* x, const uint8_t* table, uint8_t* y, size_t n) {
+#if defined(MLAS_TARGET_ARM64)
+  // Look up 16 values at a time in the four 64-byte quarters of the table. The indices are moved down by 64 for each
+  // quarter, which leaves the earlier quarters out of range so TBX keeps the values already looked up.
+  uint8x16x4_t quarters[4];
+  for (size_t q = 0; q < 4; ++q) {
+    for (size_t r = 0; r < 4; ++r) {
+      quarters[q].val[r] = vld1q_u8(table + q * 64 + r * 16);
+    }
+  }
+
+  const uint8x16_t quarter_size = vdupq_n_u8(64);
+  for (; n >= 16; n -= 16) {
+    uint8x16_t index = vld1q_u8(x);
+    uint8x16_t value = vqtbl4q_u8(quarters[0], index);
+    index = vsubq_u8(index, quarter_size);
+    value = vqtbx4q_u8(value, quarters[1], index);
+    index = vsubq_u8(index, quarter_size);
+    value = vqtbx4q_u8(value, quarters[2], index);
+    index = vsubq_u8(index, quarter_size);
+    value = vqtbx4q_u8(value, quarters[3], index);
+    vst1q_u8(y, value);
+    x += 16;
+    y += 16;
+  }
+#endif
+
+  LookupTableTransform(x, table, y, n);
+}
+
 template void QLinearLookupTableTransform(const uint8_t* x, const float* table, float* y, size_t n);
 
 template <typename T>
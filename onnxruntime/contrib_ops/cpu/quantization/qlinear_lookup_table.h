@@ -37,5 +37,9 @@ void QlinearBuildLookupTable(uint8_t* table,
 template <typename TOutput>
 void QLinearLookupTableTransform(const uint8_t* x, const TOutput* table, TOutput* y, size_t n);
 
+// uses NEON table lookups on Arm64
+template <>
+void QLinearLookupTableTransform(const uint8_t* x, const uint8_t* table, uint8_t* y, size_t n);
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -46,23 +46,23 @@ void ComputeJob(
     const T* gamma_data,
     const T* beta_data,
     const T* bias_data,
-    IAllocatorUniquePtr<float>& skip_float_uptr,
-    IAllocatorUniquePtr<float>& gamma_float_uptr,
-    IAllocatorUniquePtr<float>& beta_float_uptr,
-    IAllocatorUniquePtr<float>& bias_float_uptr,
+    const float* skip_float_ptr,
+    const float* gamma_float_ptr,
+    const float* beta_float_ptr,
+    const float* bias_float_ptr,
+    float* scratch,
     ptrdiff_t task_idx,
     int hidden_size,
     int64_t skip_size,
     float epsilon,
     bool simplified,
     T* output_data,
-    T* skip_input_bias_add_output_data,
-    AllocatorPtr alloc) {
-  ORT_UNUSED_PARAMETER(skip_float_uptr);   // only used in MLFloat16 overload
-  ORT_UNUSED_PARAMETER(gamma_float_uptr);  // only used in MLFloat16 overload
-  ORT_UNUSED_PARAMETER(beta_float_uptr);   // only used in MLFloat16 overload
-  ORT_UNUSED_PARAMETER(bias_float_uptr);   // only used in MLFloat16 overload
-  ORT_UNUSED_PARAMETER(alloc);
+    T* skip_input_bias_add_output_data) {
+  ORT_UNUSED_PARAMETER(skip_float_ptr);   // only used in MLFloat16 overload
+  ORT_UNUSED_PARAMETER(gamma_float_ptr);  // only used in MLFloat16 overload
+  ORT_UNUSED_PARAMETER(beta_float_ptr);   // only used in MLFloat16 overload
+  ORT_UNUSED_PARAMETER(bias_float_ptr);   // only used in MLFloat16 overload
+  ORT_UNUSED_PARAMETER(scratch);          // only used in MLFloat16 overload
 
   auto offset = task_idx * hidden_size;
   const T* p_input = input_data + offset;
@@ -73,6 +73,7 @@ void ComputeJob(
   T mean(0.0f);
   T mean_square(0.0f);
 
+  // the sum and the statistics are computed in the same pass over the inputs
   for (decltype(hidden_size) h = 0; h < hidden_size; h++) {
     T val = p_input[h] + p_skip[h];
 
@@ -90,44 +91,56 @@ void ComputeJob(
   }
 
   mean = mean / hidden_size;
+  T inv_std_dev;
   if (simplified) {
-    mean_square = sqrt(mean_square / hidden_size + epsilon);
+    inv_std_dev = 1 / sqrt(mean_square / hidden_size + epsilon);
   } else {
-    mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon);
+    inv_std_dev = 1 / sqrt(mean_square / hidden_size - mean * mean + epsilon);
   }
 
-  for (decltype(hidden_size) h = 0; h < hidden_size; h++) {
-    if (simplified) {
-      p_output[h] = p_output[h] / mean_square * gamma_data[h];
-    } else if (nullptr == beta_data) {
-      p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h];
-    } else {
-      p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
+  if (simplified) {
+    for (decltype(hidden_size) h = 0; h < hidden_size; h++) {
+      p_output[h] = p_output[h] * inv_std_dev * gamma_data[h];
+    }
+  } else if (nullptr == beta_data) {
+    for (decltype(hidden_size) h = 0; h < hidden_size; h++) {
+      p_output[h] = (p_output[h] - mean) * inv_std_dev * gamma_data[h];
+    }
+  } else {
+    for (decltype(hidden_size) h = 0; h < hidden_size; h++) {
+      p_output[h] = (p_output[h] - mean) * inv_std_dev * gamma_data[h] + beta_data[h];
     }
   }
 }
 
+// skip_float_ptr is the whole prepacked skip tensor, or null when skip is converted per row.
+// gamma_float_ptr, beta_float_ptr and bias_float_ptr are converted once per run.
+// scratch holds 2 * hidden_size floats.
 void ComputeJob(
     const MLFloat16* input_data,
     const MLFloat16* skip_data,
     const MLFloat16* gamma_data,
     const MLFloat16* beta_data,
     const MLFloat16* bias_data,
-    IAllocatorUniquePtr<float>& skip_float_uptr,
-    IAllocatorUniquePtr<float>& gamma_float_uptr,
-    IAllocatorUniquePtr<float>& beta_float_uptr,
-    IAllocatorUniquePtr<float>& bias_float_uptr,
+    const float* skip_float_ptr,
+    const float* gamma_float_ptr,
+    const float* beta_float_ptr,
+    const float* bias_float_ptr,
+    float* scratch,
     ptrdiff_t task_idx,
     int hidden_size,
     int64_t skip_size,
     float epsilon,
     bool simplified,
     MLFloat16* output_data,
-    MLFloat16* skip_input_bias_add_output_data,
-    AllocatorPtr alloc) {
+    MLFloat16* skip_input_bias_add_output_data) {
+  ORT_UNUSED_PARAMETER(gamma_data);  // only used in float/double overload
+  ORT_UNUSED_PARAMETER(beta_data);   // only used in float/double overload
+  ORT_UNUSED_PARAMETER(bias_data);   // only used in float/double overload
+
   auto offset = task_idx * hidden_size;
+  const auto skip_offset = offset % skip_size;
   const MLFloat16* p_input = input_data + offset;
-  const MLFloat16* p_skip = skip_data + (offset % skip_size);
   MLFloat16* p_output = output_data + offset;
   MLFloat16* p_skip_input_bias_add_output = skip_input_bias_add_output_data == nullptr ? nullptr : skip_input_bias_add_output_data + offset;
 
@@ -135,74 +148,79 @@ void ComputeJob(
   float mean_square(0.0f);
   const size_t num_elems = static_cast<size_t>(hidden_size);
 
-  IAllocatorUniquePtr<float> input_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  MlasConvertHalfToFloatBuffer(p_input, input_float_uptr.get(), num_elems);
-
-  if (!skip_float_uptr) {
-    skip_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-    MlasConvertHalfToFloatBuffer(p_skip, skip_float_uptr.get(), num_elems);
-  }
+  // the row is converted once and then summed, normalized and converted back in place
+  float* value_float_ptr = scratch;
+  MlasConvertHalfToFloatBuffer(p_input, value_float_ptr, num_elems);
 
-  if (bias_data && !bias_float_uptr) {
-    bias_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-    MlasConvertHalfToFloatBuffer(bias_data, bias_float_uptr.get(), num_elems);
+  const float* skip_row_float_ptr = skip_float_ptr == nullptr ? nullptr : skip_float_ptr + skip_offset;
+  if (skip_row_float_ptr == nullptr) {
+    float* skip_row_buffer = scratch + num_elems;
+    MlasConvertHalfToFloatBuffer(skip_data + skip_offset, skip_row_buffer, num_elems);
+    skip_row_float_ptr = skip_row_buffer;
   }
 
-  IAllocatorUniquePtr<float> output_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  float* output_float_ptr = output_float_uptr.get();
-
-  const float* input_float_ptr = input_float_uptr.get();
-  const float* skip_float_ptr = skip_float_uptr.get();
-  const float* bias_float_ptr = bias_float_uptr.get();
   for (size_t h = 0; h < num_elems; h++) {
-    float val = input_float_ptr[h] + skip_float_ptr[h];
+    float val = value_float_ptr[h] + skip_row_float_ptr[h];
 
-    if (bias_float_uptr) {
+    if (nullptr != bias_float_ptr) {
       val += bias_float_ptr[h];
     }
 
-    output_float_ptr[h] = val;
+    value_float_ptr[h] = val;
     mean += val;
     mean_square += val * val;
   }
 
   if (nullptr != p_skip_input_bias_add_output) {
-    MlasConvertFloatToHalfBuffer(output_float_ptr, p_skip_input_bias_add_output, num_elems);
+    MlasConvertFloatToHalfBuffer(value_float_ptr, p_skip_input_bias_add_output, num_elems);
   }
 
   mean = mean / hidden_size;
+  float inv_std_dev;
   if (simplified) {
-    mean_square = sqrt(mean_square / hidden_size + epsilon);
+    inv_std_dev = 1 / sqrt(mean_square / hidden_size + epsilon);
   } else {
-    mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon);
+    inv_std_dev = 1 / sqrt(mean_square / hidden_size - mean * mean + epsilon);
   }
 
-  if (!gamma_float_uptr) {
-    gamma_float_uptr = std::move(input_float_uptr);  // overwrite input with gamma values, since they have the same size
-    MlasConvertHalfToFloatBuffer(gamma_data, gamma_float_uptr.get(), num_elems);
+  if (simplified) {
+    for (size_t h = 0; h < num_elems; h++) {
+      value_float_ptr[h] = value_float_ptr[h] * inv_std_dev * gamma_float_ptr[h];
+    }
+  } else if (nullptr == beta_float_ptr) {
+    for (size_t h = 0; h < num_elems; h++) {
+      value_float_ptr[h] = (value_float_ptr[h] - mean) * inv_std_dev * gamma_float_ptr[h];
+    }
+  } else {
+    for (size_t h = 0; h < num_elems; h++) {
+      value_float_ptr[h] = (value_float_ptr[h] - mean) * inv_std_dev * gamma_float_ptr[h] + beta_float_ptr[h];
+    }
   }
 
-  if (beta_data && !beta_float_uptr) {
-    beta_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-    MlasConvertHalfToFloatBuffer(beta_data, beta_float_uptr.get(), num_elems);
-  }
+  MlasConvertFloatToHalfBuffer(value_float_ptr, p_output, num_elems);
+}
 
-  const float* gamma_float_ptr = gamma_float_uptr.get();
-  const float* beta_float_ptr = beta_float_uptr.get();
-  for (size_t h = 0; h < num_elems; h++) {
-    if (simplified) {
-      output_float_ptr[h] = output_float_ptr[h] / mean_square * gamma_float_ptr[h];
-    } else if (nullptr == beta_float_uptr) {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * gamma_float_ptr[h];
-    } else {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * gamma_float_ptr[h] + beta_float_ptr[h];
+// Returns the float copy of a MLFloat16 input that was not prepacked, or null when none is needed.
+template <typename T>
+IAllocatorUniquePtr<float> ConvertToFloatIfNotPacked(const T* data, size_t num_elems,
+                                                     const IAllocatorUniquePtr<float>& prepacked, AllocatorPtr alloc) {
+  if constexpr (std::is_same_v<T, MLFloat16>) {
+    if (data != nullptr && !prepacked) {
+      auto float_ptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
+      MlasConvertHalfToFloatBuffer(data, float_ptr.get(), num_elems);
+      return float_ptr;
     }
+  } else {
+    ORT_UNUSED_PARAMETER(data);
+    ORT_UNUSED_PARAMETER(num_elems);
+    ORT_UNUSED_PARAMETER(prepacked);
+    ORT_UNUSED_PARAMETER(alloc);
   }
 
-  MlasConvertFloatToHalfBuffer(output_float_ptr, p_output, num_elems);
+  return nullptr;
 }
 
-void ConvertMLFloat16ToFloatIfNeeded(const Tensor& tensor, AllocatorPtr alloc, IAllocatorUniquePtr<float>& dest, bool& is_packed) {
+void ConvertMLFloat16ToFloatIfNeeded(const Tensor& tensor, AllocatorPtr alloc, IAllocatorUniquePtr<float>& dest) {
   if (tensor.GetElementType() == utils::ToTensorProtoElementType<MLFloat16>()) {
     auto tensor_data_ptr = tensor.Data<MLFloat16>();
     auto tensor_size = static_cast<size_t>(tensor.Shape().Size());
@@ -210,7 +228,6 @@ void ConvertMLFloat16ToFloatIfNeeded(const Tensor& tensor, AllocatorPtr alloc, I
 
     MlasConvertHalfToFloatBuffer(tensor_data_ptr, float_ptr.get(), tensor_size);
     dest = std::move(float_ptr);
-    is_packed = true;
   }
 }
 
@@ -264,14 +281,33 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
 
-  concurrency::ThreadPool::TryBatchParallelFor(
-      p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
-      [&](ptrdiff_t task_idx) {
-        ComputeJob(input_data, skip_data, gamma_data, beta_data, bias_data, skip_fp32_, gamma_fp32_, beta_fp32_,
-                   bias_fp32_, task_idx, hidden_size, skip_size, epsilon_, simplified, output_data,
-                   skip_input_bias_add_output_data, alloc);
-      },
-      0);
+  // MLFloat16 gamma, beta and bias that were not prepacked are converted once here instead of in every row
+  const size_t num_elems = static_cast<size_t>(hidden_size);
+  IAllocatorUniquePtr<float> gamma_fp32 = ConvertToFloatIfNotPacked(gamma_data, num_elems, gamma_fp32_, alloc);
+  IAllocatorUniquePtr<float> beta_fp32 = ConvertToFloatIfNotPacked(beta_data, num_elems, beta_fp32_, alloc);
+  IAllocatorUniquePtr<float> bias_fp32 = ConvertToFloatIfNotPacked(bias_data, num_elems, bias_fp32_, alloc);
+  const float* gamma_float_ptr = gamma_fp32_ ? gamma_fp32_.get() : gamma_fp32.get();
+  const float* beta_float_ptr = beta_fp32_ ? beta_fp32_.get() : beta_fp32.get();
+  const float* bias_float_ptr = bias_fp32_ ? bias_fp32_.get() : bias_fp32.get();
+
+  const double row_size = static_cast<double>(hidden_size);
+  const TensorOpCost cost{row_size * sizeof(T) * 3, row_size * sizeof(T) * 2, row_size * 8};
+
+  concurrency::ThreadPool::TryParallelFor(
+      p_ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(task_count), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        // one buffer for the rows processed by this thread, for the MLFloat16 input and skip rows
+        IAllocatorUniquePtr<float> scratch;
+        if constexpr (std::is_same_v<T, MLFloat16>) {
+          scratch = IAllocator::MakeUniquePtr<float>(alloc, 2 * num_elems);
+        }
+
+        for (std::ptrdiff_t task_idx = begin; task_idx < end; ++task_idx) {
+          ComputeJob(input_data, skip_data, gamma_data, beta_data, bias_data, skip_fp32_.get(), gamma_float_ptr,
+                     beta_float_ptr, bias_float_ptr, scratch.get(), task_idx, hidden_size, skip_size, epsilon_,
+                     simplified, output_data, skip_input_bias_add_output_data);
+        }
+      });
 
   return Status::OK();
 }
@@ -281,15 +317,16 @@ Status SkipLayerNorm<T, simplified>::PrePack(const Tensor& tensor, int input_idx
                                              bool& is_packed, PrePackedWeights* prepacked_weights) {
   ORT_UNUSED_PARAMETER(prepacked_weights);
 
+  // Compute still validates the shapes of all the inputs, so the initializers are kept alongside the float copies
   is_packed = false;
   if (input_idx == 1) {  // skip
-    ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, skip_fp32_, is_packed);
+    ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, skip_fp32_);
   } else if (input_idx == 2) {  // gamma
-    ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, gamma_fp32_, is_packed);
+    ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, gamma_fp32_);
   } else if (input_idx == 3) {  // beta
-    ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, beta_fp32_, is_packed);
+    ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, beta_fp32_);
   } else if (input_idx == 4) {  // bias
-    ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, bias_fp32_, is_packed);
+    ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, bias_fp32_);
   }
 
   return Status::OK();
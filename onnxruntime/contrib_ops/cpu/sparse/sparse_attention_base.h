@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+
 #include "contrib_ops/cpu/bert/attention_helper.h"
 
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "contrib_ops/cpu/bert/attention_common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
@@ -65,325 +69,227 @@ class SparseAttentionBase {
     int past_buffer_sequence_length = static_cast<int>(past_key->Shape().GetDims()[2]);
     int present_buffer_sequence_length = static_cast<int>(present_key->Shape().GetDims()[2]);
 
-    // Allocate a buffer to store Softmax(QK)
-    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * parameters.total_sequence_length * sizeof(T);
-    auto attention_probs = allocator->Alloc(bytes);
-    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
-
     bool past_present_share_buffer = parameters.past_present_share_buffer;
     assert(past_present_share_buffer);
 
     auto* tp = context->GetOperatorThreadPool();
 
     const T* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
-    ComputeAttentionProbs<T>(
-        static_cast<T*>(attention_probs), Q, k, total_key_lengths->Data<int32_t>(),
-        batch_size, sequence_length, parameters.total_sequence_length,
-        past_buffer_sequence_length, present_buffer_sequence_length, head_size,
-        past_key->Data<T>(), present_key->MutableData<T>(), past_present_share_buffer, packed_qkv,
-        block_row_indices->Data<int32_t>(), block_col_indices->Data<int32_t>(), parameters, tp);
-
-    // Compute the attentionScore * Value: out(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
     const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
-    ComputeVxAttentionScore<T>(
-        output->MutableData<T>(), static_cast<T*>(attention_probs), v,
-        total_key_lengths->Data<int32_t>(),
-        batch_size, sequence_length, parameters.total_sequence_length,
-        past_buffer_sequence_length, present_buffer_sequence_length, head_size, parameters.hidden_size,
-        past_value->Data<T>(), present_value->MutableData<T>(), past_present_share_buffer, packed_qkv, tp);
+    ConcatPresentKV<T>(k, v, total_key_lengths->Data<int32_t>(), batch_size, sequence_length,
+                       parameters.total_sequence_length, past_buffer_sequence_length, present_buffer_sequence_length,
+                       head_size, past_key->Data<T>(), past_value->Data<T>(), present_key->MutableData<T>(),
+                       present_value->MutableData<T>(), past_present_share_buffer, packed_qkv, tp);
+
+    ComputeBlockSparseAttention<T>(
+        output->MutableData<T>(), Q, present_key->Data<T>(), present_value->Data<T>(),
+        total_key_lengths->Data<int32_t>(), batch_size, sequence_length, parameters.total_sequence_length,
+        present_buffer_sequence_length, head_size, parameters.hidden_size, packed_qkv,
+        block_row_indices->Data<int32_t>(), block_col_indices->Data<int32_t>(), parameters, allocator, tp);
 
     return Status::OK();
   }
 
  private:
-  // Helper function to compute the attention probs. It does 2 things:
-  //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
-  //  attention_probs(B, N, S, T) = Softmax(attention_probs)
+  // Helper function to append the new key and value to the KV cache, once for each KV head:
+  //  present_key(B, N_kv, T, H) = Concat(past_key(B, N_kv, P, H), K(B, N_kv, S, H))
+  //  present_value(B, N_kv, T, H) = Concat(past_value(B, N_kv, P, H), V(B, N_kv, S, H))
+  template <typename T>
+  void ConcatPresentKV(const T* K,                           // key start pointer
+                       const T* V,                           // value start pointer
+                       const int32_t* total_key_lengths,     // total key sequence lengths (past + new)
+                       int batch_size,                       // batch size
+                       int sequence_length,                  // sequence length of query or new key
+                       int total_sequence_length,            // maximum past_sequence_length + sequence_length
+                       int past_buffer_sequence_length,      // sequence length of past_key or past_value
+                       int present_buffer_sequence_length,   // sequence length of present_key or present_value
+                       int head_size,                        // head size of key and value
+                       const T* past_key,                    // past key
+                       const T* past_value,                  // past value
+                       T* present_key,                       // present key
+                       T* present_value,                     // present value
+                       bool past_present_share_buffer,       // whether past and present share the buffer
+                       bool packed_qkv,                      // whether Q, K, V are packed
+                       ThreadPool* tp) const {               // thread pool
+    const bool is_prompt = (total_sequence_length == sequence_length);
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_input_chunk_length = static_cast<size_t>(sequence_length) * head_size;  // S x H
+    const size_t past_buff_chunk_length = static_cast<size_t>(past_buffer_sequence_length) * head_size;
+    const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;
+
+    TensorOpCost unit_cost;
+    unit_cost.bytes_loaded = static_cast<double>(2 * kv_input_chunk_length * sizeof(T));
+    unit_cost.bytes_stored = unit_cost.bytes_loaded;
+    unit_cost.compute_cycles = 0;
+
+    ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(batch_size) * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const int batch_index = static_cast<int>(i / kv_num_heads_);
+            const int kv_head_index = static_cast<int>(i % kv_num_heads_);
+            const int past_seq_len = is_prompt ? 0 : (total_key_lengths[batch_index] - sequence_length);
+            const size_t past_chunk_length = static_cast<size_t>(past_seq_len) * head_size;
+
+            const size_t input_offset =
+                packed_qkv ? static_cast<size_t>(packed_batch_stride) * batch_index + kv_input_chunk_length * kv_head_index
+                           : kv_input_chunk_length * i;
+            ConcatStateChunkGQA(past_key, K + input_offset, present_key, present_buff_chunk_length,
+                                past_buff_chunk_length, past_chunk_length, kv_input_chunk_length,
+                                past_present_share_buffer, i);
+            ConcatStateChunkGQA(past_value, V + input_offset, present_value, present_buff_chunk_length,
+                                past_buff_chunk_length, past_chunk_length, kv_input_chunk_length,
+                                past_present_share_buffer, i);
+          }
+        });
+  }
+
+  // Helper function to compute the attention for each row of sparse blocks of the query, over only the key blocks
+  // that are not zero in the sparse layout:
+  //  scores(B, N, S_r, T_r) = 1/sqrt(H) x Q(B, N, S_r, H) x K'(B, N, T_r, H -> B, N, H, T_r)
+  //  output(B, S_r, N, H) = Softmax(scores) x V(B, N, T_r, H)
+  // where S_r is the query tokens in a row of blocks and T_r is the key tokens in the active blocks of the row.
+  // The zero blocks are neither multiplied nor stored.
   template <typename T>
-  void ComputeAttentionProbs(
-      T* attention_probs,                     // output buffer with size BxNxSxT
+  void ComputeBlockSparseAttention(
+      T* output,                              // output with size BxSxNxH
       const T* Q,                             // query start pointer
-      const T* K,                             // key start pointer
+      const T* present_key,                   // present key with size BxN_kvxT_maxxH
+      const T* present_value,                 // present value with size BxN_kvxT_maxxH
       const int32_t* total_key_lengths,       // total key sequence lengths (past + new)
       int batch_size,                         // batch size
-      int sequence_length,                    // sequence length of query or new key
+      int sequence_length,                    // sequence length of query
       int total_sequence_length,              // maximum past_sequence_length + sequence_length
-      int past_buffer_sequence_length,        // sequence length of past_key or past_value
       int present_buffer_sequence_length,     // sequence length of present_key or present_value
-      int head_size,                          // head size of query
-      const T* past_key,                      // past key
-      T* present_key,                         // present key
-      bool past_present_share_buffer,         // whether past_key and present_key share the buffer
+      int head_size,                          // head size of Q, K, V
+      int hidden_size,                        // hidden size of output
       bool packed_qkv,                        // whether Q, K, V are packed
       const int32_t* block_row_indices,       // block row indices
       const int32_t* block_col_indices,       // block column indices
       SparseAttentionParameters& parameters,  // parameters
+      AllocatorPtr allocator,                 // allocator for the scores of the threads
       ThreadPool* tp) const {                 // thread pool
     const bool is_prompt = (total_sequence_length == sequence_length);
+    const int block_size = parameters.sparse_block_size;
     const ptrdiff_t packed_batch_stride =
         packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
                    : SafeInt<ptrdiff_t>(0);
     const int kv_num_heads_factor = num_heads_ / kv_num_heads_;
     const size_t q_input_chunk_length = static_cast<size_t>(sequence_length) * head_size;  // S x H
-    const size_t kv_input_chunk_length = q_input_chunk_length;
-    const size_t past_buff_chunk_length = static_cast<size_t>(past_buffer_sequence_length) * head_size;
     const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;
-
-    const int loop_len = batch_size * num_heads_;
     const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
 
+    // The query tokens of a batch span at most this many rows of blocks, depending on the past sequence length.
+    const int max_query_blocks = (sequence_length + block_size - 2) / block_size + 1;
+    const ptrdiff_t loop_len = SafeInt<ptrdiff_t>(batch_size) * num_heads_ * max_query_blocks;
+
+    // The scores of a row of blocks are stored for the active key blocks only, up to all the blocks of the cache.
+    const int max_key_blocks = (total_sequence_length + block_size - 1) / block_size;
+    const size_t scores_length = SafeInt<size_t>(block_size) * max_key_blocks * block_size;
+
+    // Cost of a dense row of blocks, which is the worst case.
     TensorOpCost unit_cost;
-    const ptrdiff_t probs_matrix_bytes =
-        SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * sizeof(T);
     unit_cost.compute_cycles =
-        static_cast<double>(SafeInt<ptrdiff_t>(2) * sequence_length * head_size * total_sequence_length);
+        static_cast<double>(SafeInt<ptrdiff_t>(4) * block_size * head_size * total_sequence_length);
     unit_cost.bytes_loaded =
-        static_cast<double>((sequence_length + total_sequence_length) * head_size * sizeof(T));
-    unit_cost.bytes_stored = static_cast<double>(probs_matrix_bytes);
-
-    unit_cost.bytes_loaded += static_cast<double>(probs_matrix_bytes);
-    unit_cost.bytes_stored += static_cast<double>(probs_matrix_bytes);
-
-    // Cost to concatenate current key to cache (assume past and present share buffer).
-    double bytes_to_copy_key = static_cast<double>(sizeof(T) * sequence_length * head_size);
-    unit_cost.bytes_loaded += bytes_to_copy_key;
-    unit_cost.bytes_stored += bytes_to_copy_key;
+        static_cast<double>((SafeInt<ptrdiff_t>(block_size) + 2 * total_sequence_length) * head_size * sizeof(T));
+    unit_cost.bytes_stored = static_cast<double>(SafeInt<ptrdiff_t>(block_size) * head_size * sizeof(T));
 
     DUMP_CPU_TENSOR_INIT();
     DUMP_CPU_TENSOR("block_row_indices", block_row_indices, parameters.num_sparse_layout, parameters.stride_row_indices);
     DUMP_CPU_TENSOR("block_col_indices", block_col_indices, parameters.num_sparse_layout, parameters.stride_col_indices);
 
-    // Check whether each layout has sparse (has zero in lower triangular)
-    std::vector<bool> layout_has_sparse(parameters.num_sparse_layout);
-    for (int layout_index = 0; layout_index < parameters.num_sparse_layout; layout_index++) {
-      int nonzero_elements = block_row_indices[(layout_index + 1) * parameters.stride_row_indices - 1];
-      int dense_nonzero = (parameters.stride_row_indices * (parameters.stride_row_indices - 1)) / 2;
-      layout_has_sparse[layout_index] = nonzero_elements < dense_nonzero;
-      DUMP_STRING("layout_has_sparse[", layout_index, "]=", layout_has_sparse[layout_index]);
-    }
-
     ThreadPool::TryParallelFor(tp, loop_len, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-      DUMP_STRING("batch_size=", batch_size, ",num_heads=", num_heads_, ",loop_len=", loop_len, ",begin=", begin, ",end=", end);
+      auto scores_buffer = IAllocator::MakeUniquePtr<T>(allocator, scores_length);
+      T* scores = scores_buffer.get();
+      InlinedVector<int32_t> active_blocks;
+
       for (std::ptrdiff_t i = begin; i != end; ++i) {
-        const int batch_index = static_cast<int>(i) / num_heads_;
-        const int head_index = static_cast<int>(i) % num_heads_;
-        const int past_seq_len = is_prompt ? 0 : (static_cast<int>(total_key_lengths[batch_index]) - sequence_length);
-        const size_t past_chunk_length = static_cast<size_t>(past_seq_len) * head_size;
+        const int batch_index = static_cast<int>(i / (num_heads_ * max_query_blocks));
+        const int head_index = static_cast<int>(i / max_query_blocks % num_heads_);
         const int total_seq_len = total_key_lengths[batch_index];
-
-        const ptrdiff_t output_offset = SafeInt<ptrdiff_t>(i) * sequence_length * total_sequence_length;
-        T* output = attention_probs + output_offset;
-
-        const T* k;
-        if (packed_qkv) {
-          k = K + packed_batch_stride * batch_index + kv_input_chunk_length * (head_index / kv_num_heads_factor);
-        } else {
-          k = K + kv_input_chunk_length * (i / kv_num_heads_factor);
+        const int past_seq_len = is_prompt ? 0 : (total_seq_len - sequence_length);
+
+        // Query tokens [q_begin, q_end) at absolute positions past_seq_len + q are in row_in_sparse_layout.
+        const int row_in_sparse_layout = past_seq_len / block_size + static_cast<int>(i % max_query_blocks);
+        const int q_begin = std::max(row_in_sparse_layout * block_size, past_seq_len) - past_seq_len;
+        const int q_end = std::min((row_in_sparse_layout + 1) * block_size - past_seq_len, sequence_length);
+        if (q_begin >= q_end) {
+          continue;
+        }
+        const int q_rows = q_end - q_begin;
+        const int last_position = past_seq_len + q_end - 1;
+
+        // Collect the key blocks of the row that are visible to the query tokens.
+        const int layout_id = head_index % parameters.num_sparse_layout;
+        const int32_t* layout_row_indices = block_row_indices + layout_id * parameters.stride_row_indices;
+        const int32_t* layout_col_indices = block_col_indices + layout_id * parameters.stride_col_indices;
+        active_blocks.clear();
+        for (int j = layout_row_indices[row_in_sparse_layout]; j < layout_row_indices[row_in_sparse_layout + 1]; j++) {
+          const int col_in_sparse_layout = layout_col_indices[j];
+          const int key_begin = col_in_sparse_layout * block_size;
+          if (key_begin <= last_position && key_begin < total_seq_len) {
+            active_blocks.push_back(col_in_sparse_layout);
+          }
+        }
+        if (active_blocks.empty()) {
+          continue;
         }
 
-        // Concatenate past_k + k -> present_k
-        // TODO: avoid copying mutiple times for a group.
-        k = ConcatStateChunkGQA(past_key, k, present_key, present_buff_chunk_length, past_buff_chunk_length,
-                                is_prompt ? 0 : past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
-                                i / kv_num_heads_factor);
-
-        // Compute Q*K' + AttentionMask
-        //                     original                 transposed             each iteration
-        // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
-        // B: K'               (B x N x) T x H          (B x N x) H x T        H x T
-        // C: attention_probs  (B x N x) S x T          (B x N x) S x T        S x T
+        const int scores_stride = static_cast<int>(active_blocks.size()) * block_size;
+
         const T* q;
         if (packed_qkv) {
           q = Q + packed_batch_stride * batch_index + q_input_chunk_length * head_index;
         } else {
-          q = Q + q_input_chunk_length * i;
+          q = Q + q_input_chunk_length * (static_cast<size_t>(batch_index) * num_heads_ + head_index);
         }
+        q += static_cast<size_t>(q_begin) * head_size;
 
-        DUMP_STRING("i=", i, ",batch_index=", batch_index, ",head_index=", head_index,
-                    ",past_seq_len=", past_seq_len, ",total_seq_len=", total_seq_len, ",packed_qkv=", packed_qkv);
-        DUMP_CPU_TENSOR("Q", q, sequence_length, head_size);
-        DUMP_CPU_TENSOR("K", k, total_seq_len, head_size);
-
-        math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seq_len, head_size, alpha, q,
-                                    head_size, k, head_size, 0.0f /*bata*/, output, total_seq_len,
-                                    nullptr);
-
-        DUMP_CPU_TENSOR("QK", output, sequence_length, total_seq_len);
-
-        // Compute Softmax for causal and output result in place.
-        T* output_softmax = output;
-
-        int layout_id = head_index % parameters.num_sparse_layout;
-        bool is_sparse_layout = layout_has_sparse[layout_id];
-
-        DUMP_STRING("layout_id=", layout_id, ",is_sparse_layout=", is_sparse_layout);
+        const size_t kv_head_offset =
+            present_buff_chunk_length * (static_cast<size_t>(batch_index) * kv_num_heads_ + head_index / kv_num_heads_factor);
+        const T* k = present_key + kv_head_offset;
+        const T* v = present_value + kv_head_offset;
 
-        if (!is_sparse_layout) {  // dense
-          for (int q_id = 0; q_id < sequence_length; q_id++) {
-            int causal_length = past_seq_len + q_id + 1;
-            ComputeAttentionSoftmaxInplace(output_softmax, 1, causal_length, nullptr);
-            for (int remain_seq_id = causal_length; remain_seq_id < total_seq_len; remain_seq_id++) {
-              output_softmax[remain_seq_id] = 0.f;
-            }
-            output_softmax += total_seq_len;
+        DUMP_STRING("i=", i, ",batch_index=", batch_index, ",head_index=", head_index,
+                    ",row_in_sparse_layout=", row_in_sparse_layout, ",q_begin=", q_begin, ",q_end=", q_end,
+                    ",active_blocks=", active_blocks.size());
+
+        // scores = Q x K' of each active block, with the tokens past the causal or total length masked out
+        for (size_t b = 0; b < active_blocks.size(); b++) {
+          const int key_begin = active_blocks[b] * block_size;
+          const int key_count = std::min(block_size, total_seq_len - key_begin);
+          T* block_scores = scores + b * block_size;
+          math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasTrans, q_rows, key_count, head_size, alpha, q, head_size,
+                                      k + static_cast<size_t>(key_begin) * head_size, head_size, 0.0f /*beta*/,
+                                      block_scores, scores_stride, nullptr);
+
+          for (int r = 0; r < q_rows; r++) {
+            const int causal_count = std::max(0, std::min(block_size, past_seq_len + q_begin + r + 1 - key_begin));
+            const int valid_count = std::min(key_count, causal_count);
+            T* row = block_scores + static_cast<size_t>(r) * scores_stride;
+            std::fill(row + valid_count, row + block_size, std::numeric_limits<T>::lowest());
           }
-        } else {  // sparse
-          int q_id = 0;
-          bool has_sparse = false;
-          std::vector<int32_t> mask(parameters.max_sequence_length);
-
-          const int32_t* layout_row_indices = block_row_indices + layout_id * parameters.stride_row_indices;
-          const int32_t* layout_col_indices = block_col_indices + layout_id * parameters.stride_col_indices;
-          do {
-            int q_abs_position = past_seq_len + q_id;
-            int causal_length = q_abs_position + 1;
-
-            // Update mask when query token is the first or at the boundary of sparse block.
-            if (q_id == 0 || q_abs_position % parameters.sparse_block_size == 0) {
-              int row_in_sparse_layout = q_abs_position / parameters.sparse_block_size;
-              int start_in_col_indices = layout_row_indices[row_in_sparse_layout];
-              int end_in_col_indices = layout_row_indices[row_in_sparse_layout + 1];
-              int nonzero_blocks = end_in_col_indices - start_in_col_indices;
-              has_sparse = (nonzero_blocks != row_in_sparse_layout + 1);
-
-              DUMP_STRING("q_id=", q_id,
-                          ",q_abs_position=", q_abs_position,
-                          ",sparse_block_size=", parameters.sparse_block_size,
-                          ",row_in_sparse_layout=", row_in_sparse_layout,
-                          ",start_in_col_indices=", start_in_col_indices,
-                          ",end_in_col_indices=", end_in_col_indices,
-                          ",nonzero_blocks=", nonzero_blocks,
-                          ",has_sparse=", has_sparse);
-
-              // Expand attention mask for current row of q_id
-              if (has_sparse) {
-                int block_aligned_length = q_abs_position / parameters.sparse_block_size * parameters.sparse_block_size + parameters.sparse_block_size;
-                DUMP_STRING("block_aligned_length=", block_aligned_length);
-
-                std::fill_n(mask.begin(), block_aligned_length, 0);
-                for (int j = start_in_col_indices; j < end_in_col_indices; j++) {
-                  int col_in_sparse_layout = layout_col_indices[j];
-
-                  int offset = col_in_sparse_layout * parameters.sparse_block_size;
-                  for (int s = 0; s < parameters.sparse_block_size; s++, offset++) {
-                    mask[offset] = 1;
-                  }
-                }
-
-                DUMP_CPU_TENSOR("mask", mask, block_aligned_length);
-              }
-            }
-
-            // Update inline according to attention mask.
-            if (has_sparse) {
-              for (int s = 0; s < causal_length; s++) {
-                if (mask[s] == 0)
-                  output_softmax[s] = std::numeric_limits<T>::lowest();
-              }
-            }
-            ComputeAttentionSoftmaxInplace(output_softmax, 1, causal_length, nullptr);
-
-            for (int remain_seq_id = causal_length; remain_seq_id < total_seq_len; remain_seq_id++) {
-              output_softmax[remain_seq_id] = 0.f;
-            }
-
-            output_softmax += total_seq_len;
-            q_id++;
-
-          } while (q_id < sequence_length);
         }
 
-        DUMP_CPU_TENSOR("softmax", output, sequence_length, total_seq_len);
+        ComputeAttentionSoftmaxInplace(scores, q_rows, scores_stride, nullptr);
+
+        // output = scores x V, accumulated over the active blocks
+        T* output_current = output +
+                            (static_cast<size_t>(batch_index) * sequence_length * num_heads_ + head_index) * head_size +
+                            static_cast<size_t>(q_begin) * hidden_size;
+        for (size_t b = 0; b < active_blocks.size(); b++) {
+          const int key_begin = active_blocks[b] * block_size;
+          const int key_count = std::min(block_size, total_seq_len - key_begin);
+          math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasNoTrans, q_rows, head_size, key_count, 1.f /*alpha*/,
+                                      scores + b * block_size, scores_stride,
+                                      v + static_cast<size_t>(key_begin) * head_size, head_size,
+                                      b == 0 ? 0.0f : 1.0f /*beta*/, output_current, hidden_size, nullptr);
+        }
       }
     });
   }
-
-  template <typename T>
-  void ComputeVxAttentionScore(T* output,                           // buffer for the result with size BxSxNxH
-                               const T* attention_probs,            // Softmax of Q*K' with size BxNxSxT
-                               const T* V,                          // v value with size BxN_kvxSxH
-                               const int32_t* total_key_lengths,    // total sequence lengths
-                               int batch_size,                      // batch size
-                               int sequence_length,                 // sequence length
-                               int total_sequence_length,           // maximum past_sequence_length + sequence_length
-                               int past_buffer_sequence_length,     // sequence length in past state
-                               int present_buffer_sequence_length,  // sequence length in past state
-                               int head_size,                       // head size of Q, K, V
-                               int hidden_size,                     // hidden size of Output
-                               const T* past_value,                 // past value only
-                               T* present_value,                    // present value only
-                               bool past_present_share_buffer,      // whether past_key and present_key share the buffer
-                               bool packed_qkv,                     // whether Q, K, V are packed
-                               ThreadPool* tp) const {
-    const bool is_prompt = sequence_length == total_sequence_length;
-    const ptrdiff_t packed_batch_stride =
-        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
-                   : SafeInt<ptrdiff_t>(0);
-    const int kv_num_heads_factor = num_heads_ / kv_num_heads_;
-
-    const int kv_input_chunk_length = sequence_length * head_size;  // S x H
-    const size_t past_buff_chunk_length = static_cast<size_t>(past_buffer_sequence_length) * head_size;
-    const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;
-
-    // The cost of Gemm.
-    TensorOpCost unit_cost;
-    // Here we use total_sequence_length to estimate total_key_lengths[batch_index] used in GEMM.
-    unit_cost.compute_cycles =
-        static_cast<double>(SafeInt<ptrdiff_t>(2) * sequence_length * head_size * total_sequence_length);
-    unit_cost.bytes_loaded = static_cast<double>(SafeInt<ptrdiff_t>(sequence_length + head_size) *
-                                                 total_sequence_length * sizeof(T));
-    unit_cost.bytes_stored = static_cast<double>(sequence_length * head_size * sizeof(T));
-
-    if (present_value) {
-      double bytes_to_copy_value = static_cast<double>(sizeof(T) * sequence_length * head_size);
-      unit_cost.bytes_loaded += bytes_to_copy_value;
-      unit_cost.bytes_stored += bytes_to_copy_value;
-    }
-
-    DUMP_CPU_TENSOR_INIT();
-
-    ThreadPool::TryParallelFor(
-        tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-          DUMP_STRING("batch_size=", batch_size, ",num_heads=", num_heads_, ",begin=", begin, ",end=", end);
-
-          for (std::ptrdiff_t i = begin; i != end; ++i) {
-            const int batch_index = static_cast<int>(i / num_heads_);
-            const int head_index = static_cast<int>(i % num_heads_);
-            const int past_seq_len = is_prompt ? 0 : (static_cast<int>(total_key_lengths[batch_index]) - sequence_length);
-            const size_t past_chunk_length = static_cast<size_t>(past_seq_len) * head_size;
-            const int total_seq_len = total_key_lengths[batch_index];
-
-            DUMP_STRING("i=", i, ",batch_index=", batch_index, ",head_index=", head_index,
-                        ",past_seq_len=", past_seq_len, ",total_seq_len=", total_seq_len, ",packed_qkv=", packed_qkv);
-
-            const T* v;
-            if (packed_qkv) {
-              v = V + packed_batch_stride * batch_index + kv_input_chunk_length * (head_index / kv_num_heads_factor);
-            } else {
-              v = V + kv_input_chunk_length * (i / kv_num_heads_factor);
-            }
-
-            // Concatenate past_v + v -> present_v
-            v = ConcatStateChunkGQA(past_value, v, present_value, present_buff_chunk_length, past_buff_chunk_length,
-                                    is_prompt ? 0 : past_chunk_length, kv_input_chunk_length, past_present_share_buffer,
-                                    i / kv_num_heads_factor);
-
-            DUMP_CPU_TENSOR("present_value", v, total_seq_len, head_size);
-
-            T* output_current = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
-            ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_seq_len * i;
-
-            DUMP_CPU_TENSOR("attention_probs", attention_probs + attention_probs_offset, sequence_length, total_seq_len);
-
-            math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, total_seq_len,
-                                        1.f, /*alpha*/
-                                        attention_probs + attention_probs_offset, total_seq_len, v,
-                                        head_size, 0.0f /*beta*/, output_current, hidden_size, nullptr);
-
-            DUMP_CPU_TENSOR("out", attention_probs + attention_probs_offset, sequence_length, head_size);
-          }
-        });
-  }
 };
 
 }  // namespace contrib
@@ -211,7 +211,7 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
   // Initialize resources
   this->beam_scorer_ = create_beam_scorer_func_
                            ? create_beam_scorer_func_(*parameters, this->temp_space_allocator_, this->cpu_allocator_, this->ort_stream_)
-                           : std::make_unique<BeamSearchScorer>(*parameters, this->cpu_allocator_);
+                           : std::make_unique<BeamSearchScorer>(*parameters, this->cpu_allocator_, this->thread_pool_);
 
   BeamSearchCpuState cpu_state{*parameters,
                                this->cpu_allocator_,
@@ -220,7 +220,7 @@ Status BeamSearchT5<T>::Execute(const FeedsFetchesManager& encoder_feeds_fetches
 
   this->beam_scorer_ = create_beam_scorer_func_
                            ? create_beam_scorer_func_(*parameters, this->temp_space_allocator_, this->cpu_allocator_, this->ort_stream_)
-                           : std::make_unique<BeamSearchScorer>(*parameters, this->cpu_allocator_);
+                           : std::make_unique<BeamSearchScorer>(*parameters, this->cpu_allocator_, this->thread_pool_);
 
   // ------------------------------------------------------------------------------
   // Generate next token from logits output from encoder, and initialize decoder inputs.
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <queue>
 #include <math.h>
 #include "core/common/common.h"
@@ -19,9 +20,12 @@ namespace contrib {
 namespace transformers {
 using ::onnxruntime::rnn::detail::Allocate;
 
-void BeamHypotheses::Init(float length_penalty, gsl::span<HypothesisScore> beams) {
+void BeamHypotheses::Init(float length_penalty, gsl::span<HypothesisScore> beams,
+                          gsl::span<int32_t> hypothesis_buffer) {
   beams_ = beams;
   beams_used_ = 0;
+  hypothesis_buffer_ = hypothesis_buffer;
+  hypothesis_buffer_used_ = 0;
   length_penalty_ = length_penalty;
   done_ = false;
 }
@@ -73,7 +77,8 @@ void BeamHypotheses::Output(
 }
 
 BeamSearchScorer::BeamSearchScorer(const IGenerationParameters& parameters,
-                                   AllocatorPtr& allocator)
+                                   AllocatorPtr& allocator,
+                                   concurrency::ThreadPool* thread_pool)
     : batch_size_{static_cast<size_t>(parameters.batch_size)},
       num_beams_{static_cast<size_t>(parameters.num_beams)},
       max_length_{static_cast<size_t>(parameters.max_length)},
@@ -81,21 +86,25 @@ BeamSearchScorer::BeamSearchScorer(const IGenerationParameters& parameters,
       pad_token_id_{parameters.pad_token_id},
       eos_token_id_{parameters.eos_token_id},
       early_stopping_{parameters.early_stopping},
-      not_done_count_{parameters.batch_size} {
+      not_done_count_{parameters.batch_size},
+      thread_pool_{thread_pool} {
   size_t batch_beam_size = batch_size_ * num_beams_;
 
-  auto beams = Allocate<HypothesisScore>(allocator, batch_beam_size, hypothesis_scores_ptr_);
-  beam_hyps_ = Allocate<BeamHypotheses>(allocator, batch_size_, beam_hyps_ptr_);
-  for (size_t i = 0; i < batch_size_; i++)
-    beam_hyps_[i].Init(parameters.length_penalty, beams.subspan(i * num_beams_, num_beams_));
-
   next_beam_scores_ = Allocate<float>(allocator, batch_beam_size, next_beam_scores_ptr_);
   next_beam_tokens_ = Allocate<int32_t>(allocator, batch_beam_size, next_beam_tokens_ptr_);
   next_beam_indices_ = Allocate<int32_t>(allocator, batch_beam_size, next_beam_indices_ptr_);
 
   // Space to store intermediate sequence with length sequence_length, sequence_length + 1, ..., max_sequence_length.
+  // At most num_beams_ hypotheses of a batch entry finish at each length, so every batch entry gets its own slice
+  // of num_beams_ * per_beam and the batch entries can be processed independently.
   size_t per_beam = (SafeInt<size_t>(max_length_) * (max_length_ + 1) - (parameters.sequence_length - 1) * parameters.sequence_length) / 2;
   hypothesis_buffer_ = Allocate<int32_t>(allocator, batch_beam_size * per_beam, hypothesis_buffer_ptr_);
+
+  auto beams = Allocate<HypothesisScore>(allocator, batch_beam_size, hypothesis_scores_ptr_);
+  beam_hyps_ = Allocate<BeamHypotheses>(allocator, batch_size_, beam_hyps_ptr_);
+  for (size_t i = 0; i < batch_size_; i++)
+    beam_hyps_[i].Init(parameters.length_penalty, beams.subspan(i * num_beams_, num_beams_),
+                       hypothesis_buffer_.subspan(i * num_beams_ * per_beam, num_beams_ * per_beam));
 }
 
 void BeamSearchScorer::Process(ISequences& sequences,
@@ -106,80 +115,100 @@ void BeamSearchScorer::Process(ISequences& sequences,
   // It contains word ID of whole sequence generated so far.
   // It is different from subgraph input_ids, which only need one word when past state is not empty.
 
-  const int sequence_length = sequences.GetSequenceLength();
-
   ORT_ENFORCE(next_scores.size() == next_tokens.size());
   ORT_ENFORCE(next_scores.size() == next_indices.size());
 
-  for (size_t batch = 0; batch < batch_size_; batch++) {
-    BeamHypotheses& beam_hyp = beam_hyps_[batch];
-    if (beam_hyp.done_) {
-      ORT_ENFORCE(beam_hyp.beams_used_ == gsl::narrow_cast<int>(num_beams_),
-                  "Batch can only be done if all beams have been generated");
-
-      // Pad the batch.
-      for (size_t j = 0; j < num_beams_; j++) {
-        next_beam_scores_[batch * num_beams_ + j] = 0.0f;
-        next_beam_tokens_[batch * num_beams_ + j] = pad_token_id_;
-        next_beam_indices_[batch * num_beams_ + j] = 0;
-      }
-      continue;
-    }
-
-    // Next tokens for this sentence.
-    size_t beam_idx = 0;
-    size_t top_k = 2 * num_beams_;
-    for (size_t j = 0; j < top_k; j++) {
-      int32_t next_token = next_tokens[batch * top_k + j];
-      float next_score = next_scores[batch * top_k + j];
-      int32_t next_index = next_indices[batch * top_k + j];
-
-      int batch_beam_idx = static_cast<int>(batch * num_beams_) + next_index;
-      // Add to generated hypotheses if end of sentence.
-      if ((eos_token_id_ >= 0) && (next_token == eos_token_id_)) {
-        bool is_beam_token_worse_than_top_num_beams = (j >= num_beams_);
-        if (is_beam_token_worse_than_top_num_beams) {
-          continue;
+  // Each batch entry reads 2 * num_beams candidates, and may copy num_beams finished sequences.
+  const double top_k = 2.0 * static_cast<double>(num_beams_);
+  TensorOpCost cost;
+  cost.bytes_loaded = top_k * (sizeof(float) + 2 * sizeof(int32_t));
+  cost.bytes_stored = static_cast<double>(num_beams_) * (sequences.GetSequenceLength() + 3) * sizeof(int32_t);
+  cost.compute_cycles = top_k * 4.0;
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool_, static_cast<std::ptrdiff_t>(batch_size_), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t batch = begin; batch != end; ++batch) {
+          ProcessBatch(static_cast<size_t>(batch), sequences, next_scores, next_tokens, next_indices);
         }
+      });
 
-        // Clone the sequence and append to buffer.
-        gsl::span<const int32_t> src = sequences.GetSequence(batch_beam_idx);
-        auto clone = hypothesis_buffer_.subspan(static_cast<size_t>(hypothesis_buffer_used_), sequence_length);
-
-        gsl::copy(src, clone);
-        hypothesis_buffer_used_ += sequence_length;
-        auto sequence = ReinterpretAsSpan<const int32_t>(clone);
-        beam_hyp.Add(sequence, next_score);
-      } else {
-        // Add next predicted token since it is not eos_token.
-        next_beam_scores_[batch * num_beams_ + beam_idx] = next_score;
-        next_beam_tokens_[batch * num_beams_ + beam_idx] = next_token;
-        next_beam_indices_[batch * num_beams_ + beam_idx] = batch_beam_idx;
-        ++beam_idx;
-      }
+  not_done_count_ = static_cast<int>(std::count_if(beam_hyps_.begin(), beam_hyps_.end(),
+                                                   [](const BeamHypotheses& beam_hyp) { return !beam_hyp.done_; }));
+}
 
-      // Once the beam for next step is full, don't add more tokens to it.
-      if (beam_idx == num_beams_)
-        break;
-    }
+void BeamSearchScorer::ProcessBatch(size_t batch,
+                                    ISequences& sequences,
+                                    gsl::span<const float>& next_scores,
+                                    gsl::span<const int32_t>& next_tokens,
+                                    gsl::span<const int32_t>& next_indices) {
+  const int sequence_length = sequences.GetSequenceLength();
 
-    ORT_ENFORCE(beam_idx == num_beams_);
-    ORT_ENFORCE(static_cast<size_t>(hypothesis_buffer_used_) <= hypothesis_buffer_.size());
+  BeamHypotheses& beam_hyp = beam_hyps_[batch];
+  if (beam_hyp.done_) {
+    ORT_ENFORCE(beam_hyp.beams_used_ == gsl::narrow_cast<int>(num_beams_),
+                "Batch can only be done if all beams have been generated");
 
-    //  Check if we are done so that we can save a pad step if all(done)
-    if (static_cast<size_t>(beam_hyp.beams_used_) < num_beams_)
-      continue;
+    // Pad the batch.
+    for (size_t j = 0; j < num_beams_; j++) {
+      next_beam_scores_[batch * num_beams_ + j] = 0.0f;
+      next_beam_tokens_[batch * num_beams_ + j] = pad_token_id_;
+      next_beam_indices_[batch * num_beams_ + j] = 0;
+    }
+    return;
+  }
 
-    if (!early_stopping_) {
-      gsl::span<const float> topk_scores = next_scores.subspan(batch * num_beams_, top_k);
-      const auto best_sum_logprobs = std::max_element(topk_scores.begin(), topk_scores.end());
-      if (beam_hyp.CanImprove(*best_sum_logprobs, sequence_length))
+  // Next tokens for this sentence.
+  size_t beam_idx = 0;
+  size_t top_k = 2 * num_beams_;
+  for (size_t j = 0; j < top_k; j++) {
+    int32_t next_token = next_tokens[batch * top_k + j];
+    float next_score = next_scores[batch * top_k + j];
+    int32_t next_index = next_indices[batch * top_k + j];
+
+    int batch_beam_idx = static_cast<int>(batch * num_beams_) + next_index;
+    // Add to generated hypotheses if end of sentence.
+    if ((eos_token_id_ >= 0) && (next_token == eos_token_id_)) {
+      bool is_beam_token_worse_than_top_num_beams = (j >= num_beams_);
+      if (is_beam_token_worse_than_top_num_beams) {
         continue;
+      }
+
+      // Clone the sequence and append to buffer.
+      gsl::span<const int32_t> src = sequences.GetSequence(batch_beam_idx);
+      auto clone = beam_hyp.hypothesis_buffer_.subspan(beam_hyp.hypothesis_buffer_used_, sequence_length);
+
+      gsl::copy(src, clone);
+      beam_hyp.hypothesis_buffer_used_ += sequence_length;
+      auto sequence = ReinterpretAsSpan<const int32_t>(clone);
+      beam_hyp.Add(sequence, next_score);
+    } else {
+      // Add next predicted token since it is not eos_token.
+      next_beam_scores_[batch * num_beams_ + beam_idx] = next_score;
+      next_beam_tokens_[batch * num_beams_ + beam_idx] = next_token;
+      next_beam_indices_[batch * num_beams_ + beam_idx] = batch_beam_idx;
+      ++beam_idx;
     }
 
-    beam_hyp.done_ = true;
-    not_done_count_--;
+    // Once the beam for next step is full, don't add more tokens to it.
+    if (beam_idx == num_beams_)
+      break;
+  }
+
+  ORT_ENFORCE(beam_idx == num_beams_);
+  ORT_ENFORCE(beam_hyp.hypothesis_buffer_used_ <= beam_hyp.hypothesis_buffer_.size());
+
+  //  Check if we are done so that we can save a pad step if all(done)
+  if (static_cast<size_t>(beam_hyp.beams_used_) < num_beams_)
+    return;
+
+  if (!early_stopping_) {
+    gsl::span<const float> topk_scores = next_scores.subspan(batch * num_beams_, top_k);
+    const auto best_sum_logprobs = std::max_element(topk_scores.begin(), topk_scores.end());
+    if (beam_hyp.CanImprove(*best_sum_logprobs, sequence_length))
+      return;
   }
+
+  beam_hyp.done_ = true;
 }
 
 template <typename T>
@@ -12,6 +12,7 @@
 #include "core/framework/utils.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/cpu/containers.h"
+#include "core/platform/threadpool.h"
 #include "contrib_ops/cpu/transformers/sequences.h"
 #include "contrib_ops/cpu/transformers/generation_shared.h"
 
@@ -26,7 +27,7 @@ struct HypothesisScore {
 
 struct BeamHypotheses {
   // As these are constructed as an uninitialized array of memory, we need an Init method
-  void Init(float length_penalty, gsl::span<HypothesisScore> beams);
+  void Init(float length_penalty, gsl::span<HypothesisScore> beams, gsl::span<int32_t> hypothesis_buffer);
 
   // Add a new hypothesis
   void Add(gsl::span<const int32_t>& hypothesis, float sum_logprobs);
@@ -41,15 +42,18 @@ struct BeamHypotheses {
               gsl::span<int32_t>& sequences,    // buffer with pad token, shape (num_return_sequences, max_length)
               gsl::span<T>& sequences_scores);  // buffer for sequence scores, with shape (num_return_sequences)
 
-  gsl::span<HypothesisScore> beams_;  // Beam width sized array of hypotheses, sorted by highest scoring
-  int beams_used_;                    // Number of elements used in beams_
+  gsl::span<HypothesisScore> beams_;      // Beam width sized array of hypotheses, sorted by highest scoring
+  int beams_used_;                        // Number of elements used in beams_
+  gsl::span<int32_t> hypothesis_buffer_;  // Slice of the scorer buffer holding the hypotheses of this batch entry
+  size_t hypothesis_buffer_used_;         // Offset of available buffer, or length of used buffer.
   float length_penalty_;
   bool done_;
 };
 
 struct BeamSearchScorer : IBeamScorer {
   BeamSearchScorer(const IGenerationParameters& parameters,
-                   AllocatorPtr& allocator);
+                   AllocatorPtr& allocator,
+                   concurrency::ThreadPool* thread_pool = nullptr);
 
   void Process(ISequences& sequences,
                gsl::span<const float>& next_scores,
@@ -69,6 +73,13 @@ struct BeamSearchScorer : IBeamScorer {
   gsl::span<int32_t> GetNextTokens() override { return next_beam_tokens_; }
   gsl::span<int32_t> GetNextIndicesCPU() override { return next_beam_indices_; }
 
+  // Process the top 2 * num_beams candidates of one batch entry.
+  void ProcessBatch(size_t batch,
+                    ISequences& sequences,
+                    gsl::span<const float>& next_scores,
+                    gsl::span<const int32_t>& next_tokens,
+                    gsl::span<const int32_t>& next_indices);
+
   size_t batch_size_;
   size_t num_beams_;
   size_t max_length_;
@@ -76,7 +87,8 @@ struct BeamSearchScorer : IBeamScorer {
   int pad_token_id_;
   int eos_token_id_;
   bool early_stopping_;
-  int not_done_count_;  // When zero, every batch entry is done (starts at batch_size_)
+  int not_done_count_;                    // When zero, every batch entry is done (starts at batch_size_)
+  concurrency::ThreadPool* thread_pool_;  // Batch entries are processed in parallel when set
 
   IAllocatorUniquePtr<float> next_beam_scores_ptr_;
   gsl::span<float> next_beam_scores_;
@@ -88,8 +100,7 @@ struct BeamSearchScorer : IBeamScorer {
   gsl::span<int32_t> next_beam_indices_;
 
   IAllocatorUniquePtr<int32_t> hypothesis_buffer_ptr_;  // Allocated buffer to hold all hypotheses
-  gsl::span<int32_t> hypothesis_buffer_;                // Span of the allocated buffer
-  int hypothesis_buffer_used_{};                        // Offset of available buffer, or length of used buffer.
+  gsl::span<int32_t> hypothesis_buffer_;                // Span of the allocated buffer, one slice per batch entry
 
   IAllocatorUniquePtr<HypothesisScore> hypothesis_scores_ptr_;  // num_beams_ * batch_size_, divided into num_beams_ chunks per BeamHypothesis in beam_hyps_
   IAllocatorUniquePtr<BeamHypotheses> beam_hyps_ptr_;
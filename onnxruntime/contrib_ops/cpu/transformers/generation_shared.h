@@ -147,6 +147,7 @@ struct IGenerationParameters {
   int decoder_start_token_id;
   int no_repeat_ngram_size;
   bool early_stopping;
+  bool evict_finished_sequences = false;  // compact the decoder batch when sequences finish (greedy search only)
 
   // Parameters from inputs
   int min_length;
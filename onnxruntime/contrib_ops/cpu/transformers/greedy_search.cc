@@ -94,6 +94,11 @@ void GreedySearch::Init(const OpKernelInfo& info) {
     if (info.GetAttr<ONNX_NAMESPACE::GraphProto>("init_decoder", &proto).IsOK()) {
       has_init_decoder_ = true;
     }
+
+    // Check if the draft_decoder sub-graph attribute is present for speculative decoding.
+    if (info.GetAttr<ONNX_NAMESPACE::GraphProto>("draft_decoder", &proto).IsOK()) {
+      has_draft_decoder_ = true;
+    }
   }
 
   // Make sure the decoder sub-graph attribute is present for all model types.
@@ -132,6 +137,20 @@ Status GreedySearch::SetupSubgraphExecutionInfo(const SessionState& session_stat
 
       init_run_gpt_subgraph_ = std::move(res.second);
       init_run_decoder_feeds_fetches_manager_ = init_run_gpt_subgraph_->GetFeedsFetchesManager();
+    } else if (attribute_name == "draft_decoder") {
+      ORT_ENFORCE(draft_gpt_subgraph_ == nullptr, "SetupSubgraphExecutionInfo should only be called once for each subgraph.");
+      // The parameters come from the 'decoder' subgraph, so the draft decoder updates a copy.
+      GreedySearchParameters draft_parameters = parameters_;
+      auto res = gpt_details::CreateGptSubgraphAndUpdateParameters(node, session_state, attribute_name,
+                                                                   subgraph_session_state, draft_parameters);
+
+      auto status = res.first;
+      if (!status.IsOK()) {
+        return status;
+      }
+
+      draft_gpt_subgraph_ = std::move(res.second);
+      draft_decoder_feeds_fetches_manager_ = draft_gpt_subgraph_->GetFeedsFetchesManager();
     }
   } else if (parameters_.model_type == IGenerationParameters::kModelTypeT5) {  // encoder-decoder like T5
     ORT_THROW("Not Implemented");
@@ -178,6 +197,15 @@ Status GreedySearch::Compute(OpKernelContext* ctx) const {
                 "past_present_share_buffer mode must be same for init decoder and decoder subgraphes");
   }
 
+  auto* draft_decoder_session_state = ctx_internal->SubgraphSessionState("draft_decoder");
+  if (has_draft_decoder_) {
+    ORT_ENFORCE(draft_decoder_session_state, "Subgraph SessionState was not found for 'draft_decoder' attribute.");
+    ORT_ENFORCE(draft_decoder_feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
+    ORT_RETURN_IF_NOT(draft_gpt_subgraph_->vocab_size == gpt_subgraph_->vocab_size,
+                      "draft_decoder and decoder subgraphs shall have the same vocabulary size, got ",
+                      draft_gpt_subgraph_->vocab_size, " and ", gpt_subgraph_->vocab_size);
+  }
+
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
   // make a copy since we will update the parameters based on inputs later
@@ -206,6 +234,10 @@ Status GreedySearch::Compute(OpKernelContext* ctx) const {
 #ifdef USE_CUDA
       ORT_RETURN_IF_ERROR(impl.InitializeCuda(reorder_past_state_func_, cuda_device_prop_, cuda_device_arch_));
 #endif
+      if (has_draft_decoder_) {
+        impl.SetDraftDecoder(draft_decoder_session_state, draft_gpt_subgraph_.get(),
+                             draft_decoder_feeds_fetches_manager_);
+      }
       ORT_RETURN_IF_ERROR(impl.Initialize());
 
       return impl.Execute(init_run_decoder_feeds_fetches_manager_, *decoder_feeds_fetches_manager_);
@@ -230,6 +262,10 @@ Status GreedySearch::Compute(OpKernelContext* ctx) const {
 #ifdef USE_CUDA
       ORT_RETURN_IF_ERROR(impl.InitializeCuda(reorder_past_state_func_, cuda_device_prop_, cuda_device_arch_));
 #endif
+      if (has_draft_decoder_) {
+        impl.SetDraftDecoder(draft_decoder_session_state, draft_gpt_subgraph_.get(),
+                             draft_decoder_feeds_fetches_manager_);
+      }
       ORT_RETURN_IF_ERROR(impl.Initialize());
 
       return impl.Execute(init_run_decoder_feeds_fetches_manager_, *decoder_feeds_fetches_manager_);
@@ -3,6 +3,7 @@
 
 #pragma once
 #include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include "core/common/span_utils.h"
@@ -79,6 +80,15 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
   }
 #endif
 
+  // Attaches a draft decoder for speculative decoding.
+  void SetDraftDecoder(const SessionState* draft_decoder_session_state,
+                       GptSubgraph* draft_gpt_subgraph,
+                       const FeedsFetchesManager* draft_feeds_fetches_manager) {
+    draft_decoder_session_state_ = draft_decoder_session_state;
+    draft_gpt_subgraph_ = draft_gpt_subgraph;
+    draft_feeds_fetches_manager_ = draft_feeds_fetches_manager;
+  }
+
   // Execute beam search in iterations util stopping criteria is reached.
   // In each iteration, GPT subgraph is called, and next token for each sequence is generated.
   Status Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
@@ -101,10 +111,46 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
       gsl::span<const int32_t> next_tokens,
       int past_sequence_length);
 
+  // Removes the rows of finished sequences from the feeds of the next decoder run.
+  // `active_batch_ids` maps the rows of the feeds to the batch ids, and is updated to the rows that are kept.
+  Status EvictFinishedSequences(gsl::span<const bool> eos_meet,
+                                std::vector<int>& active_batch_ids,
+                                std::vector<OrtValue>& feeds,
+                                OrtValue& position_ids,
+                                gsl::span<int32_t> next_positions);
+
+  // Whether the tokens are generated with speculative decoding, which is supported for greedy search of one
+  // sequence on CPU.
+  bool UseSpeculativeDecoding() const;
+
+  // Generates all tokens with speculative decoding. In each step the draft decoder proposes tokens, which the
+  // decoder verifies in one run. Tokens are accepted until the first one that differs from greedy search with the
+  // decoder, which is then replaced by the token of the decoder. The sequence is the same as without the draft.
+  Status ExecuteSpeculative(const FeedsFetchesManager* init_run_feeds_fetches_manager,
+                            const FeedsFetchesManager& feeds_fetches_manager,
+                            std::vector<OrtValue>& feeds,
+                            GreedySearchState<T>& greedy_state,
+                            SamplingState<T>& sampling_state);
+
+  // Sets input_ids, position_ids and attention_mask of `feeds` to run `tokens`, which start at index `start` of the
+  // sequence, after a past state of length `start`.
+  void SetSpeculativeFeeds(std::vector<OrtValue>& feeds,
+                           gsl::span<const int32_t> tokens,
+                           int start,
+                           gsl::span<const int32_t> prompt_mask,
+                           int32_t prompt_positions);
+
+  // Copies logits of the active rows to their batch ids in logits of the whole batch. Finished rows are zero.
+  Status ScatterLogits(const OrtValue& logits, gsl::span<const int> active_batch_ids, OrtValue& batch_logits);
+
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
   GptSubgraph& gpt_subgraph_;
 
+  const SessionState* draft_decoder_session_state_ = nullptr;
+  GptSubgraph* draft_gpt_subgraph_ = nullptr;
+  const FeedsFetchesManager* draft_feeds_fetches_manager_ = nullptr;
+
   // Device specific functions
   GenerationDeviceHelper::CreateGptInputsFunc create_inputs_func_;
   GenerationDeviceHelper::AddToFeedsFunc add_to_feeds_func_;
@@ -187,6 +233,308 @@ Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
                             false);
 }
 
+namespace gpt_details {
+// Copies the slices `rows` along `axis` of `src` to a new tensor in `dst`.
+inline void GatherAlongAxis(const Tensor& src, size_t axis, gsl::span<const int> rows, AllocatorPtr allocator,
+                            OrtValue& dst) {
+  TensorShape shape = src.Shape();
+  const int64_t src_rows = shape[axis];
+  shape[axis] = static_cast<int64_t>(rows.size());
+  Tensor::InitOrtValue(src.DataType(), shape, std::move(allocator), dst);
+
+  const size_t row_bytes = SafeInt<size_t>(shape.SizeFromDimension(axis + 1)) * src.DataType()->Size();
+  const auto* src_data = static_cast<const char*>(src.DataRaw());
+  auto* dst_data = static_cast<char*>(dst.GetMutable<Tensor>()->MutableDataRaw());
+  for (int64_t outer = 0, num_outer = shape.SizeToDimension(axis); outer < num_outer; ++outer) {
+    for (size_t i = 0; i < rows.size(); ++i) {
+      memcpy(dst_data + (outer * static_cast<int64_t>(rows.size()) + i) * row_bytes,
+             src_data + (outer * src_rows + rows[i]) * row_bytes,
+             row_bytes);
+    }
+  }
+}
+
+// Returns the past state of the first `length` positions of a present state of shape
+// (2, batch_size, num_heads, total_sequence_length, head_size).
+inline void TruncatePastState(const Tensor& present, int length, AllocatorPtr allocator, OrtValue& past) {
+  std::vector<int> positions(static_cast<size_t>(length));
+  std::iota(positions.begin(), positions.end(), 0);
+  GatherAlongAxis(present, 3, positions, std::move(allocator), past);
+}
+
+// Returns the token with the largest logit of the last position in logits of shape (1, sequence_length, vocab_size).
+template <typename LogitsT>
+int32_t ArgMaxOfLastToken(const Tensor& logits) {
+  const int64_t vocab_size = logits.Shape()[2];
+  const LogitsT* last = logits.Data<LogitsT>() + (logits.Shape().Size() - vocab_size);
+  int64_t best = 0;
+  for (int64_t i = 1; i < vocab_size; ++i) {
+    if (static_cast<float>(last[i]) > static_cast<float>(last[best])) {
+      best = i;
+    }
+  }
+  return static_cast<int32_t>(best);
+}
+}  // namespace gpt_details
+
+template <typename T, typename ParametersT>
+bool GreedySearchGpt<T, ParametersT>::UseSpeculativeDecoding() const {
+  return draft_gpt_subgraph_ != nullptr &&
+         std::is_same<ParametersT, GreedySearchParameters>::value &&
+         this->parameters_->BatchBeamSize() == 1 &&
+         !this->IsCuda() &&
+         !gpt_subgraph_.past_present_share_buffer_ &&
+         !draft_gpt_subgraph_->past_present_share_buffer_;
+}
+
+template <typename T, typename ParametersT>
+void GreedySearchGpt<T, ParametersT>::SetSpeculativeFeeds(std::vector<OrtValue>& feeds,
+                                                          gsl::span<const int32_t> tokens,
+                                                          int start,
+                                                          gsl::span<const int32_t> prompt_mask,
+                                                          int32_t prompt_positions) {
+  const int prompt_length = static_cast<int>(prompt_mask.size());
+  const int64_t num_tokens = static_cast<int64_t>(tokens.size());
+  auto int32_type = DataTypeImpl::GetType<int32_t>();
+
+  int64_t dims[] = {1, num_tokens};
+  TensorShape shape(&dims[0], 2);
+  OrtValue input_ids;
+  Tensor::InitOrtValue(int32_type, shape, this->cpu_allocator_, input_ids);
+  OrtValue position_ids;
+  Tensor::InitOrtValue(int32_type, shape, this->cpu_allocator_, position_ids);
+  int32_t* input_ids_data = input_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  int32_t* position_data = position_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  for (int64_t i = 0; i < num_tokens; ++i) {
+    input_ids_data[i] = tokens[i];
+    // tokens after the prompt follow its last position
+    position_data[i] = prompt_positions + (start + static_cast<int>(i) - prompt_length);
+  }
+
+  // attention_mask: the prompt as given, and 1 for every generated token
+  int64_t mask_dims[] = {1, start + num_tokens};
+  OrtValue attention_mask;
+  Tensor::InitOrtValue(int32_type, TensorShape(&mask_dims[0], 2), this->cpu_allocator_, attention_mask);
+  int32_t* mask_data = attention_mask.GetMutable<Tensor>()->MutableData<int32_t>();
+  std::copy(prompt_mask.begin(), prompt_mask.end(), mask_data);
+  std::fill(mask_data + prompt_length, mask_data + mask_dims[1], 1);
+
+  feeds[0] = std::move(input_ids);
+  feeds[1] = std::move(position_ids);
+  feeds[2] = std::move(attention_mask);
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::ExecuteSpeculative(const FeedsFetchesManager* init_run_feeds_fetches_manager,
+                                                           const FeedsFetchesManager& feeds_fetches_manager,
+                                                           std::vector<OrtValue>& feeds,
+                                                           GreedySearchState<T>& greedy_state,
+                                                           SamplingState<T>& sampling_state) {
+  const ParametersT* parameters = this->parameters_;
+  const int prompt_length = parameters->sequence_length;
+  const int32_t prompt_positions = greedy_state.sequence_lengths[0];
+  const int eos_token_id = parameters->eos_token_id;
+
+  // attention_mask of the prompt, which is (1, sequence_length) in the initial feeds
+  gsl::span<const int32_t> initial_mask = feeds[2].Get<Tensor>().DataAsSpan<int32_t>();
+  std::vector<int32_t> prompt_mask(initial_mask.begin(), initial_mask.end());
+
+  auto set_past_state = [this](const GptSubgraph& subgraph, const std::vector<OrtValue>& fetches,
+                               std::vector<OrtValue>& next_feeds, int past_length) {
+    for (int layer = 0; layer < subgraph.num_layers; ++layer) {
+      const OrtValue& present = fetches[subgraph.GetFirstPresentOutputIndex() + layer];
+      OrtValue& past = next_feeds[subgraph.GetFirstPastInputIndex() + layer];
+      if (present.Get<Tensor>().Shape()[3] == past_length) {
+        past = present;
+      } else {
+        gpt_details::TruncatePastState(present.Get<Tensor>(), past_length, this->cpu_allocator_, past);
+      }
+    }
+  };
+
+  auto run = [this](const SessionState& session_state, const FeedsFetchesManager& ffm,
+                    const std::vector<OrtValue>& run_feeds, std::vector<OrtValue>& run_fetches) {
+    run_fetches.clear();
+    return utils::ExecuteSubgraph(session_state, ffm, run_feeds, run_fetches, {},
+                                  ExecutionMode::ORT_SEQUENTIAL, this->context_.GetTerminateFlag(),
+                                  this->context_.Logger(), this->ort_stream_);
+  };
+
+  // The draft decoder runs the prompt first, so its past state covers the prompt.
+  std::vector<OrtValue> draft_feeds;
+  std::vector<OrtValue> draft_fetches;
+  IAllocatorUniquePtr<char> draft_buffer;
+  OrtValue draft_input_ids;
+  int32_t draft_sequence_length = 0;
+  gsl::span<int32_t> draft_sequence_lengths(&draft_sequence_length, 1);
+  ORT_RETURN_IF_ERROR(draft_gpt_subgraph_->CreateInitialFeeds(this->context_.GetInputOrtValue(0)->Get<Tensor>(),
+                                                              this->implicit_inputs_,
+                                                              parameters->num_beams,
+                                                              parameters->pad_token_id,
+                                                              draft_sequence_lengths,
+                                                              draft_input_ids,
+                                                              this->context_.GetInputOrtValue(6),
+                                                              draft_feeds,
+                                                              this->create_inputs_func_,
+                                                              this->add_to_feeds_func_,
+                                                              draft_buffer,
+                                                              this->ort_stream_,
+                                                              parameters->max_length));
+  ORT_RETURN_IF_ERROR(run(*draft_decoder_session_state_, *draft_feeds_fetches_manager_, draft_feeds, draft_fetches));
+  set_past_state(*draft_gpt_subgraph_, draft_fetches, draft_feeds, prompt_length);
+  int draft_past_length = prompt_length;
+
+  // The decoder runs the prompt and generates the first token.
+  std::vector<OrtValue> fetches;
+  if (init_run_decoder_session_state_ != nullptr) {
+    ORT_RETURN_IF_ERROR(run(*init_run_decoder_session_state_, *init_run_feeds_fetches_manager, feeds, fetches));
+  } else {
+    ORT_RETURN_IF_ERROR(run(this->decoder_session_state_, feeds_fetches_manager, feeds, fetches));
+  }
+
+  int counter = 1;
+  gsl::span<int32_t> next_tokens;
+  ORT_RETURN_IF_ERROR(this->GenerateNextToken(fetches[0], next_tokens, greedy_state, sampling_state,
+                                              counter, eos_token_id));
+  int current_length = prompt_length + 1;
+  set_past_state(gpt_subgraph_, fetches, feeds, prompt_length);
+
+  std::vector<int32_t> draft_tokens;
+  std::vector<int32_t> verify_tokens;
+  while (current_length < parameters->max_length && !greedy_state.eos_meet[0]) {
+    // The last token of the sequence is not in the past state of the decoder. Every verified run generates
+    // up to one token more than the number of proposed tokens.
+    const int num_draft_tokens = std::min(parameters->num_speculative_tokens,
+                                          parameters->max_length - current_length - 1);
+    gsl::span<const int32_t> sequence = greedy_state.sequences.GetSequence(0);
+
+    draft_tokens.clear();
+    for (int i = 0; i < num_draft_tokens; ++i) {
+      // the first run catches up with the tokens that the draft decoder has not seen yet
+      gsl::span<const int32_t> tokens = (i == 0)
+                                            ? sequence.subspan(draft_past_length, current_length - draft_past_length)
+                                            : gsl::make_span(&draft_tokens.back(), 1);
+      SetSpeculativeFeeds(draft_feeds, tokens, draft_past_length, prompt_mask, prompt_positions);
+      ORT_RETURN_IF_ERROR(run(*draft_decoder_session_state_, *draft_feeds_fetches_manager_, draft_feeds,
+                              draft_fetches));
+      draft_past_length += static_cast<int>(tokens.size());
+      set_past_state(*draft_gpt_subgraph_, draft_fetches, draft_feeds, draft_past_length);
+
+      const Tensor& draft_logits = draft_fetches[0].Get<Tensor>();
+      draft_tokens.push_back(draft_logits.IsDataType<float>()
+                                 ? gpt_details::ArgMaxOfLastToken<float>(draft_logits)
+                                 : gpt_details::ArgMaxOfLastToken<MLFloat16>(draft_logits));
+    }
+
+    // The decoder runs the last token and the proposed tokens at once.
+    const int start = current_length - 1;
+    verify_tokens.assign(1, sequence[start]);
+    verify_tokens.insert(verify_tokens.end(), draft_tokens.begin(), draft_tokens.end());
+    SetSpeculativeFeeds(feeds, verify_tokens, start, prompt_mask, prompt_positions);
+    ORT_RETURN_IF_ERROR(run(this->decoder_session_state_, feeds_fetches_manager, feeds, fetches));
+
+    // Generate tokens from the logits of each position while they match the proposed tokens.
+    const Tensor& logits = fetches[0].Get<Tensor>();
+    const int64_t vocab_size = logits.Shape()[2];
+    int64_t logits_dims[] = {1, 1, vocab_size};
+    int num_accepted = 0;
+    for (int i = 0; i <= num_draft_tokens; ++i) {
+      OrtValue position_logits;
+      Tensor::InitOrtValue(logits.DataType(), TensorShape(&logits_dims[0], 3),
+                           const_cast<T*>(logits.Data<T>()) + i * vocab_size, logits.Location(), position_logits);
+      ORT_RETURN_IF_ERROR(this->GenerateNextToken(position_logits, next_tokens, greedy_state, sampling_state,
+                                                  ++counter, eos_token_id));
+      ++current_length;
+
+      if (greedy_state.eos_meet[0] || i == num_draft_tokens || next_tokens[0] != draft_tokens[i]) {
+        break;
+      }
+      ++num_accepted;
+    }
+
+    // Drop the past state of the rejected tokens. The past state keeps every token but the last.
+    set_past_state(gpt_subgraph_, fetches, feeds, start + 1 + num_accepted);
+    if (draft_past_length > current_length - 1) {
+      draft_past_length = current_length - 1;
+      set_past_state(*draft_gpt_subgraph_, draft_fetches, draft_feeds, draft_past_length);
+    }
+  }
+
+  return Status::OK();
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::EvictFinishedSequences(gsl::span<const bool> eos_meet,
+                                                               std::vector<int>& active_batch_ids,
+                                                               std::vector<OrtValue>& feeds,
+                                                               OrtValue& position_ids,
+                                                               gsl::span<int32_t> next_positions) {
+  // rows of the feeds that are kept
+  std::vector<int> rows;
+  std::vector<int> kept_batch_ids;
+  for (size_t row = 0; row < active_batch_ids.size(); ++row) {
+    if (!eos_meet[active_batch_ids[row]]) {
+      rows.push_back(static_cast<int>(row));
+      kept_batch_ids.push_back(active_batch_ids[row]);
+    }
+  }
+
+  if (rows.size() == active_batch_ids.size() || rows.empty()) {
+    return Status::OK();
+  }
+
+  // input_ids: (B, 1), attention_mask: (B, current_length)
+  for (int i : {0, 2}) {
+    OrtValue compacted;
+    gpt_details::GatherAlongAxis(feeds[i].Get<Tensor>(), 0, rows, this->cpu_allocator_, compacted);
+    feeds[i] = std::move(compacted);
+  }
+
+  // position_ids: (B, 1) in the buffer that UpdateFeeds increments in place. Rows only move to lower indices.
+  for (size_t i = 0; i < rows.size(); ++i) {
+    next_positions[i] = next_positions[rows[i]];
+  }
+  int64_t position_dims[] = {static_cast<int64_t>(rows.size()), 1};
+  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), TensorShape(&position_dims[0], 2), next_positions.data(),
+                       this->temp_space_allocator_->Info(), position_ids);
+  feeds[1] = position_ids;
+
+  // past_*: (2, B, num_heads, past_sequence_length, head_size)
+  for (int layer = 0; layer < gpt_subgraph_.num_layers; ++layer) {
+    const int feed_idx = gpt_subgraph_.GetFirstPastInputIndex() + layer;
+    OrtValue compacted;
+    gpt_details::GatherAlongAxis(feeds[feed_idx].Get<Tensor>(), 1, rows, this->cpu_allocator_, compacted);
+    feeds[feed_idx] = std::move(compacted);
+  }
+
+  active_batch_ids = std::move(kept_batch_ids);
+  return Status::OK();
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::ScatterLogits(const OrtValue& logits,
+                                                      gsl::span<const int> active_batch_ids,
+                                                      OrtValue& batch_logits) {
+  // logits: (B, sequence_length, vocab_size)
+  const Tensor& active_logits = logits.Get<Tensor>();
+  TensorShape shape = active_logits.Shape();
+  ORT_RETURN_IF_NOT(shape.NumDimensions() == 3 && shape[0] == static_cast<int64_t>(active_batch_ids.size()),
+                    "logits shall have shape (batch_size, sequence_length, vocab_size), got ", shape);
+  shape[0] = this->parameters_->BatchBeamSize();
+  Tensor::InitOrtValue(active_logits.DataType(), shape, this->cpu_allocator_, batch_logits);
+
+  Tensor* dst = batch_logits.GetMutable<Tensor>();
+  memset(dst->MutableDataRaw(), 0, dst->SizeInBytes());
+  const size_t row_bytes = SafeInt<size_t>(shape.SizeFromDimension(1)) * active_logits.DataType()->Size();
+  const auto* src_data = static_cast<const char*>(active_logits.DataRaw());
+  auto* dst_data = static_cast<char*>(dst->MutableDataRaw());
+  for (size_t row = 0; row < active_batch_ids.size(); ++row) {
+    memcpy(dst_data + active_batch_ids[row] * row_bytes, src_data + row * row_bytes, row_bytes);
+  }
+
+  return Status::OK();
+}
+
 template <typename T, typename ParametersT>
 Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                                                 const FeedsFetchesManager& feeds_fetches_manager) {
@@ -268,7 +616,23 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                        this->temp_space_allocator_->Info(),
                        position_ids);
 
-  int current_length = parameters->sequence_length;
+  // Batch ids of the rows that the decoder runs. Finished sequences are only evicted on CPU, where the past state
+  // is not in a buffer shared with the present state.
+  const bool evict_finished_sequences = parameters->evict_finished_sequences && !this->IsCuda() &&
+                                        !gpt_subgraph_.past_present_share_buffer_;
+  std::vector<int> active_batch_ids(static_cast<size_t>(parameters->BatchBeamSize()));
+  std::iota(active_batch_ids.begin(), active_batch_ids.end(), 0);
+  OrtValue batch_logits;
+  std::vector<int32_t> active_next_tokens;
+
+  // Speculative decoding generates the whole sequence, and the loop below is skipped.
+  const bool use_speculative_decoding = UseSpeculativeDecoding();
+  if (use_speculative_decoding) {
+    ORT_RETURN_IF_ERROR(ExecuteSpeculative(init_run_feeds_fetches_manager, feeds_fetches_manager, feeds,
+                                           greedy_state, sampling_state));
+  }
+
+  int current_length = use_speculative_decoding ? parameters->max_length : parameters->sequence_length;
   int iteration_counter = 0;
   while (current_length < parameters->max_length) {
 #ifdef DEBUG_GENERATION
@@ -312,7 +676,11 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
 
     ORT_RETURN_IF_ERROR(status);
 
-    const OrtValue& logits = fetches[0];
+    const bool evicted = active_batch_ids.size() < static_cast<size_t>(parameters->BatchBeamSize());
+    if (evicted) {
+      ORT_RETURN_IF_ERROR(ScatterLogits(fetches[0], active_batch_ids, batch_logits));
+    }
+    const OrtValue& logits = evicted ? batch_logits : fetches[0];
     gsl::span<int32_t> next_tokens;
 
     ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits,
@@ -361,10 +729,24 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
     if (current_length < parameters->max_length) {
       bool increase_position = (iteration_counter > 1);
 
+      gsl::span<const int32_t> feed_tokens = ReinterpretAsSpan<const int32_t>(next_tokens);
+      if (evicted) {
+        active_next_tokens.resize(active_batch_ids.size());
+        for (size_t row = 0; row < active_batch_ids.size(); ++row) {
+          active_next_tokens[row] = next_tokens[active_batch_ids[row]];
+        }
+        feed_tokens = active_next_tokens;
+      }
+
       ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
                                       position_ids, increase_position,
-                                      ReinterpretAsSpan<const int32_t>(next_tokens),
+                                      feed_tokens,
                                       current_length - 1));
+
+      if (evict_finished_sequences) {
+        ORT_RETURN_IF_ERROR(EvictFinishedSequences(eos_meet, active_batch_ids, feeds, position_ids,
+                                                   greedy_state.next_positions));
+      }
     }
     if (gpt_subgraph_.past_present_share_buffer_) {
       // clear fetched values before presents[]
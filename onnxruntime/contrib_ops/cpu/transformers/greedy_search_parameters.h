@@ -16,6 +16,9 @@ struct GreedySearchParameters : public BeamSearchParameters {
   void ParseFromAttributes(const OpKernelInfo& info) override;
 
   void ParseFromInputs(OpKernelContext* context);
+
+  // Number of tokens the draft decoder proposes per run of the decoder in speculative decoding.
+  int num_speculative_tokens = 0;
 };
 
 }  // namespace transformers
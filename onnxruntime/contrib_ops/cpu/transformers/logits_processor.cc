@@ -96,95 +96,61 @@ void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
 }
 
 template <typename T>
-VocabMaskLogitsProcessor<T>::VocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask)
-    : vocab_mask_(vocab_mask) {
+VocabLogitsProcessor<T>::VocabLogitsProcessor(const gsl::span<const int32_t>& vocab_mask,
+                                              const gsl::span<const int32_t>& prefix_vocab_mask,
+                                              int batch_size,
+                                              float temperature,
+                                              const gsl::span<const int32_t>& presence_mask,
+                                              float presence_penalty)
+    : vocab_mask_(vocab_mask),
+      prefix_vocab_mask_(prefix_vocab_mask),
+      batch_size_(batch_size),
+      temperature_(temperature > 0.0f ? temperature : 1.0f),
+      presence_mask_(presence_mask),
+      presence_penalty_(presence_mask.empty() ? 0.0f : presence_penalty) {
 }
 
 template <typename T>
-void VocabMaskLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                          NextTokenScores<T>& next_token_scores) {
-  assert(!vocab_mask_.empty());
-
-  // Process vocabulary mask and set tokens with mask value 0 to -inf.
-  T* p = next_token_scores.scores.data();
-  // next_token_scores shape (batch_size * num_beams, vocab_size)
-  // vocab_mask shape (vocab_size).
-  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
-    for (int j = 0; j < next_token_scores.vocab_size; j++, p++) {
-      if (vocab_mask_[j] == 0) {
-        *p = std::numeric_limits<T>::lowest();
-      }
-    }
-  }
-}
-
-template <typename T>
-PrefixVocabMaskLogitsProcessor<T>::PrefixVocabMaskLogitsProcessor(const gsl::span<const int32_t>& prefix_vocab_mask,
-                                                                  int batch_size)
-    : prefix_vocab_mask_(prefix_vocab_mask),
-      batch_size_(batch_size) {
+bool VocabLogitsProcessor<T>::IsActive() const {
+  return !vocab_mask_.empty() || !prefix_vocab_mask_.empty() || temperature_ != 1.0f || presence_penalty_ != 0.0f;
 }
 
 template <typename T>
-void PrefixVocabMaskLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                                NextTokenScores<T>& next_token_scores) {
-  assert(!prefix_vocab_mask_.empty());
-
+void VocabLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
+                                      NextTokenScores<T>& next_token_scores) {
   // next_token_scores shape (batch_size * num_beams, vocab_size)
-  int num_beams = next_token_scores.batch_beam_size / batch_size_;
+  const int vocab_size = next_token_scores.vocab_size;
+  const int num_beams = next_token_scores.batch_beam_size / batch_size_;
   assert(num_beams * batch_size_ == next_token_scores.batch_beam_size);
 
-  // Process prefix vocabulary mask and set tokens with mask value 0 to -inf.
-  // prefix_vocab_mask shape (batch_size, vocab_size).
-  T* p = next_token_scores.scores.data();
-  for (int i = 0; i < batch_size_; i++) {
-    size_t prefix_vocab_mask_offset = SafeInt<size_t>(i) * next_token_scores.vocab_size;
-    for (int j = 0; j < num_beams; j++) {
-      for (int k = 0; k < next_token_scores.vocab_size; k++, p++) {
-        if (prefix_vocab_mask_[prefix_vocab_mask_offset + static_cast<size_t>(k)] == 0) {
-          *p = std::numeric_limits<T>::lowest();
-        }
+  const bool apply_prefix_vocab_mask = is_first_step_ && !prefix_vocab_mask_.empty();
+  const T lowest = std::numeric_limits<T>::lowest();
+
+  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
+    T* p = next_token_scores.GetScores(i).data();
+    const size_t batch_offset = SafeInt<size_t>(i / num_beams) * vocab_size;
+
+    // The checks below do not depend on the token, so the compiler can hoist them out of the loops.
+    if (!vocab_mask_.empty() || apply_prefix_vocab_mask) {
+      const int32_t* vocab_mask = vocab_mask_.data();
+      const int32_t* prefix_vocab_mask = apply_prefix_vocab_mask ? prefix_vocab_mask_.data() + batch_offset : nullptr;
+      for (int j = 0; j < vocab_size; j++) {
+        const bool masked = (vocab_mask != nullptr && vocab_mask[j] == 0) ||
+                            (prefix_vocab_mask != nullptr && prefix_vocab_mask[j] == 0);
+        p[j] = masked ? lowest : p[j];
       }
     }
-  }
-}
-
-template <typename T>
-TemperatureLogitsProcessor<T>::TemperatureLogitsProcessor(float temperature) : temperature_(temperature) {
-}
-
-template <typename T>
-void TemperatureLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                            NextTokenScores<T>& next_token_scores) {
-  if (temperature_ == 1.0f) {
-    return;
-  }
-
-  T* p = next_token_scores.scores.data();
-  for (size_t i = 0; i < next_token_scores.scores.size(); i++) {
-    *p /= temperature_;
-    ++p;
-  }
-}
-
-template <typename T>
-PresencePenaltyLogitsProcessor<T>::PresencePenaltyLogitsProcessor(const gsl::span<const int32_t>& presence_mask,
-                                                                  float presence_penalty)
-    : presence_mask_(presence_mask), presence_penalty_(presence_penalty) {
-}
-
-template <typename T>
-void PresencePenaltyLogitsProcessor<T>::Process(const ISequences*,
-                                                NextTokenScores<T>& next_token_scores) {
-  if (presence_penalty_ == 0.0f) {
-    return;
-  }
 
-  assert(!presence_mask_.empty());
-
-  T* p = next_token_scores.scores.data();
-  for (size_t i = 0; i < next_token_scores.scores.size(); i++) {
-    *p -= presence_mask_[i] * presence_penalty_;
+    if (temperature_ != 1.0f || presence_penalty_ != 0.0f) {
+      const int32_t* presence_mask = presence_penalty_ != 0.0f ? presence_mask_.data() + batch_offset : nullptr;
+      for (int j = 0; j < vocab_size; j++) {
+        T score = p[j] / temperature_;
+        if (presence_mask != nullptr) {
+          score -= presence_mask[j] * presence_penalty_;
+        }
+        p[j] = score;
+      }
+    }
   }
 }
 
@@ -204,11 +170,11 @@ void LogitsProcessorList::Process(const ISequences* sequences,
                                   gsl::span<float>& next_token_scores,
                                   int step) {
   NextTokenScores<float> input_scores = {next_token_scores, batch_beam_size_, vocab_size_};
+
+  // Prefix vocab mask is applied to first iteration only.
+  vocab_processor_->SetFirstStep(step <= 1);
+
   for (size_t i = 0; i < processor_list_.size(); i++) {
-    // Prefix vocab mask is applied to first iteration only.
-    if (step > 1 && processor_list_[i] == prefix_vocab_mask_processor_.get()) {
-      continue;
-    }
     processor_list_[i]->Process(sequences, input_scores);
   }
 }
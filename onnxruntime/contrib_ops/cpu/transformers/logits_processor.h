@@ -90,70 +90,34 @@ class NoRepeatNGramLogitsProcessor : public ILogitsProcessor<T> {
   int ngram_size_;
 };
 
+// Applies the vocab mask, the prefix vocab mask (on the first step only), temperature and presence penalty in that
+// order, in a single pass over the scores of the whole vocabulary.
 template <typename T>
-class VocabMaskLogitsProcessor : public ILogitsProcessor<T> {
+class VocabLogitsProcessor : public ILogitsProcessor<T> {
  public:
-  VocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask);
+  VocabLogitsProcessor(const gsl::span<const int32_t>& vocab_mask,
+                       const gsl::span<const int32_t>& prefix_vocab_mask,
+                       int batch_size,
+                       float temperature,
+                       const gsl::span<const int32_t>& presence_mask,
+                       float presence_penalty);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+  // Returns false when none of the processors changes the scores.
+  bool IsActive() const;
 
- private:
-  gsl::span<const int32_t> vocab_mask_;
-};
-
-template <typename T>
-class PrefixVocabMaskLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  PrefixVocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask, int batch_size);
+  void SetFirstStep(bool is_first_step) { is_first_step_ = is_first_step; }
 
   void Process(const ISequences* sequences,
                NextTokenScores<T>& next_token_scores) override;
 
  private:
-  gsl::span<const int32_t> prefix_vocab_mask_;
+  gsl::span<const int32_t> vocab_mask_;         // shape (vocab_size)
+  gsl::span<const int32_t> prefix_vocab_mask_;  // shape (batch_size, vocab_size)
   const int batch_size_;
-};
-
-template <typename T>
-class TemperatureLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  TemperatureLogitsProcessor(float temperature);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
   float temperature_;
-};
-
-// template <typename T>
-// class TopPLogitsProcessor : public ILogitsProcessor<T> {
-//  public:
-//   TopPLogitsProcessor(float top_p, float filter_value,
-//                       onnxruntime::concurrency::ThreadPool* thread_pool);
-
-//   void Process(const ISequences* sequences,
-//                NextTokenScores<T>& next_token_scores) override;
-
-//  private:
-//   float top_p_;
-//   float filter_value_;
-//   onnxruntime::concurrency::ThreadPool* thread_pool_;
-// };
-
-template <typename T>
-class PresencePenaltyLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  PresencePenaltyLogitsProcessor(const gsl::span<const int32_t>& presence_mask,
-                                 float presence_penalty);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
-  gsl::span<const int32_t> presence_mask_;
+  gsl::span<const int32_t> presence_mask_;  // shape (batch_size, vocab_size)
   float presence_penalty_;
+  bool is_first_step_ = true;
 };
 
 template <typename T>
@@ -318,34 +282,21 @@ class LogitsProcessorList : public ILogitsProcessorList {
       processor_list_.push_back(no_repeat_ngram_processor_.get());
     }
 
-    if (!parameters.vocab_mask.empty()) {
-      vocab_mask_processor_ = std::make_unique<VocabMaskLogitsProcessor<float>>(parameters.vocab_mask);
-      processor_list_.push_back(vocab_mask_processor_.get());
-    }
-
-    if (!parameters.prefix_vocab_mask.empty()) {
-      prefix_vocab_mask_processor_ = std::make_unique<
-          PrefixVocabMaskLogitsProcessor<float>>(parameters.prefix_vocab_mask,
-                                                 parameters.batch_size);
-      processor_list_.push_back(prefix_vocab_mask_processor_.get());
-    }
-
     if (parameters.min_length > 0) {
       min_length_processor_ = std::make_unique<MinLengthLogitsProcessor<float>>(parameters.min_length,
                                                                                 parameters.eos_token_id);
       processor_list_.push_back(min_length_processor_.get());
     }
 
-    if (parameters.temperature > 0) {
-      temperature_processor_ = std::make_unique<TemperatureLogitsProcessor<float>>(parameters.temperature);
-      processor_list_.push_back(temperature_processor_.get());
-    }
-
-    if (!parameters.presence_mask.empty()) {
-      presence_penalty_processor_ = std::make_unique<
-          PresencePenaltyLogitsProcessor<float>>(parameters.presence_mask,
-                                                 parameters.presence_penalty);
-      processor_list_.push_back(presence_penalty_processor_.get());
+    // The min length processor only sets the score of EOS to lowest, so it can run before the vocab masks.
+    vocab_processor_ = std::make_unique<VocabLogitsProcessor<float>>(parameters.vocab_mask,
+                                                                      parameters.prefix_vocab_mask,
+                                                                      parameters.batch_size,
+                                                                      parameters.temperature,
+                                                                      parameters.presence_mask,
+                                                                      parameters.presence_penalty);
+    if (vocab_processor_->IsActive()) {
+      processor_list_.push_back(vocab_processor_.get());
     }
 
     // Add timestamp processor for whisper model
@@ -373,11 +324,8 @@ class LogitsProcessorList : public ILogitsProcessorList {
 
   std::unique_ptr<RepetitionPenaltyLogitsProcessor<float>> repetition_penalty_processor_;
   std::unique_ptr<NoRepeatNGramLogitsProcessor<float>> no_repeat_ngram_processor_;
-  std::unique_ptr<VocabMaskLogitsProcessor<float>> vocab_mask_processor_;
-  std::unique_ptr<PrefixVocabMaskLogitsProcessor<float>> prefix_vocab_mask_processor_;
   std::unique_ptr<MinLengthLogitsProcessor<float>> min_length_processor_;
-  std::unique_ptr<TemperatureLogitsProcessor<float>> temperature_processor_;
-  std::unique_ptr<PresencePenaltyLogitsProcessor<float>> presence_penalty_processor_;
+  std::unique_ptr<VocabLogitsProcessor<float>> vocab_processor_;
   std::unique_ptr<TimestampLogitsProcessor<float>> timestamp_processor_;
 };
 
@@ -65,30 +65,33 @@ Status Sample(AllocatorPtr& allocator,
   ORT_UNUSED_PARAMETER(dumper);
 
   gsl::span<T>& sorted_scores = sampling_state->sorted_scores;
-  memcpy(sorted_scores.data(), next_token_scores.data(), next_token_scores.size_bytes());
   std::vector<size_t> sorted_indices(static_cast<size_t>(parameters->batch_size) * static_cast<size_t>(parameters->vocab_size));
 
-  std::function<bool(T, T)> predicator;
+  // sort the indices of each row, and gather the sorted scores from them instead of sorting the scores a second time.
+  // the rows are independent so they are sorted in parallel.
+  auto sort_rows = [&](auto predicator) {
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(parameters->batch_size), [&](std::ptrdiff_t batch) {
+          const size_t offset = static_cast<size_t>(batch) * static_cast<size_t>(parameters->vocab_size);
+          auto indices_begin = sorted_indices.begin() + offset;
+          auto indices_end = indices_begin + parameters->vocab_size;
+          gsl::span<T> next_token_score = next_token_scores.subspan(offset, parameters->vocab_size);
+          std::iota(indices_begin, indices_end, 0);
+          std::sort(indices_begin, indices_end,
+                    [&next_token_score, &predicator](size_t i1, size_t i2) {
+                      return predicator(next_token_score[i1], next_token_score[i2]);
+                    });
+
+          for (size_t j = 0; j < static_cast<size_t>(parameters->vocab_size); j++) {
+            sorted_scores[offset + j] = next_token_score[indices_begin[j]];
+          }
+        });
+  };
+
   if (parameters->custom_sampling) {
-    predicator = std::greater<T>();
+    sort_rows(std::greater<T>());
   } else {
-    predicator = std::less<T>();
-  }
-
-  // TODO: This could be optimized with allocated buffer and handwritten sort algorithm
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    auto indices_begin = sorted_indices.begin() + i * parameters->vocab_size;
-    auto indices_end = sorted_indices.begin() + (i + 1) * parameters->vocab_size;
-    gsl::span<T> next_token_score = next_token_scores.subspan(i * parameters->vocab_size, parameters->vocab_size);
-    std::iota(indices_begin, indices_end, 0);
-    std::sort(indices_begin, indices_end,
-              [&next_token_score, &predicator](size_t i1, size_t i2) {
-                return predicator(next_token_score[i1], next_token_score[i2]);
-              });
-
-    std::sort(sorted_scores.begin() + i * parameters->vocab_size,
-              sorted_scores.begin() + (i + 1) * parameters->vocab_size,
-              predicator);
+    sort_rows(std::less<T>());
   }
 
 #ifdef DEBUG_GENERATION
@@ -19,6 +19,7 @@ void SamplingParameters::ParseFromAttributes(const OpKernelInfo& info) {
   presence_penalty = info.GetAttrOrDefault<float>("presence_penalty", 0.0f);
   custom_sampling = static_cast<int>(info.GetAttrOrDefault<int64_t>("custom", 0));
   vocab_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("vocab_size", -1));
+  evict_finished_sequences = info.GetAttrOrDefault<int64_t>("evict_finished_sequences", 0) == 1;
 }
 
 void SamplingParameters::ParseFromInputs(OpKernelContext* context) {
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
 #include "contrib_ops/cpu/transformers/sequences.h"
 
@@ -20,6 +21,7 @@ void Sequences::Init(gsl::span<int32_t> buffer, int batch_beam_size, int sequenc
   batch_beam_size_ = batch_beam_size;
   max_length_ = max_length;
   current_length_ = sequence_length;
+  materialized_length_ = sequence_length;
 }
 
 void Sequences::InitDevice(gsl::span<int32_t> buffer) {
@@ -28,6 +30,10 @@ void Sequences::InitDevice(gsl::span<int32_t> buffer) {
 }
 
 gsl::span<const int32_t> Sequences::GetSequence(int beam_index) const {
+  if (materialized_length_ < current_length_) {
+    Materialize();
+  }
+
   gsl::span<const int32_t> buffer = sequences[current_sequences_buffer];
   return buffer.subspan(SafeInt<size_t>(beam_index) * max_length_, static_cast<gsl::index>(current_length_));
 }
@@ -49,25 +55,57 @@ void Sequences::PrintSequences(const IConsoleDumper* dumper) const {
 void Sequences::AppendNextTokenToSequences(
     gsl::span<int32_t>& beam_indices,
     gsl::span<int32_t>& beam_next_tokens) {
+  if (next_tokens_.empty()) {
+    const size_t history_size = SafeInt<size_t>(batch_beam_size_) * max_length_;
+    next_tokens_.resize(history_size);
+    beam_indices_.resize(history_size);
+  }
+
+  const size_t offset = SafeInt<size_t>(current_length_) * batch_beam_size_;
+  gsl::copy(beam_next_tokens.first(batch_beam_size_), gsl::make_span(next_tokens_).subspan(offset, batch_beam_size_));
+  gsl::copy(beam_indices.first(batch_beam_size_), gsl::make_span(beam_indices_).subspan(offset, batch_beam_size_));
+
+  ++current_length_;
+}
+
+void Sequences::Materialize() const {
+  // Find the beam in the active buffer that each beam descends from.
+  InlinedVector<int32_t> origins(batch_beam_size_);
+  bool in_place = true;
+  for (int i = 0; i < batch_beam_size_; i++) {
+    int32_t beam = i;
+    for (int t = current_length_ - 1; t >= materialized_length_; t--) {
+      beam = beam_indices_[SafeInt<size_t>(t) * batch_beam_size_ + beam];
+    }
+    origins[i] = beam;
+    in_place = in_place && beam == i;
+  }
+
+  // Without a reordering, only the new tokens are written and the active buffer is kept.
   gsl::span<const int32_t> input = sequences[current_sequences_buffer];
-  gsl::span<int32_t> output = sequences[current_sequences_buffer ^ 1];
+  gsl::span<int32_t> output = sequences[in_place ? current_sequences_buffer : current_sequences_buffer ^ 1];
 
   for (int i = 0; i < batch_beam_size_; i++) {
-    int beam_index = beam_indices[i];
-    gsl::span<const int32_t> source = input.subspan(SafeInt<size_t>(beam_index) * max_length_,
-                                                    static_cast<gsl::index>(current_length_));
     gsl::span<int32_t> target = output.subspan(SafeInt<size_t>(i) * max_length_,
                                                static_cast<gsl::index>(current_length_));
-    gsl::copy(source, target);
-
-    // Append next token to each beam.
-    output[SafeInt<size_t>(i) * max_length_ + current_length_] = beam_next_tokens[i];
+    if (!in_place) {
+      gsl::span<const int32_t> source = input.subspan(SafeInt<size_t>(origins[i]) * max_length_,
+                                                      static_cast<gsl::index>(materialized_length_));
+      gsl::copy(source, target);
+    }
+
+    int32_t beam = i;
+    for (int t = current_length_ - 1; t >= materialized_length_; t--) {
+      const size_t offset = SafeInt<size_t>(t) * batch_beam_size_ + beam;
+      target[t] = next_tokens_[offset];
+      beam = beam_indices_[offset];
+    }
   }
 
-  ++current_length_;
-
-  // Rotate buffer for next round.
-  current_sequences_buffer ^= 1;
+  materialized_length_ = current_length_;
+  if (!in_place) {
+    current_sequences_buffer ^= 1;
+  }
 }
 
 void Sequences::AppendNextTokenToSequences(gsl::span<int32_t>& next_tokens) {
@@ -79,10 +117,12 @@ void Sequences::AppendNextTokenToSequences(gsl::span<int32_t>& next_tokens) {
   }
 
   ++current_length_;
+  materialized_length_ = current_length_;
 }
 
 void Sequences::AfterDeviceAppendedNextToken() {
   ++current_length_;
+  materialized_length_ = current_length_;
   current_sequences_buffer ^= 1;
 }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <vector>
 #include <gsl/gsl>
 #include "contrib_ops/cpu/transformers/generation_shared.h"
 
@@ -18,6 +19,7 @@ class Sequences : public ISequences {
   void InitDevice(gsl::span<int32_t> buffer);
 
   // Returns a sequence of word IDs for a given beam index ( beam_index < batch_beam_size).
+  // The tokens appended since the last call are written to the sequences buffer only here.
   gsl::span<const int32_t> GetSequence(int beam_index) const override;
   gsl::span<const int32_t> GetCurrentDeviceSequences() const override { return device_sequences[current_sequences_buffer]; }
   gsl::span<int32_t> GetNextDeviceSequences() override { return device_sequences[current_sequences_buffer ^ 1]; }
@@ -31,6 +33,7 @@ class Sequences : public ISequences {
 #endif
 
   // Select sequences based on beam indices, then append next token to selected sequences.
+  // Only the beam indices and tokens are recorded, so no sequence is copied until GetSequence is called.
   void AppendNextTokenToSequences(
       gsl::span<int32_t>& beam_indices,
       gsl::span<int32_t>& beam_next_tokens);
@@ -41,14 +44,25 @@ class Sequences : public ISequences {
   void AfterDeviceAppendedNextToken();
 
  private:
+  // Writes the tokens recorded after materialized_length_ to the sequences, following the beam indices back to the
+  // beam each sequence descends from.
+  void Materialize() const;
+
   // Two buffers of shape (batch_size, num_beams, max_seq_length) to store sequences.
   // At each time, there is only one buffer is active. The other one will be active in next token.
-  // Each AppendNextTokenToSequences call will trigger a rotation of active buffer.
+  // Materializing a reordering of the beams triggers a rotation of active buffer.
   gsl::span<int32_t> sequences[2];
   gsl::span<int32_t> device_sequences[2];
 
   // Index (either 0 or 1) of two buffers that is currently is active.
-  int current_sequences_buffer;
+  mutable int current_sequences_buffer;
+
+  // Length of the sequences in the active buffer. Tokens after it are only in next_tokens_.
+  mutable int materialized_length_;
+
+  // Token and source beam index of each beam at each position, with shape (max_length, batch_beam_size).
+  std::vector<int32_t> next_tokens_;
+  std::vector<int32_t> beam_indices_;
 
   int batch_beam_size_;
   int max_length_;
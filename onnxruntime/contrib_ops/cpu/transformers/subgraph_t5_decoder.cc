@@ -127,9 +127,51 @@ Status T5DecoderSubgraph::Validate(const std::vector<const NodeArg*>& subgraph_i
 
   is_output_float16_ = (subgraph_outputs[0]->TypeAsProto()->tensor_type().elem_type() == float16_type);
 
+  cross_kv_shared_across_beams_ = CanShareCrossKVAcrossBeams(subgraph_inputs);
+
   return Status::OK();
 }
 
+bool T5DecoderSubgraph::CanShareCrossKVAcrossBeams(const std::vector<const NodeArg*>& subgraph_inputs) const {
+  // Inputs of DecoderMaskedMultiHeadAttention
+  constexpr size_t kKeyInputIndex = 1;
+  constexpr size_t kValueInputIndex = 2;
+  constexpr size_t kPastKeyInputIndex = 5;
+  constexpr size_t kBeamWidthInputIndex = 8;
+
+  if (!has_decoder_masked_attention_) {
+    return false;
+  }
+
+  const int first_cross_input_index = first_past_input_index_ + 2 * num_layers;
+  for (int i = first_cross_input_index; i < first_cross_input_index + 2 * num_layers; i++) {
+    const std::string& name = subgraph_inputs[i]->Name();
+    for (const Node* consumer : subgraph.GetConsumerNodes(name)) {
+      if (consumer == nullptr ||
+          consumer->OpType() != "DecoderMaskedMultiHeadAttention" || consumer->Domain() != kMSDomain ||
+          (consumer->GetExecutionProviderType() != kCpuExecutionProvider &&
+           consumer->GetExecutionProviderType() != kCudaExecutionProvider)) {
+        return false;
+      }
+
+      // The node needs the beam width to find the batch of a beam, and shall run cross attention (no past key).
+      const auto& input_defs = consumer->InputDefs();
+      if (input_defs.size() <= kBeamWidthInputIndex || !input_defs[kBeamWidthInputIndex]->Exists() ||
+          input_defs[kPastKeyInputIndex]->Exists()) {
+        return false;
+      }
+
+      for (size_t k = 0; k < input_defs.size(); k++) {
+        if (input_defs[k]->Name() == name && k != kKeyInputIndex && k != kValueInputIndex) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
 // Create inputs for decoder from the following data sources:
 // encoder feeds: encoder_input_ids, encoder_attention_mask, decoder_input_ids (with start tokens)
 // encoder fetches: logits,
@@ -242,6 +284,11 @@ Status T5DecoderSubgraph::CreateInitialFeeds(
                                                      0 /*max_sequence_length*/));
       }
       decoder_feeds.push_back(expanded_hidden_states);
+    } else if (cross_kv_shared_across_beams_ &&
+               decoder_feeds.size() >= static_cast<size_t>(first_past_input_index_ + 2 * num_layers)) {
+      // past key/value for cross attention are the same for all the beams of a batch, and shared by them
+      // without expansion.
+      decoder_feeds.push_back(encoder_fetches[j]);
     } else {
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool use_max_seq_len = (j - first_past_input_index_) < 2 * static_cast<size_t>(num_layers);
@@ -19,7 +19,8 @@ class T5DecoderSubgraph : public Subgraph {
       const std::string& attribute_name,
       const GraphViewer& subgraph_in) : Subgraph(node_in, attribute_name, subgraph_in),
                                         has_hidden_state_(false),
-                                        use_sequence_as_input_ids_(true) {
+                                        use_sequence_as_input_ids_(true),
+                                        cross_kv_shared_across_beams_(false) {
     first_present_output_index_ = 1;
 
     // Currently just using parent node's attribute. Maybe better to find it purely in subgraph.
@@ -74,11 +75,21 @@ class T5DecoderSubgraph : public Subgraph {
     return use_sequence_as_input_ids_;
   }
 
+  // Whether the past key and value of cross attention are fed once per batch instead of expanded to each beam.
+  inline bool CrossKVSharedAcrossBeams() const {
+    return cross_kv_shared_across_beams_;
+  }
+
  protected:
+  // Returns true when every node using the past key and value of cross attention is a DecoderMaskedMultiHeadAttention
+  // reading them as its key and value, which supports sharing them across the beams of a batch.
+  bool CanShareCrossKVAcrossBeams(const std::vector<const NodeArg*>& subgraph_inputs) const;
+
   int first_past_input_index_;
   int first_present_output_index_;
   bool has_hidden_state_;
   bool use_sequence_as_input_ids_;
+  bool cross_kv_shared_across_beams_;
 };
 
 }  // namespace transformers
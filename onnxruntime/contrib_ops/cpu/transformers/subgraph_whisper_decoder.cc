@@ -125,6 +125,8 @@ Status WhisperDecoderSubgraph::Validate(const std::vector<const NodeArg*>& subgr
 
   is_output_float16_ = (subgraph_outputs[0]->TypeAsProto()->tensor_type().elem_type() == float16_type);
 
+  cross_kv_shared_across_beams_ = CanShareCrossKVAcrossBeams(subgraph_inputs);
+
   return Status::OK();
 }
 
@@ -228,6 +230,11 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
                                                      0 /*max_sequence_length*/));
       }
       decoder_feeds.push_back(expanded_hidden_states);
+    } else if (cross_kv_shared_across_beams_ &&
+               decoder_feeds.size() >= static_cast<size_t>(first_past_input_index_ + 2 * num_layers)) {
+      // past key/value for cross attention are the same for all the beams of a batch, and shared by them
+      // without expansion.
+      decoder_feeds.push_back(encoder_fetches[j]);
     } else {
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool use_max_seq_len = (j - first_past_input_index_) <= 2 * static_cast<size_t>(num_layers);
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "contrib_ops/cuda/bert/attention_kernel_options.h"
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -53,6 +54,15 @@ void AttentionKernelOptions::Initialize(int value, bool use_build_flag, bool che
       kMinSeqLenForEfficientAttentionFp32,
       value > 0 ? 0 : kDefaultMinSeqLenForEfficientAttentionFp32);
 
+  // An explicit choice of kernels does not select lean attention automatically.
+  min_seq_len_for_lean_attention_ = ParseEnvironmentVariableWithDefault<int>(
+      kMinSeqLenForLeanAttention,
+      value > 0 ? 0 : kDefaultMinSeqLenForLeanAttention);
+
+  max_num_splits_for_flash_attention_ = std::max(1, ParseEnvironmentVariableWithDefault<int>(
+                                                        kMaxNumSplitsForFlashAttention,
+                                                        kDefaultMaxNumSplitsForFlashAttention));
+
   // Enable cuDNN flash attention only when it is stable (requires cuDNN version >= 9.3.0).
   if (use_cudnn_flash_attention_ && check_cudnn_version && !::onnxruntime::cudnn_sdpa::is_stable()) {
     use_cudnn_flash_attention_ = false;
@@ -69,6 +79,7 @@ void AttentionKernelOptions::Initialize(int value, bool use_build_flag, bool che
 
 #ifndef USE_LEAN_ATTENTION
     use_lean_attention_ = false;
+    min_seq_len_for_lean_attention_ = 0;
 #endif
 
 #ifndef USE_MEMORY_EFFICIENT_ATTENTION
@@ -38,6 +38,8 @@ class AttentionKernelOptions {
 
   int MinSeqLenForFlashAttentionPackedQkv() const { return min_seq_len_for_flash_attention_packed_qkv_; }
   int MinSeqLenForEfficientAttentionFp32() const { return min_seq_len_for_efficient_attention_fp32_; }
+  int MinSeqLenForLeanAttention() const { return min_seq_len_for_lean_attention_; }
+  int MaxNumSplitsForFlashAttention() const { return max_num_splits_for_flash_attention_; }
 
  protected:
   void Print() const;
@@ -65,6 +67,10 @@ class AttentionKernelOptions {
 
   int min_seq_len_for_efficient_attention_fp32_{0};
 
+  int min_seq_len_for_lean_attention_{0};
+
+  int max_num_splits_for_flash_attention_{128};
+
   std::once_flag initialize_once_flag_;
 };
 
@@ -226,6 +226,17 @@ Status DecoderMaskedMultiHeadAttention<T1, T2>::ComputeInternal(OpKernelContext*
     parameters.beam_width = static_cast<int>(*beam_width->Data<int32_t>());
   }
 
+  // Cross attention key and value computed once per batch and shared by its beams
+  if (parameters.is_cross_attention && key->Shape()[0] != batch_size) {
+    if (key->Shape()[0] * parameters.beam_width != batch_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'key' and 'value' dimension 0 shall be batch_size or batch_size / beam_width "
+                             "for cross attention, got ",
+                             key->Shape()[0]);
+    }
+    parameters.cross_kv_shared_across_beams = true;
+  }
+
   // Cache indirection (in case we are using this op inside BeamSearch)
   if (parameters.beam_width > 1) {
     // If beam width > 1, then cache indirection buffer MUST be present
@@ -130,6 +130,10 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
   // Combine the "beam-aware" batch idx and the head indices.
   const int bbhi = bbi * params.beam_width * params.num_heads + hi;
 
+  // Combine the batch and head indices into the cross attention key and value, which are stored once per batch
+  // (instead of once per beam) when they are shared by the beams.
+  const int kv_bbhi = params.cross_kv_shared_across_beams ? bbi * params.num_heads + hi : bbhi;
+
   // The thread in the block.
   const int tidx = threadIdx.x;
 
@@ -344,7 +348,7 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
   constexpr int K_PER_WARP = WARP_SIZE / THREADS_PER_KEY;
 
   // Base pointer for the beam's batch, before offsetting with indirection buffer
-  T* k_cache_batch = &params_k_cache[bbhi * params.max_sequence_length * head_size + ki];
+  T* k_cache_batch = &params_k_cache[kv_bbhi * params.max_sequence_length * head_size + ki];
 
   // Pick a number of keys to make sure all the threads of a warp enter (due to shfl_sync).
   int ti_end = ((tlength + K_PER_WARP - 1) / K_PER_WARP) * K_PER_WARP;
@@ -581,7 +585,7 @@ __global__ void masked_multihead_attention_kernel(DecoderMaskedMultiHeadAttentio
   T* v_cache = &params_v_cache[bhi * params.max_sequence_length * head_size + vi];
 
   // Base pointer for the beam's batch, before offsetting with indirection buffer
-  T* v_cache_batch = &params_v_cache[bbhi * params.max_sequence_length * head_size + vi];
+  T* v_cache_batch = &params_v_cache[kv_bbhi * params.max_sequence_length * head_size + vi];
 
   // The number of values processed per iteration of the loop.
   constexpr int V_PER_ITER = THREADS_PER_BLOCK / THREADS_PER_VALUE;
@@ -230,8 +230,8 @@ size_t num_splits_heuristic(size_t batch_size, size_t seqlen_q, size_t seqlen_k,
 
 // Returns (num_splits, softmax_lse_accum bytes, out_accum bytes)
 std::tuple<size_t, size_t, size_t> get_num_splits_and_buffer_sizes(size_t batch_size, size_t seqlen_q, size_t seqlen_k,
-                                                                   size_t num_heads, size_t head_size, size_t num_SMs) {
-  size_t max_splits = 128;
+                                                                   size_t num_heads, size_t head_size, size_t num_SMs,
+                                                                   size_t max_splits) {
   // split kv buffers
   size_t num_splits = num_splits_heuristic(batch_size, seqlen_q, seqlen_k, num_heads, head_size,
                                            num_SMs, max_splits);
@@ -8,6 +8,7 @@
 #include "contrib_ops/cpu/bert/group_query_attention_helper.h"
 #include "contrib_ops/cuda/bert/cutlass_fmha/memory_efficient_attention.h"
 #include "contrib_ops/cuda/bert/flash_attention/flash_api.h"
+#include "contrib_ops/cuda/bert/lean_attention/lean_api.h"
 
 using namespace onnxruntime::cuda;
 using namespace ::onnxruntime::common;
@@ -26,6 +27,7 @@ namespace cuda {
       kCudaExecutionProvider,                                            \
       (*KernelDefBuilder::Create())                                      \
           .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())         \
+          .TypeConstraint("T_CACHE", DataTypeImpl::GetTensorType<T>())   \
           .TypeConstraint("M", {DataTypeImpl::GetTensorType<int32_t>()}) \
           .MayInplace(3, 1)                                              \
           .MayInplace(4, 2)                                              \
@@ -77,6 +79,10 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
   const Tensor* total_seqlen = context->Input<Tensor>(6);
   const Tensor* cos_cache = context->Input<Tensor>(7);
   const Tensor* sin_cache = context->Input<Tensor>(8);
+  const Tensor* block_table = context->Input<Tensor>(9);
+  if (context->Input<Tensor>(10) != nullptr || context->Input<Tensor>(11) != nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "A quantized KV cache is not supported on CUDA yet.");
+  }
 
   auto& device_prop = GetDeviceProp();
   GroupQueryAttentionParameters parameters;
@@ -97,7 +103,8 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
                                                                 total_seqlen,
                                                                 scale_,
                                                                 softcap_,
-                                                                device_prop.maxThreadsPerBlock));
+                                                                device_prop.maxThreadsPerBlock,
+                                                                block_table));
   parameters.local_window_size = local_window_size_;
   parameters.is_unidirectional = is_unidirectional_;
   parameters.use_smooth_softmax = use_smooth_softmax_;
@@ -119,16 +126,86 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
   output_shape[2] = static_cast<int64_t>(parameters.hidden_size);
   Tensor* output = context->Output(0, output_shape);
 
+  const bool is_paged_kv_cache = block_table != nullptr;
+  // flash attention reads the pages in units of its kBlockN = 256 keys
+  if (is_paged_kv_cache && parameters.kv_cache_block_size % 256 != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The block size of a paged KV cache must be a multiple of 256 on CUDA, got ",
+                           parameters.kv_cache_block_size);
+  }
+
+  size_t softmax_lse_bytes = 0;
+  size_t softmax_lse_accum_bytes = 0;
+  size_t out_accum_bytes = 0;
+
+#if USE_LEAN_ATTENTION
+  // Lean attention spreads the KV sequence of token generation over all the SMs, which pays off over split-KV flash
+  // attention for long contexts when the batch and KV heads alone cannot fill the device. It is selected automatically
+  // from a minimum total sequence length, or for any token generation step when it is enabled explicitly.
+  const int min_seq_len_for_lean_attention = kernel_options_->MinSeqLenForLeanAttention();
+  const bool prefer_lean_attention =
+      kernel_options_->UseLeanAttention() ||
+      (min_seq_len_for_lean_attention > 0 &&
+       parameters.total_sequence_length >= min_seq_len_for_lean_attention &&
+       parameters.batch_size * parameters.kv_num_heads < device_prop.multiProcessorCount);
+  bool use_lean_attention = std::is_same<T, MLFloat16>::value &&
+                            prefer_lean_attention &&
+                            sequence_length == 1 &&
+                            !parameters.is_first_prompt &&
+                            !is_paged_kv_cache &&
+                            local_window_size_ == -1 &&
+                            softcap_ == 0.0f &&
+                            !use_smooth_softmax_ &&
+                            onnxruntime::lean::is_supported(device_prop,
+                                                            parameters.head_size,
+                                                            parameters.num_heads,
+                                                            parameters.kv_num_heads);
+
+  size_t sync_flag_bytes = 0;
+  if (use_lean_attention) {
+    softmax_lse_bytes = onnxruntime::lean::get_softmax_lse_size(parameters.sequence_length,
+                                                                parameters.batch_size,
+                                                                parameters.num_heads);
+
+    // The tiles are scheduled over the longest sequence in the batch, not the capacity of a shared KV buffer.
+    auto [num_splits, slse_accum_bytes, o_accum_bytes, sflag_bytes, griddimz, max_tiles_tb, hload_tbs, tiles_per_head] = onnxruntime::lean::get_num_splits_and_buffer_sizes(
+        parameters.batch_size,
+        parameters.sequence_length,
+        parameters.total_sequence_length,
+        parameters.num_heads,
+        parameters.kv_num_heads,
+        parameters.head_size,
+        device_prop.multiProcessorCount,
+        parameters.is_unidirectional);
+
+    parameters.num_splits = static_cast<int>(num_splits);
+    data.grid_dim_z = static_cast<int>(griddimz);
+    data.max_tiles_per_tb = static_cast<int>(max_tiles_tb);
+    data.high_load_tbs = static_cast<int>(hload_tbs);
+    data.tiles_per_head = static_cast<int>(tiles_per_head);
+    softmax_lse_accum_bytes = slse_accum_bytes;
+    out_accum_bytes = o_accum_bytes;
+    sync_flag_bytes = sflag_bytes;
+  }
+
+  auto lean_sync_flag_buffer = GetScratchBuffer<void>(sync_flag_bytes, context->GetComputeStream());
+  data.lean_sync_flag = reinterpret_cast<int*>(lean_sync_flag_buffer.get());
+  if (sync_flag_bytes > 0) {
+    // the thread blocks of a head count the finished splits in the flags
+    CUDA_RETURN_IF_ERROR(cudaMemsetAsync(lean_sync_flag_buffer.get(), 0, sync_flag_bytes, Stream(context)));
+  }
+#else
+  constexpr bool use_lean_attention = false;
+#endif
+
 #if USE_FLASH_ATTENTION
-  bool use_flash_attention = !disable_flash_attention_ &&
+  bool use_flash_attention = !use_lean_attention &&
+                             !disable_flash_attention_ &&
                              onnxruntime::flash::is_supported(device_prop,
                                                               parameters.head_size,
                                                               parameters.num_heads,
                                                               parameters.kv_num_heads);
   // Allocate buffers
-  size_t softmax_lse_bytes = 0;
-  size_t softmax_lse_accum_bytes = 0;
-  size_t out_accum_bytes = 0;
   if (use_flash_attention) {
     // softmax buffer
     softmax_lse_bytes = onnxruntime::flash::get_softmax_lse_size(parameters.sequence_length, parameters.batch_size, parameters.num_heads);
@@ -136,25 +213,24 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
     using namespace std;
     auto [num_splits, slse_accum_bytes, o_accum_bytes] = onnxruntime::flash::get_num_splits_and_buffer_sizes(
         parameters.batch_size, parameters.sequence_length, parameters.total_sequence_length, parameters.num_heads,
-        parameters.head_size, device_prop.multiProcessorCount);
+        parameters.head_size, device_prop.multiProcessorCount, kernel_options_->MaxNumSplitsForFlashAttention());
     parameters.num_splits = static_cast<int>(num_splits);
     softmax_lse_accum_bytes = slse_accum_bytes;
     out_accum_bytes = o_accum_bytes;
   }
-  auto softmax_lse_buffer = GetScratchBuffer<void>(softmax_lse_bytes, context->GetComputeStream());
-  auto softmax_lse_accum_buffer = GetScratchBuffer<void>(softmax_lse_accum_bytes, context->GetComputeStream());
-  auto out_accum_buffer = GetScratchBuffer<void>(out_accum_bytes, context->GetComputeStream());
 #else
   constexpr bool use_flash_attention = false;
-  auto softmax_lse_buffer = GetScratchBuffer<void>(0, context->GetComputeStream());        // nullptr
-  auto softmax_lse_accum_buffer = GetScratchBuffer<void>(0, context->GetComputeStream());  // nullptr
-  auto out_accum_buffer = GetScratchBuffer<void>(0, context->GetComputeStream());          // nullptr
 #endif
+  auto softmax_lse_buffer = GetScratchBuffer<void>(softmax_lse_bytes, context->GetComputeStream());
+  auto softmax_lse_accum_buffer = GetScratchBuffer<void>(softmax_lse_accum_bytes, context->GetComputeStream());
+  auto out_accum_buffer = GetScratchBuffer<void>(out_accum_bytes, context->GetComputeStream());
 
 #if USE_MEMORY_EFFICIENT_ATTENTION
   int sm = (device_prop.major * 10) + device_prop.minor;
   bool use_memory_efficient_attention =
       !use_flash_attention &&
+      !use_lean_attention &&
+      !is_paged_kv_cache &&
       !disable_memory_efficient_attention_ &&
       local_window_size_ == -1 &&
       (sizeof(T) == 2 || parameters.sequence_length >= this->kernel_options_->MinSeqLenForEfficientAttentionFp32()) &&
@@ -170,36 +246,44 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
   if (use_memory_efficient_attention && needs_buff) {
     kv_buffer_bytes = (sizeof(T) * parameters.batch_size * parameters.num_heads * parameters.seqlen_present_kv_cache * parameters.head_size);
   }
-  size_t rotary_buffer_bytes = 0;
-  if (use_memory_efficient_attention && do_rotary_) {
-    rotary_buffer_bytes = 2 * sizeof(T) * parameters.batch_size * parameters.num_heads * parameters.sequence_length * parameters.head_size;
-    rotary_buffer_bytes += sizeof(int64_t) * parameters.batch_size * parameters.sequence_length;
-  }
   size_t fmha_buffer_bytes = 0;
   if (use_memory_efficient_attention && MemoryEfficientAttentionParams::need_workspace(parameters.head_size, sizeof(T) == sizeof(float))) {
     fmha_buffer_bytes = (parameters.batch_size * parameters.sequence_length * parameters.num_heads * parameters.head_size * sizeof(float));
   }
-  size_t unpacked_qkv_bytes = 0;
-  if (use_memory_efficient_attention && parameters.is_packed_qkv) {
-    unpacked_qkv_bytes = (parameters.batch_size * parameters.sequence_length * (parameters.num_heads + 2 * parameters.kv_num_heads) * parameters.head_size * sizeof(T));
-  }
   auto k_buffer = GetScratchBuffer<void>(kv_buffer_bytes, context->GetComputeStream());
   auto v_buffer = GetScratchBuffer<void>(kv_buffer_bytes, context->GetComputeStream());
   auto rotary_buffer = GetScratchBuffer<void>(rotary_buffer_bytes, context->GetComputeStream());
   auto fmha_buffer = GetScratchBuffer<void>(fmha_buffer_bytes, context->GetComputeStream());
-  auto unpacked_qkv_buffer = GetScratchBuffer<void>(unpacked_qkv_bytes, context->GetComputeStream());
 #else
   constexpr bool use_memory_efficient_attention = false;
   auto k_buffer = GetScratchBuffer<void>(0, context->GetComputeStream());
   auto v_buffer = GetScratchBuffer<void>(0, context->GetComputeStream());
-  auto rotary_buffer = GetScratchBuffer<void>(0, context->GetComputeStream());
   auto fmha_buffer = GetScratchBuffer<void>(0, context->GetComputeStream());
-  auto unpacked_qkv_buffer = GetScratchBuffer<void>(0, context->GetComputeStream());
 #endif
 
+  // Memory efficient and lean attention take the new query and key after rotary embedding, in separate tensors.
+  const bool needs_qkv_preprocess = use_memory_efficient_attention || use_lean_attention;
+  size_t rotary_buffer_bytes = 0;
+  if (needs_qkv_preprocess && do_rotary_) {
+    rotary_buffer_bytes = 2 * sizeof(T) * parameters.batch_size * parameters.num_heads * parameters.sequence_length * parameters.head_size;
+    rotary_buffer_bytes += sizeof(int64_t) * parameters.batch_size * parameters.sequence_length;
+  }
+  size_t unpacked_qkv_bytes = 0;
+  if (needs_qkv_preprocess && parameters.is_packed_qkv) {
+    unpacked_qkv_bytes = (parameters.batch_size * parameters.sequence_length * (parameters.num_heads + 2 * parameters.kv_num_heads) * parameters.head_size * sizeof(T));
+  }
+  auto rotary_buffer = GetScratchBuffer<void>(rotary_buffer_bytes, context->GetComputeStream());
+  auto unpacked_qkv_buffer = GetScratchBuffer<void>(unpacked_qkv_bytes, context->GetComputeStream());
+
+  if (is_paged_kv_cache && !use_flash_attention) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "A paged KV cache requires flash attention in GroupQueryAttention on CUDA.");
+  }
+
   if (kernel_options_->AllowDebugInfo()) {
     AttentionKernelDebugInfo debug_info;
     debug_info.use_flash_attention = use_flash_attention;
+    debug_info.use_lean_attention = use_lean_attention;
     debug_info.use_efficient_attention = use_memory_efficient_attention;
 
     debug_info.Print("GroupQueryAttention",
@@ -221,7 +305,7 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
     present_dims = {
         parameters.batch_size, parameters.kv_num_heads, parameters.seqlen_present_kv_cache, parameters.head_size};
   }
-  TensorShape present_shape(present_dims);
+  TensorShape present_shape = is_paged_kv_cache ? past_key->Shape() : TensorShape(present_dims);
   Tensor* present_key = context->Output(1, present_shape);
   Tensor* present_value = context->Output(2, present_shape);
 
@@ -235,12 +319,21 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
   data.present_value = (nullptr == present_value) ? nullptr : reinterpret_cast<CudaT*>(present_value->MutableData<T>());
   data.seqlens_k = const_cast<int*>(seqlens_k->Data<int>());
   data.use_flash_attention = use_flash_attention;
+  data.use_lean_attention = use_lean_attention;
   data.use_memory_efficient_attention = use_memory_efficient_attention;
   if (data.past_key == data.present_key) {
     parameters.kv_share_buffer = true;
   } else {
     parameters.kv_share_buffer = false;
   }
+  if (is_paged_kv_cache) {
+    if (!parameters.kv_share_buffer || data.past_value != data.present_value) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "present_key and present_value must share buffer with past_key and past_value "
+                             "with a paged KV cache.");
+    }
+    data.block_table = block_table->Data<int32_t>();
+  }
   // Flash Buffers
   if (softmax_lse_buffer != nullptr) {
     data.softmax_lse = reinterpret_cast<CudaT*>(softmax_lse_buffer.get());
@@ -39,6 +39,7 @@ limitations under the License.
 #include "contrib_ops/cuda/utils/dump_cuda_tensor.h"
 #include "contrib_ops/cuda/bert/cutlass_fmha/memory_efficient_attention.h"
 #include "contrib_ops/cuda/bert/flash_attention/flash_api.h"
+#include "contrib_ops/cuda/bert/lean_attention/lean_api.h"
 #include "contrib_ops/cuda/bert/group_query_attention_impl.h"
 #include "contrib_ops/cuda/bert/attention_impl.h"
 #include "core/providers/cuda/shared_inc/cuda_call.h"
@@ -708,7 +709,9 @@ Status FlashAttention(
     }
   }
 
-  if (!parameters.kv_share_buffer || parameters.is_first_prompt) {  // copy past kv to present kv
+  // a paged KV cache is updated in place, flash attention appends the new kv to the blocks of each sequence
+  const bool is_paged_kv_cache = data.block_table != nullptr;
+  if (!is_paged_kv_cache && (!parameters.kv_share_buffer || parameters.is_first_prompt)) {  // copy past kv to present kv
     ORT_RETURN_IF_ERROR(LaunchConcatNewToPastKV(parameters, data, nullptr, nullptr, stream, max_threads_per_block,
                                                 true));
   }
@@ -721,12 +724,14 @@ Status FlashAttention(
   bool past_bsnh = past_kv_format == AttentionQkvFormat::Q_K_V_BSNH;
   ORT_RETURN_IF_ERROR(onnxruntime::flash::mha_fwd_kvcache(
       device_prop, stream, query, present_key, present_value, key, value, data.output,
-      reinterpret_cast<void*>(data.softmax_lse), seqlens_k, cos_cache, sin_cache, /*block_table*/ nullptr,
+      reinterpret_cast<void*>(data.softmax_lse), seqlens_k, cos_cache, sin_cache,
+      const_cast<int*>(data.block_table),
       batch_size, num_heads, kv_num_heads, head_size, sequence_length,
       parameters.seqlen_present_kv_cache, kv_sequence_length, parameters.rotary_dim,
       scale, parameters.softcap, is_causal, is_bf16, parameters.use_smooth_softmax, past_bsnh, parameters.num_splits,
       reinterpret_cast<void*>(data.softmax_lse_accum), reinterpret_cast<void*>(data.out_accum),
-      parameters.local_window_size, parameters.rotary_interleaved, parameters.is_packed_qkv));
+      parameters.local_window_size, parameters.rotary_interleaved, parameters.is_packed_qkv,
+      parameters.max_num_blocks_per_seq, is_paged_kv_cache ? parameters.kv_cache_block_size : 1));
 
   // if (parameters.left_padding && parameters.is_first_prompt) {
   //   ORT_RETURN_IF_ERROR(LaunchLeftPadLast(parameters, data, stream, device_prop.maxThreadsPerBlock));
@@ -739,26 +744,23 @@ Status FlashAttention(
 }
 #endif
 
-#if USE_MEMORY_EFFICIENT_ATTENTION
+#if USE_MEMORY_EFFICIENT_ATTENTION || USE_LEAN_ATTENTION
+// Unpacks packed QKV and applies rotary embedding to the new query and key, for the kernels that cannot do it.
 template <typename T>
-Status EfficientAttention(
+Status PrepareQKV(
     const cudaDeviceProp& device_prop,
     cudaStream_t stream,
     contrib::GroupQueryAttentionParameters& parameters,
     GroupQueryAttentionData<T>& data,
-    float scale) {
+    const void*& query,
+    const void*& key,
+    const void*& value) {
   const int max_threads_per_block = device_prop.maxThreadsPerBlock;
   const int batch_size = parameters.batch_size;
   const int sequence_length = parameters.sequence_length;
-  const int present_sequence_length = parameters.seqlen_present_kv_cache;
   const int num_heads = parameters.num_heads;
   const int kv_num_heads = parameters.kv_num_heads;
   const int head_size = parameters.head_size;
-  AttentionQkvFormat past_kv_format = parameters.past_kv_format;
-
-  const void* query;
-  const void* key;
-  const void* value;
 
   if (!parameters.is_packed_qkv) {
     query = reinterpret_cast<const void*>(data.query);
@@ -812,6 +814,21 @@ Status EfficientAttention(
     key = reinterpret_cast<const void*>(k_buffer);
   }
 
+  return Status::OK();
+}
+
+// Appends the new key and value to present kv, and sets seqlens_k_buff to the total sequence lengths.
+template <typename T>
+Status UpdatePresentKV(
+    const cudaDeviceProp& device_prop,
+    cudaStream_t stream,
+    contrib::GroupQueryAttentionParameters& parameters,
+    GroupQueryAttentionData<T>& data,
+    const void* key,
+    const void* value) {
+  const int max_threads_per_block = device_prop.maxThreadsPerBlock;
+  const int batch_size = parameters.batch_size;
+
   if (parameters.is_subsequent_prompt || !parameters.is_first_prompt) {
     ORT_RETURN_IF_ERROR(LaunchGetSeqlensTotal(data.seqlens_k, data.seqlens_k_buff, batch_size, stream, 256));
   } else {
@@ -821,7 +838,6 @@ Status EfficientAttention(
     repeat_seqlen<<<blk_in_grid, thr_per_blk, 0, stream>>>(data.seqlens_k_buff, parameters.sequence_length,
                                                            batch_size);
   }
-  int* seqlens_k = data.seqlens_k_buff;
 
   if (parameters.kv_share_buffer) {
     // Share buffer case
@@ -843,6 +859,117 @@ Status EfficientAttention(
     ORT_RETURN_IF_ERROR(LaunchConcatNewToPastKV(parameters, data, key, value, stream, max_threads_per_block));
   }
 
+  return Status::OK();
+}
+#endif
+
+#if USE_LEAN_ATTENTION
+template <typename T>
+Status LeanAttention(
+    const cudaDeviceProp& device_prop,
+    cudaStream_t stream,
+    contrib::GroupQueryAttentionParameters& parameters,
+    GroupQueryAttentionData<T>& data,
+    float scale) {
+  const int batch_size = parameters.batch_size;
+  const int sequence_length = parameters.sequence_length;
+  const int num_heads = parameters.num_heads;
+  const int head_size = parameters.head_size;
+  constexpr bool is_bf16 = false;
+
+  const void* query;
+  const void* key;
+  const void* value;
+  ORT_RETURN_IF_ERROR(PrepareQKV(device_prop, stream, parameters, data, query, key, value));
+  // lean attention reads the whole sequence from present kv, with the total sequence lengths in seqlens_k_buff
+  ORT_RETURN_IF_ERROR(UpdatePresentKV(device_prop, stream, parameters, data, key, value));
+
+  DUMP_TENSOR_INIT();
+  DUMP_TENSOR("seqlens_k", data.seqlens_k_buff, batch_size, 1);
+
+  const bool past_bsnh = parameters.past_kv_format == AttentionQkvFormat::Q_K_V_BSNH;
+  ORT_RETURN_IF_ERROR(onnxruntime::lean::mha_fwd_kvcache(
+      device_prop, stream,
+      const_cast<void*>(query),
+      reinterpret_cast<void*>(data.present_key),    // k_cache
+      reinterpret_cast<void*>(data.present_value),  // v_cache
+      nullptr,                                      // new_k (appended to k_cache above)
+      nullptr,                                      // new_v (appended to v_cache above)
+      data.output,
+      reinterpret_cast<void*>(data.softmax_lse),
+      reinterpret_cast<void*>(data.seqlens_k_buff),
+      nullptr,  // cos_cache (applied above)
+      nullptr,  // sin_cache
+      nullptr,  // block_table
+      batch_size,
+      num_heads,
+      parameters.kv_num_heads,
+      head_size,
+      sequence_length,                     // seqlen_q
+      parameters.seqlen_present_kv_cache,  // seqlen_k, which sets the strides of present kv
+      0,                                   // seqlen_k_new
+      0,                                   // rotary_dim
+      scale,
+      parameters.is_unidirectional,
+      is_bf16,
+      past_bsnh,
+      parameters.num_splits,
+      data.grid_dim_z,
+      data.max_tiles_per_tb,
+      data.high_load_tbs,
+      data.tiles_per_head,
+      reinterpret_cast<void*>(data.softmax_lse_accum),
+      reinterpret_cast<void*>(data.out_accum),
+      data.lean_sync_flag,
+      -1,        // local_window_size
+      false,     // is_rotary_interleaved
+      false));   // is_packed_qkv
+
+  DUMP_TENSOR("lean attention output", data.output, batch_size, sequence_length, num_heads, head_size);
+
+  return Status::OK();
+}
+
+template <>
+Status LeanAttention(
+    const cudaDeviceProp& device_prop,
+    cudaStream_t stream,
+    contrib::GroupQueryAttentionParameters& parameters,
+    GroupQueryAttentionData<BFloat16>& data,
+    float scale) {
+  ORT_UNUSED_PARAMETER(device_prop);
+  ORT_UNUSED_PARAMETER(stream);
+  ORT_UNUSED_PARAMETER(parameters);
+  ORT_UNUSED_PARAMETER(data);
+  ORT_UNUSED_PARAMETER(scale);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, StatusCode::NOT_IMPLEMENTED, "lean attention does not support bfloat16");
+}
+#endif
+
+#if USE_MEMORY_EFFICIENT_ATTENTION
+template <typename T>
+Status EfficientAttention(
+    const cudaDeviceProp& device_prop,
+    cudaStream_t stream,
+    contrib::GroupQueryAttentionParameters& parameters,
+    GroupQueryAttentionData<T>& data,
+    float scale) {
+  const int max_threads_per_block = device_prop.maxThreadsPerBlock;
+  const int batch_size = parameters.batch_size;
+  const int sequence_length = parameters.sequence_length;
+  const int present_sequence_length = parameters.seqlen_present_kv_cache;
+  const int num_heads = parameters.num_heads;
+  const int kv_num_heads = parameters.kv_num_heads;
+  const int head_size = parameters.head_size;
+  AttentionQkvFormat past_kv_format = parameters.past_kv_format;
+
+  const void* query;
+  const void* key;
+  const void* value;
+  ORT_RETURN_IF_ERROR(PrepareQKV(device_prop, stream, parameters, data, query, key, value));
+  ORT_RETURN_IF_ERROR(UpdatePresentKV(device_prop, stream, parameters, data, key, value));
+  int* seqlens_k = data.seqlens_k_buff;
+
   // Ungroup if grouped, otherwise use present kv directly
   const bool is_bsnh = past_kv_format == AttentionQkvFormat::Q_K_V_BSNH;
   if (num_heads == kv_num_heads) {
@@ -918,6 +1045,12 @@ Status QkvToContext(
   }
 #endif
 
+#if USE_LEAN_ATTENTION
+  if (data.use_lean_attention) {
+    return LeanAttention(device_prop, stream, parameters, data, scale);
+  }
+#endif
+
 #if USE_MEMORY_EFFICIENT_ATTENTION
   if (data.use_memory_efficient_attention) {
     return EfficientAttention(device_prop, stream, parameters, data, scale);
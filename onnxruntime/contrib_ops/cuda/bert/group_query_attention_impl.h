@@ -23,11 +23,20 @@ struct GroupQueryAttentionData {
   int* seqlens_k = nullptr;
   const T* cos_cache = nullptr;
   const T* sin_cache = nullptr;
+  const int* block_table = nullptr;  // blocks of each sequence of a paged KV cache
   // Flash buffers
   T* softmax_lse = nullptr;
   T* softmax_lse_accum = nullptr;
   T* out_accum = nullptr;
   int* seqlens_k_buff = nullptr;
+  // Lean Attention, which shares the flash buffers and the num_splits parameter
+#if USE_LEAN_ATTENTION
+  int grid_dim_z = 0;
+  int max_tiles_per_tb = 0;
+  int high_load_tbs = 0;
+  int tiles_per_head = 0;
+  int* lean_sync_flag = nullptr;
+#endif
   // Memory Efficient buffers
   T* fmha_buffer = nullptr;
   T* unpacked_qkv_buffer = nullptr;
@@ -40,6 +49,7 @@ struct GroupQueryAttentionData {
   T* present_value = nullptr;
   // Kernel Flags
   bool use_flash_attention = false;
+  bool use_lean_attention = false;
   bool use_memory_efficient_attention = false;
 };
 
@@ -9,7 +9,9 @@
 #include <netdb.h>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "nccl_kernels.h"
 #include "mpi_include.h"
@@ -19,6 +21,7 @@
 #include "core/providers/cuda/tensor/transpose.h"
 #include "core/providers/cuda/cuda_check_memory.h"
 #include "core/platform/env_var_utils.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -228,11 +231,19 @@ NcclContext::NcclContext() {
   ORT_ENFORCE(ret.IsOK());
 }
 
+NcclContext::NcclContext(ncclComm_t comm, int rank, int world_size)
+    : comm_(comm), rank_(rank), world_size_(world_size), is_in_process_(true) {
+}
+
 NcclContext::~NcclContext() {
   if (comm_ != nullptr) {
     ncclCommDestroy(comm_);
   }
 
+  if (is_in_process_) {
+    return;
+  }
+
 #ifdef USE_MPI
   int is_mpi_finalized = 0;
   MPI_Finalized(&is_mpi_finalized);
@@ -242,7 +253,42 @@ NcclContext::~NcclContext() {
 #endif
 }
 
+NcclContext& GetInProcessNcclContext(int rank, int world_size) {
+  static std::mutex mutex;
+  static std::vector<std::unique_ptr<NcclContext>> contexts;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (contexts.empty()) {
+    std::vector<ncclComm_t> comms(world_size);
+    // a null device list places rank r on device r
+    ORT_THROW_IF_ERROR(NCCL_CALL(ncclCommInitAll(comms.data(), world_size, nullptr)));
+    for (int i = 0; i < world_size; ++i) {
+      contexts.push_back(std::make_unique<NcclContext>(comms[i], i, world_size));
+    }
+  }
+
+  ORT_ENFORCE(static_cast<int>(contexts.size()) == world_size,
+              "The tensor parallel world size of the process is ", contexts.size(), ", got ", world_size);
+  ORT_ENFORCE(rank >= 0 && rank < world_size, "Tensor parallel rank ", rank, " is out of range [0, ", world_size,
+              ")");
+  return *contexts[rank];
+}
+
 NcclKernel::NcclKernel(const OpKernelInfo& info) : CudaKernel(info) {
+  const auto& config_options = info.GetConfigOptions();
+  int world_size = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale<int>(
+      config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelWorldSize, "0"), world_size));
+  if (world_size > 1) {
+    int rank = 0;
+    ORT_ENFORCE(TryParseStringWithClassicLocale<int>(
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelRank, "0"), rank));
+    ORT_ENFORCE(GetDeviceId() == rank, "Tensor parallel rank ", rank, " must run on CUDA device ", rank,
+                ", got device ", GetDeviceId());
+    nccl_ = &GetInProcessNcclContext(rank, world_size);
+    return;
+  }
+
   static NcclContext context;
   nccl_ = &context;
 }
@@ -260,19 +306,21 @@ Status AllReduce::ComputeInternal(OpKernelContext* context) const {
   void* output_data = context->Output(0, in_shape)->MutableDataRaw();
 
 #ifndef USE_ROCM
-  return FuncCustomAllReduce(nccl_,
-                             Stream(context),
-                             input_data,
-                             output_data,
-                             input_count,
-                             input_tensor->DataType(),
-                             onnxruntime::cuda::collective::IPCMemoryResourcePack::GetGlobalInstance());
-#else
+  // the custom all-reduce shares its workspace through IPC and needs one process per rank
+  if (!nccl_->IsInProcess()) {
+    return FuncCustomAllReduce(nccl_,
+                               Stream(context),
+                               input_data,
+                               output_data,
+                               input_count,
+                               input_tensor->DataType(),
+                               onnxruntime::cuda::collective::IPCMemoryResourcePack::GetGlobalInstance());
+  }
+#endif
   ncclComm_t comm = nccl_->Comm();
   ncclDataType_t dtype = GetNcclDataType(input_tensor->DataType());
   NCCL_RETURN_IF_ERROR(ncclAllReduce(input_data, output_data, input_count, dtype, ncclSum, comm, Stream(context)));
   return Status::OK();
-#endif
 }
 
 AllGather::AllGather(const OpKernelInfo& info) : NcclKernel(info) {
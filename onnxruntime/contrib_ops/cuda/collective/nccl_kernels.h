@@ -36,6 +36,8 @@ ncclDataType_t GetNcclDataType(onnxruntime::MLDataType type);
 class NcclContext final {
  public:
   NcclContext();
+  // Wraps the communicator of one of the ranks that run in this process, see GetInProcessNcclContext.
+  NcclContext(ncclComm_t comm, int rank, int world_size);
   ~NcclContext();
 
   ncclComm_t Comm() {
@@ -50,12 +52,21 @@ class NcclContext final {
     return world_size_;
   }
 
+  bool IsInProcess() const {
+    return is_in_process_;
+  }
+
  private:
   ncclComm_t comm_;
   int rank_;
   int world_size_;
+  bool is_in_process_ = false;
 };
 
+// Returns the context of `rank` in a group of `world_size` ranks that all run in this process, with rank r on CUDA
+// device r. The communicators of all the ranks are created together on first use.
+NcclContext& GetInProcessNcclContext(int rank, int world_size);
+
 class NcclKernel : public ::onnxruntime::cuda::CudaKernel {
  public:
   explicit NcclKernel(const OpKernelInfo& info);
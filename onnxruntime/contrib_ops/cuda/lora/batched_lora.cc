@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/lora/batched_lora.h"
+
+#include "contrib_ops/cpu/lora/batched_lora_helper.h"
+#include "core/common/safeint.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/shared_inc/fpgeneric.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// the adapter indices are read on the host to split the batch into segments of rows with the same adapter
+#define REGISTER_KERNEL_TYPED(T)                                    \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                    \
+      BatchedLoRA, kMSDomain, 1, T, kCudaExecutionProvider,         \
+      (*KernelDefBuilder::Create())                                 \
+          .InputMemoryType(OrtMemTypeCPUInput, 3)                   \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      BatchedLoRA<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+Status BatchedLoRA<T>::ComputeInternal(OpKernelContext* context) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* lora_a = context->Input<Tensor>(1);
+  const Tensor* lora_b = context->Input<Tensor>(2);
+  const Tensor* adapter_indices = context->Input<Tensor>(3);
+
+  batched_lora_helper::Parameters parameters;
+  ORT_RETURN_IF_ERROR(batched_lora_helper::CheckInputs(input->Shape(), lora_a->Shape(), lora_b->Shape(),
+                                                       adapter_indices->Shape(), parameters));
+
+  TensorShapeVector output_dims = input->Shape().AsShapeVector();
+  output_dims.back() = parameters.output_size;
+  Tensor* output = context->Output(0, output_dims);
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<batched_lora_helper::Segment> segments;
+  ORT_RETURN_IF_ERROR(batched_lora_helper::GetSegments(adapter_indices->DataAsSpan<int32_t>(),
+                                                       parameters.num_adapters, segments));
+
+  const int hidden_size = SafeInt<int>(parameters.hidden_size);
+  const int rank = SafeInt<int>(parameters.rank);
+  const int output_size = SafeInt<int>(parameters.output_size);
+  const int64_t rows_per_batch = parameters.rows_per_batch;
+
+  // input * lora_a of the rows of one segment, the largest segment is at most the whole batch
+  auto intermediate = GetScratchBuffer<CudaT>(SafeInt<size_t>(parameters.batch_size) * rows_per_batch * rank,
+                                              context->GetComputeStream());
+
+  const CudaT* input_data = reinterpret_cast<const CudaT*>(input->Data<T>());
+  const CudaT* lora_a_data = reinterpret_cast<const CudaT*>(lora_a->Data<T>());
+  const CudaT* lora_b_data = reinterpret_cast<const CudaT*>(lora_b->Data<T>());
+  CudaT* output_data = reinterpret_cast<CudaT*>(output->MutableData<T>());
+
+  const CudaT one = ToCudaType<T>::FromFloat(1.f);
+  const CudaT zero = ToCudaType<T>::FromFloat(0.f);
+  const CudaT scale = ToCudaType<T>::FromFloat(scale_);
+  cublasHandle_t cublas = GetCublasHandle(context);
+
+  for (const auto& segment : segments) {
+    const int64_t row_begin = segment.begin * rows_per_batch;
+    const int num_rows = SafeInt<int>((segment.end - segment.begin) * rows_per_batch);
+    CudaT* segment_output = output_data + row_begin * output_size;
+
+    if (segment.adapter_index < 0 || rank == 0) {
+      CUDA_RETURN_IF_ERROR(cudaMemsetAsync(segment_output, 0, SafeInt<size_t>(num_rows) * output_size * sizeof(CudaT),
+                                           Stream(context)));
+      continue;
+    }
+
+    // cublas is column major, so each row major C = A * B is computed as C^T = B^T * A^T
+    const CudaT* a = lora_a_data + static_cast<int64_t>(segment.adapter_index) * hidden_size * rank;
+    const CudaT* b = lora_b_data + static_cast<int64_t>(segment.adapter_index) * rank * output_size;
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        cublas, CUBLAS_OP_N, CUBLAS_OP_N, rank, num_rows, hidden_size, &one,
+        a, rank, input_data + row_begin * hidden_size, hidden_size, &zero,
+        intermediate.get(), rank, GetDeviceProp(), UseTF32()));
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        cublas, CUBLAS_OP_N, CUBLAS_OP_N, output_size, num_rows, rank, &scale,
+        b, output_size, intermediate.get(), rank, &zero,
+        segment_output, output_size, GetDeviceProp(), UseTF32()));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
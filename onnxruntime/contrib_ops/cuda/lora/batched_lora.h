@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+template <typename T>
+class BatchedLoRA final : public CudaKernel {
+ public:
+  explicit BatchedLoRA(const OpKernelInfo& info) : CudaKernel(info) {
+    scale_ = info.GetAttrOrDefault<float>("scale", 1.0f);
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,175 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/math/fused_matmul_activation.h"
+
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      FusedMatMulActivation,                                      \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      (*KernelDefBuilder::Create())                               \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      FusedMatMulActivation<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+REGISTER_KERNEL_TYPED(BFloat16)
+
+namespace {
+
+// recommended for Hopper, and enough for the other architectures
+constexpr size_t kWorkspaceSize = 32 * 1024 * 1024;
+
+// Owns the cuBLASLt descriptors of one call.
+struct LtMatmulDescriptors {
+  ~LtMatmulDescriptors() {
+    if (preference != nullptr) {
+      cublasLtMatmulPreferenceDestroy(preference);
+    }
+    if (y_desc != nullptr) {
+      cublasLtMatrixLayoutDestroy(y_desc);
+    }
+    if (a_desc != nullptr) {
+      cublasLtMatrixLayoutDestroy(a_desc);
+    }
+    if (b_desc != nullptr) {
+      cublasLtMatrixLayoutDestroy(b_desc);
+    }
+    if (matmul != nullptr) {
+      cublasLtMatmulDescDestroy(matmul);
+    }
+  }
+
+  cublasLtMatmulDesc_t matmul = nullptr;
+  cublasLtMatrixLayout_t b_desc = nullptr;
+  cublasLtMatrixLayout_t a_desc = nullptr;
+  cublasLtMatrixLayout_t y_desc = nullptr;
+  cublasLtMatmulPreference_t preference = nullptr;
+};
+
+template <typename T>
+cudaDataType_t CudaDataType();
+template <>
+cudaDataType_t CudaDataType<float>() { return CUDA_R_32F; }
+template <>
+cudaDataType_t CudaDataType<MLFloat16>() { return CUDA_R_16F; }
+template <>
+cudaDataType_t CudaDataType<BFloat16>() { return CUDA_R_16BF; }
+
+}  // namespace
+
+template <typename T>
+FusedMatMulActivation<T>::FusedMatMulActivation(const OpKernelInfo& info) : CudaKernel(info) {
+  alpha_ = info.GetAttrOrDefault<float>("alpha", 1.0f);
+  trans_b_ = info.GetAttrOrDefault<int64_t>("transB", 0) != 0;
+  ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("transA", 0) == 0 &&
+                  info.GetAttrOrDefault<int64_t>("transBatchA", 0) == 0 &&
+                  info.GetAttrOrDefault<int64_t>("transBatchB", 0) == 0,
+              "FusedMatMulActivation on CUDA only supports transposing B.");
+
+  const std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+  if (activation == "Relu") {
+    epilogue_ = CUBLASLT_EPILOGUE_RELU;
+    bias_epilogue_ = CUBLASLT_EPILOGUE_RELU_BIAS;
+  } else if (activation == "FastGelu") {
+    epilogue_ = CUBLASLT_EPILOGUE_GELU;
+    bias_epilogue_ = CUBLASLT_EPILOGUE_GELU_BIAS;
+  } else {
+    ORT_THROW("FusedMatMulActivation on CUDA does not support activation '", activation, "'.");
+  }
+}
+
+template <typename T>
+Status FusedMatMulActivation<T>::ComputeInternal(OpKernelContext* ctx) const {
+  const Tensor* A = ctx->Input<Tensor>(0);
+  const Tensor* B = ctx->Input<Tensor>(1);
+  const Tensor* bias = ctx->Input<Tensor>(2);
+
+  const auto& a_shape = A->Shape();
+  const auto& b_shape = B->Shape();
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 2 && b_shape.NumDimensions() == 2,
+                    "FusedMatMulActivation on CUDA expects A with at least 2 dimensions and a 2D B, got A ", a_shape,
+                    " and B ", b_shape);
+  const size_t a_rank = a_shape.NumDimensions();
+  const int64_t K = a_shape[a_rank - 1];
+  const int64_t M = a_shape.SizeToDimension(a_rank - 1);
+  const int64_t N = trans_b_ ? b_shape[0] : b_shape[1];
+  ORT_RETURN_IF_NOT((trans_b_ ? b_shape[1] : b_shape[0]) == K, "FusedMatMulActivation: A ", a_shape,
+                    " and B ", b_shape, " have different K.");
+  ORT_RETURN_IF_NOT(bias == nullptr || (bias->Shape().NumDimensions() == 1 && bias->Shape()[0] == N),
+                    "FusedMatMulActivation: the bias must be 1D of size ", N, ", got ", bias->Shape());
+
+  TensorShapeVector y_dims = a_shape.AsShapeVector();
+  y_dims[a_rank - 1] = N;
+  Tensor* Y = ctx->Output(0, y_dims);
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+  ORT_RETURN_IF(K == 0, "FusedMatMulActivation on CUDA does not support K = 0.");
+
+  // Y^T(N, M) = B^T(N, K) * A^T(K, M) in column major order, so the bias epilogue adds the bias to every column
+  const cudaDataType_t data_type = CudaDataType<T>();
+  cublasComputeType_t compute_type = CUBLAS_COMPUTE_32F;
+  if (std::is_same<T, float>::value && UseTF32() && GetDeviceProp().major >= 8) {
+    compute_type = CUBLAS_COMPUTE_32F_FAST_TF32;
+  }
+
+  LtMatmulDescriptors desc;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescCreate(&desc.matmul, compute_type, CUDA_R_32F));
+  // B is the first operand of cuBLASLt, A the second
+  const cublasOperation_t b_op = trans_b_ ? CUBLAS_OP_T : CUBLAS_OP_N;
+  const cublasOperation_t a_op = CUBLAS_OP_N;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(desc.matmul, CUBLASLT_MATMUL_DESC_TRANSA, &b_op,
+                                                        sizeof(b_op)));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(desc.matmul, CUBLASLT_MATMUL_DESC_TRANSB, &a_op,
+                                                        sizeof(a_op)));
+  const cublasLtEpilogue_t epilogue = bias != nullptr ? bias_epilogue_ : epilogue_;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(desc.matmul, CUBLASLT_MATMUL_DESC_EPILOGUE, &epilogue,
+                                                        sizeof(epilogue)));
+  if (bias != nullptr) {
+    const void* bias_data = bias->DataRaw();
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(desc.matmul, CUBLASLT_MATMUL_DESC_BIAS_POINTER,
+                                                          &bias_data, sizeof(bias_data)));
+  }
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc.b_desc, data_type, trans_b_ ? K : N, trans_b_ ? N : K,
+                                                    trans_b_ ? K : N));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc.a_desc, data_type, K, M, K));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc.y_desc, data_type, N, M, N));
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceCreate(&desc.preference));
+  size_t workspace_size = kWorkspaceSize;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceSetAttribute(desc.preference,
+                                                              CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                                              &workspace_size, sizeof(workspace_size)));
+
+  cublasLtHandle_t handle = CublasLtHandle();
+  cublasLtMatmulHeuristicResult_t heuristic = {};
+  int num_results = 0;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulAlgoGetHeuristic(handle, desc.matmul, desc.b_desc, desc.a_desc, desc.y_desc,
+                                                        desc.y_desc, desc.preference, 1, &heuristic, &num_results));
+  ORT_RETURN_IF(num_results == 0, "cuBLASLt has no algorithm for FusedMatMulActivation with M=", M, ", N=", N,
+                ", K=", K);
+
+  auto workspace = GetScratchBuffer<void>(heuristic.workspaceSize, ctx->GetComputeStream());
+  const float beta = 0.0f;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmul(handle, desc.matmul, &alpha_, B->DataRaw(), desc.b_desc, A->DataRaw(),
+                                        desc.a_desc, &beta, Y->MutableDataRaw(), desc.y_desc, Y->MutableDataRaw(),
+                                        desc.y_desc, &heuristic.algo, workspace.get(), heuristic.workspaceSize,
+                                        Stream(ctx)));
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Y = activation(alpha * A * B + bias) with a single cublasLtMatmul call, the bias and the activation are applied
+// in its epilogue. B is 2D and A is flattened to 2D, see MatMulBiasActivationFusion.
+template <typename T>
+class FusedMatMulActivation final : public onnxruntime::cuda::CudaKernel {
+ public:
+  FusedMatMulActivation(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  float alpha_;
+  bool trans_b_;
+  // the epilogue of the activation, and of the bias and the activation
+  cublasLtEpilogue_t epilogue_;
+  cublasLtEpilogue_t bias_epilogue_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
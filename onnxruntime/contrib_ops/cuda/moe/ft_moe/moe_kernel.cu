@@ -959,7 +959,9 @@ void CutlassMoeFCRunner<T, WeightType, Enable>::dispatch_activations(int64_t *to
     const int blocks = (num_experts + threads - 1) / threads;
 
     cudaEvent_t &copy_event = cuda_event_.Get();
-    cudaEventCreateWithFlags(&copy_event, cudaEventDisableTiming);
+    if (copy_event == nullptr) {
+        cudaEventCreateWithFlags(&copy_event, cudaEventDisableTiming);
+    }
     cudaEventRecord(copy_event, stream);
 
     dispatch_activations_kernel<<<blocks, threads, 0, stream>>>(total_rows_before_expert, num_experts,
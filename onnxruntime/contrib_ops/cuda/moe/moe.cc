@@ -5,6 +5,16 @@
 #include "core/providers/cuda/cuda_common.h"
 #include "moe.h"
 
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "core/common/parse_string.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#endif
+
 using namespace onnxruntime::cuda;
 using namespace ::onnxruntime::common;
 using namespace ONNX_NAMESPACE;
@@ -13,27 +23,137 @@ namespace onnxruntime {
 namespace contrib {
 namespace cuda {
 
-#define REGISTER_KERNEL_TYPED(T)                    \
-  ONNX_OPERATOR_TYPED_KERNEL_EX(                    \
-      MoE, kMSDomain, 1, T, kCudaExecutionProvider, \
-      (*KernelDefBuilder::Create()).MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), MoE<T>);
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+// the expert weights stay in host memory and are paged into the device by MoEExpertCache
+#define MOE_EXPERT_WEIGHTS_MEMORY_TYPE   \
+  .InputMemoryType(OrtMemTypeCPUInput, 2) \
+      .InputMemoryType(OrtMemTypeCPUInput, 4) \
+      .InputMemoryType(OrtMemTypeCPUInput, 6)
+#else
+#define MOE_EXPERT_WEIGHTS_MEMORY_TYPE
+#endif
+
+#define REGISTER_KERNEL_TYPED(T)                                                       \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                       \
+      MoE, kMSDomain, 1, T, kCudaExecutionProvider,                                    \
+      (*KernelDefBuilder::Create())                                                    \
+          .MayInplace(0, 0) MOE_EXPERT_WEIGHTS_MEMORY_TYPE                             \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),                      \
+      MoE<T>);
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(MLFloat16)
 
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+namespace {
+
+// Returns the experts that the top k routing of run_moe_fc can pick for any of the rows. The top k of the softmax
+// is the top k of the logits, and experts that tie with the k-th logit of a row are included too, so the result does
+// not depend on the rounding of the softmax computed on the device.
+template <typename T>
+std::vector<int> GetRoutedExperts(const T* router_probs, int64_t num_rows, int64_t num_experts, int64_t k,
+                                  bool use_sparse_mixer) {
+  std::vector<int> experts;
+  if (use_sparse_mixer || k >= num_experts) {
+    experts.resize(static_cast<size_t>(num_experts));
+    std::iota(experts.begin(), experts.end(), 0);
+    return experts;
+  }
+
+  std::vector<bool> routed(static_cast<size_t>(num_experts), false);
+  std::vector<float> logits(static_cast<size_t>(num_experts));
+  for (int64_t row = 0; row < num_rows; ++row) {
+    const T* row_probs = router_probs + row * num_experts;
+    std::transform(row_probs, row_probs + num_experts, logits.begin(), [](T v) { return static_cast<float>(v); });
+    std::vector<float> sorted = logits;
+    std::nth_element(sorted.begin(), sorted.begin() + (k - 1), sorted.end(), std::greater<float>());
+    const float threshold = sorted[static_cast<size_t>(k - 1)];
+    for (int64_t e = 0; e < num_experts; ++e) {
+      if (logits[e] >= threshold) {
+        routed[e] = true;
+      }
+    }
+  }
+
+  for (int64_t e = 0; e < num_experts; ++e) {
+    if (routed[e]) {
+      experts.push_back(static_cast<int>(e));
+    }
+  }
+  return experts;
+}
+
+}  // namespace
+#endif
+
 template <typename T>
 MoE<T>::MoE(const OpKernelInfo& op_kernel_info) : CudaKernel(op_kernel_info), MoEBase(op_kernel_info) {
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+  int cache_size = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale<int>(
+      op_kernel_info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsCudaMoEExpertCacheSize, "8"),
+      cache_size));
+  ORT_ENFORCE(cache_size > 0, "The MoE expert cache size must be positive, got ", cache_size);
+  expert_cache_ = std::make_unique<MoEExpertCache>(static_cast<size_t>(cache_size));
+#endif
+}
+
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+template <typename T>
+Status MoE<T>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr /*alloc*/,
+                       bool& is_packed, PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+  std::unique_ptr<Tensor>* packed = nullptr;
+  switch (input_idx) {
+    case 2:
+      packed = &packed_fc1_experts_weights_;
+      break;
+    case 4:
+      packed = &packed_fc2_experts_weights_;
+      break;
+    case 6:
+      packed = &packed_fc3_experts_weights_;
+      break;
+    default:
+      return Status::OK();
+  }
+
+  // the pinned copy lets the copy stream page the experts in asynchronously, and replaces the initializer
+  AllocatorPtr pinned_allocator = Info().GetAllocator(OrtMemType::OrtMemTypeCPU);
+  if (pinned_allocator == nullptr) {
+    return Status::OK();
+  }
+
+  *packed = std::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), std::move(pinned_allocator));
+  memcpy((*packed)->MutableDataRaw(), tensor.DataRaw(), tensor.SizeInBytes());
+  is_packed = true;
+  return Status::OK();
 }
 
+template <typename T>
+const Tensor* MoE<T>::ExpertWeights(OpKernelContext* context, int input_idx) const {
+  const std::unique_ptr<Tensor>& packed = input_idx == 2   ? packed_fc1_experts_weights_
+                                          : input_idx == 4 ? packed_fc2_experts_weights_
+                                                           : packed_fc3_experts_weights_;
+  return packed != nullptr ? packed.get() : context->Input<Tensor>(input_idx);
+}
+#endif
+
 template <typename T>
 Status MoE<T>::ComputeInternal(OpKernelContext* context) const {
   const Tensor* input = context->Input<Tensor>(0);
   const Tensor* router_probs = context->Input<Tensor>(1);
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+  const Tensor* fc1_experts_weights = ExpertWeights(context, 2);
+  const Tensor* fc2_experts_weights = ExpertWeights(context, 4);
+  const Tensor* fc3_experts_weights_optional = ExpertWeights(context, 6);
+#else
   const Tensor* fc1_experts_weights = context->Input<Tensor>(2);
-  const Tensor* fc1_experts_bias_optional = context->Input<Tensor>(3);
   const Tensor* fc2_experts_weights = context->Input<Tensor>(4);
-  const Tensor* fc2_experts_bias_optional = context->Input<Tensor>(5);
   const Tensor* fc3_experts_weights_optional = context->Input<Tensor>(6);
+#endif
+  const Tensor* fc1_experts_bias_optional = context->Input<Tensor>(3);
+  const Tensor* fc2_experts_bias_optional = context->Input<Tensor>(5);
   const Tensor* fc3_experts_bias_optional = context->Input<Tensor>(7);
 
   MoEParameters moe_params;
@@ -74,6 +194,60 @@ Status MoE<T>::ComputeInternal(OpKernelContext* context) const {
 
   const CudaT* fc_scales_ptr = nullptr;
 
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+  // The routed experts are found on the host, and each of them runs as the only local expert of a sharded MoE once
+  // the cache has paged its weights in. The rows of an expert are a contiguous slice of fc2_output, so the runs
+  // fill disjoint parts of it and finalize_moe_routing sees the same result as with all the experts on the device.
+  const size_t router_probs_size = SafeInt<size_t>(moe_params.num_rows) * moe_params.num_experts;
+  auto router_probs_host = AllocateBufferOnCPUPinned<T>(router_probs_size);
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(router_probs_host.get(), router_probs->template Data<T>(),
+                                       router_probs_size * sizeof(T), cudaMemcpyDeviceToHost, Stream(context)));
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(Stream(context)));
+  const std::vector<int> routed_experts = GetRoutedExperts(router_probs_host.get(), moe_params.num_rows,
+                                                           moe_params.num_experts, k_, use_sparse_mixer_);
+
+  const bool has_fc3 = fc3_experts_weights_optional != nullptr;
+  const size_t local_num_experts = static_cast<size_t>(moe_params.local_num_experts);
+  InlinedVector<const void*> host_weights{fc1_experts_weights->DataRaw(), fc2_experts_weights->DataRaw()};
+  InlinedVector<size_t> weight_bytes{fc1_experts_weights->SizeInBytes() / local_num_experts,
+                                     fc2_experts_weights->SizeInBytes() / local_num_experts};
+  if (has_fc3) {
+    host_weights.push_back(fc3_experts_weights_optional->DataRaw());
+    weight_bytes.push_back(fc3_experts_weights_optional->SizeInBytes() / local_num_experts);
+  }
+
+  // weights that are not initializers may change between runs
+  const bool cacheable = packed_fc1_experts_weights_ != nullptr && packed_fc2_experts_weights_ != nullptr &&
+                         (!has_fc3 || packed_fc3_experts_weights_ != nullptr);
+
+  const CudaT* fc1_experts_bias = fc1_experts_bias_optional == nullptr
+                                      ? nullptr
+                                      : reinterpret_cast<const CudaT*>(fc1_experts_bias_optional->template Data<T>());
+  const CudaT* fc3_experts_bias = fc3_experts_bias_optional == nullptr
+                                      ? nullptr
+                                      : reinterpret_cast<const CudaT*>(fc3_experts_bias_optional->template Data<T>());
+  const int64_t inter_size = moe_params.inter_size;
+
+  ORT_RETURN_IF_ERROR(expert_cache_->Run(
+      routed_experts, host_weights, weight_bytes, cacheable, Info().GetAllocator(OrtMemType::OrtMemTypeDefault),
+      Stream(context), [&](int expert, gsl::span<void* const> device_weights) {
+        moe_runner.run_moe_fc(
+            reinterpret_cast<const CudaT*>(input->template Data<T>()),
+            reinterpret_cast<const CudaT*>(router_probs->template Data<T>()),
+            reinterpret_cast<const CudaT*>(device_weights[0]), fc_scales_ptr,
+            fc1_experts_bias == nullptr ? nullptr : fc1_experts_bias + expert * inter_size, activation_type_,
+            has_fc3 ? reinterpret_cast<const CudaT*>(device_weights[2]) : nullptr, fc_scales_ptr,
+            fc3_experts_bias == nullptr ? nullptr : fc3_experts_bias + expert * inter_size,
+            reinterpret_cast<const CudaT*>(device_weights[1]), fc_scales_ptr,
+            static_cast<int>(moe_params.num_rows), static_cast<int>(moe_params.hidden_size),
+            static_cast<int>(moe_params.inter_size), static_cast<int>(moe_params.num_experts), 1, expert,
+            static_cast<int>(k_), reinterpret_cast<char*>(work_space.get()), reinterpret_cast<CudaT*>(fc2_output.get()),
+            reinterpret_cast<CudaT*>(expert_scales.get()),
+            reinterpret_cast<int*>(expanded_source_row_to_expanded_dest_row.get()),
+            reinterpret_cast<int*>(expert_for_source_row.get()), Stream(context));
+        return Status::OK();
+      }));
+#else
   moe_runner.run_moe_fc(
       reinterpret_cast<const CudaT*>(input->template Data<T>()),
       reinterpret_cast<const CudaT*>(router_probs->template Data<T>()),
@@ -97,6 +271,8 @@ Status MoE<T>::ComputeInternal(OpKernelContext* context) const {
       reinterpret_cast<int*>(expanded_source_row_to_expanded_dest_row.get()),
       reinterpret_cast<int*>(expert_for_source_row.get()), Stream(context));
 
+#endif
+
   Tensor* output = context->Output(0, input->Shape());
 
   ort_fastertransformer::finalize_moe_routing_kernelLauncher(
@@ -5,6 +5,7 @@
 
 #include "contrib_ops/cuda/moe/ft_moe/moe_kernel.h"
 #include "contrib_ops/cuda/moe/moe_base.h"
+#include "contrib_ops/cuda/moe/moe_expert_cache.h"
 #include "core/common/common.h"
 #include "core/providers/cuda/cuda_kernel.h"
 
@@ -19,6 +20,21 @@ class MoE final : public CudaKernel, public MoEBase {
  public:
   explicit MoE(const OpKernelInfo& op_kernel_info);
   Status ComputeInternal(OpKernelContext* ctx) const override;
+
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 bool& is_packed, PrePackedWeights* prepacked_weights) override;
+
+ private:
+  const Tensor* ExpertWeights(OpKernelContext* context, int input_idx) const;
+
+  // The expert weights are host memory inputs. PrePack moves the initializers to pinned memory, from where
+  // expert_cache_ pages the experts picked by the routing into device memory.
+  std::unique_ptr<Tensor> packed_fc1_experts_weights_;
+  std::unique_ptr<Tensor> packed_fc2_experts_weights_;
+  std::unique_ptr<Tensor> packed_fc3_experts_weights_;
+  std::unique_ptr<MoEExpertCache> expert_cache_;
+#endif
 };
 
 }  // namespace cuda
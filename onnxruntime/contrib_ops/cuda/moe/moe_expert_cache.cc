@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+
+#include "contrib_ops/cuda/moe/moe_expert_cache.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+// keeps every weight tensor of an expert aligned for the grouped GEMM kernels
+constexpr size_t kWeightAlignment = 256;
+
+size_t AlignedSize(size_t bytes) {
+  return (bytes + kWeightAlignment - 1) / kWeightAlignment * kWeightAlignment;
+}
+
+}  // namespace
+
+MoEExpertCache::MoEExpertCache(size_t num_slots) : slots_(num_slots) {
+  ORT_ENFORCE(num_slots > 0, "The MoE expert cache needs at least one slot.");
+}
+
+MoEExpertCache::~MoEExpertCache() {
+  for (auto& slot : slots_) {
+    if (slot.ready != nullptr) {
+      cudaEventDestroy(slot.ready);
+    }
+    if (slot.released != nullptr) {
+      cudaEventDestroy(slot.released);
+    }
+  }
+  if (copy_stream_ != nullptr) {
+    cudaStreamDestroy(copy_stream_);
+  }
+}
+
+Status MoEExpertCache::Initialize() {
+  CUDA_RETURN_IF_ERROR(cudaStreamCreateWithFlags(&copy_stream_, cudaStreamNonBlocking));
+  for (auto& slot : slots_) {
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&slot.ready, cudaEventDisableTiming));
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&slot.released, cudaEventDisableTiming));
+  }
+  return Status::OK();
+}
+
+Status MoEExpertCache::Reserve(gsl::span<const size_t> weight_bytes, AllocatorPtr allocator) {
+  if (slots_[0].data != nullptr && std::equal(weight_bytes.begin(), weight_bytes.end(), weight_bytes_.begin(),
+                                              weight_bytes_.end())) {
+    return Status::OK();
+  }
+
+  weight_bytes_.assign(weight_bytes.begin(), weight_bytes.end());
+  expert_bytes_ = 0;
+  for (size_t bytes : weight_bytes_) {
+    expert_bytes_ += AlignedSize(bytes);
+  }
+
+  for (auto& slot : slots_) {
+    // the slot may still be read by an earlier call
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(slot.released));
+    slot.expert = -1;
+    slot.data.reset();
+    slot.data = IAllocator::MakeUniquePtr<void>(allocator, expert_bytes_);
+  }
+  return Status::OK();
+}
+
+int MoEExpertCache::FindSlot(int expert) const {
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    if (slots_[i].expert == expert) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+int MoEExpertCache::FindVictim() const {
+  int victim = -1;
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    const auto& slot = slots_[i];
+    if (!slot.pending && (victim < 0 || slot.last_use < slots_[victim].last_use)) {
+      victim = static_cast<int>(i);
+    }
+  }
+  return victim;
+}
+
+Status MoEExpertCache::CopyIn(Slot& slot, int expert, gsl::span<const void* const> host_weights) {
+  // the previous expert in the slot may still be in use on the compute stream
+  CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(copy_stream_, slot.released, 0));
+
+  char* dst = static_cast<char*>(slot.data.get());
+  for (size_t i = 0; i < weight_bytes_.size(); ++i) {
+    const char* src = static_cast<const char*>(host_weights[i]) + static_cast<size_t>(expert) * weight_bytes_[i];
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst, src, weight_bytes_[i], cudaMemcpyHostToDevice, copy_stream_));
+    dst += AlignedSize(weight_bytes_[i]);
+  }
+
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(slot.ready, copy_stream_));
+  slot.expert = expert;
+  return Status::OK();
+}
+
+Status MoEExpertCache::Run(gsl::span<const int> experts, gsl::span<const void* const> host_weights,
+                           gsl::span<const size_t> weight_bytes, bool cacheable, AllocatorPtr allocator,
+                           cudaStream_t stream, const RunExpertFn& run_expert) {
+  ORT_RETURN_IF_NOT(host_weights.size() == weight_bytes.size(), "Expected ", weight_bytes.size(),
+                    " expert weight tensors, got ", host_weights.size());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (copy_stream_ == nullptr) {
+    ORT_RETURN_IF_ERROR(Initialize());
+  }
+  ORT_RETURN_IF_ERROR(Reserve(weight_bytes, std::move(allocator)));
+
+  for (auto& slot : slots_) {
+    slot.pending = false;
+    if (!cacheable) {
+      slot.expert = -1;
+    }
+  }
+
+  // Experts in the cache run first, so their slots can be reused by the later experts that have to be copied in.
+  InlinedVector<int> order;
+  InlinedVector<int> slot_of;
+  order.reserve(experts.size());
+  slot_of.reserve(experts.size());
+  for (int expert : experts) {
+    const int slot = FindSlot(expert);
+    if (slot >= 0) {
+      order.push_back(expert);
+      slot_of.push_back(slot);
+      slots_[slot].pending = true;
+    }
+  }
+
+  size_t num_assigned = order.size();
+  for (int expert : experts) {
+    if (FindSlot(expert) < 0) {
+      order.push_back(expert);
+      slot_of.push_back(-1);
+    }
+  }
+
+  InlinedVector<void*> device_weights(weight_bytes_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    // Prefetch the next experts into the slots that are not needed by the experts still to run.
+    // The copies are issued in order, so the expert run next always finds a slot.
+    while (num_assigned < order.size()) {
+      const int victim = FindVictim();
+      if (victim < 0) {
+        break;
+      }
+
+      ORT_RETURN_IF_ERROR(CopyIn(slots_[victim], order[num_assigned], host_weights));
+      slots_[victim].pending = true;
+      slot_of[num_assigned++] = victim;
+    }
+
+    Slot& slot = slots_[slot_of[i]];
+    char* data = static_cast<char*>(slot.data.get());
+    for (size_t w = 0; w < weight_bytes_.size(); ++w) {
+      device_weights[w] = data;
+      data += AlignedSize(weight_bytes_[w]);
+    }
+
+    CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(stream, slot.ready, 0));
+    ORT_RETURN_IF_ERROR(run_expert(order[i], device_weights));
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(slot.released, stream));
+    slot.pending = false;
+    slot.last_use = ++clock_;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif  // USE_CUDA_MOE_EXPERT_OFFLOAD
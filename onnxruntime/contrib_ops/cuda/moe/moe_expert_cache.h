@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "core/common/inlined_containers.h"
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// LRU cache of MoE expert weights in device memory, for experts whose weights are kept in (pinned) host memory.
+// Each slot holds all the weight tensors (fc1, fc3, fc2) of one expert. The experts needed by a call are paged in on
+// a separate copy stream, so the copy of an expert overlaps the compute of the experts run before it.
+class MoEExpertCache {
+ public:
+  explicit MoEExpertCache(size_t num_slots);
+  ~MoEExpertCache();
+
+  using RunExpertFn = std::function<Status(int expert, gsl::span<void* const> device_weights)>;
+
+  // Calls run_expert for each of the experts on `stream`, once the weights of the expert are in a slot.
+  // host_weights[i] points to the weights of expert 0 in weight tensor i, and weight_bytes[i] is the size of one
+  // expert in it. If cacheable is false the weights may change between calls, so nothing cached by an earlier call
+  // is used.
+  Status Run(gsl::span<const int> experts, gsl::span<const void* const> host_weights,
+             gsl::span<const size_t> weight_bytes, bool cacheable, AllocatorPtr allocator, cudaStream_t stream,
+             const RunExpertFn& run_expert);
+
+ private:
+  struct Slot {
+    int expert = -1;
+    uint64_t last_use = 0;
+    // assigned to an expert of the current call that did not run yet
+    bool pending = false;
+    IAllocatorUniquePtr<void> data;
+    cudaEvent_t ready = nullptr;     // recorded on the copy stream after the copy into the slot
+    cudaEvent_t released = nullptr;  // recorded on the compute stream after the last use of the slot
+  };
+
+  Status Initialize();
+  Status Reserve(gsl::span<const size_t> weight_bytes, AllocatorPtr allocator);
+  int FindSlot(int expert) const;
+  int FindVictim() const;
+  Status CopyIn(Slot& slot, int expert, gsl::span<const void* const> host_weights);
+
+  InlinedVector<size_t> weight_bytes_;
+  size_t expert_bytes_ = 0;
+  std::vector<Slot> slots_;
+  cudaStream_t copy_stream_ = nullptr;
+  uint64_t clock_ = 0;
+  std::mutex mutex_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MoEExpertCache);
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif  // USE_CUDA_MOE_EXPERT_OFFLOAD
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/tensor/image_preprocess.h"
+#include "contrib_ops/cuda/tensor/image_preprocess_impl.h"
+
+#include <limits>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+ONNX_OPERATOR_KERNEL_EX(
+    ImagePreprocess,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<MLFloat16>()}),
+    ImagePreprocess);
+
+ImagePreprocess::ImagePreprocess(const OpKernelInfo& info) : CudaKernel(info) {
+  std::vector<int64_t> size;
+  ORT_ENFORCE(info.GetAttrs("size", size).IsOK() && size.size() == 2 && size[0] > 0 && size[1] > 0,
+              "ImagePreprocess: 'size' must contain a positive height and width");
+  output_height_ = size[0];
+  output_width_ = size[1];
+
+  const std::string mode = info.GetAttrOrDefault<std::string>("mode", "linear");
+  ORT_ENFORCE(mode == "linear" || mode == "nearest", "ImagePreprocess: unsupported mode ", mode);
+  linear_ = mode == "linear";
+
+  scale_ = info.GetAttrOrDefault<float>("scale", 1.0f);
+  mean_ = info.GetAttrsOrDefault<float>("mean", {0.0f});
+  std_ = info.GetAttrsOrDefault<float>("std", {1.0f});
+  for (float s : std_) {
+    ORT_ENFORCE(s != 0.0f, "ImagePreprocess: 'std' must not contain zeros");
+  }
+  reverse_channels_ = info.GetAttrOrDefault<int64_t>("reverse_channels", 0) != 0;
+  channels_last_ = info.GetAttrOrDefault<int64_t>("channels_last", 0) != 0;
+  to_ = info.GetAttrOrDefault<int64_t>("to", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ORT_ENFORCE(to_ == ONNX_NAMESPACE::TensorProto_DataType_FLOAT || to_ == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16,
+              "ImagePreprocess: 'to' must be float or float16");
+}
+
+Status ImagePreprocess::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The input is expected to have 4 dimensions (N, H, W, C), got ", input_dims.size());
+  }
+
+  const int64_t channels = input_dims[3];
+  if (channels <= 0 || channels > kImagePreprocessMaxChannels) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The number of channels must be in [1, ",
+                           kImagePreprocessMaxChannels, "], got ", channels);
+  }
+  if (input_dims[1] <= 0 || input_dims[2] <= 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The input images must not be empty");
+  }
+  for (const auto* values : {&mean_, &std_}) {
+    if (values->size() != 1 && static_cast<int64_t>(values->size()) != channels) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "'mean' and 'std' must have 1 or ", channels, " values, got ", values->size());
+    }
+  }
+
+  const int64_t batch_size = input_dims[0];
+  TensorShape output_shape = channels_last_
+                                 ? TensorShape({batch_size, output_height_, output_width_, channels})
+                                 : TensorShape({batch_size, channels, output_height_, output_width_});
+  Tensor* output = context->Output(0, output_shape);
+  ORT_RETURN_IF_NOT(batch_size * output_height_ * output_width_ <= std::numeric_limits<int>::max(),
+                    "ImagePreprocess: the output has too many pixels");
+
+  ImagePreprocessParams params;
+  params.batch_size = static_cast<int>(batch_size);
+  params.input_height = static_cast<int>(input_dims[1]);
+  params.input_width = static_cast<int>(input_dims[2]);
+  params.channels = static_cast<int>(channels);
+  params.output_height = static_cast<int>(output_height_);
+  params.output_width = static_cast<int>(output_width_);
+  params.linear = linear_;
+  params.reverse_channels = reverse_channels_;
+  params.channels_last = channels_last_;
+  params.multiplier.SetSize(params.channels);
+  params.offset.SetSize(params.channels);
+  for (int c = 0; c < params.channels; c++) {
+    const float mean = mean_.size() == 1 ? mean_[0] : mean_[c];
+    const float stddev = std_.size() == 1 ? std_[0] : std_[c];
+    params.multiplier[c] = scale_ / stddev;
+    params.offset[c] = -mean / stddev;
+  }
+
+  cudaStream_t stream = Stream(context);
+  if (to_ == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16) {
+    return LaunchImagePreprocessKernel<half>(stream, params, input->Data<uint8_t>(),
+                                             reinterpret_cast<half*>(output->MutableData<MLFloat16>()));
+  }
+  return LaunchImagePreprocessKernel<float>(stream, params, input->Data<uint8_t>(), output->MutableData<float>());
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
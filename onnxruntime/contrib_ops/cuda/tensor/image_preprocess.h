@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <vector>
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using onnxruntime::cuda::CudaKernel;
+
+// Fused resize, normalization and HWC to CHW conversion of uint8 images.
+class ImagePreprocess final : public CudaKernel {
+ public:
+  ImagePreprocess(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  int64_t output_height_;
+  int64_t output_width_;
+  bool linear_;
+  float scale_;
+  std::vector<float> mean_;
+  std::vector<float> std_;
+  bool reverse_channels_;
+  bool channels_last_;
+  int64_t to_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "contrib_ops/cuda/tensor/image_preprocess_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+// One thread per output pixel. x is the fastest moving index, so both the reads of the HWC input and the writes of
+// each NCHW output plane are coalesced.
+template <typename T>
+__global__ void ImagePreprocessKernel(const uint8_t* input, T* output, int input_height, int input_width, int channels,
+                                      fast_divmod output_width_div, fast_divmod output_hw_div, float height_scale,
+                                      float width_scale, bool linear, bool reverse_channels, bool channels_last,
+                                      TArray<float> multiplier, TArray<float> offset, int num_pixels) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, num_pixels);
+
+  int n, yx;
+  output_hw_div.divmod(id, n, yx);
+  int y, x;
+  output_width_div.divmod(yx, y, x);
+
+  const int output_hw = output_hw_div.d_;
+  const uint8_t* image = input + static_cast<int64_t>(n) * input_height * input_width * channels;
+  T* out = channels_last ? output + static_cast<int64_t>(id) * channels
+                         : output + static_cast<int64_t>(n) * channels * output_hw + yx;
+  const int out_stride = channels_last ? 1 : output_hw;
+
+  if (linear) {
+    // half pixel coordinates, clamped at the border
+    const float in_y = fmaxf((y + 0.5f) * height_scale - 0.5f, 0.0f);
+    const float in_x = fmaxf((x + 0.5f) * width_scale - 0.5f, 0.0f);
+    const int y0 = min(static_cast<int>(in_y), input_height - 1);
+    const int x0 = min(static_cast<int>(in_x), input_width - 1);
+    const int y1 = min(y0 + 1, input_height - 1);
+    const int x1 = min(x0 + 1, input_width - 1);
+    const float dy = in_y - y0;
+    const float dx = in_x - x0;
+
+    const uint8_t* p00 = image + (y0 * input_width + x0) * channels;
+    const uint8_t* p01 = image + (y0 * input_width + x1) * channels;
+    const uint8_t* p10 = image + (y1 * input_width + x0) * channels;
+    const uint8_t* p11 = image + (y1 * input_width + x1) * channels;
+    for (int c = 0; c < channels; c++) {
+      const int src = reverse_channels ? channels - 1 - c : c;
+      const float top = p00[src] + (p01[src] - p00[src]) * dx;
+      const float bottom = p10[src] + (p11[src] - p10[src]) * dx;
+      const float value = top + (bottom - top) * dy;
+      out[c * out_stride] = T(value * multiplier[c] + offset[c]);
+    }
+  } else {
+    const int in_y = min(static_cast<int>(y * height_scale), input_height - 1);
+    const int in_x = min(static_cast<int>(x * width_scale), input_width - 1);
+    const uint8_t* p = image + (in_y * input_width + in_x) * channels;
+    for (int c = 0; c < channels; c++) {
+      const int src = reverse_channels ? channels - 1 - c : c;
+      out[c * out_stride] = T(p[src] * multiplier[c] + offset[c]);
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+Status LaunchImagePreprocessKernel(cudaStream_t stream, const ImagePreprocessParams& params,
+                                   const uint8_t* input, T* output) {
+  const int output_hw = params.output_height * params.output_width;
+  const int num_pixels = params.batch_size * output_hw;
+  if (num_pixels == 0) {
+    return Status::OK();
+  }
+
+  const float height_scale = static_cast<float>(params.input_height) / params.output_height;
+  const float width_scale = static_cast<float>(params.input_width) / params.output_width;
+  const int blocks_per_grid = CeilDiv(num_pixels, GridDim::maxThreadsPerBlock);
+  ImagePreprocessKernel<T><<<blocks_per_grid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      input, output, params.input_height, params.input_width, params.channels,
+      fast_divmod(params.output_width), fast_divmod(output_hw), height_scale, width_scale,
+      params.linear, params.reverse_channels, params.channels_last, params.multiplier, params.offset, num_pixels);
+  return CUDA_CALL(cudaGetLastError());
+}
+
+template Status LaunchImagePreprocessKernel<float>(cudaStream_t stream, const ImagePreprocessParams& params,
+                                                   const uint8_t* input, float* output);
+template Status LaunchImagePreprocessKernel<half>(cudaStream_t stream, const ImagePreprocessParams& params,
+                                                  const uint8_t* input, half* output);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
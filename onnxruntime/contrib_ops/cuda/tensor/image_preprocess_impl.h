@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using onnxruntime::cuda::TArray;
+
+// The per channel normalization is passed by value to the kernel, which limits the number of channels.
+constexpr int kImagePreprocessMaxChannels = TArray<float>::Capacity();
+
+struct ImagePreprocessParams {
+  int batch_size;
+  int input_height;
+  int input_width;
+  int channels;
+  int output_height;
+  int output_width;
+  bool linear;
+  bool reverse_channels;
+  bool channels_last;
+  // output = resampled * multiplier[c] + offset[c]
+  TArray<float> multiplier;
+  TArray<float> offset;
+};
+
+template <typename T>
+Status LaunchImagePreprocessKernel(cudaStream_t stream, const ImagePreprocessParams& params,
+                                   const uint8_t* input, T* output);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/rocm/math/fused_matmul_activation.h"
+
+#include "contrib_ops/rocm/bert/gemm_fast_gelu_impl.h"
+#include "contrib_ops/rocm/math/gemm_relu_impl.h"
+#include "core/providers/rocm/rocm_common.h"
+
+using onnxruntime::rocm::ToHipType;
+
+namespace onnxruntime {
+namespace contrib {
+namespace rocm {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      FusedMatMulActivation,                                      \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kRocmExecutionProvider,                                     \
+      (*KernelDefBuilder::Create())                               \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      FusedMatMulActivation<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+REGISTER_KERNEL_TYPED(BFloat16)
+
+template <typename T>
+FusedMatMulActivation<T>::FusedMatMulActivation(const OpKernelInfo& info) : RocmKernel(info) {
+  alpha_ = info.GetAttrOrDefault<float>("alpha", 1.0f);
+  trans_b_ = info.GetAttrOrDefault<int64_t>("transB", 0) != 0;
+  ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("transA", 0) == 0 &&
+                  info.GetAttrOrDefault<int64_t>("transBatchA", 0) == 0 &&
+                  info.GetAttrOrDefault<int64_t>("transBatchB", 0) == 0,
+              "FusedMatMulActivation on ROCm only supports transposing B.");
+
+  const std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+  ORT_ENFORCE(activation == "Relu" || activation == "FastGelu",
+              "FusedMatMulActivation on ROCm does not support activation '", activation, "'.");
+  relu_ = activation == "Relu";
+}
+
+template <typename T>
+Status FusedMatMulActivation<T>::ComputeInternal(OpKernelContext* ctx) const {
+  typedef typename ToHipType<T>::MappedType HipT;
+
+  const Tensor* A = ctx->Input<Tensor>(0);
+  const Tensor* B = ctx->Input<Tensor>(1);
+  const Tensor* bias = ctx->Input<Tensor>(2);
+
+  const auto& a_shape = A->Shape();
+  const auto& b_shape = B->Shape();
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 2 && b_shape.NumDimensions() == 2,
+                    "FusedMatMulActivation on ROCm expects A with at least 2 dimensions and a 2D B, got A ", a_shape,
+                    " and B ", b_shape);
+  const size_t a_rank = a_shape.NumDimensions();
+  const int64_t K = a_shape[a_rank - 1];
+  const int64_t M = a_shape.SizeToDimension(a_rank - 1);
+  const int64_t N = trans_b_ ? b_shape[0] : b_shape[1];
+  ORT_RETURN_IF_NOT((trans_b_ ? b_shape[1] : b_shape[0]) == K, "FusedMatMulActivation: A ", a_shape,
+                    " and B ", b_shape, " have different K.");
+  ORT_RETURN_IF_NOT(bias == nullptr || (bias->Shape().NumDimensions() == 1 && bias->Shape()[0] == N),
+                    "FusedMatMulActivation: the bias must be 1D of size ", N, ", got ", bias->Shape());
+
+  TensorShapeVector y_dims = a_shape.AsShapeVector();
+  y_dims[a_rank - 1] = N;
+  Tensor* Y = ctx->Output(0, y_dims);
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+  ORT_RETURN_IF(K == 0, "FusedMatMulActivation on ROCm does not support K = 0.");
+
+  using onnxruntime::rocm::tunable::blas::BlasOp;
+  const BlasOp opb = trans_b_ ? BlasOp::Trans : BlasOp::NonTrans;
+  const HipT alpha = ToHipType<T>::FromFloat(alpha_);
+  const HipT beta = ToHipType<T>::FromFloat(0.0f);
+  const HipT* a_data = reinterpret_cast<const HipT*>(A->Data<T>());
+  const HipT* b_data = reinterpret_cast<const HipT*>(B->Data<T>());
+  const HipT* bias_data = bias != nullptr ? reinterpret_cast<const HipT*>(bias->Data<T>()) : nullptr;
+  HipT* y_data = reinterpret_cast<HipT*>(Y->MutableData<T>());
+
+  // the tuning results of both are persisted with the other TunableOp results of the session
+  if (relu_) {
+    return blas::row_major::GemmRelu(GetTuningContext(), ctx->GetComputeStream(), GetHipblasHandle(ctx),
+                                     BlasOp::NonTrans, opb, M, N, K, alpha, a_data, K, b_data, trans_b_ ? K : N,
+                                     bias_data, beta, y_data, N);
+  }
+  return blas::row_major::GemmFastGelu(GetTuningContext(), ctx->GetComputeStream(), GetHipblasHandle(ctx),
+                                       BlasOp::NonTrans, opb, M, N, K, alpha, a_data, K, b_data, trans_b_ ? K : N,
+                                       bias_data, beta, y_data, N);
+}
+
+}  // namespace rocm
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/rocm/rocm_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace rocm {
+
+using onnxruntime::rocm::RocmKernel;
+
+// Y = activation(alpha * A * B + bias) with the tunable GemmRelu and GemmFastGelu, whose hipBLASLt candidates apply
+// the bias and the activation in the epilogue. B is 2D and A is flattened to 2D, see MatMulBiasActivationFusion.
+template <typename T>
+class FusedMatMulActivation final : public RocmKernel {
+ public:
+  FusedMatMulActivation(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* ctx) const override;
+
+ private:
+  float alpha_;
+  bool trans_b_;
+  // FastGelu if false
+  bool relu_;
+};
+
+}  // namespace rocm
+}  // namespace contrib
+}  // namespace onnxruntime
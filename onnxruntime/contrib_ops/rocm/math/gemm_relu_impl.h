@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "contrib_ops/rocm/math/gemm_relu_common.h"
+#include "core/common/status.h"
+#include "core/framework/float16.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace rocm {
+namespace blas {
+
+#define GEMMRELU(T, ScalarT)                                                     \
+  common::Status GemmRelu(                                                       \
+      RocmTuningContext* tuning_ctx, Stream* stream, hipblasHandle_t handle,     \
+      BlasOp opa, BlasOp opb,                                                    \
+      std::int64_t m, std::int64_t n, std::int64_t k,                            \
+      ScalarT alpha, const T* a, std::int64_t lda, const T* b, std::int64_t ldb, \
+      const T* bias, ScalarT beta, T* c, std::int64_t ldc)
+
+namespace row_major {
+
+GEMMRELU(float, float);
+GEMMRELU(half, half);
+GEMMRELU(BFloat16, BFloat16);
+GEMMRELU(half, float);
+GEMMRELU(BFloat16, float);
+
+}  // namespace row_major
+
+}  // namespace blas
+}  // namespace rocm
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#ifndef _GEMM_RELU_H_KEEP_SIGNATURE_DEFINES
+#undef GEMMRELU
+#endif
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+#include <memory>
+
+#include "contrib_ops/rocm/bert/elementwise.h"
+#include "contrib_ops/rocm/math/gemm_relu_common.h"
+#include "core/providers/rocm/tunable/gemm.h"
+#include "core/providers/rocm/tunable/gemm_hipblaslt.h"
+#include "core/providers/rocm/tunable/rocm_tunable.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace rocm {
+namespace blas {
+namespace internal {
+
+using namespace onnxruntime::rocm::tunable::blas::internal;
+
+template <typename T>
+Status GemmReluUnfused(const GemmReluParams<T>* params) {
+  namespace column_major = onnxruntime::rocm::tunable::blas::column_major;
+  ORT_RETURN_IF_ERROR(column_major::Gemm(params->tuning_ctx, params->stream, params->handle,
+                                         params->opb, params->opa,
+                                         params->n, params->m, params->k,
+                                         params->alpha, params->b, params->ldb, params->a, params->lda,
+                                         params->beta, params->c, params->ldc));
+
+  int64_t relu_input_length = params->m * params->n;
+  int64_t bias_length = (params->bias != nullptr) ? params->n : 0;
+
+  // In place like in GemmFastGeluUnfused, the Gemm rewrites c before every run of the Relu while this op is tuned
+  return onnxruntime::contrib::rocm::LaunchElementwiseKernel<functor::ReLU, T>(
+      params->tuning_ctx, params->Stream(),
+      params->c, static_cast<int>(relu_input_length),
+      params->bias, static_cast<int>(bias_length),
+      params->c);
+}
+
+template <typename T, BlasOp OpA, BlasOp OpB>
+class GemmReluTunableOp : public TunableOp<GemmReluParams<T>> {
+ public:
+  GemmReluTunableOp() {
+    this->RegisterOp(GemmReluUnfused<T>);
+
+#ifdef USE_HIPBLASLT
+    for (auto&& [_, op] : GetHipBlasLtGemmReluTypeStringAndOps<T, OpA, OpB>()) {
+      ORT_UNUSED_PARAMETER(_);
+      this->RegisterOp(std::move(op));
+    }
+#endif
+  }
+};
+
+}  // namespace internal
+}  // namespace blas
+}  // namespace rocm
+}  // namespace contrib
+}  // namespace onnxruntime
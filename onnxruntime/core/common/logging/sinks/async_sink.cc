@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/sinks/async_sink.h"
+
+#include <cstdint>
+
+namespace onnxruntime {
+namespace logging {
+
+namespace {
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 2;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+}  // namespace
+
+AsyncSink::AsyncSink(std::unique_ptr<ISink> sink, size_t capacity)
+    : sink_{std::move(sink)},
+      mask_{RoundUpToPowerOfTwo(capacity) - 1},
+      slots_{std::make_unique<Slot[]>(mask_ + 1)} {
+  ORT_ENFORCE(sink_ != nullptr, "AsyncSink requires a sink to send the messages to.");
+  for (size_t i = 0; i <= mask_; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  flusher_ = std::thread([this]() { Run(); });
+}
+
+AsyncSink::~AsyncSink() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_flusher_.notify_one();
+  flusher_.join();
+}
+
+void AsyncSink::Flush() {
+  const size_t target = enqueue_pos_.load(std::memory_order_acquire);
+  std::unique_lock<OrtMutex> lock(mutex_);
+  while (flushed_pos_ < target) {
+    flush_requested_ = true;
+    wake_flusher_.notify_one();
+    flushed_.wait(lock);
+  }
+}
+
+void AsyncSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  if (message.Severity() >= Severity::kFATAL) {
+    sink_->Send(timestamp, logger_id, message);
+    return;
+  }
+
+  if (TryPush(timestamp, logger_id, message)) {
+    if (message.Severity() >= Severity::kERROR) {
+      wake_flusher_.notify_one();
+    }
+    return;
+  }
+
+  if (message.Severity() >= Severity::kERROR) {
+    sink_->Send(timestamp, logger_id, message);
+  } else {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+// bounded multi producer queue, see https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+bool AsyncSink::TryPush(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  Slot* slot;
+  for (;;) {
+    slot = &slots_[pos & mask_];
+    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // the slot still holds the message of the previous lap, the buffer is full
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  auto& queued = slot->message;
+  queued.timestamp = timestamp;
+  queued.logger_id = logger_id;
+  queued.severity = message.Severity();
+  queued.category = message.Category();
+  queued.data_type = message.DataType();
+  queued.file_and_path = message.Location().file_and_path;
+  queued.line_num = message.Location().line_num;
+  queued.function = message.Location().function;
+  queued.stacktrace = message.Location().stacktrace;
+  queued.message = message.Message();
+
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool AsyncSink::TryPop(Message& message) {
+  auto& slot = slots_[dequeue_pos_ & mask_];
+  if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+    return false;
+  }
+
+  std::swap(message, slot.message);
+  slot.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+  ++dequeue_pos_;
+  return true;
+}
+
+void AsyncSink::SendMessage(const Message& message) {
+  const CodeLocation location{message.file_and_path.c_str(), message.line_num, message.function.c_str(),
+                              message.stacktrace};
+  Capture capture{message.severity, message.category.c_str(), message.data_type, location};
+  capture.Stream() << message.message;
+  sink_->Send(message.timestamp, message.logger_id, capture);
+}
+
+void AsyncSink::ReportDropped() {
+  const size_t dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped == reported_dropped_) {
+    return;
+  }
+
+  Capture capture{Severity::kWARNING, Category::onnxruntime, DataType::SYSTEM, ORT_WHERE};
+  capture.Stream() << "Dropped " << dropped - reported_dropped_ << " log messages as the log buffer was full.";
+  sink_->Send(std::chrono::system_clock::now(), "AsyncSink", capture);
+  reported_dropped_ = dropped;
+}
+
+void AsyncSink::Run() {
+  Message message;
+  for (;;) {
+    bool stop;
+    {
+      std::unique_lock<OrtMutex> lock(mutex_);
+      if (!flush_requested_ && !stop_) {
+        wake_flusher_.wait_for(lock, kFlushInterval);
+      }
+      flush_requested_ = false;
+      // read before draining, so the messages logged before the destructor are all sent
+      stop = stop_;
+    }
+
+    while (TryPop(message)) {
+      SendMessage(message);
+    }
+    ReportDropped();
+
+    {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      flushed_pos_ = dequeue_pos_;
+    }
+    flushed_.notify_all();
+
+    if (stop) {
+      break;
+    }
+  }
+}
+
+}  // namespace logging
+}  // namespace onnxruntime
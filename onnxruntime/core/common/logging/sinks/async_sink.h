@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/logging/capture.h"
+#include "core/common/logging/isink.h"
+#include "core/common/logging/logging.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace logging {
+/// <summary>
+/// ISink that queues the messages in a bounded lock free ring buffer and sends them to another sink from a background
+/// thread, so that logging threads don't wait on the I/O of the sink.
+/// </summary>
+/// <remarks>
+/// When the buffer is full, messages below ERROR severity are dropped and the number of dropped messages is reported
+/// by a WARNING message once there is room again. ERROR messages are then sent directly to the sink, and FATAL
+/// messages are always sent directly, so that they are written before the process terminates.
+/// </remarks>
+/// <seealso cref="ISink" />
+class AsyncSink : public ISink {
+ public:
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  /// <summary>
+  /// Initializes a new instance of the <see cref="AsyncSink"/> class.
+  /// </summary>
+  /// <param name="sink">The sink to send the messages to. It must be safe to call from multiple threads.</param>
+  /// <param name="capacity">The number of messages that can be queued. Rounded up to a power of 2.</param>
+  explicit AsyncSink(std::unique_ptr<ISink> sink, size_t capacity = kDefaultCapacity);
+
+  /// <summary>
+  /// Sends the remaining queued messages and stops the background thread.
+  /// </summary>
+  ~AsyncSink() override;
+
+  /// <summary>
+  /// Blocks until the messages queued before the call have been sent.
+  /// </summary>
+  void Flush();
+
+  /// <summary>
+  /// The number of messages dropped because the buffer was full.
+  /// </summary>
+  size_t DroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Message {
+    Timestamp timestamp;
+    std::string logger_id;
+    logging::Severity severity{Severity::kVERBOSE};
+    std::string category;
+    logging::DataType data_type{DataType::SYSTEM};
+    std::string file_and_path;
+    int line_num{0};
+    std::string function;
+    std::vector<std::string> stacktrace;
+    std::string message;
+  };
+
+  struct Slot {
+    // the slot is free for the producer claiming position 'sequence', and holds the message of position
+    // 'sequence - 1' once it is published
+    std::atomic<size_t> sequence;
+    Message message;
+  };
+
+  void SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) override;
+
+  bool TryPush(const Timestamp& timestamp, const std::string& logger_id, const Capture& message);
+  bool TryPop(Message& message);
+  void SendMessage(const Message& message);
+  void ReportDropped();
+  void Run();
+
+  static constexpr std::chrono::milliseconds kFlushInterval{10};
+
+  std::unique_ptr<ISink> sink_;
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // position claimed by the next producer
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  std::atomic<size_t> dropped_{0};
+  // position of the next message to send, only used by the background thread
+  alignas(64) size_t dequeue_pos_{0};
+  size_t reported_dropped_{0};
+
+  OrtMutex mutex_;
+  OrtCondVar wake_flusher_;
+  OrtCondVar flushed_;
+  size_t flushed_pos_{0};  // guarded by mutex_
+  bool flush_requested_{false};
+  bool stop_{false};
+
+  std::thread flusher_;
+};
+}  // namespace logging
+}  // namespace onnxruntime
@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/node_latency_stats.h"
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+
+int MostSignificantBit(uint64_t value) noexcept {
+  int msb = 0;
+  for (int shift = 32; shift > 0; shift >>= 1) {
+    if (value >> shift) {
+      value >>= shift;
+      msb += shift;
+    }
+  }
+  return msb;
+}
+
+}  // namespace
+
+size_t LatencyHistogram::BucketIndex(uint64_t latency_ns) noexcept {
+  constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+  if (latency_ns < kSubBuckets) {
+    return static_cast<size_t>(latency_ns);
+  }
+  // the leading bit selects the power of two, the next kSubBucketBits bits the bucket within it
+  const int msb = MostSignificantBit(latency_ns);
+  const uint64_t sub_bucket = (latency_ns >> (msb - kSubBucketBits)) & (kSubBuckets - 1);
+  return (static_cast<size_t>(msb - kSubBucketBits + 1) << kSubBucketBits) | static_cast<size_t>(sub_bucket);
+}
+
+std::pair<uint64_t, uint64_t> LatencyHistogram::BucketRange(size_t index) noexcept {
+  constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+  if (index < kSubBuckets) {
+    return {index, index + 1};
+  }
+  const int shift = static_cast<int>(index >> kSubBucketBits) - 1;
+  const uint64_t lower = (kSubBuckets + (index & (kSubBuckets - 1))) << shift;
+  const uint64_t width = uint64_t{1} << shift;
+  // the upper bound of the last bucket does not fit
+  return {lower, lower + width > lower ? lower + width : std::numeric_limits<uint64_t>::max()};
+}
+
+void LatencyHistogram::Record(uint64_t latency_ns) noexcept {
+  buckets_[BucketIndex(latency_ns)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+
+  uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+  while (latency_ns > max_ns &&
+         !max_ns_.compare_exchange_weak(max_ns, latency_ns, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t LatencyHistogram::PercentileNs(double percentile) const noexcept {
+  // the bucket counts are read one by one while other threads may record, so their sum is used as the total
+  std::array<uint64_t, kNumBuckets> counts;
+  uint64_t total = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  const double rank = percentile / 100.0 * static_cast<double>(total);
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    cumulative += counts[i];
+    if (counts[i] != 0 && static_cast<double>(cumulative) >= rank) {
+      const auto range = BucketRange(i);
+      return range.first + (range.second - range.first) / 2;
+    }
+  }
+  return MaxNs();
+}
+
+LatencyHistogram* NodeLatencyStats::GetHistogram(const std::string& op_type, const std::string& provider) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& histogram = histograms_[{op_type, provider}];
+  if (!histogram) {
+    histogram = std::make_unique<LatencyHistogram>();
+  }
+  return histogram.get();
+}
+
+std::vector<NodeLatencySummary> NodeLatencyStats::Summarize() const {
+  std::vector<NodeLatencySummary> summaries;
+  std::lock_guard<OrtMutex> lock(mutex_);
+  summaries.reserve(histograms_.size());
+  for (const auto& [key, histogram] : histograms_) {
+    if (histogram->Count() == 0) {
+      continue;
+    }
+    summaries.push_back({key.first, key.second, histogram->Count(), histogram->TotalNs(), histogram->MaxNs(),
+                         histogram->PercentileNs(50), histogram->PercentileNs(90), histogram->PercentileNs(99)});
+  }
+  return summaries;
+}
+
+std::string NodeLatencyStats::ToJson() const {
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(3) << "[";
+  bool first = true;
+  for (const auto& summary : Summarize()) {
+    if (!first) {
+      ss << ",";
+    }
+    first = false;
+    ss << "{\"op_type\":\"" << summary.op_type << "\","
+       << "\"provider\":\"" << summary.provider << "\","
+       << "\"count\":" << summary.count << ","
+       << "\"mean_us\":" << summary.total_ns / 1000.0 / summary.count << ","
+       << "\"p50_us\":" << summary.p50_ns / 1000.0 << ","
+       << "\"p90_us\":" << summary.p90_ns / 1000.0 << ","
+       << "\"p99_us\":" << summary.p99_ns / 1000.0 << ","
+       << "\"max_us\":" << summary.max_ns / 1000.0 << "}";
+  }
+  ss << "]";
+  return ss.str();
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
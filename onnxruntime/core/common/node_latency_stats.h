@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+/**
+ * Histogram of latencies in nanoseconds that can be recorded into concurrently without locking.
+ * The buckets are log scaled with 8 buckets per power of two, so a percentile is accurate to about 6%.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 3;
+  static constexpr size_t kNumBuckets = (64 - kSubBucketBits + 1) << kSubBucketBits;
+
+  LatencyHistogram() = default;
+
+  void Record(uint64_t latency_ns) noexcept;
+
+  uint64_t Count() const noexcept { return count_.load(std::memory_order_relaxed); }
+  uint64_t TotalNs() const noexcept { return total_ns_.load(std::memory_order_relaxed); }
+  uint64_t MaxNs() const noexcept { return max_ns_.load(std::memory_order_relaxed); }
+
+  // Returns the midpoint of the bucket holding the given percentile (0-100) of the recorded latencies,
+  // or 0 if nothing was recorded.
+  uint64_t PercentileNs(double percentile) const noexcept;
+
+  static size_t BucketIndex(uint64_t latency_ns) noexcept;
+  // [lower, upper) range of the latencies in the bucket
+  static std::pair<uint64_t, uint64_t> BucketRange(size_t index) noexcept;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LatencyHistogram);
+
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> total_ns_{0};
+  std::atomic<uint64_t> max_ns_{0};
+};
+
+struct NodeLatencySummary {
+  std::string op_type;
+  std::string provider;
+  uint64_t count;
+  uint64_t total_ns;
+  uint64_t max_ns;
+  uint64_t p50_ns;
+  uint64_t p90_ns;
+  uint64_t p99_ns;
+};
+
+/**
+ * Always-on alternative to the event profiler: the kernel latencies of sampled runs are recorded into one
+ * histogram per (op type, execution provider), which can be read at any time.
+ * The histograms are created when the kernels are created, so recording a latency takes no lock and allocates
+ * nothing.
+ */
+class NodeLatencyStats {
+ public:
+  NodeLatencyStats() = default;
+
+  // Records 1 in `sampling_interval` graph executions. 0 disables the stats.
+  void Enable(uint64_t sampling_interval) noexcept { sampling_interval_ = sampling_interval; }
+
+  bool IsEnabled() const noexcept { return sampling_interval_ != 0; }
+
+  // Whether the kernels of the graph execution starting now should be timed. Subgraph executions are counted too.
+  bool SampleExecution() noexcept {
+    return IsEnabled() &&
+           executions_.fetch_add(1, std::memory_order_relaxed) % sampling_interval_ == 0;
+  }
+
+  // Returns the histogram shared by all the nodes with the given op type and provider. The pointer stays valid for
+  // the lifetime of this instance.
+  LatencyHistogram* GetHistogram(const std::string& op_type, const std::string& provider);
+
+  std::vector<NodeLatencySummary> Summarize() const;
+
+  // Summary as a JSON array with one object per (op type, provider), latencies in microseconds.
+  std::string ToJson() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NodeLatencyStats);
+
+  uint64_t sampling_interval_{0};
+  std::atomic<uint64_t> executions_{0};
+
+  mutable OrtMutex mutex_;
+  std::map<std::pair<std::string, std::string>, std::unique_ptr<LatencyHistogram>> histograms_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -3,6 +3,13 @@
 
 #include "profiler.h"
 
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
+
+#include "core/common/parse_string.h"
+
 namespace onnxruntime {
 namespace profiling {
 using namespace std::chrono;
@@ -81,27 +88,61 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
 
   EventRecord event(category, logging::GetProcessId(),
                     logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+  // TODO: sync_gpu if needed.
+  AddEvent(std::move(event), events_);
+
+  for (const auto& ep_profiler : ep_profilers_) {
+    ep_profiler->Stop(ts);
+  }
+}
+
+void Profiler::RecordThreadPoolTasks(const std::string& parent_name, const TimePoint& parent_start_time,
+                                     const std::vector<concurrency::ThreadPoolTaskSpan>& task_spans) {
+  const std::string parent_ts = std::to_string(TimeDiffMicroSeconds(profiling_start_time_, parent_start_time));
+  for (const auto& task : task_spans) {
+    EventRecord event(THREAD_POOL_EVENT, logging::GetProcessId(), static_cast<int>(task.thread_id),
+                      "thread_pool_task", TimeDiffMicroSeconds(profiling_start_time_, task.start),
+                      TimeDiffMicroSeconds(task.start, task.end),
+                      {{"parent_name", parent_name}, {"parent_ts", parent_ts}});
+    AddEvent(std::move(event), thread_pool_events_);
+  }
+}
+
+void Profiler::AddEvent(EventRecord&& event, Events& events) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (events_.size() + thread_pool_events_.size() < max_num_events_) {
+    events.emplace_back(std::move(event));
   } else {
-    // TODO: sync_gpu if needed.
-    std::lock_guard<OrtMutex> lock(mutex_);
-    if (events_.size() < max_num_events_) {
-      events_.emplace_back(std::move(event));
-    } else {
-      if (session_logger_ && !max_events_reached) {
-        LOGS(*session_logger_, ERROR)
-            << "Maximum number of events reached, could not record profile event.";
-        max_events_reached = true;
-      }
+    if (session_logger_ && !max_events_reached) {
+      LOGS(*session_logger_, ERROR)
+          << "Maximum number of events reached, could not record profile event.";
+      max_events_reached = true;
     }
   }
+}
 
-  for (const auto& ep_profiler : ep_profilers_) {
-    ep_profiler->Stop(ts);
+namespace {
+
+void WriteEventArgs(std::ostream& stream, const std::unordered_map<std::string, std::string>& args) {
+  bool is_first_arg = true;
+  for (const auto& event_arg : args) {
+    if (!is_first_arg) stream << ",";
+    if (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '[')) {
+      stream << "\"" << event_arg.first << "\" : " << event_arg.second << "";
+    } else {
+      stream << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
+    }
+    is_first_arg = false;
   }
 }
 
+}  // namespace
+
 std::string Profiler::EndProfiling() {
   if (!enabled_) {
     return std::string();
@@ -116,12 +157,25 @@ std::string Profiler::EndProfiling() {
   }
 
   std::lock_guard<OrtMutex> lock(mutex_);
-  profile_stream_ << "[\n";
-
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->EndProfiling(profiling_start_time_, events_);
   }
 
+  if (trace_format_ == TraceFormat::kTimeline) {
+    WriteTimeline();
+  } else {
+    WriteEventList();
+  }
+#if !defined(__wasm__)
+  profile_stream_.close();
+#endif
+  enabled_ = false;  // will not collect profile after writing.
+  return profile_stream_file_;
+}
+
+void Profiler::WriteEventList() {
+  profile_stream_ << "[\n";
+
   for (size_t i = 0; i < events_.size(); ++i) {
     auto& rec = events_[i];
     profile_stream_ << R"({"cat" : ")" << event_category_names_[rec.cat] << "\",";
@@ -132,16 +186,7 @@ std::string Profiler::EndProfiling() {
     profile_stream_ << R"("ph" : "X",)";
     profile_stream_ << R"("name" :")" << rec.name << "\",";
     profile_stream_ << "\"args\" : {";
-    bool is_first_arg = true;
-    for (std::pair<std::string, std::string> event_arg : rec.args) {
-      if (!is_first_arg) profile_stream_ << ",";
-      if (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '[')) {
-        profile_stream_ << "\"" << event_arg.first << "\" : " << event_arg.second << "";
-      } else {
-        profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
-      }
-      is_first_arg = false;
-    }
+    WriteEventArgs(profile_stream_, rec.args);
     profile_stream_ << "}";
     if (i == events_.size() - 1) {
       profile_stream_ << "}\n";
@@ -150,11 +195,116 @@ std::string Profiler::EndProfiling() {
     }
   }
   profile_stream_ << "]\n";
-#if !defined(__wasm__)
-  profile_stream_.close();
-#endif
-  enabled_ = false;  // will not collect profile after writing.
-  return profile_stream_file_;
+}
+
+void Profiler::WriteTimeline() {
+  // The events of the EP profilers have no process or thread, they go to a separate device process with one
+  // track per stream.
+  constexpr int kDevicePid = 0;
+  const int host_pid = logging::GetProcessId();
+
+  struct NodeEvent {
+    size_t correlation_id;
+    int tid;
+    long long ts;
+  };
+  // (name, ts) -> node event, for the thread pool tasks which refer to the start of their node event
+  std::map<std::pair<std::string, long long>, NodeEvent> node_events;
+  // name -> last node event with the name, the EP profilers put the events of the kernels launched by a node
+  // right after the node event
+  std::unordered_map<std::string, NodeEvent> last_node_events;
+  std::set<int> device_tids;
+  std::set<int> thread_pool_tids;
+  size_t next_correlation_id = 1;
+  size_t next_flow_id = 1;
+
+  profile_stream_ << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  profile_stream_ << R"({"name":"process_name","ph":"M","pid":)" << host_pid
+                  << R"(,"args":{"name":"onnxruntime"}})";
+
+  auto write_event = [&](const EventRecord& rec) {
+    int pid = rec.pid;
+    int tid = rec.tid;
+    if (rec.pid < 0) {
+      pid = kDevicePid;
+      auto stream = rec.args.find("stream");
+      if (stream == rec.args.end() || !TryParseStringWithClassicLocale(stream->second, tid)) {
+        tid = 0;
+      }
+      device_tids.insert(tid);
+    } else if (rec.cat == THREAD_POOL_EVENT) {
+      thread_pool_tids.insert(tid);
+    }
+
+    std::optional<NodeEvent> parent;
+    std::optional<size_t> correlation_id;
+    if (rec.cat == NODE_EVENT) {
+      NodeEvent node_event{next_correlation_id++, tid, rec.ts};
+      node_events[{rec.name, rec.ts}] = node_event;
+      last_node_events[rec.name] = node_event;
+      correlation_id = node_event.correlation_id;
+    } else if (auto parent_name = rec.args.find("parent_name"); parent_name != rec.args.end()) {
+      long long parent_ts = 0;
+      auto parent_ts_arg = rec.args.find("parent_ts");
+      if (parent_ts_arg == rec.args.end()) {
+        if (auto it = last_node_events.find(parent_name->second); it != last_node_events.end()) {
+          parent = it->second;
+        }
+      } else if (TryParseStringWithClassicLocale(parent_ts_arg->second, parent_ts)) {
+        if (auto it = node_events.find({parent_name->second, parent_ts}); it != node_events.end()) {
+          parent = it->second;
+        }
+      }
+      if (parent) {
+        correlation_id = parent->correlation_id;
+      }
+    }
+
+    profile_stream_ << ",\n"
+                    << R"({"cat":")" << event_category_names_[rec.cat] << R"(","ph":"X","pid":)" << pid
+                    << R"(,"tid":)" << tid << R"(,"ts":)" << rec.ts << R"(,"dur":)" << rec.dur
+                    << R"(,"name":")" << rec.name << R"(","args":{)";
+    WriteEventArgs(profile_stream_, rec.args);
+    if (correlation_id) {
+      profile_stream_ << (rec.args.empty() ? "" : ",") << R"("correlation_id" : )" << *correlation_id;
+    }
+    profile_stream_ << "}}";
+
+    if (parent) {
+      // a flow from the node event to this event
+      const char* flow_name = rec.cat == THREAD_POOL_EVENT ? "schedule" : "launch";
+      const size_t flow_id = next_flow_id++;
+      profile_stream_ << ",\n"
+                      << R"({"cat":"flow","ph":"s","name":")" << flow_name << R"(","id":)" << flow_id
+                      << R"(,"pid":)" << host_pid << R"(,"tid":)" << parent->tid << R"(,"ts":)" << parent->ts
+                      << "},\n"
+                      << R"({"cat":"flow","ph":"f","bp":"e","name":")" << flow_name << R"(","id":)" << flow_id
+                      << R"(,"pid":)" << pid << R"(,"tid":)" << tid << R"(,"ts":)" << rec.ts << "}";
+    }
+  };
+
+  for (const auto& rec : events_) {
+    write_event(rec);
+  }
+  for (const auto& rec : thread_pool_events_) {
+    write_event(rec);
+  }
+
+  if (!device_tids.empty()) {
+    profile_stream_ << ",\n"
+                    << R"({"name":"process_name","ph":"M","pid":)" << kDevicePid << R"(,"args":{"name":"device"}})";
+  }
+  for (int tid : device_tids) {
+    profile_stream_ << ",\n"
+                    << R"({"name":"thread_name","ph":"M","pid":)" << kDevicePid << R"(,"tid":)" << tid
+                    << R"(,"args":{"name":"stream )" << tid << R"("}})";
+  }
+  for (int tid : thread_pool_tids) {
+    profile_stream_ << ",\n"
+                    << R"({"name":"thread_name","ph":"M","pid":)" << host_pid << R"(,"tid":)" << tid
+                    << R"(,"args":{"name":"thread pool worker"}})";
+  }
+  profile_stream_ << "\n]}\n";
 }
 
 }  // namespace profiling
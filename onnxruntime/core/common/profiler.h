@@ -9,9 +9,11 @@
 #include <iostream>
 #include <tuple>
 
+#include "core/common/node_latency_stats.h"
 #include "core/common/profiler_common.h"
 #include "core/common/logging/logging.h"
 #include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -21,6 +23,12 @@ namespace profiling {
 // note that static profiler instance only works with single session
 // #define ENABLE_STATIC_PROFILER_INSTANCE
 
+// see kOrtSessionOptionsProfilingTraceFormat
+enum class TraceFormat {
+  kEventList,
+  kTimeline,
+};
+
 /**
  * Main class for profiling. It continues to accumulate events and produce
  * a corresponding "complete event (X)" in "chrome tracing" format.
@@ -80,6 +88,24 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Record the tasks that the thread pool ran for the node event named parent_name, which started at
+  parent_start_time. Only used with TraceFormat::kTimeline.
+  */
+  void RecordThreadPoolTasks(const std::string& parent_name, const TimePoint& parent_start_time,
+                             const std::vector<concurrency::ThreadPoolTaskSpan>& task_spans);
+
+  /*
+  Set the format of the profile file. Must be called before profiling starts.
+  */
+  void SetTraceFormat(TraceFormat trace_format) {
+    trace_format_ = trace_format;
+  }
+
+  TraceFormat GetTraceFormat() const {
+    return trace_format_;
+  }
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -110,6 +136,17 @@ class Profiler {
     global_max_num_events_.store(new_max_num_events);
   }
 
+  /*
+  Per (op type, execution provider) kernel latency histograms of sampled runs. Independent of IsEnabled().
+  */
+  NodeLatencyStats& GetNodeLatencyStats() noexcept {
+    return node_latency_stats_;
+  }
+
+  const NodeLatencyStats& GetNodeLatencyStats() const noexcept {
+    return node_latency_stats_;
+  }
+
   void AddEpProfilers(std::unique_ptr<EpProfiler> ep_profiler) {
     if (ep_profiler) {
       ep_profilers_.push_back(std::move(ep_profiler));
@@ -129,6 +166,10 @@ class Profiler {
    */
   static std::atomic<size_t> global_max_num_events_;
 
+  void AddEvent(EventRecord&& event, Events& events);
+  void WriteEventList();
+  void WriteTimeline();
+
   // Mutex controlling access to profiler data
   OrtMutex mutex_;
   bool enabled_{false};
@@ -147,6 +188,9 @@ class Profiler {
   const logging::Logger* custom_logger_{nullptr};
   TimePoint profiling_start_time_;
   Events events_;
+  // kept apart from events_, which the EP profilers merge their events into
+  Events thread_pool_events_;
+  TraceFormat trace_format_{TraceFormat::kEventList};
   bool max_events_reached{false};
   bool profile_with_logger_{false};
   const size_t max_num_events_{global_max_num_events_.load()};
@@ -156,6 +200,8 @@ class Profiler {
 #endif
 
   std::vector<std::unique_ptr<EpProfiler>> ep_profilers_;
+
+  NodeLatencyStats node_latency_stats_;
 };
 
 }  // namespace profiling
@@ -13,13 +13,20 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <optional>
+#include <sstream>
+#include <unordered_map>
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
+#include "core/common/hash_combine.h"
 #include "core/common/cpuid_info.h"
 #include "core/common/eigen_common_wrapper.h"
+#include "core/common/logging/logging.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
 #if !defined(ORT_MINIMAL_BUILD)
@@ -63,8 +70,9 @@ ThreadPoolProfiler::~ThreadPoolProfiler() {
   enabled_ = false;
 }
 
-void ThreadPoolProfiler::Start() {
+void ThreadPoolProfiler::Start(bool record_task_spans) {
   enabled_ = true;
+  record_task_spans_ = record_task_spans;
 }
 
 ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
@@ -75,8 +83,15 @@ ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
   return *stat;
 }
 
-std::string ThreadPoolProfiler::Stop() {
+std::string ThreadPoolProfiler::Stop(std::vector<ThreadPoolTaskSpan>* task_spans) {
   ORT_ENFORCE(enabled_, "Profiler not started yet");
+  if (record_task_spans_.exchange(false)) {
+    std::lock_guard<OrtMutex> lock(task_spans_mutex_);
+    if (task_spans) {
+      task_spans->swap(task_spans_);
+    }
+    task_spans_.clear();
+  }
   std::ostringstream ss;
   ss << "{\"main_thread\": {"
      << "\"thread_pool_name\": \""
@@ -202,10 +217,25 @@ void ThreadPoolProfiler::LogThreadId(int thread_idx) {
   child_thread_stats_[thread_idx].thread_id_ = std::this_thread::get_id();
 }
 
+void ThreadPoolProfiler::LogTaskStart(int thread_idx) {
+  if (record_task_spans_) {
+    child_thread_stats_[thread_idx].task_start_ = Clock::now();
+  }
+}
+
 void ThreadPoolProfiler::LogRun(int thread_idx) {
   if (enabled_) {
     child_thread_stats_[thread_idx].num_run_++;
     auto now = Clock::now();
+    // skip the tasks that started before the recording did
+    auto& task_start = child_thread_stats_[thread_idx].task_start_;
+    if (task_start != onnxruntime::TimePoint{}) {
+      if (record_task_spans_) {
+        std::lock_guard<OrtMutex> lock(task_spans_mutex_);
+        task_spans_.push_back({logging::GetThreadId(), task_start, now});
+      }
+      task_start = {};
+    }
     if (child_thread_stats_[thread_idx].core_ < 0 ||
         TimeDiffMicroSeconds(child_thread_stats_[thread_idx].last_logged_point_, now) > 10000) {
 #ifdef _WIN32
@@ -369,6 +399,128 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
 #pragma warning(pop) /* Padding added in LoopCounterShard, LoopCounter */
 #endif
 
+// Refines the TensorOpCost estimates of ParallelFor call sites with measured execution times.  Kernels often pass
+// rough constants, which makes the pool split tiny loops (losing more to synchronization than it gains) and run
+// expensive ones on too few threads.  A call site is identified by the cost estimate it passes together with the
+// type of its loop body when RTTI is available.  Only a few calls per site are timed, the others reuse a smoothed
+// average of the measured time per unit of work.
+class AdaptiveCostModel {
+ public:
+  static size_t SiteKey(const TensorOpCost& cost, const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+    size_t key = 0;
+    HashCombine(cost.bytes_loaded, key);
+    HashCombine(cost.bytes_stored, key);
+    HashCombine(cost.compute_cycles, key);
+#ifndef ORT_NO_RTTI
+    HashCombineWithHashValue(fn.target_type().hash_code(), key);
+#else
+    ORT_UNUSED_PARAMETER(fn);
+#endif
+    return key;
+  }
+
+  // Replaces `cost` with the measured one once the site has been sampled enough.
+  // Returns true if the caller should time this call and report it with Record().
+  bool Adjust(size_t key, const TensorOpCost& declared, Eigen::TensorOpCost& cost) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = sites_.find(key);
+    if (it == sites_.end()) {
+      if (sites_.size() >= kMaxSites) {
+        return false;
+      }
+      it = sites_.emplace(key, SiteStat{declared}).first;
+    }
+
+    auto& site = it->second;
+    ++site.num_calls;
+    if (site.num_samples >= kMinSamples) {
+      cost = Eigen::TensorOpCost(0, 0, site.ns_per_unit * kCyclesPerNanosecond);
+    }
+    return site.num_samples < kMinSamples || site.num_calls % kSampleInterval == 0;
+  }
+
+  void Record(size_t key, double ns_per_unit) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = sites_.find(key);
+    if (it == sites_.end()) {
+      return;
+    }
+
+    auto& site = it->second;
+    site.ns_per_unit = site.num_samples == 0 ? ns_per_unit
+                                             : site.ns_per_unit + kSmoothing * (ns_per_unit - site.ns_per_unit);
+    ++site.num_samples;
+  }
+
+  std::string Dump() const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    std::ostringstream ss;
+    ss << "\"adaptive_cost_model\": [";
+    bool first = true;
+    for (const auto& [key, site] : sites_) {
+      ss << (first ? "" : ", ")
+         << "{\"site\": " << key << ", "
+         << "\"declared_bytes_loaded\": " << site.declared.bytes_loaded << ", "
+         << "\"declared_bytes_stored\": " << site.declared.bytes_stored << ", "
+         << "\"declared_compute_cycles\": " << site.declared.compute_cycles << ", "
+         << "\"measured_ns_per_unit\": " << site.ns_per_unit << ", "
+         << "\"num_calls\": " << site.num_calls << ", "
+         << "\"num_samples\": " << site.num_samples << "}";
+      first = false;
+    }
+    ss << "]";
+    return ss.str();
+  }
+
+ private:
+  struct SiteStat {
+    TensorOpCost declared;
+    double ns_per_unit{0};
+    uint64_t num_calls{0};
+    uint64_t num_samples{0};
+  };
+
+  // The Eigen cost model works in cycles, measured time is converted with a nominal clock rate.
+  static constexpr double kCyclesPerNanosecond = 3.0;
+  // The first call of a site usually runs with cold caches, do not trust a single sample.
+  static constexpr uint64_t kMinSamples = 2;
+  static constexpr uint64_t kSampleInterval = 16;
+  static constexpr double kSmoothing = 0.25;
+  // Sites whose cost depends on the shapes get one entry per shape, bound the memory used for them.
+  static constexpr size_t kMaxSites = 4096;
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<size_t, SiteStat> sites_;
+};
+
+namespace {
+// Budget applied to the parallel loops started by the current thread, see ThreadPool::ScopedLoopBudget.
+struct LoopBudget {
+  int max_degree_of_parallelism{0};
+  ThreadPool::LoopPriority priority{ThreadPool::LoopPriority::kNormal};
+};
+
+thread_local LoopBudget current_loop_budget;
+
+// Caps the number of threads (including the caller) a loop may use.
+int ApplyLoopBudget(int num_threads) {
+  const int max_dop = current_loop_budget.max_degree_of_parallelism;
+  return max_dop > 0 ? std::min(num_threads, max_dop) : num_threads;
+}
+}  // namespace
+
+ThreadPool::ScopedLoopBudget::ScopedLoopBudget(int max_degree_of_parallelism, LoopPriority priority)
+    : prev_max_degree_of_parallelism_(current_loop_budget.max_degree_of_parallelism),
+      prev_priority_(current_loop_budget.priority) {
+  current_loop_budget.max_degree_of_parallelism = max_degree_of_parallelism;
+  current_loop_budget.priority = priority;
+}
+
+ThreadPool::ScopedLoopBudget::~ScopedLoopBudget() {
+  current_loop_budget.max_degree_of_parallelism = prev_max_degree_of_parallelism_;
+  current_loop_budget.priority = prev_priority_;
+}
+
 ThreadPool::ThreadPool(Env* env,
                        const ThreadOptions& thread_options,
                        const NAME_CHAR_TYPE* name,
@@ -396,6 +548,10 @@ ThreadPool::ThreadPool(Env* env,
                                                 *env,
                                                 thread_options_);
     underlying_threadpool_ = extended_eigen_threadpool_.get();
+
+    if (thread_options_.adaptive_cost_model) {
+      adaptive_cost_model_ = std::make_unique<AdaptiveCostModel>();
+    }
   }
 }
 
@@ -420,7 +576,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     // Split the work across threads in the pool.  Each work item will run a loop claiming iterations,
     // hence we need at most one for each thread, even if the number of blocks of iterations is larger.
     auto num_blocks = total / block_size;
-    auto num_threads_inc_main = NumThreads() + 1;
+    auto num_threads_inc_main = ApplyLoopBudget(NumThreads() + 1);
     int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(num_threads_inc_main), num_blocks));
     assert(num_work_items > 0);
 
@@ -459,7 +615,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     };
     // Distribute task among all threads in the pool, reduce number of work items if
     // num_of_blocks is smaller than number of threads.
-    RunInParallel(run_work, std::min(NumThreads() + 1, num_of_blocks), base_block_size);
+    RunInParallel(run_work, std::min(ApplyLoopBudget(NumThreads() + 1), num_of_blocks), base_block_size);
   }
 }
 
@@ -479,15 +635,19 @@ void ThreadPool::Schedule(std::function<void()> fn) {
   }
 }
 
-void ThreadPool::StartProfiling() {
+void ThreadPool::StartProfiling(bool record_task_spans) {
   if (underlying_threadpool_) {
-    underlying_threadpool_->StartProfiling();
+    underlying_threadpool_->StartProfiling(record_task_spans);
   }
 }
 
-std::string ThreadPool::StopProfiling() {
+std::string ThreadPool::StopProfiling(std::vector<ThreadPoolTaskSpan>* task_spans) {
   if (underlying_threadpool_) {
-    return underlying_threadpool_->StopProfiling();
+    auto profile = underlying_threadpool_->StopProfiling(task_spans);
+    if (adaptive_cost_model_ && !profile.empty() && profile.back() == '}') {
+      profile.insert(profile.size() - 1, ", " + adaptive_cost_model_->Dump());
+    }
+    return profile;
   } else {
     return {};
   }
@@ -520,10 +680,10 @@ void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n,
     if (current_parallel_section.has_value()) {
       underlying_threadpool_->RunInParallelSection(*current_parallel_section,
                                                    std::move(fn),
-                                                   n, block_size);
+                                                   n, block_size, current_loop_budget.priority);
     } else {
       underlying_threadpool_->RunInParallel(std::move(fn),
-                                            n, block_size);
+                                            n, block_size, current_loop_budget.priority);
     }
   } else {
     fn(0);
@@ -546,6 +706,11 @@ bool ThreadPool::ShouldParallelizeLoop(const std::ptrdiff_t num_iterations,
     return false;
   }
 
+  // Do not parallelize loops if the budget of the calling thread does not allow for any helper.
+  if (ApplyLoopBudget(NumThreads() + 1) == 1) {
+    return false;
+  }
+
   return true;
 }
 
@@ -615,15 +780,37 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
   ORT_ENFORCE(n >= 0);
   Eigen::TensorOpCost cost{c.bytes_loaded, c.bytes_stored, c.compute_cycles};
   auto d_of_p = DegreeOfParallelism(this);
-  // Compute small problems directly in the caller thread.
-  if ((!ShouldParallelizeLoop(n)) ||
-      CostModel::numThreads(static_cast<double>(n), cost, d_of_p) == 1) {
-    f(0, n);
-    return;
+  auto run = [&](const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& fn) {
+    // Compute small problems directly in the caller thread.
+    if ((!ShouldParallelizeLoop(n)) ||
+        CostModel::numThreads(static_cast<double>(n), cost, d_of_p) == 1) {
+      fn(0, n);
+      return;
+    }
+
+    ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
+    ParallelForFixedBlockSizeScheduling(n, block, fn);
+  };
+
+  if (adaptive_cost_model_ && n > 0) {
+    const size_t site_key = AdaptiveCostModel::SiteKey(c, f);
+    if (adaptive_cost_model_->Adjust(site_key, c, cost)) {
+      // Sum the time spent in the loop body over all threads, so that the synchronization overhead of the
+      // current partitioning does not leak into the per unit cost.
+      std::atomic<int64_t> busy_ns{0};
+      run([&f, &busy_ns](std::ptrdiff_t first, std::ptrdiff_t last) {
+        const auto start = std::chrono::steady_clock::now();
+        f(first, last);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                          std::memory_order_relaxed);
+      });
+      adaptive_cost_model_->Record(site_key, static_cast<double>(busy_ns.load()) / static_cast<double>(n));
+      return;
+    }
   }
 
-  ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
-  ParallelForFixedBlockSizeScheduling(n, block, f);
+  run(f);
 }
 
 void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
@@ -640,24 +827,46 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   // tp, plus 1 for the thread entering a loop.
   if (tp) {
     if (tp->force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
-      return ((tp->NumThreads() + 1)) * TaskGranularityFactor;
+      return ApplyLoopBudget(tp->NumThreads() + 1) * TaskGranularityFactor;
     } else {
-      return ((tp->NumThreads() + 1));
+      return ApplyLoopBudget(tp->NumThreads() + 1);
     }
   } else {
     return 1;
   }
 }
 
-void ThreadPool::StartProfiling(concurrency::ThreadPool* tp) {
+std::string ThreadPoolStats::ToJson() const {
+  std::ostringstream ss;
+  ss << "{\"parallel_loops\":" << parallel_loops << ",\"loop_dispatch_us\":" << loop_dispatch_ns / 1000
+     << ",\"loop_wait_us\":" << loop_wait_ns / 1000 << ",\"workers\":[";
+  for (size_t i = 0; i < workers.size(); ++i) {
+    const auto& worker = workers[i];
+    ss << (i == 0 ? "" : ",") << "{\"tasks_run\":" << worker.tasks_run << ",\"tasks_stolen\":" << worker.tasks_stolen
+       << ",\"run_us\":" << worker.run_ns / 1000 << ",\"spin_us\":" << worker.spin_ns / 1000
+       << ",\"blocked_us\":" << worker.blocked_ns / 1000 << ",\"queue_depth\":" << worker.queue_depth << "}";
+  }
+  ss << "]}";
+  return ss.str();
+}
+
+ThreadPoolStats ThreadPool::GetStats(const concurrency::ThreadPool* tp) {
+  ThreadPoolStats stats;
+  if (tp && tp->underlying_threadpool_) {
+    tp->underlying_threadpool_->GetStats(stats);
+  }
+  return stats;
+}
+
+void ThreadPool::StartProfiling(concurrency::ThreadPool* tp, bool record_task_spans) {
   if (tp) {
-    tp->StartProfiling();
+    tp->StartProfiling(record_task_spans);
   }
 }
 
-std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
+std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp, std::vector<ThreadPoolTaskSpan>* task_spans) {
   if (tp) {
-    return tp->StopProfiling();
+    return tp->StopProfiling(task_spans);
   } else {
     return {};
   }
@@ -8,6 +8,7 @@
 #include <sstream>
 #include <ctime>
 #include <iomanip>
+#include <limits>
 #include "core/common/exceptions.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
@@ -602,6 +603,14 @@ class PlannerImpl {
     return ci.kernel_def->HasExternalOutputs();
   }
 
+  // The CPU SequenceInsert and SequenceConstruct kernels add an input tensor that owns its buffer to the output
+  // sequence without copying it, so the buffer of such a tensor must not be reused or updated in place after the
+  // node ran, as the sequence may still be alive.
+  static bool HoldsInputsInOutputSequence(const Node& node) {
+    return node.GetExecutionProviderType() == kCpuExecutionProvider && node.Domain() == kOnnxDomain &&
+           (node.OpType() == "SequenceInsert" || node.OpType() == "SequenceConstruct");
+  }
+
   Status ComputePlanForInputsAndWeights() {
     auto setup_preexisting = [this](const NodeArg* node_arg) {
       auto input_index = Index(node_arg->Name());
@@ -661,6 +670,10 @@ class PlannerImpl {
         };
 
         ORT_RETURN_IF_ERROR(Node::ForEachWithIndex(pnode->InputDefs(), process_input));
+        if (HoldsInputsInOutputSequence(*pnode)) {
+          // Models the reference held by the output sequence; ensures the inputs will not be reused.
+          ORT_RETURN_IF_ERROR(Node::ForEachWithIndex(pnode->InputDefs(), process_input));
+        }
 
         ORT_RETURN_IF_ERROR(Node::ForEachWithIndex(pnode->ImplicitInputDefs(), process_input));
 
@@ -1151,6 +1164,20 @@ class PlannerImpl {
 
         ORT_RETURN_IF_ERROR(Node::ForEachWithIndex(node->InputDefs(), process_input));
         ORT_RETURN_IF_ERROR(Node::ForEachWithIndex(node->ImplicitInputDefs(), process_input));
+
+        if (HoldsInputsInOutputSequence(*node)) {
+          // add a consumer that never completes for the inputs held by the output sequence,
+          // so their buffers are neither updated in place nor reused
+          for (const auto* input : node->InputDefs()) {
+            int value_idx;
+            if (input->Exists() && ort_value_name_idx_map_.GetIdx(input->Name(), value_idx).IsOK()) {
+              auto origin = AllocPlan(value_idx).reused_buffer;
+              if (AllocPlan(origin).alloc_kind == AllocKind::kAllocate) {
+                value_consumer_map[origin].insert(std::numeric_limits<NodeIndex>::max());
+              }
+            }
+          }
+        }
       }
     }
 
@@ -1854,7 +1881,8 @@ class PlannerImpl {
             break;
           }
         }
-        if (is_all_consumer_same_stream) {
+        // with a dynamic schedule the nodes of the stream don't run in order, so the last consumer isn't known
+        if (is_all_consumer_same_stream && plan_.dynamic_schedule.Empty()) {
           // all the consumers are on the same stream, so the first element is the last consumer int the stream.
           process_consumer(release_action_idx, ortvalue_to_consumers_map[i][0]);
         } else {
@@ -1865,9 +1893,87 @@ class PlannerImpl {
         }
       }
     }
+    // 3. flatten the release lists
+    plan_.node_release_offsets.clear();
+    plan_.node_release_offsets.reserve(plan_.node_release_list.size() + 1);
+    plan_.node_release_actions.clear();
+    plan_.node_release_offsets.push_back(0);
+    for (const auto& node_release_action : plan_.node_release_list) {
+      plan_.node_release_actions.insert(plan_.node_release_actions.end(), node_release_action.begin(),
+                                        node_release_action.end());
+      plan_.node_release_offsets.push_back(plan_.node_release_actions.size());
+    }
     return Status::OK();
   }
 
+  // Record the nodes of a plan whose single logic stream only launches kernels, so the executor can run them without
+  // dispatching through the execution steps.
+  void BuildKernelLaunchNodes() {
+    const auto& execution_plan = plan_.execution_plan;
+    if (execution_plan.size() != 1 || !execution_plan[0]) {
+      return;
+    }
+
+    const auto& steps = execution_plan[0]->steps_;
+    if (steps.empty() || steps.size() != stream_nodes_[0].size()) {
+      // the stream has steps other than kernel launches
+      return;
+    }
+
+    plan_.kernel_launch_nodes.reserve(steps.size());
+    for (const auto& step : steps) {
+      plan_.kernel_launch_nodes.push_back(step->GetNodeIndex());
+    }
+  }
+
+  // Record the dependencies between the nodes of a plan that has a single CPU logic stream, so the executor can run
+  // each node as soon as its producers complete. Only done in parallel execution mode, where the reuse plan doesn't
+  // depend on the order of the nodes within the stream.
+  void BuildDynamicSchedule() {
+    auto& execution_plan = plan_.execution_plan;
+    if (!context_->IsDynamicSchedulingEnabled() || execution_plan.size() != 1 || !execution_plan[0] ||
+        execution_plan[0]->device_.Type() != OrtDevice::CPU) {
+      return;
+    }
+
+    const auto& steps = execution_plan[0]->steps_;
+    if (steps.size() < 2 || steps.size() != stream_nodes_[0].size()) {
+      // nothing to parallelize, or the stream has steps other than kernel launches
+      return;
+    }
+
+    InlinedHashMap<NodeIndex, size_t> node_to_step;
+    node_to_step.reserve(steps.size());
+    for (size_t i = 0; i < steps.size(); ++i) {
+      node_to_step[steps[i]->GetNodeIndex()] = i;
+    }
+
+    auto& schedule = plan_.dynamic_schedule;
+    schedule.num_producers.assign(steps.size(), 0);
+    schedule.consumers.resize(steps.size());
+    for (size_t i = 0; i < steps.size(); ++i) {
+      const auto* node = graph_viewer_.GetNode(steps[i]->GetNodeIndex());
+      // output edges include control edges and edges to nodes consuming the outputs as implicit inputs
+      for (auto it = node->OutputNodesBegin(), end = node->OutputNodesEnd(); it != end; ++it) {
+        auto consumer_it = node_to_step.find(it->Index());
+        if (consumer_it == node_to_step.end()) {
+          continue;
+        }
+        auto& consumers = schedule.consumers[i];
+        if (std::find(consumers.begin(), consumers.end(), consumer_it->second) == consumers.end()) {
+          consumers.push_back(consumer_it->second);
+          ++schedule.num_producers[consumer_it->second];
+        }
+      }
+    }
+
+    for (size_t i = 0; i < steps.size(); ++i) {
+      if (schedule.num_producers[i] == 0) {
+        schedule.roots.push_back(i);
+      }
+    }
+  }
+
 #ifndef ORT_ENABLE_STREAM
   void PartitionIntoStreams(const logging::Logger& /*logger*/,
                             const ExecutionProviders& /*execution_providers*/,
@@ -2303,6 +2409,9 @@ Status PlannerImpl::CreatePlan(
   ORT_RETURN_IF_ERROR(BuildExecutionPlan(execution_providers_));
 #endif
 
+  BuildDynamicSchedule();
+  BuildKernelLaunchNodes();
+
   // determine sharing/reuse among ml-values
   ORT_RETURN_IF_ERROR(ComputeReusePlan());
 
@@ -43,6 +43,10 @@ class ISequentialPlannerContext {
   // see PlannerImpl::ComputeReusePlan
   virtual bool IsParallelExecutionEnabled() const { return false; }
 
+  // If it returns true, the planner records node dependencies so that a single-stream plan can be dispatched
+  // dynamically on the inter-op thread pool. See PlannerImpl::BuildDynamicSchedule
+  virtual bool IsDynamicSchedulingEnabled() const { return false; }
+
   virtual ExecutionOrder GetExecutionOrder() const { return ExecutionOrder::DEFAULT; }
 
   virtual bool GetEnableMemoryReuse() const { return true; }
@@ -51,10 +55,12 @@ class ISequentialPlannerContext {
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse)
+  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse,
+                           bool enable_dynamic_scheduling = false)
       : execution_mode_(execution_mode),
         execution_order_(execution_order),
-        enable_memory_reuse_(enable_memory_reuse) {
+        enable_memory_reuse_(enable_memory_reuse),
+        enable_dynamic_scheduling_(enable_dynamic_scheduling) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
@@ -67,10 +73,15 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
 
   bool GetEnableMemoryReuse() const override { return enable_memory_reuse_; }
 
+  bool IsDynamicSchedulingEnabled() const override {
+    return enable_dynamic_scheduling_ && execution_mode_ == ExecutionMode::ORT_PARALLEL;
+  }
+
  private:
   ExecutionMode execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
   ExecutionOrder execution_order_ = ExecutionOrder::DEFAULT;
   bool enable_memory_reuse_ = true;
+  bool enable_dynamic_scheduling_ = false;
 };
 
 #ifdef ORT_ENABLE_STREAM
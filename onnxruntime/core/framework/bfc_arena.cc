@@ -3,6 +3,7 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
 #include <type_traits>
 
 namespace onnxruntime {
@@ -12,7 +13,8 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   int64_t small_block_cache_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -31,6 +33,7 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
+                     << " small_block_cache_bytes: " << small_block_cache_bytes
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
@@ -75,6 +78,33 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       ORT_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+
+  if (small_block_cache_bytes > 0) {
+    const size_t pool_bytes = ((static_cast<size_t>(small_block_cache_bytes) + SmallBlockCache::kPageSize - 1) /
+                               SmallBlockCache::kPageSize) *
+                              SmallBlockCache::kPageSize;
+    void* pool = nullptr;
+    if (pool_bytes <= memory_limit_) {
+      ORT_TRY {
+        pool = device_allocator_->Alloc(pool_bytes);
+      }
+      ORT_CATCH(const std::bad_alloc&) {
+        // fall back to the regular arena path below
+      }
+    }
+
+    if (pool != nullptr && reinterpret_cast<std::uintptr_t>(pool) % SmallBlockCache::kMinBlockSize == 0) {
+      small_block_cache_pool_ = pool;
+      small_block_cache_ = std::make_unique<SmallBlockCache>(pool, pool_bytes);
+      stats_.total_allocated_bytes += static_cast<int64_t>(pool_bytes);
+    } else {
+      if (pool != nullptr) {
+        device_allocator_->Free(pool);
+      }
+      LOGS_DEFAULT(WARNING) << "Unable to create a small block cache of " << pool_bytes << " bytes for "
+                            << device_allocator_->Info().name << ". Small allocations will use the arena.";
+    }
+  }
 }
 
 BFCArena::~BFCArena() {
@@ -86,6 +116,11 @@ BFCArena::~BFCArena() {
     device_allocator_->Free(reserve_chunk.first);
   }
 
+  small_block_cache_.reset();
+  if (small_block_cache_pool_ != nullptr) {
+    device_allocator_->Free(small_block_cache_pool_);
+  }
+
   for (BinNum b = 0; b < kNumBins; b++) {
     BinFromIndex(b)->~Bin();
   }
@@ -269,6 +304,14 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (small_block_cache_ && SmallBlockCache::Handles(size)) {
+    // lock-free fast path. falls through to the arena if the cache pool is exhausted for this size.
+    void* p = small_block_cache_->Alloc(size);
+    if (p != nullptr) {
+      return p;
+    }
+  }
+
   return AllocateRawInternal(size, false, nullptr, false, nullptr);
 }
 
@@ -293,6 +336,11 @@ void* BFCArena::Reserve(size_t size) {
 }
 
 size_t BFCArena::RequestedSize(const void* ptr) {
+  if (small_block_cache_ && small_block_cache_->Owns(ptr)) {
+    // the cache does not track the requested size
+    return small_block_cache_->BlockSize(ptr);
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -301,6 +349,10 @@ size_t BFCArena::RequestedSize(const void* ptr) {
 }
 
 size_t BFCArena::AllocatedSize(const void* ptr) {
+  if (small_block_cache_ && small_block_cache_->Owns(ptr)) {
+    return small_block_cache_->BlockSize(ptr);
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -379,6 +431,14 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+
+  if (small_block_cache_) {
+    // the cache pool is already counted in total_allocated_bytes.
+    // max_bytes_in_use is an upper bound as the two peaks may not have happened at the same time.
+    stats->num_allocs += small_block_cache_->NumAllocs();
+    stats->bytes_in_use += small_block_cache_->BytesInUse();
+    stats->max_bytes_in_use += small_block_cache_->MaxBytesInUse();
+  }
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -496,6 +556,12 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  if (small_block_cache_ && small_block_cache_->Owns(p)) {
+    small_block_cache_->Free(p);
+    return;
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -509,22 +575,44 @@ void BFCArena::Free(void* p) {
 }
 
 Status BFCArena::Shrink() {
+  return ShrinkToWatermark(0);
+}
+
+Status BFCArena::ShrinkToWatermark(size_t high_watermark_bytes) {
   std::lock_guard<OrtMutex> lock(lock_);
   auto num_regions = region_manager_.regions().size();
-  std::vector<void*> region_ptrs;
-  std::vector<size_t> region_sizes;
-  region_ptrs.reserve(num_regions);
-  region_sizes.reserve(num_regions);
+  std::vector<const AllocationRegion*> candidate_regions;
+  candidate_regions.reserve(num_regions);
 
   for (const auto& region : region_manager_.regions()) {
     if (consider_first_allocation_region_for_shrinkage_ || region.id() != 0) {
-      region_ptrs.push_back(region.ptr());
-      region_sizes.push_back(region.memory_size());
+      candidate_regions.push_back(&region);
     }
   }
 
+  // Release the most recently added regions first. With kNextPowerOfTwo these are also the largest ones.
+  std::sort(candidate_regions.begin(), candidate_regions.end(),
+            [](const AllocationRegion* a, const AllocationRegion* b) { return a->id() > b->id(); });
+
+  std::vector<void*> region_ptrs;
+  std::vector<size_t> region_sizes;
+  region_ptrs.reserve(candidate_regions.size());
+  region_sizes.reserve(candidate_regions.size());
+  for (const AllocationRegion* region : candidate_regions) {
+    region_ptrs.push_back(region->ptr());
+    region_sizes.push_back(region->memory_size());
+  }
+
+  // candidate_regions point into region_manager_ which is modified below
+  candidate_regions.clear();
+
+  bool shrunk = false;
   size_t i = 0;
   for (void* region_ptr : region_ptrs) {
+    if (static_cast<size_t>(stats_.total_allocated_bytes) <= high_watermark_bytes) {
+      break;
+    }
+
     bool deallocate_region = true;
     ChunkHandle region_begin_chunk = region_manager_.get_handle(region_ptr);
     ChunkHandle h = region_begin_chunk;
@@ -561,6 +649,7 @@ Status BFCArena::Shrink() {
       device_allocator_->Free(region_ptr);
       region_manager_.RemoveAllocationRegion(region_ptr);
       stats_.num_arena_extensions--;
+      shrunk = true;
     }
 
     ++i;
@@ -568,7 +657,11 @@ Status BFCArena::Shrink() {
 
   // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
   // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
-  curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+  // A partial shrink that released nothing keeps the current growth so the arena does not start over with small
+  // extensions.
+  if (high_watermark_bytes == 0 || shrunk) {
+    curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+  }
 
   return Status::OK();
 }
@@ -30,6 +30,7 @@ limitations under the License.
 #include "core/platform/ort_mutex.h"
 #include "core/framework/arena_extend_strategy.h"
 #include "core/framework/allocator.h"
+#include "core/framework/small_block_cache.h"
 
 #include "core/framework/stream_handles.h"
 
@@ -60,6 +61,7 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
+  static const int64_t DEFAULT_SMALL_BLOCK_CACHE_BYTES = 0;                         // disabled
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
 
   enum ArenaType {
@@ -73,7 +75,8 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           int64_t small_block_cache_bytes = DEFAULT_SMALL_BLOCK_CACHE_BYTES);
 
   ~BFCArena() override;
 
@@ -86,13 +89,20 @@ class BFCArena : public IAllocator {
   void Free(void* p) override;
 
   // Frees all allocation regions in which no chunk is in use.
-  // Does not free any reserved chunks.
+  // Does not free any reserved chunks or the small block cache pool.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
   // future allocation sizes are determined by the arena growth strategy
   // and the allocation request.
   Status Shrink();
 
+  // Frees allocation regions in which no chunk is in use, most recently added region first, until the total
+  // allocated bytes of the arena is at or below `high_watermark_bytes`. Regions that keep the arena at or below
+  // the watermark are retained so that the next run does not need to re-extend the arena.
+  // Like Shrink(), this does not free reserved chunks and honors the rule for the first allocation region.
+  // Shrink() is equivalent to ShrinkToWatermark(0).
+  Status ShrinkToWatermark(size_t high_watermark_bytes);
+
   void* Reserve(size_t size) override;
 
   void GetStats(AllocatorStats* stats) override;
@@ -509,6 +519,11 @@ class BFCArena : public IAllocator {
   const int initial_growth_chunk_size_bytes_;
   const int64_t max_power_of_two_extend_bytes_;
 
+  // Optional lock-free cache for small allocations made via Alloc(). Its pool is allocated from
+  // device_allocator_ at construction and is accounted for in stats_.total_allocated_bytes.
+  std::unique_ptr<SmallBlockCache> small_block_cache_;
+  void* small_block_cache_pool_ = nullptr;
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
@@ -533,7 +548,7 @@ class StreamAwareArena : public BFCArena {
   // passed to free(). Whatever, do not dereference that pointer
   void* AllocOnStream(size_t size, Stream* current_stream_id, WaitNotificationFn wait_fn);
 
-  void ReleaseStreamBuffers(Stream* stream);
+  void ReleaseStreamBuffers(Stream* stream) override;
 
   static StreamAwareArena* FromBFCArena(BFCArena& arena) {
     return arena.GetArenaType() == ArenaType::StreamAwareArena ? reinterpret_cast<StreamAwareArena*>(&arena) : nullptr;
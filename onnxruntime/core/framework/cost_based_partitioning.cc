@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/cost_based_partitioning.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/data_types.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/framework/utils.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// The costs are in bytes of CPU memory traffic. The constants are rough estimates for a discrete GPU: the device
+// streams memory kDeviceSpeedup times faster than the CPU, launching a kernel costs about as much as the CPU
+// streaming kDeviceKernelOverhead bytes, and a copy between host and device memory costs kCopyOverhead plus
+// kCopyCostPerByte per byte.
+constexpr double kDeviceSpeedup = 8.0;
+constexpr double kDeviceKernelOverhead = 32.0 * 1024;
+constexpr double kCopyOverhead = 64.0 * 1024;
+constexpr double kCopyCostPerByte = 2.0;
+
+// ops whose cost is dominated by compute rather than memory traffic, which are never moved to CPU
+const InlinedHashSet<std::string_view>& ComputeBoundOps() {
+  static const InlinedHashSet<std::string_view> ops{
+      "Attention", "Conv", "ConvTranspose", "Einsum", "FusedConv", "FusedGemm", "FusedMatMul", "GRU", "Gemm",
+      "LSTM", "MatMul", "MatMulInteger", "MultiHeadAttention", "QLinearConv", "QLinearMatMul", "RNN"};
+  return ops;
+}
+
+std::optional<double> GetSizeInBytes(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  const auto* type_proto = arg.TypeAsProto();
+  if (!arg.Exists() || shape == nullptr || type_proto == nullptr || !utils::HasTensorType(*type_proto)) {
+    return std::nullopt;
+  }
+
+  const auto* element_type = DataTypeImpl::TypeFromProto(*type_proto)->AsTensorType()->GetElementType();
+  double size = static_cast<double>(element_type->Size());
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return std::nullopt;
+    }
+    size *= static_cast<double>(dim.dim_value());
+  }
+  return size;
+}
+
+enum class Location {
+  kHost,
+  kDevice,
+};
+
+class CostModel {
+ public:
+  CostModel(const Graph& graph, const ExecutionProviders& execution_providers,
+            const KernelRegistryManager& kernel_registry_mgr)
+      : graph_(graph), on_device_(graph.MaxNodeIndex(), false), kernels_(graph.MaxNodeIndex(), nullptr) {
+    for (const auto& node : graph.Nodes()) {
+      const auto* ep = execution_providers.Get(node);
+      if (ep == nullptr || ep->Type() == kCpuExecutionProvider ||
+          ep->GetOrtDeviceByMemType(OrtMemTypeDefault).Type() == OrtDevice::CPU) {
+        continue;
+      }
+
+      on_device_[node.Index()] = true;
+      // compiled nodes have their kernels in the registry of fused kernels, which is not registered yet
+      const KernelCreateInfo* kernel_create_info = nullptr;
+      if (kernel_registry_mgr.SearchKernelRegistry(node, &kernel_create_info).IsOK()) {
+        kernels_[node.Index()] = kernel_create_info;
+      }
+    }
+  }
+
+  bool IsOnDevice(const Node& node) const { return on_device_[node.Index()]; }
+  const KernelCreateInfo* DeviceKernel(const Node& node) const { return kernels_[node.Index()]; }
+  void MoveToHost(const Node& node) { on_device_[node.Index()] = false; }
+
+  // where the input or output of a node is when the node is on device or on host
+  Location InputLocation(const Node& node, bool on_device, size_t input_index) const {
+    return on_device && !utils::IsInputOnCpu(node, DeviceKernel(node), input_index) ? Location::kDevice
+                                                                                    : Location::kHost;
+  }
+
+  Location OutputLocation(const Node& node, bool on_device, size_t output_index) const {
+    return on_device && !utils::IsOutputOnCpu(node, DeviceKernel(node), output_index) ? Location::kDevice
+                                                                                      : Location::kHost;
+  }
+
+  // the location of a value as produced. initializers are copied once when the session is created, so they are
+  // wherever they are needed.
+  std::optional<Location> ProducedLocation(const NodeArg& arg) const {
+    if (graph_.IsInitializedTensor(arg.Name())) {
+      return std::nullopt;
+    }
+    const Node* producer = graph_.GetProducerNode(arg.Name());
+    if (producer == nullptr) {
+      // graph inputs are fed from host memory
+      return Location::kHost;
+    }
+    const auto& output_defs = producer->OutputDefs();
+    for (size_t i = 0; i < output_defs.size(); ++i) {
+      if (output_defs[i] == &arg) {
+        return OutputLocation(*producer, IsOnDevice(*producer), i);
+      }
+    }
+    return Location::kHost;
+  }
+
+  // whether any consumer of a value needs it at the given location. graph outputs are fetched to host memory.
+  bool IsConsumedAt(const NodeArg& arg, Location location) const {
+    if (location == Location::kHost && graph_.IsOutput(&arg)) {
+      return true;
+    }
+    for (const Node* consumer : graph_.GetConsumerNodes(arg.Name())) {
+      const bool on_device = IsOnDevice(*consumer);
+      const auto& input_defs = consumer->InputDefs();
+      bool is_explicit_input = false;
+      for (size_t i = 0; i < input_defs.size(); ++i) {
+        if (input_defs[i] == &arg) {
+          is_explicit_input = true;
+          if (InputLocation(*consumer, on_device, i) == location) {
+            return true;
+          }
+        }
+      }
+      // implicit inputs of nodes with subgraphs are needed on the device of the node
+      if (!is_explicit_input && (on_device ? Location::kDevice : Location::kHost) == location) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // the cost of running the node on device or on host, including the copies of its inputs and outputs
+  std::optional<double> NodeCost(const Node& node, bool on_device) const {
+    double traffic = 0.0;
+    double copies = 0.0;
+    auto add_copy = [&copies](double size) { copies += kCopyOverhead + kCopyCostPerByte * size; };
+
+    const auto& input_defs = node.InputDefs();
+    for (size_t i = 0; i < input_defs.size(); ++i) {
+      if (!input_defs[i]->Exists()) {
+        continue;
+      }
+      const auto size = GetSizeInBytes(*input_defs[i]);
+      if (!size.has_value()) {
+        return std::nullopt;
+      }
+      traffic += *size;
+      const auto produced = ProducedLocation(*input_defs[i]);
+      if (produced.has_value() && *produced != InputLocation(node, on_device, i)) {
+        add_copy(*size);
+      }
+    }
+
+    const auto& output_defs = node.OutputDefs();
+    for (size_t i = 0; i < output_defs.size(); ++i) {
+      if (!output_defs[i]->Exists()) {
+        continue;
+      }
+      const auto size = GetSizeInBytes(*output_defs[i]);
+      if (!size.has_value()) {
+        return std::nullopt;
+      }
+      traffic += *size;
+      const Location produced = OutputLocation(node, on_device, i);
+      if (IsConsumedAt(*output_defs[i], produced == Location::kHost ? Location::kDevice : Location::kHost)) {
+        add_copy(*size);
+      }
+    }
+
+    return on_device ? traffic / kDeviceSpeedup + kDeviceKernelOverhead + copies : traffic + copies;
+  }
+
+ private:
+  const Graph& graph_;
+  InlinedVector<bool> on_device_;
+  InlinedVector<const KernelCreateInfo*> kernels_;
+};
+
+}  // namespace
+
+InlinedVector<NodeIndex> GetNodesCheaperOnCpu(const Graph& graph,
+                                              const ExecutionProviders& execution_providers,
+                                              const KernelRegistryManager& kernel_registry_mgr) {
+  CostModel cost_model(graph, execution_providers, kernel_registry_mgr);
+  const auto& compute_bound_ops = ComputeBoundOps();
+
+  InlinedVector<NodeIndex> candidates;
+  for (const auto& node : graph.Nodes()) {
+    if (cost_model.IsOnDevice(node) && cost_model.DeviceKernel(node) != nullptr &&
+        !node.ContainsSubgraph() && compute_bound_ops.count(node.OpType()) == 0 &&
+        KernelRegistryManager::HasImplementationOf(kernel_registry_mgr, node, kCpuExecutionProvider)) {
+      candidates.push_back(node.Index());
+    }
+  }
+
+  // visit the candidates in topological order, so that a chain of small nodes moves from its CPU end
+  GraphViewer graph_viewer(graph);
+  InlinedVector<size_t> topological_order(graph.MaxNodeIndex(), 0);
+  const auto& ordered_nodes = graph_viewer.GetNodesInTopologicalOrder();
+  for (size_t i = 0; i < ordered_nodes.size(); ++i) {
+    topological_order[ordered_nodes[i]] = i;
+  }
+  std::sort(candidates.begin(), candidates.end(), [&topological_order](NodeIndex a, NodeIndex b) {
+    return topological_order[a] < topological_order[b];
+  });
+
+  // every pass moves at least one node to host, or stops
+  InlinedVector<NodeIndex> moved_nodes;
+  bool moved = true;
+  while (moved) {
+    moved = false;
+    for (const NodeIndex index : candidates) {
+      const Node& node = *graph.GetNode(index);
+      if (!cost_model.IsOnDevice(node)) {
+        continue;
+      }
+      const auto device_cost = cost_model.NodeCost(node, true);
+      const auto host_cost = cost_model.NodeCost(node, false);
+      if (device_cost.has_value() && host_cost.has_value() && *host_cost < *device_cost) {
+        cost_model.MoveToHost(node);
+        moved_nodes.push_back(index);
+        moved = true;
+      }
+    }
+  }
+
+  return moved_nodes;
+}
+
+}  // namespace onnxruntime
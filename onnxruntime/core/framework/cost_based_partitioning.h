@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/inlined_containers_fwd.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+class ExecutionProviders;
+class KernelRegistryManager;
+
+/**
+  Returns the nodes assigned to the kernels of a device (non-CPU memory) execution provider that a cost model
+  estimates to finish sooner on the CPU execution provider, once the copies of their inputs and outputs between
+  host and device memory are taken into account. Those are typically small isolated ops between CPU nodes, which
+  would otherwise be surrounded by Memcpy nodes.
+
+  The cost of a node is estimated from the sizes of its inputs and outputs, so only nodes with static shapes are
+  considered. Compute bound ops, nodes with subgraphs, nodes compiled by an execution provider and nodes without a
+  CPU kernel are never returned. The estimate is iterated to a fixed point, as moving a node changes where the
+  values next to it are.
+  @param graph Partitioned graph
+  @param execution_providers Execution providers of the session
+  @param kernel_registry_mgr Kernel registries of the session
+  */
+InlinedVector<NodeIndex> GetNodesCheaperOnCpu(const Graph& graph,
+                                              const ExecutionProviders& execution_providers,
+                                              const KernelRegistryManager& kernel_registry_mgr);
+
+}  // namespace onnxruntime
@@ -33,13 +33,18 @@ class DeviceStreamCollectionImpl {
   void ReleaseSingleStreamBuffers(Stream* stream) {
     if (!stream) return;
     for (auto it : allocators_) {
-      if (it.second->Info().device == stream->GetDevice() &&
-          it.second->Info().alloc_type == OrtArenaAllocator) {
+      if (it.second->Info().device != stream->GetDevice()) {
+        continue;
+      }
+
+      if (it.second->Info().alloc_type == OrtArenaAllocator) {
         auto* arena_alloc = static_cast<BFCArena*>(it.second.get());
         auto* stream_aware_alloc = StreamAwareArena::FromBFCArena(*arena_alloc);
         if (stream_aware_alloc) {
           stream_aware_alloc->ReleaseStreamBuffers(stream);
         }
+      } else if (it.second->IsStreamAware()) {
+        it.second->ReleaseStreamBuffers(stream);
       }
     }
   }
@@ -56,10 +61,20 @@ class DeviceStreamCollectionImpl {
       }
     }
 
+    if (sync_streams) {
+      for (auto& copy_stream : copy_streams_) {
+        ORT_RETURN_IF_ERROR(copy_stream->CleanUpOnRunEnd());
+        copy_stream->Flush();
+      }
+    }
+
     // only clean the streams that is owned by current context
     for (auto& stream : owned_streams_) {
       ReleaseSingleStreamBuffers(stream.get());
     }
+    for (auto& copy_stream : copy_streams_) {
+      ReleaseSingleStreamBuffers(copy_stream.get());
+    }
     ReleaseSingleStreamBuffers(root_stream_.get());
     return Status::OK();
   }
@@ -82,6 +97,19 @@ class DeviceStreamCollectionImpl {
 
   size_t NumStreams() { return num_streams_; }
 
+  void AddCopyStream(std::unique_ptr<Stream> stream) {
+    copy_streams_.emplace_back(std::move(stream));
+  }
+
+  Stream* GetCopyStream(const OrtDevice& device) const {
+    for (const auto& copy_stream : copy_streams_) {
+      if (copy_stream->GetDevice().Type() == device.Type() && copy_stream->GetDevice().Id() == device.Id()) {
+        return copy_stream.get();
+      }
+    }
+    return nullptr;
+  }
+
   Stream* GetRootStream() {
     return root_stream_.get();
   }
@@ -90,6 +118,8 @@ class DeviceStreamCollectionImpl {
   size_t num_streams_;
   std::vector<Stream*> device_streams_;
   InlinedVector<std::unique_ptr<Stream>> owned_streams_;
+  // one per device, see kOrtSessionOptionsConfigUseCopyStreamForFeeds
+  InlinedVector<std::unique_ptr<Stream>> copy_streams_;
   const AllocatorMap& allocators_;
   bool is_main_graph_ = false;
   // This is used in ExecutionFrame when memory pattern is enabled, to allocate the peak size memory
@@ -117,6 +147,14 @@ size_t DeviceStreamCollection::NumStreams() const {
   return impl_->NumStreams();
 }
 
+void DeviceStreamCollection::AddCopyStream(std::unique_ptr<Stream> stream) {
+  impl_->AddCopyStream(std::move(stream));
+}
+
+Stream* DeviceStreamCollection::GetCopyStream(const OrtDevice& device) const {
+  return impl_->GetCopyStream(device);
+}
+
 Status DeviceStreamCollection::CleanUp(bool sync_streams) {
   return impl_->CleanUp(sync_streams);
 }
@@ -36,6 +36,13 @@ class DeviceStreamCollection {
   // get the number of device stream instances.
   size_t NumStreams() const;
 
+  // Add a stream dedicated to copying the feeds to the device of the stream.
+  // The current collection is the owner of the stream.
+  void AddCopyStream(std::unique_ptr<Stream> stream);
+
+  // get the copy stream for the given device, nullptr if there is none.
+  Stream* GetCopyStream(const OrtDevice& device) const;
+
   // Since the collection may be reused for future iteration,
   // This API is used to cleanup some resources at the end of an iteration.
   Status CleanUp(bool sync_streams);
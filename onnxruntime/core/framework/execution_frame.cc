@@ -3,6 +3,7 @@
 
 #include "core/framework/execution_frame.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/framework/mem_pattern_planner.h"
@@ -205,12 +206,13 @@ AllocatorPtr IExecutionFrame::GetAllocator(const OrtDevice& info) const {
 Status IExecutionFrame::ReleaseMLValue(int ort_value_idx) { return ReleaseMLValueImpl(ort_value_idx); }
 
 #ifdef ENABLE_TRAINING
+#endif
+
 void IExecutionFrame::ReleaseAllMLValues() {
   for (size_t ort_value_idx = 0; ort_value_idx < all_values_.size(); ort_value_idx++) {
     all_values_[ort_value_idx] = OrtValue();
   }
 }
-#endif
 
 Status IExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   if (ort_value_idx == NodeIndexInfo::kInvalidEntry || static_cast<size_t>(ort_value_idx) >= all_values_size_) {
@@ -356,24 +358,14 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 #ifdef ORT_ENABLE_STREAM
       device_streams_(device_streams),
 #endif
-      session_state_(session_state),
-      mem_patterns_(nullptr) {
-  Init(
-      feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
-#if !defined(DISABLE_SPARSE_TENSORS)
-      [&session_state](const std::string& name) -> bool {
-        int idx = -1;
-        if (session_state.GetOrtValueNameIdxMap().GetIdx(name, idx).IsOK()) {
-          return session_state.IsSparseInitializer(idx);
-        }
-        return false;
-      },
-#else
-      [&](const std::string& /*name*/) -> bool {
-        return false;
-      },
+      session_state_(session_state) {
+#if !defined(ORT_MINIMAL_BUILD)
+  if (session_state.GetMemoryTracer() != nullptr) {
+    memory_trace_ = std::make_unique<MemoryTrace>();
+  }
 #endif
-      fetches);
+
+  InitValues(feed_mlvalue_idxs, feeds, fetches);
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   session_state.GetMemoryProfiler()->GetMemoryInfo().IncreaseIteration();
@@ -410,6 +402,7 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
       // if no existing patterns, generate one in this execution frame
       if (!mem_patterns_) {
         planner_.emplace(*session_state.GetExecutionPlan());
+        record_memory_pattern_trace_ = session_state.NeedsMemoryPatternTrace();
       } else {
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
@@ -492,7 +485,72 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
   }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+void ExecutionFrame::InitValues(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                gsl::span<const OrtValue> fetches) {
+  Init(
+      feed_mlvalue_idxs, feeds, session_state_.GetInitializedTensors(),
+#if !defined(DISABLE_SPARSE_TENSORS)
+      [this](const std::string& name) -> bool {
+        int idx = -1;
+        if (session_state_.GetOrtValueNameIdxMap().GetIdx(name, idx).IsOK()) {
+          return session_state_.IsSparseInitializer(idx);
+        }
+        return false;
+      },
+#else
+      [&](const std::string& /*name*/) -> bool {
+        return false;
+      },
+#endif
+      fetches);
+}
+
+bool ExecutionFrame::IsReusable() const {
+#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
+  // the memory profile is recorded per execution frame
+  return false;
+#else
+  bool reusable = !planner_.has_value() && custom_allocators_.empty();
+#ifdef ORT_ENABLE_STREAM
+  // the memory pattern buffers are secured to the streams of the run that allocated them
+  reusable = reusable && device_streams_ == nullptr;
+#endif
+#if !defined(ORT_MINIMAL_BUILD)
+  reusable = reusable && memory_trace_ == nullptr;
+#endif
+  return reusable;
+#endif
+}
+
+bool ExecutionFrame::CanReuseFor(gsl::span<const int> fetch_mlvalue_idxs,
+                                 const MemoryPatternGroup* mem_patterns) const {
+  const auto frame_fetch_mlvalue_idxs = GetFetchMLValueIdxs();
+  return mem_patterns == mem_patterns_.get() &&
+         std::equal(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end(),
+                    frame_fetch_mlvalue_idxs.begin(), frame_fetch_mlvalue_idxs.end());
+}
+
+void ExecutionFrame::Reset(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                           gsl::span<const OrtValue> fetches,
+                           std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes) {
+  inferred_shapes_ = std::move(inferred_shapes);
+  InitValues(feed_mlvalue_idxs, feeds, fetches);
+}
+
+ExecutionFrame::~ExecutionFrame() {
+#if !defined(ORT_MINIMAL_BUILD)
+  if (memory_trace_) {
+    ORT_TRY {
+      session_state_.GetMemoryTracer()->AddExecution(*memory_trace_, session_state_);
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        LOGS(session_state_.Logger(), WARNING) << "Failed to record the memory trace: " << e.what();
+      });
+    }
+  }
+#endif
+}
 
 Status ExecutionFrame::CopyTensor(const Tensor& src, Tensor& dest) const {
   return session_state_.GetDataTransferMgr().CopyTensor(src, dest);
@@ -548,12 +606,18 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // if the block is not correct, log message then fall back to default behavior.
+          // the pattern of a bucket of input shapes may have been generated for larger inputs of the bucket.
+          if (block->size_ == size || (block->size_ > size && session_state_.HasMemoryPatternDimBuckets())) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
                 shape);
+#if !defined(ORT_MINIMAL_BUILD)
+            if (memory_trace_ && status.IsOK()) {
+              memory_trace_->RecordAllocation(ort_value_index, size, location);
+            }
+#endif
             return status;
           } else {
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
@@ -586,6 +650,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
           current_stream->GetDevice().Type(), current_stream->GetDevice().Type());
       void* p_data = stream_aware_alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
       Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
+    } else if (alloc->IsStreamAware()) {
+      size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
+      void* p_data = alloc->AllocOnStream(buffer_size, current_stream);
+      Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
     } else {
       Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
     }
@@ -603,6 +671,12 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
     TraceAllocate(ort_value_index, size);
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  if (memory_trace_) {
+    memory_trace_->RecordAllocation(ort_value_index, size, location);
+  }
+#endif
+
   {
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // This code block is not thread-safe.
@@ -877,6 +951,11 @@ void ExecutionFrame::VerifyOutputSizes(int output_index, const Node& node, const
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
+#if !defined(ORT_MINIMAL_BUILD)
+  if (memory_trace_) {
+    memory_trace_->RecordFree(ort_value_idx);
+  }
+#endif
   return Status::OK();
 }
 
@@ -893,6 +972,9 @@ void ExecutionFrame::TraceAllocate(int ort_value_idx, size_t size) {
       return;
     }
     auto status = planner_->TraceAllocation(ort_value_idx, size);
+    if (record_memory_pattern_trace_ && status.IsOK()) {
+      memory_pattern_trace_.push_back({ort_value_idx, size, false});
+    }
     if (!status.IsOK()) {
       LOGS(session_state_.Logger(), WARNING) << "TraceAllocation for ort_value_idx=" << ort_value_idx
                                              << " size=" << size << " failed: " << status.ErrorMessage();
@@ -917,6 +999,9 @@ void ExecutionFrame::TraceFree(int ort_value_idx) {
       // don't trace string tensors
       if (!utils::IsDataTypeString(ml_data_type)) {
         auto status = planner_->TraceFree(ort_value_idx);
+        if (record_memory_pattern_trace_ && status.IsOK()) {
+          memory_pattern_trace_.push_back({ort_value_idx, 0, true});
+        }
         if (!status.IsOK()) {
           LOGS(session_state_.Logger(), WARNING)
               << "TraceFree for ort_value_idx=" << ort_value_idx << " failed: " << status.ErrorMessage();
@@ -10,10 +10,12 @@
 #include "core/common/logging/logging.h"
 #include "core/common/status.h"
 #include "core/framework/iexecutor.h"
+#include "core/framework/memory_trace.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/sequential_execution_plan.h"
+#include "core/framework/symbolic_memory_planner.h"
 #include "core/framework/tensor.h"
 #include "core/graph/graph_viewer.h"
 
@@ -67,9 +69,11 @@ class IExecutionFrame {
 
                      const std::unordered_map<int, OrtValue>& initializers);
   Status GetOutputs(gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches);
+#endif
+
   // if OOM happens, then release all values, so session can run next batch.
+  // also used to clear a completed frame before it is pooled for another run.
   void ReleaseAllMLValues();
-#endif
 
   // TO DO: make it thread safe
   // This method is not thread safe!
@@ -103,6 +107,8 @@ class IExecutionFrame {
   // returns true if the ort_value_idx is an output from the graph
   bool IsOutput(int ort_value_idx) const;
 
+  gsl::span<const int> GetFetchMLValueIdxs() const { return fetch_mlvalue_idxs_; }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IExecutionFrame);
 
@@ -166,6 +172,26 @@ class ExecutionFrame final : public IExecutionFrame {
     return planner_.has_value();
   }
 
+  // The allocations and frees traced by the memory pattern planner, in order, if the session plans the memory
+  // patterns of new input shapes from the symbolic dims and needs this trace to do so.
+  gsl::span<const SymbolicMemoryPlanner::TraceEvent> GetMemoryPatternTrace() const {
+    return memory_pattern_trace_;
+  }
+
+  // Whether the frame can be pooled by the session once its run completes, to be reset for another run.
+  // Frames that generate memory patterns, allocate outputs with custom allocators, run on device streams or
+  // record the memory they allocate are not reusable.
+  bool IsReusable() const;
+
+  // Whether the frame, if reusable, can be reset for a run with these fetches that uses the memory patterns
+  // `mem_patterns`, which are nullptr if the run doesn't use memory patterns.
+  bool CanReuseFor(gsl::span<const int> fetch_mlvalue_idxs, const MemoryPatternGroup* mem_patterns) const;
+
+  // Reset a pooled frame for a run with the given feeds and fetches. The OrtValues of the last run must have been
+  // released, and CanReuseFor must be true for the run. The memory pattern buffers are kept.
+  void Reset(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+             gsl::span<const OrtValue> fetches, std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes);
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrival is successful, this function returns true and false otherwise.
   bool TryGetInferredShape(int index, TensorShape& shape) const override;
@@ -195,6 +221,10 @@ class ExecutionFrame final : public IExecutionFrame {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
+  // Assign the feeds, fetches and initializers to their OrtValues.
+  void InitValues(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                  gsl::span<const OrtValue> fetches);
+
   AllocatorPtr GetAllocatorImpl(const OrtDevice& info) const override;
   Status ReleaseMLValueImpl(int ort_value_idx) override;
   Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) override;
@@ -231,12 +261,17 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  // Shared with the session's cache, which may evict or replace the patterns while the frame uses them.
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
   std::optional<OrtValuePatternPlanner> planner_;
 
+  // see GetMemoryPatternTrace. the memory patterns are only traced with a sequential plan on a single stream.
+  bool record_memory_pattern_trace_{false};
+  std::vector<SymbolicMemoryPlanner::TraceEvent> memory_pattern_trace_;
+
   // Big chunks on different locations that will be used by mem_pattern.
   InlinedHashMap<OrtDevice, BufferUniquePtr> buffers_;
 
@@ -244,8 +279,13 @@ class ExecutionFrame final : public IExecutionFrame {
   // all symbolic shapes. inferred_shapes_[i] is the shape of OrtValue indexed
   // by i, if the key i exists.
   // inferred_shapes_ is generated together with mem_patterns_.
-  // It is never updated after creation
-  const InlinedHashMap<int, TensorShape>* inferred_shapes_{nullptr};
+  // It is only updated when a pooled frame is reset for another run with the same mem_patterns_.
+  std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // the allocations of this execution, if the session has a MemoryTracer
+  std::unique_ptr<MemoryTrace> memory_trace_;
+#endif
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Size of virtual memory allocated before any kernel execution.
@@ -100,6 +100,8 @@ class FeedsFetchesManager {
 
   const DeviceCopyChecks& GetDeviceCopyChecks() const { return device_copy_checks_; }
   void SetDeviceCopyChecks(DeviceCopyCheck input_copy_needed, DeviceCopyCheck output_copy_needed);
+  // Forget the checks of the previous feeds and fetches, for a manager that is reused with other values.
+  void ResetDeviceCopyChecks() { device_copy_checks_ = {}; }
 
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(FeedsFetchesManager);
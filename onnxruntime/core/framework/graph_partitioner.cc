@@ -6,7 +6,9 @@
 #include <cassert>
 #include <functional>
 
+#include "core/common/profiler.h"
 #include "core/framework/compute_capability.h"
+#include "core/framework/cost_based_partitioning.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/func_kernel.h"
 #include "core/framework/kernel_lookup.h"
@@ -60,6 +62,30 @@ struct PartitionParams {
   std::reference_wrapper<const layout_transformation::DebugGraphFn> debug_graph_fn;
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 };
+
+// Records the time spent partitioning the graph for one execution provider as a session event.
+class ScopedPartitionEvent {
+ public:
+  ScopedPartitionEvent(profiling::Profiler* profiler, const IExecutionProvider& ep)
+      : profiler_(profiler != nullptr && profiler->IsEnabled() ? profiler : nullptr), ep_(ep) {
+    if (profiler_ != nullptr) {
+      start_time_ = profiler_->Start();
+    }
+  }
+
+  ~ScopedPartitionEvent() {
+    if (profiler_ != nullptr) {
+      profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_partition_" + ep_.Type(), start_time_);
+    }
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScopedPartitionEvent);
+
+ private:
+  profiling::Profiler* profiler_;
+  const IExecutionProvider& ep_;
+  TimePoint start_time_;
+};
 }  // namespace
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -727,7 +753,10 @@ static Status CreateEpContextModel(const ExecutionProviders& execution_providers
 
 static Status PartitionOnnxFormatModel(const PartitionParams& partition_params, GraphPartitioner::Mode mode,
                                        const ExecutionProviders& execution_providers,
-                                       KernelRegistryManager& kernel_registry_manager) {
+                                       KernelRegistryManager& kernel_registry_manager,
+                                       profiling::Profiler* profiler,
+                                       bool cost_based_partitioning,
+                                       const logging::Logger& logger) {
   bool modified_graph = false;
 
   auto& graph = partition_params.graph.get();
@@ -739,6 +768,20 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
   do {
     // process full graph with each EP
     for (const auto& ep : execution_providers) {
+      // the CPU EP is the last one. before it runs, give it back the nodes the device EPs took that are cheaper on
+      // CPU once the copies around them are accounted for.
+      if (cost_based_partitioning && ep->Type() == kCpuExecutionProvider) {
+        const auto nodes_cheaper_on_cpu = GetNodesCheaperOnCpu(graph, execution_providers, kernel_registry_manager);
+        for (const NodeIndex index : nodes_cheaper_on_cpu) {
+          graph.GetNode(index)->SetExecutionProviderType("");
+        }
+        if (!nodes_cheaper_on_cpu.empty()) {
+          LOGS(logger, INFO) << "Cost based partitioning moved " << nodes_cheaper_on_cpu.size() << " nodes to "
+                             << kCpuExecutionProvider;
+        }
+      }
+
+      ScopedPartitionEvent partition_event(profiler, *ep);
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(graph, func_mgr, kernel_registry_manager,
                                                        fused_kernel_registry, *ep, mode, fused_node_unique_id,
                                                        transform_layout_function,
@@ -876,9 +919,11 @@ static Status PartitionOrtFormatModelImpl(const PartitionParams& partition_param
 // Simplified partitioning where custom EPs may produce compiled nodes.
 static Status PartitionOrtFormatModel(const PartitionParams& partition_params,
                                       const ExecutionProviders& execution_providers,
-                                      KernelRegistryManager& kernel_registry_manager) {
+                                      KernelRegistryManager& kernel_registry_manager,
+                                      profiling::Profiler* profiler) {
   // process full graph with each EP
   for (const auto& ep : execution_providers) {
+    ScopedPartitionEvent partition_event(profiler, *ep);
     ORT_RETURN_IF_ERROR(PartitionOrtFormatModelImpl(partition_params, kernel_registry_manager, *ep));
   }
 
@@ -977,8 +1022,11 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
 
   if (mode == Mode::kNormal || mode == Mode::kAssignOnly) {
 #if !defined(ORT_MINIMAL_BUILD)
+    const bool cost_based_partitioning =
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCostBasedPartitioning, "0") == "1";
     ORT_RETURN_IF_ERROR(PartitionOnnxFormatModel(partition_params, mode,
-                                                 providers_, kernel_registry_mgr_));
+                                                 providers_, kernel_registry_mgr_, profiler_,
+                                                 cost_based_partitioning, logger));
 
     bool ep_context_enabled = config_options.GetConfigOrDefault(kOrtSessionOptionEpContextEnable, "0") == "1";
     std::string ep_context_path = config_options.GetConfigOrDefault(kOrtSessionOptionEpContextFilePath, "");
@@ -992,7 +1040,7 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
 #endif  //! defined(ORT_MINIMAL_BUILD)
   } else {
     ORT_RETURN_IF_ERROR(PartitionOrtFormatModel(partition_params,
-                                                providers_, kernel_registry_mgr_));
+                                                providers_, kernel_registry_mgr_, profiler_));
   }
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
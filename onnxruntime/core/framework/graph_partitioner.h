@@ -14,6 +14,9 @@ class ExecutionProviders;
 class KernelRegistryManager;
 class Model;
 struct ConfigOptions;
+namespace profiling {
+class Profiler;
+}
 
 class GraphPartitioner {
  public:
@@ -24,9 +27,12 @@ class GraphPartitioner {
   };
 
   // The order of providers represents the user preference.
-  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers)
+  // If profiler is enabled, the time spent partitioning the graph for each provider is recorded.
+  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers,
+                   profiling::Profiler* profiler = nullptr)
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {
+        providers_(providers),
+        profiler_(profiler) {
   }
 
   // Run partitioning.
@@ -64,6 +70,7 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  profiling::Profiler* profiler_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#elif defined(_WIN32)
+#include <Windows.h>
+#endif
+
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+namespace {
+
+#if defined(__linux__) || defined(_WIN32)
+size_t RoundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+#endif
+
+#if defined(__linux__)
+constexpr size_t k2MB = size_t{2} * 1024 * 1024;
+constexpr size_t k1GB = size_t{1024} * 1024 * 1024;
+
+// map pages of the hugetlb pool. page_size_log2 of 0 is the default huge page size.
+void* MapHugeTlbPages(size_t size, [[maybe_unused]] int page_size_log2) {
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#if defined(MAP_HUGE_SHIFT)
+  flags |= page_size_log2 << MAP_HUGE_SHIFT;
+#else
+  if (page_size_log2 != 0) {
+    return nullptr;
+  }
+#endif
+  void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  return p == MAP_FAILED ? nullptr : p;
+}
+
+// map memory aligned to 2 MB and ask the kernel to back it with transparent huge pages.
+// if it doesn't, e.g. transparent huge pages are disabled, the memory is in regular pages.
+void* MapTransparentHugePages(size_t size) {
+  const size_t mapped_size = size + k2MB;
+  void* p = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) {
+    return nullptr;
+  }
+
+  // unmap the parts before and after the aligned range
+  const auto begin = reinterpret_cast<uintptr_t>(p);
+  const auto aligned_begin = static_cast<uintptr_t>(RoundUp(begin, k2MB));
+  const uintptr_t end = begin + mapped_size;
+  const uintptr_t aligned_end = aligned_begin + size;
+  if (aligned_begin > begin) {
+    munmap(p, aligned_begin - begin);
+  }
+  if (end > aligned_end) {
+    munmap(reinterpret_cast<void*>(aligned_end), end - aligned_end);
+  }
+
+  void* aligned = reinterpret_cast<void*>(aligned_begin);
+#if defined(MADV_HUGEPAGE)
+  madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+  return aligned;
+}
+#elif defined(_WIN32)
+// large pages require the SeLockMemoryPrivilege to be enabled in the token of the process
+bool EnableLockMemoryPrivilege() {
+  static const bool enabled = []() {
+    HANDLE token = nullptr;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+      return false;
+    }
+
+    TOKEN_PRIVILEGES privileges{};
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    // AdjustTokenPrivileges succeeds with ERROR_NOT_ALL_ASSIGNED if the account doesn't hold the privilege
+    const bool result = LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+                        AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                        GetLastError() == ERROR_SUCCESS;
+    CloseHandle(token);
+    return result;
+  }();
+  return enabled;
+}
+#endif
+
+}  // namespace
+
+void* HugePageCPUAllocator::Alloc(size_t size) {
+  if (size < kMinHugePageAllocationSize) {
+    return CPUAllocator::Alloc(size);
+  }
+
+  // see AllocatorDefaultAlloc
+  const size_t alloc_size = size + MLAS_SYMM_QGEMM_BUF_OVERRUN;
+  void* p = nullptr;
+  size_t mapped_size = 0;
+
+#if defined(__linux__)
+  // 1 GB pages unless rounding up to them wastes more than an eighth of the allocation
+  if (alloc_size >= k1GB && RoundUp(alloc_size, k1GB) - alloc_size <= alloc_size / 8) {
+    mapped_size = RoundUp(alloc_size, k1GB);
+    p = MapHugeTlbPages(mapped_size, 30);
+  }
+  if (p == nullptr) {
+    mapped_size = RoundUp(alloc_size, k2MB);
+    p = MapHugeTlbPages(mapped_size, 21);
+  }
+  if (p == nullptr) {
+    p = MapTransparentHugePages(mapped_size);
+  }
+#elif defined(_WIN32)
+  const size_t large_page_size = GetLargePageMinimum();
+  if (large_page_size != 0 && EnableLockMemoryPrivilege()) {
+    mapped_size = RoundUp(alloc_size, large_page_size);
+    p = VirtualAlloc(nullptr, mapped_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+  }
+#endif
+
+  if (p == nullptr) {
+    return CPUAllocator::Alloc(size);
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  huge_page_allocations_.emplace(p, mapped_size);
+  return p;
+}
+
+void HugePageCPUAllocator::Free(void* p) {
+  size_t mapped_size = 0;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = huge_page_allocations_.find(p);
+    if (it != huge_page_allocations_.end()) {
+      mapped_size = it->second;
+      huge_page_allocations_.erase(it);
+    }
+  }
+
+  if (mapped_size == 0) {
+    CPUAllocator::Free(p);
+    return;
+  }
+
+#if defined(__linux__)
+  munmap(p, mapped_size);
+#elif defined(_WIN32)
+  VirtualFree(p, 0, MEM_RELEASE);
+#endif
+}
+
+}  // namespace onnxruntime
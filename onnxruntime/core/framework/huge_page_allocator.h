@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * CPU allocator that backs the allocations of at least kMinHugePageAllocationSize bytes with huge pages, so that
+ * kernels that stream through large buffers, e.g. the weights of a GEMM, take fewer TLB misses. It is the device
+ * allocator of the CPU arena when kOrtSessionOptionsUseHugePagesForCpuMemory is set, so the arena regions and the
+ * initializers are in huge pages.
+ *
+ * On Linux an allocation first tries pages of the reserved hugetlb pool (1 GB pages for allocations of at least
+ * 1 GB, then 2 MB pages), then transparent huge pages by aligning the memory to 2 MB and advising the kernel with
+ * madvise(MADV_HUGEPAGE). On Windows it allocates large pages, which requires the SeLockMemoryPrivilege.
+ * Smaller allocations, and the ones for which huge pages are not available, use the default CPU allocation.
+ */
+class HugePageCPUAllocator : public CPUAllocator {
+ public:
+  static constexpr size_t kMinHugePageAllocationSize = size_t{2} * 1024 * 1024;
+
+  HugePageCPUAllocator() = default;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+ private:
+  // the sizes of the allocations made with huge pages. the other allocations are freed by the CPUAllocator.
+  OrtMutex mutex_;
+  std::unordered_map<void*, size_t> huge_page_allocations_;
+};
+
+}  // namespace onnxruntime
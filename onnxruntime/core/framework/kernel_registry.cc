@@ -15,8 +15,9 @@
 namespace onnxruntime {
 
 namespace {
+// mismatch_reason is only filled in if it is not null, as building it is costly
 bool IsTypeProtoCompatible(gsl::span<const MLDataType> enabled_types, const ONNX_NAMESPACE::TypeProto& actual_type,
-                           std::string& mismatch_reason) {
+                           std::string* mismatch_reason) {
   const bool is_type_compatible = std::any_of(
       enabled_types.begin(), enabled_types.end(),
       [&actual_type](const DataTypeImpl* expected_type) {
@@ -25,6 +26,9 @@ bool IsTypeProtoCompatible(gsl::span<const MLDataType> enabled_types, const ONNX
       });
 
   if (!is_type_compatible) {
+    if (mismatch_reason == nullptr) {
+      return false;
+    }
     std::ostringstream ostr;
     ostr << "This op has been implemented only for the following types (";
     for (const auto& enabled_type : enabled_types) {
@@ -33,7 +37,7 @@ bool IsTypeProtoCompatible(gsl::span<const MLDataType> enabled_types, const ONNX
     ostr << "),";
     const char* actual_type_str = DataTypeImpl::ToString(DataTypeImpl::TypeFromProto(actual_type));
     ostr << " but the node in the model has the following type (" << actual_type_str << ")";
-    mismatch_reason = ostr.str();
+    *mismatch_reason = ostr.str();
     return false;
   }
 
@@ -44,7 +48,7 @@ bool IsTypeProtoCompatible(gsl::span<const MLDataType> enabled_types, const ONNX
 bool MatchKernelDefTypes(const Node& node,
                          const std::unordered_map<std::string, std::vector<MLDataType>>& kernel_type_constraints,
                          const IKernelTypeStrResolver& kernel_type_str_resolver,
-                         std::string& mismatch_reason) {
+                         std::string* mismatch_reason) {
   const auto actual_inputs = node.InputDefs();
   const auto actual_outputs = node.OutputDefs();
   const auto& actual_input_arg_counts = node.InputArgCount();
@@ -115,9 +119,57 @@ bool MatchKernelDefTypes(const std::unordered_map<std::string, std::vector<MLDat
 
   return match;
 }
+
+// Key of the kernel lookup cache. The kernel matching a node only depends on the op, the provider, the since version
+// and the types of the node's arguments, so that is what the key holds. Returns false if an argument has a type that
+// is not a tensor or a sparse tensor, in which case the lookup is not cached.
+bool GetKernelLookupKey(const Node& node, std::string_view map_key, std::string& key) {
+  auto append_int = [&key](int32_t value) { key.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+  auto append_arg = [&append_int](const NodeArg* arg) {
+    if (!arg->Exists()) {
+      append_int(0);
+      return true;
+    }
+    const ONNX_NAMESPACE::TypeProto* type_proto = arg->TypeAsProto();
+    if (type_proto == nullptr) {
+      return false;
+    }
+    append_int(static_cast<int32_t>(type_proto->value_case()));
+    switch (type_proto->value_case()) {
+      case ONNX_NAMESPACE::TypeProto::kTensorType:
+        append_int(type_proto->tensor_type().elem_type());
+        return true;
+      case ONNX_NAMESPACE::TypeProto::kSparseTensorType:
+        append_int(type_proto->sparse_tensor_type().elem_type());
+        return true;
+      default:
+        return false;
+    }
+  };
+
+  key.assign(map_key).append(1, '\0');
+  append_int(node.SinceVersion());
+  // the variadic input counts change which arguments the type constraints resolve to
+  for (const int count : node.InputArgCount()) {
+    append_int(count);
+  }
+  append_int(-1);
+  for (const NodeArg* arg : node.InputDefs()) {
+    if (!append_arg(arg)) {
+      return false;
+    }
+  }
+  append_int(-1);
+  for (const NodeArg* arg : node.OutputDefs()) {
+    if (!append_arg(arg)) {
+      return false;
+    }
+  }
+  return true;
+}
 }  // namespace
 
-static bool VerifyVersion(int since_ver, const KernelDef& kernel_def, std::string& error_str) {
+static bool VerifyVersion(int since_ver, const KernelDef& kernel_def, std::string* error_str) {
   // check if version matches
   int kernel_start_version;
   int kernel_end_version;
@@ -132,13 +184,13 @@ static bool VerifyVersion(int since_ver, const KernelDef& kernel_def, std::strin
       (kernel_end_version != INT_MAX &&
        kernel_start_version <= since_ver && kernel_end_version >= since_ver);
 
-  if (!valid_version) {
+  if (!valid_version && error_str != nullptr) {
     std::ostringstream ostr;
     ostr << " Version mismatch."
          << " node_version: " << since_ver
          << " kernel start version: " << kernel_start_version
          << " kernel_end_version: " << kernel_end_version;
-    error_str = ostr.str();
+    *error_str = ostr.str();
   }
   return valid_version;
 }
@@ -147,7 +199,7 @@ bool KernelRegistry::VerifyKernelDef(const Node& node,
                                      const KernelDef& kernel_def,
                                      const IKernelTypeStrResolver* kernel_type_str_resolver,
                                      const TypeConstraintMap* type_constraint_values,
-                                     std::string& error_str) {
+                                     std::string* error_str) {
   // check if version matches
   bool valid_version = VerifyVersion(node.SinceVersion(), kernel_def, error_str);
 
@@ -160,15 +212,15 @@ bool KernelRegistry::VerifyKernelDef(const Node& node,
 
   bool matched = type_constraint_values ? MatchKernelDefTypes(kernel_type_constraints, *type_constraint_values)
                                         : MatchKernelDefTypes(node, kernel_type_constraints, *kernel_type_str_resolver,
-                                                              mismatch_reason);
+                                                              error_str != nullptr ? &mismatch_reason : nullptr);
 
-  if (!matched) {
+  if (!matched && error_str != nullptr) {
     std::ostringstream ostr;
     ostr << "Kernel found kernel"
          << " in the supported version range"
          << " (node_version: " << node.SinceVersion() << ")."
          << " However the types are incompatible. " << mismatch_reason;
-    error_str = ostr.str();
+    *error_str = ostr.str();
   }
 
   return matched;
@@ -187,20 +239,44 @@ Status KernelRegistry::TryFindKernelImpl(const Node& node,
   const auto& node_provider = node.GetExecutionProviderType();
   const auto& expected_provider = (node_provider.empty() ? exec_provider : node_provider);
 
-  auto range = kernel_creator_fn_map_.equal_range(GetMapKey(node.OpType(), node.Domain(), expected_provider));
+  const std::string map_key = GetMapKey(node.OpType(), node.Domain(), expected_provider);
   if (out) *out = nullptr;
 
-  std::vector<std::string> verify_kernel_def_error_strs;
+  // a session looks up the kernels of every node several times, and the nodes of a model mostly repeat a few
+  // signatures, so the matches are cached
+  std::string lookup_key;
+  if (kernel_type_str_resolver != nullptr && GetKernelLookupKey(node, map_key, lookup_key)) {
+    std::lock_guard<OrtMutex> lock(kernel_lookup_cache_mutex_);
+    auto cached = kernel_lookup_cache_.find(lookup_key);
+    if (cached != kernel_lookup_cache_.end()) {
+      if (out) {
+        *out = cached->second;
+      }
+      return Status::OK();
+    }
+  } else {
+    lookup_key.clear();
+  }
 
+  auto range = kernel_creator_fn_map_.equal_range(map_key);
   for (auto i = range.first; i != range.second; ++i) {
-    std::string error_str;
-    if (VerifyKernelDef(node, *i->second.kernel_def, kernel_type_str_resolver, type_constraints, error_str)) {
+    if (VerifyKernelDef(node, *i->second.kernel_def, kernel_type_str_resolver, type_constraints, nullptr)) {
+      if (!lookup_key.empty()) {
+        std::lock_guard<OrtMutex> lock(kernel_lookup_cache_mutex_);
+        kernel_lookup_cache_.emplace(std::move(lookup_key), &i->second);
+      }
       if (out) {
         *out = &i->second;
       }
       return Status::OK();
     }
+  }
 
+  // no match. check the candidates again to report why they don't match.
+  std::vector<std::string> verify_kernel_def_error_strs;
+  for (auto i = range.first; i != range.second; ++i) {
+    std::string error_str;
+    VerifyKernelDef(node, *i->second.kernel_def, kernel_type_str_resolver, type_constraints, &error_str);
     verify_kernel_def_error_strs.push_back(error_str);
   }
 
@@ -237,7 +313,7 @@ Status KernelRegistry::TryFindKernel(const Node& node, ProviderType exec_provide
 static bool KernelDefCompatible(int version, const KernelDef& kernel_def,
                                 const KernelRegistry::TypeConstraintMap& type_constraint_values,
                                 std::string& error_str) {
-  if (!VerifyVersion(version, kernel_def, error_str)) {
+  if (!VerifyVersion(version, kernel_def, &error_str)) {
     return false;
   }
 
@@ -323,6 +399,10 @@ Status KernelRegistry::Register(KernelCreateInfo&& create_info) {
   // Register the kernel.
   // Ownership of the KernelDef is transferred to kernel_creator_fn_map_.
   kernel_creator_fn_map_.emplace(key, std::move(create_info));
+
+  // the new kernel may match nodes that matched another kernel before
+  std::lock_guard<OrtMutex> lock(kernel_lookup_cache_mutex_);
+  kernel_lookup_cache_.clear();
   return Status::OK();
 }
 
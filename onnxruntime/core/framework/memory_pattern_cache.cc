@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/memory_pattern_cache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#if !defined(ORT_MINIMAL_BUILD)
+#include "nlohmann/json.hpp"
+using json = nlohmann::json;
+#endif
+
+namespace onnxruntime {
+
+#if !defined(ORT_MINIMAL_BUILD)
+namespace {
+constexpr int kCacheVersion = 1;
+}  // namespace
+
+Status MemoryPatternCache::Save(const PathString& path, uint64_t fingerprint,
+                                const InlinedHashMap<int64_t, const MemoryPatternGroup*>& pattern_groups) {
+  json groups = json::array();
+  for (const auto& [key, group] : pattern_groups) {
+    json locations = json::array();
+    for (const auto& location : group->locations) {
+      locations.push_back({static_cast<int>(location.Type()), static_cast<int>(location.MemType()),
+                           static_cast<int>(location.Id())});
+    }
+
+    json patterns = json::array();
+    for (const auto& pattern : group->patterns) {
+      json blocks = json::array();
+      for (const auto& [ml_value_idx, block] : pattern.patterns_) {
+        blocks.push_back({ml_value_idx, block.offset_, block.size_});
+      }
+      patterns.push_back({{"peak_size", pattern.peak_size_}, {"blocks", std::move(blocks)}});
+    }
+
+    groups.push_back({{"key", key}, {"locations", std::move(locations)}, {"patterns", std::move(patterns)}});
+  }
+
+  json cache;
+  cache["version"] = kCacheVersion;
+  // stored as a string as not every json reader handles 64-bit unsigned integers
+  cache["fingerprint"] = std::to_string(fingerprint);
+  cache["groups"] = std::move(groups);
+
+  // write to a temporary file first so a concurrent reader never sees a partially written cache
+  const PathString tmp_path = path + ORT_TSTR(".tmp");
+  {
+    std::ofstream out(tmp_path, std::ios::trunc);
+    ORT_RETURN_IF_NOT(out.is_open(), "Failed to open memory pattern cache file for writing: ", ToUTF8String(tmp_path));
+    out << cache.dump();
+    ORT_RETURN_IF_NOT(out.good(), "Failed to write memory pattern cache file: ", ToUTF8String(tmp_path));
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  ORT_RETURN_IF(ec, "Failed to replace memory pattern cache file ", ToUTF8String(path), ": ", ec.message());
+  return Status::OK();
+}
+
+Status MemoryPatternCache::Load(const PathString& path, uint64_t fingerprint,
+                                NodeHashMap<int64_t, MemoryPatternGroup>& pattern_groups) {
+  std::ifstream in(path);
+  ORT_RETURN_IF_NOT(in.is_open(), "Failed to open memory pattern cache file: ", ToUTF8String(path));
+
+  ORT_TRY {
+    const json cache = json::parse(in);
+    ORT_RETURN_IF_NOT(cache.at("version").get<int>() == kCacheVersion,
+                      "Unsupported memory pattern cache version in ", ToUTF8String(path));
+    ORT_RETURN_IF_NOT(cache.at("fingerprint").get<std::string>() == std::to_string(fingerprint),
+                      "Memory pattern cache ", ToUTF8String(path), " was generated for a different execution plan.");
+
+    NodeHashMap<int64_t, MemoryPatternGroup> loaded;
+    for (const auto& group_json : cache.at("groups")) {
+      MemoryPatternGroup group;
+      for (const auto& location : group_json.at("locations")) {
+        group.locations.emplace_back(static_cast<OrtDevice::DeviceType>(location.at(0).get<int>()),
+                                     static_cast<OrtDevice::MemoryType>(location.at(1).get<int>()),
+                                     static_cast<OrtDevice::DeviceId>(location.at(2).get<int>()));
+      }
+
+      for (const auto& pattern_json : group_json.at("patterns")) {
+        MemoryPattern pattern;
+        pattern.peak_size_ = pattern_json.at("peak_size").get<size_t>();
+        for (const auto& block : pattern_json.at("blocks")) {
+          pattern.patterns_.insert_or_assign(block.at(0).get<int>(),
+                                             MemoryBlock(block.at(1).get<size_t>(), block.at(2).get<size_t>()));
+        }
+        group.patterns.push_back(std::move(pattern));
+      }
+
+      ORT_RETURN_IF_NOT(group.locations.size() == group.patterns.size(),
+                        "Corrupted memory pattern cache file: ", ToUTF8String(path));
+      loaded.emplace(group_json.at("key").get<int64_t>(), std::move(group));
+    }
+
+    for (auto& [key, group] : loaded) {
+      pattern_groups.emplace(key, std::move(group));
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    Status status;
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to parse memory pattern cache file ",
+                               ToUTF8String(path), ": ", ex.what());
+    });
+    return status;
+  }
+
+  return Status::OK();
+}
+
+#else
+
+Status MemoryPatternCache::Save(const PathString& /*path*/, uint64_t /*fingerprint*/,
+                                const InlinedHashMap<int64_t, const MemoryPatternGroup*>& /*pattern_groups*/) {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The memory pattern cache is not supported in this build.");
+}
+
+Status MemoryPatternCache::Load(const PathString& /*path*/, uint64_t /*fingerprint*/,
+                                NodeHashMap<int64_t, MemoryPatternGroup>& /*pattern_groups*/) {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The memory pattern cache is not supported in this build.");
+}
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+#include "core/framework/mem_pattern.h"
+
+namespace onnxruntime {
+
+// Persists the memory patterns generated by a session so that a session created later for the same model,
+// e.g. after a process restart, can allocate the activations of its first Run up front.
+//
+// The patterns are keyed the same way as in SessionState, by a hash of the input shapes. `fingerprint` identifies
+// the execution plan the patterns were generated for; Load fails if it does not match the one stored in the file.
+struct MemoryPatternCache {
+  static Status Save(const PathString& path, uint64_t fingerprint,
+                     const InlinedHashMap<int64_t, const MemoryPatternGroup*>& pattern_groups);
+
+  // Entries that are already present in `pattern_groups` are not overwritten.
+  static Status Load(const PathString& path, uint64_t fingerprint,
+                     NodeHashMap<int64_t, MemoryPatternGroup>& pattern_groups);
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/framework/memory_trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+#include "core/common/path_string.h"
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+
+MemoryTrace::MemoryTrace() : start_(std::chrono::high_resolution_clock::now()) {}
+
+int64_t MemoryTrace::ElapsedUs() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_)
+      .count();
+}
+
+void MemoryTrace::RecordAllocation(int ort_value_idx, size_t bytes, const OrtDevice& device) {
+  const int64_t now = ElapsedUs();
+  std::lock_guard<OrtMutex> lock(mutex_);
+  live_[ort_value_idx] = allocations_.size();
+  allocations_.push_back({ort_value_idx, bytes, device, next_seq_++, kNotFreed, now, -1});
+}
+
+void MemoryTrace::RecordFree(int ort_value_idx) {
+  const int64_t now = ElapsedUs();
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = live_.find(ort_value_idx);
+  if (it == live_.end()) {
+    // not allocated by the frame, e.g. a feed or a buffer shared with another value
+    return;
+  }
+  auto& allocation = allocations_[it->second];
+  allocation.free_seq = next_seq_++;
+  allocation.free_us = now;
+  live_.erase(it);
+}
+
+void MemoryTracer::AddExecution(const MemoryTrace& trace, const SessionState& session_state) {
+  // (seq, allocation index, is allocation) in the order the allocations and frees happened
+  std::vector<std::tuple<size_t, size_t, bool>> events;
+  events.reserve(trace.allocations_.size() * 2);
+  for (size_t i = 0; i < trace.allocations_.size(); ++i) {
+    const auto& allocation = trace.allocations_[i];
+    events.emplace_back(allocation.alloc_seq, i, true);
+    if (allocation.free_seq != MemoryTrace::kNotFreed) {
+      events.emplace_back(allocation.free_seq, i, false);
+    }
+  }
+  std::sort(events.begin(), events.end());
+
+  struct Peak {
+    size_t live_bytes = 0;
+    size_t bytes = 0;
+    size_t seq = 0;
+    int64_t time_us = 0;
+  };
+  std::map<OrtDevice, Peak> device_peaks;
+  for (const auto& [seq, index, is_allocation] : events) {
+    const auto& allocation = trace.allocations_[index];
+    auto& peak = device_peaks[allocation.device];
+    if (is_allocation) {
+      peak.live_bytes += allocation.bytes;
+      if (peak.live_bytes > peak.bytes) {
+        peak.bytes = peak.live_bytes;
+        peak.seq = seq;
+        peak.time_us = allocation.alloc_us;
+      }
+    } else {
+      peak.live_bytes -= allocation.bytes;
+    }
+  }
+
+  size_t total_peak_bytes = 0;
+  for (const auto& entry : device_peaks) {
+    total_peak_bytes += entry.second.bytes;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (total_peak_bytes <= max_total_peak_bytes_) {
+    return;
+  }
+  max_total_peak_bytes_ = total_peak_bytes;
+
+  const auto& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  tensors_.clear();
+  tensors_.reserve(trace.allocations_.size());
+  end_us_ = 0;
+  for (const auto& allocation : trace.allocations_) {
+    TensorRecord record{"", "", "", allocation.bytes, allocation.device, allocation.alloc_seq, allocation.free_seq,
+                        allocation.alloc_us, allocation.free_us};
+    if (name_idx_map.GetName(allocation.ort_value_idx, record.name).IsOK()) {
+      if (const Node* producer = graph_viewer.GetProducerNode(record.name)) {
+        record.node_name = producer->Name();
+        record.op_type = producer->OpType();
+      }
+    }
+    end_us_ = std::max(end_us_, std::max(allocation.alloc_us, allocation.free_us));
+    tensors_.push_back(std::move(record));
+  }
+
+  peaks_.clear();
+  for (const auto& [device, peak] : device_peaks) {
+    DevicePeak device_peak{device, peak.bytes, peak.time_us, {}};
+    for (size_t i = 0; i < tensors_.size(); ++i) {
+      const auto& tensor = tensors_[i];
+      if (tensor.device == device && tensor.alloc_seq <= peak.seq && tensor.free_seq > peak.seq) {
+        device_peak.top_tensors.push_back(i);
+      }
+    }
+    std::stable_sort(device_peak.top_tensors.begin(), device_peak.top_tensors.end(),
+                     [this](size_t a, size_t b) { return tensors_[a].bytes > tensors_[b].bytes; });
+    if (device_peak.top_tensors.size() > top_n_) {
+      device_peak.top_tensors.resize(top_n_);
+    }
+    peaks_.push_back(std::move(device_peak));
+  }
+}
+
+std::string MemoryTracer::ToChromeTrace() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  auto tensor_args = [](std::ostringstream& ss, const TensorRecord& tensor) {
+    ss << "\"bytes\":" << tensor.bytes << ",\"node\":\"" << tensor.node_name << "\",\"op_type\":\""
+       << tensor.op_type << "\"";
+  };
+
+  // one process per device, with the live bytes as a counter and the lifetimes of its tensors as slices
+  std::map<OrtDevice, int> device_pids;
+  for (const auto& tensor : tensors_) {
+    device_pids.emplace(tensor.device, static_cast<int>(device_pids.size()));
+  }
+
+  std::ostringstream ss;
+  ss << "{\"traceEvents\":[";
+  bool first = true;
+  auto separator = [&]() {
+    if (!first) {
+      ss << ",\n";
+    }
+    first = false;
+  };
+
+  for (const auto& [device, pid] : device_pids) {
+    separator();
+    ss << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"args\":{\"name\":\""
+       << device.ToString() << "\"}}";
+  }
+
+  std::vector<std::tuple<size_t, size_t, bool>> events;
+  for (size_t i = 0; i < tensors_.size(); ++i) {
+    events.emplace_back(tensors_[i].alloc_seq, i, true);
+    if (tensors_[i].free_seq != MemoryTrace::kNotFreed) {
+      events.emplace_back(tensors_[i].free_seq, i, false);
+    }
+  }
+  std::sort(events.begin(), events.end());
+  std::map<OrtDevice, size_t> live_bytes;
+  for (const auto& [seq, index, is_allocation] : events) {
+    const auto& tensor = tensors_[index];
+    auto& live = live_bytes[tensor.device];
+    live = is_allocation ? live + tensor.bytes : live - tensor.bytes;
+    separator();
+    ss << "{\"name\":\"live_bytes\",\"ph\":\"C\",\"pid\":" << device_pids[tensor.device]
+       << ",\"ts\":" << (is_allocation ? tensor.alloc_us : tensor.free_us) << ",\"args\":{\"bytes\":" << live
+       << "}}";
+  }
+
+  for (const auto& tensor : tensors_) {
+    // the tensors that are not freed are fetches, which live until the end of the execution
+    const int64_t free_us = tensor.free_seq != MemoryTrace::kNotFreed ? tensor.free_us : end_us_;
+    separator();
+    ss << "{\"name\":\"" << tensor.name << "\",\"cat\":\"tensor\",\"ph\":\"X\",\"pid\":"
+       << device_pids[tensor.device] << ",\"tid\":0,\"ts\":" << tensor.alloc_us
+       << ",\"dur\":" << free_us - tensor.alloc_us << ",\"args\":{";
+    tensor_args(ss, tensor);
+    ss << "}}";
+  }
+  ss << "],\n";
+
+  ss << "\"peakMemory\":[";
+  for (size_t p = 0; p < peaks_.size(); ++p) {
+    const auto& peak = peaks_[p];
+    ss << (p == 0 ? "" : ",") << "{\"device\":\"" << peak.device.ToString() << "\",\"bytes\":" << peak.bytes
+       << ",\"ts\":" << peak.time_us << ",\"top_tensors\":[";
+    for (size_t i = 0; i < peak.top_tensors.size(); ++i) {
+      const auto& tensor = tensors_[peak.top_tensors[i]];
+      ss << (i == 0 ? "" : ",") << "{\"name\":\"" << tensor.name << "\",";
+      tensor_args(ss, tensor);
+      ss << "}";
+    }
+    ss << "]}";
+  }
+  ss << "]}\n";
+  return ss.str();
+}
+
+Status MemoryTracer::WriteToFile(const std::string& path) const {
+  std::ofstream file(ToPathString(path), std::ios::out | std::ios::trunc);
+  ORT_RETURN_IF_NOT(file, "Failed to open the memory trace file ", path);
+  file << ToChromeTrace();
+  ORT_RETURN_IF_NOT(file, "Failed to write the memory trace file ", path);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/ortdevice.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class SessionState;
+
+/**
+ * The tensors allocated by one execution of a graph, with the order they were allocated and freed in.
+ * Recorded by the ExecutionFrame if the session has a MemoryTracer.
+ */
+class MemoryTrace {
+ public:
+  MemoryTrace();
+
+  // thread-safe, the parallel executor allocates from multiple threads
+  void RecordAllocation(int ort_value_idx, size_t bytes, const OrtDevice& device);
+  void RecordFree(int ort_value_idx);
+
+ private:
+  friend class MemoryTracer;
+
+  static constexpr size_t kNotFreed = std::numeric_limits<size_t>::max();
+
+  struct Allocation {
+    int ort_value_idx;
+    size_t bytes;
+    OrtDevice device;
+    // position in the sequence of the allocations and frees of the execution
+    size_t alloc_seq;
+    size_t free_seq;
+    int64_t alloc_us;
+    int64_t free_us;
+  };
+
+  int64_t ElapsedUs() const;
+
+  TimePoint start_;
+  OrtMutex mutex_;
+  size_t next_seq_{0};
+  std::vector<Allocation> allocations_;
+  // ort value index -> index in allocations_ of the tensors that were not freed yet
+  InlinedHashMap<int, size_t> live_;
+};
+
+/**
+ * Keeps the MemoryTrace of the execution with the highest peak memory and exports it as a Chrome trace, with
+ * the live bytes per device over time, the lifetime of each tensor, and the largest tensors that are live at the
+ * peak of each device.
+ * see kOrtSessionOptionsMemoryTraceFile
+ */
+class MemoryTracer {
+ public:
+  explicit MemoryTracer(size_t top_n) : top_n_(top_n) {}
+
+  void AddExecution(const MemoryTrace& trace, const SessionState& session_state);
+
+  std::string ToChromeTrace() const;
+
+  Status WriteToFile(const std::string& path) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryTracer);
+
+  struct TensorRecord {
+    std::string name;
+    std::string node_name;
+    std::string op_type;
+    size_t bytes;
+    OrtDevice device;
+    size_t alloc_seq;
+    size_t free_seq;
+    int64_t alloc_us;
+    int64_t free_us;
+  };
+
+  struct DevicePeak {
+    OrtDevice device;
+    size_t bytes;
+    int64_t time_us;
+    // indexes in tensors_ of the largest tensors live at the peak
+    std::vector<size_t> top_tensors;
+  };
+
+  const size_t top_n_;
+
+  mutable OrtMutex mutex_;
+  size_t max_total_peak_bytes_{0};
+  std::vector<TensorRecord> tensors_;
+  std::vector<DevicePeak> peaks_;
+  int64_t end_us_{0};
+};
+
+}  // namespace onnxruntime
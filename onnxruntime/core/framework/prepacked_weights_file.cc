@@ -0,0 +1,199 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_file.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/safeint.h"
+
+namespace onnxruntime {
+
+namespace {
+// File layout, all integers in native byte order:
+//   header:  magic[8], uint64 ISA signature, uint64 number of entries
+//   entries: uint32 key length, key, uint32 number of buffers, then uint64 offset and uint64 size per buffer
+//   data:    the buffers, each at an offset aligned to kBufferAlignment
+constexpr char kMagic[8] = {'O', 'R', 'T', 'P', 'P', 'W', '0', '1'};
+constexpr size_t kBufferAlignment = 64;
+
+size_t AlignUp(size_t offset) {
+  return (offset + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+class Reader {
+ public:
+  Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  Status Read(T& value) {
+    ORT_RETURN_IF(size_ - offset_ < sizeof(T), "Unexpected end of pre-packed weights file.");
+    std::memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return Status::OK();
+  }
+
+  Status ReadString(size_t length, std::string& value) {
+    ORT_RETURN_IF(size_ - offset_ < length, "Unexpected end of pre-packed weights file.");
+    value.assign(data_ + offset_, length);
+    offset_ += length;
+    return Status::OK();
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+template <typename T>
+void Write(std::ostream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+}  // namespace
+
+uint64_t PrepackedWeightsFile::CurrentCpuIsaSignature() {
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  const bool features[] = {
+      cpu_info.HasSSE3(), cpu_info.HasSSE4_1(), cpu_info.HasAVX(), cpu_info.HasAVX2(), cpu_info.HasF16C(),
+      cpu_info.HasAVX512f(), cpu_info.HasAVX512Skylake(), cpu_info.HasAVX512_BF16(), cpu_info.HasAMX_BF16(),
+      cpu_info.HasArmNeonDot(), cpu_info.HasArmNeon_I8MM(), cpu_info.HasArmSVE_I8MM(), cpu_info.HasArmNeon_BF16(),
+      cpu_info.HasFp16VectorAcceleration()};
+
+  uint64_t signature = 0;
+  for (size_t i = 0; i < sizeof(features) / sizeof(features[0]); ++i) {
+    signature |= static_cast<uint64_t>(features[i]) << i;
+  }
+  return signature;
+}
+
+Status PrepackedWeightsFile::Load(const Env& env, const PathString& path, std::unique_ptr<PrepackedWeightsFile>& file) {
+  std::error_code ec;
+  const auto file_size = std::filesystem::file_size(path, ec);
+  ORT_RETURN_IF(ec, "Failed to get the size of pre-packed weights file ", ToUTF8String(path), ": ", ec.message());
+
+  std::unique_ptr<PrepackedWeightsFile> result{new PrepackedWeightsFile()};
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(path.c_str(), 0, gsl::narrow<size_t>(file_size), result->mapped_file_));
+  const char* data = result->mapped_file_.get();
+  Reader reader(data, gsl::narrow<size_t>(file_size));
+
+  char magic[sizeof(kMagic)];
+  for (auto& c : magic) {
+    ORT_RETURN_IF_ERROR(reader.Read(c));
+  }
+  ORT_RETURN_IF(std::memcmp(magic, kMagic, sizeof(kMagic)) != 0,
+                ToUTF8String(path), " is not a pre-packed weights file of a supported version.");
+
+  uint64_t isa_signature = 0;
+  ORT_RETURN_IF_ERROR(reader.Read(isa_signature));
+  ORT_RETURN_IF(isa_signature != CurrentCpuIsaSignature(),
+                "Pre-packed weights file ", ToUTF8String(path), " was written on a CPU with different instruction sets.");
+
+  uint64_t num_entries = 0;
+  ORT_RETURN_IF_ERROR(reader.Read(num_entries));
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    uint32_t key_length = 0;
+    std::string key;
+    ORT_RETURN_IF_ERROR(reader.Read(key_length));
+    ORT_RETURN_IF_ERROR(reader.ReadString(key_length, key));
+
+    uint32_t num_buffers = 0;
+    ORT_RETURN_IF_ERROR(reader.Read(num_buffers));
+
+    PrePackedWeights weights;
+    for (uint32_t j = 0; j < num_buffers; ++j) {
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      ORT_RETURN_IF_ERROR(reader.Read(offset));
+      ORT_RETURN_IF_ERROR(reader.Read(size));
+      ORT_RETURN_IF(offset > file_size || size > file_size - offset,
+                    "Corrupted pre-packed weights file ", ToUTF8String(path));
+
+      // the mapping owns the memory, so the buffers are not freed individually
+      void* buffer = size == 0 ? nullptr : const_cast<char*>(data) + offset;
+      weights.buffers_.emplace_back(buffer, [](void*) {});
+      weights.buffer_sizes_.push_back(gsl::narrow<size_t>(size));
+    }
+
+    result->weights_.emplace(std::move(key), std::move(weights));
+  }
+
+  file = std::move(result);
+  return Status::OK();
+}
+
+Status PrepackedWeightsFile::Save(const PathString& path,
+                                  const std::vector<std::pair<std::string, const PrePackedWeights*>>& weights) {
+  // compute where the data of each buffer goes
+  SafeInt<size_t> table_size = sizeof(kMagic) + 2 * sizeof(uint64_t);
+  for (const auto& [key, packed] : weights) {
+    table_size += sizeof(uint32_t) + key.size() + sizeof(uint32_t) + packed->buffers_.size() * 2 * sizeof(uint64_t);
+  }
+
+  std::vector<std::vector<size_t>> offsets;
+  offsets.reserve(weights.size());
+  size_t data_end = table_size;
+  for (const auto& [key, packed] : weights) {
+    ORT_RETURN_IF_NOT(packed->buffers_.size() == packed->buffer_sizes_.size(),
+                      "Pre-packed weight ", key, " has mismatched buffers and buffer sizes.");
+    auto& buffer_offsets = offsets.emplace_back();
+    for (size_t size : packed->buffer_sizes_) {
+      data_end = AlignUp(data_end);
+      buffer_offsets.push_back(data_end);
+      data_end = SafeInt<size_t>(data_end) + size;
+    }
+  }
+
+  const PathString tmp_path = path + ORT_TSTR(".tmp");
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(out.is_open(), "Failed to open pre-packed weights file for writing: ", ToUTF8String(tmp_path));
+
+    out.write(kMagic, sizeof(kMagic));
+    Write<uint64_t>(out, CurrentCpuIsaSignature());
+    Write<uint64_t>(out, weights.size());
+    for (size_t i = 0; i < weights.size(); ++i) {
+      const auto& [key, packed] = weights[i];
+      Write<uint32_t>(out, gsl::narrow<uint32_t>(key.size()));
+      out.write(key.data(), key.size());
+      Write<uint32_t>(out, gsl::narrow<uint32_t>(packed->buffers_.size()));
+      for (size_t j = 0; j < packed->buffers_.size(); ++j) {
+        const bool has_data = packed->buffers_[j] != nullptr && packed->buffer_sizes_[j] != 0;
+        Write<uint64_t>(out, offsets[i][j]);
+        Write<uint64_t>(out, has_data ? packed->buffer_sizes_[j] : 0);
+      }
+    }
+
+    size_t position = table_size;
+    for (size_t i = 0; i < weights.size(); ++i) {
+      const auto* packed = weights[i].second;
+      for (size_t j = 0; j < packed->buffers_.size(); ++j) {
+        if (packed->buffers_[j] == nullptr || packed->buffer_sizes_[j] == 0) {
+          continue;
+        }
+        for (; position < offsets[i][j]; ++position) {
+          out.put('\0');
+        }
+        out.write(static_cast<const char*>(packed->buffers_[j].get()), packed->buffer_sizes_[j]);
+        position += packed->buffer_sizes_[j];
+      }
+    }
+
+    ORT_RETURN_IF_NOT(out.good(), "Failed to write pre-packed weights file: ", ToUTF8String(tmp_path));
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  ORT_RETURN_IF(ec, "Failed to replace pre-packed weights file ", ToUTF8String(path), ": ", ec.message());
+  return Status::OK();
+}
+
+const PrePackedWeights* PrepackedWeightsFile::GetWeight(const std::string& key) const {
+  auto it = weights_.find(key);
+  return it == weights_.end() ? nullptr : &it->second;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+// A read-only file of pre-packed weights, shared by the sessions of all processes that run the same model.
+//
+// The file is memory mapped and the buffers of the PrePackedWeights it returns point into the mapping, so the
+// packed weights are backed by the page cache and not duplicated in the private memory of every process.
+// Entries are keyed like the entries of PrepackedWeightsContainer, by op type and hash of the packed buffers.
+// The file also records the instruction sets of the CPU it was written on, and is ignored on a CPU with
+// different ones as its packed layouts are unlikely to match.
+class PrepackedWeightsFile {
+ public:
+  // Maps the file at `path`. Returns a non-OK status if the file can't be read, is corrupted or was written on a
+  // CPU with different instruction sets.
+  static Status Load(const Env& env, const PathString& path, std::unique_ptr<PrepackedWeightsFile>& file);
+
+  // Writes `weights` to `path`. The file is written to a temporary path and renamed, so processes that have the
+  // previous version of the file mapped are not affected.
+  static Status Save(const PathString& path,
+                     const std::vector<std::pair<std::string, const PrePackedWeights*>>& weights);
+
+  // Returns nullptr if the file has no entry for `key`.
+  const PrePackedWeights* GetWeight(const std::string& key) const;
+
+  size_t GetNumberOfElements() const { return weights_.size(); }
+
+  template <typename Func>
+  void ForEachWeight(Func&& func) const {
+    for (const auto& [key, weights] : weights_) {
+      func(key, weights);
+    }
+  }
+
+  // Identifies the instruction sets of the current CPU that affect the layout of packed weights.
+  static uint64_t CurrentCpuIsaSignature();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsFile);
+
+ private:
+  PrepackedWeightsFile() = default;
+
+  // declared before weights_ so the buffers are released before the mapping
+  Env::MappedMemoryPtr mapped_file_;
+  std::unordered_map<std::string, PrePackedWeights> weights_;
+};
+
+}  // namespace onnxruntime
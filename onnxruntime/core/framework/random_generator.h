@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <stdint.h>
 #include <utility>
@@ -84,4 +85,51 @@ class PhiloxGenerator {
   uint64_t offset_;
 };
 
+/**
+ * Philox4x32-10 random number engine for the CPU, see "Parallel Random Numbers: As Easy as 1, 2, 3"
+ * (Salmon et al., SC 2011). It maps a key and a counter to 4 random 32-bit values, so any block of a sequence can be
+ * generated independently of the others. The key is the seed and the counter is the offset of the block in the
+ * sequence, as returned by PhiloxGenerator::NextPhiloxSeeds().
+ */
+class Philox4x32 {
+ public:
+  static std::array<uint32_t, 4> Generate(uint64_t key, uint64_t counter) {
+    uint32_t k0 = static_cast<uint32_t>(key);
+    uint32_t k1 = static_cast<uint32_t>(key >> 32);
+    std::array<uint32_t, 4> c = {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 0, 0};
+
+    for (int round = 0; round < 10; round++) {
+      const uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * c[0];
+      const uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * c[2];
+      c = {static_cast<uint32_t>(product1 >> 32) ^ c[1] ^ k0, static_cast<uint32_t>(product1),
+           static_cast<uint32_t>(product0 >> 32) ^ c[3] ^ k1, static_cast<uint32_t>(product0)};
+      k0 += kWeyl0;
+      k1 += kWeyl1;
+    }
+
+    return c;
+  }
+
+  /**
+   * Converts a random value to a float in [0, 1).
+   */
+  static float ToUniformFloat(uint32_t value) {
+    return static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+  }
+
+  /**
+   * Converts two random values to a double in [0, 1).
+   */
+  static double ToUniformDouble(uint32_t high, uint32_t low) {
+    const uint64_t value = (static_cast<uint64_t>(high) << 32 | low) >> 11;
+    return static_cast<double>(value) * (1.0 / 9007199254740992.0);
+  }
+
+ private:
+  static constexpr uint32_t kMultiplier0 = 0xD2511F53;
+  static constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+};
+
 }  // namespace onnxruntime
@@ -71,3 +71,9 @@ ORT_API_STATUS_IMPL(OrtApis::RunOptionsAddActiveLoraAdapter, _Inout_ OrtRunOptio
   return nullptr;
   API_IMPL_END
 }
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetLoraAdapterCache, _Inout_ OrtRunOptions* options,
+                    _In_opt_ OrtLoraAdapterCache* cache) {
+  options->lora_adapter_cache = reinterpret_cast<onnxruntime::lora::LoraAdapterCache*>(cache);
+  return nullptr;
+}
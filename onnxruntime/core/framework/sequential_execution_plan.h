@@ -156,6 +156,10 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // indexed by node index
   // elements in node_release_list[i] is the index in release_actions.
   std::vector<std::vector<size_t>> node_release_list;
+  // node_release_list stored contiguously, as read by the executor after each kernel: the release actions of node i
+  // are node_release_actions[node_release_offsets[i]] to node_release_actions[node_release_offsets[i + 1] - 1].
+  std::vector<size_t> node_release_offsets;
+  std::vector<size_t> node_release_actions;
   // for each notification, what is the stream-idx of the its owner.
   std::vector<size_t> notification_owners;
   // key: notification index.
@@ -165,6 +169,27 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
 
   size_t num_barriers{0};
 
+  // Dependencies between the steps of a plan with a single CPU logic stream, used in parallel execution mode to
+  // dispatch each node on the inter-op thread pool as soon as its producers have completed instead of running the
+  // stream in order. Indices refer to execution_plan[0]->steps_. Empty if the plan is executed stream by stream.
+  struct DynamicSchedule {
+    // number of distinct producer steps each step waits on
+    std::vector<int32_t> num_producers;
+    // steps to notify when a step completes
+    std::vector<InlinedVector<size_t>> consumers;
+    // steps without producers in the stream
+    InlinedVector<size_t> roots;
+
+    bool Empty() const { return num_producers.empty(); }
+  };
+
+  DynamicSchedule dynamic_schedule;
+
+  // The node of each step of a plan with a single logic stream whose steps are all kernel launches, e.g. a CPU only
+  // session, so the executor runs the kernels in a loop instead of going through the virtual ExecutionStep::Execute.
+  // Indices refer to execution_plan[0]->steps_. Empty if the plan has other steps.
+  std::vector<NodeIndex> kernel_launch_nodes;
+
 #ifdef ENABLE_TRAINING
   InlinedVector<NodeIndex> node_execution_order_in_training;
   InlinedHashMap<NodeIndex, size_t> node_index_2_toposort_index;
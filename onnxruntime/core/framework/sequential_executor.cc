@@ -180,6 +180,8 @@ class SessionScope {
       session_start_ = session_state.Profiler().Start();
     }
 
+    sample_node_latency_ = session_state_.Profiler().GetNodeLatencyStats().SampleExecution();
+
     auto& logger = session_state_.Logger();
     VLOGS(logger, 0) << "Begin execution";
     const SequentialExecutionPlan& seq_exec_plan = *session_state_.GetExecutionPlan();
@@ -250,6 +252,8 @@ class SessionScope {
  private:
   const SessionState& session_state_;
   TimePoint session_start_;
+  // whether the kernel latencies of this execution are recorded into the node latency stats
+  bool sample_node_latency_{false};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
   // Whether memory profiler need create events and flush to file.
@@ -336,10 +340,19 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
+    if (session_scope_.sample_node_latency_) {
+      node_latency_histogram_ = session_state_.GetNodeLatencyHistogram(kernel.Node().Index());
+      if (node_latency_histogram_ != nullptr) {
+        node_latency_start_ = std::chrono::steady_clock::now();
+      }
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
-      concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
+      concurrency::ThreadPool::StartProfiling(
+          session_state_.GetThreadPool(),
+          session_state_.Profiler().GetTraceFormat() == profiling::TraceFormat::kTimeline);
       VLOGS(session_state_.Logger(), 1) << "Computing kernel: " << node_name_;
       kernel_begin_time_ = session_state_.Profiler().Start();
       CalculateTotalInputSizes(&kernel_context, &kernel_,
@@ -355,12 +368,22 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
+    if (node_latency_histogram_ != nullptr) {
+      const auto elapsed = std::chrono::steady_clock::now() - node_latency_start_;
+      node_latency_histogram_->Record(
+          static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& profiler = session_state_.Profiler();
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
+      const std::string event_name = node_name_ + "_kernel_time";
+      std::vector<concurrency::ThreadPoolTaskSpan> task_spans;
+      const std::string thread_scheduling_stats =
+          concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool(), &task_spans);
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                     node_name_ + "_kernel_time",
+                                     event_name,
                                      kernel_begin_time_,
                                      // Log additional operation args / info.
                                      {
@@ -372,9 +395,11 @@ class KernelScope {
                                          {"output_size", std::to_string(total_output_sizes_)},
                                          {"input_type_shape", input_type_shape_},
                                          {"output_type_shape", output_type_shape_},
-                                         {"thread_scheduling_stats",
-                                          concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
+                                         {"thread_scheduling_stats", thread_scheduling_stats},
                                      });
+      if (!task_spans.empty()) {
+        profiler.RecordThreadPoolTasks(event_name, kernel_begin_time_, task_spans);
+      }
     }
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
@@ -404,6 +429,9 @@ class KernelScope {
   OpKernelContextInternal& kernel_context_;
   const OpKernel& kernel_;
 
+  profiling::LatencyHistogram* node_latency_histogram_{nullptr};
+  std::chrono::steady_clock::time_point node_latency_start_;
+
   size_t input_activation_sizes_{};
   size_t input_parameter_sizes_{};
   size_t total_output_sizes_{};
@@ -437,6 +465,7 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     ctx.RecycleNodeInputs(idx);
     return Status::OK();
   }
+  ORT_RETURN_IF_ERROR(ctx.GetSessionState().LoadLazyInitializers(idx));
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
@@ -567,17 +596,29 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 
   auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
 
-  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
-    if (execution_plan->execution_plan[i]->steps_.empty()) {
-      // execution context is initialized with number of valid streams
-      // for invalid stream (0 steps), it doesn't count in number of tasks
-      // so don't need to invoke CompleteTask here
-      // ctx.CompleteTask();
-    } else {
-      concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
-        RunSince(i, ctx, session_scope, terminate_flag, 0);
+  if (tp && !execution_plan->dynamic_schedule.Empty()) {
+    // dispatch the nodes by dependency instead of running the single stream in order.
+    // each root is a task, the initial task of the stream is completed once they are all scheduled.
+    for (auto root : execution_plan->dynamic_schedule.roots) {
+      ctx.AddTask();
+      concurrency::ThreadPool::Schedule(tp, [root, &ctx, &terminate_flag, &session_scope]() {
+        RunDynamic(ctx, session_scope, terminate_flag, root);
       });
     }
+    ctx.CompleteTask();
+  } else {
+    for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+      if (execution_plan->execution_plan[i]->steps_.empty()) {
+        // execution context is initialized with number of valid streams
+        // for invalid stream (0 steps), it doesn't count in number of tasks
+        // so don't need to invoke CompleteTask here
+        // ctx.CompleteTask();
+      } else {
+        concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
+          RunSince(i, ctx, session_scope, terminate_flag, 0);
+        });
+      }
+    }
   }
 
   ctx.WaitAll();
@@ -596,6 +637,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
       MemoryPatternGroup mem_patterns;
       ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GeneratePatterns(mem_patterns));
       ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+      session_state.UpdateSymbolicMemoryPlanner(feed_mlvalue_idxs, feeds,
+                                                ctx.GetExecutionFrame().GetMemoryPatternTrace());
     }
   }
 
@@ -3,13 +3,18 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
+#include "core/framework/memory_pattern_cache.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
@@ -89,6 +94,33 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  const std::string frame_pool_size =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigExecutionFramePoolSize, "0");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(frame_pool_size, execution_frame_pool_size_),
+              "Invalid value for ", kOrtSessionOptionsConfigExecutionFramePoolSize, ": ", frame_pool_size);
+
+  // the memory patterns of a subgraph are traced per execution of the subgraph
+  enable_symbolic_memory_planning_ =
+      graph_.ParentNode() == nullptr &&
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSymbolicMemoryPlanning, "0") == "1";
+
+  const std::string pattern_cache_size =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheSize, "0");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(pattern_cache_size, memory_pattern_cache_size_),
+              "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternCacheSize, ": ", pattern_cache_size);
+
+  std::istringstream dim_buckets(
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternDimBuckets, ""));
+  std::string dim_bucket;
+  while (std::getline(dim_buckets, dim_bucket, ',')) {
+    int64_t bucket = 0;
+    ORT_ENFORCE(TryParseStringWithClassicLocale(dim_bucket, bucket) && bucket > 0,
+                "Invalid bucket in ", kOrtSessionOptionsConfigMemoryPatternDimBuckets, ": ", dim_bucket);
+    memory_pattern_dim_buckets_.push_back(bucket);
+  }
+  std::sort(memory_pattern_dim_buckets_.begin(), memory_pattern_dim_buckets_.end());
+  memory_pattern_dim_buckets_.erase(std::unique(memory_pattern_dim_buckets_.begin(), memory_pattern_dim_buckets_.end()),
+                                    memory_pattern_dim_buckets_.end());
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -235,6 +267,15 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       // assumes vector is already resize()'ed to the number of nodes in the graph
       ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
     }
+
+    auto& node_latency_stats = profiler_.GetNodeLatencyStats();
+    if (node_latency_stats.IsEnabled()) {
+      node_latency_histograms_.assign(max_nodeid + 1, nullptr);
+      for (const auto& node : nodes) {
+        node_latency_histograms_[node.Index()] =
+            node_latency_stats.GetHistogram(node.OpType(), node.GetExecutionProviderType());
+      }
+    }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
   return Status::OK();
@@ -316,6 +357,44 @@ const std::unordered_map<int, OrtValue>& SessionState::GetConstantInitializedTen
   return constant_initialized_tensors_;
 }
 
+Status SessionState::LoadLazyInitializers(NodeIndex node_index) const {
+  if (lazy_node_inputs_.empty()) {
+    return Status::OK();
+  }
+
+  auto it = lazy_node_inputs_.find(node_index);
+  if (it == lazy_node_inputs_.end()) {
+    return Status::OK();
+  }
+
+  // the kernel isn't run before this completes, so it can be pre-packed like during initialization
+  LazyNodeInputs& node_inputs = *it->second;
+  std::call_once(node_inputs.load_flag, [this, node_index, &node_inputs]() {
+    ORT_TRY {
+      node_inputs.load_status = [&]() -> Status {
+        OpKernel* kernel = session_kernels_[node_index].get();
+        for (const auto& [input_index, lazy_initializer] : node_inputs.inputs) {
+          ORT_RETURN_IF_ERROR(lazy_initializer->Load());
+          if (input_index >= 0 && prepack_lazy_initializers_ && lazy_initializer->IsConstant()) {
+            bool is_packed = false;
+            AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+            ORT_RETURN_IF_ERROR(kernel->PrePack(lazy_initializer->Value().Get<Tensor>(), input_index,
+                                                session_cpu_alloc, is_packed, nullptr));
+          }
+        }
+        return Status::OK();
+      }();
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        node_inputs.load_status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+      });
+    }
+  });
+
+  return node_inputs.load_status;
+}
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 bool SessionState::IsSparseInitializer(int ort_value_index) const {
   return sparse_initialized_tensors_.count(ort_value_index) > 0;
@@ -421,9 +500,11 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
                 auto iter = initializers_to_share_map.find(input_name);
                 bool is_shared_initializer = (iter != initializers_to_share_map.end());
 
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP and the
+                // XNNPACK EP, whose pre-packed weights are in CPU memory, for now
                 if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
+                    (node.GetExecutionProviderType() == kCpuExecutionProvider ||
+                     node.GetExecutionProviderType() == kXnnpackExecutionProvider)) {  // caching of pre-packed weights' turned ON
 
                   AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
                   ORT_ENFORCE(allocator_for_caching.get() != nullptr);
@@ -478,6 +559,21 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
                     }
                   }
 
+                } else if (!prepacked_weights_cache_file_.empty() &&
+                           node.GetExecutionProviderType() == kCpuExecutionProvider) {  // sharing through a file
+                  AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                  PrePackedWeights weights_to_be_filled_in;
+                  // PrePack() is still invoked as kernels initialize other state in it and the key is the hash of
+                  // the packed weight.
+                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
+                                                      is_packed,
+                                                      &weights_to_be_filled_in));
+
+                  // kernels that can't share their pre-packed weights keep them and don't fill in any buffers
+                  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                    ORT_RETURN_IF_ERROR(UsePrepackedWeightsCacheFile(node, input_idx,
+                                                                     std::move(weights_to_be_filled_in)));
+                  }
                 } else {  // caching of pre-packed weights' turned OFF
                   AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
                   ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
@@ -525,12 +621,118 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
+Status SessionState::UsePrepackedWeightsCacheFile(const Node& node, int input_idx, PrePackedWeights&& weights) {
+  const std::string key = GenerateKeyForPrepackedWeightsMap(node.OpType(), weights);
+
+  const PrePackedWeights* shared_weights = prepacked_weights_file_ ? prepacked_weights_file_->GetWeight(key) : nullptr;
+  if (shared_weights != nullptr) {
+    LOGS(logger_, INFO) << "Using pre-packed weight from the cache file for the node: " << node.Name();
+    ++used_shared_pre_packed_weights_counter_;
+  } else {
+    // another kernel of this session may have packed the same weight already
+    shared_weights = &prepacked_weights_for_cache_file_.emplace(key, std::move(weights)).first->second;
+  }
+
+  return KernelUseSharedPrePackedBuffers(*GetMutableKernel(node.Index()), input_idx, *shared_weights, node.Name());
+}
+
+void SessionState::LoadPrepackedWeightsCacheFile() {
+  std::error_code ec;
+  if (!std::filesystem::exists(prepacked_weights_cache_file_, ec)) {
+    return;
+  }
+
+  auto status = PrepackedWeightsFile::Load(Env::Default(), prepacked_weights_cache_file_, prepacked_weights_file_);
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << "Ignoring the pre-packed weights cache file: " << status.ErrorMessage();
+    prepacked_weights_file_.reset();
+  }
+}
+
+void SessionState::SavePrepackedWeightsCacheFile() const {
+  if (prepacked_weights_for_cache_file_.empty()) {
+    return;
+  }
+
+  // keep the weights of the current file, the file may be shared by sessions of different models
+  std::vector<std::pair<std::string, const PrePackedWeights*>> weights;
+  if (prepacked_weights_file_) {
+    prepacked_weights_file_->ForEachWeight([&weights](const std::string& key, const PrePackedWeights& value) {
+      weights.emplace_back(key, &value);
+    });
+  }
+  for (const auto& [key, value] : prepacked_weights_for_cache_file_) {
+    weights.emplace_back(key, &value);
+  }
+
+  auto status = PrepackedWeightsFile::Save(prepacked_weights_cache_file_, weights);
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << "Failed to write the pre-packed weights cache file: " << status.ErrorMessage();
+  }
+}
+
+static int64_t RoundUpToDimBucket(int64_t dim, gsl::span<const int64_t> dim_buckets) {
+  auto bucket = std::lower_bound(dim_buckets.begin(), dim_buckets.end(), dim);
+  // dims larger than the last bucket are kept as they are
+  return bucket != dim_buckets.end() ? *bucket : dim;
+}
+
+static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs,
+                                          gsl::span<const int64_t> dim_buckets) {
   int64_t key = 0;
+  if (dim_buckets.empty()) {
+    for (const auto& input : tensor_inputs) {
+      for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+    }
+    return key;
+  }
+
+  // the bucketed dims repeat a lot, e.g. {64, 64} and {128, 128}, so they are hashed with the ranks instead of xor-ed
+  uint32_t hash[4] = {0, 0, 0, 0};
+  InlinedVector<int64_t> dims;
   for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+    const auto input_dims = input.Get<Tensor>().Shape().GetDims();
+    dims.clear();
+    dims.push_back(static_cast<int64_t>(input_dims.size()));
+    for (auto dim : input_dims) {
+      dims.push_back(RoundUpToDimBucket(dim, dim_buckets));
+    }
+    MurmurHash3::x86_128(dims.data(), gsl::narrow_cast<int32_t>(dims.size() * sizeof(int64_t)), hash[0], &hash);
+  }
+  return static_cast<int64_t>((static_cast<uint64_t>(hash[1]) << 32) | hash[0]);
+}
+
+// the ranks and dims of the inputs, to compare the inputs of the runs of a bucket
+static InlinedVector<int64_t> GetMemoryPatternInputDims(gsl::span<const OrtValue> tensor_inputs) {
+  InlinedVector<int64_t> input_dims;
+  for (const auto& input : tensor_inputs) {
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    input_dims.push_back(static_cast<int64_t>(dims.size()));
+    input_dims.insert(input_dims.end(), dims.begin(), dims.end());
+  }
+  return input_dims;
+}
+
+// whether the inputs are larger than those a pattern was generated for: no dim is smaller and one is larger.
+static bool InputsExceedMemoryPatternDims(gsl::span<const OrtValue> tensor_inputs,
+                                          gsl::span<const int64_t> pattern_input_dims) {
+  if (pattern_input_dims.empty()) {
+    return false;
+  }
+
+  const auto input_dims = GetMemoryPatternInputDims(tensor_inputs);
+  if (input_dims.size() != pattern_input_dims.size()) {
+    return false;
+  }
+
+  bool larger = false;
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    if (input_dims[i] < pattern_input_dims[i]) {
+      return false;
+    }
+    larger = larger || input_dims[i] > pattern_input_dims[i];
   }
-  return key;
+  return larger;
 }
 
 #ifdef ENABLE_TRAINING
@@ -767,38 +969,103 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
-// and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
     gsl::span<const int> feed_mlvalue_idxs,
-    const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
-  out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>>& out_inferred_shapes) const {
+  out_inferred_shapes.reset();
+  int64_t key = CalculateMemoryPatternsKey(tensor_inputs, memory_pattern_dim_buckets_);
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+  if (it != mem_patterns_.end()) {
+    const auto& cached = it->second.patterns;
+    // with bucketed shapes, the tensors of a run with larger inputs than the pattern was generated for may not fit
+    // in its blocks, so the patterns are generated again for these inputs
+    if (!HasMemoryPatternDimBuckets() || !InputsExceedMemoryPatternDims(tensor_inputs, cached->input_dims)) {
+      mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+      if (!cached->inferred_shapes.empty()) {
+        out_inferred_shapes =
+            std::shared_ptr<const InlinedHashMap<int, TensorShape>>(cached, &cached->inferred_shapes);
+      }
+      return std::shared_ptr<const MemoryPatternGroup>(cached, &cached->patterns);
+    }
+  }
+
 #ifdef ENABLE_TRAINING
-    MemoryPatternGroup mem_patterns;
-    InlinedHashMap<int, TensorShape> inferred_shapes;
-    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
-      return ptr;
+  if (it == mem_patterns_.end()) {
+    auto cached = std::make_shared<CachedMemoryPatterns>();
+    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, cached->patterns, cached->inferred_shapes)
+            .IsOK()) {
+      cached->input_dims = GetMemoryPatternInputDims(tensor_inputs);
+      out_inferred_shapes = std::shared_ptr<const InlinedHashMap<int, TensorShape>>(cached, &cached->inferred_shapes);
+      std::shared_ptr<const MemoryPatternGroup> patterns(cached, &cached->patterns);
+      InsertMemoryPatterns(key, std::move(cached));
+      return patterns;
     }
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
+  }
 #endif
-    return nullptr;
+
+  // plan the patterns of these inputs from the symbolic dims, instead of tracing the allocations of this run
+  if (symbolic_memory_planner_) {
+    auto cached = std::make_shared<CachedMemoryPatterns>();
+    auto status = symbolic_memory_planner_->GeneratePatterns(feed_mlvalue_idxs, tensor_inputs, cached->patterns);
+    if (status.IsOK()) {
+      cached->input_dims = GetMemoryPatternInputDims(tensor_inputs);
+      std::shared_ptr<const MemoryPatternGroup> patterns(cached, &cached->patterns);
+      InsertMemoryPatterns(key, std::move(cached));
+      return patterns;
+    }
+
+    LOGS(logger_, VERBOSE) << "Could not plan the memory patterns from the symbolic dims: " << status.ErrorMessage();
+  }
+
+  return nullptr;
+}
+
+bool SessionState::NeedsMemoryPatternTrace() const {
+  return enable_symbolic_memory_planning_ && !symbolic_memory_planner_attempted_.load(std::memory_order_relaxed);
+}
+
+void SessionState::UpdateSymbolicMemoryPlanner(gsl::span<const int> feed_mlvalue_idxs,
+                                               gsl::span<const OrtValue> feeds,
+                                               gsl::span<const SymbolicMemoryPlanner::TraceEvent> trace) const {
+  if (!NeedsMemoryPatternTrace() || trace.empty()) {
+    return;
+  }
+
+  auto planner = SymbolicMemoryPlanner::Create(*graph_viewer_, *GetExecutionPlan(), ort_value_name_idx_map_,
+                                               feed_mlvalue_idxs, feeds, trace);
+
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  if (symbolic_memory_planner_attempted_.exchange(true)) {
+    return;
+  }
+
+  if (planner) {
+    LOGS(logger_, INFO) << "The memory patterns of new input shapes are planned from the symbolic dims of "
+                        << planner->NumPlannedTensors() << " tensors.";
+  } else {
+    LOGS(logger_, INFO) << "No tensor size could be expressed with the symbolic dims of the inputs, the memory "
+                        << "patterns are generated by the runs.";
+  }
+  symbolic_memory_planner_ = std::move(planner);
+}
+
+void SessionState::InsertMemoryPatterns(int64_t key, std::shared_ptr<const CachedMemoryPatterns> patterns) const {
+  auto it = mem_patterns_.find(key);
+  if (it != mem_patterns_.end()) {
+    it->second.patterns = std::move(patterns);
+    mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+    return;
   }
 
-  auto patt_hit = shape_patterns_.find(key);
-  if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
+  mem_patterns_lru_.push_front(key);
+  mem_patterns_.emplace(key, MemoryPatternCacheEntry{std::move(patterns), mem_patterns_lru_.begin()});
+  if (memory_pattern_cache_size_ > 0 && mem_patterns_.size() > memory_pattern_cache_size_) {
+    // the frames that still use the evicted patterns hold on to them
+    mem_patterns_.erase(mem_patterns_lru_.back());
+    mem_patterns_lru_.pop_back();
   }
-  return &it->second;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -849,14 +1116,95 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  int64_t key = CalculateMemoryPatternsKey(tensor_inputs, memory_pattern_dim_buckets_);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  auto it = mem_patterns_.find(key);
+  // Do not update if present, unless the patterns of a bucket are generated for larger inputs
+  if (it != mem_patterns_.end() &&
+      !(HasMemoryPatternDimBuckets() && InputsExceedMemoryPatternDims(tensor_inputs, it->second.patterns->input_dims))) {
+    return Status::OK();
+  }
+
+  auto cached = std::make_shared<CachedMemoryPatterns>();
+  cached->patterns = std::move(mem_patterns);
+  cached->input_dims = GetMemoryPatternInputDims(tensor_inputs);
+  InsertMemoryPatterns(key, std::move(cached));
+
+  if (!mem_pattern_cache_file_.empty()) {
+    InlinedHashMap<int64_t, const MemoryPatternGroup*> pattern_groups;
+    pattern_groups.reserve(mem_patterns_.size());
+    for (const auto& [pattern_key, entry] : mem_patterns_) {
+      pattern_groups.emplace(pattern_key, &entry.patterns->patterns);
+    }
+    auto status = MemoryPatternCache::Save(mem_pattern_cache_file_, MemoryPatternCacheFingerprint(), pattern_groups);
+    if (!status.IsOK()) {
+      LOGS(logger_, WARNING) << "Failed to save the memory pattern cache: " << status.ErrorMessage();
+    }
+  }
   return Status::OK();
 }
 
+uint64_t SessionState::MemoryPatternCacheFingerprint() const {
+  // the offsets in a pattern are only valid for the same OrtValue indices and allocation plan
+  const auto& allocation_plan = GetExecutionPlan()->allocation_plan;
+  std::vector<const std::string*> names(allocation_plan.size(), nullptr);
+  for (const auto& [name, idx] : ort_value_name_idx_map_) {
+    if (static_cast<size_t>(idx) < names.size()) {
+      names[idx] = &name;
+    }
+  }
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  for (size_t i = 0; i < allocation_plan.size(); ++i) {
+    if (names[i]) {
+      MurmurHash3::x86_128(names[i]->data(), gsl::narrow_cast<int32_t>(names[i]->size()), hash[0], &hash);
+    }
+    const auto& value_plan = allocation_plan[i];
+    const int32_t plan_info[] = {static_cast<int32_t>(value_plan.alloc_kind),
+                                 static_cast<int32_t>(value_plan.reused_buffer),
+                                 value_plan.location.Type(),
+                                 value_plan.location.MemType(),
+                                 value_plan.location.Id()};
+    MurmurHash3::x86_128(plan_info, static_cast<int32_t>(sizeof(plan_info)), hash[0], &hash);
+  }
+
+  // the keys depend on the buckets of the dims
+  if (!memory_pattern_dim_buckets_.empty()) {
+    MurmurHash3::x86_128(memory_pattern_dim_buckets_.data(),
+                         gsl::narrow_cast<int32_t>(memory_pattern_dim_buckets_.size() * sizeof(int64_t)), hash[0],
+                         &hash);
+  }
+
+  return (static_cast<uint64_t>(hash[1]) << 32) | hash[0];
+}
+
+void SessionState::SetMemoryPatternCacheFile(const PathString& cache_file) {
+  mem_pattern_cache_file_ = cache_file;
+  std::error_code ec;
+  if (!enable_mem_pattern_ || cache_file.empty() || !std::filesystem::exists(cache_file, ec)) {
+    // nothing to load yet, the file is created once a pattern is generated
+    return;
+  }
+
+  NodeHashMap<int64_t, MemoryPatternGroup> pattern_groups;
+  auto status = MemoryPatternCache::Load(cache_file, MemoryPatternCacheFingerprint(), pattern_groups);
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << "Ignoring the memory pattern cache: " << status.ErrorMessage();
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  for (auto& [key, patterns] : pattern_groups) {
+    if (mem_patterns_.find(key) == mem_patterns_.end()) {
+      auto cached = std::make_shared<CachedMemoryPatterns>();
+      cached->patterns = std::move(patterns);
+      InsertMemoryPatterns(key, std::move(cached));
+    }
+  }
+  LOGS(logger_, INFO) << "Loaded " << mem_patterns_.size() << " memory patterns from the memory pattern cache.";
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 bool SessionState::GetEnableMemoryReuse() const { return sess_options_.enable_mem_reuse; }
@@ -1378,9 +1726,12 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
+  const bool enable_dynamic_scheduling =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicInterOpScheduling, "1") == "1";
   SequentialPlannerContext context(session_options.execution_mode,
                                    session_options.execution_order,
-                                   session_options.enable_mem_reuse);
+                                   session_options.enable_mem_reuse,
+                                   enable_dynamic_scheduling);
 
 #ifdef _WIN32
 
@@ -1475,6 +1826,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  // the phases of the initialization are recorded as session events, subgraphs add their own events
+  const bool profiling_enabled = profiler_.IsEnabled();
+  TimePoint phase_start;
+  if (profiling_enabled) {
+    phase_start = profiler_.Start();
+  }
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
           Env::Default(), graph_location, *graph_viewer_,
@@ -1489,7 +1847,39 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
             return Status::OK();
           },
           logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-          memory_profile_func, name_to_buffered_tensor_));
+          memory_profile_func, name_to_buffered_tensor_, lazy_initializers_,
+          inter_op_thread_pool_ != nullptr ? inter_op_thread_pool_ : thread_pool_));
+
+  if (profiling_enabled) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "initializer_copy", phase_start);
+  }
+
+  if (!lazy_initializers_.empty()) {
+    prepack_lazy_initializers_ = !disable_prepacking;
+    for (const auto& node : graph_viewer_->Nodes()) {
+      auto node_inputs = std::make_unique<LazyNodeInputs>();
+      auto add_input = [this, &node_inputs](const NodeArg& arg, int input_index) {
+        int ort_value_index;
+        if (arg.Exists() && ort_value_name_idx_map_.GetIdx(arg.Name(), ort_value_index).IsOK()) {
+          if (auto it = lazy_initializers_.find(ort_value_index); it != lazy_initializers_.end()) {
+            node_inputs->inputs.emplace_back(input_index, it->second.get());
+          }
+        }
+      };
+
+      int input_index = 0;
+      for (const auto* input_def : node.InputDefs()) {
+        add_input(*input_def, input_index++);
+      }
+      for (const auto* implicit_input_def : node.ImplicitInputDefs()) {
+        add_input(*implicit_input_def, -1);
+      }
+
+      if (!node_inputs->inputs.empty()) {
+        lazy_node_inputs_.insert_or_assign(node.Index(), std::move(node_inputs));
+      }
+    }
+  }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1503,11 +1893,37 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
+  if (profiling_enabled) {
+    phase_start = profiler_.Start();
+  }
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  if (profiling_enabled) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "kernel_creation", phase_start);
+  }
 
   if (!disable_prepacking) {
+    if (profiling_enabled) {
+      phase_start = profiler_.Start();
+    }
+    // subgraphs are packed by their own session state, only the main graph uses the cache file
+    if (parent_ == nullptr) {
+      prepacked_weights_cache_file_ = ToPathString(session_options.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsConfigPrepackedWeightsCacheFile, ""));
+      if (!prepacked_weights_cache_file_.empty()) {
+        LoadPrepackedWeightsCacheFile();
+      }
+    }
+
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
                                                           session_options.initializers_to_share_map));
+
+    if (!prepacked_weights_cache_file_.empty()) {
+      SavePrepackedWeightsCacheFile();
+    }
+
+    if (profiling_enabled) {
+      profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "prepacking", phase_start);
+    }
   }
 
   ORT_RETURN_IF_ERROR(
@@ -1569,7 +1985,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 #ifdef ORT_ENABLE_STREAM
 static void BindToDeviceStream(const SequentialExecutionPlan& execution_plan,
                                DeviceStreamCollection& device_stream_map,
-                               IStreamCommandHandleRegistry& stream_handle_registry) {
+                               IStreamCommandHandleRegistry& stream_handle_registry,
+                               bool use_copy_streams) {
   for (size_t i = 0; i < execution_plan.execution_plan.size(); ++i) {
     auto& logic_stream = execution_plan.execution_plan[i];
     if (logic_stream->steps_.size() > 0) {
@@ -1584,6 +2001,16 @@ static void BindToDeviceStream(const SequentialExecutionPlan& execution_plan,
       device_stream_map.SetDeviceStream(i, nullptr);
     }
   }
+
+  if (use_copy_streams) {
+    for (size_t i = 0; i < execution_plan.execution_plan.size(); ++i) {
+      const Stream* stream = device_stream_map.GetStream(i);
+      if (stream != nullptr && device_stream_map.GetCopyStream(stream->GetDevice()) == nullptr) {
+        auto create_stream_fn = stream_handle_registry.GetCreateStreamFn(stream->GetDevice().Type());
+        device_stream_map.AddCopyStream(create_stream_fn(stream->GetDevice()));
+      }
+    }
+  }
 }
 
 std::unique_ptr<DeviceStreamCollection> SessionState::AcquireDeviceStreamCollection() const {
@@ -1595,7 +2022,11 @@ std::unique_ptr<DeviceStreamCollection> SessionState::AcquireDeviceStreamCollect
       return device_stream;
     } else {
       auto device_stream = std::make_unique<DeviceStreamCollection>(this->GetExecutionPlan()->execution_plan.size(), *allocators_, graph_viewer_->ParentNode() == nullptr);
-      BindToDeviceStream(*this->GetExecutionPlan(), *device_stream, *stream_handles_registry_);
+      // subgraphs run on the streams of the parent graph, which copies the feeds
+      const bool use_copy_streams =
+          graph_viewer_->ParentNode() == nullptr &&
+          sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseCopyStreamForFeeds, "0") == "1";
+      BindToDeviceStream(*this->GetExecutionPlan(), *device_stream, *stream_handles_registry_, use_copy_streams);
       return device_stream;
     }
   } else {
@@ -1615,4 +2046,73 @@ void SessionState::RecycleDeviceStreamCollection(std::unique_ptr<DeviceStreamCol
 }
 #endif
 
+std::unique_ptr<ExecutionFrame> SessionState::AcquireExecutionFrame(
+    gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
+    gsl::span<const OrtValue> fetches, const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators
+#ifdef ORT_ENABLE_STREAM
+    ,
+    const DeviceStreamCollection* device_streams
+#endif
+) const {
+#ifdef ORT_ENABLE_STREAM
+  const bool poolable = execution_frame_pool_size_ > 0 && fetch_allocators.empty() && device_streams == nullptr;
+#else
+  const bool poolable = execution_frame_pool_size_ > 0 && fetch_allocators.empty();
+#endif
+  if (poolable) {
+    // a pooled frame can only be reused with the memory patterns its buffers were allocated for
+    std::shared_ptr<const MemoryPatternGroup> mem_patterns;
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+    const bool use_mem_patterns =
+        enable_mem_pattern_ && GetExecutionPlan() &&
+        std::all_of(feeds.begin(), feeds.end(), [](const OrtValue& feed) { return feed.IsTensor(); });
+    if (use_mem_patterns) {
+      mem_patterns = GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes);
+    }
+
+    // without patterns for these shapes the frame of this run generates them, so none of the pooled frames fits
+    if (!use_mem_patterns || mem_patterns != nullptr) {
+      std::unique_ptr<ExecutionFrame> frame;
+      {
+        std::lock_guard<onnxruntime::OrtMutex> lock(execution_frame_pool_mutex_);
+        auto it = std::find_if(execution_frame_pool_.begin(), execution_frame_pool_.end(),
+                               [&](const std::unique_ptr<ExecutionFrame>& pooled) {
+                                 return pooled->CanReuseFor(fetch_mlvalue_idxs, mem_patterns.get());
+                               });
+        if (it != execution_frame_pool_.end()) {
+          frame = std::move(*it);
+          execution_frame_pool_.erase(it);
+        }
+      }
+
+      if (frame) {
+        frame->Reset(feed_mlvalue_idxs, feeds, fetches, std::move(inferred_shapes));
+        return frame;
+      }
+    }
+  }
+
+  return std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators,
+#ifdef ORT_ENABLE_STREAM
+                                          device_streams,
+#endif
+                                          *this);
+}
+
+void SessionState::RecycleExecutionFrame(std::unique_ptr<ExecutionFrame> frame) const {
+  if (execution_frame_pool_size_ == 0 || !frame->IsReusable()) {
+    return;
+  }
+
+  // release the values of the run, which include the feeds and fetches owned by the caller
+  frame->ReleaseAllMLValues();
+
+  std::lock_guard<onnxruntime::OrtMutex> lock(execution_frame_pool_mutex_);
+  if (execution_frame_pool_.size() >= execution_frame_pool_size_) {
+    // drop the oldest frame, e.g. one for memory patterns that were evicted from the cache since
+    execution_frame_pool_.erase(execution_frame_pool_.begin());
+  }
+  execution_frame_pool_.push_back(std::move(frame));
+}
+
 }  // namespace onnxruntime
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <list>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -26,13 +29,17 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_file.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/memory_trace.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/session_state_utils.h"
+#include "core/framework/symbolic_memory_planner.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/platform/ort_mutex.h"
@@ -121,6 +128,11 @@ class SessionState {
     return (node_id < session_kernels_.size()) ? session_kernels_[node_id].get() : nullptr;
   }
 
+  // Latency histogram the kernel of the node records into, or nullptr if the node latency stats are disabled.
+  profiling::LatencyHistogram* GetNodeLatencyHistogram(size_t node_id) const {
+    return (node_id < node_latency_histograms_.size()) ? node_latency_histograms_[node_id] : nullptr;
+  }
+
   const ExecutionProviders& GetExecutionProviders() const noexcept { return execution_providers_; }
 
   /**
@@ -168,6 +180,14 @@ class SessionState {
   bool IsSparseInitializer(int ort_value_index) const;
 #endif
 
+  /**
+   * Loads the initializers consumed by the node that are loaded on first use, and pre-packs the constant ones
+   * into its kernel. Must be called before the kernel of the node is run. Only the first call for a node does any
+   * work, later calls return its result. Thread safe.
+   * See kOrtSessionOptionsLazyLoadExternalInitializers.
+   */
+  Status LoadLazyInitializers(NodeIndex node_index) const;
+
 #ifdef ENABLE_TRAINING
   // This is referenced in training::TrainingSession. Should be removed when this class is removed.
   /**
@@ -214,19 +234,48 @@ class SessionState {
   }
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Records the tensors allocated by the executions of this graph, if set. Subgraphs are not traced.
+  MemoryTracer* GetMemoryTracer() const noexcept { return memory_tracer_; }
+
+  void SetMemoryTracer(MemoryTracer* memory_tracer) noexcept {
+    memory_tracer_ = memory_tracer;
+  }
+#endif
+
   /**
   Get cached memory pattern based on input shapes
   Must be called only when all values contain tensors
-  In training scenarios, the cache may be updated so
-  the callers would receive a copy of inferred shapes
-  made under mutex being held. In inference scenarios,
-  it is not mutable, we do not obtain a lock and simply get a pointer
-  w/o copying a hashtable
+  In training scenarios, the cache may be updated and the inferred shapes
+  are generated together with the pattern.
+  The returned pattern and inferred shapes stay valid while they are held,
+  even if the cache entry is evicted or replaced in the meantime.
+  Returns nullptr if there is no pattern for the input shapes, or, with bucketed
+  shapes, if the pattern of the bucket was generated for smaller inputs, so that
+  the run generates a pattern that replaces it.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
       gsl::span<const int> feed_mlvalue_idxs,
-      const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
+      std::shared_ptr<const InlinedHashMap<int, TensorShape>>& inferred_shapes) const;
+
+  /**
+  Whether a frame that generates memory patterns should record its allocations for UpdateSymbolicMemoryPlanner.
+  */
+  bool NeedsMemoryPatternTrace() const;
+
+  /**
+  Create the planner of the memory patterns of new input shapes from the symbolic dims, with the allocations that
+  were traced by the frame of a run with `feeds`. See kOrtSessionOptionsConfigSymbolicMemoryPlanning.
+  */
+  void UpdateSymbolicMemoryPlanner(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                   gsl::span<const SymbolicMemoryPlanner::TraceEvent> trace) const;
+
+  /**
+  Whether the memory patterns are cached per bucket of input shapes, see kOrtSessionOptionsConfigMemoryPatternDimBuckets.
+  A pattern is then used for any inputs of its bucket, and its blocks may be larger than the tensors placed in them.
+  */
+  bool HasMemoryPatternDimBuckets() const { return !memory_pattern_dim_buckets_.empty(); }
 
   /**
   Set generated memory pattern with a given input shapes.
@@ -236,6 +285,14 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Persist the memory pattern cache in `cache_file`.
+  Patterns saved by a previous session for the same execution plan are loaded, and the file is rewritten whenever
+  a pattern is generated for new input shapes. A missing or stale file is not an error.
+  Must be called before the first Run.
+  */
+  void SetMemoryPatternCacheFile(const PathString& cache_file);
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -341,6 +398,23 @@ class SessionState {
     return subgraph_session_states_;
   }
 
+  // Get an execution frame for a run, reusing a frame of a previous run with the same input shapes if one is pooled.
+  // See kOrtSessionOptionsConfigExecutionFramePoolSize.
+  std::unique_ptr<ExecutionFrame> AcquireExecutionFrame(gsl::span<const int> feed_mlvalue_idxs,
+                                                        gsl::span<const OrtValue> feeds,
+                                                        gsl::span<const int> fetch_mlvalue_idxs,
+                                                        gsl::span<const OrtValue> fetches,
+                                                        const std::unordered_map<size_t, IExecutor::CustomAllocator>&
+                                                            fetch_allocators
+#ifdef ORT_ENABLE_STREAM
+                                                        ,
+                                                        const DeviceStreamCollection* device_streams
+#endif
+  ) const;
+
+  // Return the frame of a completed run. It is pooled for the next runs if the pool isn't full.
+  void RecycleExecutionFrame(std::unique_ptr<ExecutionFrame> frame) const;
+
 #ifdef ORT_ENABLE_STREAM
   std::unique_ptr<DeviceStreamCollection> AcquireDeviceStreamCollection() const;
 
@@ -384,6 +458,16 @@ class SessionState {
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
                                            const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
 
+  // Makes `kernel` use the buffers of `weights` from the pre-packed weights cache file if it has them, and keeps
+  // `weights` to be written to the cache file otherwise.
+  Status UsePrepackedWeightsCacheFile(const Node& node, int input_idx, PrePackedWeights&& weights);
+
+  // Loads the pre-packed weights cache file set by kOrtSessionOptionsConfigPrepackedWeightsCacheFile.
+  void LoadPrepackedWeightsCacheFile();
+
+  // Writes the pre-packed weights cache file if the session packed weights that it doesn't have.
+  void SavePrepackedWeightsCacheFile() const;
+
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
   Status CreateSubgraphSessionState();
@@ -419,6 +503,8 @@ class SessionState {
 
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<std::unique_ptr<OpKernel>> session_kernels_;
+  // histograms of Profiler().GetNodeLatencyStats() by node index, empty if the stats are disabled
+  std::vector<profiling::LatencyHistogram*> node_latency_histograms_;
   Graph& graph_;
   std::optional<GraphViewer> graph_viewer_;  // GraphViewer for const access to Graph
 
@@ -477,6 +563,19 @@ class SessionState {
   InlinedHashSet<int> sparse_initialized_tensors_;
 #endif
 
+  // initializers loaded on first use, their OrtValues are in initialized_tensors_ too. key is ort_value_index
+  InlinedHashMap<int, std::unique_ptr<session_state_utils::LazyInitializer>> lazy_initializers_;
+
+  // the lazily loaded initializers consumed by a node, with the index of the input or -1 for an implicit input
+  struct LazyNodeInputs {
+    InlinedVector<std::pair<int, session_state_utils::LazyInitializer*>> inputs;
+    std::once_flag load_flag;
+    Status load_status;
+  };
+  InlinedHashMap<NodeIndex, std::unique_ptr<LazyNodeInputs>> lazy_node_inputs_;
+  // whether kernels pre-pack the lazily loaded initializers
+  bool prepack_lazy_initializers_ = false;
+
   // This data structure is for uninitializing string tensors and
   // munmap memory region and close file descriptor
   InlinedHashMap<int, OrtCallback> deleter_for_initialized_tensors_;
@@ -490,21 +589,51 @@ class SessionState {
   MemoryProfiler* memory_profiler_;
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+  MemoryTracer* memory_tracer_{nullptr};
+#endif
+
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  // identifies the execution plan the memory patterns are generated for, see SetMemoryPatternCacheFile.
+  uint64_t MemoryPatternCacheFingerprint() const;
+
+  // a memory pattern group in the cache
+  struct CachedMemoryPatterns {
+    MemoryPatternGroup patterns;
+    // the shapes inferred together with the patterns, only generated in training
+    InlinedHashMap<int, TensorShape> inferred_shapes;
+    // the ranks and dims of the inputs the patterns were generated for. empty if loaded from the cache file.
+    InlinedVector<int64_t> input_dims;
+  };
+
+  struct MemoryPatternCacheEntry {
+    // shared with the execution frames that use the patterns, so that the entry can be evicted or replaced
+    std::shared_ptr<const CachedMemoryPatterns> patterns;
+    std::list<int64_t>::iterator lru_position;
+  };
+
+  // adds or replaces the patterns for `key` and evicts the least recently used patterns beyond
+  // memory_pattern_cache_size_. mem_patterns_lock_ must be held.
+  void InsertMemoryPatterns(int64_t key, std::shared_ptr<const CachedMemoryPatterns> patterns) const;
+
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
-  // This is mutable under mutex in training scenarios so execution frame would make a copy
-  // of the value when created.
-#ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#endif
+  mutable InlinedHashMap<int64_t, MemoryPatternCacheEntry> mem_patterns_;
+  // the keys of mem_patterns_, most recently used first
+  mutable std::list<int64_t> mem_patterns_lru_;
+  // the maximum number of patterns in mem_patterns_. 0 if not limited.
+  size_t memory_pattern_cache_size_ = 0;
+  // ascending bucket boundaries the input dims are rounded up to for the cache key. empty to key on the exact shapes.
+  InlinedVector<int64_t> memory_pattern_dim_buckets_;
+  // plans the patterns of new input shapes, created from the allocations of the first run that generated a pattern
+  bool enable_symbolic_memory_planning_ = false;
+  mutable std::atomic_bool symbolic_memory_planner_attempted_{false};
+  mutable std::unique_ptr<SymbolicMemoryPlanner> symbolic_memory_planner_;
+  // if not empty, mem_patterns_ is persisted in this file. see SetMemoryPatternCacheFile
+  PathString mem_pattern_cache_file_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -529,6 +658,13 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // if not empty, pre-packed weights of CPU kernels are shared across processes through this file.
+  // see kOrtSessionOptionsConfigPrepackedWeightsCacheFile
+  PathString prepacked_weights_cache_file_;
+  std::unique_ptr<PrepackedWeightsFile> prepacked_weights_file_;
+  // weights packed by this session that the cache file doesn't have yet. their buffers are used by the kernels.
+  std::unordered_map<std::string, PrePackedWeights> prepacked_weights_for_cache_file_;
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -564,6 +700,12 @@ class SessionState {
   size_t graph_executions_counter_ = 0;
 #endif
 
+  // the maximum number of frames in execution_frame_pool_. 0 if the frames are not pooled.
+  size_t execution_frame_pool_size_ = 0;
+  // lock for the execution frame pool
+  mutable OrtMutex execution_frame_pool_mutex_;
+  mutable std::vector<std::unique_ptr<ExecutionFrame>> execution_frame_pool_;
+
 #ifdef ORT_ENABLE_STREAM
   std::unique_ptr<IStreamCommandHandleRegistry> stream_handles_registry_;
 
@@ -1,14 +1,21 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <functional>
+#include <iomanip>
 #include <limits>
 #include <memory>
+#include <optional>
+#include <sstream>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <core/common/status.h>
 
+#include "core/common/narrow.h"
 #include "core/framework/ortdevice.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/session_state_utils.h"
@@ -18,16 +25,20 @@
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/ort_value.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_initializer_store.h"
+#include "core/framework/tensor_external_data_info.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/framework/bfc_arena.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -91,6 +102,94 @@ static inline common::Status ExtDataTensorProtoToTensor(const Env& env,
   return common::Status::OK();
 }
 
+// deserialize a tensor for a non-CPU device to the CPU tensor it is copied to the device from.
+// external data is mmap'd instead of copied into the CPU tensor, and ext_data_deleter releases it.
+static common::Status DeserializeTensorProtoToCpu(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                                                  const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                  const AllocatorPtr& default_cpu_alloc,
+                                                  bool use_device_allocator_for_initializers, Tensor* buffered_tensor,
+                                                  std::unique_ptr<Tensor>& p_deserialize_tensor,
+                                                  OrtCallback& ext_data_deleter) {
+  if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "string tensor is not supported for copying between allocators");
+  }
+
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+  if (utils::HasExternalData(tensor_proto)) {
+    p_deserialize_tensor = std::make_unique<Tensor>(type, TensorShape(), default_cpu_alloc);
+    return ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_deserialize_tensor, ext_data_deleter,
+                                      buffered_tensor);
+  }
+
+  TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+  ORT_RETURN_IF_ERROR(AllocateTensorOnDeviceOrMemory(use_device_allocator_for_initializers, tensor_shape, type,
+                                                     default_cpu_alloc, p_deserialize_tensor));
+  return utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_deserialize_tensor);
+}
+
+// initializers smaller than this are not shared across sessions, as sharing them saves little
+constexpr size_t kMinSharedInitializerSizeInBytes = 1024;
+
+// whether the initializer can be shared with other sessions through the SharedInitializerStore. its data must be
+// raw data or in an external file, as data at a memory address belongs to the graph of this session.
+static bool CanShareInitializer(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return false;
+  }
+
+  if (utils::HasExternalData(tensor_proto)) {
+    std::unique_ptr<ExternalDataInfo> external_data_info;
+    if (!ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info).IsOK() ||
+        external_data_info->GetRelPath() == utils::kTensorProtoMemoryAddressTag) {
+      return false;
+    }
+  } else if (!utils::HasRawData(tensor_proto)) {
+    return false;
+  }
+
+  SafeInt<size_t> size_in_bytes = 0;
+  return utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &size_in_bytes).IsOK() &&
+         size_in_bytes >= kMinSharedInitializerSizeInBytes;
+}
+
+// the key of an initializer on `device` in the SharedInitializerStore: the hash of its data, its type and its shape
+static common::Status GetSharedInitializerKey(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                                              const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                              const OrtDevice& device, std::string& key) {
+  const char* data = nullptr;
+  size_t size = 0;
+  OrtCallback ext_data_deleter{nullptr, nullptr};
+  if (utils::HasExternalData(tensor_proto)) {
+    void* ext_data_buf = nullptr;
+    SafeInt<size_t> ext_data_len = 0;
+    ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(env, proto_path.c_str(), tensor_proto, ext_data_buf,
+                                                         ext_data_len, ext_data_deleter));
+    data = static_cast<const char*>(ext_data_buf);
+    size = ext_data_len;
+  } else {
+    data = tensor_proto.raw_data().data();
+    size = tensor_proto.raw_data().size();
+  }
+  ScopedOrtCallbackInvoker scoped_ext_data_deleter(ext_data_deleter);
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  constexpr size_t kMaxHashChunkSize = size_t{1} << 30;
+  for (size_t offset = 0; offset < size; offset += kMaxHashChunkSize) {
+    const size_t chunk_size = std::min(kMaxHashChunkSize, size - offset);
+    MurmurHash3::x86_128(data + offset, narrow<int32_t>(chunk_size), hash[0], &hash);
+  }
+
+  std::ostringstream oss;
+  oss << std::hex << std::setfill('0');
+  for (uint32_t h : hash) {
+    oss << std::setw(8) << h;
+  }
+  oss << std::dec << ':' << size << ':' << tensor_proto.data_type() << ':'
+      << utils::GetTensorShapeFromTensorProto(tensor_proto) << ':' << device.ToString();
+  key = oss.str();
+  return Status::OK();
+}
+
 // If tensor_proto's external file path is kTensorProtoMemoryAddressTag, and
 // buffered_tensor is not null, buffered_tensor holds the real buffer pointed
 // by tensor_proto. buffered_tensor must be the owner of the buffer and deleter
@@ -141,15 +240,27 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor,
                                                      ext_data_deleter, buffered_tensor));
 
+      // The mapped data is at the initializer's offset in the file. Kernels may assume that tensor data is
+      // aligned to its element size, so copy it if the offset doesn't honor that.
+      if (reinterpret_cast<uintptr_t>(p_tensor->DataRaw()) % type->Size() != 0) {
+        LOGS_DEFAULT(WARNING) << "External data of initializer " << tensor_proto.name()
+                              << " is not aligned to its element size and will be copied instead of memory mapped.";
+        ScopedOrtCallbackInvoker scoped_ext_data_deleter(ext_data_deleter);
+        std::unique_ptr<Tensor> p_aligned_tensor;
+        ORT_RETURN_IF_ERROR(AllocateTensor(m, p_aligned_tensor, type, tensor_shape,
+                                           use_device_allocator_for_initializers, alloc));
+        memcpy(p_aligned_tensor->MutableDataRaw(), p_tensor->DataRaw(), p_tensor->SizeInBytes());
+
+        auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+        ort_value.Init(p_aligned_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+        return common::Status::OK();
+      }
+
       ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
       MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
       ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
       return common::Status::OK();
     } else {  // non-cpu tensor
-      if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "string tensor is not supported for copying between allocators");
-      }
-
       // deserialize to CPU first for non-CPU allocator, then copy to device
       // for external initializer load on non-CPU device:
       // 1. allocate memory on device - p_tensor
@@ -158,13 +269,13 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       // 3. copy tensor from CPU to device - p_deserialize_tensor -> p_tensor
       ORT_RETURN_IF_ERROR(AllocateTensor(m, p_tensor, type, tensor_shape, use_device_allocator_for_initializers, alloc));
 
-      std::unique_ptr<Tensor> p_deserialize_tensor = std::make_unique<Tensor>(type, TensorShape(), default_cpu_alloc);
-
-      OrtCallback ext_data_deleter;
-      std::optional<ScopedOrtCallbackInvoker> scoped_ort_callback_invoker;
-      ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_deserialize_tensor,
-                                                     ext_data_deleter, buffered_tensor));
-      scoped_ort_callback_invoker = ScopedOrtCallbackInvoker(ext_data_deleter);
+      std::unique_ptr<Tensor> p_deserialize_tensor;
+      OrtCallback ext_data_deleter{nullptr, nullptr};
+      const Status status = DeserializeTensorProtoToCpu(env, proto_path, tensor_proto, default_cpu_alloc,
+                                                        use_device_allocator_for_initializers, buffered_tensor,
+                                                        p_deserialize_tensor, ext_data_deleter);
+      ScopedOrtCallbackInvoker scoped_ort_callback_invoker(ext_data_deleter);
+      ORT_RETURN_IF_ERROR(status);
       // TODO!! Need a temp buffer allocator for non-escape buffers that maybe too big for stack allocation.
 
       return CopyTensorFromCPUToDevice(data_transfer_mgr, p_deserialize_tensor, p_tensor, ort_value);
@@ -180,19 +291,16 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
       return common::Status::OK();
     } else {  // non-cpu tensor
-      if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "string tensor is not supported for copying between allocators");
-      }
-
       // deserialize to CPU first for non-CPU allocator, then copy
       // for internal initializer
       // 1. allocate memory on CPU - p_deserialize_tensor
       // 2. deserialize tensor_probo into a preallocated tensor (p_deserialize_tensor)
       // 3. copy tensor from CPU to device - p_deserialize_tensor -> p_tensor
       std::unique_ptr<Tensor> p_deserialize_tensor;
-      ORT_RETURN_IF_ERROR(AllocateTensorOnDeviceOrMemory(use_device_allocator_for_initializers, tensor_shape, type, default_cpu_alloc, p_deserialize_tensor));
-
-      ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_deserialize_tensor));
+      OrtCallback unused_deleter{nullptr, nullptr};
+      ORT_RETURN_IF_ERROR(DeserializeTensorProtoToCpu(env, proto_path, tensor_proto, default_cpu_alloc,
+                                                      use_device_allocator_for_initializers, nullptr,
+                                                      p_deserialize_tensor, unused_deleter));
       // TODO!! Need a temp buffer allocator for non-escape buffers that maybe too big for stack allocation.
 
       return CopyTensorFromCPUToDevice(data_transfer_mgr, p_deserialize_tensor, p_tensor, ort_value);
@@ -200,6 +308,51 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   }
 }
 
+LazyInitializer::LazyInitializer(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
+                                 const ONNX_NAMESPACE::TensorProto& tensor_proto, const AllocatorPtr& alloc,
+                                 const AllocatorPtr& default_cpu_alloc, const DataTransferManager& data_transfer_mgr,
+                                 const ExternalDataLoaderManager& external_data_loader_mgr,
+                                 bool use_device_allocator_for_initializers, bool constant)
+    : env_(env),
+      graph_loc_(graph_loc),
+      tensor_proto_(tensor_proto),
+      alloc_(alloc),
+      default_cpu_alloc_(default_cpu_alloc),
+      data_transfer_mgr_(data_transfer_mgr),
+      external_data_loader_mgr_(external_data_loader_mgr),
+      use_device_allocator_for_initializers_(use_device_allocator_for_initializers),
+      constant_(constant) {
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+  Tensor::InitOrtValue(type, utils::GetTensorShapeFromTensorProto(tensor_proto), nullptr, alloc->Info(), value_);
+}
+
+Status LazyInitializer::Load() {
+  std::call_once(load_flag_, [this]() {
+    ORT_TRY {
+      load_status_ = DeserializeTensorProto(env_, graph_loc_, tensor_proto_, nullptr, alloc_, default_cpu_alloc_, data_,
+                                            data_transfer_mgr_, external_data_loader_mgr_,
+                                            use_device_allocator_for_initializers_);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        load_status_ = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+      });
+    }
+
+    if (!load_status_.IsOK()) {
+      load_status_ = Status(load_status_.Category(), load_status_.Code(),
+                            "Deserialize tensor " + tensor_proto_.name() + " failed." + load_status_.ErrorMessage());
+      return;
+    }
+
+    // only the data pointer changes, the shape and type are the ones the placeholder was created with
+    Tensor& data = *data_.GetMutable<Tensor>();
+    *value_.GetMutable<Tensor>() = Tensor(data.DataType(), data.Shape(), data.MutableDataRaw(), data.Location());
+  });
+
+  return load_status_;
+}
+
 common::Status AllocateTensor(
     const onnxruntime::MemBuffer* m,
     std::unique_ptr<onnxruntime::Tensor>& p_tensor,
@@ -272,7 +425,9 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors) {
+    std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors,
+    InlinedHashMap<int, std::unique_ptr<LazyInitializer>>& lazy_initializers,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -313,11 +468,37 @@ common::Status SaveInitializedTensors(
   id_to_initialized_tensor.reserve(initialized_tensor_set.size());
   user_supplied_initializer_ids.reserve(initialized_tensor_set.size());
 
+  // initializers with external data that are read when first used instead of here.
+  // an initializer that is a graph output is copied to the fetches by the execution frame so must be loaded.
+  const bool lazy_load_external_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLazyLoadExternalInitializers, "0") == "1";
+  InlinedHashSet<int> lazy_initializer_ids;
+  InlinedHashSet<std::string_view> graph_output_names;
+
+  // initializers that are looked up in and added to the SharedInitializerStore. they are allocated separately
+  // instead of in the weights buffer of the session, as they may outlive it.
+  const bool share_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsShareInitializersAcrossSessions, "0") == "1";
+  InlinedHashSet<int> shared_initializer_ids;
+  if (lazy_load_external_initializers) {
+    for (const auto* output : graph.GetOutputs()) {
+      graph_output_names.insert(output->Name());
+    }
+  }
+
   for (const auto& entry : initialized_tensor_set) {
     int ort_value_index;
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (lazy_load_external_initializers && utils::HasExternalData(*entry.second) &&
+               entry.second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING &&
+               buffered_tensors.find(entry.first) == buffered_tensors.end() &&
+               graph_output_names.find(entry.first) == graph_output_names.end()) {
+      lazy_initializer_ids.insert(ort_value_index);
+    } else if (share_initializers && buffered_tensors.find(entry.first) == buffered_tensors.end() &&
+               CanShareInitializer(*entry.second)) {
+      shared_initializer_ids.insert(ort_value_index);
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
@@ -331,6 +512,8 @@ common::Status SaveInitializedTensors(
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end(),
                 "OrtValue index: ", ort_value_index, " from initializer_allocation_order not found among initialized tensors");
+    lazy_initializer_ids.erase(ort_value_index);
+    shared_initializer_ids.erase(ort_value_index);
     if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU)) {
       // can not trace string tensor
       ORT_ENFORCE(entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING, "Can not trace string tensor");
@@ -348,6 +531,17 @@ common::Status SaveInitializedTensors(
       // do not trace string tensor
       continue;
     }
+    // external data on CPU is mmap'd by DeserializeTensorProto, so don't reserve space for it in the weights buffer
+    if (utils::HasExternalData(*entry.second) && exec_plan.GetLocation(entry.first).Type() == OrtDevice::CPU) {
+      continue;
+    }
+    // lazily loaded initializers are allocated when they are loaded
+    if (lazy_initializer_ids.find(entry.first) != lazy_initializer_ids.end()) {
+      continue;
+    }
+    if (shared_initializer_ids.find(entry.first) != shared_initializer_ids.end()) {
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
   }
   // 2. allocate weight buffer on different locations
@@ -366,8 +560,165 @@ common::Status SaveInitializedTensors(
   }
 
   OrtCallback deleter{nullptr, nullptr};
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
 
   // 3. create weight tensors based on weights buffer
+  // the tensors are created in batches. the tensor protos of a batch are deserialized in parallel, the ones for a
+  // non-CPU device to CPU tensors that are then copied to the device together. a batch is saved before the next one
+  // is created, so that their CPU copies and the tensor protos released by save_tensor_func don't add up.
+  enum class CreateMode {
+    kNone,                 // the value is user supplied or lazily loaded
+    kDeserialize,          // deserialized in parallel
+    kDeserializeSerially,  // deserialized on this thread as the external data loader may not be thread safe
+    kCopyToDevice,         // deserialized to CPU in parallel, then copied to the device
+  };
+
+  struct InitializerToCreate {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    bool constant;
+    CreateMode mode = CreateMode::kNone;
+    std::optional<MemBuffer> m;
+    AllocatorPtr alloc;
+    Tensor* buffered_tensor = nullptr;
+    OrtValue ort_value;
+    Status status;
+    // the CPU tensor for kCopyToDevice and the release of its mmap'd data
+    std::unique_ptr<Tensor> cpu_tensor;
+    std::optional<ScopedOrtCallbackInvoker> cpu_data_deleter;
+    std::unique_ptr<Tensor> device_tensor;
+    // whether the initializer is looked up in the SharedInitializerStore with shared_key, and found there
+    bool shareable = false;
+    std::string shared_key;
+    bool shared = false;
+  };
+
+  constexpr size_t kMaxBatchSizeInBytes = size_t{256} * 1024 * 1024;
+  std::vector<InitializerToCreate> batch;
+  size_t batch_size_in_bytes = 0;
+
+  const auto create_and_save_batch = [&]() -> Status {
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(batch.size()), [&](std::ptrdiff_t i) {
+          auto& initializer = batch[static_cast<size_t>(i)];
+          if (initializer.mode != CreateMode::kDeserialize && initializer.mode != CreateMode::kCopyToDevice) {
+            return;
+          }
+
+          ORT_TRY {
+            if (initializer.shareable) {
+              initializer.status = GetSharedInitializerKey(env, graph_loc, *initializer.tensor_proto,
+                                                           initializer.alloc->Info().device, initializer.shared_key);
+              if (!initializer.status.IsOK()) {
+                return;
+              }
+
+              auto shared_value = SharedInitializerStore::Instance().Find(initializer.shared_key);
+              if (shared_value.has_value()) {
+                initializer.ort_value = std::move(*shared_value);
+                initializer.shared = true;
+                return;
+              }
+            }
+
+            if (initializer.mode == CreateMode::kDeserialize) {
+              initializer.status = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto,
+                                                          initializer.m.has_value() ? &*initializer.m : nullptr,
+                                                          initializer.alloc, default_cpu_alloc, initializer.ort_value,
+                                                          data_transfer_mgr, external_data_loader_mgr,
+                                                          use_device_allocator_for_initializers,
+                                                          initializer.buffered_tensor);
+            } else {
+              OrtCallback ext_data_deleter{nullptr, nullptr};
+              initializer.status = DeserializeTensorProtoToCpu(env, graph_loc, *initializer.tensor_proto,
+                                                               default_cpu_alloc,
+                                                               use_device_allocator_for_initializers,
+                                                               initializer.buffered_tensor, initializer.cpu_tensor,
+                                                               ext_data_deleter);
+              initializer.cpu_data_deleter.emplace(ext_data_deleter);
+            }
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              initializer.status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+            });
+          }
+        });
+
+    std::vector<IDataTransfer::SrcDstPair> copies;
+    for (auto& initializer : batch) {
+      if (initializer.mode == CreateMode::kDeserializeSerially) {
+        initializer.status = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto,
+                                                    initializer.m.has_value() ? &*initializer.m : nullptr,
+                                                    initializer.alloc, default_cpu_alloc, initializer.ort_value,
+                                                    data_transfer_mgr, external_data_loader_mgr,
+                                                    use_device_allocator_for_initializers,
+                                                    initializer.buffered_tensor);
+      } else if (initializer.mode == CreateMode::kCopyToDevice && !initializer.shared && initializer.status.IsOK()) {
+        TensorShape tensor_shape = initializer.cpu_tensor->Shape();
+        initializer.status = AllocateTensor(initializer.m.has_value() ? &*initializer.m : nullptr,
+                                            initializer.device_tensor, initializer.cpu_tensor->DataType(),
+                                            tensor_shape, use_device_allocator_for_initializers, initializer.alloc);
+        if (initializer.status.IsOK()) {
+          copies.push_back({*initializer.cpu_tensor, *initializer.device_tensor, nullptr});
+        }
+      }
+
+      if (!initializer.status.IsOK()) {
+        const auto& st = initializer.status;
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << initializer.tensor_proto->name() << " failed." << st.ErrorMessage();
+        return Status(st.Category(), st.Code(), oss.str());
+      }
+    }
+
+    Status copy_status = data_transfer_mgr.CopyTensors(copies);
+    if (!copy_status.IsOK()) {
+      if (copy_status.ErrorMessage().empty()) {
+        // see CopyTensorFromCPUToDevice
+        return Status(copy_status.Category(), copy_status.Code(),
+                      "Failed to copy tensors to " + copies.front().dst.get().Location().ToString());
+      }
+      return copy_status;
+    }
+
+    for (auto& initializer : batch) {
+      if (initializer.mode == CreateMode::kCopyToDevice && !initializer.shared) {
+        auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+        initializer.ort_value.Init(initializer.device_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+        initializer.cpu_tensor.reset();
+        initializer.cpu_data_deleter.reset();
+      }
+
+      if (initializer.shared) {
+        VLOGS(logger, 1) << "Using the initializer " << initializer.tensor_proto->name()
+                         << " shared by another session.";
+      } else if (initializer.shareable) {
+        initializer.ort_value = SharedInitializerStore::Instance().Add(initializer.shared_key,
+                                                                       std::move(initializer.ort_value));
+      }
+
+      // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
+      // so we need to output this message prior to calling save_tensor_func
+      const std::string& name = initializer.tensor_proto->name();
+      VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << initializer.ort_value_index;
+
+#if !defined(DISABLE_SPARSE_TENSORS)
+      const bool sparse = graph.GetGraph().IsSparseInitializer(name);
+      ORT_RETURN_IF_ERROR(save_tensor_func(name, initializer.ort_value_index, initializer.ort_value, deleter,
+                                           initializer.constant, sparse));
+#else
+      ORT_RETURN_IF_ERROR(save_tensor_func(name, initializer.ort_value_index, initializer.ort_value, deleter,
+                                           initializer.constant, false));
+#endif
+    }
+
+    batch.clear();
+    batch_size_in_bytes = 0;
+    return Status::OK();
+  };
+
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const std::string& name = entry.second->name();
@@ -377,53 +728,67 @@ common::Status SaveInitializedTensors(
       continue;
     }
 
-    OrtValue ort_value;
+    InitializerToCreate& initializer = batch.emplace_back();
+    initializer.ort_value_index = ort_value_index;
+    initializer.tensor_proto = entry.second;
+    // any outer scope value is shadowed by a local value and can't override it.
+    // due to that check_outer_scope is false
+    initializer.constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
 
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
-      ort_value = *(session_options.initializers_to_share_map.at(name));
+      initializer.ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (lazy_initializer_ids.find(ort_value_index) != lazy_initializer_ids.end()) {
+      auto lazy_initializer = std::make_unique<LazyInitializer>(
+          env, graph_loc, *entry.second, planner.GetAllocator(exec_plan.GetLocation(ort_value_index)),
+          default_cpu_alloc, data_transfer_mgr, external_data_loader_mgr, use_device_allocator_for_initializers,
+          initializer.constant);
+      initializer.ort_value = lazy_initializer->Value();
+      lazy_initializers.insert_or_assign(ort_value_index, std::move(lazy_initializer));
+      // kernels can't read the data in their constructor or pre-pack it before it is loaded. it is pre-packed by
+      // the session state when it is loaded instead.
+      initializer.constant = false;
+      VLOGS(logger, 1) << "Initializer " << name << " will be loaded on first use.";
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
-      std::optional<MemBuffer> m;
-      AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, initializer.m, initializer.alloc));
 
-      Tensor* p_tensor = nullptr;
       if (auto iter = buffered_tensors.find(name);
           iter != buffered_tensors.end()) {
-        p_tensor = iter->second.release();
+        initializer.buffered_tensor = iter->second.release();
         buffered_tensors.erase(iter);
       }
 
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr, external_data_loader_mgr,
-                                         use_device_allocator_for_initializers, p_tensor);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
+      const auto& memory_info = initializer.alloc != nullptr ? initializer.alloc->Info()
+                                                             : initializer.m->GetAllocInfo();
+      if (utils::HasExternalData(tensor_proto) && external_data_loader_mgr.GetExternalDataLoader(memory_info)) {
+        initializer.mode = CreateMode::kDeserializeSerially;
+      } else if (memory_info.device.Type() != OrtDevice::CPU && bool(initializer.alloc) != initializer.m.has_value()) {
+        initializer.mode = CreateMode::kCopyToDevice;
+      } else {
+        // also reports an invalid combination of a preallocated buffer and an allocator
+        initializer.mode = CreateMode::kDeserialize;
       }
-    }
 
-    // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
-    // so we need to output this message prior to calling save_tensor_func
-    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
+      // the initializers to share aren't traced, so are allocated with the allocator
+      initializer.shareable = shared_initializer_ids.find(ort_value_index) != shared_initializer_ids.end() &&
+                              initializer.mode != CreateMode::kDeserializeSerially && initializer.alloc != nullptr;
 
-    // any outer scope value is shadowed by a local value and can't override it.
-    // due to that check_outer_scope is false
-    const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
-#if !defined(DISABLE_SPARSE_TENSORS)
-    const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, sparse));
-#else
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, false));
-#endif
+      SafeInt<size_t> size_in_bytes = 0;
+      if (utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &size_in_bytes).IsOK()) {
+        batch_size_in_bytes += size_in_bytes;
+      }
+    }
+
+    if (batch_size_in_bytes >= kMaxBatchSizeInBytes) {
+      ORT_RETURN_IF_ERROR(create_and_save_batch());
+    }
   }
 
+  ORT_RETURN_IF_ERROR(create_and_save_batch());
+
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
@@ -4,15 +4,18 @@
 #pragma once
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
 #include "core/common/const_pointer_container.h"
 #include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
 #include "core/framework/tensor.h"
 #include "core/framework/tensor_allocator.h"
 #include "core/framework/session_options.h"
 #include "core/framework/sequential_execution_plan.h"
+#include "core/graph/onnx_protobuf.h"
 #include "core/platform/path_lib.h"
 
 namespace onnxruntime {
@@ -33,11 +36,58 @@ namespace logging {
 class Logger;
 }
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(const std::string& name, int idx, const OrtValue& value,
                                                 const OrtCallback& d, bool constant, bool sparse)>;
 using MemoryProfileFunction = std::function<void(ITensorAllocator& planner)>;
 
+/**
+ * An initializer with external data that is loaded the first time it is used,
+ * see kOrtSessionOptionsLazyLoadExternalInitializers.
+ *
+ * Value() is the OrtValue stored in the session state. Until Load() succeeds its tensor has the shape and type of
+ * the initializer but no data, after that it points to the loaded data. As the tensor is updated in place, copies
+ * of the OrtValue in execution frames see the data too.
+ */
+class LazyInitializer {
+ public:
+  LazyInitializer(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
+                  const ONNX_NAMESPACE::TensorProto& tensor_proto, const AllocatorPtr& alloc,
+                  const AllocatorPtr& default_cpu_alloc, const DataTransferManager& data_transfer_mgr,
+                  const ExternalDataLoaderManager& external_data_loader_mgr,
+                  bool use_device_allocator_for_initializers, bool constant);
+
+  const OrtValue& Value() const noexcept { return value_; }
+
+  // whether the initializer is constant, i.e. kernels may pre-pack it
+  bool IsConstant() const noexcept { return constant_; }
+
+  // Reads the data of the initializer, or returns the result of the first call. Thread safe.
+  Status Load();
+
+ private:
+  const Env& env_;
+  const std::basic_string<PATH_CHAR_TYPE> graph_loc_;
+  // copy as the initializers are removed from the graph once the session state is finalized
+  const ONNX_NAMESPACE::TensorProto tensor_proto_;
+  const AllocatorPtr alloc_;
+  const AllocatorPtr default_cpu_alloc_;
+  const DataTransferManager& data_transfer_mgr_;
+  const ExternalDataLoaderManager& external_data_loader_mgr_;
+  const bool use_device_allocator_for_initializers_;
+  const bool constant_;
+
+  OrtValue value_;
+  // owns the data value_ points to once loaded
+  OrtValue data_;
+  std::once_flag load_flag_;
+  Status load_status_;
+};
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_memory_info,
@@ -50,7 +100,9 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors);
+    std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors,
+    InlinedHashMap<int, std::unique_ptr<LazyInitializer>>& lazy_initializers,
+    concurrency::ThreadPool* thread_pool = nullptr);
 
 common::Status AllocateTensor(
     const onnxruntime::MemBuffer* m,
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "core/framework/data_types.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+namespace {
+constexpr size_t kMinEntriesToCleanUp = 32;
+}  // namespace
+
+SharedInitializerStore& SharedInitializerStore::Instance() {
+  // intentionally leaked, so that the sessions in static objects can release their initializers at exit
+  static SharedInitializerStore* instance = new SharedInitializerStore();
+  return *instance;
+}
+
+OrtValue SharedInitializerStore::MakeSharedValue(std::shared_ptr<Entry> entry) {
+  Tensor& tensor = *entry->value.GetMutable<Tensor>();
+  auto p_tensor = std::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), tensor.MutableDataRaw(),
+                                           tensor.Location());
+
+  // the value keeps the entry, and with it the data, alive
+  OrtValue value;
+  value.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(),
+             [entry = std::move(entry)](void* p) { delete static_cast<Tensor*>(p); });
+  return value;
+}
+
+std::optional<OrtValue> SharedInitializerStore::Find(const std::string& key) {
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      entry = it->second.lock();
+    }
+  }
+
+  if (!entry) {
+    return std::nullopt;
+  }
+  return MakeSharedValue(std::move(entry));
+}
+
+OrtValue SharedInitializerStore::Add(const std::string& key, OrtValue&& value) {
+  ORT_ENFORCE(value.IsTensor(), "Only tensors can be shared.");
+
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto& stored = entries_[key];
+    entry = stored.lock();
+    if (!entry) {
+      entry = std::make_shared<Entry>(Entry{std::move(value)});
+      stored = entry;
+
+      // drop the keys of the initializers that were released once they may make up half of the keys
+      if (entries_.size() >= 2 * num_entries_after_cleanup_) {
+        for (auto it = entries_.begin(); it != entries_.end();) {
+          it = it->second.expired() ? entries_.erase(it) : std::next(it);
+        }
+        num_entries_after_cleanup_ = std::max(entries_.size(), kMinEntriesToCleanUp);
+      }
+    }
+  }
+
+  return MakeSharedValue(std::move(entry));
+}
+
+size_t SharedInitializerStore::Size() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  size_t size = 0;
+  for (const auto& entry : entries_) {
+    size += entry.second.expired() ? 0 : 1;
+  }
+  return size;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/ort_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Process wide store of the initializers created by the sessions that enable
+ * kOrtSessionOptionsShareInitializersAcrossSessions, keyed by the hash of their content, their type and shape, and
+ * the device they are on.
+ *
+ * A session looks up each of its initializers before it allocates it, so sessions of the same model with different
+ * execution providers or optimization levels share the initializers that end up identical on the same device,
+ * including the results of constant folding and the copies on a device.
+ *
+ * The store doesn't keep the initializers alive. An initializer is released once no session uses it.
+ */
+class SharedInitializerStore final {
+ public:
+  static SharedInitializerStore& Instance();
+
+  // Returns a value that shares the data of the initializer stored with `key`, if there is one.
+  std::optional<OrtValue> Find(const std::string& key);
+
+  // Stores the tensor in `value` with `key` and returns the value the session should use instead of it.
+  // If another session stored an initializer with `key` in the meantime, the returned value shares that one and
+  // `value` is released.
+  OrtValue Add(const std::string& key, OrtValue&& value);
+
+  // the number of initializers that are in use
+  size_t Size();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerStore);
+
+ private:
+  SharedInitializerStore() = default;
+
+  struct Entry {
+    OrtValue value;
+  };
+
+  static OrtValue MakeSharedValue(std::shared_ptr<Entry> entry);
+
+  OrtMutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<Entry>> entries_;
+  // the keys are cleaned up when there are twice as many as after the last clean up
+  size_t num_entries_after_cleanup_ = 32;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/small_block_cache.h"
+
+#include <mutex>
+
+namespace onnxruntime {
+
+namespace {
+constexpr uint64_t kIndexMask = 0xFFFFFFFFull;
+
+uint64_t PackHead(uint64_t tag, uint64_t index_plus_one) {
+  return (tag << 32) | (index_plus_one & kIndexMask);
+}
+}  // namespace
+
+SmallBlockCache::SmallBlockCache(void* pool, size_t pool_size)
+    : pool_(static_cast<char*>(pool)),
+      pool_size_(pool_size),
+      num_pages_(pool_size / kPageSize) {
+  ORT_ENFORCE(pool_ != nullptr, "SmallBlockCache requires a valid pool.");
+  ORT_ENFORCE(pool_size_ % kPageSize == 0, "SmallBlockCache pool size must be a multiple of ", kPageSize);
+  ORT_ENFORCE(reinterpret_cast<std::uintptr_t>(pool_) % kMinBlockSize == 0,
+              "SmallBlockCache pool must be aligned to ", kMinBlockSize, " bytes.");
+
+  const size_t num_blocks = pool_size_ / kMinBlockSize;
+  ORT_ENFORCE(num_blocks < kIndexMask, "SmallBlockCache pool is too large.");
+
+  next_ = std::make_unique<std::atomic<uint32_t>[]>(num_blocks);
+  page_size_class_ = std::make_unique<std::atomic<int8_t>[]>(num_pages_);
+  for (size_t i = 0; i < num_pages_; ++i) {
+    page_size_class_[i].store(kUnassignedPage, std::memory_order_relaxed);
+  }
+
+  for (auto& head : free_list_heads_) {
+    head.store(0, std::memory_order_relaxed);
+  }
+}
+
+int SmallBlockCache::SizeClassFor(size_t size) {
+  int size_class = 0;
+  while (SizeClassToBytes(size_class) < size) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+size_t SmallBlockCache::BlockSize(const void* p) const {
+  const size_t page = static_cast<size_t>(static_cast<const char*>(p) - pool_) / kPageSize;
+  const int8_t size_class = page_size_class_[page].load(std::memory_order_acquire);
+  ORT_ENFORCE(size_class != kUnassignedPage, "Pointer ", p, " is not a block handed out by this cache.");
+  return SizeClassToBytes(size_class);
+}
+
+void SmallBlockCache::Push(int size_class, uint32_t block_index) {
+  auto& head = free_list_heads_[size_class];
+  uint64_t old_head = head.load(std::memory_order_relaxed);
+  uint64_t new_head;
+  do {
+    next_[block_index].store(static_cast<uint32_t>(old_head & kIndexMask), std::memory_order_relaxed);
+    new_head = PackHead((old_head >> 32) + 1, uint64_t{block_index} + 1);
+  } while (!head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool SmallBlockCache::TryPop(int size_class, uint32_t& block_index) {
+  auto& head = free_list_heads_[size_class];
+  uint64_t old_head = head.load(std::memory_order_acquire);
+  uint64_t new_head;
+  do {
+    const uint64_t index_plus_one = old_head & kIndexMask;
+    if (index_plus_one == 0) {
+      return false;
+    }
+
+    // The tag in the upper bits makes the CAS fail if the head was popped and pushed back concurrently,
+    // in which case the value read from next_ may be stale and is discarded.
+    const uint32_t next = next_[index_plus_one - 1].load(std::memory_order_relaxed);
+    new_head = PackHead((old_head >> 32) + 1, next);
+  } while (!head.compare_exchange_weak(old_head, new_head, std::memory_order_acquire, std::memory_order_acquire));
+
+  block_index = static_cast<uint32_t>((old_head & kIndexMask) - 1);
+  return true;
+}
+
+bool SmallBlockCache::Refill(int size_class) {
+  std::lock_guard<OrtMutex> lock(refill_mutex_);
+
+  // Another thread may have refilled this size class while we were waiting.
+  if ((free_list_heads_[size_class].load(std::memory_order_acquire) & kIndexMask) != 0) {
+    return true;
+  }
+
+  if (next_free_page_ == num_pages_) {
+    return false;
+  }
+
+  const size_t page = next_free_page_++;
+  page_size_class_[page].store(static_cast<int8_t>(size_class), std::memory_order_release);
+
+  const size_t block_size = SizeClassToBytes(size_class);
+  char* page_begin = pool_ + page * kPageSize;
+  for (size_t offset = 0; offset < kPageSize; offset += block_size) {
+    Push(size_class, BlockIndex(page_begin + offset));
+  }
+
+  return true;
+}
+
+void* SmallBlockCache::Alloc(size_t size) {
+  if (!Handles(size)) {
+    return nullptr;
+  }
+
+  const int size_class = SizeClassFor(size);
+  uint32_t block_index = 0;
+  while (!TryPop(size_class, block_index)) {
+    if (!Refill(size_class)) {
+      return nullptr;
+    }
+  }
+
+  const auto block_size = static_cast<int64_t>(SizeClassToBytes(size_class));
+  const int64_t in_use = bytes_in_use_.fetch_add(block_size, std::memory_order_relaxed) + block_size;
+  int64_t max_in_use = max_bytes_in_use_.load(std::memory_order_relaxed);
+  while (in_use > max_in_use &&
+         !max_bytes_in_use_.compare_exchange_weak(max_in_use, in_use, std::memory_order_relaxed)) {
+  }
+  num_allocs_.fetch_add(1, std::memory_order_relaxed);
+
+  return pool_ + size_t{block_index} * kMinBlockSize;
+}
+
+void SmallBlockCache::Free(void* p) {
+  const size_t page = static_cast<size_t>(static_cast<char*>(p) - pool_) / kPageSize;
+  const int8_t size_class = page_size_class_[page].load(std::memory_order_acquire);
+  ORT_ENFORCE(size_class != kUnassignedPage, "Pointer ", p, " is not a block handed out by this cache.");
+
+  bytes_in_use_.fetch_sub(static_cast<int64_t>(SizeClassToBytes(size_class)), std::memory_order_relaxed);
+  Push(size_class, BlockIndex(p));
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// A size-class cache for small allocations that sits in front of BFCArena.
+//
+// The cache owns a single contiguous pool which is carved into fixed size pages. A page is assigned to a size class
+// the first time that class needs more blocks and is then split into equally sized blocks. Free blocks of each size
+// class are kept on a lock-free stack, so Alloc/Free of a small block does not take the arena mutex.
+// Whether a pointer belongs to the cache is decided by a range check against the pool, so Free does not need to
+// know the size of the allocation.
+//
+// Pages are never returned to the arena. If the pool is exhausted for a size class, Alloc returns nullptr and the
+// caller is expected to fall back to the regular arena path.
+//
+// This class is thread-safe.
+class SmallBlockCache {
+ public:
+  // Allocations larger than this are never served by the cache.
+  static constexpr size_t kMaxBlockSize = 4096;
+  static constexpr size_t kMinBlockSize = 256;
+  static constexpr size_t kPageSize = 64 * 1024;
+
+  // `pool` must be at least kMinBlockSize aligned and `pool_size` a multiple of kPageSize. The memory is not owned.
+  SmallBlockCache(void* pool, size_t pool_size);
+
+  // Returns nullptr if `size` is not handled by the cache or the pool is exhausted for its size class.
+  void* Alloc(size_t size);
+
+  // `p` must satisfy Owns(p).
+  void Free(void* p);
+
+  bool Owns(const void* p) const {
+    const auto* c = static_cast<const char*>(p);
+    return c >= pool_ && c < pool_ + pool_size_;
+  }
+
+  // Size of the block backing `p`. `p` must satisfy Owns(p).
+  size_t BlockSize(const void* p) const;
+
+  int64_t BytesInUse() const { return bytes_in_use_.load(std::memory_order_relaxed); }
+  int64_t NumAllocs() const { return num_allocs_.load(std::memory_order_relaxed); }
+  int64_t MaxBytesInUse() const { return max_bytes_in_use_.load(std::memory_order_relaxed); }
+
+  static bool Handles(size_t size) { return size > 0 && size <= kMaxBlockSize; }
+
+ private:
+  // 256, 512, 1024, 2048 and 4096 byte blocks.
+  static constexpr int kNumSizeClasses = 5;
+  static constexpr int8_t kUnassignedPage = -1;
+
+  static int SizeClassFor(size_t size);
+  static size_t SizeClassToBytes(int size_class) { return kMinBlockSize << size_class; }
+
+  // Block indices are in units of kMinBlockSize from the start of the pool.
+  uint32_t BlockIndex(const void* p) const {
+    return static_cast<uint32_t>((static_cast<const char*>(p) - pool_) / kMinBlockSize);
+  }
+
+  void Push(int size_class, uint32_t block_index);
+  bool TryPop(int size_class, uint32_t& block_index);
+
+  // Assigns a fresh page to `size_class`. Returns false if there are no pages left.
+  bool Refill(int size_class);
+
+  char* const pool_;
+  const size_t pool_size_;
+  const size_t num_pages_;
+
+  // The head of each free list packs an ABA tag in the upper 32 bits and (block index + 1) in the lower 32 bits.
+  // A value of 0 in the lower 32 bits means the list is empty.
+  std::atomic<uint64_t> free_list_heads_[kNumSizeClasses];
+  std::unique_ptr<std::atomic<uint32_t>[]> next_;
+  std::unique_ptr<std::atomic<int8_t>[]> page_size_class_;
+
+  OrtMutex refill_mutex_;
+  size_t next_free_page_ = 0;
+
+  std::atomic<int64_t> bytes_in_use_{0};
+  std::atomic<int64_t> max_bytes_in_use_{0};
+  std::atomic<int64_t> num_allocs_{0};
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SmallBlockCache);
+};
+
+}  // namespace onnxruntime
@@ -5,8 +5,11 @@
 #include "core/framework/execution_frame.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/session_state.h"
+#include "core/framework/sequential_executor.h"
 #include "core/common/spin_pause.h"
 
+#include <limits>
+
 namespace onnxruntime {
 #ifdef ORT_ENABLE_STREAM
 StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
@@ -22,13 +25,12 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
                                                const logging::Logger& sess_logger,
                                                bool single_thread_mode)
     : session_state_(&sess_state),
-      frame_(feed_mlvalue_idxs,
-             feeds,
-             fetch_mlvalue_idxs,
-             fetches,
-             fetch_allocators,
-             device_stream_map,
-             sess_state),
+      frame_(sess_state.AcquireExecutionFrame(feed_mlvalue_idxs,
+                                              feeds,
+                                              fetch_mlvalue_idxs,
+                                              fetches,
+                                              fetch_allocators,
+                                              device_stream_map)),
       logger_(&sess_logger),
       single_thread_mode_(single_thread_mode),
       device_stream_map_(device_stream_map),
@@ -62,6 +64,12 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
   for (size_t i = 0; i < release_actions.size(); ++i) {
     release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
   }
+  // init the pending producer counts of the dynamic schedule
+  const auto& num_producers = sess_state.GetExecutionPlan()->dynamic_schedule.num_producers;
+  pending_producers_ = std::make_unique<std::atomic_int[]>(num_producers.size());
+  for (size_t i = 0; i < num_producers.size(); ++i) {
+    pending_producers_[i] = num_producers[i];
+  }
 }
 
 synchronize::Notification* StreamExecutionContext ::GetNotification(size_t idx) { return notifications_[idx].get(); }
@@ -90,12 +98,11 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
                                                const logging::Logger& sess_logger,
                                                bool single_thread_mode)
     : session_state_(&sess_state),
-      frame_(feed_mlvalue_idxs,
-             feeds,
-             fetch_mlvalue_idxs,
-             fetches,
-             fetch_allocators,
-             sess_state),
+      frame_(sess_state.AcquireExecutionFrame(feed_mlvalue_idxs,
+                                              feeds,
+                                              fetch_mlvalue_idxs,
+                                              fetches,
+                                              fetch_allocators)),
       logger_(&sess_logger),
       single_thread_mode_(single_thread_mode) {
 #ifdef _WIN32
@@ -114,6 +121,12 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
   for (size_t i = 0; i < release_actions.size(); ++i) {
     release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
   }
+  // init the pending producer counts of the dynamic schedule
+  const auto& num_producers = sess_state.GetExecutionPlan()->dynamic_schedule.num_producers;
+  pending_producers_ = std::make_unique<std::atomic_int[]>(num_producers.size());
+  for (size_t i = 0; i < num_producers.size(); ++i) {
+    pending_producers_[i] = num_producers[i];
+  }
 }
 
 synchronize::Notification* StreamExecutionContext ::GetNotification(size_t /*idx*/) {
@@ -133,7 +146,7 @@ const SessionState& StreamExecutionContext ::GetSessionState() const { return *s
 
 const logging::Logger& StreamExecutionContext ::GetLogger() const { return *logger_; }
 
-ExecutionFrame& StreamExecutionContext ::GetExecutionFrame() { return frame_; }
+ExecutionFrame& StreamExecutionContext ::GetExecutionFrame() { return *frame_; }
 
 const Status& StreamExecutionContext ::TaskStatus() const {
   return task_status_;
@@ -161,13 +174,18 @@ void StreamExecutionContext ::SetStatus(Status& status) {
     task_status_ = status;
 }
 
-StreamExecutionContext::~StreamExecutionContext() {}
+StreamExecutionContext::~StreamExecutionContext() {
+  session_state_->RecycleExecutionFrame(std::move(frame_));
+}
 
 void StreamExecutionContext::RecycleNodeInputs(onnxruntime::NodeIndex node_index) {
   auto* execution_plan = session_state_->GetExecutionPlan();
-  for (auto idx : execution_plan->node_release_list[node_index]) {
+  const auto& release_offsets = execution_plan->node_release_offsets;
+  const auto& release_actions = execution_plan->node_release_actions;
+  for (size_t i = release_offsets[node_index], end = release_offsets[node_index + 1]; i < end; ++i) {
+    const size_t idx = release_actions[i];
     if (--release_plan_[idx] == 0) {
-      ORT_ENFORCE(frame_.ReleaseMLValue(static_cast<int>(execution_plan->release_actions[idx].value_index)).IsOK());
+      ORT_ENFORCE(frame_->ReleaseMLValue(static_cast<int>(execution_plan->release_actions[idx].value_index)).IsOK());
       VLOGS(*logger_, 0) << "ort value " << execution_plan->release_actions[idx].value_index << " released";
     }
   }
@@ -196,7 +214,8 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
 #endif
 
   // get logic stream
-  auto& execution_plan = ctx.GetSessionState().GetExecutionPlan()->execution_plan;
+  auto* plan = ctx.GetSessionState().GetExecutionPlan();
+  auto& execution_plan = plan->execution_plan;
   auto& logic_stream = execution_plan[stream_idx];
   size_t end = logic_stream->steps_.size();
 #ifdef ENABLE_TRAINING
@@ -204,6 +223,14 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
   if (range)
     end = std::min(end, range->stream_pc_range[stream_idx].second);
 #endif
+  // a stream of kernel launches only runs the kernels directly
+  const NodeIndex* kernel_launch_nodes = plan->kernel_launch_nodes.empty() ? nullptr : plan->kernel_launch_nodes.data();
+#ifdef ENABLE_TRAINING
+  // the steps skip the nodes that are not to be executed
+  if (ctx.GetNodeToExecute()) {
+    kernel_launch_nodes = nullptr;
+  }
+#endif
 
   while (since < end) {
     if (!ctx.TaskStatus().IsOK()) {
@@ -219,7 +246,12 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
     bool continue_flag = true;
     Status status;
     ORT_TRY {
-      status = logic_stream->steps_[since]->Execute(ctx, stream_idx, session_scope, terminate_flag, continue_flag);
+      if (kernel_launch_nodes) {
+        status = ExecuteKernel(ctx, kernel_launch_nodes[since], stream_idx, terminate_flag, session_scope);
+        continue_flag = status.IsOK();
+      } else {
+        status = logic_stream->steps_[since]->Execute(ctx, stream_idx, session_scope, terminate_flag, continue_flag);
+      }
     }
     ORT_CATCH(const std::exception& ex) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -244,6 +276,61 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
   return;
 }
 
+void RunDynamic(StreamExecutionContext& ctx, SessionScope& session_scope, const bool& terminate_flag, size_t step_idx) {
+  auto* plan = ctx.GetSessionState().GetExecutionPlan();
+  auto& steps = plan->execution_plan[0]->steps_;
+  auto& schedule = plan->dynamic_schedule;
+  auto* tp = ctx.SingleThreadMode() ? nullptr : ctx.GetSessionState().GetInterOpThreadPool();
+
+  for (;;) {
+    if (!ctx.TaskStatus().IsOK()) {
+      break;
+    }
+    if (terminate_flag) {
+      Status status_made = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+      ctx.SetStatus(status_made);
+      break;
+    }
+    bool continue_flag = true;
+    Status status;
+    ORT_TRY {
+      status = steps[step_idx]->Execute(ctx, 0, session_scope, terminate_flag, continue_flag);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    if (!status.IsOK()) {
+      ctx.SetStatus(status);
+      break;
+    }
+
+    // keep the first consumer that became ready on this thread, hand the others to the thread pool.
+    // Schedule() from a worker thread pushes to the front of the worker's own queue, idle workers steal from the back.
+    constexpr size_t kNoStep = std::numeric_limits<size_t>::max();
+    size_t next_step = kNoStep;
+    for (auto consumer : schedule.consumers[step_idx]) {
+      if (!ctx.DecPendingProducers(consumer)) {
+        continue;
+      }
+      if (next_step == kNoStep) {
+        next_step = consumer;
+      } else {
+        ctx.AddTask();
+        concurrency::ThreadPool::Schedule(tp, [&ctx, &session_scope, &terminate_flag, consumer]() {
+          RunDynamic(ctx, session_scope, terminate_flag, consumer);
+        });
+      }
+    }
+    if (next_step == kNoStep) {
+      break;
+    }
+    step_idx = next_step;
+  }
+  ctx.CompleteTask();
+}
+
 void ScheduleDownstream(StreamExecutionContext& ctx, size_t trigger, bool single_thread_mode,
                         const bool& terminate_flag, SessionScope& session_scope) {
   auto* plan = ctx.GetSessionState().GetExecutionPlan();
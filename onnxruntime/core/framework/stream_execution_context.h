@@ -116,6 +116,13 @@ class StreamExecutionContext {
   // Release the OrtValues after a step, based on the execution plan.
   void RecycleNodeInputs(onnxruntime::NodeIndex node_index);
 
+  // Decrease the number of pending producers of a step in the plan's dynamic schedule.
+  // Returns true if the step became ready to run.
+  bool DecPendingProducers(size_t step_idx) {
+    // acq_rel so the outputs written by all the producers are visible to the thread that runs the step
+    return pending_producers_[step_idx].fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
 #ifdef ENABLE_TRAINING
   void SetOrtValueCache(OrtValueCachePtr cache) {
     cache_ = std::move(cache);
@@ -150,12 +157,16 @@ class StreamExecutionContext {
  private:
   const SessionState* session_state_;
 
-  ExecutionFrame frame_;
+  // acquired from the session state, which may pool it for the next runs once this one completes
+  std::unique_ptr<ExecutionFrame> frame_;
 
   const logging::Logger* logger_;
 
   std::unique_ptr<std::atomic_int[]> release_plan_;
 
+  // per step count of producers that haven't completed, only used with a dynamic schedule
+  std::unique_ptr<std::atomic_int[]> pending_producers_;
+
   CountDownBarrier remain_tasks_;
 
   Status task_status_{Status::OK()};
@@ -189,6 +200,14 @@ void RunSince(size_t stream_idx,
               const bool& terminate_flag,
               size_t since);
 
+// Execute the steps of a plan with a dynamic schedule, starting from step 'step_idx' of the single logic stream.
+// Consumers that become ready are run on the current thread or scheduled on the inter-op thread pool, where idle
+// workers steal them from the queue of the scheduling thread.
+void RunDynamic(StreamExecutionContext& ctx,
+                SessionScope& session_scope,
+                const bool& terminate_flag,
+                size_t step_idx);
+
 // Schedule the downstream jobs from other streams at 'trigger' step, based on the execution plan.
 void ScheduleDownstream(StreamExecutionContext& ctx,
                         size_t trigger,
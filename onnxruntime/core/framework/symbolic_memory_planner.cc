@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/symbolic_memory_planner.h"
+
+#include <algorithm>
+
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+std::unique_ptr<SymbolicMemoryPlanner> SymbolicMemoryPlanner::Create(const GraphViewer& graph_viewer,
+                                                                     const SequentialExecutionPlan& execution_plan,
+                                                                     const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                                     gsl::span<const int> feed_mlvalue_idxs,
+                                                                     gsl::span<const OrtValue> feeds,
+                                                                     gsl::span<const TraceEvent> trace) {
+  std::unique_ptr<SymbolicMemoryPlanner> planner(new SymbolicMemoryPlanner(execution_plan));
+
+  // number the symbolic dims of the graph inputs
+  InlinedHashMap<std::string, int> symbols;
+  for (const auto* input : graph_viewer.GetInputs()) {
+    const auto* shape = input->Shape();
+    int input_idx = -1;
+    if (shape == nullptr || !ort_value_name_idx_map.GetIdx(input->Name(), input_idx).IsOK()) {
+      continue;
+    }
+
+    for (int k = 0, end = shape->dim_size(); k < end; ++k) {
+      const auto& dim = shape->dim(k);
+      if (!dim.has_dim_param() || dim.dim_param().empty()) {
+        continue;
+      }
+
+      auto [it, inserted] = symbols.emplace(dim.dim_param(), static_cast<int>(planner->symbol_sources_.size()));
+      if (inserted) {
+        planner->symbol_sources_.emplace_back();
+      }
+      planner->symbol_sources_[it->second].push_back({input_idx, static_cast<size_t>(k)});
+    }
+  }
+
+  if (symbols.empty()) {
+    return nullptr;
+  }
+
+  InlinedVector<int64_t> symbol_values;
+  if (!planner->ResolveSymbols(feed_mlvalue_idxs, feeds, symbol_values).IsOK()) {
+    return nullptr;
+  }
+
+  // keep the allocations of the tensors whose size is the product of fixed and symbolic dims, and their frees
+  InlinedHashSet<int> planned_values;
+  for (const auto& trace_event : trace) {
+    if (trace_event.is_free) {
+      if (planned_values.count(trace_event.ort_value_idx) != 0) {
+        planner->events_.push_back({trace_event.ort_value_idx, nullptr, {}});
+      }
+      continue;
+    }
+
+    std::string name;
+    if (!ort_value_name_idx_map.GetName(trace_event.ort_value_idx, name).IsOK()) {
+      continue;
+    }
+    const auto* node_arg = graph_viewer.GetNodeArg(name);
+    const auto* shape = node_arg != nullptr ? node_arg->Shape() : nullptr;
+    const auto* value_type = execution_plan.allocation_plan[trace_event.ort_value_idx].value_type;
+    if (shape == nullptr || value_type == nullptr || !value_type->IsTensorType()) {
+      continue;
+    }
+
+    PlannedEvent event{trace_event.ort_value_idx,
+                       static_cast<const TensorTypeBase*>(value_type)->GetElementType(), {}};
+    bool resolvable = true;
+    for (const auto& dim : shape->dim()) {
+      if (dim.has_dim_value() && dim.dim_value() >= 0) {
+        event.dims.push_back({dim.dim_value(), -1});
+        continue;
+      }
+
+      auto symbol = dim.has_dim_param() ? symbols.find(dim.dim_param()) : symbols.end();
+      if (symbol == symbols.end()) {
+        resolvable = false;
+        break;
+      }
+      event.dims.push_back({0, symbol->second});
+    }
+
+    // the shape in the graph must give the size that was allocated
+    size_t size = 0;
+    if (!resolvable || !CalculateSize(event, symbol_values, size).IsOK() || size != trace_event.size) {
+      continue;
+    }
+
+    planned_values.insert(event.ort_value_idx);
+    planner->events_.push_back(std::move(event));
+  }
+
+  planner->num_planned_tensors_ = planned_values.size();
+  if (planner->num_planned_tensors_ == 0) {
+    return nullptr;
+  }
+
+  return planner;
+}
+
+Status SymbolicMemoryPlanner::ResolveSymbols(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                             InlinedVector<int64_t>& symbol_values) const {
+  symbol_values.assign(symbol_sources_.size(), -1);
+  for (size_t symbol = 0; symbol < symbol_sources_.size(); ++symbol) {
+    for (const auto& source : symbol_sources_[symbol]) {
+      auto feed = std::find(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end(), source.ort_value_idx);
+      if (feed == feed_mlvalue_idxs.end()) {
+        // a graph input with an initializer for a default value that is not fed
+        continue;
+      }
+
+      const auto& feed_value = feeds[static_cast<size_t>(feed - feed_mlvalue_idxs.begin())];
+      ORT_RETURN_IF_NOT(feed_value.IsTensor(), "Input ", source.ort_value_idx, " is not a tensor.");
+      const auto& dims = feed_value.Get<Tensor>().Shape().GetDims();
+      ORT_RETURN_IF_NOT(source.dim < dims.size(), "Input ", source.ort_value_idx, " has a rank of ", dims.size(),
+                        " which doesn't match the graph input.");
+
+      const int64_t value = dims[source.dim];
+      ORT_RETURN_IF_NOT(symbol_values[symbol] < 0 || symbol_values[symbol] == value,
+                        "A symbolic dim has the values ", symbol_values[symbol], " and ", value, " in the inputs.");
+      symbol_values[symbol] = value;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status SymbolicMemoryPlanner::CalculateSize(const PlannedEvent& event, gsl::span<const int64_t> symbol_values,
+                                            size_t& size) {
+  TensorShapeVector dims;
+  dims.reserve(event.dims.size());
+  for (const auto& dim : event.dims) {
+    const int64_t value = dim.symbol < 0 ? dim.value : symbol_values[dim.symbol];
+    ORT_RETURN_IF(value < 0, "A symbolic dim of the tensor is not fed.");
+    dims.push_back(value);
+  }
+
+  return Tensor::CalculateTensorStorageSize(event.element_type, TensorShape(dims), kAllocAlignment, size);
+}
+
+Status SymbolicMemoryPlanner::GeneratePatterns(gsl::span<const int> feed_mlvalue_idxs,
+                                               gsl::span<const OrtValue> feeds, MemoryPatternGroup& out) const {
+  InlinedVector<int64_t> symbol_values;
+  ORT_RETURN_IF_ERROR(ResolveSymbols(feed_mlvalue_idxs, feeds, symbol_values));
+
+  OrtValuePatternPlanner planner(execution_plan_);
+  for (const auto& event : events_) {
+    if (event.element_type == nullptr) {
+      ORT_RETURN_IF_ERROR(planner.TraceFree(event.ort_value_idx));
+      continue;
+    }
+
+    size_t size = 0;
+    ORT_RETURN_IF_ERROR(CalculateSize(event, symbol_values, size));
+    ORT_RETURN_IF_ERROR(planner.TraceAllocation(event.ort_value_idx, size));
+  }
+
+  return planner.GeneratePatterns(out);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/data_types.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class OrtValueNameIdxMap;
+struct SequentialExecutionPlan;
+
+/**
+ * Plans the memory patterns of input shapes that were not run yet, from the symbolic dims of the tensors.
+ *
+ * The allocations and frees of a run that generated a memory pattern are recorded in the order they happened, which
+ * for a sequential execution plan is the same for all input shapes. The shape of most tensors in the graph is made
+ * of fixed dims and of the symbolic dims of the graph inputs, e.g. {batch, seq_len, 768}, so their sizes can be
+ * evaluated for the input shapes of a new run. Replaying the recorded allocations with the evaluated sizes gives the
+ * memory pattern of the run before it executes, so its activations are allocated in one block per device even on
+ * the first run with these input shapes.
+ *
+ * Tensors whose size can't be evaluated, e.g. the output of NonZero or of a Reshape to a computed shape, are left
+ * out of the pattern and allocated when they are created.
+ */
+class SymbolicMemoryPlanner {
+ public:
+  // an allocation or a free recorded by the execution frame while it generated a memory pattern
+  struct TraceEvent {
+    int ort_value_idx;
+    // the size of an allocation
+    size_t size;
+    bool is_free;
+  };
+
+  /**
+   * Create the planner from the allocations of a run with `feeds`.
+   * Returns nullptr if the graph inputs have no symbolic dims, or if no tensor size could be expressed with them.
+   */
+  static std::unique_ptr<SymbolicMemoryPlanner> Create(const GraphViewer& graph_viewer,
+                                                       const SequentialExecutionPlan& execution_plan,
+                                                       const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                       gsl::span<const int> feed_mlvalue_idxs,
+                                                       gsl::span<const OrtValue> feeds,
+                                                       gsl::span<const TraceEvent> trace);
+
+  /**
+   * Generate the memory patterns for a run with `feeds`.
+   * Fails if the value of a symbolic dim can't be taken from the feeds, e.g. a graph input is not fed.
+   */
+  Status GeneratePatterns(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                          MemoryPatternGroup& out) const;
+
+  size_t NumPlannedTensors() const { return num_planned_tensors_; }
+
+ private:
+  // a dim of a planned tensor: a fixed value, or the symbolic dim at `symbol`
+  struct Dim {
+    int64_t value;
+    int symbol;
+  };
+
+  // where the value of a symbolic dim is taken from: the dim `dim` of the graph input `ort_value_idx`
+  struct SymbolSource {
+    int ort_value_idx;
+    size_t dim;
+  };
+
+  struct PlannedEvent {
+    int ort_value_idx;
+    // the element type and dims of an allocation. nullptr for a free
+    MLDataType element_type;
+    InlinedVector<Dim> dims;
+  };
+
+  explicit SymbolicMemoryPlanner(const SequentialExecutionPlan& execution_plan) : execution_plan_(execution_plan) {}
+
+  // resolve the values of the symbolic dims from the feeds of a run
+  Status ResolveSymbols(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                        InlinedVector<int64_t>& symbol_values) const;
+
+  static Status CalculateSize(const PlannedEvent& event, gsl::span<const int64_t> symbol_values, size_t& size);
+
+  const SequentialExecutionPlan& execution_plan_;
+  // the graph input dims each symbolic dim appears at. they must all have the same value in a run.
+  InlinedVector<InlinedVector<SymbolSource>> symbol_sources_;
+  std::vector<PlannedEvent> events_;
+  size_t num_planned_tensors_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "tensor_external_data_info.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "core/common/common.h"
 #include "core/platform/path_lib.h"
 
@@ -40,6 +44,12 @@ Status ExternalDataInfo::Create(const RepeatedPtrField<StringStringEntryProto>&
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "parsing ", stringmap.value(), " failed");
     } else if (stringmap.key() == "checksum" && !stringmap.value().empty()) {
       out->checksum_ = stringmap.value();
+    } else if (stringmap.key() == "compression" && !stringmap.value().empty()) {
+      if (stringmap.value() != "lz4") {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error! Unsupported external data compression '",
+                               stringmap.value(), "'");
+      }
+      out->compression_ = stringmap.value();
     } else {
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error!");
     }
@@ -47,6 +57,124 @@ Status ExternalDataInfo::Create(const RepeatedPtrField<StringStringEntryProto>&
   if (out->rel_path_.empty()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error! Missing 'location'");
   }
+  if (out->IsCompressed() && out->length_ == 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error! Compressed external data requires 'length'");
+  }
+  return Status::OK();
+}
+
+namespace {
+
+uint32_t ReadUInt32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// read the extra bytes of an LZ4 literal or match length
+bool ReadLz4Length(gsl::span<const uint8_t> input, size_t& pos, size_t& length) {
+  uint8_t byte = 0;
+  do {
+    if (pos >= input.size()) {
+      return false;
+    }
+    byte = input[pos++];
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+// decompress an LZ4 block, which must fill `output`
+Status DecompressLz4Block(gsl::span<const uint8_t> input, gsl::span<uint8_t> output) {
+  const auto corrupted = []() {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Compressed external data is corrupted.");
+  };
+
+  size_t in = 0;
+  size_t out = 0;
+  while (true) {
+    if (in >= input.size()) {
+      return corrupted();
+    }
+    const uint8_t token = input[in++];
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !ReadLz4Length(input, in, literal_length)) {
+      return corrupted();
+    }
+    if (literal_length > input.size() - in || literal_length > output.size() - out) {
+      return corrupted();
+    }
+    memcpy(output.data() + out, input.data() + in, literal_length);
+    in += literal_length;
+    out += literal_length;
+
+    // the last sequence has literals only
+    if (in == input.size()) {
+      break;
+    }
+
+    if (input.size() - in < 2) {
+      return corrupted();
+    }
+    const size_t match_offset = static_cast<size_t>(input[in]) | (static_cast<size_t>(input[in + 1]) << 8);
+    in += 2;
+    if (match_offset == 0 || match_offset > out) {
+      return corrupted();
+    }
+
+    size_t match_length = token & 0xF;
+    if (match_length == 15 && !ReadLz4Length(input, in, match_length)) {
+      return corrupted();
+    }
+    match_length += 4;
+    if (match_length > output.size() - out) {
+      return corrupted();
+    }
+
+    // the match may overlap the bytes it produces, so copy it in order
+    const uint8_t* match = output.data() + out - match_offset;
+    uint8_t* dst = output.data() + out;
+    if (match_offset >= match_length) {
+      memcpy(dst, match, match_length);
+    } else {
+      for (size_t i = 0; i < match_length; ++i) {
+        dst[i] = match[i];
+      }
+    }
+    out += match_length;
+  }
+
+  if (out != output.size()) {
+    return corrupted();
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status ExternalDataInfo::Decompress(gsl::span<const uint8_t> compressed, gsl::span<uint8_t> output) const {
+  ORT_RETURN_IF_NOT(IsCompressed(), "The external data is not compressed.");
+  ORT_RETURN_IF(compressed.size() < 8, "Compressed external data is truncated.");
+
+  const size_t num_chunks = ReadUInt32(compressed.data());
+  const size_t chunk_size = ReadUInt32(compressed.data() + 4);
+  ORT_RETURN_IF((compressed.size() - 8) / 4 < num_chunks, "Compressed external data is truncated.");
+  ORT_RETURN_IF(chunk_size == 0 ? !output.empty() || num_chunks != 0
+                                : num_chunks != (output.size() + chunk_size - 1) / chunk_size,
+                "Compressed external data has ", num_chunks, " chunks of ", chunk_size,
+                " bytes which doesn't match the tensor size of ", output.size(), " bytes.");
+
+  size_t in = 8 + 4 * num_chunks;
+  size_t out = 0;
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    const size_t compressed_size = ReadUInt32(compressed.data() + 8 + 4 * chunk);
+    ORT_RETURN_IF(compressed_size > compressed.size() - in, "Compressed external data is truncated.");
+    const size_t size = std::min(chunk_size, output.size() - out);
+    ORT_RETURN_IF_ERROR(DecompressLz4Block(compressed.subspan(in, compressed_size), output.subspan(out, size)));
+    in += compressed_size;
+    out += size;
+  }
+
   return Status::OK();
 }
 }  // namespace onnxruntime
\ No newline at end of file
@@ -3,6 +3,9 @@
 #pragma once
 
 #include <string>
+
+#include <gsl/gsl>
+
 #include "core/common/status.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/onnxruntime_c_api.h"
@@ -23,6 +26,19 @@ class ExternalDataInfo {
 
   const std::string& GetChecksum() const { return checksum_; }
 
+  // The data is compressed when the 'compression' key is "lz4". 'length' is then the size of the compressed data in
+  // the file, and the tensor's data is split in chunks that are compressed separately:
+  //   uint32 num_chunks
+  //   uint32 chunk_size: the uncompressed size of each chunk but the last one, which may be smaller
+  //   uint32 compressed_chunk_sizes[num_chunks]
+  //   the chunks in the LZ4 block format, e.g. from python's lz4.block.compress(chunk, store_size=False)
+  // The integers are little endian.
+  bool IsCompressed() const { return !compression_.empty(); }
+
+  // Decompress the data of the tensor from `compressed`, the 'length' bytes read from the file, to `output`, which
+  // has the size of the tensor's data.
+  common::Status Decompress(gsl::span<const uint8_t> compressed, gsl::span<uint8_t> output) const;
+
   // If the value of 'offset' or 'length' field is larger the max value of ssize_t, this function will treat it as a
   // wrong value and return FAIL.
   static common::Status Create(
@@ -36,5 +52,6 @@ class ExternalDataInfo {
   // 0 means the whole file
   size_t length_ = 0;
   std::string checksum_;
+  std::string compression_;
 };
 }  // namespace onnxruntime
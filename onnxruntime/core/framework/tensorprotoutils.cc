@@ -169,14 +169,14 @@ static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_prot
                                   const std::filesystem::path& tensor_proto_dir,
                                   std::basic_string<ORTCHAR_T>& external_file_path,
                                   onnxruntime::FileOffsetType& file_offset,
-                                  SafeInt<size_t>& tensor_byte_size) {
+                                  SafeInt<size_t>& tensor_byte_size,
+                                  std::unique_ptr<onnxruntime::ExternalDataInfo>& external_data_info) {
   ORT_RETURN_IF_NOT(onnxruntime::utils::HasExternalData(tensor_proto),
                     "Tensor does not have external data to read from.");
 
   ORT_RETURN_IF(!onnxruntime::utils::HasDataType(tensor_proto) || onnxruntime::utils::HasString(tensor_proto),
                 "External data type cannot be UNDEFINED or STRING.");
 
-  std::unique_ptr<onnxruntime::ExternalDataInfo> external_data_info;
   ORT_RETURN_IF_ERROR(onnxruntime::ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info));
 
   const auto& location = external_data_info->GetRelPath();
@@ -186,7 +186,9 @@ static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_prot
 
   ORT_RETURN_IF_ERROR(onnxruntime::utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &tensor_byte_size));
   const size_t external_data_length = external_data_info->GetLength();
-  ORT_RETURN_IF_NOT(external_data_length == 0 || external_data_length == tensor_byte_size,
+  // the length of compressed data is the size of the compressed data in the file
+  ORT_RETURN_IF_NOT(external_data_info->IsCompressed() || external_data_length == 0 ||
+                        external_data_length == tensor_byte_size,
                     "TensorProto: ", tensor_proto.name(),
                     " external data size mismatch. Computed size: ", *&tensor_byte_size,
                     ", external_data.length: ", external_data_length);
@@ -206,10 +208,22 @@ Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto
   std::basic_string<ORTCHAR_T> external_file_path;
   onnxruntime::FileOffsetType file_offset;
   SafeInt<size_t> tensor_byte_size;
-  ORT_RETURN_IF_ERROR(
-      GetExternalDataInfo(tensor_proto, tensor_proto_dir, external_file_path, file_offset, tensor_byte_size));
+  std::unique_ptr<onnxruntime::ExternalDataInfo> external_data_info;
+  ORT_RETURN_IF_ERROR(GetExternalDataInfo(tensor_proto, tensor_proto_dir, external_file_path, file_offset,
+                                          tensor_byte_size, external_data_info));
 
   unpacked_tensor.resize(tensor_byte_size);
+  if (external_data_info->IsCompressed()) {
+    const size_t compressed_length = external_data_info->GetLength();
+    std::vector<uint8_t> compressed(compressed_length);
+    ORT_RETURN_IF_ERROR(onnxruntime::Env::Default().ReadFileIntoBuffer(
+        external_file_path.c_str(),
+        file_offset,
+        compressed_length,
+        gsl::make_span(reinterpret_cast<char*>(compressed.data()), compressed_length)));
+    return external_data_info->Decompress(compressed, unpacked_tensor);
+  }
+
   ORT_RETURN_IF_ERROR(onnxruntime::Env::Default().ReadFileIntoBuffer(
       external_file_path.c_str(),
       file_offset,
@@ -997,8 +1011,12 @@ Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& mo
   std::basic_string<ORTCHAR_T> external_data_file_path;
   FileOffsetType file_offset;
   SafeInt<size_t> raw_data_safe_len = 0;
-  ORT_RETURN_IF_ERROR(
-      GetExternalDataInfo(tensor_proto, tensor_proto_dir, external_data_file_path, file_offset, raw_data_safe_len));
+  std::unique_ptr<ExternalDataInfo> external_data_info;
+  ORT_RETURN_IF_ERROR(GetExternalDataInfo(tensor_proto, tensor_proto_dir, external_data_file_path, file_offset,
+                                          raw_data_safe_len, external_data_info));
+  ORT_RETURN_IF(external_data_info->IsCompressed() &&
+                    external_data_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag,
+                "External initializer: ", tensor_proto.name(), " in memory can not be compressed.");
 
   if (external_data_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag) {
     // the value in location is the memory address of the data
@@ -1012,6 +1030,8 @@ Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& mo
     }
   } else {
 #if defined(__wasm__)
+    ORT_RETURN_IF(external_data_info->IsCompressed(), "External initializer: ", tensor_proto.name(),
+                  " is compressed, which is not supported in WebAssembly.");
     ORT_RETURN_IF(file_offset < 0 || file_offset + raw_data_safe_len >= 4294967296,
                   "External initializer: ", tensor_proto.name(), " offset: ", file_offset,
                   " size to read: ", static_cast<size_t>(raw_data_safe_len),
@@ -1033,14 +1053,33 @@ Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& mo
     // manually check file size first.
     std::uintmax_t file_length = std::filesystem::file_size(external_data_file_path);
 
+    const size_t size_to_read = external_data_info->IsCompressed() ? external_data_info->GetLength()
+                                                                   : static_cast<size_t>(raw_data_safe_len);
     SafeInt<FileOffsetType> end_of_read(file_offset);
-    end_of_read += raw_data_safe_len;
+    end_of_read += size_to_read;
     ORT_RETURN_IF(file_offset < 0 || static_cast<std::uintmax_t>(end_of_read) > file_length,
                   "External initializer: ", tensor_proto.name(), " offset: ", file_offset,
-                  " size to read: ", static_cast<size_t>(raw_data_safe_len), " given file_length: ", file_length,
+                  " size to read: ", size_to_read, " given file_length: ", file_length,
                   " are out of bounds or can not be read in full.");
-    ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path.c_str(), file_offset, raw_data_safe_len,
-                                       ext_data_buf, ext_data_deleter));
+
+    if (external_data_info->IsCompressed()) {
+      void* compressed_buf = nullptr;
+      OrtCallback compressed_deleter{nullptr, nullptr};
+      ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path.c_str(), file_offset, size_to_read,
+                                         compressed_buf, compressed_deleter));
+      AutoDelete compressed_auto_delete;
+      compressed_auto_delete.d = compressed_deleter;
+
+      auto buffer = std::make_unique<char[]>(raw_data_safe_len);
+      ORT_RETURN_IF_ERROR(external_data_info->Decompress(
+          gsl::make_span(static_cast<const uint8_t*>(compressed_buf), size_to_read),
+          gsl::make_span(reinterpret_cast<uint8_t*>(buffer.get()), static_cast<size_t>(raw_data_safe_len))));
+      ext_data_deleter = OrtCallback{DeleteCharArray, buffer.get()};
+      ext_data_buf = buffer.release();
+    } else {
+      ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path.c_str(), file_offset, raw_data_safe_len,
+                                         ext_data_buf, ext_data_deleter));
+    }
     ext_data_len = raw_data_safe_len;
 #endif
   }
@@ -1060,9 +1099,12 @@ Status LoadExtDataToTensorFromTensorProto(const Env& env, const std::filesystem:
   std::basic_string<ORTCHAR_T> external_data_file_path;
   FileOffsetType file_offset;
   SafeInt<size_t> raw_data_safe_len = 0;
-  ORT_RETURN_IF_ERROR(
-      GetExternalDataInfo(tensor_proto, tensor_proto_dir, external_data_file_path, file_offset, raw_data_safe_len));
+  std::unique_ptr<ExternalDataInfo> external_data_info;
+  ORT_RETURN_IF_ERROR(GetExternalDataInfo(tensor_proto, tensor_proto_dir, external_data_file_path, file_offset,
+                                          raw_data_safe_len, external_data_info));
 
+  ORT_RETURN_IF(external_data_info->IsCompressed(), "External initializer: ", tensor_proto.name(),
+                " is compressed, which is not supported by custom external data loader.");
   ORT_RETURN_IF(file_offset < 0 || raw_data_safe_len != tensor.SizeInBytes(),
                 "External initializer: ", tensor_proto.name(), " offset: ", file_offset,
                 " size to read: ", static_cast<size_t>(raw_data_safe_len),
@@ -105,6 +105,12 @@ static common::Status AllocateHelper(const AllocatorPtr& allocator,
                              p_data,
                              allocator, target_mlvalue);
       }
+    } else if (target_stream && allocator->IsStreamAware()) {
+      size_t len = Tensor::CalculateTensorStorageSize(source_tensor.DataType(), source_tensor.Shape());
+      Tensor::InitOrtValue(source_tensor.DataType(),
+                           source_tensor.Shape(),
+                           allocator->AllocOnStream(len, target_stream),
+                           allocator, target_mlvalue);
     } else {
       Tensor::InitOrtValue(source_tensor.DataType(),
                            source_tensor.Shape(),
@@ -330,7 +336,7 @@ common::Status InitializeFeedFetchCopyInfo(const SessionState& session_state,
     feeds_fetches_manager.SetDeviceCopyChecks(DeviceCopyCheck::NoCopy, DeviceCopyCheck::NoCopy);
   } else {
     // setup all the static info about where the graph inputs and outputs are located
-    auto info = feeds_fetches_manager.GetFeedsFetchesInfo();
+    const auto& info = feeds_fetches_manager.GetFeedsFetchesInfo();
     auto& feed_copy_info = feeds_fetches_manager.GetMutableFeedsDeviceCopyInfo();
     auto& fetch_copy_info = feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo();
     ORT_RETURN_IF_ERROR(utils::CalculateStaticCopyInfoForFeeds(session_state, info.feed_names, feed_copy_info));
@@ -465,23 +471,45 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
 #endif
 
   std::unordered_set<Stream*> stream_to_flush;
+#ifdef ORT_ENABLE_STREAM
+  // copy streams, see kOrtSessionOptionsConfigUseCopyStreamForFeeds, and the streams that wait for their copies
+  std::unordered_map<Stream*, std::unordered_set<Stream*>> copy_stream_waiters;
+#endif
   for (size_t idx = 0; idx < num_feeds; ++idx) {
     Stream* copy_this_feed = nullptr;
 #ifdef ORT_ENABLE_STREAM
+    Stream* copy_stream = nullptr;
     if (device_stream_collection) {
+      if (copy_info[idx].source_device != copy_info[idx].target_device) {
+        copy_stream = device_stream_collection->GetCopyStream(copy_info[idx].target_device);
+      }
+
       if (copy_info[idx].unique_stream_index_consumes_it < 0) {
         for (size_t i = 0; i < device_stream_collection->NumStreams(); i++) {
           Stream* stream = device_stream_collection->GetStream(i);
           if (stream && stream->GetDevice().Type() == copy_info[idx].target_device.Type()) {
-            copy_this_feed = stream;
-            stream_to_flush.insert(stream);
-            break;
+            if (copy_stream == nullptr) {
+              copy_this_feed = stream;
+              stream_to_flush.insert(stream);
+              break;
+            }
+
+            // any stream of the device may consume it
+            if (copy_this_feed == nullptr) {
+              copy_this_feed = stream;
+            }
+            copy_stream_waiters[copy_stream].insert(stream);
           }
         }
       } else {
         copy_this_feed = device_stream_collection->GetStream(copy_info[idx].unique_stream_index_consumes_it);
+        if (copy_stream != nullptr && copy_this_feed != nullptr) {
+          copy_stream_waiters[copy_stream].insert(copy_this_feed);
+        }
       }
     }
+
+    const size_t first_copy_pair = batched_data_transfers.size();
 #endif
 #if !defined(DISABLE_SPARSE_TENSORS)
     ORT_RETURN_IF_ERROR(BatchOrCopyMLValue(session_state, copy_info[idx], orig_feeds[idx], new_feeds[idx],
@@ -491,6 +519,14 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
     ORT_RETURN_IF_ERROR(BatchOrCopyMLValue(session_state, copy_info[idx], orig_feeds[idx], new_feeds[idx],
                                            copy_this_feed,
                                            &batched_data_transfers));
+#endif
+#ifdef ORT_ENABLE_STREAM
+    if (copy_stream != nullptr && copy_this_feed != nullptr) {
+      // the copy is allocated on the consuming stream, only the copy itself is issued on the copy stream
+      for (size_t i = first_copy_pair; i < batched_data_transfers.size(); ++i) {
+        batched_data_transfers[i].src_stream = copy_stream;
+      }
+    }
 #endif
   }
 
@@ -504,6 +540,21 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
   }
 #endif
 
+#ifdef ORT_ENABLE_STREAM
+  // the consuming streams wait for the copies on the device
+  for (const auto& [copy_stream, waiters] : copy_stream_waiters) {
+    auto notification = copy_stream->CreateNotification(waiters.size());
+    notification->ActivateAndUpdate();
+    for (Stream* waiter : waiters) {
+      auto wait_fn = session_state.GetStreamHandleRegistryInstance().GetWaitHandle(copy_stream->GetDevice().Type(),
+                                                                                   waiter->GetDevice().Type());
+      ORT_RETURN_IF(wait_fn == nullptr, "No way to wait on a stream of device ", waiter->GetDevice().ToString(),
+                    " for a copy stream of device ", copy_stream->GetDevice().ToString());
+      wait_fn(*waiter, *notification);
+    }
+  }
+#endif
+
   // flush the stream to make sure the inputs are ready before launch the inference.
   // TODO: this sync is because the graph inputs can be consumed by multiple stream,
   // but we can only place the MemCpyAsync on one of the stream. Ideally we should make
@@ -318,8 +318,17 @@ void BaseGroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceConte
 
 void GroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int past_key_index) {
   // TODO(aciddelgado): propagate output shapes depending if kv-share buffer is on or not
-  constexpr int use_max_past_present_buffer = -1;
+  // A paged KV cache is updated in place, so present has the shape of past.
+  constexpr int block_table_index = 9;
+  const bool is_paged_kv_cache = ctx.getNumInputs() > block_table_index && ctx.hasInput(block_table_index);
+  const int use_max_past_present_buffer = is_paged_kv_cache ? 1 : -1;
   BaseGroupQueryAttentionTypeAndShapeInference(ctx, past_key_index, use_max_past_present_buffer);
+
+  // The KV cache may be quantized, so present has the type of past rather than of query.
+  if (ctx.getNumOutputs() > 1 && static_cast<int>(ctx.getNumInputs()) > past_key_index && ctx.hasInput(past_key_index)) {
+    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, past_key_index, 1);
+    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, static_cast<size_t>(past_key_index) + 1, 2);
+  }
 }
 
 void SparseAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int past_key_index) {
@@ -1050,9 +1059,28 @@ Only supports causal and local attention.
 Supports rotary position embedding for CPU and CUDA.
 Supports packed input for CPU and CUDA.
 Supports continuous decoding for batch_size == 1 for CPU and CUDA.
+Supports a paged KV cache for CPU and CUDA. When block_table is given, past_key and past_value are a pool of
+fixed size blocks shared by all sequences, with shape (num_blocks, block_size, kv_num_heads, head_size), and row b of
+block_table lists the blocks of sequence b in order. Token t of sequence b is at position t % block_size of block
+block_table[b, t / block_size]. New key and value are written into the pool in place, so present_key and present_value
+must share buffer with past_key and past_value. On CUDA the paged KV cache requires flash attention and a block_size
+that is a multiple of 256.
+Supports a quantized KV cache on CPU. When k_scale and v_scale are given, past and present key and value are int8 or
+float8e4m3fn, and a key or value x is stored as x / scale (round to nearest, saturated for int8). The scales have
+shape (1) or (kv_num_heads) for one scale per KV head. The cache is dequantized inside the attention kernel, so it
+takes a quarter of the memory of a float cache and half of a float16 one. A quantized KV cache requires past_key and
+past_value, which may have a sequence length of 0, and cannot be combined with a paged KV cache.
 
 )DOC";
 
+#if !defined(DISABLE_FLOAT8_TYPES)
+#define GQA_KV_CACHE_TYPES \
+  {"tensor(float16)", "tensor(bfloat16)", "tensor(float)", "tensor(int8)", "tensor(float8e4m3fn)"}
+#else
+#define GQA_KV_CACHE_TYPES \
+  {"tensor(float16)", "tensor(bfloat16)", "tensor(float)", "tensor(int8)"}
+#endif
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     GroupQueryAttention, 1,
     OpSchema()
@@ -1102,13 +1130,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "past_key",
                "past state key with support for format BNSH. When past_key uses same tensor as present_key"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(4,
                "past_value",
                "past state value with support for format BNSH. When past_value uses same tensor as present_value"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(5,
                "seqlens_k",
@@ -1129,6 +1157,22 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "2D tensor with shape (max_sequence_length, head_size / 2).",
                "T",
                OpSchema::Optional)
+        .Input(9,
+               "block_table",
+               "2D tensor with shape (batch_size, max_num_blocks_per_seq) of the blocks of each sequence in a paged "
+               "KV cache. Unused entries are ignored.",
+               "M",
+               OpSchema::Optional)
+        .Input(10,
+               "k_scale",
+               "1D tensor with shape (1) or (kv_num_heads) of the scales of a quantized key cache.",
+               "tensor(float)",
+               OpSchema::Optional)
+        .Input(11,
+               "v_scale",
+               "1D tensor with shape (1) or (kv_num_heads) of the scales of a quantized value cache.",
+               "tensor(float)",
+               OpSchema::Optional)
         .Output(0,
                 "output",
                 "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
@@ -1138,14 +1182,17 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "present state key with support for format BNSH. When past_key uses same tensor as present_key"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(2,
                 "present_value",
                 "present state value with support for format BNSH. When past_value uses same tensor as present_value"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .TypeConstraint("T", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T_CACHE", GQA_KV_CACHE_TYPES,
+                        "Constrain past and present KV cache to float tensors, or int8 and float8 tensors for a "
+                        "quantized KV cache.")
         .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask to int tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
           GroupQueryAttentionTypeAndShapeInference(ctx, 3);
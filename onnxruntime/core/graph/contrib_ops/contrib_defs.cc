@@ -1136,6 +1136,73 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           updateOutputShape(ctx, 0, resultShape);
         }));
 
+constexpr const char* ImagePreprocess_ver1_doc = R"DOC(
+Resizes a batch of uint8 images in NHWC layout (as produced by image decoders) and normalizes them
+per channel, producing a float tensor that can be fed to a vision model directly.
+
+For every output pixel the input is resampled to `size` with the given `mode`, then
+`output = (resampled * scale - mean[c]) / std[c]`. With `reverse_channels` set, output channel c is
+read from input channel C - 1 - c (BGR <-> RGB), and `mean`/`std` refer to the output channels.
+
+'linear' mode uses half pixel coordinates (like cv2.resize), 'nearest' mode takes the input pixel at
+floor(output_coordinate * input_size / output_size).
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    ImagePreprocess, 1,
+    OpSchema()
+        .SetDoc(ImagePreprocess_ver1_doc)
+        .Attr("size", "Output spatial size [height, width].", AttributeProto::INTS)
+        .Attr("mode", "Interpolation mode, 'linear' or 'nearest'.", AttributeProto::STRING, std::string("linear"))
+        .Attr("scale", "Scale applied to the resampled values before the mean is subtracted.", AttributeProto::FLOAT, 1.0f)
+        .Attr("mean", "Per channel mean, with one or C values. Default is 0.", AttributeProto::FLOATS, OPTIONAL_VALUE)
+        .Attr("std", "Per channel standard deviation, with one or C values. Default is 1.", AttributeProto::FLOATS,
+              OPTIONAL_VALUE)
+        .Attr("reverse_channels", "Reverse the order of the channels. Default is 0.", AttributeProto::INT,
+              static_cast<int64_t>(0))
+        .Attr("channels_last", "1 for NHWC output, 0 for NCHW output. Default is 0.", AttributeProto::INT,
+              static_cast<int64_t>(0))
+        .Attr("to", "The element type of the output, float or float16.", AttributeProto::INT,
+              static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT))
+        .Input(0, "input", "Images with shape (N, H, W, C)", "T1")
+        .Output(0, "output", "Output with shape (N, C, size[0], size[1]), or (N, size[0], size[1], C) if channels_last",
+                "T2")
+        .TypeConstraint("T1", {"tensor(uint8)"}, "Constrain input to uint8 tensors.")
+        .TypeConstraint("T2", {"tensor(float)", "tensor(float16)"}, "Constrain output to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          const auto to = getAttribute(ctx, "to", static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
+          if (to != ONNX_NAMESPACE::TensorProto_DataType_FLOAT && to != ONNX_NAMESPACE::TensorProto_DataType_FLOAT16) {
+            fail_type_inference("ImagePreprocess: 'to' must be float or float16");
+          }
+          updateOutputElemType(ctx, 0, static_cast<int32_t>(to));
+
+          std::vector<int64_t> size;
+          if (!getRepeatedAttribute(ctx, "size", size) || size.size() != 2 || size[0] <= 0 || size[1] <= 0) {
+            fail_shape_inference("ImagePreprocess: 'size' must contain a positive height and width");
+          }
+
+          if (!hasInputShape(ctx, 0)) {
+            return;
+          }
+          const auto& input_shape = getInputShape(ctx, 0);
+          if (input_shape.dim_size() != 4) {
+            fail_shape_inference("ImagePreprocess: the input must have 4 dimensions (N, H, W, C)");
+          }
+
+          ONNX_NAMESPACE::TensorShapeProto output_shape;
+          *output_shape.add_dim() = input_shape.dim(0);
+          if (getAttribute(ctx, "channels_last", 0) != 0) {
+            output_shape.add_dim()->set_dim_value(size[0]);
+            output_shape.add_dim()->set_dim_value(size[1]);
+            *output_shape.add_dim() = input_shape.dim(3);
+          } else {
+            *output_shape.add_dim() = input_shape.dim(3);
+            output_shape.add_dim()->set_dim_value(size[0]);
+            output_shape.add_dim()->set_dim_value(size[1]);
+          }
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(BeamSearch, 1,
                             OpSchema()
                                 .SetDoc("Beam Search for text generation. Supports GPT-2 decoder.")
@@ -1321,10 +1388,22 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GreedySearch, 1,
                                       "This is relevant only for the GPT2 model. If this attribute is missing, the `decoder` subgraph will be used for all decoding runs",
                                       AttributeProto::GRAPH, OPTIONAL_VALUE)
                                 .Attr("decoder", "Decoder subgraph to execute in a loop.", AttributeProto::GRAPH)
+                                .Attr("draft_decoder",
+                                      "Optional smaller decoder subgraph with the same inputs, outputs and vocabulary as `decoder`, used for speculative decoding. "
+                                      "It proposes `num_speculative_tokens` tokens, which `decoder` verifies in one run. The output is the same as without it. "
+                                      "This is relevant only for the GPT2 model with batch_size 1 on CPU, and ignored otherwise.",
+                                      AttributeProto::GRAPH, OPTIONAL_VALUE)
+                                .Attr("num_speculative_tokens", "Number of tokens proposed by `draft_decoder` per run of `decoder`.",
+                                      AttributeProto::INT, static_cast<int64_t>(4))
                                 .Attr("vocab_size",
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
                                       AttributeProto::INT, static_cast<int64_t>(-1))
+                                .Attr("evict_finished_sequences",
+                                      "If 1, sequences that have generated eos_token_id are removed from the batch that the `decoder` subgraph runs, "
+                                      "so the remaining decoding steps only compute the unfinished sequences. "
+                                      "The output is the same. Only used for GPT-2 models on CPU without past and present sharing a buffer.",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
                                 .Input(0, "input_ids", "The sequence used as a prompt for the generation. Shape is (batch_size, sequence_length)", "I")
                                 .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
                                 .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
@@ -1366,6 +1445,11 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Sampling, 1,
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
                                       AttributeProto::INT, static_cast<int64_t>(-1))
+                                .Attr("evict_finished_sequences",
+                                      "If 1, sequences that have generated eos_token_id are removed from the batch that the `decoder` subgraph runs, "
+                                      "so the remaining decoding steps only compute the unfinished sequences. "
+                                      "The output is the same. Only used for GPT-2 models on CPU without past and present sharing a buffer.",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
                                 .Input(0, "input_ids", "The sequence used as a prompt for the generation. Shape is (batch_size, sequence_length)", "I")
                                 .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
                                 .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
@@ -1480,6 +1564,58 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .TypeConstraint("T1", {"tensor(uint8)"}, "Constrain weights type to uint8 tensors.")
         .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+constexpr const char* BatchedLoRA_ver1_doc = R"DOC(
+      Computes the LoRA delta of a projection for a batch in which every row selects its own adapter:
+      output[b] = scale * input[b] * lora_a[adapter_indices[b]] * lora_b[adapter_indices[b]].
+      The output is added to the output of the base projection, e.g. MatMul(input, W) + BatchedLoRA(input, ...),
+      so requests fine-tuned with different adapters can share one batch of the base model.
+      The weights of all adapters are stacked on their first dimension. An adapter index of -1 selects no adapter
+      and its rows of the output are zero. Consecutive rows that select the same adapter are computed together
+      (like the SGMV kernel of Punica), so sorting the batch by adapter makes the computation more efficient.
+      )DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    BatchedLoRA, 1,
+    OpSchema()
+        .SetDoc(BatchedLoRA_ver1_doc)
+        .Attr("scale", "Scaling factor of the LoRA delta, usually alpha / rank", AttributeProto::FLOAT, 1.0f)
+        .Input(0,
+               "input",
+               "2D input tensor with shape (batch_size, hidden_size) or 3D input tensor with shape "
+               "(batch_size, sequence_length, hidden_size)",
+               "T")
+        .Input(1, "lora_a", "3D input tensor with shape (num_adapters, hidden_size, rank)", "T")
+        .Input(2, "lora_b", "3D input tensor with shape (num_adapters, rank, output_size)", "T")
+        .Input(3,
+               "adapter_indices",
+               "1D input tensor with shape (batch_size). The index of the adapter of each batch row, or -1.",
+               "tensor(int32)")
+        .Output(0,
+                "output",
+                "2D output tensor with shape (batch_size, output_size) or 3D output tensor with shape "
+                "(batch_size, sequence_length, output_size)",
+                "T")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float or float16 tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 2)) {
+            return;
+          }
+
+          const auto& input_shape = getInputShape(ctx, 0);
+          const auto& lora_b_shape = getInputShape(ctx, 2);
+          if (input_shape.dim_size() != 2 && input_shape.dim_size() != 3) {
+            fail_shape_inference("input is expected to have 2 or 3 dimensions, got ", input_shape.dim_size());
+          }
+          if (lora_b_shape.dim_size() != 3) {
+            fail_shape_inference("lora_b is expected to have 3 dimensions, got ", lora_b_shape.dim_size());
+          }
+
+          ONNX_NAMESPACE::TensorShapeProto output_shape = input_shape;
+          *output_shape.mutable_dim(input_shape.dim_size() - 1) = lora_b_shape.dim(2);
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(SampleOp, 1,
                             OpSchema()
                                 .Input(0, "X", "input", "T")
@@ -1798,6 +1934,40 @@ activation and leaky_relu_alpha.)DOC")
                                   }
                                 }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+A chain of elementwise ops evaluated in a single pass over the data. The steps are applied in order, each one
+to the result of the previous step, starting with X. A binary step (Add, Sub, Mul or Div) takes its other
+operand from the constant in 'scalars' or from one of the inputs, which must have the shape of X.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(FusedElementwise, 1,
+                            OpSchema()
+                                .SetDoc(FusedElementwise_ver1_doc)
+                                .Input(0,
+                                       "inputs",
+                                       "X, followed by the tensors used as operands by the binary steps.",
+                                       "T",
+                                       OpSchema::Variadic,
+                                       true,
+                                       1)
+                                .Output(0, "Y", "Result of the last step, with the shape of X.", "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .Attr("ops",
+                                      "Op type of each step: Add, Sub, Mul, Div, Abs, Neg, Floor, Ceil, Reciprocal, "
+                                      "Sqrt, Exp, Log, Erf, Relu, Sigmoid or Tanh.",
+                                      AttributeProto::STRINGS)
+                                .Attr("operands",
+                                      "For each step, the index of the input used as the other operand of a binary op, "
+                                      "or -1 for a unary op or a binary op with a scalar operand.",
+                                      AttributeProto::INTS)
+                                .Attr("scalars",
+                                      "For each step, the scalar operand of a binary op. Ignored by the other steps.",
+                                      AttributeProto::FLOATS)
+                                .Attr("operand_first",
+                                      "For each step, 1 if the operand is the first input of the binary op, "
+                                      "e.g. operand - value, and 0 otherwise.",
+                                      AttributeProto::INTS)
+                                .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(ExpandDims, 1,
                             OpSchema()
                                 .Input(0, "X", "input", "T")
@@ -2125,6 +2295,7 @@ Matrix product that behaves like numpy.matmul: https://docs.scipy.org/doc/numpy-
 
 constexpr const char* FusedMatMulActivation_doc = R"DOC(
 Executes the same operation as FusedMatMul, but also has an activation function fused to its output.
+The optional bias of size N, the last dimension of Y, is added before the activation.
 )DOC";
 
 ONNX_MS_OPERATOR_SET_SCHEMA(TransposeMatMul, 1,
@@ -2183,6 +2354,7 @@ ONNX_MS_OPERATOR_SET_SCHEMA(FusedMatMulActivation, 1,
                             OpSchema()
                                 .Input(0, "A", "N-dimensional matrix A", "T")
                                 .Input(1, "B", "N-dimensional matrix B", "T")
+                                .Input(2, "bias", "1D bias of size N", "T", OpSchema::Optional)
                                 .Attr("alpha", "Scalar multiplier for the product of the input tensors.", AttributeProto::FLOAT, 1.0f)
                                 .Attr("transA", "Whether A should be transposed on the last two dimensions before doing multiplication",
                                       AttributeProto::INT, static_cast<int64_t>(0))
@@ -3595,7 +3767,8 @@ GatherBlockQuantized is a Gather with data quantized. It is similar to Gather (h
       .Input(2, "scales", "quantization scale", "T2")
       .Input(3, "zero_points", "quantization zero points", "T1", OpSchema::Optional)
       .Output(0, "output", "Dequantized output tensor of rank q + (r - 1).", "T2")
-      .TypeConstraint("T1", {"tensor(int4)", "tensor(uint4)"}, "Constrain quantized types.")
+      .TypeConstraint("T1", {"tensor(int4)", "tensor(uint4)", "tensor(int8)", "tensor(uint8)"},
+                      "Constrain quantized types.")
       .TypeConstraint("T2", {"tensor(float)", "tensor(float16)", "tensor(bfloat16)"}, "Constrain dequantized types.")
       .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types.")
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
@@ -600,6 +600,38 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
         .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+const char* QLinearUnaryDoc_ver1 = R"DOC(
+QLinearUnary takes quantized input data (Tensor), and quantize parameter for output, and produces one output data
+(Tensor<T>) where the function `f(x) = quantize(op(dequantize(x)))` is applied to the data tensor elementwise.
+`op` is the ONNX unary elementwise operator named by the `op_type` attribute, one of Abs, Celu, Cos, Elu, Erf, Exp,
+Gelu, HardSigmoid, HardSwish, Log, Mish, Neg, Reciprocal, Selu, Sin, Softplus, Softsign, Sqrt and Tanh. The
+attributes of that operator, e.g. `alpha` for Elu, are attributes of this node with the same names and defaults.
+As the input has 256 possible values, the function is evaluated once per value into a lookup table.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearUnary, 1,
+    OpSchema()
+        .SetDoc(QLinearUnaryDoc_ver1)
+        .Attr("op_type", "The unary elementwise operator to apply.", AttributeProto::STRING)
+        .AllowUncheckedAttributes()
+        .Input(0, "X", "Input tensor", "T")
+        .Input(1, "X_scale", "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(2, "X_zero_point",
+               "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Input(3, "Y_scale", "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(4, "Y_zero_point",
+               "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Output(0, "Y", "Output tensor", "T")
+        .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     QLinearSoftmax, 1,
     OpSchema()
@@ -12,6 +12,7 @@
 
 #include "core/common/common.h"
 #include <gsl/gsl>
+#include "core/common/hash_combine.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
@@ -3081,6 +3082,62 @@ common::Status Graph::TypeCheckInputsAndInitializers() {
   return Status::OK();
 }
 
+// Hash of what the type and shape inferencing of `node` depends on: the schema, the names and types of the inputs,
+// the values of small constant initializer inputs (e.g. the shape input of Reshape), the types of the outputs that
+// inferencing merges with, and the attributes.
+// Returns 0 for nodes with subgraphs, which are inferred with the subgraphs in every Resolve.
+static size_t ComputeInferenceSignature(const Graph& graph, const Node& node, const Graph::ResolveOptions& options) {
+  if (node.ContainsSubgraph()) {
+    return 0;
+  }
+
+  // inferencing only reads the values of initializers that describe shapes, which are tiny
+  constexpr size_t kMaxHashedInitializerBytes = 1024;
+
+  size_t hash = 0;
+  std::string buffer;
+  auto hash_node_arg = [&](const NodeArg& node_arg) {
+    HashCombine(node_arg.Name(), hash);
+    if (const auto* type = node_arg.TypeAsProto(); type != nullptr) {
+      type->SerializeToString(&buffer);
+      HashCombine(buffer, hash);
+    }
+  };
+
+  HashCombine(reinterpret_cast<uintptr_t>(node.Op()), hash);
+  HashCombine(node.SinceVersion(), hash);
+  HashCombine(options.override_types, hash);
+
+  HashCombine(node.InputDefs().size(), hash);
+  for (const auto* input_def : node.InputDefs()) {
+    hash_node_arg(*input_def);
+    if (input_def->Exists()) {
+      const auto* initializer = graph.GetConstantInitializer(input_def->Name(), true);
+      if (initializer != nullptr && initializer->ByteSizeLong() <= kMaxHashedInitializerBytes) {
+        initializer->SerializeToString(&buffer);
+        HashCombine(buffer, hash);
+      }
+    }
+  }
+
+  HashCombine(node.OutputDefs().size(), hash);
+  for (const auto* output_def : node.OutputDefs()) {
+    hash_node_arg(*output_def);
+  }
+
+  // attributes are unordered, so combine their hashes with an order independent sum
+  size_t attributes_hash = 0;
+  for (const auto& [name, attribute] : node.GetAttributes()) {
+    size_t attribute_hash = 0;
+    attribute.SerializeToString(&buffer);
+    HashCombine(buffer, attribute_hash);
+    attributes_hash += attribute_hash;
+  }
+  HashCombine(attributes_hash, hash);
+
+  return hash == 0 ? 1 : hash;
+}
+
 Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   CheckerContext ctx;
   ctx.set_ir_version(gsl::narrow_cast<int>(IrVersion()));
@@ -3202,7 +3259,14 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
       }
     }
 
-    NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    // after a local edit of the graph most nodes and the types of their inputs are unchanged, and inferencing them
+    // again would give the same output types and shapes. only the nodes that were edited, or are downstream of an
+    // edit that changed a type or shape, are inferred again.
+    if (node.inference_signature_ == 0 ||
+        node.inference_signature_ != ComputeInferenceSignature(*this, node, options)) {
+      NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+      node.inference_signature_ = ComputeInferenceSignature(*this, node, options);
+    }
 
     // Accumulate output names of the iterated Node
     for (const auto& output : node.OutputDefs()) {
@@ -3566,6 +3630,8 @@ Status Graph::InjectExternalInitializersFromFilesInMemory(
     if (tensor_proto->data_location() == TensorProto_DataLocation_EXTERNAL) {
       std::unique_ptr<onnxruntime::ExternalDataInfo> external_data_info;
       ORT_RETURN_IF_ERROR(onnxruntime::ExternalDataInfo::Create(tensor_proto->external_data(), external_data_info));
+      ORT_RETURN_IF(external_data_info->IsCompressed(), "External initializer: ", tensor_name,
+                    " is compressed, which is not supported for external initializer files in memory.");
 
       const auto& external_file = external_data_info->GetRelPath();
       onnxruntime::FileOffsetType file_offset = external_data_info->GetOffset();
@@ -1,7 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <filesystem>
 #include <memory>
+#include <optional>
+#include <string>
 #include "core/common/logging/logging.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
@@ -636,6 +640,195 @@ Status Model::Load(const PathString& file_path,
   return LoadModel(file_path, model_proto);
 }
 
+namespace {
+
+// the protobuf wire types used by onnx.proto
+constexpr int kWireTypeVarint = 0;
+constexpr int kWireTypeFixed64 = 1;
+constexpr int kWireTypeLengthDelimited = 2;
+constexpr int kWireTypeFixed32 = 5;
+
+// the numbers of the fields in onnx.proto that lead to the data of the main graph's initializers
+constexpr uint64_t kModelProtoGraphField = 7;
+constexpr uint64_t kGraphProtoInitializerField = 5;
+constexpr uint64_t kTensorProtoRawDataField = 9;
+
+struct WireField {
+  uint64_t number;
+  int wire_type;
+  // the tag and the value of the field, as serialized
+  gsl::span<const uint8_t> bytes;
+  // the value of a length delimited field
+  gsl::span<const uint8_t> payload;
+};
+
+Status TruncatedMessageError() {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed. The message is truncated.");
+}
+
+bool ReadVarint(gsl::span<const uint8_t> data, size_t& pos, uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64 && pos < data.size(); shift += 7) {
+    const uint8_t byte = data[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// call `fn` with each field of the serialized message in `data`
+template <typename TFn>
+Status ForEachWireField(gsl::span<const uint8_t> data, TFn&& fn) {
+  size_t pos = 0;
+  while (pos < data.size()) {
+    const size_t start = pos;
+    uint64_t tag = 0;
+    if (!ReadVarint(data, pos, tag)) {
+      return TruncatedMessageError();
+    }
+
+    WireField field{tag >> 3, static_cast<int>(tag & 0x7), {}, {}};
+    switch (field.wire_type) {
+      case kWireTypeVarint: {
+        uint64_t value = 0;
+        if (!ReadVarint(data, pos, value)) {
+          return TruncatedMessageError();
+        }
+        break;
+      }
+      case kWireTypeFixed64:
+      case kWireTypeFixed32: {
+        const size_t size = field.wire_type == kWireTypeFixed64 ? 8 : 4;
+        if (data.size() - pos < size) {
+          return TruncatedMessageError();
+        }
+        pos += size;
+        break;
+      }
+      case kWireTypeLengthDelimited: {
+        uint64_t length = 0;
+        if (!ReadVarint(data, pos, length) || length > data.size() - pos) {
+          return TruncatedMessageError();
+        }
+        field.payload = data.subspan(pos, static_cast<size_t>(length));
+        pos += static_cast<size_t>(length);
+        break;
+      }
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed. Unsupported wire type ",
+                               field.wire_type, " for field ", field.number, ".");
+    }
+
+    field.bytes = data.subspan(start, pos - start);
+    ORT_RETURN_IF_ERROR(fn(field));
+  }
+
+  return Status::OK();
+}
+
+void AppendField(const WireField& field, std::string& serialized) {
+  serialized.append(reinterpret_cast<const char*>(field.bytes.data()), field.bytes.size());
+}
+
+Status MergeSerializedFields(const std::string& serialized, google::protobuf::MessageLite& message) {
+  if (!message.MergeFromString(serialized)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed.");
+  }
+  return Status::OK();
+}
+
+// the model file that is parsed, and how its initializers refer to it
+struct InitializersInFile {
+  gsl::span<const uint8_t> file;
+  std::string location;
+  size_t min_size;
+};
+
+Status ParseInitializer(gsl::span<const uint8_t> data, const InitializersInFile& info, TensorProto& tensor) {
+  std::string other_fields;
+  std::optional<gsl::span<const uint8_t>> raw_data;
+  ORT_RETURN_IF_ERROR(ForEachWireField(data, [&](const WireField& field) {
+    if (field.number == kTensorProtoRawDataField && field.wire_type == kWireTypeLengthDelimited) {
+      // the last value of a non repeated field is the one that is parsed
+      raw_data = field.payload;
+    } else {
+      AppendField(field, other_fields);
+    }
+    return Status::OK();
+  }));
+
+  ORT_RETURN_IF_ERROR(MergeSerializedFields(other_fields, tensor));
+  if (!raw_data.has_value()) {
+    return Status::OK();
+  }
+
+  const bool leave_in_file = raw_data->size() >= info.min_size &&
+                             tensor.data_location() != TensorProto_DataLocation_EXTERNAL &&
+                             utils::HasDataType(tensor) && !utils::HasString(tensor);
+  if (!leave_in_file) {
+    tensor.set_raw_data(raw_data->data(), raw_data->size());
+    return Status::OK();
+  }
+
+  const auto offset = static_cast<size_t>(raw_data->data() - info.file.data());
+  tensor.set_data_location(TensorProto_DataLocation_EXTERNAL);
+  auto* location_entry = tensor.add_external_data();
+  location_entry->set_key("location");
+  location_entry->set_value(info.location);
+  auto* offset_entry = tensor.add_external_data();
+  offset_entry->set_key("offset");
+  offset_entry->set_value(std::to_string(offset));
+  auto* length_entry = tensor.add_external_data();
+  length_entry->set_key("length");
+  length_entry->set_value(std::to_string(raw_data->size()));
+  return Status::OK();
+}
+
+Status ParseGraph(gsl::span<const uint8_t> data, const InitializersInFile& info, GraphProto& graph) {
+  std::string other_fields;
+  ORT_RETURN_IF_ERROR(ForEachWireField(data, [&](const WireField& field) {
+    if (field.number == kGraphProtoInitializerField && field.wire_type == kWireTypeLengthDelimited) {
+      return ParseInitializer(field.payload, info, *graph.add_initializer());
+    }
+    AppendField(field, other_fields);
+    return Status::OK();
+  }));
+
+  return MergeSerializedFields(other_fields, graph);
+}
+
+}  // namespace
+
+Status Model::LoadWithInitializersInFile(const PathString& file_path, size_t initializer_min_size,
+                                         ModelProto& model_proto) {
+  const auto& env = Env::Default();
+  size_t file_size = 0;
+  ORT_RETURN_IF_ERROR(env.GetFileLength(file_path.c_str(), file_size));
+  ORT_RETURN_IF(file_size == 0, "Load model ", ToUTF8String(file_path), " failed. The file is empty.");
+
+  // the mapping is only read up to the initializers' data, so their pages are not loaded by the parsing
+  Env::MappedMemoryPtr mapped_file;
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path.c_str(), 0, file_size, mapped_file));
+
+  InitializersInFile info{gsl::make_span(reinterpret_cast<const uint8_t*>(mapped_file.get()), file_size),
+                          ToUTF8String(std::filesystem::path(file_path).filename().native()),
+                          std::max<size_t>(initializer_min_size, 1)};
+
+  std::string other_fields;
+  ORT_RETURN_IF_ERROR(ForEachWireField(info.file, [&](const WireField& field) {
+    if (field.number == kModelProtoGraphField && field.wire_type == kWireTypeLengthDelimited) {
+      return ParseGraph(field.payload, info, *model_proto.mutable_graph());
+    }
+    AppendField(field, other_fields);
+    return Status::OK();
+  }));
+
+  return MergeSerializedFields(other_fields, model_proto);
+}
+
 GSL_SUPPRESS(r .30)  // spurious warnings. p_model is potentially reset in the internal call to Load
 GSL_SUPPRESS(r .35)
 Status Model::Load(const PathString& file_path, std::shared_ptr<Model>& p_model,
@@ -241,6 +241,12 @@ class Model {
   static common::Status Load(const PathString& file_path,
                              /*out*/ ONNX_NAMESPACE::ModelProto& model_proto);
 
+  // Parse the model at `file_path` without copying the inline data of the main graph's initializers of at least
+  // `initializer_min_size` bytes. Those initializers are changed to external data that refers to their offset in the
+  // model file, so they are memory mapped when they are used. Supports models larger than 2GB.
+  static common::Status LoadWithInitializersInFile(const PathString& file_path, size_t initializer_min_size,
+                                                   /*out*/ ONNX_NAMESPACE::ModelProto& model_proto);
+
   // TODO(Task:132) Use of shared_ptr<X>* in Load/Save methods is confusing.
   static common::Status Load(const PathString& file_path,
                              /*out*/ std::shared_ptr<Model>& p_model,
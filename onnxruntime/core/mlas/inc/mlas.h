@@ -58,6 +58,14 @@ Abstract:
 #define MLAS_TARGET_ARM_ANY
 #endif
 
+//
+// Define the targets with a bfloat16 precision GEMM (SBGEMM) implementation.
+//
+
+#if (defined(__aarch64__) && defined(__linux__)) || defined(MLAS_TARGET_AMD64)
+#define MLAS_SBGEMM_SUPPORTED
+#endif
+
 #if defined(__VSX__)
 #define MLAS_TARGET_POWER
 #endif
@@ -755,6 +763,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -820,6 +829,57 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(4x4, 3x3) routines for 2D 3x3 convolutions with unit strides and
+// dilations. The filter is transformed once by MlasConvWinogradPackFilter and
+// supplied to MlasConv after MlasConvPrepareWinograd selected the algorithm.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    );
+
+bool
+MLASCALL
+MlasConvPrepareWinograd(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize
+    );
+
+//
+// Depthwise convolution of NHWC float tensors. Input supplies KernelSize
+// pointers to the input pixels for each output pixel, the filter is laid out
+// as KernelSize x Channels, and the bias and the activation are applied to the
+// output.
+//
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    const MLAS_ACTIVATION* Activation
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1018,6 +1078,18 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+void
+MLASCALL
+MlasComputeSoftmaxStrided(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    size_t Stride,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -1643,7 +1715,7 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 /**
  * @brief Whether current CPU supports Bfloat16(bf16) acceleration.
  */
@@ -1754,7 +1826,7 @@ MlasSBGemmPackBSize(size_t N, size_t K);
  */
 void MLASCALL
 MlasSBGemmConvertPackB(size_t N, size_t K, const float* B, size_t ldb, void* PackedB);
-#endif
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
 
 /**
  * @brief Indirect Depthwise convolution for fp16
@@ -1855,10 +1927,24 @@ struct MlasFlashAttentionThreadedArgs {
     const float* key;
     const float* value;
     float* output;
+    //
+    // Optional inputs, the defaults select unmasked attention over contiguous key and value heads.
+    //
+    int kv_buffer_sequence_length = 0;  // rows of each key and value head in the buffers, 0 if kv_sequence_length
+    bool is_causal = false;             // mask key j for query i if j > i + causal_offset
+    int causal_offset = 0;              // usually the past sequence length
+    const float* mask = nullptr;        // additive mask shared by the heads, rows of kv_sequence_length
+    size_t mask_batch_stride = 0;
+    size_t mask_row_stride = 0;         // 0 to apply the same key padding mask to all queries
+    const float* attn_bias = nullptr;   // additive bias, rows of kv_sequence_length for each batch, head and query
+    size_t attn_bias_batch_stride = 0;  // 0 to broadcast along the batch
+    size_t attn_bias_head_stride = 0;   // 0 to broadcast along the heads
 };
 
 /**
  * @brief Per-thread worker function for fp32 Flash Attention
+ *        The optional mask and bias are added to the scaled QK^T before the online
+ *        softmax, blocks beyond the causal boundary are skipped.
  * @param thread_id    Thread index
  * @param args         Arguments
  * @return
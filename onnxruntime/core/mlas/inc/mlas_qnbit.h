@@ -62,6 +62,7 @@ struct MLAS_SQNBIT_GEMM_DATA_PARAMS {
  * @brief Batched GEMM:  C = A * B + Bias
  *        A must be a float32 matrix
  *        B must be a quantized and packed n-bit int matrix
+ *        4-bit B supports the CompFp32 and CompInt8 compute types, 2-bit and 3-bit B supports CompFp32.
  *
  *        Call MlasIsSQNBitGemmAvailable() with the same parameters to determine whether this function may be called.
  *
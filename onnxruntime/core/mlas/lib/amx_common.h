@@ -27,6 +27,8 @@ Abstract:
 
 #define tile_dpbuud(dst, src1, src2) _tile_dpbuud(dst, src1, src2)
 
+#define tile_zero(dst) _tile_zero(dst)
+
 #define tile_loadd(dst, base, stride) _tile_loadd(dst, base, stride)
 
 #define tile_stream_loadd(dst, base, stride) _tile_stream_loadd(dst, base, stride)
@@ -51,6 +53,25 @@ __asm__ volatile (".set Payload1, 0x01\n\t"    \
 #define tile_dpbusd(dst,src1,src2)					\
 tile_dpbusd_internal(dst,src1,src2)
 
+#define tile_dpbsud_internal(dst,src1,src2)  \
+__asm__ volatile (".set Payload1, 0x02\n\t"    \
+	".set Payload1, Payload1 + (("#src2" & 15) ^ 15) << 3\n\t"  \
+	".set ModRMByte, 0xC0\n\t" 		\
+	".set ModRMByte, ModRMByte + ("#dst" << 3)\n\t"     \
+	".set ModRMByte, ModRMByte + ("#src1")\n\t"     \
+	".byte 0xC4, 0xE2, Payload1, 0x5E, ModRMByte\n\t")
+
+#define tile_dpbsud(dst,src1,src2)					\
+tile_dpbsud_internal(dst,src1,src2)
+
+#define tile_zero_internal(dst)  \
+__asm__ volatile (".set ModRMByte, 0xC0\n\t" 		\
+	".set ModRMByte, ModRMByte + ("#dst" << 3)\n\t"     \
+	".byte 0xC4, 0xE2, 0x7B, 0x49, ModRMByte\n\t")
+
+#define tile_zero(dst)					\
+tile_zero_internal(dst)
+
 #define tile_loadd_internal1(dst,base,stride)				\
   __asm__ volatile (".set ModRMByte, 0x04\n\t" 		\
 	".set ModRMByte, ModRMByte + ("#dst" << 3)\n\t"     \
@@ -21,6 +21,8 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <vector>
+
 //
 // Bundles the constants for use by kernels written in assembly.
 //
@@ -783,6 +785,71 @@ Return Value:
     }
 }
 
+//
+// Helpers to invoke the platform specific kernels of the softmax operation.
+//
+
+MLAS_FORCEINLINE
+float
+MlasSoftmaxReduceMaximum(
+    const float* Input,
+    size_t N
+)
+{
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+    return GetMlasPlatform().ReduceMaximumF32Kernel(Input, N);
+#else
+    return MlasReduceMaximumF32Kernel(Input, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+float
+MlasSoftmaxComputeSumExp(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* NegativeMaximum
+)
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().ComputeSumExpF32Kernel(Input, Output, N, NegativeMaximum);
+#else
+    return MlasComputeSumExpF32Kernel(Input, Output, N, NegativeMaximum);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasSoftmaxComputeOutput(
+    float* Output,
+    size_t N,
+    const float* Parameters
+)
+{
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+    GetMlasPlatform().ComputeSoftmaxOutputF32Kernel(Output, N, Parameters);
+#else
+    MlasComputeSoftmaxOutputF32Kernel(Output, N, Parameters);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasSoftmaxComputeLogOutput(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* Parameters
+)
+{
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+    GetMlasPlatform().ComputeLogSoftmaxOutputF32Kernel(Input, Output, N, Parameters);
+#else
+    MlasComputeLogSoftmaxOutputF32Kernel(Input, Output, N, Parameters);
+#endif
+}
+
 void
 MlasComputeSoftmaxThreaded(
     void* Context,
@@ -850,11 +917,7 @@ Return Value:
         // Find the maximum value for the row.
         //
 
-#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-        float Maximum = GetMlasPlatform().ReduceMaximumF32Kernel(Input, D);
-#else
-        float Maximum = MlasReduceMaximumF32Kernel(Input, D);
-#endif
+        float Maximum = MlasSoftmaxReduceMaximum(Input, D);
         float NegativeMaximum = -Maximum;
         if (SmoothSoftmax && NegativeMaximum > 0.0f) {
             NegativeMaximum = 0.0f;
@@ -865,11 +928,7 @@ Return Value:
         // compute the sum of these exponential functions.
         //
         float* Temp = LogSoftmax ? nullptr : Output;
-#if defined(MLAS_TARGET_AMD64)
-        float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(Input, Temp, D, &NegativeMaximum);
-#else
-        float Accumulation = MlasComputeSumExpF32Kernel(Input, Temp, D, &NegativeMaximum);
-#endif
+        float Accumulation = MlasSoftmaxComputeSumExp(Input, Temp, D, &NegativeMaximum);
 
         if (SmoothSoftmax) {
             Accumulation += expf(NegativeMaximum);
@@ -880,24 +939,14 @@ Return Value:
             // Compute the log softmax output.
             //
             float Parameters[] = {NegativeMaximum, std::log(Accumulation)};
-
-#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-            GetMlasPlatform().ComputeLogSoftmaxOutputF32Kernel(Input, Output, D, Parameters);
-#else
-            MlasComputeLogSoftmaxOutputF32Kernel(Input, Output, D, Parameters);
-#endif
+            MlasSoftmaxComputeLogOutput(Input, Output, D, Parameters);
 
         } else {
             //
             // Normalize the softmax output.
             //
             float Parameters[] = {1.0f / Accumulation};
-
-#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-            GetMlasPlatform().ComputeSoftmaxOutputF32Kernel(Output, D, Parameters);
-#else
-            MlasComputeSoftmaxOutputF32Kernel(Output, D, Parameters);
-#endif
+            MlasSoftmaxComputeOutput(Output, D, Parameters);
         }
 
         Input += D;
@@ -906,6 +955,130 @@ Return Value:
     }
 }
 
+void
+MlasComputeSoftmaxSplitRows(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    size_t SegmentCount,
+    MLAS_THREADPOOL* ThreadPool
+)
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function of rows that
+    are too few to keep the threads busy, but long enough to be split in
+    segments that are processed by different threads.
+
+    Each segment is reduced to its maximum and the sum of the exponentials
+    relative to that maximum. The partial sums are combined by rescaling them
+    to the maximum of the row (online normalization), so the segments are
+    read the same number of times as in the single threaded case.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    SegmentCount - Supplies the number of segments of each row.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t WorkCount = ptrdiff_t(N * SegmentCount);
+
+    std::vector<float> SegmentMaximum(WorkCount);
+    std::vector<float> SegmentSum(WorkCount);
+
+    //
+    // Compute the maximum and the sum of the exponentials of each segment. The
+    // exponentials are saved to the output for the softmax operation.
+    //
+
+    MlasTrySimpleParallel(ThreadPool, WorkCount, [&](ptrdiff_t w) {
+        size_t d;
+        size_t CountD;
+        MlasPartitionWork(ptrdiff_t(w % SegmentCount), ptrdiff_t(SegmentCount), D, &d, &CountD);
+
+        const size_t Offset = (w / SegmentCount) * D + d;
+        float NegativeMaximum = -MlasSoftmaxReduceMaximum(Input + Offset, CountD);
+        float* Temp = LogSoftmax ? nullptr : Output + Offset;
+
+        SegmentMaximum[w] = -NegativeMaximum;
+        SegmentSum[w] = MlasSoftmaxComputeSumExp(Input + Offset, Temp, CountD, &NegativeMaximum);
+    });
+
+    //
+    // Combine the segments of each row: the sum of a segment is rescaled from
+    // the maximum of the segment to the maximum of the row.
+    //
+
+    for (size_t n = 0; n < N; n++) {
+
+        float* Maximum = SegmentMaximum.data() + n * SegmentCount;
+        float* Sum = SegmentSum.data() + n * SegmentCount;
+
+        const float RowMaximum = *std::max_element(Maximum, Maximum + SegmentCount);
+        float RowSum = 0.0f;
+
+        for (size_t k = 0; k < SegmentCount; k++) {
+            RowSum += Sum[k] * std::exp(Maximum[k] - RowMaximum);
+        }
+
+        //
+        // Replace the partial results by the parameters of the output kernels.
+        // The softmax exponentials of a segment are relative to the maximum of
+        // the segment, so the rescale is folded into its normalization factor.
+        //
+
+        for (size_t k = 0; k < SegmentCount; k++) {
+            if (LogSoftmax) {
+                Maximum[k] = -RowMaximum;
+                Sum[k] = std::log(RowSum);
+            } else {
+                Sum[k] = std::exp(Maximum[k] - RowMaximum) / RowSum;
+            }
+        }
+    }
+
+    //
+    // Compute the output of each segment.
+    //
+
+    MlasTrySimpleParallel(ThreadPool, WorkCount, [&](ptrdiff_t w) {
+        size_t d;
+        size_t CountD;
+        MlasPartitionWork(ptrdiff_t(w % SegmentCount), ptrdiff_t(SegmentCount), D, &d, &CountD);
+
+        const size_t Offset = (w / SegmentCount) * D + d;
+
+        if (LogSoftmax) {
+            float Parameters[] = {SegmentMaximum[w], SegmentSum[w]};
+            MlasSoftmaxComputeLogOutput(Input + Offset, Output + Offset, CountD, Parameters);
+        } else {
+            float Parameters[] = {SegmentSum[w]};
+            MlasSoftmaxComputeOutput(Output + Offset, CountD, Parameters);
+        }
+    });
+}
+
 void
 MLASCALL
 MlasComputeSoftmax(
@@ -977,6 +1150,23 @@ Return Value:
 
     constexpr size_t MinimumElementsPerThread = 16384;
 
+    //
+    // Split the rows in segments if there are fewer rows than threads and the
+    // rows are long, e.g. the logits of a large vocabulary.
+    //
+
+    const ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (!SmoothSoftmax && N > 0 && size_t(MaximumThreadCount) >= 2 * N) {
+
+        size_t SegmentCount = std::min(size_t(MaximumThreadCount) / N, D / MinimumElementsPerThread);
+
+        if (SegmentCount >= 2) {
+            MlasComputeSoftmaxSplitRows(Input, Output, N, D, LogSoftmax, SegmentCount, ThreadPool);
+            return;
+        }
+    }
+
     size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
 
     if (size_t(ThreadCountN) > BlockCount) {
@@ -987,3 +1177,237 @@ Return Value:
 
     MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
 }
+
+//
+// Define the number of columns that the strided softmax processes at a time.
+//
+
+constexpr size_t MLAS_SOFTMAX_STRIDED_COLUMNS = 16;
+
+void
+MlasComputeSoftmaxStridedColumns(
+    const float* Input,
+    float* Output,
+    size_t D,
+    size_t Stride,
+    size_t CountS,
+    bool LogSoftmax
+)
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function of a block of
+    up to MLAS_SOFTMAX_STRIDED_COLUMNS adjacent columns, where the elements of
+    a column are Stride elements apart.
+
+Arguments:
+
+    Input - Supplies the first element of the first column of the input.
+
+    Output - Supplies the first element of the first column of the output.
+
+    D - Supplies the number of elements per column.
+
+    Stride - Supplies the distance between the elements of a column.
+
+    CountS - Supplies the number of columns to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float NegativeMaximum[MLAS_SOFTMAX_STRIDED_COLUMNS], 16);
+    MLAS_DECLSPEC_ALIGN(float Accumulation[MLAS_SOFTMAX_STRIDED_COLUMNS], 16);
+
+    //
+    // Find the maximum value of each column.
+    //
+
+    std::copy_n(Input, CountS, NegativeMaximum);
+
+    for (size_t d = 1; d < D; d++) {
+
+        const float* Row = Input + d * Stride;
+        size_t s = 0;
+
+        for (; s + 4 <= CountS; s += 4) {
+            MLAS_FLOAT32X4 Maximum = MlasMaximumFloat32x4(MlasLoadFloat32x4(NegativeMaximum + s), MlasLoadFloat32x4(Row + s));
+            MlasStoreAlignedFloat32x4(NegativeMaximum + s, Maximum);
+        }
+
+        for (; s < CountS; s++) {
+            NegativeMaximum[s] = std::max(NegativeMaximum[s], Row[s]);
+        }
+    }
+
+    for (size_t s = 0; s < CountS; s++) {
+        NegativeMaximum[s] = -NegativeMaximum[s];
+        Accumulation[s] = 0.0f;
+    }
+
+    //
+    // Compute the exponential function for each element (save to the output
+    // for the softmax operation) and the sum of these exponential functions.
+    //
+
+    for (size_t d = 0; d < D; d++) {
+
+        const float* Row = Input + d * Stride;
+        float* OutputRow = Output + d * Stride;
+        size_t s = 0;
+
+        for (; s + 4 <= CountS; s += 4) {
+            MLAS_FLOAT32X4 Vector = MlasComputeSumExpVector(MlasLoadFloat32x4(Row + s), MlasLoadFloat32x4(NegativeMaximum + s));
+            if (!LogSoftmax) {
+                MlasStoreFloat32x4(OutputRow + s, Vector);
+            }
+            MlasStoreAlignedFloat32x4(Accumulation + s, MlasAddFloat32x4(MlasLoadFloat32x4(Accumulation + s), Vector));
+        }
+
+        for (; s < CountS; s++) {
+            MLAS_FLOAT32X4 Vector = MlasComputeSumExpVector(MlasBroadcastFloat32x4(Row[s]), MlasBroadcastFloat32x4(NegativeMaximum[s]));
+            float Value = MlasExtractLaneFloat32x4<0>(Vector);
+            if (!LogSoftmax) {
+                OutputRow[s] = Value;
+            }
+            Accumulation[s] += Value;
+        }
+    }
+
+    //
+    // Compute the log softmax output, or normalize the softmax output.
+    //
+
+    for (size_t s = 0; s < CountS; s++) {
+        Accumulation[s] = LogSoftmax ? std::log(Accumulation[s]) : 1.0f / Accumulation[s];
+    }
+
+    for (size_t d = 0; d < D; d++) {
+
+        const float* Row = Input + d * Stride;
+        float* OutputRow = Output + d * Stride;
+        size_t s = 0;
+
+        if (LogSoftmax) {
+
+            for (; s + 4 <= CountS; s += 4) {
+                MLAS_FLOAT32X4 Vector = MlasAddFloat32x4(MlasLoadFloat32x4(Row + s), MlasLoadFloat32x4(NegativeMaximum + s));
+                Vector = MlasSubtractFloat32x4(Vector, MlasLoadFloat32x4(Accumulation + s));
+                MlasStoreFloat32x4(OutputRow + s, Vector);
+            }
+
+            for (; s < CountS; s++) {
+                OutputRow[s] = Row[s] + NegativeMaximum[s] - Accumulation[s];
+            }
+
+        } else {
+
+            for (; s + 4 <= CountS; s += 4) {
+                MLAS_FLOAT32X4 Vector = MlasMultiplyFloat32x4(MlasLoadFloat32x4(OutputRow + s), MlasLoadFloat32x4(Accumulation + s));
+                MlasStoreFloat32x4(OutputRow + s, Vector);
+            }
+
+            for (; s < CountS; s++) {
+                OutputRow[s] *= Accumulation[s];
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasComputeSoftmaxStrided(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    size_t Stride,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+)
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function along the
+    middle dimension of a [N, D, Stride] tensor, e.g. the channel axis of an
+    NCHW tensor, without transposing the axis to the innermost dimension.
+
+    Adjacent columns are processed together so that the rows of the axis are
+    read with vector loads.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of outer slices to process.
+
+    D - Supplies the number of elements along the softmax axis.
+
+    Stride - Supplies the number of elements after the softmax axis, which is
+        the distance between consecutive elements along the axis.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockCountS = (Stride + MLAS_SOFTMAX_STRIDED_COLUMNS - 1) / MLAS_SOFTMAX_STRIDED_COLUMNS;
+    const size_t BlockCount = N * BlockCountS;
+
+    if (BlockCount == 0 || D == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the softmax
+    // operation, as in MlasComputeSoftmax.
+    //
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    size_t WorkCount = ((N * D * Stride) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCount) > WorkCount) {
+        ThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+        size_t Block;
+        size_t CountBlocks;
+        MlasPartitionWork(tid, ThreadCount, BlockCount, &Block, &CountBlocks);
+
+        for (; CountBlocks > 0; Block++, CountBlocks--) {
+
+            const size_t n = Block / BlockCountS;
+            const size_t s = (Block % BlockCountS) * MLAS_SOFTMAX_STRIDED_COLUMNS;
+            const size_t CountS = std::min(Stride - s, MLAS_SOFTMAX_STRIDED_COLUMNS);
+            const size_t Offset = n * D * Stride + s;
+
+            MlasComputeSoftmaxStridedColumns(Input + Offset, Output + Offset, D, Stride, CountS, LogSoftmax);
+        }
+    });
+}
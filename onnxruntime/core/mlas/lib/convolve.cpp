@@ -819,6 +819,440 @@ Return Value:
     return true;
 }
 
+//
+// Winograd F(4x4, 3x3) convolution.
+//
+// The filter and each 6x6 tile of the padded input are transformed to 36
+// points, where the filters and the input channels are multiplied by SGEMM,
+// and the products are transformed back to a 4x4 tile of the output. This
+// replaces the 144 multiplies per tile and channel of the direct convolution
+// with 36.
+//
+
+constexpr size_t MLAS_WINOGRAD_OUTPUT_TILE = 4;
+constexpr size_t MLAS_WINOGRAD_INPUT_TILE = 6;
+constexpr size_t MLAS_WINOGRAD_POINTS = MLAS_WINOGRAD_INPUT_TILE * MLAS_WINOGRAD_INPUT_TILE;
+
+static
+void
+MlasConvWinogradTransformFilter(
+    const float* Filter,
+    float* Transformed,
+    size_t TransformedStride
+    )
+/*++
+
+Routine Description:
+
+    This routine computes G * g * G^T for a 3x3 filter g.
+
+Arguments:
+
+    Filter - Supplies the 3x3 filter.
+
+    Transformed - Receives the 36 transformed points.
+
+    TransformedStride - Supplies the distance between the transformed points.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float t[MLAS_WINOGRAD_INPUT_TILE][3];
+
+    for (size_t j = 0; j < 3; j++) {
+        const float g0 = Filter[0 * 3 + j];
+        const float g1 = Filter[1 * 3 + j];
+        const float g2 = Filter[2 * 3 + j];
+        t[0][j] = g0 / 4.0f;
+        t[1][j] = -(g0 + g1 + g2) / 6.0f;
+        t[2][j] = -(g0 - g1 + g2) / 6.0f;
+        t[3][j] = g0 / 24.0f + g1 / 12.0f + g2 / 6.0f;
+        t[4][j] = g0 / 24.0f - g1 / 12.0f + g2 / 6.0f;
+        t[5][j] = g2;
+    }
+
+    for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+        const float g0 = t[i][0];
+        const float g1 = t[i][1];
+        const float g2 = t[i][2];
+        float* u = Transformed + i * MLAS_WINOGRAD_INPUT_TILE * TransformedStride;
+        u[0 * TransformedStride] = g0 / 4.0f;
+        u[1 * TransformedStride] = -(g0 + g1 + g2) / 6.0f;
+        u[2 * TransformedStride] = -(g0 - g1 + g2) / 6.0f;
+        u[3 * TransformedStride] = g0 / 24.0f + g1 / 12.0f + g2 / 6.0f;
+        u[4 * TransformedStride] = g0 / 24.0f - g1 / 12.0f + g2 / 6.0f;
+        u[5 * TransformedStride] = g2;
+    }
+}
+
+static
+void
+MlasConvWinogradTransformInput(
+    const float* Input,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t ih0,
+    size_t iw0,
+    float* Transformed,
+    size_t TransformedStride
+    )
+/*++
+
+Routine Description:
+
+    This routine computes B^T * d * B for the 6x6 tile d of the input that
+    starts at (ih0, iw0). Elements outside of the input are zero padding.
+
+Arguments:
+
+    Input - Supplies the input channel.
+
+    InputHeight - Supplies the height of the input channel.
+
+    InputWidth - Supplies the width of the input channel.
+
+    ih0 - Supplies the first row of the tile, which wraps around when the
+        tile starts in the padding.
+
+    iw0 - Supplies the first column of the tile, which wraps around when the
+        tile starts in the padding.
+
+    Transformed - Receives the 36 transformed points.
+
+    TransformedStride - Supplies the distance between the transformed points.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float d[MLAS_WINOGRAD_INPUT_TILE][MLAS_WINOGRAD_INPUT_TILE];
+
+    for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+        const size_t ih = ih0 + i;
+        for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+            const size_t iw = iw0 + j;
+            d[i][j] = (ih < InputHeight && iw < InputWidth) ? Input[ih * InputWidth + iw] : 0.0f;
+        }
+    }
+
+    float t[MLAS_WINOGRAD_INPUT_TILE][MLAS_WINOGRAD_INPUT_TILE];
+
+    for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+        const float d0 = d[0][j];
+        const float d1 = d[1][j];
+        const float d2 = d[2][j];
+        const float d3 = d[3][j];
+        const float d4 = d[4][j];
+        const float d5 = d[5][j];
+        t[0][j] = 4.0f * d0 - 5.0f * d2 + d4;
+        t[1][j] = -4.0f * (d1 + d2) + d3 + d4;
+        t[2][j] = 4.0f * (d1 - d2) - d3 + d4;
+        t[3][j] = 2.0f * (d3 - d1) - d2 + d4;
+        t[4][j] = 2.0f * (d1 - d3) - d2 + d4;
+        t[5][j] = 4.0f * d1 - 5.0f * d3 + d5;
+    }
+
+    for (size_t i = 0; i < MLAS_WINOGRAD_INPUT_TILE; i++) {
+        const float d0 = t[i][0];
+        const float d1 = t[i][1];
+        const float d2 = t[i][2];
+        const float d3 = t[i][3];
+        const float d4 = t[i][4];
+        const float d5 = t[i][5];
+        float* v = Transformed + i * MLAS_WINOGRAD_INPUT_TILE * TransformedStride;
+        v[0 * TransformedStride] = 4.0f * d0 - 5.0f * d2 + d4;
+        v[1 * TransformedStride] = -4.0f * (d1 + d2) + d3 + d4;
+        v[2 * TransformedStride] = 4.0f * (d1 - d2) - d3 + d4;
+        v[3 * TransformedStride] = 2.0f * (d3 - d1) - d2 + d4;
+        v[4 * TransformedStride] = 2.0f * (d1 - d3) - d2 + d4;
+        v[5 * TransformedStride] = 4.0f * d1 - 5.0f * d3 + d5;
+    }
+}
+
+static
+void
+MlasConvWinogradTransformOutput(
+    const float* Transformed,
+    size_t TransformedStride,
+    float* Output,
+    size_t OutputHeight,
+    size_t OutputWidth,
+    size_t oh0,
+    size_t ow0,
+    float Beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes A^T * m * A for the 36 products m and stores the
+    part of the 4x4 output tile that starts at (oh0, ow0) and is inside of
+    the output.
+
+Arguments:
+
+    Transformed - Supplies the 36 products.
+
+    TransformedStride - Supplies the distance between the products.
+
+    Output - Supplies the output channel.
+
+    OutputHeight - Supplies the height of the output channel.
+
+    OutputWidth - Supplies the width of the output channel.
+
+    oh0 - Supplies the first row of the tile.
+
+    ow0 - Supplies the first column of the tile.
+
+    Beta - Supplies the multiplier of the existing output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float t[MLAS_WINOGRAD_OUTPUT_TILE][MLAS_WINOGRAD_INPUT_TILE];
+
+    for (size_t j = 0; j < MLAS_WINOGRAD_INPUT_TILE; j++) {
+        const float m0 = Transformed[(0 * MLAS_WINOGRAD_INPUT_TILE + j) * TransformedStride];
+        const float m1 = Transformed[(1 * MLAS_WINOGRAD_INPUT_TILE + j) * TransformedStride];
+        const float m2 = Transformed[(2 * MLAS_WINOGRAD_INPUT_TILE + j) * TransformedStride];
+        const float m3 = Transformed[(3 * MLAS_WINOGRAD_INPUT_TILE + j) * TransformedStride];
+        const float m4 = Transformed[(4 * MLAS_WINOGRAD_INPUT_TILE + j) * TransformedStride];
+        const float m5 = Transformed[(5 * MLAS_WINOGRAD_INPUT_TILE + j) * TransformedStride];
+        t[0][j] = m0 + (m1 + m2) + (m3 + m4);
+        t[1][j] = (m1 - m2) + 2.0f * (m3 - m4);
+        t[2][j] = (m1 + m2) + 4.0f * (m3 + m4);
+        t[3][j] = (m1 - m2) + 8.0f * (m3 - m4) + m5;
+    }
+
+    for (size_t i = 0; i < MLAS_WINOGRAD_OUTPUT_TILE; i++) {
+        const size_t oh = oh0 + i;
+        if (oh >= OutputHeight) {
+            break;
+        }
+
+        const float m0 = t[i][0];
+        const float m1 = t[i][1];
+        const float m2 = t[i][2];
+        const float m3 = t[i][3];
+        const float m4 = t[i][4];
+        const float m5 = t[i][5];
+
+        float y[MLAS_WINOGRAD_OUTPUT_TILE];
+        y[0] = m0 + (m1 + m2) + (m3 + m4);
+        y[1] = (m1 - m2) + 2.0f * (m3 - m4);
+        y[2] = (m1 + m2) + 4.0f * (m3 + m4);
+        y[3] = (m1 - m2) + 8.0f * (m3 - m4) + m5;
+
+        float* output = Output + oh * OutputWidth;
+        const size_t Count = std::min(MLAS_WINOGRAD_OUTPUT_TILE, OutputWidth - ow0);
+
+        for (size_t j = 0; j < Count; j++) {
+            if (Beta == 0.0f) {
+                output[ow0 + j] = y[j];
+            } else {
+                output[ow0 + j] = Beta * output[ow0 + j] + y[j];
+            }
+        }
+    }
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution for one group of one
+    batch. The bias and the activation are applied by the caller.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    PackedFilter - Supplies the filter transformed by
+        MlasConvWinogradPackFilter.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepareWinograd.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t PaddingLeftHeight = Parameters->Padding[0];
+    const size_t PaddingLeftWidth = Parameters->Padding[1];
+    const float Beta = Parameters->Beta;
+
+    const size_t TileCountHeight = (OutputHeight + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE;
+    const size_t TileCountWidth = (OutputWidth + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE;
+    const size_t TileCount = TileCountHeight * TileCountWidth;
+
+    //
+    // The transformed input is stored as [points][InputChannels][TileCount]
+    // and the products as [points][FilterCount][TileCount], so that every
+    // point is a GEMM of the [FilterCount][InputChannels] packed filter.
+    //
+
+    float* TransformedInput = WorkingBuffer;
+    float* TransformedOutput = WorkingBuffer + MLAS_WINOGRAD_POINTS * InputChannels * TileCount;
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(InputChannels), [&](ptrdiff_t c) {
+        const float* input = Input + size_t(c) * InputHeight * InputWidth;
+        float* transformed = TransformedInput + size_t(c) * TileCount;
+
+        for (size_t th = 0; th < TileCountHeight; th++) {
+            for (size_t tw = 0; tw < TileCountWidth; tw++) {
+                MlasConvWinogradTransformInput(input, InputHeight, InputWidth,
+                    th * MLAS_WINOGRAD_OUTPUT_TILE - PaddingLeftHeight,
+                    tw * MLAS_WINOGRAD_OUTPUT_TILE - PaddingLeftWidth,
+                    transformed + th * TileCountWidth + tw, InputChannels * TileCount);
+            }
+        }
+    });
+
+    MLAS_SGEMM_DATA_PARAMS Data[MLAS_WINOGRAD_POINTS];
+
+    for (size_t point = 0; point < MLAS_WINOGRAD_POINTS; point++) {
+        Data[point].A = PackedFilter + point * FilterCount * InputChannels;
+        Data[point].lda = InputChannels;
+        Data[point].B = TransformedInput + point * InputChannels * TileCount;
+        Data[point].ldb = TileCount;
+        Data[point].C = TransformedOutput + point * FilterCount * TileCount;
+        Data[point].ldc = TileCount;
+    }
+
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, FilterCount, TileCount, InputChannels, Data,
+        MLAS_WINOGRAD_POINTS, ThreadPool);
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(FilterCount), [&](ptrdiff_t f) {
+        const float* transformed = TransformedOutput + size_t(f) * TileCount;
+        float* output = Output + size_t(f) * OutputHeight * OutputWidth;
+
+        for (size_t th = 0; th < TileCountHeight; th++) {
+            for (size_t tw = 0; tw < TileCountWidth; tw++) {
+                MlasConvWinogradTransformOutput(transformed + th * TileCountWidth + tw,
+                    FilterCount * TileCount, output, OutputHeight, OutputWidth,
+                    th * MLAS_WINOGRAD_OUTPUT_TILE, tw * MLAS_WINOGRAD_OUTPUT_TILE, Beta);
+            }
+        }
+    });
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements of a 3x3 filter transformed
+    for the Winograd convolution.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns the number of elements of the packed filter.
+
+--*/
+{
+    return GroupCount * MLAS_WINOGRAD_POINTS * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 3x3 filter for the Winograd convolution.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor in [GroupCount * FilterCount]
+        [InputChannels][3][3] order.
+
+    PackedFilter - Receives the packed filter, which holds the number of
+        elements returned by MlasConvWinogradPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t PointStride = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                MlasConvWinogradTransformFilter(Filter, PackedFilter + f * InputChannels + c, PointStride);
+                Filter += 3 * 3;
+            }
+        }
+
+        PackedFilter += MLAS_WINOGRAD_POINTS * PointStride;
+    }
+}
+
 void
 MLASCALL
 MlasConv(
@@ -843,12 +1277,14 @@ Arguments:
 
     Input - Supplies the input tensor.
 
-    Filter - Supplies the filter tensor.
+    Filter - Supplies the filter tensor, or the packed filter from
+        MlasConvWinogradPackFilter if MlasConvPrepareWinograd selected the
+        Winograd algorithm.
 
     Bias - Optionally supplies the bias vector.
 
     WorkingBuffer - Supplies a working buffer sized to the number of elements
-        returned by MlasConvPrepare.
+        returned by MlasConvPrepare or MlasConvPrepareWinograd.
 
     Output - Supplies the output tensor.
 
@@ -865,15 +1301,17 @@ Return Value:
     const size_t OutputSize = Parameters->OutputSize;
     const size_t K = Parameters->K;
 
-    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
-    const size_t OutputGroupSize = FilterCount * OutputSize;
-    const size_t FilterGroupSize = FilterCount * K;
-
     const size_t BatchCount = Parameters->BatchCount;
     const size_t GroupCount = Parameters->GroupCount;
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * OutputSize;
+    const size_t FilterGroupSize = (Algorithm == MlasConvAlgorithmWinograd)
+        ? MlasConvWinogradPackFilterSize(1, FilterCount, Parameters->InputChannels)
+        : FilterCount * K;
+
     //
     // Schedule batches of GEMMs across multiple threads.
     //
@@ -976,6 +1414,25 @@ Return Value:
                     break;
                 }
 
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // Transform the input, multiply with the packed filter and
+                    // transform the products to the output.
+                    //
+
+                    MlasConvWinograd(Parameters, Input, filter, WorkingBuffer, Output, ThreadPool);
+
+                    //
+                    // Apply the activation with optional bias.
+                    //
+
+                    MlasActivation(Parameters->Activation, Output, bias, FilterCount,
+                        OutputSize, OutputSize);
+
+                    break;
+                }
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
                 case MlasConvAlgorithmDepthwise:
@@ -1299,4 +1756,294 @@ Return Value:
 }
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
-#endif
\ No newline at end of file
+#endif
+
+bool
+MLASCALL
+MlasConvPrepareWinograd(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the Winograd algorithm for parameters prepared by
+    MlasConvPrepare if the convolution is a 2D 3x3 convolution with unit
+    strides and dilations. The filter must then be supplied to MlasConv as
+    packed by MlasConvWinogradPackFilter.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    Returns true if the Winograd algorithm was selected, else false and the
+    parameters are not modified.
+
+--*/
+{
+    if (Parameters->Dimensions != 2) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        if (Parameters->KernelShape[dim] != 3 || Parameters->StrideShape[dim] != 1 ||
+            Parameters->DilationShape[dim] != 1) {
+            return false;
+        }
+    }
+
+    const size_t TileCount =
+        ((Parameters->OutputShape[0] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE) *
+        ((Parameters->OutputShape[1] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE);
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+
+    *WorkingBufferSize = MLAS_WINOGRAD_POINTS * (Parameters->InputChannels + Parameters->FilterCount) * TileCount;
+
+    return true;
+}
+
+//
+// Depthwise convolution of NHWC float tensors.
+//
+// Each output pixel accumulates KernelSize input pixels, which are supplied
+// by an indirection buffer so that any stride, dilation and padding use the
+// same kernel. The common 3x3 and 5x5 kernel sizes are unrolled at compile
+// time. Relu and Clip are applied to the accumulators before they are stored,
+// the other activations are applied to the output afterwards.
+//
+
+template<size_t KernelSizeT, bool Clamp>
+static
+void
+MlasConvDepthwiseFloatKernel(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t RuntimeKernelSize,
+    float Minimum,
+    float Maximum
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the depthwise convolution for a set of output
+    pixels.
+
+Arguments:
+
+    Input - Supplies the indirection buffer, KernelSize input pixel pointers
+        for each output pixel.
+
+    Filter - Supplies the filter laid out as KernelSize x Channels.
+
+    Bias - Supplies the optional bias vector.
+
+    Output - Supplies the output pixels.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output pixels.
+
+    RuntimeKernelSize - Supplies the kernel size if KernelSizeT is zero.
+
+    Minimum - Supplies the lower bound of the output if Clamp is set.
+
+    Maximum - Supplies the upper bound of the output if Clamp is set.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t KernelSize = (KernelSizeT != 0) ? KernelSizeT : RuntimeKernelSize;
+
+    const MLAS_FLOAT32X4 MinimumVector = MlasBroadcastFloat32x4(Minimum);
+    const MLAS_FLOAT32X4 MaximumVector = MlasBroadcastFloat32x4(Maximum);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+
+        size_t c = 0;
+
+        for (; c + 16 <= Channels; c += 16) {
+
+            MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator2 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator3 = MlasZeroFloat32x4();
+
+            if (Bias != nullptr) {
+                Accumulator0 = MlasLoadFloat32x4(&Bias[c]);
+                Accumulator1 = MlasLoadFloat32x4(&Bias[c + 4]);
+                Accumulator2 = MlasLoadFloat32x4(&Bias[c + 8]);
+                Accumulator3 = MlasLoadFloat32x4(&Bias[c + 12]);
+            }
+
+            const float* filter = Filter + c;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                const float* input = Input[k] + c;
+                Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input), MlasLoadFloat32x4(filter), Accumulator0);
+                Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input + 4), MlasLoadFloat32x4(filter + 4), Accumulator1);
+                Accumulator2 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input + 8), MlasLoadFloat32x4(filter + 8), Accumulator2);
+                Accumulator3 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input + 12), MlasLoadFloat32x4(filter + 12), Accumulator3);
+                filter += Channels;
+            }
+
+            if (Clamp) {
+                Accumulator0 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(Accumulator0, MinimumVector), MaximumVector);
+                Accumulator1 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(Accumulator1, MinimumVector), MaximumVector);
+                Accumulator2 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(Accumulator2, MinimumVector), MaximumVector);
+                Accumulator3 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(Accumulator3, MinimumVector), MaximumVector);
+            }
+
+            MlasStoreFloat32x4(&Output[c], Accumulator0);
+            MlasStoreFloat32x4(&Output[c + 4], Accumulator1);
+            MlasStoreFloat32x4(&Output[c + 8], Accumulator2);
+            MlasStoreFloat32x4(&Output[c + 12], Accumulator3);
+        }
+
+        for (; c + 4 <= Channels; c += 4) {
+
+            MLAS_FLOAT32X4 Accumulator = (Bias != nullptr) ? MlasLoadFloat32x4(&Bias[c]) : MlasZeroFloat32x4();
+
+            const float* filter = Filter + c;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Input[k] + c), MlasLoadFloat32x4(filter), Accumulator);
+                filter += Channels;
+            }
+
+            if (Clamp) {
+                Accumulator = MlasMinimumFloat32x4(MlasMaximumFloat32x4(Accumulator, MinimumVector), MaximumVector);
+            }
+
+            MlasStoreFloat32x4(&Output[c], Accumulator);
+        }
+
+        for (; c < Channels; c++) {
+
+            float Accumulator = (Bias != nullptr) ? Bias[c] : 0.0f;
+
+            const float* filter = Filter + c;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                Accumulator += Input[k][c] * *filter;
+                filter += Channels;
+            }
+
+            if (Clamp) {
+                Accumulator = std::min(std::max(Accumulator, Minimum), Maximum);
+            }
+
+            Output[c] = Accumulator;
+        }
+
+        Input += KernelSize;
+        Output += Channels;
+    }
+}
+
+template<bool Clamp>
+static
+void
+MlasConvDepthwiseFloatDispatch(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    float Minimum,
+    float Maximum
+    )
+{
+    switch (KernelSize) {
+        case 9:
+            MlasConvDepthwiseFloatKernel<9, Clamp>(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize, Minimum, Maximum);
+            break;
+        case 25:
+            MlasConvDepthwiseFloatKernel<25, Clamp>(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize, Minimum, Maximum);
+            break;
+        default:
+            MlasConvDepthwiseFloatKernel<0, Clamp>(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize, Minimum, Maximum);
+            break;
+    }
+}
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    const MLAS_ACTIVATION* Activation
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the depthwise convolution of NHWC float tensors
+    for a set of output pixels.
+
+Arguments:
+
+    Input - Supplies the indirection buffer, KernelSize input pixel pointers
+        for each output pixel. Padding is supplied as a pointer to a zero
+        filled buffer of Channels elements.
+
+    Filter - Supplies the filter laid out as KernelSize x Channels.
+
+    Bias - Supplies the optional bias vector of Channels elements.
+
+    Output - Supplies the output, OutputCount pixels of Channels elements.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output pixels.
+
+    KernelSize - Supplies the number of input pixels for each output pixel.
+
+    Activation - Supplies the optional activation to apply to the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_ACTIVATION_KIND ActivationKind =
+        (Activation != nullptr) ? Activation->ActivationKind : MlasIdentityActivation;
+
+    if (ActivationKind == MlasReluActivation) {
+        MlasConvDepthwiseFloatDispatch<true>(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize,
+                                            0.0f, std::numeric_limits<float>::infinity());
+    } else if (ActivationKind == MlasClipActivation) {
+        MlasConvDepthwiseFloatDispatch<true>(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize,
+                                            Activation->Parameters.Clip.minimum,
+                                            Activation->Parameters.Clip.maximum);
+    } else {
+        MlasConvDepthwiseFloatDispatch<false>(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize,
+                                             0.0f, 0.0f);
+        if (ActivationKind != MlasIdentityActivation) {
+            MlasActivation(Activation, Output, nullptr, OutputCount, Channels, Channels);
+        }
+    }
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <limits>
 #include <numeric>
 
 #include "mlasi.h"
@@ -24,6 +26,10 @@ MlasFlashAttentionThreaded(
     const float* key = args->key;
     const float* value = args->value;
     float* output = args->output;
+    ptrdiff_t kv_buffer_sequence_length =
+        args->kv_buffer_sequence_length > 0 ? static_cast<ptrdiff_t>(args->kv_buffer_sequence_length) : kv_sequence_length;
+    const bool is_causal = args->is_causal;
+    ptrdiff_t causal_offset = static_cast<ptrdiff_t>(args->causal_offset);
 
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
     auto&& mlas_platform = GetMlasPlatform();
@@ -61,7 +67,15 @@ MlasFlashAttentionThreaded(
         float* temp_output = intermediate + q_block_size * kv_block_size;
         float negmax = 0;
 
-        for (ptrdiff_t ir = 0; ir < kv_sequence_length; ir += kv_block_size) {
+        //
+        // Keys after the causal boundary of the last query of the block don't contribute.
+        //
+        ptrdiff_t kv_end = kv_sequence_length;
+        if (is_causal) {
+            kv_end = std::min(kv_end, causal_offset + std::min(q_idx + q_block_size, q_sequence_length));
+        }
+
+        for (ptrdiff_t ir = 0; ir < kv_end; ir += kv_block_size) {
             /*
                 S = Q[batch_idx, head_idx, q_idx:q_idx+q_block_size, :] * (K[batch_idx, head_idx, ir:ir+kv_block_size, :]).T
                 old_m = m
@@ -73,11 +87,11 @@ MlasFlashAttentionThreaded(
             */
             ptrdiff_t h = batch_idx * num_heads + head_idx;
             const float* inputQ = query + (h * q_sequence_length + q_idx) * qk_head_size;
-            const float* inputK = key + (h * kv_sequence_length + ir) * qk_head_size;
-            const float* inputV = value + (h * kv_sequence_length + ir) * v_head_size;
+            const float* inputK = key + (h * kv_buffer_sequence_length + ir) * qk_head_size;
+            const float* inputV = value + (h * kv_buffer_sequence_length + ir) * v_head_size;
 
             size_t row_size_q_capped = static_cast<size_t>(std::min(q_block_size, q_sequence_length - q_idx));
-            size_t row_size_kv_capped = static_cast<size_t>(std::min(kv_block_size, kv_sequence_length - ir));
+            size_t row_size_kv_capped = static_cast<size_t>(std::min(kv_block_size, kv_end - ir));
 
             MlasSgemmOperation(CBLAS_TRANSPOSE::CblasNoTrans,
                      CBLAS_TRANSPOSE::CblasTrans,
@@ -96,6 +110,28 @@ MlasFlashAttentionThreaded(
             for (ptrdiff_t irow = 0; irow < static_cast<ptrdiff_t>(row_size_q_capped); ++irow) {
                 float* p = intermediate + irow * row_size_kv_capped;
 
+                if (args->attn_bias != nullptr) {
+                    const float* bias_row = args->attn_bias + batch_idx * args->attn_bias_batch_stride +
+                                            head_idx * args->attn_bias_head_stride +
+                                            (q_idx + irow) * kv_sequence_length + ir;
+                    for (size_t icol = 0; icol < row_size_kv_capped; ++icol) {
+                        p[icol] += bias_row[icol];
+                    }
+                }
+                if (args->mask != nullptr) {
+                    const float* mask_row = args->mask + batch_idx * args->mask_batch_stride +
+                                            (q_idx + irow) * args->mask_row_stride + ir;
+                    for (size_t icol = 0; icol < row_size_kv_capped; ++icol) {
+                        p[icol] += mask_row[icol];
+                    }
+                }
+                if (is_causal) {
+                    ptrdiff_t causal_end = causal_offset + q_idx + irow + 1 - ir;
+                    for (ptrdiff_t icol = std::max<ptrdiff_t>(causal_end, 0); icol < static_cast<ptrdiff_t>(row_size_kv_capped); ++icol) {
+                        p[icol] = std::numeric_limits<float>::lowest();
+                    }
+                }
+
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
                 float rowmax = mlas_platform.ReduceMaximumF32Kernel(p, row_size_kv_capped);
 #else
@@ -925,7 +925,7 @@ extern "C" {
 #define MLAS_DGEMM_THREAD_COMPLEXITY                (size_t(64) * size_t(1024))
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 #define MLAS_SBGEMM_THREAD_COMPLEXITY (size_t(64) * size_t(1024))
 #endif
 
@@ -1029,6 +1029,18 @@ extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512;
 
 extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512vnni;
 
+extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAmx;
+
+extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchWasmSimd;
+
+//
+// Float/bfloat16 matrix/matrix multiply dispatch structure.
+//
+
+struct MLAS_SBGEMM_DISPATCH;
+
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16;
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -1186,6 +1198,10 @@ struct MLAS_PLATFORM {
 
     const MLAS_SQNBIT_GEMM_DISPATCH* SQNBitGemmDispatch{nullptr};
 
+#if defined(MLAS_TARGET_AMD64)
+    const MLAS_SBGEMM_DISPATCH* SBGemmDispatch{nullptr};
+#endif
+
     MLAS_CAST_F16_TO_F32_KERNEL* CastF16ToF32Kernel;
     MLAS_CAST_F32_TO_F16_KERNEL* CastF32ToF16Kernel;
 };
@@ -17,6 +17,8 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <thread>
 #include <mutex>
 
@@ -220,6 +222,98 @@ MLAS_INTERNAL_DATA MLAS_DECLSPEC_ALIGN(const uint32_t MlasMaskMoveTableLasx[16],
 };
 
 #endif
+
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_ARM64)
+
+//
+// The ISA levels the platform dispatch can be capped at, in increasing order.
+//
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+
+enum MLAS_ISA_LEVEL {
+    MlasIsaSse2,
+    MlasIsaSse41,
+    MlasIsaAvx,
+    MlasIsaAvx2,
+    MlasIsaAvxVnni,
+    MlasIsaAvx512F,
+    MlasIsaAvx512Core,
+    MlasIsaAvx512Vnni,
+    MlasIsaAmx,
+    MlasIsaCount
+};
+
+static const char* const MlasIsaNames[MlasIsaCount] = {
+    "sse2", "sse41", "avx", "avx2", "avxvnni", "avx512f", "avx512core", "avx512vnni", "amx",
+};
+
+#else
+
+enum MLAS_ISA_LEVEL {
+    MlasIsaNeon,
+    MlasIsaDot,
+    MlasIsaI8mm,
+    MlasIsaCount
+};
+
+static const char* const MlasIsaNames[MlasIsaCount] = {
+    "neon", "dot", "i8mm",
+};
+
+#endif
+
+static
+int
+MlasGetMaximumIsaLevel(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine reads the ISA level the platform dispatch is capped at from
+    the ORT_MLAS_MAX_ISA environment variable. Capping the ISA lets the kernels
+    of the lower ISAs be tested and benchmarked on a machine that supports a
+    higher ISA.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the ISA level named by the environment variable, or the highest
+    level if the variable is not set or does not name a level of this target.
+
+--*/
+{
+    char Value[32];
+
+#if defined(_WIN32)
+    const DWORD Length = GetEnvironmentVariableA("ORT_MLAS_MAX_ISA", Value, sizeof(Value));
+    if (Length == 0 || Length >= sizeof(Value)) {
+        return MlasIsaCount - 1;
+    }
+#else
+    const char* Variable = getenv("ORT_MLAS_MAX_ISA");
+    if (Variable == nullptr || strlen(Variable) >= sizeof(Value)) {
+        return MlasIsaCount - 1;
+    }
+    strcpy(Value, Variable);
+#endif
+
+    for (int Level = 0; Level < MlasIsaCount; Level++) {
+        if (strcmp(Value, MlasIsaNames[Level]) == 0) {
+            return Level;
+        }
+    }
+
+    return MlasIsaCount - 1;
+}
+
+#endif
+
 MLAS_PLATFORM::MLAS_PLATFORM(
     void
     )
@@ -247,6 +341,10 @@ Return Value:
     this->CastF16ToF32Kernel = nullptr;
     this->CastF32ToF16Kernel = nullptr;
 
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_ARM64)
+    const int MaximumIsaLevel = MlasGetMaximumIsaLevel();
+#endif
+
 #if defined(MLAS_TARGET_AMD64_IX86)
 
     //
@@ -309,7 +407,7 @@ Return Value:
     // Check if the processor supports SSE 4.1 instructions.
     //
 
-    if ((Cpuid1[2] & 0x80000) != 0) {
+    if ((Cpuid1[2] & 0x80000) != 0 && MaximumIsaLevel >= MlasIsaSse41) {
         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchSse41;
     }
 
@@ -319,7 +417,7 @@ Return Value:
     // Check if the processor supports the AVX and OSXSAVE features.
     //
 
-    if ((Cpuid1[2] & 0x18000000) == 0x18000000) {
+    if ((Cpuid1[2] & 0x18000000) == 0x18000000 && MaximumIsaLevel >= MlasIsaAvx) {
 
         //
         // Check if the operating system supports saving SSE and AVX states.
@@ -361,7 +459,7 @@ Return Value:
             __cpuid_count(7, 0, Cpuid7[0], Cpuid7[1], Cpuid7[2], Cpuid7[3]);
 #endif
 
-            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
+            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0) && MaximumIsaLevel >= MlasIsaAvx2) {
 
                 this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAvx2;
                 this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx2;
@@ -411,7 +509,7 @@ Return Value:
                 __cpuid_count(7, 1, Cpuid7_1[0], Cpuid7_1[1], Cpuid7_1[2], Cpuid7_1[3]);
 #endif
 
-                if ((Cpuid7_1[0] & 0x10) != 0) {
+                if ((Cpuid7_1[0] & 0x10) != 0 && MaximumIsaLevel >= MlasIsaAvxVnni) {
 
                     this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
@@ -427,7 +525,7 @@ Return Value:
                 // operating system supports saving AVX512F state.
                 //
 
-                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
+                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0) && MaximumIsaLevel >= MlasIsaAvx512F) {
 
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
@@ -451,7 +549,7 @@ Return Value:
                     // (AVX512BW/AVX512DQ/AVX512VL).
                     //
 
-                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000) {
+                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000 && MaximumIsaLevel >= MlasIsaAvx512Core) {
 
                         this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Core;
                         this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Core;
@@ -464,7 +562,7 @@ Return Value:
                         // Check if the processor supports AVX512VNNI.
                         //
 
-                        if ((Cpuid7[2] & 0x800) != 0) {
+                        if ((Cpuid7[2] & 0x800) != 0 && MaximumIsaLevel >= MlasIsaAvx512Vnni) {
 
                             this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
@@ -473,13 +571,22 @@ Return Value:
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
                             this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512vnni;
                         }
+
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0 && MaximumIsaLevel >= MlasIsaAvx512Vnni) {
+
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAvx512Bf16;
+                        }
                     }
                 }
 
                 //
                 // Check if the processor supports AVX-VNNI-INT8
                 //
-                if ((Cpuid7_1[3] & 0x10) != 0) {
+                if ((Cpuid7_1[3] & 0x10) != 0 && MaximumIsaLevel >= MlasIsaAvxVnni) {
                     this->GemmU8U8Dispatch = &MlasGemmU8U8DispatchAvx2Vnni;
                     this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchAvx2Vnni;
                     this->GemmS8S8Kernel = MlasGemmS8S8KernelAvx2Vnni;
@@ -492,7 +599,7 @@ Return Value:
                 //
                 // Check if the processor supports AVX NE CONVERT.
                 //
-                if ((Cpuid7_1[3] & (0b1 << 5)) != 0) {
+                if ((Cpuid7_1[3] & (0b1 << 5)) != 0 && MaximumIsaLevel >= MlasIsaAvxVnni) {
                     this->CastF16ToF32Kernel = &MlasCastF16ToF32KernelAvx;
                 }
 #endif  // (defined(_MSC_VER) && (_MSC_VER >= 1933)) || (defined(__GNUC__) && (__GNUC__ >= 13))
@@ -504,10 +611,19 @@ Return Value:
                 //
                 if ((Cpuid7[3] & 0b1 << 24) != 0 &&
                     (Cpuid7[3] & 0b1 << 25) != 0 &&
-                    (xcr0 & XFEATURE_MASK_XTILE) == XFEATURE_MASK_XTILE) {
+                    (xcr0 & XFEATURE_MASK_XTILE) == XFEATURE_MASK_XTILE &&
+                    MaximumIsaLevel >= MlasIsaAmx) {
                     if (MlasInitAMX()) {
                         this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+
+                        //
+                        // The AMX SQNBitGemm kernels fall back to the AVX512VNNI kernels.
+                        //
+
+                        if (this->SQNBitGemmDispatch == &MlasSQNBitGemmDispatchAvx512vnni) {
+                            this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAmx;
+                        }
                     }
                 }
 #endif // __APPLE__
@@ -553,7 +669,7 @@ Return Value:
     HasDotProductInstructions = MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeonDot();
 #endif
 
-    if (HasDotProductInstructions) {
+    if (HasDotProductInstructions && MaximumIsaLevel >= MlasIsaDot) {
         this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchUdot;
         this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchUdot;
         this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchSdot;
@@ -569,7 +685,7 @@ Return Value:
     //
     // Check if the processor supports ASIMD I8MM instructions.
     //
-    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeon_I8MM()) {
+    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeon_I8MM() && MaximumIsaLevel >= MlasIsaI8mm) {
         this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchUmmla;
         this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchUmmla;
         this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchSmmla;
@@ -679,6 +795,10 @@ Return Value:
 
 #endif // MLAS_TARGET_LARCH64
 
+#if defined(MLAS_TARGET_WASM_SIMD)
+    this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchWasmSimd;
+#endif // MLAS_TARGET_WASM_SIMD
+
 }
 
 size_t
@@ -30,8 +30,6 @@ Abstract:
         MLAS_SBGEMM_STRIDES Strides{128, 128, 256};
 --*/
 
-#if defined(__aarch64__) && defined(__linux__)
-
 #pragma once
 
 #include <cassert>
@@ -39,6 +37,13 @@ Abstract:
 
 #include "mlasi.h"
 
+#if defined(MLAS_SBGEMM_SUPPORTED)
+
+#if !defined(MLAS_TARGET_ARM64)
+// Raw bits of a bfloat16 value, arm_neon.h provides the type on ARM64.
+typedef uint16_t bfloat16_t;
+#endif
+
 /**
  * @brief Define the default striding parameters for
  *        the bfloat16 precision gemm operation
@@ -134,7 +139,9 @@ MlasSBGemmPackedOperation(size_t M, size_t RangeStartN, size_t RangeCountN, size
             bool ZeroMode = (k == 0);
             CountK = std::min(K - k, PackedStrideK);
 
-            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + CountK * SliceStartN;
+            // rows of a slice are padded to PackedK, like the rows of B are in the packing buffer
+            const size_t AlignedCountK = (CountK + KernelType::PackedK - 1) & ~(KernelType::PackedK - 1);
+            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + AlignedCountK * SliceStartN;
             float* c = C + n;
             const float* pbias = ((nullptr == Bias) ? nullptr : Bias + RangeStartN + n);
             MlasSBGemmKernel<KernelType>(M, CountN, CountK, A + k, lda, pb, c, ldc, ZeroMode ? pbias : nullptr, ZeroMode);
@@ -162,7 +169,7 @@ MlasSBGemmNonPackedOperation(size_t M, size_t N, size_t K, const float* A, size_
     size_t StrideK = Strides.K;
 
     if (N >= K) {
-        while (StrideK / 2 >= K) {
+        while (StrideK / 2 >= K && StrideK / 2 >= KernelType::PackedK) {
             StrideN *= 2;
             StrideK /= 2;
         }
@@ -291,6 +298,8 @@ MlasSBGemmGetDispatch()
 {
 #if defined(MLAS_TARGET_ARM64)
     return &MlasSBGemmDispatchNeon;
+#elif defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().SBGemmDispatch;
 #else
     std::cerr << "SBGemm Kernel is supported only on ARM64 platform.";
     exit(1);
@@ -396,4 +405,4 @@ MlasSBGemmBatch(const size_t M, const size_t N, const size_t K, const size_t Bat
         }
     );
 }
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
@@ -0,0 +1,276 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements bfloat16 precision GEMM kernel for AVX512_BF16.
+
+--*/
+
+#include "mlasi.h"
+
+#if defined(MLAS_TARGET_AMD64)
+
+#include <cstring>
+
+#include "sbgemm.h"
+
+struct MLAS_SBGEMM_KERNEL_AVX512BF16 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 8;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 2;
+    static constexpr size_t PackedN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+static_assert(MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN == 16, "a packed column group is one AVX512 register");
+
+bool MLASCALL
+MlasBf16AccelerationSupported()
+{
+    return GetMlasPlatform().SBGemmDispatch != nullptr;
+}
+
+MLAS_FORCEINLINE
+__m512bh
+MlasReinterpretAsBf16x32(__m512i Value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return Value;
+#else
+    return (__m512bh)Value;
+#endif
+}
+
+/*
+    This routine rounds fp32 values to the nearest even bf16 value. The bf16
+    value is returned in the upper 16 bits of each 32-bit element.
+*/
+MLAS_FORCEINLINE
+__m512i
+MlasRoundFloat32ToBf16Avx512(__m512 Value)
+{
+    const __m512i Bits = _mm512_castps_si512(Value);
+    const __m512i Lsb = _mm512_and_si512(_mm512_srli_epi32(Bits, 16), _mm512_set1_epi32(1));
+    const __m512i Rounded = _mm512_add_epi32(Bits, _mm512_add_epi32(Lsb, _mm512_set1_epi32(0x7FFF)));
+
+    //
+    // Keep NaNs quiet instead of rounding them to infinity.
+    //
+
+    const __mmask16 IsNan = _mm512_cmp_ps_mask(Value, Value, _CMP_UNORD_Q);
+    return _mm512_mask_or_epi32(Rounded, IsNan, Bits, _mm512_set1_epi32(0x00400000));
+}
+
+MLAS_FORCEINLINE
+__mmask16
+MlasSBGemmElementMask(size_t CountN)
+{
+    return __mmask16((1u << std::min(CountN, size_t{16})) - 1);
+}
+
+/*
+    This routine converts fp32 to bf16 and copies elements from the source
+    matrix to the destination packed buffer.
+
+    Columns are packed in groups of 16. Within a group, rows k and k + 1 are
+    interleaved so each 32-bit element holds B[k, n] in its lower and
+    B[k + 1, n] in its upper 16 bits, the operand layout of VDPBF16PS. The
+    remaining columns are padded to 16 and the rows to 2 with zeros.
+*/
+MLAS_FORCEINLINE
+void
+MlasSBGemmConvertCopyPackBAvx512Bf16(bfloat16_t* D, const float* B, size_t ldb, size_t CountN, size_t CountK)
+{
+    const __m512i HighMask = _mm512_set1_epi32(int(0xFFFF0000));
+
+    for (size_t n = 0; n < CountN; n += 16) {
+        const __mmask16 Mask = MlasSBGemmElementMask(CountN - n);
+        const float* b = B + n;
+
+        for (size_t k = 0; k < CountK; k += 2) {
+            const __m512i Row0 = MlasRoundFloat32ToBf16Avx512(_mm512_maskz_loadu_ps(Mask, b));
+            __m512i Row1 = _mm512_setzero_si512();
+            if (k + 1 < CountK) {
+                Row1 = MlasRoundFloat32ToBf16Avx512(_mm512_maskz_loadu_ps(Mask, b + ldb));
+            }
+
+            const __m512i Pairs = _mm512_or_si512(_mm512_and_si512(Row1, HighMask), _mm512_srli_epi32(Row0, 16));
+            _mm512_storeu_si512(D, Pairs);
+
+            D += 32;
+            b += 2 * ldb;
+        }
+    }
+}
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    constexpr size_t PackedN = MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN;
+    const size_t AlignedN = (CountN + PackedN - 1) & ~(PackedN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+    size_t K_block_size;
+    constexpr MLAS_SBGEMM_STRIDES Strides = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides;
+
+    for (size_t k = 0; k < CountK; k += K_block_size) {
+        K_block_size = std::min(CountK - k, Strides.K);
+
+        MlasSBGemmConvertCopyPackBAvx512Bf16(PackedB, B + k * ldb, ldb, CountN, K_block_size);
+        PackedB += AlignedN * K_block_size;
+    }
+}
+
+/*
+    This routine converts up to KernelMaxM rows of a slice of matrix A to bf16,
+    padding each row to an even number of elements with zeros.
+*/
+MLAS_FORCEINLINE
+void
+MlasSBGemmConvertA(
+    size_t CountM,
+    size_t CountK,
+    const float* A,
+    size_t lda,
+    uint16_t (*D)[MLAS_SBGEMM_KERNEL_AVX512BF16::Strides.K]
+)
+{
+    for (size_t m = 0; m < CountM; m++) {
+        for (size_t k = 0; k < CountK; k += 16) {
+            const __mmask16 Mask = MlasSBGemmElementMask(CountK - k);
+            const __m512i Rounded = MlasRoundFloat32ToBf16Avx512(_mm512_maskz_loadu_ps(Mask, A + m * lda + k));
+            _mm256_storeu_si256((__m256i*)&D[m][k], _mm512_cvtepi32_epi16(_mm512_srli_epi32(Rounded, 16)));
+        }
+    }
+}
+
+template <size_t RowCount>
+MLAS_FORCEINLINE void
+MlasSBGemmKernelAvx512Bf16(
+    size_t CountN,
+    size_t CountK,
+    const uint16_t (*A)[MLAS_SBGEMM_KERNEL_AVX512BF16::Strides.K],
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    bool Accumulate
+)
+{
+    const size_t AlignedK = (CountK + 1) & ~size_t{1};
+
+    for (size_t n = 0; n < CountN; n += 16) {
+        const __mmask16 Mask = MlasSBGemmElementMask(CountN - n);
+
+        __m512 Accumulators[RowCount];
+        for (size_t m = 0; m < RowCount; m++) {
+            if (Accumulate) {
+                Accumulators[m] = _mm512_maskz_loadu_ps(Mask, C + m * ldc + n);
+            } else if (Bias != nullptr) {
+                Accumulators[m] = _mm512_maskz_loadu_ps(Mask, Bias + n);
+            } else {
+                Accumulators[m] = _mm512_setzero_ps();
+            }
+        }
+
+        const bfloat16_t* b = B + n * AlignedK;
+        for (size_t k = 0; k < AlignedK; k += 2) {
+            const __m512bh BPairs = MlasReinterpretAsBf16x32(_mm512_loadu_si512(b));
+            for (size_t m = 0; m < RowCount; m++) {
+                int32_t APair;
+                std::memcpy(&APair, &A[m][k], sizeof(APair));
+                Accumulators[m] = _mm512_dpbf16_ps(Accumulators[m], MlasReinterpretAsBf16x32(_mm512_set1_epi32(APair)), BPairs);
+            }
+            b += 32;
+        }
+
+        for (size_t m = 0; m < RowCount; m++) {
+            _mm512_mask_storeu_ps(C + m * ldc + n, Mask, Accumulators[m]);
+        }
+    }
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX512BF16>(size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode)
+{
+    constexpr size_t KernelMaxM = MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM;
+    constexpr size_t StrideK = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides.K;
+    constexpr size_t PackedN = MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN;
+
+    //
+    // B is packed in slices of StrideK rows, see MlasSBGemmConvertPackB.
+    //
+    const size_t AlignedN = (CountN + PackedN - 1) & ~(PackedN - 1);
+
+    MLAS_DECLSPEC_ALIGN(uint16_t PanelA[KernelMaxM][StrideK], 64);
+
+    while (CountM > 0) {
+        const size_t RowsHandled = std::min(CountM, KernelMaxM);
+
+        size_t CountSliceK;
+        for (size_t k = 0; k < CountK; k += CountSliceK) {
+            CountSliceK = std::min(CountK - k, StrideK);
+
+            MlasSBGemmConvertA(RowsHandled, CountSliceK, A + k, lda, PanelA);
+
+            const bfloat16_t* b = B + AlignedN * k;
+            const bool Accumulate = !ZeroMode || k > 0;
+
+            switch (RowsHandled) {
+                case 1:
+                    MlasSBGemmKernelAvx512Bf16<1>(CountN, CountSliceK, PanelA, b, C, ldc, Bias, Accumulate);
+                    break;
+                case 2:
+                    MlasSBGemmKernelAvx512Bf16<2>(CountN, CountSliceK, PanelA, b, C, ldc, Bias, Accumulate);
+                    break;
+                case 3:
+                    MlasSBGemmKernelAvx512Bf16<3>(CountN, CountSliceK, PanelA, b, C, ldc, Bias, Accumulate);
+                    break;
+                case 4:
+                    MlasSBGemmKernelAvx512Bf16<4>(CountN, CountSliceK, PanelA, b, C, ldc, Bias, Accumulate);
+                    break;
+                case 5:
+                    MlasSBGemmKernelAvx512Bf16<5>(CountN, CountSliceK, PanelA, b, C, ldc, Bias, Accumulate);
+                    break;
+                case 6:
+                    MlasSBGemmKernelAvx512Bf16<6>(CountN, CountSliceK, PanelA, b, C, ldc, Bias, Accumulate);
+                    break;
+                case 7:
+                    MlasSBGemmKernelAvx512Bf16<7>(CountN, CountSliceK, PanelA, b, C, ldc, Bias, Accumulate);
+                    break;
+                default:
+                    MlasSBGemmKernelAvx512Bf16<8>(CountN, CountSliceK, PanelA, b, C, ldc, Bias, Accumulate);
+                    break;
+            }
+        }
+
+        C += ldc * RowsHandled;
+        A += lda * RowsHandled;
+        CountM -= RowsHandled;
+    }
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM,
+    0  // column groups are loaded with masks, the kernel doesn't read beyond the buffer
+};
+
+#endif  // defined(MLAS_TARGET_AMD64)
@@ -19,6 +19,7 @@ Abstract:
 #include "sqnbitgemm_q8_block.h"
 
 #include <cassert>
+#include <cstring>
 
 namespace
 {
@@ -30,6 +31,8 @@ enum SQNBitGemmVariant {
 
     SQNBitGemmVariant_BitWidth4_CompFp32 = 0,
     SQNBitGemmVariant_BitWidth4_CompInt8,
+    SQNBitGemmVariant_BitWidth2_CompFp32,
+    SQNBitGemmVariant_BitWidth3_CompFp32,
 
     // End of valid variants
 
@@ -45,14 +48,23 @@ GetSQNBitGemmVariant(
     MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType
 )
 {
-    if (BlkBitWidth == 4 &&
-        (BlkLen == 16 || BlkLen == 32 || BlkLen == 64 || BlkLen == 128 || BlkLen == 256)) {
-        if (ComputeType == CompFp32 ||
-            ComputeType == CompUndef) {  // treat CompUndef (undefined) as CompFp32
+    if (!(BlkLen == 16 || BlkLen == 32 || BlkLen == 64 || BlkLen == 128 || BlkLen == 256)) {
+        return SQNBitGemmVariantInvalid;
+    }
+
+    // treat CompUndef (undefined) as CompFp32
+    const bool IsCompFp32 = ComputeType == CompFp32 || ComputeType == CompUndef;
+
+    if (BlkBitWidth == 4) {
+        if (IsCompFp32) {
             return SQNBitGemmVariant_BitWidth4_CompFp32;
         } else if (ComputeType == CompInt8) {
             return SQNBitGemmVariant_BitWidth4_CompInt8;
         }
+    } else if (BlkBitWidth == 2 && IsCompFp32) {
+        return SQNBitGemmVariant_BitWidth2_CompFp32;
+    } else if (BlkBitWidth == 3 && IsCompFp32) {
+        return SQNBitGemmVariant_BitWidth3_CompFp32;
     }
 
     return SQNBitGemmVariantInvalid;
@@ -84,6 +96,11 @@ MlasIsSQNBitGemmAvailable(
               (Dispatch->SQ4BitGemmKernel_CompInt8 != nullptr && Dispatch->QuantizeARow_CompInt8 != nullptr) ||
               (Dispatch->SQ4BitGemmKernel_BlkSum_CompInt8 != nullptr && Dispatch->QuantizeARowComputeBlkSum_CompInt8 != nullptr);
         }
+        case SQNBitGemmVariant_BitWidth2_CompFp32:
+        case SQNBitGemmVariant_BitWidth3_CompFp32: {
+            return Dispatch->SQLowBitGemmM1Kernel_CompFp32 != nullptr &&
+                   Dispatch->QLowBitBlkDequantBForSgemm_CompFp32 != nullptr;
+        }
         default: {
             return false;
         }
@@ -194,6 +211,11 @@ MlasSQNBitGemmPackQuantBDataSize(
         );
     }
 
+    if ((BlkBitWidth == 2 || BlkBitWidth == 3) && Dispatch->SQLowBitGemmM1Kernel_CompFp32 != nullptr) {
+        // 2-bit and 3-bit B is used as is, "packing" copies it
+        return N * MlasDivRoundup(K, BlkLen) * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    }
+
     return 0;
 }
 
@@ -263,6 +285,10 @@ MlasSQNBitGemmPackQuantBData(
             );
             return;
         }
+    } else if ((BlkBitWidth == 2 || BlkBitWidth == 3) && QuantBData != nullptr &&
+               Dispatch->SQLowBitGemmM1Kernel_CompFp32 != nullptr) {
+        const size_t QuantBDataSize = N * MlasDivRoundup(K, BlkLen) * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+        std::memcpy(PackedQuantBDataAndOrBlkSumWorkspace, QuantBData, QuantBDataSize);
     }
 }
 
@@ -306,8 +332,9 @@ typedef void(SQNBitGemmFn)(
     size_t RangeCountN
 );
 
+template <size_t BlkBitWidth>
 void
-SQ4BitGemm_CompFp32(
+SQNBitGemm_CompFp32(
     const size_t BlkLen,
     const size_t K,
     const MLAS_SQNBIT_GEMM_DATA_PARAMS* const DataParams,
@@ -318,8 +345,6 @@ SQ4BitGemm_CompFp32(
     const size_t RangeCountN
 )
 {
-    constexpr size_t BlkBitWidth = 4;
-
     MLAS_UNREFERENCED_PARAMETER(PerGemmWorkspace);
 
     const size_t lda = DataParams->lda;
@@ -355,10 +380,17 @@ SQ4BitGemm_CompFp32(
             float* c_blk = C + n;
             const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
 
-            GetMlasPlatform().SQNBitGemmDispatch->SQ4BitGemmM1Kernel_CompFp32(
-                BlkLen,
-                a_row, b_col, b_col_scale, b_col_zp, c_blk, CountN, K, k_blks, bias
-            );
+            if constexpr (BlkBitWidth == 4) {
+                GetMlasPlatform().SQNBitGemmDispatch->SQ4BitGemmM1Kernel_CompFp32(
+                    BlkLen,
+                    a_row, b_col, b_col_scale, b_col_zp, c_blk, CountN, K, k_blks, bias
+                );
+            } else {
+                GetMlasPlatform().SQNBitGemmDispatch->SQLowBitGemmM1Kernel_CompFp32(
+                    BlkBitWidth, BlkLen,
+                    a_row, b_col, b_col_scale, b_col_zp, c_blk, CountN, K, k_blks, bias
+                );
+            }
 
             if (DataParams->PostProcessor != nullptr) {
                 DataParams->PostProcessor->Process(
@@ -393,10 +425,17 @@ SQ4BitGemm_CompFp32(
         float* c_blk = C + n;
         const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
 
-        GetMlasPlatform().SQNBitGemmDispatch->Q4BitBlkDequantBForSgemm_CompFp32(
-            BlkLen,
-            dequant_b, b_col, b_col_scale, b_col_zp, CountN, K, k_blks
-        );
+        if constexpr (BlkBitWidth == 4) {
+            GetMlasPlatform().SQNBitGemmDispatch->Q4BitBlkDequantBForSgemm_CompFp32(
+                BlkLen,
+                dequant_b, b_col, b_col_scale, b_col_zp, CountN, K, k_blks
+            );
+        } else {
+            GetMlasPlatform().SQNBitGemmDispatch->QLowBitBlkDequantBForSgemm_CompFp32(
+                BlkBitWidth, BlkLen,
+                dequant_b, b_col, b_col_scale, b_col_zp, CountN, K, k_blks
+            );
+        }
 
         size_t RowsRemaining = RangeCountM;
         while (RowsRemaining > 0) {
@@ -630,11 +669,14 @@ struct Operations {
 constexpr auto OperationMap = []() {
     std::array<Operations, SQNBitGemmVariantCount> ops;
 
-    ops[SQNBitGemmVariant_BitWidth4_CompFp32].SQNBitGemm = SQ4BitGemm_CompFp32;
+    ops[SQNBitGemmVariant_BitWidth4_CompFp32].SQNBitGemm = SQNBitGemm_CompFp32<4>;
 
     ops[SQNBitGemmVariant_BitWidth4_CompInt8].InitializeWorkspace = InitializeWorkspace_CompInt8;
     ops[SQNBitGemmVariant_BitWidth4_CompInt8].SQNBitGemm = SQ4BitGemm_CompInt8;
 
+    ops[SQNBitGemmVariant_BitWidth2_CompFp32].SQNBitGemm = SQNBitGemm_CompFp32<2>;
+    ops[SQNBitGemmVariant_BitWidth3_CompFp32].SQNBitGemm = SQNBitGemm_CompFp32<3>;
+
     return ops;
 }();
 }  // namespace
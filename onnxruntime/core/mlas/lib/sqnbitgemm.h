@@ -73,11 +73,24 @@ template <size_t BlkBitWidth>
 constexpr MLAS_FORCEINLINE size_t
 MlasQNBitZeroPointsForBlksSizeInBytes(size_t BlkCount)
 {
-    if constexpr (BlkBitWidth <= 4) {
-        return MlasDivRoundup(BlkCount, 2);  // 2 blocks per byte
-    } else {
-        return BlkCount;
+    // zero points are packed with BlkBitWidth bits each, e.g., 2 blocks per byte for 4-bit
+    return MlasDivRoundup(BlkCount * BlkBitWidth, 8);
+}
+
+/**
+ * @brief Gets value `Index` of a little-endian bit stream of BlkBitWidth-bit values, e.g., the 2-bit and 3-bit
+ *        quantized B data or zero points.
+ */
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE uint8_t
+MlasQNBitGetPackedValue(const std::byte* Data, size_t Index)
+{
+    const size_t BitOffset = Index * BlkBitWidth;
+    uint32_t Bits = std::to_integer<uint32_t>(Data[BitOffset / 8]);
+    if (BitOffset % 8 + BlkBitWidth > 8) {
+        Bits |= std::to_integer<uint32_t>(Data[BitOffset / 8 + 1]) << 8;
     }
+    return static_cast<uint8_t>((Bits >> (BitOffset % 8)) & ((1u << BlkBitWidth) - 1));
 }
 
 //
@@ -230,6 +243,62 @@ struct MLAS_SQNBIT_GEMM_DISPATCH {
 
     Q4BitBlkDequantBForSgemm_CompFp32_Fn* Q4BitBlkDequantBForSgemm_CompFp32 = nullptr;
 
+    //
+    // CompFp32 kernel function prototypes for 2-bit and 3-bit quantized B.
+    // B is not packed. The values of a block are stored as a little-endian bit stream, i.e., value i of a block
+    // occupies bits [i * BlkBitWidth, (i + 1) * BlkBitWidth) of the block data. Zero points are stored the same way
+    // and default to 2^(BlkBitWidth - 1).
+    //
+
+    /**
+     * @brief Multiply float matrix A with quantized 2-bit or 3-bit integer matrix B.
+     *        B is block quantized and column major.
+     *        This kernel handles the special case where M, the number of rows of A and C, is 1.
+     *
+     * @param       BlkBitWidth         Number of bits of a quantized value, 2 or 3.
+     * @param       BlkLen              Number of values in a block.
+     *
+     * See SQ4BitGemmM1Kernel_CompFp32_Fn for the other parameters.
+     */
+    typedef void(SQLowBitGemmM1Kernel_CompFp32_Fn)(
+        size_t BlkBitWidth,
+        size_t BlkLen,
+        const float* A,
+        const std::byte* QuantBData,
+        const float* QuantBScale,
+        const std::byte* QuantBZeroPoint,
+        float* C,
+        size_t CountN,
+        size_t CountK,
+        size_t BlockStrideQuantB,
+        const float* Bias
+    );
+
+    SQLowBitGemmM1Kernel_CompFp32_Fn* SQLowBitGemmM1Kernel_CompFp32 = nullptr;
+
+    /**
+     * @brief Dequantize 2-bit or 3-bit B into the format expected by the Sgemm kernel.
+     *        Only the first (CountN + 16 - 1) / 16 * 16 * CountK elements of FpData are written.
+     *
+     * @param       BlkBitWidth         Number of bits of a quantized value, 2 or 3.
+     * @param       BlkLen              Number of values in a block.
+     *
+     * See Q4BitBlkDequantBForSgemm_CompFp32_Fn for the other parameters.
+     */
+    typedef void(QLowBitBlkDequantBForSgemm_CompFp32_Fn)(
+        size_t BlkBitWidth,
+        size_t BlkLen,
+        float* FpData,
+        const std::byte* QuantBData,
+        const float* QuantBScale,
+        const std::byte* QuantBZeroPoint,
+        size_t CountN,
+        size_t CountK,
+        size_t BlockStrideQuantB
+    );
+
+    QLowBitBlkDequantBForSgemm_CompFp32_Fn* QLowBitBlkDequantBForSgemm_CompFp32 = nullptr;
+
     //
     // CompInt8 kernel function prototypes.
     //
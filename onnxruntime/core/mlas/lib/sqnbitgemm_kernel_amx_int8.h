@@ -0,0 +1,316 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_amx_int8.h
+
+Abstract:
+
+    This module implements the quantized 8-bit integer/quantized 4-bit integer
+    matrix multiplication kernel (CompInt8) for x64 AMX-INT8.
+
+    B is read from the layout packed for the AVX512 CompInt8 kernels (see
+    PackQuantB with a SubBlkLen of 128). A strip of 16 columns is unpacked to
+    unsigned 8-bit integers in the VNNI layout of an AMX tile once per call and
+    reused for every row of A.
+
+--*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "amx_common.h"
+#include "sqnbitgemm.h"
+#include "sqnbitgemm_kernel_avx_common.h"
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+
+constexpr size_t MlasQ4Int8AmxTileM = 16;
+constexpr size_t MlasQ4Int8AmxTileN = 16;
+constexpr size_t MlasQ4Int8AmxTileK = 64;
+
+// Below this number of rows of A, the tile loads and stores cost more than the AVX512VNNI kernels.
+constexpr size_t MlasQ4Int8AmxMinimumM = MlasQ4Int8AmxTileM;
+
+// The tile instructions are inline assembly that doesn't tell the compiler
+// which memory it accesses.
+MLAS_FORCEINLINE void
+MlasAmxMemoryBarrier()
+{
+#if !defined(_MSC_VER)
+    __asm__ volatile("" ::: "memory");
+#endif
+}
+
+struct MLAS_Q4INT8_AMX_TILECONFIG {
+    uint8_t palette_id = 0;
+    uint8_t start_row = 0;
+    uint8_t reserved1[14] = {0};
+    uint16_t colb[8] = {0};
+    uint8_t reserved2[16] = {0};
+    uint8_t rows[8] = {0};
+    uint8_t reserved3[8] = {0};
+};
+
+/**
+ * @brief Loads the tile configuration for CountM rows of A: TMM0 holds the
+ *        int32 results, TMM1 the int8 A tile and TMM2 the uint8 B tile of
+ *        TileK values along K.
+ */
+MLAS_FORCEINLINE void
+MlasQ4Int8AmxLoadTileConfig(size_t CountM, size_t TileK)
+{
+    MLAS_Q4INT8_AMX_TILECONFIG tc;
+    tc.palette_id = 1;
+    tc.rows[TMM0] = static_cast<uint8_t>(CountM);
+    tc.colb[TMM0] = static_cast<uint16_t>(MlasQ4Int8AmxTileN * sizeof(int32_t));
+    tc.rows[TMM1] = static_cast<uint8_t>(CountM);
+    tc.colb[TMM1] = static_cast<uint16_t>(TileK);
+    tc.rows[TMM2] = static_cast<uint8_t>(TileK / 4);
+    tc.colb[TMM2] = static_cast<uint16_t>(MlasQ4Int8AmxTileN * 4);
+    MlasAmxMemoryBarrier();
+    tile_loadconfig(&tc);
+}
+
+MLAS_FORCEINLINE void
+MlasQ4Int8UnpackNibbles(const std::byte* Src, size_t Count, uint8_t* Values)
+{
+    // byte i holds value i in its lower and value i + Count / 2 in its upper 4 bits
+    for (size_t i = 0; i < Count / 2; ++i) {
+        Values[i] = static_cast<uint8_t>(Src[i] & std::byte{0x0F});
+        Values[i + Count / 2] = static_cast<uint8_t>(Src[i] >> 4);
+    }
+}
+
+/**
+ * @brief Unpacks block k_blk of column n of B from the layout of PackQuantB with a SubBlkLen of 128.
+ *        CountN is the number of columns from the start of QuantBData, which is a multiple of 4 columns
+ *        from the start of B, and must include the last column of B if the number of columns of B
+ *        is not a multiple of 4.
+ */
+static void
+MlasQ4Int8UnpackQuantBBlk(
+    const std::byte* QuantBData,
+    size_t CountN,
+    size_t BlockCountK,
+    size_t BlkLen,
+    size_t n,
+    size_t k_blk,
+    uint8_t* Values
+)
+{
+    constexpr size_t SubBlkLen = 128;
+    constexpr size_t SubBlkDataSize = SubBlkLen / 2;
+    const size_t BlkDataSize = BlkLen / 2;
+
+    if (BlkLen >= SubBlkLen) {
+        const size_t SubBlkCountK = BlockCountK * BlkLen / SubBlkLen;
+        for (size_t s = 0; s < BlkLen / SubBlkLen; ++s) {
+            const size_t k_subblk = k_blk * BlkLen / SubBlkLen + s;
+            const size_t offset = GetContinueLayoutOffsetSubBlk(CountN, n, SubBlkCountK, k_subblk);
+            MlasQ4Int8UnpackNibbles(QuantBData + offset * SubBlkDataSize, SubBlkLen, Values + s * SubBlkLen);
+        }
+        return;
+    }
+
+    //
+    // Smaller blocks are packed by sub blocks of SubBlkLen values, except the
+    // blocks of a last sub block that extends beyond the blocks of the column.
+    //
+
+    const size_t BlksPerSubBlk = SubBlkLen / BlkLen;
+    const size_t k_subblk = k_blk / BlksPerSubBlk;
+    const bool PackedByBlk = (k_subblk + 1) * BlksPerSubBlk > BlockCountK;
+    const size_t k_blk_packed = PackedByBlk ? k_blk : k_subblk * BlksPerSubBlk;
+
+    const size_t offset = (BlkLen == 16)
+                              ? n * BlockCountK + k_blk_packed
+                              : GetContinueLayoutOffsetBlkInSubBlk(CountN, n, BlockCountK, k_blk_packed,
+                                                                   static_cast<int>(BlksPerSubBlk));
+    const std::byte* Src = QuantBData + offset * BlkDataSize;
+
+    if (PackedByBlk) {
+        MlasQ4Int8UnpackNibbles(Src, BlkLen, Values);
+    } else {
+        uint8_t SubBlkValues[SubBlkLen];
+        MlasQ4Int8UnpackNibbles(Src, SubBlkLen, SubBlkValues);
+        std::memcpy(Values, SubBlkValues + (k_blk % BlksPerSubBlk) * BlkLen, BlkLen);
+    }
+}
+
+/**
+ * @brief Index of the scale of block k_blk of column n in the scales reordered by ComputePackBlkSum.
+ */
+MLAS_FORCEINLINE size_t
+MlasQ4Int8QuantBScaleOffset(size_t CountN, size_t BlockCountK, size_t BlkLen, size_t n, size_t k_blk)
+{
+    constexpr size_t SubBlkLen = 128;
+    if (BlkLen == 16) {
+        return n * BlockCountK + k_blk;
+    } else if (BlkLen >= SubBlkLen) {
+        return GetContinueLayoutOffsetSubBlk(CountN, n, BlockCountK, k_blk);
+    } else {
+        return GetContinueLayoutOffsetBlkInSubBlk(CountN, n, BlockCountK, k_blk, static_cast<int>(SubBlkLen / BlkLen));
+    }
+}
+
+/**
+ * @brief Unpacks up to 16 columns of B to the VNNI layout of the B tile: each
+ *        row of 64 bytes holds 4 consecutive values along K of each column.
+ *        The scales of the columns are copied by block, 16 per block.
+ *        Missing columns are zero.
+ */
+static void
+MlasQ4Int8AmxUnpackStripB(
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    size_t CountN,
+    size_t StartN,
+    size_t StripN,
+    size_t BlockCountK,
+    size_t BlkLen,
+    uint8_t* StripB,
+    float* StripScale
+)
+{
+    const size_t StripBytes = BlockCountK * BlkLen * MlasQ4Int8AmxTileN;
+    std::memset(StripB, 0, StripBytes);
+    std::fill_n(StripScale, BlockCountK * MlasQ4Int8AmxTileN, 0.0f);
+
+    uint8_t Values[256];
+    assert(BlkLen <= sizeof(Values));
+
+    for (size_t j = 0; j < StripN; ++j) {
+        const size_t n = StartN + j;
+        for (size_t k_blk = 0; k_blk < BlockCountK; ++k_blk) {
+            MlasQ4Int8UnpackQuantBBlk(QuantBData, CountN, BlockCountK, BlkLen, n, k_blk, Values);
+
+            uint8_t* dst = StripB + k_blk * BlkLen * MlasQ4Int8AmxTileN + j * 4;
+            for (size_t k = 0; k < BlkLen; k += 4) {
+                std::memcpy(dst, Values + k, 4);
+                dst += MlasQ4Int8AmxTileN * 4;
+            }
+
+            StripScale[k_blk * MlasQ4Int8AmxTileN + j] =
+                QuantBScale[MlasQ4Int8QuantBScaleOffset(CountN, BlockCountK, BlkLen, n, k_blk)];
+        }
+    }
+}
+
+/**
+ * @brief Computes C = A * B + Bias for up to 16 rows of A and a strip of 16 columns of B,
+ *        excluding the zero point term that is added with the block sums.
+ *        The tile configuration must be loaded for CountM rows.
+ */
+MLAS_FORCEINLINE void
+MlasQ4Int8AmxKernelTile(
+    size_t BlkLen,
+    size_t TileK,
+    const std::byte* QuantA,
+    size_t lda,
+    const float* QuantAScale,
+    const uint8_t* StripB,
+    const float* StripScale,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t StripN,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    MLAS_DECLSPEC_ALIGN(int32_t Tile[MlasQ4Int8AmxTileM][MlasQ4Int8AmxTileN], 64);
+
+    __m512 acc[MlasQ4Int8AmxTileM];
+    for (size_t m = 0; m < MlasQ4Int8AmxTileM; ++m) {
+        acc[m] = _mm512_setzero_ps();
+    }
+
+    for (size_t k_blk = 0; k_blk < BlockCountK; ++k_blk) {
+        tile_zero(TMM0);
+        for (size_t k = 0; k < BlkLen; k += TileK) {
+            tile_loadd(TMM1, QuantA + k_blk * BlkLen + k, lda);
+            tile_loadd(TMM2, StripB + (k_blk * BlkLen + k) * MlasQ4Int8AmxTileN, MlasQ4Int8AmxTileN * 4);
+            tile_dpbsud(TMM0, TMM1, TMM2);
+        }
+        tile_stored(TMM0, Tile, MlasQ4Int8AmxTileN * sizeof(int32_t));
+        MlasAmxMemoryBarrier();
+
+        const __m512 scale_b = _mm512_load_ps(StripScale + k_blk * MlasQ4Int8AmxTileN);
+        for (size_t m = 0; m < MlasQ4Int8AmxTileM; ++m) {
+            if (m < CountM) {
+                const __m512 scale = _mm512_mul_ps(scale_b, _mm512_set1_ps(QuantAScale[m * BlockCountK + k_blk]));
+                const __m512 dot = _mm512_cvtepi32_ps(_mm512_load_si512(Tile[m]));
+                acc[m] = _mm512_fmadd_ps(dot, scale, acc[m]);
+            }
+        }
+    }
+
+    const __mmask16 mask = __mmask16((1u << StripN) - 1);
+    const __m512 bias = (Bias == nullptr) ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(mask, Bias);
+    for (size_t m = 0; m < MlasQ4Int8AmxTileM; ++m) {
+        if (m < CountM) {
+            _mm512_mask_storeu_ps(C + m * ldc, mask, _mm512_add_ps(acc[m], bias));
+        }
+    }
+}
+
+/**
+ * @brief Multiplies the block quantized 8-bit A with the block quantized 4-bit B,
+ *        writing C = A * B + Bias without the zero point term of B.
+ *        See SQ4BitGemmKernel_BlkSum_CompInt8 for the parameters.
+ */
+static void
+MlasQ4Int8GemmKernelAmx(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias,
+    size_t ldc
+)
+{
+    const size_t TileK = std::min(BlkLen, MlasQ4Int8AmxTileK);
+    const size_t lda = BlockCountK * BlkLen;
+
+    const size_t StripBytes = UpAlignSize(BlockCountK * BlkLen * MlasQ4Int8AmxTileN);
+    const size_t StripScaleBytes = UpAlignSize(BlockCountK * MlasQ4Int8AmxTileN * sizeof(float));
+    MlasThreadedBufAlloc(StripBytes + StripScaleBytes);
+    uint8_t* StripB = ThreadedBufHolder.get();
+    float* StripScale = reinterpret_cast<float*>(StripB + StripBytes);
+
+    for (size_t n = 0; n < CountN; n += MlasQ4Int8AmxTileN) {
+        const size_t StripN = std::min(CountN - n, MlasQ4Int8AmxTileN);
+        MlasQ4Int8AmxUnpackStripB(
+            QuantBData, QuantBScale, CountN, n, StripN, BlockCountK, BlkLen, StripB, StripScale
+        );
+        MlasAmxMemoryBarrier();
+
+        MlasQ4Int8AmxLoadTileConfig(MlasQ4Int8AmxTileM, TileK);
+
+        for (size_t m = 0; m < CountM; m += MlasQ4Int8AmxTileM) {
+            const size_t TileM = std::min(CountM - m, MlasQ4Int8AmxTileM);
+            if (TileM < MlasQ4Int8AmxTileM) {
+                MlasQ4Int8AmxLoadTileConfig(TileM, TileK);
+            }
+
+            MlasQ4Int8AmxKernelTile(
+                BlkLen, TileK, QuantA + m * lda, lda, QuantAScale + m * BlockCountK, StripB, StripScale,
+                C + m * ldc + n, ldc, TileM, StripN, BlockCountK, Bias == nullptr ? nullptr : Bias + n
+            );
+        }
+    }
+}
@@ -23,10 +23,12 @@ Abstract:
 #include "sqnbitgemm_kernel_avx_common.h"
 #include "sqnbitgemm_kernel_avx_common_fp32.h"
 #include "sqnbitgemm_kernel_avx_common_int8.h"
+#include "sqnbitgemm_kernel_avx_common_lowbit.h"
 #include "sqnbitgemm_kernel_avx512_int8_blklen16.h"
 #include "sqnbitgemm_kernel_avx512_int8_blklen32.h"
 #include "sqnbitgemm_kernel_avx512_int8_blklen64.h"
 #include "sqnbitgemm_kernel_avx512_int8_blklen128.h"
+#include "sqnbitgemm_kernel_amx_int8.h"
 
 MLAS_FORCEINLINE void
 SQ4BitGemmM1Kernel_CompFp32(
@@ -299,6 +301,54 @@ SQ4BitGemmKernel_BlkSum_CompInt8_avx512vnni(
     return CountM;
 }
 
+MLAS_FORCEINLINE
+size_t
+SQ4BitGemmKernel_BlkSum_CompInt8_amx(
+    const size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias,
+    size_t ldc,
+    const float* ABlockSum,
+    const float* QuantBBlkSum
+)
+{
+    if (CountM < MlasQ4Int8AmxMinimumM) {
+        return SQ4BitGemmKernel_BlkSum_CompInt8_avx512vnni(
+            BlkLen, QuantA, QuantAScale, QuantBData, QuantBScale, QuantBZeroPoint, C, CountM, CountN, CountK,
+            BlockCountK, Bias, ldc, ABlockSum, QuantBBlkSum
+        );
+    }
+
+    MlasQ4Int8GemmKernelAmx(
+        BlkLen, QuantA, QuantAScale, QuantBData, QuantBScale, C, CountM, CountN, BlockCountK, Bias, ldc
+    );
+
+    float* c_blk = C;
+    const float* b_blk_sum = QuantBBlkSum;
+
+    size_t RowsRemaining = CountM;
+    const float* a_blksum_row = ABlockSum;
+    while (RowsRemaining > 0) {
+        auto RowsHandled = GetMlasPlatform().GemmFloatKernel(
+            a_blksum_row, b_blk_sum, c_blk, BlockCountK, RowsRemaining, CountN, BlockCountK, ldc, 1.f, false
+        );
+
+        c_blk += ldc * RowsHandled;
+        a_blksum_row += BlockCountK * RowsHandled;
+        RowsRemaining -= RowsHandled;
+    }
+    return CountM;
+}
+
 void MLASCALL
 QuantizeARow_CompInt8_avx512(
     size_t BlkLen,
@@ -350,8 +400,37 @@ const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512vnni = []() {
     d.SQ4BitGemmM1Kernel_CompFp32 = SQ4BitGemmM1Kernel_CompFp32;
     d.Q4BitBlkDequantBForSgemm_CompFp32 = Q4BitBlkDequantBForSgemm_CompFp32_avx2;
 
+    d.SQLowBitGemmM1Kernel_CompFp32 = SQLowBitGemmM1Kernel_CompFp32_avx2;
+    d.QLowBitBlkDequantBForSgemm_CompFp32 = QLowBitBlkDequantBForSgemm_CompFp32_avx2;
+
     d.SQ4BitGemmKernel_BlkSum_CompInt8 = SQ4BitGemmKernel_BlkSum_CompInt8_avx512vnni;
     d.QuantizeARowComputeBlkSum_CompInt8 = QuantizeARow_CompInt8_avx512;
 
     return d;
 }();
+
+//
+// Kernel dispatch structure definition for AMX-INT8, which uses the same
+// packed B as AVX512VNNI and falls back to its kernels for few rows of A.
+//
+const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAmx = []() {
+    MLAS_SQNBIT_GEMM_DISPATCH d;
+
+    d.SQ4BitGemmPackQuantBDataSize = SQ4BitGemmPackQuantBDataSize;
+    d.SQ4BitGemmPackQuantBData = SQ4BitGemmPackQuantBData;
+    d.SQ4BitGemmPackQuantBDataAndBlkSum = SQ4BitGemmPackQuantBDataAndBlkSum512vnni;
+
+    d.SQ4BitGemmPerGemmWorkspaceSize = SQ4BitGemmPerGemmWorkspaceSize;
+    d.SQ4BitGemmPerGemmWorkspaceAlignment = SQ4BitGemmPerGemmWorkspaceAlignment;
+
+    d.SQ4BitGemmM1Kernel_CompFp32 = SQ4BitGemmM1Kernel_CompFp32;
+    d.Q4BitBlkDequantBForSgemm_CompFp32 = Q4BitBlkDequantBForSgemm_CompFp32_avx2;
+
+    d.SQLowBitGemmM1Kernel_CompFp32 = SQLowBitGemmM1Kernel_CompFp32_avx2;
+    d.QLowBitBlkDequantBForSgemm_CompFp32 = QLowBitBlkDequantBForSgemm_CompFp32_avx2;
+
+    d.SQ4BitGemmKernel_BlkSum_CompInt8 = SQ4BitGemmKernel_BlkSum_CompInt8_amx;
+    d.QuantizeARowComputeBlkSum_CompInt8 = QuantizeARow_CompInt8_avx512;
+
+    return d;
+}();
@@ -0,0 +1,277 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_avx_common_lowbit.h
+
+Abstract:
+
+    This module implements the SQNBitGemm CompFp32 kernels for 2-bit and 3-bit
+    quantized B with AVX2 intrinsics. They are shared by the AVX2 and AVX512
+    kernel dispatches.
+
+    B is used in its unpacked layout. Eight consecutive values of a block take
+    BlkBitWidth bytes and are unpacked together with variable shifts.
+
+--*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "sqnbitgemm.h"
+#include "sqnbitgemm_kernel_avx_common.h"
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE __m256i
+LoadLowBitValues8_avx2(const std::byte* Data)
+{
+    static_assert(BlkBitWidth == 2 || BlkBitWidth == 3, "only 2-bit and 3-bit values are supported");
+
+    // 8 values take BlkBitWidth bytes
+    uint32_t Bits = 0;
+    std::memcpy(&Bits, Data, BlkBitWidth);
+
+    const __m256i Shifts = _mm256_setr_epi32(
+        0 * BlkBitWidth, 1 * BlkBitWidth, 2 * BlkBitWidth, 3 * BlkBitWidth,
+        4 * BlkBitWidth, 5 * BlkBitWidth, 6 * BlkBitWidth, 7 * BlkBitWidth
+    );
+    const __m256i Mask = _mm256_set1_epi32((1 << BlkBitWidth) - 1);
+    return _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int32_t>(Bits)), Shifts), Mask);
+}
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE int32_t
+GetLowBitZeroPoint(const std::byte* QuantBZeroPointCol, size_t BlkIdx)
+{
+    return (QuantBZeroPointCol != nullptr)
+               ? MlasQNBitGetPackedValue<BlkBitWidth>(QuantBZeroPointCol, BlkIdx)
+               : (1 << (BlkBitWidth - 1));
+}
+
+MLAS_FORCEINLINE __m256
+LoadFloatN_avx2(const float* Data, size_t n)
+{
+    static const int32_t MaskBuffer[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+    const __m256i LoadMask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(MaskBuffer + 8 - n));
+    return _mm256_maskload_ps(Data, LoadMask);
+}
+
+template <size_t BlkBitWidth>
+void
+SQLowBitGemmM1KernelImpl_CompFp32_avx2(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t ZeroPointColStride = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    for (size_t n = 0; n < CountN; ++n) {
+        const std::byte* b_col = QuantBData + n * BlockCountK * BlkDataSize;
+        const float* scale_col = QuantBScale + n * BlockCountK;
+        const std::byte* zp_col = (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * ZeroPointColStride;
+
+        __m256 acc = _mm256_setzero_ps();
+
+        for (size_t k = 0, blk = 0; k < CountK; k += BlkLen, ++blk) {
+            const size_t KLen = std::min(CountK - k, BlkLen);
+            const __m256i zp = _mm256_set1_epi32(GetLowBitZeroPoint<BlkBitWidth>(zp_col, blk));
+            const std::byte* b_blk = b_col + blk * BlkDataSize;
+            const float* a_blk = A + k;
+
+            // sum of a * (b - zp) over the block, the scale is applied once per block
+            __m256 blk_acc0 = _mm256_setzero_ps();
+            __m256 blk_acc1 = _mm256_setzero_ps();
+
+            size_t kk = 0;
+            for (; kk + 16 <= KLen; kk += 16) {
+                const __m256i b0 = _mm256_sub_epi32(LoadLowBitValues8_avx2<BlkBitWidth>(b_blk), zp);
+                const __m256i b1 = _mm256_sub_epi32(LoadLowBitValues8_avx2<BlkBitWidth>(b_blk + BlkBitWidth), zp);
+                blk_acc0 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(b0), _mm256_loadu_ps(a_blk + kk), blk_acc0);
+                blk_acc1 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(b1), _mm256_loadu_ps(a_blk + kk + 8), blk_acc1);
+                b_blk += 2 * BlkBitWidth;
+            }
+
+            for (; kk < KLen; kk += 8) {
+                const __m256 a = (KLen - kk >= 8) ? _mm256_loadu_ps(a_blk + kk) : LoadFloatN_avx2(a_blk + kk, KLen - kk);
+                const __m256i b = _mm256_sub_epi32(LoadLowBitValues8_avx2<BlkBitWidth>(b_blk), zp);
+                blk_acc0 = _mm256_fmadd_ps(_mm256_cvtepi32_ps(b), a, blk_acc0);
+                b_blk += BlkBitWidth;
+            }
+
+            acc = _mm256_fmadd_ps(_mm256_add_ps(blk_acc0, blk_acc1), _mm256_set1_ps(scale_col[blk]), acc);
+        }
+
+        C[n] = hsum_float_8(acc) + ((Bias == nullptr) ? 0.0f : Bias[n]);
+    }
+}
+
+MLAS_FORCEINLINE void
+SQLowBitGemmM1Kernel_CompFp32_avx2(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    if (BlkBitWidth == 2) {
+        SQLowBitGemmM1KernelImpl_CompFp32_avx2<2>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    } else {
+        assert(BlkBitWidth == 3);
+        SQLowBitGemmM1KernelImpl_CompFp32_avx2<3>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    }
+}
+
+MLAS_FORCEINLINE void
+Transpose8x8_avx2(__m256 (&v)[8])
+{
+    const __m256 a0 = _mm256_unpacklo_ps(v[0], v[1]);
+    const __m256 a1 = _mm256_unpackhi_ps(v[0], v[1]);
+    const __m256 a2 = _mm256_unpacklo_ps(v[2], v[3]);
+    const __m256 a3 = _mm256_unpackhi_ps(v[2], v[3]);
+    const __m256 a4 = _mm256_unpacklo_ps(v[4], v[5]);
+    const __m256 a5 = _mm256_unpackhi_ps(v[4], v[5]);
+    const __m256 a6 = _mm256_unpacklo_ps(v[6], v[7]);
+    const __m256 a7 = _mm256_unpackhi_ps(v[6], v[7]);
+
+    const __m256 b0 = _mm256_shuffle_ps(a0, a2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 b1 = _mm256_shuffle_ps(a0, a2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 b2 = _mm256_shuffle_ps(a1, a3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 b3 = _mm256_shuffle_ps(a1, a3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 b4 = _mm256_shuffle_ps(a4, a6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 b5 = _mm256_shuffle_ps(a4, a6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 b6 = _mm256_shuffle_ps(a5, a7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 b7 = _mm256_shuffle_ps(a5, a7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    v[0] = _mm256_permute2f128_ps(b0, b4, 0x20);
+    v[1] = _mm256_permute2f128_ps(b1, b5, 0x20);
+    v[2] = _mm256_permute2f128_ps(b2, b6, 0x20);
+    v[3] = _mm256_permute2f128_ps(b3, b7, 0x20);
+    v[4] = _mm256_permute2f128_ps(b0, b4, 0x31);
+    v[5] = _mm256_permute2f128_ps(b1, b5, 0x31);
+    v[6] = _mm256_permute2f128_ps(b2, b6, 0x31);
+    v[7] = _mm256_permute2f128_ps(b3, b7, 0x31);
+}
+
+template <size_t BlkBitWidth>
+void
+QLowBitBlkDequantBForSgemmImpl_CompFp32_avx2(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+)
+{
+    constexpr size_t NCols8 = 8;                   // process NCols8 columns of QuantB at a time
+    constexpr size_t GemmFloatKernelWidth16 = 16;  // mlas GemmFloatKernel requires B with width 16
+
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t b_data_col_stride_in_bytes = BlockCountK * BlkDataSize;
+    const size_t zp_col_stride_in_bytes = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    for (size_t col = 0; col < CountN; col += NCols8) {
+        const size_t cols = std::min(NCols8, CountN - col);
+
+        // columns [col, col + 8) are one half of a tile of GemmFloatKernelWidth16 columns
+        float* dst_col = FpData + (col / GemmFloatKernelWidth16) * CountK * GemmFloatKernelWidth16 +
+                         (col % GemmFloatKernelWidth16);
+
+        for (size_t k = 0, blk = 0; k < CountK; k += BlkLen, ++blk) {
+            const size_t KLen = std::min(CountK - k, BlkLen);
+
+            __m256i zp_8_epi32[NCols8];
+            __m256 scale_8_ps[NCols8];
+            UnrolledLoop<NCols8>([&](size_t col_) {
+                if (col_ < cols) {
+                    const std::byte* zp_col =
+                        (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + (col + col_) * zp_col_stride_in_bytes;
+                    zp_8_epi32[col_] = _mm256_set1_epi32(GetLowBitZeroPoint<BlkBitWidth>(zp_col, blk));
+                    scale_8_ps[col_] = _mm256_set1_ps(QuantBScale[(col + col_) * BlockCountK + blk]);
+                } else {
+                    zp_8_epi32[col_] = _mm256_setzero_si256();
+                    scale_8_ps[col_] = _mm256_setzero_ps();
+                }
+            });
+
+            const std::byte* b_blk = QuantBData + col * b_data_col_stride_in_bytes + blk * BlkDataSize;
+
+            for (size_t kk = 0; kk < KLen; kk += 8) {
+                __m256 weight_8_ps[NCols8];
+                UnrolledLoop<NCols8>([&](size_t col_) {
+                    if (col_ < cols) {
+                        const __m256i b = LoadLowBitValues8_avx2<BlkBitWidth>(
+                            b_blk + col_ * b_data_col_stride_in_bytes + (kk / 8) * BlkBitWidth
+                        );
+                        weight_8_ps[col_] = _mm256_mul_ps(
+                            _mm256_cvtepi32_ps(_mm256_sub_epi32(b, zp_8_epi32[col_])), scale_8_ps[col_]
+                        );
+                    } else {
+                        weight_8_ps[col_] = _mm256_setzero_ps();
+                    }
+                });
+
+                // weight_8_ps[i] becomes row k + kk + i of the 8 columns
+                Transpose8x8_avx2(weight_8_ps);
+
+                const size_t rows = std::min(size_t{8}, KLen - kk);
+                for (size_t i = 0; i < rows; ++i) {
+                    _mm256_storeu_ps(dst_col + (k + kk + i) * GemmFloatKernelWidth16, weight_8_ps[i]);
+                }
+            }
+        }
+    }
+}
+
+MLAS_FORCEINLINE void
+QLowBitBlkDequantBForSgemm_CompFp32_avx2(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+)
+{
+    if (BlkBitWidth == 2) {
+        QLowBitBlkDequantBForSgemmImpl_CompFp32_avx2<2>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockCountK
+        );
+    } else {
+        assert(BlkBitWidth == 3);
+        QLowBitBlkDequantBForSgemmImpl_CompFp32_avx2<3>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockCountK
+        );
+    }
+}
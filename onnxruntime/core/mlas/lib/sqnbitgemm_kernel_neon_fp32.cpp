@@ -19,7 +19,9 @@ Abstract:
 
 #include <arm_neon.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 #include "sqnbitgemm.h"
 #include "sqnbitgemm_kernel_neon.h"
@@ -644,4 +646,227 @@ Q4BitBlkDequantBForSgemm_CompFp32(
     }
 }
 
+namespace
+{
+
+//
+// CompFp32 kernel implementation for 2-bit and 3-bit B.
+// B is used in its unpacked layout. Eight consecutive values of a block take BlkBitWidth bytes.
+//
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE void
+LoadLowBitValues8(const std::byte* Data, int32x4_t& Values0, int32x4_t& Values1)
+{
+    static_assert(BlkBitWidth == 2 || BlkBitWidth == 3, "only 2-bit and 3-bit values are supported");
+
+    uint32_t Bits = 0;
+    std::memcpy(&Bits, Data, BlkBitWidth);
+
+    // negative shift counts shift right
+    static constexpr int32_t Shifts[8] = {
+        0, -1 * int32_t{BlkBitWidth}, -2 * int32_t{BlkBitWidth}, -3 * int32_t{BlkBitWidth},
+        -4 * int32_t{BlkBitWidth}, -5 * int32_t{BlkBitWidth}, -6 * int32_t{BlkBitWidth}, -7 * int32_t{BlkBitWidth},
+    };
+
+    const uint32x4_t BitsV = vdupq_n_u32(Bits);
+    const uint32x4_t Mask = vdupq_n_u32((1u << BlkBitWidth) - 1);
+    Values0 = vreinterpretq_s32_u32(vandq_u32(vshlq_u32(BitsV, vld1q_s32(&Shifts[0])), Mask));
+    Values1 = vreinterpretq_s32_u32(vandq_u32(vshlq_u32(BitsV, vld1q_s32(&Shifts[4])), Mask));
+}
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE int32_t
+GetLowBitZeroPoint(const std::byte* QuantBZeroPointCol, size_t BlkIdx)
+{
+    return (QuantBZeroPointCol != nullptr)
+               ? MlasQNBitGetPackedValue<BlkBitWidth>(QuantBZeroPointCol, BlkIdx)
+               : (1 << (BlkBitWidth - 1));
+}
+
+template <size_t BlkBitWidth>
+void
+SQLowBitGemmM1Kernel_CompFp32_Impl(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    for (size_t n = 0; n < CountN; ++n) {
+        const std::byte* QuantBDataCol = QuantBData + n * BlockCountK * BlkDataSize;
+        const float* QuantBScaleCol = QuantBScale + n * BlockCountK;
+        const std::byte* QuantBZeroPointCol =
+            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * StrideQuantBZeroPoint;
+
+        float32x4_t acc = vdupq_n_f32(0.0f);
+
+        for (size_t k = 0, k_blk_idx = 0; k < CountK; k += BlkLen, ++k_blk_idx) {
+            const size_t k_blk_len = std::min(CountK - k, BlkLen);
+            const int32x4_t zp = vdupq_n_s32(GetLowBitZeroPoint<BlkBitWidth>(QuantBZeroPointCol, k_blk_idx));
+            const std::byte* QuantBDataBlk = QuantBDataCol + k_blk_idx * BlkDataSize;
+
+            // sum of a * (b - zp) over the block, the scale is applied once per block
+            float32x4_t blk_acc0 = vdupq_n_f32(0.0f);
+            float32x4_t blk_acc1 = vdupq_n_f32(0.0f);
+
+            for (size_t kk = 0; kk < k_blk_len; kk += 8) {
+                float32x4_t av[2]{};
+                LoadFloatData<8>(A + k + kk, std::min(k_blk_len - kk, size_t{8}), av);
+
+                int32x4_t bv0, bv1;
+                LoadLowBitValues8<BlkBitWidth>(QuantBDataBlk, bv0, bv1);
+
+                blk_acc0 = vfmaq_f32(blk_acc0, vcvtq_f32_s32(vsubq_s32(bv0, zp)), av[0]);
+                blk_acc1 = vfmaq_f32(blk_acc1, vcvtq_f32_s32(vsubq_s32(bv1, zp)), av[1]);
+
+                QuantBDataBlk += BlkBitWidth;
+            }
+
+            acc = vfmaq_f32(acc, vaddq_f32(blk_acc0, blk_acc1), vdupq_n_f32(QuantBScaleCol[k_blk_idx]));
+        }
+
+        C[n] = vaddvq_f32(acc) + ((Bias == nullptr) ? 0.0f : Bias[n]);
+    }
+}
+
+template <size_t BlkBitWidth>
+void
+QLowBitBlkDequantBForSgemm_CompFp32_Impl(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+)
+{
+    constexpr size_t NCols = 4;
+
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBData = BlockCountK * BlkDataSize;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    //
+    // Proceed down 16 column-wide regions of B. Dequantize 8 x NCols elements at a time and write them as rows.
+    // Columns beyond CountN are written as zeros.
+    //
+
+    for (size_t n = 0; n < CountN; n += 16) {
+        float* Dst = FpData + n * CountK;
+
+        for (size_t k = 0, k_blk_idx = 0; k < CountK; k += BlkLen, ++k_blk_idx) {
+            const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+            for (size_t nn = 0; nn < 16; nn += NCols) {
+                int32x4_t zp[NCols];
+                float32x4_t scale[NCols];
+                const std::byte* QuantBDataBlk[NCols];
+                UnrolledLoop<NCols>([&](size_t i) {
+                    const size_t col = n + nn + i;
+                    if (col < CountN) {
+                        const std::byte* QuantBZeroPointCol =
+                            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + col * StrideQuantBZeroPoint;
+                        zp[i] = vdupq_n_s32(GetLowBitZeroPoint<BlkBitWidth>(QuantBZeroPointCol, k_blk_idx));
+                        scale[i] = vdupq_n_f32(QuantBScale[col * BlockCountK + k_blk_idx]);
+                        QuantBDataBlk[i] = QuantBData + col * StrideQuantBData + k_blk_idx * BlkDataSize;
+                    } else {
+                        QuantBDataBlk[i] = nullptr;
+                    }
+                });
+
+                for (size_t kk = 0; kk < k_blk_len; kk += 8) {
+                    float32x4_t b0[NCols], b1[NCols];
+                    UnrolledLoop<NCols>([&](size_t i) {
+                        if (QuantBDataBlk[i] != nullptr) {
+                            int32x4_t bv0, bv1;
+                            LoadLowBitValues8<BlkBitWidth>(QuantBDataBlk[i] + (kk / 8) * BlkBitWidth, bv0, bv1);
+                            b0[i] = vmulq_f32(vcvtq_f32_s32(vsubq_s32(bv0, zp[i])), scale[i]);
+                            b1[i] = vmulq_f32(vcvtq_f32_s32(vsubq_s32(bv1, zp[i])), scale[i]);
+                        } else {
+                            b0[i] = vdupq_n_f32(0.0f);
+                            b1[i] = vdupq_n_f32(0.0f);
+                        }
+                    });
+
+                    // bN[i] become rows of the NCols columns
+                    Transpose4x4(b0[0], b0[1], b0[2], b0[3]);
+                    Transpose4x4(b1[0], b1[1], b1[2], b1[3]);
+
+                    const size_t rows = std::min(k_blk_len - kk, size_t{8});
+                    float* DstRow = Dst + (k + kk) * 16 + nn;
+                    for (size_t r = 0; r < rows; ++r) {
+                        vst1q_f32(DstRow + r * 16, (r < 4) ? b0[r] : b1[r - 4]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+void
+SQLowBitGemmM1Kernel_CompFp32(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    if (BlkBitWidth == 2) {
+        SQLowBitGemmM1Kernel_CompFp32_Impl<2>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    } else {
+        assert(BlkBitWidth == 3);
+        SQLowBitGemmM1Kernel_CompFp32_Impl<3>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    }
+}
+
+void
+QLowBitBlkDequantBForSgemm_CompFp32(
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+)
+{
+    if (BlkBitWidth == 2) {
+        QLowBitBlkDequantBForSgemm_CompFp32_Impl<2>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockCountK
+        );
+    } else {
+        assert(BlkBitWidth == 3);
+        QLowBitBlkDequantBForSgemm_CompFp32_Impl<3>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockCountK
+        );
+    }
+}
+
 }  // namespace sqnbitgemm_neon
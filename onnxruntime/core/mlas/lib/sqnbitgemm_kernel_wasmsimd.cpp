@@ -0,0 +1,408 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_wasmsimd.cpp
+
+Abstract:
+
+    This module implements the float/quantized n-bit integer matrix
+    multiplication kernels for WebAssembly SIMD128 specific to
+    input type T1 as float32 and
+    MLAS_SQNBIT_GEMM_COMPUTE_TYPE CompFp32.
+
+    B is used in its unpacked layout: the two 4-bit values of a byte are
+    consecutive values of a block, with the first one in the low nibble.
+
+--*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "sqnbitgemm.h"
+
+namespace sqnbitgemm_wasmsimd
+{
+
+namespace
+{
+
+constexpr size_t BlkBitWidth = 4;
+
+// Number of values of a block that are dequantized at a time.
+constexpr size_t SubBlkLen = 16;
+
+MLAS_FORCEINLINE float
+GetZeroPoint(const std::byte* QuantBZeroPointColPtr, size_t k_blk_idx)
+{
+    const std::byte zp_packed = QuantBZeroPointColPtr[k_blk_idx / 2];
+    const std::byte zp = ((k_blk_idx & 1) == 1) ? (zp_packed >> 4) : (zp_packed & std::byte{0x0F});
+    return static_cast<float>(std::to_integer<uint8_t>(zp));
+}
+
+// Dequantizes `SubBlkLen` consecutive values of a block of B.
+MLAS_FORCEINLINE void
+DequantB16(const std::byte* QuantBDataPtr, v128_t scale_v, v128_t zp_v, v128_t (&bv)[4])
+{
+    const v128_t bv_packed = wasm_v128_load64_zero(QuantBDataPtr);
+
+    const v128_t bv_lo = wasm_v128_and(bv_packed, wasm_i8x16_splat(0x0F));
+    const v128_t bv_hi = wasm_u8x16_shr(bv_packed, 4);
+
+    // interleave the nibbles to restore the order of the values
+    const v128_t bv_u8 = wasm_i8x16_shuffle(bv_lo, bv_hi, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+
+    const v128_t bv_u16_lo = wasm_u16x8_extend_low_u8x16(bv_u8);
+    const v128_t bv_u16_hi = wasm_u16x8_extend_high_u8x16(bv_u8);
+
+    bv[0] = wasm_f32x4_convert_i32x4(wasm_u32x4_extend_low_u16x8(bv_u16_lo));
+    bv[1] = wasm_f32x4_convert_i32x4(wasm_u32x4_extend_high_u16x8(bv_u16_lo));
+    bv[2] = wasm_f32x4_convert_i32x4(wasm_u32x4_extend_low_u16x8(bv_u16_hi));
+    bv[3] = wasm_f32x4_convert_i32x4(wasm_u32x4_extend_high_u16x8(bv_u16_hi));
+
+    for (size_t j = 0; j < 4; ++j) {
+        bv[j] = wasm_f32x4_mul(wasm_f32x4_sub(bv[j], zp_v), scale_v);
+    }
+}
+
+MLAS_FORCEINLINE void
+Transpose4x4(v128_t& a0, v128_t& a1, v128_t& a2, v128_t& a3)
+{
+    const v128_t b0 = wasm_i32x4_shuffle(a0, a1, 0, 4, 1, 5);  // a0_0 a1_0 a0_1 a1_1
+    const v128_t b1 = wasm_i32x4_shuffle(a0, a1, 2, 6, 3, 7);  // a0_2 a1_2 a0_3 a1_3
+    const v128_t b2 = wasm_i32x4_shuffle(a2, a3, 0, 4, 1, 5);  // a2_0 a3_0 a2_1 a3_1
+    const v128_t b3 = wasm_i32x4_shuffle(a2, a3, 2, 6, 3, 7);  // a2_2 a3_2 a2_3 a3_3
+
+    a0 = wasm_i32x4_shuffle(b0, b2, 0, 1, 4, 5);  // a0_0 a1_0 a2_0 a3_0
+    a1 = wasm_i32x4_shuffle(b0, b2, 2, 3, 6, 7);  // a0_1 a1_1 a2_1 a3_1
+    a2 = wasm_i32x4_shuffle(b1, b3, 0, 1, 4, 5);  // a0_2 a1_2 a2_2 a3_2
+    a3 = wasm_i32x4_shuffle(b1, b3, 2, 3, 6, 7);  // a0_3 a1_3 a2_3 a3_3
+}
+
+//
+// CompFp32 kernel implementation.
+//
+
+template <size_t NCols, bool HasZeroPoint>
+MLAS_FORCEINLINE void
+ComputeDotProducts_BlkBitWidth4_CompFp32(
+    size_t BlkLen,
+    const float* ARowPtr,
+    const std::byte* QuantBDataColPtr,
+    const float* QuantBScaleColPtr,
+    [[maybe_unused]] const std::byte* QuantBZeroPointColPtr,  // only used if HasZeroPoint is true
+    float* SumPtr,
+    size_t CountK,
+    size_t StrideQuantBData,
+    size_t StrideQuantBScale,
+    [[maybe_unused]] size_t StrideQuantBZeroPoint,  // only used if HasZeroPoint is true
+    const float* BiasPtr
+)
+{
+    v128_t acc[NCols];
+    for (size_t i = 0; i < NCols; ++i) {
+        acc[i] = wasm_f32x4_splat(0.0f);
+    }
+
+    for (size_t k = 0, k_blk_idx = 0; k < CountK; k += BlkLen, ++k_blk_idx) {
+        const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+        v128_t scale_v[NCols];
+        v128_t zp_v[NCols];
+        for (size_t i = 0; i < NCols; ++i) {
+            scale_v[i] = wasm_f32x4_splat(QuantBScaleColPtr[i * StrideQuantBScale + k_blk_idx]);
+
+            float zp = 8.0f;
+            if constexpr (HasZeroPoint) {
+                zp = GetZeroPoint(QuantBZeroPointColPtr + i * StrideQuantBZeroPoint, k_blk_idx);
+            }
+            zp_v[i] = wasm_f32x4_splat(zp);
+        }
+
+        for (size_t kk = 0; kk < k_blk_len; kk += SubBlkLen) {
+            const size_t kklen = std::min(k_blk_len - kk, SubBlkLen);
+
+            // load A, zero padding the values past the end of K
+            v128_t av[4];
+            if (kklen == SubBlkLen) {
+                for (size_t j = 0; j < 4; ++j) {
+                    av[j] = wasm_v128_load(ARowPtr + k + kk + j * 4);
+                }
+            } else {
+                float a_tail[SubBlkLen] = {};
+                std::memcpy(a_tail, ARowPtr + k + kk, kklen * sizeof(float));
+                for (size_t j = 0; j < 4; ++j) {
+                    av[j] = wasm_v128_load(a_tail + j * 4);
+                }
+            }
+
+            for (size_t i = 0; i < NCols; ++i) {
+                v128_t bv[4];
+                DequantB16(
+                    QuantBDataColPtr + i * StrideQuantBData + (k + kk) * BlkBitWidth / 8, scale_v[i], zp_v[i], bv
+                );
+
+                for (size_t j = 0; j < 4; ++j) {
+                    acc[i] = MlasMultiplyAddFloat32x4(av[j], bv[j], acc[i]);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < NCols; ++i) {
+        SumPtr[i] = MlasReduceAddFloat32x4(acc[i]);
+        if (BiasPtr != nullptr) {
+            SumPtr[i] += BiasPtr[i];
+        }
+    }
+}
+
+template <bool HasZeroPoint>
+void
+SQ4BitGemmM1Kernel_CompFp32_Impl(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    constexpr size_t NCols = 4;
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBScale = BlockCountK;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    const float* BiasPtr = Bias;
+
+    const std::byte* QuantBDataColPtr = QuantBData;
+    const float* QuantBScaleColPtr = QuantBScale;
+    const std::byte* QuantBZeroPointColPtr = QuantBZeroPoint;
+
+    float* SumPtr = C;
+
+    size_t n = 0;
+    for (; n + NCols <= CountN; n += NCols) {
+        ComputeDotProducts_BlkBitWidth4_CompFp32<NCols, HasZeroPoint>(
+            BlkLen,
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next `NCols` columns
+
+        QuantBDataColPtr += NCols * StrideQuantBData;
+        QuantBScaleColPtr += NCols * StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += NCols * StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? NCols : 0;
+        SumPtr += NCols;
+    }
+
+    // left over columns less than `NCols`
+    for (; n < CountN; ++n) {
+        ComputeDotProducts_BlkBitWidth4_CompFp32<1, HasZeroPoint>(
+            BlkLen,
+            A, QuantBDataColPtr, QuantBScaleColPtr, QuantBZeroPointColPtr, SumPtr, CountK,
+            StrideQuantBData, StrideQuantBScale, StrideQuantBZeroPoint,
+            BiasPtr
+        );
+
+        // move to next column
+
+        QuantBDataColPtr += StrideQuantBData;
+        QuantBScaleColPtr += StrideQuantBScale;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointColPtr += StrideQuantBZeroPoint;
+        }
+
+        BiasPtr += BiasPtr != nullptr ? 1 : 0;
+        SumPtr += 1;
+    }
+}
+
+void
+SQ4BitGemmM1Kernel_CompFp32(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    const float* Bias
+)
+{
+    assert(BlkLen >= SubBlkLen && BlkLen % SubBlkLen == 0);
+
+    if (QuantBZeroPoint != nullptr) {
+        SQ4BitGemmM1Kernel_CompFp32_Impl<true>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    } else {
+        SQ4BitGemmM1Kernel_CompFp32_Impl<false>(
+            BlkLen, A, QuantBData, QuantBScale, QuantBZeroPoint, C, CountN, CountK, BlockCountK, Bias
+        );
+    }
+}
+
+//
+// Dequantizes B into the 16 column wide panels, zero padded to 16 columns, that
+// MlasSgemmKernelZero takes as its packed B.
+//
+
+template <bool HasZeroPoint>
+void
+Q4BitBlkDequantBForSgemm_CompFp32_Impl(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+)
+{
+    float* Dst = FpData;
+
+    const std::byte* QuantBDataCol = QuantBData;
+    const float* QuantBScaleCol = QuantBScale;
+    [[maybe_unused]] const std::byte* QuantBZeroPointCol = QuantBZeroPoint;  // only used if HasZeroPoint is true
+
+    const size_t StrideQuantBData = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    [[maybe_unused]] const size_t StrideQuantBZeroPoint =  // only used if HasZeroPoint is true
+        MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    for (size_t n = 0; n < CountN; n += 16) {
+        const size_t nnlen = std::min(CountN - n, size_t{16});
+
+        for (size_t k = 0, k_blk_idx = 0; k < CountK; k += BlkLen, ++k_blk_idx) {
+            v128_t scale_v[16];
+            v128_t zp_v[16];
+            for (size_t nn = 0; nn < nnlen; ++nn) {
+                scale_v[nn] = wasm_f32x4_splat(QuantBScaleCol[nn * BlockCountK + k_blk_idx]);
+
+                float zp = 8.0f;
+                if constexpr (HasZeroPoint) {
+                    zp = GetZeroPoint(QuantBZeroPointCol + nn * StrideQuantBZeroPoint, k_blk_idx);
+                }
+                zp_v[nn] = wasm_f32x4_splat(zp);
+            }
+
+            const size_t k_blk_len = std::min(CountK - k, BlkLen);
+
+            for (size_t kk = 0; kk < k_blk_len; kk += SubBlkLen) {
+                const size_t kklen = std::min(k_blk_len - kk, SubBlkLen);
+                const size_t QuantBDataOffset = (k + kk) * BlkBitWidth / 8;
+
+                if (nnlen == 16 && kklen == SubBlkLen) {
+                    // dequantize and write, transposed, 16 x 4 values at a time
+                    for (size_t nn = 0; nn < 16; nn += 4) {
+                        v128_t bv[4][4];
+                        for (size_t i = 0; i < 4; ++i) {
+                            DequantB16(
+                                QuantBDataCol + (nn + i) * StrideQuantBData + QuantBDataOffset,
+                                scale_v[nn + i], zp_v[nn + i], bv[i]
+                            );
+                        }
+
+                        for (size_t j = 0; j < 4; ++j) {
+                            Transpose4x4(bv[0][j], bv[1][j], bv[2][j], bv[3][j]);
+
+                            for (size_t i = 0; i < 4; ++i) {
+                                wasm_v128_store(&Dst[(j * 4 + i) * 16 + nn], bv[i][j]);
+                            }
+                        }
+                    }
+                } else {
+                    // zero out the rows first to ensure the padding of the columns past the end of N
+                    std::fill_n(Dst, kklen * 16, 0.0f);
+
+                    for (size_t nn = 0; nn < nnlen; ++nn) {
+                        v128_t bv[4];
+                        DequantB16(
+                            QuantBDataCol + nn * StrideQuantBData + QuantBDataOffset, scale_v[nn], zp_v[nn], bv
+                        );
+
+                        float values[SubBlkLen];
+                        for (size_t j = 0; j < 4; ++j) {
+                            wasm_v128_store(values + j * 4, bv[j]);
+                        }
+
+                        for (size_t r = 0; r < kklen; ++r) {
+                            Dst[r * 16 + nn] = values[r];
+                        }
+                    }
+                }
+
+                Dst += 16 * kklen;
+            }
+        }
+
+        QuantBDataCol += 16 * StrideQuantBData;
+        QuantBScaleCol += 16 * BlockCountK;
+        if constexpr (HasZeroPoint) {
+            QuantBZeroPointCol += 16 * StrideQuantBZeroPoint;
+        }
+    }
+}
+
+void
+Q4BitBlkDequantBForSgemm_CompFp32(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+)
+{
+    assert(BlkLen >= SubBlkLen && BlkLen % SubBlkLen == 0);
+
+    if (QuantBZeroPoint != nullptr) {
+        Q4BitBlkDequantBForSgemm_CompFp32_Impl<true>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockCountK
+        );
+    } else {
+        Q4BitBlkDequantBForSgemm_CompFp32_Impl<false>(
+            BlkLen, FpData, QuantBData, QuantBScale, QuantBZeroPoint, CountN, CountK, BlockCountK
+        );
+    }
+}
+
+}  // namespace
+
+}  // namespace sqnbitgemm_wasmsimd
+
+//
+// Kernel dispatch structure definition.
+//
+// B is not packed, so the unpacked layout of the MatMulNBits initializer is used directly.
+//
+
+const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchWasmSimd = []() {
+    MLAS_SQNBIT_GEMM_DISPATCH d;
+
+    d.SQ4BitGemmM1Kernel_CompFp32 = sqnbitgemm_wasmsimd::SQ4BitGemmM1Kernel_CompFp32;
+    d.Q4BitBlkDequantBForSgemm_CompFp32 = sqnbitgemm_wasmsimd::Q4BitBlkDequantBForSgemm_CompFp32;
+
+    return d;
+}();
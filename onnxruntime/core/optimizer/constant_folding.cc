@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <fstream>
 #include <limits>
 
 #include "core/optimizer/constant_folding.h"
@@ -11,6 +13,10 @@
 #include "core/optimizer/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/common/parse_string.h"
+#include "core/common/narrow.h"
+#include "core/common/path_string.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 using namespace onnxruntime::common;
 
@@ -28,6 +34,51 @@ ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
       execution_provider_(execution_provider) {
 }
 
+// The data of a folded initializer in the external data file starts at a multiple of this, so it can be memory mapped.
+static constexpr int64_t kExternalDataAlignment = 4096;
+
+Status ConstantFolding::WriteToExternalDataFile(const std::filesystem::path& model_path, const std::string& location,
+                                                const Tensor& tensor,
+                                                ONNX_NAMESPACE::TensorProto& tensor_proto) const {
+  // resolved like the location of the external data when the session loads the initializer
+  std::filesystem::path file_path = ToPathString(location);
+  if (!model_path.empty()) {
+    file_path = model_path.parent_path() / file_path;
+  }
+
+  // the file is recreated by the first folded initializer of the session, as the data of an earlier session is stale
+  std::ofstream file(file_path, std::ios::binary | (external_data_file_created_ ? std::ios::app : std::ios::trunc));
+  ORT_RETURN_IF_NOT(file.is_open(), "Failed to open the constant folding external data file ", location);
+  external_data_file_created_ = true;
+
+  const int64_t offset =
+      (external_data_file_size_ + kExternalDataAlignment - 1) / kExternalDataAlignment * kExternalDataAlignment;
+  const std::vector<char> padding(narrow<size_t>(offset - external_data_file_size_));
+  file.write(padding.data(), padding.size());
+  file.write(static_cast<const char*>(tensor.DataRaw()), tensor.SizeInBytes());
+  file.close();
+  ORT_RETURN_IF_NOT(file.good(), "Failed to write to the constant folding external data file ", location);
+  external_data_file_size_ = offset + narrow<int64_t>(tensor.SizeInBytes());
+
+  // Note: like TensorToTensorProto this requires the data to be in little-endian format.
+  tensor_proto.set_data_type(tensor.GetElementType());
+  for (auto dim : tensor.Shape().GetDims()) {
+    tensor_proto.add_dims(dim);
+  }
+
+  tensor_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+  auto* entry = tensor_proto.mutable_external_data()->Add();
+  entry->set_key("location");
+  entry->set_value(location);
+  entry = tensor_proto.mutable_external_data()->Add();
+  entry->set_key("offset");
+  entry->set_value(std::to_string(offset));
+  entry = tensor_proto.mutable_external_data()->Add();
+  entry->set_key("length");
+  entry->set_value(std::to_string(tensor.SizeInBytes()));
+  return Status::OK();
+}
+
 // We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
 // Shape to be able to be constant folded.
 static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
@@ -132,6 +183,26 @@ static Status ConstantFoldIfNode(Graph& graph, Node& if_node, const logging::Log
 }
 
 Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  size_t memory_budget = 0;
+  const std::string memory_budget_config =
+      config_options_.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingMemoryBudget, "0");
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(memory_budget_config, memory_budget),
+                    "Invalid value for ", kOrtSessionOptionsConstantFoldingMemoryBudget, ": ", memory_budget_config);
+
+  const std::string external_data_file =
+      config_options_.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingExternalDataFile, "");
+  size_t external_data_min_size = 0;
+  const std::string external_data_min_size_config =
+      config_options_.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingExternalDataMinSizeInBytes, "1024");
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(external_data_min_size_config, external_data_min_size),
+                    "Invalid value for ", kOrtSessionOptionsConstantFoldingExternalDataMinSizeInBytes, ": ",
+                    external_data_min_size_config);
+
+  const auto write_to_external_data_file = [&](const Tensor& tensor) {
+    return !external_data_file.empty() && !tensor.IsDataTypeString() &&
+           tensor.SizeInBytes() >= std::max<size_t>(external_data_min_size, 1);
+  };
+
   bool have_updated_nodes = false;
   GraphViewer graph_viewer(graph);
   auto& order = graph_viewer.GetNodesInTopologicalOrder();
@@ -159,6 +230,8 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     }
 
     bool converted_to_constant = false;
+    // the initializers consumed by a folded node, which are removed once no other node uses them
+    InlinedVector<std::string> folded_inputs;
     if (node->OpType().compare("If") == 0) {
       // This process constant folds the If node only,
       // but inlines the nodes of the corresponding branch graph.
@@ -301,13 +374,38 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         }
       }
 
+      if (converted_to_constant && memory_budget != 0) {
+        size_t bytes_in_memory = 0;
+        for (const OrtValue& ort_value : fetches) {
+          const Tensor& out_tensor = ort_value.Get<Tensor>();
+          if (!write_to_external_data_file(out_tensor)) {
+            bytes_in_memory += out_tensor.SizeInBytes();
+          }
+        }
+
+        if (folded_bytes_in_memory_ + bytes_in_memory > memory_budget) {
+          LOGS(logger, INFO) << "Constant folding memory budget of " << memory_budget << " bytes exceeded. Can't "
+                             << "constant fold " << node->OpType() << " node '" << node->Name() << "'";
+          converted_to_constant = false;
+        } else {
+          folded_bytes_in_memory_ += bytes_in_memory;
+        }
+      }
+
       if (converted_to_constant) {
         for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
           OrtValue& ort_value = fetches[fetch_idx];
           // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
           auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
           const Tensor& out_tensor = ort_value.Get<Tensor>();
-          ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
+          ONNX_NAMESPACE::TensorProto out_tensorproto;
+          if (write_to_external_data_file(out_tensor)) {
+            out_tensorproto.set_name(constant_arg_out->Name());
+            ORT_RETURN_IF_ERROR(WriteToExternalDataFile(graph.ModelPath(), external_data_file, out_tensor,
+                                                        out_tensorproto));
+          } else {
+            out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
+          }
 
           ONNX_NAMESPACE::TensorShapeProto result_shape;
           for (auto& dim : out_tensor.Shape().GetDims()) {
@@ -317,6 +415,10 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
           constant_arg_out->SetShape(result_shape);
           graph.AddInitializedTensor(out_tensorproto);
         }
+
+        for (const auto& constant_input : constant_inputs) {
+          folded_inputs.push_back(constant_input.first);
+        }
       }
     }
 
@@ -337,6 +439,17 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       graph.RemoveNode(node->Index());
       modified = true;
       have_updated_nodes = true;
+
+      // Release the consumed initializers now rather than when the graph is resolved after this pass, so the
+      // original and the folded weights of the model are not all in memory at the same time.
+      for (const auto& name : folded_inputs) {
+        const NodeArg* input = graph.GetNodeArg(name);
+        if (input != nullptr && graph.GetConsumerNodes(name).empty() && !graph.IsOutput(input) &&
+            excluded_initializers_.find(name) == excluded_initializers_.end() &&
+            graph.GetConstantInitializer(name, /*check_outer_scope*/ false) != nullptr) {
+          graph.RemoveInitializedTensor(name);
+        }
+      }
     }
   }
 
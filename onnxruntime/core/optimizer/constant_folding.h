@@ -5,6 +5,7 @@
 
 #include "core/optimizer/graph_transformer.h"
 #include "core/framework/ort_value.h"
+#include <filesystem>
 #include <memory>
 #include "core/framework/execution_provider.h"
 
@@ -15,6 +16,10 @@ namespace onnxruntime {
 
 Transformer that traverses the graph top-down and performs constant folding, i.e.,
 it statically computes parts of the graph that rely only on constant initializers.
+
+The initializers that a folded node consumed are removed as soon as nothing else uses them, and the folded
+initializers can be limited by a memory budget or written to an external data file, see
+kOrtSessionOptionsConstantFoldingMemoryBudget and kOrtSessionOptionsConstantFoldingExternalDataFile.
 */
 class ConstantFolding : public GraphTransformer {
  public:
@@ -31,10 +36,18 @@ class ConstantFolding : public GraphTransformer {
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
+  Status WriteToExternalDataFile(const std::filesystem::path& model_path, const std::string& location,
+                                 const Tensor& tensor, ONNX_NAMESPACE::TensorProto& tensor_proto) const;
+
   bool skip_dequantize_linear_;
   const ConfigOptions& config_options_;
   const InlinedHashSet<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
+
+  // state of the session kept across the runs of the transformer
+  mutable size_t folded_bytes_in_memory_{0};
+  mutable bool external_data_file_created_{false};
+  mutable int64_t external_data_file_size_{0};
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,208 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsSupportedBinaryOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14});
+}
+
+bool IsSupportedUnaryOp(const Node& node) {
+  static const std::array<std::string_view, 10> ops_v6_13 = {"Abs", "Neg", "Floor", "Ceil", "Reciprocal",
+                                                             "Sqrt", "Exp", "Log", "Sigmoid", "Tanh"};
+  for (const auto& op : ops_v6_13) {
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, op, {6, 13})) {
+      return true;
+    }
+  }
+
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14});
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Whether the shapes of the two values are known to be equal. Symbolic dims must have the same name.
+bool HaveSameShape(const NodeArg& arg, const NodeArg& other) {
+  const auto* shape = arg.Shape();
+  const auto* other_shape = other.Shape();
+  if (shape == nullptr || other_shape == nullptr || shape->dim_size() != other_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < shape->dim_size(); ++i) {
+    const auto& dim = shape->dim(i);
+    const auto& other_dim = other_shape->dim(i);
+    if (dim.has_dim_value() && other_dim.has_dim_value()) {
+      if (dim.dim_value() != other_dim.dim_value()) {
+        return false;
+      }
+    } else if (!dim.has_dim_param() || !other_dim.has_dim_param() || dim.dim_param().empty() ||
+               dim.dim_param() != other_dim.dim_param()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+struct ElementwiseChain {
+  InlinedVector<std::reference_wrapper<Node>> nodes;
+  // X followed by the tensor operands
+  InlinedVector<NodeArg*> inputs;
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  std::vector<float> scalars;
+  std::vector<int64_t> operand_first;
+};
+
+// Append node, which consumes value, to the chain. Returns false if node can not be part of the chain.
+bool AddStep(const Graph& graph, Node& node, const NodeArg& value, ElementwiseChain& chain) {
+  const auto& input_defs = node.MutableInputDefs();
+  if (IsSupportedUnaryOp(node)) {
+    if (input_defs[0]->Name() != value.Name()) {
+      return false;
+    }
+
+    chain.ops.push_back(node.OpType());
+    chain.operands.push_back(-1);
+    chain.scalars.push_back(0.0f);
+    chain.operand_first.push_back(0);
+    return true;
+  }
+
+  if (!IsSupportedBinaryOp(node)) {
+    return false;
+  }
+
+  const int value_index = input_defs[0]->Name() == value.Name() ? 0 : (input_defs[1]->Name() == value.Name() ? 1 : -1);
+  if (value_index == -1) {
+    return false;
+  }
+
+  NodeArg* other = input_defs[1 - value_index];
+  const NodeArg& x = *chain.inputs[0];
+  int64_t operand = -1;
+  float scalar = 0.0f;
+  if (other->Name() == x.Name()) {
+    operand = 0;
+  } else if (other->Name() == value.Name() || !IsFloatTensor(*other)) {
+    return false;
+  } else if (optimizer_utils::IsScalar(*other) && graph_utils::IsConstantInitializer(graph, other->Name())) {
+    // a scalar of shape [1] would broadcast a rank 0 chain to rank 1
+    if (other->Shape()->dim_size() != 0 && (x.Shape() == nullptr || x.Shape()->dim_size() == 0)) {
+      return false;
+    }
+
+    if (!optimizer_utils::GetScalarInitializerValue<float>(graph, *other, scalar, true)) {
+      return false;
+    }
+  } else if (HaveSameShape(x, *other)) {
+    auto it = std::find(chain.inputs.begin(), chain.inputs.end(), other);
+    operand = static_cast<int64_t>(it - chain.inputs.begin());
+    if (it == chain.inputs.end()) {
+      chain.inputs.push_back(other);
+    }
+  } else {
+    return false;
+  }
+
+  chain.ops.push_back(node.OpType());
+  chain.operands.push_back(operand);
+  chain.scalars.push_back(scalar);
+  chain.operand_first.push_back(value_index == 1 ? 1 : 0);
+  return true;
+}
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // the chain input is the first input, unless the node is a binary op with a scalar constant there
+    const bool is_binary = IsSupportedBinaryOp(node);
+    if (!is_binary && !IsSupportedUnaryOp(node)) {
+      continue;
+    }
+
+    NodeArg* x = node.MutableInputDefs()[0];
+    if (is_binary && optimizer_utils::IsScalar(*x) && graph_utils::IsConstantInitializer(graph, x->Name())) {
+      x = node.MutableInputDefs()[1];
+    }
+
+    if (!IsFloatTensor(*x)) {
+      continue;
+    }
+
+    ElementwiseChain chain;
+    chain.inputs.push_back(x);
+    if (!AddStep(graph, node, *x, chain)) {
+      continue;
+    }
+    chain.nodes.emplace_back(node);
+
+    Node* last_node = &node;
+    while (last_node->GetOutputEdgesCount() == 1 && !graph.NodeProducesGraphOutput(*last_node)) {
+      Node& next_node = *graph.GetNode(last_node->OutputNodesBegin()->Index());
+      if (next_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          !AddStep(graph, next_node, *last_node->OutputDefs()[0], chain)) {
+        break;
+      }
+
+      chain.nodes.emplace_back(next_node);
+      last_node = &next_node;
+    }
+
+    if (chain.nodes.size() < 2) {
+      continue;
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(last_node->Name() + "/ElementwiseFusion/"),
+                                     "FusedElementwise", "fused elementwise ops", chain.inputs,
+                                     std::array{last_node->MutableOutputDefs()[0]}, nullptr, kMSDomain);
+    fused_node.AddAttribute("ops", chain.ops);
+    fused_node.AddAttribute("operands", chain.operands);
+    fused_node.AddAttribute("scalars", chain.scalars);
+    fused_node.AddAttribute("operand_first", chain.operand_first);
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+    graph_utils::FinalizeNodeFusion(graph, chain.nodes, fused_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite chains of float elementwise ops into a single FusedElementwise node, which evaluates the whole chain
+ * tile by tile without writing out the intermediate tensors.
+ *
+ * A chain is extended while the value produced by the last node has a single consumer, which must be a supported
+ * unary op or a binary op whose other operand is a scalar constant or a tensor with the shape of the chain input.
+ */
+class ElementwiseFusion : public GraphTransformer {
+ public:
+  ElementwiseFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+
+#include <limits>
+
+#include "core/common/profiler.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -26,15 +30,46 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  // The graph gets a new version every time a transformer modifies it. A transformer that left a version of the graph
+  // unmodified would leave it unmodified again, so it is only applied again once another transformer changed the
+  // graph. In the last step this skips all transformers after the last one that modified the graph.
+  constexpr size_t kNotApplied = std::numeric_limits<size_t>::max();
+  InlinedVector<size_t> unmodified_graph_version(transformers->second.size(), kNotApplied);
+  size_t graph_version = 0;
+
   for (unsigned step = 0; step < steps_; ++step) {
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
+    for (size_t i = 0; i < transformers->second.size(); ++i) {
+      const auto& transformer = transformers->second[i];
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      if (unmodified_graph_version[i] == graph_version) {
+        continue;
+      }
+
+      const bool profiling_enabled = profiler_ != nullptr && profiler_->IsEnabled();
+      TimePoint start_time;
+      if (profiling_enabled) {
+        start_time = profiler_->Start();
+      }
+
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
-      graph_changed = graph_changed || modified;
+
+      if (profiling_enabled) {
+        profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_transform_" + transformer->Name(),
+                                         start_time,
+                                         {{"level", std::to_string(static_cast<int>(level))},
+                                          {"step", std::to_string(step)},
+                                          {"modified", modified ? "1" : "0"}});
+      }
+      if (modified) {
+        ++graph_version;
+        graph_changed = true;
+      } else {
+        unmodified_graph_version[i] = graph_version;
+      }
     }
     if (!graph_changed) {
       break;
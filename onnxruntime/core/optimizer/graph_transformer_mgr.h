@@ -11,6 +11,10 @@
 
 namespace onnxruntime {
 
+namespace profiling {
+class Profiler;
+}
+
 // Manages a list of graph transformers. It is initialized with a list of graph
 // transformers. Each inference session can further register additional ones.
 class GraphTransformerManager {
@@ -30,12 +34,19 @@ class GraphTransformerManager {
   // Apply all transformers registered for the given level on the given graph
   common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const;
 
+  // Record the time spent in each transformer while the profiler is enabled.
+  void SetProfiler(profiling::Profiler* profiler) {
+    profiler_ = profiler;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
 
   // maximum number of graph transformation steps
   unsigned steps_;
 
+  profiling::Profiler* profiler_{nullptr};
+
   InlinedHashMap<TransformerLevel, InlinedVector<std::unique_ptr<GraphTransformer>>> level_to_transformer_map_;
   InlinedHashMap<std::string, GraphTransformer*> transformers_info_;
 };
@@ -9,6 +9,7 @@
 
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/matmul_nbits_fusion.h"
+#include "core/optimizer/matmul_nbits_sibling_fusion.h"
 #include "core/optimizer/nhwc_transformer.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selector_action_transformer.h"
@@ -35,6 +36,7 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
@@ -49,12 +51,15 @@
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/label_encoder_fusion.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_invariant_hoisting.h"
 #include "core/optimizer/matmul_activation_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
+#include "core/optimizer/matmul_bias_activation_fusion.h"
 #include "core/optimizer/matmul_bn_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/multihead_attention_fusion.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
@@ -65,6 +70,7 @@
 #endif
 #include "core/optimizer/qdq_transformer/clip_quantizelinear.h"
 #include "core/optimizer/qdq_transformer/ensure_unique_dq_for_node_unit.h"
+#include "core/optimizer/qdq_transformer/qdq_float8_gemm_fusion.h"
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/qdq_s8_to_u8.h"
 #include "core/optimizer/qdq_transformer/relu_quantizelinear.h"
@@ -75,9 +81,11 @@
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_transformer.h"
 #include "core/optimizer/transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #ifdef ENABLE_TRAINING
+#include "orttraining/core/optimizer/bfloat16_gradient_accumulation.h"
 #include "orttraining/core/optimizer/bias_softmax_dropout_fusion.h"
 #include "orttraining/core/optimizer/bitmask_dropout_replacement.h"
 #include "orttraining/core/optimizer/sce_loss_grad_bias_fusion.h"
@@ -233,6 +241,8 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
       transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq,
                                                                   session_options.config_options));
+      // after ConstantFolding so the body nodes that only consume constants are folded instead of hoisted
+      transformers.emplace_back(std::make_unique<LoopInvariantHoisting>());
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
@@ -241,6 +251,21 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<GeluFusion>());
       transformers.emplace_back(std::make_unique<LayerNormFusion>());
 
+#if !defined(DISABLE_CONTRIB_OPS) && defined(ORT_USE_NCCL)
+      // after GeluFusion so the MatMul pairs around a Gelu are sharded without a collective in between
+      const int64_t tensor_parallel_world_size = ParseStringWithClassicLocale<int64_t>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelWorldSize, "0"));
+      if (tensor_parallel_world_size > 1) {
+        const int64_t tensor_parallel_rank = ParseStringWithClassicLocale<int64_t>(
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelRank, "0"));
+        ORT_ENFORCE(tensor_parallel_rank >= 0 && tensor_parallel_rank < tensor_parallel_world_size,
+                    "Tensor parallel rank ", tensor_parallel_rank, " is out of range [0, ",
+                    tensor_parallel_world_size, ")");
+        transformers.emplace_back(std::make_unique<TensorParallelTransformer>(tensor_parallel_rank,
+                                                                              tensor_parallel_world_size));
+      }
+#endif
+
       if (!disable_quant_qdq) {
         transformers.emplace_back(std::make_unique<QDQPropagationTransformer>());
 
@@ -281,6 +306,8 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
       const InlinedHashSet<std::string_view> cuda_rocm_eps = {onnxruntime::kCudaExecutionProvider,
                                                               onnxruntime::kRocmExecutionProvider};
+      const InlinedHashSet<std::string_view> cpu_cuda_eps = {onnxruntime::kCpuExecutionProvider,
+                                                             onnxruntime::kCudaExecutionProvider};
       const InlinedHashSet<std::string_view> cpu_cuda_rocm_eps = {onnxruntime::kCpuExecutionProvider,
                                                                   onnxruntime::kCudaExecutionProvider,
                                                                   onnxruntime::kRocmExecutionProvider};
@@ -329,6 +356,13 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                                                  qdq_matmulnbits_accuracy_level,
                                                                                  intra_op_thread_pool,
                                                                                  p_buffered_tensors));
+#if !defined(DISABLE_FLOAT8_TYPES)
+        if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableQDQFloat8GemmFusion, "0") ==
+            "1") {
+          transformers.emplace_back(std::make_unique<QDQFloat8GemmFusion>(
+              InlinedHashSet<std::string_view>{onnxruntime::kCudaExecutionProvider}));
+        }
+#endif
       }
 
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
@@ -340,6 +374,7 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<GeluFusion>(cpu_acl_cuda_dml_rocm_eps, level));
       transformers.emplace_back(std::make_unique<LayerNormFusion>(cpu_acl_cuda_dml_rocm_eps, level));
       transformers.emplace_back(std::make_unique<SimplifiedLayerNormFusion>(cpu_cuda_rocm_eps));
+      transformers.emplace_back(std::make_unique<MultiHeadAttentionFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<AttentionFusion>(cpu_acl_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_acl_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherSliceToSplitFusion>(cpu_cuda_rocm_eps));
@@ -374,10 +409,15 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<BitmaskDropoutReplacement>(cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<BiasSoftmaxDropoutFusion>(cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<SceLossGradBiasFusion>(cpu_cuda_rocm_eps));
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsBFloat16GradientAccumulation, "0") ==
+          "1") {
+        transformers.emplace_back(std::make_unique<BFloat16GradientAccumulation>(cpu_ep));
+      }
 #endif
 
       transformers.emplace_back(std::make_unique<MatMulScaleFusion>(cpu_acl_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<MatMulActivationFusion>(dml_ep));
+      transformers.emplace_back(std::make_unique<MatMulBiasActivationFusion>(cuda_rocm_eps));
 
 #ifdef MLAS_TARGET_AMD64_IX86
       if (avx2_precision_mode) {
@@ -386,6 +426,7 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 #endif
 
       transformers.emplace_back(std::make_unique<MatMulNBitsFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<MatMulNBitsSiblingFusion>(cpu_cuda_eps));
 
 #endif  // !defined(DISABLE_CONTRIB_OPS)
       // The QDQFinalCleanupTransformer must run AFTER other transformers that fuse Q/DQ nodes. Otherwise, their
@@ -402,7 +443,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       }
 
       auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
-      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry));
+      const bool enable_nhwc_float_conv =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFloatConv, "0") == "1";
+      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
+                                                                enable_nhwc_float_conv);
       if (nhwc_transformer->IsActive()) {
         transformers.emplace_back(std::move(nhwc_transformer));
       }
@@ -413,6 +457,11 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // PR #6351 implemented similar fusion-pattern for CUDA only, and can only fuse conv-add-relu,
       // while we can fuse more activation.
       transformers.emplace_back(std::make_unique<ConvAddActivationFusion>(cpu_ep));
+
+      // run after the pattern fusions so that the chains left over are the ones they do not cover
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseFusion, "0") == "1") {
+        transformers.emplace_back(std::make_unique<ElementwiseFusion>(cpu_ep));
+      }
 #endif
 
     } break;
@@ -488,7 +537,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformersForMinimalB
 #ifndef DISABLE_CONTRIB_OPS
         AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
         auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
-        auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry));
+        const bool enable_nhwc_float_conv =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFloatConv, "0") == "1";
+        auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
+                                                                  enable_nhwc_float_conv);
         if (nhwc_transformer->IsActive()) {
           transformers.emplace_back(std::move(nhwc_transformer));
         }
@@ -1,11 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include <unordered_map>
 #include <vector>
 #include <string>
 
 #include "core/optimizer/label_encoder_fusion.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_node_proto_helper.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/utils.h"
@@ -105,17 +105,20 @@ Status LabelEncoderFusion::ApplyHelper(
   const T3 next_node_default =
       next_node_helper.GetAttr<T3>(DEFAULT_VALUE_ATTR_NAME(T3));
 
-  const auto getFromMapDefault = [](const auto& mp, const auto key, const auto def) {
-    return (mp.find(key) == mp.end()) ? def : mp.at(key);
+  const auto getFromMapDefault = [](const auto& mp, const T2& key, const T3& def) {
+    const auto it = mp.find(key);
+    return it == mp.end() ? def : it->second;
   };
 
   // Perform value propagation through the second label encoder
-  std::unordered_map<T2, T3> mapping = {};
+  InlinedHashMap<T2, T3> mapping;
+  mapping.reserve(next_node_keys.size());
   for (size_t i = 0; i < next_node_keys.size(); i++) {
     mapping[next_node_keys[i]] = next_node_values[i];
   }
 
-  std::vector<T3> new_node_values = {};
+  std::vector<T3> new_node_values;
+  new_node_values.reserve(node_values.size());
   const auto new_node_default = getFromMapDefault(mapping, node_default, next_node_default);
 
   for (const T2& node_value : node_values) {
@@ -45,7 +45,8 @@ const std::unordered_set<std::string_view>& GetCUDALayoutSensitiveOps() {
         "GridSample",
         "DepthToSpace",
         "SpaceToDepth",
-        "LRN"};
+        "LRN",
+        "Resize"};
   }();
   return cuda_nhwc_ops;
 }
@@ -89,6 +90,20 @@ bool ConvertNodeLayout(const api::NodeRef& node) {
         return false;
       }
     }
+
+    if (node.OpType() == "Resize") {
+      // The NHWC kernel is limited to 'nearest' mode, whose implementation does not depend on the position of the
+      // channels. ROI is not converted by the layout transformer, and there are no NHWC schemas before opset 11.
+      // Scales/sizes covering a subset of the axes can't be permuted either.
+      const auto mode = node.GetAttributeString("mode");
+      const auto coordinate_transformation_mode = node.GetAttributeString("coordinate_transformation_mode");
+      if (node.SinceVersion() < 11 ||
+          (mode.has_value() && *mode != "nearest") ||
+          (coordinate_transformation_mode.has_value() && *coordinate_transformation_mode == "tf_crop_and_resize") ||
+          node.GetAttributeInts("axes").has_value()) {
+        return false;
+      }
+    }
   }
 #endif
 
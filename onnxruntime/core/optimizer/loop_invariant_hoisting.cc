@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/loop_invariant_hoisting.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsInvariant(const Graph& body, const Node& node, const InlinedHashSet<std::string>& hoisted_values,
+                 Graph& graph) {
+  if (node.ContainsSubgraph() || !optimizer_utils::IsOperationDeterministic(node.Domain(), node.OpType())) {
+    return false;
+  }
+
+  bool has_input = false;
+  for (const auto* input : node.InputDefs()) {
+    if (!input->Exists()) {
+      continue;
+    }
+    const auto& name = input->Name();
+    if (hoisted_values.count(name) == 0 &&
+        (!body.IsOuterScopeValue(name) || body.GetInitializer(name, false) != nullptr)) {
+      return false;
+    }
+    has_input = true;
+  }
+
+  if (!has_input) {
+    return false;
+  }
+
+  const auto& body_outputs = body.GetOutputs();
+  for (const auto* output : node.OutputDefs()) {
+    if (!output->Exists()) {
+      continue;
+    }
+    // the outputs become values of the outer graph so their names must be free there
+    if (std::find(body_outputs.begin(), body_outputs.end(), output) != body_outputs.end() ||
+        graph.GetNodeArgIncludingParentGraphs(output->Name()) != nullptr) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Move the loop invariant nodes of `body` into `graph`, which contains the Loop/Scan node. Returns true if any moved.
+bool HoistInvariantNodes(Graph& graph, Graph& body) {
+  InlinedHashSet<std::string> hoisted_values;
+  InlinedVector<NodeIndex> hoisted_nodes;
+
+  GraphViewer body_viewer(body);
+  for (NodeIndex index : body_viewer.GetNodesInTopologicalOrder()) {
+    const Node* node = body.GetNode(index);
+    if (node == nullptr || !IsInvariant(body, *node, hoisted_values, graph)) {
+      continue;
+    }
+
+    InlinedVector<NodeArg*> inputs;
+    inputs.reserve(node->InputDefs().size());
+    for (const auto* input : node->InputDefs()) {
+      inputs.push_back(&graph.GetOrCreateNodeArg(input->Name(), input->TypeAsProto()));
+    }
+
+    InlinedVector<NodeArg*> outputs;
+    outputs.reserve(node->OutputDefs().size());
+    for (const auto* output : node->OutputDefs()) {
+      outputs.push_back(&graph.GetOrCreateNodeArg(output->Name(), output->TypeAsProto()));
+      if (output->Exists()) {
+        hoisted_values.insert(output->Name());
+      }
+    }
+
+    graph.AddNode(graph.GenerateNodeName(node->Name()), node->OpType(), node->Description(), inputs, outputs,
+                  &node->GetAttributes(), node->Domain());
+    hoisted_nodes.push_back(index);
+  }
+
+  // the body keeps the NodeArgs of the hoisted outputs, they resolve to the new outer scope values
+  for (NodeIndex index : hoisted_nodes) {
+    graph_utils::RemoveNodeOutputEdges(body, *body.GetNode(index));
+    body.RemoveNode(index);
+  }
+
+  return !hoisted_nodes.empty();
+}
+
+}  // namespace
+
+Status LoopInvariantHoisting::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                        const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (NodeIndex index : order) {
+    auto* node = graph.GetNode(index);
+    if (node == nullptr) {
+      continue;
+    }
+
+    // hoist from nested subgraphs first, the nodes they hoist into a body may be invariant in that body too
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (node->Domain() != kOnnxDomain || (node->OpType() != "Loop" && node->OpType() != "Scan") ||
+        !graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    Graph* body = node->GetMutableGraphAttribute("body");
+    if (body != nullptr && HoistInvariantNodes(graph, *body)) {
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
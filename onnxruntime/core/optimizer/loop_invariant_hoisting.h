@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class LoopInvariantHoisting
+
+Moves nodes of a Loop or Scan body that only consume values from outer scope out of the body, so they run once
+per Loop/Scan instead of once per iteration. The body then reads their outputs as outer scope values.
+
+A body node is hoisted if it is deterministic, has no subgraphs, none of its outputs are body outputs, and each
+of its inputs is an outer scope value or the output of another hoisted node. Body initializers, the iteration
+number, the condition and the loop carried values are not outer scope values, so nodes depending on them stay.
+Nodes that only consume constants are left to constant folding.
+*/
+class LoopInvariantHoisting : public GraphTransformer {
+ public:
+  LoopInvariantHoisting(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LoopInvariantHoisting", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/matmul_bias_activation_fusion.h"
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return attr != nullptr && attr->has_i() ? attr->i() : default_value;
+}
+
+// MatMul, or FusedMatMul whose A is not transposed, so A can be flattened to 2D
+bool IsFusableMatMul(const Node& node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13})) {
+    return true;
+  }
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedMatMul", {1}, kMSDomain) &&
+         GetIntAttribute(node, "transA", 0) == 0 && GetIntAttribute(node, "transBatchA", 0) == 0 &&
+         GetIntAttribute(node, "transBatchB", 0) == 0;
+}
+
+bool IsSupportedDataType(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  if (type == nullptr) {
+    return false;
+  }
+  const auto elem_type = type->tensor_type().elem_type();
+  return elem_type == TensorProto_DataType_FLOAT || elem_type == TensorProto_DataType_FLOAT16 ||
+         elem_type == TensorProto_DataType_BFLOAT16;
+}
+
+// the number of columns of the 2D B, or -1 if it is not known
+int64_t GetMatMulN(const Node& matmul) {
+  const auto* a_shape = matmul.InputDefs()[0]->Shape();
+  const auto* b_shape = matmul.InputDefs()[1]->Shape();
+  if (a_shape == nullptr || a_shape->dim_size() < 2 || b_shape == nullptr || b_shape->dim_size() != 2) {
+    return -1;
+  }
+  const auto& n_dim = b_shape->dim(GetIntAttribute(matmul, "transB", 0) != 0 ? 0 : 1);
+  return utils::HasDimValue(n_dim) ? n_dim.dim_value() : -1;
+}
+
+bool IsBias(const NodeArg& node_arg, int64_t n) {
+  const auto* shape = node_arg.Shape();
+  return node_arg.Exists() && shape != nullptr && shape->dim_size() == 1 && utils::HasDimValue(shape->dim(0)) &&
+         shape->dim(0).dim_value() == n;
+}
+
+// an intermediate value that is only consumed by the next node in the pattern
+bool HasSingleConsumer(const Graph& graph, const Node& node) {
+  return node.GetOutputEdgesCount() == 1 && !graph.NodeProducesGraphOutput(node);
+}
+
+}  // namespace
+
+Status MatMulBiasActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                             const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsFusableMatMul(node) || !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !HasSingleConsumer(graph, node) || !IsSupportedDataType(*node.OutputDefs()[0])) {
+      continue;
+    }
+
+    const int64_t n = GetMatMulN(node);
+    if (n <= 0) {
+      continue;
+    }
+
+    const auto& ep = node.GetExecutionProviderType();
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse{node};
+    NodeArg* bias = nullptr;
+    const Node* next_node = &*node.OutputNodesBegin();
+    if (next_node->GetExecutionProviderType() != ep) {
+      continue;
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "Add", {7, 13, 14})) {
+      const auto& add_inputs = next_node->InputDefs();
+      bias = const_cast<NodeArg*>(add_inputs[add_inputs[0] == node.OutputDefs()[0] ? 1 : 0]);
+      if (bias == node.OutputDefs()[0] || !IsBias(*bias, n) || !HasSingleConsumer(graph, *next_node)) {
+        continue;
+      }
+
+      nodes_to_fuse.push_back(*graph.GetNode(next_node->Index()));
+      next_node = &*next_node->OutputNodesBegin();
+      if (next_node->GetExecutionProviderType() != ep) {
+        continue;
+      }
+    }
+
+    std::string activation;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "Relu", {6, 13, 14})) {
+      activation = "Relu";
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "FastGelu", {1}, kMSDomain)) {
+      // FastGelu uses the same tanh approximation as the GELU epilogue of cuBLASLt and hipBLASLt
+      const auto& gelu_inputs = next_node->InputDefs();
+      if (gelu_inputs.size() > 1 && gelu_inputs[1]->Exists()) {
+        if (bias != nullptr || !IsBias(*gelu_inputs[1], n)) {
+          continue;
+        }
+        bias = const_cast<NodeArg*>(gelu_inputs[1]);
+      }
+      activation = "FastGelu";
+    } else {
+      continue;
+    }
+
+    Node& act_node = *graph.GetNode(next_node->Index());
+    nodes_to_fuse.push_back(act_node);
+
+    InlinedVector<NodeArg*> inputs{node.MutableInputDefs()[0], node.MutableInputDefs()[1]};
+    if (bias != nullptr) {
+      inputs.push_back(bias);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_BiasActivation"),
+                                     "FusedMatMulActivation",
+                                     "fused " + node.OpType() + " " + node.Name() + " with bias and " + activation,
+                                     inputs, {}, &node.GetAttributes(), kMSDomain);
+    fused_node.AddAttribute("activation", activation);
+    fused_node.SetExecutionProviderType(ep);
+
+    // move output definitions and edges from act_node to fused_node. delete the fused nodes.
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, fused_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MatMulBiasActivationFusion
+
+Fuses MatMul (or FusedMatMul that only scales and transposes B) with a 2D B, followed by an optional bias Add and a
+Relu or FastGelu, into FusedMatMulActivation with a bias input. The bias and activation are applied in the epilogue
+of the GEMM, e.g. by cuBLASLt on CUDA or hipBLASLt on ROCm, instead of in separate kernels.
+
+  MatMul -> [Add(bias)] -> Relu
+  MatMul -> FastGelu(bias)
+  MatMul -> Add(bias) -> FastGelu
+*/
+class MatMulBiasActivationFusion : public GraphTransformer {
+ public:
+  MatMulBiasActivationFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MatMulBiasActivationFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/matmul_nbits_sibling_fusion.h"
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// MatMulNBits op input indices.
+// These should match the inputs names specified in the op schema.
+namespace InputIndex {
+constexpr size_t A = 0,
+                 B = 1,
+                 scales = 2,
+                 zero_points = 3,
+                 g_idx = 4,
+                 bias = 5;
+};
+
+// the inputs that are concatenated along N
+constexpr std::array kConcatenatedInputs{InputIndex::B, InputIndex::scales, InputIndex::zero_points,
+                                         InputIndex::bias};
+
+bool HasInput(const Node& node, size_t input_index) {
+  const auto& input_defs = node.InputDefs();
+  return input_index < input_defs.size() && input_defs[input_index]->Exists();
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return attr != nullptr ? attr->i() : default_value;
+}
+
+bool IsCandidate(const Graph& graph, const Node& node, const InlinedHashSet<std::string_view>& compatible_eps) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMulNBits", {1}, kMSDomain) ||
+      !graph_utils::IsSupportedProvider(node, compatible_eps) || HasInput(node, InputIndex::g_idx) ||
+      GetIntAttribute(node, "N", -1) <= 0) {
+    return false;
+  }
+
+  return std::all_of(kConcatenatedInputs.begin(), kConcatenatedInputs.end(), [&](size_t input_index) {
+    return !HasInput(node, input_index) ||
+           graph_utils::IsConstantInitializer(graph, node.InputDefs()[input_index]->Name());
+  });
+}
+
+bool IsSibling(const Node& node, const Node& sibling) {
+  for (const char* attr : {"K", "bits", "block_size"}) {
+    if (GetIntAttribute(node, attr, -1) != GetIntAttribute(sibling, attr, -1)) {
+      return false;
+    }
+  }
+
+  return GetIntAttribute(node, "accuracy_level", 0) == GetIntAttribute(sibling, "accuracy_level", 0) &&
+         node.GetExecutionProviderType() == sibling.GetExecutionProviderType() &&
+         node.InputDefs().size() == sibling.InputDefs().size() &&
+         std::all_of(kConcatenatedInputs.begin(), kConcatenatedInputs.end(), [&](size_t input_index) {
+           return HasInput(node, input_index) == HasInput(sibling, input_index);
+         });
+}
+
+// Whether the initializers of the input of the nodes can be concatenated along their first dim.
+bool CanConcatenate(const Graph& graph, gsl::span<const Node* const> nodes, size_t input_index) {
+  if (!HasInput(*nodes[0], input_index)) {
+    return true;
+  }
+
+  const auto* first = graph_utils::GetConstantInitializer(graph, nodes[0]->InputDefs()[input_index]->Name());
+  if (first == nullptr || first->dims_size() == 0) {
+    return false;
+  }
+
+  return std::all_of(nodes.begin(), nodes.end(), [&](const Node* node) {
+    const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, node->InputDefs()[input_index]->Name());
+    if (tensor_proto == nullptr || tensor_proto->data_type() != first->data_type() ||
+        tensor_proto->dims_size() != first->dims_size()) {
+      return false;
+    }
+
+    for (int i = 1; i < first->dims_size(); ++i) {
+      if (tensor_proto->dims(i) != first->dims(i)) {
+        return false;
+      }
+    }
+
+    return true;
+  });
+}
+
+// Concatenate the initializers of the input of the nodes along their first dim.
+NodeArg* Concatenate(Graph& graph, gsl::span<const Node* const> nodes, size_t input_index) {
+  const auto& first_arg = *nodes[0]->InputDefs()[input_index];
+  const auto* first = graph_utils::GetConstantInitializer(graph, first_arg.Name());
+
+  ONNX_NAMESPACE::TensorProto concatenated;
+  concatenated.set_name(graph.GenerateNodeArgName(first_arg.Name() + "_siblings"));
+  concatenated.set_data_type(first->data_type());
+
+  int64_t first_dim = 0;
+  std::vector<uint8_t> data;
+  for (const Node* node : nodes) {
+    const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, node->InputDefs()[input_index]->Name());
+    Initializer initializer(*tensor_proto, graph.ModelPath());
+    const auto bytes = initializer.DataAsByteSpan();
+    data.insert(data.end(), bytes.begin(), bytes.end());
+    first_dim += tensor_proto->dims(0);
+  }
+
+  concatenated.add_dims(first_dim);
+  for (int i = 1; i < first->dims_size(); ++i) {
+    concatenated.add_dims(first->dims(i));
+  }
+  utils::SetRawDataInTensorProto(concatenated, data.data(), data.size());
+
+  return &graph_utils::AddInitializer(graph, concatenated);
+}
+
+void FuseSiblings(Graph& graph, gsl::span<const Node* const> nodes) {
+  const Node& first = *nodes[0];
+
+  InlinedVector<NodeArg*> input_defs;
+  for (size_t input_index = 0; input_index < first.InputDefs().size(); ++input_index) {
+    NodeArg* input_def = graph.GetNodeArg(first.InputDefs()[input_index]->Name());
+    const bool concatenated = std::find(kConcatenatedInputs.begin(), kConcatenatedInputs.end(), input_index) !=
+                              kConcatenatedInputs.end();
+    input_defs.push_back(concatenated && input_def->Exists() ? Concatenate(graph, nodes, input_index) : input_def);
+  }
+
+  int64_t fused_n = 0;
+  InlinedVector<int64_t> split_values;
+  InlinedVector<NodeArg*> split_outputs;
+  for (const Node* node : nodes) {
+    split_values.push_back(GetIntAttribute(*node, "N", -1));
+    fused_n += split_values.back();
+    split_outputs.push_back(graph.GetNodeArg(node->OutputDefs()[0]->Name()));
+  }
+
+  // the shape of the fused output is inferred from the fused node
+  ONNX_NAMESPACE::TypeProto fused_output_type = *first.OutputDefs()[0]->TypeAsProto();
+  fused_output_type.mutable_tensor_type()->clear_shape();
+  NodeArg& fused_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(first.Name() + "_siblings_output"),
+                                                   &fused_output_type);
+
+  Node& fused_node = graph.AddNode(graph.GenerateNodeName(first.Name() + "/MatMulNBitsSiblingFusion/"),
+                                   "MatMulNBits", "Fused MatMulNBits nodes sharing their input", input_defs,
+                                   {&fused_output}, &first.GetAttributes(), kMSDomain);
+  fused_node.AddAttribute("N", fused_n);
+  fused_node.SetExecutionProviderType(first.GetExecutionProviderType());
+
+  ONNX_NAMESPACE::TensorProto split_initializer_proto;
+  split_initializer_proto.set_name(graph.GenerateNodeArgName("splits"));
+  split_initializer_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  split_initializer_proto.add_dims(static_cast<int64_t>(split_values.size()));
+  split_initializer_proto.mutable_int64_data()->Add(split_values.begin(), split_values.end());
+  NodeArg* split_initializer_arg = &graph_utils::AddInitializer(graph, split_initializer_proto);
+
+  Node& split_node = graph.AddNode(graph.GenerateNodeName(first.Name() + "/MatMulNBitsSiblingFusion/Split"),
+                                   "Split", "Split for fused MatMulNBits nodes",
+                                   {&fused_output, split_initializer_arg}, split_outputs);
+  split_node.AddAttribute("axis", static_cast<int64_t>(-1));
+  split_node.SetExecutionProviderType(first.GetExecutionProviderType());
+
+  for (const Node* node : nodes) {
+    Node& node_to_remove = *graph.GetNode(node->Index());
+    graph_utils::RemoveNodeOutputEdges(graph, node_to_remove);
+    graph.RemoveNode(node_to_remove.Index());
+  }
+}
+
+}  // namespace
+
+Status MatMulNBitsSiblingFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                           const logging::Logger& logger) const {
+  // Split takes the sizes of its outputs as an input since opset 13.
+  const auto& domain_to_version = graph.DomainToVersionMap();
+  const auto onnx_version = domain_to_version.find(kOnnxDomain);
+  const bool can_split = onnx_version != domain_to_version.end() && onnx_version->second >= 13;
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // Group the nodes first as the fusions remove nodes, the groups are disjoint.
+  InlinedVector<InlinedVector<const Node*>> sibling_groups;
+  InlinedHashSet<std::string_view> grouped_inputs;
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) continue;  // we removed the node as part of an earlier fusion
+    Node& node = *p_node;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!can_split || !IsCandidate(graph, node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const std::string& input_name = node.InputDefs()[InputIndex::A]->Name();
+    if (!grouped_inputs.insert(input_name).second) {
+      continue;
+    }
+
+    InlinedVector<const Node*> siblings{&node};
+    for (const Node* consumer : graph.GetConsumerNodes(input_name)) {
+      if (consumer != &node && IsCandidate(graph, *consumer, GetCompatibleExecutionProviders()) &&
+          consumer->InputDefs()[InputIndex::A]->Name() == input_name && IsSibling(node, *consumer)) {
+        siblings.push_back(consumer);
+      }
+    }
+
+    if (siblings.size() > 1 &&
+        std::all_of(kConcatenatedInputs.begin(), kConcatenatedInputs.end(), [&](size_t input_index) {
+          return CanConcatenate(graph, siblings, input_index);
+        })) {
+      sibling_groups.push_back(std::move(siblings));
+    }
+  }
+
+  for (const auto& siblings : sibling_groups) {
+    LOGS(logger, VERBOSE) << "Fusing " << siblings.size() << " MatMulNBits nodes sharing input "
+                          << siblings[0]->InputDefs()[InputIndex::A]->Name();
+    FuseSiblings(graph, siblings);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
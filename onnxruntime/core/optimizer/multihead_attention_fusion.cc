@@ -0,0 +1,331 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/multihead_attention_fusion.h"
+
+#include <array>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+
+namespace {
+
+using ONNX_NAMESPACE::TensorShapeProto;
+
+bool HasDimValue(const TensorShapeProto& shape, int index, int64_t value) {
+  return utils::HasDimValue(shape.dim(index)) && shape.dim(index).dim_value() == value;
+}
+
+// Returns the only consumer of the output of node, or null when there are several or the output is a graph output.
+const Node* GetOnlyChild(const Graph& graph, const Node& node) {
+  if (!optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+    return nullptr;
+  }
+
+  return &*node.OutputNodesBegin();
+}
+
+// Returns whether node multiplies or divides its input at data_index by a scalar float constant, and the factor that
+// the input is multiplied by.
+bool IsScalingByConstant(const Graph& graph, const Node& node, float& factor, int& data_index) {
+  const bool is_mul = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14});
+  if (!is_mul && !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14})) {
+    return false;
+  }
+
+  const auto& inputs = node.InputDefs();
+  for (int i = is_mul ? 0 : 1; i < 2; ++i) {
+    const auto* type = inputs[i]->TypeAsProto();
+    float value = 0.0f;
+    if (type == nullptr || type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+        !optimizer_utils::GetScalarInitializerValue(graph, *inputs[i], value, true)) {
+      continue;
+    }
+
+    if (!is_mul && value == 0.0f) {
+      return false;
+    }
+
+    factor = is_mul ? value : 1.0f / value;
+    data_index = 1 - i;
+    return true;
+  }
+
+  return false;
+}
+
+// The scaling of the scores, the query or the key, that is fused into the scale of MultiHeadAttention.
+// Returns the input of node that is scaled, or the input itself when there is no scaling.
+const NodeArg* SkipScaling(const Graph& graph, const Node& consumer, int input_index, float& scale,
+                           InlinedVector<NodeIndex>& nodes_to_remove) {
+  const NodeArg* input = consumer.InputDefs()[input_index];
+  const Node* producer = graph_utils::GetInputNode(consumer, input_index);
+  float factor = 1.0f;
+  int data_index = 0;
+  if (producer != nullptr && optimizer_utils::CheckOutputEdges(graph, *producer, 1) &&
+      IsScalingByConstant(graph, *producer, factor, data_index)) {
+    scale *= factor;
+    nodes_to_remove.push_back(producer->Index());
+    return producer->InputDefs()[data_index];
+  }
+
+  return input;
+}
+
+NodeArg& GetQueryShapeInitializer(Graph& graph, NodeArg*& query_shape) {
+  if (query_shape == nullptr) {
+    // (batch_size, sequence_length, num_heads, head_size) to (batch_size, sequence_length, hidden_size)
+    ONNX_NAMESPACE::TensorProto shape_initializer;
+    shape_initializer.set_name(graph.GenerateNodeArgName("mha_query_shape"));
+    shape_initializer.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    shape_initializer.add_dims(3);
+    shape_initializer.add_int64_data(0);
+    shape_initializer.add_int64_data(0);
+    shape_initializer.add_int64_data(-1);
+    query_shape = &graph_utils::AddInitializer(graph, shape_initializer);
+  }
+
+  return *query_shape;
+}
+
+bool FuseAttention(Graph& graph, const Node& softmax, const InlinedHashSet<std::string_view>& compatible_providers,
+                   NodeArg*& query_shape, const logging::Logger& logger) {
+  // Softmax over the last axis of the 4D scores. The attribute defaults to 1 and flattens the following axes before
+  // opset 13, which is the same for axis 3.
+  const auto* scores_shape = softmax.InputDefs()[0]->Shape();
+  if (scores_shape == nullptr || scores_shape->dim_size() != 4) {
+    return false;
+  }
+
+  int64_t axis = graph_utils::MatchesOpSinceVersion(softmax, {1, 11}) ? 1 : -1;
+  const auto* axis_attr = graph_utils::GetNodeAttribute(softmax, "axis");
+  if (axis_attr != nullptr && utils::HasInt(*axis_attr)) {
+    axis = axis_attr->i();
+  }
+
+  if (HandleNegativeAxis(axis, 4) != 3) {
+    return false;
+  }
+
+  // probs x value, transposed back to BSNH and reshaped to BSD
+  const Node* pv_matmul = GetOnlyChild(graph, softmax);
+  if (pv_matmul == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*pv_matmul, "MatMul", {1, 9, 13}) ||
+      pv_matmul->InputDefs()[0] != softmax.OutputDefs()[0]) {
+    return false;
+  }
+
+  const Node* output_transpose = GetOnlyChild(graph, *pv_matmul);
+  if (output_transpose == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*output_transpose, "Transpose", {1, 13, 21}) ||
+      !optimizer_utils::IsAttributeWithExpectedValues(*output_transpose, "perm", {0, 2, 1, 3})) {
+    return false;
+  }
+
+  const Node* output_reshape = GetOnlyChild(graph, *output_transpose);
+  if (output_reshape == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*output_reshape, "Reshape", {5, 13, 14, 19, 21}) ||
+      output_reshape->InputDefs()[0] != output_transpose->OutputDefs()[0]) {
+    return false;
+  }
+
+  InlinedVector<NodeIndex> nodes_to_remove{softmax.Index(), pv_matmul->Index(), output_transpose->Index(),
+                                           output_reshape->Index()};
+
+  // scores, with an optional attention bias added
+  const Node* scores_node = graph_utils::GetInputNode(softmax, 0);
+  const NodeArg* attention_bias = nullptr;
+  float scale = 1.0f;
+  const Node* qk_matmul = nullptr;
+  if (scores_node != nullptr && optimizer_utils::CheckOutputEdges(graph, *scores_node, 1) &&
+      graph_utils::IsSupportedOptypeVersionAndDomain(*scores_node, "Add", {7, 13, 14})) {
+    for (int i = 0; i < 2 && qk_matmul == nullptr; ++i) {
+      InlinedVector<NodeIndex> scale_nodes;
+      float add_scale = 1.0f;
+      const NodeArg* scores = SkipScaling(graph, *scores_node, i, add_scale, scale_nodes);
+      const Node* producer = graph.GetProducerNode(scores->Name());
+      if (producer != nullptr &&
+          graph_utils::IsSupportedOptypeVersionAndDomain(*producer, "MatMul", {1, 9, 13})) {
+        qk_matmul = producer;
+        scale = add_scale;
+        attention_bias = scores_node->InputDefs()[1 - i];
+        nodes_to_remove.push_back(scores_node->Index());
+        nodes_to_remove.insert(nodes_to_remove.end(), scale_nodes.begin(), scale_nodes.end());
+      }
+    }
+  } else {
+    const NodeArg* scores = SkipScaling(graph, softmax, 0, scale, nodes_to_remove);
+    qk_matmul = graph.GetProducerNode(scores->Name());
+    if (qk_matmul != nullptr && !graph_utils::IsSupportedOptypeVersionAndDomain(*qk_matmul, "MatMul", {1, 9, 13})) {
+      qk_matmul = nullptr;
+    }
+  }
+
+  if (qk_matmul == nullptr || !optimizer_utils::CheckOutputEdges(graph, *qk_matmul, 1)) {
+    return false;
+  }
+
+  nodes_to_remove.push_back(qk_matmul->Index());
+
+  // query x key_transposed, where either side may be scaled
+  const NodeArg* query = SkipScaling(graph, *qk_matmul, 0, scale, nodes_to_remove);
+  const NodeArg* key_transposed = SkipScaling(graph, *qk_matmul, 1, scale, nodes_to_remove);
+  const Node* key_transpose = graph.GetProducerNode(key_transposed->Name());
+  if (key_transpose == nullptr || !optimizer_utils::CheckOutputEdges(graph, *key_transpose, 1) ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*key_transpose, "Transpose", {1, 13, 21}) ||
+      !optimizer_utils::IsAttributeWithExpectedValues(*key_transpose, "perm", {0, 1, 3, 2})) {
+    return false;
+  }
+
+  nodes_to_remove.push_back(key_transpose->Index());
+  const NodeArg* key = SkipScaling(graph, *key_transpose, 0, scale, nodes_to_remove);
+  const NodeArg* value = pv_matmul->InputDefs()[1];
+
+  // a scale of 0 means 1 / sqrt(head_size) to MultiHeadAttention
+  if (scale == 0.0f) {
+    return false;
+  }
+
+  for (NodeIndex index : nodes_to_remove) {
+    if (!graph_utils::IsSupportedProvider(*graph.GetNode(index), compatible_providers)) {
+      return false;
+    }
+  }
+
+  // MultiHeadAttention takes key and value in BNSH format only when they have the same shape. The batch sizes
+  // must match exactly as MatMul would broadcast them.
+  const auto* query_type = query->TypeAsProto();
+  if (query_type == nullptr || query_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  const auto* query_shape_proto = query->Shape();
+  const auto* key_shape_proto = key->Shape();
+  const auto* value_shape_proto = value->Shape();
+  if (query_shape_proto == nullptr || key_shape_proto == nullptr || value_shape_proto == nullptr ||
+      query_shape_proto->dim_size() != 4 || key_shape_proto->dim_size() != 4 || value_shape_proto->dim_size() != 4) {
+    return false;
+  }
+
+  const auto& query_dims = *query_shape_proto;
+  const auto& key_dims = *key_shape_proto;
+  const auto& value_dims = *value_shape_proto;
+  if (!utils::HasDimValue(query_dims.dim(1)) || !utils::HasDimValue(query_dims.dim(3))) {
+    return false;
+  }
+
+  const int64_t num_heads = query_dims.dim(1).dim_value();
+  const int64_t head_size = query_dims.dim(3).dim_value();
+  if (num_heads <= 0 || head_size <= 0 ||
+      !HasDimValue(key_dims, 1, num_heads) || !HasDimValue(key_dims, 3, head_size) ||
+      !HasDimValue(value_dims, 1, num_heads) || !HasDimValue(value_dims, 3, head_size) ||
+      query_dims.dim(0) != key_dims.dim(0) || query_dims.dim(0) != value_dims.dim(0)) {
+    LOGS(logger, VERBOSE) << "MultiHeadAttentionFusion: query, key and value shapes are not supported for "
+                          << softmax.Name();
+    return false;
+  }
+
+  // MultiHeadAttention requires an attention bias of shape (batch_size or 1, num_heads or 1, S, T)
+  if (attention_bias != nullptr) {
+    const auto* bias_shape = attention_bias->Shape();
+    if (bias_shape == nullptr || bias_shape->dim_size() != 4 ||
+        !(HasDimValue(*bias_shape, 0, 1) || bias_shape->dim(0) == query_dims.dim(0)) ||
+        !(HasDimValue(*bias_shape, 1, 1) || HasDimValue(*bias_shape, 1, num_heads)) ||
+        bias_shape->dim(2) != query_dims.dim(2) || bias_shape->dim(3) != key_dims.dim(2)) {
+      LOGS(logger, VERBOSE) << "MultiHeadAttentionFusion: attention bias shape is not supported for "
+                            << softmax.Name();
+      return false;
+    }
+  }
+
+  // the output must be (batch_size, sequence_length, num_heads * head_size)
+  const auto* output_shape = output_reshape->OutputDefs()[0]->Shape();
+  if (output_shape == nullptr || output_shape->dim_size() != 3 ||
+      output_shape->dim(0) != query_dims.dim(0) || output_shape->dim(1) != query_dims.dim(2) ||
+      !HasDimValue(*output_shape, 2, num_heads * head_size)) {
+    return false;
+  }
+
+  // Query (B, N, S, H) -> (B, S, N, H) -> (B, S, N * H)
+  const std::string& provider = softmax.GetExecutionProviderType();
+  ONNX_NAMESPACE::TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  NodeArg& query_bsnh = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("mha_query_bsnh"), &float_type);
+  NodeArg& query_bsd = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("mha_query"), &float_type);
+
+  NodeArg* query_arg = graph.GetNodeArg(query->Name());
+  Node& query_transpose = graph.AddNode(graph.GenerateNodeName("MultiHeadAttentionFusion/Transpose"),
+                                        "Transpose", "Query to BSNH for MultiHeadAttention",
+                                        std::array{query_arg}, std::array{&query_bsnh});
+  query_transpose.AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+  query_transpose.SetExecutionProviderType(provider);
+
+  Node& query_reshape = graph.AddNode(graph.GenerateNodeName("MultiHeadAttentionFusion/Reshape"),
+                                      "Reshape", "Query to BSD for MultiHeadAttention",
+                                      std::array{&query_bsnh, &GetQueryShapeInitializer(graph, query_shape)},
+                                      std::array{&query_bsd});
+  query_reshape.SetExecutionProviderType(provider);
+
+  InlinedVector<NodeArg*> mha_inputs{&query_bsd, graph.GetNodeArg(key->Name()), graph.GetNodeArg(value->Name())};
+  if (attention_bias != nullptr) {
+    NodeArg& empty = graph.GetOrCreateNodeArg("", nullptr);
+    mha_inputs.push_back(&empty);  // bias
+    mha_inputs.push_back(&empty);  // key_padding_mask
+    mha_inputs.push_back(graph.GetNodeArg(attention_bias->Name()));
+  }
+
+  Node& mha = graph.AddNode(graph.GenerateNodeName("MultiHeadAttention"), "MultiHeadAttention",
+                            "Fused scaled dot product attention", mha_inputs,
+                            std::array{graph.GetNode(output_reshape->Index())->MutableOutputDefs()[0]},
+                            nullptr, kMSDomain);
+  mha.AddAttribute("num_heads", num_heads);
+  mha.AddAttribute("scale", scale);
+  mha.SetExecutionProviderType(provider);
+
+  for (NodeIndex index : nodes_to_remove) {
+    Node* node = graph.GetNode(index);
+    graph_utils::RemoveNodeOutputEdges(graph, *node);
+    graph.RemoveNode(index);
+  }
+
+  return true;
+}
+
+}  // namespace
+
+Status MultiHeadAttentionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                           const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // shared by the query reshapes of all the layers
+  NodeArg* query_shape = nullptr;
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr) {
+      continue;  // node was removed
+    }
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Softmax", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    if (FuseAttention(graph, node, GetCompatibleExecutionProviders(), query_shape, logger)) {
+      modified = true;
+      LOGS(logger, VERBOSE) << "Fused scaled dot product attention into MultiHeadAttention.";
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
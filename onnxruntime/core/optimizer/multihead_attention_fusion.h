@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MultiHeadAttentionFusion
+Rewrite the scaled dot product attention of decoder exports (Llama, Mistral, Phi and the like) to a
+MultiHeadAttention node. Query, key and value are in (batch_size, num_heads, sequence_length, head_size) format,
+after the rotary embedding and the repetition of the key value heads:
+
+    Transpose(key, perm=[0, 1, 3, 2])
+    MatMul(query, key_transposed)
+    Mul or Div by a constant scale (optional, may also be applied to query and key_transposed)
+    Add(attention_bias) (optional, like the causal and padding mask built with Trilu and Where)
+    Softmax(axis=-1)
+    MatMul(probs, value)
+    Transpose(perm=[0, 2, 1, 3])
+    Reshape to (batch_size, sequence_length, num_heads * head_size)
+
+Query is transposed and reshaped to (batch_size, sequence_length, hidden_size), and key and value are passed in
+BNSH format.
+*/
+class MultiHeadAttentionFusion : public GraphTransformer {
+ public:
+  MultiHeadAttentionFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MultiHeadAttentionFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
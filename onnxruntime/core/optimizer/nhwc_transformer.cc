@@ -44,7 +44,8 @@ NhwcConvLookup(
   return &(iter->second);
 }
 
-NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry) noexcept
+NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry,
+                                 bool enable_float_conv) noexcept
     : GraphTransformer("NhwcTransformer"), cpu_allocator_(std::move(cpu_allocator)) {
   if (!cpu_kernel_registry) {
     // This is a CPU op nodes optimizer, not useful if cpu EP is not available.
@@ -115,6 +116,26 @@ NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<Ker
     }
   }
 
+  if (enable_float_conv) {
+    // fp32 conv -> fp32 nhwc conv
+    OpKernelRegistryId nhwc_conv_fp32{
+        "NhwcFusedConv", kMSDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+    const KernelCreateInfo* kernel_create_info{};
+    const auto status = cpu_kernel_registry->TryFindKernel(
+        kCpuExecutionProvider, nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_,
+        nhwc_conv_fp32.version_, nhwc_conv_fp32.type_constraints_, &kernel_create_info);
+    if (status.IsOK() && kernel_create_info != nullptr) {
+      kernel_create_info = nullptr;
+      conv_table_.emplace(
+          OpIdInfo("Conv", kOnnxDomain, api::DataType::FLOAT),
+          OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+      conv_table_.emplace(
+          OpIdInfo("FusedConv", kMSDomain, api::DataType::FLOAT),
+          OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+    }
+  }
+
   {
     // fp16 MaxPool -> fp16 nhwc MaxPool
     OpKernelRegistryId nhwc_maxpool_fp16{
@@ -196,6 +217,11 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       continue;
     }
 
+    // The float NhwcFusedConv kernel is only in the CPU EP, the ACL EP has its own NHWC convolution.
+    if (ep != kCpuExecutionProvider && api_graph->GetValueInfo(node->Inputs()[0])->DType() == api::DataType::FLOAT) {
+      continue;
+    }
+
     // Skip if already transformed
     if (transform->has_channels_last_attrib_ &&
         node->GetAttributeIntDefault("channels_last", 0) == 1) {
@@ -215,7 +241,13 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     size_t rank = shape->dim_size();
     std::vector<int64_t> input_perm = ChannelFirstToLastPerm(rank);
     std::vector<int64_t> output_perm = ChannelLastToFirstPerm(rank);
-    WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
+    std::vector<const std::vector<int64_t>*> input_perms{&input_perm};
+    // the Sum input of FusedConv has the layout of the output
+    const auto inputs = node->Inputs();
+    if (transform->optype_ == "NhwcFusedConv" && inputs.size() > 3 && !inputs[3].empty()) {
+      input_perms = {&input_perm, nullptr, nullptr, &input_perm};
+    }
+    WrapTransposesAroundNode(*api_graph, *node, input_perms, {&output_perm});
 
     // Replace the operator if needed
     if (node->Domain() != transform->domain_ ||
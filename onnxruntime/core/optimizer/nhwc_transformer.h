@@ -75,7 +75,11 @@ and inserts nodes to transpose tensors as needed.
 class NhwcTransformer : public GraphTransformer {
  private:
  public:
-  explicit NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry) noexcept;
+  /**
+   * @param enable_float_conv  Also convert float Conv and FusedConv nodes to NhwcFusedConv.
+   */
+  explicit NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry,
+                           bool enable_float_conv = false) noexcept;
 
   /**
    * @brief Usually called right after constructor, it shows whether
@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/qdq_transformer/qdq_float8_gemm_fusion.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/qdq_transformer/qdq_util.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsFloat8Tensor(const NodeArg& arg, int32_t& elem_type) {
+  const auto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return false;
+  }
+
+  elem_type = type->tensor_type().elem_type();
+  return elem_type == TensorProto_DataType_FLOAT8E4M3FN || elem_type == TensorProto_DataType_FLOAT8E5M2;
+}
+
+bool IsRank2(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  return shape != nullptr && shape->dim_size() == 2;
+}
+
+// Returns the DequantizeLinear node producing `arg` if it dequantizes a float8 tensor with a per-tensor float scale
+// and a zero point of 0, and `arg` is only consumed by `consumer`.
+const Node* GetFloat8DQNode(const Graph& graph, const Node& consumer, const NodeArg& arg, int32_t& elem_type) {
+  const Node* dq_node = graph.GetProducerNode(arg.Name());
+  if (dq_node == nullptr || !QDQ::MatchDQNode(*dq_node) ||
+      dq_node->GetExecutionProviderType() != consumer.GetExecutionProviderType() ||
+      !optimizer_utils::CheckOutputEdges(graph, *dq_node, 1)) {
+    return nullptr;
+  }
+
+  const auto& input_defs = dq_node->InputDefs();
+  if (!IsFloat8Tensor(*input_defs[QDQ::InputIndex::INPUT_ID], elem_type)) {
+    return nullptr;
+  }
+
+  auto get_const_initializer = [&graph](const std::string& initializer_name) {
+    return graph.GetConstantInitializer(initializer_name, true);
+  };
+
+  bool zero_point_exists = false;
+  if (!QDQ::QOrDQNodeHasConstantScalarScaleAndZeroPoint(*dq_node, get_const_initializer, zero_point_exists)) {
+    return nullptr;
+  }
+
+  // GemmFloat8 only takes float scales
+  const auto* scale_type = input_defs[QDQ::InputIndex::SCALE_ID]->TypeAsProto();
+  if (scale_type == nullptr || scale_type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+    return nullptr;
+  }
+
+  if (zero_point_exists) {
+    // the encoding of 0 is all zero bits for both float8 types
+    std::vector<uint8_t> zero_point;
+    const auto* zero_point_proto = get_const_initializer(input_defs[QDQ::InputIndex::ZERO_POINT_ID]->Name());
+    if (!utils::UnpackInitializerData(*zero_point_proto, graph.ModelPath(), zero_point).IsOK() ||
+        std::any_of(zero_point.begin(), zero_point.end(), [](uint8_t v) { return v != 0; })) {
+      return nullptr;
+    }
+  }
+
+  return dq_node;
+}
+
+}  // namespace
+
+Status QDQFloat8GemmFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                      const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // B is used as is only by a Gemm with transB=1, every other case needs a transposed copy of it
+    bool transpose_b = true;
+    float alpha = 1.0f;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", {11, 13})) {
+      const auto& attrs = node.GetAttributes();
+      auto get_int_attr = [&attrs](const char* name) {
+        auto it = attrs.find(name);
+        return it == attrs.end() ? int64_t{0} : it->second.i();
+      };
+
+      // the bias would have to be in the output type and is only supported by cuBLASLt from CUDA 12
+      const auto& input_defs = node.InputDefs();
+      if (get_int_attr("transA") != 0 || (input_defs.size() > 2 && input_defs[2]->Exists())) {
+        continue;
+      }
+
+      transpose_b = get_int_attr("transB") == 0;
+      auto alpha_it = attrs.find("alpha");
+      if (alpha_it != attrs.end()) {
+        alpha = alpha_it->second.f();
+      }
+    } else if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {9, 13})) {
+      continue;
+    }
+
+    const auto& input_defs = node.InputDefs();
+    if (!IsRank2(*input_defs[0]) || !IsRank2(*input_defs[1])) {
+      continue;
+    }
+
+    int32_t a_type = 0;
+    int32_t b_type = 0;
+    const Node* dq_a = GetFloat8DQNode(graph, node, *input_defs[0], a_type);
+    const Node* dq_b = GetFloat8DQNode(graph, node, *input_defs[1], b_type);
+    if (dq_a == nullptr || dq_b == nullptr || dq_a == dq_b) {
+      continue;
+    }
+
+    // cuBLASLt has no E5M2 x E5M2 kernels
+    if (a_type == TensorProto_DataType_FLOAT8E5M2 && b_type == TensorProto_DataType_FLOAT8E5M2) {
+      continue;
+    }
+
+    Node& dq_a_node = *graph.GetNode(dq_a->Index());
+    Node& dq_b_node = *graph.GetNode(dq_b->Index());
+    auto& dq_a_inputs = dq_a_node.MutableInputDefs();
+    auto& dq_b_inputs = dq_b_node.MutableInputDefs();
+
+    NodeArg* b_arg = dq_b_inputs[QDQ::InputIndex::INPUT_ID];
+    const TensorProto* b_proto = graph.GetConstantInitializer(b_arg->Name(), true);
+    if (b_proto == nullptr || b_proto->dims_size() != 2) {
+      continue;
+    }
+
+    if (transpose_b) {
+      std::vector<uint8_t> b_data;
+      if (!utils::UnpackInitializerData(*b_proto, graph.ModelPath(), b_data).IsOK()) {
+        continue;
+      }
+
+      const size_t K = gsl::narrow<size_t>(b_proto->dims(0));
+      const size_t N = gsl::narrow<size_t>(b_proto->dims(1));
+      std::vector<uint8_t> transposed(b_data.size());
+      for (size_t k = 0; k < K; ++k) {
+        for (size_t n = 0; n < N; ++n) {
+          transposed[n * K + k] = b_data[k * N + n];
+        }
+      }
+
+      TensorProto transposed_proto;
+      transposed_proto.set_name(graph.GenerateNodeArgName(b_arg->Name() + "_transposed"));
+      transposed_proto.set_data_type(b_proto->data_type());
+      transposed_proto.add_dims(static_cast<int64_t>(N));
+      transposed_proto.add_dims(static_cast<int64_t>(K));
+      utils::SetRawDataInTensorProto(transposed_proto, transposed.data(), transposed.size());
+      b_arg = &graph_utils::AddInitializer(graph, transposed_proto);
+    }
+
+    const std::array<NodeArg*, 5> gemm_inputs{dq_a_inputs[QDQ::InputIndex::INPUT_ID],
+                                              b_arg,
+                                              &graph.GetOrCreateNodeArg("", nullptr),
+                                              dq_a_inputs[QDQ::InputIndex::SCALE_ID],
+                                              dq_b_inputs[QDQ::InputIndex::SCALE_ID]};
+
+    Node& gemm_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "/QDQFloat8GemmFusion/"), "GemmFloat8",
+                                    "fused DequantizeLinear and " + node.OpType(), gemm_inputs,
+                                    std::array{node.MutableOutputDefs()[0]}, nullptr, kMSDomain);
+    gemm_node.AddAttribute("transA", static_cast<int64_t>(0));
+    gemm_node.AddAttribute("transB", static_cast<int64_t>(1));
+    gemm_node.AddAttribute("alpha", alpha);
+    gemm_node.AddAttribute("dtype", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+    gemm_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {dq_a_node, dq_b_node, node}, gemm_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
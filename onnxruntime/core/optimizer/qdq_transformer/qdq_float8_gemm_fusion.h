@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+    @Class QDQFloat8GemmFusion
+
+    Fuse DequantizeLinear(A float8) and DequantizeLinear(B float8 constant) feeding a 2D MatMul or Gemm into
+    com.microsoft.GemmFloat8, so the matrix multiplication runs on the float8 tensor cores with the per-tensor
+    scales applied by cuBLASLt instead of on the dequantized float tensors.
+
+    Only per-tensor scales with zero (or missing) zero points are handled. B is stored transposed, as the float8
+    path of GemmFloat8 requires transB=1.
+ */
+class QDQFloat8GemmFusion : public GraphTransformer {
+ public:
+  QDQFloat8GemmFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QDQFloat8GemmFusion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
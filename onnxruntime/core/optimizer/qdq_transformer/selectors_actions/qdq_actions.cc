@@ -8,7 +8,9 @@
 #include "core/optimizer/qdq_transformer/qdq_util.h"
 #include "core/optimizer/initializer.h"
 #include "core/graph/node_attr_utils.h"
+#include "core/framework/int4.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
 #include "core/mlas/inc/mlas_q4.h"
 
 namespace onnxruntime {
@@ -154,6 +156,8 @@ struct SetOptionalZeroPoint {
     onnxruntime::utils::SetRawDataInTensorProto(tensor_proto, a.data(), sizeof(uint8_t));
     return tensor_proto;
   };
+
+ public:
   static ONNX_NAMESPACE::TensorProto GetOptionalZeroPointInt8() {
     static ONNX_NAMESPACE::TensorProto proto = init_optional_zero_point_int8();
     return proto;
@@ -209,6 +213,28 @@ void SetOptionalZeroPoint::UpdateNodes(Graph& graph, const NodesToOptimize& sele
   }
 }
 
+// add an 8-bit copy of a constant int4/uint4 initializer
+template <bool Signed>
+NodeArg& Widen4BitInitializer(Graph& graph, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  using Int4 = Int4x2Base<Signed>;
+
+  Initializer src(tensor_proto, graph.ModelPath());
+  const auto packed = src.DataAsByteSpan();
+  std::vector<typename Int4::UnpackedType> unpacked(src.size());
+  ORT_ENFORCE(Int4::Unpack(unpacked, gsl::make_span(reinterpret_cast<const Int4*>(packed.data()),
+                                                    packed.size())),
+              "Unexpected size of the 4-bit initializer ", tensor_proto.name());
+
+  ONNX_NAMESPACE::TensorProto widened;
+  widened.set_name(graph.GenerateNodeArgName(tensor_proto.name() + "_8bit"));
+  widened.set_data_type(Signed ? ONNX_NAMESPACE::TensorProto_DataType_INT8
+                               : ONNX_NAMESPACE::TensorProto_DataType_UINT8);
+  *widened.mutable_dims() = tensor_proto.dims();
+  utils::SetRawDataInTensorProto(widened, unpacked.data(), unpacked.size());
+
+  return graph_utils::AddInitializer(graph, widened);
+}
+
 }  // namespace
 
 Status QDQReplaceWithNew::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
@@ -239,6 +265,17 @@ NodeAttributes UnaryReplaceWithQLinear::ExtraAttributes(const RuntimeState& stat
   return attr;
 }
 
+UnaryReplaceWithQLinearUnary::UnaryReplaceWithQLinearUnary()
+    : QDQReplaceWithNew(kMSDomain, "QLinearUnary", UnaryMoves()) {
+}
+
+NodeAttributes UnaryReplaceWithQLinearUnary::ExtraAttributes(const RuntimeState& state) const {
+  // the attributes of the target, e.g. 'alpha' of Elu, are copied to the replacement node
+  NodeAttributes attr;
+  attr["op_type"] = utils::MakeAttribute(std::string("op_type"), state.selected_nodes.Target().OpType());
+  return attr;
+}
+
 BinaryReplaceWithQLinear::BinaryReplaceWithQLinear(std::string domain)
     : ReplaceWithQLinear(std::move(domain), BinaryMoves()) {
 }
@@ -250,6 +287,46 @@ VariadicReplaceWithQLinear::VariadicReplaceWithQLinear(std::string domain)
 ConvReplaceWithQLinear::ConvReplaceWithQLinear()
     : ReplaceWithQLinear(kOnnxDomain, ConvMoves()) {
 }
+
+Status ConvReplaceWithQLinear::ProcessNewNode(Graph& graph, const NodesToOptimize&, Node& replacement_node) const {
+  // QLinearConv inputs: x, x_scale, x_zero_point, w, w_scale, w_zero_point, y_scale, y_zero_point, B
+  constexpr size_t w_idx = 3, w_zero_point_idx = 5;
+
+  auto& input_defs = replacement_node.MutableInputDefs();
+  const int32_t dt_weight = input_defs[w_idx]->TypeAsProto()->tensor_type().elem_type();
+  if (dt_weight != ONNX_NAMESPACE::TensorProto_DataType_INT4 &&
+      dt_weight != ONNX_NAMESPACE::TensorProto_DataType_UINT4) {
+    return Status::OK();
+  }
+
+  for (size_t idx : {w_idx, w_zero_point_idx}) {
+    const NodeArg& arg = *input_defs[idx];
+    const int32_t dt = arg.TypeAsProto()->tensor_type().elem_type();
+    if (dt != ONNX_NAMESPACE::TensorProto_DataType_INT4 && dt != ONNX_NAMESPACE::TensorProto_DataType_UINT4) {
+      continue;
+    }
+
+    const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, arg.Name());
+    ORT_RETURN_IF(tensor_proto == nullptr, "The 4-bit input ", arg.Name(), " of ", replacement_node.Name(),
+                  " is not a constant initializer.");
+    input_defs[idx] = dt == ONNX_NAMESPACE::TensorProto_DataType_INT4
+                          ? &Widen4BitInitializer<true>(graph, *tensor_proto)
+                          : &Widen4BitInitializer<false>(graph, *tensor_proto);
+  }
+
+  // the zero point added for a weight DQ without one is uint8, so it must be int8 for an int4 weight
+  if (dt_weight == ONNX_NAMESPACE::TensorProto_DataType_INT4 &&
+      input_defs[w_zero_point_idx]->Name() == SetOptionalZeroPoint::GetOptionalZeroPointUint8().name()) {
+    const auto zp_tensor_proto = SetOptionalZeroPoint::GetOptionalZeroPointInt8();
+    const ONNX_NAMESPACE::TensorProto* existing_zp_tensor_proto;
+    if (!graph.GetInitializedTensor(zp_tensor_proto.name(), existing_zp_tensor_proto)) {
+      graph.AddInitializedTensor(zp_tensor_proto);
+    }
+    input_defs[w_zero_point_idx] = &graph.GetOrCreateNodeArg(zp_tensor_proto.name(), nullptr);
+  }
+
+  return Status::OK();
+}
 WhereReplaceWithQLinear::WhereReplaceWithQLinear()
     : ReplaceWithQLinear(kMSDomain, WhereMoves()) {
 }
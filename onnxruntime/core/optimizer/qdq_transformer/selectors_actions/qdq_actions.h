@@ -55,6 +55,15 @@ struct UnaryReplaceWithQLinear : ReplaceWithQLinear {
   NodeAttributes ExtraAttributes(const RuntimeState& state) const override;
 };
 
+// replace an elementwise unary node with QLinearUnary, which applies the op with a lookup table.
+// the op is named by the 'op_type' attribute of the replacement node.
+struct UnaryReplaceWithQLinearUnary : QDQReplaceWithNew {
+  UnaryReplaceWithQLinearUnary();
+
+ private:
+  NodeAttributes ExtraAttributes(const RuntimeState& state) const override;
+};
+
 struct BinaryReplaceWithQLinear : ReplaceWithQLinear {
   BinaryReplaceWithQLinear(std::string domain);
 };
@@ -65,6 +74,10 @@ struct VariadicReplaceWithQLinear : ReplaceWithQLinear {
 
 struct ConvReplaceWithQLinear : ReplaceWithQLinear {
   ConvReplaceWithQLinear();
+
+ private:
+  // widen 4-bit weights and zero points to the 8-bit types QLinearConv takes
+  Status ProcessNewNode(Graph&, const NodesToOptimize&, Node&) const override;
 };
 struct WhereReplaceWithQLinear : ReplaceWithQLinear {
   WhereReplaceWithQLinear();
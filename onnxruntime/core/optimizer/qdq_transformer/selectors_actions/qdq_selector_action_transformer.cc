@@ -162,6 +162,46 @@ void UnaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+void UnaryLookupTableOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ, target, Q
+  // Replace with QLinearUnary, which applies the op to the 256 possible 8-bit inputs once and looks up the
+  // output of each element. Delete all original nodes.
+  const std::string action_name{"1DQLookupTable"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::UnaryReplaceWithQLinearUnary>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // TODO: Enable 16-bit types in selector when QLinearUnary supports 16-bit.
+  std::vector<const char*> providers = {kCpuExecutionProvider};
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::UnarySelector>(providers);
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Abs", {}},
+                                                          {"Celu", {}},
+                                                          {"Cos", {}},
+                                                          {"Elu", {}},
+                                                          {"Erf", {}},
+                                                          {"Exp", {}},
+                                                          {"Gelu", {}},
+                                                          {"HardSigmoid", {}},
+                                                          {"HardSwish", {}},
+                                                          {"Log", {}},
+                                                          {"Mish", {}},
+                                                          {"Neg", {}},
+                                                          {"Reciprocal", {}},
+                                                          {"Selu", {}},
+                                                          {"Sin", {}},
+                                                          {"Softplus", {}},
+                                                          {"Softsign", {}},
+                                                          {"Sqrt", {}},
+                                                          {"Tanh", {}},
+                                                          {SelectorActionRegistry::OpVersionsMapKey("Gelu", kMSDomain),
+                                                           {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 void BinaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
   // 4 nodes. 2 x DQ for inputs, target, Q
   // Replace with internal QLinear version of operator. Delete all original nodes.
@@ -236,11 +276,13 @@ void ConvQDQRules(SelectorActionRegistry& qdq_selector_action_registry, bool is_
 
 #if !defined(ORT_MINIMAL_BUILD)
   // TODO: Enable 16-bit types in selector when QLinearConv supports 16-bit.
+  // 4-bit weights are widened to 8 bits by the action, as QLinearConv takes 8-bit weights.
   std::vector<const char*> providers = {kCpuExecutionProvider, kDmlExecutionProvider};
   std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::ConvSelector>(is_int8_allowed,
                                                                                false,
-                                                                               false,
-                                                                               providers);
+                                                                               true,
+                                                                               providers,
+                                                                               true);
 
   qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
                                                          {{"Conv", {}}},
@@ -359,6 +401,7 @@ SelectorActionRegistry CreateSelectorActionRegistry(
   DropQDQNodesRules(qdq_selector_action_registry);
   DropDQNodesRules(qdq_selector_action_registry);
   UnaryOpQDQRules(qdq_selector_action_registry);
+  UnaryLookupTableOpQDQRules(qdq_selector_action_registry);
   BinaryOpQDQRules(qdq_selector_action_registry);
   VariadicOpQDQRules(qdq_selector_action_registry);
   ConvQDQRules(qdq_selector_action_registry, is_int8_allowed);
@@ -25,6 +25,36 @@ constexpr bool Is4BitIntType(int32_t data_type) {
          (data_type == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT4);
 }
 
+// Whether the 4-bit weight of the DQ node can be widened to 8 bits for a QLinear op: the weight and zero point must be
+// constant, and quantized per tensor or per output channel rather than blockwise.
+bool CanWiden4BitWeight(const GraphViewer& graph_viewer, const Node& dq_node) {
+  const auto& input_defs = dq_node.InputDefs();
+  if (!graph_viewer.GetConstantInitializer(input_defs[0]->Name(), true) ||
+      (input_defs.size() == 3 && input_defs[2]->Exists() &&
+       !graph_viewer.GetConstantInitializer(input_defs[2]->Name(), true))) {
+    return false;
+  }
+
+  const auto& dq_attrs = dq_node.GetAttributes();
+  if (const auto block_size = dq_attrs.find("block_size");
+      block_size != dq_attrs.end() && block_size->second.i() != 0) {
+    return false;
+  }
+
+  const auto* scale_shape = input_defs[1]->Shape();
+  if (scale_shape == nullptr) {
+    return false;
+  }
+
+  if (scale_shape->dim_size() == 0 || (scale_shape->dim_size() == 1 && scale_shape->dim(0).has_dim_value() &&
+                                       scale_shape->dim(0).dim_value() == 1)) {
+    return true;  // per tensor
+  }
+
+  const auto axis = dq_attrs.find("axis");
+  return axis != dq_attrs.end() && axis->second.i() == 0;
+}
+
 // adjust for an optional input/output that has an entry but does not exist
 int NumActualValues(const Node& node, bool input) {
   const auto& defs = input ? node.InputDefs() : node.OutputDefs();
@@ -352,6 +382,10 @@ bool ConvNodeGroupSelector::Check(const GraphViewer& graph_viewer,
     return false;
   }
 
+  if (widen_4bit_weight_ && Is4BitIntType(dt_weight) && !CanWiden4BitWeight(graph_viewer, *dq_nodes[1])) {
+    return false;
+  }
+
   if (dt_input == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT8) {
     if (!int8_allowed_ || dt_weight != dt_input) {
       return false;
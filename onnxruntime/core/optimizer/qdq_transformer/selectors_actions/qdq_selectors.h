@@ -145,8 +145,14 @@ class SplitNodeGroupSelector : public NodeGroupSelector {
 class ConvNodeGroupSelector : public NodeGroupSelector {
  public:
   // default to 'true'
-  ConvNodeGroupSelector(bool int8_allowed = true, bool allow_16bit = true, bool allow_4bit_weight = true)
-      : int8_allowed_(int8_allowed), allow_16bit_(allow_16bit), allow_4bit_weight_(allow_4bit_weight) {}
+  // widen_4bit_weight: 4-bit weights are widened to 8 bits when the group is replaced, so they must be constant and
+  // quantized per tensor or per output channel.
+  ConvNodeGroupSelector(bool int8_allowed = true, bool allow_16bit = true, bool allow_4bit_weight = true,
+                        bool widen_4bit_weight = false)
+      : int8_allowed_(int8_allowed),
+        allow_16bit_(allow_16bit),
+        allow_4bit_weight_(allow_4bit_weight),
+        widen_4bit_weight_(widen_4bit_weight) {}
 
  private:
   bool Check(const GraphViewer& graph_viewer, const Node& node,
@@ -156,6 +162,7 @@ class ConvNodeGroupSelector : public NodeGroupSelector {
   bool int8_allowed_;
   bool allow_16bit_;
   bool allow_4bit_weight_;
+  bool widen_4bit_weight_;
 };
 
 class WhereNodeGroupSelector : public NodeGroupSelector {
@@ -359,8 +366,9 @@ class SplitSelector : public BaseSelector {
 class ConvSelector : public BaseSelector {
  public:
   ConvSelector(bool int8_allowed = false, bool allow_16bit = false, bool allow_4bit_weight = false,
-               gsl::span<const char*> compatible_providers = {})
-      : BaseSelector(std::make_unique<ConvNodeGroupSelector>(int8_allowed, allow_16bit, allow_4bit_weight),
+               gsl::span<const char*> compatible_providers = {}, bool widen_4bit_weight = false)
+      : BaseSelector(std::make_unique<ConvNodeGroupSelector>(int8_allowed, allow_16bit, allow_4bit_weight,
+                                                             widen_4bit_weight),
                      compatible_providers) {}
 
   void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
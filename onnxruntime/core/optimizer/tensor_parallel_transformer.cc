@@ -0,0 +1,230 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/tensor_parallel_transformer.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/node_attr_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Prefix of the sharded initializers. Weights with it are not sharded again when the transformer is re-applied.
+constexpr const char* kShardPrefix = "TensorParallel_";
+
+bool IsShardedInitializer(const std::string& name) {
+  return name.rfind(kShardPrefix, 0) == 0;
+}
+
+// Returns the constant initializer `name` if it can be sharded along `axis` over `world_size` ranks.
+const TensorProto* GetShardableInitializer(const Graph& graph, const std::string& name, size_t rank, int axis,
+                                           int64_t world_size) {
+  if (IsShardedInitializer(name) || graph.GetConsumerNodes(name).size() != 1) {
+    return nullptr;
+  }
+
+  const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, name, false);
+  if (tensor_proto == nullptr || static_cast<size_t>(tensor_proto->dims_size()) != rank) {
+    return nullptr;
+  }
+
+  const auto data_type = tensor_proto->data_type();
+  if (data_type != TensorProto_DataType_FLOAT && data_type != TensorProto_DataType_FLOAT16 &&
+      data_type != TensorProto_DataType_DOUBLE) {
+    return nullptr;
+  }
+
+  const int64_t dim = tensor_proto->dims(axis);
+  return dim >= world_size && dim % world_size == 0 ? tensor_proto : nullptr;
+}
+
+// Replaces the input `input_index` of `node` by the part of `tensor_proto` that `rank` owns when its dimension `axis`
+// is split evenly over `world_size` ranks.
+void ShardNodeInput(Graph& graph, Node& node, int input_index, const TensorProto& tensor_proto, int axis,
+                    int64_t rank, int64_t world_size) {
+  const std::string name = tensor_proto.name();
+  Initializer initializer{tensor_proto, graph.ModelPath()};
+  const auto dims = initializer.dims();
+  const auto bytes = initializer.DataAsByteSpan();
+
+  size_t outer_size = 1;
+  for (int i = 0; i < axis; ++i) {
+    outer_size *= narrow<size_t>(dims[i]);
+  }
+  size_t inner_bytes = bytes.size() / initializer.size();
+  for (size_t i = axis + 1; i < dims.size(); ++i) {
+    inner_bytes *= narrow<size_t>(dims[i]);
+  }
+
+  const int64_t shard_dim = dims[axis] / world_size;
+  const size_t shard_bytes = narrow<size_t>(shard_dim) * inner_bytes;
+  const size_t stride_bytes = narrow<size_t>(dims[axis]) * inner_bytes;
+  std::vector<uint8_t> shard_data;
+  shard_data.reserve(outer_size * shard_bytes);
+  for (size_t i = 0; i < outer_size; ++i) {
+    const uint8_t* begin = bytes.data() + i * stride_bytes + narrow<size_t>(rank) * shard_bytes;
+    shard_data.insert(shard_data.end(), begin, begin + shard_bytes);
+  }
+
+  TensorProto shard;
+  shard.set_name(graph.GenerateNodeArgName(kShardPrefix + name));
+  shard.set_data_type(tensor_proto.data_type());
+  for (size_t i = 0; i < dims.size(); ++i) {
+    shard.add_dims(static_cast<int>(i) == axis ? shard_dim : dims[i]);
+  }
+  utils::SetRawDataInTensorProto(shard, shard_data.data(), shard_data.size());
+
+  NodeArg& shard_arg = graph_utils::AddInitializer(graph, shard);
+  graph_utils::ReplaceNodeInput(node, input_index, shard_arg);
+  graph.RemoveInitializedTensor(name);
+}
+
+// Makes `node` produce a partial result consumed by a new collective node that takes over the original output.
+void InsertCollectiveAfter(Graph& graph, Node& node, const std::string& op_type, NodeAttributes attributes) {
+  NodeArg* output = node.MutableOutputDefs()[0];
+  TypeProto partial_type;
+  partial_type.mutable_tensor_type()->set_elem_type(output->TypeAsProto()->tensor_type().elem_type());
+  NodeArg& partial = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name() + "_partial"), &partial_type);
+
+  Node& collective = graph.AddNode(graph.GenerateNodeName(node.Name() + "_" + op_type), op_type,
+                                   "Tensor parallel " + op_type, {&partial}, {output}, &attributes, kMSDomain);
+  collective.SetExecutionProviderType(node.GetExecutionProviderType());
+
+  const auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(node, 0);
+  graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+  node.MutableOutputDefs()[0] = &partial;
+  graph.AddEdge(node.Index(), collective.Index(), 0, 0);
+  for (const auto& edge : output_edges) {
+    graph.AddEdge(collective.Index(), edge.dst_node, 0, edge.dst_arg_index);
+  }
+}
+
+bool IsMatMul(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13});
+}
+
+// Activations that are applied per element, so they can run on a column shard.
+bool IsElementwiseActivation(const Node& node) {
+  int input_count = 0;
+  for (const auto* input : node.InputDefs()) {
+    input_count += input->Exists() ? 1 : 0;
+  }
+
+  if (input_count != 1) {
+    // e.g. FastGelu with a bias
+    return false;
+  }
+
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {20}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "FastGelu", {1}, kMSDomain) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "QuickGelu", {1}, kMSDomain);
+}
+
+Node* GetOnlyConsumer(Graph& graph, const Node& node) {
+  if (!optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+    return nullptr;
+  }
+
+  return graph.GetNode(node.OutputNodesBegin()->Index());
+}
+
+}  // namespace
+
+Status TensorParallelTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                            const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr) {
+      continue;  // node was removed
+    }
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsMatMul(node) || !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const TensorProto* weight = GetShardableInitializer(graph, node.InputDefs()[1]->Name(), 2, 1, world_size_);
+    if (weight == nullptr) {
+      continue;
+    }
+
+    // Look for the second half of a Megatron style pair: an optional bias, an activation and a MatMul whose weight
+    // rows match the columns of this one.
+    const int64_t column_count = weight->dims(1);
+    Node* bias_add = nullptr;
+    const TensorProto* bias = nullptr;
+    int bias_index = 0;
+    Node* activation = nullptr;
+    Node* row_matmul = nullptr;
+    const TensorProto* row_weight = nullptr;
+    Node* next = GetOnlyConsumer(graph, node);
+    if (next != nullptr && graph_utils::IsSupportedOptypeVersionAndDomain(*next, "Add", {7, 13, 14})) {
+      bias_index = next->InputDefs()[0] == node.OutputDefs()[0] ? 1 : 0;
+      bias = GetShardableInitializer(graph, next->InputDefs()[bias_index]->Name(), 1, 0, world_size_);
+      if (bias != nullptr && bias->dims(0) == column_count) {
+        bias_add = next;
+        next = GetOnlyConsumer(graph, *next);
+      }
+    }
+    if (next != nullptr && IsElementwiseActivation(*next)) {
+      activation = next;
+      next = GetOnlyConsumer(graph, *next);
+      if (next != nullptr && IsMatMul(*next) && next->InputDefs()[0] == activation->OutputDefs()[0]) {
+        row_weight = GetShardableInitializer(graph, next->InputDefs()[1]->Name(), 2, 0, world_size_);
+        if (row_weight != nullptr && row_weight->dims(0) == column_count) {
+          row_matmul = next;
+        }
+      }
+    }
+
+    NodeAttributes attributes;
+    if (row_matmul != nullptr) {
+      ShardNodeInput(graph, node, 1, *weight, 1, rank_, world_size_);
+      node.MutableOutputDefs()[0]->ClearShape();
+      if (bias_add != nullptr) {
+        ShardNodeInput(graph, *bias_add, bias_index, *bias, 0, rank_, world_size_);
+        bias_add->MutableOutputDefs()[0]->ClearShape();
+      }
+      activation->MutableOutputDefs()[0]->ClearShape();
+      ShardNodeInput(graph, *row_matmul, 1, *row_weight, 0, rank_, world_size_);
+      InsertCollectiveAfter(graph, *row_matmul, "AllReduce", attributes);
+      LOGS(logger, VERBOSE) << "Sharded MatMul pair " << node.Name() << " and " << row_matmul->Name()
+                            << " over " << world_size_ << " ranks";
+    } else {
+      // AllGather needs the rank of the output to concatenate along its last axis.
+      const auto* output_shape = node.OutputDefs()[0]->Shape();
+      if (output_shape == nullptr || output_shape->dim_size() < 1) {
+        continue;
+      }
+
+      utils::SetNodeAttribute(utils::MakeAttribute("axis", static_cast<int64_t>(output_shape->dim_size() - 1)),
+                              attributes);
+      utils::SetNodeAttribute(utils::MakeAttribute("group_size", world_size_), attributes);
+      ShardNodeInput(graph, node, 1, *weight, 1, rank_, world_size_);
+      InsertCollectiveAfter(graph, node, "AllGather", attributes);
+      LOGS(logger, VERBOSE) << "Sharded the weight columns of MatMul " << node.Name() << " over " << world_size_
+                            << " ranks";
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TensorParallelTransformer
+
+Shards the constant weights of MatMul nodes over the ranks of a tensor parallel group and inserts the collectives
+that restore the full result, so each rank only stores and computes its share of the weights.
+
+  - MatMul -> [Add(bias)] -> activation -> MatMul, with constant weights W1 [K, N] and W2 [N, M], is split in the
+    Megatron way: rank r keeps the columns [r * N / world_size, (r + 1) * N / world_size) of W1 and the bias and the
+    matching rows of W2, and an AllReduce sums the partial results of the second MatMul.
+  - Any other MatMul with a constant 2D weight keeps its share of the weight columns and an AllGather along the last
+    axis concatenates the partial results of all ranks.
+
+Weights are only sharded if the sharded dimension is divisible by world_size and the weight has no other consumer.
+Every rank must load the same model with the same world_size and run it concurrently with the other ranks.
+*/
+class TensorParallelTransformer : public GraphTransformer {
+ public:
+  TensorParallelTransformer(int64_t rank, int64_t world_size,
+                            const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TensorParallelTransformer", compatible_execution_providers),
+        rank_(rank),
+        world_size_(world_size) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  int64_t rank_;
+  int64_t world_size_;
+};
+
+}  // namespace onnxruntime
@@ -2682,7 +2682,10 @@ bool ProcessTranspose(OptimizerCtx& ctx, api::NodeRef& transpose, api::NodeRef&
 
   CostCheckResult cost = CostCheckResult::kFallThrough;
 
-  if (ctx.cost_check_fn) {
+  if (auto assigned = ctx.assigned_perms.find(node.Id());
+      assigned != ctx.assigned_perms.end() && assigned->second == perm) {
+    cost = CostCheckResult::kPushTranspose;
+  } else if (ctx.cost_check_fn) {
     cost = ctx.cost_check_fn(ctx.graph, node, perm, outputs_leading_to_transpose);
   }
 
@@ -2722,7 +2725,7 @@ std::optional<OptimizerCtx> MakeOptimizerContext(api::GraphRef& graph,
     return std::nullopt;
   }
 
-  OptimizerCtx ctx{*opset, graph, provider_type, cost_check_fn, extended_handlers};
+  OptimizerCtx ctx{*opset, graph, provider_type, cost_check_fn, extended_handlers, {}};
   return ctx;
 }
 
@@ -3142,6 +3145,150 @@ static bool TryConstantFoldNode(OptimizerCtx& ctx, api::NodeRef& node) {
 
 // Performs optimization. General algorithm: iterate over nodes in topological order. If a node has a transpose
 // as input, push it through if the transpose cost does not increase and is likely to decrease.
+/////// <Layout Assignment> ///////
+// The handlers decide whether to push a Transpose one node at a time, looking only at the inputs of the node and
+// whether its output leads to another Transpose. A Transpose whose removal requires pushing it through a branch merge
+// or a chain of nodes before it cancels may be left where it is, as every single step looks like a loss.
+//
+// Before the handlers run we take a global view. Starting from each Transpose we grow the region of nodes it can be
+// pushed through without changing the perm, and estimate the cost of the whole region using the layout of the
+// Transpose input instead of the current one: the transposes created at the boundary of the region minus the ones
+// that cancel. If that is lower than the cost of the current layout, the nodes of the region are assigned the perm,
+// and ProcessTranspose pushes the Transpose through them without a cost check of its own. The handlers then do the
+// rewriting and the cancellation as usual.
+
+// Maximum number of nodes of a region, to bound the time taken by a large graph.
+constexpr size_t kMaxLayoutRegionSize = 1000;
+
+// Returns true if the handler pushes the Transpose through the node with the same perm, e.g. not Squeeze or Reshape.
+static bool HandlerPreservesPerm(const HandlerInfo& info) {
+  return info.transposes_outputs &&
+         (info.handler_fn == &HandleSimpleNode || info.handler_fn == &HandleSimpleNodeBroadcast ||
+          info.handler_fn == &HandleConcat || info.handler_fn == &HandleSplit ||
+          info.handler_fn == &HandleSoftHardMax || info.handler_fn == &HandlePad ||
+          info.handler_fn == &HandleSlice || info.handler_fn == &HandleTile ||
+          info.handler_fn == &HandleQuantizeDequantizeLinear);
+}
+
+static void AssignLayoutFromTranspose(OptimizerCtx& ctx, api::NodeRef& transpose,
+                                      const std::unordered_set<std::string>& outputs_leading_to_transpose) {
+  std::optional<std::vector<int64_t>> perm = GetPermAttrIfValid(transpose);
+  if (perm == std::nullopt || IsIdentityPerm(*perm)) {
+    return;
+  }
+
+  const std::vector<int64_t> perm_inv = InvertPerm(*perm);
+  const auto& graph = ctx.graph;
+
+  // nodes of the region by id, with the input indices that the handler transposes
+  std::unordered_map<int64_t, std::vector<size_t>> region;
+  // values that will be in the layout of the Transpose input, i.e. are transposed by perm_inv relative to now
+  std::vector<std::string> permuted_values{std::string(transpose.Outputs()[0])};
+  std::unordered_set<std::string> permuted_value_set{permuted_values[0]};
+
+  // Removing the Transpose gains its cost.
+  int cost = -EstimateValueRank(graph, permuted_values[0]);
+
+  for (size_t i = 0; i < permuted_values.size(); ++i) {
+    auto consumers = graph.GetValueConsumers(permuted_values[i]);
+    for (auto& consumer : consumers->nodes) {
+      if (region.find(consumer->Id()) != region.end() || consumer->IsOp("Transpose")) {
+        continue;
+      }
+
+      const HandlerInfo* info = GetHandler(*consumer, ctx.extended_handlers);
+      if (info == nullptr || !HandlerPreservesPerm(*info) || !CanModifyNode(ctx, *consumer) ||
+          region.size() == kMaxLayoutRegionSize) {
+        continue;
+      }
+
+      std::vector<size_t> input_indices = info->transposible_inputs_fn(ctx, *consumer);
+      auto inputs = consumer->Inputs();
+      const bool consumes_as_transposible_input =
+          std::any_of(input_indices.begin(), input_indices.end(), [&](size_t j) {
+            return permuted_value_set.count(std::string(inputs[j])) != 0;
+          });
+
+      if (!consumes_as_transposible_input ||
+          (ctx.cost_check_fn &&
+           ctx.cost_check_fn(graph, *consumer, *perm, outputs_leading_to_transpose) == CostCheckResult::kStop)) {
+        continue;
+      }
+
+      // The other inputs get a Transpose, which is free for constants and cancels a Transpose with the same perm.
+      for (size_t j : input_indices) {
+        if (permuted_value_set.count(std::string(inputs[j])) == 0) {
+          cost += EstimateTransposeValueCost(graph, inputs[j], *perm, ctx.extended_handlers);
+        }
+      }
+
+      for (auto output : consumer->Outputs()) {
+        if (permuted_value_set.insert(std::string(output)).second) {
+          permuted_values.emplace_back(output);
+        }
+      }
+
+      region.emplace(consumer->Id(), std::move(input_indices));
+    }
+  }
+
+  if (region.empty()) {
+    return;
+  }
+
+  // A permuted value needs a Transpose back to the current layout if it is consumed outside of the region, and
+  // cancels the Transposes consuming it that have the inverse perm.
+  for (const auto& value : permuted_values) {
+    auto consumers = graph.GetValueConsumers(value);
+    bool needs_transpose = !consumers->comprehensive;
+    for (auto& consumer : consumers->nodes) {
+      if (consumer->IsOp("Transpose")) {
+        if (GetPermAttrIfValid(*consumer) == perm_inv) {
+          cost -= EstimateValueRank(graph, value);
+        }
+
+        continue;
+      }
+
+      auto in_region = region.find(consumer->Id());
+      if (in_region == region.end()) {
+        needs_transpose = true;
+        continue;
+      }
+
+      // an input the handler doesn't transpose consumes the value in the current layout
+      auto inputs = consumer->Inputs();
+      for (size_t j = 0; j < inputs.size(); ++j) {
+        if (inputs[j] == value &&
+            std::find(in_region->second.begin(), in_region->second.end(), j) == in_region->second.end()) {
+          needs_transpose = true;
+        }
+      }
+    }
+
+    if (needs_transpose) {
+      cost += EstimateValueRank(graph, value);
+    }
+  }
+
+  if (cost < 0) {
+    for (const auto& [id, input_indices] : region) {
+      ctx.assigned_perms.emplace(id, *perm);
+    }
+  }
+}
+
+// Assigns the layout of the regions of nodes that are worth pushing a Transpose through as a whole.
+static void AssignLayouts(OptimizerCtx& ctx, const std::vector<std::unique_ptr<api::NodeRef>>& nodes,
+                          const std::unordered_set<std::string>& outputs_leading_to_transpose) {
+  for (const auto& node : nodes) {
+    if (node->IsOp("Transpose") && CanModifyNode(ctx, *node)) {
+      AssignLayoutFromTranspose(ctx, *node, outputs_leading_to_transpose);
+    }
+  }
+}
+/////// </Layout Assignment> ///////
+
 OptimizeResult OptimizeImpl(OptimizerCtx& ctx) {
   OptimizeResult result{};
   const std::vector<std::unique_ptr<api::NodeRef>> nodes = ctx.graph.Nodes();
@@ -3173,6 +3320,8 @@ OptimizeResult OptimizeImpl(OptimizerCtx& ctx) {
     }
   }
 
+  AssignLayouts(ctx, nodes, outputs_leading_to_transpose);
+
   bool changed = false;
   bool have_dq = false;
 
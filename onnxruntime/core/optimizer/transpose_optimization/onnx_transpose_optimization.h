@@ -52,6 +52,10 @@ struct OptimizerCtx {
   // Handlers for ops that are not in the ONNX opset, or for ONNX ops where special handling is required.
   // If a handler is not found in this map, the default handlers will be used.
   const HandlerMap& extended_handlers;
+
+  // Perm of the Transpose that the layout assignment decided to push through a node, by node id. Pushing it is
+  // beneficial for the region of nodes as a whole even where the cost check of the single node says otherwise.
+  std::unordered_map<int64_t, std::vector<int64_t>> assigned_perms;
 };
 
 /// <summary>
@@ -91,6 +91,14 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // If true, TryParallelFor records the observed execution time per unit of work for each call site and uses it
+  // instead of the kernel provided TensorOpCost when deciding whether and how finely to split the loop.
+  bool adaptive_cost_model = false;
+
+  // If true, each worker sizes its spin budget from how long it recently waited for work, instead of always spinning
+  // for the full fixed count before blocking. Only applies if spinning is allowed.
+  bool adaptive_spinning = false;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -147,6 +155,22 @@ class Env {
 
   virtual std::vector<LogicalProcessors> GetDefaultThreadAffinities() const = 0;
 
+  /// <summary>
+  /// Returns one entry per physical core of the given NUMA node, in the same form as GetDefaultThreadAffinities().
+  /// Threads pinned to these affinities first-touch the memory they allocate on that node.
+  /// </summary>
+  /// <returns>The affinities, or an empty vector if the node does not exist or NUMA topology information
+  /// is not available on this platform.</returns>
+  virtual std::vector<LogicalProcessors> GetNumaNodeThreadAffinities(int /*numa_node*/) const { return {}; }
+
+  /// <summary>
+  /// Returns one entry per physical core of the highest performance class (e.g. the P-cores of an Intel hybrid CPU or
+  /// the big cores of an Arm big.LITTLE design), in the same form as GetDefaultThreadAffinities().
+  /// </summary>
+  /// <returns>The affinities, or an empty vector if all cores are of the same class or the core classes cannot be
+  /// determined on this platform.</returns>
+  virtual std::vector<LogicalProcessors> GetPerformanceCoreThreadAffinities() const { return {}; }
+
   virtual int GetL2CacheSize() const = 0;
 
   /// \brief Returns the number of micro-seconds since the Unix epoch.
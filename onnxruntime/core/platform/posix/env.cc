@@ -31,6 +31,7 @@ limitations under the License.
 #endif
 #include <unistd.h>
 
+#include <algorithm>
 #include <iostream>
 #include <optional>
 #include <thread>
@@ -55,6 +56,7 @@ limitations under the License.
 #include "core/common/narrow.h"
 #include "core/platform/scoped_resource.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
+#include "core/platform/posix/io_uring_file_reader.h"
 
 namespace onnxruntime {
 
@@ -117,6 +119,77 @@ int nftw_remove(
   return result;
 }
 
+#if defined(__linux__)
+// Reads a cpu list in the sysfs format (e.g. "0-3,8,10-11") from the given file.
+// Returns an empty vector if the file doesn't exist.
+std::vector<int> ReadSysfsCpuList(const std::string& path) {
+  std::vector<int> cpus;
+  FILE* file = fopen(path.c_str(), "r");
+  if (file == nullptr) {
+    return cpus;
+  }
+
+  char buffer[4096];
+  const bool read_ok = fgets(buffer, sizeof(buffer), file) != nullptr;
+  fclose(file);
+  if (!read_ok) {
+    return cpus;
+  }
+
+  const char* cur = buffer;
+  while (*cur != '\0' && *cur != '\n') {
+    char* end = nullptr;
+    const long first = strtol(cur, &end, 10);
+    if (end == cur) {
+      return {};
+    }
+
+    long last = first;
+    cur = end;
+    if (*cur == '-') {
+      ++cur;
+      last = strtol(cur, &end, 10);
+      if (end == cur || last < first) {
+        return {};
+      }
+      cur = end;
+    }
+
+    for (long cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(static_cast<int>(cpu));
+    }
+
+    if (*cur == ',') {
+      ++cur;
+    }
+  }
+
+  return cpus;
+}
+
+// Reads the cpu list of the given NUMA node. Returns an empty vector if the node doesn't exist.
+std::vector<int> ReadNumaNodeCpuList(int numa_node) {
+  return ReadSysfsCpuList("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+}
+
+// Reads the relative compute capacity the scheduler assigns to a logical processor, which is how Arm big.LITTLE
+// designs expose their core classes. Returns -1 if it's not available.
+long ReadCpuCapacity(int cpu) {
+  const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpu_capacity";
+  FILE* file = fopen(path.c_str(), "r");
+  if (file == nullptr) {
+    return -1;
+  }
+
+  long capacity = -1;
+  if (fscanf(file, "%ld", &capacity) != 1) {
+    capacity = -1;
+  }
+  fclose(file);
+  return capacity;
+}
+#endif
+
 template <typename T>
 struct Freer {
   void operator()(T* p) { ::free(p); }
@@ -308,12 +381,92 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  std::vector<LogicalProcessors> GetNumaNodeThreadAffinities(int numa_node) const override {
+    std::vector<LogicalProcessors> ret;
+#if defined(__linux__)
+    if (numa_node < 0) {
+      return ret;
+    }
+
+    const std::vector<int> node_cpus = ReadNumaNodeCpuList(numa_node);
+    if (node_cpus.empty()) {
+      return ret;
+    }
+
+    // keep the physical cores that belong to the node so there is one thread per core as in the default setting
+    for (auto& core_affinity : GetDefaultThreadAffinities()) {
+      if (!core_affinity.empty() &&
+          std::find(node_cpus.begin(), node_cpus.end(), core_affinity.front()) != node_cpus.end()) {
+        ret.push_back(std::move(core_affinity));
+      }
+    }
+
+    // without core topology information, use one thread per logical processor of the node
+    if (ret.empty()) {
+      ret.reserve(node_cpus.size());
+      for (int cpu : node_cpus) {
+        ret.push_back(LogicalProcessors{cpu});
+      }
+    }
+#else
+    ORT_UNUSED_PARAMETER(numa_node);
+#endif
+    return ret;
+  }
+
+  std::vector<LogicalProcessors> GetPerformanceCoreThreadAffinities() const override {
+    std::vector<LogicalProcessors> ret;
+#if defined(__linux__)
+    std::vector<LogicalProcessors> cores = GetDefaultThreadAffinities();
+    if (std::any_of(cores.begin(), cores.end(), [](const LogicalProcessors& core) { return core.empty(); })) {
+      // without core topology information, consider each logical processor on its own
+      const int num_cpus = static_cast<int>(std::thread::hardware_concurrency());
+      cores.clear();
+      for (int cpu = 0; cpu < num_cpus; ++cpu) {
+        cores.push_back(LogicalProcessors{cpu});
+      }
+    }
+
+    // Intel hybrid CPUs register separate PMUs for their P-cores and E-cores
+    const std::vector<int> p_core_cpus = ReadSysfsCpuList("/sys/devices/cpu_core/cpus");
+    if (!p_core_cpus.empty() && !ReadSysfsCpuList("/sys/devices/cpu_atom/cpus").empty()) {
+      for (auto& core : cores) {
+        if (std::find(p_core_cpus.begin(), p_core_cpus.end(), core.front()) != p_core_cpus.end()) {
+          ret.push_back(std::move(core));
+        }
+      }
+      return ret;
+    }
+
+    // otherwise keep the cores with the highest capacity, if the capacities differ
+    std::vector<long> capacities;
+    capacities.reserve(cores.size());
+    for (const auto& core : cores) {
+      capacities.push_back(ReadCpuCapacity(core.front()));
+    }
+    const auto [min_capacity, max_capacity] = std::minmax_element(capacities.begin(), capacities.end());
+    if (capacities.empty() || *min_capacity < 0 || *min_capacity == *max_capacity) {
+      return ret;
+    }
+    for (size_t i = 0; i < cores.size(); ++i) {
+      if (capacities[i] == *max_capacity) {
+        ret.push_back(std::move(cores[i]));
+      }
+    }
+#endif
+    return ret;
+  }
+
   int GetL2CacheSize() const override {
 #ifdef _SC_LEVEL2_CACHE_SIZE
     return static_cast<int>(sysconf(_SC_LEVEL2_CACHE_SIZE));
 #else
     int value = 0;  // unknown
-#if (defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__)) && defined(HW_L2CACHESIZE)
+#if defined(__EMSCRIPTEN__)
+    // The cache of the host can't be queried from WebAssembly. Assume a common L2 size so that the cache blocked
+    // kernels, such as MlasFlashAttention, are still used.
+    value = 256 * 1024;
+#elif (defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__)) && defined(HW_L2CACHESIZE)
     int mib[2] = {CTL_HW, HW_L2CACHESIZE};
     size_t len = sizeof(value);
     if (sysctl(mib, 2, &value, &len, NULL, 0) < 0) {
@@ -392,6 +545,20 @@ class PosixEnv : public Env {
     if (length == 0)
       return Status::OK();
 
+    // keep several reads in flight for large reads, e.g. of external initializers, to use the device's bandwidth
+    constexpr size_t k_min_bytes_for_async_read = 16 * 1024 * 1024;
+    if (length >= k_min_bytes_for_async_read) {
+      bool read_async = false;
+      const Status status = ReadFileWithIoUring(file_descriptor.Get(), offset, length, buffer.data(), read_async);
+      if (!status.IsOK()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ReadFileIntoBuffer failed. File: ", file_path, ", offset: ", offset,
+                               ", length: ", length, ". ", status.ErrorMessage());
+      }
+      if (read_async) {
+        return Status::OK();
+      }
+    }
+
     if (offset > 0) {
       const FileOffsetType seek_result = lseek(file_descriptor.Get(), offset, SEEK_SET);
       if (seek_result == -1) {
@@ -0,0 +1,269 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/posix/io_uring_file_reader.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define ORT_HAS_IO_URING
+#endif
+#endif
+#endif
+
+#if defined(ORT_HAS_IO_URING)
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+#endif
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+#if defined(ORT_HAS_IO_URING)
+
+namespace {
+
+// the number of reads in flight, and the size of each of them
+constexpr unsigned kQueueDepth = 8;
+constexpr size_t kReadSize = size_t{4} * 1024 * 1024;
+
+// set once io_uring_setup fails, so it isn't tried for every read
+std::atomic<bool> io_uring_unavailable{false};
+
+// the submission and completion queues of an io_uring instance, mapped from the kernel
+class IoUring {
+ public:
+  ~IoUring() {
+    if (sqes_ != MAP_FAILED) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_ != MAP_FAILED) {
+      munmap(sq_ring_, sq_ring_size_);
+    }
+    if (ring_fd_ >= 0) {
+      close(ring_fd_);
+    }
+  }
+
+  // returns false if io_uring is not available
+  bool Setup() {
+    io_uring_params params{};
+    ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, kQueueDepth, &params));
+    if (ring_fd_ < 0) {
+      return false;
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = false;
+#if defined(IORING_FEAT_SINGLE_MMAP)
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+    if (single_mmap) {
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                    IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+      return false;
+    }
+    cq_ring_ = single_mmap ? sq_ring_
+                           : mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                  ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      return false;
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sqes_ == MAP_FAILED) {
+      return false;
+    }
+
+    auto* sq = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    auto* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  // queue a read of `iov` at `offset` of `fd`. it is submitted by the next call to SubmitAndWait.
+  void QueueRead(int fd, const iovec* iov, off_t offset, uint64_t user_data) {
+    const unsigned index = sq_tail_local_ & sq_mask_;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->off = static_cast<uint64_t>(offset);
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = 1;
+    sqe->user_data = user_data;
+    sq_array_[index] = index;
+    ++sq_tail_local_;
+  }
+
+  // submit the queued reads and wait for at least one of them to complete. returns the errno of a failure.
+  int SubmitAndWait() {
+    __atomic_store_n(sq_tail_, sq_tail_local_, __ATOMIC_RELEASE);
+    while (true) {
+      const unsigned to_submit = sq_tail_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+      const long result = syscall(__NR_io_uring_enter, ring_fd_, to_submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (result >= 0) {
+        return 0;
+      }
+      if (errno != EINTR) {
+        return errno;
+      }
+    }
+  }
+
+  // call `fn` with the user data and the result of each completed read
+  template <typename TFn>
+  void ForEachCompletion(TFn&& fn) {
+    unsigned head = *cq_head_;
+    while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+      const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      fn(cqe.user_data, cqe.res);
+      ++head;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+ private:
+  int ring_fd_ = -1;
+  void* sq_ring_ = MAP_FAILED;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = MAP_FAILED;
+  size_t cq_ring_size_ = 0;
+  void* sqes_ = MAP_FAILED;
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned* sq_array_ = nullptr;
+  // the tail of the submission queue including the reads that are queued but not submitted yet
+  unsigned sq_tail_local_ = 0;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+};
+
+}  // namespace
+
+Status ReadFileWithIoUring(int fd, off_t offset, size_t length, char* buffer, bool& read) {
+  read = false;
+  if (io_uring_unavailable.load(std::memory_order_relaxed)) {
+    return Status::OK();
+  }
+
+  IoUring ring;
+  if (!ring.Setup()) {
+    io_uring_unavailable.store(true, std::memory_order_relaxed);
+    return Status::OK();
+  }
+
+  // the part of the file each slot reads. a slot is reused once its read completes.
+  std::vector<iovec> slots(kQueueDepth);
+  std::vector<off_t> slot_offsets(kQueueDepth);
+  std::vector<unsigned> free_slots;
+  for (unsigned slot = kQueueDepth; slot > 0; --slot) {
+    free_slots.push_back(slot - 1);
+  }
+
+  size_t next_read = 0;
+  size_t bytes_read = 0;
+  unsigned in_flight = 0;
+  int error = 0;
+  bool unexpected_end_of_file = false;
+  // after a failure the reads in flight are waited for, as they write to `buffer`
+  while (in_flight > 0 || (error == 0 && !unexpected_end_of_file && bytes_read < length)) {
+    while (error == 0 && !unexpected_end_of_file && next_read < length && !free_slots.empty()) {
+      const unsigned slot = free_slots.back();
+      free_slots.pop_back();
+      const size_t size = std::min(kReadSize, length - next_read);
+      slots[slot] = iovec{buffer + next_read, size};
+      slot_offsets[slot] = offset + static_cast<off_t>(next_read);
+      ring.QueueRead(fd, &slots[slot], slot_offsets[slot], slot);
+      next_read += size;
+      ++in_flight;
+    }
+
+    const int enter_error = ring.SubmitAndWait();
+    if (enter_error != 0) {
+      // wait for the reads in flight before reporting the failure, unless waiting is what fails
+      const bool failed_before = error != 0;
+      error = enter_error;
+      if (in_flight == 0 || failed_before) {
+        break;
+      }
+      continue;
+    }
+
+    ring.ForEachCompletion([&](uint64_t user_data, int result) {
+      const auto slot = static_cast<unsigned>(user_data);
+      --in_flight;
+      if (result < 0) {
+        error = error != 0 ? error : -result;
+      } else if (result == 0) {
+        unexpected_end_of_file = true;
+      } else if (static_cast<size_t>(result) < slots[slot].iov_len) {
+        // a short read. read the rest of the slot's part again.
+        bytes_read += static_cast<size_t>(result);
+        slots[slot].iov_base = static_cast<char*>(slots[slot].iov_base) + result;
+        slots[slot].iov_len -= static_cast<size_t>(result);
+        slot_offsets[slot] += result;
+        if (error == 0 && !unexpected_end_of_file) {
+          ring.QueueRead(fd, &slots[slot], slot_offsets[slot], slot);
+          ++in_flight;
+          return;
+        }
+      } else {
+        bytes_read += static_cast<size_t>(result);
+      }
+      free_slots.push_back(slot);
+    });
+  }
+
+  if (error != 0) {
+    return common::Status(common::SYSTEM, error, std::string("io_uring read failed: ") + strerror(error));
+  }
+  if (unexpected_end_of_file) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unexpected end of file.");
+  }
+
+  read = true;
+  return Status::OK();
+}
+
+#else
+
+Status ReadFileWithIoUring(int /*fd*/, off_t /*offset*/, size_t /*length*/, char* /*buffer*/, bool& read) {
+  read = false;
+  return Status::OK();
+}
+
+#endif  // defined(ORT_HAS_IO_URING)
+
+}  // namespace onnxruntime
@@ -0,0 +1,23 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+
+#include <sys/types.h>
+
+#include "core/common/status.h"
+
+namespace onnxruntime {
+
+/**
+ * Read `length` bytes at `offset` of the file `fd` into `buffer` with several large reads in flight through io_uring,
+ * so a single thread keeps a fast storage device busy instead of waiting for each read to complete.
+ *
+ * Sets `read` to false and returns OK without reading if io_uring is not available, e.g. the kernel is older than
+ * 5.1 or a seccomp policy blocks it. The caller reads the file with blocking reads in that case.
+ */
+common::Status ReadFileWithIoUring(int fd, off_t offset, size_t length, char* buffer, bool& read);
+
+}  // namespace onnxruntime
@@ -16,11 +16,13 @@ limitations under the License.
 
 #include "core/platform/windows/env.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <optional>
 #include <string>
 #include <thread>
+#include <vector>
 #include <climits>
 #include <process.h>
 #include <fcntl.h>
@@ -65,6 +67,79 @@ std::wstring Basename(const std::wstring& path) {
   return path.substr(basename_index);
 }
 
+// read `length` bytes at `offset` of a file opened with FILE_FLAG_OVERLAPPED, with several reads in flight so a
+// single thread keeps a fast storage device busy instead of waiting for each read to complete.
+static Status ReadFileOverlapped(HANDLE file_handle, const std::wstring& file_path, FileOffsetType offset,
+                                 size_t length, char* buffer) {
+  constexpr size_t k_queue_depth = 8;
+  constexpr size_t k_read_size = 4 * 1024 * 1024;
+
+  struct Read {
+    OVERLAPPED overlapped;
+    wil::unique_event event;
+    DWORD size;
+  };
+  // the OVERLAPPED structures must not move while their reads are in flight
+  std::vector<Read> reads(k_queue_depth);
+  for (auto& read : reads) {
+    if (!read.event.try_create(wil::EventOptions::ManualReset, nullptr)) {
+      const auto error_code = GetLastError();
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "CreateEvent fail, errcode = ", error_code, " - ",
+                             std::system_category().message(error_code));
+    }
+  }
+
+  Status status;
+  size_t next_read = 0;
+  size_t first_in_flight = 0;
+  size_t num_in_flight = 0;
+  while (num_in_flight > 0 || (status.IsOK() && next_read < length)) {
+    // keep the queue full
+    while (status.IsOK() && next_read < length && num_in_flight < k_queue_depth) {
+      Read& read = reads[(first_in_flight + num_in_flight) % k_queue_depth];
+      read.size = static_cast<DWORD>(std::min(k_read_size, length - next_read));
+      const uint64_t position = static_cast<uint64_t>(offset) + next_read;
+      read.overlapped = OVERLAPPED{};
+      read.overlapped.Offset = static_cast<DWORD>(position);
+      read.overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+      read.overlapped.hEvent = read.event.get();
+      if (!ReadFile(file_handle, buffer + next_read, read.size, nullptr, &read.overlapped) &&
+          GetLastError() != ERROR_IO_PENDING) {
+        const auto error_code = GetLastError();
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ReadFile ", ToUTF8String(Basename(file_path)),
+                                 " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+        break;
+      }
+      next_read += read.size;
+      ++num_in_flight;
+    }
+
+    if (num_in_flight == 0) {
+      break;
+    }
+
+    // the reads complete in any order but are waited for in the order they were issued.
+    // after a failure the reads in flight are still waited for, as they write to `buffer`.
+    Read& read = reads[first_in_flight];
+    DWORD bytes_read = 0;
+    if (!GetOverlappedResult(file_handle, &read.overlapped, &bytes_read, TRUE)) {
+      const auto error_code = GetLastError();
+      if (status.IsOK()) {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ReadFile ", ToUTF8String(Basename(file_path)),
+                                 " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+      }
+    } else if (bytes_read != read.size && status.IsOK()) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ReadFile ", ToUTF8String(Basename(file_path)),
+                               " fail: unexpected end");
+    }
+
+    first_in_flight = (first_in_flight + 1) % k_queue_depth;
+    --num_in_flight;
+  }
+
+  return status;
+}
+
 class WindowsThread : public EnvThread {
  private:
   struct Param {
@@ -303,6 +378,24 @@ std::vector<LogicalProcessors> WindowsEnv::GetDefaultThreadAffinities() const {
   return cores_.empty() ? std::vector<LogicalProcessors>(DefaultNumCores(), LogicalProcessors{}) : cores_;
 }
 
+std::vector<LogicalProcessors> WindowsEnv::GetPerformanceCoreThreadAffinities() const {
+  std::vector<LogicalProcessors> ret;
+  if (core_efficiency_classes_.empty() || core_efficiency_classes_.size() != cores_.size()) {
+    return ret;
+  }
+  const auto [min_class, max_class] = std::minmax_element(core_efficiency_classes_.begin(),
+                                                          core_efficiency_classes_.end());
+  if (*min_class == *max_class) {
+    return ret;
+  }
+  for (size_t i = 0; i < cores_.size(); ++i) {
+    if (core_efficiency_classes_[i] == *max_class) {
+      ret.push_back(cores_[i]);
+    }
+  }
+  return ret;
+}
+
 int WindowsEnv::GetL2CacheSize() const {
   return l2_cache_size_;
 }
@@ -364,8 +457,16 @@ Status WindowsEnv::ReadFileIntoBuffer(_In_z_ const ORTCHAR_T* const file_path, c
   ORT_RETURN_IF_NOT(file_path, "file_path == nullptr");
   ORT_RETURN_IF_NOT(offset >= 0, "offset < 0");
   ORT_RETURN_IF_NOT(length <= buffer.size(), "length > buffer.size()");
+
+  // keep several reads in flight for large reads, e.g. of external initializers, to use the device's bandwidth
+  constexpr size_t k_min_bytes_for_overlapped_read = 16 * 1024 * 1024;
+  const bool overlapped = length >= k_min_bytes_for_overlapped_read;
+  CREATEFILE2_EXTENDED_PARAMETERS open_parameters{};
+  open_parameters.dwSize = sizeof(open_parameters);
+  open_parameters.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+  open_parameters.dwFileFlags = overlapped ? FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN : 0;
   wil::unique_hfile file_handle{
-      CreateFile2(file_path, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, NULL)};
+      CreateFile2(file_path, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, overlapped ? &open_parameters : NULL)};
   if (file_handle.get() == INVALID_HANDLE_VALUE) {
     const auto error_code = GetLastError();
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "open file ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
@@ -374,6 +475,10 @@ Status WindowsEnv::ReadFileIntoBuffer(_In_z_ const ORTCHAR_T* const file_path, c
   if (length == 0)
     return Status::OK();
 
+  if (overlapped) {
+    return ReadFileOverlapped(file_handle.get(), file_path, offset, length, buffer.data());
+  }
+
   if (offset > 0) {
     LARGE_INTEGER current_position;
     current_position.QuadPart = offset;
@@ -445,20 +550,13 @@ Status WindowsEnv::MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path,
   SYSTEM_INFO sysinfo;
   GetSystemInfo(&sysinfo);
 
-  static const DWORD page_size = sysinfo.dwPageSize;
+  // the view must start at a multiple of the allocation granularity, so map from the aligned offset below `offset`
+  // and skip to the requested data. This keeps initializers at arbitrary offsets of an external data file mapped
+  // rather than copied.
   static const DWORD allocation_granularity = sysinfo.dwAllocationGranularity;
-  const FileOffsetType offset_to_page = offset % static_cast<FileOffsetType>(page_size);
-  const size_t mapped_length = length + static_cast<size_t>(offset_to_page);
-  const FileOffsetType mapped_offset = offset - offset_to_page;
-  if (mapped_offset % allocation_granularity != 0) {
-    const auto error_code = GetLastError();
-    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
-                           "mapped offset must be a multiple of the allocation granularity",
-                           " , mapped_offset = ", mapped_offset,
-                           " , allocation_granularity = ", allocation_granularity,
-                           " , errcode = ", error_code,
-                           " - ", std::system_category().message(error_code));
-  }
+  const FileOffsetType offset_to_granularity = offset % static_cast<FileOffsetType>(allocation_granularity);
+  const size_t mapped_length = length + static_cast<size_t>(offset_to_granularity);
+  const FileOffsetType mapped_offset = offset - offset_to_granularity;
 
   void* const mapped_base = MapViewOfFile(file_mapping_handle.get(),
                                           FILE_MAP_READ,
@@ -467,7 +565,7 @@ Status WindowsEnv::MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path,
                                           mapped_length);
   GSL_SUPPRESS(r.11)
   mapped_memory =
-      MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + offset_to_page,
+      MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + offset_to_granularity,
                       OrtCallbackInvoker{OrtCallback{UnmapFile, new UnmapFileParam{mapped_base, mapped_length}}}};
 
   return Status::OK();
@@ -925,6 +1023,7 @@ void WindowsEnv::InitializeCpuInfo() {
         }
       }
       cores_.push_back(std::move(core_global_proc_ids));
+      core_efficiency_classes_.push_back(processor_info->Processor.EfficiencyClass);
       core_id++;
     }
     iter += size;
@@ -55,6 +55,7 @@ class WindowsEnv : public Env {
   static int DefaultNumCores();
   int GetNumPhysicalCpuCores() const override;
   std::vector<LogicalProcessors> GetDefaultThreadAffinities() const override;
+  std::vector<LogicalProcessors> GetPerformanceCoreThreadAffinities() const override;
   int GetL2CacheSize() const override;
   static WindowsEnv& Instance();
   PIDType GetSelfPid() const override;
@@ -115,6 +116,13 @@ class WindowsEnv : public Env {
    */
   std::vector<LogicalProcessors> cores_;
 
+  /*
+   * "core_efficiency_classes_" is parallel to "cores_" and holds the EfficiencyClass reported for each core.
+   * On hybrid systems a higher value means a more performant (and less power efficient) core,
+   * on other systems all cores report the same value.
+   */
+  std::vector<BYTE> core_efficiency_classes_;
+
   int l2_cache_size_;
   /*
    * "global_processor_info_map_" is a map of:
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -18,6 +19,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
+#include "core/framework/murmurhash3.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/platform/env.h"
 #include "core/providers/coreml/builders/helper.h"
@@ -255,6 +257,88 @@ Status CopyMLMultiArrayBuffer(const void* mlmultiarray_buffer, void* tensor_buff
   }
   return Status::OK();
 }
+// Returns the directory in the caches directory of the user that holds the compiled models, creating it if needed.
+// Returns nil if it isn't available.
+NSString* GetCompiledModelCacheDirectory(const logging::Logger& logger) {
+  NSFileManager* file_manager = [NSFileManager defaultManager];
+  NSURL* caches_url = [[file_manager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] firstObject];
+  if (caches_url == nil) {
+    LOGS(logger, WARNING) << "The caches directory is not available, the compiled CoreML model is not cached.";
+    return nil;
+  }
+
+  NSURL* cache_url = [caches_url URLByAppendingPathComponent:@"onnxruntime-coreml-models" isDirectory:YES];
+  NSError* error = nil;
+  if (![file_manager createDirectoryAtURL:cache_url withIntermediateDirectories:YES attributes:nil error:&error]) {
+    LOGS(logger, WARNING) << "Failed to create the compiled CoreML model cache directory: "
+                          << [[cache_url path] UTF8String]
+                          << ", error message: " << [[error localizedDescription] UTF8String];
+    return nil;
+  }
+
+  return [cache_url path];
+}
+
+// Returns the name of the compiled model of the CoreML model at `model_path`, which is a .mlmodel file or an
+// .mlpackage directory, in the cache. It hashes the content of the model and the OS version, as the compiler comes
+// with the OS. The manifest of a package isn't hashed, as it holds random identifiers of the items of the package.
+// Returns nil if the model can't be read.
+NSString* GetCompiledModelCacheKey(NSString* model_path) {
+  NSFileManager* file_manager = [NSFileManager defaultManager];
+  BOOL is_directory = NO;
+  if (![file_manager fileExistsAtPath:model_path isDirectory:&is_directory]) {
+    return nil;
+  }
+
+  // paths of the files to hash, relative to model_path
+  NSMutableArray<NSString*>* files = [NSMutableArray array];
+  if (is_directory) {
+    NSArray<NSString*>* sub_paths = [file_manager subpathsOfDirectoryAtPath:model_path error:nil];
+    if (sub_paths == nil) {
+      return nil;
+    }
+    for (NSString* sub_path in [sub_paths sortedArrayUsingSelector:@selector(compare:)]) {
+      BOOL is_sub_directory = NO;
+      if (![sub_path isEqualToString:@"Manifest.json"] &&
+          [file_manager fileExistsAtPath:[model_path stringByAppendingPathComponent:sub_path]
+                             isDirectory:&is_sub_directory] &&
+          !is_sub_directory) {
+        [files addObject:sub_path];
+      }
+    }
+  } else {
+    [files addObject:@""];
+  }
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  auto hash_bytes = [&hash](const void* data, size_t size) {
+    constexpr size_t kMaxChunkSize = size_t{1} << 30;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    do {
+      const size_t chunk_size = std::min(size, kMaxChunkSize);
+      MurmurHash3::x86_128(bytes, narrow<int>(chunk_size), hash[0], &hash);
+      bytes += chunk_size;
+      size -= chunk_size;
+    } while (size > 0);
+  };
+
+  for (NSString* file in files) {
+    NSString* file_path = [file length] == 0 ? model_path : [model_path stringByAppendingPathComponent:file];
+    NSData* data = [NSData dataWithContentsOfFile:file_path options:NSDataReadingMappedIfSafe error:nil];
+    if (data == nil) {
+      return nil;
+    }
+    const char* name = [file UTF8String];
+    hash_bytes(name, strlen(name));
+    hash_bytes([data bytes], [data length]);
+  }
+
+  const char* os_version = [[[NSProcessInfo processInfo] operatingSystemVersionString] UTF8String];
+  hash_bytes(os_version, strlen(os_version));
+
+  return [NSString stringWithFormat:@"%08x%08x%08x%08x.mlmodelc", hash[0], hash[1], hash[2], hash[3]];
+}
+
 }  // namespace
 
 Status GetMLMultiArrayCopyInfo(const MLMultiArray* _Nonnull array,
@@ -382,6 +466,44 @@ Status Execution::LoadModel() {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create model URL from path");
       }
 
+      MLModelConfiguration* config = [[MLModelConfiguration alloc] init];
+
+      if (coreml_flags_ & COREML_FLAG_USE_CPU_ONLY) {
+        config.computeUnits = MLComputeUnitsCPUOnly;
+      } else if (coreml_flags_ & COREML_FLAG_USE_CPU_AND_GPU) {
+        config.computeUnits = MLComputeUnitsCPUAndGPU;
+      } else {
+        config.computeUnits = MLComputeUnitsAll;
+      }
+
+      NSString* cached_model_path = nil;
+      if (coreml_flags_ & COREML_FLAG_ENABLE_MODEL_CACHE) {
+        NSString* cache_directory = GetCompiledModelCacheDirectory(logger_);
+        NSString* cache_key = cache_directory != nil ? GetCompiledModelCacheKey(coreml_model_path_) : nil;
+        if (cache_key != nil) {
+          cached_model_path = [cache_directory stringByAppendingPathComponent:cache_key];
+        }
+      }
+
+      NSFileManager* file_manager = [NSFileManager defaultManager];
+      if (cached_model_path != nil && [file_manager fileExistsAtPath:cached_model_path]) {
+        model_ = [MLModel modelWithContentsOfURL:[NSURL fileURLWithPath:cached_model_path isDirectory:YES]
+                                   configuration:config
+                                           error:&error];
+        if (model_ != nil) {
+          LOGS(logger_, INFO) << "Loaded the compiled model from the cache: " << [cached_model_path UTF8String];
+          return Status::OK();
+        }
+
+        // e.g. a partially written entry. compile the model again and replace it.
+        LOGS(logger_, WARNING) << "Failed to load the cached compiled model: " << [cached_model_path UTF8String]
+                               << ((error != nil) ? MakeString(", error message: ",
+                                                               [[error localizedDescription] UTF8String])
+                                                  : "");
+        error = nil;
+        [file_manager removeItemAtPath:cached_model_path error:nil];
+      }
+
       // TODO: Update this to version with callback handler as the API used here is deprecated.
       // https://developer.apple.com/documentation/coreml/mlmodel/3929553-compilemodelaturl
       // As we call loadModel during EP Compile there shouldn't be an issue letting the actual compile run in the
@@ -394,14 +516,17 @@ Status Execution::LoadModel() {
 
       compiled_model_path_ = [compileUrl path];
 
-      MLModelConfiguration* config = [[MLModelConfiguration alloc] init];
-
-      if (coreml_flags_ & COREML_FLAG_USE_CPU_ONLY) {
-        config.computeUnits = MLComputeUnitsCPUOnly;
-      } else if (coreml_flags_ & COREML_FLAG_USE_CPU_AND_GPU) {
-        config.computeUnits = MLComputeUnitsCPUAndGPU;
-      } else {
-        config.computeUnits = MLComputeUnitsAll;
+      if (cached_model_path != nil) {
+        // the move fails if another session added the same model to the cache first, in which case this session
+        // uses its own copy, which is removed with the session.
+        NSError* move_error = nil;
+        if ([file_manager moveItemAtPath:compiled_model_path_ toPath:cached_model_path error:&move_error]) {
+          compiled_model_path_ = nil;
+          compileUrl = [NSURL fileURLWithPath:cached_model_path isDirectory:YES];
+        } else {
+          LOGS(logger_, WARNING) << "Failed to add the compiled model to the cache: " << [cached_model_path UTF8String]
+                                 << ", error message: " << [[move_error localizedDescription] UTF8String];
+        }
       }
 
       model_ = [MLModel modelWithContentsOfURL:compileUrl configuration:config error:&error];
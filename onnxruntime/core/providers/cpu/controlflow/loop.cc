@@ -560,6 +560,8 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
       } else {
         // We can't move the Loop's inputs directly into the Loop's outputs
         // as operator inputs are read-only. Hence, we need to make a copy.
+        // The tensors of a sequence are never updated in place, so the ones on the device of the Loop's outputs
+        // are shared rather than copied.
         auto& data = input.Get<TensorSeq>();
         output->SetType(data.DataType());
         output->Reserve(data.Size());
@@ -567,6 +569,11 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
         AllocatorPtr alloc;
         ORT_RETURN_IF_ERROR(context_.GetTempSpaceAllocator(&alloc));
         for (auto it = data.begin(), end = data.end(); it != end; ++it) {
+          if (it->Get<Tensor>().Location().device == alloc->Info().device) {
+            output->Add(*it);
+            continue;
+          }
+
           Tensor tmp(it->Get<Tensor>().DataType(), it->Get<Tensor>().Shape(), alloc);
           // Safely use the IDataTransfer abstraction as we only allow using
           // Loop on CUDA if the copy stream is the same as the compute stream.
@@ -5,12 +5,16 @@
 
 #include "core/framework/execution_provider.h"
 #include "core/graph/constants.h"
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
 
 namespace onnxruntime {
 
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // back the large allocations with huge pages. see HugePageCPUAllocator.
+  bool use_huge_pages{false};
+  cpu::TunableOpInfo tunable_op{};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -32,9 +36,12 @@ class CPUExecutionProvider : public IExecutionProvider {
   std::unique_ptr<IDataTransfer> GetDataTransfer() const override;
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
 
+  ITuningContext* GetTuningContext() const override;
+
  private:
   CPUExecutionProviderInfo info_;
   std::vector<FuseRuleFn> fuse_rules_;
+  std::unique_ptr<cpu::tunable::CpuTuningContext> tuning_context_;
 };
 
 // Registers all available CPU kernels
@@ -22,12 +22,16 @@ limitations under the License.
 #endif
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <random>
 
 #include "core/common/eigen_common_wrapper.h"
+#include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
 
@@ -131,6 +135,10 @@ void GenerateData(std::default_random_engine& generator, TDistribution distribut
 
 static Status RandomNormalCompute(float mean, float scale, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
 static Status RandomUniformCompute(float high, float low, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
+static Status RandomNormalCompute(float mean, float scale, PhiloxGenerator& generator, concurrency::ThreadPool* thread_pool,
+                                  TensorProto::DataType dtype, Tensor& Y);
+static Status RandomUniformCompute(float low, float high, PhiloxGenerator& generator, concurrency::ThreadPool* thread_pool,
+                                   TensorProto::DataType dtype, Tensor& Y);
 
 static Status CreateOutputTensorFromTensorShape(OpKernelContext* ctx, const Tensor& X, Tensor** Y);
 static TensorProto::DataType InferDataType(const Tensor& tensor);
@@ -138,6 +146,10 @@ static TensorProto::DataType InferDataType(const Tensor& tensor);
 Status RandomNormal::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
+  if (philox_generator_) {
+    return RandomNormalCompute(mean_, scale_, *philox_generator_, ctx->GetOperatorThreadPool(), dtype_, Y);
+  }
+
   std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
   auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, Y);
 
@@ -147,6 +159,10 @@ Status RandomNormal::Compute(OpKernelContext* ctx) const {
 Status RandomUniform::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
+  if (philox_generator_) {
+    return RandomUniformCompute(low_, high_, *philox_generator_, ctx->GetOperatorThreadPool(), dtype_, Y);
+  }
+
   std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
   auto status = RandomUniformCompute(low_, high_, generator_, dtype_, Y);
 
@@ -169,6 +185,10 @@ Status RandomNormalLike::Compute(OpKernelContext* ctx) const {
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
 
+  if (philox_generator_) {
+    return RandomNormalCompute(mean_, scale_, *philox_generator_, ctx->GetOperatorThreadPool(), dtype, *Y);
+  }
+
   std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
   status = RandomNormalCompute(mean_, scale_, generator_, dtype, *Y);
 
@@ -190,6 +210,10 @@ Status RandomUniformLike::Compute(OpKernelContext* ctx) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
+  if (philox_generator_) {
+    return RandomUniformCompute(low_, high_, *philox_generator_, ctx->GetOperatorThreadPool(), dtype, *Y);
+  }
+
   std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
   status = RandomUniformCompute(low_, high_, generator_, dtype, *Y);
 
@@ -269,6 +293,74 @@ Status MultinomialComputeShared(AllocatorPtr& alloc,
   return Status::OK();
 }
 
+template <typename OutputType>
+Status MultinomialComputeShared(AllocatorPtr& alloc,
+                                const Tensor& X,
+                                const int64_t batch_size,
+                                const int64_t num_classes,
+                                const int64_t num_samples,
+                                PhiloxGenerator& generator,
+                                concurrency::ThreadPool* thread_pool,
+                                Tensor& Y) {
+  if (!utils::HasType<EnabledMultinomialOutputTypes, OutputType>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output type not supported in this build.");
+  }
+
+  // each counter of the Philox sequence generates the uniform values of 2 samples
+  const int64_t num_counters = (batch_size * num_samples + 1) / 2;
+  const auto seeds = generator.NextPhiloxSeeds(static_cast<uint64_t>(num_counters));
+
+  const float* logits = X.Data<float>();
+  OutputType* output = Y.MutableData<OutputType>();
+
+  // a cumulative distribution buffer per batch, so that the batches are sampled in parallel
+  auto cdf_data = static_cast<double*>(alloc->Alloc(SafeInt<size_t>(sizeof(double)) * batch_size * num_classes));
+  BufferUniquePtr cdf_buffer(cdf_data, BufferDeleter(std::move(alloc)));
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, onnxruntime::narrow<std::ptrdiff_t>(batch_size),
+      TensorOpCost{static_cast<double>(num_classes * sizeof(float)),
+                   static_cast<double>(num_samples * sizeof(OutputType)),
+                   static_cast<double>(num_classes * 20 + num_samples * (40 + std::log2(num_classes + 1)))},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          const float* logits_row = logits + b * num_classes;
+          double* cdf = cdf_data + b * num_classes;
+
+          // Takes an along-class maximum (for numerical stability).
+          float maxx = std::numeric_limits<float>::lowest();
+          for (int64_t j = 0; j < num_classes; ++j) {
+            if (Eigen::numext::isfinite(logits_row[j])) {
+              maxx = std::max(maxx, logits_row[j]);
+            }
+          }
+          const auto max_logit = static_cast<double>(maxx);
+
+          // Precompute cumulative probability distribution across classes.
+          // Note: This isn't normalized.
+          double running_total = 0;
+          for (int64_t j = 0; j < num_classes; ++j) {
+            if (Eigen::numext::isfinite(logits_row[j])) {
+              running_total += std::exp(static_cast<double>(logits_row[j]) - max_logit);
+            }
+            cdf[j] = running_total;
+          }
+
+          // Generate each sample.
+          for (int64_t j = 0; j < num_samples; ++j) {
+            const int64_t sample = b * num_samples + j;
+            const auto random = Philox4x32::Generate(seeds.first, seeds.second + static_cast<uint64_t>(sample / 2));
+            const size_t lane = static_cast<size_t>(sample % 2) * 2;
+            const double to_find = Philox4x32::ToUniformDouble(random[lane], random[lane + 1]) * running_total;
+            auto found_iter = std::upper_bound(cdf, cdf + num_classes, to_find);
+            output[sample] = static_cast<OutputType>(std::distance(cdf, found_iter));
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
 template <typename OutputType>
 static Status MultinomialCompute(OpKernelContext* ctx,
                                  const Tensor& X,
@@ -309,6 +401,22 @@ Status Multinomial::Compute(OpKernelContext* ctx) const {
 
   Tensor* Y = ctx->Output(0, {batch_size, num_samples_});
 
+  if (philox_generator_) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+    auto* thread_pool = ctx->GetOperatorThreadPool();
+    switch (output_dtype_) {
+      case TensorProto::INT32:
+        return MultinomialComputeShared<int32_t>(alloc, X, batch_size, num_classes, num_samples_, *philox_generator_,
+                                                 thread_pool, *Y);
+      case TensorProto::INT64:
+        return MultinomialComputeShared<int64_t>(alloc, X, batch_size, num_classes, num_samples_, *philox_generator_,
+                                                 thread_pool, *Y);
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Invalid data type of ", output_dtype_);
+    }
+  }
+
   Status status = Status::OK();
   std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
   switch (output_dtype_) {
@@ -420,6 +528,127 @@ void GenerateData(std::default_random_engine& generator, TDistribution distribut
   }
 }
 
+// Generates the values of a tensor in parallel with the Philox engine. Each counter of the sequence generates
+// kValuesPerCounter values from its 4 random 32-bit values, so the values depend only on the seed and on their
+// position in the sequence of the generator.
+template <typename T, int64_t kValuesPerCounter, typename TConvert>
+static void GeneratePhiloxData(PhiloxGenerator& generator, concurrency::ThreadPool* thread_pool, TConvert convert,
+                               Tensor& tensor) {
+  const int64_t size = tensor.Shape().Size();
+  const int64_t num_counters = (size + kValuesPerCounter - 1) / kValuesPerCounter;
+  const auto seeds = generator.NextPhiloxSeeds(static_cast<uint64_t>(num_counters));
+  T* out = tensor.MutableData<T>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, onnxruntime::narrow<std::ptrdiff_t>(num_counters),
+      TensorOpCost{0, static_cast<double>(kValuesPerCounter * sizeof(T)), 80.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::array<T, kValuesPerCounter> values;
+        for (std::ptrdiff_t counter = first; counter < last; ++counter) {
+          convert(Philox4x32::Generate(seeds.first, seeds.second + static_cast<uint64_t>(counter)), values);
+          const int64_t begin = counter * kValuesPerCounter;
+          std::copy_n(values.begin(), std::min(kValuesPerCounter, size - begin), out + begin);
+        }
+      });
+}
+
+// Box-Muller transform of two uniform values in [0, 1) to two normal values.
+template <typename T>
+static void BoxMuller(T u1, T u2, T mean, T scale, T* out) {
+  const T radius = scale * std::sqrt(static_cast<T>(-2) * std::log(static_cast<T>(1) - u1));  // 1 - u1 is in (0, 1]
+  const T theta = static_cast<T>(6.283185307179586) * u2;
+  out[0] = mean + radius * std::cos(theta);
+  out[1] = mean + radius * std::sin(theta);
+}
+
+static Status RandomNormalCompute(float mean, float scale, PhiloxGenerator& generator,
+                                  concurrency::ThreadPool* thread_pool, TensorProto::DataType dtype, Tensor& Y) {
+  bool handled = false;
+  switch (dtype) {
+    case TensorProto::FLOAT: {
+      if (utils::HasType<EnabledRandomNormalComputeOutputTypes, float>()) {
+        GeneratePhiloxData<float, 4>(
+            generator, thread_pool,
+            [mean, scale](const std::array<uint32_t, 4>& random, std::array<float, 4>& values) {
+              BoxMuller(Philox4x32::ToUniformFloat(random[0]), Philox4x32::ToUniformFloat(random[1]),
+                        mean, scale, values.data());
+              BoxMuller(Philox4x32::ToUniformFloat(random[2]), Philox4x32::ToUniformFloat(random[3]),
+                        mean, scale, values.data() + 2);
+            },
+            Y);
+        handled = true;
+      }
+      break;
+    }
+    case TensorProto::DOUBLE: {
+      if (utils::HasType<EnabledRandomNormalComputeOutputTypes, double>()) {
+        GeneratePhiloxData<double, 2>(
+            generator, thread_pool,
+            [mean, scale](const std::array<uint32_t, 4>& random, std::array<double, 2>& values) {
+              BoxMuller(Philox4x32::ToUniformDouble(random[0], random[1]),
+                        Philox4x32::ToUniformDouble(random[2], random[3]),
+                        static_cast<double>(mean), static_cast<double>(scale), values.data());
+            },
+            Y);
+        handled = true;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  if (!handled) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output type not supported in this build: ", dtype);
+  }
+
+  return Status::OK();
+}
+
+static Status RandomUniformCompute(float low, float high, PhiloxGenerator& generator,
+                                   concurrency::ThreadPool* thread_pool, TensorProto::DataType dtype, Tensor& Y) {
+  bool handled = false;
+  switch (dtype) {
+    case TensorProto::FLOAT: {
+      if (utils::HasType<EnabledRandomUniformComputeOutputTypes, float>()) {
+        const float range = high - low;
+        GeneratePhiloxData<float, 4>(
+            generator, thread_pool,
+            [low, range](const std::array<uint32_t, 4>& random, std::array<float, 4>& values) {
+              for (size_t i = 0; i < 4; ++i) {
+                values[i] = low + range * Philox4x32::ToUniformFloat(random[i]);
+              }
+            },
+            Y);
+        handled = true;
+      }
+      break;
+    }
+    case TensorProto::DOUBLE: {
+      if (utils::HasType<EnabledRandomUniformComputeOutputTypes, double>()) {
+        const double range = static_cast<double>(high) - static_cast<double>(low);
+        GeneratePhiloxData<double, 2>(
+            generator, thread_pool,
+            [low, range](const std::array<uint32_t, 4>& random, std::array<double, 2>& values) {
+              values[0] = low + range * Philox4x32::ToUniformDouble(random[0], random[1]);
+              values[1] = low + range * Philox4x32::ToUniformDouble(random[2], random[3]);
+            },
+            Y);
+        handled = true;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  if (!handled) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output type not supported in this build: ", dtype);
+  }
+
+  return Status::OK();
+}
+
 template Status MultinomialComputeShared<int64_t>(AllocatorPtr& alloc,
                                                   const Tensor& X,
                                                   const int64_t batch_size,
@@ -428,6 +657,24 @@ template Status MultinomialComputeShared<int64_t>(AllocatorPtr& alloc,
                                                   std::default_random_engine& generator,
                                                   Tensor& Y);
 
+template Status MultinomialComputeShared<int64_t>(AllocatorPtr& alloc,
+                                                  const Tensor& X,
+                                                  const int64_t batch_size,
+                                                  const int64_t num_classes,
+                                                  const int64_t num_samples,
+                                                  PhiloxGenerator& generator,
+                                                  concurrency::ThreadPool* thread_pool,
+                                                  Tensor& Y);
+
+template Status MultinomialComputeShared<int32_t>(AllocatorPtr& alloc,
+                                                  const Tensor& X,
+                                                  const int64_t batch_size,
+                                                  const int64_t num_classes,
+                                                  const int64_t num_samples,
+                                                  PhiloxGenerator& generator,
+                                                  concurrency::ThreadPool* thread_pool,
+                                                  Tensor& Y);
+
 #if !defined(DISABLE_CONTRIB_OPS)
 // used by onnxruntime/contrib_ops/cpu/transformers/sampling_cpu_helper.h
 template Status MultinomialComputeShared<int32_t>(AllocatorPtr& alloc,
@@ -3,16 +3,39 @@
 
 #pragma once
 
+#include <memory>
 #include <random>
 #include <gsl/gsl>
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/random_generator.h"
 #include "core/framework/random_seed.h"
 #include "core/platform/ort_mutex.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
+// Gets the seed of a random op from its optional seed attribute, or from the global seed if it is not provided.
+inline uint32_t GetRandomOpSeed(const OpKernelInfo& info) {
+  float seed = 0.f;
+  if (info.GetAttr<float>("seed", &seed).IsOK()) {
+    return gsl::narrow_cast<uint32_t>(seed);
+  }
+
+  // node index is added to the global seed to avoid two nodes generating the same sequence of random data
+  return gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index());
+}
+
+// Creates the Philox generator of a random op if kOrtSessionOptionsUsePhiloxRandomGenerator is enabled,
+// else returns nullptr and the op uses its std::default_random_engine.
+inline std::unique_ptr<PhiloxGenerator> CreatePhiloxGeneratorIfEnabled(const OpKernelInfo& info, uint32_t seed) {
+  if (info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsUsePhiloxRandomGenerator, "0") != "1") {
+    return nullptr;
+  }
+  return std::make_unique<PhiloxGenerator>(seed);
+}
+
 template <typename OutputType>
 Status MultinomialComputeShared(AllocatorPtr& alloc,
                                 const Tensor& X,
@@ -22,20 +45,26 @@ Status MultinomialComputeShared(AllocatorPtr& alloc,
                                 std::default_random_engine& generator,
                                 Tensor& Y);
 
+// Multinomial sampling with the Philox engine. The batches are sampled in parallel.
+template <typename OutputType>
+Status MultinomialComputeShared(AllocatorPtr& alloc,
+                                const Tensor& X,
+                                const int64_t batch_size,
+                                const int64_t num_classes,
+                                const int64_t num_samples,
+                                PhiloxGenerator& generator,
+                                concurrency::ThreadPool* thread_pool,
+                                Tensor& Y);
+
 class RandomNormal final : public OpKernel {
  public:
   RandomNormal(const OpKernelInfo& info) : OpKernel(info) {
     ORT_ENFORCE(info.GetAttr<float>("mean", &mean_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("scale", &scale_).IsOK());
 
-    // read optional seed attribute and generate if not provided
-    float seed = 0.f;
-    if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
-    } else {
-      // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
-    }
+    const uint32_t seed = GetRandomOpSeed(info);
+    generator_ = std::default_random_engine{seed};
+    philox_generator_ = CreatePhiloxGeneratorIfEnabled(info, seed);
 
     int64_t dtype;
     ORT_ENFORCE(info.GetAttr<int64_t>("dtype", &dtype).IsOK());
@@ -59,6 +88,9 @@ class RandomNormal final : public OpKernel {
   // this is to ensure that a model with random generators is deterministic and still can be executed in parallel.
   mutable std::default_random_engine generator_;
   mutable onnxruntime::OrtMutex generator_mutex_;
+  // used instead of generator_ when the Philox engine is enabled. it reserves a range of the sequence for each call
+  // to Compute() under its own lock, and the values of the range are generated in parallel.
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_;
   TensorShape shape_;
 };
@@ -69,14 +101,9 @@ class RandomNormalLike final : public OpKernel {
     ORT_ENFORCE(info.GetAttr<float>("mean", &mean_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("scale", &scale_).IsOK());
 
-    // read optional seed attribute and generate if not provided
-    float seed = 0.f;
-    if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
-    } else {
-      // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
-    }
+    const uint32_t seed = GetRandomOpSeed(info);
+    generator_ = std::default_random_engine{seed};
+    philox_generator_ = CreatePhiloxGeneratorIfEnabled(info, seed);
 
     int64_t dtype;
     if (info.GetAttr<int64_t>("dtype", &dtype).IsOK()) {
@@ -95,6 +122,7 @@ class RandomNormalLike final : public OpKernel {
   // see comments for generator_ and generator_mutex_ in RandomNormal class.
   mutable std::default_random_engine generator_;
   mutable onnxruntime::OrtMutex generator_mutex_;
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_ = ONNX_NAMESPACE::TensorProto::DataType::TensorProto_DataType_UNDEFINED;  // optional and may be inferred
 };
 
@@ -104,14 +132,9 @@ class RandomUniform final : public OpKernel {
     ORT_ENFORCE(info.GetAttr<float>("high", &high_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("low", &low_).IsOK());
 
-    // read optional seed attribute and generate if not provided
-    float seed = 0.f;
-    if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
-    } else {
-      // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
-    }
+    const uint32_t seed = GetRandomOpSeed(info);
+    generator_ = std::default_random_engine{seed};
+    philox_generator_ = CreatePhiloxGeneratorIfEnabled(info, seed);
 
     int64_t dtype;
     ORT_ENFORCE(info.GetAttr<int64_t>("dtype", &dtype).IsOK());
@@ -133,6 +156,7 @@ class RandomUniform final : public OpKernel {
   // see comments for generator_ and generator_mutex_ in RandomNormal class.
   mutable std::default_random_engine generator_;
   mutable onnxruntime::OrtMutex generator_mutex_;
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_;
   TensorShape shape_;
 };
@@ -142,14 +166,9 @@ class RandomUniformLike final : public OpKernel {
   RandomUniformLike(const OpKernelInfo& info) : OpKernel(info) {
     ORT_ENFORCE(info.GetAttr<float>("high", &high_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("low", &low_).IsOK());
-    // read optional seed attribute and generate if not provided
-    float seed = 0.f;
-    if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
-    } else {
-      // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
-    }
+    const uint32_t seed = GetRandomOpSeed(info);
+    generator_ = std::default_random_engine{seed};
+    philox_generator_ = CreatePhiloxGeneratorIfEnabled(info, seed);
 
     int64_t dtype;
     if (info.GetAttr<int64_t>("dtype", &dtype).IsOK()) {
@@ -168,6 +187,7 @@ class RandomUniformLike final : public OpKernel {
   // see comments for generator_ and generator_mutex_ in RandomNormal class.
   mutable std::default_random_engine generator_;
   mutable onnxruntime::OrtMutex generator_mutex_;
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_ = ONNX_NAMESPACE::TensorProto::DataType::TensorProto_DataType_UNDEFINED;  // optional and may be inferred
 };
 
@@ -176,13 +196,9 @@ class Multinomial final : public OpKernel {
   Multinomial(const OpKernelInfo& info) : OpKernel(info) {
     ORT_ENFORCE(info.GetAttr<int64_t>("sample_size", &num_samples_).IsOK());
 
-    float seed = 0.f;
-    if (info.GetAttr<float>("seed", &seed).IsOK()) {
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
-    } else {
-      // node index is added to the global seed to avoid two nodes generating the same sequence of random data
-      generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(utils::GetRandomSeed() + info.node().Index())};
-    }
+    const uint32_t seed = GetRandomOpSeed(info);
+    generator_ = std::default_random_engine{seed};
+    philox_generator_ = CreatePhiloxGeneratorIfEnabled(info, seed);
 
     int64_t output_dtype_tmp;
     if (!info.GetAttr<int64_t>("dtype", &output_dtype_tmp).IsOK()) {
@@ -202,6 +218,7 @@ class Multinomial final : public OpKernel {
   // see comments for generator_ and generator_mutex_ in RandomNormal class.
   mutable std::default_random_engine generator_;
   mutable onnxruntime::OrtMutex generator_mutex_;
+  std::unique_ptr<PhiloxGenerator> philox_generator_;
   ONNX_NAMESPACE::TensorProto::DataType output_dtype_;
 };
 }  // namespace onnxruntime
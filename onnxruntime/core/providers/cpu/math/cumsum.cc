@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 #include "cumsum.h"
 #include "core/providers/common.h"
@@ -34,6 +36,79 @@ Status GetAxis(const Tensor* axis_tensor, int64_t input_rank, int64_t& axis_out)
   return Status::OK();
 }
 
+// the length from which a single slice along the axis is split into blocks that are scanned in parallel.
+// the blocks are summed in a different order than a sequential scan, which changes the rounding of floats.
+constexpr int64_t kMinBlockedScanLength = 1 << 16;
+
+namespace {
+// the index of the k-th row to accumulate along the axis
+inline int64_t ScanIndex(int64_t k, int64_t dim, bool reverse) {
+  return reverse ? dim - 1 - k : k;
+}
+}  // namespace
+
+template <typename T>
+void ScanRows(const T* input, T* output, int64_t dim, int64_t row_size, int64_t inner_begin, int64_t inner_end,
+              bool exclusive, bool reverse) {
+  T* out = output + ScanIndex(0, dim, reverse) * row_size;
+  const T* in = input + ScanIndex(0, dim, reverse) * row_size;
+  for (int64_t inner = inner_begin; inner < inner_end; inner++) {
+    out[inner] = exclusive ? T{0} : in[inner];
+  }
+
+  for (int64_t k = 1; k < dim; k++) {
+    const T* prev_out = output + ScanIndex(k - 1, dim, reverse) * row_size;
+    in = input + ScanIndex(exclusive ? k - 1 : k, dim, reverse) * row_size;
+    out = output + ScanIndex(k, dim, reverse) * row_size;
+    for (int64_t inner = inner_begin; inner < inner_end; inner++) {
+      out[inner] = prev_out[inner] + in[inner];
+    }
+  }
+}
+
+template <typename T>
+void BlockedScan(const T* input, T* output, int64_t dim, bool exclusive, bool reverse,
+                 concurrency::ThreadPool* tp) {
+  const int64_t num_blocks = std::min<int64_t>(concurrency::ThreadPool::DegreeOfParallelism(tp),
+                                               dim / (kMinBlockedScanLength / 4));
+  const int64_t block_size = (dim + num_blocks - 1) / num_blocks;
+
+  // scan the blocks independently, in the order of the accumulation, and keep the sum of each block
+  std::vector<T> block_sums(onnxruntime::narrow<size_t>(num_blocks));
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, static_cast<std::ptrdiff_t>(num_blocks), [&](std::ptrdiff_t b) {
+    const int64_t begin = b * block_size;
+    const int64_t end = std::min(dim, begin + block_size);
+    T sum{0};
+    for (int64_t k = begin; k < end; k++) {
+      const int64_t i = ScanIndex(k, dim, reverse);
+      if (exclusive) {
+        output[i] = sum;
+        sum += input[i];
+      } else {
+        sum += input[i];
+        output[i] = sum;
+      }
+    }
+    block_sums[onnxruntime::narrow<size_t>(b)] = sum;
+  });
+
+  // then add the sums of all the blocks before to each block
+  T offset{0};
+  for (auto& block_sum : block_sums) {
+    const T sum = block_sum;
+    block_sum = offset;
+    offset += sum;
+  }
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, static_cast<std::ptrdiff_t>(num_blocks - 1), [&](std::ptrdiff_t b) {
+    const int64_t begin = (b + 1) * block_size;
+    const int64_t end = std::min(dim, begin + block_size);
+    const T block_offset = block_sums[onnxruntime::narrow<size_t>(b + 1)];
+    for (int64_t k = begin; k < end; k++) {
+      output[ScanIndex(k, dim, reverse)] += block_offset;
+    }
+  });
+}
+
 }  // namespace cumsum_op
 
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -166,8 +241,8 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   // 1) out[upper_dims...][0][lower_dims...] = 0
   // 2) out[upper_dims...][i][lower_dims...] =
   //      in[upper_dims...][i-1][lower_dims...] + out[upper_dims...][i-1][lower_dims...]
-  // we loop through the [upper_dims...] and start applying the identity in each slice
-  // since the [lower_dims...] are adjecent in memory, so we can add them like vectors
+  // the slices of the [upper_dims...] and the [lower_dims...] positions are independent, so ranges of them are
+  // computed in parallel. the [lower_dims...] are adjecent in memory, so we can add them like vectors
 
   const auto input_shape = input->Shape().GetDims();
   const size_t axis = onnxruntime::narrow<size_t>(axis_input);
@@ -177,71 +252,37 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   const int64_t lower_dim_size =  // sizes of the slices we can treat as 1D arrays
       std::accumulate(input_shape.begin() + axis + 1, input_shape.end(), static_cast<int64_t>(1), std::multiplies<int64_t>());
 
-  if (!reverse_) {
-    const auto* input_iter = input->Data<T>();
-    auto* output_iter = output_tensor.MutableData<T>();
-    const auto* prev_output_iter = output_iter;
+  const T* input_data = input->Data<T>();
+  T* output_data = output_tensor.MutableData<T>();
+  auto* tp = ctx->GetOperatorThreadPool();
 
-    if (exclusive_) {
-      for (int64_t outer = 0; outer < upper_dim_count; outer++) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-          *(output_iter++) = 0;
-        }
-        for (int64_t cum_axis = 1; cum_axis < dim; cum_axis++) {
-          for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-            *(output_iter++) = *(prev_output_iter++) + *(input_iter++);
-          }
-        }
-        input_iter += lower_dim_size;
-      }
-    } else {
-      for (int64_t outer = 0; outer < upper_dim_count; outer++) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-          *(output_iter++) = *(input_iter++);
-        }
-        for (int64_t cum_axis = 1; cum_axis < dim; cum_axis++) {
-          for (int64_t inner = 0; inner < lower_dim_size; inner++) {
-            *(output_iter++) = *(prev_output_iter++) + *(input_iter++);
-          }
-        }
-      }
-    }
-  } else {
-    // in this case the logic is mostly the same, but we start from the end
-    const auto* input_iter = input->Data<T>() + input->Shape().Size();
-    auto* output_iter = output_tensor.MutableData<T>() + output_shape.Size();
-    const auto* prev_output_iter = output_iter;
-
-    if (exclusive_) {
-      for (int64_t outer = upper_dim_count - 1; outer >= 0; outer--) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-          *(--output_iter) = 0;
-        }
-        for (int64_t cum_axis = dim - 1; cum_axis > 0; cum_axis--) {
-          for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-            *(--output_iter) = *(--prev_output_iter) + *(--input_iter);
-          }
-        }
-        input_iter -= lower_dim_size;
-      }
-    } else {
-      for (int64_t outer = upper_dim_count - 1; outer >= 0; outer--) {
-        prev_output_iter = output_iter;
-        for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-          *(--output_iter) = *(--input_iter);
-        }
-        for (int64_t cum_axis = dim - 1; cum_axis > 0; cum_axis--) {
-          for (int64_t inner = lower_dim_size - 1; inner >= 0; inner--) {
-            *(--output_iter) = *(--prev_output_iter) + *(--input_iter);
-          }
-        }
-      }
+  if (lower_dim_size == 1 && dim >= cumsum_op::kMinBlockedScanLength &&
+      upper_dim_count < concurrency::ThreadPool::DegreeOfParallelism(tp)) {
+    // too few slices to keep the threads busy, split each one into blocks instead
+    for (int64_t outer = 0; outer < upper_dim_count; outer++) {
+      cumsum_op::BlockedScan(input_data + outer * dim, output_data + outer * dim, dim, exclusive_ != 0, reverse_ != 0,
+                             tp);
     }
+    return Status::OK();
   }
 
+  // a unit of work is one [lower_dims...] position of one slice, consecutive units are adjecent in memory
+  const double bytes_per_unit = static_cast<double>(dim * sizeof(T));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(upper_dim_count * lower_dim_size),
+      TensorOpCost{bytes_per_unit, bytes_per_unit, static_cast<double>(dim)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t unit = first; unit < last;) {
+          const int64_t outer = unit / lower_dim_size;
+          const int64_t inner_begin = unit % lower_dim_size;
+          const int64_t inner_end = std::min(lower_dim_size, inner_begin + (last - unit));
+          const int64_t slice_offset = outer * dim * lower_dim_size;
+          cumsum_op::ScanRows(input_data + slice_offset, output_data + slice_offset, dim, lower_dim_size, inner_begin,
+                              inner_end, exclusive_ != 0, reverse_ != 0);
+          unit += inner_end - inner_begin;
+        }
+      });
+
   return Status::OK();
 }
 
@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "einsum_typed_compute_processor.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
 
@@ -92,6 +97,163 @@ static bool IsTransposeReshapeForEinsum(const gsl::span<const size_t>& perm,
   return true;
 }
 
+// Estimated cost of folding the operands in the given order into the running result, pair by pair.
+// Every step is a batched MatMul over all the labels of its two operands, so its cost is the product of their dims.
+// The running result keeps the labels that are in the output or in an operand that is still to be processed.
+// pending_labels are the labels of the operands that will be processed after the ones in `order`.
+static double GetContractionCost(gsl::span<const size_t> order, gsl::span<const uint64_t> input_labels,
+                                 gsl::span<const int64_t> label_dims, uint64_t output_labels,
+                                 uint64_t pending_labels = 0) {
+  auto size_of = [&label_dims](uint64_t labels) {
+    double size = 1.0;
+    for (size_t i = 0; i < label_dims.size(); ++i) {
+      if (labels & (uint64_t{1} << i)) {
+        size *= static_cast<double>(label_dims[i]);
+      }
+    }
+    return size;
+  };
+
+  double cost = 0.0;
+  uint64_t result_labels = input_labels[order[0]];
+  for (size_t step = 1; step < order.size(); ++step) {
+    uint64_t remaining_labels = output_labels | pending_labels;
+    for (size_t i = step + 1; i < order.size(); ++i) {
+      remaining_labels |= input_labels[order[i]];
+    }
+
+    const uint64_t step_labels = result_labels | input_labels[order[step]];
+    cost += size_of(step_labels);
+    result_labels = step_labels & remaining_labels;
+  }
+
+  return cost;
+}
+
+// Picks the order in which the operands are folded into the running result.
+// Processing the operands left to right can be asymptotically worse than contracting the operands that share the
+// large dims first, e.g. for 'ij,jk,kl->il' with a small l. The order is searched exhaustively for up to
+// kMaxOperandsForExhaustiveSearch operands and greedily (cheapest next step) beyond that, and is only used if it is
+// estimated to be cheaper than processing the operands left to right.
+static InlinedVector<size_t> GetContractionOrder(const std::vector<TensorShape>& homogenized_input_dims,
+                                                 const std::vector<int64_t>& mapped_indices_to_last_input_index) {
+  constexpr size_t kMaxOperandsForExhaustiveSearch = 6;
+
+  const size_t num_inputs = homogenized_input_dims.size();
+  const size_t num_labels = mapped_indices_to_last_input_index.size();
+
+  InlinedVector<size_t> order(num_inputs);
+  std::iota(order.begin(), order.end(), size_t{0});
+
+  // with 2 operands the order only swaps the MatMul operands
+  if (num_inputs < 3 || num_labels > 64) {
+    return order;
+  }
+
+  // the labels each operand has a non-trivial dim for (see PairwiseOperandProcess) and their dim values
+  InlinedVector<uint64_t> input_labels(num_inputs, 0);
+  TensorShapeVector label_dims(num_labels, 1);
+  for (size_t input = 0; input < num_inputs; ++input) {
+    const auto dims = homogenized_input_dims[input].GetDims();
+    for (size_t i = 0; i < num_labels; ++i) {
+      if (dims[i] == 0) {
+        // empty operands take the existing path
+        return order;
+      }
+      if (dims[i] > 1) {
+        input_labels[input] |= uint64_t{1} << i;
+        label_dims[i] = dims[i];
+      }
+    }
+  }
+
+  uint64_t output_labels = 0;
+  for (size_t i = 0; i < num_labels; ++i) {
+    if (mapped_indices_to_last_input_index[i] == -1) {
+      output_labels |= uint64_t{1} << i;
+    }
+  }
+
+  const double left_to_right_cost = GetContractionCost(order, input_labels, label_dims, output_labels);
+  double best_cost = left_to_right_cost;
+  InlinedVector<size_t> best_order = order;
+
+  if (num_inputs <= kMaxOperandsForExhaustiveSearch) {
+    // the first two operands are interchangeable, so only consider orders with order[0] < order[1]
+    while (std::next_permutation(order.begin(), order.end())) {
+      if (order[0] > order[1]) {
+        continue;
+      }
+      const double cost = GetContractionCost(order, input_labels, label_dims, output_labels);
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_order = order;
+      }
+    }
+  } else {
+    // greedy: start with the cheapest pair, then keep adding the operand that makes the next step cheapest
+    InlinedVector<size_t> greedy_order;
+    greedy_order.reserve(num_inputs);
+    InlinedVector<bool> used(num_inputs, false);
+    auto pending_labels = [&](size_t excluded0, size_t excluded1) {
+      uint64_t labels = 0;
+      for (size_t i = 0; i < num_inputs; ++i) {
+        if (!used[i] && i != excluded0 && i != excluded1) {
+          labels |= input_labels[i];
+        }
+      }
+      return labels;
+    };
+
+    for (size_t step = 0; step < num_inputs; ++step) {
+      double step_best_cost = std::numeric_limits<double>::max();
+      size_t step_best = 0;
+      size_t step_best_second = 0;
+      for (size_t candidate = 0; candidate < num_inputs; ++candidate) {
+        if (used[candidate]) {
+          continue;
+        }
+        if (step == 0) {
+          for (size_t second = candidate + 1; second < num_inputs; ++second) {
+            const size_t pair[] = {candidate, second};
+            const double cost = GetContractionCost(pair, input_labels, label_dims, output_labels,
+                                                   pending_labels(candidate, second));
+            if (cost < step_best_cost) {
+              step_best_cost = cost;
+              step_best = candidate;
+              step_best_second = second;
+            }
+          }
+        } else {
+          greedy_order.push_back(candidate);
+          const double cost = GetContractionCost(greedy_order, input_labels, label_dims, output_labels,
+                                                 pending_labels(candidate, candidate));
+          greedy_order.pop_back();
+          if (cost < step_best_cost) {
+            step_best_cost = cost;
+            step_best = candidate;
+          }
+        }
+      }
+
+      greedy_order.push_back(step_best);
+      used[step_best] = true;
+      if (step == 0) {
+        greedy_order.push_back(step_best_second);
+        used[step_best_second] = true;
+        ++step;
+      }
+    }
+
+    const double cost = GetContractionCost(greedy_order, input_labels, label_dims, output_labels);
+    if (cost < best_cost) {
+      best_order = std::move(greedy_order);
+    }
+  }
+
+  return best_order;
+}
+
 template <typename T>
 std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(const Tensor& left,
                                                                                const TensorShape& left_shape_override,
@@ -357,8 +519,30 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
+  // Order in which the operands are processed, and for each subscript index the position in that order of the last
+  // operand to have it (-1 if it is in the output).
+  const InlinedVector<size_t> order = GetContractionOrder(homogenized_input_dims, mapped_indices_to_last_input_index);
+  std::vector<int64_t> reordered_last_input_index;
+  const bool is_reordered = !std::is_sorted(order.begin(), order.end());
+  if (is_reordered) {
+    // Labels with a trivial dim (1) in every operand don't need to be reduced
+    reordered_last_input_index.assign(mapped_indices_to_last_input_index.size(), -1);
+    for (size_t i = 0; i < reordered_last_input_index.size(); ++i) {
+      if (mapped_indices_to_last_input_index[i] == -1) {
+        continue;
+      }
+      for (size_t position = 0; position < order.size(); ++position) {
+        if (homogenized_input_dims[order[position]][i] > 1) {
+          reordered_last_input_index[i] = static_cast<int64_t>(position);
+        }
+      }
+    }
+  }
+  const auto& last_input_index = is_reordered ? reordered_last_input_index : mapped_indices_to_last_input_index;
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
+  const size_t first = order[0];
 
   {
     TensorShapeVector reduced_dims;
@@ -368,7 +552,7 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     preserved_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving.
 
     for (size_t i = 0; i < onnxruntime::narrow<size_t>(num_subscript_labels); ++i) {
-      if (mapped_indices_to_last_input_index[i] == 0) {
+      if (last_input_index[i] == 0) {
         reduced_dims.push_back(i);
       } else {
         preserved_dims.push_back(i);
@@ -377,14 +561,14 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
     // Reduce the dims that are last seen in the first input alone
     if (reduced_dims.size() != 0) {
-      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
-                                      homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
+      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[first] ? *preprocessed_inputs[first] : *raw_inputs[first],
+                                      homogenized_input_dims[first].GetDims(), reduced_dims, allocator_, tp_,
                                       einsum_ep_assets_, device_reduce_sum_func_);
     } else {
       // Check if there is a pre-processed version of this input
       // If so assign it to result
-      if (preprocessed_inputs[0]) {
-        result = std::move(preprocessed_inputs[0]);
+      if (preprocessed_inputs[first]) {
+        result = std::move(preprocessed_inputs[first]);
       }
     }
 
@@ -402,21 +586,22 @@ Status EinsumTypedComputeProcessor<T>::Run() {
   {
     bool is_final_pair = false;
     // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
+    for (int position = 1; position < num_inputs; ++position) {
+      const size_t input = order[position];
       TensorShapeVector reduced_dims;
       reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
       for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[onnxruntime::narrow<size_t>(dim)] == input) {
+        if (last_input_index[onnxruntime::narrow<size_t>(dim)] == position) {
           // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
           reduced_dims.push_back(dim);
         }
       }
-      if (input == num_inputs - 1) {
+      if (position == num_inputs - 1) {
         is_final_pair = true;
       }
       // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
+      result = PairwiseOperandProcess(result ? *result : *raw_inputs[first],
+                                      result ? result->Shape() : homogenized_input_dims[first],
                                       preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
                                       homogenized_input_dims[input],
                                       reduced_dims, is_final_pair);
@@ -12,7 +12,9 @@
 #include "core/util/math.h"
 #include "core/mlas/inc/mlas.h"
 
+#include <array>
 #include <cmath>
+#include <optional>
 
 namespace onnxruntime {
 // Supported types for operators that have type reduction enabled
@@ -102,6 +104,31 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
       KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),                    \
       KERNEL_CLASS<TYPE>);
 
+// Kernels that compute each output element only from the input elements at the same position, so the output may
+// reuse the buffer of an input with the same shape once that input has no other consumers. The allocation planner
+// ignores the entries for inputs that don't exist or whose shape differs from the output, e.g. a broadcast input.
+#define REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
+      OP_TYPE,                                                                     \
+      VERSION,                                                                     \
+      TYPE,                                                                        \
+      KernelDefBuilder()                                                           \
+          .MayInplace(0, 0)                                                        \
+          .MayInplace(1, 0)                                                        \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),               \
+      KERNEL_CLASS<TYPE>);
+
+#define REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                   \
+      OP_TYPE,                                                                                                \
+      VERSION_FROM, VERSION_TO,                                                                               \
+      TYPE,                                                                                                   \
+      KernelDefBuilder()                                                                                      \
+          .MayInplace(0, 0)                                                                                   \
+          .MayInplace(1, 0)                                                                                   \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),                                          \
+      KERNEL_CLASS<TYPE>);
+
 #define REG_ELEMENTWISE_LOGICALOP_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
   ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                     \
       OP_TYPE,                                                                                                  \
@@ -153,110 +180,110 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
           .TypeConstraint("T1", T2_CONSTRAINTS),                                                 \
       KERNEL_CLASS);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, float, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, double, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int32_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int64_t, Add);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, float, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, double, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int32_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int64_t, Sub);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, float, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, double, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int32_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int64_t, Mul);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, float, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, double, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int32_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int64_t, Div);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int8_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int16_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int32_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int64_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint8_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint16_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint32_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint64_t, Abs);
-
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, float, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, double, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int64_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint64_t, Abs);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, float, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, double, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int8_t, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int32_t, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int64_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, float, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, double, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int8_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int32_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int64_t, Neg);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, float, Floor);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, double, Floor);
-REG_ELEMENTWISE_TYPED_KERNEL(Floor, 13, float, Floor);
-REG_ELEMENTWISE_TYPED_KERNEL(Floor, 13, double, Floor);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, float, Ceil);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, double, Ceil);
-REG_ELEMENTWISE_TYPED_KERNEL(Ceil, 13, float, Ceil);
-REG_ELEMENTWISE_TYPED_KERNEL(Ceil, 13, double, Ceil);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, float, Reciprocal);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, double, Reciprocal);
-REG_ELEMENTWISE_TYPED_KERNEL(Reciprocal, 13, float, Reciprocal);
-REG_ELEMENTWISE_TYPED_KERNEL(Reciprocal, 13, double, Reciprocal);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, float, Sqrt);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, double, Sqrt);
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 13, float, Sqrt);
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 13, double, Sqrt);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, float, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, double, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int64_t, Add);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, float, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, double, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int64_t, Sub);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, float, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, double, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int64_t, Mul);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, float, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, double, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int64_t, Div);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int8_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int16_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int32_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int64_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint8_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint16_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint32_t, Abs);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint64_t, Abs);
+
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, float, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, double, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, int8_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, int16_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, int32_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, int64_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, uint8_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, uint16_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, uint32_t, Abs);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Abs, 13, uint64_t, Abs);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, float, Neg);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, double, Neg);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int8_t, Neg);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int32_t, Neg);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int64_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, float, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, double, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, int8_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, int32_t, Neg);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Neg, 13, int64_t, Neg);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, float, Floor);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, double, Floor);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Floor, 13, float, Floor);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Floor, 13, double, Floor);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, float, Ceil);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, double, Ceil);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Ceil, 13, float, Ceil);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Ceil, 13, double, Ceil);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, float, Reciprocal);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, double, Reciprocal);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Reciprocal, 13, float, Reciprocal);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Reciprocal, 13, double, Reciprocal);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, float, Sqrt);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, double, Sqrt);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sqrt, 13, float, Sqrt);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sqrt, 13, double, Sqrt);
 
 REG_ELEMENTWISE_VERSIONED_KERNEL_NONT(Pow, 7, 11, Pow,
                                       BuildKernelDefConstraintsFromTypeList<EnabledPow7Types>());
@@ -273,15 +300,15 @@ REG_ELEMENTWISE_KERNEL_NONT_2(Pow, 15, Pow,
                               BuildKernelDefConstraintsFromTypeList<EnabledPow12BaseTypes>(),
                               BuildKernelDefConstraintsFromTypeList<EnabledPow12ExpTypes>());
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, float, Exp);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, double, Exp);
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 13, float, Exp);
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 13, double, Exp);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, float, Exp);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, double, Exp);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Exp, 13, float, Exp);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Exp, 13, double, Exp);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Log, 6, 12, float, Log);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Log, 6, 12, double, Log);
-REG_ELEMENTWISE_TYPED_KERNEL(Log, 13, float, Log);
-REG_ELEMENTWISE_TYPED_KERNEL(Log, 13, double, Log);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Log, 6, 12, float, Log);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Log, 6, 12, double, Log);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Log, 13, float, Log);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Log, 13, double, Log);
 
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sum, 6, 7, float, Sum_6);
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sum, 6, 7, double, Sum_6);
@@ -417,9 +444,9 @@ REG_ELEMENTWISE_TYPED_KERNEL(BitwiseXor, 18, uint16_t, BitwiseXor);
 REG_ELEMENTWISE_TYPED_KERNEL(BitwiseXor, 18, uint32_t, BitwiseXor);
 REG_ELEMENTWISE_TYPED_KERNEL(BitwiseXor, 18, uint64_t, BitwiseXor);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Erf, 9, 12, float, Erf);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Erf, 9, 12, float, Erf);
 // Supposed to add BFloat16 but we are not supporting now, however, separate registration
-REG_ELEMENTWISE_TYPED_KERNEL(Erf, 13, float, Erf);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Erf, 13, float, Erf);
 
 // REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(Not, 1, bool, Not);
 // REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(And, 7, bool, And);
@@ -1940,8 +1967,42 @@ Status Mod::Compute(OpKernelContext* context) const {
 // Type specific logic is plugged in via the functions in ProcessBroadcastSpanFuncs.
 // Optional user_data can be provided, and will be available to the ProcessSpanFunc implementations
 // via BroadcastHelper.GetUserData().
+namespace {
+struct CachedBroadcaster {
+  TensorShapeVector shape1;
+  TensorShapeVector shape2;
+  std::optional<Broadcaster> broadcaster;
+};
+
+constexpr size_t kNumCachedBroadcasters = 4;
+}  // namespace
+
+const Broadcaster& GetCachedBroadcaster(gsl::span<const int64_t> shape1, gsl::span<const int64_t> shape2) {
+  thread_local std::array<CachedBroadcaster, kNumCachedBroadcasters> cache;
+  thread_local size_t next_entry = 0;
+
+  for (const auto& entry : cache) {
+    if (entry.broadcaster.has_value() && SpanEq(gsl::make_span(entry.shape1), shape1) &&
+        SpanEq(gsl::make_span(entry.shape2), shape2)) {
+      return *entry.broadcaster;
+    }
+  }
+
+  // replace the entries in turn. the Broadcaster throws for shapes that can't be broadcast, leaving the entry empty.
+  auto& entry = cache[next_entry];
+  next_entry = (next_entry + 1) % kNumCachedBroadcasters;
+  entry.broadcaster.emplace(shape1, shape2);
+  entry.shape1.assign(shape1.begin(), shape1.end());
+  entry.shape2.assign(shape2.begin(), shape2.end());
+  return *entry.broadcaster;
+}
+
 void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs, void* user_data) {
-  InputBroadcaster input_broadcaster(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
+  const Tensor& input0_tensor = *context.Input<Tensor>(0);
+  const Tensor& input1_tensor = *context.Input<Tensor>(1);
+  InputBroadcaster input_broadcaster(input0_tensor, input1_tensor,
+                                     GetCachedBroadcaster(input0_tensor.Shape().GetDims(),
+                                                          input1_tensor.Shape().GetDims()));
   OutputBroadcaster output_broadcaster(input_broadcaster.GetSpanSize(),
                                        *context.Output(0, input_broadcaster.GetOutputShape()));
   BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, user_data);
@@ -1956,7 +2017,9 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
                          void* user_data) {
   const Tensor& input0_tensor = *context.Input<Tensor>(0);
   const Tensor& input1_tensor = *context.Input<Tensor>(1);
-  InputBroadcaster input_broadcaster(input0_tensor, input1_tensor);
+  InputBroadcaster input_broadcaster(input0_tensor, input1_tensor,
+                                     GetCachedBroadcaster(input0_tensor.Shape().GetDims(),
+                                                          input1_tensor.Shape().GetDims()));
 
   Tensor& output_tensor = *context.Output(0, input_broadcaster.GetOutputShape());
 
@@ -201,6 +201,10 @@ struct Exp final : public ElementWiseRangedTransform<T> {
     ym = xm.exp();
   }
 };
+
+// uses MLAS, see element_wise_ops.cc
+template <>
+void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const;
 }  // namespace functors
 
 DEFINE_ELE_KERNEL(Log)
@@ -702,6 +706,11 @@ struct Broadcaster {
   TensorShapeVector output_shape_;
 };
 
+// Returns the Broadcaster for the two shapes. The Broadcasters of the last few pairs of shapes broadcast on this
+// thread are cached, so that a kernel that runs with the same shapes again only copies its Broadcaster, which is
+// cheaper than building it for small inputs. The returned reference is valid until the next call on the same thread.
+const Broadcaster& GetCachedBroadcaster(gsl::span<const int64_t> shape1, gsl::span<const int64_t> shape2);
+
 struct InputBroadcaster {
   InputBroadcaster(const Tensor& input0, const Tensor& input1)
       : input_tensor0_(input0),
@@ -715,6 +724,14 @@ struct InputBroadcaster {
         input_tensor1_shape_(input1_shape) {
   }
 
+  // use a Broadcaster for the shapes of the inputs that was built before, e.g. by GetCachedBroadcaster
+  InputBroadcaster(const Tensor& input0, const Tensor& input1, const Broadcaster& broadcaster)
+      : input_tensor0_(input0),
+        input_tensor1_(&input1),
+        input_tensor1_shape_(input1.Shape()),
+        broadcaster_(broadcaster) {
+  }
+
   void AdvanceBy(size_t offset) {
     ORT_ENFORCE(offset % span_size_ == 0, "InputBroadcaster can only start at span boundary!");
     broadcaster_.iterator1_.AdvanceBy(offset);
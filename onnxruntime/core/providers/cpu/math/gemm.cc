@@ -208,7 +208,9 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
   } else if (c_shape->NumDimensions() == 2 && (((*c_shape)[0] == 1 && (*c_shape)[1] == N) || ((*c_shape)[0] == N && (*c_shape)[1] == 1))) {
     support_mlas = true;
   }
-  if (trans_a == CblasNoTrans && trans_b == CblasNoTrans && support_mlas && alpha.ToFloat() == 1.0 && beta.ToFloat() == 1.0) {
+  // without a bias beta was zeroed above, which MLAS handles by not adding a bias
+  if (trans_a == CblasNoTrans && trans_b == CblasNoTrans && support_mlas && alpha.ToFloat() == 1.0 &&
+      (beta.ToFloat() == 1.0 || c_data == nullptr)) {
     MLAS_HALF_GEMM_DATA_PARAMS data;
     data.A = a_data;
     data.lda = K;
@@ -216,7 +218,7 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
     data.ldb = N;
     data.C = y_data;
     data.ldc = N;
-    if (c_shape != nullptr) {
+    if (c_data != nullptr) {
       data.Bias = c_data;
     }
     MlasHalfGemmBatch(M, N, K, 1, &data, thread_pool);
@@ -263,7 +265,11 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    // a weight pruned below the density threshold is packed for the sparse-dense kernel
+    sparse_b_ = GemmPackBSparseFp32(alloc, tensor, trans_B_ != CblasNoTrans, sparse_density_threshold_,
+                                    packed_b_, packed_b_size, b_shape_);
+    is_packed = sparse_b_ ||
+                GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
@@ -423,7 +429,20 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
                 c_data, c_shape, y_data, thread_pool);
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    if (K > 0) {
+    if (K > 0 && sparse_b_) {
+      SparseGemmFp32(trans_A_ != CblasNoTrans,
+                     static_cast<size_t>(M),
+                     static_cast<size_t>(N),
+                     static_cast<size_t>(K),
+                     alpha_,
+                     A->Data<float>(),
+                     static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
+                     packed_b_.get(),
+                     c_data != nullptr ? beta_ : 0.0f,
+                     y_data,
+                     static_cast<size_t>(N),
+                     thread_pool);
+    } else if (K > 0) {
       MlasGemm(
           trans_A_,
           static_cast<size_t>(M),
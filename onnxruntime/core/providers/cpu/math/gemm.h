@@ -9,6 +9,7 @@
 #include "core/common/common.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/providers/cpu/math/sparse_gemm.h"
 
 namespace onnxruntime {
 
@@ -16,6 +17,7 @@ template <typename T>
 class Gemm : protected GemmBase, public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : GemmBase(info), OpKernel(info) {
+    sparse_density_threshold_ = GetSparseWeightDensityThreshold(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -40,6 +42,9 @@ class Gemm : protected GemmBase, public OpKernel {
  protected:
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // packed_b_ holds B in the blocked CSR form of GemmPackBSparseFp32 instead of the MLAS packed form
+  bool sparse_b_{false};
+  float sparse_density_threshold_{0.0f};
 
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
@@ -2,8 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/matmul.h"
+
+#include <algorithm>
+
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -88,6 +92,23 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
         .TypeConstraint("T", BuildKernelDefConstraints<int64_t, uint64_t>()),
     MatMul<int64_t>);
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+#endif
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -133,7 +154,54 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
 
   return Status::OK();
 }
-#if defined(__aarch64__) && defined(__linux__)
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* a = ctx->Input<Tensor>(0);
+  const auto* b = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  MLFloat16* y_data = y->MutableData<MLFloat16>();
+
+  if (helper.K() == 0) {
+    // When we have (M, 0, N) then the inputs are empty, but the output should
+    // be filled out with zeros.
+    std::fill_n(y_data, narrow<size_t>(y->Shape().Size()), MLFloat16::Zero);
+    return Status::OK();
+  }
+
+  const MLFloat16* a_data = a->Data<MLFloat16>();
+  const MLFloat16* b_data = b->Data<MLFloat16>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = b_data + helper.RightOffsets()[i];
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  MlasHalfGemmBatch(M, N, K, max_len, data.data(), thread_pool);
+
+  return Status::OK();
+}
+#endif
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
 bool GemmPackBBfloat16(AllocatorPtr& alloc,
                        const Tensor& tensor_b,
                        bool trans_b,
@@ -180,7 +248,7 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
     size_t dim1 = 0;
     size_t dim2 = 0;
     TensorShape b_shape = tensor.Shape();
@@ -194,7 +262,13 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
       is_packed = GemmPackBBfloat16(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
     } else
 #endif
-    {
+    // a weight pruned below the density threshold is packed for the sparse-dense kernel
+    if (!trans_batch_a_ && !trans_batch_b_ &&
+        GemmPackBSparseFp32(alloc, tensor, trans_b_attr_ != 0, sparse_density_threshold_,
+                            packed_b_, packed_b_size, b_shape_)) {
+      is_packed = true;
+      sparse_b_ = true;
+    } else {
       is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
     }
 
@@ -220,6 +294,65 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+namespace {
+
+struct SgemmBatchParams : cpu::tunable::OpParams {
+  std::string Signature() const override {
+    return MakeString(trans_a == CblasTrans ? "T" : "N", trans_b == CblasTrans ? "T" : "N", "_",
+                      M, "_", N, "_", K, "_", batch, data[0].BIsPacked ? "_packed" : "");
+  }
+
+  CBLAS_TRANSPOSE trans_a;
+  CBLAS_TRANSPOSE trans_b;
+  size_t M;
+  size_t N;
+  size_t K;
+  const MLAS_SGEMM_DATA_PARAMS* data;
+  size_t batch;
+  concurrency::ThreadPool* thread_pool;
+};
+
+// MLAS splits every GEMM of the batch over the whole thread pool. That is a bad fit for small matrices, where the
+// cost of waking up the workers dominates, and for large batches of medium matrices, where giving each worker whole
+// GEMMs avoids the synchronization. The candidates only differ in how the work is partitioned across threads, never
+// in the order of accumulation, so they produce identical results.
+class SgemmBatchTunableOp : public cpu::tunable::TunableOp<SgemmBatchParams> {
+ public:
+  SgemmBatchTunableOp() {
+    // MLAS default partitioning.
+    RegisterOp([](const SgemmBatchParams* params) {
+      MlasGemmBatch(params->trans_a, params->trans_b, params->M, params->N, params->K,
+                    params->data, params->batch, params->thread_pool);
+      return Status::OK();
+    });
+
+    // Run on the calling thread only.
+    RegisterOp([](const SgemmBatchParams* params) {
+      TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+          concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool) <= 1,
+          "Same as the default partitioning without a thread pool.");
+      MlasGemmBatch(params->trans_a, params->trans_b, params->M, params->N, params->K,
+                    params->data, params->batch, nullptr);
+      return Status::OK();
+    });
+
+    // One whole GEMM of the batch per task.
+    RegisterOp([](const SgemmBatchParams* params) {
+      TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+          params->batch <= 1 || concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool) <= 1,
+          "Batch partitioning needs a batch and a thread pool.");
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          params->thread_pool, static_cast<std::ptrdiff_t>(params->batch), [params](std::ptrdiff_t i) {
+            MlasGemmBatch(params->trans_a, params->trans_b, params->M, params->N, params->K,
+                          params->data + i, 1, nullptr);
+          });
+      return Status::OK();
+    });
+  }
+};
+
+}  // namespace
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -258,7 +391,14 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
-#if defined(__aarch64__) && defined(__linux__)
+  if (sparse_b_) {
+    for (size_t i = 0; i < max_len; i++) {
+      SparseGemmFp32(trans_a, M, N, K, alpha_attr_, a_data + helper.LeftOffsets()[i], lda, packed_b_.get(),
+                     0.0f, y_data + helper.OutputOffsets()[i], N, thread_pool);
+    }
+    return Status::OK();
+  }
+#if defined(MLAS_SBGEMM_SUPPORTED)
   if (use_fastmath_mode_ && !trans_b && ((N * K) >= kFastMathModeKernelsizeThreshold)) {
     std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
     for (size_t i = 0; i < max_len; i++) {
@@ -289,6 +429,20 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
       data[i].alpha = alpha_attr_;
       data[i].beta = 0.0f;
     }
+    if (tuning_ctx_ != nullptr && tuning_ctx_->IsTunableOpEnabled()) {
+      static SgemmBatchTunableOp op;
+      SgemmBatchParams params;
+      params.tuning_ctx = tuning_ctx_;
+      params.trans_a = trans_a ? CblasTrans : CblasNoTrans;
+      params.trans_b = trans_b ? CblasTrans : CblasNoTrans;
+      params.M = M;
+      params.N = N;
+      params.K = K;
+      params.data = data.data();
+      params.batch = max_len;
+      params.thread_pool = thread_pool;
+      return op(&params);
+    }
     MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
                   M, N, K, data.data(), max_len, thread_pool);
   }
@@ -5,6 +5,8 @@
 
 #include "core/framework/op_kernel.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/sparse_gemm.h"
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
@@ -17,6 +19,12 @@ class MatMul final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 };
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+// fp16 MatMul runs the half precision MLAS GEMM instead of casting the inputs to float.
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* context) const;
+#endif
+
 template <>
 class MatMul<float> final : public OpKernel {
  public:
@@ -30,9 +38,19 @@ class MatMul<float> final : public OpKernel {
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
 
-#if defined(__aarch64__) && defined(__linux__)
-    auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16);
-    use_fastmath_mode_ = (config_ops == "1") && MlasBf16AccelerationSupported();
+    // only the CPU EP hands out a CPU tuning context
+    const auto* ep = info.GetExecutionProvider();
+    if (ep != nullptr && ep->Type() == kCpuExecutionProvider) {
+      tuning_ctx_ = static_cast<cpu::tunable::CpuTuningContext*>(ep->GetTuningContext());
+    }
+
+    sparse_density_threshold_ = GetSparseWeightDensityThreshold(info);
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
+    const auto& config_options = info.GetConfigOptions();
+    use_fastmath_mode_ = (config_options.GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16) == "1" ||
+                          config_options.GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathBfloat16) == "1") &&
+                         MlasBf16AccelerationSupported();
 #endif
   }
 
@@ -48,6 +66,9 @@ class MatMul<float> final : public OpKernel {
  private:
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // packed_b_ holds B in the blocked CSR form of GemmPackBSparseFp32 instead of the MLAS packed form
+  bool sparse_b_{false};
+  float sparse_density_threshold_{0.0f};
 
   // For FusedMatMul contrib ops
   float alpha_attr_;
@@ -56,7 +77,9 @@ class MatMul<float> final : public OpKernel {
   bool trans_batch_a_;
   bool trans_batch_b_;
 
-#if defined(__aarch64__) && defined(__linux__)
+  cpu::tunable::CpuTuningContext* tuning_ctx_{nullptr};
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
   // fastmath mode state
   bool use_fastmath_mode_;
   // sbgemm kernel is implemented as 8x8 blocks with weights pre-packed to 4 blocks of 4x2
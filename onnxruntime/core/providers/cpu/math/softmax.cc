@@ -5,6 +5,9 @@
 #include "core/providers/cpu/tensor/transpose.h"
 #include <vector>
 #include <numeric>
+#include <type_traits>
+
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -139,6 +142,16 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
   // and perform softmax and then reverse the transpose. We can skip the transposing aspect if the axis is already
   // the innermost dim
   if (axis != (rank - 1)) {
+    if constexpr (std::is_same<T, float>::value) {
+      // the float kernel reads the elements along the axis with a stride, so no transpose is needed
+      MlasComputeSoftmaxStrided(input.Data<float>(), output.MutableData<float>(),
+                                onnxruntime::narrow<size_t>(X_shape.SizeToDimension(axis)),
+                                onnxruntime::narrow<size_t>(X_shape[axis]),
+                                onnxruntime::narrow<size_t>(X_shape.SizeFromDimension(axis + 1)),
+                                log_softmax_, thread_pool);
+      return Status::OK();
+    }
+
     is_transpose_required = true;
   }
 
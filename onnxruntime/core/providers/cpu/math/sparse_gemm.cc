@@ -0,0 +1,221 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/math/sparse_gemm.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "core/common/parse_string.h"
+#include "core/common/safeint.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// The packed buffer is the header, the K + 1 row offsets in blocks, the column of the first element of every block
+// and the block values, which start on a 64 byte boundary.
+struct SparseGemmPackedBHeader {
+  uint64_t K;
+  uint64_t N;
+  uint64_t block_width;
+  uint64_t block_count;
+};
+
+struct SparseGemmPackedBLayout {
+  size_t row_offsets;
+  size_t block_columns;
+  size_t values;
+  size_t size;
+};
+
+constexpr size_t kSparseGemmValuesAlignment = 64;
+
+SparseGemmPackedBLayout GetPackedBLayout(size_t K, size_t block_width, size_t block_count) {
+  SparseGemmPackedBLayout layout;
+  layout.row_offsets = sizeof(SparseGemmPackedBHeader);
+  layout.block_columns = layout.row_offsets + SafeInt<size_t>(K + 1) * sizeof(uint64_t);
+  size_t values = layout.block_columns + SafeInt<size_t>(block_count) * sizeof(uint32_t);
+  layout.values = (values + kSparseGemmValuesAlignment - 1) / kSparseGemmValuesAlignment * kSparseGemmValuesAlignment;
+  layout.size = layout.values + SafeInt<size_t>(block_count) * block_width * sizeof(float);
+  return layout;
+}
+
+template <size_t BlockWidth>
+void SparseGemmRow(size_t N, size_t K, float alpha, const float* a, size_t a_stride,
+                   const uint64_t* row_offsets, const uint32_t* block_columns, const float* values, float* c) {
+  for (size_t k = 0; k < K; k++) {
+    const float a_k = alpha * a[k * a_stride];
+    for (uint64_t block = row_offsets[k]; block < row_offsets[k + 1]; block++) {
+      const size_t column = block_columns[block];
+      const float* v = values + block * BlockWidth;
+      float* c_block = c + column;
+      if (column + BlockWidth <= N) {
+        for (size_t j = 0; j < BlockWidth; j++) {
+          c_block[j] += a_k * v[j];
+        }
+      } else {
+        // the last block of a row that is not a multiple of the block width
+        for (size_t j = 0; j < N - column; j++) {
+          c_block[j] += a_k * v[j];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+float GetSparseWeightDensityThreshold(const OpKernelInfo& info) {
+  const std::string threshold_str =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsSparseWeightDensityThreshold, "0");
+  float threshold = 0.0f;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(threshold_str, threshold) && threshold >= 0.0f && threshold <= 1.0f,
+              "Invalid value for ", kOrtSessionOptionsSparseWeightDensityThreshold, ": ", threshold_str);
+  return threshold;
+}
+
+bool GemmPackBSparseFp32(AllocatorPtr& alloc,
+                         const Tensor& tensor_b,
+                         bool trans_b,
+                         float density_threshold,
+                         IAllocatorUniquePtr<void>& packed_b,
+                         size_t& packed_b_size,
+                         TensorShape& b_shape) {
+  if (density_threshold <= 0.0f || tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const TensorShape& shape = tensor_b.Shape();
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  if (K == 0 || N == 0 || N > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  const float* b_data = tensor_b.Data<float>();
+  auto b_at = [b_data, trans_b, K, N](size_t k, size_t n) {
+    return trans_b ? b_data[n * K + k] : b_data[k * N + n];
+  };
+
+  size_t nonzero_count = 0;
+  size_t nonzero_block_count = 0;
+  for (size_t k = 0; k < K; k++) {
+    for (size_t n0 = 0; n0 < N; n0 += kSparseGemmBlockWidth) {
+      const size_t n_end = std::min(N, n0 + kSparseGemmBlockWidth);
+      size_t block_nonzero_count = 0;
+      for (size_t n = n0; n < n_end; n++) {
+        block_nonzero_count += b_at(k, n) != 0.0f;
+      }
+      nonzero_count += block_nonzero_count;
+      nonzero_block_count += block_nonzero_count != 0;
+    }
+  }
+
+  if (static_cast<double>(nonzero_count) >= static_cast<double>(density_threshold) * static_cast<double>(K * N)) {
+    return false;
+  }
+
+  // the blocks cost about as much as the scalar elements they replace if they are at least half full
+  const size_t block_width = nonzero_block_count * kSparseGemmBlockWidth <= 2 * nonzero_count ? kSparseGemmBlockWidth
+                                                                                               : 1;
+  const size_t block_count = block_width == 1 ? nonzero_count : nonzero_block_count;
+
+  const SparseGemmPackedBLayout layout = GetPackedBLayout(K, block_width, block_count);
+  packed_b_size = layout.size;
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  auto* packed_b_data = static_cast<uint8_t*>(packed_b.get());
+
+  // zero the padding so that the hash of the buffer is deterministic when it is shared between sessions
+  memset(packed_b_data, 0, packed_b_size);
+
+  auto* header = reinterpret_cast<SparseGemmPackedBHeader*>(packed_b_data);
+  header->K = K;
+  header->N = N;
+  header->block_width = block_width;
+  header->block_count = block_count;
+
+  auto* row_offsets = reinterpret_cast<uint64_t*>(packed_b_data + layout.row_offsets);
+  auto* block_columns = reinterpret_cast<uint32_t*>(packed_b_data + layout.block_columns);
+  auto* values = reinterpret_cast<float*>(packed_b_data + layout.values);
+
+  size_t block = 0;
+  for (size_t k = 0; k < K; k++) {
+    row_offsets[k] = block;
+    for (size_t n0 = 0; n0 < N; n0 += block_width) {
+      const size_t n_end = std::min(N, n0 + block_width);
+      bool has_nonzero = false;
+      for (size_t n = n0; n < n_end; n++) {
+        has_nonzero = has_nonzero || b_at(k, n) != 0.0f;
+      }
+      if (!has_nonzero) {
+        continue;
+      }
+      block_columns[block] = static_cast<uint32_t>(n0);
+      for (size_t n = n0; n < n_end; n++) {
+        values[block * block_width + (n - n0)] = b_at(k, n);
+      }
+      block++;
+    }
+  }
+  row_offsets[K] = block;
+
+  b_shape = shape;
+  return true;
+}
+
+void SparseGemmFp32(bool trans_a,
+                    size_t M,
+                    size_t N,
+                    size_t K,
+                    float alpha,
+                    const float* A,
+                    size_t lda,
+                    const void* packed_b,
+                    float beta,
+                    float* C,
+                    size_t ldc,
+                    concurrency::ThreadPool* thread_pool) {
+  const auto* packed_b_data = static_cast<const uint8_t*>(packed_b);
+  const auto* header = reinterpret_cast<const SparseGemmPackedBHeader*>(packed_b_data);
+  ORT_ENFORCE(header->K == K && header->N == N, "The sparse packed weight does not match the GEMM shape.");
+
+  const size_t block_width = static_cast<size_t>(header->block_width);
+  const SparseGemmPackedBLayout layout = GetPackedBLayout(K, block_width, static_cast<size_t>(header->block_count));
+  const auto* row_offsets = reinterpret_cast<const uint64_t*>(packed_b_data + layout.row_offsets);
+  const auto* block_columns = reinterpret_cast<const uint32_t*>(packed_b_data + layout.block_columns);
+  const auto* values = reinterpret_cast<const float*>(packed_b_data + layout.values);
+
+  // the element (m, k) of op(A)
+  const size_t a_row_stride = trans_a ? 1 : lda;
+  const size_t a_k_stride = trans_a ? lda : 1;
+
+  // every row of C reads all the stored values of B once
+  const double stored_count = static_cast<double>(header->block_count * block_width);
+  const TensorOpCost cost{static_cast<double>(K) * sizeof(float) + stored_count * sizeof(float),
+                          static_cast<double>(N) * sizeof(float),
+                          2.0 * stored_count};
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(M), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (auto m = static_cast<size_t>(first); m < static_cast<size_t>(last); m++) {
+          float* c = C + m * ldc;
+          if (beta == 0.0f) {
+            std::fill_n(c, N, 0.0f);
+          } else if (beta != 1.0f) {
+            std::transform(c, c + N, c, [beta](float value) { return beta * value; });
+          }
+
+          const float* a = A + m * a_row_stride;
+          if (block_width == kSparseGemmBlockWidth) {
+            SparseGemmRow<kSparseGemmBlockWidth>(N, K, alpha, a, a_k_stride, row_offsets, block_columns, values, c);
+          } else {
+            SparseGemmRow<1>(N, K, alpha, a, a_k_stride, row_offsets, block_columns, values, c);
+          }
+        }
+      });
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Width of the blocks of the blocked CSR weights. A block is processed with a fixed length loop that vectorizes.
+constexpr size_t kSparseGemmBlockWidth = 8;
+
+// Reads kOrtSessionOptionsSparseWeightDensityThreshold. 0 disables the sparse weight packing.
+float GetSparseWeightDensityThreshold(const OpKernelInfo& info);
+
+// Packs the float weight B of a GEMM in blocked CSR form if the fraction of its non-zero elements is below
+// density_threshold. Every row k of the K x N matrix B holds the column-sorted blocks of 1 x kSparseGemmBlockWidth
+// elements that contain a non-zero, or single non-zero elements (CSR) when the non-zeros are too scattered for the
+// blocks to be at least half full. Only 2D weights are packed.
+bool GemmPackBSparseFp32(AllocatorPtr& alloc,
+                         const Tensor& tensor_b,
+                         bool trans_b,
+                         float density_threshold,
+                         IAllocatorUniquePtr<void>& packed_b,
+                         size_t& packed_b_size,
+                         TensorShape& b_shape);
+
+// C = alpha * op(A) * B + beta * C with B packed by GemmPackBSparseFp32. C is overwritten when beta is 0.
+// The rows of C are split across the thread pool.
+void SparseGemmFp32(bool trans_a,
+                    size_t M,
+                    size_t N,
+                    size_t K,
+                    float alpha,
+                    const float* A,
+                    size_t lda,
+                    const void* packed_b,
+                    float beta,
+                    float* C,
+                    size_t ldc,
+                    concurrency::ThreadPool* thread_pool);
+
+}  // namespace onnxruntime
@@ -140,6 +140,73 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// rows of at least twice this size are split into chunks when there are fewer rows than threads
+constexpr int64_t kMinTopKChunkSize = 16 * 1024;
+
+// Selects the top k elements of long contiguous rows when there are too few rows to keep the threads busy, e.g. the
+// logits of a single sequence over a large vocabulary. Each row is split into num_chunks chunks whose top k are found
+// in parallel, and the top k of the row is then selected from the candidates of its chunks. The comparer orders equal
+// values by index, so the result is the same as selecting from the whole row.
+template <class Comparator>
+static void FindTopKElementsInChunks(const typename Comparator::DataType* input_data, int64_t rows, int64_t num_blocks,
+                                     int64_t num_chunks, const unsigned k, bool sorted,
+                                     typename Comparator::DataType* values_data, int64_t* indices_data,
+                                     concurrency::ThreadPool* threadpool) {
+  const size_t candidates_per_row = SafeInt<size_t>(num_chunks) * k;
+  std::vector<int64_t> candidates(SafeInt<size_t>(rows) * candidates_per_row);
+  Comparator comparer(input_data);
+
+  // same selector as FindTopKElements, relative to the chunk size
+  const bool use_priority_queue = k < 4 || (std::log2(k) / std::log2(num_blocks / num_chunks)) < 0.725;
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      threadpool, onnxruntime::narrow<std::ptrdiff_t>(rows * num_chunks),
+      [&](std::ptrdiff_t work_item) {
+        const int64_t row = work_item / num_chunks;
+        const int64_t chunk = work_item % num_chunks;
+        // split evenly so every chunk has at least k elements as num_chunks <= num_blocks / k
+        const int64_t begin = row * num_blocks + chunk * num_blocks / num_chunks;
+        const int64_t end = row * num_blocks + (chunk + 1) * num_blocks / num_chunks;
+        int64_t* chunk_top_k = candidates.data() + work_item * k;
+
+        if (use_priority_queue) {
+          // one pass over the chunk. the heap is only updated for values that beat the current worst of the top k.
+          int64_t cur_idx = begin;
+          for (size_t l = 0; l < k; ++l, ++cur_idx) {
+            chunk_top_k[k - l - 1] = cur_idx;
+            HeapifyIthPosition(chunk_top_k, k - l - 1, k, comparer);
+          }
+
+          auto top = input_data[chunk_top_k[0]];
+          for (; cur_idx < end; ++cur_idx) {
+            if (comparer.CompareValueOnly(input_data[cur_idx], top)) {
+              chunk_top_k[0] = cur_idx;
+              HeapifyIthPosition(chunk_top_k, 0, k, comparer);
+              top = input_data[chunk_top_k[0]];
+            }
+          }
+        } else {
+          std::vector<int64_t> data_holder(onnxruntime::narrow<size_t>(end - begin));
+          SelectTopK<Comparator>(comparer, begin, end - begin, 1, 0, k, false, data_holder);
+          std::copy_n(data_holder.begin(), k, chunk_top_k);
+        }
+      });
+
+  for (int64_t row = 0; row < rows; ++row) {
+    auto row_candidates = candidates.begin() + onnxruntime::narrow<ptrdiff_t>(row * candidates_per_row);
+    std::nth_element(row_candidates, row_candidates + (k - 1), row_candidates + candidates_per_row, comparer);
+    if (sorted) {
+      std::sort(row_candidates, row_candidates + k, comparer);
+    }
+
+    for (size_t l = 0; l < k; ++l) {
+      const int64_t idx = row_candidates[l];
+      values_data[row * k + l] = input_data[idx];
+      indices_data[row * k + l] = idx - row * num_blocks;
+    }
+  }
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -165,6 +232,16 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t block_slice = reduced_cols / k;
 
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+
+  // splitting on rows would leave threads idle, so split each row instead if the rows are long enough
+  if (block_slice == 1 && rows < tp_threads && num_blocks >= 2 * kMinTopKChunkSize) {
+    const int64_t num_chunks = std::min({tp_threads, num_blocks / kMinTopKChunkSize, num_blocks / k});
+    if (num_chunks > 1) {
+      FindTopKElementsInChunks<Comparator>(input_data, rows, num_blocks, num_chunks, k, sorted,
+                                           values_data, indices_data, threadpool);
+      return;
+    }
+  }
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
   // rough attempt to make sure there's enough work for each thread. if there's insufficient work the usage of
@@ -524,5 +524,40 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
     }
   }
 }
+template <typename TMap, typename TKey, typename = void>
+struct MapHasPrefetch : std::false_type {};
+
+template <typename TMap, typename TKey>
+struct MapHasPrefetch<TMap, TKey,
+                      std::void_t<decltype(std::declval<const TMap&>().prefetch(std::declval<const TKey&>()))>>
+    : std::true_type {};
+
+// Replaces each element of input by its value in map, or by default_value if it is not a key.
+// Lookups are independent so the input is split into contiguous blocks across the thread pool.
+// For tables too large to stay in cache, the slot of a key a few elements ahead is prefetched
+// (when the hash map supports it) so that several probes are in flight at once.
+template <typename TMap, typename TKey, typename TValue>
+void BatchedMapLookup(const TMap& map, gsl::span<const TKey> input, gsl::span<TValue> output,
+                      const TValue& default_value, concurrency::ThreadPool* tp) {
+  const auto map_end = map.end();
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(input.size()),
+      TensorOpCost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)), 64.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          if constexpr (MapHasPrefetch<TMap, TKey>::value) {
+            constexpr std::ptrdiff_t kPrefetchDistance = 8;
+            constexpr size_t kPrefetchMinMapSize = 1 << 16;
+            if (i + kPrefetchDistance < last && map.size() >= kPrefetchMinMapSize) {
+              map.prefetch(input[i + kPrefetchDistance]);
+            }
+          }
+          const auto found = map.find(input[i]);
+          output[i] = found == map_end ? default_value : found->second;
+        }
+      });
+}
+
 }  // namespace ml
 }  // namespace onnxruntime
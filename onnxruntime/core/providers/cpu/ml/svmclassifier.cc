@@ -63,6 +63,7 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  // length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    prepare_rbf_kernel(support_vectors_, vector_count_, feature_count_);
   } else {
     feature_count_ = coefficients_.size() / class_count_;  // liblinear mode
     mode_ = SVM_TYPE::SVM_LINEAR;
@@ -247,60 +248,58 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
                               threadpool);
 
+    // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
+    // per class.
+    // coefficients: [num_classes - 1, vector_count_]
+    //
+    // e.g. say you have 3 classes, with 3 x 3 coefficients
+    //
+    // AA AB AC
+    // BA BB BC
+    // CA CB CC
+    //
+    // you can remove the diagonal line of items comparing a class with itself leaving one less row.
+    //
+    // BA AB AC
+    // CA CB BC
+    //
+    // for each class there is a coefficient per support vector, and a class has one or more support vectors.
+    //
+    // Combine the scores for the two combinations for two classes with their coefficient.
+    // e.g. AB combines with BA.
+    // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
+    //
+    // The products of the kernels of the support vectors of class c with every coefficient row are computed
+    // with one GEMM per class: partial_sums: [num_batches, class_count_, class_count_ - 1].
+    const size_t num_rows = onnxruntime::narrow<size_t>(class_count_ - 1);
+    const size_t partial_sums_per_batch = onnxruntime::narrow<size_t>(class_count_) * num_rows;
+    std::vector<float> partial_sums(SafeInt<size_t>(num_batches) * partial_sums_per_batch, 0.f);
+    for (int64_t c = 0; c < class_count_; c++) {
+      const size_t class_support_count = onnxruntime::narrow<size_t>(vectors_per_class_[onnxruntime::narrow<size_t>(c)]);
+      if (class_support_count == 0 || num_rows == 0) {
+        continue;
+      }
+      const size_t start_index = onnxruntime::narrow<size_t>(starting_vector_[onnxruntime::narrow<size_t>(c)]);
+      MlasGemm(CblasNoTrans, CblasTrans, static_cast<size_t>(num_batches), num_rows, class_support_count,
+               1.f, kernels_data.data() + start_index, onnxruntime::narrow<size_t>(vector_count_),
+               coefficients_.data() + start_index, onnxruntime::narrow<size_t>(vector_count_),
+               0.f, partial_sums.data() + c * num_rows, partial_sums_per_batch, threadpool);
+    }
+
     for (int64_t n = 0; n < num_batches; n++) {
-      // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
-      // per class.
-      // coefficients: [num_classes - 1, vector_count_]
-      //
-      // e.g. say you have 3 classes, with 3 x 3 coefficients
-      //
-      // AA AB AC
-      // BA BB BC
-      // CA CB CC
-      //
-      // you can remove the diagonal line of items comparing a class with itself leaving one less row.
-      //
-      // BA AB AC
-      // CA CB BC
-      //
-      // for each class there is a coefficient per support vector, and a class has one or more support vectors.
-      //
-      // Combine the scores for the two combinations for two classes with their coefficient.
-      // e.g. AB combines with BA.
-      // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
-
-      auto cur_kernels = kernels_span.subspan(n * SafeInt<size_t>(vector_count_), onnxruntime::narrow<size_t>(vector_count_));
+      const float* cur_partial_sums = partial_sums.data() + n * partial_sums_per_batch;
       auto cur_scores = classifier_scores.subspan(n * SafeInt<size_t>(num_slots_per_iteration), onnxruntime::narrow<size_t>(num_classifiers));
       auto cur_votes = votes_span.subspan(n * SafeInt<size_t>(class_count_), onnxruntime::narrow<size_t>(class_count_));
       auto scores_iter = cur_scores.begin();
 
       size_t classifier_idx = 0;
       for (int64_t i = 0; i < class_count_ - 1; i++) {
-        int64_t start_index_i = starting_vector_[onnxruntime::narrow<size_t>(i)];  // start of support vectors for class i
-        int64_t class_i_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(i)];
-        int64_t i_coeff_row_offset = vector_count_ * i;
-
         for (int64_t j = i + 1; j < class_count_; j++) {
-          int64_t start_index_j = starting_vector_[onnxruntime::narrow<size_t>(j)];  // start of support vectors for class j
-          int64_t class_j_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(j)];
-          int64_t j_coeff_row_offset = vector_count_ * (j - 1);
-
-          double sum = 0;
-
-          const float* val1 = &(coefficients_[j_coeff_row_offset + SafeInt<size_t>(start_index_i)]);
-          const float* val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_i)]);
-          for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          val1 = &(coefficients_[i_coeff_row_offset + SafeInt<size_t>(start_index_j)]);
-          val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_j)]);
-
-          for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
+          // class i support vectors with coefficient row j - 1, class j support vectors with coefficient row i
+          float sum = cur_partial_sums[i * num_rows + (j - 1)] + cur_partial_sums[j * num_rows + i];
           sum += rho_[classifier_idx++];
 
-          *scores_iter++ = static_cast<float>(sum);
+          *scores_iter++ = sum;
           ++(cur_votes[onnxruntime::narrow<size_t>(sum > 0 ? i : j)]);
         }
       }
@@ -30,6 +30,38 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
+  // The RBF kernel is evaluated as exp(-gamma * (|x|^2 + |s|^2 - 2 x.s)) so that the dot products
+  // between the inputs and the support vectors go through a GEMM. Both are centered on the mean support vector
+  // first to limit the cancellation in the expansion. This precomputes the centered support vectors and their norms.
+  void prepare_rbf_kernel(const gsl::span<const float> support_vectors, ptrdiff_t vector_count,
+                          ptrdiff_t feature_count) {
+    if (kernel_type_ != KERNEL::RBF || vector_count <= 0 || feature_count <= 0) {
+      return;
+    }
+    ORT_ENFORCE(support_vectors.size() == SafeInt<size_t>(vector_count) * feature_count);
+
+    const size_t k = narrow<size_t>(feature_count);
+    rbf_center_.assign(k, 0.f);
+    for (ptrdiff_t v = 0; v < vector_count; ++v) {
+      for (size_t f = 0; f < k; ++f) {
+        rbf_center_[f] += support_vectors[v * k + f];
+      }
+    }
+    for (auto& c : rbf_center_) {
+      c /= static_cast<float>(vector_count);
+    }
+
+    rbf_support_vectors_.resize(support_vectors.size());
+    rbf_squared_norms_.assign(narrow<size_t>(vector_count), 0.f);
+    for (ptrdiff_t v = 0; v < vector_count; ++v) {
+      for (size_t f = 0; f < k; ++f) {
+        float val = support_vectors[v * k + f] - rbf_center_[f];
+        rbf_support_vectors_[v * k + f] = val;
+        rbf_squared_norms_[v] += val * val;
+      }
+    }
+  }
+
   template <typename T>
   void batched_kernel_dot(const gsl::span<const T> a, const gsl::span<const T> b,
                           ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
@@ -39,6 +71,13 @@ class SVMCommon {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
     if (kernel_type_ == KERNEL::RBF) {
+      if constexpr (std::is_same<T, float>::value) {
+        if (rbf_squared_norms_.size() == size_t(n) && rbf_center_.size() == size_t(k)) {
+          batched_rbf_kernel(a, m, n, k, out, threadpool);
+          return;
+        }
+      }
+
       T* cur_out = out.data();
       const T* cur_batch = a.data();
 
@@ -96,15 +135,47 @@ class SVMCommon {
   }
 
  private:
+  void batched_rbf_kernel(const gsl::span<const float> a, ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
+                          const gsl::span<float> out, concurrency::ThreadPool* threadpool) const {
+    const size_t num_features = narrow<size_t>(k);
+    std::vector<float> centered(a.size());
+    std::vector<float> squared_norms(narrow<size_t>(m), 0.f);
+    for (ptrdiff_t batch = 0; batch < m; ++batch) {
+      for (size_t f = 0; f < num_features; ++f) {
+        float val = a[batch * num_features + f] - rbf_center_[f];
+        centered[batch * num_features + f] = val;
+        squared_norms[batch] += val * val;
+      }
+    }
+
+    // out = -2 x.s, then |x - s|^2 = |x|^2 + |s|^2 - 2 x.s
+    MlasGemm(CblasNoTrans, CblasTrans, narrow<size_t>(m), narrow<size_t>(n), num_features,
+             -2.f, centered.data(), num_features, rbf_support_vectors_.data(), num_features,
+             0.f, out.data(), narrow<size_t>(n), threadpool);
+
+    float* cur_out = out.data();
+    for (ptrdiff_t batch = 0; batch < m; ++batch) {
+      for (ptrdiff_t support_vector = 0; support_vector < n; ++support_vector, ++cur_out) {
+        float distance = std::max(*cur_out + squared_norms[batch] + rbf_squared_norms_[support_vector], 0.f);
+        *cur_out = -gamma_ * distance;
+      }
+    }
+    MlasComputeExp(out.data(), out.data(), out.size());
+  }
+
   KERNEL kernel_type_;
   float gamma_{0.f};
   float coef0_{0.f};
   float degree_{0.f};
+  std::vector<float> rbf_center_;
+  std::vector<float> rbf_support_vectors_;
+  std::vector<float> rbf_squared_norms_;
 };
 
 class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
   using SVMCommon::get_kernel_type;
+  using SVMCommon::prepare_rbf_kernel;
   using SVMCommon::set_kernel_type;
 
  public:
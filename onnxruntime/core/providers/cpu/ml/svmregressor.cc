@@ -31,6 +31,7 @@ SVMRegressor<T>::SVMRegressor(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  // length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    prepare_rbf_kernel(support_vectors_, vector_count_, feature_count_);
   } else {
     feature_count_ = coefficients_.size();
     mode_ = SVM_TYPE::SVM_LINEAR;
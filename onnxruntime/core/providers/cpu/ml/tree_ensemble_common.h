@@ -48,8 +48,46 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   std::vector<SparseValue<ThresholdType>> weights_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
 
+  // QuickScorer layout (Lucchese et al., SIGIR 2015), built by InitQuickScorer when every tree has at
+  // most 64 leaves. Each tree keeps a bitvector of its candidate exit leaves ordered from left (true branch)
+  // to right. The false nodes of a row clear the leaves of their true subtree, the exit leaf is the lowest bit
+  // left. Nodes are grouped by feature and sorted by threshold so a row only visits its false nodes.
+  struct QuickScorerNode {
+    ThresholdType threshold;
+    int64_t feature_id;
+    uint32_t tree_id;
+    uint64_t mask;
+  };
+  struct QuickScorerFeature {
+    int64_t feature_id;
+    size_t begin;
+    size_t end;
+  };
+  bool use_quickscorer_;
+  NODE_MODE quickscorer_mode_;
+  std::vector<QuickScorerNode> qs_nodes_;
+  std::vector<QuickScorerFeature> qs_features_;
+  std::vector<TreeNodeElement<ThresholdType>*> qs_leaves_;
+  std::vector<size_t> qs_leaf_offsets_;
+
+  // Trees of depth at most kFlatTreeMaxDepth are also stored as complete binary trees of depth flat_depth_,
+  // built by InitFlatTrees. The nodes of every tree are stored level by level, the children of node i are
+  // 2i+1 (true branch) and 2i+2 (false branch). A leaf above the last level is replicated below so that every
+  // path has the same length and the traversal is a fixed sequence of comparisons without any branch.
+  struct FlatTreeNode {
+    ThresholdType threshold;
+    int32_t feature_id;
+    uint8_t missing_track_true;
+  };
+  using FlatTreeFn = TreeNodeElement<ThresholdType>* (TreeEnsembleCommon::*)(size_t, const InputType*) const;
+  FlatTreeFn flat_tree_fn_;
+  int64_t flat_depth_;
+  std::vector<FlatTreeNode> flat_nodes_;
+  std::vector<TreeNodeElement<ThresholdType>*> flat_leaves_;
+
  public:
-  TreeEnsembleCommon() {}
+  TreeEnsembleCommon()
+      : use_quickscorer_(false), quickscorer_mode_(NODE_MODE::BRANCH_LEQ), flat_tree_fn_(nullptr), flat_depth_(0) {}
 
   virtual Status Init(const OpKernelInfo& info);
   virtual Status compute(OpKernelContext* ctx, const Tensor* X, Tensor* Y, Tensor* label) const;
@@ -83,10 +121,41 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Returns the leaf of tree tree_id reached by x_data, it uses the flattened trees if available.
+  TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(size_t tree_id, const InputType* x_data) const;
+
+  template <int Depth, bool Strict, bool MissingTracks>
+  TreeNodeElement<ThresholdType>* ProcessFlatTree(size_t tree_id, const InputType* x_data) const;
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
 
+  // Fills bitvectors (one per tree) with the remaining candidate leaves of every tree for one row.
+  void ProcessQuickScorer(const InputType* x_data, uint64_t* bitvectors) const;
+
+  template <typename AGG>
+  void ComputeAggQuickScorer(concurrency::ThreadPool* ttp, const InputType* x_data, OutputType* z_data,
+                             int64_t* label_data, int64_t N, int64_t stride, const AGG& agg) const;
+
  private:
+  void InitQuickScorer();
+  bool AddQuickScorerNodes(TreeNodeElement<ThresholdType>* node, uint32_t tree_id, int64_t depth, int64_t& max_depth,
+                           InlinedHashSet<const TreeNodeElement<ThresholdType>*>& visited,
+                           std::vector<QuickScorerNode>& qs_nodes,
+                           std::vector<TreeNodeElement<ThresholdType>*>& qs_leaves, size_t leaf_offset);
+  void InitFlatTrees();
+  template <int Depth>
+  FlatTreeFn SelectFlatTreeFn(bool strict) const {
+    if (strict) {
+      return has_missing_tracks_ ? &TreeEnsembleCommon::ProcessFlatTree<Depth, true, true>
+                                 : &TreeEnsembleCommon::ProcessFlatTree<Depth, true, false>;
+    }
+    return has_missing_tracks_ ? &TreeEnsembleCommon::ProcessFlatTree<Depth, false, true>
+                               : &TreeEnsembleCommon::ProcessFlatTree<Depth, false, false>;
+  }
+  int64_t GetTreeDepth(const TreeNodeElement<ThresholdType>* node, int64_t max_depth) const;
+  void AddFlatNodes(TreeNodeElement<ThresholdType>* node, size_t tree_id, size_t index, int64_t depth);
+
   size_t AddNodes(const size_t i, const InlinedVector<NODE_MODE>& cmodes, const InlinedVector<size_t>& truenode_ids,
                   const InlinedVector<size_t>& falsenode_ids, const std::vector<int64_t>& nodes_featureids,
                   const std::vector<ThresholdType>& nodes_values_as_tensor, const std::vector<float>& node_values,
@@ -338,9 +407,208 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
     }
   }
 
+  InitQuickScorer();
+  InitFlatTrees();
   return Status::OK();
 }
 
+// The QuickScorer evaluator is only worth it when there are enough trees to amortize the scan of
+// the features and when the trees are deep enough for the pointer chasing to dominate.
+constexpr int64_t kQuickScorerMinTrees = 16;
+constexpr size_t kQuickScorerMaxLeaves = 64;
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::InitQuickScorer() {
+  use_quickscorer_ = false;
+  qs_nodes_.clear();
+  qs_features_.clear();
+  qs_leaves_.clear();
+  qs_leaf_offsets_.clear();
+
+  // Sorting thresholds only gives the false nodes as a prefix for a single inequality.
+  // Missing value tracks would require a second scan for NaN values.
+  if (!same_mode_ || has_missing_tracks_ || n_trees_ < kQuickScorerMinTrees) {
+    return;
+  }
+  auto first_node = std::find_if(nodes_.begin(), nodes_.end(),
+                                 [](const TreeNodeElement<ThresholdType>& node) { return node.is_not_leaf(); });
+  if (first_node == nodes_.end()) {
+    return;
+  }
+  NODE_MODE mode = first_node->mode();
+  if (mode != NODE_MODE::BRANCH_LEQ && mode != NODE_MODE::BRANCH_LT) {
+    return;
+  }
+
+  std::vector<QuickScorerNode> qs_nodes;
+  std::vector<TreeNodeElement<ThresholdType>*> qs_leaves;
+  std::vector<size_t> qs_leaf_offsets;
+  InlinedHashSet<const TreeNodeElement<ThresholdType>*> visited;
+  qs_nodes.reserve(nodes_.size());
+  qs_leaf_offsets.reserve(roots_.size() + 1);
+  visited.reserve(nodes_.size());
+  int64_t sum_depth = 0;
+  for (size_t j = 0; j < roots_.size(); ++j) {
+    qs_leaf_offsets.push_back(qs_leaves.size());
+    int64_t depth = 0;
+    if (!AddQuickScorerNodes(roots_[j], static_cast<uint32_t>(j), 0, depth, visited, qs_nodes, qs_leaves,
+                             qs_leaf_offsets.back())) {
+      return;
+    }
+    sum_depth += depth;
+  }
+  qs_leaf_offsets.push_back(qs_leaves.size());
+
+  // Every row scans all the features used by the ensemble, the regular evaluator follows one path per tree.
+  if (max_feature_id_ + 1 >= sum_depth) {
+    return;
+  }
+
+  std::stable_sort(qs_nodes.begin(), qs_nodes.end(), [](const QuickScorerNode& a, const QuickScorerNode& b) {
+    return a.feature_id < b.feature_id || (a.feature_id == b.feature_id && a.threshold < b.threshold);
+  });
+  for (size_t i = 0; i < qs_nodes.size(); ++i) {
+    if (qs_features_.empty() || qs_features_.back().feature_id != qs_nodes[i].feature_id) {
+      qs_features_.push_back({qs_nodes[i].feature_id, i, i});
+    }
+    qs_features_.back().end = i + 1;
+  }
+
+  qs_nodes_ = std::move(qs_nodes);
+  qs_leaves_ = std::move(qs_leaves);
+  qs_leaf_offsets_ = std::move(qs_leaf_offsets);
+  quickscorer_mode_ = mode;
+  use_quickscorer_ = true;
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+bool TreeEnsembleCommon<InputType, ThresholdType, OutputType>::AddQuickScorerNodes(
+    TreeNodeElement<ThresholdType>* node, uint32_t tree_id, int64_t depth, int64_t& max_depth,
+    InlinedHashSet<const TreeNodeElement<ThresholdType>*>& visited, std::vector<QuickScorerNode>& qs_nodes,
+    std::vector<TreeNodeElement<ThresholdType>*>& qs_leaves, size_t leaf_offset) {
+  // Nodes shared by several parents (see AddNodes) do not have a single leaf range.
+  if (!visited.insert(node).second) {
+    return false;
+  }
+  if (!node->is_not_leaf()) {
+    if (qs_leaves.size() - leaf_offset >= kQuickScorerMaxLeaves) {
+      return false;
+    }
+    qs_leaves.push_back(node);
+    max_depth = std::max(max_depth, depth);
+    return true;
+  }
+
+  size_t first_leaf = qs_leaves.size() - leaf_offset;
+  if (!AddQuickScorerNodes(node->truenode_or_weight.ptr, tree_id, depth + 1, max_depth, visited, qs_nodes, qs_leaves,
+                           leaf_offset)) {
+    return false;
+  }
+  size_t n_leaves = qs_leaves.size() - leaf_offset - first_leaf;
+  uint64_t true_leaves = n_leaves >= kQuickScorerMaxLeaves ? ~uint64_t{0} : ((uint64_t{1} << n_leaves) - 1);
+  qs_nodes.push_back({node->value_or_unique_weight, static_cast<int64_t>(node->feature_id), tree_id,
+                      ~(true_leaves << first_leaf)});
+  return AddQuickScorerNodes(node + 1, tree_id, depth + 1, max_depth, visited, qs_nodes, qs_leaves, leaf_offset);
+}
+
+constexpr int64_t kFlatTreeMaxDepth = 8;
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::InitFlatTrees() {
+  flat_tree_fn_ = nullptr;
+  flat_depth_ = 0;
+  flat_nodes_.clear();
+  flat_leaves_.clear();
+
+  // QuickScorer already avoids walking the trees.
+  if (use_quickscorer_ || !same_mode_) {
+    return;
+  }
+  auto first_node = std::find_if(nodes_.begin(), nodes_.end(),
+                                 [](const TreeNodeElement<ThresholdType>& node) { return node.is_not_leaf(); });
+  if (first_node == nodes_.end()) {
+    return;
+  }
+  NODE_MODE mode = first_node->mode();
+  if (mode != NODE_MODE::BRANCH_LEQ && mode != NODE_MODE::BRANCH_LT) {
+    return;
+  }
+  for (auto* root : roots_) {
+    flat_depth_ = std::max(flat_depth_, GetTreeDepth(root, kFlatTreeMaxDepth + 1));
+    if (flat_depth_ > kFlatTreeMaxDepth) {
+      flat_depth_ = 0;
+      return;
+    }
+  }
+
+  const size_t n_internal = (size_t{1} << flat_depth_) - 1;
+  flat_nodes_.resize(roots_.size() * n_internal, FlatTreeNode{0, 0, 0});
+  flat_leaves_.resize(roots_.size() * (n_internal + 1), nullptr);
+  for (size_t j = 0; j < roots_.size(); ++j) {
+    AddFlatNodes(roots_[j], j, 0, 0);
+  }
+
+  bool strict = mode == NODE_MODE::BRANCH_LT;
+  switch (flat_depth_) {
+    case 1:
+      flat_tree_fn_ = SelectFlatTreeFn<1>(strict);
+      break;
+    case 2:
+      flat_tree_fn_ = SelectFlatTreeFn<2>(strict);
+      break;
+    case 3:
+      flat_tree_fn_ = SelectFlatTreeFn<3>(strict);
+      break;
+    case 4:
+      flat_tree_fn_ = SelectFlatTreeFn<4>(strict);
+      break;
+    case 5:
+      flat_tree_fn_ = SelectFlatTreeFn<5>(strict);
+      break;
+    case 6:
+      flat_tree_fn_ = SelectFlatTreeFn<6>(strict);
+      break;
+    case 7:
+      flat_tree_fn_ = SelectFlatTreeFn<7>(strict);
+      break;
+    default:
+      flat_tree_fn_ = SelectFlatTreeFn<8>(strict);
+      break;
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+int64_t TreeEnsembleCommon<InputType, ThresholdType, OutputType>::GetTreeDepth(
+    const TreeNodeElement<ThresholdType>* node, int64_t max_depth) const {
+  // Stops at max_depth, nodes shared by several parents would otherwise be visited many times.
+  if (!node->is_not_leaf() || max_depth == 0) {
+    return 0;
+  }
+  return 1 + std::max(GetTreeDepth(node->truenode_or_weight.ptr, max_depth - 1),
+                      GetTreeDepth(node + 1, max_depth - 1));
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::AddFlatNodes(TreeNodeElement<ThresholdType>* node,
+                                                                            size_t tree_id, size_t index,
+                                                                            int64_t depth) {
+  const size_t n_internal = (size_t{1} << flat_depth_) - 1;
+  if (depth == flat_depth_) {
+    flat_leaves_[tree_id * (n_internal + 1) + index - n_internal] = node;
+    return;
+  }
+  if (node->is_not_leaf()) {
+    flat_nodes_[tree_id * n_internal + index] = {node->value_or_unique_weight, node->feature_id,
+                                                 static_cast<uint8_t>(node->is_missing_track_true() ? 1 : 0)};
+    AddFlatNodes(node->truenode_or_weight.ptr, tree_id, 2 * index + 1, depth + 1);
+    AddFlatNodes(node + 1, tree_id, 2 * index + 2, depth + 1);
+  } else {
+    // Both children of a padding node lead to the same leaf, the comparison does not matter.
+    AddFlatNodes(node, tree_id, 2 * index + 1, depth + 1);
+    AddFlatNodes(node, tree_id, 2 * index + 2, depth + 1);
+  }
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 size_t TreeEnsembleCommon<InputType, ThresholdType, OutputType>::AddNodes(
     const size_t i, const InlinedVector<NODE_MODE>& cmodes, const InlinedVector<size_t>& truenode_ids,
@@ -455,12 +723,18 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
   int64_t* label_data = label == nullptr ? nullptr : label->MutableData<int64_t>();
   auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
 
+  // A single row with many trees is faster when parallelized by trees (sections B, B2).
+  if (use_quickscorer_ && (N > 1 || n_trees_ <= parallel_tree_ || max_num_threads == 1)) {
+    ComputeAggQuickScorer(ttp, x_data, z_data, label_data, N, stride, agg);
+    return;
+  }
+
   if (n_targets_or_classes_ == 1) {
     if (N == 1) {
       ScoreValue<ThresholdType> score = {0, 0};
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A: 1 output, 1 row and not enough trees to parallelize */
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data));
+          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(onnxruntime::narrow<size_t>(j), x_data));
         }
       } else { /* section B: 1 output, 1 row and enough trees to parallelize */
         std::vector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_trees_), {0, 0});
@@ -468,7 +742,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             ttp,
             SafeInt<int32_t>(n_trees_),
             [this, &scores, &agg, x_data](ptrdiff_t j) {
-              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(roots_[j], x_data));
+              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(j, x_data));
             },
             max_num_threads);
 
@@ -499,7 +773,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         }
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(j, x_data + i * stride));
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -524,7 +798,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               for (auto j = work.start; j < work.end; ++j) {
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                 *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+                                                 *ProcessTreeNodeLeave(j, x_data + i * stride));
                 }
               }
             });
@@ -550,7 +824,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
             ScoreValue<ThresholdType> score = {0, 0};
             for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(j, x_data + i * stride));
             }
 
             agg.FinalizeScores1(z_data + i, score,
@@ -563,7 +837,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A2 */
         InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data), weights_);
+          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(onnxruntime::narrow<size_t>(j), x_data), weights_);
         }
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else { /* section B2: 2+ outputs, 1 row, enough trees to parallelize */
@@ -576,7 +850,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               scores[batch_num].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(n_trees_));
               for (auto j = work.start; j < work.end; ++j) {
-                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(roots_[j], x_data), weights_);
+                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(j, x_data), weights_);
               }
             });
         for (size_t i = 1, limit = scores.size(); i < limit; ++i) {
@@ -599,7 +873,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         }
         for (j = 0, limit = roots_.size(); j < limit; ++j) {
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(j, x_data + i * stride), weights_);
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -625,7 +899,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               for (auto j = work.start; j < work.end; ++j) {
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                                                *ProcessTreeNodeLeave(j, x_data + i * stride), weights_);
                 }
               }
             });
@@ -657,7 +931,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (auto i = work.start; i < work.end; ++i) {
               std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
               for (j = 0, limit = roots_.size(); j < limit; ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(j, x_data + i * stride), weights_);
               }
 
               agg.FinalizeScores(scores,
@@ -767,6 +1041,111 @@ TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
   return root;
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+TreeNodeElement<ThresholdType>*
+TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(size_t tree_id,
+                                                                               const InputType* x_data) const {
+  return flat_tree_fn_ != nullptr ? (this->*flat_tree_fn_)(tree_id, x_data)
+                                  : ProcessTreeNodeLeave(roots_[tree_id], x_data);
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <int Depth, bool Strict, bool MissingTracks>
+TreeNodeElement<ThresholdType>*
+TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessFlatTree(size_t tree_id,
+                                                                          const InputType* x_data) const {
+  constexpr size_t n_internal = (size_t{1} << Depth) - 1;
+  const FlatTreeNode* nodes = flat_nodes_.data() + tree_id * n_internal;
+  size_t index = 0;
+  // Depth is a constant, the loop is unrolled and the next index is computed from the comparison.
+  for (int level = 0; level < Depth; ++level) {
+    const FlatTreeNode& node = nodes[index];
+    InputType val = x_data[node.feature_id];
+    bool is_true = Strict ? (val < node.threshold) : (val <= node.threshold);
+    if constexpr (MissingTracks) {
+      is_true = is_true | (static_cast<bool>(node.missing_track_true) & _isnan_(val));
+    }
+    index = 2 * index + 2 - static_cast<size_t>(is_true);
+  }
+  return flat_leaves_[tree_id * (n_internal + 1) + index - n_internal];
+}
+
+inline uint32_t _ctz64_(uint64_t x) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanForward64(&index, x);
+  return static_cast<uint32_t>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint32_t>(__builtin_ctzll(x));
+#else
+  uint32_t index = 0;
+  for (; (x & 1) == 0; x >>= 1) ++index;
+  return index;
+#endif
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessQuickScorer(const InputType* x_data,
+                                                                                  uint64_t* bitvectors) const {
+  std::fill_n(bitvectors, onnxruntime::narrow<size_t>(n_trees_), ~uint64_t{0});
+  const QuickScorerNode* nodes = qs_nodes_.data();
+  // Thresholds are sorted in ascending order so the false nodes of a feature come first.
+  // A NaN value makes every comparison false as in ProcessTreeNodeLeave.
+  if (quickscorer_mode_ == NODE_MODE::BRANCH_LT) {
+    for (const auto& feature : qs_features_) {
+      InputType val = x_data[feature.feature_id];
+      for (size_t k = feature.begin; k < feature.end && !(val < nodes[k].threshold); ++k) {
+        bitvectors[nodes[k].tree_id] &= nodes[k].mask;
+      }
+    }
+  } else {
+    for (const auto& feature : qs_features_) {
+      InputType val = x_data[feature.feature_id];
+      for (size_t k = feature.begin; k < feature.end && !(val <= nodes[k].threshold); ++k) {
+        bitvectors[nodes[k].tree_id] &= nodes[k].mask;
+      }
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename AGG>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAggQuickScorer(
+    concurrency::ThreadPool* ttp, const InputType* x_data, OutputType* z_data, int64_t* label_data, int64_t N,
+    int64_t stride, const AGG& agg) const {
+  // QuickScorer evaluates all trees for one row at once, the computation is parallelized by rows.
+  auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
+  auto num_threads = N <= parallel_N_ ? 1 : std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      ttp,
+      num_threads,
+      [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
+        std::vector<uint64_t> bitvectors(onnxruntime::narrow<size_t>(n_trees_));
+        InlinedVector<ScoreValue<ThresholdType>> scores(
+            n_targets_or_classes_ == 1 ? 0 : onnxruntime::narrow<size_t>(n_targets_or_classes_));
+        auto work = concurrency::ThreadPool::PartitionWork(batch_num, onnxruntime::narrow<ptrdiff_t>(num_threads),
+                                                           onnxruntime::narrow<ptrdiff_t>(N));
+        for (auto i = work.start; i < work.end; ++i) {
+          ProcessQuickScorer(x_data + i * stride, bitvectors.data());
+          if (n_targets_or_classes_ == 1) {
+            ScoreValue<ThresholdType> score = {0, 0};
+            for (size_t j = 0, limit = bitvectors.size(); j < limit; ++j) {
+              agg.ProcessTreeNodePrediction1(score, *qs_leaves_[qs_leaf_offsets_[j] + _ctz64_(bitvectors[j])]);
+            }
+            agg.FinalizeScores1(z_data + i, score, label_data == nullptr ? nullptr : (label_data + i));
+          } else {
+            std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
+            for (size_t j = 0, limit = bitvectors.size(); j < limit; ++j) {
+              agg.ProcessTreeNodePrediction(scores, *qs_leaves_[qs_leaf_offsets_[j] + _ctz64_(bitvectors[j])],
+                                            weights_);
+            }
+            agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
+                               label_data == nullptr ? nullptr : (label_data + i));
+          }
+        }
+      });
+}
+
 // TI: input type
 // TH: threshold type, double if T==double, float otherwise
 // TO: output type
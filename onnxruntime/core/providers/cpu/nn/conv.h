@@ -30,10 +30,22 @@ class Conv<float> : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+  // filter transformed for the Winograd convolution of 3x3 kernels with unit strides and dilations
+  TensorShape filter_shape_;
+  BufferUniquePtr packed_filter_;
 };
 
 }  // namespace onnxruntime
@@ -271,23 +271,45 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
           thread_pool);
 
       if (p.X->Shape().NumDimensions() == 4) {
-        math::Col2im<float, CPUMathUtil, StorageOrder::NCHW>(
-            col_buffer_data,
-            p.num_output_channels / conv_transpose_attrs_.group,
-            p.Y->Shape()[2],
-            p.Y->Shape()[3],
-            p.kernel_shape[0],
-            p.kernel_shape[1],
-            p.dilations[0],
-            p.dilations[1],
-            p.pads[0],
-            p.pads[1],
-            p.pads[2],
-            p.pads[3],
-            p.strides[0],
-            p.strides[1],
-            Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
+        // The output channels are independent, so they are accumulated in parallel, and the bias is added to each
+        // channel while it is in cache.
+        const int64_t group_output_channels = p.num_output_channels / conv_transpose_attrs_.group;
+        const int64_t col_channel_size = kernel_size * input_image_size;
+        const float* Bdata = p.B != nullptr ? p.B->Data<float>() + group_id * group_output_channels : nullptr;
+        float* group_Ydata = Ydata + group_id * Y_offset;
+        const TensorOpCost cost{static_cast<double>(col_channel_size * sizeof(float)),
+                                static_cast<double>(output_size * sizeof(float)),
+                                static_cast<double>(col_channel_size)};
+        concurrency::ThreadPool::TryParallelFor(
+            thread_pool, onnxruntime::narrow<std::ptrdiff_t>(group_output_channels), cost,
+            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+              math::Col2im<float, CPUMathUtil, StorageOrder::NCHW>(
+                  col_buffer_data + first * col_channel_size,
+                  last - first,
+                  p.Y->Shape()[2],
+                  p.Y->Shape()[3],
+                  p.kernel_shape[0],
+                  p.kernel_shape[1],
+                  p.dilations[0],
+                  p.dilations[1],
+                  p.pads[0],
+                  p.pads[1],
+                  p.pads[2],
+                  p.pads[3],
+                  p.strides[0],
+                  p.strides[1],
+                  group_Ydata + first * output_size,
+                  &CPUMathUtil::Instance());
+              if (Bdata != nullptr) {
+                for (std::ptrdiff_t c = first; c < last; c++) {
+                  float* channel = group_Ydata + c * output_size;
+                  const float bias = Bdata[c];
+                  for (int64_t i = 0; i < output_size; i++) {
+                    channel[i] += bias;
+                  }
+                }
+              }
+            });
       } else {
         math::Col2imNd<float, CPUMathUtil, StorageOrder::NCHW>(
             col_buffer_data,
@@ -305,7 +327,8 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
       }
     }
 
-    if (p.B != nullptr) {
+    // the bias of 2D convolutions is added by the col2im tasks
+    if (p.B != nullptr && p.X->Shape().NumDimensions() != 4) {
       auto Ymatrix = EigenMatrixMap<float>(Ydata, onnxruntime::narrow<size_t>(output_size), onnxruntime::narrow<size_t>(p.num_output_channels));
       auto Bvec = ConstEigenVectorMap<float>(p.B->Data<float>(), onnxruntime::narrow<size_t>(p.num_output_channels));
       Ymatrix.rowwise() += Bvec.transpose();
@@ -31,10 +31,10 @@ void ComputeJob(
     T* Y_data,
     U* mean_data,
     U* inv_std_dev_data,
-    AllocatorPtr alloc) {
+    float* scratch) {
   ORT_UNUSED_PARAMETER(scale_float_ptr);  // only used in MLFloat16 overload
   ORT_UNUSED_PARAMETER(bias_float_ptr);   // only used in MLFloat16 overload
-  ORT_UNUSED_PARAMETER(alloc);
+  ORT_UNUSED_PARAMETER(scratch);          // only used in MLFloat16 overload
 
   const T* p_input = X_data + task_idx * norm_size;
   T* p_output = Y_data + task_idx * norm_size;
@@ -49,19 +49,24 @@ void ComputeJob(
   }
 
   mean = mean / norm_size;
+  T inv_std_dev;
   if (simplified) {
-    mean_square = sqrt(mean_square / norm_size + epsilon);
+    inv_std_dev = 1 / sqrt(mean_square / norm_size + epsilon);
   } else {
-    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
+    inv_std_dev = 1 / sqrt(mean_square / norm_size - mean * mean + epsilon);
   }
 
-  for (int64_t h = 0; h < norm_size; h++) {
-    if (simplified) {
-      p_output[h] = p_output[h] / mean_square * scale_data[h];
-    } else if (nullptr == bias_data) {
-      p_output[h] = (p_output[h] - mean) / mean_square * scale_data[h];
-    } else {
-      p_output[h] = (p_output[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+  if (simplified) {
+    for (int64_t h = 0; h < norm_size; h++) {
+      p_output[h] = p_output[h] * inv_std_dev * scale_data[h];
+    }
+  } else if (nullptr == bias_data) {
+    for (int64_t h = 0; h < norm_size; h++) {
+      p_output[h] = (p_output[h] - mean) * inv_std_dev * scale_data[h];
+    }
+  } else {
+    for (int64_t h = 0; h < norm_size; h++) {
+      p_output[h] = (p_output[h] - mean) * inv_std_dev * scale_data[h] + bias_data[h];
     }
   }
 
@@ -71,10 +76,11 @@ void ComputeJob(
   }
 
   if (inv_std_dev_data != nullptr) {
-    inv_std_dev_data[task_idx] = gsl::narrow_cast<float>(1 / mean_square);
+    inv_std_dev_data[task_idx] = gsl::narrow_cast<float>(inv_std_dev);
   }
 }
 
+// scratch holds norm_size floats.
 template <typename U>
 void ComputeJob(
     const MLFloat16* X_data,
@@ -89,7 +95,7 @@ void ComputeJob(
     MLFloat16* Y_data,
     U* mean_data,
     U* inv_std_dev_data,
-    AllocatorPtr alloc) {
+    float* scratch) {
   ORT_UNUSED_PARAMETER(scale_data);  // only used in float/double overload
   ORT_UNUSED_PARAMETER(bias_data);   // only used in float/double overload
 
@@ -99,38 +105,39 @@ void ComputeJob(
   float mean(0.0f);
   float mean_square(0.0f);
 
+  // the row is converted once and then normalized and converted back in place
   const size_t num_elems = static_cast<size_t>(norm_size);
-  IAllocatorUniquePtr<float> input_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  MlasConvertHalfToFloatBuffer(p_input, input_float_uptr.get(), num_elems);
-
-  IAllocatorUniquePtr<float> output_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  float* output_float_ptr = output_float_uptr.get();
+  float* value_float_ptr = scratch;
+  MlasConvertHalfToFloatBuffer(p_input, value_float_ptr, num_elems);
 
-  const float* input_float_ptr = input_float_uptr.get();
   for (size_t h = 0; h < num_elems; h++) {
-    output_float_ptr[h] = input_float_ptr[h];
-    mean += input_float_ptr[h];
-    mean_square += input_float_ptr[h] * input_float_ptr[h];
+    mean += value_float_ptr[h];
+    mean_square += value_float_ptr[h] * value_float_ptr[h];
   }
 
   mean = mean / norm_size;
+  float inv_std_dev;
   if (simplified) {
-    mean_square = sqrt(mean_square / norm_size + epsilon);
+    inv_std_dev = 1 / sqrt(mean_square / norm_size + epsilon);
   } else {
-    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
+    inv_std_dev = 1 / sqrt(mean_square / norm_size - mean * mean + epsilon);
   }
 
-  for (size_t h = 0; h < num_elems; h++) {
-    if (simplified) {
-      output_float_ptr[h] = output_float_ptr[h] / mean_square * scale_float_ptr[h];
-    } else if (nullptr == bias_float_ptr) {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * scale_float_ptr[h];
-    } else {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * scale_float_ptr[h] + bias_float_ptr[h];
+  if (simplified) {
+    for (size_t h = 0; h < num_elems; h++) {
+      value_float_ptr[h] = value_float_ptr[h] * inv_std_dev * scale_float_ptr[h];
+    }
+  } else if (nullptr == bias_float_ptr) {
+    for (size_t h = 0; h < num_elems; h++) {
+      value_float_ptr[h] = (value_float_ptr[h] - mean) * inv_std_dev * scale_float_ptr[h];
+    }
+  } else {
+    for (size_t h = 0; h < num_elems; h++) {
+      value_float_ptr[h] = (value_float_ptr[h] - mean) * inv_std_dev * scale_float_ptr[h] + bias_float_ptr[h];
     }
   }
 
-  MlasConvertFloatToHalfBuffer(output_float_ptr, p_output, num_elems);
+  MlasConvertFloatToHalfBuffer(value_float_ptr, p_output, num_elems);
 
   if (mean_data != nullptr) {
     // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
@@ -138,7 +145,7 @@ void ComputeJob(
   }
 
   if (inv_std_dev_data != nullptr) {
-    inv_std_dev_data[task_idx] = MLFloat16(1 / mean_square);
+    inv_std_dev_data[task_idx] = MLFloat16(inv_std_dev);
   }
 }
 
@@ -285,15 +292,25 @@ Status LayerNormImpl::ComputeWithoutContext(
     }
   }
 
-  concurrency::ThreadPool::TryBatchParallelFor(
-      thread_pool, static_cast<int32_t>(norm_count),
-      [&](ptrdiff_t task_idx) {
-        ComputeJob(X_data, scale_data, bias_data, task_idx, norm_size,
-                   prepacked_scale_fp32_data_ ? prepacked_scale_fp32_data_.get() : scale_fp32.get(),
-                   prepacked_bias_fp32_data_ ? prepacked_bias_fp32_data_.get() : bias_fp32.get(),
-                   epsilon, simplified, Y_data, mean_data, inv_std_dev_data, alloc);
-      },
-      0);
+  const double row_size = static_cast<double>(norm_size);
+  const TensorOpCost cost{row_size * sizeof(T) * 2, row_size * sizeof(T), row_size * 6};
+  const float* scale_float_ptr = prepacked_scale_fp32_data_ ? prepacked_scale_fp32_data_.get() : scale_fp32.get();
+  const float* bias_float_ptr = prepacked_bias_fp32_data_ ? prepacked_bias_fp32_data_.get() : bias_fp32.get();
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(norm_count), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        // one buffer for the MLFloat16 rows processed by this thread
+        IAllocatorUniquePtr<float> scratch;
+        if constexpr (std::is_same_v<T, MLFloat16>) {
+          scratch = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(norm_size));
+        }
+
+        for (std::ptrdiff_t task_idx = begin; task_idx < end; ++task_idx) {
+          ComputeJob(X_data, scale_data, bias_data, task_idx, norm_size, scale_float_ptr, bias_float_ptr,
+                     epsilon, simplified, Y_data, mean_data, inv_std_dev_data, scratch.get());
+        }
+      });
 
   return Status::OK();
 }
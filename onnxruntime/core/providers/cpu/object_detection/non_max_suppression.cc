@@ -17,6 +17,7 @@ limitations under the License.
 #include <utility>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -43,6 +44,78 @@ ONNX_OPERATOR_KERNEL_EX(
 
 using namespace nms_helpers;
 
+namespace {
+// The corners and areas of the boxes of a batch. They are computed once and shared by all the classes, instead of
+// being recomputed for every pair of boxes compared.
+struct BoxCorners {
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+
+  void Reset(size_t size) {
+    x_min.resize(size);
+    y_min.resize(size);
+    x_max.resize(size);
+    y_max.resize(size);
+    area.resize(size);
+  }
+
+  void Set(size_t i, const float* box, int64_t center_point_box) {
+    // same computation as SuppressByIOU
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2]
+      MaxMin(box[1], box[3], x_min[i], x_max[i]);
+      MaxMin(box[0], box[2], y_min[i], y_max[i]);
+    } else {
+      // boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      x_min[i] = box[0] - width_half;
+      x_max[i] = box[0] + width_half;
+      y_min[i] = box[1] - height_half;
+      y_max[i] = box[1] + height_half;
+    }
+
+    area[i] = (x_max[i] - x_min[i]) * (y_max[i] - y_min[i]);
+  }
+};
+
+constexpr size_t kIOUBlockSize = 8;
+
+// Returns true if the IOU of box i of 'boxes' with any of the 'selected' boxes exceeds iou_threshold, with the same
+// result as SuppressByIOU. Each block of selected boxes is checked without branches so the compiler can vectorize it.
+bool SuppressedBySelectedBoxes(const BoxCorners& boxes, size_t i, const BoxCorners& selected, size_t num_selected,
+                               float iou_threshold) {
+  const float x_min = boxes.x_min[i];
+  const float y_min = boxes.y_min[i];
+  const float x_max = boxes.x_max[i];
+  const float y_max = boxes.y_max[i];
+  const float area = boxes.area[i];
+
+  for (size_t block_start = 0; block_start < num_selected; block_start += kIOUBlockSize) {
+    const size_t block_end = std::min(block_start + kIOUBlockSize, num_selected);
+    bool suppressed = false;
+    for (size_t j = block_start; j < block_end; ++j) {
+      const float intersection_width = std::min(x_max, selected.x_max[j]) - std::max(x_min, selected.x_min[j]);
+      const float intersection_height = std::min(y_max, selected.y_max[j]) - std::max(y_min, selected.y_min[j]);
+      const float intersection_area = intersection_width * intersection_height;
+      const float union_area = area + selected.area[j] - intersection_area;
+      suppressed |= (intersection_width > 0.f) & (intersection_height > 0.f) & (intersection_area > 0.f) &
+                    (area > 0.f) & (selected.area[j] > 0.f) & (union_area > 0.f) &
+                    (intersection_area / union_area > iou_threshold);
+    }
+
+    if (suppressed) {
+      return true;
+    }
+  }
+
+  return false;
+}
+}  // namespace
+
 // This works for both CPU and GPU.
 // CUDA kernel declare OrtMemTypeCPUInput for max_output_boxes_per_class(2), iou_threshold(3) and score_threshold(4)
 Status NonMaxSuppressionBase::PrepareCompute(OpKernelContext* ctx, PrepareContext& pc) {
@@ -148,55 +221,82 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   };
 
   const auto center_point_box = GetCenterPointBox();
+  const int64_t num_boxes = pc.num_boxes_;
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
+  std::vector<BoxCorners> batch_corners(narrow<size_t>(pc.num_batches_));
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+    BoxCorners& corners = batch_corners[batch_index];
+    corners.Reset(narrow<size_t>(num_boxes));
+    const float* batch_boxes = boxes_data + (batch_index * num_boxes * 4);
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      corners.Set(narrow<size_t>(box_index), batch_boxes + box_index * 4, center_point_box);
+    }
+  }
+
+  // the classes of every batch are independent, so they are processed in parallel. the box indices selected for each
+  // are concatenated afterwards to keep the output order.
+  const int64_t num_work_items = pc.num_batches_ * pc.num_classes_;
+  const size_t max_selected = std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), narrow<size_t>(num_boxes));
+  std::vector<std::vector<int64_t>> selected_box_indices(narrow<size_t>(num_work_items));
+  const TensorOpCost cost{static_cast<double>(num_boxes * (sizeof(float) + sizeof(BoxInfoPtr))),
+                          static_cast<double>(max_selected * sizeof(int64_t)),
+                          static_cast<double>(num_boxes) * (16 + static_cast<double>(max_selected))};
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(num_work_items), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        BoxCorners selected_corners;
+        selected_corners.Reset(max_selected);
+
+        for (std::ptrdiff_t work_item = first; work_item < last; ++work_item) {
+          const int64_t batch_index = work_item / pc.num_classes_;
+          const BoxCorners& corners = batch_corners[narrow<size_t>(batch_index)];
+          std::vector<int64_t>& selected_boxes_inside_class = selected_box_indices[narrow<size_t>(work_item)];
+          std::vector<BoxInfoPtr> candidate_boxes;
+          candidate_boxes.reserve(narrow<size_t>(num_boxes));
+
+          // Filter by score_threshold_
+          const auto* class_scores = scores_data + work_item * num_boxes;
+          if (pc.score_threshold_ != nullptr) {
+            for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
+              if (*class_scores > score_threshold) {
+                candidate_boxes.emplace_back(*class_scores, box_index);
+              }
+            }
+          } else {
+            for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
+              candidate_boxes.emplace_back(*class_scores, box_index);
+            }
           }
+          std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
+
+          // Get the next box with top score, filter by iou_threshold
+          while (!sorted_boxes.empty() && selected_boxes_inside_class.size() < max_selected) {
+            const size_t box_index = narrow<size_t>(sorted_boxes.top().index_);
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
+            const size_t num_selected = selected_boxes_inside_class.size();
+            if (!SuppressedBySelectedBoxes(corners, box_index, selected_corners, num_selected, iou_threshold)) {
+              selected_corners.x_min[num_selected] = corners.x_min[box_index];
+              selected_corners.y_min[num_selected] = corners.y_min[box_index];
+              selected_corners.x_max[num_selected] = corners.x_max[box_index];
+              selected_corners.y_max[num_selected] = corners.y_max[box_index];
+              selected_corners.area[num_selected] = corners.area[box_index];
+              selected_boxes_inside_class.push_back(static_cast<int64_t>(box_index));
+            }
+            sorted_boxes.pop();
+          }  // while
         }
+      });
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  // while
-    }  // for class_index
-  }  // for batch_index
+  std::vector<SelectedIndex> selected_indices;
+  for (int64_t work_item = 0; work_item < num_work_items; ++work_item) {
+    const int64_t batch_index = work_item / pc.num_classes_;
+    const int64_t class_index = work_item % pc.num_classes_;
+    for (int64_t box_index : selected_box_indices[narrow<size_t>(work_item)]) {
+      selected_indices.emplace_back(batch_index, class_index, box_index);
+    }
+  }
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
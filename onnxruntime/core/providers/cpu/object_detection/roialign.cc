@@ -154,6 +154,49 @@ static void PreCalcForBilinearInterpolate(const int64_t height, const int64_t wi
   }
 }
 
+// pools the channels [c_begin, c_end) of a roi with the indices and weights of its bilinear samples.
+template <typename T>
+void RoiAlignPoolChannels(const PreCalc<T>* pre_calc, const T* bottom_data, int64_t height, int64_t width,
+                          int64_t pooled_height, int64_t pooled_width, int64_t roi_bin_grid_h, int64_t roi_bin_grid_w,
+                          RoiAlignMode mode, int64_t c_begin, int64_t c_end, T* top_data) {
+  const int64_t pooled_size = pooled_height * pooled_width;
+  const int64_t count = roi_bin_grid_h * roi_bin_grid_w;
+
+  for (int64_t c = c_begin; c < c_end; c++) {
+    const T* offset_bottom_data = bottom_data + c * height * width;
+    T* offset_top_data = top_data + c * pooled_size;
+    const PreCalc<T>* pc = pre_calc;
+
+    for (int64_t index = 0; index < pooled_size; index++) {
+      T output_val = 0.;
+      if (mode == RoiAlignMode::avg) {  // avg pooling
+        for (const PreCalc<T>* bin_end = pc + count; pc != bin_end; ++pc) {
+          output_val += pc->w1 * offset_bottom_data[pc->pos1] + pc->w2 * offset_bottom_data[pc->pos2] +
+                        pc->w3 * offset_bottom_data[pc->pos3] + pc->w4 * offset_bottom_data[pc->pos4];
+        }
+        // We do average (integral) pooling inside a bin
+        output_val /= std::max(count, static_cast<int64_t>(1));  // e.g. = 4
+      } else {  // max pooling
+        bool max_flag = false;
+        for (const PreCalc<T>* bin_end = pc + count; pc != bin_end; ++pc) {
+          T val = std::max(
+              std::max(std::max(pc->w1 * offset_bottom_data[pc->pos1], pc->w2 * offset_bottom_data[pc->pos2]),
+                       pc->w3 * offset_bottom_data[pc->pos3]),
+              pc->w4 * offset_bottom_data[pc->pos4]);
+          if (!max_flag) {
+            output_val = val;
+            max_flag = true;
+          } else {
+            output_val = std::max(output_val, val);
+          }
+        }
+      }
+
+      offset_top_data[index] = output_val;
+    }
+  }
+}
+
 template <typename T>
 void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, float spatial_scale, int64_t height,
                      int64_t width, int64_t sampling_ratio, const T* bottom_rois, int64_t num_roi_cols, T* top_data,
@@ -163,98 +206,75 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
 
-  // 100 is a random chosed value, need be tuned
-  double cost = static_cast<double>(channels * pooled_width * pooled_height * 100);
-
-  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
-    for (; n != end; ++n) {
-      int64_t index_n = n * channels * pooled_width * pooled_height;
-
-      const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
-      const auto roi_batch_ind = batch_indices_ptr[n];
-
-      // Do not using rounding; this implementation detail is critical
-      T offset = half_pixel ? (T)0.5 : (T)0.0;
-      T roi_start_w = offset_bottom_rois[0] * spatial_scale - offset;
-      T roi_start_h = offset_bottom_rois[1] * spatial_scale - offset;
-      T roi_end_w = offset_bottom_rois[2] * spatial_scale - offset;
-      T roi_end_h = offset_bottom_rois[3] * spatial_scale - offset;
-
-      T roi_width = roi_end_w - roi_start_w;
-      T roi_height = roi_end_h - roi_start_h;
-      if (!half_pixel) {
-        // Force malformed ROIs to be 1x1
-        roi_width = std::max(roi_width, (T)1.);
-        roi_height = std::max(roi_height, (T)1.);
-      }
+  // computes the indices and weights of the bilinear samples of roi n, which are shared by all channels.
+  // this is the key point of optimization
+  auto pre_calc_roi = [&](int64_t n, std::vector<PreCalc<T>>& pre_calc, int64_t& roi_bin_grid_h,
+                          int64_t& roi_bin_grid_w) {
+    const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+
+    // Do not using rounding; this implementation detail is critical
+    T offset = half_pixel ? (T)0.5 : (T)0.0;
+    T roi_start_w = offset_bottom_rois[0] * spatial_scale - offset;
+    T roi_start_h = offset_bottom_rois[1] * spatial_scale - offset;
+    T roi_end_w = offset_bottom_rois[2] * spatial_scale - offset;
+    T roi_end_h = offset_bottom_rois[3] * spatial_scale - offset;
+
+    T roi_width = roi_end_w - roi_start_w;
+    T roi_height = roi_end_h - roi_start_h;
+    if (!half_pixel) {
+      // Force malformed ROIs to be 1x1
+      roi_width = std::max(roi_width, (T)1.);
+      roi_height = std::max(roi_height, (T)1.);
+    }
 
-      T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
-      T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
-
-      // We use roi_bin_grid to sample the grid and mimic integral
-      int64_t roi_bin_grid_h = (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_height / pooled_height));  // e.g., = 2
-      int64_t roi_bin_grid_w =
-          (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
-
-      // We do average (integral) pooling inside a bin
-      const int64_t count = std::max(roi_bin_grid_h * roi_bin_grid_w, static_cast<int64_t>(1));  // e.g. = 4
-
-      // we want to precalculate indices and weights shared by all channels,
-      // this is the key point of optimization
-      std::vector<PreCalc<T>> pre_calc(roi_bin_grid_h * roi_bin_grid_w * pooled_width * SafeInt<size_t>(pooled_height));
-      PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
-                                    roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
-                                    roi_bin_grid_w, pre_calc);
-
-      for (int64_t c = 0; c < channels; c++) {
-        int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-        const T* offset_bottom_data =
-            bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-        int64_t pre_calc_index = 0;
-
-        for (int64_t ph = 0; ph < pooled_height; ph++) {
-          for (int64_t pw = 0; pw < pooled_width; pw++) {
-            int64_t index = index_n_c + ph * pooled_width + pw;
-
-            T output_val = 0.;
-            if (mode == RoiAlignMode::avg) {  // avg pooling
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[onnxruntime::narrow<size_t>(pre_calc_index)];
-                  output_val += pc.w1 * offset_bottom_data[pc.pos1] + pc.w2 * offset_bottom_data[pc.pos2] +
-                                pc.w3 * offset_bottom_data[pc.pos3] + pc.w4 * offset_bottom_data[pc.pos4];
-
-                  pre_calc_index += 1;
-                }
-              }
-              output_val /= count;
-            } else {  // max pooling
-              bool max_flag = false;
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[onnxruntime::narrow<size_t>(pre_calc_index)];
-                  T val = std::max(
-                      std::max(std::max(pc.w1 * offset_bottom_data[pc.pos1], pc.w2 * offset_bottom_data[pc.pos2]),
-                               pc.w3 * offset_bottom_data[pc.pos3]),
-                      pc.w4 * offset_bottom_data[pc.pos4]);
-                  if (!max_flag) {
-                    output_val = val;
-                    max_flag = true;
-                  } else {
-                    output_val = std::max(output_val, val);
-                  }
-
-                  pre_calc_index += 1;
-                }
-              }
-            }
-
-            top_data[index] = output_val;
-          }  // for pw
-        }  // for ph
-      }  // for c
-    }  // for n
-  });
+    T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
+    T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
+
+    // We use roi_bin_grid to sample the grid and mimic integral
+    roi_bin_grid_h = (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_height / pooled_height));  // e.g., = 2
+    roi_bin_grid_w =
+        (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
+
+    pre_calc.resize(roi_bin_grid_h * roi_bin_grid_w * pooled_width * SafeInt<size_t>(pooled_height));
+    PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
+                                  roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
+                                  roi_bin_grid_w, pre_calc);
+  };
+
+  const int64_t roi_output_size = channels * pooled_width * pooled_height;
+  const int64_t image_size = channels * height * width;
+
+  if (n_rois >= ThreadPool::DegreeOfParallelism(ttp)) {
+    // 100 is a random chosed value, need be tuned
+    double cost = static_cast<double>(roi_output_size * 100);
+
+    ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
+      std::vector<PreCalc<T>> pre_calc;
+      for (; n != end; ++n) {
+        int64_t roi_bin_grid_h = 0;
+        int64_t roi_bin_grid_w = 0;
+        pre_calc_roi(n, pre_calc, roi_bin_grid_h, roi_bin_grid_w);
+        RoiAlignPoolChannels(pre_calc.data(), bottom_data + batch_indices_ptr[n] * image_size, height, width,
+                             pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w, mode, 0, channels,
+                             top_data + n * roi_output_size);
+      }
+    });
+  } else {
+    // too few rois to keep the threads busy, e.g. a second stage detector with a small batch of proposals.
+    // parallelize over the channels of each roi instead.
+    std::vector<PreCalc<T>> pre_calc;
+    for (int64_t n = 0; n < n_rois; ++n) {
+      int64_t roi_bin_grid_h = 0;
+      int64_t roi_bin_grid_w = 0;
+      pre_calc_roi(n, pre_calc, roi_bin_grid_h, roi_bin_grid_w);
+      const double cost = static_cast<double>(pre_calc.size() * 10);
+      ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(channels), cost, [&](ptrdiff_t c, ptrdiff_t end) {
+        RoiAlignPoolChannels(pre_calc.data(), bottom_data + batch_indices_ptr[n] * image_size, height, width,
+                             pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w, mode, c, end,
+                             top_data + n * roi_output_size);
+      });
+    }
+  }
 }
 }  // namespace
 
@@ -969,24 +969,39 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
             gemm_params.C = worker_gemm_output + group_id * group_output_channels;
             gemm_params.ldc = static_cast<size_t>(M);
 
+            // Requantize each block of the GEMM output as soon as it is computed, while it is still in cache.
+            const bool per_channel_scale = output_scales.size() > 1;
+            MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR requant_proc(
+                worker_output + group_id * group_output_channels,
+                static_cast<size_t>(M),
+                Bdata != nullptr ? Bdata + group_id * group_output_channels : nullptr,
+                output_scales.data() + (per_channel_scale ? group_id * group_output_channels : 0),
+                per_channel_scale,
+                Y_zero_point_value,
+                std::is_signed<ActType>::value);
+            gemm_params.OutputProcessor = &requant_proc;
+
             MlasGemm(gemm_shape, gemm_params, nullptr);
           }
         }
       }
 
-      MlasRequantizeOutput(
-          worker_gemm_output,
-          static_cast<size_t>(M),
-          worker_output,
-          static_cast<size_t>(M),
-          Bdata,
-          output_scales.data(),
-          output_scales.size() > 1,
-          Y_zero_point_value,
-          0,
-          0,
-          static_cast<size_t>(output_count),
-          static_cast<size_t>(M));
+      // The symmetric GEMM and the depthwise kernels don't requantize their output.
+      if (is_depthwise_conv || is_symmetric_gemm_) {
+        MlasRequantizeOutput(
+            worker_gemm_output,
+            static_cast<size_t>(M),
+            worker_output,
+            static_cast<size_t>(M),
+            Bdata,
+            output_scales.data(),
+            output_scales.size() > 1,
+            Y_zero_point_value,
+            0,
+            0,
+            static_cast<size_t>(output_count),
+            static_cast<size_t>(M));
+      }
     };
 
     concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, onnxruntime::narrow<ptrdiff_t>(task_count), conv_worker);
@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include <core/common/safeint.h>
 #include "core/framework/element_type_lists.h"
 #include "core/framework/float8.h"
@@ -262,16 +266,119 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 }  // namespace contrib
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
-template <typename T, typename OutT, bool is_4bit>
-struct DequantizeLinearApply;
+namespace {
+
+// Converts `count` quantized elements, starting at element `offset` of `input`, to float.
+template <typename T>
+void UnpackQuantizedToFloat(const T* input, size_t offset, size_t count, float* output) {
+  if constexpr (boost::mp11::mp_contains<TypeList<Int4x2, UInt4x2>, T>::value) {
+    if (count == 0) {
+      return;
+    }
+
+    const T* packed = input + (offset >> 1);
+    size_t i = 0;
+    if (offset & 0x1) {
+      output[i++] = static_cast<float>(packed->GetElem(1));
+      ++packed;
+    }
+
+    // unpack both elements of a byte with shifts instead of GetElem, so that the loop vectorizes
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(packed);
+    const size_t pair_count = (count - i) >> 1;
+    float* pair_output = output + i;
+    for (size_t p = 0; p < pair_count; ++p) {
+      const uint8_t bits = bytes[p];
+      if constexpr (std::is_same_v<T, Int4x2>) {
+        pair_output[2 * p] = static_cast<float>(static_cast<int8_t>(static_cast<uint8_t>(bits << 4)) >> 4);
+        pair_output[2 * p + 1] = static_cast<float>(static_cast<int8_t>(bits) >> 4);
+      } else {
+        pair_output[2 * p] = static_cast<float>(bits & 0xF);
+        pair_output[2 * p + 1] = static_cast<float>(bits >> 4);
+      }
+    }
+
+    i += 2 * pair_count;
+    if (i < count) {
+      output[i] = static_cast<float>(packed[pair_count].GetElem(0));
+    }
+  } else {
+    input += offset;
+    for (size_t i = 0; i < count; ++i) {
+      output[i] = static_cast<float>(input[i]);
+    }
+  }
+}
+
+// values[i] = (values[i] - zero_point[i]) * scale[i]. zero_point may be null.
+void ScaleDequantizedValues(float* values, size_t count, const float* scale, const float* zero_point) {
+  if (zero_point) {
+    for (size_t i = 0; i < count; ++i) {
+      values[i] = (values[i] - zero_point[i]) * scale[i];
+    }
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      values[i] *= scale[i];
+    }
+  }
+}
+
+// values[i] = (values[i] - zero_point) * scale
+void ScaleDequantizedValues(float* values, size_t count, float scale, float zero_point) {
+  for (size_t i = 0; i < count; ++i) {
+    values[i] = (values[i] - zero_point) * scale;
+  }
+}
+
+// The scales as float. `buffer` holds `count` values and is only used to convert float16 scales.
+const float* ScaleAsFloat(const float* scale, size_t /*count*/, float* /*buffer*/) {
+  return scale;
+}
+
+const float* ScaleAsFloat(const MLFloat16* scale, size_t count, float* buffer) {
+  MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(scale), buffer, count);
+  return buffer;
+}
+
+/**
+ * @brief Dequantizes `count` consecutive elements, starting at element `offset` of `input`, into `output`.
+ *        The values are computed in float, directly in `output` for float outputs and in `buffer`
+ *        (of `count` floats) for float16 outputs.
+ * @param[in]    scale                  1D array of `count` scales, or a single scale for all the elements
+ * @param[in]    zero_point             same as scale. May be null when it is an array.
+ */
+template <typename T, typename OutT, typename ScaleT>
+void DequantizeElements(const T* input, size_t offset, size_t count, ScaleT scale, ScaleT zero_point,
+                        OutT* output, float* buffer) {
+  if constexpr (std::is_same_v<OutT, float>) {
+    UnpackQuantizedToFloat(input, offset, count, output);
+    ScaleDequantizedValues(output, count, scale, zero_point);
+  } else {
+    UnpackQuantizedToFloat(input, offset, count, buffer);
+    ScaleDequantizedValues(buffer, count, scale, zero_point);
+    MlasConvertFloatToHalfBuffer(buffer, reinterpret_cast<MLAS_FP16*>(output), count);
+  }
+}
+
+template <typename T, typename OutT>
+TensorOpCost DequantizeCost(size_t element_count) {
+  const auto elements = static_cast<double>(element_count);
+  return TensorOpCost{elements * sizeof(T), elements * sizeof(OutT), elements * 2.0};
+}
+
+// number of elements of a row processed by a single task when a whole row shares the same scale
+constexpr size_t kDequantizeChunkSize = 16384;
+
+}  // namespace
 
 // The dimensions before quantize axis and after quantize axis can be flattened.
 // After flattening, the tensor can be represented by a rank-3 tensor.
 // If the quantization happens on the first or last axis, the flattened tensor is
 // effectively rank-2.
 // For per tensor quantization, the tensor is effectively rank-1.
+// The 4-bit types are handled by UnpackQuantizedToFloat, the element indices below are the unpacked indices.
 template <typename T, typename OutT>
-struct DequantizeLinearApply<T, OutT, false> {
+struct DequantizeLinearApply {
   /**
    * @brief Calculate per-tensor/layer or per-axis quantization of DequantizeLinear on the
    *        flattened tensors.
@@ -283,23 +390,64 @@ struct DequantizeLinearApply<T, OutT, false> {
    *                                      for per-axis quantization. i is the quantize axis.
    * @param[out]   output                 same shape as input
    * @param[in]    zero_point             same shape as scale
+   * @param[in]    thread_pool            thread pool to split the rows over
    */
   void op(size_t M, size_t K, size_t N, const T* input,
-          const OutT* scale, OutT* output, const T* zero_point) {
-    for (size_t m = 0; m < M; m++) {
-      for (size_t k = 0; k < K; k++) {
-        auto zp = zero_point ? static_cast<int32_t>(zero_point[k]) : 0;
-        auto sc = static_cast<float>(scale[k]);
-        for (size_t n = 0; n < N; n++) {
-          *output++ = static_cast<OutT>(static_cast<float>(static_cast<int32_t>(*input++) - zp) * sc);
-        }
+          const OutT* scale, OutT* output, const T* zero_point, concurrency::ThreadPool* thread_pool) {
+    constexpr bool is_float = std::is_same_v<OutT, float>;
+
+    if (N == 1) {
+      // quantize axis is the last one, each row of K elements uses all the scales and zero points
+      std::vector<float> scale_buffer(is_float ? 0 : K);
+      std::vector<float> zero_point_buffer(zero_point ? K : 0);
+      const float* row_scale = ScaleAsFloat(scale, K, scale_buffer.data());
+      const float* row_zero_point = nullptr;
+      if (zero_point) {
+        UnpackQuantizedToFloat(zero_point, 0, K, zero_point_buffer.data());
+        row_zero_point = zero_point_buffer.data();
       }
+
+      concurrency::ThreadPool::TryParallelFor(
+          thread_pool, static_cast<std::ptrdiff_t>(M), DequantizeCost<T, OutT>(K),
+          [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+            std::vector<float> buffer(is_float ? 0 : K);
+            for (auto m = static_cast<size_t>(begin), m_end = static_cast<size_t>(end); m < m_end; ++m) {
+              DequantizeElements(input, m * K, K, row_scale, row_zero_point, output + m * K, buffer.data());
+            }
+          });
+      return;
     }
+
+    // each row of N elements has a single scale and zero point. split the rows in chunks so that
+    // per-tensor quantization, which is a single row, is also processed in parallel.
+    const size_t chunk_size = std::min(N, kDequantizeChunkSize);
+    const size_t chunk_count = (N + chunk_size - 1) / chunk_size;
+
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(M * K * chunk_count), DequantizeCost<T, OutT>(chunk_size),
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          std::vector<float> buffer(is_float ? 0 : chunk_size);
+          for (auto task = static_cast<size_t>(begin), task_end = static_cast<size_t>(end); task < task_end; ++task) {
+            const size_t row = task / chunk_count;
+            const size_t k = row % K;
+            const size_t start = (task % chunk_count) * chunk_size;
+            const size_t count = std::min(chunk_size, N - start);
+
+            const auto sc = static_cast<float>(scale[k]);
+            float zp = 0.0f;
+            if (zero_point) {
+              UnpackQuantizedToFloat(zero_point, k, 1, &zp);
+            }
+
+            const size_t offset = row * N + start;
+            DequantizeElements(input, offset, count, sc, zp, output + offset, buffer.data());
+          }
+        });
   }
 
   /**
    * @brief Calculate blocked quantization of DequantizeLinear on the flattened tensors.
-   *        TODO(fajin): add mlas kernel to utilize multithreading, refer MlasDequantizeBlockwise.
+   *        The quantize blocks are split over the thread pool.
    * @param[in]    M                      size of dimensions before the quantize axis
    * @param[in]    K                      dimension of the quantize axis
    * @param[in]    N                      size of dimensions after the quantize axis
@@ -309,116 +457,57 @@ struct DequantizeLinearApply<T, OutT, false> {
    *                                      i is the quantize axis.
    * @param[out]   output                 same shape as input
    * @param[in]    zero_point             same shape as scale
+   * @param[in]    thread_pool            thread pool to split the quantize blocks over
    */
   void op(size_t M, size_t K, size_t N, size_t quant_block_size,
-          const T* input, const OutT* scale, OutT* output, const T* zero_point) {
-    if (zero_point) {
-      for (size_t m = 0; m < M; m++) {
-        for (size_t bd = 0; bd < K; bd += quant_block_size) {
-          for (size_t qb = 0, qb_end = std::min(quant_block_size, K - bd); qb < qb_end; ++qb) {
-            // within the quantize block, the zero point and scale are the same.
-            for (size_t bs = 0; bs < N; bs++) {
-              auto zp = static_cast<int32_t>(zero_point[bs]);
-              auto sc = static_cast<float>(scale[bs]);
-              *output++ = static_cast<OutT>(static_cast<float>(static_cast<int32_t>(*input++) - zp) * sc);
+          const T* input, const OutT* scale, OutT* output, const T* zero_point,
+          concurrency::ThreadPool* thread_pool) {
+    constexpr bool is_float = std::is_same_v<OutT, float>;
+    const size_t block_count = (K + quant_block_size - 1) / quant_block_size;
+    const size_t block_rows = std::min(quant_block_size, K);
+
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(M * block_count), DequantizeCost<T, OutT>(block_rows * N),
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          // when N is 1 the quantize block is a single run of up to block_rows elements
+          std::vector<float> buffer(is_float ? 0 : (N == 1 ? block_rows : N));
+          std::vector<float> scale_buffer(is_float || N == 1 ? 0 : N);
+          std::vector<float> zero_point_buffer(zero_point && N != 1 ? N : 0);
+
+          for (auto task = static_cast<size_t>(begin), task_end = static_cast<size_t>(end); task < task_end; ++task) {
+            // task is m * block_count + block index, which is also the index of the row of scales of the block
+            const size_t bd = (task % block_count) * quant_block_size;
+            const size_t qb_end = std::min(quant_block_size, K - bd);
+            const size_t offset = ((task / block_count) * K + bd) * N;
+
+            if (N == 1) {
+              // quantize axis is the last one, the block is contiguous and shares a single scale and zero point
+              const auto sc = static_cast<float>(scale[task]);
+              float zp = 0.0f;
+              if (zero_point) {
+                UnpackQuantizedToFloat(zero_point, task, 1, &zp);
+              }
+
+              DequantizeElements(input, offset, qb_end, sc, zp, output + offset, buffer.data());
+              continue;
             }
-          }
-
-          // move to the next quantize block
-          zero_point += N;
-          scale += N;
-        }
-      }
-    } else {
-      for (size_t m = 0; m < M; m++) {
-        for (size_t bd = 0; bd < K; bd += quant_block_size) {
-          for (size_t qb = 0, qb_end = std::min(quant_block_size, K - bd); qb < qb_end; ++qb) {
-            // within the quantize block, the zero point and scale are the same.
-            for (size_t bs = 0; bs < N; bs++) {
-              auto sc = static_cast<float>(scale[bs]);
-              *output++ = static_cast<OutT>(static_cast<float>(static_cast<int32_t>(*input++)) * sc);
-            }
-          }
-
-          // move to the next quantize block
-          scale += N;
-        }
-      }
-    }
-  }
-};
-
-template <typename T, typename OutT>
-struct DequantizeLinearApply<T, OutT, true> {
-  // per-tensor/layer or per-axis quantization
-  void op(size_t M, size_t K, size_t N,
-          const T* input, const OutT* scale, OutT* output, const T* zero_point) {
-    size_t input_index = 0;
-
-    for (size_t m = 0; m < M; m++) {
-      for (size_t bd = 0; bd < K; bd++) {
-        size_t bd_i = bd >> 1;  /*bd / 2*/
-        size_t bd_j = bd & 0x1; /*bd % 2*/
-        auto zp = zero_point ? static_cast<int32_t>(zero_point[bd_i].GetElem(bd_j)) : 0;
-        auto sc = static_cast<float>(scale[bd]);
-
-        for (size_t bs = 0; bs < N; bs++) {
-          size_t input_i = input_index >> 1;
-          size_t input_j = input_index & 0x1;
-          int32_t val = static_cast<int32_t>(input[input_i].GetElem(input_j));
-          *output++ = static_cast<OutT>(static_cast<float>(val - zp) * sc);
-          input_index += 1;
-        }
-      }
-    }
 
-    assert(input_index == M * K * N);
-  }
-
-  // Blocked quantization
-  // TODO(fajin) : add mlas kernel to utilize multithreading, refer MlasDequantizeBlockwise.
-  void op(size_t M, size_t K, size_t N, size_t quant_block_size,
-          const T* input, const OutT* scale, OutT* output, const T* zero_point) {
-    size_t input_index = 0;
-
-    if (zero_point) {
-      size_t zp_index = 0;
-
-      for (size_t n = 0; n < M; n++) {
-        for (size_t bd = 0; bd < K; bd += quant_block_size) {
-          for (size_t qb = 0, qb_end = std::min(quant_block_size, K - bd); qb < qb_end; ++qb) {
-            auto q_zp_index = zp_index;
-            for (size_t bs = 0; bs < N; ++bs, ++input_index, ++q_zp_index) {
-              auto zp = static_cast<int32_t>(zero_point[q_zp_index >> 1].GetElem(q_zp_index & 0x1));
-              auto sc = static_cast<float>(scale[bs]);
-
-              int32_t val = static_cast<int32_t>(input[input_index >> 1].GetElem(input_index & 0x1));
-              *output++ = static_cast<OutT>(static_cast<float>(val - zp) * sc);
+            // within the quantize block, the zero point and scale are the same for each of the qb_end rows.
+            const size_t param_offset = task * N;
+            const float* block_scale = ScaleAsFloat(scale + param_offset, N, scale_buffer.data());
+            const float* block_zero_point = nullptr;
+            if (zero_point) {
+              UnpackQuantizedToFloat(zero_point, param_offset, N, zero_point_buffer.data());
+              block_zero_point = zero_point_buffer.data();
             }
-          }
 
-          scale += N;
-          zp_index += N;
-        }
-      }
-    } else {
-      for (size_t n = 0; n < M; n++) {
-        for (size_t bd = 0; bd < K; bd += quant_block_size) {
-          for (size_t qb = 0, qb_end = std::min(quant_block_size, K - bd); qb < qb_end; ++qb) {
-            for (size_t bs = 0; bs < N; ++bs, ++input_index) {
-              auto sc = static_cast<float>(scale[bs]);
-
-              int32_t val = static_cast<int32_t>(input[input_index >> 1].GetElem(input_index & 0x1));
-              *output++ = static_cast<OutT>(static_cast<float>(val) * sc);
+            for (size_t qb = 0; qb < qb_end; ++qb) {
+              const size_t row_offset = offset + qb * N;
+              DequantizeElements(input, row_offset, N, block_scale, block_zero_point, output + row_offset,
+                                 buffer.data());
             }
           }
-
-          scale += N;
-        }
-      }
-    }
-
-    assert(input_index == M * K * N);
+        });
   }
 };
 
@@ -426,10 +515,11 @@ struct DequantizeLinearApply<T, OutT, true> {
 
 #define DEQUANTIZE_LINEAR_APPLY_FLOAT8(T)                                                       \
   template <typename OutT>                                                                      \
-  struct DequantizeLinearApply<T, OutT, false> {                                                \
+  struct DequantizeLinearApply<T, OutT> {                                                       \
     /* Per-tensor/layer or per-axis quantization */                                             \
     void op(size_t M, size_t K, size_t N,                                                       \
-            const T* input, const OutT* scale, OutT* output, const T*) {                        \
+            const T* input, const OutT* scale, OutT* output, const T*,                          \
+            concurrency::ThreadPool*) {                                                         \
       for (size_t m = 0; m < M; m++) {                                                          \
         for (size_t bd = 0; bd < K; bd++) {                                                     \
           auto sc = scale[bd];                                                                  \
@@ -441,7 +531,8 @@ struct DequantizeLinearApply<T, OutT, true> {
     }                                                                                           \
     /* Blocked quantization */                                                                  \
     void op(size_t M, size_t K, size_t N, size_t quant_block_size,                              \
-            const T* input, const OutT* scale, OutT* output, const T*) {                        \
+            const T* input, const OutT* scale, OutT* output, const T*,                          \
+            concurrency::ThreadPool*) {                                                         \
       for (size_t m = 0; m < M; m++) {                                                          \
         for (size_t bd = 0; bd < K; bd += quant_block_size) {                                   \
           for (size_t qb = 0, qb_end = std::min(quant_block_size, K - bd); qb < qb_end; ++qb) { \
@@ -496,37 +587,37 @@ Status DequantizeLinear<T>::Compute(OpKernelContext* ctx) const {
 
   const auto to = x_scale.GetElementType();
   const T* input = x.Data<T>();
-  constexpr bool is_4bit = boost::mp11::mp_contains<TypeList<Int4x2, UInt4x2>, T>::value;
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
   if (to == ONNX_NAMESPACE::TensorProto::FLOAT) {
     const float* scale = x_scale.Data<float>();
     float* output = y.MutableData<float>();
     if (block_size_) {
-      DequantizeLinearApply<T, float, is_4bit>().op(static_cast<size_t>(process_block_count),
-                                                    static_cast<size_t>(broadcast_dim),
-                                                    static_cast<size_t>(process_block_size),
-                                                    static_cast<size_t>(block_size_),
-                                                    input, scale, output, zero_point);
+      DequantizeLinearApply<T, float>().op(static_cast<size_t>(process_block_count),
+                                           static_cast<size_t>(broadcast_dim),
+                                           static_cast<size_t>(process_block_size),
+                                           static_cast<size_t>(block_size_),
+                                           input, scale, output, zero_point, thread_pool);
     } else {
-      DequantizeLinearApply<T, float, is_4bit>().op(static_cast<size_t>(process_block_count),
-                                                    static_cast<size_t>(broadcast_dim),
-                                                    static_cast<size_t>(process_block_size),
-                                                    input, scale, output, zero_point);
+      DequantizeLinearApply<T, float>().op(static_cast<size_t>(process_block_count),
+                                           static_cast<size_t>(broadcast_dim),
+                                           static_cast<size_t>(process_block_size),
+                                           input, scale, output, zero_point, thread_pool);
     }
   } else if (to == ONNX_NAMESPACE::TensorProto::FLOAT16) {
     const MLFloat16* scale = x_scale.Data<MLFloat16>();
     MLFloat16* output = y.MutableData<MLFloat16>();
     if (block_size_) {
-      DequantizeLinearApply<T, MLFloat16, is_4bit>().op(static_cast<size_t>(process_block_count),
-                                                        static_cast<size_t>(broadcast_dim),
-                                                        static_cast<size_t>(process_block_size),
-                                                        static_cast<size_t>(block_size_),
-                                                        input, scale, output, zero_point);
+      DequantizeLinearApply<T, MLFloat16>().op(static_cast<size_t>(process_block_count),
+                                               static_cast<size_t>(broadcast_dim),
+                                               static_cast<size_t>(process_block_size),
+                                               static_cast<size_t>(block_size_),
+                                               input, scale, output, zero_point, thread_pool);
     } else {
-      DequantizeLinearApply<T, MLFloat16, is_4bit>().op(static_cast<size_t>(process_block_count),
-                                                        static_cast<size_t>(broadcast_dim),
-                                                        static_cast<size_t>(process_block_size),
-                                                        input, scale, output, zero_point);
+      DequantizeLinearApply<T, MLFloat16>().op(static_cast<size_t>(process_block_count),
+                                               static_cast<size_t>(broadcast_dim),
+                                               static_cast<size_t>(process_block_size),
+                                               input, scale, output, zero_point, thread_pool);
     }
   } else if (to == ONNX_NAMESPACE::TensorProto::BFLOAT16) {
     ORT_THROW("DequantizeLinear into BFLOAT16 is not implemented yet.");
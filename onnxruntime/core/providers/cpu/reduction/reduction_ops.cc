@@ -825,8 +825,10 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
         }
         case FastReduceKind::kKRK:
           ValidateFastReduceKRK(fast_shape, *output);
-          if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()))) {
-            // See benchmarks in PR #7719.
+          if (FastReduceKRKBlockCount(fast_shape) >=
+              std::max(2, concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()))) {
+            // See benchmarks in PR #7719. The blocks of the columns are split among the threads as well,
+            // so a small outer dimension is fine.
             case_krk(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
             return true;
           } else {
@@ -1095,7 +1097,7 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
         }
       case FastReduceKind::kKRK:
         ValidateFastReduceKRK(fast_shape, *output);
-        if (fast_shape[0] >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(tp))) {
+        if (FastReduceKRKBlockCount(fast_shape) >= std::max(2, concurrency::ThreadPool::DegreeOfParallelism(tp))) {
           // See benchmarks in PR #7719.
           ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, *output, tp);
           return output;
@@ -16,6 +16,7 @@
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/reduction/reduction_kernel_base.h"
 #include "core/common/safeint.h"
+#include <algorithm>
 #include <cmath>
 
 namespace onnxruntime {
@@ -40,6 +41,14 @@ bool operator!=(FastReduceKind a, FastReduceKind b);
 constexpr bool IsFastReduceKindAvailable(FastReduceKind scenario, FastReduceKind available) {
   return (static_cast<uint8_t>(scenario) & static_cast<uint8_t>(available)) > 0;
 }
+/* Number of contiguous output values processed as one unit of work by the KRK fast reductions. */
+constexpr int64_t kFastReduceKRKBlockSize = 256;
+
+/* Number of units of work of the KRK fast reductions, see ReduceAggregator::CommonFastReduceKRK. */
+inline int64_t FastReduceKRKBlockCount(gsl::span<const int64_t> fast_shape) {
+  return fast_shape[0] * ((fast_shape[2] + kFastReduceKRKBlockSize - 1) / kFastReduceKRKBlockSize);
+}
+
 /* Evaluate the cost of parallelized FastReduce implementations. */
 constexpr TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int64_t element_size, int n_ops) {
   return TensorOpCost{static_cast<double>(n_row * n_col * element_size),
@@ -206,6 +215,47 @@ class ReduceAggregator : public ReduceAggregatorBase {
           }
         });
   }
+
+  // Reduces the middle axis of a KRK shape. The columns of every outer index are split in blocks, which are the unit
+  // of work of the thread pool so that a small outer dimension still keeps all the threads busy. Every block is
+  // initialized with the first row and f_update folds the next rows into it, reading contiguous memory.
+  // f_finalize, if given, is applied to every block once all the rows were folded in.
+  static void CommonFastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                  Tensor& output, concurrency::ThreadPool* tp,
+                                  std::function<void(TVAL*, const T*, int64_t)> f_update,
+                                  std::function<void(TVAL*, int64_t)> f_finalize = nullptr) {
+    static_assert(std::is_same_v<T, TVAL>, "the first row initializes the output");
+    const T* data = input.Data<T>();
+    TVAL* out = output.MutableData<TVAL>();
+    int64_t d1 = fast_shape[1];
+    int64_t d2 = fast_shape[2];
+    if (d2 == 0) {
+      return;
+    }
+    int64_t stridei = d1 * d2;
+    int64_t block_size = std::min(d2, kFastReduceKRKBlockSize);
+    int64_t n_blocks = (d2 + block_size - 1) / block_size;
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<ptrdiff_t>(fast_shape[0] * n_blocks),
+        ParallelReduceFastCost(d1, block_size, sizeof(T), 6),
+        [data, out, d1, d2, stridei, block_size, n_blocks, f_update, f_finalize](ptrdiff_t begin, ptrdiff_t last) {
+          for (ptrdiff_t b = begin; b < last; ++b) {
+            int64_t d = b / n_blocks;
+            int64_t j = (b % n_blocks) * block_size;
+            int64_t size = std::min(block_size, d2 - j);
+            const T* p = data + d * stridei + j;
+            TVAL* acc = out + d * d2 + j;
+            std::copy(p, p + size, acc);
+            for (int64_t i = 1; i < d1; ++i) {
+              f_update(acc, p + i * d2, size);
+            }
+            if (f_finalize) {
+              f_finalize(acc, size);
+            }
+          }
+        });
+  }
 };
 
 template <typename T>
@@ -263,18 +313,10 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    int64_t N = fast_shape[2];
-    const T* data = input.Data<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    T* out = output.MutableData<T>();
-    std::vector<T> one(onnxruntime::narrow<size_t>(fast_shape[1]), 1);
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [one, data, fast_shape, stridei, strideo, out, N](ptrdiff_t begin, ptrdiff_t last) {
-          for (ptrdiff_t d = begin; d < last; ++d) {
-            math::MatMul<T>(1, onnxruntime::narrow<ptrdiff_t>(N), onnxruntime::narrow<ptrdiff_t>(fast_shape[1]), one.data(), data + stridei * d, out + strideo * d, nullptr);
-          }
+    ReduceAggregator<T, T>::CommonFastReduceKRK(
+        input, fast_shape, output, tp,
+        [](T* acc, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(acc, size) += ConstEigenVectorArrayMap<T>(p, size);
         });
   }
 
@@ -341,19 +383,16 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, output, tp);
-    int64_t strideo = fast_shape[2];
-    T* out = output.MutableData<T>();
-    T* begin;
-    T* end;
+    // divide each block while it is still in cache
     T div = static_cast<T>(fast_shape[1]);
-    for (int64_t d = 0; d < fast_shape[0]; ++d) {
-      begin = out + strideo * d;
-      end = begin + strideo;
-      for (; begin != end; ++begin) {
-        *begin /= div;
-      }
-    }
+    ReduceAggregator<T, T>::CommonFastReduceKRK(
+        input, fast_shape, output, tp,
+        [](T* acc, const T* p, int64_t size) {
+          EigenVectorArrayMap<T>(acc, size) += ConstEigenVectorArrayMap<T>(p, size);
+        },
+        [div](T* acc, int64_t size) {
+          EigenVectorArrayMap<T>(acc, size) /= div;
+        });
   }
 
   static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -441,28 +480,15 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
+    ReduceAggregator<T, T>::CommonFastReduceKRK(
+        input, fast_shape, output, tp,
+        [](T* acc, const T* p, int64_t size) {
+          for (int64_t j = 0; j < size; ++j) {
             if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
-              EigenVectorMap<bool>(out + j * strideo, onnxruntime::narrow<size_t>(strideo)) =
-                  ConstEigenMatrixMap<bool>(
-                      data + j * stridei, onnxruntime::narrow<size_t>(fast_shape[2]), onnxruntime::narrow<size_t>(fast_shape[1]))
-                      .cast<unsigned char>()
-                      .rowwise()
-                      .maxCoeff()
-                      .cast<bool>();
+              acc[j] = acc[j] || p[j];
             } else {
-              EigenVectorMap<T>(out + j * strideo, onnxruntime::narrow<size_t>(strideo)) =
-                  ConstEigenMatrixMap<T>(
-                      data + j * stridei, onnxruntime::narrow<size_t>(fast_shape[2]), onnxruntime::narrow<size_t>(fast_shape[1]))
-                      .rowwise()
-                      .maxCoeff();
+              if (acc[j] < p[j])
+                acc[j] = p[j];
             }
           }
         });
@@ -651,28 +677,15 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1] * fast_shape[2];
-    int64_t strideo = fast_shape[2];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
-        [data, fast_shape, stridei, strideo, out](ptrdiff_t begin, ptrdiff_t end) {
-          for (ptrdiff_t j = begin; j < end; ++j) {
+    ReduceAggregator<T, T>::CommonFastReduceKRK(
+        input, fast_shape, output, tp,
+        [](T* acc, const T* p, int64_t size) {
+          for (int64_t j = 0; j < size; ++j) {
             if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
-              EigenVectorMap<bool>(out + j * strideo, onnxruntime::narrow<size_t>(strideo)) =
-                  ConstEigenMatrixMap<bool>(
-                      data + j * stridei, onnxruntime::narrow<size_t>(fast_shape[2]), onnxruntime::narrow<size_t>(fast_shape[1]))
-                      .cast<unsigned char>()
-                      .rowwise()
-                      .minCoeff()
-                      .cast<bool>();
+              acc[j] = acc[j] && p[j];
             } else {
-              EigenVectorMap<T>(out + j * strideo, onnxruntime::narrow<size_t>(strideo)) =
-                  ConstEigenMatrixMap<T>(
-                      data + j * stridei, onnxruntime::narrow<size_t>(fast_shape[2]), onnxruntime::narrow<size_t>(fast_shape[1]))
-                      .rowwise()
-                      .minCoeff();
+              if (acc[j] > p[j])
+                acc[j] = p[j];
             }
           }
         });
@@ -520,6 +520,9 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 // Implementation of internal helper code
 namespace detail {
 
+// number of hidden units per work item when the gate activations of a step are split across threads
+constexpr int kGruGateBlockSize = 256;
+
 template <typename T>
 UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
                                         const int seq_length,
@@ -763,6 +766,24 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
     }
   }
 
+  // the gate activations are elementwise, so each batch row is split into blocks of hidden units that are computed
+  // in parallel. this lets a small batch with a large hidden size use the threads between the recurrent GEMMs.
+  const int gate_blocks_per_row = (hidden_size_ + kGruGateBlockSize - 1) / kGruGateBlockSize;
+  const TensorOpCost gate_block_cost{static_cast<double>(kGruGateBlockSize * 4 * sizeof(T)),
+                                     static_cast<double>(kGruGateBlockSize * 2 * sizeof(T)),
+                                     static_cast<double>(kGruGateBlockSize * 32)};
+  auto compute_gate_blocks = [&](auto&& compute_block) {
+    concurrency::ThreadPool::TryParallelFor(
+        ttp_, static_cast<std::ptrdiff_t>(batch_size_) * gate_blocks_per_row, gate_block_cost,
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t block = first; block < last; ++block) {
+            const int r = static_cast<int>(block / gate_blocks_per_row);
+            const int c = static_cast<int>(block % gate_blocks_per_row) * kGruGateBlockSize;
+            compute_block(r, c, std::min(kGruGateBlockSize, hidden_size_ - c));
+          }
+        });
+  };
+
   {
     // Enter a parallel section encompassing the kernels invoked
     // below.  This lets the runtime system amortize loop entry/exit
@@ -839,35 +860,35 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
       }
 
       // 1st Set Of Activations
-      for (int r = 0; r < batch_size_; r++) {
-        const T* p_bias_r = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRr_local + r * hidden_size_,
-                                                               batched_bias_WRr_local_end, hidden_size_)
+      compute_gate_blocks([&](int r, int c, int count) {
+        const T* p_bias_r = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRr_local + r * hidden_size_ + c,
+                                                               batched_bias_WRr_local_end, count)
                                       : nullptr;
 
         // initialize p_rt with input to calculate rt. zrh has Xt*(Wr^T) + Ht-1*(Rr^T).
-        T* p_rt = SafeRawPointer(zrh, out_added_offset + r * hidden_size_x3 + hidden_size_, hidden_size_);
+        T* p_rt = SafeRawPointer(zrh, out_added_offset + r * hidden_size_x3 + hidden_size_ + c, count);
 
         // add the bias and clip. post: p_rt == Xt*(Wr^T) + Ht-1*(Rr^T) + Wbr + Rbr
-        clip_with_bias_ptr_(clip_, p_bias_r, p_rt, hidden_size_);
+        clip_with_bias_ptr_(clip_, p_bias_r, p_rt, count);
 
         if (linear_before_reset_) {
           // p_linear_output = Ht-1 * (Rh^T) + Rbh
-          T* p_linear_output = SafeRawPointer<T>(linear_output_, r * hidden_size_, hidden_size_);
-          T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
+          T* p_linear_output = SafeRawPointer<T>(linear_output_, r * hidden_size_ + c, count);
+          T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_ + c, cur_h_local_end, count);
 
           // calculate rt in-place [p_rt = f(p_rt)]
           // calculate rt (.) (Ht-1 * (Rh^T) + Rbh) using p_linear_output. write to p_cur_h
-          reset_gate_(p_linear_output, p_rt, p_cur_h, hidden_size_, zr_alpha_, zr_beta_);
+          reset_gate_(p_linear_output, p_rt, p_cur_h, count, zr_alpha_, zr_beta_);
 
         } else {
-          const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
-          T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
+          const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_ + c, prev_Ht_end, count);
+          T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_ + c, cur_h_local_end, count);
 
           // calculate rt in-place [p_rt = f(p_rt)]
           // calculate rt (.) Ht-1 using p_prev_Ht, and write to p_cur_h
-          reset_gate_(p_prev_Ht, p_rt, p_cur_h, hidden_size_, zr_alpha_, zr_beta_);
+          reset_gate_(p_prev_Ht, p_rt, p_cur_h, count, zr_alpha_, zr_beta_);
         }
-      }
+      });
 
 #if defined(DUMP_MATRIXES)
       std::string label = linear_before_reset_ ? "rt (.) (Ht-1 * (Rh^T) + Rbh)" : "rt (.) Ht-1";
@@ -934,65 +955,64 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
         output_end = final_hidden_state.end();
       }
 
-      for (int r = 0; r < batch_size_; r++) {
+      compute_gate_blocks([&](int r, int c, int count) {
         if (step >= min_sequence_length && step >= sequence_lengths[r]) {
           // if we need output for every step,
           // or we need to set prev_Ht for an empty sequence to avoid warnings about using uninitialized values
           if (output_sequence || (step == 0 && sequence_lengths[r] == 0)) {
-            auto fill_output = output + r * hidden_size_;
-            std::fill_n(&*fill_output, hidden_size_, T{});
+            auto fill_output = output + r * hidden_size_ + c;
+            std::fill_n(&*fill_output, count, T{});
           }
 
-          continue;
+          return;
         }
 
-        const T* p_bias_z = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRz_local,
-                                                               batched_bias_WRz_local_end, hidden_size_)
+        const T* p_bias_z = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRz_local + c,
+                                                               batched_bias_WRz_local_end, count)
                                       : nullptr;
 
         // initialize p_zt with Xt*(Wz^T) + Ht-1*(Rz^T), which is most of the input to calculate zt:
-        T* p_zt = SafeRawPointer<T>(zrh, out_added_offset + r * hidden_size_x3, hidden_size_);
+        T* p_zt = SafeRawPointer<T>(zrh, out_added_offset + r * hidden_size_x3 + c, count);
 
         // using p_zt, add bias and clip in-place
-        clip_with_bias_ptr_(clip_, p_bias_z, p_zt, hidden_size_);
+        clip_with_bias_ptr_(clip_, p_bias_z, p_zt, count);
 
         // calculate zt in-place. p_zt = f(p_zt)
-        update_gate_(p_zt, hidden_size_, zr_alpha_, zr_beta_);
-
-        DumpMatrix("zt[" + std::to_string(r) + "]" + seqno_str, p_zt, 1, hidden_size_);
+        update_gate_(p_zt, count, zr_alpha_, zr_beta_);
 
         const T* p_bias_h = nullptr;
         if (use_bias_) {
           if (linear_before_reset_) {
             // Wbh
-            p_bias_h = SafeRawConstPointer<T>(batched_bias_Wh_local + r * hidden_size_,
-                                              batched_bias_Wh_local_end, hidden_size_);
+            p_bias_h = SafeRawConstPointer<T>(batched_bias_Wh_local + r * hidden_size_ + c,
+                                              batched_bias_Wh_local_end, count);
 
           } else {
             // Wbh + Wrh
-            p_bias_h = SafeRawConstPointer<T>(batched_bias_WRh_local + r * hidden_size_,
-                                              batched_bias_WRh_local_end, hidden_size_);
+            p_bias_h = SafeRawConstPointer<T>(batched_bias_WRh_local + r * hidden_size_ + c,
+                                              batched_bias_WRh_local_end, count);
           }
         }
 
         // setup p_ht with input to calculate ht
         // p_ht = Xt*(Wh^T) + (rt (.) Ht-1 * Rh^T)          #  linear_before_reset_ == false
         //      = Xt*(Wh^T) + (rt (.) (Ht-1*(Rh^T) + Rbh))  #  linear_before_reset_ == true
-        T* p_ht = SafeRawPointer<T>(zrh, out_added_offset + r * hidden_size_x3 + hidden_size_x2, hidden_size_);
+        T* p_ht = SafeRawPointer<T>(zrh, out_added_offset + r * hidden_size_x3 + hidden_size_x2 + c, count);
 
         // add Wbh [and Wrh] and clip
-        clip_with_bias_ptr_(clip_, p_bias_h, p_ht, hidden_size_);  // post: p_ht == input to g() for calculating ht
-
-        DumpMatrix("ht input [" + std::to_string(r) + "]" + seqno_str, p_ht, 1, hidden_size_);
+        clip_with_bias_ptr_(clip_, p_bias_h, p_ht, count);  // post: p_ht == input to g() for calculating ht
 
-        const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
-        T* p_Ht = SafeRawPointer<T>(output + r * hidden_size_, output_end, hidden_size_);
+        const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_ + c, prev_Ht_end, count);
+        T* p_Ht = SafeRawPointer<T>(output + r * hidden_size_ + c, output_end, count);
 
         // calculate ht = g(p_ht) and write in-place to p_ht
         // calculate Ht = (1 - zt) (.) ht + zt (.) Ht-1 and write to p_Ht
-        output_gate_(p_ht, p_zt, p_prev_Ht, p_Ht, hidden_size_, h_alpha_, h_beta_);  // calculate ht and Ht
-      }
+        output_gate_(p_ht, p_zt, p_prev_Ht, p_Ht, count, h_alpha_, h_beta_);  // calculate ht and Ht
+      });
 
+      DumpMatrix("zt" + seqno_str, zrh.data() + out_added_offset, batch_size_, hidden_size_, 0, hidden_size_x3);
+      DumpMatrix("ht" + seqno_str, zrh.data() + out_added_offset, batch_size_, hidden_size_, hidden_size_x2,
+                 hidden_size_x3);
       DumpMatrix("output" + seqno_str, &*output, batch_size_, hidden_size_);
 
       prev_Ht = output;
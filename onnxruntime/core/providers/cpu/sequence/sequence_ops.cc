@@ -17,9 +17,6 @@ using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
-// TODO: The current implementation of sequence ops relies on tensor copies. Ideally we should try to avoid
-// these copies. This has been postponed due to lack of time.
-
 // SequenceLength
 ONNX_CPU_OPERATOR_KERNEL(
     SequenceLength,
@@ -96,6 +93,8 @@ Status SequenceAt::Compute(OpKernelContext* context) const {
     input_seq_idx = static_cast<int64_t>(X->Size()) + input_seq_idx;
   }
   const Tensor& indexed_tensor = X->Get(onnxruntime::narrow<size_t>(input_seq_idx));
+  // the output is planned like any other tensor, so later nodes may reuse or update its buffer and the indexed
+  // tensor is copied into it.
   auto* Y = context->Output(0, indexed_tensor.Shape().GetDims());
 
   // Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops
@@ -207,6 +206,38 @@ static Tensor CloneTensor(const Tensor& in_tensor, OpKernelContext* context, con
   return tmp;
 }
 
+// Returns whether each input of the node is produced by another node of the same graph, rather than being a graph
+// input, an initializer or an outer scope value. Only the CPU nodes are considered by the allocation planner.
+static InlinedVector<bool> GetInputsProducedInGraph(const OpKernelInfo& info) {
+  const Node& node = info.node();
+  InlinedVector<bool> produced(node.InputDefs().size(), false);
+  if (info.GetExecutionProvider()->Type() == kCpuExecutionProvider) {
+    for (auto it = node.InputEdgesBegin(), end = node.InputEdgesEnd(); it != end; ++it) {
+      produced[static_cast<size_t>(it->GetDstArgIndex())] = true;
+    }
+  }
+  return produced;
+}
+
+// Adds an input tensor to the sequence. The tensor is referenced rather than copied if it is produced by another node
+// of the graph and owns its buffer, as the allocation planner doesn't reuse the buffers of the inputs of the node (see
+// HoldsInputsInOutputSequence() in allocation_planner.cc). Otherwise the buffer may belong to another value or to the
+// caller, so the tensor is copied.
+static void AddInputTensor(OpKernelContext* context, int input_idx, bool is_produced_in_graph,
+                           const DataTransferManager& dtm, TensorSeq& seq) {
+  const OrtValue& input = *context->GetInputOrtValue(input_idx);
+  const Tensor& tensor = input.Get<Tensor>();
+  if (is_produced_in_graph && tensor.OwnsBuffer()) {
+    seq.Add(input);
+  } else {
+    seq.Add(CloneTensor(tensor, context, dtm));
+  }
+}
+
+SequenceInsert::SequenceInsert(const OpKernelInfo& info) : OpKernel(info) {
+  is_tensor_produced_in_graph_ = GetInputsProducedInGraph(info)[1];
+}
+
 Status SequenceInsert::Compute(OpKernelContext* context) const {
   const auto* S = context->Input<TensorSeq>(0);
   const auto* X = context->Input<Tensor>(1);
@@ -239,16 +270,12 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
 
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
-      // Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops
-      Y->Add(CloneTensor(*X, context, Info().GetDataTransferManager()));
-      Y->Add(S->GetAt(i));
-    } else {
-      Y->Add(S->GetAt(i));
+      AddInputTensor(context, 1, is_tensor_produced_in_graph_, Info().GetDataTransferManager(), *Y);
     }
+    Y->Add(S->GetAt(i));
   }
   if (input_seq_idx == num_tensors_input_seq) {
-    // Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops
-    Y->Add(CloneTensor(*X, context, Info().GetDataTransferManager()));
+    AddInputTensor(context, 1, is_tensor_produced_in_graph_, Info().GetDataTransferManager(), *Y);
   }
 
   return Status::OK();
@@ -305,6 +332,10 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("S", DataTypeImpl::AllSequenceTensorTypes()),
     SequenceConstruct);
 
+SequenceConstruct::SequenceConstruct(const OpKernelInfo& info)
+    : OpKernel(info), is_input_produced_in_graph_(GetInputsProducedInGraph(info)) {
+}
+
 Status SequenceConstruct::Compute(OpKernelContext* context) const {
   auto num_inputs = Node().InputArgCount().front();
   ORT_ENFORCE(num_inputs >= 1, "Must have 1 or more inputs");
@@ -321,13 +352,11 @@ Status SequenceConstruct::Compute(OpKernelContext* context) const {
     }
   }
 
-  // now copy the tensors to the output sequence
+  // now add the tensors to the output sequence
   Y->SetType(first_dtype);
   Y->Reserve(SafeInt<size_t>(num_inputs));
   for (int input_idx = 0; input_idx < num_inputs; ++input_idx) {
-    const auto* X = context->Input<Tensor>(input_idx);
-    // Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops
-    Y->Add(CloneTensor(*X, context, Info().GetDataTransferManager()));
+    AddInputTensor(context, input_idx, is_input_produced_in_graph_[static_cast<size_t>(input_idx)], Info().GetDataTransferManager(), *Y);
   }
   return Status::OK();
 }
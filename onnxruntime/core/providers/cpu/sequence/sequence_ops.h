@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -35,9 +36,12 @@ class SequenceEmpty final : public OpKernel {
 
 class SequenceInsert final : public OpKernel {
  public:
-  SequenceInsert(const OpKernelInfo& info) : OpKernel(info) {
-  }
+  SequenceInsert(const OpKernelInfo& info);
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // whether the tensor to insert is produced by another node of the graph
+  bool is_tensor_produced_in_graph_{false};
 };
 
 class SequenceErase final : public OpKernel {
@@ -49,9 +53,12 @@ class SequenceErase final : public OpKernel {
 
 class SequenceConstruct final : public OpKernel {
  public:
-  SequenceConstruct(const OpKernelInfo& info) : OpKernel(info) {
-  }
+  SequenceConstruct(const OpKernelInfo& info);
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // whether each input is produced by another node of the graph
+  InlinedVector<bool> is_input_produced_in_graph_;
 };
 
 class SplitToSequence final : public OpKernel {
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/signal/dft.h"
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <functional>
@@ -189,6 +190,143 @@ static Status fft_radix2(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, s
   return Status::OK();
 }
 
+// largest radix of the mixed radix FFT. lengths with larger prime factors use the Bluestein algorithm.
+constexpr size_t kMaxMixedRadix = 7;
+
+// Factorization and twiddle factors of a mixed radix FFT. They only depend on the DFT length and direction, so a plan
+// is created once and shared by all the DFTs of a Compute call.
+template <typename T>
+struct MixedRadixFftPlan {
+  size_t dft_length = 0;
+  bool inverse = false;
+  InlinedVector<size_t> radices;
+  // exp(+-2*pi*i*k/dft_length) for k in [0, dft_length)
+  InlinedVector<std::complex<T>> twiddles;
+};
+
+// Creates the plan for lengths that factor into radices up to kMaxMixedRadix. Returns false for other lengths, and for
+// powers of 2 that use fft_radix2.
+template <typename T>
+static bool create_mixed_radix_fft_plan(size_t dft_length, bool inverse, MixedRadixFftPlan<T>& plan) {
+  if (dft_length < 2 || is_power_of_2(dft_length)) {
+    return false;
+  }
+
+  InlinedVector<size_t> radices;
+  size_t remaining = dft_length;
+  for (size_t radix : {size_t{4}, size_t{2}, size_t{3}, size_t{5}, size_t{7}}) {
+    while (remaining % radix == 0) {
+      radices.push_back(radix);
+      remaining /= radix;
+    }
+  }
+
+  if (remaining != 1) {
+    return false;
+  }
+
+  plan.dft_length = dft_length;
+  plan.inverse = inverse;
+  plan.radices = std::move(radices);
+  plan.twiddles.resize(dft_length);
+  const auto angular_velocity = compute_angular_velocity<T>(dft_length, inverse);
+  for (size_t k = 0; k < dft_length; k++) {
+    plan.twiddles[k] = compute_exponential(k, angular_velocity);
+  }
+
+  return true;
+}
+
+// Decimation in time step that computes the transform of the stage'th sub-sequences of 'in', whose elements are
+// 'stride' apart, into consecutive elements of 'out'.
+template <typename T>
+static void fft_mixed_radix_stage(const MixedRadixFftPlan<T>& plan, std::complex<T>* out, const std::complex<T>* in,
+                                  size_t stride, size_t stage) {
+  const size_t radix = plan.radices[stage];
+  // length of the sub transforms of this stage
+  const size_t m = plan.dft_length / (stride * radix);
+  const std::complex<T>* twiddles = plan.twiddles.data();
+
+  if (m == 1) {
+    for (size_t q = 0; q < radix; q++) {
+      out[q] = in[q * stride];
+    }
+  } else {
+    for (size_t q = 0; q < radix; q++) {
+      fft_mixed_radix_stage(plan, out + q * m, in + q * stride, stride * radix, stage + 1);
+    }
+  }
+
+  // combine the sub transforms: out[u + k * m] = sum over q of w^(q * (u + k * m)) * sub_q[u], where w is the root
+  // of unity for a transform of length radix * m, and w^(q * k * m) is a root of unity for a transform of radix.
+  if (radix == 2) {
+    for (size_t u = 0; u < m; u++) {
+      const std::complex<T> a = out[u];
+      const std::complex<T> b = out[u + m] * twiddles[u * stride];
+      out[u] = a + b;
+      out[u + m] = a - b;
+    }
+  } else if (radix == 4) {
+    for (size_t u = 0; u < m; u++) {
+      const std::complex<T> a0 = out[u];
+      const std::complex<T> a1 = out[u + m] * twiddles[u * stride];
+      const std::complex<T> a2 = out[u + 2 * m] * twiddles[2 * u * stride];
+      const std::complex<T> a3 = out[u + 3 * m] * twiddles[3 * u * stride];
+      const std::complex<T> s02 = a0 + a2;
+      const std::complex<T> d02 = a0 - a2;
+      const std::complex<T> s13 = a1 + a3;
+      // (a1 - a3) multiplied by w^m, which is -i for the forward and +i for the inverse transform
+      const std::complex<T> d13 = plan.inverse ? std::complex<T>(-(a1 - a3).imag(), (a1 - a3).real())
+                                               : std::complex<T>((a1 - a3).imag(), -(a1 - a3).real());
+      out[u] = s02 + s13;
+      out[u + m] = d02 + d13;
+      out[u + 2 * m] = s02 - s13;
+      out[u + 3 * m] = d02 - d13;
+    }
+  } else {
+    const size_t root_stride = m * stride;  // dft_length / radix
+    std::complex<T> values[kMaxMixedRadix];
+    for (size_t u = 0; u < m; u++) {
+      for (size_t q = 0; q < radix; q++) {
+        values[q] = out[u + q * m] * twiddles[q * u * stride];
+      }
+
+      for (size_t k = 0; k < radix; k++) {
+        std::complex<T> sum = values[0];
+        for (size_t q = 1; q < radix; q++) {
+          sum += values[q] * twiddles[(q * k % radix) * root_stride];
+        }
+        out[u + k * m] = sum;
+      }
+    }
+  }
+}
+
+// Runs one DFT with a mixed radix plan. 'buffer' is scratch space that is resized to 2 * dft_length.
+template <typename T, typename U>
+static void fft_mixed_radix(const MixedRadixFftPlan<T>& plan, const U* X_data, size_t X_stride,
+                            size_t number_of_samples, const U* window_data, std::complex<T>* Y_data, size_t Y_stride,
+                            size_t output_size, InlinedVector<std::complex<T>>& buffer) {
+  const size_t dft_length = plan.dft_length;
+  buffer.resize(2 * dft_length);
+  std::complex<T>* input = buffer.data();
+  std::complex<T>* output = input + dft_length;
+
+  const size_t samples = std::min(number_of_samples, dft_length);
+  for (size_t i = 0; i < samples; i++) {
+    auto window_element = window_data ? *(window_data + i) : 1;
+    input[i] = std::complex<T>(1, 0) * *(X_data + i * X_stride) * window_element;
+  }
+  std::fill(input + samples, input + dft_length, std::complex<T>(0, 0));
+
+  fft_mixed_radix_stage(plan, output, input, 1, 0);
+
+  const T scale = plan.inverse ? static_cast<T>(1) / static_cast<T>(dft_length) : static_cast<T>(1);
+  for (size_t i = 0; i < output_size; i++) {
+    *(Y_data + i * Y_stride) = output[i] * scale;
+  }
+}
+
 template <typename T>
 T next_power_of_2(T in) {
   in--;
@@ -332,10 +470,12 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
     batch_and_signal_rank -= 1;
   }
 
-  // Calculate x/y offsets/strides
-  for (size_t i = 0; i < total_dfts; i++) {
-    size_t X_offset = 0;
-    size_t X_stride = onnxruntime::narrow<size_t>(X_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / complex_input_factor);
+  const size_t X_stride = onnxruntime::narrow<size_t>(X_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / complex_input_factor);
+  const size_t Y_stride = onnxruntime::narrow<size_t>(Y_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / 2);
+
+  // Calculate x/y offsets of the i'th dft
+  auto get_offsets = [&](size_t i, size_t& X_offset, size_t& Y_offset) {
+    X_offset = 0;
     size_t cumulative_packed_stride = total_dfts;
     size_t temp = i;
     for (size_t r = 0; r < batch_and_signal_rank; r++) {
@@ -348,8 +488,7 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
       X_offset += index * SafeInt<size_t>(X_shape.SizeFromDimension(r + 1)) / complex_input_factor;
     }
 
-    size_t Y_offset = 0;
-    size_t Y_stride = onnxruntime::narrow<size_t>(Y_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / 2);
+    Y_offset = 0;
     cumulative_packed_stride = total_dfts;
     temp = i;
     for (size_t r = 0; r < batch_and_signal_rank; r++) {
@@ -361,6 +500,38 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
       temp -= (index * cumulative_packed_stride);
       Y_offset += index * SafeInt<size_t>(Y_shape.SizeFromDimension(r + 1)) / 2;
     }
+  };
+
+  // the mixed radix dfts share a read only plan, so they can run in parallel
+  MixedRadixFftPlan<T> plan;
+  if (create_mixed_radix_fft_plan(onnxruntime::narrow<size_t>(dft_length), inverse, plan)) {
+    const auto* X_data = reinterpret_cast<const U*>(X->DataRaw());
+    auto* Y_data = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw());
+    const U* window_data = window ? reinterpret_cast<const U*>(window->DataRaw()) : nullptr;
+    const size_t number_of_samples = onnxruntime::narrow<size_t>(X_shape[onnxruntime::narrow<size_t>(axis)]);
+    const size_t output_size = onnxruntime::narrow<size_t>(Y_shape[onnxruntime::narrow<size_t>(axis)]);
+    const double length = static_cast<double>(dft_length);
+    const TensorOpCost cost{length * sizeof(U), static_cast<double>(output_size * sizeof(std::complex<T>)),
+                            length * std::log2(length) * 8};
+
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(total_dfts), cost,
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          InlinedVector<std::complex<T>> buffer;
+          for (std::ptrdiff_t i = first; i < last; i++) {
+            size_t X_offset, Y_offset;
+            get_offsets(static_cast<size_t>(i), X_offset, Y_offset);
+            fft_mixed_radix<T, U>(plan, X_data + X_offset, X_stride, number_of_samples, window_data,
+                                  Y_data + Y_offset, Y_stride, output_size, buffer);
+          }
+        });
+
+    return Status::OK();
+  }
+
+  for (size_t i = 0; i < total_dfts; i++) {
+    size_t X_offset, Y_offset;
+    get_offsets(i, X_offset, Y_offset);
 
     if (is_power_of_2(onnxruntime::narrow<size_t>(dft_length))) {
       ORT_RETURN_IF_ERROR((fft_radix2<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window,
@@ -529,6 +700,33 @@ static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_oneside
   auto dft_input_shape = onnxruntime::TensorShape({1, window_size, signal_components});
   auto dft_output_shape = onnxruntime::TensorShape({1, dft_output_size, output_components});
 
+  // with a mixed radix plan the frames are independent and are transformed in parallel
+  MixedRadixFftPlan<T> plan;
+  if (create_mixed_radix_fft_plan(onnxruntime::narrow<size_t>(window_size), false, plan)) {
+    const U* window_data = window ? reinterpret_cast<const U*>(window->DataRaw()) : nullptr;
+    auto* Y_complex_data = reinterpret_cast<std::complex<T>*>(Y_data);
+    const double length = static_cast<double>(window_size);
+    const TensorOpCost cost{length * sizeof(U), static_cast<double>(dft_output_size * sizeof(std::complex<T>)),
+                            length * std::log2(length) * 8};
+
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(batch_size * n_dfts), cost,
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          InlinedVector<std::complex<T>> buffer;
+          for (std::ptrdiff_t frame = first; frame < last; frame++) {
+            const int64_t batch_idx = frame / n_dfts;
+            const int64_t i = frame % n_dfts;
+            // U is the complex type for complex signals, so a sample is a single element
+            const U* input_frame_begin = signal_data + batch_idx * signal_size + i * frame_step;
+            std::complex<T>* output_frame_begin = Y_complex_data + frame * dft_output_size;
+            fft_mixed_radix<T, U>(plan, input_frame_begin, 1, onnxruntime::narrow<size_t>(window_size), window_data,
+                                  output_frame_begin, 1, onnxruntime::narrow<size_t>(dft_output_size), buffer);
+          }
+        });
+
+    return Status::OK();
+  }
+
   Tensor b_fft, chirp;
   InlinedVector<std::complex<T>> V;
   InlinedVector<std::complex<T>> temp_output;
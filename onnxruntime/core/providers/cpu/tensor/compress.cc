@@ -2,6 +2,13 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/compress.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 using namespace ::onnxruntime::common;
 
@@ -25,6 +32,11 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
     Compress);
 
+namespace {
+// minimum number of elements that a block of the parallel passes processes
+constexpr int64_t kMinCompressBlockSize = 16 * 1024;
+}  // namespace
+
 Status Compress::Compute(OpKernelContext* ctx) const {
   const auto* input_tensor = ctx->Input<Tensor>(0);
   size_t rank = input_tensor->Shape().NumDimensions();
@@ -38,18 +50,39 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[onnxruntime::narrow<size_t>(axis)] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
-  }
+  // The output size depends on the condition, so it is processed in two parallel passes over the same blocks.
+  // The first pass counts the positive conditions of each block, and the prefix sum of the counts gives the
+  // output position where each block writes its selected elements in the second pass.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const int64_t num_blocks =
+      std::min<int64_t>(std::max<int64_t>(valid_condition_length / kMinCompressBlockSize,
+                                          valid_condition_length > 0 ? 1 : 0),
+                        concurrency::ThreadPool::DegreeOfParallelism(tp));
+  auto block_range = [valid_condition_length, num_blocks](std::ptrdiff_t block) {
+    return std::make_pair(block * valid_condition_length / num_blocks,
+                          (block + 1) * valid_condition_length / num_blocks);
+  };
+
+  // block_offsets[b] is the number of positive conditions before block b
+  std::vector<int64_t> block_offsets(onnxruntime::narrow<size_t>(num_blocks + 1), 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(num_blocks),
+      [&](std::ptrdiff_t block) {
+        const auto [begin, end] = block_range(block);
+        int64_t count = 0;
+        for (int64_t i = begin; i < end; ++i) {
+          count += condition_data[i] ? 1 : 0;
+        }
+        block_offsets[block + 1] = count;
+      });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+  const int64_t positive_condition_count = block_offsets.back();
 
+  // Figure out output shape
   std::vector<int64_t> output_dims(input_dimensions.begin(), input_dimensions.end());
   if (has_axis_) {
     output_dims[onnxruntime::narrow<size_t>(axis)] = positive_condition_count;
@@ -68,7 +101,6 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
   if (has_axis_) {
     int64_t axes_left_stride = 1;
@@ -81,42 +113,62 @@ Status Compress::Compute(OpKernelContext* ctx) const {
       axes_right_stride *= input_dimensions[i];
     }
     int64_t axes_included_right_stride = axes_right_stride * input_dimensions[onnxruntime::narrow<size_t>(axis)];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
     ORT_ENFORCE(axes_right_stride >= 0 &&
                 static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
     size_t axes_right_stride_bytes = 0;
     if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
                                          &axes_right_stride_bytes))
       return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
-          continue;
-        }
-        if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
-          }
-          output_index += axes_right_stride;
-        } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
-        }
+
+    // the condition along the axis is short compared to the data, so the selected indices are listed first and
+    // the slices are copied in parallel over all the outer rows.
+    std::vector<int64_t> selected;
+    selected.reserve(onnxruntime::narrow<size_t>(positive_condition_count));
+    for (int64_t j = 0; j < valid_condition_length; ++j) {
+      if (condition_data[j]) {
+        selected.push_back(j);
       }
     }
+
+    const double slice_bytes = static_cast<double>(axes_right_stride_bytes);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(axes_left_stride * positive_condition_count),
+        TensorOpCost{slice_bytes, slice_bytes, static_cast<double>(axes_right_stride)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t slice = first; slice < last; ++slice) {
+            const int64_t i = slice / positive_condition_count;
+            const int64_t j = selected[onnxruntime::narrow<size_t>(slice % positive_condition_count)];
+            const int64_t input_offset = i * axes_included_right_stride + j * axes_right_stride;
+            const int64_t output_offset = slice * axes_right_stride;
+            if (is_string_type) {
+              std::copy_n(reinterpret_cast<const std::string*>(input_data) + input_offset,
+                          onnxruntime::narrow<size_t>(axes_right_stride),
+                          reinterpret_cast<std::string*>(output_data) + output_offset);
+            } else {
+              memcpy(output_data + output_offset * element_bytes, input_data + input_offset * element_bytes,
+                     axes_right_stride_bytes);
+            }
+          }
+        });
   } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
-      }
-      ++output_index;
-    }
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(num_blocks),
+        [&](std::ptrdiff_t block) {
+          const auto [begin, end] = block_range(block);
+          int64_t output_index = block_offsets[block];
+          for (int64_t i = begin; i < end; ++i) {
+            if (!condition_data[i]) {
+              continue;
+            }
+            if (is_string_type) {
+              reinterpret_cast<std::string*>(output_data)[output_index] =
+                  reinterpret_cast<const std::string*>(input_data)[i];
+            } else {
+              memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
+            }
+            ++output_index;
+          }
+        });
   }
 
   return Status::OK();
@@ -3,6 +3,9 @@
 
 // https://github.com/onnx/onnx/blob/main/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
+
+#include <algorithm>
+
 #include "core/common/common.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
@@ -102,30 +105,37 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-  auto lambda = [&](int64_t index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
-
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, narrow<size_t>(block_size));
-    }
-  };
-  concurrency::ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(M) * N, static_cast<double>(block_size),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int index = static_cast<int>(first), end = static_cast<int>(last); index < end; ++index) {
-                                              lambda(index);
-                                            }
-                                          });
+  const size_t copy_bytes = narrow<size_t>(block_size);
+  const int64_t block_elements = block_size / SafeInt<int64_t>(element_bytes);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, SafeInt<ptrdiff_t>(M) * N, static_cast<double>(block_size),
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        // walk the (batch, index) pairs of the range in order instead of dividing for every gathered row.
+        // the gathered rows of consecutive batches are adjacent in the output.
+        int64_t i = first % N;
+        const uint8_t* src_batch = src_base + (first / N) * data_batch_bytes;
+        uint8_t* dst = dst_base + (first / N) * gathered_batch_bytes + i * block_size;
+
+        for (ptrdiff_t index = first; index < last; ++index) {
+          Tin idx = indices_data[i];
+          idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
+          const uint8_t* src = src_batch + idx * block_size;
+
+          if (is_string_type) {
+            std::copy_n(reinterpret_cast<const std::string*>(src), block_elements,
+                        reinterpret_cast<std::string*>(dst));
+          } else {
+            memcpy(dst, src, copy_bytes);
+          }
+
+          dst += block_size;
+          if (++i == N) {
+            i = 0;
+            src_batch += data_batch_bytes;
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/tensor/grid_sample.h"
 
+#include <vector>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/TensorSeq.h"
 #include "core/providers/common.h"
@@ -102,21 +104,31 @@ T GsBicubicInterpolate(T p[4][4], T x, T y) {
   return static_cast<T>(coeffs[0] * v[0] + coeffs[1] * v[1] + coeffs[2] * v[2] + coeffs[3] * v[3]);
 }
 
+// Index of the pixel at image location (r, c) after padding. Returns false if the pixel is zero padding.
 template <typename T>
-T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const {
-  T pixel = {};  // default 0
+bool GridSample<T>::IndexAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, const T border[/* 4 */],
+                                int64_t& index) const {
   if (padding_mode_ == Zeros) {
-    if (c >= 0 && c < W && r >= 0 && r < H) {
-      pixel = image[r * W + c];
+    if (c < 0 || c >= W || r < 0 || r >= H) {
+      return false;
     }
   } else if (padding_mode_ == Border) {
     c = std::clamp<int64_t>(c, 0, W - 1);
     r = std::clamp<int64_t>(r, 0, H - 1);
-    pixel = image[r * W + c];
   } else {  // (padding_mode_ == Reflection)
     c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
     r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
-    pixel = image[r * W + c];
+  }
+  index = r * W + c;
+  return true;
+}
+
+template <typename T>
+T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const {
+  T pixel = {};  // default 0
+  int64_t index = 0;
+  if (IndexAtGrid(r, c, H, W, border, index)) {
+    pixel = image[index];
   }
   return pixel;
 }
@@ -142,6 +154,94 @@ T GridSample<T>::PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w,
   return pixel;
 }
 
+namespace {
+// The image indices and interpolation weights of the 4 pixels around a grid point.
+// The weights of zero padding pixels are 0.
+template <typename T>
+struct GsBilinearPoint {
+  int64_t index[4];
+  T weight[4];
+};
+}  // namespace
+
+// The pixels and weights that a grid point interpolates depend only on the grid, so they are computed once per
+// image and shared by all channels. This moves the padding logic out of the per channel loops, which then only
+// gather and blend 4 pixels per output element. The work is split over the rows of all channels to keep the
+// threads busy when there are few channels, e.g. when warping a flow field or a mask.
+template <typename T>
+void GridSample<T>::ComputeLinear2D(OpKernelContext* context, const Tensor& input, const Tensor& grid, Tensor& Y,
+                                    const T border[/* 4 */]) const {
+  const auto& input_dims = input.Shape();
+  const int64_t N = input_dims[0];
+  const int64_t C = input_dims[1];
+  const int64_t H_in = input_dims[2];
+  const int64_t W_in = input_dims[3];
+  const int64_t H_out = Y.Shape()[2];
+  const int64_t W_out = Y.Shape()[3];
+  const int64_t input_image_size = H_in * W_in;
+  const int64_t output_image_size = H_out * W_out;
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  std::vector<GsBilinearPoint<T>> points(onnxruntime::narrow<size_t>(output_image_size));
+
+  for (int64_t n = 0; n < N; n++) {
+    const T* grid_data = grid.Data<T>() + n * output_image_size * 2;
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(output_image_size),
+        TensorOpCost{static_cast<double>(2 * sizeof(T)), static_cast<double>(sizeof(GsBilinearPoint<T>)), 40.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; i++) {
+            const T* gridpoint = grid_data + i * 2;
+            auto x = GsDenormalize<T>(gridpoint[0], W_in, align_corners_);  // actual location
+            auto y = GsDenormalize<T>(gridpoint[1], H_in, align_corners_);
+
+            int64_t x1 = static_cast<int64_t>(std::floor(x));
+            int64_t y1 = static_cast<int64_t>(std::floor(y));
+            int64_t x2 = x1 + 1;
+            int64_t y2 = y1 + 1;
+
+            T dx2 = static_cast<T>(x2) - x;
+            T dx1 = x - static_cast<T>(x1);
+            T dy2 = static_cast<T>(y2) - y;
+            T dy1 = y - static_cast<T>(y1);
+
+            const int64_t rows[4] = {y1, y1, y2, y2};
+            const int64_t cols[4] = {x1, x2, x1, x2};
+            const T weights[4] = {dy2 * dx2, dy2 * dx1, dy1 * dx2, dy1 * dx1};
+
+            auto& point = points[i];
+            for (int k = 0; k < 4; k++) {
+              point.index[k] = 0;
+              point.weight[k] = IndexAtGrid(rows[k], cols[k], H_in, W_in, border, point.index[k]) ? weights[k] : T{0};
+            }
+          }
+        });
+
+    const T* X_data = input.Data<T>() + n * C * input_image_size;
+    T* Y_data = Y.MutableData<T>() + n * C * output_image_size;
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(C * H_out),
+        TensorOpCost{static_cast<double>(W_out * (sizeof(GsBilinearPoint<T>) + 4 * sizeof(T))),
+                     static_cast<double>(W_out * sizeof(T)), static_cast<double>(W_out * 8)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t row = first; row < last; row++) {
+            const int64_t c = row / H_out;
+            const int64_t oy = row % H_out;
+            const T* X_image = X_data + c * input_image_size;
+            const GsBilinearPoint<T>* point = points.data() + oy * W_out;
+            T* Y_row = Y_data + c * output_image_size + oy * W_out;
+
+            for (int64_t ox = 0; ox < W_out; ox++, point++) {
+              Y_row[ox] = point->weight[0] * X_image[point->index[0]] + point->weight[1] * X_image[point->index[1]] +
+                          point->weight[2] * X_image[point->index[2]] + point->weight[3] * X_image[point->index[3]];
+            }
+          }
+        });
+  }
+}
+
 // When grid sampling, padding is applied before interpolation.
 // For instance, in bilinear mode and zeros padding-mode, pixel p at actual
 // image location (-0.5, -0.5)
@@ -203,6 +303,11 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
     }
     T border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
 
+    if (mode_ == Linear) {
+      ComputeLinear2D(context, *input, *grid, Y, border);
+      return Status::OK();
+    }
+
     concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
     for (int64_t n = 0; n < N; n++) {
       const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
@@ -226,22 +331,6 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
                   y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
                   // x, y are integers in all padding modes
                   *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                } else if (mode_ == Linear) {
-                  int64_t x1 = static_cast<int64_t>(std::floor(x));
-                  int64_t y1 = static_cast<int64_t>(std::floor(y));
-                  int64_t x2 = x1 + 1;
-                  int64_t y2 = y1 + 1;
-
-                  T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                  T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                  T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                  T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                  T dx2 = static_cast<T>(x2) - x;
-                  T dx1 = x - static_cast<T>(x1);
-                  T dy2 = static_cast<T>(y2) - y;
-                  T dy1 = y - static_cast<T>(y1);
-                  *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
                 } else if (mode_ == Cubic) {
                   int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
                   int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
@@ -68,7 +68,10 @@ class GridSample final : public OpKernel {
     Reflection
   };
 
+  bool IndexAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, const T border[/* 4 */], int64_t& index) const;
   T PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const;
+  void ComputeLinear2D(OpKernelContext* context, const Tensor& input, const Tensor& grid, Tensor& Y,
+                       const T border[/* 4 */]) const;
   T PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W, T border[/* 6 */]) const;
 
   GridSampleInterpolationMode mode_{Linear};
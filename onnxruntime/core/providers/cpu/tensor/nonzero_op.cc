@@ -3,10 +3,13 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
+#include <utility>
 #include <vector>
-#include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -51,6 +54,14 @@ NONZERO_TYPED_KERNEL(float)
 #undef NONZERO_9_TYPED_KERNEL
 #undef NONZERO_TYPED_KERNEL
 
+namespace {
+// minimum number of elements that a block of the parallel passes processes
+constexpr int64_t kMinNonZeroBlockSize = 16 * 1024;
+}  // namespace
+
+// The output size depends on the data, so the input is processed in two parallel passes over the same blocks.
+// The first pass counts the non-zero elements of each block, and the prefix sum of the counts gives the column of
+// the output where each block writes its coordinates in the second pass.
 template <typename T>
 Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto X = context->Input<Tensor>(0);
@@ -59,59 +70,93 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
+  const int64_t coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<int64_t>(X_shape.NumDimensions());
+  const int64_t size = X_shape.Size();
   const T* data = X->Data<T>();
 
-  if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
-    }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
-
-    // as we iterate the entries, increment the coordinate for the current entry
-    // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
-        int64_t& cur_coord = coordinate[idx];
-        if (cur_coord != X_shape[idx] - 1) {
-          ++cur_coord;
-          break;
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  const int64_t num_blocks =
+      std::min<int64_t>(std::max<int64_t>(size / kMinNonZeroBlockSize, size > 0 ? 1 : 0),
+                        concurrency::ThreadPool::DegreeOfParallelism(tp));
+  auto block_range = [size, num_blocks](std::ptrdiff_t block) {
+    return std::make_pair(block * size / num_blocks, (block + 1) * size / num_blocks);
+  };
+
+  // block_offsets[b] is the number of non-zero elements before block b
+  std::vector<int64_t> block_offsets(onnxruntime::narrow<size_t>(num_blocks + 1), 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(num_blocks),
+      [&](std::ptrdiff_t block) {
+        const auto [begin, end] = block_range(block);
+        int64_t count = 0;
+        for (int64_t i = begin; i < end; ++i) {
+          count += data[i] != T{} ? 1 : 0;
         }
-        cur_coord = 0;
-      }
-    };
-
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
-
-      increment_coordinate();
-    }
+        block_offsets[block + 1] = count;
+      });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+
+  const int64_t num_non_zero_values = block_offsets.back();
+  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+  int64_t* y_data = Y->MutableData<int64_t>();
+
+  if (num_non_zero_values == 0) {
+    return Status::OK();
   }
 
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
+  if (X_shape.IsScalar()) {
+    y_data[0] = 0;
+    return Status::OK();
+  }
 
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(num_blocks),
+      [&](std::ptrdiff_t block) {
+        const auto [begin, end] = block_range(block);
+        int64_t output_index = block_offsets[block];
+
+        if (coordinate_size == 1) {
+          for (int64_t i = begin; i < end; ++i) {
+            if (data[i] != T{}) {
+              y_data[output_index++] = i;
+            }
+          }
+          return;
+        }
 
-  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
+        // coordinate of the first entry of the block
+        std::vector<int64_t> coordinate(onnxruntime::narrow<size_t>(coordinate_size), 0);
+        for (int64_t idx = coordinate_size - 1, remainder = begin; idx >= 0; --idx) {
+          coordinate[idx] = remainder % X_shape[idx];
+          remainder /= X_shape[idx];
+        }
 
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+        // as we iterate the entries, increment the coordinate for the current entry
+        // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
+        auto increment_coordinate = [&coordinate, coordinate_size, &X_shape]() {
+          for (int64_t idx = coordinate_size - 1; idx >= 0; --idx) {
+            int64_t& cur_coord = coordinate[idx];
+            if (cur_coord != X_shape[idx] - 1) {
+              ++cur_coord;
+              break;
+            }
+            cur_coord = 0;
+          }
+        };
+
+        // the output is transposed, i.e. each row holds one dimension of the coordinates
+        for (int64_t i = begin; i < end; ++i) {
+          if (data[i] != T{}) {
+            for (int64_t idx = 0; idx < coordinate_size; ++idx) {
+              y_data[idx * num_non_zero_values + output_index] = coordinate[idx];
+            }
+            ++output_index;
+          }
+
+          increment_coordinate();
+        }
+      });
 
   return Status::OK();
 }
@@ -57,6 +57,19 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
     Tile);
 
+namespace {
+// Fills the num_repeats - 1 blocks of block_size bytes that follow the first block at data with copies of it,
+// copying exponentially growing runs of the blocks that are already filled.
+void RepeatBlock(uint8_t* data, size_t block_size, size_t num_repeats) {
+  const size_t total_size = block_size * num_repeats;
+  for (size_t filled = block_size; filled < total_size;) {
+    const size_t copy_size = std::min(filled, total_size - filled);
+    memcpy(data + filled, data, copy_size);
+    filled += copy_size;
+  }
+}
+}  // namespace
+
 Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches, size_t element_size) {
   const auto& input_shape = input_tensor.Shape().GetDims();
   const size_t dimension_count = input_shape.size();
@@ -67,7 +80,6 @@ Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tens
   // some helper variables that will be used along the way
   size_t block_size = 0;
   int64_t num_repeats = 0;
-  const uint8_t* copy = nullptr;
   const int64_t innermost_dim = input_shape[dimension_count - 1];
 
   while (input_counters) {
@@ -78,23 +90,17 @@ Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tens
     input += block_size;
 
     // Tile data for the innermost axis
-    copy = output - block_size;
     num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      memcpy(output, copy, block_size);
-      output += block_size;
-    }
+    RepeatBlock(output - block_size, block_size, onnxruntime::narrow<size_t>(num_repeats + 1));
+    output += block_size * onnxruntime::narrow<size_t>(num_repeats);
 
     // Tile data for other axes
     while (input_counters.Increment()) {
       ptrdiff_t pitch = onnxruntime::narrow<size_t>(output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()]);
       block_size = pitch * element_size;
-      copy = output - block_size;
       num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        memcpy(output, copy, block_size);
-        output += block_size;
-      }
+      RepeatBlock(output - block_size, block_size, onnxruntime::narrow<size_t>(num_repeats + 1));
+      output += block_size * onnxruntime::narrow<size_t>(num_repeats);
     }
   }
   return Status::OK();
@@ -230,41 +236,48 @@ Status Tile::Compute(OpKernelContext* ctx) const {
                            num_of_copies_per_batch,
                            num_of_batch_copies) &&
       !input_tensor.IsDataType<std::string>()) {
-    int8_t* output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-    const int8_t* input_data_casted = reinterpret_cast<const int8_t*>(input_tensor.DataRaw());
-    const void* input_data_raw = input_tensor.DataRaw();
+    auto* output_data = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
+    const auto* input_data = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
+    auto* tp = ctx->GetOperatorThreadPool();
 
+    // Each range of copies that the thread pool hands out starts from a copy of the source and doubles from there
     if (!is_batched_memcpy) {
-      size_t copy_bytes = input_tensor.SizeInBytes();
-      // TODO: Add multi-threading logic if num_of_copies_per_batch is large enough
-      for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-        memcpy(static_cast<void*>(output_data_casted), input_data_raw, copy_bytes);
-        output_data_casted += copy_bytes;
-      }
+      const size_t copy_bytes = input_tensor.SizeInBytes();
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(num_of_copies_per_batch),
+          TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(copy_bytes), 0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            uint8_t* dst = output_data + static_cast<size_t>(first) * copy_bytes;
+            memcpy(dst, input_data, copy_bytes);
+            RepeatBlock(dst, copy_bytes, static_cast<size_t>(last - first));
+          });
     } else {
-      size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
-      size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
-
-      // TODO: Multi-thread if needed
-      for (size_t batch = 0; batch < batch_count; ++batch) {
-        for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-          memcpy(static_cast<void*>(output_data_casted), static_cast<const void*>(input_data_casted), copy_bytes);
-          output_data_casted += copy_bytes;
-        }
-        input_data_casted += copy_bytes;
-      }
+      const size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
+      const size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
+      const size_t batch_bytes = copy_bytes * num_of_copies_per_batch;
+
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(batch_count),
+          TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(batch_bytes), 0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (auto batch = static_cast<size_t>(first); batch < static_cast<size_t>(last); ++batch) {
+              uint8_t* dst = output_data + batch * batch_bytes;
+              memcpy(dst, input_data + batch * copy_bytes, copy_bytes);
+              RepeatBlock(dst, copy_bytes, num_of_copies_per_batch);
+            }
+          });
 
       // Now account for batch dim repeat
       if (num_of_batch_copies > 1) {
-        // reset some values
-        output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-        copy_bytes *= num_of_copies_per_batch * batch_count;
-        int8_t* copy_ptr = output_data_casted + copy_bytes;
-
-        for (size_t i = 1; i < num_of_batch_copies; ++i) {
-          memcpy(static_cast<void*>(copy_ptr), static_cast<const void*>(output_data_casted), copy_bytes);
-          copy_ptr += copy_bytes;
-        }
+        const size_t all_batches_bytes = batch_bytes * batch_count;
+        concurrency::ThreadPool::TryParallelFor(
+            tp, static_cast<std::ptrdiff_t>(num_of_batch_copies - 1),
+            TensorOpCost{static_cast<double>(all_batches_bytes), static_cast<double>(all_batches_bytes), 0},
+            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+              uint8_t* dst = output_data + (static_cast<size_t>(first) + 1) * all_batches_bytes;
+              memcpy(dst, output_data, all_batches_bytes);
+              RepeatBlock(dst, all_batches_bytes, static_cast<size_t>(last - first));
+            });
       }
     }
 
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 
+#include <algorithm>
 #include <memory>
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
@@ -259,9 +260,136 @@ static void DoTransposeEltWise(int64_t num_axes, gsl::span<const int64_t> target
   }
 }
 
+// Tile edge of DoTransposeBlocked. A tile of 16x16 elements of up to 8 bytes reads and writes 16 rows of at most
+// 128 bytes, which stays well within L1 on every CPU we target.
+constexpr size_t kTransposeTileSize = 16;
+
+// Transposes a tile of rows x cols elements. Consecutive rows are adjacent in the source and consecutive columns are
+// adjacent in the target.
+template <class T>
+static inline void TransposeTile(const T* source, T* target, size_t rows, size_t cols,
+                                 size_t source_col_stride, size_t target_row_stride) {
+  for (size_t r = 0; r < rows; ++r) {
+    const T* s = source + r;
+    T* t = target + r * target_row_stride;
+    for (size_t c = 0; c < cols; ++c) {
+      t[c] = s[c * source_col_stride];
+    }
+  }
+}
+
+// DoTransposeBlocked: cache blocked variant of DoTransposeEltWise for permutations that move the innermost input
+// axis. The elements are walked as 2D planes made of the output axis the innermost input axis moved to (contiguous
+// reads) and the innermost output axis (contiguous writes), and every plane is transposed in tiles so that the reads
+// and writes of a tile share cache lines instead of touching one cache line per element. The planes of all the
+// other axes are split in strips of kTransposeTileSize rows which are processed in parallel.
+template <class T>
+static bool TypedDoTransposeBlocked(const gsl::span<const size_t>& permutations, gsl::span<const int64_t> target_dims,
+                                    const gsl::span<const size_t>& stride, const uint8_t* source, uint8_t* target,
+                                    concurrency::ThreadPool* tp) {
+  constexpr bool enabled = utils::HasTypeWithSameSize<EnabledDataTypesAllOpsets, T>();
+
+  if (enabled) {
+    const size_t rank = permutations.size();
+    const size_t col_axis = rank - 1;
+    const size_t row_axis = static_cast<size_t>(
+        std::find(permutations.begin(), permutations.end(), rank - 1) - permutations.begin());
+
+    InlinedVector<size_t> target_stride(rank);
+    target_stride[rank - 1] = 1;
+    for (size_t i = rank - 1; i > 0; --i) {
+      target_stride[i - 1] = target_stride[i] * narrow<size_t>(target_dims[i]);
+    }
+
+    const size_t rows = narrow<size_t>(target_dims[row_axis]);
+    const size_t cols = narrow<size_t>(target_dims[col_axis]);
+    const size_t source_col_stride = stride[col_axis];
+    const size_t target_row_stride = target_stride[row_axis];
+
+    // the remaining axes, in output order, select the plane
+    InlinedVector<size_t> outer_dims;
+    InlinedVector<size_t> outer_source_stride;
+    InlinedVector<size_t> outer_target_stride;
+    size_t num_planes = 1;
+    for (size_t i = 0; i < rank; ++i) {
+      if (i == row_axis || i == col_axis || target_dims[i] == 1)
+        continue;
+      outer_dims.push_back(narrow<size_t>(target_dims[i]));
+      outer_source_stride.push_back(stride[i]);
+      outer_target_stride.push_back(target_stride[i]);
+      num_planes *= outer_dims.back();
+    }
+
+    const size_t strips_per_plane = (rows + kTransposeTileSize - 1) / kTransposeTileSize;
+    const auto* typed_source = reinterpret_cast<const T*>(source);
+    auto* typed_target = reinterpret_cast<T*>(target);
+
+    const double strip_elements = static_cast<double>(kTransposeTileSize * cols);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(num_planes * strips_per_plane),
+        TensorOpCost{strip_elements * sizeof(T), strip_elements * sizeof(T), strip_elements},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (auto strip = narrow<size_t>(first), end = narrow<size_t>(last); strip < end; ++strip) {
+            size_t plane = strip / strips_per_plane;
+            const size_t row_begin = (strip % strips_per_plane) * kTransposeTileSize;
+            const size_t num_rows = std::min(kTransposeTileSize, rows - row_begin);
+
+            size_t source_offset = row_begin;
+            size_t target_offset = row_begin * target_row_stride;
+            for (size_t i = outer_dims.size(); i > 0; --i) {
+              const size_t index = plane % outer_dims[i - 1];
+              plane /= outer_dims[i - 1];
+              source_offset += index * outer_source_stride[i - 1];
+              target_offset += index * outer_target_stride[i - 1];
+            }
+
+            for (size_t col_begin = 0; col_begin < cols; col_begin += kTransposeTileSize) {
+              TransposeTile(typed_source + source_offset + col_begin * source_col_stride,
+                            typed_target + target_offset + col_begin,
+                            num_rows, std::min(kTransposeTileSize, cols - col_begin),
+                            source_col_stride, target_row_stride);
+            }
+          }
+        });
+  }
+
+  return enabled;
+}
+
+// Returns false if the blocked transpose does not apply, in which case DoTransposeEltWise should be used.
+static bool DoTransposeBlocked(const gsl::span<const size_t>& permutations, gsl::span<const int64_t> target_dims,
+                               const gsl::span<const size_t>& stride, const uint8_t* source, uint8_t* target,
+                               size_t element_size, concurrency::ThreadPool* tp) {
+  const size_t rank = permutations.size();
+  if (rank < 2 || permutations[rank - 1] == rank - 1) {
+    return false;
+  }
+
+  // tiling only pays off if both the reads and the writes have runs of at least a few elements
+  const size_t row_axis = static_cast<size_t>(
+      std::find(permutations.begin(), permutations.end(), rank - 1) - permutations.begin());
+  if (target_dims[row_axis] < 4 || target_dims[rank - 1] < 4) {
+    return false;
+  }
+
+  switch (element_size) {
+    case sizeof(uint64_t):
+      return TypedDoTransposeBlocked<uint64_t>(permutations, target_dims, stride, source, target, tp);
+    case sizeof(uint32_t):
+      return TypedDoTransposeBlocked<uint32_t>(permutations, target_dims, stride, source, target, tp);
+    case sizeof(uint16_t):
+      return TypedDoTransposeBlocked<uint16_t>(permutations, target_dims, stride, source, target, tp);
+    case sizeof(uint8_t):
+      return TypedDoTransposeBlocked<uint8_t>(permutations, target_dims, stride, source, target, tp);
+    default:
+      return false;
+  }
+}
+
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                 const TensorShape* input_shape_override = nullptr) {
+                                 const TensorShape* input_shape_override = nullptr,
+                                 concurrency::ThreadPool* tp = nullptr) {
   const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
@@ -322,6 +450,11 @@ static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, co
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
     } else if (1 == suffix_blocksize) {
+      if (DoTransposeBlocked(permutations, output.Shape().GetDims(), stride, input_data, output_data, element_size,
+                             tp)) {
+        return status;
+      }
+
       // this may return a failed status if the data size is not supported in this build
       status = DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
                                   input_data, output_data, element_size);
@@ -368,7 +501,7 @@ static Status TransposeImpl(const gsl::span<const size_t>& permutations, const T
   }
 
   // fall back to default implementation
-  return DoUntypedTranspose(permutations, input, output, input_shape_override);
+  return DoUntypedTranspose(permutations, input, output, input_shape_override, tp);
 }
 
 template <typename Int4Type>
@@ -2,10 +2,13 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/unique.h"
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <core/common/safeint.h>
 #include <gsl/gsl>
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -144,16 +147,39 @@ class Subtensor {
   std::vector<T> items_;
 };
 
+namespace {
+// the occurrences of a unique value or subtensor in the input
+struct UniqueEntry {
+  int64_t first_index;     // index of the first occurrence
+  int64_t count;           // number of occurrences
+  int64_t unsorted_index;  // index of the entry in the order of the first occurrences
+};
+
+// minimum number of elements that a block of the parallel passes of the flattened Unique processes
+constexpr int64_t kMinUniqueBlockSize = 16 * 1024;
+
+// converts the unsorted index of each entry to its index in the sorted output
+template <typename Key>
+std::vector<int64_t> UnsortedToSorted(const std::map<const Key, UniqueEntry>& entries) {
+  std::vector<int64_t> unsorted_to_sorted(entries.size());
+  int64_t sorted_idx = 0;
+  for (const auto& entry : entries) {
+    unsorted_to_sorted[onnxruntime::narrow<size_t>(entry.second.unsorted_index)] = sorted_idx++;
+  }
+  return unsorted_to_sorted;
+}
+}  // namespace
+
+// The inverse indices are looked up in the final map in parallel, so that the first pass doesn't need to record them.
 template <typename T>
 static void CreateFlattenedOutput(OpKernelContext& context,
-                                  const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
-                                  const std::vector<std::vector<int64_t>>& indices,  // unsorted
-                                  const std::vector<int64_t>& inverse_index,         // unsorted
+                                  const std::map<const T, UniqueEntry>& entries,  // sorted
+                                  gsl::span<const T> data,
                                   bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
+  int64_t num_unique = static_cast<int64_t>(entries.size());
   Tensor& Y = *context.Output(0, {num_unique});
   Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
+  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(data.size())});
   Tensor* counts = context.Output(3, {num_unique});
 
   auto Y_data = Y.MutableDataAsSpan<T>();
@@ -164,42 +190,41 @@ static void CreateFlattenedOutput(OpKernelContext& context,
   gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
                                                      : gsl::span<int64_t>();
 
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
+  // iterate using 'entries' which is sorted, but contains the index of the unsorted entry
+  auto entries_iter = entries.begin();
+  for (int64_t i = 0, end = num_unique; i < end; ++i, ++entries_iter) {
     // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = sorted ? i : unsorted_idx;
+    const auto& entry = entries_iter->second;
+    auto output_idx = onnxruntime::narrow<size_t>(sorted ? i : entry.unsorted_index);
 
-    Y_data[onnxruntime::narrow<size_t>(output_idx)] = offsets_iter->first;
+    Y_data[output_idx] = entries_iter->first;
 
     if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
+      indices_data[output_idx] = entry.first_index;
     }
 
     if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
+      counts_data[output_idx] = entry.count;
     }
   }
 
   if (inverse_indices) {
+    std::vector<int64_t> unsorted_to_sorted;
     if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
-      }
-
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[onnxruntime::narrow<size_t>(i)] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
-      }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
-      }
+      unsorted_to_sorted = UnsortedToSorted(entries);
     }
+
+    concurrency::ThreadPool::TryParallelFor(
+        context.GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(data.size()),
+        TensorOpCost{static_cast<double>(sizeof(T)), static_cast<double>(sizeof(int64_t)),
+                     static_cast<double>(4 * std::log2(num_unique + 1))},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const int64_t unsorted_idx = entries.find(data[i])->second.unsorted_index;
+            inverse_indices_data[i] = sorted ? unsorted_to_sorted[onnxruntime::narrow<size_t>(unsorted_idx)]
+                                             : unsorted_idx;
+          }
+        });
   }
 }
 
@@ -207,11 +232,10 @@ template <typename T>
 static void CreateOutput(OpKernelContext& context,
                          const TensorShape& subtensor_shape,
                          int64_t axis,
-                         const std::map<const Subtensor<T>, int64_t>& offsets,  // map sorted key to unsorted idx
-                         const std::vector<std::vector<int64_t>>& indices,      // unsorted
-                         const std::vector<int64_t>& inverse_index,             // unsorted
+                         const std::map<const Subtensor<T>, UniqueEntry>& offsets,  // sorted
+                         const std::vector<int64_t>& inverse_index,                 // unsorted
                          bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
+  int64_t num_unique = static_cast<int64_t>(offsets.size());
 
   // rows and columns for the slice along axis, flattened to 2D by merging the dimensions before and after the axis
   int64_t num_cols = subtensor_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis));
@@ -245,7 +269,7 @@ static void CreateOutput(OpKernelContext& context,
 
   for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
     // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
+    auto unsorted_idx = offsets_iter->second.unsorted_index;
     auto output_idx = (sorted ? i : unsorted_idx);
 
     const auto& items = offsets_iter->first.GetItems();
@@ -269,23 +293,18 @@ static void CreateOutput(OpKernelContext& context,
     assert(item == items.cend());
 
     if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
+      indices_data[onnxruntime::narrow<size_t>(output_idx)] = offsets_iter->second.first_index;
     }
 
     if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
+      counts_data[onnxruntime::narrow<size_t>(output_idx)] = offsets_iter->second.count;
     }
   }
 
   if (inverse_indices) {
     if (sorted) {
       // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
-      }
+      const std::vector<int64_t> unsorted_to_sorted = UnsortedToSorted(offsets);
 
       for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
         inverse_indices_data[i] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
@@ -308,30 +327,47 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   auto data = input.DataAsSpan<T>();
 
   if (flatten_) {
-    std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-
-    for (int64_t i = 0, end = input.Shape().Size(); i < end; ++i) {
-      auto entry = offsets.find(data[onnxruntime::narrow<size_t>(i)]);
-      if (entry == offsets.end()) {
-        offsets[data[onnxruntime::narrow<size_t>(i)]] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
+    // The input is split in blocks that are counted in parallel into a map per block, which are then merged in
+    // order, so that the first occurrence of a value is in the earliest block that contains it.
+    const int64_t size = input.Shape().Size();
+    concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
+    const int64_t num_blocks =
+        std::min<int64_t>(std::max<int64_t>(size / kMinUniqueBlockSize, 1),
+                          concurrency::ThreadPool::DegreeOfParallelism(tp));
+
+    std::vector<std::map<const T, UniqueEntry>> block_entries(onnxruntime::narrow<size_t>(num_blocks));
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(num_blocks),
+        [&](std::ptrdiff_t block) {
+          auto& entries = block_entries[block];
+          for (int64_t i = block * size / num_blocks, end = (block + 1) * size / num_blocks; i < end; ++i) {
+            auto entry = entries.try_emplace(data[onnxruntime::narrow<size_t>(i)], UniqueEntry{i, 0, 0}).first;
+            ++entry->second.count;
+          }
+        });
+
+    std::map<const T, UniqueEntry> entries = std::move(block_entries[0]);
+    for (size_t block = 1; block < block_entries.size(); ++block) {
+      // merge moves the values that are not in entries yet, and leaves the others in the block
+      entries.merge(block_entries[block]);
+      for (const auto& block_entry : block_entries[block]) {
+        entries.find(block_entry.first)->second.count += block_entry.second.count;
       }
     }
 
-    CreateFlattenedOutput(context, offsets, indices, inverse_index, sort_);
+    // the unsorted output is in the order of the first occurrences
+    std::vector<UniqueEntry*> first_occurrences;
+    first_occurrences.reserve(entries.size());
+    for (auto& entry : entries) {
+      first_occurrences.push_back(&entry.second);
+    }
+    std::sort(first_occurrences.begin(), first_occurrences.end(),
+              [](const UniqueEntry* lhs, const UniqueEntry* rhs) { return lhs->first_index < rhs->first_index; });
+    for (size_t i = 0; i < first_occurrences.size(); ++i) {
+      first_occurrences[i]->unsorted_index = static_cast<int64_t>(i);
+    }
+
+    CreateFlattenedOutput<T>(context, entries, data, sort_);
   } else {
     const auto& input_shape = input.Shape();
     const int64_t input_dims = static_cast<int64_t>(input_shape.NumDimensions());
@@ -345,33 +381,25 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
 
     TensorShape subtensor_shape(std::move(subtensor_dims));
 
-    std::map<const Subtensor<T>, int64_t> offsets;
-    std::vector<std::vector<int64_t>> indices;
+    std::map<const Subtensor<T>, UniqueEntry> offsets;
     std::vector<int64_t> inverse_index;
 
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
     int64_t num_unique = 0;
     int64_t n_axis = input_shape[onnxruntime::narrow<size_t>(axis)];
+    inverse_index.reserve(onnxruntime::narrow<size_t>(n_axis));
 
     for (int64_t i = 0; i < n_axis; ++i) {
       Subtensor<T> s(data, subtensor_shape, axis, n_axis, i);
 
-      auto entry = offsets.find(s);
-      if (entry == offsets.end()) {
-        offsets[std::move(s)] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
+      auto entry = offsets.try_emplace(std::move(s), UniqueEntry{i, 0, num_unique});
+      if (entry.second) {
         ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
       }
+      ++entry.first->second.count;
+      inverse_index.push_back(entry.first->second.unsorted_index);
     }
 
-    CreateOutput(context, subtensor_shape, axis, offsets, indices, inverse_index, sort_);
+    CreateOutput(context, subtensor_shape, axis, offsets, inverse_index, sort_);
   }
 
   return Status::OK();
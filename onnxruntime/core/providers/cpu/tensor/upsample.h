@@ -101,38 +101,59 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
-  for (int32_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, num_channels,
-        [&](std::ptrdiff_t c) {
-          const T* const Xdata =
-              XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
-          T* const Ydata = YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
-          for (int32_t y = 0; y < output_height; ++y) {
+  // Parallelize over the output rows of all the images rather than just the channels of one image, so that inputs
+  // with few channels (e.g. RGB images) still use the whole thread pool. The source rows and the vertical weights
+  // are looked up once per output row, which leaves a simple loop over the columns.
+  const std::ptrdiff_t num_rows = static_cast<std::ptrdiff_t>(batch_size) * num_channels * output_height;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows,
+      static_cast<double>(output_width) * 8,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const std::ptrdiff_t image = row / output_height;
+          const int32_t y = static_cast<int32_t>(row % output_height);
+          const T* const Xdata = XdataBase + image * (static_cast<std::ptrdiff_t>(input_height) * input_width);
+          T* const Ydata = YdataBase + row * output_width;
+
+          // when use_extrapolation is set and original index of x or y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation &&
+              (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
+            continue;
+          }
+
+          const T* const X1 = Xdata + p.input_width_mul_y1[y];
+          const T* const X2 = Xdata + p.input_width_mul_y2[y];
+          const float dy1 = p.dy1[y];
+          const float dy2 = p.dy2[y];
+
+          if (use_extrapolation) {
             for (int32_t x = 0; x < output_width; ++x) {
-              const int32_t output_offset = output_width * y + x;
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_offset] = static_cast<T>(extrapolation_value);
+              if (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)) {
+                Ydata[x] = static_cast<T>(extrapolation_value);
                 continue;
               }
 
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
-
-              Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                    p.dx1[x] * p.dy2[y] * X21 +
-                                                    p.dx2[x] * p.dy1[y] * X12 +
-                                                    p.dx1[x] * p.dy1[y] * X22);
+              Ydata[x] = static_cast<T>(p.dx2[x] * dy2 * X1[p.in_x1[x]] +
+                                        p.dx1[x] * dy2 * X1[p.in_x2[x]] +
+                                        p.dx2[x] * dy1 * X2[p.in_x1[x]] +
+                                        p.dx1[x] * dy1 * X2[p.in_x2[x]]);
+            }
+          } else {
+            const int32_t* const in_x1 = p.in_x1;
+            const int32_t* const in_x2 = p.in_x2;
+            const float* const dx1 = p.dx1;
+            const float* const dx2 = p.dx2;
+            for (int32_t x = 0; x < output_width; ++x) {
+              Ydata[x] = static_cast<T>(dx2[x] * dy2 * X1[in_x1[x]] +
+                                        dx1[x] * dy2 * X1[in_x2[x]] +
+                                        dx2[x] * dy1 * X2[in_x1[x]] +
+                                        dx1[x] * dy1 * X2[in_x2[x]]);
             }
           }
-        });
-  }
+        }
+      });
 }
 
 template <typename T, bool UseExtrapolation>
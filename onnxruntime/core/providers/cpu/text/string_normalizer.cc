@@ -4,6 +4,8 @@
 #include "string_normalizer.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
 // Used below HAS_DEPRECATED_DECLARATIONS
 #include "onnxruntime_config.h"
 
@@ -505,6 +507,15 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
                   "Input dimensions are either[C > 0] or [1][C > 0] allowed");
   }
 
+  // Every string is processed independently so the work is split across the intra-op thread pool.
+  // The cost is estimated from the average string length.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  size_t total_length = 0;
+  for (const auto& s : input_span) {
+    total_length += s.size();
+  }
+  const double average_length = std::max(1.0, static_cast<double>(total_length) / static_cast<double>(C));
+
   // Special case, no filtering and no case change
   if (case_change_action_ == NONE &&
       ((is_case_sensitive_ && stopwords_.empty()) ||
@@ -512,7 +523,11 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     output_shape.push_back(C);
     auto output_tensor = ctx->Output(0, output_shape);
     auto const output_data = output_tensor->MutableData<std::string>();
-    std::copy(input_span.begin(), input_span.end(), output_data);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, narrow<std::ptrdiff_t>(C), TensorOpCost{average_length, average_length, average_length},
+        [&input_span, output_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+          std::copy(input_span.begin() + first, input_span.begin() + last, output_data + first);
+        });
     return Status::OK();
   }
 
@@ -522,115 +537,120 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   // to widechar, lowercase it and then compare. Case-insensitive comparison is complicated
   // for UTF-8 and requires additional dependency.
 
-  Locale locale(locale_name_);
-  Utf8Converter converter;
+  const Locale locale(locale_name_);
+  const TensorOpCost conversion_cost{average_length, average_length, average_length * 16.0};
 
-  // Compute the largest widestring buffer needed.
-  size_t max_wide_buffer_len = 0;
-  for (const auto& s : input_span) {
-    size_t wchars = 0;
-    // Checks for invalid UTF-8 characters on Windows
-    ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
-    max_wide_buffer_len = std::max(max_wide_buffer_len, wchars);
-  }
+  // Runs fn on blocks of [0, count) in parallel. Every block gets its own converter and
+  // wide char buffer, the first error is returned.
+  Status status;
+  OrtMutex status_mutex;
+  auto parallel_for = [&](std::ptrdiff_t count, const TensorOpCost& cost,
+                          const std::function<Status(std::ptrdiff_t, Utf8Converter&, std::wstring&)>& fn) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, count, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          Utf8Converter converter;
+          std::wstring wchar_buffer;
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            Status block_status = fn(i, converter, wchar_buffer);
+            if (!block_status.IsOK()) {
+              std::lock_guard<OrtMutex> lock(status_mutex);
+              if (status.IsOK()) {
+                status = block_status;
+              }
+              return;
+            }
+          }
+        });
+    return status;
+  };
+
+  auto change_case = [&locale](const std::string& s, CaseAction caseaction,
+                               Utf8Converter& converter, std::wstring& wchar_buffer) {
+    // UTF-8 never needs more wide characters than bytes, this also checks for invalid UTF-8 characters.
+    wchar_buffer.resize(s.size());
+    ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
+    locale.ChangeCase(caseaction, wchar_buffer);
+    return Status::OK();
+  };
 
-  // Reuse reserved space
-  std::wstring wchar_buffer;
-  wchar_buffer.reserve(max_wide_buffer_len);
+  auto change_case_to = [this, &change_case](const std::string& s, std::string& dest,
+                                             Utf8Converter& converter, std::wstring& wchar_buffer) {
+    ORT_RETURN_IF_ERROR(change_case(s, case_change_action_, converter, wchar_buffer));
+    // The destination is allocated once with its final size.
+    dest.resize(converter.ComputeRequiredSizeToUtf8(wchar_buffer));
+    return converter.ConvertToUtf8(wchar_buffer, dest);
+  };
 
   // Output everything and change case as required
   auto output_no_filtering = [&](const TensorShape& output_shape) {
     auto output_tensor = ctx->Output(0, output_shape);
     auto const output_data = output_tensor->MutableData<std::string>();
-    for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-      const std::string& s = input_span[i];
-      wchar_buffer.resize(max_wide_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-      locale.ChangeCase(case_change_action_, wchar_buffer);
-
-      auto& dest = output_data[i];
-      size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-      dest.resize(utf8_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
-    }
-    return Status::OK();
+    return parallel_for(narrow<std::ptrdiff_t>(input_span.size()), conversion_cost,
+                        [&](std::ptrdiff_t i, Utf8Converter& converter, std::wstring& wchar_buffer) {
+                          return change_case_to(input_span[i], output_data[i], converter, wchar_buffer);
+                        });
   };
 
   auto output_filtered = [&](const TensorShape& output_shape, gsl::span<const size_t> filtered_indices) {
     auto output_tensor = ctx->Output(0, output_shape);
-    auto output_data = output_tensor->MutableData<std::string>();
-    for (size_t i : filtered_indices) {
-      const std::string& s = input_span[i];
-      if (case_change_action_ != NONE) {
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(case_change_action_, wchar_buffer);
-
-        auto& dest = *output_data++;
-        size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-        dest.resize(utf8_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
-      } else {
-        *output_data++ = s;
-      }
-    }
-    return Status::OK();
+    auto const output_data = output_tensor->MutableData<std::string>();
+    return parallel_for(narrow<std::ptrdiff_t>(filtered_indices.size()), conversion_cost,
+                        [&](std::ptrdiff_t i, Utf8Converter& converter, std::wstring& wchar_buffer) {
+                          const std::string& s = input_span[filtered_indices[i]];
+                          if (case_change_action_ == NONE) {
+                            output_data[i] = s;
+                            return Status::OK();
+                          }
+                          return change_case_to(s, output_data[i], converter, wchar_buffer);
+                        });
   };
 
-  Status status;
-
-  if (is_case_sensitive_) {
-    if (stopwords_.empty()) {
-      assert(case_change_action_ != NONE);
-      output_shape.push_back(C);
-      status = output_no_filtering(output_shape);
-    } else {
-      // we need to filter
-      InlinedVector<size_t> filtered_strings_indices;
-      filtered_strings_indices.reserve(input_span.size());
-
-      for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-        const std::string& s = input_span[i];
-        if (stopwords_.count(s) == 0) {
-          filtered_strings_indices.push_back(i);
-        }
-      }
-
-      // According to the spec, if all strings are filtered out
-      // the output must have a shape of {1} with a single empty string.
-      const int64_t filtered_count = std::max<int64_t>(1, narrow<int64_t>(filtered_strings_indices.size()));
-      output_shape.push_back(filtered_count);
-      status = output_filtered(output_shape, filtered_strings_indices);
-    }
-  } else {
-    if (wstopwords_.empty()) {
-      assert(case_change_action_ != NONE);
-      output_shape.push_back(C);
-      status = output_no_filtering(output_shape);
+  // Keeps the indices of the strings which are not stop words.
+  auto filter = [&](InlinedVector<size_t>& filtered_strings_indices) {
+    InlinedVector<uint8_t> keep(input_span.size(), 0);
+    if (is_case_sensitive_) {
+      concurrency::ThreadPool::TryParallelFor(
+          tp, narrow<std::ptrdiff_t>(input_span.size()), TensorOpCost{average_length, 1.0, average_length},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              keep[i] = stopwords_.count(input_span[i]) == 0;
+            }
+          });
     } else {
       // Case insensitive filtering is performed by converting the input strings
       // to compare_caseaction_. For that we convert to wchar_t UNICODE.
       // Otherwise, we need to pull ICU library on all platforms.
-      InlinedVector<size_t> filtered_strings_indices;
-      filtered_strings_indices.reserve(input_span.size());
-      for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-        const std::string& s = input_span[i];
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(compare_caseaction_, wchar_buffer);
-        if (wstopwords_.count(wchar_buffer) == 0) {
-          filtered_strings_indices.push_back(i);
-        }
-      }
+      ORT_RETURN_IF_ERROR(parallel_for(narrow<std::ptrdiff_t>(input_span.size()), conversion_cost,
+                                       [&](std::ptrdiff_t i, Utf8Converter& converter, std::wstring& wchar_buffer) {
+                                         ORT_RETURN_IF_ERROR(change_case(input_span[i], compare_caseaction_,
+                                                                         converter, wchar_buffer));
+                                         keep[i] = wstopwords_.count(wchar_buffer) == 0;
+                                         return Status::OK();
+                                       }));
+    }
 
-      // According to the spec, if all strings are filtered out
-      // the output must have a shape of {1} with a single empty string.
-      const int64_t filtered_count = std::max<int64_t>(1, narrow<int64_t>(filtered_strings_indices.size()));
-      output_shape.push_back(filtered_count);
-      status = output_filtered(output_shape, filtered_strings_indices);
+    filtered_strings_indices.reserve(input_span.size());
+    for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
+      if (keep[i]) {
+        filtered_strings_indices.push_back(i);
+      }
     }
+    return Status::OK();
+  };
+
+  if ((is_case_sensitive_ && stopwords_.empty()) || (!is_case_sensitive_ && wstopwords_.empty())) {
+    assert(case_change_action_ != NONE);
+    output_shape.push_back(C);
+    return output_no_filtering(output_shape);
   }
 
-  return status;
+  InlinedVector<size_t> filtered_strings_indices;
+  ORT_RETURN_IF_ERROR(filter(filtered_strings_indices));
+
+  // According to the spec, if all strings are filtered out
+  // the output must have a shape of {1} with a single empty string.
+  const int64_t filtered_count = std::max<int64_t>(1, narrow<int64_t>(filtered_strings_indices.size()));
+  output_shape.push_back(filtered_count);
+  return output_filtered(output_shape, filtered_strings_indices);
 }
 }  // namespace onnxruntime
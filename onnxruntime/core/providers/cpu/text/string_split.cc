@@ -6,6 +6,8 @@
 #include <limits>
 #include <string>
 #include "core/common/common.h"
+#include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(StringSplit, 20,
@@ -67,19 +69,30 @@ Status StringSplit::Compute(OpKernelContext* context) const {
 
   // Set up number of tokens output
   auto num_tokens_data = context->Output(1, input->Shape())->template MutableDataAsSpan<int64_t>();
-  auto num_tokens_iter = num_tokens_data.begin();
-
-  InlinedVector<InlinedVector<std::string_view>> input_slices;
-  input_slices.reserve(input_data.size());
-  size_t last_dim = 0;
 
+  // Strings are split independently, the work is distributed on the intra-op thread pool.
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  size_t total_length = 0;
   for (const auto& s : input_data) {
-    auto& substrs = input_slices.emplace_back();
-    ComputeSubstrings(s, delimiter_, maxsplit_, substrs);
-    auto substr_count = substrs.size();
-    last_dim = std::max(last_dim, substr_count);
-    *num_tokens_iter = static_cast<int64_t>(substr_count);
-    ++num_tokens_iter;
+    total_length += s.size();
+  }
+  const double average_length =
+      input_data.empty() ? 1.0 : std::max(1.0, static_cast<double>(total_length) / input_data.size());
+  const std::ptrdiff_t num_strings = narrow<std::ptrdiff_t>(input_data.size());
+
+  InlinedVector<InlinedVector<std::string_view>> input_slices(input_data.size());
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_strings, TensorOpCost{average_length, 8.0, average_length * 2.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          ComputeSubstrings(input_data[i], delimiter_, maxsplit_, input_slices[i]);
+          num_tokens_data[i] = static_cast<int64_t>(input_slices[i].size());
+        }
+      });
+
+  size_t last_dim = 0;
+  for (const auto& substrs : input_slices) {
+    last_dim = std::max(last_dim, substrs.size());
   }
 
   // Set up splits output
@@ -87,9 +100,14 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   splits_shape.push_back(last_dim);
 
   auto splits_data = context->Output(0, splits_shape)->template MutableDataAsSpan<std::string>();
-  auto slices_iter = input_slices.begin();
-  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++slices_iter) {
-    std::copy(slices_iter->begin(), slices_iter->end(), output_splits_iter);
+  if (last_dim > 0) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_strings, TensorOpCost{average_length, average_length, average_length},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            std::copy(input_slices[i].begin(), input_slices[i].end(), splits_data.begin() + i * last_dim);
+          }
+        });
   }
 
   return Status::OK();
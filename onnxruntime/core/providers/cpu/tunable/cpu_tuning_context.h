@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "core/framework/tunable.h"
+#include "core/framework/tuning_context.h"
+
+namespace onnxruntime {
+
+class CPUExecutionProvider;
+
+namespace cpu {
+
+struct TunableOpInfo {
+  bool enable{false};
+  bool tuning_enable{false};
+  int max_tuning_duration_ms{};
+};
+
+namespace tunable {
+
+class CpuTuningResultsValidator : public TuningResultsValidator {
+ public:
+  CpuTuningResultsValidator();
+
+ protected:
+  std::string GetDeviceModel() const;
+  Status ValidateDeviceModel(const std::string& value) const;
+};
+
+class CpuTuningContext : public ITuningContext {
+ public:
+  explicit CpuTuningContext(CPUExecutionProvider* ep, TunableOpInfo* info);
+
+  void EnableTunableOp() override;
+  void DisableTunableOp() override;
+  bool IsTunableOpEnabled() const override;
+
+  void EnableTuning() override;
+  void DisableTuning() override;
+  bool IsTuningEnabled() const override;
+
+  void SetMaxTuningDurationMs(int max_duration_ms) override;
+  int GetMaxTuningDurationMs() const override;
+
+  TuningResultsManager& GetTuningResultsManager() override;
+  const TuningResultsManager& GetTuningResultsManager() const override;
+
+  const TuningResultsValidator& GetTuningResultsValidator() const override;
+
+ private:
+  TunableOpInfo* info_;  // non-owning handle
+  TuningResultsManager manager_;
+  CpuTuningResultsValidator validator_;
+};
+
+// CPU kernels run synchronously on the calling thread, so there is no native stream and wall clock time is what we
+// want to minimize.
+class CpuTimer : public ITimer<void*> {
+ public:
+  using TimerBase = ITimer<void*>;
+
+  explicit CpuTimer(void* stream) : TimerBase{stream} {}
+
+  void Start() override {
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  void End() override {
+    end_ = std::chrono::steady_clock::now();
+  }
+
+  float Duration() override {
+    return std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(end_ - start_).count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point end_;
+};
+
+using OpParams = OpParams<CpuTuningContext, void*>;
+
+template <typename ParamsT>
+using TunableOp = TunableOp<ParamsT, CpuTimer>;
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
@@ -55,6 +55,105 @@ void CUDAAllocator::Free(void* p) {
   cudaFree(p);         // do not throw error since it's OK for cudaFree to fail during shutdown
 }
 
+CUDAMempoolAllocator::CUDAMempoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t release_threshold)
+    : CUDAAllocator(device_id, name) {
+  cudaMemPoolProps props{};
+  props.allocType = cudaMemAllocationTypePinned;
+  props.handleTypes = cudaMemHandleTypeNone;
+  props.location.type = cudaMemLocationTypeDevice;
+  props.location.id = device_id;
+  CUDA_CALL_THROW(cudaMemPoolCreate(&pool_, &props));
+
+  uint64_t threshold = release_threshold;
+  CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+}
+
+CUDAMempoolAllocator::~CUDAMempoolAllocator() {
+  // the memory still allocated from the pool is released once it is freed
+  cudaMemPoolDestroy(pool_);
+}
+
+void* CUDAMempoolAllocator::Alloc(size_t size) {
+  SetDevice(true);
+  CheckDevice(true);
+  void* p = nullptr;
+  if (size > 0) {
+    // the memory may be used on any stream, so wait for the allocation to be done
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, nullptr));
+    CUDA_CALL_THROW(cudaStreamSynchronize(nullptr));
+  }
+  return p;
+}
+
+void* CUDAMempoolAllocator::AllocOnStream(size_t size, Stream* stream) {
+  if (stream == nullptr || stream->GetHandle() == nullptr || stream->GetDevice() != Info().device) {
+    return Alloc(size);
+  }
+
+  SetDevice(true);
+  CheckDevice(true);
+  void* p = nullptr;
+  if (size > 0) {
+    cudaStream_t cuda_stream = static_cast<cudaStream_t>(stream->GetHandle());
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, cuda_stream));
+    std::lock_guard<OrtMutex> lock(lock_);
+    allocations_[p] = cuda_stream;
+  }
+  return p;
+}
+
+void CUDAMempoolAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  SetDevice(false);
+  CheckDevice(false);
+
+  cudaStream_t cuda_stream = nullptr;
+  bool on_stream = false;
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    auto it = allocations_.find(p);
+    if (it != allocations_.end()) {
+      cuda_stream = it->second;
+      on_stream = true;
+      allocations_.erase(it);
+    }
+  }
+
+  if (!on_stream) {
+    // the work using the memory can be on any stream. cudaFree synchronizes the device as well.
+    cudaDeviceSynchronize();
+  }
+
+  // queued after the work already on the stream that uses the memory.
+  // do not throw error since it's OK for the free to fail during shutdown
+  cudaFreeAsync(p, cuda_stream);
+}
+
+void CUDAMempoolAllocator::ReleaseStreamBuffers(Stream* stream) {
+  if (stream == nullptr || stream->GetHandle() == nullptr) {
+    return;
+  }
+
+  // the stream may be destroyed or reused by another run once the run is done, so the memory still allocated on it,
+  // e.g. the outputs of the run, is handed over to the legacy default stream after the work on the stream is done.
+  cudaStream_t cuda_stream = static_cast<cudaStream_t>(stream->GetHandle());
+  std::lock_guard<OrtMutex> lock(lock_);
+  bool synchronized = false;
+  for (auto& allocation : allocations_) {
+    if (allocation.second == cuda_stream) {
+      if (!synchronized) {
+        // usually a no-op as the streams are synchronized at the end of the run
+        CUDA_CALL_THROW(cudaStreamSynchronize(cuda_stream));
+        synchronized = true;
+      }
+      allocation.second = nullptr;
+    }
+  }
+}
+
 void* CUDAExternalAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
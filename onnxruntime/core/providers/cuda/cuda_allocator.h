@@ -6,6 +6,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
 #include "core/platform/ort_mutex.h"
+#include "core/providers/cuda/cuda_pch.h"
 
 namespace onnxruntime {
 
@@ -19,11 +20,38 @@ class CUDAAllocator : public IAllocator {
   void* Alloc(size_t size) override;
   void Free(void* p) override;
 
- private:
+ protected:
   void CheckDevice(bool throw_when_fail) const;
   void SetDevice(bool throw_when_fail) const;
 };
 
+// Allocates from a CUDA memory pool with cudaMallocFromPoolAsync/cudaFreeAsync instead of keeping the memory in a
+// BFCArena. The pool returns the free memory above release_threshold bytes to the driver whenever a stream using it
+// synchronizes, so the memory a session does not need can be used by other sessions or processes.
+//
+// Allocations made on a stream are ordered on it and freed on it while the run is in progress, which lets the pool
+// reuse the memory on the stream without any host synchronization. Other allocations are ordered on the legacy
+// default stream after the device synchronizes, like with cudaMalloc/cudaFree.
+class CUDAMempoolAllocator : public CUDAAllocator {
+ public:
+  CUDAMempoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t release_threshold);
+  ~CUDAMempoolAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+  bool IsStreamAware() const override { return true; }
+  void* AllocOnStream(size_t size, Stream* stream) override;
+  void ReleaseStreamBuffers(Stream* stream) override;
+
+ private:
+  cudaMemPool_t pool_{nullptr};
+
+  mutable OrtMutex lock_;
+  // the stream each allocation is ordered on. nullptr once the stream was synchronized at the end of the run.
+  InlinedHashMap<void*, cudaStream_t> allocations_;
+};
+
 class CUDAExternalAllocator : public CUDAAllocator {
   typedef void* (*ExternalAlloc)(size_t size);
   typedef void (*ExternalFree)(void* p);
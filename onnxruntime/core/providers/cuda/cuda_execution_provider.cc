@@ -2568,7 +2568,7 @@ static bool CastNeedFallbackToCPU(const onnxruntime::Node& node) {
 }
 
 std::unique_ptr<onnxruntime::IDataTransfer> CUDAExecutionProvider::GetDataTransfer() const {
-  return std::make_unique<onnxruntime::GPUDataTransfer>();
+  return std::make_unique<onnxruntime::GPUDataTransfer>(info_.use_pinned_staging_for_host_copies);
 }
 
 std::vector<std::unique_ptr<ComputeCapability>>
@@ -2691,9 +2691,19 @@ std::vector<AllocatorPtr> CUDAExecutionProvider::CreatePreferredAllocators() {
       // correct to use the GPU device id, unless we wanted to share the pinned memory allocator across devices,
       // at the risk the lifetime isn't managed correctly if one of those devices go away.
       0);
+
+  AllocatorPtr device_allocator;
+  if (info_.use_cuda_mempool && !info_.external_allocator_info.UseExternalAllocator() && !IsGraphCaptureEnabled()) {
+    // the pool reuses the memory itself, so it is not wrapped in an arena
+    device_allocator = std::make_shared<CUDAMempoolAllocator>(info_.device_id, CUDA,
+                                                              info_.cuda_mempool_release_threshold);
+  } else {
+    device_allocator = CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
+                                           info_.external_allocator_info, info_.default_memory_arena_cfg);
+  }
+
   return std::vector<AllocatorPtr>{
-      CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                          info_.external_allocator_info, info_.default_memory_arena_cfg),
+      std::move(device_allocator),
       CreateAllocator(pinned_memory_info),
   };
 }
@@ -36,6 +36,9 @@ constexpr const char* kUseEPLevelUnifiedStream = "use_ep_level_unified_stream";
 constexpr const char* kUseTF32 = "use_tf32";
 constexpr const char* kFuseConvBias = "fuse_conv_bias";
 constexpr const char* kSdpaKernel = "sdpa_kernel";
+constexpr const char* kUsePinnedStagingForHostCopies = "use_pinned_staging_for_host_copies";
+constexpr const char* kUseCudaMempool = "use_cuda_mempool";
+constexpr const char* kCudaMempoolReleaseThreshold = "cuda_mempool_release_threshold";
 
 }  // namespace provider_option_names
 }  // namespace cuda
@@ -121,6 +124,11 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToReference(cuda::provider_option_names::kUseTF32, info.use_tf32)
           .AddAssignmentToReference(cuda::provider_option_names::kSdpaKernel, info.sdpa_kernel)
           .AddAssignmentToReference(cuda::provider_option_names::kFuseConvBias, info.fuse_conv_bias)
+          .AddAssignmentToReference(cuda::provider_option_names::kUsePinnedStagingForHostCopies,
+                                    info.use_pinned_staging_for_host_copies)
+          .AddAssignmentToReference(cuda::provider_option_names::kUseCudaMempool, info.use_cuda_mempool)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudaMempoolReleaseThreshold,
+                                    info.cuda_mempool_release_threshold)
           .AddValueParser(
               cuda::provider_option_names::kTunableOpEnable,
               [&info](const std::string& value_str) -> Status {
@@ -176,6 +184,11 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kUseTF32, MakeStringWithClassicLocale(info.use_tf32)},
       {cuda::provider_option_names::kSdpaKernel, MakeStringWithClassicLocale(info.sdpa_kernel)},
       {cuda::provider_option_names::kFuseConvBias, MakeStringWithClassicLocale(info.fuse_conv_bias)},
+      {cuda::provider_option_names::kUsePinnedStagingForHostCopies,
+       MakeStringWithClassicLocale(info.use_pinned_staging_for_host_copies)},
+      {cuda::provider_option_names::kUseCudaMempool, MakeStringWithClassicLocale(info.use_cuda_mempool)},
+      {cuda::provider_option_names::kCudaMempoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.cuda_mempool_release_threshold)},
   };
 
   return options;
@@ -200,6 +213,11 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const OrtCUDAProvid
       {cuda::provider_option_names::kUseTF32, MakeStringWithClassicLocale(info.use_tf32)},
       {cuda::provider_option_names::kFuseConvBias, MakeStringWithClassicLocale(info.fuse_conv_bias)},
       {cuda::provider_option_names::kSdpaKernel, MakeStringWithClassicLocale(info.sdpa_kernel)},
+      {cuda::provider_option_names::kUsePinnedStagingForHostCopies,
+       MakeStringWithClassicLocale(info.use_pinned_staging_for_host_copies)},
+      {cuda::provider_option_names::kUseCudaMempool, MakeStringWithClassicLocale(info.use_cuda_mempool)},
+      {cuda::provider_option_names::kCudaMempoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.cuda_mempool_release_threshold)},
   };
 
   return options;
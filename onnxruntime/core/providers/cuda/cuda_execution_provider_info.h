@@ -82,6 +82,16 @@ struct CUDAExecutionProviderInfo {
 
   int sdpa_kernel{0};
 
+  // Copies from pageable host memory on a stream go through pooled pinned memory, so that they do not block the
+  // host until the copy is done.
+  bool use_pinned_staging_for_host_copies{false};
+
+  // Allocate device memory from a CUDA memory pool (cudaMallocFromPoolAsync) instead of the BFC arena. The pool keeps
+  // at most cuda_mempool_release_threshold bytes of free memory when a stream synchronizes, and returns the rest to
+  // the driver. Ignored when an external allocator is set or CUDA graph capture is enabled.
+  bool use_cuda_mempool{false};
+  size_t cuda_mempool_release_threshold{0};
+
   static CUDAExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const CUDAExecutionProviderInfo& info);
   static ProviderOptions ToProviderOptions(const OrtCUDAProviderOptionsV2& info);
@@ -115,6 +125,9 @@ struct std::hash<::onnxruntime::CUDAExecutionProviderInfo> {
     onnxruntime::HashCombine(info.gpu_mem_limit, value);
     onnxruntime::HashCombine(info.tunable_op.max_tuning_duration_ms, value);
     onnxruntime::HashCombine(info.sdpa_kernel, value);
+    onnxruntime::HashCombine(info.use_pinned_staging_for_host_copies, value);
+    onnxruntime::HashCombine(info.use_cuda_mempool, value);
+    onnxruntime::HashCombine(info.cuda_mempool_release_threshold, value);
 
     // Memory pointers
     onnxruntime::HashCombine(reinterpret_cast<size_t>(info.user_compute_stream), value);
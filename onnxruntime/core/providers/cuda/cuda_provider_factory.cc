@@ -228,6 +228,9 @@ struct CUDA_Provider : Provider {
     info.use_ep_level_unified_stream = params->use_ep_level_unified_stream != 0;
     info.use_tf32 = params->use_tf32 != 0;
     info.sdpa_kernel = params->sdpa_kernel;
+    info.use_pinned_staging_for_host_copies = params->use_pinned_staging_for_host_copies != 0;
+    info.use_cuda_mempool = params->use_cuda_mempool != 0;
+    info.cuda_mempool_release_threshold = params->cuda_mempool_release_threshold;
 
     return std::make_shared<CUDAProviderFactory>(info);
   }
@@ -264,6 +267,9 @@ struct CUDA_Provider : Provider {
     cuda_options.use_tf32 = internal_options.use_tf32;
     cuda_options.sdpa_kernel = internal_options.sdpa_kernel;
     cuda_options.fuse_conv_bias = internal_options.fuse_conv_bias;
+    cuda_options.use_pinned_staging_for_host_copies = internal_options.use_pinned_staging_for_host_copies;
+    cuda_options.use_cuda_mempool = internal_options.use_cuda_mempool;
+    cuda_options.cuda_mempool_release_threshold = internal_options.cuda_mempool_release_threshold;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
@@ -2,6 +2,9 @@
 // Copyright (c) 2023 NVIDIA Corporation.
 // Licensed under the MIT License.
 
+#include <cstdio>
+#include <fstream>
+#include <memory>
 #include <utility>
 #include <string>
 #include <vector>
@@ -285,6 +288,75 @@ std::vector<int64_t> generateStrides(const std::vector<int64_t>& shape, bool cha
   return strides;
 }
 
+CudnnFePlanCache& CudnnFePlanCache::Get(const std::string& path) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::unique_ptr<CudnnFePlanCache>> caches;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& cache = caches[path];
+  if (cache == nullptr) {
+    cache.reset(new CudnnFePlanCache(path));
+  }
+  return *cache;
+}
+
+CudnnFePlanCache::CudnnFePlanCache(std::string path) : path_(std::move(path)) {
+  if (path_.empty()) {
+    return;
+  }
+
+  // one "<key>\t<plan name>" entry per line
+  std::ifstream file(path_);
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto tab = line.rfind('\t');
+    if (tab == std::string::npos || tab + 1 == line.size()) {
+      continue;
+    }
+    plans_[line.substr(0, tab)] = line.substr(tab + 1);
+  }
+  LOGS_DEFAULT(VERBOSE) << "Loaded " << plans_.size() << " cuDNN frontend plans from " << path_;
+}
+
+std::string CudnnFePlanCache::MakeKey(const cudaDeviceProp& prop, int64_t graph_key) {
+  return MakeString(prop.name, ";sm_", prop.major, prop.minor, ";cudnn_", cudnnGetVersion(), ";", graph_key);
+}
+
+std::string CudnnFePlanCache::Find(const cudaDeviceProp& prop, int64_t graph_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = plans_.find(MakeKey(prop, graph_key));
+  return it == plans_.end() ? std::string{} : it->second;
+}
+
+void CudnnFePlanCache::Insert(const cudaDeviceProp& prop, int64_t graph_key, const std::string& plan_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  plans_[MakeKey(prop, graph_key)] = plan_name;
+  if (!path_.empty()) {
+    Save();
+  }
+}
+
+void CudnnFePlanCache::Save() const {
+  // write a new file and move it over the old one, so a concurrent session never reads a partial file
+  const std::string tmp_path = path_ + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::trunc);
+    for (const auto& entry : plans_) {
+      file << entry.first << '\t' << entry.second << '\n';
+    }
+    if (!file) {
+      LOGS_DEFAULT(WARNING) << "Failed to write the cuDNN frontend plan cache " << tmp_path;
+      return;
+    }
+  }
+
+  // rename does not replace an existing file on Windows
+  if (std::rename(tmp_path.c_str(), path_.c_str()) != 0 &&
+      (std::remove(path_.c_str()) != 0 || std::rename(tmp_path.c_str(), path_.c_str()) != 0)) {
+    LOGS_DEFAULT(WARNING) << "Failed to write the cuDNN frontend plan cache " << path_;
+  }
+}
+
 #if !defined(__CUDACC__)
 CudnnFeTensor::CudnnFeTensor(const onnxruntime::TensorShapeVector& shape,
                              const std::string& name,
@@ -5,8 +5,10 @@
 #pragma once
 
 #include <cfloat>
+#include <mutex>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/shared_inc/cudnn_fe_call.h"
@@ -272,6 +274,33 @@ SetPoolingNdDescriptorHelper(cudnnPoolingDescriptor_t poolingDesc,
 
 std::vector<int64_t> generateStrides(const std::vector<int64_t>& shape, bool channels_last);
 
+// The cuDNN frontend execution plans picked by the exhaustive algo search, optionally persisted in a file so that
+// later sessions do not search again. Entries are keyed by the GPU, the cuDNN version and the key of the graph, so
+// one file can be shared by different GPUs.
+class CudnnFePlanCache final {
+ public:
+  // Returns the process wide cache backed by `path`, loading the file on first use.
+  // An empty path gives a cache that only lives in the process.
+  static CudnnFePlanCache& Get(const std::string& path);
+
+  // Returns the name of the plan picked for the graph, or an empty string if the graph was not searched yet.
+  std::string Find(const cudaDeviceProp& prop, int64_t graph_key) const;
+
+  // Records the plan picked for the graph and rewrites the file.
+  void Insert(const cudaDeviceProp& prop, int64_t graph_key, const std::string& plan_name);
+
+ private:
+  explicit CudnnFePlanCache(std::string path);
+  static std::string MakeKey(const cudaDeviceProp& prop, int64_t graph_key);
+  void Save() const;
+
+  const std::string path_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::string> plans_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudnnFePlanCache);
+};
+
 #if !defined(__CUDACC__)
 class CudnnFeTensor final {
  public:
@@ -4,11 +4,15 @@
 #include "core/providers/shared_library/provider_api.h"
 
 #include "core/providers/cuda/gpu_data_transfer.h"
+#include "core/providers/cuda/cuda_resource.h"
 #include "cuda_common.h"
 
 namespace onnxruntime {
 GPUDataTransfer::GPUDataTransfer() {}
 
+GPUDataTransfer::GPUDataTransfer(bool use_pinned_staging_for_host_copies)
+    : use_pinned_staging_for_host_copies_(use_pinned_staging_for_host_copies) {}
+
 GPUDataTransfer::~GPUDataTransfer() {}
 
 bool GPUDataTransfer::CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const {
@@ -49,6 +53,90 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst) const
   return Status::OK();
 }
 
+OrtAllocator* GPUDataTransfer::GetStagingAllocator(const Tensor& src, const Tensor& dst, Stream& stream) const {
+  const auto& src_device = src.Location().device;
+  if (!use_pinned_staging_for_host_copies_ || src.SizeInBytes() == 0 || src_device.Type() != OrtDevice::CPU ||
+      src_device.MemType() != OrtDevice::MemType::DEFAULT || dst.Location().device.Type() != OrtDevice::GPU) {
+    return nullptr;
+  }
+
+  // frees of the deferred allocator of the stream wait for the work queued on the stream until then
+  return static_cast<OrtAllocator*>(stream.GetResource(ORT_CUDA_RESOURCE_VERSION,
+                                                       CudaResource::deferred_cpu_allocator_t));
+}
+
+common::Status GPUDataTransfer::CopyTensors(const std::vector<SrcDstPair>& src_dst_pairs) const {
+  // the copies from pageable memory to stage, by stream, so each stream stages them in a single pinned buffer
+  InlinedHashMap<Stream*, std::vector<const SrcDstPair*>> staged_copies;
+  bool synchronize_default_stream = false;
+
+  for (const auto& pair : src_dst_pairs) {
+    const Tensor& src = pair.src;
+    Tensor& dst = pair.dst;
+
+    if (pair.src_stream) {
+      if (GetStagingAllocator(src, dst, *pair.src_stream) != nullptr) {
+        staged_copies[pair.src_stream].push_back(&pair);
+      } else {
+        ORT_RETURN_IF_ERROR(CopyTensorAsync(src, dst, *pair.src_stream));
+      }
+      continue;
+    }
+
+    // queue the copies without a stream on the default stream, and synchronize it once after all of them
+    const size_t bytes = src.SizeInBytes();
+    const void* src_data = src.DataRaw();
+    void* dst_data = dst.MutableDataRaw();
+    const bool src_on_gpu = src.Location().device.Type() == OrtDevice::GPU;
+    const bool dst_on_gpu = dst.Location().device.Type() == OrtDevice::GPU;
+    if (src_on_gpu || dst_on_gpu) {
+      if (dst_data != src_data) {
+        const auto kind = src_on_gpu ? (dst_on_gpu ? cudaMemcpyDeviceToDevice : cudaMemcpyDeviceToHost)
+                                     : cudaMemcpyHostToDevice;
+        CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, kind, nullptr));
+        synchronize_default_stream = true;
+      }
+    } else {
+      // copying between cpu memory
+      memcpy(dst_data, src_data, bytes);
+    }
+  }
+
+  for (const auto& [stream, copies] : staged_copies) {
+    // offsets aligned like the allocations of the copies would be
+    constexpr size_t kAlignment = 256;
+    std::vector<size_t> offsets;
+    offsets.reserve(copies.size());
+    size_t total_bytes = 0;
+    for (const auto* pair : copies) {
+      offsets.push_back(total_bytes);
+      total_bytes += (pair->src.get().SizeInBytes() + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    OrtAllocator* staging_allocator = GetStagingAllocator(copies.front()->src, copies.front()->dst, *stream);
+    auto* staging = static_cast<uint8_t*>(staging_allocator->Alloc(staging_allocator, total_bytes));
+    ORT_RETURN_IF(staging == nullptr, "Failed to allocate ", total_bytes,
+                  " bytes of pinned memory to stage a batch of copies");
+
+    Status status = Status::OK();
+    for (size_t i = 0; i < copies.size() && status.IsOK(); ++i) {
+      const Tensor& src = copies[i]->src;
+      Tensor& dst = copies[i]->dst;
+      memcpy(staging + offsets[i], src.DataRaw(), src.SizeInBytes());
+      status = CUDA_CALL(cudaMemcpyAsync(dst.MutableDataRaw(), staging + offsets[i], src.SizeInBytes(),
+                                         cudaMemcpyHostToDevice, static_cast<cudaStream_t>(stream->GetHandle())));
+    }
+    staging_allocator->Free(staging_allocator, staging);
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  if (synchronize_default_stream) {
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(nullptr));
+  }
+
+  return Status::OK();
+}
+
 common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst, Stream& stream) const {
   size_t bytes = src.SizeInBytes();
   const void* src_data = src.DataRaw();
@@ -59,8 +147,22 @@ common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst,
 
   if (dst_device.Type() == OrtDevice::GPU) {
     if (src_device.Type() == OrtDevice::CPU) {
-      // copy from pinned memory to GPU, this is non-blocking
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, static_cast<cudaStream_t>(stream.GetHandle())));
+      OrtAllocator* staging_allocator = GetStagingAllocator(src, dst, stream);
+
+      if (staging_allocator != nullptr) {
+        // a copy from pageable memory blocks until the stream reaches it, stage it in the pinned memory pool of the
+        // stream instead
+        void* staging = staging_allocator->Alloc(staging_allocator, bytes);
+        ORT_RETURN_IF(staging == nullptr, "Failed to allocate ", bytes, " bytes of pinned memory to stage a copy");
+        memcpy(staging, src_data, bytes);
+        const auto copy_status = cudaMemcpyAsync(dst_data, staging, bytes, cudaMemcpyHostToDevice,
+                                                 static_cast<cudaStream_t>(stream.GetHandle()));
+        staging_allocator->Free(staging_allocator, staging);
+        CUDA_RETURN_IF_ERROR(copy_status);
+      } else {
+        // copy from pinned memory to GPU, this is non-blocking
+        CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, static_cast<cudaStream_t>(stream.GetHandle())));
+      }
     } else if (src_device.Type() == OrtDevice::GPU) {
       // copying between GPU, this is non-blocking
       if (dst_data != src_data) {
@@ -11,6 +11,8 @@ namespace onnxruntime {
 class GPUDataTransfer : public IDataTransfer {
  public:
   GPUDataTransfer();
+  // use_pinned_staging_for_host_copies: see CUDAExecutionProviderInfo
+  explicit GPUDataTransfer(bool use_pinned_staging_for_host_copies);
   ~GPUDataTransfer();
 
   bool CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const override;
@@ -19,6 +21,16 @@ class GPUDataTransfer : public IDataTransfer {
   using IDataTransfer::CopyTensor;
   common::Status CopyTensor(const Tensor& src, Tensor& dst) const override;
   common::Status CopyTensorAsync(const Tensor& src, Tensor& dst, Stream& stream) const override;
+
+  // queues the copies without a stream on the default stream and synchronizes it once, and stages the copies from
+  // pageable memory to a stream in one pinned buffer per stream
+  common::Status CopyTensors(const std::vector<SrcDstPair>& src_dst_pairs) const override;
+
+ private:
+  // the pinned memory pool of the stream to stage a copy from pageable memory in, or nullptr to copy directly
+  OrtAllocator* GetStagingAllocator(const Tensor& src, const Tensor& dst, Stream& stream) const;
+
+  bool use_pinned_staging_for_host_copies_{false};
 };
 
 }  // namespace onnxruntime
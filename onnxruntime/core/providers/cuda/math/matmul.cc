@@ -88,8 +88,49 @@ static bool CanUseStridedBatchedGemm(const TensorShape& left_shape, const Tensor
   return true;
 }
 
+#ifdef USE_CUSPARSELT
+template <typename T>
+Status MatMul<T>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                          bool& is_packed, PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+  if (!use_sparse_b_ || input_idx != 1) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(SparseMatMulWeight::Create(tensor, std::move(alloc), DefaultCudaStream(), sparse_b_));
+  // the compressed copy replaces B
+  is_packed = sparse_b_ != nullptr;
+  return Status::OK();
+}
+
+template <typename T>
+Status MatMul<T>::ComputeSparse(OpKernelContext* ctx) const {
+  const Tensor* left_X = ctx->Input<Tensor>(0);
+  const auto& left_shape = left_X->Shape();
+  const int64_t K = sparse_b_->K();
+  ORT_RETURN_IF_NOT(left_shape.NumDimensions() >= 1 && left_shape[left_shape.NumDimensions() - 1] == K,
+                    "MatMul dimension mismatch. A: ", left_shape.ToString(), " K of B: ", K);
+
+  TensorShapeVector output_dims = left_shape.AsShapeVector();
+  output_dims.back() = sparse_b_->N();
+  Tensor* Y = ctx->Output(0, output_dims);
+  const int64_t M = left_shape.SizeToDimension(left_shape.NumDimensions() - 1);
+  if (M == 0) {
+    return Status::OK();
+  }
+
+  return sparse_b_->Compute(this, ctx, left_X->DataRaw(), M, alpha_, Y->MutableDataRaw());
+}
+#endif
+
 template <typename T>
 Status MatMul<T>::ComputeInternal(OpKernelContext* ctx) const {
+#ifdef USE_CUSPARSELT
+  if (sparse_b_) {
+    return ComputeSparse(ctx);
+  }
+#endif
+
   const Tensor* left_X = ctx->Input<Tensor>(0);
   const Tensor* right_X = ctx->Input<Tensor>(1);
 
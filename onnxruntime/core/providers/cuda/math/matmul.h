@@ -5,6 +5,12 @@
 
 #include "core/providers/cuda/cuda_kernel.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#ifdef USE_CUSPARSELT
+#include <type_traits>
+
+#include "core/providers/cuda/math/matmul_sparse.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#endif
 
 namespace onnxruntime {
 namespace cuda {
@@ -19,17 +25,35 @@ class MatMul final : public CudaKernel {
         trans_A_{info.GetAttrOrDefault<int64_t>("transA", 0) != 0},
         trans_B_{info.GetAttrOrDefault<int64_t>("transB", 0) != 0},
         trans_batch_a_{info.GetAttrOrDefault<int64_t>("transBatchA", 0) != 0},
-        trans_batch_b_{info.GetAttrOrDefault<int64_t>("transBatchB", 0) != 0} {}
+        trans_batch_b_{info.GetAttrOrDefault<int64_t>("transBatchB", 0) != 0} {
+#ifdef USE_CUSPARSELT
+    use_sparse_b_ = (std::is_same_v<T, MLFloat16> || std::is_same_v<T, BFloat16>) &&
+                    !trans_A_ && !trans_B_ && !trans_batch_a_ && !trans_batch_b_ &&
+                    info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsCudaSparseMatMul, "0") == "1";
+#endif
+  }
 
   Status ComputeInternal(OpKernelContext* context) const override;
   Status ComputeDefault(OpKernelContext* context, MatMulComputeHelper& helper) const;
 
+#ifdef USE_CUSPARSELT
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 bool& is_packed, PrePackedWeights* prepacked_weights) override;
+#endif
+
  private:
   const float alpha_;
   const bool trans_A_;
   const bool trans_B_;
   const bool trans_batch_a_;
   const bool trans_batch_b_;
+#ifdef USE_CUSPARSELT
+  Status ComputeSparse(OpKernelContext* context) const;
+
+  bool use_sparse_b_ = false;
+  // set by PrePack if B is a 2:4 sparse initializer, in which case B is not an input of Compute
+  std::unique_ptr<SparseMatMulWeight> sparse_b_;
+#endif
 };
 
 template <typename T>
@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef USE_CUSPARSELT
+
+#include "core/providers/cuda/math/matmul_sparse.h"
+
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+namespace {
+
+constexpr uint32_t kAlignmentBytes = 16;
+constexpr size_t kElementSize = 2;
+
+// Owns the per-call cuSPARSELt objects, which depend on M.
+struct SparseMatMulPlan {
+  explicit SparseMatMulPlan(cusparseLtHandle_t* handle) : handle(handle) {}
+
+  ~SparseMatMulPlan() {
+    if (plan_initialized) {
+      cusparseLtMatmulPlanDestroy(&plan);
+    }
+    if (output_desc_initialized) {
+      cusparseLtMatDescriptorDestroy(&output_desc);
+    }
+    if (input_desc_initialized) {
+      cusparseLtMatDescriptorDestroy(&input_desc);
+    }
+  }
+
+  cusparseLtHandle_t* handle;
+  cusparseLtMatDescriptor_t input_desc;
+  cusparseLtMatDescriptor_t output_desc;
+  cusparseLtMatmulDescriptor_t matmul;
+  cusparseLtMatmulAlgSelection_t alg_sel;
+  cusparseLtMatmulPlan_t plan;
+  bool input_desc_initialized = false;
+  bool output_desc_initialized = false;
+  bool plan_initialized = false;
+};
+
+}  // namespace
+
+Status SparseMatMulWeight::Create(const Tensor& weight, AllocatorPtr alloc, cudaStream_t stream,
+                                  std::unique_ptr<SparseMatMulWeight>& sparse_weight) {
+  sparse_weight.reset();
+
+  const auto& shape = weight.Shape();
+  if (shape.NumDimensions() != 2 || shape[0] % kDimAlignment != 0 || shape[1] % kDimAlignment != 0) {
+    return Status::OK();
+  }
+
+  cudaDataType_t data_type;
+  if (weight.IsDataType<MLFloat16>()) {
+    data_type = CUDA_R_16F;
+  } else if (weight.IsDataType<BFloat16>()) {
+    data_type = CUDA_R_16BF;
+  } else {
+    return Status::OK();
+  }
+
+  std::unique_ptr<SparseMatMulWeight> result{new SparseMatMulWeight(shape[0], shape[1], data_type)};
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtInit(&result->handle_));
+  result->handle_initialized_ = true;
+
+  // W(K, N) in row major order is W^T(N, K) in column major order, the sparse operand of Y^T = W^T * A^T.
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtStructuredDescriptorInit(
+      &result->handle_, &result->weight_desc_, result->n_, result->k_, result->n_, kAlignmentBytes, data_type,
+      CUSPARSE_ORDER_COL, CUSPARSELT_SPARSITY_50_PERCENT));
+  result->weight_desc_initialized_ = true;
+
+  auto invalid = IAllocator::MakeUniquePtr<int>(alloc, 1);
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtSpMMAPruneCheck2(&result->handle_, &result->weight_desc_, 1,
+                                                      CUSPARSE_OPERATION_NON_TRANSPOSE, weight.DataRaw(),
+                                                      invalid.get(), stream));
+  int is_invalid = 0;
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(&is_invalid, invalid.get(), sizeof(int), cudaMemcpyDeviceToHost, stream));
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+  if (is_invalid != 0) {
+    return Status::OK();
+  }
+
+  size_t compressed_size = 0;
+  size_t compress_buffer_size = 0;
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtSpMMACompressedSize2(&result->handle_, &result->weight_desc_,
+                                                          &compressed_size, &compress_buffer_size));
+  result->compressed_ = IAllocator::MakeUniquePtr<void>(alloc, compressed_size);
+  auto compress_buffer = IAllocator::MakeUniquePtr<void>(alloc, compress_buffer_size);
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtSpMMACompress2(&result->handle_, &result->weight_desc_, 1,
+                                                    CUSPARSE_OPERATION_NON_TRANSPOSE, weight.DataRaw(),
+                                                    result->compressed_.get(), compress_buffer.get(), stream));
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+
+  sparse_weight = std::move(result);
+  return Status::OK();
+}
+
+SparseMatMulWeight::~SparseMatMulWeight() {
+  if (weight_desc_initialized_) {
+    cusparseLtMatDescriptorDestroy(&weight_desc_);
+  }
+  if (handle_initialized_) {
+    cusparseLtDestroy(&handle_);
+  }
+}
+
+Status SparseMatMulWeight::Compute(const CudaKernel* kernel, OpKernelContext* ctx, const void* a, int64_t m,
+                                   float alpha, void* y) const {
+  cudaStream_t stream = kernel->Stream(ctx);
+
+  // cuSPARSELt needs M to be aligned too. The rows of A and Y are contiguous, so A is zero padded to the aligned M
+  // and the first M rows of the padded Y are copied out.
+  const int64_t padded_m = (m + kDimAlignment - 1) / kDimAlignment * kDimAlignment;
+  IAllocatorUniquePtr<void> padded_a;
+  IAllocatorUniquePtr<void> padded_y;
+  void* output = y;
+  if (padded_m != m) {
+    const size_t a_bytes = SafeInt<size_t>(m) * k_ * kElementSize;
+    padded_a = kernel->GetScratchBuffer<void>(SafeInt<size_t>(padded_m) * k_ * kElementSize, ctx->GetComputeStream());
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(padded_a.get(), a, a_bytes, cudaMemcpyDeviceToDevice, stream));
+    CUDA_RETURN_IF_ERROR(cudaMemsetAsync(static_cast<char*>(padded_a.get()) + a_bytes, 0,
+                                         SafeInt<size_t>(padded_m - m) * k_ * kElementSize, stream));
+    padded_y = kernel->GetScratchBuffer<void>(SafeInt<size_t>(padded_m) * n_ * kElementSize, ctx->GetComputeStream());
+    a = padded_a.get();
+    output = padded_y.get();
+  }
+
+  // Y^T(N, M) = W^T(N, K) * A^T(K, M), all in column major order
+  SparseMatMulPlan plan{&handle_};
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtDenseDescriptorInit(&handle_, &plan.input_desc, k_, padded_m, k_,
+                                                         kAlignmentBytes, data_type_, CUSPARSE_ORDER_COL));
+  plan.input_desc_initialized = true;
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtDenseDescriptorInit(&handle_, &plan.output_desc, n_, padded_m, n_,
+                                                         kAlignmentBytes, data_type_, CUSPARSE_ORDER_COL));
+  plan.output_desc_initialized = true;
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtMatmulDescriptorInit(&handle_, &plan.matmul, CUSPARSE_OPERATION_NON_TRANSPOSE,
+                                                          CUSPARSE_OPERATION_NON_TRANSPOSE, &weight_desc_,
+                                                          &plan.input_desc, &plan.output_desc, &plan.output_desc,
+                                                          CUSPARSE_COMPUTE_32F));
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtMatmulAlgSelectionInit(&handle_, &plan.alg_sel, &plan.matmul,
+                                                            CUSPARSELT_MATMUL_ALG_DEFAULT));
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtMatmulPlanInit(&handle_, &plan.plan, &plan.matmul, &plan.alg_sel));
+  plan.plan_initialized = true;
+
+  size_t workspace_size = 0;
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtMatmulGetWorkspace(&handle_, &plan.plan, &workspace_size));
+  auto workspace = kernel->GetScratchBuffer<void>(workspace_size, ctx->GetComputeStream());
+
+  const float beta = 0.0f;
+  CUSPARSE_RETURN_IF_ERROR(cusparseLtMatmul(&handle_, &plan.plan, &alpha, compressed_.get(), a, &beta, output,
+                                            output, workspace.get(), &stream, 1));
+
+  if (padded_y) {
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(y, padded_y.get(), SafeInt<size_t>(m) * n_ * kElementSize,
+                                         cudaMemcpyDeviceToDevice, stream));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif  // USE_CUSPARSELT
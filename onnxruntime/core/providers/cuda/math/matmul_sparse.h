@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#ifdef USE_CUSPARSELT
+
+#include <cusparseLt.h>
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// A 2D MatMul weight W(K, N) with 2:4 structured sparsity along K, compressed for cuSPARSELt.
+// Only created for fp16 and bf16 weights whose dims are multiples of kDimAlignment.
+class SparseMatMulWeight {
+ public:
+  static constexpr int64_t kDimAlignment = 16;
+
+  // Sets sparse_weight to nullptr if the weight does not have the 2:4 pattern or its shape or type is not supported.
+  static Status Create(const Tensor& weight, AllocatorPtr alloc, cudaStream_t stream,
+                       std::unique_ptr<SparseMatMulWeight>& sparse_weight);
+
+  ~SparseMatMulWeight();
+
+  int64_t K() const { return k_; }
+  int64_t N() const { return n_; }
+
+  // Y(M, N) = alpha * A(M, K) * W(K, N), with A and Y in row major order.
+  Status Compute(const CudaKernel* kernel, OpKernelContext* ctx, const void* a, int64_t m, float alpha,
+                 void* y) const;
+
+ private:
+  SparseMatMulWeight(int64_t k, int64_t n, cudaDataType_t data_type) : k_(k), n_(n), data_type_(data_type) {}
+
+  const int64_t k_;
+  const int64_t n_;
+  const cudaDataType_t data_type_;
+  bool handle_initialized_ = false;
+  bool weight_desc_initialized_ = false;
+  mutable cusparseLtHandle_t handle_;
+  cusparseLtMatDescriptor_t weight_desc_;
+  IAllocatorUniquePtr<void> compressed_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SparseMatMulWeight);
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif  // USE_CUSPARSELT
@@ -4,6 +4,8 @@
 
 #include <utility>
 #include <algorithm>
+#include <limits>
+#include <string>
 #include <vector>
 
 #include "core/common/status.h"
@@ -231,9 +233,33 @@ Status Conv<T, Layout>::CreateCudnnFeExecutionPlan(const onnxruntime::TensorShap
 
   if (!use_tf32) s_.cudnn_fe_graph->deselect_numeric_notes({cudnn_frontend::NumericalNote_t::TENSOR_CORE});
 
+  const CUDAExecutionProvider* cuda_ep =
+      static_cast<const CUDAExecutionProvider*>(this->Info().GetExecutionProvider());
+  // EXHAUSTIVE times all the plans, unless the plan picked for this graph is in the cache
+  const bool exhaustive = cuda_ep->GetCudnnConvAlgo() == 0;
+  s_.cudnn_fe_plan_index = -1;
+  s_.cudnn_fe_search_pending = false;
+
   try {
     CUDNN_FE_CALL_THROW(s_.cudnn_fe_graph->check_support(handle));
-    CUDNN_FE_CALL_THROW(s_.cudnn_fe_graph->build_plans(handle));
+    if (exhaustive) {
+      const std::string plan_name = plan_cache_->Find(GetDeviceProp(), s_.cudnn_fe_graph->key());
+      for (int64_t i = 0; !plan_name.empty() && i < s_.cudnn_fe_graph->get_execution_plan_count(); ++i) {
+        std::string name;
+        if (s_.cudnn_fe_graph->get_plan_name_at_index(i, name).is_good() && name == plan_name &&
+            s_.cudnn_fe_graph->build_plan_at_index(handle, i).is_good()) {
+          s_.cudnn_fe_plan_index = i;
+          break;
+        }
+      }
+
+      if (s_.cudnn_fe_plan_index < 0) {
+        CUDNN_FE_CALL_THROW(s_.cudnn_fe_graph->build_plans(handle, cudnn_frontend::BuildPlanPolicy_t::ALL));
+        s_.cudnn_fe_search_pending = true;
+      }
+    } else {
+      CUDNN_FE_CALL_THROW(s_.cudnn_fe_graph->build_plans(handle));
+    }
   } catch (const std::exception& ex) {
     if (!fuse_bias && !fuse_act && use_tf32) {
       std::string message = MakeString("OP not supported by CUDNN Frontend", ex.what(),
@@ -246,7 +272,73 @@ Status Conv<T, Layout>::CreateCudnnFeExecutionPlan(const onnxruntime::TensorShap
                                       pads, strides, dilations, bias_expected, false, false, w_in_nhwc, true);
   }
 
-  s_.workspace_bytes = s_.cudnn_fe_graph->get_workspace_size();
+  s_.workspace_bytes = s_.cudnn_fe_plan_index >= 0
+                           ? s_.cudnn_fe_graph->get_workspace_size_plan_at_index(s_.cudnn_fe_plan_index)
+                           : s_.cudnn_fe_graph->get_workspace_size();
+  return Status::OK();
+}
+
+template <typename T, bool Layout>
+Status Conv<T, Layout>::SearchCudnnFePlan(OpKernelContext* context, cudnnHandle_t handle) const {
+  constexpr int kTimedRuns = 3;
+  const CUDAExecutionProvider* cuda_ep =
+      static_cast<const CUDAExecutionProvider*>(this->Info().GetExecutionProvider());
+  auto& graph = *s_.cudnn_fe_graph;
+  cudaStream_t stream = Stream(context);
+
+  // the plans write to a scratch output, as Y may also be the input Z
+  auto y_scratch = GetScratchBuffer<void>(s_.Y->SizeInBytes(), context->GetComputeStream());
+  auto variant_pack = s_.variant_pack;
+  variant_pack.insert_or_assign(s_.cudnn_fe_Y, y_scratch.get());
+
+  cudaEvent_t start = nullptr;
+  cudaEvent_t stop = nullptr;
+  auto destroy_events = gsl::finally([&start, &stop]() {
+    if (start != nullptr) cudaEventDestroy(start);
+    if (stop != nullptr) cudaEventDestroy(stop);
+  });
+  CUDA_RETURN_IF_ERROR(cudaEventCreate(&start));
+  CUDA_RETURN_IF_ERROR(cudaEventCreate(&stop));
+
+  int64_t best_index = -1;
+  float best_time = std::numeric_limits<float>::max();
+  for (int64_t i = 0; i < graph.get_execution_plan_count(); ++i) {
+    const int64_t workspace_bytes = graph.get_workspace_size_plan_at_index(i);
+    if (!cuda_ep->GetCudnnConvUseMaxWorkspace() && workspace_bytes > static_cast<int64_t>(AlgoSearchWorkspaceSize)) {
+      continue;
+    }
+
+    auto workspace = GetScratchBuffer<void>(static_cast<size_t>(workspace_bytes), context->GetComputeStream());
+    // plans that failed to build or fail to run are skipped, the first run also warms the plan up
+    if (!graph.execute_plan_at_index(handle, variant_pack, workspace.get(), i).is_good()) {
+      continue;
+    }
+
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(start, stream));
+    for (int run = 0; run < kTimedRuns; ++run) {
+      CUDNN_FE_RETURN_IF_ERROR(graph.execute_plan_at_index(handle, variant_pack, workspace.get(), i));
+    }
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(stop, stream));
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(stop));
+
+    float time = 0.0f;
+    CUDA_RETURN_IF_ERROR(cudaEventElapsedTime(&time, start, stop));
+    if (time < best_time) {
+      best_time = time;
+      best_index = i;
+    }
+  }
+  ORT_RETURN_IF(best_index < 0, "None of the cuDNN frontend plans of ", Node().OpType(), " (", Node().Name(),
+                ") could run.");
+
+  s_.cudnn_fe_plan_index = best_index;
+  s_.cudnn_fe_search_pending = false;
+  s_.workspace_bytes = graph.get_workspace_size_plan_at_index(best_index);
+
+  std::string plan_name;
+  if (graph.get_plan_name_at_index(best_index, plan_name).is_good()) {
+    plan_cache_->Insert(GetDeviceProp(), graph.key(), plan_name);
+  }
   return Status::OK();
 }
 
@@ -478,11 +570,21 @@ Status Conv<T, Layout>::ComputeInternal(OpKernelContext* context) const {
       CUDA_RETURN_IF_ERROR(cudaMemset(s_.y_data, 0, s_.Y->SizeInBytes()));
     }
   }
+  if (s_.cudnn_fe_search_pending) {
+    ORT_RETURN_IF_ERROR(SearchCudnnFePlan(context, cudnn_handle));
+  }
   auto ws = GetWorkSpace(context->GetComputeStream());
 
-  CUDNN_FE_RETURN_IF_ERROR(s_.cudnn_fe_graph->execute(cudnn_handle,
-                                                      s_.variant_pack,
-                                                      ws.get()));
+  if (s_.cudnn_fe_plan_index >= 0) {
+    CUDNN_FE_RETURN_IF_ERROR(s_.cudnn_fe_graph->execute_plan_at_index(cudnn_handle,
+                                                                      s_.variant_pack,
+                                                                      ws.get(),
+                                                                      s_.cudnn_fe_plan_index));
+  } else {
+    CUDNN_FE_RETURN_IF_ERROR(s_.cudnn_fe_graph->execute(cudnn_handle,
+                                                        s_.variant_pack,
+                                                        ws.get()));
+  }
 
   if (!s_.bias_fused && s_.z_data != nullptr) {
     CUDNN_RETURN_IF_ERROR(cudnnAddTensor(cudnn_handle, &alpha, s_.z_tensor, s_.z_data,
@@ -14,6 +14,7 @@
 #endif
 
 #include "core/platform/ort_mutex.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/providers/cuda/cuda_kernel.h"
 #include "core/providers/cuda/cudnn_common.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
@@ -173,6 +174,11 @@ struct CudnnConvState {
 
   std::unordered_map<std::shared_ptr<cudnn_frontend::graph::Tensor_attributes>, void*> variant_pack;
   std::unordered_map<std::shared_ptr<cudnn_frontend::graph::Tensor_attributes>, void*> variant_pack_bias;
+
+  // the plan of cudnn_fe_graph picked by the exhaustive search, -1 to run the best heuristic plan
+  int64_t cudnn_fe_plan_index = -1;
+  // all the plans are built and the search runs on the next execution
+  bool cudnn_fe_search_pending = false;
 #endif
 
   struct PerfResultParams {
@@ -216,6 +222,8 @@ class Conv : public CudaKernel {
     auto pads_size = conv_attrs_.pads.size();
     ORT_ENFORCE(pads_size % 2 == 0);
     is_nhwc_domain_ = info.node().Domain() == kMSInternalNHWCDomain;
+    plan_cache_ = &CudnnFePlanCache::Get(
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsCudnnConvPlanCacheFile, ""));
   }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
@@ -246,6 +254,9 @@ class Conv : public CudaKernel {
                                     const bool fuse_act,
                                     const bool w_in_nhwc,
                                     const bool use_tf32) const;
+
+  // Times all the plans of the graph and keeps the fastest one.
+  Status SearchCudnnFePlan(OpKernelContext* context, cudnnHandle_t handle) const;
 #endif
 
   ConvAttributes conv_attrs_;
@@ -255,6 +266,7 @@ class Conv : public CudaKernel {
   bool is_nhwc_domain_;         // prepack is only needed for the Conv in kMSInternalNHWCDomain
   bool is_fused_node_ = false;  // ensures the node is fused although the session option is not set
   bool W_already_nhwc = false;  // In case NHWC == true and Conv is not in kMSInternalNHWCDomain
+  CudnnFePlanCache* plan_cache_ = nullptr;  // plans picked by the exhaustive algo search
 };
 
 Status SliceOutUnwantedOutputSection(cudaStream_t stream,
@@ -59,5 +59,51 @@ REGISTER_KERNEL_TYPED(MLFloat16)
 REGISTER_KERNEL_TYPED(int32_t)
 REGISTER_KERNEL_TYPED(uint8_t)
 
+#ifdef ENABLE_CUDA_NHWC_OPS
+#define REGISTER_NHWC_KERNEL_TYPED(T)                              \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                         \
+      Resize,                                                      \
+      kMSInternalNHWCDomain,                                       \
+      11, 12,                                                      \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .InputMemoryType(OrtMemTypeCPUInput, 1)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 2)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 3)                  \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()), \
+      Resize<T>);                                                  \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                         \
+      Resize,                                                      \
+      kMSInternalNHWCDomain,                                       \
+      13, 17,                                                      \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .InputMemoryType(OrtMemTypeCPUInput, 1)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 2)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 3)                  \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()), \
+      Resize<T>);                                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                   \
+      Resize,                                                      \
+      kMSInternalNHWCDomain,                                       \
+      18,                                                          \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .InputMemoryType(OrtMemTypeCPUInput, 1)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 2)                  \
+          .InputMemoryType(OrtMemTypeCPUInput, 3)                  \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()), \
+      Resize<T>);
+
+// The layout transformer only converts Resize nodes in 'nearest' mode, see ConvertNodeLayout.
+REGISTER_NHWC_KERNEL_TYPED(float)
+REGISTER_NHWC_KERNEL_TYPED(MLFloat16)
+REGISTER_NHWC_KERNEL_TYPED(int32_t)
+REGISTER_NHWC_KERNEL_TYPED(uint8_t)
+#endif
+
 }  // namespace cuda
 }  // namespace onnxruntime
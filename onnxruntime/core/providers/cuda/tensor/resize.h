@@ -13,6 +13,9 @@ template <typename T>
 class Resize : public Upsample<T> {
  public:
   Resize(const OpKernelInfo& info) : Upsample<T>(info) {
+    // 'nearest' is the only mode whose implementation does not assume the innermost dims are H and W
+    ORT_ENFORCE(info.node().Domain() != kMSInternalNHWCDomain || this->mode_ == UpsampleMode::NN,
+                "The NHWC Resize kernel only supports 'nearest' mode.");
   }
 
   Status ComputeInternal(OpKernelContext* context) const override {
@@ -186,17 +186,13 @@ namespace Dml
         }
         else
         {
+            ComPtr<DmlResourceWrapper> resourceWrapper = allocInfo->DetachResourceWrapper();
             if (!m_closed)
             {
-                // Free the underlying allocation once queued work has completed.
-    #ifdef _GAMING_XBOX
-                m_context->QueueReference(WRAP_GRAPHICS_UNKNOWN(allocInfo->GetResource()).Get());
-    #else
-                m_context->QueueReference(allocInfo->GetResource());
-    #endif
+                // Free the underlying allocation once queued work has completed. The wrapper is kept rather than
+                // the resource alone, since a sub-allocated resource returns its memory to the heap on release.
+                m_context->QueueReference(resourceWrapper.Get());
             }
-
-            allocInfo->DetachResourceWrapper();
         }
 
     #if _DEBUG
@@ -0,0 +1,327 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "precomp.h"
+
+#include <dxgi1_4.h>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "core/framework/murmurhash3.h"
+#include "DmlGraphDescCache.h"
+
+namespace Dml
+{
+    namespace
+    {
+        constexpr char c_entryMagic[8] = {'D', 'M', 'L', 'G', 'D', 'C', '0', '1'};
+
+        // Initializers up to this size are hashed by content, larger ones by name, type and shape only
+        constexpr size_t c_maxHashedInitializerSize = 4096;
+
+        template <typename T>
+        void Write(std::string& buffer, T value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <typename T>
+        bool Read(std::string_view& buffer, T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (buffer.size() < sizeof(value))
+            {
+                return false;
+            }
+
+            memcpy(&value, buffer.data(), sizeof(value));
+            buffer.remove_prefix(sizeof(value));
+            return true;
+        }
+
+        std::string ToHexString(const uint32_t (&hash)[4])
+        {
+            std::ostringstream stream;
+            stream << std::hex << std::setfill('0');
+            for (uint32_t word : hash)
+            {
+                stream << std::setw(8) << word;
+            }
+            return stream.str();
+        }
+
+        void AppendNodeArg(std::string& content, const onnxruntime::NodeArg* arg)
+        {
+            content += arg->Name();
+            content += '\0';
+            if (arg->TypeAsProto())
+            {
+                content += arg->TypeAsProto()->SerializeAsString();
+            }
+        }
+    }
+
+    DmlGraphDescCache::DmlGraphDescCache(std::filesystem::path directory, ID3D12Device* device, bool metacommandsEnabled)
+        : m_directory(std::move(directory))
+    {
+        const LUID luid = device->GetAdapterLuid();
+
+        ComPtr<IDXGIFactory4> dxgiFactory;
+        ORT_THROW_IF_FAILED(CreateDXGIFactory2(0, IID_GRAPHICS_PPV_ARGS(dxgiFactory.GetAddressOf())));
+
+        ComPtr<IDXGIAdapter1> adapter;
+        LARGE_INTEGER driverVersion = {};
+        if (SUCCEEDED(dxgiFactory->EnumAdapterByLuid(luid, IID_GRAPHICS_PPV_ARGS(adapter.GetAddressOf()))))
+        {
+            // Fails for adapters without a user mode driver, which then share the version 0
+            adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion);
+        }
+
+        std::ostringstream deviceKey;
+        deviceKey << std::hex << luid.HighPart << '_' << luid.LowPart << '_' << driverVersion.QuadPart
+                  << '_' << metacommandsEnabled;
+        m_deviceKey = deviceKey.str();
+    }
+
+    std::string DmlGraphDescCache::GetPartitionKey(
+        const onnxruntime::Graph& graph,
+        gsl::span<const onnxruntime::Node* const> subgraphNodes,
+        gsl::span<const onnxruntime::NodeArg* const> subgraphInputs,
+        gsl::span<const onnxruntime::NodeArg* const> subgraphOutputs,
+        gsl::span<const uint8_t> isInputsUploadedByDmlEP) const
+    {
+        std::string content = m_deviceKey;
+        content += '\0';
+
+        for (const onnxruntime::Node* node : subgraphNodes)
+        {
+            ONNX_NAMESPACE::NodeProto nodeProto;
+            node->ToProto(nodeProto);
+            content += nodeProto.SerializeAsString();
+        }
+
+        for (size_t i = 0; i < subgraphInputs.size(); ++i)
+        {
+            AppendNodeArg(content, subgraphInputs[i]);
+            content += static_cast<char>(i < isInputsUploadedByDmlEP.size() && isInputsUploadedByDmlEP[i]);
+
+            const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+            if (graph.GetInitializedTensor(subgraphInputs[i]->Name(), initializer))
+            {
+                if (initializer->ByteSizeLong() <= c_maxHashedInitializerSize)
+                {
+                    content += initializer->SerializeAsString();
+                }
+                else
+                {
+                    Write(content, initializer->data_type());
+                    for (int64_t dim : initializer->dims())
+                    {
+                        Write(content, dim);
+                    }
+                }
+            }
+        }
+
+        for (const onnxruntime::NodeArg* output : subgraphOutputs)
+        {
+            AppendNodeArg(content, output);
+        }
+
+        uint32_t hash[4] = {};
+        onnxruntime::MurmurHash3::x86_128(content.data(), gsl::narrow<int>(content.size()), 0, &hash);
+        return ToHexString(hash);
+    }
+
+    std::filesystem::path DmlGraphDescCache::GetEntryPath(const std::string& key) const
+    {
+        return m_directory / (key + ".dmlgraph");
+    }
+
+    bool DmlGraphDescCache::TryLoad(
+        const std::string& key,
+        gsl::span<const std::string> subGraphInputArgNames,
+        /*out*/ GraphDescBuilder::GraphDesc& graphDesc,
+        /*out*/ std::unordered_map<uint32_t, uint32_t>& serializedGraphInputIndexToSubgraphInputIndex,
+        /*out*/ std::unordered_map<std::string_view, uint32_t>& serializedGraphLargeConstantNameToSubgraphInputIndex,
+        /*out*/ std::vector<std::unique_ptr<std::byte[]>>& smallConstantData) const
+    {
+        std::ifstream file(GetEntryPath(key), std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        const std::string entry((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::string_view remaining = entry;
+        if (remaining.substr(0, sizeof(c_entryMagic)) != std::string_view(c_entryMagic, sizeof(c_entryMagic)))
+        {
+            return false;
+        }
+        remaining.remove_prefix(sizeof(c_entryMagic));
+
+        uint8_t reuseCommandList = 0;
+        uint32_t outputShapeCount = 0;
+        if (!Read(remaining, reuseCommandList) || !Read(remaining, outputShapeCount))
+        {
+            return false;
+        }
+
+        Windows::AI::MachineLearning::Adapter::EdgeShapes outputShapes(outputShapeCount);
+        for (uint32_t i = 0; i < outputShapeCount; ++i)
+        {
+            uint32_t dimCount = 0;
+            if (!Read(remaining, dimCount) || remaining.size() / sizeof(uint32_t) < dimCount)
+            {
+                return false;
+            }
+
+            auto& shape = outputShapes.GetMutableShape(i);
+            shape.resize(dimCount);
+            for (uint32_t& dim : shape)
+            {
+                Read(remaining, dim);
+            }
+        }
+
+        std::unordered_map<uint32_t, uint32_t> inputIndexMap;
+        std::unordered_map<std::string_view, uint32_t> largeConstantMap;
+        uint32_t inputIndexCount = 0;
+        if (!Read(remaining, inputIndexCount))
+        {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < inputIndexCount; ++i)
+        {
+            uint32_t graphInputIndex = 0;
+            uint32_t subgraphInputIndex = 0;
+            if (!Read(remaining, graphInputIndex) || !Read(remaining, subgraphInputIndex) ||
+                subgraphInputIndex >= subGraphInputArgNames.size())
+            {
+                return false;
+            }
+            inputIndexMap[graphInputIndex] = subgraphInputIndex;
+        }
+
+        uint32_t largeConstantCount = 0;
+        if (!Read(remaining, largeConstantCount))
+        {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < largeConstantCount; ++i)
+        {
+            uint32_t subgraphInputIndex = 0;
+            if (!Read(remaining, subgraphInputIndex) || subgraphInputIndex >= subGraphInputArgNames.size())
+            {
+                return false;
+            }
+            largeConstantMap[subGraphInputArgNames[subgraphInputIndex]] = subgraphInputIndex;
+        }
+
+        uint64_t serializedGraphSize = 0;
+        if (!Read(remaining, serializedGraphSize) || remaining.size() != serializedGraphSize)
+        {
+            return false;
+        }
+
+        flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(remaining.data()), remaining.size());
+        if (!dml::ir::VerifyDmlGraphDescBuffer(verifier))
+        {
+            return false;
+        }
+
+        std::vector<std::unique_ptr<std::byte[]>> constantData;
+        DmlSerializedGraphDesc serializedGraphDesc =
+            DeserializeDmlGraph(reinterpret_cast<const uint8_t*>(remaining.data()), constantData);
+
+        graphDesc = {};
+        graphDesc.InputCount = serializedGraphDesc.InputCount;
+        graphDesc.OutputCount = serializedGraphDesc.OutputCount;
+        graphDesc.Nodes = std::move(serializedGraphDesc.Nodes);
+        graphDesc.InputEdges = std::move(serializedGraphDesc.InputEdges);
+        graphDesc.OutputEdges = std::move(serializedGraphDesc.OutputEdges);
+        graphDesc.IntermediateEdges = std::move(serializedGraphDesc.IntermediateEdges);
+        graphDesc.reuseCommandList = reuseCommandList != 0;
+        graphDesc.outputShapes = std::move(outputShapes);
+
+        serializedGraphInputIndexToSubgraphInputIndex = std::move(inputIndexMap);
+        serializedGraphLargeConstantNameToSubgraphInputIndex = std::move(largeConstantMap);
+        for (auto& data : constantData)
+        {
+            smallConstantData.push_back(std::move(data));
+        }
+
+        return true;
+    }
+
+    void DmlGraphDescCache::Store(
+        const std::string& key,
+        const GraphDescBuilder::GraphDesc& graphDesc,
+        const std::unordered_map<uint32_t, uint32_t>& serializedGraphInputIndexToSubgraphInputIndex,
+        const std::unordered_map<std::string_view, uint32_t>& serializedGraphLargeConstantNameToSubgraphInputIndex) const
+    {
+        std::string entry(c_entryMagic, sizeof(c_entryMagic));
+        Write(entry, static_cast<uint8_t>(graphDesc.reuseCommandList));
+
+        Write(entry, gsl::narrow<uint32_t>(graphDesc.outputShapes.EdgeCount()));
+        for (size_t i = 0; i < graphDesc.outputShapes.EdgeCount(); ++i)
+        {
+            const auto& shape = graphDesc.outputShapes.GetShape(i);
+            Write(entry, gsl::narrow<uint32_t>(shape.size()));
+            for (uint32_t dim : shape)
+            {
+                Write(entry, dim);
+            }
+        }
+
+        Write(entry, gsl::narrow<uint32_t>(serializedGraphInputIndexToSubgraphInputIndex.size()));
+        for (const auto& [graphInputIndex, subgraphInputIndex] : serializedGraphInputIndexToSubgraphInputIndex)
+        {
+            Write(entry, graphInputIndex);
+            Write(entry, subgraphInputIndex);
+        }
+
+        // The names of the large constants are the names of the subgraph inputs they come from
+        Write(entry, gsl::narrow<uint32_t>(serializedGraphLargeConstantNameToSubgraphInputIndex.size()));
+        for (const auto& [name, subgraphInputIndex] : serializedGraphLargeConstantNameToSubgraphInputIndex)
+        {
+            Write(entry, subgraphInputIndex);
+        }
+
+        const flatbuffers::DetachedBuffer serializedGraph = SerializeDmlGraph(graphDesc);
+        Write(entry, static_cast<uint64_t>(serializedGraph.size()));
+        entry.append(reinterpret_cast<const char*>(serializedGraph.data()), serializedGraph.size());
+
+        // Write to a temporary file first so that concurrent sessions never read a partial entry
+        std::error_code error;
+        std::filesystem::create_directories(m_directory, error);
+
+        const std::filesystem::path entryPath = GetEntryPath(key);
+        std::filesystem::path temporaryPath = entryPath;
+        temporaryPath += std::to_string(GetCurrentProcessId()) + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                return;
+            }
+            file.write(entry.data(), entry.size());
+            if (!file)
+            {
+                file.close();
+                std::filesystem::remove(temporaryPath, error);
+                return;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, entryPath, error);
+        if (error)
+        {
+            std::filesystem::remove(temporaryPath, error);
+        }
+    }
+}
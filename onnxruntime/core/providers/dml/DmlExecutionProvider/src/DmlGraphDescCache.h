@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <filesystem>
+
+#include "GraphDescBuilder.h"
+
+namespace Dml
+{
+    // Persists the DML graph descriptions built for the fused partitions of a model in a directory, so that later
+    // sessions for the same model on the same adapter and driver don't need to build them again. An entry is keyed by
+    // the adapter LUID, the driver version, the flags that affect the graph and the content of the partition: its
+    // nodes, the types and shapes of its inputs and outputs, and its small initializers. Large initializers only
+    // contribute their name, type and shape, since they are bound to the graph rather than baked into it.
+    //
+    // DirectML has no way to serialize an IDMLCompiledOperator, so the cached descriptions still need to be compiled.
+    class DmlGraphDescCache
+    {
+    public:
+        DmlGraphDescCache(std::filesystem::path directory, ID3D12Device* device, bool metacommandsEnabled);
+
+        std::string GetPartitionKey(
+            const onnxruntime::Graph& graph,
+            gsl::span<const onnxruntime::Node* const> subgraphNodes,
+            gsl::span<const onnxruntime::NodeArg* const> subgraphInputs,
+            gsl::span<const onnxruntime::NodeArg* const> subgraphOutputs,
+            gsl::span<const uint8_t> isInputsUploadedByDmlEP) const;
+
+        // Returns false if there is no valid entry for the key. The string views of
+        // serializedGraphLargeConstantNameToSubgraphInputIndex point into subGraphInputArgNames.
+        bool TryLoad(
+            const std::string& key,
+            gsl::span<const std::string> subGraphInputArgNames,
+            /*out*/ GraphDescBuilder::GraphDesc& graphDesc,
+            /*out*/ std::unordered_map<uint32_t, uint32_t>& serializedGraphInputIndexToSubgraphInputIndex,
+            /*out*/ std::unordered_map<std::string_view, uint32_t>& serializedGraphLargeConstantNameToSubgraphInputIndex,
+            /*out*/ std::vector<std::unique_ptr<std::byte[]>>& smallConstantData) const;
+
+        // Failing to write the cache is not an error, the entry is just missing on the next run.
+        void Store(
+            const std::string& key,
+            const GraphDescBuilder::GraphDesc& graphDesc,
+            const std::unordered_map<uint32_t, uint32_t>& serializedGraphInputIndexToSubgraphInputIndex,
+            const std::unordered_map<std::string_view, uint32_t>& serializedGraphLargeConstantNameToSubgraphInputIndex) const;
+
+    private:
+        std::filesystem::path GetEntryPath(const std::string& key) const;
+
+        std::filesystem::path m_directory;
+        std::string m_deviceKey;
+    };
+}
@@ -11,6 +11,7 @@
 #include "FusedGraphKernel.h"
 #include "MLOperatorAuthorImpl.h"
 #include "DmlGraphFusionHelper.h"
+#include "DmlGraphDescCache.h"
 
 
 namespace Dml
@@ -33,14 +34,26 @@ namespace Dml
     DmlGraphFusionTransformer::DmlGraphFusionTransformer(
         const std::string& name,
         const onnxruntime::IExecutionProvider* provider,
-        const bool graphSerializationEnabled
+        const bool graphSerializationEnabled,
+        const std::filesystem::path& graphCacheDirectory
     )
         :onnxruntime::GraphTransformer(name),
          m_providerImpl(static_cast<const ExecutionProvider*>(provider)->GetImpl()),
          graphSerializationEnabled(graphSerializationEnabled)
     {
+        if (!graphCacheDirectory.empty())
+        {
+            ComPtr<ID3D12Device> d3d12Device;
+            ORT_THROW_IF_FAILED(m_providerImpl->GetD3DDevice(d3d12Device.GetAddressOf()));
+            m_graphDescCache = std::make_unique<DmlGraphDescCache>(
+                graphCacheDirectory,
+                d3d12Device.Get(),
+                m_providerImpl->MetacommandsEnabled());
+        }
     }
 
+    DmlGraphFusionTransformer::~DmlGraphFusionTransformer() = default;
+
     onnxruntime::common::Status DmlGraphFusionTransformer::ApplyImpl(
         onnxruntime::Graph& graph,
         bool& modified,
@@ -244,19 +257,39 @@ namespace Dml
                     std::unordered_map<uint32_t, uint32_t> serializedGraphInputIndexToSubgraphInputIndex;
                     std::unordered_map<std::string_view, uint32_t> serializedGraphLargeConstantNameToSubgraphInputIndex;
                     std::vector<std::unique_ptr<std::byte[]>> smallConstantData;
-                    GraphDescBuilder::GraphDesc graphDesc = GraphDescBuilder::BuildGraphDesc(
-                        isInputsUploadedByDmlEP.data(),
-                        isInputsUploadedByDmlEP.size(),
-                        isInitializerTransferable,
-                        partitionNodePropsMap,
-                        m_providerImpl,
-                        modelPath,
-                        subgraphNodes,
-                        subgraphInputs,
-                        subgraphOutputs,
-                        serializedGraphInputIndexToSubgraphInputIndex,
-                        serializedGraphLargeConstantNameToSubgraphInputIndex,
-                        smallConstantData);
+                    GraphDescBuilder::GraphDesc graphDesc;
+
+                    // Reuse the graph description of a previous session for the same partition if there is one
+                    std::string cacheKey;
+                    bool isCachedGraphDesc = false;
+                    if (m_graphDescCache)
+                    {
+                        cacheKey = m_graphDescCache->GetPartitionKey(graph, subgraphNodes, subgraphInputs, subgraphOutputs, isInputsUploadedByDmlEP);
+                        isCachedGraphDesc = m_graphDescCache->TryLoad(
+                            cacheKey,
+                            subGraphInputArgNames,
+                            graphDesc,
+                            serializedGraphInputIndexToSubgraphInputIndex,
+                            serializedGraphLargeConstantNameToSubgraphInputIndex,
+                            smallConstantData);
+                    }
+
+                    if (!isCachedGraphDesc)
+                    {
+                        graphDesc = GraphDescBuilder::BuildGraphDesc(
+                            isInputsUploadedByDmlEP.data(),
+                            isInputsUploadedByDmlEP.size(),
+                            isInitializerTransferable,
+                            partitionNodePropsMap,
+                            m_providerImpl,
+                            modelPath,
+                            subgraphNodes,
+                            subgraphInputs,
+                            subgraphOutputs,
+                            serializedGraphInputIndexToSubgraphInputIndex,
+                            serializedGraphLargeConstantNameToSubgraphInputIndex,
+                            smallConstantData);
+                    }
 
                     // Compile the operator
                     auto compiledPartition = DmlGraphFusionHelper::TryCreateCompiledOperator(
@@ -279,6 +312,16 @@ namespace Dml
                     }
                     else
                     {
+                        // Only descriptions that compiled are worth keeping
+                        if (m_graphDescCache && !isCachedGraphDesc)
+                        {
+                            m_graphDescCache->Store(
+                                cacheKey,
+                                graphDesc,
+                                serializedGraphInputIndexToSubgraphInputIndex,
+                                serializedGraphLargeConstantNameToSubgraphInputIndex);
+                        }
+
                         auto compiledPartitionInfo = std::make_shared<CompiledPartitionInfo>();
                         compiledPartitionInfo->compiledOperator = std::move(compiledPartition);
                         compiledPartitionInfo->indexedSubGraph = std::move(indexedSubGraph);
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 #pragma once
 
+#include <filesystem>
 #include <string>
 #include <unordered_map>
 #include "core/optimizer/graph_transformer.h"
@@ -10,6 +11,7 @@
 namespace Dml
 {
 class ExecutionProviderImpl;
+class DmlGraphDescCache;
 
 class DmlGraphFusionTransformer : public onnxruntime::GraphTransformer
 {
@@ -17,9 +19,12 @@ public:
     DmlGraphFusionTransformer(
         const std::string& name,
         const onnxruntime::IExecutionProvider* provider,
-        const bool graphSerializationEnabled
+        const bool graphSerializationEnabled,
+        const std::filesystem::path& graphCacheDirectory = {}
     );
 
+    ~DmlGraphFusionTransformer();
+
 public:
     static inline const char* const DML_GRAPH_FUSION_NODE_NAME_PREFIX = "DmlFusedNode_";
     static inline const char* const DML_GRAPH_FUSION_NODE_DOMAIN = "DmlFusedNodeDomain";
@@ -40,5 +45,6 @@ private:
 private:
     const ExecutionProviderImpl* m_providerImpl = nullptr;
     const bool graphSerializationEnabled = false;
+    std::unique_ptr<DmlGraphDescCache> m_graphDescCache;
 };
 }
@@ -0,0 +1,200 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "precomp.h"
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <tuple>
+
+#include "DmlHeapSubAllocator.h"
+#include "DmlResourceWrapper.h"
+
+namespace Dml
+{
+    struct DmlHeapSubAllocator::HeapState
+    {
+        struct Heap
+        {
+            ComPtr<ID3D12Heap> heap;
+            uint64_t size;
+            // offset -> size of the free ranges
+            std::map<uint64_t, uint64_t> freeRanges;
+        };
+
+        // (size, heap id, offset) of the free ranges of all the heaps, ordered for the best fit lookup
+        using FreeRange = std::tuple<uint64_t, uint64_t, uint64_t>;
+
+        ComPtr<ID3D12Device> device;
+        uint64_t minHeapSize;
+
+        std::mutex mutex;
+        std::map<uint64_t, Heap> heaps;
+        std::set<FreeRange> freeRangesBySize;
+        uint64_t nextHeapId = 0;
+
+        // Takes `size` bytes from the smallest free range that fits. Returns false if no range fits.
+        bool TryReserve(uint64_t size, uint64_t& heapId, uint64_t& offset)
+        {
+            auto it = freeRangesBySize.lower_bound(FreeRange{size, 0, 0});
+            if (it == freeRangesBySize.end())
+            {
+                return false;
+            }
+
+            const auto [rangeSize, rangeHeapId, rangeOffset] = *it;
+            freeRangesBySize.erase(it);
+            auto& heap = heaps.at(rangeHeapId);
+            heap.freeRanges.erase(rangeOffset);
+
+            if (rangeSize > size)
+            {
+                heap.freeRanges.emplace(rangeOffset + size, rangeSize - size);
+                freeRangesBySize.emplace(rangeSize - size, rangeHeapId, rangeOffset + size);
+            }
+
+            heapId = rangeHeapId;
+            offset = rangeOffset;
+            return true;
+        }
+
+        void Release(uint64_t heapId, uint64_t offset, uint64_t size)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto& heap = heaps.at(heapId);
+            auto& ranges = heap.freeRanges;
+
+            // Merge with the free ranges that directly follow and precede the released one
+            auto next = ranges.lower_bound(offset);
+            if (next != ranges.end() && offset + size == next->first)
+            {
+                freeRangesBySize.erase(FreeRange{next->second, heapId, next->first});
+                size += next->second;
+                next = ranges.erase(next);
+            }
+
+            if (next != ranges.begin())
+            {
+                auto previous = std::prev(next);
+                if (previous->first + previous->second == offset)
+                {
+                    freeRangesBySize.erase(FreeRange{previous->second, heapId, previous->first});
+                    offset = previous->first;
+                    size += previous->second;
+                    ranges.erase(previous);
+                }
+            }
+
+            if (size == heap.size && heaps.size() > 1)
+            {
+                // Give the memory of an unused heap back to the device
+                heaps.erase(heapId);
+                return;
+            }
+
+            ranges.emplace(offset, size);
+            freeRangesBySize.emplace(size, heapId, offset);
+        }
+    };
+
+    namespace
+    {
+        class DmlPlacedResourceWrapper : public Microsoft::WRL::RuntimeClass<Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::ClassicCom>, DmlResourceWrapper>
+        {
+        public:
+            DmlPlacedResourceWrapper(
+                ComPtr<ID3D12Resource>&& d3d12Resource,
+                std::shared_ptr<DmlHeapSubAllocator::HeapState> state,
+                uint64_t heapId,
+                uint64_t offset,
+                uint64_t size)
+                : m_d3d12Resource(std::move(d3d12Resource)),
+                  m_state(std::move(state)),
+                  m_heapId(heapId),
+                  m_offset(offset),
+                  m_size(size)
+            {
+            }
+
+            ~DmlPlacedResourceWrapper()
+            {
+                // The resource must be gone before its memory can be placed under another one
+                m_d3d12Resource.Reset();
+                m_state->Release(m_heapId, m_offset, m_size);
+            }
+
+            ID3D12Resource* GetD3D12Resource() const final { return m_d3d12Resource.Get(); }
+
+        private:
+            ComPtr<ID3D12Resource> m_d3d12Resource;
+            std::shared_ptr<DmlHeapSubAllocator::HeapState> m_state;
+            uint64_t m_heapId;
+            uint64_t m_offset;
+            uint64_t m_size;
+        };
+    }
+
+    DmlHeapSubAllocator::DmlHeapSubAllocator(ID3D12Device* device, uint64_t minHeapSize)
+        : m_state(std::make_shared<HeapState>())
+    {
+        m_state->device = device;
+        m_state->minHeapSize = minHeapSize;
+    }
+
+    ComPtr<DmlResourceWrapper> DmlHeapSubAllocator::Alloc(size_t size)
+    {
+        constexpr uint64_t alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        const uint64_t alignedSize = (static_cast<uint64_t>(size) + alignment - 1) / alignment * alignment;
+
+        uint64_t heapId = 0;
+        uint64_t offset = 0;
+        ComPtr<ID3D12Heap> heap;
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            if (!m_state->TryReserve(alignedSize, heapId, offset))
+            {
+                // No free range fits, so add a heap that is at least large enough for this buffer
+                D3D12_HEAP_DESC heapDesc = {};
+                heapDesc.SizeInBytes = std::max(m_state->minHeapSize, alignedSize);
+                heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+                heapDesc.Alignment = alignment;
+                heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+
+                HeapState::Heap newHeap;
+                newHeap.size = heapDesc.SizeInBytes;
+                ORT_THROW_IF_FAILED(m_state->device->CreateHeap(&heapDesc, IID_GRAPHICS_PPV_ARGS(newHeap.heap.GetAddressOf())));
+
+                const uint64_t newHeapId = m_state->nextHeapId++;
+                newHeap.freeRanges.emplace(0, newHeap.size);
+                m_state->freeRangesBySize.emplace(newHeap.size, newHeapId, 0);
+                m_state->heaps.emplace(newHeapId, std::move(newHeap));
+
+                const bool reserved = m_state->TryReserve(alignedSize, heapId, offset);
+                assert(reserved);
+                (void)reserved;
+            }
+
+            heap = m_state->heaps.at(heapId).heap;
+        }
+
+        ComPtr<ID3D12Resource> resource;
+        auto buffer = CD3DX12_RESOURCE_DESC::Buffer(size, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+        HRESULT hr = m_state->device->CreatePlacedResource(
+            heap.Get(),
+            offset,
+            &buffer,
+            D3D12_RESOURCE_STATE_COMMON,
+            nullptr,
+            IID_GRAPHICS_PPV_ARGS(resource.GetAddressOf()));
+        if (FAILED(hr))
+        {
+            m_state->Release(heapId, offset, alignedSize);
+            ORT_THROW_HR(hr);
+        }
+
+        ComPtr<DmlResourceWrapper> resourceWrapper;
+        wil::MakeOrThrow<DmlPlacedResourceWrapper>(std::move(resource), m_state, heapId, offset, alignedSize).As(&resourceWrapper);
+        return resourceWrapper;
+    }
+}
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "DmlSubAllocator.h"
+
+namespace Dml
+{
+    struct DmlResourceWrapper;
+
+    // Allocates buffers as placed resources in large D3D12 heaps instead of as committed resources. Each buffer takes
+    // the best fitting free range of the heaps, rounded to the 64KB placement alignment, and its range is returned to
+    // the heap and merged with the neighboring free ranges once the buffer is released. New heaps are created when no
+    // free range fits, and heaps that become entirely free are released, except for the last one.
+    class DmlHeapSubAllocator : public DmlSubAllocator
+    {
+    public:
+        static constexpr uint64_t c_defaultMinHeapSize = 64 * 1024 * 1024;
+
+        // Shared with the allocated resources, which return their range on release, so it outlives the allocator
+        // until the last resource is released.
+        struct HeapState;
+
+        explicit DmlHeapSubAllocator(ID3D12Device* device, uint64_t minHeapSize = c_defaultMinHeapSize);
+        Microsoft::WRL::ComPtr<DmlResourceWrapper> Alloc(size_t size) final;
+
+    private:
+        std::shared_ptr<HeapState> m_state;
+    };
+}
@@ -3,6 +3,10 @@
 
 #include "precomp.h"
 
+#include <list>
+
+#include "core/common/parse_string.h"
+#include "core/providers/dml/dml_session_options_config_keys.h"
 #include "core/providers/dml/DmlExecutionProvider/src/MLOperatorAuthorImpl.h"
 #include "core/providers/dml/DmlExecutionProvider/src/DmlRuntimeFusedGraphKernel.h"
 #include "core/providers/dml/DmlExecutionProvider/src/DmlGraphFusionHelper.h"
@@ -14,6 +18,22 @@ namespace Dml
 {
     class DmlRuntimeFusedGraphKernel : public onnxruntime::OpKernel
     {
+        // The graph compiled for one set of input shapes and CPU input values
+        struct CompiledGraph
+        {
+            ComPtr<IDMLCompiledOperator> compiledExecutionPlanOperator;
+            std::vector<bool> inputsUsed;
+            ComPtr<ID3D12Resource> persistentResource;
+            ComPtr<IUnknown> persistentResourceAllocatorUnknown; // Controls when the persistent resource is returned to the allocator
+            std::optional<DML_BUFFER_BINDING> persistentResourceBinding;
+            Windows::AI::MachineLearning::Adapter::EdgeShapes outputShapes;
+            std::deque<std::unique_ptr<DmlReusedCommandListState>> reusedCommandLists;
+            std::vector<std::unique_ptr<ONNX_NAMESPACE::TensorProto>> ownedCpuInputs;
+
+            // Captured graphs replay the command lists of this graph, so it must never be evicted
+            bool usedByCapturedGraph = false;
+        };
+
     public:
         DmlRuntimeFusedGraphKernel() = delete;
 
@@ -60,29 +80,59 @@ namespace Dml
             {
                 m_subgraphNodePointers.push_back(subgraphNode.get());
             }
+
+            const auto& configOptions = kernelInfo.GetConfigOptions();
+            const auto capacity = configOptions.GetConfigEntry(kOrtSessionOptionsConfigDmlRuntimeGraphCacheCapacity);
+            if (capacity.has_value())
+            {
+                ORT_ENFORCE(onnxruntime::TryParseStringWithClassicLocale<size_t>(*capacity, m_compiledGraphCacheCapacity),
+                            "Failed to parse the DML runtime graph cache capacity: ", *capacity);
+            }
+            m_compiledGraphCacheCapacity = std::max<size_t>(m_compiledGraphCacheCapacity, 1);
         }
 
-        void TranslateAndCompileGraph(const onnxruntime::OpKernelInfo& kernelInfo, std::vector<DML_BUFFER_BINDING> initInputBindings) const
+        void TranslateAndCompileGraph(CompiledGraph& compiledGraph, std::vector<DML_BUFFER_BINDING> initInputBindings) const
         {
             // Allocate a persistent resource and initialize the operator
-            UINT64 persistentResourceSize = m_compiledExecutionPlanOperator->GetBindingProperties().PersistentResourceSize;
+            UINT64 persistentResourceSize = compiledGraph.compiledExecutionPlanOperator->GetBindingProperties().PersistentResourceSize;
             if (persistentResourceSize > 0)
             {
                 ORT_THROW_IF_FAILED(m_provider->AllocatePooledResource(
                     static_cast<size_t>(persistentResourceSize),
                     AllocatorRoundingMode::Disabled,
-                    m_persistentResource.ReleaseAndGetAddressOf(),
-                    m_persistentResourceAllocatorUnknown.ReleaseAndGetAddressOf()));
+                    compiledGraph.persistentResource.ReleaseAndGetAddressOf(),
+                    compiledGraph.persistentResourceAllocatorUnknown.ReleaseAndGetAddressOf()));
 
-                m_persistentResourceBinding = DML_BUFFER_BINDING { m_persistentResource.Get(), 0, persistentResourceSize };
+                compiledGraph.persistentResourceBinding = DML_BUFFER_BINDING { compiledGraph.persistentResource.Get(), 0, persistentResourceSize };
             }
 
             ORT_THROW_IF_FAILED(m_provider->InitializeOperator(
-                m_compiledExecutionPlanOperator.Get(),
-                m_persistentResourceBinding ? &*m_persistentResourceBinding : nullptr,
+                compiledGraph.compiledExecutionPlanOperator.Get(),
+                compiledGraph.persistentResourceBinding ? &*compiledGraph.persistentResourceBinding : nullptr,
                 gsl::make_span(initInputBindings)));
         }
 
+        // Makes room for a new compiled graph by dropping the least recently used ones
+        void EvictCompiledGraphs() const
+        {
+            auto iter = m_compiledGraphs.end();
+            while (m_compiledGraphs.size() >= m_compiledGraphCacheCapacity && iter != m_compiledGraphs.begin())
+            {
+                --iter;
+                if (iter->second->usedByCapturedGraph)
+                {
+                    continue;
+                }
+
+                // The GPU may still be executing the graph
+                m_winmlProvider->QueueReference(iter->second->compiledExecutionPlanOperator.Get());
+                m_winmlProvider->QueueReference(iter->second->persistentResourceAllocatorUnknown.Get());
+
+                m_compiledGraphLookup.erase(iter->first);
+                iter = m_compiledGraphs.erase(iter);
+            }
+        }
+
         onnxruntime::Status Compute(onnxruntime::OpKernelContext* kernelContext) const override
         {
             // Release the references from the previous execution since Flush() isn't called for reusable command lists
@@ -91,63 +141,52 @@ namespace Dml
 
             ORT_THROW_HR_IF(E_UNEXPECTED, static_cast<ptrdiff_t>(m_subgraphInputs.size()) != kernelContext->InputCount());
 
-            bool recompileNeeded = m_compiledExecutionPlanOperator == nullptr;
-
+            // The graph is compiled for the shapes of the inputs and the values of the CPU inputs, which identify it in the cache
+            std::string compiledGraphKey;
+            std::vector<std::unique_ptr<ONNX_NAMESPACE::TensorProto>> cpuInputs;
             for (int inputIndex = 0; inputIndex < kernelContext->InputCount(); ++inputIndex)
             {
                 const auto& input = kernelContext->RequiredInput<onnxruntime::Tensor>(inputIndex);
-                const std::string& inputName = m_subgraphInputs[inputIndex]->Name();
-                auto shapeIter = m_inferredInputShapes.find(inputName);
-
-                if (shapeIter == m_inferredInputShapes.end())
-                {
-                    m_inferredInputShapes[inputName] = input.Shape();
-                    recompileNeeded = true;
-                }
-                else if (shapeIter->second != input.Shape())
+                for (int64_t dim : input.Shape().GetDims())
                 {
-                    shapeIter->second = input.Shape();
-                    recompileNeeded = true;
+                    compiledGraphKey += std::to_string(dim);
+                    compiledGraphKey += ',';
                 }
+                compiledGraphKey += ';';
 
-                // If we have CPU inputs that are not initializers (i.e. they were computed at runtime), add them to the initializer list
+                // If we have CPU inputs that are not initializers (i.e. they were computed at runtime), they are baked into the graph
                 if (input.Location().device.Type() == OrtDevice::CPU)
                 {
-                    auto inputProto = onnxruntime::utils::TensorToTensorProto(input, inputName);
+                    auto inputProto = onnxruntime::utils::TensorToTensorProto(input, m_subgraphInputs[inputIndex]->Name());
+                    compiledGraphKey += inputProto.SerializeAsString();
+                    compiledGraphKey += ';';
+                    cpuInputs.push_back(std::make_unique<ONNX_NAMESPACE::TensorProto>(std::move(inputProto)));
+                }
+            }
 
-                    // We can only avoid recompiling the graph when all CPU inputs are identical
-                    auto initializerIter = m_isInitializerTransferable.find(inputName);
+            auto lookupIter = m_compiledGraphLookup.find(compiledGraphKey);
+            if (lookupIter != m_compiledGraphLookup.end())
+            {
+                // Move the graph to the front of the least recently used list
+                m_compiledGraphs.splice(m_compiledGraphs.begin(), m_compiledGraphs, lookupIter->second);
+            }
+            else
+            {
+                EvictCompiledGraphs();
+                auto compiledGraph = std::make_unique<CompiledGraph>();
 
-                    if (initializerIter != m_isInitializerTransferable.end())
-                    {
-                        if (initializerIter->second.first->raw_data().length() == inputProto.raw_data().length())
-                        {
-                            for (size_t i = 0; i < inputProto.raw_data().length(); ++i)
-                            {
-                                if (initializerIter->second.first->raw_data()[i] != inputProto.raw_data()[i])
-                                {
-                                    recompileNeeded = true;
-                                    break;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            recompileNeeded = true;
-                        }
-                    }
-                    else
-                    {
-                        recompileNeeded = true;
-                    }
+                for (int inputIndex = 0; inputIndex < kernelContext->InputCount(); ++inputIndex)
+                {
+                    const auto& input = kernelContext->RequiredInput<onnxruntime::Tensor>(inputIndex);
+                    m_inferredInputShapes[m_subgraphInputs[inputIndex]->Name()] = input.Shape();
+                }
 
-                    m_ownedCpuInputs.push_back(std::make_unique<ONNX_NAMESPACE::TensorProto>(std::move(inputProto)));
-                    m_isInitializerTransferable[inputName] = std::make_pair(m_ownedCpuInputs.back().get(), false);
+                for (auto& cpuInput : cpuInputs)
+                {
+                    m_isInitializerTransferable[cpuInput->name()] = std::make_pair(cpuInput.get(), false);
                 }
-            }
+                compiledGraph->ownedCpuInputs = std::move(cpuInputs);
 
-            if (recompileNeeded)
-            {
                 // Go through all the node args and replace their shapes with the real ones
                 for (auto& nodeArg : m_intermediateNodeArgs)
                 {
@@ -201,15 +240,15 @@ namespace Dml
                     serializedGraphLargeConstantNameToSubgraphInputIndex,
                     smallConstantData);
 
-                m_outputShapes = graphDesc.outputShapes;
+                compiledGraph->outputShapes = graphDesc.outputShapes;
 
                 // Walk through each graph edge and mark used inputs
-                m_inputsUsed = std::vector<bool>(fusedNodeInputCount);
+                compiledGraph->inputsUsed = std::vector<bool>(fusedNodeInputCount);
                 for (auto it = serializedGraphInputIndexToSubgraphInputIndex.begin(); it != serializedGraphInputIndexToSubgraphInputIndex.end(); it++) {
-                    m_inputsUsed[it->second] = true;
+                    compiledGraph->inputsUsed[it->second] = true;
                 }
                 for (auto it = serializedGraphLargeConstantNameToSubgraphInputIndex.begin(); it != serializedGraphLargeConstantNameToSubgraphInputIndex.end(); it++) {
-                    m_inputsUsed[it->second] = true;
+                    compiledGraph->inputsUsed[it->second] = true;
                 }
 
                 m_isInputsUploadedByDmlEP.resize(fusedNodeInputCount, 0);
@@ -217,7 +256,7 @@ namespace Dml
                 graphDesc.reuseCommandList = true;
 
                 // Compile the operator
-                m_compiledExecutionPlanOperator = DmlGraphFusionHelper::TryCreateCompiledOperator(
+                compiledGraph->compiledExecutionPlanOperator = DmlGraphFusionHelper::TryCreateCompiledOperator(
                     graphDesc,
                     *m_indexedSubGraph,
                     cProviderImpl,
@@ -225,28 +264,28 @@ namespace Dml
                     &serializedGraphLargeConstantNameToSubgraphInputIndex);
 
                 // Queue references to objects which must be kept alive until resulting GPU work completes
-                m_winmlProvider->QueueReference(m_compiledExecutionPlanOperator.Get());
-
-                TranslateAndCompileGraph(Info(), initInputBindings);
+                m_winmlProvider->QueueReference(compiledGraph->compiledExecutionPlanOperator.Get());
 
-                std::vector<DML_BUFFER_BINDING> inputBindings(kernelContext->InputCount());
-                std::vector<DML_BINDING_DESC> inputBindingDescs(kernelContext->InputCount());
+                TranslateAndCompileGraph(*compiledGraph, initInputBindings);
 
-                m_reusedCommandLists.clear();
+                m_compiledGraphs.emplace_front(compiledGraphKey, std::move(compiledGraph));
+                m_compiledGraphLookup[std::move(compiledGraphKey)] = m_compiledGraphs.begin();
             }
 
+            CompiledGraph& compiledGraph = *m_compiledGraphs.front().second;
+
             // When we are capturing a graph, we don't pool the command list and instead transfer it to the execution provider. Captured graph
             // have the same bindings for their entire lifetime.
             if (providerImpl->GraphCaptureEnabled() && providerImpl->GetCurrentGraphAnnotationId() != -1 && !providerImpl->GraphCaptured(providerImpl->GetCurrentGraphAnnotationId()))
             {
                 auto reusableCommandList = DmlGraphFusionHelper::BuildReusableCommandList(
                     m_provider.Get(),
-                    m_compiledExecutionPlanOperator.Get(),
-                    m_persistentResource.Get(),
-                    m_persistentResourceBinding);
+                    compiledGraph.compiledExecutionPlanOperator.Get(),
+                    compiledGraph.persistentResource.Get(),
+                    compiledGraph.persistentResourceBinding);
 
-                reusableCommandList->persistentResource = m_persistentResource;
-                reusableCommandList->persistentResourceAllocatorUnknown = m_persistentResourceAllocatorUnknown;
+                reusableCommandList->persistentResource = compiledGraph.persistentResource;
+                reusableCommandList->persistentResourceAllocatorUnknown = compiledGraph.persistentResourceAllocatorUnknown;
 
                 // Keep the temporary resource alive since we won't call ExecuteReusableCommandList again, but will merely replay
                 // the graph in the future. Therefore, all executions of the graph will use the same temporary resource that was
@@ -256,31 +295,32 @@ namespace Dml
                 DmlGraphFusionHelper::ExecuteReusableCommandList(
                     kernelContext,
                     *reusableCommandList,
-                    m_compiledExecutionPlanOperator.Get(),
+                    compiledGraph.compiledExecutionPlanOperator.Get(),
                     Info(),
                     m_isInputsUploadedByDmlEP,
-                    m_inputsUsed,
+                    compiledGraph.inputsUsed,
                     m_nonOwnedGraphInputsFromInitializers,
-                    m_outputShapes,
+                    compiledGraph.outputShapes,
                     m_winmlProvider.Get(),
                     m_provider.Get(),
-                    m_persistentResourceAllocatorUnknown.Get(),
+                    compiledGraph.persistentResourceAllocatorUnknown.Get(),
                     keepTemporaryResourceAlive);
 
                 providerImpl->AppendCapturedGraph(providerImpl->GetCurrentGraphAnnotationId(), std::move(reusableCommandList));
+                compiledGraph.usedByCapturedGraph = true;
             }
             else
             {
-                if (m_reusedCommandLists.empty() ||
-                    m_reusedCommandLists.front()->fence && m_reusedCommandLists.front()->fence->GetCompletedValue() < m_reusedCommandLists.front()->completionValue)
+                if (compiledGraph.reusedCommandLists.empty() ||
+                    compiledGraph.reusedCommandLists.front()->fence && compiledGraph.reusedCommandLists.front()->fence->GetCompletedValue() < compiledGraph.reusedCommandLists.front()->completionValue)
                 {
                     auto reusableCommandList = DmlGraphFusionHelper::BuildReusableCommandList(
                         m_provider.Get(),
-                        m_compiledExecutionPlanOperator.Get(),
-                        m_persistentResource.Get(),
-                        m_persistentResourceBinding);
+                        compiledGraph.compiledExecutionPlanOperator.Get(),
+                        compiledGraph.persistentResource.Get(),
+                        compiledGraph.persistentResourceBinding);
 
-                    m_reusedCommandLists.push_front(std::move(reusableCommandList));
+                    compiledGraph.reusedCommandLists.push_front(std::move(reusableCommandList));
                 }
 
                 // We don't need to keep a reference on the temporary resource once we have recorded into the command list, so the
@@ -289,20 +329,20 @@ namespace Dml
 
                 DmlGraphFusionHelper::ExecuteReusableCommandList(
                     kernelContext,
-                    *m_reusedCommandLists.front(),
-                    m_compiledExecutionPlanOperator.Get(),
+                    *compiledGraph.reusedCommandLists.front(),
+                    compiledGraph.compiledExecutionPlanOperator.Get(),
                     Info(),
                     m_isInputsUploadedByDmlEP,
-                    m_inputsUsed,
+                    compiledGraph.inputsUsed,
                     m_nonOwnedGraphInputsFromInitializers,
-                    m_outputShapes,
+                    compiledGraph.outputShapes,
                     m_winmlProvider.Get(),
                     m_provider.Get(),
-                    m_persistentResourceAllocatorUnknown.Get(),
+                    compiledGraph.persistentResourceAllocatorUnknown.Get(),
                     keepTemporaryResourceAlive);
 
-                m_reusedCommandLists.push_back(std::move(m_reusedCommandLists.front()));
-                m_reusedCommandLists.pop_front();
+                compiledGraph.reusedCommandLists.push_back(std::move(compiledGraph.reusedCommandLists.front()));
+                compiledGraph.reusedCommandLists.pop_front();
             }
 
             return onnxruntime::Status::OK();
@@ -312,7 +352,6 @@ namespace Dml
         ComPtr<IWinmlExecutionProvider> m_winmlProvider;
         ComPtr<Dml::IExecutionProvider> m_provider;
 
-        mutable std::optional<DML_BUFFER_BINDING> m_persistentResourceBinding;
         std::shared_ptr<const onnxruntime::IndexedSubGraph> m_indexedSubGraph;
         const std::filesystem::path& m_modelPath;
 
@@ -325,15 +364,13 @@ namespace Dml
         mutable std::unordered_map<std::string, std::pair<const ONNX_NAMESPACE::TensorProto*, bool>> m_isInitializerTransferable;
         std::vector<const onnxruntime::Node*> m_subgraphNodePointers;
 
-        // Bindings from previous executions of a re-used command list
-        mutable std::vector<std::unique_ptr<ONNX_NAMESPACE::TensorProto>> m_ownedCpuInputs;
-        mutable ComPtr<IDMLCompiledOperator> m_compiledExecutionPlanOperator;
-        mutable std::vector<bool> m_inputsUsed;
-        mutable ComPtr<ID3D12Resource> m_persistentResource;
-        mutable ComPtr<IUnknown> m_persistentResourceAllocatorUnknown; // Controls when the persistent resource is returned to the allocator
-        mutable Windows::AI::MachineLearning::Adapter::EdgeShapes m_outputShapes;
+        // Compiled graphs, most recently used first
+        size_t m_compiledGraphCacheCapacity = 1;
+        using CompiledGraphList = std::list<std::pair<std::string, std::unique_ptr<CompiledGraph>>>;
+        mutable CompiledGraphList m_compiledGraphs;
+        mutable std::unordered_map<std::string, CompiledGraphList::iterator> m_compiledGraphLookup;
+
         mutable std::unordered_map<std::string, onnxruntime::TensorShape> m_inferredInputShapes;
-        mutable std::deque<std::unique_ptr<DmlReusedCommandListState>> m_reusedCommandLists;
         mutable std::vector<uint8_t> m_isInputsUploadedByDmlEP;
         mutable std::vector<ComPtr<ID3D12Resource>> m_nonOwnedGraphInputsFromInitializers;
     };
@@ -18,6 +18,7 @@
 #include "core/framework/compute_capability.h"
 #include "core/framework/fallback_cpu_capability.h"
 #include "DmlCommittedResourceAllocator.h"
+#include "DmlHeapSubAllocator.h"
 #include "DmlCommittedResourceWrapper.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
 #include "core/common/parse_string.h"
@@ -73,7 +74,8 @@ namespace Dml
         bool enableMetacommands,
         bool enableGraphCapture,
         bool enableSyncSpinning,
-        bool disableMemoryArena) :
+        bool disableMemoryArena,
+        bool enableHeapSubAllocation) :
             IExecutionProvider(onnxruntime::kDmlExecutionProvider, OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, 0))
     {
         D3D12_COMMAND_LIST_TYPE queueType = executionContext->GetCommandListTypeForQueue();
@@ -86,7 +88,7 @@ namespace Dml
         ComPtr<ID3D12Device> device;
         GRAPHICS_THROW_IF_FAILED(dmlDevice->GetParentDevice(IID_GRAPHICS_PPV_ARGS(device.GetAddressOf())));
 
-        m_impl = wil::MakeOrThrow<ExecutionProviderImpl>(dmlDevice, device.Get(), executionContext, enableMetacommands, enableGraphCapture, enableSyncSpinning, disableMemoryArena);
+        m_impl = wil::MakeOrThrow<ExecutionProviderImpl>(dmlDevice, device.Get(), executionContext, enableMetacommands, enableGraphCapture, enableSyncSpinning, disableMemoryArena, enableHeapSubAllocation);
     }
 
     std::vector<std::unique_ptr<onnxruntime::ComputeCapability>>
@@ -106,6 +108,12 @@ namespace Dml
         // Release the cached command list references before closing the context
         m_capturedGraphs.clear();
 
+        // Finish the asynchronous readbacks while their callbacks can still use the provider
+        if (m_readbackHeap)
+        {
+            m_readbackHeap->WaitForPendingReadbacks();
+        }
+
         // Close the allocator before clearing the command queue to stop it from
         // appending resources to it in an attempt to keep them alive.
         if (m_allocator)
@@ -169,13 +177,14 @@ namespace Dml
         }
     }
 
-    ExecutionProviderImpl::ExecutionProviderImpl(IDMLDevice* dmlDevice, ID3D12Device* d3d12Device, ExecutionContext* executionContext, bool enableMetacommands, bool enableGraphCapture, bool enableCpuSyncSpinning, bool disableMemoryArena)
+    ExecutionProviderImpl::ExecutionProviderImpl(IDMLDevice* dmlDevice, ID3D12Device* d3d12Device, ExecutionContext* executionContext, bool enableMetacommands, bool enableGraphCapture, bool enableCpuSyncSpinning, bool disableMemoryArena, bool enableHeapSubAllocation)
         : m_d3d12Device(d3d12Device),
           m_dmlDevice(dmlDevice),
           m_areMetacommandsEnabled(enableMetacommands),
           m_graphCaptureEnabled(enableGraphCapture),
           m_cpuSyncSpinningEnabled(enableCpuSyncSpinning),
           m_memoryArenaDisabled(disableMemoryArena),
+          m_heapSubAllocationEnabled(enableHeapSubAllocation),
           m_context(executionContext)
     {
         D3D12_FEATURE_DATA_FEATURE_LEVELS featureLevels = {};
@@ -247,6 +256,16 @@ namespace Dml
     std::vector<onnxruntime::AllocatorPtr> ExecutionProviderImpl::CreatePreferredAllocators() {
         if (!m_allocator)
         {
+            std::unique_ptr<DmlSubAllocator> subAllocator;
+            if (m_heapSubAllocationEnabled)
+            {
+                subAllocator = std::make_unique<DmlHeapSubAllocator>(m_d3d12Device.Get());
+            }
+            else
+            {
+                subAllocator = std::make_unique<DmlCommittedResourceAllocator>(m_d3d12Device.Get());
+            }
+
             // Create an allocator for D3D12 buffers used to hold tensor data. The returned buffers from the allocator
             // should be DEFAULT heap buffers which can be used as UAVs, and which start in UAV state.
             m_allocator = std::make_shared<BucketizedBufferAllocator>(m_d3d12Device.Get(),
@@ -255,7 +274,7 @@ namespace Dml
                 D3D12_HEAP_FLAG_NONE,
                 D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
                 D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-                std::make_unique<DmlCommittedResourceAllocator>(m_d3d12Device.Get()));
+                std::move(subAllocator));
             m_context->SetAllocator(m_allocator);
             // CPU Allocator used to create buffers for the MemcpyFromHost, Shape and Size operators.
             OrtMemoryInfo memoryInfo(onnxruntime::CPU, OrtAllocatorType::OrtDeviceAllocator);
@@ -1030,6 +1049,7 @@ namespace Dml
     void ExecutionProviderImpl::ReleaseCompletedReferences()
     {
          m_context->ReleaseCompletedReferences();
+         m_readbackHeap->ProcessCompletedReadbacks();
     }
 
     void ExecutionProviderImpl::QueueReference(IUnknown* object)
@@ -1204,7 +1224,9 @@ namespace Dml
         m_context->ReleaseCompletedReferences();
         m_uploadHeap->Trim();
 
-        if (!m_memoryArenaDisabled)
+        // Sub-allocated buffers are reused through the free ranges of their heaps, so their sizes are not rounded up
+        // to the power of two buckets.
+        if (!m_memoryArenaDisabled && !m_heapSubAllocationEnabled)
         {
             // Allocations after this point are potentially transient and their sizes are
             // rounded to enable pooling.
@@ -1270,9 +1292,10 @@ namespace Dml
         bool enableMetacommands,
         bool enableGraphCapture,
         bool enableCpuSyncSpinning,
-        bool disableMemoryArena)
+        bool disableMemoryArena,
+        bool enableHeapSubAllocation)
     {
-        return std::make_unique<Dml::ExecutionProvider>(dmlDevice, executionContext, enableMetacommands, enableGraphCapture, enableCpuSyncSpinning, disableMemoryArena);
+        return std::make_unique<Dml::ExecutionProvider>(dmlDevice, executionContext, enableMetacommands, enableGraphCapture, enableCpuSyncSpinning, disableMemoryArena, enableHeapSubAllocation);
     }
 
     ID3D12Resource* GetD3D12ResourceFromAllocation(onnxruntime::IAllocator* allocator, void* ptr)
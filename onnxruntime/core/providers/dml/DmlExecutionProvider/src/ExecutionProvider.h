@@ -38,7 +38,8 @@ namespace Dml
             bool enableMetacommands,
             bool enableGraphCapture,
             bool enableCpuSyncSpinning,
-            bool disableMemoryArena);
+            bool disableMemoryArena,
+            bool enableHeapSubAllocation);
 
         void ReleaseCompletedReferences();
 
@@ -208,6 +209,7 @@ namespace Dml
         bool m_sessionInitialized = false;
         bool m_cpuSyncSpinningEnabled = false;
         bool m_memoryArenaDisabled = false;
+        bool m_heapSubAllocationEnabled = false;
         ComPtr<ExecutionContext> m_context;
         std::unique_ptr<PooledUploadHeap> m_uploadHeap;
         std::unique_ptr<ReadbackHeap> m_readbackHeap;
@@ -262,7 +264,8 @@ namespace Dml
             bool enableMetacommands,
             bool enableGraphCapture,
             bool enableSyncSpinning,
-            bool disableMemoryArena
+            bool disableMemoryArena,
+            bool enableHeapSubAllocation
         );
 
         std::unique_ptr<onnxruntime::IDataTransfer> GetDataTransfer() const final override
@@ -20,6 +20,9 @@ public:
             pastKeyIndex,
             pastValueIndex,
             seqLensIndex,
+            totalSequenceLengthIndex,
+            cosCacheIndex,
+            sinCacheIndex,
             inputCount,
         };
 
@@ -34,10 +37,18 @@ public:
         ML_CHECK_VALID_ARGUMENT(kernelCreationContext.GetInputCount() >= 1);
         ML_CHECK_VALID_ARGUMENT(kernelCreationContext.GetOutputCount() >= 1);
 
+        // When key and value are missing, the query input holds the packed query, key and value
+        const bool isPackedQkv = !kernelCreationContext.IsInputValid(keyIndex);
+        const bool doRotary = kernelCreationContext.GetOptionalAttribute<int64_t>(AttrName::DoRotary, 0) != 0;
+        const bool rotaryInterleaved = kernelCreationContext.GetOptionalAttribute<int64_t>(AttrName::RotaryInterleaved, 0) != 0;
+
         std::vector<std::optional<uint32_t>> inputIndices(inputCount);
         inputIndices[queryIndex] = queryIndex;
-        inputIndices[keyIndex] = keyIndex;
-        inputIndices[valueIndex] = valueIndex;
+        if (!isPackedQkv)
+        {
+            inputIndices[keyIndex] = keyIndex;
+            inputIndices[valueIndex] = valueIndex;
+        }
 
         const uint32_t sequenceLength = kernelCreationContext.GetInputTensorShape(queryIndex)[1];
 
@@ -46,6 +57,13 @@ public:
             inputIndices[seqLensIndex] = seqLensIndex;
         }
 
+        if (doRotary)
+        {
+            ML_CHECK_VALID_ARGUMENT(kernelCreationContext.IsInputValid(cosCacheIndex) && kernelCreationContext.IsInputValid(sinCacheIndex));
+            inputIndices[cosCacheIndex] = cosCacheIndex;
+            inputIndices[sinCacheIndex] = sinCacheIndex;
+        }
+
         std::vector<std::optional<uint32_t>> outputIndices = {
             outputIndex,
             outputPresentKeyIndex,
@@ -54,40 +72,51 @@ public:
         DmlOperator::Initialize(kernelCreationContext, inputIndices, outputIndices, std::nullopt, std::nullopt, 1);
 
         ML_CHECK_VALID_ARGUMENT(m_inputTensorDescs[queryIndex].GetDimensionCount() == 3);
-        ML_CHECK_VALID_ARGUMENT(m_inputTensorDescs[keyIndex].GetDimensionCount() == 3);
-        ML_CHECK_VALID_ARGUMENT(m_inputTensorDescs[valueIndex].GetDimensionCount() == 3);
 
         const uint32_t queryNumHeads = gsl::narrow_cast<uint32_t>(kernelCreationContext.GetAttribute<int64_t>(AttrName::NumHeads));
         const uint32_t kvNumHeads = gsl::narrow_cast<uint32_t>(kernelCreationContext.GetAttribute<int64_t>(AttrName::KvNumHeads));
 
         auto querySizes = m_inputTensorDescs[queryIndex].GetSizes();
-        auto keySizes = m_inputTensorDescs[keyIndex].GetSizes();
-        auto valueSizes = m_inputTensorDescs[valueIndex].GetSizes();
-
         const uint32_t batchSize = querySizes[0];
-        const uint32_t queryHiddenSize = querySizes[2];
 
-        const uint32_t kvSequenceLength = keySizes[1];
-        const uint32_t kvHiddenSize = keySizes[2];
+        uint32_t queryHiddenSize = querySizes[2];
+        uint32_t kvSequenceLength = sequenceLength;
+        uint32_t kvHiddenSize = 0;
+
+        if (isPackedQkv)
+        {
+            const uint32_t headSize = querySizes[2] / (queryNumHeads + 2 * kvNumHeads);
+            ML_CHECK_VALID_ARGUMENT(querySizes[2] == headSize * (queryNumHeads + 2 * kvNumHeads));
+            queryHiddenSize = queryNumHeads * headSize;
+            kvHiddenSize = kvNumHeads * headSize;
+        }
+        else
+        {
+            ML_CHECK_VALID_ARGUMENT(m_inputTensorDescs[keyIndex].GetDimensionCount() == 3);
+            ML_CHECK_VALID_ARGUMENT(m_inputTensorDescs[valueIndex].GetDimensionCount() == 3);
+
+            auto keySizes = m_inputTensorDescs[keyIndex].GetSizes();
+            auto valueSizes = m_inputTensorDescs[valueIndex].GetSizes();
+            kvSequenceLength = keySizes[1];
+            kvHiddenSize = keySizes[2];
+
+            // Validate Key dimensions
+            ML_CHECK_VALID_ARGUMENT(keySizes[0] == batchSize);
+            ML_CHECK_VALID_ARGUMENT(keySizes[1] == kvSequenceLength);
+            ML_CHECK_VALID_ARGUMENT(keySizes[2] == kvHiddenSize);
+
+            // Validate Value dimensions
+            ML_CHECK_VALID_ARGUMENT(valueSizes[0] == batchSize);
+            ML_CHECK_VALID_ARGUMENT(valueSizes[1] == kvSequenceLength);
+            ML_CHECK_VALID_ARGUMENT(valueSizes[2] == kvHiddenSize);
+        }
 
         const uint32_t queryHeadSize = queryHiddenSize / queryNumHeads;
         const uint32_t kvHeadSize = kvHiddenSize / kvNumHeads;
-        const uint32_t totalSequenceLength = GetTotalSequenceLength();
 
         // Validate Query dimensions
         ML_CHECK_VALID_ARGUMENT(querySizes[0] == batchSize);
         ML_CHECK_VALID_ARGUMENT(querySizes[1] == sequenceLength);
-        ML_CHECK_VALID_ARGUMENT(querySizes[2] == queryHiddenSize);
-
-        // Validate Key dimensions
-        ML_CHECK_VALID_ARGUMENT(keySizes[0] == batchSize);
-        ML_CHECK_VALID_ARGUMENT(keySizes[1] == kvSequenceLength);
-        ML_CHECK_VALID_ARGUMENT(keySizes[2] == kvHiddenSize);
-
-        // Validate Value dimensions
-        ML_CHECK_VALID_ARGUMENT(valueSizes[0] == batchSize);
-        ML_CHECK_VALID_ARGUMENT(valueSizes[1] == kvSequenceLength);
-        ML_CHECK_VALID_ARGUMENT(valueSizes[2] == kvHiddenSize);
 
         if (sequenceLength == 1)
         {
@@ -104,6 +133,16 @@ public:
             }
         }
 
+        const uint32_t halfHeadSize = queryHeadSize / 2;
+        if (doRotary)
+        {
+            // The rotation is applied to the whole head, so the caches must hold half a head per position
+            ML_CHECK_VALID_ARGUMENT(queryHeadSize == kvHeadSize && queryHeadSize % 2 == 0);
+            ML_CHECK_VALID_ARGUMENT(m_inputTensorDescs[cosCacheIndex].GetDimensionCount() == 2);
+            ML_CHECK_VALID_ARGUMENT(m_inputTensorDescs[cosCacheIndex].GetSizes().back() == halfHeadSize, "Partial rotary embeddings are not supported");
+            ML_CHECK_VALID_ARGUMENT(m_inputTensorDescs[cosCacheIndex].GetSizes() == m_inputTensorDescs[sinCacheIndex].GetSizes());
+        }
+
         const std::array<uint32_t, 1> pastSequenceLengthsShape = {batchSize};
         auto pastSequenceLengthsDataType = MLOperatorTensorDataType::Int32;
         TensorDesc pastSequenceLengthsTensorDesc = TensorDesc::ConstructDefaultTensorDesc(pastSequenceLengthsDataType, pastSequenceLengthsShape);
@@ -112,27 +151,293 @@ public:
         std::vector<DML_TENSOR_DESC> inputDescs = GetDmlInputDescs();
         std::vector<DML_TENSOR_DESC> outputDescs = GetDmlOutputDescs();
 
+        const MLOperatorTensorDataType dataType = kernelCreationContext.GetInputEdgeDescription(queryIndex).tensorDataType;
+        const std::array<uint32_t, 3> queryShape = {batchSize, sequenceLength, queryHiddenSize};
+        const std::array<uint32_t, 3> keyValueShape = {batchSize, kvSequenceLength, kvHiddenSize};
+        TensorDesc queryTensorDesc = TensorDesc::ConstructDefaultTensorDesc(dataType, queryShape);
+        TensorDesc keyValueTensorDesc = TensorDesc::ConstructDefaultTensorDesc(dataType, keyValueShape);
+        const DML_TENSOR_DESC queryDmlTensorDesc = queryTensorDesc.GetDmlDesc();
+        const DML_TENSOR_DESC keyValueDmlTensorDesc = keyValueTensorDesc.GetDmlDesc();
+
+        // The nodes of the graph, and where each of query, key and value currently comes from: either a graph input
+        // or the output of a node
+        struct EdgeSource
+        {
+            std::optional<uint32_t> graphInputIndex;
+            uint32_t nodeIndex;
+            uint32_t nodeOutputIndex;
+        };
+
+        std::vector<const DML_OPERATOR_DESC*> opDescs;
+        std::vector<DML_INPUT_GRAPH_EDGE_DESC> inputEdges;
+        std::vector<DML_INTERMEDIATE_GRAPH_EDGE_DESC> intermediateEdges;
+        std::vector<DML_OUTPUT_GRAPH_EDGE_DESC> outputEdges;
+
+        auto addNode = [&opDescs](const DML_OPERATOR_DESC* opDesc)
+        {
+            opDescs.push_back(opDesc);
+            return gsl::narrow_cast<uint32_t>(opDescs.size() - 1);
+        };
+
+        auto connect = [&inputEdges, &intermediateEdges](const EdgeSource& source, uint32_t toNodeIndex, uint32_t toNodeInputIndex)
+        {
+            if (source.graphInputIndex)
+            {
+                DML_INPUT_GRAPH_EDGE_DESC inputEdge = {};
+                inputEdge.GraphInputIndex = *source.graphInputIndex;
+                inputEdge.ToNodeIndex = toNodeIndex;
+                inputEdge.ToNodeInputIndex = toNodeInputIndex;
+                inputEdges.push_back(inputEdge);
+            }
+            else
+            {
+                DML_INTERMEDIATE_GRAPH_EDGE_DESC intermediateEdge = {};
+                intermediateEdge.FromNodeIndex = source.nodeIndex;
+                intermediateEdge.FromNodeOutputIndex = source.nodeOutputIndex;
+                intermediateEdge.ToNodeIndex = toNodeIndex;
+                intermediateEdge.ToNodeInputIndex = toNodeInputIndex;
+                intermediateEdges.push_back(intermediateEdge);
+            }
+        };
+
+        // MHA is always the first node, since the other nodes are only added when needed
+        DML_MULTIHEAD_ATTENTION1_OPERATOR_DESC mhaDesc = {};
+        DML_OPERATOR_DESC mhaDmlDesc = { DML_OPERATOR_MULTIHEAD_ATTENTION1, &mhaDesc };
+        const uint32_t mhaNodeIndex = addNode(&mhaDmlDesc);
+
+        std::array<EdgeSource, 3> qkvSources = {
+            EdgeSource{queryIndex},
+            EdgeSource{keyIndex},
+            EdgeSource{valueIndex},
+        };
+
+        // The tensor descs with which the consumers of query, key and value read them
+        std::array<const DML_TENSOR_DESC*, 3> qkvDescs = {
+            &inputDescs[queryIndex],
+            isPackedQkv ? &keyValueDmlTensorDesc : &inputDescs[keyIndex],
+            isPackedQkv ? &keyValueDmlTensorDesc : &inputDescs[valueIndex],
+        };
+
+        // Unpack the query, key and value
+        const std::array<DML_TENSOR_DESC, 3> splitQkvDmlTensorDescs = {queryDmlTensorDesc, keyValueDmlTensorDesc, keyValueDmlTensorDesc};
+        DML_SPLIT_OPERATOR_DESC splitQkvDesc = {};
+        splitQkvDesc.InputTensor = &inputDescs[queryIndex];
+        splitQkvDesc.OutputCount = gsl::narrow_cast<uint32_t>(splitQkvDmlTensorDescs.size());
+        splitQkvDesc.OutputTensors = splitQkvDmlTensorDescs.data();
+        splitQkvDesc.Axis = 2;
+        const DML_OPERATOR_DESC splitQkvDmlDesc = { DML_OPERATOR_SPLIT, &splitQkvDesc };
+
+        if (isPackedQkv)
+        {
+            const uint32_t splitQkvNodeIndex = addNode(&splitQkvDmlDesc);
+            connect(EdgeSource{queryIndex}, splitQkvNodeIndex, 0);
+
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                qkvSources[i] = EdgeSource{std::nullopt, splitQkvNodeIndex, i};
+            }
+            qkvDescs[0] = &queryDmlTensorDesc;
+        }
+
+        // Rotate the query and the key by their position before the attention. The position ids are the indices of the
+        // tokens for the prompt, and the past sequence lengths (seqlens_k) for the token generation, which matches the
+        // CPU and CUDA implementations that also assume that the prompt has no past.
+        const uint32_t positionCount = sequenceLength == 1 ? batchSize : sequenceLength;
+        const std::array<uint32_t, 4> positionIdsShape = {1, 1, 1, positionCount};
+        TensorDesc positionIdsTensorDesc = TensorDesc::ConstructDefaultTensorDesc(MLOperatorTensorDataType::Int32, positionIdsShape);
+        const DML_TENSOR_DESC positionIdsDmlTensorDesc = positionIdsTensorDesc.GetDmlDesc();
+
+        DML_FILL_VALUE_SEQUENCE_OPERATOR_DESC positionIdsRangeDesc = {};
+        positionIdsRangeDesc.OutputTensor = &positionIdsDmlTensorDesc;
+        positionIdsRangeDesc.ValueDataType = DML_TENSOR_DATA_TYPE_INT32;
+        positionIdsRangeDesc.ValueDelta.Int32 = 1;
+        const DML_OPERATOR_DESC positionIdsRangeDmlDesc = { DML_OPERATOR_FILL_VALUE_SEQUENCE, &positionIdsRangeDesc };
+
+        // Gather needs its input, indices and output to have the same rank
+        const uint32_t maxRotarySequenceLength = doRotary ? m_inputTensorDescs[cosCacheIndex].GetSizes().front() : 1;
+        const std::array<uint32_t, 4> cosSinCacheShape = {1, 1, maxRotarySequenceLength, halfHeadSize};
+        TensorDesc cosSinCacheTensorDesc = TensorDesc::ConstructDefaultTensorDesc(dataType, cosSinCacheShape);
+        const DML_TENSOR_DESC cosSinCacheDmlTensorDesc = cosSinCacheTensorDesc.GetDmlDesc();
+
+        const std::array<uint32_t, 4> gatheredCosSinShape = {1, 1, positionCount, halfHeadSize};
+        TensorDesc gatheredCosSinTensorDesc = TensorDesc::ConstructDefaultTensorDesc(dataType, gatheredCosSinShape);
+        const DML_TENSOR_DESC gatheredCosSinDmlTensorDesc = gatheredCosSinTensorDesc.GetDmlDesc();
+
+        DML_GATHER_OPERATOR_DESC gatherCosSinDesc = {};
+        gatherCosSinDesc.InputTensor = &cosSinCacheDmlTensorDesc;
+        gatherCosSinDesc.IndicesTensor = &positionIdsDmlTensorDesc;
+        gatherCosSinDesc.OutputTensor = &gatheredCosSinDmlTensorDesc;
+        gatherCosSinDesc.Axis = 2;
+        gatherCosSinDesc.IndexDimensions = 1;
+        const DML_OPERATOR_DESC gatherCosSinDmlDesc = { DML_OPERATOR_GATHER, &gatherCosSinDesc };
+
+        // The descs of the rotation of one input. The heads are viewed as [2, headSize / 2], or [headSize / 2, 2] when
+        // interleaved, and split into the halves x1 and x2 that become x1 * cos - x2 * sin and x2 * cos + x1 * sin.
+        struct RotaryDescs
+        {
+            TensorDesc inputTensorDesc;
+            TensorDesc halfTensorDesc;
+            TensorDesc cosSinTensorDesc;
+            DML_TENSOR_DESC inputDmlTensorDesc;
+            std::array<DML_TENSOR_DESC, 2> halfDmlTensorDescs;
+            DML_TENSOR_DESC cosSinDmlTensorDesc;
+
+            DML_SPLIT_OPERATOR_DESC splitDesc;
+            DML_ELEMENT_WISE_MULTIPLY_OPERATOR_DESC mulDesc;
+            DML_ELEMENT_WISE_SUBTRACT_OPERATOR_DESC subtractDesc;
+            DML_ELEMENT_WISE_ADD_OPERATOR_DESC addDesc;
+            DML_JOIN_OPERATOR_DESC joinDesc;
+
+            DML_OPERATOR_DESC splitDmlDesc;
+            DML_OPERATOR_DESC mulDmlDesc;
+            DML_OPERATOR_DESC subtractDmlDesc;
+            DML_OPERATOR_DESC addDmlDesc;
+            DML_OPERATOR_DESC joinDmlDesc;
+        };
+
+        auto makeRotaryDescs = [&](uint32_t headCount)
+        {
+            const uint32_t splitAxis = rotaryInterleaved ? 4 : 3;
+            const std::array<uint32_t, 5> inputShape = rotaryInterleaved
+                ? std::array<uint32_t, 5>({batchSize, sequenceLength, headCount, halfHeadSize, 2})
+                : std::array<uint32_t, 5>({batchSize, sequenceLength, headCount, 2, halfHeadSize});
+            const std::array<uint32_t, 5> halfShape = rotaryInterleaved
+                ? std::array<uint32_t, 5>({batchSize, sequenceLength, headCount, halfHeadSize, 1})
+                : std::array<uint32_t, 5>({batchSize, sequenceLength, headCount, 1, halfHeadSize});
+
+            // The gathered cos and sin have one row per batch for the token generation and per token for the prompt,
+            // and are broadcasted to the other dimensions
+            std::array<uint32_t, 5> cosSinShape = rotaryInterleaved
+                ? std::array<uint32_t, 5>({1, 1, 1, halfHeadSize, 1})
+                : std::array<uint32_t, 5>({1, 1, 1, 1, halfHeadSize});
+            cosSinShape[sequenceLength == 1 ? 0 : 1] = positionCount;
+
+            return RotaryDescs{
+                TensorDesc::ConstructDefaultTensorDesc(dataType, inputShape),
+                TensorDesc::ConstructDefaultTensorDesc(dataType, halfShape),
+                TensorDesc::ConstructBroadcastedTensorDesc(dataType, halfShape, cosSinShape),
+                {}, {}, {},
+                DML_SPLIT_OPERATOR_DESC{nullptr, 2, nullptr, splitAxis},
+                {}, {}, {},
+                DML_JOIN_OPERATOR_DESC{2, nullptr, nullptr, splitAxis},
+            };
+        };
+
+        auto initializeRotaryDescs = [](RotaryDescs& descs)
+        {
+            descs.inputDmlTensorDesc = descs.inputTensorDesc.GetDmlDesc();
+            descs.halfDmlTensorDescs = {descs.halfTensorDesc.GetDmlDesc(), descs.halfTensorDesc.GetDmlDesc()};
+            descs.cosSinDmlTensorDesc = descs.cosSinTensorDesc.GetDmlDesc();
+
+            descs.splitDesc.InputTensor = &descs.inputDmlTensorDesc;
+            descs.splitDesc.OutputTensors = descs.halfDmlTensorDescs.data();
+
+            descs.mulDesc.ATensor = &descs.halfDmlTensorDescs[0];
+            descs.mulDesc.BTensor = &descs.cosSinDmlTensorDesc;
+            descs.mulDesc.OutputTensor = &descs.halfDmlTensorDescs[0];
+
+            descs.subtractDesc.ATensor = &descs.halfDmlTensorDescs[0];
+            descs.subtractDesc.BTensor = &descs.halfDmlTensorDescs[0];
+            descs.subtractDesc.OutputTensor = &descs.halfDmlTensorDescs[0];
+
+            descs.addDesc.ATensor = &descs.halfDmlTensorDescs[0];
+            descs.addDesc.BTensor = &descs.halfDmlTensorDescs[0];
+            descs.addDesc.OutputTensor = &descs.halfDmlTensorDescs[0];
+
+            descs.joinDesc.InputTensors = descs.halfDmlTensorDescs.data();
+            descs.joinDesc.OutputTensor = &descs.inputDmlTensorDesc;
+
+            descs.splitDmlDesc = { DML_OPERATOR_SPLIT, &descs.splitDesc };
+            descs.mulDmlDesc = { DML_OPERATOR_ELEMENT_WISE_MULTIPLY, &descs.mulDesc };
+            descs.subtractDmlDesc = { DML_OPERATOR_ELEMENT_WISE_SUBTRACT, &descs.subtractDesc };
+            descs.addDmlDesc = { DML_OPERATOR_ELEMENT_WISE_ADD, &descs.addDesc };
+            descs.joinDmlDesc = { DML_OPERATOR_JOIN, &descs.joinDesc };
+        };
+
+        // These are referenced by the graph, so they can't move after being initialized
+        RotaryDescs queryRotaryDescs = makeRotaryDescs(queryNumHeads);
+        RotaryDescs keyRotaryDescs = makeRotaryDescs(kvNumHeads);
+        initializeRotaryDescs(queryRotaryDescs);
+        initializeRotaryDescs(keyRotaryDescs);
+
+        if (doRotary)
+        {
+            const uint32_t gatherCosNodeIndex = addNode(&gatherCosSinDmlDesc);
+            const uint32_t gatherSinNodeIndex = addNode(&gatherCosSinDmlDesc);
+            connect(EdgeSource{cosCacheIndex}, gatherCosNodeIndex, 0);
+            connect(EdgeSource{sinCacheIndex}, gatherSinNodeIndex, 0);
+
+            const EdgeSource positionIdsSource = sequenceLength == 1
+                ? EdgeSource{seqLensIndex}
+                : EdgeSource{std::nullopt, addNode(&positionIdsRangeDmlDesc), 0};
+            connect(positionIdsSource, gatherCosNodeIndex, 1);
+            connect(positionIdsSource, gatherSinNodeIndex, 1);
+
+            const EdgeSource cosSource = {std::nullopt, gatherCosNodeIndex, 0};
+            const EdgeSource sinSource = {std::nullopt, gatherSinNodeIndex, 0};
+
+            std::array<RotaryDescs*, 2> rotaryDescs = {&queryRotaryDescs, &keyRotaryDescs};
+            for (uint32_t i = 0; i < 2; ++i)
+            {
+                RotaryDescs& descs = *rotaryDescs[i];
+
+                const uint32_t splitNodeIndex = addNode(&descs.splitDmlDesc);
+                connect(qkvSources[i], splitNodeIndex, 0);
+                const EdgeSource x1 = {std::nullopt, splitNodeIndex, 0};
+                const EdgeSource x2 = {std::nullopt, splitNodeIndex, 1};
+
+                // x1 * cos - x2 * sin
+                const uint32_t x1CosNodeIndex = addNode(&descs.mulDmlDesc);
+                connect(x1, x1CosNodeIndex, 0);
+                connect(cosSource, x1CosNodeIndex, 1);
+                const uint32_t x2SinNodeIndex = addNode(&descs.mulDmlDesc);
+                connect(x2, x2SinNodeIndex, 0);
+                connect(sinSource, x2SinNodeIndex, 1);
+                const uint32_t subtractNodeIndex = addNode(&descs.subtractDmlDesc);
+                connect(EdgeSource{std::nullopt, x1CosNodeIndex, 0}, subtractNodeIndex, 0);
+                connect(EdgeSource{std::nullopt, x2SinNodeIndex, 0}, subtractNodeIndex, 1);
+
+                // x2 * cos + x1 * sin
+                const uint32_t x2CosNodeIndex = addNode(&descs.mulDmlDesc);
+                connect(x2, x2CosNodeIndex, 0);
+                connect(cosSource, x2CosNodeIndex, 1);
+                const uint32_t x1SinNodeIndex = addNode(&descs.mulDmlDesc);
+                connect(x1, x1SinNodeIndex, 0);
+                connect(sinSource, x1SinNodeIndex, 1);
+                const uint32_t addNodeIndex = addNode(&descs.addDmlDesc);
+                connect(EdgeSource{std::nullopt, x2CosNodeIndex, 0}, addNodeIndex, 0);
+                connect(EdgeSource{std::nullopt, x1SinNodeIndex, 0}, addNodeIndex, 1);
+
+                const uint32_t joinNodeIndex = addNode(&descs.joinDmlDesc);
+                connect(EdgeSource{std::nullopt, subtractNodeIndex, 0}, joinNodeIndex, 0);
+                connect(EdgeSource{std::nullopt, addNodeIndex, 0}, joinNodeIndex, 1);
+
+                qkvSources[i] = EdgeSource{std::nullopt, joinNodeIndex, 0};
+                qkvDescs[i] = i == 0 ? &queryDmlTensorDesc : &keyValueDmlTensorDesc;
+            }
+        }
+
         // GQA is very sensitive to overflows, so we cast all inputs to fp32 and cast the outputs back to fp16. At the DML level,
         // those casts will be eliminated and replaced with half precision computation instead, which mimics the CUDA EP behavior
         // of their flash attention kernel.
-        TensorDesc queryCastTensorDesc(DML_TENSOR_DATA_TYPE_FLOAT32, m_inputTensorDescs[queryIndex].GetSizes());
+        TensorDesc queryCastTensorDesc(DML_TENSOR_DATA_TYPE_FLOAT32, queryShape);
         DML_TENSOR_DESC queryCastDmlTensorDesc = queryCastTensorDesc.GetDmlDesc();
         DML_CAST_OPERATOR_DESC queryCastOpDesc{};
-        queryCastOpDesc.InputTensor = &inputDescs[queryIndex];
+        queryCastOpDesc.InputTensor = qkvDescs[0];
         queryCastOpDesc.OutputTensor = &queryCastDmlTensorDesc;
         DML_OPERATOR_DESC queryCastDmlDesc = { DML_OPERATOR_CAST, &queryCastOpDesc };
 
-        TensorDesc keyCastTensorDesc(DML_TENSOR_DATA_TYPE_FLOAT32, m_inputTensorDescs[keyIndex].GetSizes());
+        TensorDesc keyCastTensorDesc(DML_TENSOR_DATA_TYPE_FLOAT32, keyValueShape);
         DML_TENSOR_DESC keyCastDmlTensorDesc = keyCastTensorDesc.GetDmlDesc();
         DML_CAST_OPERATOR_DESC keyCastOpDesc{};
-        keyCastOpDesc.InputTensor = &inputDescs[keyIndex];
+        keyCastOpDesc.InputTensor = qkvDescs[1];
         keyCastOpDesc.OutputTensor = &keyCastDmlTensorDesc;
         DML_OPERATOR_DESC keyCastDmlDesc = { DML_OPERATOR_CAST, &keyCastOpDesc };
 
-        TensorDesc valueCastTensorDesc(DML_TENSOR_DATA_TYPE_FLOAT32, m_inputTensorDescs[valueIndex].GetSizes());
+        TensorDesc valueCastTensorDesc(DML_TENSOR_DATA_TYPE_FLOAT32, keyValueShape);
         DML_TENSOR_DESC valueCastDmlTensorDesc = valueCastTensorDesc.GetDmlDesc();
         DML_CAST_OPERATOR_DESC valueCastOpDesc{};
-        valueCastOpDesc.InputTensor = &inputDescs[valueIndex];
+        valueCastOpDesc.InputTensor = qkvDescs[2];
         valueCastOpDesc.OutputTensor = &valueCastDmlTensorDesc;
         DML_OPERATOR_DESC valueCastDmlDesc = { DML_OPERATOR_CAST, &valueCastOpDesc };
 
@@ -159,10 +464,9 @@ public:
 
         const bool isFp16 = m_inputTensorDescs[queryIndex].GetDmlDataType() == DML_TENSOR_DATA_TYPE_FLOAT16;
 
-        DML_MULTIHEAD_ATTENTION1_OPERATOR_DESC mhaDesc = {};
-        mhaDesc.QueryTensor = isFp16 ? &queryCastDmlTensorDesc : &inputDescs[queryIndex];
-        mhaDesc.KeyTensor = isFp16 ? &keyCastDmlTensorDesc : &inputDescs[keyIndex];
-        mhaDesc.ValueTensor = isFp16 ? &valueCastDmlTensorDesc : &inputDescs[valueIndex];
+        mhaDesc.QueryTensor = isFp16 ? &queryCastDmlTensorDesc : qkvDescs[0];
+        mhaDesc.KeyTensor = isFp16 ? &keyCastDmlTensorDesc : qkvDescs[1];
+        mhaDesc.ValueTensor = isFp16 ? &valueCastDmlTensorDesc : qkvDescs[2];
         mhaDesc.PastSequenceLengthsTensor = &pastSequenceLengthsDmlTensorDesc;
         mhaDesc.OutputTensor = isFp16 ? &outputCastDmlTensorDesc : &outputDescs[outputIndex];
         mhaDesc.OutputPresentKeyTensor = isFp16 ? &outputPresentKeyCastDmlTensorDesc : &outputDescs[outputPresentKeyIndex];
@@ -171,62 +475,29 @@ public:
         mhaDesc.KeyValueHeadCount = kvNumHeads;
         mhaDesc.Scale = kernelCreationContext.GetOptionalAttribute<float>(AttrName::Scale, gsl::narrow_cast<float>(1.0f / std::sqrt(queryHeadSize)));
         mhaDesc.MaskFilterValue = -10'000.0f;
-        DML_OPERATOR_DESC mhaDmlDesc = { DML_OPERATOR_MULTIHEAD_ATTENTION1, &mhaDesc };
 
         DML_FILL_VALUE_CONSTANT_OPERATOR_DESC zeroScalarDesc = {};
         zeroScalarDesc.OutputTensor = &pastSequenceLengthsDmlTensorDesc;
         zeroScalarDesc.ValueDataType = pastSequenceLengthsTensorDesc.GetDmlDataType();
         DML_OPERATOR_DESC zeroScalarDmlDesc = { DML_OPERATOR_FILL_VALUE_CONSTANT, &zeroScalarDesc };
 
-        std::vector<const DML_OPERATOR_DESC*> opDescs = {
-            &mhaDmlDesc,
-        };
-
-        // Construct the graph
-        std::vector<DML_INPUT_GRAPH_EDGE_DESC> inputEdges;
-        std::vector<DML_INTERMEDIATE_GRAPH_EDGE_DESC> intermediateEdges;
-        std::vector<DML_OUTPUT_GRAPH_EDGE_DESC> outputEdges;
-
         if (isFp16)
         {
-            opDescs.push_back(&queryCastDmlDesc);
-            opDescs.push_back(&keyCastDmlDesc);
-            opDescs.push_back(&valueCastDmlDesc);
-            opDescs.push_back(&outputCastDmlDesc);
-            opDescs.push_back(&outputPresentKeyCastDmlDesc);
-            opDescs.push_back(&outputPresentValueCastDmlDesc);
-
-            // Link the query/key/value inputs to the cast nodes
+            // Link the query/key/value to MHA through the cast nodes
+            const std::array<const DML_OPERATOR_DESC*, 3> inputCastDmlDescs = {&queryCastDmlDesc, &keyCastDmlDesc, &valueCastDmlDesc};
             for (uint32_t i = 0; i < 3; ++i)
             {
-                DML_INPUT_GRAPH_EDGE_DESC inputToMhaEdge = {};
-                inputToMhaEdge.GraphInputIndex = i;
-                inputToMhaEdge.ToNodeIndex = 1 + i;
-                inputToMhaEdge.ToNodeInputIndex = 0;
-                inputEdges.push_back(inputToMhaEdge);
-            }
-
-            // Link the input cast nodes to MHA
-            for (uint32_t i = 0; i < 3; ++i)
-            {
-                DML_INTERMEDIATE_GRAPH_EDGE_DESC castToMhaEdge = {};
-                castToMhaEdge.FromNodeIndex = 1 + i;
-                castToMhaEdge.FromNodeOutputIndex = 0;
-                castToMhaEdge.ToNodeIndex = 0;
-                castToMhaEdge.ToNodeInputIndex = i;
-                intermediateEdges.push_back(castToMhaEdge);
+                const uint32_t castNodeIndex = addNode(inputCastDmlDescs[i]);
+                connect(qkvSources[i], castNodeIndex, 0);
+                connect(EdgeSource{std::nullopt, castNodeIndex, 0}, mhaNodeIndex, i);
             }
         }
         else
         {
-            // Link the query/key/value inputs to MHA
+            // Link the query/key/value to MHA
             for (uint32_t i = 0; i < 3; ++i)
             {
-                DML_INPUT_GRAPH_EDGE_DESC inputToMhaEdge = {};
-                inputToMhaEdge.GraphInputIndex = i;
-                inputToMhaEdge.ToNodeIndex = 0;
-                inputToMhaEdge.ToNodeInputIndex = i;
-                inputEdges.push_back(inputToMhaEdge);
+                connect(qkvSources[i], mhaNodeIndex, i);
             }
         }
 
@@ -243,46 +514,25 @@ public:
         if (sequenceLength == 1)
         {
             // Link the PastSequenceLengths input to MHA
-            DML_INPUT_GRAPH_EDGE_DESC inputToMhaEdge = {};
-            inputToMhaEdge.GraphInputIndex = seqLensIndex;
-            inputToMhaEdge.ToNodeIndex = 0;
-            inputToMhaEdge.ToNodeInputIndex = dmlPastSequenceLengthsIndex;
-            inputEdges.push_back(inputToMhaEdge);
+            connect(EdgeSource{seqLensIndex}, mhaNodeIndex, dmlPastSequenceLengthsIndex);
         }
         else
         {
-            opDescs.push_back(&zeroScalarDmlDesc);
-
             // Link the zero scalar to MHA
-            DML_INTERMEDIATE_GRAPH_EDGE_DESC zeroScalarToMhaEdge = {};
-            zeroScalarToMhaEdge.FromNodeIndex = gsl::narrow_cast<uint32_t>(opDescs.size() - 1);
-            zeroScalarToMhaEdge.FromNodeOutputIndex = 0;
-            zeroScalarToMhaEdge.ToNodeIndex = 0;
-            zeroScalarToMhaEdge.ToNodeInputIndex = dmlPastSequenceLengthsIndex;
-            intermediateEdges.push_back(zeroScalarToMhaEdge);
+            connect(EdgeSource{std::nullopt, addNode(&zeroScalarDmlDesc), 0}, mhaNodeIndex, dmlPastSequenceLengthsIndex);
         }
 
         if (isFp16)
         {
-            // Output cast nodes start at the 4th index (previously we have the mha, query, key and value nodes)
-            const uint32_t outputCastNodeStart = 4;
-
-            // Link MHA's output to the output cast nodes
+            // Link MHA's outputs to the graph's outputs through the cast nodes
+            const std::array<const DML_OPERATOR_DESC*, 3> outputCastDmlDescs = {&outputCastDmlDesc, &outputPresentKeyCastDmlDesc, &outputPresentValueCastDmlDesc};
             for (uint32_t i = 0; i < 3; ++i)
             {
-                DML_INTERMEDIATE_GRAPH_EDGE_DESC mhaToCastEdge = {};
-                mhaToCastEdge.FromNodeIndex = 0;
-                mhaToCastEdge.FromNodeOutputIndex = i;
-                mhaToCastEdge.ToNodeIndex = outputCastNodeStart + i;
-                mhaToCastEdge.ToNodeInputIndex = 0;
-                intermediateEdges.push_back(mhaToCastEdge);
-            }
+                const uint32_t castNodeIndex = addNode(outputCastDmlDescs[i]);
+                connect(EdgeSource{std::nullopt, mhaNodeIndex, i}, castNodeIndex, 0);
 
-            // Link the output cast nodes to the graph's outputs
-            for (uint32_t i = 0; i < 3; ++i)
-            {
                 DML_OUTPUT_GRAPH_EDGE_DESC castToOutputEdge = {};
-                castToOutputEdge.FromNodeIndex = outputCastNodeStart + i;
+                castToOutputEdge.FromNodeIndex = castNodeIndex;
                 castToOutputEdge.FromNodeOutputIndex = 0;
                 castToOutputEdge.GraphOutputIndex = i;
                 outputEdges.push_back(castToOutputEdge);
@@ -294,7 +544,7 @@ public:
             for (uint32_t i = 0; i < 3; ++i)
             {
                 DML_OUTPUT_GRAPH_EDGE_DESC mhaToOutputEdge = {};
-                mhaToOutputEdge.FromNodeIndex = 0;
+                mhaToOutputEdge.FromNodeIndex = mhaNodeIndex;
                 mhaToOutputEdge.FromNodeOutputIndex = i;
                 mhaToOutputEdge.GraphOutputIndex = i;
                 outputEdges.push_back(mhaToOutputEdge);
@@ -314,5 +564,56 @@ public:
     }
 };
 
+void CALLBACK QueryGroupQueryAttention(IMLOperatorSupportQueryContextPrivate* context, /*out*/ bool* isSupported)
+{
+    *isSupported = false;
+
+    // Key and value must either both be present or both be packed in the query
+    if (context->IsInputValid(1) != context->IsInputValid(2))
+    {
+        return;
+    }
+
+    // `block_table` (paged KV cache) is not supported yet
+    if (context->IsInputValid(9))
+    {
+        return;
+    }
+
+    // `k_scale` and `v_scale` (quantized KV cache) are not supported yet
+    if (context->IsInputValid(10) || context->IsInputValid(11))
+    {
+        return;
+    }
+
+    MLOperatorAttributes attributes(context);
+
+    // `do_rotary == 1` requires the cos and sin caches
+    if (attributes.GetOptionalAttribute<int32_t>(AttrName::DoRotary, 0) != 0 && (!context->IsInputValid(7) || !context->IsInputValid(8)))
+    {
+        return;
+    }
+
+    // `softcap` is not supported yet
+    if (attributes.GetOptionalAttribute<float>(AttrName::Softcap, 0.0f) != 0.0f)
+    {
+        return;
+    }
+
+    // `local_window_size` is not supported yet
+    if (attributes.GetOptionalAttribute<int32_t>(AttrName::LocalWindowSize, -1) != -1)
+    {
+        return;
+    }
+
+    // `smooth_softmax == 1` is not supported yet
+    if (attributes.GetOptionalAttribute<int32_t>(AttrName::SmoothSoftmax, -1) > 0)
+    {
+        return;
+    }
+
+    *isSupported = true;
+}
+
 DML_OP_DEFINE_CREATION_FUNCTION(GroupQueryAttention, DmlOperatorGroupQueryAttention);
 } // namespace Dml
@@ -52,6 +52,9 @@ namespace Dml
             size_t capacityInBytes; // The total size of the upload heap, in bytes
             ComPtr<ID3D12Resource> resource;
 
+            // Upload heaps stay mapped for the lifetime of the chunk, so an upload is a plain memcpy
+            std::byte* mappedData;
+
             // Allocations are sorted by ascending fence value - that is, least to most recently allocated
             std::list<Allocation> allocations;
         };
@@ -30,6 +30,15 @@ namespace Dml
     {
     }
 
+    ReadbackHeap::~ReadbackHeap()
+    {
+        // The buffers may still be written to by the GPU until the pending copies complete
+        for (auto& readback : m_pendingReadbacks)
+        {
+            readback.doneEvent.WaitForSignal(m_executionContext->CpuSyncSpinningEnabled());
+        }
+    }
+
     static size_t ComputeNewCapacity(size_t existingCapacity, size_t desiredCapacity)
     {
         size_t newCapacity = existingCapacity;
@@ -48,25 +57,120 @@ namespace Dml
         return newCapacity;
     }
 
-    void ReadbackHeap::EnsureReadbackHeap(size_t size)
+    size_t ReadbackHeap::AcquireBuffer(size_t size)
     {
-        if (!m_readbackHeap)
+        // Take the smallest unused buffer that is large enough, and remember the largest unused one that isn't so
+        // that it can be replaced rather than growing the pool
+        std::optional<size_t> bestFit;
+        std::optional<size_t> largestTooSmall;
+        for (size_t i = 0; i < m_buffers.size(); ++i)
         {
-            // Initialize the readback heap for the first time
-            assert(m_capacity == 0);
-            m_capacity = ComputeNewCapacity(c_initialCapacity, size);
-            m_readbackHeap = CreateReadbackHeap(m_device.Get(), m_capacity);
+            const Buffer& buffer = m_buffers[i];
+            if (buffer.inUse)
+            {
+                continue;
+            }
+
+            if (buffer.capacityInBytes >= size)
+            {
+                if (!bestFit || buffer.capacityInBytes < m_buffers[*bestFit].capacityInBytes)
+                {
+                    bestFit = i;
+                }
+            }
+            else if (!largestTooSmall || buffer.capacityInBytes > m_buffers[*largestTooSmall].capacityInBytes)
+            {
+                largestTooSmall = i;
+            }
         }
-        else if (m_capacity < size)
+
+        if (!bestFit)
         {
-            // Ensure there's sufficient capacity
-            m_capacity = ComputeNewCapacity(m_capacity, size);
+            const size_t existingCapacity = largestTooSmall ? m_buffers[*largestTooSmall].capacityInBytes : c_initialCapacity;
+
+            Buffer buffer = {};
+            buffer.capacityInBytes = ComputeNewCapacity(existingCapacity, size);
+            buffer.resource = CreateReadbackHeap(m_device.Get(), buffer.capacityInBytes);
+
+            // Readback heaps can stay mapped while the GPU writes to them, so each buffer is only mapped once
+            void* mappedData = nullptr;
+            ORT_THROW_IF_FAILED(buffer.resource->Map(0, nullptr, &mappedData));
+            buffer.mappedData = static_cast<std::byte*>(mappedData);
+
+            if (largestTooSmall)
+            {
+                bestFit = largestTooSmall;
+                m_buffers[*bestFit] = std::move(buffer);
+            }
+            else
+            {
+                bestFit = m_buffers.size();
+                m_buffers.push_back(std::move(buffer));
+            }
+        }
+
+        assert(m_buffers[*bestFit].resource->GetDesc().Width >= size);
+        m_buffers[*bestFit].inUse = true;
+        return *bestFit;
+    }
+
+    GpuEvent ReadbackHeap::BeginReadback(
+        PendingReadback& readback,
+        gsl::span<ID3D12Resource* const> src,
+        gsl::span<const uint64_t> srcOffsets,
+        D3D12_RESOURCE_STATES srcState)
+    {
+        size_t totalSize = 0;
+        for (auto size : readback.dstSizes)
+        {
+            totalSize += size;
+        }
+
+        readback.bufferIndex = AcquireBuffer(totalSize);
+        ID3D12Resource* readbackHeap = m_buffers[*readback.bufferIndex].resource.Get();
+
+        // Copy from the source resources into the readback buffer
+        uint64_t offset = 0;
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            m_executionContext->CopyBufferRegion(
+                readbackHeap,
+                offset,
+                D3D12_RESOURCE_STATE_COPY_DEST,
+                src[i],
+                srcOffsets[i],
+                srcState,
+                readback.dstSizes[i]);
+
+            offset += readback.dstSizes[i];
+        }
+
+        // The copies are the last work recorded, so this event only waits for them and the work that preceded them
+        readback.doneEvent = m_executionContext->GetCurrentCompletionEvent();
+        m_executionContext->Flush();
+        return readback.doneEvent;
+    }
+
+    void ReadbackHeap::CompleteReadback(PendingReadback& readback)
+    {
+        assert(readback.doneEvent.IsSignaled());
 
-            m_readbackHeap = nullptr;
-            m_readbackHeap = CreateReadbackHeap(m_device.Get(), m_capacity);
+        if (readback.bufferIndex)
+        {
+            Buffer& buffer = m_buffers[*readback.bufferIndex];
+            size_t offset = 0;
+            for (size_t i = 0; i < readback.dst.size(); ++i)
+            {
+                memcpy(readback.dst[i], buffer.mappedData + offset, readback.dstSizes[i]);
+                offset += readback.dstSizes[i];
+            }
+            buffer.inUse = false;
         }
 
-        assert(m_readbackHeap->GetDesc().Width >= size);
+        if (readback.onComplete)
+        {
+            readback.onComplete();
+        }
     }
 
     void ReadbackHeap::ReadbackFromGpu(
@@ -77,28 +181,17 @@ namespace Dml
     {
         assert(!dst.empty());
 
-        EnsureReadbackHeap(dst.size());
+        PendingReadback readback = {};
+        readback.dst = { dst.data() };
+        readback.dstSizes = { gsl::narrow<uint32_t>(dst.size()) };
 
-        // Copy from the source resource into the readback heap
-        m_executionContext->CopyBufferRegion(
-            m_readbackHeap.Get(),
-            0,
-            D3D12_RESOURCE_STATE_COPY_DEST,
-            src,
-            srcOffset,
-            srcState,
-            dst.size());
-
-        // Wait for completion and map the result
-        m_executionContext->Flush();
-        m_executionContext->GetCurrentCompletionEvent().WaitForSignal(m_executionContext->CpuSyncSpinningEnabled());
+        ID3D12Resource* const srcs[] = { src };
+        const uint64_t srcOffsets[] = { srcOffset };
+        BeginReadback(readback, srcs, srcOffsets, srcState).WaitForSignal(m_executionContext->CpuSyncSpinningEnabled());
         m_executionContext->ReleaseCompletedReferences();
 
-        // Map the readback heap and copy it into the destination
-        void* readbackHeapData = nullptr;
-        ORT_THROW_IF_FAILED(m_readbackHeap->Map(0, nullptr, &readbackHeapData));
-        memcpy(dst.data(), readbackHeapData, dst.size());
-        m_readbackHeap->Unmap(0, nullptr);
+        CompleteReadback(readback);
+        ProcessCompletedReadbacks();
     }
 
     void ReadbackHeap::ReadbackFromGpu(
@@ -115,47 +208,68 @@ namespace Dml
             return;
         }
 
-        uint32_t totalSize = 0;
-        for (auto size : dstSizes)
-        {
-            totalSize += size;
-        }
+        PendingReadback readback = {};
+        readback.dst.assign(dst.begin(), dst.end());
+        readback.dstSizes.assign(dstSizes.begin(), dstSizes.end());
 
-        EnsureReadbackHeap(totalSize);
+        const std::vector<uint64_t> srcOffsets(src.size(), 0);
+        BeginReadback(readback, src, srcOffsets, srcState).WaitForSignal(m_executionContext->CpuSyncSpinningEnabled());
+        m_executionContext->ReleaseCompletedReferences();
 
-        // Copy from the source resource into the readback heap
-        uint32_t offset = 0;
-        for (uint32_t i = 0; i < dst.size(); ++i)
-        {
-            m_executionContext->CopyBufferRegion(
-                m_readbackHeap.Get(),
-                offset,
-                D3D12_RESOURCE_STATE_COPY_DEST,
-                src[i],
-                0,
-                srcState,
-                dstSizes[i]);
+        CompleteReadback(readback);
+        ProcessCompletedReadbacks();
+    }
 
-            offset += dstSizes[i];
-        }
+    GpuEvent ReadbackHeap::BeginReadbackFromGpu(
+        gsl::span<void* const> dst,
+        gsl::span<const uint32_t> dstSizes,
+        gsl::span<ID3D12Resource* const> src,
+        D3D12_RESOURCE_STATES srcState,
+        std::function<void()> onComplete)
+    {
+        assert(dst.size() == src.size());
+        assert(dstSizes.size() == src.size());
 
-        // Wait for completion and map the result
-        m_executionContext->Flush();
-        m_executionContext->GetCurrentCompletionEvent().WaitForSignal(m_executionContext->CpuSyncSpinningEnabled());
-        m_executionContext->ReleaseCompletedReferences();
+        // Free the buffers of the readbacks that are already done before picking one
+        ProcessCompletedReadbacks();
+
+        PendingReadback readback = {};
+        readback.dst.assign(dst.begin(), dst.end());
+        readback.dstSizes.assign(dstSizes.begin(), dstSizes.end());
+        readback.onComplete = std::move(onComplete);
+
+        if (dst.empty())
+        {
+            // Nothing to copy, but the callback still runs in order with the other readbacks
+            readback.doneEvent = m_executionContext->GetCurrentCompletionEvent();
+        }
+        else
+        {
+            const std::vector<uint64_t> srcOffsets(src.size(), 0);
+            BeginReadback(readback, src, srcOffsets, srcState);
+        }
 
-        // Map the readback heap and copy it into the destination
-        void* readbackHeapData = nullptr;
-        ORT_THROW_IF_FAILED(m_readbackHeap->Map(0, nullptr, &readbackHeapData));
+        m_pendingReadbacks.push_back(std::move(readback));
+        return m_pendingReadbacks.back().doneEvent;
+    }
 
-        // Copy from the source resource into the readback heap
-        offset = 0;
-        for (uint32_t i = 0; i < dst.size(); ++i)
+    void ReadbackHeap::ProcessCompletedReadbacks()
+    {
+        while (!m_pendingReadbacks.empty() && m_pendingReadbacks.front().doneEvent.IsSignaled())
         {
-            memcpy(dst[i], static_cast<uint8_t*>(readbackHeapData) + offset, dstSizes[i]);
-            offset += dstSizes[i];
+            // Remove the readback before completing it, so that its callback can start new readbacks
+            PendingReadback readback = std::move(m_pendingReadbacks.front());
+            m_pendingReadbacks.pop_front();
+            CompleteReadback(readback);
         }
+    }
 
-        m_readbackHeap->Unmap(0, nullptr);
+    void ReadbackHeap::WaitForPendingReadbacks()
+    {
+        while (!m_pendingReadbacks.empty())
+        {
+            m_pendingReadbacks.back().doneEvent.WaitForSignal(m_executionContext->CpuSyncSpinningEnabled());
+            ProcessCompletedReadbacks();
+        }
     }
 } // namespace Dml
@@ -3,16 +3,22 @@
 
 #pragma once
 
+#include <functional>
+
+#include "GpuEvent.h"
+
 namespace Dml
 {
     class ExecutionContext;
 
-    // Because we never perform more than one readback at a time, we don't need anything fancy for managing the
-    // readback heap - just maintain a single resource and reallocate it if it's not big enough.
+    // Manages a pool of persistently mapped readback buffers for copying GPU resources into CPU memory. Each readback
+    // takes a buffer that isn't used by another in-flight readback, so readbacks can be started without waiting for
+    // the previous ones, and the buffers are reused once the GPU has signaled the fence of their copy.
     class ReadbackHeap
     {
     public:
         ReadbackHeap(ID3D12Device* device, ExecutionContext* executionContext);
+        ~ReadbackHeap();
 
         // Copies data from the specified GPU resource into CPU memory pointed-to by the span. This method will block
         // until the copy is complete.
@@ -29,16 +35,62 @@ namespace Dml
             gsl::span<ID3D12Resource*> src,
             D3D12_RESOURCE_STATES srcState);
 
-    private:
-        void EnsureReadbackHeap(size_t size);
+        // Begins copying the source resources into the CPU memory pointed-to by dst without blocking, and returns a
+        // GpuEvent which will become signaled when the GPU copy is complete. The data is only written to dst, and
+        // onComplete invoked, by a later call to ProcessCompletedReadbacks or WaitForPendingReadbacks, so dst must
+        // remain valid until then.
+        GpuEvent BeginReadbackFromGpu(
+            gsl::span<void* const> dst,
+            gsl::span<const uint32_t> dstSizes,
+            gsl::span<ID3D12Resource* const> src,
+            D3D12_RESOURCE_STATES srcState,
+            std::function<void()> onComplete);
+
+        // Copies out the data of the readbacks whose GPU copies are complete and invokes their callbacks, in the
+        // order the readbacks were started.
+        void ProcessCompletedReadbacks();
 
+        // Blocks until all the pending readbacks are complete and processes them.
+        void WaitForPendingReadbacks();
+
+    private:
         static constexpr size_t c_initialCapacity = 1024 * 1024; // 1MB
 
+        struct Buffer
+        {
+            ComPtr<ID3D12Resource> resource;
+            std::byte* mappedData;
+            size_t capacityInBytes;
+            bool inUse;
+        };
+
+        struct PendingReadback
+        {
+            std::optional<size_t> bufferIndex; // Empty if there is nothing to copy
+            GpuEvent doneEvent;
+            std::vector<void*> dst;
+            std::vector<uint32_t> dstSizes;
+            std::function<void()> onComplete;
+        };
+
+        // Returns the index of an unused buffer of at least the given size, creating one if needed
+        size_t AcquireBuffer(size_t size);
+
+        GpuEvent BeginReadback(
+            PendingReadback& readback,
+            gsl::span<ID3D12Resource* const> src,
+            gsl::span<const uint64_t> srcOffsets,
+            D3D12_RESOURCE_STATES srcState);
+
+        void CompleteReadback(PendingReadback& readback);
+
         ComPtr<ID3D12Device> m_device;
         ComPtr<ExecutionContext> m_executionContext;
 
-        ComPtr<ID3D12Resource> m_readbackHeap;
-        size_t m_capacity = 0;
+        std::vector<Buffer> m_buffers;
+
+        // Sorted by ascending fence value, since readbacks are started on a single command queue
+        std::deque<PendingReadback> m_pendingReadbacks;
     };
 
 } // namespace Dml
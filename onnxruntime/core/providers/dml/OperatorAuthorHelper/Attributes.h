@@ -120,6 +120,10 @@ namespace AttrName
     static constexpr const char* FusedRatio = "fused_ratio";
     static constexpr const char* MaskFilterValue = "mask_filter_value";
     static constexpr const char* DoRotary = "do_rotary";
+    static constexpr const char* RotaryInterleaved = "rotary_interleaved";
+    static constexpr const char* Softcap = "softcap";
+    static constexpr const char* LocalWindowSize = "local_window_size";
+    static constexpr const char* SmoothSoftmax = "smooth_softmax";
     static constexpr const char* Activation = "activation";
     static constexpr const char* Groups = "groups";
 
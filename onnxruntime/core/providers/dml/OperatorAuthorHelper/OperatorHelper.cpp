@@ -2775,12 +2775,21 @@ namespace OperatorHelper
         ML_CHECK_VALID_ARGUMENT(queryShape.size() == 3);
         const uint32_t batchSize = queryShape[0];
         const uint32_t sequenceLength = queryShape[1];
-        const uint32_t hiddenSize = queryShape[2];
+        uint32_t hiddenSize = queryShape[2];
 
-        const auto keyShape = shapeInfo.GetInputTensorShape(1);
-        ML_CHECK_VALID_ARGUMENT(keyShape.size() == 3);
-        const uint32_t kvHiddenSize = keyShape[2];
-        const uint32_t kvHeadSize = kvHiddenSize / m_kvNumHeads;
+        uint32_t kvHeadSize = 0;
+        if (shapeInfo.IsInputValid(1))
+        {
+            const auto keyShape = shapeInfo.GetInputTensorShape(1);
+            ML_CHECK_VALID_ARGUMENT(keyShape.size() == 3);
+            kvHeadSize = keyShape[2] / m_kvNumHeads;
+        }
+        else
+        {
+            // The query is the packed query, key and value
+            kvHeadSize = queryShape[2] / (m_numHeads + 2 * m_kvNumHeads);
+            hiddenSize = m_numHeads * kvHeadSize;
+        }
 
         uint32_t pastSequenceLength = 0;
 
@@ -2805,6 +2814,7 @@ namespace OperatorHelper
 
     void GroupQueryAttentionHelper::Initialize(const IKernelInformationAdapter& kernelInformation)
     {
+        m_numHeads = gsl::narrow_cast<uint32_t>(kernelInformation.GetAttributes().GetAttribute<int64_t>(AttrName::NumHeads));
         m_kvNumHeads = gsl::narrow_cast<uint32_t>(kernelInformation.GetAttributes().GetAttribute<int64_t>(AttrName::KvNumHeads));
 
         std::vector<int32_t> totalSequenceLength;
@@ -1554,6 +1554,7 @@ protected:
 private:
     void Initialize(const IKernelInformationAdapter& kernelInformation);
 
+    uint32_t m_numHeads;
     uint32_t m_kvNumHeads;
     uint32_t m_totalSequenceLength;
 };
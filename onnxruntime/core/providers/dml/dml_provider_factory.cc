@@ -57,6 +57,7 @@ struct DMLProviderFactory : IExecutionProviderFactory {
     graph_capture_enabled_ = ConfigValueIsTrue(config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableGraphCapture, "0"));
     cpu_sync_spinning_enabled_ = ConfigValueIsTrue(config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableCpuSyncSpinning, "0"));
     disable_memory_arena_ = ConfigValueIsTrue(config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisableMemoryArena, "0"));
+    heap_sub_allocation_enabled_ = ConfigValueIsTrue(config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableHeapSubAllocation, "0"));
   }
 
   ~DMLProviderFactory() override {}
@@ -72,6 +73,7 @@ struct DMLProviderFactory : IExecutionProviderFactory {
   bool graph_capture_enabled_ = false;
   bool cpu_sync_spinning_enabled_ = false;
   bool disable_memory_arena_ = false;
+  bool heap_sub_allocation_enabled_ = false;
   bool python_api_ = false;
 };
 
@@ -93,7 +95,7 @@ std::unique_ptr<IExecutionProvider> DMLProviderFactory::CreateProvider() {
     execution_context = wil::MakeOrThrow<Dml::ExecutionContext>(d3d12_device.Get(), dml_device_.Get(), cmd_queue_.Get(), cpu_sync_spinning_enabled_);
   }
 
-  auto provider = Dml::CreateExecutionProvider(dml_device_.Get(), execution_context.Get(), metacommands_enabled_, graph_capture_enabled_, cpu_sync_spinning_enabled_, disable_memory_arena_);
+  auto provider = Dml::CreateExecutionProvider(dml_device_.Get(), execution_context.Get(), metacommands_enabled_, graph_capture_enabled_, cpu_sync_spinning_enabled_, disable_memory_arena_, heap_sub_allocation_enabled_);
   return provider;
 }
 
@@ -25,3 +25,30 @@ static const char* const kOrtSessionOptionsConfigEnableGraphSerialization = "ep.
 static const char* const kOrtSessionOptionsConfigEnableGraphCapture = "ep.dml.enable_graph_capture";
 static const char* const kOrtSessionOptionsConfigEnableCpuSyncSpinning = "ep.dml.enable_cpu_sync_spinning";
 static const char* const kOrtSessionOptionsConfigDisableMemoryArena = "ep.dml.disable_memory_arena";
+
+// Influences how the DirectML EP allocates the D3D12 buffers of tensors.
+// "0": every buffer is a committed resource, and transient buffers are rounded up to power of two sizes to be pooled.
+// "1": buffers are placed resources sub-allocated from large heaps, rounded up to 64KB only, and the memory of
+//      released buffers is reused for new ones of any size. This lowers the VRAM usage, e.g. on integrated GPUs.
+// The default value is "0"
+static const char* const kOrtSessionOptionsConfigEnableHeapSubAllocation = "ep.dml.enable_heap_sub_allocation";
+
+// Directory in which the DirectML EP keeps the graph descriptions of the fused partitions of the models it loads, keyed
+// by the adapter LUID, the driver version and the content of the partition. Sessions that find the description of a
+// partition there skip building it, which shortens the startup of applications that load the same models repeatedly.
+// The compilation of the graphs still happens in every session, as DirectML can't serialize compiled operators.
+// The default value is "", which disables the cache.
+static const char* const kOrtSessionOptionsConfigDmlGraphCacheDirectory = "ep.dml.graph_cache_directory";
+
+// Number of graphs compiled for distinct input shapes that each fused partition keeps when graph capture is enabled,
+// in which case the partitions are compiled at runtime for the shapes of their inputs. Once the capacity is reached,
+// the least recently used graph is released to compile a new one.
+// The default value is "1", i.e. a partition is recompiled whenever the shapes of its inputs change.
+static const char* const kOrtSessionOptionsConfigDmlRuntimeGraphCacheCapacity = "ep.dml.runtime_graph_cache_capacity";
+
+// Shapes of the model inputs to compile the partitions for at the end of the session initialization, by running the
+// model once for each with zero filled inputs. The shape buckets are separated by ';', and each is a ',' separated
+// list of "input_name:dim0xdim1x..." entries. Inputs that are missing from a bucket use their static shape.
+// E.g. "image:1x3x224x224;image:1x3x384x384". Useful together with kOrtSessionOptionsConfigDmlRuntimeGraphCacheCapacity.
+// The default value is "", which precompiles nothing.
+static const char* const kOrtSessionOptionsConfigDmlRuntimeGraphPrecompileShapes = "ep.dml.runtime_graph_precompile_shapes";
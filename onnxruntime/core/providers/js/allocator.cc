@@ -9,22 +9,86 @@
 namespace onnxruntime {
 namespace js {
 
+WebGpuAllocator::~WebGpuAllocator() {
+  ReleasePooledBuffers();
+}
+
+size_t WebGpuAllocator::GetBucketSize(size_t size) {
+  constexpr size_t kSmallBufferLimit = 64 * 1024;
+  if (size <= kSmallBufferLimit) {
+    return (size + 15) & ~size_t{15};
+  }
+
+  size_t power_of_two = kSmallBufferLimit;
+  while (power_of_two * 2 < size) {
+    power_of_two *= 2;
+  }
+
+  const size_t step = power_of_two / 8;
+  return (size + step - 1) / step * step;
+}
+
 void* WebGpuAllocator::Alloc(size_t size) {
   if (size == 0) {
     return nullptr;
   }
 
+  if (max_pool_size_ != 0) {
+    size = GetBucketSize(size);
+
+    auto it = free_buffers_.find(size);
+    if (it != free_buffers_.end() && !it->second.empty()) {
+      void* p = it->second.back();
+      it->second.pop_back();
+      pooled_size_ -= size;
+      stats_.num_allocs++;
+      stats_.bytes_in_use += size;
+      return p;
+    }
+  }
+
   void* p = EM_ASM_PTR({ return Module.jsepAlloc($0); }, size);
   stats_.num_allocs++;
   stats_.bytes_in_use += size;
+  if (max_pool_size_ != 0) {
+    buffer_sizes_[p] = size;
+  }
   return p;
 }
 
 void WebGpuAllocator::Free(void* p) {
-  if (p != nullptr) {
-    size_t size = (size_t)(void*)EM_ASM_PTR({ return Module.jsepFree($0); }, p);
+  if (p == nullptr) {
+    return;
+  }
+
+  auto it = buffer_sizes_.find(p);
+  if (it != buffer_sizes_.end()) {
+    const size_t size = it->second;
     stats_.bytes_in_use -= size;
+    if (pooled_size_ + size <= max_pool_size_) {
+      free_buffers_[size].push_back(p);
+      pooled_size_ += size;
+      return;
+    }
+
+    buffer_sizes_.erase(it);
+    EM_ASM({ Module.jsepFree($0); }, p);
+    return;
+  }
+
+  size_t size = (size_t)(void*)EM_ASM_PTR({ return Module.jsepFree($0); }, p);
+  stats_.bytes_in_use -= size;
+}
+
+void WebGpuAllocator::ReleasePooledBuffers() {
+  for (auto& [size, buffers] : free_buffers_) {
+    for (void* p : buffers) {
+      buffer_sizes_.erase(p);
+      EM_ASM({ Module.jsepFree($0); }, p);
+    }
   }
+  free_buffers_.clear();
+  pooled_size_ = 0;
 }
 
 void WebGpuAllocator::GetStats(AllocatorStats* stats) {
@@ -3,27 +3,47 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "core/framework/allocator.h"
 #include "core/framework/ortdevice.h"
 
 namespace onnxruntime {
 namespace js {
 
+// Allocates GPU buffers through the JSEP WebGPU backend. When max_pool_size is not zero, freed buffers are kept in
+// free lists bucketed by size, up to max_pool_size bytes in total, and handed out again to later allocations of the
+// same bucket. This avoids creating and destroying a GPUBuffer for every intermediate tensor of every run.
 class WebGpuAllocator : public IAllocator {
  public:
-  WebGpuAllocator()
+  explicit WebGpuAllocator(size_t max_pool_size = 0)
       : IAllocator(
             OrtMemoryInfo(WEBGPU_BUFFER, OrtAllocatorType::OrtDeviceAllocator,
                           OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, 0),
-                          0, OrtMemTypeDefault)) {
+                          0, OrtMemTypeDefault)),
+        max_pool_size_(max_pool_size) {
   }
 
+  ~WebGpuAllocator() override;
+
   virtual void* Alloc(size_t size) override;
   virtual void Free(void* p) override;
   void GetStats(AllocatorStats* stats) override;
 
+  // Returns the size of the buckets that an allocation of the given size is served from. Sizes are rounded up to
+  // 16 bytes, and sizes above 64KB to one of 8 steps between consecutive powers of 2, which bounds the waste to 1/8.
+  static size_t GetBucketSize(size_t size);
+
  private:
+  void ReleasePooledBuffers();
+
   AllocatorStats stats_;
+
+  const size_t max_pool_size_;
+  size_t pooled_size_ = 0;
+  std::unordered_map<size_t, std::vector<void*>> free_buffers_;  // bucket size -> free buffers
+  std::unordered_map<void*, size_t> buffer_sizes_;              // buffer -> bucket size, for pooled allocations
 };
 
 }  // namespace js
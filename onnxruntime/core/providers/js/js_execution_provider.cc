@@ -729,7 +729,8 @@ using namespace js;
 
 JsExecutionProvider::JsExecutionProvider(const JsExecutionProviderInfo& info, const SessionOptions* session_options)
     : IExecutionProvider{kJsExecutionProvider, OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, 0)},
-      preferred_data_layout_{info.data_layout} {
+      preferred_data_layout_{info.data_layout},
+      buffer_pool_max_size_{info.buffer_pool_max_size} {
   if (session_options) {
     enable_graph_capture_ = session_options->config_options.GetConfigOrDefault("enableGraphCapture", "false") == "true";
     LOGS_DEFAULT(VERBOSE) << "Graph capture enable: " << enable_graph_capture_;
@@ -738,7 +739,7 @@ JsExecutionProvider::JsExecutionProvider(const JsExecutionProviderInfo& info, co
 
 std::vector<AllocatorPtr> JsExecutionProvider::CreatePreferredAllocators() {
   AllocatorCreationInfo customAllocatorCreationInfo([&](int) {
-    return std::make_unique<js::WebGpuAllocator>();
+    return std::make_unique<js::WebGpuAllocator>(buffer_pool_max_size_);
   },
                                                     0, false);
   return std::vector<AllocatorPtr>{CreateAllocator(customAllocatorCreationInfo)};
@@ -31,10 +31,18 @@ struct JsExecutionProviderInfo {
         data_layout = DataLayout::NHWC;
       }
     }
+
+    it = po.find("buffer_pool_max_size");
+    if (it != po.end()) {
+      buffer_pool_max_size = static_cast<size_t>(std::stoull(it->second));
+    }
   }
 
   // JSEP default preferred layout is NHWC
   DataLayout data_layout = DataLayout::NHWC;
+
+  // The maximum number of bytes of freed GPU buffers that the allocator keeps for reuse. 0 disables the pool.
+  size_t buffer_pool_max_size = 0;
 };
 
 class JsExecutionProvider : public IExecutionProvider {
@@ -71,6 +79,7 @@ class JsExecutionProvider : public IExecutionProvider {
   bool IsGraphCaptureAllowed() const;
   void IncrementRegularRunCountBeforeGraphCapture();
   DataLayout preferred_data_layout_;
+  size_t buffer_pool_max_size_;
   bool enable_graph_capture_ = false;
   bool is_graph_captured_ = false;
   int regular_run_count_before_graph_capture_ = 0;
@@ -2,7 +2,11 @@
 // Licensed under the MIT License
 #include <fstream>
 #include <algorithm>
+#include <cctype>
+#include <functional>
 #include <iterator>
+#include <map>
+#include <sstream>
 #include <unordered_map>
 #include <set>
 #include <filesystem>
@@ -188,6 +192,33 @@ MIGraphXExecutionProvider::MIGraphXExecutionProvider(const MIGraphXExecutionProv
     exhaustive_tune_ = (std::stoi(exhaustive_tune_env) == 0 ? false : true);
   }
 
+  // Cache of the programs compiled for each input shapes
+  program_cache_size_ = info.program_cache_size;
+  const std::string program_cache_size_env = onnxruntime::GetEnvironmentVar(migraphx_env_vars::kProgramCacheSize);
+  if (!program_cache_size_env.empty()) {
+    program_cache_size_ = static_cast<std::size_t>(std::stoul(program_cache_size_env));
+  }
+
+  model_cache_path_ = info.model_cache_dir;
+  const std::string model_cache_path_env = onnxruntime::GetEnvironmentVar(migraphx_env_vars::kModelCachePath);
+  if (!model_cache_path_env.empty()) {
+    model_cache_path_ = model_cache_path_env;
+  }
+
+  precompile_shapes_ = info.precompile_shapes;
+  const std::string precompile_shapes_env = onnxruntime::GetEnvironmentVar(migraphx_env_vars::kPrecompileShapes);
+  if (!precompile_shapes_env.empty()) {
+    precompile_shapes_ = precompile_shapes_env;
+  }
+
+  if (!model_cache_path_.empty()) {
+    hipDeviceProp_t device_prop;
+    HIP_CALL_THROW(hipGetDeviceProperties(&device_prop, info_.device_id));
+    gpu_arch_ = device_prop.gcnArchName;
+    std::replace(gpu_arch_.begin(), gpu_arch_.end(), ':', '_');
+    std::filesystem::create_directories(model_cache_path_);
+  }
+
   metadef_id_generator_ = ModelMetadefIdGenerator::Create();
 
   LOGS_DEFAULT(VERBOSE) << "[MIGraphX EP] MIGraphX provider options: "
@@ -203,7 +234,10 @@ MIGraphXExecutionProvider::MIGraphXExecutionProvider(const MIGraphXExecutionProv
                         << ", migraphx_save_compiled_model: " << save_compiled_model_
                         << ", migraphx_save_compiled_model_path: " << save_compiled_path_
                         << ", migraphx_load_compiled_model: " << load_compiled_model_
-                        << ", migraphx_load_compiled_model_path: " << load_compiled_path_;
+                        << ", migraphx_load_compiled_model_path: " << load_compiled_path_
+                        << ", migraphx_program_cache_size: " << program_cache_size_
+                        << ", migraphx_model_cache_path: " << model_cache_path_
+                        << ", migraphx_precompile_shapes: " << precompile_shapes_;
 }
 
 MIGraphXExecutionProvider::~MIGraphXExecutionProvider() {
@@ -1120,6 +1154,120 @@ void save_compiled_model(migraphx::program& prog, bool save_enable, std::string
   }
 }
 
+// The key of the programs of a fused node, from the shapes of its inputs in the order of their names,
+// e.g. "attention_mask:1x128;input_ids:1x128;".
+std::string GetInputShapesKey(const std::map<std::string, std::vector<std::size_t>>& input_shapes) {
+  std::ostringstream key;
+  for (const auto& [name, lens] : input_shapes) {
+    key << name << ':';
+    for (std::size_t i = 0; i < lens.size(); ++i) {
+      key << (i == 0 ? "" : "x") << lens[i];
+    }
+    key << ';';
+  }
+  return key.str();
+}
+
+// The key of a compiled program, from the shapes of its parameters that are inputs of the fused node.
+std::string GetProgramShapesKey(migraphx::program& prog,
+                                const std::unordered_map<std::string, std::size_t>& input_name_index) {
+  std::map<std::string, std::vector<std::size_t>> input_shapes;
+  auto param_shapes = prog.get_parameter_shapes();
+  for (auto&& name : param_shapes.names()) {
+    if (input_name_index.count(name) > 0) {
+      auto mgx_s = param_shapes[name];
+      auto mgx_lens = mgx_s.lengths();
+      auto mgx_strides = mgx_s.strides();
+      // scalars are parameters of one element with a zero stride
+      if (mgx_lens.size() == 1 and mgx_lens[0] == 1 and mgx_strides.size() == 1 and mgx_strides[0] == 0) {
+        mgx_lens.clear();
+      }
+      input_shapes[name] = mgx_lens;
+    }
+  }
+  return GetInputShapesKey(input_shapes);
+}
+
+// The file of the program compiled for `shapes_key` in the model cache directory.
+std::string GetModelCacheFile(const std::string& model_cache_prefix, const std::string& shapes_key) {
+  return model_cache_prefix + "_" + std::to_string(std::hash<std::string>{}(shapes_key)) + ".mxr";
+}
+
+// Parses the input shapes to precompile, one program per ';' separated entry of comma separated input shapes,
+// e.g. "input_ids:1x128,attention_mask:1x128;input_ids:8x128,attention_mask:8x128".
+Status ParsePrecompileShapes(const std::string& precompile_shapes,
+                             std::vector<std::map<std::string, std::vector<std::size_t>>>& buckets) {
+  std::istringstream buckets_stream(precompile_shapes);
+  std::string bucket;
+  while (std::getline(buckets_stream, bucket, ';')) {
+    if (bucket.empty()) {
+      continue;
+    }
+    std::map<std::string, std::vector<std::size_t>> input_shapes;
+    std::istringstream bucket_stream(bucket);
+    std::string input_shape;
+    while (std::getline(bucket_stream, input_shape, ',')) {
+      const auto separator = input_shape.rfind(':');
+      ORT_RETURN_IF(separator == std::string::npos || separator == 0, "Invalid input shape to precompile: ",
+                    input_shape);
+      std::vector<std::size_t> lens;
+      std::istringstream dims_stream(input_shape.substr(separator + 1));
+      std::string dim;
+      while (std::getline(dims_stream, dim, 'x')) {
+        ORT_RETURN_IF(dim.empty() || !std::all_of(dim.begin(), dim.end(), [](char c) { return std::isdigit(c); }),
+                      "Invalid dimension in the input shape to precompile: ", input_shape);
+        lens.push_back(static_cast<std::size_t>(std::stoull(dim)));
+      }
+      input_shapes[input_shape.substr(0, separator)] = lens;
+    }
+    buckets.push_back(std::move(input_shapes));
+  }
+  return Status::OK();
+}
+
+migraphx::program MIGraphXExecutionProvider::CompileProgram(const std::string& onnx_string,
+                                                            const migraphx::onnx_options& options) {
+  migraphx::program prog = migraphx::parse_onnx_buffer(onnx_string, options);
+
+  // Read in the calibration data and map it to an migraphx paramater map for the calibration ops
+  if (int8_enable_ && int8_calibration_cache_available_) {
+    LOGS_DEFAULT(INFO) << "Quantizing input program to int8" << std::endl;
+    migraphx::quantize_int8_options quant_opts;
+    migraphx::program_parameters quant_params;
+
+    auto param_shapes = prog.get_parameter_shapes();
+
+    // Add all calibration data read in from int8 table
+    for (auto& [cal_key, cal_val] : dynamic_range_map_) {
+      auto cal_val_shape = migraphx::shape(migraphx_shape_float_type);
+      quant_params.add(cal_key.c_str(), migraphx::argument(cal_val_shape, static_cast<void*>(std::move(&cal_val))));
+    }
+    quant_opts.add_calibration_data(quant_params);
+
+    // specify thing we want to int8 quantize
+    quant_opts.add_op_name("convolution");
+    quant_opts.add_op_name("dot");
+
+    // perform static quantization on the programs
+    migraphx::quantize_int8(prog, t_, quant_opts);
+    LOGS_DEFAULT(INFO) << "Quantizing input program to int8: Complete" << std::endl;
+  }
+
+  if (fp16_enable_) {
+    LOGS_DEFAULT(INFO) << "Quantizing input program to fp16" << std::endl;
+    migraphx::quantize_fp16(prog);
+    LOGS_DEFAULT(INFO) << "Quantizing input program to fp16: Complete" << std::endl;
+  }
+
+  migraphx::compile_options co;
+  co.set_fast_math(false);
+  co.set_exhaustive_tune_flag(exhaustive_tune_);
+  LOGS_DEFAULT(INFO) << "Model Compile: Begin" << std::endl;
+  prog.compile(t_, co);
+  LOGS_DEFAULT(INFO) << "Model Compile: Complete" << std::endl;
+  return prog;
+}
+
 Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes,
                                           std::vector<NodeComputeInfo>& node_compute_funcs) {
   migraphx::onnx_options options;
@@ -1159,44 +1307,7 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
     if (!no_input_shape) {
       if (!load_precompiled_model(prog, load_compiled_model_, std::string{load_compiled_path_})) {
         LOGS_DEFAULT(INFO) << "No Input shapes detected quantizing model";
-        prog = migraphx::parse_onnx_buffer(onnx_string_buffer, options);
-
-        // Read in the calibration data and map it to an migraphx paramater map for the calibration ops
-        if (int8_enable_ && int8_calibration_cache_available_) {
-          LOGS_DEFAULT(INFO) << "Quantizing input program to int8" << std::endl;
-          migraphx::quantize_int8_options quant_opts;
-          migraphx::program_parameters quant_params;
-
-          auto param_shapes = prog.get_parameter_shapes();
-
-          // Add all calibration data read in from int8 table
-          for (auto& [cal_key, cal_val] : dynamic_range_map_) {
-            auto cal_val_shape = migraphx::shape(migraphx_shape_float_type);
-            quant_params.add(cal_key.c_str(), migraphx::argument(cal_val_shape, static_cast<void*>(std::move(&cal_val))));
-          }
-          quant_opts.add_calibration_data(quant_params);
-
-          // specify thing we want to int8 quantize
-          quant_opts.add_op_name("convolution");
-          quant_opts.add_op_name("dot");
-
-          // perform static quantization on the programs
-          migraphx::quantize_int8(prog, t_, quant_opts);
-          LOGS_DEFAULT(INFO) << "Quantizing input program to int8: Complete" << std::endl;
-        }
-
-        if (fp16_enable_) {
-          LOGS_DEFAULT(INFO) << "Quantizing input program to fp16" << std::endl;
-          migraphx::quantize_fp16(prog);
-          LOGS_DEFAULT(INFO) << "Quantizing input program to fp16: Complete" << std::endl;
-        }
-
-        migraphx::compile_options co;
-        co.set_fast_math(false);
-        co.set_exhaustive_tune_flag(exhaustive_tune_);
-        LOGS_DEFAULT(INFO) << "Model Compile: Begin" << std::endl;
-        prog.compile(t_, co);
-        LOGS_DEFAULT(INFO) << "Model Compile: Complete" << std::endl;
+        prog = CompileProgram(onnx_string_buffer, options);
 
         save_compiled_model(prog, save_compiled_model_, save_compiled_path_);
       }
@@ -1208,8 +1319,54 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
       }
     }
 
+    auto program_cache = std::make_shared<MIGraphXProgramCache>(program_cache_size_);
+    std::string model_cache_prefix;
+    if (!model_cache_path_.empty()) {
+      // the compiled programs depend on the subgraph, the compile options and the GPU architecture
+      const std::string model_key = onnx_string_buffer + (fp16_enable_ ? "_fp16" : "") + (int8_enable_ ? "_int8" : "") +
+                                    (exhaustive_tune_ ? "_exhaustive_tune" : "");
+      model_cache_prefix = (std::filesystem::path(model_cache_path_) /
+                            (fused_node.Name() + "_" + std::to_string(std::hash<std::string>{}(model_key)) + "_" +
+                             gpu_arch_))
+                               .string();
+    }
+    if (!no_input_shape) {
+      program_cache->Put(GetProgramShapesKey(prog, input_name_index), prog);
+    }
+
+    // compile the programs of the configured input shapes before the first run
+    std::vector<std::map<std::string, std::vector<std::size_t>>> precompile_buckets;
+    ORT_RETURN_IF_ERROR(ParsePrecompileShapes(precompile_shapes_, precompile_buckets));
+    for (const auto& bucket : precompile_buckets) {
+      if (!std::all_of(input_name_index.begin(), input_name_index.end(),
+                       [&bucket](const auto& input) { return bucket.count(input.first) > 0; })) {
+        LOGS_DEFAULT(VERBOSE) << "Not all the inputs of " << fused_node.Name() << " have a shape to precompile";
+        continue;
+      }
+
+      migraphx::onnx_options bucket_options;
+      std::map<std::string, std::vector<std::size_t>> input_shapes;
+      for (const auto& input : input_name_index) {
+        input_shapes[input.first] = bucket.at(input.first);
+        bucket_options.set_input_parameter_shape(input.first, input_shapes[input.first]);
+      }
+      const std::string shapes_key = GetInputShapesKey(input_shapes);
+
+      migraphx::program bucket_prog;
+      const std::string model_cache_file =
+          model_cache_prefix.empty() ? "" : GetModelCacheFile(model_cache_prefix, shapes_key);
+      if (!load_precompiled_model(bucket_prog, !model_cache_file.empty(), model_cache_file)) {
+        LOGS_DEFAULT(INFO) << "Precompiling " << fused_node.Name() << " for " << shapes_key;
+        bucket_prog = CompileProgram(onnx_string_buffer, bucket_options);
+        save_compiled_model(bucket_prog, !model_cache_file.empty(), model_cache_file);
+      }
+      program_cache->Put(shapes_key, bucket_prog);
+    }
+
     // compile the program
     map_progs_[fused_node.Name()] = prog;
+    map_program_cache_[fused_node.Name()] = program_cache;
+    map_model_cache_prefix_[fused_node.Name()] = model_cache_prefix;
 
     map_onnx_string_[fused_node.Name()] = onnx_string_buffer;
     map_input_index_[fused_node.Name()] = input_name_index;
@@ -1222,7 +1379,8 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
             map_no_input_shape_[context->node_name], fp16_enable_, int8_enable_,
             int8_calibration_cache_available_, dynamic_range_map_,
             save_compiled_model_, save_compiled_path_,
-            load_compiled_model_, load_compiled_path_, dump_model_ops_};
+            load_compiled_model_, load_compiled_path_, dump_model_ops_, exhaustive_tune_,
+            map_program_cache_[context->node_name], map_model_cache_prefix_[context->node_name]};
       *state = p.release();
       return 0;
     };
@@ -1298,7 +1456,26 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
       // input shapes are different, needs to re-parse onnx and
       // re-compile the program
       if (!input_shape_match) {
-        if (!load_precompiled_model(prog, load_compiled_model_, std::string{load_compiled_path_})) {
+        std::map<std::string, std::vector<std::size_t>> input_shapes;
+        for (auto& it : map_input_name_index) {
+          const auto tensor_shape = ctx.GetInput(it.second).GetTensorTypeAndShapeInfo().GetShape();
+          input_shapes[it.first] = std::vector<std::size_t>(tensor_shape.begin(), tensor_shape.end());
+        }
+        const std::string shapes_key = GetInputShapesKey(input_shapes);
+        const std::string model_cache_file =
+            mgx_state->model_cache_prefix.empty() ? "" : GetModelCacheFile(mgx_state->model_cache_prefix, shapes_key);
+
+        bool cached = false;
+        {
+          std::lock_guard<OrtMutex> lock(*(mgx_state->mgx_mu_ptr));
+          cached = mgx_state->program_cache->Get(shapes_key, prog);
+        }
+
+        if (cached) {
+          LOGS_DEFAULT(VERBOSE) << "Using the program compiled for " << shapes_key << std::endl;
+        } else if (load_precompiled_model(prog, !model_cache_file.empty(), model_cache_file)) {
+          LOGS_DEFAULT(VERBOSE) << "Loaded the program compiled for " << shapes_key << std::endl;
+        } else {
           LOGS_DEFAULT(VERBOSE) << "No Input shapes mismatch detected. Recompiling" << std::endl;
 #ifndef ENABLE_TRAINING_CORE
 #if HIP_VERSION_MAJOR > 6 || (HIP_VERSION_MAJOR == 6 && HIP_VERSION_MINOR >= 2)
@@ -1362,6 +1539,12 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
           prog.compile(t, co);
 
           save_compiled_model(prog, mgx_state->save_compiled_mode, mgx_state->save_compiled_path);
+          save_compiled_model(prog, !model_cache_file.empty(), model_cache_file);
+        }
+
+        if (!cached) {
+          std::lock_guard<OrtMutex> lock(*(mgx_state->mgx_mu_ptr));
+          mgx_state->program_cache->Put(shapes_key, prog);
         }
 
         mgx_state->prog = prog;
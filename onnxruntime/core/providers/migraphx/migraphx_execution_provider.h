@@ -9,7 +9,9 @@
 #include "core/providers/migraphx/migraphx_execution_provider_info.h"
 #include "core/providers/migraphx/migraphx_inc.h"
 
+#include <list>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <filesystem>
 
@@ -27,9 +29,49 @@ static const char kSavedModelPath[] = "ORT_MIGRAPHX_SAVE_COMPILE_PATH";
 static const char kLoadCompiledModel[] = "ORT_MIGRAPHX_LOAD_COMPILED_MODEL";
 static const char kLoadModelPath[] = "ORT_MIGRAPHX_LOAD_COMPILE_PATH";
 static const char kExhaustiveTune[] = "ORT_MIGRAPHX_EXHAUSTIVE_TUNE";
+static const char kProgramCacheSize[] = "ORT_MIGRAPHX_PROGRAM_CACHE_SIZE";
+static const char kModelCachePath[] = "ORT_MIGRAPHX_MODEL_CACHE_PATH";
+static const char kPrecompileShapes[] = "ORT_MIGRAPHX_PRECOMPILE_SHAPES";
 
 };  // namespace migraphx_env_vars
 
+// The compiled programs of a fused node by the shapes of its inputs. The least recently used program is evicted when
+// the cache is full. Not thread safe, the users lock the mutex of the execution provider.
+class MIGraphXProgramCache {
+ public:
+  explicit MIGraphXProgramCache(std::size_t capacity) : capacity_(capacity) {}
+
+  bool Get(const std::string& shapes_key, migraphx::program& prog) {
+    auto it = index_.find(shapes_key);
+    if (it == index_.end()) {
+      return false;
+    }
+    programs_.splice(programs_.begin(), programs_, it->second);
+    prog = it->second->second;
+    return true;
+  }
+
+  void Put(const std::string& shapes_key, const migraphx::program& prog) {
+    if (capacity_ == 0) {
+      return;
+    }
+    auto it = index_.find(shapes_key);
+    if (it != index_.end()) {
+      programs_.erase(it->second);
+    } else if (programs_.size() == capacity_) {
+      index_.erase(programs_.back().first);
+      programs_.pop_back();
+    }
+    programs_.emplace_front(shapes_key, prog);
+    index_[shapes_key] = programs_.begin();
+  }
+
+ private:
+  std::size_t capacity_;
+  std::list<std::pair<std::string, migraphx::program>> programs_;
+  std::unordered_map<std::string, std::list<std::pair<std::string, migraphx::program>>::iterator> index_;
+};
+
 // Information to construct kernel function state.
 struct MIGraphXFuncState {
   AllocateFunc allocate_func = nullptr;
@@ -52,6 +94,9 @@ struct MIGraphXFuncState {
   std::string load_compiled_path;
   bool dump_model_ops = false;
   bool exhaustive_tune = false;
+  std::shared_ptr<MIGraphXProgramCache> program_cache;
+  // the name of the files of the fused node in the model cache directory, without the shapes, empty if there is none
+  std::string model_cache_prefix;
 };
 
 // Logical device representation.
@@ -76,6 +121,9 @@ class MIGraphXExecutionProvider : public IExecutionProvider {
   virtual std::shared_ptr<KernelRegistry> GetKernelRegistry() const override;
   std::unique_ptr<onnxruntime::IDataTransfer> GetDataTransfer() const override;
 
+  // Parses the fused subgraph with the input shapes of `options`, quantizes it and compiles it.
+  migraphx::program CompileProgram(const std::string& onnx_string, const migraphx::onnx_options& options);
+
   std::unique_ptr<IndexedSubGraph> GetSubGraph(const std::vector<std::size_t>& graph_nodes_index, const GraphViewer& graph) const;
   void RegisterStreamHandlers(IStreamCommandHandleRegistry& stream_handle_registry, AllocatorMap& allocators) const override;
   OrtDevice GetOrtDeviceByMemType(OrtMemType mem_type) const override;
@@ -104,12 +152,19 @@ class MIGraphXExecutionProvider : public IExecutionProvider {
   OrtMutex mgx_mu_;
   hipStream_t stream_ = nullptr;
   bool exhaustive_tune_ = false;
+  std::size_t program_cache_size_ = 8;
+  std::string model_cache_path_;
+  std::string precompile_shapes_;
+  // e.g. "gfx90a_sramecc+_xnack-", the compiled programs of the model cache are only valid for this architecture
+  std::string gpu_arch_;
   mutable std::filesystem::path model_path_;
 
   std::unordered_map<std::string, migraphx::program> map_progs_;
   std::unordered_map<std::string, std::string> map_onnx_string_;
   std::unordered_map<std::string, std::unordered_map<std::string, std::size_t>> map_input_index_;
   std::unordered_map<std::string, bool> map_no_input_shape_;
+  std::unordered_map<std::string, std::shared_ptr<MIGraphXProgramCache>> map_program_cache_;
+  std::unordered_map<std::string, std::string> map_model_cache_prefix_;
 
   AllocatorPtr allocator_;
   std::unique_ptr<ModelMetadefIdGenerator> metadef_id_generator_;
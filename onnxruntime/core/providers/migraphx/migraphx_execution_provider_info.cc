@@ -22,6 +22,9 @@ constexpr const char* kSaveModelPath = "migx_save_model_name";
 constexpr const char* kLoadCompiledModel = "migx_load_compiled_model";
 constexpr const char* kLoadModelPath = "migx_load_model_name";
 constexpr const char* kExhaustiveTune = "migx_exhaustive_tune";
+constexpr const char* kProgramCacheSize = "migx_program_cache_size";
+constexpr const char* kModelCacheDir = "migx_model_cache_dir";
+constexpr const char* kPrecompileShapes = "migx_precompile_shapes";
 
 }  // namespace provider_option_names
 }  // namespace migraphx
@@ -47,6 +50,9 @@ MIGraphXExecutionProviderInfo MIGraphXExecutionProviderInfo::FromProviderOptions
           .AddAssignmentToReference(migraphx::provider_option_names::kSaveCompiledModel, info.save_compiled_model)
           .AddAssignmentToReference(migraphx::provider_option_names::kLoadCompiledModel, info.load_compiled_model)
           .AddAssignmentToReference(migraphx::provider_option_names::kExhaustiveTune, info.exhaustive_tune)
+          .AddAssignmentToReference(migraphx::provider_option_names::kProgramCacheSize, info.program_cache_size)
+          .AddAssignmentToReference(migraphx::provider_option_names::kModelCacheDir, info.model_cache_dir)
+          .AddAssignmentToReference(migraphx::provider_option_names::kPrecompileShapes, info.precompile_shapes)
           .Parse(options));
 
   return info;
@@ -60,6 +66,9 @@ ProviderOptions MIGraphXExecutionProviderInfo::ToProviderOptions(const MIGraphXE
       {migraphx::provider_option_names::kSaveCompiledModel, MakeStringWithClassicLocale(info.save_compiled_model)},
       {migraphx::provider_option_names::kLoadCompiledModel, MakeStringWithClassicLocale(info.load_compiled_model)},
       {migraphx::provider_option_names::kExhaustiveTune, MakeStringWithClassicLocale(info.exhaustive_tune)},
+      {migraphx::provider_option_names::kProgramCacheSize, MakeStringWithClassicLocale(info.program_cache_size)},
+      {migraphx::provider_option_names::kModelCacheDir, info.model_cache_dir},
+      {migraphx::provider_option_names::kPrecompileShapes, info.precompile_shapes},
   };
   return options;
 }
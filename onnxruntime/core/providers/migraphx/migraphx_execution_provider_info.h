@@ -24,6 +24,12 @@ struct MIGraphXExecutionProviderInfo {
   bool load_compiled_model{true};
   std::string load_model_file{"./compiled_model.mxr"};
   bool exhaustive_tune{false};
+  // the number of compiled programs of every fused node that are kept for the input shapes seen by the runs
+  size_t program_cache_size{8};
+  // directory where the programs compiled for each input shapes are saved and loaded, keyed by the GPU architecture
+  std::string model_cache_dir{""};
+  // input shapes to compile the programs of before the first run, e.g. "input:1x3x224x224;input:8x3x224x224"
+  std::string precompile_shapes{""};
 
   static MIGraphXExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const MIGraphXExecutionProviderInfo& info);
@@ -3,14 +3,17 @@
 
 #include "model_builder.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "core/common/common.h"
 #include "core/common/inlined_containers_fwd.h"
 #include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/common/status.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/node_unit.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
@@ -42,6 +45,7 @@ ModelBuilder::ModelBuilder(const GraphViewer& graph_viewer, const NnApi& nnapi_h
   Status ModelBuilder::AddOperandFromScalar(scalar_type value, uint32_t& index) { \
     OperandType operandType(Type::op_type, InlinedVector<uint32_t>{});            \
     ORT_RETURN_IF_ERROR(AddNewNNAPIOperand(operandType, index));                  \
+    HashForCompilationCache(value);                                               \
     RETURN_STATUS_ON_ERROR_WITH_NOTE(                                             \
         nnapi_.ANeuralNetworksModel_setOperandValue(                              \
             nnapi_model_->model_, index, &value, sizeof(value)),                  \
@@ -387,6 +391,7 @@ Status ModelBuilder::AddNewNNAPIOperand(const OperandType& operand_type, uint32_
   RETURN_STATUS_ON_ERROR(
       nnapi_.ANeuralNetworksModel_addOperand(nnapi_model_->model_, &operand_type.operandType));
   index = next_index_++;
+  HashOperandForCompilationCache(operand_type);
 
   if (operand_type.channelQuant) {
     if (nnapi_effective_feature_level_ < ANEURALNETWORKS_FEATURE_LEVEL_3) {
@@ -409,9 +414,45 @@ void ModelBuilder::RegisterOperand(const std::string& name, uint32_t index,
   operands_.insert(name);
 }
 
+void ModelBuilder::HashForCompilationCache(const void* data, size_t size) {
+  if (compilation_cache_dir_.empty()) {
+    return;
+  }
+
+  constexpr size_t kMaxChunkSize = size_t{1} << 30;
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  do {
+    const size_t chunk_size = std::min(size, kMaxChunkSize);
+    for (auto& hash : cache_token_hash_) {
+      MurmurHash3::x86_128(bytes, narrow<int>(chunk_size), hash[0], hash);
+    }
+    bytes += chunk_size;
+    size -= chunk_size;
+  } while (size > 0);
+}
+
+void ModelBuilder::HashOperandForCompilationCache(const OperandType& operand_type) {
+  if (compilation_cache_dir_.empty()) {
+    return;
+  }
+
+  const auto& nnapi_operand_type = operand_type.operandType;
+  HashForCompilationCache(nnapi_operand_type.type);
+  HashForCompilationCache(operand_type.dimensions.data(), operand_type.dimensions.size() * sizeof(uint32_t));
+  HashForCompilationCache(nnapi_operand_type.scale);
+  HashForCompilationCache(nnapi_operand_type.zeroPoint);
+  if (operand_type.channelQuant) {
+    HashForCompilationCache(operand_type.channelQuant->params.channelDim);
+    HashForCompilationCache(operand_type.channelQuant->scales.data(),
+                            operand_type.channelQuant->scales.size() * sizeof(float));
+  }
+}
+
 Status ModelBuilder::SetOperandValue(uint32_t index,
                                      Model::NNMemory* memory,
                                      size_t size, size_t offset) {
+  HashForCompilationCache(index);
+  HashForCompilationCache(memory->GetDataPtr() + offset, size);
 #ifdef USENNAPISHAREDMEM
   RETURN_STATUS_ON_ERROR(
       nnapi_.ANeuralNetworksModel_setOperandValueFromMemory(
@@ -440,6 +481,7 @@ Status ModelBuilder::AddOperandFromPersistMemoryBuffer(
   // for small size operand, the value will be copied
   // no need to persist
   if (size < ANEURALNETWORKS_MAX_SIZE_OF_IMMEDIATELY_COPIED_VALUES) {
+    HashForCompilationCache(buffer, size);
     RETURN_STATUS_ON_ERROR(
         nnapi_.ANeuralNetworksModel_setOperandValue(
             nnapi_model_->model_, index,
@@ -508,6 +550,10 @@ Status ModelBuilder::AddOperation(int op, const InlinedVector<uint32_t>& input_i
     output_indices.push_back(index);
   }
 
+  HashForCompilationCache(op);
+  HashForCompilationCache(input_indices.data(), input_indices.size() * sizeof(uint32_t));
+  HashForCompilationCache(output_indices.data(), output_indices.size() * sizeof(uint32_t));
+
   RETURN_STATUS_ON_ERROR_WITH_NOTE(
       nnapi_.ANeuralNetworksModel_addOperation(
           nnapi_model_->model_, op, static_cast<uint32_t>(input_indices.size()), &input_indices[0],
@@ -644,6 +690,27 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model) {
           nnapi_model_->compilation_, static_cast<int32_t>(exe_pref_)),
       "on setPreference");
 
+  if (!compilation_cache_dir_.empty() && nnapi_effective_feature_level_ >= ANEURALNETWORKS_FEATURE_LEVEL_3) {
+    // the compilation also depends on how the model is compiled and the devices it is compiled for
+    HashForCompilationCache(input_index_vec_.data(), input_index_vec_.size() * sizeof(uint32_t));
+    HashForCompilationCache(output_index_vec_.data(), output_index_vec_.size() * sizeof(uint32_t));
+    HashForCompilationCache(use_fp16_);
+    HashForCompilationCache(exe_pref_);
+    HashForCompilationCache(use_create_for_devices);
+    for (const auto& device : nnapi_target_devices_) {
+      HashForCompilationCache(device.name.data(), device.name.size());
+      HashForCompilationCache(device.feature_level);
+    }
+
+    uint8_t token[ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN];
+    static_assert(sizeof(token) == sizeof(cache_token_hash_), "The cache token must be made of the two hashes");
+    memcpy(token, cache_token_hash_, sizeof(token));
+    RETURN_STATUS_ON_ERROR_WITH_NOTE(
+        nnapi_.ANeuralNetworksCompilation_setCaching(
+            nnapi_model_->compilation_, compilation_cache_dir_.c_str(), token),
+        "on setCaching");
+  }
+
   RETURN_STATUS_ON_ERROR_WITH_NOTE(
       nnapi_.ANeuralNetworksCompilation_finish(nnapi_model_->compilation_),
       "on compilation finish");
@@ -80,6 +80,12 @@ class ModelBuilder {
   void SetExecutePreference(
       android::nn::wrapper::ExecutePreference pref) { exe_pref_ = pref; }
 
+  // Let the NNAPI drivers cache the compilation of the model in the given directory, with a token hashed from the
+  // NNAPI model, so compiling the same partition again, e.g. in a later launch of the app, loads it from the cache.
+  // Only available on Android API level 29+, ignored for lower levels
+  // It is off by default
+  void SetCompilationCacheDir(const std::string& cache_dir) { compilation_cache_dir_ = cache_dir; }
+
   // Accessors for members
   Shaper& GetShaper() { return shaper_; }
 
@@ -126,6 +132,11 @@ class ModelBuilder {
   android::nn::wrapper::ExecutePreference exe_pref_{
       android::nn::wrapper::ExecutePreference::PREFER_FAST_SINGLE_ANSWER};
 
+  std::string compilation_cache_dir_;
+  // fingerprint of the NNAPI model, updated as the model is built when the compilation is cached.
+  // two 128-bit hashes with different seeds make up the ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN bytes of the token.
+  uint32_t cache_token_hash_[2][4] = {{0, 0, 0, 0}, {0x9e3779b9, 0, 0, 0}};
+
   Shaper shaper_;
 
   std::unordered_map<std::string, uint32_t> operand_indices_;
@@ -195,6 +206,12 @@ class ModelBuilder {
 
   common::Status SetOperandValue(uint32_t index, Model::NNMemory* memory, size_t size, size_t offset);
 
+  // Add the given bytes to the fingerprint of the NNAPI model used as the compilation cache token
+  void HashForCompilationCache(const void* data, size_t size);
+  template <typename T>
+  void HashForCompilationCache(const T& value) { HashForCompilationCache(&value, sizeof(value)); }
+  void HashOperandForCompilationCache(const android::nn::wrapper::OperandType& operand_type);
+
   common::Status AddNewNNAPIOperand(const android::nn::wrapper::OperandType& type, uint32_t& index);
   common::Status AddNewOperand(const std::string& name,
                                const android::nn::wrapper::OperandType& operand_type,
@@ -19,7 +19,8 @@ class Model;
 class NnapiExecutionProvider : public IExecutionProvider {
  public:
   explicit NnapiExecutionProvider(uint32_t nnapi_flags,
-                                  const optional<std::string>& partitioning_stop_ops_list = {});
+                                  const optional<std::string>& partitioning_stop_ops_list = {},
+                                  const optional<std::string>& compilation_cache_dir = {});
 
   virtual ~NnapiExecutionProvider();
 
@@ -43,6 +44,9 @@ class NnapiExecutionProvider : public IExecutionProvider {
 
   const std::unordered_set<std::string> partitioning_stop_ops_;
 
+  // Directory the NNAPI drivers cache the compiled models in, empty if the compilation is not cached
+  const std::string compilation_cache_dir_;
+
   std::unordered_map<std::string, std::unique_ptr<onnxruntime::nnapi::Model>> nnapi_models_;
 
   // For Android NNAPI and stub implementation.
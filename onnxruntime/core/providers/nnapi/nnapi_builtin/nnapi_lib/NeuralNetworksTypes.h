@@ -277,6 +277,15 @@ enum {
   ANEURALNETWORKS_MAX_SIZE_OF_IMMEDIATELY_COPIED_VALUES = 128
 };
 
+/**
+ * The size of the cache token required by {@link ANeuralNetworksCompilation_setCaching}.
+ *
+ * Available since API level 29.
+ */
+enum {
+  ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN = 32
+};
+
 /**
  * ANeuralNetworksMemoryDesc is an opaque type that represents a memory
  * descriptor.
@@ -13,9 +13,11 @@ namespace onnxruntime {
 namespace {
 struct NnapiProviderFactory : IExecutionProviderFactory {
   NnapiProviderFactory(uint32_t nnapi_flags,
-                       const optional<std::string>& partitioning_stop_ops_list)
+                       const optional<std::string>& partitioning_stop_ops_list,
+                       const optional<std::string>& compilation_cache_dir)
       : nnapi_flags_(nnapi_flags),
-        partitioning_stop_ops_list_(partitioning_stop_ops_list) {}
+        partitioning_stop_ops_list_(partitioning_stop_ops_list),
+        compilation_cache_dir_(compilation_cache_dir) {}
 
   ~NnapiProviderFactory() override {}
 
@@ -24,16 +26,18 @@ struct NnapiProviderFactory : IExecutionProviderFactory {
  private:
   const uint32_t nnapi_flags_;
   const optional<std::string> partitioning_stop_ops_list_;
+  const optional<std::string> compilation_cache_dir_;
 };
 
 std::unique_ptr<IExecutionProvider> NnapiProviderFactory::CreateProvider() {
-  return std::make_unique<NnapiExecutionProvider>(nnapi_flags_, partitioning_stop_ops_list_);
+  return std::make_unique<NnapiExecutionProvider>(nnapi_flags_, partitioning_stop_ops_list_, compilation_cache_dir_);
 }
 }  // namespace
 
 std::shared_ptr<IExecutionProviderFactory> NnapiProviderFactoryCreator::Create(
-    uint32_t nnapi_flags, const optional<std::string>& partitioning_stop_ops_list) {
-  return std::make_shared<NnapiProviderFactory>(nnapi_flags, partitioning_stop_ops_list);
+    uint32_t nnapi_flags, const optional<std::string>& partitioning_stop_ops_list,
+    const optional<std::string>& compilation_cache_dir) {
+  return std::make_shared<NnapiProviderFactory>(nnapi_flags, partitioning_stop_ops_list, compilation_cache_dir);
 }
 
 }  // namespace onnxruntime
@@ -41,7 +45,10 @@ std::shared_ptr<IExecutionProviderFactory> NnapiProviderFactoryCreator::Create(
 ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_Nnapi, _In_ OrtSessionOptions* options, uint32_t nnapi_flags) {
   const auto partitioning_stop_ops_list = options->value.config_options.GetConfigEntry(
       kOrtSessionOptionsConfigNnapiEpPartitioningStopOps);
+  const auto compilation_cache_dir = options->value.config_options.GetConfigEntry(
+      kOrtSessionOptionsConfigNnapiEpCompilationCacheDir);
   options->provider_factories.push_back(
-      onnxruntime::NnapiProviderFactoryCreator::Create(nnapi_flags, partitioning_stop_ops_list));
+      onnxruntime::NnapiProviderFactoryCreator::Create(nnapi_flags, partitioning_stop_ops_list,
+                                                       compilation_cache_dir));
   return nullptr;
 }
@@ -1,6 +1,7 @@
 // Copyright (C) Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <memory>
@@ -121,7 +122,11 @@ BasicBackend::BasicBackend(std::unique_ptr<ONNX_NAMESPACE::ModelProto>& model_pr
     ORT_THROW(msg);
   }
 
-  inferRequestsQueue_ = std::unique_ptr<InferRequestsQueue>(new InferRequestsQueue(exe_network_, 1));
+  // Size the pool to the number of infer requests the compiled model runs in parallel, which is more than one with
+  // num_streams or the THROUGHPUT performance hint, so that concurrent Runs on the session don't wait for each other
+  size_t num_infer_requests = std::max<size_t>(exe_network_.GetOptimalNumberOfInferRequests(), 1);
+  LOGS_DEFAULT(INFO) << log_tag << "Creating " << num_infer_requests << " infer requests";
+  inferRequestsQueue_ = std::unique_ptr<InferRequestsQueue>(new InferRequestsQueue(exe_network_, num_infer_requests));
 }
 
 bool BasicBackend::ValidateSubgraph(std::map<std::string, std::shared_ptr<ov::Node>>& const_outputs_map) {
@@ -307,6 +312,10 @@ void BasicBackend::SetNumThreads(ov::AnyMap& device_config) {
 // an Infer Request indexed by infer_req_idx
 void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferRequestPtr infer_request) {
   try {
+    auto& ort_ov_tensor_map = [&]() -> std::map<ort_tensor_key_t, ov_tensor_data_t>& {
+      std::lock_guard<std::mutex> lock(compute_lock_);
+      return ort_ov_tensor_maps_[infer_request.get()];
+    }();
     auto graph_input_info = exe_network_.Get().inputs();
     int input_idx = 0;
     for (auto input_info_iter = graph_input_info.begin();
@@ -631,8 +640,8 @@ void BasicBackend::CompleteAsyncInference(Ort::KernelContext& context, OVInferRe
 }
 
 void BasicBackend::Infer(OrtKernelContext* ctx) {
-  // Preliminary Thread safety mechanism
-  // currently allows a maximum of 8 Infer request's to parallel execute at the same time
+  // Concurrent Runs execute in parallel on different infer requests taken from the pool, and wait for an idle
+  // request once all of them are in use
   Ort::KernelContext context(ctx);
 
   LOGS_DEFAULT(INFO) << log_tag << "Running graph " << subgraph_context_.subgraph_name;
@@ -67,8 +67,9 @@ class BasicBackend : public IBackend {
   OVRemoteContextPtr remote_context_;
 #endif
 
+  // ORT tensors bound to each infer request, guarded by compute_lock_ as concurrent Runs use different requests
   using ort_tensor_key_t = const std::string;
-  std::map<ort_tensor_key_t, ov_tensor_data_t> ort_ov_tensor_map;
+  std::map<const OVInferRequest*, std::map<ort_tensor_key_t, ov_tensor_data_t>> ort_ov_tensor_maps_;
 };
 
 class InferRequestsQueue {
@@ -90,6 +91,7 @@ class InferRequestsQueue {
   }
 
   void printstatus() {
+    std::unique_lock<std::mutex> lock(_mutex);
     std::cout << "printing elements of the vector (infer_requests_): " << std::endl;
     for (auto i = infer_requests_.begin(); i != infer_requests_.end(); ++i) {
       i->get()->QueryStatus();
@@ -194,6 +194,16 @@ OVInferRequest OVExeNetwork::CreateInferRequest() {
   }
 }
 
+uint32_t OVExeNetwork::GetOptimalNumberOfInferRequests() {
+  try {
+    return obj.get_property(ov::optimal_number_of_infer_requests);
+  } catch (const Exception& e) {
+    ORT_THROW(log_tag + "Exception while querying the optimal number of infer requests: " + e.what());
+  } catch (...) {
+    ORT_THROW(log_tag + "Exception while querying the optimal number of infer requests.");
+  }
+}
+
 OVTensorPtr OVInferRequest::GetTensor(const std::string& input_name) {
   try {
     auto tobj = ovInfReq.get_tensor(input_name);
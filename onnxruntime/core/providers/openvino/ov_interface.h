@@ -81,6 +81,8 @@ class OVExeNetwork {
   OVExeNetwork() : obj(ov::CompiledModel()) {}
   ov::CompiledModel& Get() { return obj; }
   OVInferRequest CreateInferRequest();
+  // Number of infer requests needed to keep the device busy, e.g. one per stream in throughput mode
+  uint32_t GetOptimalNumberOfInferRequests();
 };
 
 class OVInferRequest {
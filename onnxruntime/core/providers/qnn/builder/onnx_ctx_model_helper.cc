@@ -196,6 +196,7 @@ Status CreateEPContextNodes(Model* model,
                             const QnnModelLookupTable& qnn_models,
                             const onnxruntime::PathString& context_cache_path,
                             bool qnn_context_embed_mode,
+                            onnxruntime::PathString& context_bin_path,
                             const logging::Logger& logger) {
   auto& graph = model->MainGraph();
 
@@ -229,7 +230,10 @@ Status CreateEPContextNodes(Model* model,
         std::string cache_payload(buffer, buffer + buffer_size);
         ep_node.AddAttribute(EP_CACHE_CONTEXT, cache_payload);
       } else {
-        onnxruntime::PathString context_bin_path = context_cache_path + ToPathString("_" + graph_name + ".bin");
+        // use the given context binary file if any, e.g. the one shared by all the sessions sharing EP contexts
+        if (context_bin_path.empty()) {
+          context_bin_path = context_cache_path + ToPathString("_" + graph_name + ".bin");
+        }
         std::string context_cache_name(std::filesystem::path(context_bin_path).filename().string());
         std::ofstream of_stream(context_bin_path.c_str(), std::ofstream::binary);
         if (!of_stream) {
@@ -65,6 +65,7 @@ Status CreateEPContextNodes(Model* model,
                             const std::unordered_map<std::string, std::unique_ptr<QnnModel>>& qnn_models,
                             const onnxruntime::PathString& context_cache_path,
                             bool qnn_context_embed_mode,
+                            onnxruntime::PathString& context_bin_path,
                             const logging::Logger& logger);
 }  // namespace qnn
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <unordered_set>
+#include <gsl/gsl>
 #include "core/framework/compute_capability.h"
 #include "core/graph/graph_viewer.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -107,6 +108,15 @@ static void ParseHtpPerformanceMode(std::string htp_performance_mode_string,
   }
 }
 
+// "auto" performance mode for a Run: burst while the Run executes, and relax once it's done
+static bool IsHtpPerformanceModeAuto(std::string htp_performance_mode_string) {
+  std::transform(htp_performance_mode_string.begin(),
+                 htp_performance_mode_string.end(),
+                 htp_performance_mode_string.begin(),
+                 [](unsigned char c) { return static_cast<unsigned char>(std::tolower(c)); });
+  return htp_performance_mode_string == "auto";
+}
+
 static void ParseQnnContextPriority(std::string context_priority_string, qnn::ContextPriority& context_priority) {
   std::transform(context_priority_string.begin(),
                  context_priority_string.end(),
@@ -227,6 +237,17 @@ QNNExecutionProvider::QNNExecutionProvider(const ProviderOptions& provider_optio
     share_ep_contexts_ =
         session_options->config_options.GetConfigOrDefault(kOrtSessionOptionShareEpContexts, "0") == "1";
     LOGS_DEFAULT(VERBOSE) << "User specified option - share EP contexts across sessions: " << share_ep_contexts_;
+
+    stop_share_ep_contexts_ =
+        session_options->config_options.GetConfigOrDefault(kOrtSessionOptionStopShareEpContexts, "0") == "1";
+    LOGS_DEFAULT(VERBOSE) << "User specified option - stop share EP contexts across sessions: "
+                          << stop_share_ep_contexts_;
+
+    if (share_ep_contexts_ && context_cache_enabled_ && qnn_context_embed_mode_) {
+      LOGS_DEFAULT(WARNING) << "Sharing EP contexts while generating the context model requires "
+                            << kOrtSessionOptionEpContextEmbedMode << "=0. "
+                            << "The embedded context binaries would not include the graphs of the later sessions.";
+    }
   }
 
   static const std::string BACKEND_PATH = "backend_path";
@@ -429,17 +450,32 @@ QNNExecutionProvider::QNNExecutionProvider(const ProviderOptions& provider_optio
                           << "handles the graph I/O quantization/dequantization.";
   }
 
-  qnn_backend_manager_ = std::make_unique<qnn::QnnBackendManager>(
-      std::move(backend_path),
-      profiling_level_etw,
-      profiling_level,
-      std::move(profiling_file_path),
-      context_priority,
-      std::move(qnn_saver_path),
-      device_id_,
-      htp_arch,
-      soc_model,
-      enable_htp_weight_sharing_);
+  // Sessions sharing EP contexts use the QnnBackendManager of the first one, so the backend options of the later
+  // sessions are ignored
+  if (share_ep_contexts_) {
+    qnn_backend_manager_ = SharedContext::GetInstance().GetSharedQnnBackendManager();
+    if (qnn_backend_manager_) {
+      LOGS_DEFAULT(VERBOSE) << "Use the QnnBackendManager from the shared EP contexts.";
+    }
+  }
+
+  if (!qnn_backend_manager_) {
+    qnn_backend_manager_ = std::make_shared<qnn::QnnBackendManager>(
+        std::move(backend_path),
+        profiling_level_etw,
+        profiling_level,
+        std::move(profiling_file_path),
+        context_priority,
+        std::move(qnn_saver_path),
+        device_id_,
+        htp_arch,
+        soc_model,
+        enable_htp_weight_sharing_);
+
+    if (share_ep_contexts_ && !stop_share_ep_contexts_) {
+      SharedContext::GetInstance().SetSharedQnnBackendManager(qnn_backend_manager_);
+    }
+  }
 }
 
 QNNExecutionProvider::~QNNExecutionProvider() {
@@ -889,6 +925,13 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
                                      std::vector<NodeComputeInfo>& node_compute_funcs) {
   const auto& logger = *GetLogger();
 
+  // the last session sharing EP contexts releases the shared resources once it's compiled
+  auto reset_shared_context = gsl::finally([this]() {
+    if (stop_share_ep_contexts_) {
+      SharedContext::GetInstance().Reset();
+    }
+  });
+
   bool is_qnn_ctx_model = qnn::IsFusedGraphHasCtxNode(fused_nodes_and_graphs);
 
   onnxruntime::PathString context_cache_path;
@@ -983,6 +1026,15 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
     uint64_t buffer_size(0);
     auto context_buffer = qnn_backend_manager_->GetContextBinaryBuffer(buffer_size);
     qnn_ep_context_model_ = std::make_unique<Model>("qnn_ep_context_model", false, logger);
+
+    // With shared EP contexts, the QNN context also has the graphs of the previous sessions. Every session rewrites
+    // the same context binary file, so the one written by the last session has the graphs of all the sessions and
+    // the EPContext models of all the sessions can refer to it.
+    onnxruntime::PathString context_bin_path;
+    if (share_ep_contexts_) {
+      context_bin_path = SharedContext::GetInstance().GetSharedCtxBinPath();
+    }
+
     ORT_RETURN_IF_ERROR(qnn::CreateEPContextNodes(qnn_ep_context_model_.get(),
                                                   context_buffer.get(),
                                                   buffer_size,
@@ -991,7 +1043,12 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
                                                   qnn_models_,
                                                   context_cache_path,
                                                   qnn_context_embed_mode_,
+                                                  context_bin_path,
                                                   logger));
+
+    if (share_ep_contexts_ && !qnn_context_embed_mode_) {
+      SharedContext::GetInstance().SetSharedCtxBinPath(context_bin_path);
+    }
   }
   return Status::OK();
 }
@@ -1102,7 +1159,11 @@ Status QNNExecutionProvider::OnRunStart(const onnxruntime::RunOptions& run_optio
   qnn::HtpPerformanceMode htp_performance_mode = qnn::HtpPerformanceMode::kHtpDefault;
   if (run_options.config_options.TryGetConfigEntry(kOrtRunOptionsConfigQnnPerfMode, htp_perf_mode)) {
     // set power mode
-    ParseHtpPerformanceMode(htp_perf_mode, htp_performance_mode);
+    if (IsHtpPerformanceModeAuto(htp_perf_mode)) {
+      htp_performance_mode = qnn::HtpPerformanceMode::kHtpBurst;
+    } else {
+      ParseHtpPerformanceMode(htp_perf_mode, htp_performance_mode);
+    }
   }
 
   std::string rpc_latency = "";
@@ -1138,6 +1199,10 @@ Status QNNExecutionProvider::OnRunEnd(bool /*sync_stream*/, const onnxruntime::R
   if (run_options.config_options.TryGetConfigEntry(kOrtRunOptionsConfigQnnPerfModePostRun, htp_perf_mode)) {
     // set power mode
     ParseHtpPerformanceMode(htp_perf_mode, htp_performance_mode);
+  } else if (run_options.config_options.TryGetConfigEntry(kOrtRunOptionsConfigQnnPerfMode, htp_perf_mode) &&
+             IsHtpPerformanceModeAuto(htp_perf_mode)) {
+    // relax the burst of the "auto" mode while idle
+    htp_performance_mode = qnn::HtpPerformanceMode::kHtpPowerSaver;
   }
 
   if (qnn::HtpPerformanceMode::kHtpDefault != htp_performance_mode) {
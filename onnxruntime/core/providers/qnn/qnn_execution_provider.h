@@ -72,6 +72,35 @@ class SharedContext {
     return graph_exist;
   }
 
+  std::shared_ptr<qnn::QnnBackendManager> GetSharedQnnBackendManager() {
+    const std::lock_guard<OrtMutex> lock(mtx_);
+    return shared_qnn_backend_manager_;
+  }
+
+  void SetSharedQnnBackendManager(const std::shared_ptr<qnn::QnnBackendManager>& qnn_backend_manager) {
+    const std::lock_guard<OrtMutex> lock(mtx_);
+    shared_qnn_backend_manager_ = qnn_backend_manager;
+  }
+
+  onnxruntime::PathString GetSharedCtxBinPath() {
+    const std::lock_guard<OrtMutex> lock(mtx_);
+    return shared_ctx_bin_path_;
+  }
+
+  void SetSharedCtxBinPath(const onnxruntime::PathString& ctx_bin_path) {
+    const std::lock_guard<OrtMutex> lock(mtx_);
+    shared_ctx_bin_path_ = ctx_bin_path;
+  }
+
+  // Called by the last session sharing EP contexts. Graphs not taken by any session are released, and later sessions
+  // start from a new QnnBackendManager and context binary.
+  void Reset() {
+    const std::lock_guard<OrtMutex> lock(mtx_);
+    shared_qnn_models_.clear();
+    shared_qnn_backend_manager_.reset();
+    shared_ctx_bin_path_.clear();
+  }
+
  private:
   SharedContext() = default;
   ~SharedContext() = default;
@@ -79,6 +108,13 @@ class SharedContext {
   SharedContext& operator=(const SharedContext&) = delete;
 
   std::vector<std::unique_ptr<qnn::QnnModel>> shared_qnn_models_;
+  // All the sessions sharing EP contexts use this QnnBackendManager. When generating the context binary, the graphs of
+  // all the sessions are compiled into its single QNN context, so that the HTP backend can share the weights between
+  // them. When loading, it keeps the backend owning the shared graphs alive until the graphs are taken by a session.
+  std::shared_ptr<qnn::QnnBackendManager> shared_qnn_backend_manager_;
+  // The context binary dumped by all the sessions generating shared EP contexts, rewritten by each session to
+  // include the graphs of that session, so the EPContext models of all the sessions refer to the same file.
+  onnxruntime::PathString shared_ctx_bin_path_;
   // Producer sessions can be in parallel
   // Consumer sessions have to be after producer sessions initialized
   OrtMutex mtx_;
@@ -134,7 +170,7 @@ class QNNExecutionProvider : public IExecutionProvider {
 
  private:
   qnn::HtpGraphFinalizationOptimizationMode htp_graph_finalization_opt_mode_ = qnn::HtpGraphFinalizationOptimizationMode::kDefault;
-  std::unique_ptr<qnn::QnnBackendManager> qnn_backend_manager_;
+  std::shared_ptr<qnn::QnnBackendManager> qnn_backend_manager_;
   std::unordered_map<std::string, std::unique_ptr<qnn::QnnModel>> qnn_models_;
   bool context_cache_enabled_ = false;
   std::string context_cache_path_cfg_ = "";
@@ -150,6 +186,7 @@ class QNNExecutionProvider : public IExecutionProvider {
   uint32_t default_rpc_control_latency_ = 0;
   bool enable_HTP_FP16_precision_ = true;
   bool share_ep_contexts_ = false;
+  bool stop_share_ep_contexts_ = false;
 #ifdef _WIN32
   onnxruntime::logging::EtwRegistrationManager::EtwInternalCallback callback_ETWSink_provider_;
 #endif
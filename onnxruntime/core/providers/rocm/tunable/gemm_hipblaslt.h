@@ -12,6 +12,7 @@
 #endif
 
 #include "contrib_ops/rocm/bert/gemm_fast_gelu_common.h"
+#include "contrib_ops/rocm/math/gemm_relu_common.h"
 #include "core/common/common.h"
 #include "core/providers/rocm/tunable/gemm_common.h"
 #include "core/providers/rocm/tunable/rocm_tunable.h"
@@ -23,6 +24,7 @@ namespace blas {
 namespace internal {
 
 using onnxruntime::contrib::rocm::blas::GemmFastGeluParams;
+using onnxruntime::contrib::rocm::blas::GemmReluParams;
 
 #ifdef USE_HIPBLASLT
 
@@ -89,6 +91,11 @@ const T* GetBiasFromParams(const GemmFastGeluParams<T>* params) {
   return params->bias;
 }
 
+template <typename T>
+const T* GetBiasFromParams(const GemmReluParams<T>* params) {
+  return params->bias;
+}
+
 template <typename T, typename ParamsT>
 std::string TypeStringFor() {
   if constexpr (std::is_same_v<ParamsT, GemmParams<T>>) {
@@ -97,6 +104,8 @@ std::string TypeStringFor() {
     return "StridedBatchedGemm";
   } else if constexpr (std::is_same_v<ParamsT, GemmFastGeluParams<T>>) {
     return "GemmFastGelu";
+  } else if constexpr (std::is_same_v<ParamsT, GemmReluParams<T>>) {
+    return "GemmRelu";
   }
   return "UnknownType";
 }
@@ -281,6 +290,11 @@ auto GetHipBlasLtGemmFastGeluTypeStringAndOps() {
   return GetHipBlasLtTypeStringAndOps<T, OpA, OpB, GemmFastGeluParams<T>>(ActivationType::GELU);
 }
 
+template <typename T, BlasOp OpA, BlasOp OpB>
+auto GetHipBlasLtGemmReluTypeStringAndOps() {
+  return GetHipBlasLtTypeStringAndOps<T, OpA, OpB, GemmReluParams<T>>(ActivationType::RELU);
+}
+
 #endif  // USE_HIPBLASLT
 
 }  // namespace internal
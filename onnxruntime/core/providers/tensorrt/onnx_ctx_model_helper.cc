@@ -328,7 +328,9 @@ Status TensorRTCacheModelHandler::GetEpContextFromGraph(const GraphViewer& graph
       weight_stripped_engine_refit_ = IsWeightStrippedEngineCache(engine_cache_path);
     }
 
-    // If the serialized refitted engine is present, use it directly without refitting the engine again
+    // If the serialized refitted engine is present, use it directly without refitting the engine again.
+    // TRT EP no longer writes the refitted engine, the weight-stripped engine is refitted at every load instead
+    // so that the weights are only stored in the ONNX model, but refitted engines from earlier runs are still used.
     if (weight_stripped_engine_refit_) {
       const std::filesystem::path refitted_engine_cache_path = GetWeightRefittedEnginePath(engine_cache_path.string());
       if (std::filesystem::exists(refitted_engine_cache_path)) {
@@ -367,7 +369,7 @@ Status TensorRTCacheModelHandler::GetEpContextFromGraph(const GraphViewer& graph
                                                            onnx_model_bytestream_,
                                                            onnx_model_bytestream_size_,
                                                            (*trt_engine_).get(),
-                                                           true /* serialize refitted engine to disk */,
+                                                           false /* serialize refitted engine to disk */,
                                                            detailed_build_log_);
       if (status != Status::OK()) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, status.ErrorMessage());
@@ -585,6 +585,25 @@ bool ApplyProfileShapesFromProviderOptions(std::vector<nvinfer1::IOptimizationPr
   return true;
 }
 
+/*
+ * Round a dimension down/up to a power of 2, to widen the range of a dynamic dimension in an optimization profile.
+ */
+static int64_t RoundDownToPowerOfTwo(int64_t value) {
+  int64_t result = 1;
+  while (result * 2 <= value) {
+    result *= 2;
+  }
+  return value < 1 ? value : result;
+}
+
+static int64_t RoundUpToPowerOfTwo(int64_t value) {
+  int64_t result = 1;
+  while (result < value) {
+    result *= 2;
+  }
+  return result;
+}
+
 /*
  * Apply TensorRT optimization profile shapes from input tensor value.
  *
@@ -593,6 +612,8 @@ bool ApplyProfileShapesFromProviderOptions(std::vector<nvinfer1::IOptimizationPr
  *
  * @param shape_tensor_values holds "shape tensor -> shape values" for the INT32 shape tensor input across this inference run
  * @param shape_tensor_values_int64 holds "shape tensor -> shape values" for the INT64 shape tensor input across this inference run
+ * @param widen_profile_ranges widens an updated range of an execution tensor dimension to the enclosing power of 2
+ * range, e.g. [3, 5] to [2, 8], so that the engine isn't rebuilt for each new shape. Shape tensor values are exact.
  */
 Status ApplyProfileShapesFromInputTensorValue(std::vector<nvinfer1::IOptimizationProfile*>& trt_profiles,
                                               Ort::KernelContext ctx,
@@ -602,6 +623,7 @@ Status ApplyProfileShapesFromInputTensorValue(std::vector<nvinfer1::IOptimizatio
                                               std::unordered_map<std::string, std::vector<int32_t>>& shape_tensor_values,
                                               std::unordered_map<std::string, std::vector<int64_t>>& shape_tensor_values_int64,
                                               cudaStream_t stream,
+                                              bool widen_profile_ranges,
                                               bool* engine_update) {
   for (size_t i = 0; i < trt_profiles.size(); i++) {
     const std::string& input_name = input->getName();
@@ -749,15 +771,15 @@ Status ApplyProfileShapesFromInputTensorValue(std::vector<nvinfer1::IOptimizatio
 
           // Update minimum dimension
           if (tensor_shape < shape_range[0]) {
-            shape_range[0] = tensor_shape;
-            dims_min.d[j] = static_cast<int32_t>(tensor_shape);
+            shape_range[0] = widen_profile_ranges ? RoundDownToPowerOfTwo(tensor_shape) : tensor_shape;
+            dims_min.d[j] = static_cast<int32_t>(shape_range[0]);
             *engine_update = true;
           }
           // Update maximum dimension
           if (tensor_shape > shape_range[1]) {
-            shape_range[1] = tensor_shape;
+            shape_range[1] = widen_profile_ranges ? RoundUpToPowerOfTwo(tensor_shape) : tensor_shape;
             shape_range[2] = tensor_shape;
-            dims_max.d[j] = static_cast<int32_t>(tensor_shape);
+            dims_max.d[j] = static_cast<int32_t>(shape_range[1]);
             dims_opt.d[j] = static_cast<int32_t>(tensor_shape);
             *engine_update = true;
           }
@@ -1379,6 +1401,7 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     profile_opt_shapes = info.profile_opt_shapes;
     cuda_graph_enable_ = info.cuda_graph_enable;
     engine_hw_compatible_ = info.engine_hw_compatible;
+    widen_profile_ranges_ = info.widen_profile_ranges;
   } else {
     try {
       const std::string max_partition_iterations_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxPartitionIterations);
@@ -1565,6 +1588,11 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
         cuda_graph_enable_ = (std::stoi(cuda_graph_enable_env) == 0 ? false : true);
       }
 
+      const std::string widen_profile_ranges_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kWidenProfileRanges);
+      if (!widen_profile_ranges_env.empty()) {
+        widen_profile_ranges_ = (std::stoi(widen_profile_ranges_env) == 0 ? false : true);
+      }
+
     } catch (const std::invalid_argument& ex) {
       LOGS_DEFAULT(WARNING) << "[TensorRT EP] Invalid Argument (from environment variables): " << ex.what();
     } catch (const std::out_of_range& ex) {
@@ -1762,6 +1790,7 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_ep_context_embed_mode: " << ep_context_embed_mode_
                         << ", trt_cache_prefix: " << cache_prefix_
                         << ", trt_engine_hw_compatible: " << engine_hw_compatible_
+                        << ", trt_widen_profile_ranges: " << widen_profile_ranges_
                         << ", trt_onnx_model_bytestream_size_: " << onnx_model_bytestream_size_;
 }
 
@@ -3286,8 +3315,10 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
       }
     }
 
+    // The weights are refitted from the initializers of the subgraph which are already in memory, so only the
+    // weight-stripped engine is kept in the engine cache and the weights are not duplicated on disk.
     if (weight_stripped_engine_refit_) {
-      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Refit engine from main ONNX file after engine build";
+      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Refit engine from the initializers of the subgraph";
       char* onnx = string_buf.data();
       size_t onnx_size = string_buf.size();
       auto status = RefitEngine(model_path_,
@@ -3297,7 +3328,7 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
                                 onnx,
                                 onnx_size,
                                 trt_engine.get(),
-                                true /* serialize refitted engine to disk */,
+                                false /* serialize refitted engine to disk */,
                                 detailed_build_log_);
       if (status != Status::OK()) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, status.ErrorMessage());
@@ -3568,7 +3599,7 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
       // If there is any input tensor in shape_ranges, it means this input tensor has dynamic shape and its profile shape values have not yet resolved.
       // TRT EP will help determine the min/max/opt profile values based on current input tensor value.
       if (shape_ranges.find(input_name) != shape_ranges.end()) {
-        auto status = ApplyProfileShapesFromInputTensorValue(trt_profiles, ctx, input, shape_ranges, input_indexes, shape_tensor_values, shape_tensor_values_int64, stream, &engine_update);
+        auto status = ApplyProfileShapesFromInputTensorValue(trt_profiles, ctx, input, shape_ranges, input_indexes, shape_tensor_values, shape_tensor_values_int64, stream, widen_profile_ranges_, &engine_update);
         if (status != Status::OK()) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to parse input tensor and generate optimization profiles.");
         }
@@ -3769,7 +3800,7 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
                                   onnx_model_bytestream_,
                                   onnx_model_bytestream_size_,
                                   trt_engine,
-                                  true /* serialize refitted engine to disk */,
+                                  false /* serialize refitted engine to disk */,
                                   detailed_build_log_);
         if (status != Status::OK()) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, status.ErrorMessage());
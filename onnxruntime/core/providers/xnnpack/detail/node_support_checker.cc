@@ -17,6 +17,7 @@
 // each operator provides a helper to check if supported
 #include "core/providers/xnnpack/math/gemm.h"
 #include "core/providers/xnnpack/math/matmul.h"
+#include "core/providers/xnnpack/math/matmul_nbits.h"
 #include "core/providers/xnnpack/math/softmax.h"
 #include "core/providers/xnnpack/nn/average_pool.h"
 #include "core/providers/xnnpack/nn/conv.h"
@@ -43,7 +44,12 @@ const NodeUnit* ClipReluChecker(const NodeUnit& node_unit,
                                 const GraphViewer& graph,
                                 const std::unordered_map<const Node*, const NodeUnit*>& supported_node_unit_map) {
   const NodeUnit* fuse_with{nullptr};
-  static const std::unordered_set<std::string> node_to_be_fuse = {"Conv", "MaxPool", "AveragePool"};
+  // layout sensitive nodes, which are in the NHWC domain once the layout has been transformed
+  static const std::unordered_set<std::string> nhwc_node_to_be_fuse = {"Conv", "ConvTranspose", "MaxPool",
+                                                                       "AveragePool"};
+  // layout insensitive nodes, which stay in the ONNX domain
+  static const std::unordered_set<std::string> onnx_node_to_be_fuse = {"Gemm", "MatMul"};
+  static const std::unordered_set<std::string> ms_node_to_be_fuse = {"MatMulNBits"};
   const Node& node = node_unit.GetNode();
   do {
     // input 0 must come from a node we support
@@ -52,15 +58,28 @@ const NodeUnit* ClipReluChecker(const NodeUnit& node_unit,
       break;
     }
 
-    // must be NHWC Conv or MaxPool in the supported nodes
+    // must be NHWC Conv, ConvTranspose, MaxPool or AveragePool, or Gemm, MatMul or MatMulNBits in the supported
+    // nodes. Gemm, MatMul and MatMulNBits are only fused in the second call to GetCapability, once they have been
+    // assigned to the EP, like the NHWC nodes which only exist after the layout transformation.
     const Node& input0 = input0_edge->GetNode();
+    bool can_fuse_with_input0 = false;
+    if (input0.Domain() == kMSInternalNHWCDomain) {
+      can_fuse_with_input0 = nhwc_node_to_be_fuse.count(input0.OpType()) > 0;
+    } else if (input0.GetExecutionProviderType() == kXnnpackExecutionProvider) {
+      can_fuse_with_input0 = (input0.Domain() == kOnnxDomain && onnx_node_to_be_fuse.count(input0.OpType()) > 0) ||
+                             (input0.Domain() == kMSDomain && ms_node_to_be_fuse.count(input0.OpType()) > 0);
+    }
     if (supported_node_unit_map.count(&input0) == 0 ||
-        input0.Domain() != kMSInternalNHWCDomain ||
-        (node_to_be_fuse.count(input0.OpType()) == 0) ||
+        !can_fuse_with_input0 ||
         supported_node_unit_map.at(&input0)->UnitType() == NodeUnit::Type::QDQGroup) {
       break;
     }
 
+    // the output of input0 is replaced by the output of the activation, so nothing else can consume it
+    if (input0.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(input0)) {
+      break;
+    }
+
     // if Clip check the min/max are constant.
     if (node.OpType() == "Clip") {
       const auto& input_args = node.InputDefs();
@@ -113,6 +132,10 @@ bool NodeSupportChecker::IsNodeSupported(const NodeUnit& nodeunit) {
       {"MatMul", MatMul::IsOnnxNodeSupported},
   };
 
+  static std::unordered_map<std::string, CheckerFn> ms_domain_checkers{
+      {"MatMulNBits", MatMulNBits::IsOnnxNodeSupported},
+  };
+
   bool supported = false;
 
   if (nodeunit.Domain() == onnxruntime::kOnnxDomain) {
@@ -120,6 +143,11 @@ bool NodeSupportChecker::IsNodeSupported(const NodeUnit& nodeunit) {
     if (entry != checkers.cend()) {
       supported = entry->second(nodeunit, graph_);
     }
+  } else if (nodeunit.Domain() == onnxruntime::kMSDomain) {
+    const auto entry = ms_domain_checkers.find(nodeunit.OpType());
+    if (entry != ms_domain_checkers.cend()) {
+      supported = entry->second(nodeunit, graph_);
+    }
   }
 
   return supported;
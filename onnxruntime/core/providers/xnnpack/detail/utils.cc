@@ -289,6 +289,20 @@ std::unique_ptr<IndexedSubGraph::MetaDef> FuseActivation(const NodeUnit& node_un
   return metadef;
 }
 
+std::optional<std::pair<float, float>> GetFusedActivationMinMax(const OpKernelInfo& info) {
+  std::optional<std::pair<float, float>> clip_min_max;
+  if (std::string activation; info.GetAttr<std::string>("activation", &activation).IsOK()) {
+    std::vector<float> activation_params;
+
+    // min/max could be from Clip or Relu
+    if (info.GetAttrs<float>("activation_params", activation_params).IsOK() && activation_params.size() == 2) {
+      clip_min_max = {activation_params[0], activation_params[1]};
+    }
+  }
+
+  return clip_min_max;
+}
+
 std::pair<const onnx::TensorProto*, const onnx::TensorProto*>
 GetQuantizationZeroPointAndScale(const GraphViewer& graphview,
                                  const NodeUnitIODef& io_def) {
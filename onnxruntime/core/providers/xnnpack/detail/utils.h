@@ -5,6 +5,7 @@
 
 #include <limits>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <string>
 #include <unordered_set>
@@ -98,6 +99,9 @@ std::unique_ptr<IndexedSubGraph::MetaDef> FuseActivation(const NodeUnit& conv_un
                                                          const GraphViewer& graph);
 std::unique_ptr<IndexedSubGraph::MetaDef> FuseQDQGroup(const NodeUnit& unit_node);
 
+// returns the min/max of the Clip or Relu activation that FuseActivation fused with the node, if any
+std::optional<std::pair<float, float>> GetFusedActivationMinMax(const OpKernelInfo& info);
+
 bool GetType(const NodeArg& node_arg, int32_t& type);
 
 TensorQuantType GetTensorQuantType(const onnxruntime::NodeUnit& node_unit, int32_t io_index,
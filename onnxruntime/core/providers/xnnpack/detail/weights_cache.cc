@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/detail/weights_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include "core/providers/xnnpack/xnnpack_init.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+namespace {
+// XNN_CACHE_NOT_FOUND in XNNPACK
+constexpr size_t kCacheNotFound = std::numeric_limits<size_t>::max();
+
+size_t AlignOffset(size_t offset) {
+  return (offset + XNN_ALLOCATION_ALIGNMENT - 1) / XNN_ALLOCATION_ALIGNMENT * XNN_ALLOCATION_ALIGNMENT;
+}
+}  // namespace
+
+WeightsCache::WeightsCache() {
+  provider_.context = this;
+  provider_.look_up = LookUp;
+  provider_.reserve_space = ReserveSpace;
+  provider_.look_up_or_insert = LookUpOrInsert;
+  provider_.is_finalized = IsFinalized;
+  provider_.offset_to_addr = OffsetToAddr;
+  provider_.delete_cache = DeleteCache;
+}
+
+WeightsCache::~WeightsCache() {
+  AllocatorDefaultFree(owned_buffer_);
+}
+
+void WeightsCache::Finalize(PrePackedWeights* prepacked_weights) {
+  finalized_ = true;
+
+  if (prepacked_weights != nullptr && owned_buffer_ != nullptr && size_ > 0) {
+    prepacked_weights->buffers_.emplace_back(owned_buffer_, [](void* p) { AllocatorDefaultFree(p); });
+    prepacked_weights->buffer_sizes_.push_back(size_);
+    owned_buffer_ = nullptr;
+  }
+}
+
+void WeightsCache::UseSharedBuffer(void* buffer) {
+  AllocatorDefaultFree(owned_buffer_);
+  owned_buffer_ = nullptr;
+  data_ = static_cast<std::byte*>(buffer);
+}
+
+size_t WeightsCache::LookUp(void* context, const xnn_weights_cache_look_up_key* cache_key) {
+  const auto& cache = *static_cast<const WeightsCache*>(context);
+  auto it = std::find_if(cache.entries_.begin(), cache.entries_.end(), [cache_key](const Entry& entry) {
+    return entry.key.seed == cache_key->seed && entry.key.kernel == cache_key->kernel &&
+           entry.key.bias == cache_key->bias;
+  });
+
+  return it != cache.entries_.end() ? it->offset : kCacheNotFound;
+}
+
+void* WeightsCache::ReserveSpace(void* context, size_t n) {
+  auto& cache = *static_cast<WeightsCache*>(context);
+  if (cache.finalized_ || cache.owned_buffer_ != cache.data_) {
+    return nullptr;
+  }
+
+  const size_t offset = AlignOffset(cache.size_);
+  if (offset + n > cache.capacity_) {
+    const size_t capacity = std::max(offset + n, cache.capacity_ * 2);
+    // called by XNNPACK, so report failures with nullptr instead of throwing
+    void* buffer = nullptr;
+    ORT_TRY {
+      buffer = AllocatorDefaultAlloc(capacity);
+    }
+    ORT_CATCH(const std::bad_alloc&) {
+    }
+
+    if (buffer == nullptr) {
+      return nullptr;
+    }
+
+    if (cache.size_ > 0) {
+      std::memcpy(buffer, cache.data_, cache.size_);
+    }
+
+    AllocatorDefaultFree(cache.owned_buffer_);
+    cache.owned_buffer_ = buffer;
+    cache.data_ = static_cast<std::byte*>(buffer);
+    cache.capacity_ = capacity;
+  }
+
+  return cache.data_ + offset;
+}
+
+size_t WeightsCache::LookUpOrInsert(void* context, const xnn_weights_cache_look_up_key* cache_key,
+                                    void* ptr, size_t size) {
+  auto& cache = *static_cast<WeightsCache*>(context);
+  const size_t existing = LookUp(context, cache_key);
+  if (existing != kCacheNotFound) {
+    return existing;
+  }
+
+  // the weights are packed in place in the space returned by the last call to ReserveSpace
+  auto* bytes = static_cast<std::byte*>(ptr);
+  if (bytes < cache.data_ || bytes + size > cache.data_ + cache.capacity_) {
+    return kCacheNotFound;
+  }
+
+  const size_t offset = static_cast<size_t>(bytes - cache.data_);
+  cache.size_ = offset + size;
+  cache.entries_.push_back(Entry{*cache_key, offset});
+  return offset;
+}
+
+bool WeightsCache::IsFinalized(void* context) {
+  return static_cast<const WeightsCache*>(context)->finalized_;
+}
+
+void* WeightsCache::OffsetToAddr(void* context, size_t offset) {
+  return static_cast<WeightsCache*>(context)->data_ + offset;
+}
+
+xnn_status WeightsCache::DeleteCache(void* /*context*/) {
+  // the cache is owned by the kernel
+  return xnn_status_success;
+}
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights.h"
+
+#include "xnnpack.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+// XNNPACK weights cache that keeps the weights packed by the operators of a kernel in one buffer, so that the buffer
+// can be handed to ORT as the pre-packed weights of the kernel and shared with the kernels of other sessions through
+// the PrepackedWeightsContainer.
+//
+// XNNPACK only stores the offset of the packed weights in an operator and resolves it with offset_to_addr whenever
+// the operator is reshaped, so switching the operators to an identical buffer from another kernel only requires
+// changing the base address of the cache.
+class WeightsCache {
+ public:
+  WeightsCache();
+  ~WeightsCache();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WeightsCache);
+
+  xnn_weights_cache_t Get() { return &provider_; }
+
+  // Called once the operators using the cache have been created, as XNNPACK only runs operators with a finalized
+  // cache. If prepacked_weights is not null and weights were packed, the ownership of the buffer is transferred to
+  // it, and the buffer remains in use until UseSharedBuffer is called.
+  void Finalize(PrePackedWeights* prepacked_weights);
+
+  // Use identical packed weights owned by someone else, which must outlive the operators using the cache.
+  void UseSharedBuffer(void* buffer);
+
+ private:
+  struct Entry {
+    xnn_weights_cache_look_up_key key;
+    size_t offset;
+  };
+
+  static size_t LookUp(void* context, const xnn_weights_cache_look_up_key* cache_key);
+  static void* ReserveSpace(void* context, size_t n);
+  static size_t LookUpOrInsert(void* context, const xnn_weights_cache_look_up_key* cache_key, void* ptr, size_t size);
+  static bool IsFinalized(void* context);
+  static void* OffsetToAddr(void* context, size_t offset);
+  static xnn_status DeleteCache(void* context);
+
+  xnn_weights_cache_provider provider_;
+
+  // owned buffer, null once it was transferred to PrePackedWeights
+  void* owned_buffer_{nullptr};
+  std::byte* data_{nullptr};
+  size_t capacity_{0};
+  size_t size_{0};
+  bool finalized_{false};
+
+  std::vector<Entry> entries_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
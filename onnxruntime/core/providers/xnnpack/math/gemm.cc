@@ -10,10 +10,9 @@ namespace onnxruntime {
 namespace xnnpack {
 
 // Todo -
-// 1. Integrate activation layers - Cliping & Relu
-// 2. Enable C matrix broadcasting - reuse "GemmBroadcastBias" function / logic
-// 3. Enable Quant ops
-// 4. Review possible consolidation of MatMul & Gemm
+// 1. Enable C matrix broadcasting - reuse "GemmBroadcastBias" function / logic
+// 2. Enable Quant ops
+// 3. Review possible consolidation of MatMul & Gemm
 //
 
 bool Gemm::IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph) {
@@ -114,11 +113,13 @@ Gemm::Gemm(const OpKernelInfo& info) : GemmBase(info), XnnpackKernel(info, /*ena
   } else {
     N_ = shapeB->dim(0).dim_value() > 1 ? shapeB->dim(0).dim_value() : 1;
   }
+
+  clip_min_max_ = GetFusedActivationMinMax(info);
 }
 
 Status Gemm::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr,
                      /*out*/ bool& is_packed,
-                     /*out*/ PrePackedWeights*) {
+                     /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
   if (input_idx == 0) {
@@ -181,6 +182,7 @@ Status Gemm::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr,
                            OpTypeToString(op_compute_type_), " returned ", status);
   }
   op0_.reset(p);
+  FinalizeWeightsCache(prepacked_weights);
 
   return Status::OK();
 }
@@ -6,9 +6,8 @@
 #include "core/providers/xnnpack/xnnpack_init.h"
 
 // Todo -
-// 1. Integrate activation layers - Cliping & Relu
-// 2. Enable Quant ops
-// 3. Review possible consolidation of MatMul & Gemm
+// 1. Enable Quant ops
+// 2. Review possible consolidation of MatMul & Gemm
 //
 
 namespace onnxruntime {
@@ -75,11 +74,13 @@ MatMul::MatMul(const OpKernelInfo& info) : XnnpackKernel(info, /*enable_caches*/
   } else if (input_dtype == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16) {
     op_type_ = OpComputeType::op_compute_type_fp16;
   }
+
+  clip_min_max_ = GetFusedActivationMinMax(info);
 }
 
 Status MatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                        /*out*/ bool& is_packed,
-                       /*out*/ PrePackedWeights* /*Not used*/) {
+                       /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
   if (input_idx == 0 || input_idx == 2) {
@@ -101,16 +102,11 @@ Status MatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
     shape_broadcast.push_back(1);
   }
 
-#ifdef XNN_CACHE_ENABLE
   xnn_code_cache_t code_cache = GetCodeCache();
   xnn_weights_cache_t weight_cache = GetWeightsCache();
-#else
-  xnn_code_cache_t code_cache = nullptr;
-  xnn_weights_cache_t weight_cache = nullptr;
-#endif
 
-  float foutput_min = -INFINITY;
-  float foutput_max = INFINITY;
+  float foutput_min = clip_min_max_ ? clip_min_max_->first : -INFINITY;
+  float foutput_max = clip_min_max_ ? clip_min_max_->second : INFINITY;
   if (op_type_ == OpComputeType::op_compute_type_fp32) {
     status = xnn_create_fully_connected_nc_f32(
         shape_broadcast[0],    // size_t input_channels,
@@ -146,6 +142,7 @@ Status MatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
   }
 
   op0_.reset(p);
+  FinalizeWeightsCache(prepacked_weights);
 
   return Status::OK();
 }
@@ -34,6 +34,8 @@ class MatMul : public XnnpackKernel {
   OpComputeType op_type_ = OpComputeType::op_compute_type_invalid;
   std::string op_type_str_ = "";
 
+  std::optional<std::pair<float, float>> clip_min_max_;
+
   XnnpackOperator op0_ = nullptr;
 };
 
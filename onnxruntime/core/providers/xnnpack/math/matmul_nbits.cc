@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "matmul_nbits.h"
+
+#include "core/framework/float16.h"
+#include "core/framework/op_node_proto_helper.h"
+#include "core/providers/xnnpack/xnnpack_init.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+namespace {
+enum InputIndex : size_t {
+  A,
+  B,
+  scales,
+  zero_points,
+  g_idx,
+  bias,
+};
+
+// zero point of the 4-bit values when the zero_points input is not provided
+constexpr uint8_t kDefaultZeroPoint = 8;
+}  // namespace
+
+bool MatMulNBits::IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph) {
+  bool supported = false;
+  const onnxruntime::Node& node = node_unit.GetNode();
+
+  // use do {} while(false) so it's easier to set a breakpoint on the return
+  do {
+    const auto& input_defs = node.InputDefs();
+    auto input_exists = [&input_defs](size_t idx) {
+      return input_defs.size() > idx && input_defs[idx]->Exists();
+    };
+
+    // Support only float
+    const auto* A_type = input_defs[InputIndex::A]->TypeAsProto();
+    if (A_type == nullptr || A_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      break;
+    }
+
+    const auto* A_shape = input_defs[InputIndex::A]->Shape();
+    if (A_shape == nullptr || A_shape->dim_size() < 1) {
+      break;
+    }
+
+    ProtoHelperNodeContext nc(node);
+    OpNodeProtoHelper info(&nc);
+    const int64_t K = info.GetAttrOrDefault<int64_t>("K", 0);
+    const int64_t N = info.GetAttrOrDefault<int64_t>("N", 0);
+    const int64_t bits = info.GetAttrOrDefault<int64_t>("bits", 4);
+    const int64_t block_size = info.GetAttrOrDefault<int64_t>("block_size", 0);
+    const int64_t accuracy_level = info.GetAttrOrDefault<int64_t>("accuracy_level", 0);
+
+    // XNNPACK quantizes A to int8, so only take the nodes which allow the int8 compute type
+    if (bits != 4 || accuracy_level != 4 || K <= 0 || N <= 0) {
+      break;
+    }
+
+    // blocks must be a power of 2 no smaller than 32 and evenly divide K so that B has no padding
+    if (block_size < 32 || (block_size & (block_size - 1)) != 0 || K % block_size != 0) {
+      break;
+    }
+
+    // B and scales must be constant
+    if (!graph.IsConstantInitializer(input_defs[InputIndex::B]->Name(), true) ||
+        !graph.IsConstantInitializer(input_defs[InputIndex::scales]->Name(), true)) {
+      break;
+    }
+
+    // XNNPACK takes a single zero point for the whole of B
+    if (input_exists(InputIndex::zero_points) || input_exists(InputIndex::g_idx)) {
+      break;
+    }
+
+    if (input_exists(InputIndex::bias) &&
+        !graph.IsConstantInitializer(input_defs[InputIndex::bias]->Name(), true)) {
+      break;
+    }
+
+    supported = true;
+
+  } while (false);
+
+  return supported;
+}
+
+MatMulNBits::MatMulNBits(const OpKernelInfo& info) : XnnpackKernel(info, /*enable_caches*/ true) {
+  K_ = narrow<size_t>(info.GetAttr<int64_t>("K"));
+  N_ = narrow<size_t>(info.GetAttr<int64_t>("N"));
+  block_size_ = narrow<size_t>(info.GetAttr<int64_t>("block_size"));
+
+  clip_min_max_ = GetFusedActivationMinMax(info);
+
+  struct xnn_operator* p = nullptr;
+  auto status = xnn_create_convert_nc_f32_qd8(0, &p);
+  ORT_ENFORCE(status == xnn_status_success, "xnn_create_convert_nc_f32_qd8 failed. Status:", status);
+  quantize_op_.reset(p);
+}
+
+Status MatMulNBits::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr /*alloc*/,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // the scales and bias are constant and read from the kernel info when B is packed
+  if (input_idx != InputIndex::B) {
+    return Status::OK();
+  }
+
+  const Tensor* scales = nullptr;
+  ORT_RETURN_IF_NOT(Info().TryGetConstantInput(InputIndex::scales, &scales), "scales must be a constant initializer");
+  const size_t blocks_per_col = K_ / block_size_;
+  ORT_RETURN_IF_NOT(narrow<size_t>(scales->Shape().Size()) == N_ * blocks_per_col,
+                    "scales has unexpected shape ", scales->Shape());
+
+  const Tensor* bias = nullptr;
+  const auto& input_defs = Node().InputDefs();
+  if (input_defs.size() > InputIndex::bias && input_defs[InputIndex::bias]->Exists()) {
+    ORT_RETURN_IF_NOT(Info().TryGetConstantInput(InputIndex::bias, &bias), "bias must be a constant initializer");
+  }
+
+  // B is [N][K / block_size][block_size / 2] with the lower nibble holding the even k, which is the [N][K] layout
+  // XNNPACK expects when the weights are not transposed. XNNPACK takes the block scales as bf16.
+  const float* scales_data = scales->Data<float>();
+  std::vector<uint16_t> bf16_scales(N_ * blocks_per_col);
+  for (size_t i = 0; i < bf16_scales.size(); ++i) {
+    bf16_scales[i] = BFloat16(scales_data[i]).val;
+  }
+
+  float foutput_min = clip_min_max_ ? clip_min_max_->first : -INFINITY;
+  float foutput_max = clip_min_max_ ? clip_min_max_->second : INFINITY;
+
+  const float* bias_data = bias != nullptr ? bias->Data<float>() : nullptr;
+
+  struct xnn_operator* p = nullptr;
+  xnn_status status = xnn_create_fully_connected_nc_qd8_f32_qb4w(
+      K_,                  // size_t input_channels,
+      N_,                  // size_t output_channels,
+      K_,                  // size_t input_stride,
+      N_,                  // size_t output_stride,
+      block_size_,         // size_t block_size,
+      kDefaultZeroPoint,   // uint8_t kernel_zero_point,
+      bf16_scales.data(),  // const uint16_t* kernel_scale,
+      tensor.DataRaw(),    // const void* kernel,
+      bias_data,           // const float* bias,
+      foutput_min,
+      foutput_max,
+      0,  // flags
+      GetCodeCache(),
+      GetWeightsCache(),
+      &p);
+
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_create_fully_connected_nc_qd8_f32_qb4w returned ", status);
+  }
+
+  op0_.reset(p);
+  FinalizeWeightsCache(prepacked_weights);
+  is_packed = true;
+
+  return Status::OK();
+}
+
+Status MatMulNBits::Compute(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(InputIndex::A);
+  const auto& a_shape = a->Shape();
+  const size_t rank = a_shape.NumDimensions();
+  ORT_RETURN_IF_NOT(narrow<size_t>(a_shape[rank - 1]) == K_, "A has unexpected shape ", a_shape);
+
+  TensorShapeVector y_dims = a_shape.AsShapeVector();
+  y_dims[rank - 1] = narrow<int64_t>(N_);
+  Tensor* y = ctx->Output(0, TensorShape(y_dims));
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const size_t batch = narrow<size_t>(a_shape.SizeToDimension(rank - 1));
+  pthreadpool_t threadpool = GetThreadPool();
+
+  // quantized A, plus the extra bytes XNNPACK kernels may read past the end. one set of parameters per row.
+  xnn_allocator* allocator = GetStoredAllocator().second;
+  auto deallocator = [allocator](void* ptr) { allocator->aligned_deallocate(allocator->context, ptr); };
+  std::unique_ptr<void, decltype(deallocator)> quantized_a(
+      allocator->aligned_allocate(allocator->context, XNN_ALLOCATION_ALIGNMENT, batch * K_ + XNN_EXTRA_BYTES),
+      deallocator);
+  std::vector<xnn_dynamic_quantization_params> quantization_params(batch + XNN_EXTRA_QUANTIZATION_PARAMS);
+
+  xnn_status status = xnn_reshape_convert_nc_f32_qd8(quantize_op_.get(), batch, K_, K_, K_, threadpool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_reshape_convert_nc_f32_qd8 returned ", status);
+  }
+
+  status = xnn_setup_convert_nc_f32_qd8(quantize_op_.get(), a->Data<float>(),
+                                        static_cast<int8_t*>(quantized_a.get()), quantization_params.data());
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_setup_convert_nc_f32_qd8 returned ", status);
+  }
+
+  status = xnn_run_operator(quantize_op_.get(), threadpool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_run_operator returned ", status);
+  }
+
+  status = xnn_reshape_fully_connected_nc_qd8_f32_qb4w(op0_.get(), batch, threadpool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_reshape_fully_connected_nc_qd8_f32_qb4w returned ", status);
+  }
+
+  status = xnn_setup_fully_connected_nc_qd8_f32_qb4w(op0_.get(), static_cast<const int8_t*>(quantized_a.get()),
+                                                     y->MutableData<float>(), quantization_params.data());
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_setup_fully_connected_nc_qd8_f32_qb4w returned ", status);
+  }
+
+  status = xnn_run_operator(op0_.get(), threadpool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_run_operator returned ", status);
+  }
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(MatMulNBits, kMSDomain, 1, kXnnpackExecutionProvider,
+                        KernelDefBuilder()
+                            .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+                            .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+                        MatMulNBits);
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
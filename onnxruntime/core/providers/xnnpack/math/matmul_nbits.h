@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/xnnpack/xnnpack_kernel.h"
+#include "core/framework/allocator.h"
+#include "core/providers/xnnpack/detail/utils.h"
+#include "core/common/common.h"
+
+namespace onnxruntime {
+class GraphViewer;
+class Node;
+namespace xnnpack {
+
+// MatMulNBits with 4-bit blockwise quantized B. A is dynamically quantized to int8 per row, which matches the
+// accuracy_level 4 (int8 compute) path of the CPU kernel.
+class MatMulNBits : public XnnpackKernel {
+ public:
+  MatMulNBits(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* /*context*/) const override;
+
+  // Required for checking XNNpack restrictions on ORT side
+  static bool IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph);
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+ private:
+  size_t K_;
+  size_t N_;
+  size_t block_size_;
+
+  std::optional<std::pair<float, float>> clip_min_max_;
+
+  // converts A to int8 with per row quantization parameters
+  XnnpackOperator quantize_op_ = nullptr;
+  XnnpackOperator op0_ = nullptr;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -16,7 +16,7 @@ namespace xnnpack {
 // use PrePack to handle the weight layout change as that's not a simple NCHW -> NHWC transpose
 Status ConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                               /*out*/ bool& is_packed,
-                              /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+                              /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
   // only layout of weight input is adjusted via PrePack
   const bool conv_type_is_float = (conv_type_ == OpComputeType::op_compute_type_fp32 ||
@@ -97,6 +97,7 @@ Status ConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr
     // we can create the kernel now
     auto ret = CreateKernel();
     ORT_RETURN_IF_ERROR(ret);
+    FinalizeWeightsCache(prepacked_weights);
   }
 
   return Status::OK();
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "core/framework/op_kernel.h"
+#include "core/providers/xnnpack/detail/weights_cache.h"
 #include "core/providers/xnnpack/xnnpack_execution_provider.h"
 #include "xnnpack.h"
 
@@ -17,55 +18,39 @@ class XnnpackKernel : public OpKernel {
       : OpKernel{info},
         xnnpack_threadpool_{
             static_cast<const XnnpackExecutionProvider*>(info.GetExecutionProvider())->GetPrivateThreadPool()},
-        caches_{enable_caches} {
+        weights_cache_{enable_caches ? std::make_unique<WeightsCache>() : nullptr} {
   }
   [[nodiscard]] pthreadpool* GetThreadPool() const {
     return xnnpack_threadpool_;
   }
 
-  // see comment below about enabling code cache
-  // xnn_code_cache_t GetCodeCache() { return caches_.auto_code_cache.get();}
+  // the code cache is not exposed via the public xnnpack.h header
   xnn_code_cache_t GetCodeCache() { return nullptr; }
-  xnn_weights_cache_t GetWeightsCache() { return caches_.auto_weights_cache.get(); }
-
- private:
-  pthreadpool* xnnpack_threadpool_;
-
-  // Helper class to wrap usage of the XNNPACK weights and code caches.
-  // NOTE: Currently creating/freeing the code cache is not exposed via the public xnnpack.h header so usage is
-  // commented out. If we need to use it, we'll need to add the 'src' directory of XNNPACK to the include path
-  // and #include "xnnpack/cache.h"
-  struct Caches {
-    Caches(bool enable)
-        :  // auto_code_cache(nullptr, xnn_release_code_cache),
-          auto_weights_cache(nullptr, xnn_delete_weights_cache) {
-      if (enable) {
-#ifdef XNN_CACHE_ENABLE
-        xnn_status status = xnn_status_success;
-#if XNN_PLATFORM_JIT
-        // status = xnn_init_code_cache(&code_cache_);
-        // ORT_ENFORCE(status == xnn_status_success, "Failed to initialize XNNPACK code cache");)
-        // auto_code_cache.reset(&code_cache_);
-#endif
-        // status = xnn_init_weights_cache(&weights_cache_);
-        xnn_weights_cache_t weights_cache_provider = nullptr;
-        status = xnn_create_weights_cache(&weights_cache, 0);
-        ORT_ENFORCE(status == xnn_status_success, "Failed to create XNNPACK weights cache");
-        auto_weights_cache.reset(weights_cache);
-#endif
-      }
+  xnn_weights_cache_t GetWeightsCache() { return weights_cache_ ? weights_cache_->Get() : nullptr; }
+
+  // Kernels using the weights cache call this in PrePack once their XNNPACK operators are created. If
+  // prepacked_weights is not null, the weights packed by the operators are handed to ORT so that they can be shared
+  // with other sessions.
+  void FinalizeWeightsCache(PrePackedWeights* prepacked_weights) {
+    if (weights_cache_) {
+      weights_cache_->Finalize(prepacked_weights);
     }
+  }
 
-    // std::unique_ptr<xnn_code_cache, decltype(&xnn_release_code_cache)> auto_code_cache;
-    std::unique_ptr<xnn_weights_cache_provider, decltype(&xnn_delete_weights_cache)> auto_weights_cache;
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int /*input_idx*/,
+                                   /*out*/ bool& used_shared_buffers) override {
+    used_shared_buffers = false;
+    if (weights_cache_ && !prepacked_buffers.empty()) {
+      weights_cache_->UseSharedBuffer(prepacked_buffers[0].get());
+      used_shared_buffers = true;
+    }
 
-    // private:
-    // #if defined(XNN_CACHE_ENABLE) && XNN_PLATFORM_JIT
-    //   xnn_code_cache code_cache_;
-    // #endif
-  };
+    return Status::OK();
+  }
 
-  Caches caches_;
+ private:
+  pthreadpool* xnnpack_threadpool_;
+  std::unique_ptr<WeightsCache> weights_cache_;
 };
 }  // namespace xnnpack
 }  // namespace onnxruntime
@@ -0,0 +1,210 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/graph_capture_shape_buckets.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/common/parse_string.h"
+#include "core/common/safeint.h"
+#include "core/framework/data_transfer_manager.h"
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+// Copies `num_bytes` bytes between the buffers of two tensors that may be on different devices.
+Status CopyBytes(const DataTransferManager& data_transfer_mgr, const void* src, const OrtMemoryInfo& src_location,
+                 void* dst, const OrtMemoryInfo& dst_location, size_t num_bytes) {
+  if (num_bytes == 0) {
+    return Status::OK();
+  }
+
+  const auto* byte_type = DataTypeImpl::GetType<uint8_t>();
+  const TensorShape shape({static_cast<int64_t>(num_bytes)});
+  Tensor src_view(byte_type, shape, const_cast<void*>(src), src_location);
+  Tensor dst_view(byte_type, shape, dst, dst_location);
+  return data_transfer_mgr.CopyTensor(src_view, dst_view);
+}
+}  // namespace
+
+Status GraphCaptureShapeBuckets::Parse(const std::string& config, std::unique_ptr<GraphCaptureShapeBuckets>& buckets) {
+  const auto colon = config.find(':');
+  ORT_RETURN_IF(colon == std::string::npos, "Expected graph capture shape buckets of the form <axis>:<size>,..., got ",
+                config);
+
+  size_t axis = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(config.substr(0, colon), axis),
+                    "Failed to parse the axis of graph capture shape buckets: ", config);
+
+  std::vector<int64_t> sizes;
+  std::istringstream sizes_stream(config.substr(colon + 1));
+  std::string size_str;
+  while (std::getline(sizes_stream, size_str, ',')) {
+    int64_t size = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(size_str, size) && size > 0,
+                      "Invalid graph capture shape bucket size: ", size_str);
+    sizes.push_back(size);
+  }
+  ORT_RETURN_IF(sizes.empty(), "No graph capture shape bucket sizes in: ", config);
+
+  std::sort(sizes.begin(), sizes.end());
+  sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+
+  buckets.reset(new GraphCaptureShapeBuckets(axis, std::move(sizes)));
+  return Status::OK();
+}
+
+Status GraphCaptureShapeBuckets::Run(InferenceSession& session, const RunOptions& run_options,
+                                     gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                     gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches) {
+  ORT_RETURN_IF(p_fetches == nullptr, "Output vector pointer is NULL");
+
+  int64_t length = -1;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF_NOT(feeds[i].IsTensor(), "Graph capture shape buckets only support tensor feeds, ", feed_names[i],
+                      " is not a tensor.");
+    const auto& shape = feeds[i].Get<Tensor>().Shape();
+    if (shape.NumDimensions() > axis_) {
+      ORT_RETURN_IF(length != -1 && shape[axis_] != length, "Feeds have different sizes along axis ", axis_,
+                    " of the graph capture shape buckets.");
+      length = shape[axis_];
+    }
+  }
+
+  const auto bucket_it = std::lower_bound(sizes_.begin(), sizes_.end(), length);
+  if (length == -1 || bucket_it == sizes_.end()) {
+    // no bucket to pad to, run without capturing a graph
+    RunOptions uncaptured_run_options(run_options);
+    ORT_RETURN_IF_ERROR(uncaptured_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation,
+                                                                            "-1"));
+    return session.RunImpl(uncaptured_run_options, feed_names, feeds, output_names, p_fetches, nullptr);
+  }
+
+  const auto bucket_index = static_cast<size_t>(bucket_it - sizes_.begin());
+  const int64_t bucket_size = *bucket_it;
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& bucket = buckets_[bucket_index];
+  if (bucket.feed_names.empty()) {
+    bucket.feed_names.assign(feed_names.begin(), feed_names.end());
+    bucket.output_names.assign(output_names.begin(), output_names.end());
+    bucket.feeds.resize(feeds.size());
+  }
+  ORT_RETURN_IF_NOT(std::equal(feed_names.begin(), feed_names.end(), bucket.feed_names.begin(),
+                               bucket.feed_names.end()) &&
+                        std::equal(output_names.begin(), output_names.end(), bucket.output_names.begin(),
+                                   bucket.output_names.end()),
+                    "The feeds and fetches of a run must be the same for every run of a graph capture shape bucket.");
+
+  ORT_RETURN_IF_ERROR(CopyFeeds(session, feeds, length, bucket_size, bucket));
+
+  // annotation id 0 is reserved
+  RunOptions bucket_run_options(run_options);
+  ORT_RETURN_IF_ERROR(bucket_run_options.config_options.AddConfigEntry(
+      kOrtRunOptionsConfigCudaGraphAnnotation, std::to_string(bucket_index + 1).c_str()));
+
+  // the first run allocates the fetches, the following runs write into them so the captured graph does too
+  ORT_RETURN_IF_ERROR(session.RunImpl(bucket_run_options, bucket.feed_names, bucket.feeds, bucket.output_names,
+                                      &bucket.fetches, nullptr));
+
+  return CopyFetches(session, bucket, length, bucket_size, *p_fetches);
+}
+
+Status GraphCaptureShapeBuckets::CopyFeeds(const InferenceSession& session, gsl::span<const OrtValue> feeds,
+                                           int64_t length, int64_t bucket_size, Bucket& bucket) const {
+  const auto& data_transfer_mgr = session.GetDataTransferManager();
+  const OrtMemoryInfo cpu_location(CPU, OrtAllocatorType::OrtDeviceAllocator);
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const auto& src = feeds[i].Get<Tensor>();
+    const bool padded = src.Shape().NumDimensions() > axis_;
+    TensorShape shape = src.Shape();
+    if (padded) {
+      shape[axis_] = bucket_size;
+    }
+
+    if (!bucket.feeds[i].IsAllocated()) {
+      auto allocator = session.GetAllocator(src.Location());
+      ORT_RETURN_IF_NOT(allocator, "No allocator for the location of feed ", bucket.feed_names[i]);
+      Tensor::InitOrtValue(src.DataType(), shape, std::move(allocator), bucket.feeds[i]);
+    }
+
+    auto& dst = *bucket.feeds[i].GetMutable<Tensor>();
+    ORT_RETURN_IF_NOT(dst.DataType() == src.DataType() && dst.Shape() == shape &&
+                          dst.Location().device == src.Location().device,
+                      "Feed ", bucket.feed_names[i], " doesn't match the feed the graph of its bucket was captured with.");
+
+    if (!padded) {
+      ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(src, dst));
+      continue;
+    }
+
+    const size_t row_bytes = SafeInt<size_t>(src.Shape().SizeFromDimension(axis_ + 1)) * src.DataType()->Size();
+    const size_t src_block_bytes = SafeInt<size_t>(length) * row_bytes;
+    const size_t dst_block_bytes = SafeInt<size_t>(bucket_size) * row_bytes;
+    const std::vector<char> zeros(dst_block_bytes - src_block_bytes, 0);
+
+    const auto* src_data = static_cast<const char*>(src.DataRaw());
+    auto* dst_data = static_cast<char*>(dst.MutableDataRaw());
+    for (int64_t outer = 0, num_outer = src.Shape().SizeToDimension(axis_); outer < num_outer; ++outer) {
+      ORT_RETURN_IF_ERROR(CopyBytes(data_transfer_mgr, src_data + outer * src_block_bytes, src.Location(),
+                                    dst_data + outer * dst_block_bytes, dst.Location(), src_block_bytes));
+      ORT_RETURN_IF_ERROR(CopyBytes(data_transfer_mgr, zeros.data(), cpu_location,
+                                    dst_data + outer * dst_block_bytes + src_block_bytes, dst.Location(),
+                                    zeros.size()));
+    }
+  }
+
+  return Status::OK();
+}
+
+Status GraphCaptureShapeBuckets::CopyFetches(const InferenceSession& session, const Bucket& bucket, int64_t length,
+                                             int64_t bucket_size, std::vector<OrtValue>& fetches) const {
+  const auto& data_transfer_mgr = session.GetDataTransferManager();
+  fetches.resize(bucket.fetches.size());
+
+  for (size_t i = 0; i < bucket.fetches.size(); ++i) {
+    ORT_RETURN_IF_NOT(bucket.fetches[i].IsTensor(), "Graph capture shape buckets only support tensor fetches, ",
+                      bucket.output_names[i], " is not a tensor.");
+    const auto& src = bucket.fetches[i].Get<Tensor>();
+    const bool sliced = src.Shape().NumDimensions() > axis_ && src.Shape()[axis_] == bucket_size;
+    TensorShape shape = src.Shape();
+    if (sliced) {
+      shape[axis_] = length;
+    }
+
+    if (!fetches[i].IsAllocated()) {
+      auto allocator = session.GetAllocator(src.Location());
+      ORT_RETURN_IF_NOT(allocator, "No allocator for the location of fetch ", bucket.output_names[i]);
+      Tensor::InitOrtValue(src.DataType(), shape, std::move(allocator), fetches[i]);
+    }
+
+    auto& dst = *fetches[i].GetMutable<Tensor>();
+    ORT_RETURN_IF_NOT(dst.DataType() == src.DataType() && dst.Shape() == shape, "Pre-allocated fetch ",
+                      bucket.output_names[i], " has shape ", dst.Shape(), ", expected ", shape);
+
+    if (!sliced) {
+      ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(src, dst));
+      continue;
+    }
+
+    const size_t row_bytes = SafeInt<size_t>(src.Shape().SizeFromDimension(axis_ + 1)) * src.DataType()->Size();
+    const size_t src_block_bytes = SafeInt<size_t>(bucket_size) * row_bytes;
+    const size_t dst_block_bytes = SafeInt<size_t>(length) * row_bytes;
+
+    const auto* src_data = static_cast<const char*>(src.DataRaw());
+    auto* dst_data = static_cast<char*>(dst.MutableDataRaw());
+    for (int64_t outer = 0, num_outer = src.Shape().SizeToDimension(axis_); outer < num_outer; ++outer) {
+      ORT_RETURN_IF_ERROR(CopyBytes(data_transfer_mgr, src_data + outer * src_block_bytes, src.Location(),
+                                    dst_data + outer * dst_block_bytes, dst.Location(), dst_block_bytes));
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
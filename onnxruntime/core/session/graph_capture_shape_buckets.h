@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+/**
+ * Lets a session that uses graph capture (e.g. CUDA graphs) run inputs of varying length.
+ *
+ * A captured graph replays with the shapes and buffer addresses of the capturing run. This class pads the feeds of
+ * a run along one axis up to the smallest configured bucket, copies them into buffers kept per bucket, and runs the
+ * session with the graph annotation id of the bucket, so each bucket is captured once and then replayed.
+ * Fetches that have the bucket size along the axis are sliced back to the length of the feeds.
+ * Runs longer than the largest bucket are not captured.
+ *
+ * The padded rows are zero. The results of the rows that are not padding are only unchanged if the model does not
+ * combine values along the axis, or masks the padding, as LLM decoders and BERT models with an attention mask do.
+ *
+ * The buckets are configured with kOrtSessionOptionsConfigGraphCaptureShapeBuckets.
+ */
+class GraphCaptureShapeBuckets {
+ public:
+  // Parses a configuration of the form "<axis>:<size>,<size>,...".
+  static Status Parse(const std::string& config, std::unique_ptr<GraphCaptureShapeBuckets>& buckets);
+
+  Status Run(InferenceSession& session, const RunOptions& run_options,
+             gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches);
+
+ private:
+  GraphCaptureShapeBuckets(size_t axis, std::vector<int64_t> sizes)
+      : axis_(axis), sizes_(std::move(sizes)), buckets_(sizes_.size()) {}
+
+  // Buffers whose addresses are captured in the graph of a bucket.
+  struct Bucket {
+    std::vector<std::string> feed_names;
+    std::vector<std::string> output_names;
+    InlinedVector<OrtValue> feeds;
+    std::vector<OrtValue> fetches;
+  };
+
+  Status CopyFeeds(const InferenceSession& session, gsl::span<const OrtValue> feeds, int64_t length,
+                   int64_t bucket_size, Bucket& bucket) const;
+  Status CopyFetches(const InferenceSession& session, const Bucket& bucket, int64_t length, int64_t bucket_size,
+                     std::vector<OrtValue>& fetches) const;
+
+  const size_t axis_;
+  // ascending
+  const std::vector<int64_t> sizes_;
+
+  std::vector<Bucket> buckets_;
+
+  // runs that replay a graph use the same buffers, so they are serialized
+  OrtMutex mutex_;
+};
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <list>
@@ -66,9 +67,14 @@
 #include "core/optimizer/stft_decomposition.h"
 #endif
 #include "core/session/environment.h"
+#include "core/session/graph_capture_shape_buckets.h"
+#include "core/session/streaming_state.h"
 #include "core/session/user_logging_sink.h"
 #include "core/session/IOBinding.h"
+#include "core/session/run_context.h"
 #include "core/session/inference_session_utils.h"
+#include "core/session/micro_batch_run.h"
+#include "core/session/optimized_model_cache.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
 #include "core/util/protobuf_parsing_utils.h"
@@ -507,6 +513,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.allow_spinning = allow_intra_op_spinning;
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
+        to.adaptive_cost_model =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpAdaptiveCostModel, "0") == "1";
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpAdaptiveSpinning, "0") == "1";
 
         // Set custom threading functions
         to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
@@ -515,6 +525,15 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         if (session_options_.config_options.TryGetConfigEntry(kOrtSessionOptionsConfigIntraOpThreadAffinities, to.affinity_str)) {
           ORT_ENFORCE(!to.affinity_str.empty(), "Affinity string must not be empty");
         }
+        const std::string numa_node =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpThreadNumaNode, "");
+        if (!numa_node.empty()) {
+          ORT_ENFORCE(TryParseStringWithClassicLocale<int>(numa_node, to.numa_node) && to.numa_node >= 0,
+                      "Invalid NUMA node index: ", numa_node);
+        }
+        to.performance_cores_only =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpPerformanceCoresOnly,
+                                                               "0") == "1";
         to.auto_set_affinity = to.thread_pool_size == 0 &&
                                session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                                to.affinity_str.empty();
@@ -570,10 +589,27 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   }
 
   session_profiler_.Initialize(session_logger_);
+  graph_transformer_mgr_.SetProfiler(&session_profiler_);
+  const std::string profiling_trace_format =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingTraceFormat, "event_list");
+  if (profiling_trace_format == "timeline") {
+    session_profiler_.SetTraceFormat(profiling::TraceFormat::kTimeline);
+  } else {
+    ORT_ENFORCE(profiling_trace_format == "event_list", "Invalid value for ", kOrtSessionOptionsProfilingTraceFormat,
+                ": ", profiling_trace_format);
+  }
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
 
+  const std::string node_latency_sampling_interval =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsNodeLatencySamplingInterval, "0");
+  uint64_t sampling_interval = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(node_latency_sampling_interval, sampling_interval),
+              "Invalid value for ", kOrtSessionOptionsNodeLatencySamplingInterval, ": ",
+              node_latency_sampling_interval);
+  session_profiler_.GetNodeLatencyStats().Enable(sampling_interval);
+
   telemetry_ = {};
 }
 
@@ -723,6 +759,36 @@ InferenceSession::~InferenceSession() {
     }
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  if (memory_tracer_) {
+    auto status = memory_tracer_->WriteToFile(memory_trace_file_);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, ERROR) << status.ErrorMessage();
+    }
+  }
+
+  if (is_inited_ && !warmup_shapes_file_.empty() && warmup_shapes_changed_ && !warmup_shapes_.empty()) {
+    auto status = inference_session_utils::SaveWarmupShapesFile(warmup_shapes_file_, warmup_shapes_);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, ERROR) << status.ErrorMessage();
+    }
+  }
+
+  if (is_inited_ && !tuning_results_file_.empty()) {
+    ORT_TRY {
+      auto status = SaveTuningResultsFile();
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, ERROR) << status.ErrorMessage();
+      }
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        LOGS(*session_logger_, ERROR) << "Error while saving the tuning results: " << e.what();
+      });
+    }
+  }
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
   // Unregister the session and ETW callbacks
 #ifdef _WIN32
   std::lock_guard<OrtMutex> lock(active_sessions_mutex_);
@@ -972,7 +1038,13 @@ common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std
   }
 
   if (session_profiler_.IsEnabled()) {
-    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, event_name, tp);
+    if (model_proto_parse_time_.has_value()) {
+      const auto parse_us = std::chrono::duration_cast<std::chrono::microseconds>(*model_proto_parse_time_).count();
+      session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, event_name, tp,
+                                              {{"model_proto_parse_us", std::to_string(parse_us)}});
+    } else {
+      session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, event_name, tp);
+    }
   }
 
   return status;
@@ -990,8 +1062,34 @@ common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
 #endif
     const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
                                                  kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
-    return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                                    *session_logger_,
+    size_t initializer_min_size = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(session_options_.config_options.GetConfigOrDefault(
+                                                          kOrtSessionOptionsConfigMapInlineInitializersMinSize, "0"),
+                                                      initializer_min_size),
+                      "Invalid value for ", kOrtSessionOptionsConfigMapInlineInitializersMinSize);
+#if !defined(__wasm__)
+    // protobuf can't parse a message larger than 2GB, so the data of the initializers of such a model is left in the file
+    size_t model_file_size = 0;
+    if (initializer_min_size == 0 &&
+        Env::Default().GetFileLength(model_location_.c_str(), model_file_size).IsOK() &&
+        model_file_size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+      initializer_min_size = 1024;
+    }
+#endif
+
+    // parse the protobuf separately so the profile shows it apart from building and resolving the graph
+    ModelProto model_proto;
+    const auto parse_start = std::chrono::high_resolution_clock::now();
+    if (initializer_min_size > 0) {
+      ORT_RETURN_IF_ERROR(onnxruntime::Model::LoadWithInitializersInFile(model_location_, initializer_min_size,
+                                                                         model_proto));
+    } else {
+      ORT_RETURN_IF_ERROR(onnxruntime::Model::Load(model_location_, model_proto));
+    }
+    model_proto_parse_time_ = std::chrono::high_resolution_clock::now() - parse_start;
+
+    return onnxruntime::Model::Load(std::move(model_proto), model_location_, model,
+                                    HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
                                     ModelOptions(true, strict_shape_type_inference));
   };
 
@@ -1004,6 +1102,66 @@ common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
   return Status::OK();
 }
 
+Status InferenceSession::LoadFromOptimizedModelCache(std::unique_ptr<OptimizedModelCache>& cache, std::string& key,
+                                                     bool& loaded) {
+  loaded = false;
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, "");
+  // ORT format models are optimized already
+  if (cache_dir.empty() || !ort_format_model_bytes_.empty()) {
+    return Status::OK();
+  }
+
+  // user provided initializers are not part of the key, and may not be folded into a cached model
+  bool has_user_initializers = !session_options_.initializers_to_share_map.empty();
+#if !defined(DISABLE_EXTERNAL_INITIALIZERS)
+  has_user_initializers = has_user_initializers ||
+                          !session_options_.external_initializers.empty() ||
+                          !session_options_.external_initializer_files_mmap.empty();
+#endif
+  if (has_user_initializers || !session_options_.optimized_model_filepath.empty()) {
+    LOGS(*session_logger_, INFO) << "The optimized model cache is not used as the session has user provided "
+                                    "initializers or saves the optimized model.";
+    return Status::OK();
+  }
+
+  auto status = OptimizedModelCache::ComputeKey(*model_, model_location_, session_options_, execution_providers_,
+                                                optimizers_to_disable_, key);
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "The optimized model cache is not used: " << status.ErrorMessage();
+    return Status::OK();
+  }
+  cache = std::make_unique<OptimizedModelCache>(ToPathString(cache_dir));
+
+  const PathString cached_model_path = cache->GetModelPath(key);
+  std::error_code ec;
+  if (!std::filesystem::exists(cached_model_path, ec)) {
+    LOGS(*session_logger_, INFO) << "The optimized model cache has no entry " << key << ".";
+    return Status::OK();
+  }
+
+  std::shared_ptr<Model> cached_model;
+  const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
+                                               kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+  status = Model::Load(cached_model_path, cached_model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
+                       *session_logger_, ModelOptions(true, strict_shape_type_inference));
+  if (!status.IsOK()) {
+    // the entry is replaced once this session has optimized the model
+    LOGS(*session_logger_, WARNING) << "Failed to load the optimized model " << ToUTF8String(cached_model_path)
+                                    << " from the cache: " << status.ErrorMessage();
+    return Status::OK();
+  }
+
+  // the model metadata refers to the graph inputs and outputs of the model
+  ORT_RETURN_IF_ERROR(SaveModelMetadata(*cached_model));
+  model_ = std::move(cached_model);
+  model_location_ = cached_model_path;
+  loaded = true;
+  LOGS(*session_logger_, INFO) << "Loaded the optimized model " << ToUTF8String(cached_model_path)
+                               << " from the cache.";
+  return Status::OK();
+}
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -1061,11 +1219,13 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
   auto loader = [this, model_data, model_data_len](std::shared_ptr<onnxruntime::Model>& model) {
     ModelProto model_proto;
 
+    const auto parse_start = std::chrono::high_resolution_clock::now();
     const bool result = model_proto.ParseFromArray(model_data, model_data_len);
     if (!result) {
       return Status(common::ONNXRUNTIME, common::INVALID_PROTOBUF,
                     "Failed to load model because protobuf parsing failed.");
     }
+    model_proto_parse_time_ = std::chrono::high_resolution_clock::now() - parse_start;
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
     LoadInterOp(model_proto, interop_domains_, [&](const char* msg) { LOGS(*session_logger_, WARNING) << msg; });
     InlinedVector<OrtCustomOpDomain*> domain_ptrs;
@@ -1193,7 +1353,7 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
   // 7. insert copy nodes (required transformer).
 
   // Run Ahead Of time function inlining
-  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_);
+  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_, &session_profiler_);
   if (const bool disable_aot_function_inlining =
           session_options_.config_options.GetConfigOrDefault(
               kOrtSessionOptionsDisableAheadOfTimeFunctionInlining, "0") == "1";
@@ -1603,7 +1763,7 @@ Status PartitionOrtFormatModel(onnxruntime::Graph& graph,
   }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
-  GraphPartitioner partitioner(kernel_registry_manager, providers);
+  GraphPartitioner partitioner(kernel_registry_manager, providers, &session_state.Profiler());
   ORT_RETURN_IF_ERROR(partitioner.Partition(graph,
                                             session_state.GetMutableFuncMgr(),
                                             transform_layout_fn,
@@ -1642,6 +1802,91 @@ Status ApplyOrtFormatModelRuntimeOptimizations(
   return Status::OK();
 }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+
+// Creates a zero filled tensor for every model input, with its shape in `shapes`, else its static shape.
+// `shapes_origin` names where the shapes come from, for the errors.
+Status CreateZeroFilledFeeds(const InputDefList& model_inputs,
+                             const std::unordered_map<std::string, TensorShape>& shapes,
+                             const char* shapes_origin, const AllocatorPtr& allocator,
+                             std::vector<std::string>& feed_names, std::vector<OrtValue>& feeds) {
+  for (const NodeArg* input : model_inputs) {
+    const auto* type = input->TypeAsProto();
+    ORT_RETURN_IF_NOT(type != nullptr && type->has_tensor_type(), "Model input ", input->Name(),
+                      " is not a tensor and can't be created from ", shapes_origin, ".");
+
+    TensorShape shape;
+    auto iter = shapes.find(input->Name());
+    if (iter != shapes.end()) {
+      shape = iter->second;
+    } else {
+      ORT_RETURN_IF_NOT(input->Shape() != nullptr, "Model input ", input->Name(),
+                        " has no shape and is missing from ", shapes_origin, ".");
+      shape = utils::GetTensorShapeFromTensorShapeProto(*input->Shape());
+      ORT_RETURN_IF(shape.Size() < 0, "Model input ", input->Name(),
+                    " has a symbolic shape and is missing from ", shapes_origin, ".");
+    }
+
+    OrtValue feed;
+    const auto* element_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType();
+    Tensor::InitOrtValue(element_type, shape, allocator, feed);
+    auto& tensor = *feed.GetMutable<Tensor>();
+    if (!tensor.IsDataTypeString()) {
+      memset(tensor.MutableDataRaw(), 0, tensor.SizeInBytes());
+    }
+
+    feed_names.push_back(input->Name());
+    feeds.push_back(std::move(feed));
+  }
+
+  return Status::OK();
+}
+
+#ifdef USE_DML
+// Runs the session once for every shape bucket of kOrtSessionOptionsConfigDmlRuntimeGraphPrecompileShapes with zero
+// filled inputs, so that the DML graphs of these shapes are compiled before the first request.
+Status PrecompileDmlShapeBuckets(InferenceSession& session, const std::string& shape_buckets) {
+  const auto [inputs_status, model_inputs] = session.GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs_status);
+  const auto [outputs_status, model_outputs] = session.GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs_status);
+
+  std::vector<std::string> output_names;
+  for (const NodeArg* output : *model_outputs) {
+    output_names.push_back(output->Name());
+  }
+
+  // the warm-up runs must not be captured as DML graphs
+  RunOptions run_options;
+  ORT_RETURN_IF_ERROR(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation, "-1"));
+
+  auto allocator = std::make_shared<CPUAllocator>();
+  for (const auto bucket : utils::SplitString(shape_buckets, ";")) {
+    std::unordered_map<std::string, TensorShape> bucket_shapes;
+    for (const auto input_shape : utils::SplitString(bucket, ",")) {
+      const auto separator = input_shape.find(':');
+      ORT_RETURN_IF(separator == std::string_view::npos, "Invalid input shape in the DML shape buckets: ", input_shape);
+      TensorShapeVector dims;
+      for (const auto dim : utils::SplitString(input_shape.substr(separator + 1), "x")) {
+        int64_t value = 0;
+        ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(dim, value) && value >= 0,
+                          "Invalid dimension in the DML shape buckets: ", input_shape);
+        dims.push_back(value);
+      }
+      bucket_shapes[std::string(input_shape.substr(0, separator))] = TensorShape(dims);
+    }
+
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    ORT_RETURN_IF_ERROR(CreateZeroFilledFeeds(*model_inputs, bucket_shapes, "the DML shape buckets", allocator,
+                                              feed_names, feeds));
+
+    std::vector<OrtValue> fetches;
+    ORT_RETURN_IF_ERROR(session.Run(run_options, feed_names, feeds, output_names, &fetches, nullptr));
+  }
+
+  return Status::OK();
+}
+#endif  // USE_DML
 }  // namespace
 
 static void ResolveMemoryPatternFlags(SessionState& session_state) {
@@ -1689,9 +1934,8 @@ common::Status InferenceSession::Initialize() {
     }
 
     // Verify that there are no external initializers in the graph if external data is disabled.
-    onnxruntime::Graph& graph = model_->MainGraph();
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
-    const InitializedTensorSet& initializers = graph.GetAllInitializedTensors();
+    const InitializedTensorSet& initializers = model_->MainGraph().GetAllInitializedTensors();
     for (const auto& it : initializers) {
       if (utils::HasExternalData(*it.second)) {
         return common::Status(common::ONNXRUNTIME, common::FAIL,
@@ -1705,6 +1949,8 @@ common::Status InferenceSession::Initialize() {
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      epi.use_huge_pages =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsUseHugePagesForCpuMemory, "0") == "1";
       auto p_cpu_exec_provider = std::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
       execution_providers_.SetCpuProviderWasImplicitlyAdded(true);
@@ -1713,6 +1959,17 @@ common::Status InferenceSession::Initialize() {
     // re-acquire mutex
     std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // the cache key includes the execution providers, so this can only happen once they are all registered
+    std::unique_ptr<OptimizedModelCache> optimized_model_cache;
+    std::string optimized_model_cache_key;
+    bool loaded_from_optimized_model_cache = false;
+    ORT_RETURN_IF_ERROR_SESSIONID_(LoadFromOptimizedModelCache(optimized_model_cache, optimized_model_cache_key,
+                                                               loaded_from_optimized_model_cache));
+#endif
+
+    onnxruntime::Graph& graph = model_->MainGraph();
+
 #if !defined(DISABLE_EXTERNAL_INITIALIZERS) && !defined(ORT_MINIMAL_BUILD)
     if (!session_options_.external_initializers.empty()) {
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.InjectExternalInitializedTensors(session_options_.external_initializers));
@@ -1759,6 +2016,26 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    // The CPU EP has no provider options of its own, so its TunableOp switches are session config entries.
+    auto* cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider);
+    auto* cpu_tuning_ctx = cpu_ep != nullptr ? cpu_ep->GetTuningContext() : nullptr;
+    if (cpu_tuning_ctx != nullptr) {
+      const auto& config_options = session_options_.config_options;
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpEnable, "0") == "1") {
+        cpu_tuning_ctx->EnableTunableOp();
+      }
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpTuningEnable, "0") == "1") {
+        cpu_tuning_ctx->EnableTuning();
+      }
+      int max_tuning_duration_ms = 0;
+      const auto max_tuning_duration_str =
+          config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, "0");
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale<int>(max_tuning_duration_str, max_tuning_duration_ms),
+                        "Invalid value for ", kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, ": ",
+                        max_tuning_duration_str);
+      cpu_tuning_ctx->SetMaxTuningDurationMs(max_tuning_duration_ms);
+    }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // Don't want to pollute SessionState constructor since memory profile is enabled optionally.
     session_state_->SetMemoryProfiler(&memory_profiler_);
@@ -1801,9 +2078,11 @@ common::Status InferenceSession::Initialize() {
         return Status::OK();
       };
 
-      // add predefined transformers
+      // add predefined transformers. a model from the optimized model cache has been through them already.
       ORT_RETURN_IF_ERROR_SESSIONID_(AddPredefinedTransformers(graph_transformer_mgr_,
-                                                               session_options_.graph_optimization_level,
+                                                               loaded_from_optimized_model_cache
+                                                                   ? TransformerLevel::Default
+                                                                   : session_options_.graph_optimization_level,
                                                                minimal_build_optimization_handling,
                                                                record_runtime_optimization_produced_op_schema));
 
@@ -1823,6 +2102,7 @@ common::Status InferenceSession::Initialize() {
                        dml_graph_serialization_enabled_config_val.begin(),
                        [](char ch) { return std::tolower(ch); });
         bool dml_graph_serialization_enabled = dml_graph_serialization_enabled_config_val == "true";
+        const std::string dml_graph_cache_directory = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDmlGraphCacheDirectory, "");
 
         if (static_cast<const Dml::ExecutionProvider*>(dmlExecutionProvider)->IsGraphCaptureEnabled()) {
           std::unique_ptr<onnxruntime::GraphTransformer> dmlRuntimeGraphFusionTransformer = std::make_unique<Dml::DmlRuntimeGraphFusionTransformer>("DmlRuntimeGraphFusionTransformer",
@@ -1834,7 +2114,8 @@ common::Status InferenceSession::Initialize() {
         } else if (dml_graph_fusion_enabled) {
           std::unique_ptr<onnxruntime::GraphTransformer> dmlGraphFusionTransformer = std::make_unique<Dml::DmlGraphFusionTransformer>("DmlGraphFusionTransformer",
                                                                                                                                       dmlExecutionProvider,
-                                                                                                                                      dml_graph_serialization_enabled);
+                                                                                                                                      dml_graph_serialization_enabled,
+                                                                                                                                      ToPathString(dml_graph_cache_directory));
           if (dmlGraphFusionTransformer == nullptr) {
             return Status(common::ONNXRUNTIME, common::FAIL, "DmlGraphFusionTransformer is nullptr");
           }
@@ -1866,7 +2147,14 @@ common::Status InferenceSession::Initialize() {
       ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, saving_ort_format));
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
+      TimePoint resolve_start;
+      if (session_profiler_.IsEnabled()) {
+        resolve_start = session_profiler_.Start();
+      }
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
+      if (session_profiler_.IsEnabled()) {
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_resolve", resolve_start);
+      }
 
       // Currently graph capture is only considered by CUDA EP, TRT EP, ROCM EP and JS EP.
       //
@@ -1938,6 +2226,25 @@ common::Status InferenceSession::Initialize() {
                                       target_ep->Type()));
             }
 
+#ifdef USE_DML
+            // Only the fused partitions record reusable command lists, the DML nodes that couldn't be fused record
+            // into the command list of the execution context on every run and are not part of the captured graph.
+            if (strcmp(target_ep->Type().c_str(), onnxruntime::kDmlExecutionProvider) == 0) {
+              std::string unfused_op_types;
+              for (const auto& node : graph.Nodes()) {
+                if (node.GetExecutionProviderType() == kDmlExecutionProvider &&
+                    node.Domain() != Dml::DmlGraphFusionTransformer::DML_GRAPH_FUSION_NODE_DOMAIN) {
+                  unfused_op_types += (unfused_op_types.empty() ? "" : ", ") + node.OpType();
+                }
+              }
+
+              if (!unfused_op_types.empty()) {
+                LOGS(*session_logger_, WARNING) << "These DML nodes could not be fused into graphs and won't run when "
+                                                << "the captured graph is replayed: " << unfused_op_types;
+              }
+            }
+#endif
+
             // Log a warning for the user to know that there are shape subgraphs that will execute on CPU
             if (HasShapeSubgraphNodes(graph)) {
               LOGS(*session_logger_, WARNING) << "This model has shape massaging nodes that will execute on CPU. "
@@ -1971,6 +2278,24 @@ common::Status InferenceSession::Initialize() {
         }
       }
 
+      const std::string graph_capture_shape_buckets =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGraphCaptureShapeBuckets, "");
+      if (!graph_capture_shape_buckets.empty()) {
+        if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+          ORT_RETURN_IF_ERROR_SESSIONID_(
+              GraphCaptureShapeBuckets::Parse(graph_capture_shape_buckets, graph_capture_shape_buckets_));
+        } else {
+          LOGS(*session_logger_, WARNING) << "Ignoring graph capture shape buckets as this session doesn't capture "
+                                          << "a graph.";
+        }
+      }
+
+      const std::string streaming_state =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigStreamingState, "");
+      if (!streaming_state.empty()) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(StreamingState::Create(*this, streaming_state, streaming_state_));
+      }
+
       const bool disable_cpu_ep_fallback = session_options_.config_options.GetConfigOrDefault(
                                                kOrtSessionOptionsDisableCPUEPFallback, "0") == "1";
 
@@ -2027,6 +2352,21 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // save before the session state is finalized, which removes the initializers from the graph
+    if (optimized_model_cache && !loaded_from_optimized_model_cache) {
+      if (session_state_->GetFuncMgr().NumFuncs() > 0) {
+        LOGS(*session_logger_, INFO) << "The optimized model contains compiled nodes and is not cached.";
+      } else {
+        auto cache_status = optimized_model_cache->Save(*model_, optimized_model_cache_key);
+        if (!cache_status.IsOK()) {
+          LOGS(*session_logger_, WARNING) << "Failed to add the optimized model to the cache: "
+                                          << cache_status.ErrorMessage();
+        }
+      }
+    }
+#endif
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              // need to keep the initializers if saving the optimized model
@@ -2081,11 +2421,56 @@ common::Status InferenceSession::Initialize() {
     if (found_tuning_results) {
       ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(tuning_results, /*error_on_invalid*/ false, /*auto_enable*/ true));
     }
+
+    tuning_results_file_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsTuningResultsFile, "");
+    if (!tuning_results_file_.empty()) {
+      // a bad file is tuned again and overwritten
+      auto status = inference_session_utils::LoadTuningResultsFile(tuning_results_file_, tuning_results,
+                                                                   found_tuning_results);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << status.ErrorMessage();
+      } else if (found_tuning_results) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(tuning_results, /*error_on_invalid*/ false,
+                                                        /*auto_enable*/ true));
+      }
+    }
+
+    warmup_shapes_file_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsWarmupShapesFile, "");
+    if (!warmup_shapes_file_.empty()) {
+      // a bad file is recorded again and overwritten
+      bool found_warmup_shapes = false;
+      auto status = inference_session_utils::LoadWarmupShapesFile(warmup_shapes_file_, warmup_shapes_,
+                                                                  found_warmup_shapes);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << status.ErrorMessage();
+        warmup_shapes_changed_ = true;
+      }
+      for (const auto& entry : warmup_shapes_) {
+        warmup_shapes_num_elements_ += entry.second.Size();
+      }
+    }
+
+    memory_trace_file_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryTraceFile, "");
+    if (!memory_trace_file_.empty()) {
+      const std::string top_n_str =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryTraceTopN, "20");
+      size_t top_n = 0;
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(top_n_str, top_n),
+                        "Invalid value for ", kOrtSessionOptionsMemoryTraceTopN, ": ", top_n_str);
+      memory_tracer_ = std::make_unique<MemoryTracer>(top_n);
+      session_state_->SetMemoryTracer(memory_tracer_.get());
+    }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    const std::string mem_pattern_cache_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheFile, "");
+    if (!mem_pattern_cache_file.empty()) {
+      session_state_->SetMemoryPatternCacheFile(ToPathString(mem_pattern_cache_file));
+    }
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
@@ -2135,6 +2520,14 @@ common::Status InferenceSession::Initialize() {
     }
   }
 
+#ifdef USE_DML
+  const std::string dml_shape_buckets =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDmlRuntimeGraphPrecompileShapes, "");
+  if (status.IsOK() && !dml_shape_buckets.empty() && execution_providers_.Get(kDmlExecutionProvider) != nullptr) {
+    status = PrecompileDmlShapeBuckets(*this, dml_shape_buckets);
+  }
+#endif
+
   return status;
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -2497,6 +2890,121 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  return RunWithFeedsFetchesManager(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                    nullptr);
+}
+
+Status InferenceSession::RunWithFeedsFetchesManager(const RunOptions& run_options,
+                                                    gsl::span<const std::string> feed_names,
+                                                    gsl::span<const OrtValue> feeds,
+                                                    gsl::span<const std::string> output_names,
+                                                    std::vector<OrtValue>* p_fetches,
+                                                    const std::vector<OrtDevice>* p_fetches_device_info,
+                                                    FeedsFetchesManager* cached_feeds_fetches_manager) {
+#if !defined(ORT_MINIMAL_BUILD)
+  if (run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigTuningWarmup, "0") == "1") {
+    return TuningWarmupRun(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+  }
+
+  if (!warmup_shapes_file_.empty()) {
+    RecordWarmupShapes(feed_names, feeds);
+  }
+#endif
+
+  size_t micro_batch_count = 1;
+  ORT_RETURN_IF_ERROR(MicroBatchRun::GetMicroBatchCount(run_options, micro_batch_count));
+  if (micro_batch_count > 1) {
+    // the state of a streaming run is carried from one run to the next, so its rows can't run concurrently
+    ORT_RETURN_IF(streaming_state_ != nullptr, "Micro-batches are not supported with a streaming state.");
+    ORT_RETURN_IF(p_fetches == nullptr || p_fetches_device_info != nullptr,
+                  "Micro-batches are not supported with fetches bound to a device.");
+    return MicroBatchRun::Run(*this, run_options, micro_batch_count, feed_names, feeds, output_names, *p_fetches);
+  }
+
+  if (streaming_state_) {
+    return streaming_state_->Run(*this, run_options, feed_names, feeds, output_names, p_fetches,
+                                 p_fetches_device_info);
+  }
+
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                 cached_feeds_fetches_manager);
+}
+
+void InferenceSession::RecordCapturedGraphBindings(int graph_annotation_id, gsl::span<const std::string> feed_names,
+                                                   gsl::span<const OrtValue> feeds,
+                                                   gsl::span<const std::string> output_names,
+                                                   const std::vector<OrtValue>* p_fetches) {
+  CapturedGraphBindings bindings;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (feeds[i].IsTensor()) {
+      const auto& tensor = feeds[i].Get<Tensor>();
+      bindings.feeds.emplace(feed_names[i], std::make_pair(tensor.DataRaw(), tensor.Shape()));
+    }
+  }
+
+  if (p_fetches != nullptr) {
+    for (size_t i = 0; i < output_names.size() && i < p_fetches->size(); ++i) {
+      if ((*p_fetches)[i].IsTensor()) {
+        bindings.fetches.emplace(output_names[i], (*p_fetches)[i].Get<Tensor>().DataRaw());
+      }
+    }
+  }
+
+  std::lock_guard<OrtMutex> lock(captured_graph_bindings_mutex_);
+  captured_graph_bindings_[graph_annotation_id] = std::move(bindings);
+}
+
+Status InferenceSession::ValidateCapturedGraphBindings(int graph_annotation_id,
+                                                       gsl::span<const std::string> feed_names,
+                                                       gsl::span<const OrtValue> feeds,
+                                                       gsl::span<const std::string> output_names,
+                                                       const std::vector<OrtValue>* p_fetches) {
+  std::lock_guard<OrtMutex> lock(captured_graph_bindings_mutex_);
+  auto bindings = captured_graph_bindings_.find(graph_annotation_id);
+  if (bindings == captured_graph_bindings_.end()) {
+    // captured by a run that didn't go through RunImpl, e.g. by an EP on its own
+    return Status::OK();
+  }
+
+  // The replay reads the feeds and writes the fetches at the addresses of the capturing run, so a run bound to other
+  // buffers would silently read stale inputs and never receive its outputs.
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!feeds[i].IsTensor()) {
+      continue;
+    }
+
+    const auto& tensor = feeds[i].Get<Tensor>();
+    auto captured = bindings->second.feeds.find(feed_names[i]);
+    ORT_RETURN_IF(captured == bindings->second.feeds.end() || captured->second.first != tensor.DataRaw() ||
+                      captured->second.second != tensor.Shape(),
+                  "Input ", feed_names[i], " is not bound to the buffer and shape of the run that captured graph ",
+                  graph_annotation_id, ". Bind the same device buffers, e.g. with an IOBinding, to replay it.");
+  }
+
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    auto captured = bindings->second.fetches.find(output_names[i]);
+    ORT_RETURN_IF(captured == bindings->second.fetches.end() || p_fetches == nullptr ||
+                      i >= p_fetches->size() || !(*p_fetches)[i].IsTensor() ||
+                      (*p_fetches)[i].Get<Tensor>().DataRaw() != captured->second,
+                  "Output ", output_names[i], " is not bound to the buffer of the run that captured graph ",
+                  graph_annotation_id, ". Bind the same pre-allocated device buffers, e.g. with an IOBinding, ",
+                  "to replay it.");
+  }
+
+  return Status::OK();
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 FeedsFetchesManager* cached_feeds_fetches_manager) {
+  // runs that pick their own graph annotation bypass the buckets, which is also how the buckets run the session
+  if (graph_capture_shape_buckets_ && p_fetches_device_info == nullptr &&
+      !run_options.config_options.GetConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation).has_value()) {
+    return graph_capture_shape_buckets_->Run(*this, run_options, feed_names, feeds, output_names, p_fetches);
+  }
+
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -2529,18 +3037,26 @@ Status InferenceSession::Run(const RunOptions& run_options,
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
   ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
 
+  // Set if this Run() captures a graph, whose bindings the runs replaying it must then match.
+  const bool capturing_graph = cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
+                               cached_execution_provider_for_graph_replay_.AllowGraphCaptureOnRun(graph_annotation_id) &&
+                               !cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id);
+
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Replaying the captured "
                                  << cached_execution_provider_for_graph_replay_.Type()
                                  << " CUDA Graph for this model with tag: " << run_options.run_tag
                                  << " with graph annotation id: " << graph_annotation_id;
+    ORT_RETURN_IF_ERROR_SESSIONID_(
+        ValidateCapturedGraphBindings(graph_annotation_id, feed_names, feeds, output_names, p_fetches));
     ORT_RETURN_IF_ERROR_SESSIONID_(cached_execution_provider_for_graph_replay_.ReplayGraph(graph_annotation_id));
   } else {
     InlinedVector<IExecutionProvider*> exec_providers_to_stop;
     exec_providers_to_stop.reserve(execution_providers_.NumProviders());
 
     InlinedVector<AllocatorPtr> arenas_to_shrink;
+    size_t arena_shrinkage_high_watermark_bytes = 0;
 
     ORT_TRY {
       if (!is_inited_) {
@@ -2560,10 +3076,30 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
       if (!shrink_memory_arenas.empty()) {
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
+        ORT_RETURN_IF_ERROR_SESSIONID_(ParseArenaShrinkageHighWatermark(
+            run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigMemoryArenaShrinkageHighWatermark, ""),
+            arena_shrinkage_high_watermark_bytes));
+      }
+
+      // apply the intra-op thread budget of this run to the kernels executed on this thread
+      int max_intra_op_degree_of_parallelism = 0;
+      auto intra_op_priority = concurrency::ThreadPool::LoopPriority::kNormal;
+      ORT_RETURN_IF_ERROR_SESSIONID_(ParseIntraOpLoopBudget(run_options, max_intra_op_degree_of_parallelism,
+                                                            intra_op_priority));
+      std::optional<concurrency::ThreadPool::ScopedLoopBudget> intra_op_loop_budget;
+      if (max_intra_op_degree_of_parallelism > 0 ||
+          intra_op_priority != concurrency::ThreadPool::LoopPriority::kNormal) {
+        intra_op_loop_budget.emplace(max_intra_op_degree_of_parallelism, intra_op_priority);
       }
 
-      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-      FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      std::optional<FeedsFetchesManager> owned_feeds_fetches_manager;
+      if (cached_feeds_fetches_manager == nullptr) {
+        owned_feeds_fetches_manager.emplace(
+            FeedsFetchesInfo(feed_names, output_names, session_state_->GetOrtValueNameIdxMap()));
+      }
+      FeedsFetchesManager& feeds_fetches_manager = cached_feeds_fetches_manager != nullptr
+                                                       ? *cached_feeds_fetches_manager
+                                                       : *owned_feeds_fetches_manager;
 
       if (p_fetches_device_info) {
         // populate the target device info. ignored if pre-allocated fetches are provided
@@ -2660,7 +3196,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
     }
 
     if (!arenas_to_shrink.empty()) {
-      ShrinkMemoryArenas(arenas_to_shrink);
+      ShrinkMemoryArenas(arenas_to_shrink, arena_shrinkage_high_watermark_bytes);
     }
   }
 
@@ -2690,6 +3226,11 @@ Status InferenceSession::Run(const RunOptions& run_options,
   TraceLoggingWriteStop(ortrun_activity, "OrtRun");
 #endif
 
+  if (retval.IsOK() && capturing_graph &&
+      cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
+    RecordCapturedGraphBindings(graph_annotation_id, feed_names, feeds, output_names, p_fetches);
+  }
+
   // As N+1 inference runs (N for memory allocation and 1 for graph capturing)
   // are needed before replaying the captured graph, here run N inference runs recursively until graph captured,
   // so that users just need one session run to capture the graph.
@@ -2700,7 +3241,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
       cached_execution_provider_for_graph_replay_.AllowGraphCaptureOnRun(graph_annotation_id) &&
       !cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Start another run for necessary memory allocation or graph capture.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                cached_feeds_fetches_manager));
   }
   return retval;
 }
@@ -2813,6 +3355,69 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
   return Status::OK();
 }
 
+common::Status InferenceSession::Warmup(const RunOptions& run_options,
+                                        const std::unordered_map<std::string, TensorShape>& input_shapes) {
+  const auto [inputs_status, model_inputs] = GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs_status);
+  const auto [outputs_status, model_outputs] = GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs_status);
+
+  std::unordered_map<std::string, TensorShape> shapes = input_shapes;
+#if !defined(ORT_MINIMAL_BUILD)
+  {
+    std::lock_guard<OrtMutex> lock(warmup_shapes_mutex_);
+    shapes.insert(warmup_shapes_.begin(), warmup_shapes_.end());
+  }
+#endif
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  ORT_RETURN_IF_ERROR(CreateZeroFilledFeeds(*model_inputs, shapes, "the warmup shapes",
+                                            std::make_shared<CPUAllocator>(), feed_names, feeds));
+
+  std::vector<std::string> output_names;
+  for (const NodeArg* output : *model_outputs) {
+    output_names.push_back(output->Name());
+  }
+
+  // a shrinkage would release the arena extensions that the warmup is for
+  RunOptions warmup_run_options = run_options;
+  warmup_run_options.config_options.configurations.erase(kOrtRunOptionsConfigEnableMemoryArenaShrinkage);
+
+  std::vector<OrtValue> fetches;
+  return Run(warmup_run_options, feed_names, feeds, output_names, &fetches, nullptr);
+}
+
+common::Status InferenceSession::WarmupAsync(const RunOptions* run_options,
+                                             std::unordered_map<std::string, TensorShape> input_shapes,
+                                             RunAsyncCallbackFn callback, void* user_data) {
+  auto* tp = GetIntraOpThreadPoolToUse();
+  if (!tp || concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "intra op thread pool must have at least one thread for an asynchronous warmup");
+  }
+  // the warmup may outlive the caller's run options
+  RunOptions warmup_run_options = run_options ? *run_options : RunOptions();
+  std::function<void()> warmup_fn = [warmup_run_options = std::move(warmup_run_options),
+                                     input_shapes = std::move(input_shapes), callback, user_data, this]() {
+    Status status = Status::OK();
+    ORT_TRY {
+      status = Warmup(warmup_run_options, input_shapes);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    ORT_CATCH(...) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+    }
+    callback(user_data, nullptr, 0, ToOrtStatus(status));
+  };  // warmup_fn
+  concurrency::ThreadPool::Schedule(tp, warmup_fn);
+  return Status::OK();
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds, gsl::span<const std::string> output_names,
                                      std::vector<OrtValue>* p_fetches) {
   return Run(RunOptions(), feeds, output_names, p_fetches);
@@ -2910,6 +3515,38 @@ common::Status InferenceSession::Run(IOBinding& io_binding) {
   return Run(run_options, io_binding);
 }
 
+common::Status InferenceSession::NewRunContext(gsl::span<const std::string> feed_names,
+                                               gsl::span<const std::string> fetch_names,
+                                               std::unique_ptr<RunContext>* run_context) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  for (const auto& name : feed_names) {
+    if (input_def_map_.count(name) == 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid input name: ", name);
+    }
+  }
+  ORT_RETURN_IF_ERROR(ValidateOutputs(fetch_names, nullptr));
+
+  *run_context = std::make_unique<RunContext>(*session_state_, feed_names, fetch_names);
+  return Status::OK();
+}
+
+common::Status InferenceSession::Run(const RunOptions& run_options, RunContext& run_context) {
+  ORT_RETURN_IF_NOT(&run_context.session_state_ == session_state_.get(),
+                    "The run context was created by another session.");
+  ORT_RETURN_IF_ERROR(run_context.PrepareRun());
+
+  const auto& info = run_context.feeds_fetches_manager_.GetFeedsFetchesInfo();
+  return RunWithFeedsFetchesManager(run_options, info.feed_names, run_context.feeds_, info.output_names,
+                                    &run_context.fetches_, nullptr, &run_context.feeds_fetches_manager_);
+}
+
 template <typename T>
 void InferenceSession::StartProfiling(const std::basic_string<T>& file_prefix) {
   std::basic_ostringstream<T> ss;
@@ -2948,7 +3585,70 @@ const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+std::string InferenceSession::GetThreadPoolStats() const {
+  return MakeString("{\"intra_op\":", concurrency::ThreadPool::GetStats(GetIntraOpThreadPoolToUse()).ToJson(),
+                    ",\"inter_op\":", concurrency::ThreadPool::GetStats(GetInterOpThreadPoolToUse()).ToJson(), "}");
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
+Status InferenceSession::TuningWarmupRun(const RunOptions& run_options,
+                                         gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                         gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                         const std::vector<OrtDevice>* p_fetches_device_info) {
+  std::vector<ITuningContext*> tuned_ctxs;
+  for (const auto& provider : execution_providers_) {
+    auto* tuning_ctx = provider->GetTuningContext();
+    if (tuning_ctx != nullptr && !tuning_ctx->IsTuningEnabled()) {
+      tuning_ctx->EnableTunableOpAndTuning();
+      tuned_ctxs.push_back(tuning_ctx);
+    } else if (tuning_ctx != nullptr) {
+      tuning_ctx->EnableTunableOp();
+    }
+  }
+
+  RunOptions tuning_run_options = run_options;
+  tuning_run_options.config_options.configurations.erase(kOrtRunOptionsConfigTuningWarmup);
+  auto status = Run(tuning_run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+
+  // keep TunableOp enabled, so the later runs use the results
+  for (auto* tuning_ctx : tuned_ctxs) {
+    tuning_ctx->DisableTuning();
+  }
+
+  ORT_RETURN_IF_ERROR(status);
+  return SaveTuningResultsFile();
+}
+
+void InferenceSession::RecordWarmupShapes(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds) {
+  int64_t num_elements = 0;
+  for (const auto& feed : feeds) {
+    if (feed.IsTensor()) {
+      num_elements += feed.Get<Tensor>().Shape().Size();
+    }
+  }
+
+  std::lock_guard<OrtMutex> lock(warmup_shapes_mutex_);
+  if (num_elements <= warmup_shapes_num_elements_) {
+    return;
+  }
+
+  warmup_shapes_.clear();
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (feeds[i].IsTensor()) {
+      warmup_shapes_.emplace(feed_names[i], feeds[i].Get<Tensor>().Shape());
+    }
+  }
+  warmup_shapes_num_elements_ = num_elements;
+  warmup_shapes_changed_ = true;
+}
+
+Status InferenceSession::SaveTuningResultsFile() const {
+  if (tuning_results_file_.empty()) {
+    return Status::OK();
+  }
+  return inference_session_utils::SaveTuningResultsFile(tuning_results_file_, GetTuningResults());
+}
+
 std::vector<TuningResults> InferenceSession::GetTuningResults() const {
   std::vector<TuningResults> ret;
   for (const auto& provider : execution_providers_) {
@@ -3063,9 +3763,68 @@ common::Status InferenceSession::ValidateAndParseShrinkArenaString(const std::st
   return Status::OK();
 }
 
-void InferenceSession::ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink) {
+common::Status InferenceSession::ParseIntraOpLoopBudget(const RunOptions& run_options,
+                                                        /*out*/ int& max_degree_of_parallelism,
+                                                        /*out*/ concurrency::ThreadPool::LoopPriority& priority) {
+  max_degree_of_parallelism = 0;
+  priority = concurrency::ThreadPool::LoopPriority::kNormal;
+
+  const std::string max_dop_str =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism, "0");
+  if (!TryParseStringWithClassicLocale<int>(max_dop_str, max_degree_of_parallelism) ||
+      max_degree_of_parallelism < 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism, ": ", max_dop_str,
+                           ". Expected a non-negative integer.");
+  }
+
+  const std::string priority_str =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigIntraOpPriority, "normal");
+  if (priority_str == "low") {
+    priority = concurrency::ThreadPool::LoopPriority::kLow;
+  } else if (priority_str == "high") {
+    priority = concurrency::ThreadPool::LoopPriority::kHigh;
+  } else if (priority_str != "normal") {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", kOrtRunOptionsConfigIntraOpPriority,
+                           ": ", priority_str, ". Expected 'low', 'normal' or 'high'.");
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::ParseArenaShrinkageHighWatermark(const std::string& high_watermark,
+                                                                  /*out*/ size_t& high_watermark_bytes) {
+  high_watermark_bytes = 0;
+  if (high_watermark.empty()) {
+    return Status::OK();
+  }
+
+  if (high_watermark == "peak") {
+    high_watermark_bytes = kArenaShrinkageWatermarkPeak;
+    return Status::OK();
+  }
+
+  if (!TryParseStringWithClassicLocale<size_t>(high_watermark, high_watermark_bytes)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtRunOptionsConfigMemoryArenaShrinkageHighWatermark, ": ", high_watermark,
+                           ". Expected a number of bytes or 'peak'.");
+  }
+
+  return Status::OK();
+}
+
+void InferenceSession::ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink,
+                                          size_t high_watermark_bytes) {
   for (auto& alloc : arenas_to_shrink) {
-    auto status = static_cast<BFCArena*>(alloc.get())->Shrink();
+    auto* arena = static_cast<BFCArena*>(alloc.get());
+    size_t watermark = high_watermark_bytes;
+    if (watermark == kArenaShrinkageWatermarkPeak) {
+      AllocatorStats stats;
+      arena->GetStats(&stats);
+      watermark = static_cast<size_t>(stats.max_bytes_in_use);
+    }
+
+    auto status = watermark == 0 ? arena->Shrink() : arena->ShrinkToWatermark(watermark);
 
     if (!status.IsOK()) {
       LOGS(*session_logger_, WARNING) << "Unable to shrink arena: " << alloc->Info().ToString()
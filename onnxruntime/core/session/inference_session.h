@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <limits>
 #include <map>
+#include <chrono>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -49,10 +51,14 @@ class ModelProto;
 namespace onnxruntime {  // forward declarations
 class CustomRegistry;
 class Environment;
+class GraphCaptureShapeBuckets;
 class GraphTransformer;
 class IExecutionProvider;
 class IOBinding;
+class RunContext;
 struct Notification;
+class OptimizedModelCache;
+class StreamingState;
 
 #ifdef ENABLE_TRAINING
 struct PartialGraphExecutionState;
@@ -352,6 +358,21 @@ class InferenceSession {
                                         RunAsyncCallbackFn callback,
                                         void* user_data = nullptr);
 
+  /**
+   * Runs the model once with zero filled inputs, so that the lazy initialization of the first run, e.g. the arena
+   * extensions, the prepacking, the algorithm searches and the compilation of the execution providers, is done before
+   * the session is serving.
+   * @param input_shapes the shapes of the model inputs. The inputs without a shape here use the shape of the
+   *        kOrtSessionOptionsWarmupShapesFile file, else their static shape in the model.
+   */
+  [[nodiscard]] common::Status Warmup(const RunOptions& run_options,
+                                      const std::unordered_map<std::string, TensorShape>& input_shapes);
+
+  // Runs Warmup in a thread of the intra op thread pool. The callback is called with no outputs when it is done.
+  [[nodiscard]] common::Status WarmupAsync(const RunOptions* run_options,
+                                           std::unordered_map<std::string, TensorShape> input_shapes,
+                                           RunAsyncCallbackFn callback, void* user_data = nullptr);
+
   /**
    * Run a pre-loaded and pre-intialized model.
    * Multiple threads are allowed to run this function; hence its thread-safe.
@@ -384,6 +405,16 @@ class InferenceSession {
   [[nodiscard]] virtual common::Status Run(const RunOptions& run_options, IOBinding& io_binding);
   [[nodiscard]] common::Status Run(IOBinding& io_binding);
 
+  /**
+   * Creates a context for repeated runs with the same feeds and fetches, whose names are resolved once.
+   * See RunContext class for more info.
+   */
+  [[nodiscard]] common::Status NewRunContext(gsl::span<const std::string> feed_names,
+                                             gsl::span<const std::string> fetch_names,
+                                             std::unique_ptr<RunContext>* run_context);
+
+  [[nodiscard]] common::Status Run(const RunOptions& run_options, RunContext& run_context);
+
 #ifdef ENABLE_TRAINING
   /**
    * Partially run a pre-loaded and pre-intialized model.
@@ -495,6 +526,12 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+    * Return the counters of the intra-op and inter-op thread pools used by the session as JSON.
+    * See OrtApi::SessionGetThreadPoolStats.
+    */
+  std::string GetThreadPoolStats() const;
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
    * Get the TuningResults of TunableOp for every execution providers.
@@ -616,6 +653,38 @@ class InferenceSession {
 
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InferenceSession);
+
+  // run the graph with the feeds and fetches as given, without the streaming state
+  friend class GraphCaptureShapeBuckets;
+  friend class StreamingState;
+  // cached_feeds_fetches_manager, if given, holds the resolved feed_names and output_names, e.g. of a RunContext.
+  [[nodiscard]] common::Status RunImpl(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                       gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                       std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info,
+                                       FeedsFetchesManager* cached_feeds_fetches_manager = nullptr);
+
+  // Run() with the feeds and fetches resolved by cached_feeds_fetches_manager, if given.
+  [[nodiscard]] common::Status RunWithFeedsFetchesManager(const RunOptions& run_options,
+                                                          gsl::span<const std::string> feed_names,
+                                                          gsl::span<const OrtValue> feeds,
+                                                          gsl::span<const std::string> output_names,
+                                                          std::vector<OrtValue>* p_fetches,
+                                                          const std::vector<OrtDevice>* p_fetches_device_info,
+                                                          FeedsFetchesManager* cached_feeds_fetches_manager);
+
+  // Keeps the buffers of the feeds and fetches of the run that captured a graph.
+  void RecordCapturedGraphBindings(int graph_annotation_id, gsl::span<const std::string> feed_names,
+                                   gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                   const std::vector<OrtValue>* p_fetches);
+
+  // Fails if a run that replays a graph is not bound to the buffers recorded by RecordCapturedGraphBindings.
+  [[nodiscard]] common::Status ValidateCapturedGraphBindings(int graph_annotation_id,
+                                                             gsl::span<const std::string> feed_names,
+                                                             gsl::span<const OrtValue> feeds,
+                                                             gsl::span<const std::string> output_names,
+                                                             const std::vector<OrtValue>* p_fetches);
+
   void SetLoggingManager(const SessionOptions& session_options,
                          const Environment& session_env);
   void ConstructorCommon(const SessionOptions& session_options,
@@ -632,6 +701,32 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const std::filesystem::path& filepath) const;
+
+  /**
+   * Replace the loaded model with its optimized version from the cache directory set with
+   * kOrtSessionOptionsOptimizedModelCacheDir, if the cache is enabled and has it.
+   * @param cache set to the cache if it is enabled for this session.
+   * @param key set to the key of the model in the cache.
+   * @param loaded set to true if the model was replaced.
+   * @return OK unless the session can't continue, errors of the cache itself are logged only.
+   */
+  [[nodiscard]] common::Status LoadFromOptimizedModelCache(std::unique_ptr<OptimizedModelCache>& cache,
+                                                           std::string& key, bool& loaded);
+
+  // Runs with tuning enabled for every execution provider that supports TunableOp, then saves the tuning results.
+  // see kOrtRunOptionsConfigTuningWarmup
+  [[nodiscard]] common::Status TuningWarmupRun(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                               gsl::span<const OrtValue> feeds,
+                                               gsl::span<const std::string> output_names,
+                                               std::vector<OrtValue>* p_fetches,
+                                               const std::vector<OrtDevice>* p_fetches_device_info);
+
+  // Writes the tuning results of the session to the kOrtSessionOptionsTuningResultsFile file, if it has one.
+  [[nodiscard]] common::Status SaveTuningResultsFile() const;
+
+  // Keeps the input shapes of the run if it has more input elements than the recorded ones.
+  // see kOrtSessionOptionsWarmupShapesFile
+  void RecordWarmupShapes(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds);
 #endif
 
   /**
@@ -693,11 +788,30 @@ class InferenceSession {
   [[nodiscard]] common::Status ValidateAndParseShrinkArenaString(const std::string& ort_device_list,
                                                                  /*out*/ InlinedVector<AllocatorPtr>& arenas_to_shrink) const;
 
+  /*
+   * Parses the value of the kOrtRunOptionsConfigMemoryArenaShrinkageHighWatermark run option.
+   * `high_watermark_bytes` is set to 0 if the value is empty (shrink fully) and to
+   * kArenaShrinkageWatermarkPeak if the value is "peak".
+   */
+  [[nodiscard]] static common::Status ParseArenaShrinkageHighWatermark(const std::string& high_watermark,
+                                                                       /*out*/ size_t& high_watermark_bytes);
+
+  static constexpr size_t kArenaShrinkageWatermarkPeak = std::numeric_limits<size_t>::max();
+
+  /*
+   * Parses kOrtRunOptionsConfigIntraOpMaxDegreeOfParallelism and kOrtRunOptionsConfigIntraOpPriority.
+   * `max_degree_of_parallelism` is set to 0 and `priority` to kNormal if the values are not set.
+   */
+  [[nodiscard]] static common::Status ParseIntraOpLoopBudget(const RunOptions& run_options,
+                                                             /*out*/ int& max_degree_of_parallelism,
+                                                             /*out*/ concurrency::ThreadPool::LoopPriority& priority);
+
   /*
    * Performs the shrinkage of arenas requested to be shrunk by the user
    * The `arenas_to_shrink` parameter is got from ValidateAndParseShrinkArenaString()
+   * The `high_watermark_bytes` parameter is got from ParseArenaShrinkageHighWatermark()
    */
-  void ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink);
+  void ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink, size_t high_watermark_bytes);
 
 #ifdef _WIN32
   void LogAllSessions();
@@ -832,6 +946,9 @@ class InferenceSession {
 
   // Flag indicating if ModelProto has been parsed in an applicable ctor
   bool is_model_proto_parsed_ = false;
+
+  // Time spent parsing the protobuf while loading the model, reported with the model loading profiler event
+  std::optional<std::chrono::high_resolution_clock::duration> model_proto_parse_time_;
   const Environment& environment_;
 
   // View of the bytes from an ORT format model.
@@ -909,6 +1026,41 @@ class InferenceSession {
   };
 
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
+
+  // The buffers of the feeds and fetches of the run that captured a graph, by graph annotation id.
+  // Feeds map to their address and shape, fetches to their address.
+  struct CapturedGraphBindings {
+    std::unordered_map<std::string, std::pair<const void*, TensorShape>> feeds;
+    std::unordered_map<std::string, const void*> fetches;
+  };
+  std::unordered_map<int, CapturedGraphBindings> captured_graph_bindings_;
+  OrtMutex captured_graph_bindings_mutex_;
+
+  // Set if runs of varying shapes are padded to buckets that each capture a graph.
+  // see kOrtSessionOptionsConfigGraphCaptureShapeBuckets
+  std::unique_ptr<GraphCaptureShapeBuckets> graph_capture_shape_buckets_;
+
+  // Set if state outputs are fed back into state inputs across runs.
+  // see kOrtSessionOptionsConfigStreamingState
+  std::unique_ptr<StreamingState> streaming_state_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // The file the tuning results are loaded from and saved to.
+  // see kOrtSessionOptionsTuningResultsFile
+  std::string tuning_results_file_;
+
+  // The file the input shapes of the largest run are loaded from and saved to.
+  // see kOrtSessionOptionsWarmupShapesFile
+  std::string warmup_shapes_file_;
+  OrtMutex warmup_shapes_mutex_;
+  std::unordered_map<std::string, TensorShape> warmup_shapes_;
+  int64_t warmup_shapes_num_elements_ = 0;
+  bool warmup_shapes_changed_ = false;
+
+  // Records the allocations of the runs, if kOrtSessionOptionsMemoryTraceFile is set.
+  std::string memory_trace_file_;
+  std::unique_ptr<MemoryTracer> memory_tracer_;
+#endif
 };
 
 struct SessionIOBinding {
@@ -5,6 +5,10 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
 namespace onnxruntime {
 
 //---------------------
@@ -110,6 +114,11 @@ void from_json(const json& j, TuningResults& trs) {
   j.at("validators").get_to(trs.validators);
 }
 
+// This function is called by nlohmann/json
+void to_json(json& j, const TuningResults& trs) {
+  j = json{{"ep", trs.ep}, {"results", trs.results}, {"validators", trs.validators}};
+}
+
 //---------------------------------------------------
 //--- end of session options related helpers ---
 //---------------------------------------------------
@@ -264,6 +273,129 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
   return Status::OK();
 }
 
+// Writes a new file and moves it over the old one, so a concurrent session never reads a partial file.
+static Status WriteJsonFile(const std::string& path, const json& content, const char* what) {
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::trunc);
+    file << content.dump(2);
+    ORT_RETURN_IF_NOT(file.good(), "Failed to write the ", what, " file ", tmp_path);
+  }
+
+  // rename does not replace an existing file on Windows
+  ORT_RETURN_IF(std::rename(tmp_path.c_str(), path.c_str()) != 0 &&
+                    (std::remove(path.c_str()) != 0 || std::rename(tmp_path.c_str(), path.c_str()) != 0),
+                "Failed to write the ", what, " file ", path);
+  return Status::OK();
+}
+
+Status LoadTuningResultsFile(const std::string& path,
+                             std::vector<TuningResults>& results,
+                             bool& file_found) {
+  results.clear();
+  file_found = false;
+  std::ifstream file(path);
+  if (!file) {
+    return Status::OK();
+  }
+
+  file_found = true;
+  Status status;
+  ORT_TRY {
+    results = json::parse(file).get<std::vector<TuningResults>>();
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Tuning results file ", path,
+                               " cannot be parsed. Error message: ", e.what());
+    });
+  }
+  return status;
+}
+
+Status SaveTuningResultsFile(const std::string& path, const std::vector<TuningResults>& results) {
+  // keep the results of the execution providers that are not in this session
+  std::vector<TuningResults> existing;
+  bool file_found = false;
+  if (!LoadTuningResultsFile(path, existing, file_found).IsOK()) {
+    LOGS_DEFAULT(WARNING) << "Overwriting the tuning results file " << path << " that cannot be parsed";
+    existing.clear();
+  }
+
+  std::vector<TuningResults> merged = results;
+  for (auto& trs : existing) {
+    if (std::none_of(results.begin(), results.end(), [&](const TuningResults& r) { return r.ep == trs.ep; })) {
+      merged.push_back(std::move(trs));
+    }
+  }
+
+  Status status;
+  ORT_TRY {
+    const json merged_json = merged;
+    if (file_found && merged_json == json(existing)) {
+      return Status::OK();
+    }
+    status = WriteJsonFile(path, merged_json, "tuning results");
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the tuning results file ", path,
+                               ". Error message: ", e.what());
+    });
+  }
+  return status;
+}
+
+Status LoadWarmupShapesFile(const std::string& path,
+                            std::unordered_map<std::string, TensorShape>& shapes,
+                            bool& file_found) {
+  shapes.clear();
+  file_found = false;
+  std::ifstream file(path);
+  if (!file) {
+    return Status::OK();
+  }
+
+  file_found = true;
+  Status status;
+  ORT_TRY {
+    std::unordered_map<std::string, TensorShape> loaded;
+    for (const auto& item : json::parse(file).at(kWarmupShapesKey).items()) {
+      const auto dims = item.value().get<std::vector<int64_t>>();
+      ORT_RETURN_IF(std::any_of(dims.begin(), dims.end(), [](int64_t dim) { return dim < 0; }),
+                    "Warmup shapes file ", path, " has a negative dimension for input ", item.key());
+      loaded.emplace(item.key(), TensorShape(dims));
+    }
+    shapes = std::move(loaded);
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Warmup shapes file ", path,
+                               " cannot be parsed. Error message: ", e.what());
+    });
+  }
+  return status;
+}
+
+Status SaveWarmupShapesFile(const std::string& path, const std::unordered_map<std::string, TensorShape>& shapes) {
+  Status status;
+  ORT_TRY {
+    json shapes_json = json::object();
+    for (const auto& [name, shape] : shapes) {
+      const auto dims = shape.GetDims();
+      shapes_json[name] = std::vector<int64_t>(dims.begin(), dims.end());
+    }
+    status = WriteJsonFile(path, json{{kWarmupShapesKey, shapes_json}}, "warmup shapes");
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the warmup shapes file ", path,
+                               ". Error message: ", e.what());
+    });
+  }
+  return status;
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
@@ -32,6 +32,7 @@ static constexpr const char* kOrtLoadConfigFromModelEnvVar = "ORT_LOAD_CONFIG_FR
 static constexpr const char* kOrtConfigKey = "ort_config";
 static constexpr const char* kSessionOptionsKey = "session_options";
 static constexpr const char* kTuningResultsKeys = "tuning_results";
+static constexpr const char* kWarmupShapesKey = "input_shapes";
 
 class JsonConfigParser {
  public:
@@ -62,6 +63,26 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
                                            /*out*/ std::vector<TuningResults>& results,
                                            /*out*/ bool& key_found);
 
+// Reads the tuning results of every execution provider from a file written by SaveTuningResultsFile.
+// file_found is false, and results empty, if the file does not exist.
+Status LoadTuningResultsFile(const std::string& path,
+                             /*out*/ std::vector<TuningResults>& results,
+                             /*out*/ bool& file_found);
+
+// Writes the tuning results to a file, replacing the entries of the same execution providers and keeping the others.
+// The file is replaced atomically and left untouched if nothing changed.
+Status SaveTuningResultsFile(const std::string& path, const std::vector<TuningResults>& results);
+
+// Reads the model input shapes of a file written by SaveWarmupShapesFile.
+// file_found is false, and shapes empty, if the file does not exist.
+Status LoadWarmupShapesFile(const std::string& path,
+                            /*out*/ std::unordered_map<std::string, TensorShape>& shapes,
+                            /*out*/ bool& file_found);
+
+// Writes the model input shapes to a file, as {"input_shapes": {"<input name>": [dims...], ...}}.
+// The file is replaced atomically.
+Status SaveWarmupShapesFile(const std::string& path, const std::unordered_map<std::string, TensorShape>& shapes);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -21,6 +21,9 @@
 #include "core/providers/dml/dml_provider_factory.h"
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <functional>
 #include <unordered_map>
 
@@ -59,6 +62,11 @@ void LoraAdapter::MemoryMap(const std::filesystem::path& file_path) {
 }
 
 namespace {
+uint64_t NextAdapterId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id++;
+}
+
 struct DataTransfer {
   std::unique_ptr<IExecutionProvider> ep;
   std::unique_ptr<IDataTransfer> data_transfer;
@@ -155,6 +163,232 @@ void LoraAdapter::InitializeParamsValues() {
   }
 
   params_values_.swap(params_values);
+  id_ = NextAdapterId();
+}
+
+void LoraAdapter::Stack(gsl::span<const LoraAdapter* const> adapters) {
+  ORT_ENFORCE(!adapters.empty(), "Expecting at least one adapter to stack");
+
+  DataTransfer data_transfer;
+  if (device_allocator_) {
+    ORT_THROW_IF_ERROR(GetDataTransfer(device_allocator_->Info(), data_transfer));
+  }
+
+  const auto& first_params = adapters[0]->params_values_;
+  for (const auto* adapter : adapters) {
+    ORT_ENFORCE(adapter != nullptr, "Adapter to stack is null");
+    ORT_ENFORCE(adapter->params_values_.size() == first_params.size(),
+                "All adapters to stack must have the same parameters");
+  }
+
+  const auto num_adapters = static_cast<int64_t>(adapters.size());
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  std::unordered_map<std::string, Param> params_values;
+  params_values.reserve(first_params.size());
+  for (const auto& [name, first_param] : first_params) {
+    const auto& first_tensor = first_param.GetMapped().Get<Tensor>();
+    ORT_ENFORCE(!first_tensor.IsDataTypeString(), "Lora parameter: ", name, " of string type can not be stacked");
+
+    TensorShapeVector dims;
+    dims.reserve(first_tensor.Shape().NumDimensions() + 1);
+    dims.push_back(num_adapters);
+    const auto first_dims = first_tensor.Shape().GetDims();
+    dims.insert(dims.end(), first_dims.begin(), first_dims.end());
+
+    Tensor stacked(first_tensor.DataType(), TensorShape(dims), cpu_allocator);
+    auto* dst = static_cast<std::byte*>(stacked.MutableDataRaw());
+    for (const auto* adapter : adapters) {
+      auto hit = adapter->params_values_.find(name);
+      ORT_ENFORCE(hit != adapter->params_values_.end(), "Lora parameter: ", name,
+                  " is missing from one of the adapters to stack");
+      const auto& tensor = hit->second.GetMapped().Get<Tensor>();
+      ORT_ENFORCE(tensor.DataType() == first_tensor.DataType() && tensor.Shape() == first_tensor.Shape(),
+                  "Lora parameter: ", name, " has a different type or shape in the adapters to stack");
+      memcpy(dst, tensor.DataRaw(), tensor.SizeInBytes());
+      dst += tensor.SizeInBytes();
+    }
+
+    OrtValue ort_value;
+    Tensor::InitOrtValue(std::move(stacked), ort_value);
+    if (device_allocator_) {
+      OrtValue ort_value_ondevice;
+      ORT_THROW_IF_ERROR(CreateOrtValueOnDevice(ort_value, device_allocator_,
+                                                data_transfer, ort_value_ondevice));
+      params_values.emplace(name, Param(std::move(ort_value), std::move(ort_value_ondevice)));
+    } else {
+      params_values.emplace(name, Param(std::move(ort_value)));
+    }
+  }
+
+  if (device_allocator_) {
+    ORT_THROW_IF_ERROR(data_transfer.Sync());
+  }
+
+  // the stacked parameters own their data
+  adapter_ = nullptr;
+  buffer_.emplace<std::monostate>();
+  params_values_.swap(params_values);
+  id_ = NextAdapterId();
+}
+
+LoraAdapterCache::LoraAdapterCache(AllocatorPtr device_allocator, size_t capacity_bytes)
+    : device_allocator_(std::move(device_allocator)), capacity_bytes_(capacity_bytes) {
+  ORT_ENFORCE(device_allocator_ != nullptr && strcmp(device_allocator_->Info().name, onnxruntime::CPU) != 0,
+              "Expecting on device allocator for LoraAdapterCache");
+  prefetch_thread_ = std::thread([this]() { PrefetchLoop(); });
+}
+
+LoraAdapterCache::~LoraAdapterCache() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  prefetch_cv_.notify_one();
+  prefetch_thread_.join();
+}
+
+std::shared_ptr<LoraAdapterCache::CachedAdapter> LoraAdapterCache::GetOrAddEntry(const LoraAdapter& adapter,
+                                                                                 bool& is_new) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto hit = entries_.find(adapter.Id());
+  if (hit != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, hit->second.lru_position);
+    is_new = false;
+    return hit->second.cached;
+  }
+
+  lru_.push_front(adapter.Id());
+  auto cached = std::make_shared<CachedAdapter>();
+  entries_.emplace(adapter.Id(), Entry{cached, lru_.begin()});
+  is_new = true;
+  return cached;
+}
+
+void LoraAdapterCache::Prefetch(const LoraAdapter& adapter) {
+  bool is_new = false;
+  auto cached = GetOrAddEntry(adapter, is_new);
+  if (is_new) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      prefetch_queue_.emplace_back(&adapter, std::move(cached));
+    }
+    prefetch_cv_.notify_one();
+  }
+}
+
+Status LoraAdapterCache::Acquire(const LoraAdapter& adapter, std::shared_ptr<const CachedAdapter>& cached) {
+  bool is_new = false;
+  auto entry = GetOrAddEntry(adapter, is_new);
+  if (!is_new) {
+    // do not wait behind other prefetches for an adapter whose copy has not started yet
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto queued = std::find_if(prefetch_queue_.begin(), prefetch_queue_.end(),
+                               [&entry](const auto& item) { return item.second == entry; });
+    if (queued != prefetch_queue_.end()) {
+      prefetch_queue_.erase(queued);
+      is_new = true;
+    }
+  }
+
+  if (is_new) {
+    Copy(adapter, entry);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  ready_cv_.wait(lock, [&entry]() { return entry->ready_; });
+  ORT_RETURN_IF_ERROR(entry->status_);
+  cached = std::move(entry);
+  return Status::OK();
+}
+
+void LoraAdapterCache::Copy(const LoraAdapter& adapter, const std::shared_ptr<CachedAdapter>& cached) {
+  const uint64_t id = adapter.Id();
+  std::vector<std::pair<std::string, OrtValue>> params;
+  size_t size_in_bytes = 0;
+
+  Status status;
+  ORT_TRY {
+    status = [&]() -> Status {
+      DataTransfer data_transfer;
+      ORT_RETURN_IF_ERROR(GetDataTransfer(device_allocator_->Info(), data_transfer));
+      params.reserve(adapter.GetParamNum());
+      auto [begin, end] = adapter.GetParamIterators();
+      for (; begin != end; ++begin) {
+        const auto& [name, param] = *begin;
+        const auto& device_or_mapped = param.GetDeviceOrMapped();
+        OrtValue ort_value;
+        if (device_or_mapped.Get<Tensor>().Location().device == device_allocator_->Info().device) {
+          // the adapter was created with an allocator for this device, share its copy
+          ort_value = device_or_mapped;
+        } else {
+          ORT_RETURN_IF_ERROR(CreateOrtValueOnDevice(param.GetMapped(), device_allocator_, data_transfer, ort_value));
+          size_in_bytes += ort_value.Get<Tensor>().SizeInBytes();
+        }
+        params.emplace_back(name, std::move(ort_value));
+      }
+      return data_transfer.Sync();
+    }();
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to copy the lora adapter to the device: ", ex.what());
+    });
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cached->params_ = std::move(params);
+    cached->size_in_bytes_ = size_in_bytes;
+    cached->status_ = status;
+    cached->ready_ = true;
+
+    auto hit = entries_.find(id);
+    if (hit != entries_.end() && hit->second.cached == cached) {
+      if (status.IsOK()) {
+        size_in_bytes_ += size_in_bytes;
+        EvictIfNeeded();
+      } else {
+        // a later Acquire retries the copy
+        lru_.erase(hit->second.lru_position);
+        entries_.erase(hit);
+      }
+    }
+  }
+  ready_cv_.notify_all();
+}
+
+void LoraAdapterCache::EvictIfNeeded() {
+  // the most recently used adapter is kept even if it alone exceeds the capacity
+  auto it = lru_.end();
+  while (size_in_bytes_ > capacity_bytes_ && --it != lru_.begin()) {
+    auto hit = entries_.find(*it);
+    // adapters that are still being copied are not accounted for yet
+    if (!hit->second.cached->ready_) {
+      continue;
+    }
+
+    size_in_bytes_ -= hit->second.cached->size_in_bytes_;
+    entries_.erase(hit);
+    it = lru_.erase(it);
+  }
+}
+
+void LoraAdapterCache::PrefetchLoop() {
+  for (;;) {
+    std::pair<const LoraAdapter*, std::shared_ptr<CachedAdapter>> item;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      prefetch_cv_.wait(lock, [this]() { return stop_ || !prefetch_queue_.empty(); });
+      if (stop_) {
+        return;
+      }
+
+      item = std::move(prefetch_queue_.front());
+      prefetch_queue_.pop_front();
+    }
+
+    Copy(*item.first, item.second);
+  }
 }
 
 }  // namespace lora
@@ -198,6 +432,52 @@ ORT_API_STATUS_IMPL(OrtApis::CreateLoraAdapterFromArray, _In_ const void* bytes,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateStackedLoraAdapter, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                    size_t num_adapters, _In_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** adapter) {
+  API_IMPL_BEGIN
+
+  std::unique_ptr<onnxruntime::lora::LoraAdapter> lora_adapter;
+  if (allocator != nullptr) {
+    auto alloc_ptr = std::make_shared<onnxruntime::IAllocatorImplWrappingOrtAllocator>(allocator);
+    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>(std::move(alloc_ptr));
+  } else {
+    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>();
+  }
+
+  auto* lora_adapters = reinterpret_cast<const onnxruntime::lora::LoraAdapter* const*>(adapters);
+  lora_adapter->Stack(gsl::make_span(lora_adapters, num_adapters));
+  *adapter = reinterpret_cast<OrtLoraAdapter*>(lora_adapter.release());
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API(void, OrtApis::ReleaseLoraAdapter, _Frees_ptr_opt_ OrtLoraAdapter* adapter) {
   delete reinterpret_cast<onnxruntime::lora::LoraAdapter*>(adapter);
 }
+
+ORT_API_STATUS_IMPL(OrtApis::CreateLoraAdapterCache, _In_ OrtAllocator* allocator, size_t capacity_bytes,
+                    _Outptr_ OrtLoraAdapterCache** cache) {
+  API_IMPL_BEGIN
+  if (allocator == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "A device allocator is required for the lora adapter cache");
+  }
+
+  auto alloc_ptr = std::make_shared<onnxruntime::IAllocatorImplWrappingOrtAllocator>(allocator);
+  auto adapter_cache = std::make_unique<onnxruntime::lora::LoraAdapterCache>(std::move(alloc_ptr), capacity_bytes);
+  *cache = reinterpret_cast<OrtLoraAdapterCache*>(adapter_cache.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseLoraAdapterCache, _Frees_ptr_opt_ OrtLoraAdapterCache* cache) {
+  delete reinterpret_cast<onnxruntime::lora::LoraAdapterCache*>(cache);
+}
+
+ORT_API_STATUS_IMPL(OrtApis::LoraAdapterCachePrefetch, _Inout_ OrtLoraAdapterCache* cache,
+                    _In_ const OrtLoraAdapter* adapter) {
+  API_IMPL_BEGIN
+  auto* adapter_cache = reinterpret_cast<onnxruntime::lora::LoraAdapterCache*>(cache);
+  adapter_cache->Prefetch(*reinterpret_cast<const onnxruntime::lora::LoraAdapter*>(adapter));
+  return nullptr;
+  API_IMPL_END
+}
@@ -11,8 +11,14 @@
 
 #include "lora/adapter_format_utils.h"
 
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <variant>
 #include <vector>
 #include <unordered_map>
@@ -98,6 +104,16 @@ class LoraAdapter {
   /// <param name="file_name"></param>
   void MemoryMap(const std::filesystem::path& file_path);
 
+  /// <summary>
+  /// Stacks the parameters of the adapters along a new leading dimension, so that the
+  /// parameter named X holds [adapters.size(), X dims...]. Used to feed the BatchedLoRA
+  /// contrib operator that selects an adapter per batch row.
+  /// All adapters must have the same parameter names, shapes and types.
+  /// A stacked adapter has no versions, they are reported as 0.
+  /// </summary>
+  /// <param name="adapters">adapters to stack, in the order of the adapter indices</param>
+  void Stack(gsl::span<const LoraAdapter* const> adapters);
+
   /// <summary>
   /// Returns number of parameters in the adapter.
   /// The number is expected to be even as lora params come in pairs.
@@ -107,12 +123,20 @@ class LoraAdapter {
     return params_values_.size();
   }
 
+  /// <summary>
+  /// Identifies the parameters currently held by the adapter, it changes every time they are (re)loaded.
+  /// Used as the key of LoraAdapterCache so that a reused address never hits a stale entry.
+  /// </summary>
+  uint64_t Id() const noexcept {
+    return id_;
+  }
+
   /// <summary>
   /// Gets lora format version
   /// </summary>
   /// <returns></returns>
   int FormatVersion() const noexcept {
-    return adapter_->format_version();
+    return adapter_ != nullptr ? adapter_->format_version() : 0;
   }
 
   /// <summary>
@@ -120,7 +144,7 @@ class LoraAdapter {
   /// </summary>
   /// <returns></returns>
   int AdapterVersion() const noexcept {
-    return adapter_->adapter_version();
+    return adapter_ != nullptr ? adapter_->adapter_version() : 0;
   }
 
   /// <summary>
@@ -128,7 +152,7 @@ class LoraAdapter {
   /// </summary>
   /// <returns></returns>
   int ModelVersion() const noexcept {
-    return adapter_->model_version();
+    return adapter_ != nullptr ? adapter_->model_version() : 0;
   }
 
   /// <summary>
@@ -170,6 +194,84 @@ class LoraAdapter {
   AllocatorPtr device_allocator_;
   const adapters::Adapter* adapter_{nullptr};
   std::unordered_map<std::string, Param> params_values_;
+  uint64_t id_{0};
+};
+
+/// <summary>
+/// Keeps device copies of the parameters of recently used adapters, so that activating a cached adapter
+/// does not copy anything. The least recently used adapters are evicted once the copies exceed the capacity.
+/// Adapters can be prefetched ahead of their use, the copies are then made on a dedicated thread.
+/// </summary>
+class LoraAdapterCache {
+ public:
+  LoraAdapterCache(AllocatorPtr device_allocator, size_t capacity_bytes);
+  ~LoraAdapterCache();
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LoraAdapterCache);
+
+  /// <summary>
+  /// Device copies of the parameters of one adapter.
+  /// They stay valid while referenced, even if the adapter is evicted in the meantime.
+  /// </summary>
+  class CachedAdapter {
+   public:
+    template <class NamesOutputIter, class TensorOutputIter>
+    void OutputAdapterParameters(NamesOutputIter names_out,
+                                 TensorOutputIter tensor_out) const {
+      for (const auto& [name, ort_value] : params_) {
+        *names_out = name.c_str();
+        ++names_out;
+        *tensor_out = &ort_value;
+        ++tensor_out;
+      }
+    }
+
+   private:
+    friend class LoraAdapterCache;
+    std::vector<std::pair<std::string, OrtValue>> params_;
+    size_t size_in_bytes_{0};
+    bool ready_{false};
+    Status status_;
+  };
+
+  /// <summary>
+  /// Queues the copy of the adapter to the device and returns immediately.
+  /// The adapter must stay alive until the copy is made, i.e. until it is acquired or the cache is destroyed.
+  /// </summary>
+  void Prefetch(const LoraAdapter& adapter);
+
+  /// <summary>
+  /// Returns the device copies of the adapter parameters. A miss copies them on the calling thread,
+  /// an adapter that is being prefetched is waited for.
+  /// </summary>
+  Status Acquire(const LoraAdapter& adapter, std::shared_ptr<const CachedAdapter>& cached);
+
+ private:
+  using LruList = std::list<uint64_t>;
+  struct Entry {
+    std::shared_ptr<CachedAdapter> cached;
+    LruList::iterator lru_position;
+  };
+
+  // Returns the entry of the adapter, creating it if missing. Sets is_new if the caller has to copy it.
+  std::shared_ptr<CachedAdapter> GetOrAddEntry(const LoraAdapter& adapter, bool& is_new);
+  void Copy(const LoraAdapter& adapter, const std::shared_ptr<CachedAdapter>& cached);
+  void EvictIfNeeded();
+  void PrefetchLoop();
+
+  AllocatorPtr device_allocator_;
+  const size_t capacity_bytes_;
+
+  std::mutex mutex_;
+  std::condition_variable ready_cv_;
+  std::unordered_map<uint64_t, Entry> entries_;
+  // most recently used first
+  LruList lru_;
+  size_t size_in_bytes_{0};
+
+  std::condition_variable prefetch_cv_;
+  std::deque<std::pair<const LoraAdapter*, std::shared_ptr<CachedAdapter>>> prefetch_queue_;
+  bool stop_{false};
+  std::thread prefetch_thread_;
 };
 
 }  // namespace lora
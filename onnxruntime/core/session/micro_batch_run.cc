@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/micro_batch_run.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#include "core/common/parse_string.h"
+#include "core/common/safeint.h"
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+// Returns a tensor that refers to `num_rows` rows of `tensor` starting at `first_row`, without copying.
+OrtValue SliceRows(const Tensor& tensor, int64_t first_row, int64_t num_rows) {
+  TensorShape shape = tensor.Shape();
+  const size_t row_bytes = SafeInt<size_t>(shape.SizeFromDimension(1)) * tensor.DataType()->Size();
+  shape[0] = num_rows;
+
+  OrtValue slice;
+  Tensor::InitOrtValue(tensor.DataType(), shape,
+                       const_cast<char*>(static_cast<const char*>(tensor.DataRaw())) + first_row * row_bytes,
+                       tensor.Location(), slice);
+  return slice;
+}
+
+Status Concatenate(const std::string& name, const AllocatorPtr& allocator,
+                   const std::vector<std::vector<OrtValue>>& fetches_per_micro_batch, size_t index, OrtValue& result) {
+  int64_t total_rows = 0;
+  const Tensor* first = nullptr;
+  for (const auto& fetches : fetches_per_micro_batch) {
+    const auto& value = fetches[index];
+    ORT_RETURN_IF_NOT(value.IsTensor(), "Output ", name, " is not a tensor and can't be split into micro-batches.");
+    const auto& tensor = value.Get<Tensor>();
+    ORT_RETURN_IF_NOT(tensor.Location().device.Type() == OrtDevice::CPU, "Output ", name,
+                      " is not a CPU tensor and can't be split into micro-batches.");
+    ORT_RETURN_IF(tensor.Shape().NumDimensions() == 0, "Output ", name,
+                  " is a scalar and can't be split into micro-batches.");
+    if (first == nullptr) {
+      first = &tensor;
+    } else {
+      ORT_RETURN_IF_NOT(tensor.DataType() == first->DataType() &&
+                            tensor.Shape().Slice(1) == first->Shape().Slice(1),
+                        "Output ", name, " has shape ", tensor.Shape(), " in one micro-batch and ", first->Shape(),
+                        " in another, they can't be concatenated.");
+    }
+    total_rows += tensor.Shape()[0];
+  }
+
+  TensorShape shape = first->Shape();
+  shape[0] = total_rows;
+  Tensor::InitOrtValue(first->DataType(), shape, allocator, result);
+  auto& output = *result.GetMutable<Tensor>();
+
+  int64_t offset = 0;
+  for (const auto& fetches : fetches_per_micro_batch) {
+    const auto& tensor = fetches[index].Get<Tensor>();
+    const int64_t count = tensor.Shape().Size();
+    if (tensor.IsDataTypeString()) {
+      std::copy_n(tensor.Data<std::string>(), count, output.MutableData<std::string>() + offset);
+    } else {
+      std::memcpy(static_cast<char*>(output.MutableDataRaw()) + SafeInt<size_t>(offset) * tensor.DataType()->Size(),
+                  tensor.DataRaw(), tensor.SizeInBytes());
+    }
+    offset += count;
+  }
+
+  return Status::OK();
+}
+}  // namespace
+
+Status MicroBatchRun::GetMicroBatchCount(const RunOptions& run_options, size_t& micro_batch_count) {
+  micro_batch_count = 1;
+  const auto config = run_options.config_options.GetConfigEntry(kOrtRunOptionsConfigMicroBatchCount);
+  if (config.has_value() && !TryParseStringWithClassicLocale<size_t>(*config, micro_batch_count)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to parse the micro-batch count: ", *config);
+  }
+
+  micro_batch_count = std::max<size_t>(micro_batch_count, 1);
+  return Status::OK();
+}
+
+Status MicroBatchRun::Run(InferenceSession& session, const RunOptions& run_options, size_t micro_batch_count,
+                          gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                          gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches) {
+  for (const auto& fetch : fetches) {
+    ORT_RETURN_IF(fetch.IsAllocated(), "Pre-allocated fetches are not supported with micro-batches.");
+  }
+
+  ORT_RETURN_IF(feeds.empty() || !feeds[0].IsTensor() || feeds[0].Get<Tensor>().Shape().NumDimensions() == 0,
+                "The first feed must be a tensor with a batch dimension to split the run into micro-batches.");
+  const int64_t batch_size = feeds[0].Get<Tensor>().Shape()[0];
+  const int64_t count = std::min<int64_t>(static_cast<int64_t>(micro_batch_count), batch_size);
+
+  // the micro-batches run as normal runs
+  RunOptions micro_batch_run_options = run_options;
+  micro_batch_run_options.config_options.configurations.erase(kOrtRunOptionsConfigMicroBatchCount);
+  if (count <= 1) {
+    return session.Run(micro_batch_run_options, feed_names, feeds, output_names, &fetches, nullptr);
+  }
+
+  std::vector<std::vector<OrtValue>> micro_batch_feeds(static_cast<size_t>(count));
+  int64_t first_row = 0;
+  for (int64_t i = 0; i < count; ++i) {
+    // the first batch_size % count micro-batches get one row more
+    const int64_t rows = batch_size / count + (i < batch_size % count ? 1 : 0);
+    auto& micro_feeds = micro_batch_feeds[static_cast<size_t>(i)];
+    micro_feeds.reserve(feeds.size());
+    for (const auto& feed : feeds) {
+      if (feed.IsTensor() && feed.Get<Tensor>().Shape().NumDimensions() > 0 &&
+          feed.Get<Tensor>().Shape()[0] == batch_size) {
+        micro_feeds.push_back(SliceRows(feed.Get<Tensor>(), first_row, rows));
+      } else {
+        micro_feeds.push_back(feed);
+      }
+    }
+    first_row += rows;
+  }
+
+  std::vector<std::vector<OrtValue>> micro_batch_fetches(static_cast<size_t>(count));
+  std::vector<Status> statuses(static_cast<size_t>(count));
+  auto run_micro_batch = [&](size_t i) {
+    ORT_TRY {
+      statuses[i] = session.Run(micro_batch_run_options, feed_names, micro_batch_feeds[i], output_names,
+                                &micro_batch_fetches[i], nullptr);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+      });
+    }
+  };
+
+  // the calling thread runs the first micro-batch
+  std::vector<std::thread> threads;
+  threads.reserve(static_cast<size_t>(count - 1));
+  for (size_t i = 1; i < static_cast<size_t>(count); ++i) {
+    threads.emplace_back(run_micro_batch, i);
+  }
+  run_micro_batch(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  auto allocator = std::make_shared<CPUAllocator>();
+  fetches.resize(output_names.size());
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    ORT_RETURN_IF_ERROR(Concatenate(output_names[i], allocator, micro_batch_fetches, i, fetches[i]));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
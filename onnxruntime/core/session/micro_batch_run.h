@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+/**
+ * Runs a request as several micro-batches so the stages of a model partitioned over several devices overlap.
+ *
+ * The feeds whose first dimension is the batch size, i.e. the first dimension of the first feed, are split along it
+ * into `micro_batch_count` micro-batches without copying, the other feeds are fed whole to every micro-batch.
+ * The micro-batches run concurrently as separate runs of `session`, each on its own device streams, so while one
+ * micro-batch runs the nodes assigned to one device the next one runs the nodes of another device.
+ * The fetches of the micro-batches are concatenated along their first dimension into CPU tensors.
+ *
+ * The number of micro-batches is configured with kOrtRunOptionsConfigMicroBatchCount.
+ */
+class MicroBatchRun {
+ public:
+  // Returns the number of micro-batches requested by `run_options`, 1 if micro-batching is not requested.
+  static Status GetMicroBatchCount(const RunOptions& run_options, size_t& micro_batch_count);
+
+  // Fetches must not be pre-allocated.
+  static Status Run(InferenceSession& session, const RunOptions& run_options, size_t micro_batch_count,
+                    gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                    gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+};
+
+}  // namespace onnxruntime
@@ -5,6 +5,8 @@
 #include "core/session/allocator_adapters.h"
 #include "core/session/inference_session_utils.h"
 #include "core/session/IOBinding.h"
+#include "core/session/run_context.h"
+#include "core/session/session_pipeline.h"
 #include "core/framework/allocator.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_provider.h"
@@ -817,11 +819,14 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromArray, _In_ const OrtEnv* env, _In
 
 namespace {
 // Checks if there are active lora adapters and adjusts input spans.
-void CheckAndAdjustInputSpansForLora(const OrtRunOptions& run_options,
-                                     InlinedVector<const char*>& input_names_with_lora,
-                                     InlinedVector<const OrtValue*>& inputs_with_lora,
-                                     gsl::span<const char* const>& input_names,
-                                     gsl::span<const OrtValue* const>& inputs) {
+// The device copies of adapters served from the lora adapter cache are kept alive by cached_adapters.
+Status CheckAndAdjustInputSpansForLora(
+    const OrtRunOptions& run_options,
+    InlinedVector<const char*>& input_names_with_lora,
+    InlinedVector<const OrtValue*>& inputs_with_lora,
+    InlinedVector<std::shared_ptr<const lora::LoraAdapterCache::CachedAdapter>>& cached_adapters,
+    gsl::span<const char* const>& input_names,
+    gsl::span<const OrtValue* const>& inputs) {
   size_t total_lora_params = 0;
   for (const lora::LoraAdapter* ad : run_options.active_adapters) {
     total_lora_params += ad->GetParamNum();
@@ -833,12 +838,21 @@ void CheckAndAdjustInputSpansForLora(const OrtRunOptions& run_options,
   std::copy(inputs.begin(), inputs.end(), std::back_inserter(inputs_with_lora));
 
   for (const lora::LoraAdapter* ad : run_options.active_adapters) {
-    ad->OutputAdapterParameters(std::back_inserter(input_names_with_lora),
-                                std::back_inserter(inputs_with_lora));
+    if (run_options.lora_adapter_cache != nullptr) {
+      std::shared_ptr<const lora::LoraAdapterCache::CachedAdapter> cached;
+      ORT_RETURN_IF_ERROR(run_options.lora_adapter_cache->Acquire(*ad, cached));
+      cached->OutputAdapterParameters(std::back_inserter(input_names_with_lora),
+                                      std::back_inserter(inputs_with_lora));
+      cached_adapters.push_back(std::move(cached));
+    } else {
+      ad->OutputAdapterParameters(std::back_inserter(input_names_with_lora),
+                                  std::back_inserter(inputs_with_lora));
+    }
   }
 
   input_names = gsl::make_span(input_names_with_lora);
   inputs = gsl::make_span(inputs_with_lora);
+  return Status::OK();
 }
 
 }  // namespace
@@ -883,14 +897,17 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
     if (!run_options->active_adapters.empty()) {
       InlinedVector<const char*> input_names_with_lora;
       InlinedVector<const OrtValue*> input_with_lora;
-
-      CheckAndAdjustInputSpansForLora(*run_options, input_names_with_lora, input_with_lora, input_names_span, input_span);
-
-      status = session->Run(*run_options,
-                            input_names_span,
-                            input_span,
-                            output_name_span,
-                            output_span);
+      InlinedVector<std::shared_ptr<const lora::LoraAdapterCache::CachedAdapter>> cached_adapters;
+
+      status = CheckAndAdjustInputSpansForLora(*run_options, input_names_with_lora, input_with_lora, cached_adapters,
+                                               input_names_span, input_span);
+      if (status.IsOK()) {
+        status = session->Run(*run_options,
+                              input_names_span,
+                              input_span,
+                              output_name_span,
+                              output_span);
+      }
     } else {
       status = session->Run(*run_options,
                             input_names_span,
@@ -938,6 +955,128 @@ ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::WarmupSession, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const int64_t* const* input_shapes,
+                    _In_reads_(input_len) const size_t* input_shape_lens, size_t input_len,
+                    _In_opt_ RunAsyncCallbackFn callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::unordered_map<std::string, onnxruntime::TensorShape> shapes;
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    if (input_shape_lens[i] != 0 && input_shapes[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input shape cannot be null");
+    }
+    auto dims = gsl::make_span(input_shapes[i], input_shape_lens[i]);
+    if (std::any_of(dims.begin(), dims.end(), [](int64_t dim) { return dim < 0; })) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input shape cannot have negative dimensions");
+    }
+    shapes[input_names[i]] = onnxruntime::TensorShape(dims);
+  }
+
+  if (callback != nullptr) {
+    return ToOrtStatus(session->WarmupAsync(run_options, std::move(shapes), callback, user_data));
+  }
+
+  if (run_options == nullptr) {
+    OrtRunOptions default_run_options;
+    return ToOrtStatus(session->Warmup(default_run_options, shapes));
+  }
+  return ToOrtStatus(session->Warmup(*run_options, shapes));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateSessionPipeline, _In_reads_(num_sessions) OrtSession* const* sessions,
+                    size_t num_sessions, _Outptr_ OrtSessionPipeline** out) {
+  API_IMPL_BEGIN
+  std::vector<::onnxruntime::InferenceSession*> stages;
+  stages.reserve(num_sessions);
+  for (size_t i = 0; i != num_sessions; ++i) {
+    stages.push_back(reinterpret_cast<::onnxruntime::InferenceSession*>(sessions[i]));
+  }
+
+  std::unique_ptr<::onnxruntime::SessionPipeline> pipeline;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(::onnxruntime::SessionPipeline::Create(std::move(stages), pipeline));
+  *out = reinterpret_cast<OrtSessionPipeline*>(pipeline.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseSessionPipeline, _Frees_ptr_opt_ OrtSessionPipeline* pipeline) {
+  delete reinterpret_cast<::onnxruntime::SessionPipeline*>(pipeline);
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionPipelineLink, _Inout_ OrtSessionPipeline* pipeline, size_t from_session,
+                    _In_ const char* output_name, size_t to_session, _In_ const char* input_name) {
+  API_IMPL_BEGIN
+  if (output_name == nullptr || input_name == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input and output names cannot be null");
+  }
+  auto session_pipeline = reinterpret_cast<::onnxruntime::SessionPipeline*>(pipeline);
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session_pipeline->Link(from_session, output_name, to_session, input_name));
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunSessionPipeline, _Inout_ OrtSessionPipeline* pipeline,
+                    _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Out_writes_all_(output_names_len) OrtValue** outputs) {
+  API_IMPL_BEGIN
+  auto session_pipeline = reinterpret_cast<::onnxruntime::SessionPipeline*>(pipeline);
+
+  InlinedVector<std::string> feed_names;
+  InlinedVector<OrtValue> feeds;
+  feed_names.reserve(input_len);
+  feeds.reserve(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    if (inputs[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input cannot be null");
+    }
+    feed_names.emplace_back(input_names[i]);
+    feeds.emplace_back(*inputs[i]);
+  }
+
+  InlinedVector<std::string> fetch_names;
+  fetch_names.reserve(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names[i] == nullptr || output_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    fetch_names.emplace_back(output_names[i]);
+  }
+
+  std::vector<OrtValue> fetches;
+  if (run_options == nullptr) {
+    OrtRunOptions default_run_options;
+    ORT_API_RETURN_IF_STATUS_NOT_OK(session_pipeline->Run(default_run_options, feed_names, feeds, fetch_names,
+                                                          fetches));
+  } else {
+    ORT_API_RETURN_IF_STATUS_NOT_OK(session_pipeline->Run(*run_options, feed_names, feeds, fetch_names, fetches));
+  }
+
+  // create all the values before handing them out, so a failed allocation doesn't leak the others
+  InlinedVector<std::unique_ptr<OrtValue>> output_values;
+  output_values.reserve(output_names_len);
+  for (auto& fetch : fetches) {
+    output_values.push_back(std::make_unique<OrtValue>(std::move(fetch)));
+  }
+  for (size_t i = 0; i != output_names_len; ++i) {
+    outputs[i] = output_values[i].release();
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 struct OrtIoBinding {
   std::unique_ptr<::onnxruntime::IOBinding> binding_;
   explicit OrtIoBinding(std::unique_ptr<::onnxruntime::IOBinding>&& binding) : binding_(std::move(binding)) {}
@@ -967,6 +1106,94 @@ ORT_API_STATUS_IMPL(OrtApis::RunWithBinding, _Inout_ OrtSession* sess, _In_ cons
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateRunContext, _In_ OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtRunContext** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  InlinedVector<std::string> feed_names;
+  feed_names.reserve(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    feed_names.emplace_back(input_names[i]);
+  }
+
+  InlinedVector<std::string> fetch_names;
+  fetch_names.reserve(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names[i] == nullptr || output_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    fetch_names.emplace_back(output_names[i]);
+  }
+
+  std::unique_ptr<::onnxruntime::RunContext> run_context;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->NewRunContext(feed_names, fetch_names, &run_context));
+  *out = reinterpret_cast<OrtRunContext*>(run_context.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseRunContext, _Frees_ptr_opt_ OrtRunContext* run_context) {
+  delete reinterpret_cast<::onnxruntime::RunContext*>(run_context);
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunContextBindInput, _Inout_ OrtRunContext* run_context, size_t index,
+                    _In_ const OrtValue* value) {
+  API_IMPL_BEGIN
+  auto context = reinterpret_cast<::onnxruntime::RunContext*>(run_context);
+  ORT_API_RETURN_IF_STATUS_NOT_OK(context->BindInput(index, *value));
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunContextBindOutput, _Inout_ OrtRunContext* run_context, size_t index,
+                    _In_ const OrtValue* value) {
+  API_IMPL_BEGIN
+  auto context = reinterpret_cast<::onnxruntime::RunContext*>(run_context);
+  ORT_API_RETURN_IF_STATUS_NOT_OK(context->BindOutput(index, *value));
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunContextGetOutput, _In_ const OrtRunContext* run_context, size_t index,
+                    _Outptr_ const OrtValue** out) {
+  API_IMPL_BEGIN
+  auto context = reinterpret_cast<const ::onnxruntime::RunContext*>(run_context);
+  if (index >= context->GetOutputCount()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output index is out of bounds");
+  }
+  *out = &context->GetOutput(index);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunWithContext, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtRunContext* run_context) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  auto context = reinterpret_cast<::onnxruntime::RunContext*>(run_context);
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions default_run_options;
+    status = session->Run(default_run_options, *context);
+  } else {
+    if (!run_options->active_adapters.empty()) {
+      LOGS(*session->GetLogger(), WARNING)
+          << "RunWithContext() has active adapters specified, but won't have an effect";
+    }
+    status = session->Run(*run_options, *context);
+  }
+  if (!status.IsOK()) {
+    return ToOrtStatus(status);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::CreateIoBinding, _Inout_ OrtSession* sess, _Outptr_ OrtIoBinding** out) {
   API_IMPL_BEGIN
   auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
@@ -1176,6 +1403,28 @@ ORT_API_STATUS_IMPL(OrtApis::FillStringTensor, _Inout_ OrtValue* value, _In_ con
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::FillStringTensorFromOffsets, _Inout_ OrtValue* value, _In_ const void* data,
+                    size_t data_len, _In_ const int64_t* offsets, size_t offsets_len) {
+  TENSOR_READWRITE_API_BEGIN
+  auto* dst = tensor->MutableData<std::string>();
+  const auto len = static_cast<size_t>(tensor->Shape().Size());
+  if (offsets_len != len + 1) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "offsets array must have tensor size plus one elements");
+  }
+  if (offsets[0] != 0 || static_cast<uint64_t>(offsets[len]) > data_len) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "offsets must start at 0 and end within the data buffer");
+  }
+  const char* src = static_cast<const char*>(data);
+  for (size_t i = 0; i != len; ++i) {
+    if (offsets[i + 1] < offsets[i]) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "offsets must be monotonically increasing");
+    }
+    dst[i].assign(src + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]));
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::FillStringTensorElement, _Inout_ OrtValue* value, _In_ const char* s, size_t index) {
   TENSOR_READWRITE_API_BEGIN
   auto* dst = tensor->MutableData<std::string>();
@@ -2268,6 +2517,24 @@ ORT_API_STATUS_IMPL(OrtApis::SessionGetProfilingStartTimeNs, _In_ const OrtSessi
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetNodeLatencyStats, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  *out = StrDup(session->GetProfiling().GetNodeLatencyStats().ToJson(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetThreadPoolStats, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  *out = StrDup(session->GetThreadPoolStats(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 // End support for non-tensor types
 
 ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfg, _In_ size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
@@ -2302,6 +2569,8 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "max_power_of_two_extend_bytes") == 0) {
       cfg->max_power_of_two_extend_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "small_block_cache_bytes") == 0) {
+      cfg->small_block_cache_bytes = static_cast<int64_t>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2809,6 +3078,25 @@ static constexpr OrtApi ort_api_1_to_21 = {
     &OrtApis::RunOptionsAddActiveLoraAdapter,
 
     &OrtApis::SetEpDynamicOptions,
+    &OrtApis::FillStringTensorFromOffsets,
+    &OrtApis::CreateStackedLoraAdapter,
+    &OrtApis::CreateLoraAdapterCache,
+    &OrtApis::ReleaseLoraAdapterCache,
+    &OrtApis::LoraAdapterCachePrefetch,
+    &OrtApis::RunOptionsSetLoraAdapterCache,
+    &OrtApis::SessionGetNodeLatencyStats,
+    &OrtApis::SessionGetThreadPoolStats,
+    &OrtApis::CreateRunContext,
+    &OrtApis::ReleaseRunContext,
+    &OrtApis::RunContextBindInput,
+    &OrtApis::RunContextBindOutput,
+    &OrtApis::RunContextGetOutput,
+    &OrtApis::RunWithContext,
+    &OrtApis::WarmupSession,
+    &OrtApis::CreateSessionPipeline,
+    &OrtApis::ReleaseSessionPipeline,
+    &OrtApis::SessionPipelineLink,
+    &OrtApis::RunSessionPipeline,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
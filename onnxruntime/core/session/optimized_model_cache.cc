@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/optimized_model_cache.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "onnxruntime_config.h"
+#include "core/common/cpuid_info.h"
+#include "core/common/narrow.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/session_options.h"
+#include "core/graph/model.h"
+#include "core/platform/env.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Incremental 128-bit hash, seeded with the previous value for each chunk.
+class Hasher {
+ public:
+  void Update(const void* data, size_t size) {
+    MurmurHash3::x86_128(data, narrow<int32_t>(size), hash_[0], &hash_);
+  }
+
+  void Update(const std::string& str) { Update(str.data(), str.size()); }
+
+  std::string HexDigest() const {
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0');
+    for (uint32_t word : hash_) {
+      oss << std::setw(8) << word;
+    }
+    return oss.str();
+  }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+Status HashFile(const PathString& path, Hasher& hasher) {
+  std::ifstream stream(path, std::ifstream::in | std::ifstream::binary);
+  ORT_RETURN_IF_NOT(stream, "Failed to open ", ToUTF8String(path), " to compute the optimized model cache key.");
+
+  std::vector<char> buffer(size_t{1} << 20);
+  while (stream) {
+    stream.read(buffer.data(), buffer.size());
+    const auto num_read = static_cast<size_t>(stream.gcount());
+    if (num_read > 0) {
+      hasher.Update(buffer.data(), num_read);
+    }
+  }
+  ORT_RETURN_IF_NOT(stream.eof(), "Failed to read ", ToUTF8String(path),
+                    " to compute the optimized model cache key.");
+  return Status::OK();
+}
+
+// Entries of an unordered map in a deterministic order.
+template <typename Map>
+std::vector<std::pair<std::string, std::string>> SortedEntries(const Map& map) {
+  std::vector<std::pair<std::string, std::string>> entries(map.begin(), map.end());
+  std::sort(entries.begin(), entries.end());
+  return entries;
+}
+
+std::string GetFingerprint(const SessionOptions& session_options, const ExecutionProviders& execution_providers,
+                           const InlinedHashSet<std::string>& optimizers_to_disable) {
+  std::ostringstream oss;
+  oss << "ort_version=" << ORT_VERSION
+      << ";graph_optimization_level=" << static_cast<int>(session_options.graph_optimization_level)
+      << ";max_num_graph_transformation_steps=" << session_options.max_num_graph_transformation_steps
+      << ";use_deterministic_compute=" << session_options.use_deterministic_compute;
+
+  // the optimizers pick kernels and fusions by the instruction sets of the CPU, e.g. NCHWc blocking depends on AVX512
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  oss << ";cpu=" << cpuid_info.HasAVX() << cpuid_info.HasAVX2() << cpuid_info.HasAVX512f()
+      << cpuid_info.HasAVX512Skylake() << cpuid_info.HasAVX512_BF16() << cpuid_info.HasAMX_BF16()
+      << cpuid_info.HasF16C() << cpuid_info.HasArmNeonDot() << cpuid_info.HasArmNeon_I8MM()
+      << cpuid_info.HasArmSVE_I8MM() << cpuid_info.HasArmNeon_BF16();
+
+  for (const auto& ep : execution_providers) {
+    oss << ";ep=" << ep->Type();
+    for (const auto& [name, value] : SortedEntries(ep->GetProviderOptions())) {
+      oss << "," << name << "=" << value;
+    }
+  }
+
+  for (const auto& [name, value] : SortedEntries(session_options.config_options.configurations)) {
+    // where the cache is doesn't change what is in it
+    if (name != kOrtSessionOptionsOptimizedModelCacheDir) {
+      oss << ";config:" << name << "=" << value;
+    }
+  }
+
+  for (const auto& dim_override : session_options.free_dimension_overrides) {
+    oss << ";free_dim:" << static_cast<int>(dim_override.dim_identifier_type) << ":" << dim_override.dim_identifier
+        << "=" << dim_override.dim_value;
+  }
+
+  std::vector<std::string> disabled(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  std::sort(disabled.begin(), disabled.end());
+  for (const auto& name : disabled) {
+    oss << ";disabled:" << name;
+  }
+
+  return oss.str();
+}
+
+}  // namespace
+
+Status OptimizedModelCache::ComputeKey(const Model& model, const PathString& model_location,
+                                       const SessionOptions& session_options,
+                                       const ExecutionProviders& execution_providers,
+                                       const InlinedHashSet<std::string>& optimizers_to_disable, std::string& key) {
+  Hasher hasher;
+  if (!model_location.empty()) {
+    // external data files are referenced by the model file but not hashed, they are expected to change only
+    // together with it.
+    ORT_RETURN_IF_ERROR(HashFile(model_location, hasher));
+  } else {
+    hasher.Update(model.ToProto().SerializeAsString());
+  }
+
+  hasher.Update(GetFingerprint(session_options, execution_providers, optimizers_to_disable));
+  key = hasher.HexDigest();
+  return Status::OK();
+}
+
+PathString OptimizedModelCache::GetModelPath(const std::string& key) const {
+  return (std::filesystem::path(cache_dir_) / ToPathString(key + ".onnx")).native();
+}
+
+Status OptimizedModelCache::Save(Model& model, const std::string& key) const {
+  const auto& env = Env::Default();
+  if (!env.FolderExists(cache_dir_)) {
+    ORT_RETURN_IF_ERROR(env.CreateFolder(cache_dir_));
+  }
+
+  // the external data file is unique to this writer as the model that references it may not win the rename below
+  const std::string unique_name = key + "_" + std::to_string(env.GetSelfPid()) + "_" +
+                                  std::to_string(reinterpret_cast<uintptr_t>(&model));
+  const std::filesystem::path dir{cache_dir_};
+  const auto tmp_model_path = dir / ToPathString(unique_name + ".onnx.tmp");
+  const auto data_file_name = std::filesystem::path{ToPathString(unique_name + ".onnx.data")};
+
+  Status status;
+  ORT_TRY {
+    Graph::OffsetAlignmentInfo align_info;
+    align_info.align_offset = true;
+    status = Model::SaveWithExternalInitializers(model, tmp_model_path, data_file_name, 1024, align_info);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to save the optimized model: ", ex.what());
+    });
+  }
+
+  std::error_code ec;
+  if (status.IsOK()) {
+    std::filesystem::rename(tmp_model_path, GetModelPath(key), ec);
+    if (ec) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename the optimized model to ",
+                               ToUTF8String(GetModelPath(key)), ": ", ec.message());
+    }
+  }
+
+  if (!status.IsOK()) {
+    std::filesystem::remove(tmp_model_path, ec);
+    std::filesystem::remove(dir / data_file_name, ec);
+  }
+
+  return status;
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
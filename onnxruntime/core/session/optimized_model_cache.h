@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+
+namespace onnxruntime {
+
+class ExecutionProviders;
+class Model;
+struct SessionOptions;
+
+/**
+ * Directory of optimized models, used to skip the graph optimizations when a session is created again for the same
+ * model and configuration.
+ *
+ * Entries are ONNX models saved after the graph transformations and the partitioning of a session, with the large
+ * initializers in an external data file next to them. An entry is keyed by the hash of the original model together
+ * with a fingerprint of everything else that affects the optimized graph: the onnxruntime version, the execution
+ * providers and their options, the instruction sets of the CPU, the optimization level and the session config.
+ * A change to any of them selects a different entry, so stale entries are never used, only left on disk.
+ *
+ * Entries are written to a temporary name and renamed, so concurrent sessions can share a directory.
+ */
+class OptimizedModelCache {
+ public:
+  explicit OptimizedModelCache(const PathString& cache_dir) : cache_dir_(cache_dir) {}
+
+  // Computes the key of the entry for `model`, which was loaded from `model_location` (empty if it was loaded from
+  // memory). The contents of the file are hashed if there is one, the serialized model otherwise.
+  static Status ComputeKey(const Model& model, const PathString& model_location,
+                           const SessionOptions& session_options, const ExecutionProviders& execution_providers,
+                           const InlinedHashSet<std::string>& optimizers_to_disable, std::string& key);
+
+  // Path of the model of the entry `key`. The entry exists if the file does.
+  PathString GetModelPath(const std::string& key) const;
+
+  // Saves `model` as the entry `key`, replacing an existing one.
+  Status Save(Model& model, const std::string& key) const;
+
+ private:
+  PathString cache_dir_;
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -533,4 +533,49 @@ ORT_API_STATUS_IMPL(RunOptionsAddActiveLoraAdapter, _Inout_ OrtRunOptions* optio
 
 ORT_API_STATUS_IMPL(SetEpDynamicOptions, _Inout_ OrtSession* sess, _In_reads_(kv_len) const char* const* keys,
                     _In_reads_(kv_len) const char* const* values, _In_ size_t kv_len);
+
+ORT_API_STATUS_IMPL(FillStringTensorFromOffsets, _Inout_ OrtValue* value, _In_reads_bytes_(data_len) const void* data,
+                    size_t data_len, _In_reads_(offsets_len) const int64_t* offsets, size_t offsets_len);
+ORT_API_STATUS_IMPL(CreateStackedLoraAdapter, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                    size_t num_adapters, _In_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** out);
+ORT_API_STATUS_IMPL(CreateLoraAdapterCache, _In_ OrtAllocator* allocator, size_t capacity_bytes,
+                    _Outptr_ OrtLoraAdapterCache** out);
+ORT_API(void, ReleaseLoraAdapterCache, _Frees_ptr_opt_ OrtLoraAdapterCache*);
+ORT_API_STATUS_IMPL(LoraAdapterCachePrefetch, _Inout_ OrtLoraAdapterCache* cache, _In_ const OrtLoraAdapter* adapter);
+ORT_API_STATUS_IMPL(RunOptionsSetLoraAdapterCache, _Inout_ OrtRunOptions* options, _In_opt_ OrtLoraAdapterCache* cache);
+
+ORT_API_STATUS_IMPL(SessionGetNodeLatencyStats, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(SessionGetThreadPoolStats, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(CreateRunContext, _In_ OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtRunContext** out);
+ORT_API(void, ReleaseRunContext, _Frees_ptr_opt_ OrtRunContext*);
+ORT_API_STATUS_IMPL(RunContextBindInput, _Inout_ OrtRunContext* run_context, size_t index,
+                    _In_ const OrtValue* value);
+ORT_API_STATUS_IMPL(RunContextBindOutput, _Inout_ OrtRunContext* run_context, size_t index,
+                    _In_ const OrtValue* value);
+ORT_API_STATUS_IMPL(RunContextGetOutput, _In_ const OrtRunContext* run_context, size_t index,
+                    _Outptr_ const OrtValue** out);
+ORT_API_STATUS_IMPL(RunWithContext, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtRunContext* run_context);
+ORT_API_STATUS_IMPL(WarmupSession, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const int64_t* const* input_shapes,
+                    _In_reads_(input_len) const size_t* input_shape_lens, size_t input_len,
+                    _In_opt_ RunAsyncCallbackFn callback, _In_opt_ void* user_data);
+
+ORT_API_STATUS_IMPL(CreateSessionPipeline, _In_reads_(num_sessions) OrtSession* const* sessions, size_t num_sessions,
+                    _Outptr_ OrtSessionPipeline** out);
+ORT_API(void, ReleaseSessionPipeline, _Frees_ptr_opt_ OrtSessionPipeline*);
+ORT_API_STATUS_IMPL(SessionPipelineLink, _Inout_ OrtSessionPipeline* pipeline, size_t from_session,
+                    _In_ const char* output_name, size_t to_session, _In_ const char* input_name);
+ORT_API_STATUS_IMPL(RunSessionPipeline, _Inout_ OrtSessionPipeline* pipeline, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Out_writes_all_(output_names_len) OrtValue** outputs);
 }  // namespace OrtApis
@@ -11,12 +11,20 @@
 #include "core/session/allocator_adapters.h"
 #include "core/session/user_logging_sink.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/framework/provider_shutdown.h"
+#include "core/platform/env_var_utils.h"
 #include "core/platform/logging/make_platform_default_log_sink.h"
 
 using namespace onnxruntime;
 using namespace onnxruntime::logging;
 
+namespace {
+// Set to 1 to send the messages to the default log sink from a background thread, so that logging doesn't block the
+// threads running the models on the I/O of the sink.
+constexpr const char* kAsyncLoggingEnvVar = "ORT_ASYNC_LOGGING";
+}  // namespace
+
 std::unique_ptr<OrtEnv> OrtEnv::p_instance_;
 int OrtEnv::ref_count_ = 0;
 onnxruntime::OrtMutex OrtEnv::m_;
@@ -46,6 +54,9 @@ OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_inf
 
     } else {
       sink = MakePlatformDefaultLogSink();
+      if (ParseEnvironmentVariableWithDefault<bool>(kAsyncLoggingEnvVar, false)) {
+        sink = std::make_unique<AsyncSink>(std::move(sink));
+      }
     }
     auto etwOverrideSeverity = logging::OverrideLevelWithEtw(static_cast<Severity>(lm_info.default_warning_level));
     sink = EnhanceSinkWithEtw(std::move(sink), static_cast<Severity>(lm_info.default_warning_level),
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/prefix_kv_cache.h"
+
+#include <algorithm>
+
+#include "core/common/hash_combine.h"
+#include "core/common/safeint.h"
+#include "core/framework/data_transfer_manager.h"
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+// Copies the first `length` entries along `axis` of `src` to `dst`, which has `length` entries along `axis`.
+Status CopyPrefix(const DataTransferManager& data_transfer_mgr, const Tensor& src, size_t axis, int64_t length,
+                  Tensor& dst) {
+  const auto* byte_type = DataTypeImpl::GetType<uint8_t>();
+  const size_t row_bytes = SafeInt<size_t>(src.Shape().SizeFromDimension(axis + 1)) * src.DataType()->Size();
+  const size_t src_block_bytes = SafeInt<size_t>(src.Shape()[axis]) * row_bytes;
+  const size_t dst_block_bytes = SafeInt<size_t>(length) * row_bytes;
+  const TensorShape block_shape({static_cast<int64_t>(dst_block_bytes)});
+
+  const auto* src_data = static_cast<const char*>(src.DataRaw());
+  auto* dst_data = static_cast<char*>(dst.MutableDataRaw());
+  for (int64_t outer = 0, num_outer = src.Shape().SizeToDimension(axis); outer < num_outer; ++outer) {
+    Tensor src_view(byte_type, block_shape, const_cast<char*>(src_data + outer * src_block_bytes), src.Location());
+    Tensor dst_view(byte_type, block_shape, dst_data + outer * dst_block_bytes, dst.Location());
+    ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(src_view, dst_view));
+  }
+
+  return Status::OK();
+}
+}  // namespace
+
+PrefixKVCache::PrefixKVCache(const PrefixKVCacheOptions& options) : options_(options) {
+  ORT_ENFORCE(options_.block_size > 0, "block_size must be positive.");
+}
+
+std::vector<size_t> PrefixKVCache::BlockHashes(gsl::span<const int64_t> tokens, size_t max_length) const {
+  std::vector<size_t> hashes;
+  size_t hash = 0;
+  for (size_t i = 0; i < std::min(tokens.size(), max_length); ++i) {
+    HashCombine(tokens[i], hash);
+    if ((i + 1) % options_.block_size == 0) {
+      hashes.push_back(hash);
+    }
+  }
+
+  return hashes;
+}
+
+Status PrefixKVCache::Insert(gsl::span<const int64_t> tokens, gsl::span<const OrtValue> present) {
+  size_t bytes = 0;
+  for (const auto& value : present) {
+    ORT_RETURN_IF_NOT(value.IsTensor(), "The state of a prefix must be tensors.");
+    const auto& shape = value.Get<Tensor>().Shape();
+    ORT_RETURN_IF_NOT(shape.NumDimensions() > options_.sequence_axis && shape[0] == 1 &&
+                          shape[options_.sequence_axis] >= static_cast<int64_t>(tokens.size()),
+                      "State with shape ", shape, " doesn't have batch size 1 and ", tokens.size(),
+                      " tokens along axis ", options_.sequence_axis);
+    bytes += value.Get<Tensor>().SizeInBytes();
+  }
+
+  std::vector<size_t> block_hashes = BlockHashes(tokens, tokens.size());
+  if (block_hashes.empty() || bytes > options_.max_bytes) {
+    return Status::OK();  // too short to be reused, or too large to cache
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  // a cached sequence that starts with `tokens` already has their state
+  auto candidates = entries_by_prefix_hash_.find(block_hashes.back());
+  if (candidates != entries_by_prefix_hash_.end()) {
+    for (auto entry : candidates->second) {
+      if (entry->tokens.size() >= tokens.size() &&
+          std::equal(tokens.begin(), tokens.end(), entry->tokens.begin())) {
+        entries_.splice(entries_.begin(), entries_, entry);
+        return Status::OK();
+      }
+    }
+  }
+
+  while (bytes_ + bytes > options_.max_bytes) {
+    Evict(std::prev(entries_.end()));
+  }
+
+  entries_.push_front(Entry{std::vector<int64_t>(tokens.begin(), tokens.end()),
+                            std::vector<OrtValue>(present.begin(), present.end()),
+                            std::move(block_hashes), bytes});
+  for (size_t hash : entries_.front().block_hashes) {
+    entries_by_prefix_hash_[hash].push_back(entries_.begin());
+  }
+  bytes_ += bytes;
+
+  return Status::OK();
+}
+
+void PrefixKVCache::Evict(EntryList::iterator entry) {
+  for (size_t hash : entry->block_hashes) {
+    auto it = entries_by_prefix_hash_.find(hash);
+    auto& candidates = it->second;
+    candidates.erase(std::find(candidates.begin(), candidates.end(), entry));
+    if (candidates.empty()) {
+      entries_by_prefix_hash_.erase(it);
+    }
+  }
+
+  bytes_ -= entry->bytes;
+  entries_.erase(entry);
+}
+
+Status PrefixKVCache::Lookup(const InferenceSession& session, gsl::span<const int64_t> tokens,
+                             std::vector<OrtValue>& past, size_t& prefix_length) {
+  prefix_length = 0;
+  past.clear();
+
+  // at least the last token runs, as its logits are needed
+  const std::vector<size_t> block_hashes = BlockHashes(tokens, tokens.size() - std::min<size_t>(tokens.size(), 1));
+
+  std::vector<OrtValue> state;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+
+    EntryList::iterator match = entries_.end();
+    for (size_t block = 0; block < block_hashes.size(); ++block) {
+      auto candidates = entries_by_prefix_hash_.find(block_hashes[block]);
+      if (candidates == entries_by_prefix_hash_.end()) {
+        break;  // no cached sequence has a longer prefix either
+      }
+
+      const size_t length = (block + 1) * options_.block_size;
+      auto entry = std::find_if(candidates->second.begin(), candidates->second.end(), [&](EntryList::iterator e) {
+        return std::equal(tokens.begin(), tokens.begin() + length, e->tokens.begin());
+      });
+      if (entry == candidates->second.end()) {
+        break;
+      }
+
+      match = *entry;
+      prefix_length = length;
+    }
+
+    if (match == entries_.end()) {
+      return Status::OK();
+    }
+
+    entries_.splice(entries_.begin(), entries_, match);
+    state = match->state;
+  }
+
+  // the cached tensors are copied without holding the lock, they are not written while cached
+  const auto& data_transfer_mgr = session.GetDataTransferManager();
+  past.resize(state.size());
+  for (size_t i = 0; i < state.size(); ++i) {
+    const auto& src = state[i].Get<Tensor>();
+    TensorShape shape = src.Shape();
+    shape[options_.sequence_axis] = static_cast<int64_t>(prefix_length);
+
+    auto allocator = session.GetAllocator(src.Location());
+    ORT_RETURN_IF_NOT(allocator, "No allocator for the location of the cached state ", src.Location().ToString());
+    Tensor::InitOrtValue(src.DataType(), shape, std::move(allocator), past[i]);
+    ORT_RETURN_IF_ERROR(CopyPrefix(data_transfer_mgr, src, options_.sequence_axis,
+                                   static_cast<int64_t>(prefix_length), *past[i].GetMutable<Tensor>()));
+  }
+
+  return Status::OK();
+}
+
+size_t PrefixKVCache::SizeInBytes() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return bytes_;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/framework_common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+struct PrefixKVCacheOptions {
+  // Maximum size of the cached state. The least recently used prefixes are evicted beyond it.
+  size_t max_bytes = size_t{1} << 30;
+
+  // Prefixes are matched in multiples of this number of tokens.
+  size_t block_size = 16;
+
+  // Axis of the sequence in the state tensors, 2 for (batch_size, num_heads, sequence_length, head_size) as the
+  // present_key and present_value outputs of GroupQueryAttention and MultiHeadAttention.
+  size_t sequence_axis = 2;
+};
+
+/**
+ * Caches the past key and value state of decoder models for token prefixes that many requests share, such as system
+ * prompts, so the prompt of a later request only runs the tokens after the longest cached prefix.
+ *
+ * After a Run of a prompt, Insert() stores the present state outputs for the tokens of the prompt. Before a Run of
+ * the next prompt, Lookup() returns the past state of its longest cached prefix, which is fed as the past state
+ * inputs together with the tokens that are not in the prefix.
+ * Prefixes are found by the hash of their tokens at every multiple of block_size tokens, and compared token by token.
+ *
+ * State is for one sequence, i.e. batch size 1. The tensors given to Insert() are kept, not copied, and must not be
+ * written afterwards. They may be longer than the tokens along the sequence axis, e.g. when past and present share
+ * a buffer of the maximum sequence length.
+ *
+ * This class is thread-safe.
+ */
+class PrefixKVCache {
+ public:
+  explicit PrefixKVCache(const PrefixKVCacheOptions& options = {});
+
+  // Stores the state `present` of the sequence `tokens`.
+  Status Insert(gsl::span<const int64_t> tokens, gsl::span<const OrtValue> present);
+
+  // Finds the longest cached prefix of `tokens` that leaves at least one token to run, and copies its state to new
+  // tensors in `past`, allocated with the allocators of `session`.
+  // `prefix_length` is the number of tokens of the prefix, 0 if none is cached and `past` is left empty.
+  Status Lookup(const InferenceSession& session, gsl::span<const int64_t> tokens, std::vector<OrtValue>& past,
+                size_t& prefix_length);
+
+  // Size of the cached state in bytes.
+  size_t SizeInBytes() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrefixKVCache);
+
+ private:
+  struct Entry {
+    std::vector<int64_t> tokens;
+    std::vector<OrtValue> state;
+    // hash of the first k * block_size tokens, for k = 1, 2, ...
+    std::vector<size_t> block_hashes;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Hashes of the prefixes of `tokens` at every multiple of block_size, up to `max_length` tokens.
+  std::vector<size_t> BlockHashes(gsl::span<const int64_t> tokens, size_t max_length) const;
+
+  void Evict(EntryList::iterator entry);
+
+  const PrefixKVCacheOptions options_;
+
+  mutable OrtMutex mutex_;
+  // most recently used first
+  EntryList entries_;
+  // entries by the hash of their prefixes
+  std::unordered_map<size_t, InlinedVector<EntryList::iterator>> entries_by_prefix_hash_;
+  size_t bytes_ = 0;
+};
+
+}  // namespace onnxruntime
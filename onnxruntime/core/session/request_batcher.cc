@@ -0,0 +1,264 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/request_batcher.h"
+
+#include <cstring>
+#include <future>
+
+#include "core/common/safeint.h"
+#include "core/framework/error_code_helper.h"
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+// Copies `num_rows` rows along `axis` starting at `src_row` of `src` to `dst` starting at `dst_row`.
+// The shapes of `src` and `dst` must only differ in `axis`.
+void CopyRows(const Tensor& src, int64_t src_row, Tensor& dst, int64_t dst_row, int64_t num_rows, size_t axis) {
+  const auto& src_shape = src.Shape();
+  const auto& dst_shape = dst.Shape();
+  const size_t row_bytes = SafeInt<size_t>(src_shape.SizeFromDimension(axis + 1)) * src.DataType()->Size();
+  const int64_t outer = src_shape.SizeToDimension(axis);
+
+  const auto* src_data = static_cast<const char*>(src.DataRaw());
+  auto* dst_data = static_cast<char*>(dst.MutableDataRaw());
+  for (int64_t i = 0; i < outer; ++i) {
+    std::memcpy(dst_data + (i * dst_shape[axis] + dst_row) * row_bytes,
+                src_data + (i * src_shape[axis] + src_row) * row_bytes,
+                num_rows * row_bytes);
+  }
+}
+}  // namespace
+
+RequestBatcher::RequestBatcher(InferenceSession& session, const RequestBatcherOptions& options,
+                               std::vector<std::string> feed_names, std::vector<std::string> fetch_names,
+                               const RunOptions& run_options)
+    : session_(session),
+      options_(options),
+      feed_names_(std::move(feed_names)),
+      fetch_names_(std::move(fetch_names)),
+      run_options_(run_options) {
+  ORT_ENFORCE(options_.max_batch_size > 0, "max_batch_size must be positive.");
+  dispatcher_ = std::thread([this]() { DispatchLoop(); });
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  queue_changed_.notify_all();
+  dispatcher_.join();
+}
+
+Status RequestBatcher::Run(gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches) {
+  std::promise<Status> promise;
+  auto future = promise.get_future();
+
+  ORT_RETURN_IF_ERROR(Enqueue(InlinedVector<OrtValue>(feeds.begin(), feeds.end()),
+                              [&promise, &fetches](Status status, std::vector<OrtValue>&& results) {
+                                fetches = std::move(results);
+                                promise.set_value(std::move(status));
+                              }));
+
+  return future.get();
+}
+
+Status RequestBatcher::RunAsync(gsl::span<const OrtValue* const> feeds, gsl::span<OrtValue*> fetches,
+                                RunAsyncCallbackFn callback, void* user_data) {
+  ORT_RETURN_IF_NOT(fetches.size() == fetch_names_.size(), "Expected ", fetch_names_.size(), " fetches, got ",
+                    fetches.size());
+
+  InlinedVector<OrtValue> request_feeds;
+  request_feeds.reserve(feeds.size());
+  for (const auto* feed : feeds) {
+    ORT_RETURN_IF(feed == nullptr, "Feeds can't be null.");
+    request_feeds.push_back(*feed);
+  }
+
+  return Enqueue(std::move(request_feeds),
+                 [fetches, callback, user_data](Status status, std::vector<OrtValue>&& results) {
+                   if (status.IsOK()) {
+                     for (size_t i = 0; i < results.size(); ++i) {
+                       *fetches[i] = std::move(results[i]);
+                     }
+                   }
+                   callback(user_data, fetches.data(), status.IsOK() ? fetches.size() : 0, ToOrtStatus(status));
+                 });
+}
+
+Status RequestBatcher::Enqueue(InlinedVector<OrtValue>&& feeds, CompletionFn&& on_complete) {
+  ORT_RETURN_IF_NOT(feeds.size() == feed_names_.size(), "Expected ", feed_names_.size(), " feeds, got ",
+                    feeds.size());
+
+  int64_t batch_size = -1;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF_NOT(feeds[i].IsTensor(), "Feed ", feed_names_[i], " is not a tensor.");
+    const auto& tensor = feeds[i].Get<Tensor>();
+    ORT_RETURN_IF_NOT(tensor.Location().device.Type() == OrtDevice::CPU, "Feed ", feed_names_[i],
+                      " is not a CPU tensor.");
+    ORT_RETURN_IF(tensor.IsDataTypeString(), "Feed ", feed_names_[i], " is a string tensor.");
+    ORT_RETURN_IF_NOT(tensor.Shape().NumDimensions() > options_.batch_axis, "Feed ", feed_names_[i],
+                      " has no batch axis ", options_.batch_axis);
+
+    const int64_t rows = tensor.Shape()[options_.batch_axis];
+    ORT_RETURN_IF(batch_size != -1 && rows != batch_size, "Feed ", feed_names_[i], " has batch size ", rows,
+                  ", the other feeds have ", batch_size);
+    batch_size = rows;
+  }
+  ORT_RETURN_IF(batch_size <= 0, "Requests must have at least one row.");
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    ORT_RETURN_IF(shutdown_, "The request batcher is being destroyed.");
+    queue_.push_back(Request{std::move(feeds), batch_size, Clock::now(), std::move(on_complete)});
+    queued_rows_ += static_cast<size_t>(batch_size);
+  }
+
+  queue_changed_.notify_one();
+  return Status::OK();
+}
+
+bool RequestBatcher::CanBatch(const Request& a, const Request& b) const {
+  for (size_t i = 0; i < a.feeds.size(); ++i) {
+    const auto& x = a.feeds[i].Get<Tensor>();
+    const auto& y = b.feeds[i].Get<Tensor>();
+    if (x.DataType() != y.DataType() || x.Shape().NumDimensions() != y.Shape().NumDimensions()) {
+      return false;
+    }
+
+    for (size_t dim = 0; dim < x.Shape().NumDimensions(); ++dim) {
+      if (dim != options_.batch_axis && x.Shape()[dim] != y.Shape()[dim]) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void RequestBatcher::DispatchLoop() {
+  std::unique_lock<OrtMutex> lock(mutex_);
+  while (true) {
+    while (queue_.empty() && !shutdown_) {
+      queue_changed_.wait(lock);
+    }
+
+    if (queue_.empty()) {
+      break;  // shut down and nothing left to run
+    }
+
+    // wait for more requests until the batch is full or the oldest request has waited long enough
+    const auto deadline = queue_.front().enqueue_time + options_.max_queue_delay;
+    while (queued_rows_ < options_.max_batch_size && !shutdown_) {
+      const auto now = Clock::now();
+      if (now >= deadline) {
+        break;
+      }
+      queue_changed_.wait_for(lock, deadline - now);
+    }
+
+    std::vector<Request> batch;
+    size_t rows = 0;
+    while (!queue_.empty()) {
+      auto& next = queue_.front();
+      if (!batch.empty() &&
+          (rows + static_cast<size_t>(next.batch_size) > options_.max_batch_size || !CanBatch(batch.front(), next))) {
+        break;
+      }
+
+      rows += static_cast<size_t>(next.batch_size);
+      batch.push_back(std::move(next));
+      queue_.pop_front();
+    }
+    queued_rows_ -= rows;
+
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+  }
+}
+
+void RequestBatcher::RunBatch(std::vector<Request>& batch) {
+  std::vector<std::vector<OrtValue>> fetches_per_request(batch.size());
+
+  Status status;
+  ORT_TRY {
+    status = RunBatch(batch, fetches_per_request);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+  ORT_CATCH(...) {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+  }
+
+  for (size_t i = 0; i < batch.size(); ++i) {
+    batch[i].on_complete(status, status.IsOK() ? std::move(fetches_per_request[i]) : std::vector<OrtValue>{});
+  }
+}
+
+Status RequestBatcher::RunBatch(std::vector<Request>& batch,
+                                std::vector<std::vector<OrtValue>>& fetches_per_request) {
+  const size_t axis = options_.batch_axis;
+
+  if (batch.size() == 1) {
+    return session_.Run(run_options_, feed_names_, batch[0].feeds, fetch_names_, &fetches_per_request[0], nullptr);
+  }
+
+  AllocatorPtr allocator = session_.GetAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator));
+  ORT_RETURN_IF_NOT(allocator, "Failed to get the CPU allocator of the session.");
+
+  int64_t total_rows = 0;
+  for (const auto& request : batch) {
+    total_rows += request.batch_size;
+  }
+
+  InlinedVector<OrtValue> feeds(feed_names_.size());
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const auto& first = batch[0].feeds[i].Get<Tensor>();
+    TensorShape shape = first.Shape();
+    shape[axis] = total_rows;
+    Tensor::InitOrtValue(first.DataType(), shape, allocator, feeds[i]);
+
+    auto& batched = *feeds[i].GetMutable<Tensor>();
+    int64_t row = 0;
+    for (const auto& request : batch) {
+      CopyRows(request.feeds[i].Get<Tensor>(), 0, batched, row, request.batch_size, axis);
+      row += request.batch_size;
+    }
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(session_.Run(run_options_, feed_names_, feeds, fetch_names_, &fetches, nullptr));
+
+  for (auto& request_fetches : fetches_per_request) {
+    request_fetches.resize(fetches.size());
+  }
+
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    ORT_RETURN_IF_NOT(fetches[i].IsTensor(), "Fetch ", fetch_names_[i], " is not a tensor.");
+    const auto& output = fetches[i].Get<Tensor>();
+    ORT_RETURN_IF_NOT(output.Location().device.Type() == OrtDevice::CPU && !output.IsDataTypeString() &&
+                          output.Shape().NumDimensions() > axis && output.Shape()[axis] == total_rows,
+                      "Fetch ", fetch_names_[i], " with shape ", output.Shape(),
+                      " can't be split along batch axis ", axis, " into ", batch.size(), " requests.");
+
+    int64_t row = 0;
+    for (size_t r = 0; r < batch.size(); ++r) {
+      TensorShape shape = output.Shape();
+      shape[axis] = batch[r].batch_size;
+      Tensor::InitOrtValue(output.DataType(), shape, allocator, fetches_per_request[r][i]);
+      CopyRows(output, row, *fetches_per_request[r][i].GetMutable<Tensor>(), 0, batch[r].batch_size, axis);
+      row += batch[r].batch_size;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
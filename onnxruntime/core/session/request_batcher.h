@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+struct RequestBatcherOptions {
+  // Maximum number of rows along the batch axis of one batched Run. A request with more rows runs on its own.
+  size_t max_batch_size = 8;
+
+  // Maximum time the oldest queued request waits for more requests before its batch is run.
+  std::chrono::microseconds max_queue_delay{1000};
+
+  // Axis of the inputs and outputs that requests are concatenated along.
+  size_t batch_axis = 0;
+};
+
+/**
+ * Coalesces concurrent requests to an InferenceSession into batched Runs.
+ *
+ * Every request feeds the same inputs and fetches the same outputs, given at construction. The feeds of the queued
+ * requests are concatenated along the batch axis, the batch is run with InferenceSession::Run on a dispatcher
+ * thread, and the fetches are split along the batch axis and returned to each request.
+ * Only requests whose feeds match in element type and in every dimension other than the batch axis are batched
+ * together. Padding shorter requests is left to the caller, as only the model knows which values are neutral.
+ *
+ * Feeds must be CPU tensors of a non-string type, and the model must produce outputs with the same batch axis.
+ *
+ * This class is thread-safe.
+ */
+class RequestBatcher {
+ public:
+  RequestBatcher(InferenceSession& session, const RequestBatcherOptions& options,
+                 std::vector<std::string> feed_names, std::vector<std::string> fetch_names,
+                 const RunOptions& run_options = {});
+
+  // Runs the queued requests and stops the dispatcher thread.
+  ~RequestBatcher();
+
+  // Queues a request and waits for its fetches.
+  Status Run(gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches);
+
+  // Queues a request and returns. `callback` is invoked like the callback of InferenceSession::RunAsync, on the
+  // dispatcher thread, after the fetches of the request are written to `fetches`.
+  // `feeds` are copied by the call, `fetches` must stay valid until the callback is invoked.
+  Status RunAsync(gsl::span<const OrtValue* const> feeds, gsl::span<OrtValue*> fetches,
+                  RunAsyncCallbackFn callback, void* user_data = nullptr);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RequestBatcher);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  using CompletionFn = std::function<void(Status, std::vector<OrtValue>&&)>;
+
+  struct Request {
+    InlinedVector<OrtValue> feeds;
+    int64_t batch_size;
+    Clock::time_point enqueue_time;
+    CompletionFn on_complete;
+  };
+
+  Status Enqueue(InlinedVector<OrtValue>&& feeds, CompletionFn&& on_complete);
+
+  // Whether the feeds of `a` and `b` can be concatenated.
+  bool CanBatch(const Request& a, const Request& b) const;
+
+  void DispatchLoop();
+  void RunBatch(std::vector<Request>& batch);
+  Status RunBatch(std::vector<Request>& batch, std::vector<std::vector<OrtValue>>& fetches_per_request);
+
+  InferenceSession& session_;
+  const RequestBatcherOptions options_;
+  const std::vector<std::string> feed_names_;
+  const std::vector<std::string> fetch_names_;
+  const RunOptions run_options_;
+
+  OrtMutex mutex_;
+  OrtCondVar queue_changed_;
+  std::deque<Request> queue_;
+  size_t queued_rows_ = 0;
+  bool shutdown_ = false;
+
+  std::thread dispatcher_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_context.h"
+
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+
+RunContext::RunContext(const SessionState& session_state, gsl::span<const std::string> feed_names,
+                       gsl::span<const std::string> fetch_names)
+    : session_state_(session_state),
+      feeds_fetches_manager_(FeedsFetchesInfo(feed_names, fetch_names, session_state.GetOrtValueNameIdxMap())),
+      feeds_(feed_names.size()),
+      fetches_(fetch_names.size()),
+      output_bound_(fetch_names.size(), false) {
+}
+
+common::Status RunContext::BindInput(size_t index, const OrtValue& ort_value) {
+  ORT_RETURN_IF_NOT(index < feeds_.size(), "Invalid input index ", index, ", the run context has ", feeds_.size(),
+                    " inputs.");
+  ORT_RETURN_IF_NOT(ort_value.IsAllocated(), "Input ",
+                    feeds_fetches_manager_.GetFeedsFetchesInfo().feed_names[index], " is not allocated.");
+  feeds_[index] = ort_value;
+  return Status::OK();
+}
+
+common::Status RunContext::BindOutput(size_t index, const OrtValue& ort_value) {
+  ORT_RETURN_IF_NOT(index < fetches_.size(), "Invalid output index ", index, ", the run context has ",
+                    fetches_.size(), " outputs.");
+  ORT_RETURN_IF_NOT(ort_value.IsAllocated(), "Output ",
+                    feeds_fetches_manager_.GetFeedsFetchesInfo().output_names[index],
+                    " must be bound to a pre-allocated value.");
+  fetches_[index] = ort_value;
+  output_bound_[index] = true;
+  return Status::OK();
+}
+
+const OrtValue& RunContext::GetOutput(size_t index) const {
+  ORT_ENFORCE(index < fetches_.size(), "Invalid output index ", index, ", the run context has ", fetches_.size(),
+              " outputs.");
+  return fetches_[index];
+}
+
+common::Status RunContext::PrepareRun() {
+  for (size_t i = 0; i < feeds_.size(); ++i) {
+    ORT_RETURN_IF_NOT(feeds_[i].IsAllocated(), "Input ", feeds_fetches_manager_.GetFeedsFetchesInfo().feed_names[i],
+                      " of the run context is not bound.");
+  }
+
+  for (size_t i = 0; i < fetches_.size(); ++i) {
+    if (!output_bound_[i]) {
+      fetches_[i] = OrtValue();
+    }
+  }
+
+  // the device copies were checked for the values of the last run
+  feeds_fetches_manager_.ResetDeviceCopyChecks();
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/status.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+class InferenceSession;
+class SessionState;
+
+/**
+ * Feeds and fetches of repeated runs of an InferenceSession with the same inputs and outputs.
+ *
+ * The names are resolved to their OrtValue indices once, when the context is created, and the feeds and fetches
+ * vectors are kept from one run to the next, so a run with a context only validates the bound values and executes
+ * the graph. This matters for small models, where building the name lookups of every Run() is a measurable part
+ * of the latency.
+ *
+ * Usage is as follows:
+ *
+ * std::unique_ptr<RunContext> run_context;
+ * session.NewRunContext(feed_names, fetch_names, &run_context);
+ * run_context->BindOutput(0, preallocated_output);  // optional
+ * for (...) {
+ *   run_context->BindInput(0, input);
+ *   session.Run(run_options, *run_context);
+ *   const OrtValue& output = run_context->GetOutput(0);
+ * }
+ *
+ * Inputs and outputs are bound by their index in the names the context was created with. An output bound to a
+ * pre-allocated OrtValue is written in place by every run. The other outputs are allocated by each run and are
+ * replaced by the next one.
+ *
+ * A RunContext can be used by one run at a time. Use a context per thread to run concurrently.
+ */
+class RunContext {
+ public:
+  RunContext(const SessionState& session_state, gsl::span<const std::string> feed_names,
+             gsl::span<const std::string> fetch_names);
+
+  size_t GetInputCount() const { return feeds_.size(); }
+  size_t GetOutputCount() const { return fetches_.size(); }
+
+  /**
+   * Bind the value for the input at `index`. It replaces the value bound by a previous call and is used by every
+   * run until then.
+   */
+  common::Status BindInput(size_t index, const OrtValue& ort_value);
+
+  /**
+   * Bind the output at `index` to a pre-allocated OrtValue that every run writes to.
+   */
+  common::Status BindOutput(size_t index, const OrtValue& ort_value);
+
+  /**
+   * The output at `index` of the last run. It is valid until the next run with this context.
+   */
+  const OrtValue& GetOutput(size_t index) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunContext);
+
+ private:
+  friend InferenceSession;
+
+  // Checks that all the inputs are bound, and releases the outputs of the last run that weren't pre-allocated.
+  common::Status PrepareRun();
+
+  const SessionState& session_state_;
+  FeedsFetchesManager feeds_fetches_manager_;
+  std::vector<OrtValue> feeds_;
+  std::vector<OrtValue> fetches_;
+  InlinedVector<bool> output_bound_;
+};
+}  // namespace onnxruntime
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/session_pipeline.h"
+
+#include <algorithm>
+
+#include "core/framework/utils.h"
+#include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+bool Contains(const std::vector<std::string>& names, const std::string& name) {
+  return std::find(names.begin(), names.end(), name) != names.end();
+}
+}  // namespace
+
+SessionPipeline::~SessionPipeline() = default;
+
+common::Status SessionPipeline::Create(std::vector<InferenceSession*> stages,
+                                       std::unique_ptr<SessionPipeline>& pipeline) {
+  ORT_RETURN_IF(stages.empty(), "A session pipeline needs at least one session.");
+
+  auto new_pipeline = std::unique_ptr<SessionPipeline>(new SessionPipeline());
+  for (size_t i = 0; i < stages.size(); ++i) {
+    ORT_RETURN_IF(stages[i] == nullptr, "Session ", i, " of the pipeline is null.");
+
+    Stage stage;
+    stage.session = stages[i];
+    ORT_RETURN_IF_ERROR(stage.session->NewIOBinding(&stage.io_binding));
+
+    const auto [inputs_status, inputs] = stage.session->GetModelInputs();
+    ORT_RETURN_IF_ERROR(inputs_status);
+    for (const NodeArg* input : *inputs) {
+      stage.input_names.push_back(input->Name());
+    }
+
+    const auto [outputs_status, outputs] = stage.session->GetModelOutputs();
+    ORT_RETURN_IF_ERROR(outputs_status);
+    for (const NodeArg* output : *outputs) {
+      stage.output_names.push_back(output->Name());
+    }
+
+    new_pipeline->stages_.push_back(std::move(stage));
+  }
+
+  pipeline = std::move(new_pipeline);
+  return Status::OK();
+}
+
+common::Status SessionPipeline::Link(size_t from_stage, const std::string& output_name, size_t to_stage,
+                                     const std::string& input_name) {
+  ORT_RETURN_IF_NOT(from_stage < to_stage && to_stage < stages_.size(), "Invalid link from stage ", from_stage,
+                    " to stage ", to_stage, ", an output must be linked to a later stage of the ", stages_.size(),
+                    " stages.");
+
+  auto& from = stages_[from_stage];
+  auto& to = stages_[to_stage];
+  ORT_RETURN_IF_NOT(Contains(from.output_names, output_name), output_name, " is not an output of stage ",
+                    from_stage, ".");
+  ORT_RETURN_IF_NOT(Contains(to.input_names, input_name), input_name, " is not an input of stage ", to_stage,
+                    ".");
+  ORT_RETURN_IF(std::any_of(to.links.begin(), to.links.end(),
+                            [&input_name](const StageLink& link) { return link.input_name == input_name; }),
+                "Input ", input_name, " of stage ", to_stage, " is already linked.");
+
+  to.links.push_back({from_stage, output_name, input_name});
+
+  // allocate the output where the consumer reads it, so it is fed without a copy
+  from.linked_outputs.emplace(output_name, utils::FindDeviceForValue(to.session->GetSessionState(), input_name));
+  return Status::OK();
+}
+
+common::Status SessionPipeline::Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                    gsl::span<const OrtValue> feeds, gsl::span<const std::string> fetch_names,
+                                    std::vector<OrtValue>& fetches) {
+  for (const auto& feed_name : feed_names) {
+    ORT_RETURN_IF_NOT(std::any_of(stages_.begin(), stages_.end(),
+                                  [&feed_name](const Stage& stage) { return Contains(stage.input_names, feed_name); }),
+                      feed_name, " is not an input of any stage of the pipeline.");
+  }
+
+  // the stage each fetch is taken from
+  std::vector<size_t> fetch_stages;
+  fetch_stages.reserve(fetch_names.size());
+  for (const auto& fetch_name : fetch_names) {
+    auto stage = std::find_if(stages_.rbegin(), stages_.rend(),
+                              [&fetch_name](const Stage& s) { return Contains(s.output_names, fetch_name); });
+    ORT_RETURN_IF(stage == stages_.rend(), fetch_name, " is not an output of any stage of the pipeline.");
+    fetch_stages.push_back(static_cast<size_t>(std::distance(stage, stages_.rend())) - 1);
+  }
+
+  // the consuming stage must see the complete outputs of the stage before it
+  RunOptions stage_run_options = run_options;
+  stage_run_options.config_options.configurations.erase(kOrtRunOptionsConfigDisableSynchronizeExecutionProviders);
+
+  // the outputs of every stage, kept until the last stage has run
+  std::vector<std::unordered_map<std::string, OrtValue>> stage_outputs(stages_.size());
+  for (size_t s = 0; s < stages_.size(); ++s) {
+    auto& stage = stages_[s];
+    auto& io_binding = *stage.io_binding;
+    io_binding.ClearInputs();
+    io_binding.ClearOutputs();
+
+    for (const auto& link : stage.links) {
+      ORT_RETURN_IF_ERROR(io_binding.BindInput(link.input_name, stage_outputs[link.from_stage].at(link.output_name)));
+    }
+
+    for (size_t i = 0; i < feeds.size(); ++i) {
+      const bool linked = std::any_of(stage.links.begin(), stage.links.end(),
+                                      [&](const StageLink& link) { return link.input_name == feed_names[i]; });
+      if (!linked && Contains(stage.input_names, feed_names[i])) {
+        ORT_RETURN_IF_ERROR(io_binding.BindInput(feed_names[i], feeds[i]));
+      }
+    }
+
+    for (const auto& [output_name, device] : stage.linked_outputs) {
+      ORT_RETURN_IF_ERROR(io_binding.BindOutput(output_name, device));
+    }
+    for (size_t i = 0; i < fetch_names.size(); ++i) {
+      if (fetch_stages[i] == s && stage.linked_outputs.find(fetch_names[i]) == stage.linked_outputs.end()) {
+        ORT_RETURN_IF_ERROR(io_binding.BindOutput(fetch_names[i]));
+      }
+    }
+
+    const bool is_last_stage = s + 1 == stages_.size();
+    ORT_RETURN_IF_ERROR(stage.session->Run(is_last_stage ? run_options : stage_run_options, io_binding));
+
+    const auto& output_names = io_binding.GetOutputNames();
+    const auto& outputs = io_binding.GetOutputs();
+    for (size_t i = 0; i < output_names.size(); ++i) {
+      stage_outputs[s][output_names[i]] = outputs[i];
+    }
+
+    // don't keep the values of this run alive in the binding
+    io_binding.ClearInputs();
+    io_binding.ClearOutputs();
+  }
+
+  fetches.clear();
+  fetches.reserve(fetch_names.size());
+  for (size_t i = 0; i < fetch_names.size(); ++i) {
+    fetches.push_back(stage_outputs[fetch_stages[i]].at(fetch_names[i]));
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
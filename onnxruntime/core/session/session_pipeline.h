@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/ortdevice.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+class InferenceSession;
+class IOBinding;
+
+/**
+ * Runs several initialized InferenceSessions one after the other, with outputs of a stage linked to inputs of a
+ * later stage, e.g. a preprocessing model, an encoder and a postprocessing model.
+ *
+ * A linked output is allocated by its stage on the device where the consuming stage reads the input, and is fed to
+ * it as is, so the values that stay on a device are neither copied to the host nor copied back.
+ *
+ * Usage is as follows:
+ *
+ * std::unique_ptr<SessionPipeline> pipeline;
+ * SessionPipeline::Create({&preprocess, &encoder, &postprocess}, pipeline);
+ * pipeline->Link(0, "pixel_values", 1, "pixel_values");
+ * pipeline->Link(1, "last_hidden_state", 2, "hidden_states");
+ * pipeline->Run(run_options, {"image"}, {image}, {"labels"}, fetches);
+ *
+ * The feeds of a run are fed to every stage that has an input of the same name that isn't linked. A fetch is taken
+ * from the last stage with an output of its name. It is allocated on the CPU, unless the output is also linked.
+ *
+ * Every stage but the last synchronizes its execution providers at the end of its run, so the consuming stage,
+ * e.g. on another stream, reads complete values. The last stage follows the run options.
+ *
+ * A SessionPipeline can be used by one run at a time. The sessions must outlive it.
+ */
+class SessionPipeline {
+ public:
+  static common::Status Create(std::vector<InferenceSession*> stages, std::unique_ptr<SessionPipeline>& pipeline);
+
+  /**
+   * Feed the output `output_name` of stage `from_stage` to the input `input_name` of the later stage `to_stage`.
+   */
+  common::Status Link(size_t from_stage, const std::string& output_name, size_t to_stage,
+                      const std::string& input_name);
+
+  common::Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                     gsl::span<const OrtValue> feeds, gsl::span<const std::string> fetch_names,
+                     std::vector<OrtValue>& fetches);
+
+  ~SessionPipeline();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionPipeline);
+
+ private:
+  struct StageLink {
+    size_t from_stage;
+    std::string output_name;
+    std::string input_name;
+  };
+
+  struct Stage {
+    InferenceSession* session;
+    std::unique_ptr<IOBinding> io_binding;
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+    // the inputs fed by the outputs of earlier stages
+    std::vector<StageLink> links;
+    // the outputs fed to later stages, with the device where the first consumer reads them
+    std::unordered_map<std::string, OrtDevice> linked_outputs;
+  };
+
+  SessionPipeline() = default;
+
+  std::vector<Stage> stages_;
+};
+}  // namespace onnxruntime
@@ -6,6 +6,8 @@
 #include "core/framework/error_code_helper.h"
 #include "core/framework/TensorSeq.h"
 #include "core/session/ort_apis.h"
+#include <algorithm>
+#include <sstream>
 #include <unordered_map>
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -104,16 +106,33 @@ class NodeRepo {
     return kernel_create_info.kernel_create_func(func_mgr_, kernel_info, op_kernel);
   }
 
-  onnxruntime::Status AddNode(const onnxruntime::OpKernel* kernel, NodePtr&& node_ptr, ArgPtrs&& args) {
+  // add the node of a kernel, and share the kernel with the later ops created with the same key
+  onnxruntime::Status AddNode(const onnxruntime::OpKernel* kernel, NodePtr&& node_ptr, ArgPtrs&& args,
+                              const std::string& kernel_key) {
     std::lock_guard<std::mutex> guard(mutex_);
     auto ret = resource_map_.try_emplace(kernel, NodeResource{std::move(node_ptr), std::move(args)});
     if (!ret.second) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "kernel already mapped to existing node");
     }
 
+    // another thread may have created the same kernel in the meantime, this one is then not shared
+    if (kernel_cache_.try_emplace(kernel_key, SharedKernel{kernel, 1}).second) {
+      kernel_keys_[kernel] = kernel_key;
+    }
     return Status::OK();
   }
 
+  // the kernel created with the same key, with one more reference, or nullptr
+  const onnxruntime::OpKernel* FindKernel(const std::string& kernel_key) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto iter = kernel_cache_.find(kernel_key);
+    if (iter == kernel_cache_.end()) {
+      return nullptr;
+    }
+    ++iter->second.ref_count;
+    return iter->second.kernel;
+  }
+
 #if !defined(ORT_MINIMAL_BUILD)
   common::Status RegisterCustomOpNodeSchemas(KernelTypeStrResolver& kernel_type_str_resolver, Graph& graph) {
     std::lock_guard<std::mutex> guard(mutex_);
@@ -163,20 +182,80 @@ class NodeRepo {
     return Status::OK();
   }
 
-  void RemoveNode(const onnxruntime::OpKernel* kernel) {
-    std::lock_guard<std::mutex> guard(mutex_);
-    resource_map_.erase(kernel);
+  // drop a reference to the kernel, and delete it with its node once no op refers to it
+  void ReleaseKernel(const onnxruntime::OpKernel* kernel) {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      auto key_iter = kernel_keys_.find(kernel);
+      if (key_iter != kernel_keys_.end()) {
+        auto cache_iter = kernel_cache_.find(key_iter->second);
+        if (--cache_iter->second.ref_count > 0) {
+          return;
+        }
+        kernel_cache_.erase(cache_iter);
+        kernel_keys_.erase(key_iter);
+      }
+      resource_map_.erase(kernel);
+    }
+    delete kernel;
   }
 
  private:
+  struct SharedKernel {
+    const onnxruntime::OpKernel* kernel;
+    size_t ref_count;
+  };
+
   explicit NodeRepo() = default;
   ~NodeRepo() = default;
 
   std::mutex mutex_;
   NodeResourceMap resource_map_;
+  // the kernels that are shared by the ops created with the same execution provider, op, attributes and types
+  InlinedHashMap<std::string, SharedKernel> kernel_cache_;
+  InlinedHashMap<const onnxruntime::OpKernel*, std::string> kernel_keys_;
   FuncManager func_mgr_;
 };
 
+// The key of the kernel of an op, from everything that goes into its creation. A kernel has the execution provider
+// of the kernel info it is created from, which belongs to a single session.
+std::string GetKernelKey(const IExecutionProvider& ep,
+                         const char* op_name,
+                         const char* domain,
+                         int version,
+                         const char** type_constraint_names,
+                         const ONNXTensorElementDataType* type_constraint_values,
+                         int type_constraint_count,
+                         const OrtOpAttr* const* attr_values,
+                         int attr_count,
+                         int input_count,
+                         int output_count) {
+  std::vector<std::string> type_constraints;
+  for (int i = 0; i < type_constraint_count; ++i) {
+    type_constraints.push_back(std::string{type_constraint_names[i]} + "=" +
+                               std::to_string(static_cast<int>(type_constraint_values[i])));
+  }
+  std::sort(type_constraints.begin(), type_constraints.end());
+
+  std::vector<std::string> attrs;
+  for (int i = 0; i < attr_count; ++i) {
+    attrs.push_back(reinterpret_cast<const ONNX_NAMESPACE::AttributeProto*>(attr_values[i])->SerializeAsString());
+  }
+  std::sort(attrs.begin(), attrs.end());
+
+  std::ostringstream key;
+  key << static_cast<const void*>(&ep) << '|' << domain << '|' << op_name << '|' << version << '|' << input_count
+      << '|' << output_count;
+  for (const auto& type_constraint : type_constraints) {
+    key << '|' << type_constraint;
+  }
+  for (const auto& attr : attrs) {
+    // serialized attributes are binary, so they are prefixed with their size
+    key << '|' << attr.size() << ':' << attr;
+  }
+  return key.str();
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 common::Status RegisterCustomOpNodeSchemas(KernelTypeStrResolver& kernel_type_str_resolver, Graph& graph) {
   return NodeRepo::GetInstance().RegisterCustomOpNodeSchemas(kernel_type_str_resolver, graph);
@@ -376,6 +455,17 @@ onnxruntime::Status CreateOp(_In_ const OrtKernelInfo* info,
   *op = nullptr;
   auto kernel_info = reinterpret_cast<const OpKernelInfo*>(info);
   auto ep = reinterpret_cast<const IExecutionProvider*>(kernel_info->GetExecutionProvider());
+
+  // reuse the kernel of an identical op, e.g. of another node of the same custom op, instead of constructing it again
+  auto& node_repo = NodeRepo::GetInstance();
+  const std::string kernel_key = GetKernelKey(*ep, op_name, domain, version, type_constraint_names,
+                                              type_constraint_values, type_constraint_count, attr_values, attr_count,
+                                              input_count, output_count);
+  if (const OpKernel* cached_kernel = node_repo.FindKernel(kernel_key)) {
+    *op = reinterpret_cast<OrtOp*>(const_cast<OpKernel*>(cached_kernel));
+    return Status::OK();
+  }
+
   auto kernel_registry = ep->GetKernelRegistry();
   const KernelCreateInfo* kernel_create_info{};
   InlinedHashMap<std::string, MLDataType> type_constraint_map;
@@ -427,9 +517,8 @@ onnxruntime::Status CreateOp(_In_ const OrtKernelInfo* info,
 
   std::unique_ptr<onnxruntime::OpKernel> op_kernel;
 
-  auto& node_repo = NodeRepo::GetInstance();
   ORT_RETURN_IF_ERROR(node_repo.CreateKernel(*kernel_create_info, tmp_kernel_info, op_kernel));
-  ORT_RETURN_IF_ERROR(node_repo.AddNode(op_kernel.get(), std::move(node_ptr), std::move(arg_ptrs)));
+  ORT_RETURN_IF_ERROR(node_repo.AddNode(op_kernel.get(), std::move(node_ptr), std::move(arg_ptrs), kernel_key));
 
   *op = reinterpret_cast<OrtOp*>(op_kernel.release());
   return status;
@@ -536,8 +625,7 @@ ORT_API_STATUS_IMPL(OrtApis::InvokeOp,
 ORT_API(void, OrtApis::ReleaseOp, _Frees_ptr_opt_ OrtOp* op) {
   if (op) {
     auto kernel = reinterpret_cast<onnxruntime::OpKernel*>(op);
-    onnxruntime::standalone::NodeRepo::GetInstance().RemoveNode(kernel);
-    delete kernel;
+    onnxruntime::standalone::NodeRepo::GetInstance().ReleaseKernel(kernel);
   }
 }
 
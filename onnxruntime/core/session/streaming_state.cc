@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/streaming_state.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/common/inlined_containers.h"
+#include "core/graph/node_arg.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+template <typename DefList>
+bool ContainsName(const DefList* defs, const std::string& name) {
+  return defs != nullptr && std::any_of(defs->begin(), defs->end(),
+                                        [&name](const NodeArg* def) { return def->Name() == name; });
+}
+}  // namespace
+
+Status StreamingState::Create(const InferenceSession& session, const std::string& config,
+                              std::unique_ptr<StreamingState>& state) {
+  const auto inputs = session.GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs.first);
+  const auto overridable_initializers = session.GetOverridableInitializers();
+  ORT_RETURN_IF_ERROR(overridable_initializers.first);
+  const auto outputs = session.GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs.first);
+
+  std::vector<StatePair> pairs;
+  std::istringstream config_stream(config);
+  std::string pair_str;
+  while (std::getline(config_stream, pair_str, ';')) {
+    const auto colon = pair_str.find(':');
+    ORT_RETURN_IF(colon == std::string::npos || colon == 0 || colon + 1 == pair_str.size(),
+                  "Expected streaming state pairs of the form <output>:<input>, got ", pair_str);
+
+    StatePair pair;
+    pair.output_name = pair_str.substr(0, colon);
+    pair.input_name = pair_str.substr(colon + 1);
+    ORT_RETURN_IF_NOT(ContainsName(outputs.second, pair.output_name),
+                      "Streaming state output ", pair.output_name, " is not an output of the model.");
+    pair.input_has_default = ContainsName(overridable_initializers.second, pair.input_name);
+    ORT_RETURN_IF_NOT(pair.input_has_default || ContainsName(inputs.second, pair.input_name),
+                      "Streaming state input ", pair.input_name, " is not an input of the model.");
+    ORT_RETURN_IF(std::any_of(pairs.begin(), pairs.end(),
+                              [&pair](const StatePair& p) { return p.input_name == pair.input_name; }),
+                  "Streaming state input ", pair.input_name, " is fed by more than one output.");
+    pairs.push_back(std::move(pair));
+  }
+  ORT_RETURN_IF(pairs.empty(), "No streaming state pairs in: ", config);
+
+  state.reset(new StreamingState(std::move(pairs)));
+  return Status::OK();
+}
+
+Status StreamingState::Run(InferenceSession& session, const RunOptions& run_options,
+                           gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                           gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                           const std::vector<OrtDevice>* p_fetches_device_info) {
+  ORT_RETURN_IF(p_fetches == nullptr, "Output vector pointer is NULL");
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  if (run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigResetStreamingState, "0") == "1") {
+    for (auto& pair : pairs_) {
+      pair.value = OrtValue();
+    }
+  }
+
+  std::vector<std::string> run_feed_names(feed_names.begin(), feed_names.end());
+  std::vector<OrtValue> run_feeds(feeds.begin(), feeds.end());
+  for (const auto& pair : pairs_) {
+    if (std::find(feed_names.begin(), feed_names.end(), pair.input_name) != feed_names.end()) {
+      // the caller sets the state
+      continue;
+    }
+    if (pair.value.IsAllocated()) {
+      run_feed_names.push_back(pair.input_name);
+      run_feeds.push_back(pair.value);
+    } else {
+      ORT_RETURN_IF_NOT(pair.input_has_default, "Streaming state input ", pair.input_name,
+                        " has no state from a previous run and needs to be fed.");
+    }
+  }
+
+  // fetch the state outputs the caller didn't request after the requested ones
+  std::vector<std::string> run_output_names(output_names.begin(), output_names.end());
+  InlinedVector<size_t> state_fetch_indices;
+  state_fetch_indices.reserve(pairs_.size());
+  for (const auto& pair : pairs_) {
+    const auto it = std::find(run_output_names.begin(), run_output_names.end(), pair.output_name);
+    state_fetch_indices.push_back(static_cast<size_t>(it - run_output_names.begin()));
+    if (it == run_output_names.end()) {
+      run_output_names.push_back(pair.output_name);
+    }
+  }
+
+  std::vector<OrtValue> run_fetches;
+  if (!p_fetches->empty()) {
+    // pre-allocated fetches, ORT allocates the extra ones
+    run_fetches = *p_fetches;
+    run_fetches.resize(run_output_names.size());
+  }
+
+  std::vector<OrtDevice> run_fetches_device_info;
+  if (p_fetches_device_info != nullptr) {
+    run_fetches_device_info = *p_fetches_device_info;
+    run_fetches_device_info.resize(run_output_names.size());
+  }
+
+  ORT_RETURN_IF_ERROR(session.RunImpl(run_options, run_feed_names, run_feeds, run_output_names, &run_fetches,
+                                      p_fetches_device_info != nullptr ? &run_fetches_device_info : nullptr));
+
+  for (size_t i = 0; i < pairs_.size(); ++i) {
+    pairs_[i].value = run_fetches[state_fetch_indices[i]];
+  }
+
+  run_fetches.resize(output_names.size());
+  *p_fetches = std::move(run_fetches);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+/**
+ * Keeps state tensors of a streaming model inside the session across runs.
+ *
+ * Streaming models (e.g. audio models built on Scan or Loop) take their recurrent state as graph inputs and return
+ * the updated state as graph outputs. Each configured pair names a state output and the input it is fed back into.
+ * After a successful run the OrtValue of the output is kept, and the next run feeds it to the input unless the caller
+ * feeds that input. The value is handed over as is, so the state is neither copied nor passes through the caller.
+ * State outputs are fetched even if the caller doesn't request them.
+ *
+ * Before the first run, and after a run with kOrtRunOptionsConfigResetStreamingState set, the caller has to feed the
+ * state inputs unless they have an initializer to fall back to.
+ * Runs of a session with streaming state are serialized as every run consumes the state of the previous one.
+ *
+ * The pairs are configured with kOrtSessionOptionsConfigStreamingState.
+ */
+class StreamingState {
+ public:
+  // Parses a configuration of the form "<output>:<input>;<output>:<input>;..." and checks the names
+  // against the inputs and outputs of the model loaded in `session`.
+  static Status Create(const InferenceSession& session, const std::string& config,
+                       std::unique_ptr<StreamingState>& state);
+
+  Status Run(InferenceSession& session, const RunOptions& run_options,
+             gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+             const std::vector<OrtDevice>* p_fetches_device_info);
+
+ private:
+  struct StatePair {
+    std::string output_name;
+    std::string input_name;
+    // the input is an overridable initializer, so it doesn't have to be fed
+    bool input_has_default;
+    // the output of the last run, empty until the first run or after a reset
+    OrtValue value;
+  };
+
+  explicit StreamingState(std::vector<StatePair> pairs) : pairs_(std::move(pairs)) {}
+
+  std::vector<StatePair> pairs_;
+
+  OrtMutex mutex_;
+};
+
+}  // namespace onnxruntime
@@ -699,6 +699,7 @@ void Im2col<T, StorageOrder::NHWC>::operator()(
 
 template struct Im2col<int8_t, StorageOrder::NHWC>;
 template struct Im2col<uint8_t, StorageOrder::NHWC>;
+template struct Im2col<float, StorageOrder::NHWC>;
 template struct Im2col<MLFloat16, StorageOrder::NHWC>;
 
 template <>
@@ -763,28 +764,29 @@ void Col2im<float, CPUMathUtil, StorageOrder::NCHW>(const float* data_col, int64
   auto* dst_end = data_im + hwc;
   // Begin of src channel data
   for (auto* dst = data_im; dst < dst_end; dst += hw) {
-    // Current kernel element starting vertical offset in dst data
-    int64_t h_offset = -pad_t * width;
-    int64_t h_offset_end = h_offset + kernel_h * dilation_h * width;
-    for (; h_offset < h_offset_end; h_offset += dilation_h * width) {
-      // Current kernel element starting horizontal offset in dst data
-      int64_t w_offset = -pad_l;
-      int64_t w_offset_end = w_offset + kernel_w * dilation_w;
-      for (; w_offset < w_offset_end; w_offset += dilation_w) {
-        // End of src channel data
-        auto* src_ce = src + output_hw;
-        // Dst row offset
-        for (int64_t h = h_offset; src < src_ce; h += stride_h * width) {
-          // End of src row data
-          auto* src_we = src + output_w;
-          if (is_a_ge_zero_and_a_lt_b(h, hw)) {
-            for (int64_t w = w_offset; src < src_we; src++, w += stride_w) {
-              if (is_a_ge_zero_and_a_lt_b(w, width)) {
-                dst[h + w] += *src;
-              }
+    for (int64_t kh = 0; kh < kernel_h; ++kh) {
+      for (int64_t kw = 0; kw < kernel_w; ++kw) {
+        // Dst column of the first src column, and the range of src columns that land inside the dst row,
+        // so that the inner loop has no bounds checks.
+        const int64_t w_offset = kw * dilation_w - pad_l;
+        const int64_t ow_begin = w_offset >= 0 ? 0 : std::min(output_w, (-w_offset + stride_w - 1) / stride_w);
+        const int64_t ow_end = w_offset >= width
+                                   ? ow_begin
+                                   : std::max(ow_begin, std::min(output_w, (width - w_offset + stride_w - 1) / stride_w));
+        for (int64_t oh = 0; oh < output_h; ++oh, src += output_w) {
+          const int64_t h = oh * stride_h + kh * dilation_h - pad_t;
+          if (!is_a_ge_zero_and_a_lt_b(h, height)) {
+            continue;
+          }
+          auto* dst_row = dst + h * width;
+          if (stride_w == 1) {
+            for (int64_t ow = ow_begin; ow < ow_end; ++ow) {
+              dst_row[w_offset + ow] += src[ow];
             }
           } else {
-            src = src_we;
+            for (int64_t ow = ow_begin; ow < ow_end; ++ow) {
+              dst_row[w_offset + ow * stride_w] += src[ow];
+            }
           }
         }
       }
@@ -20,8 +20,12 @@ std::ostream& operator<<(std::ostream& os, const OrtThreadPoolParams& params) {
   os << " auto_set_affinity: " << params.auto_set_affinity;
   os << " allow_spinning: " << params.allow_spinning;
   os << " dynamic_block_base_: " << params.dynamic_block_base_;
+  os << " adaptive_cost_model: " << params.adaptive_cost_model;
+  os << " adaptive_spinning: " << params.adaptive_spinning;
   os << " stack_size: " << params.stack_size;
   os << " affinity_str: " << params.affinity_str;
+  os << " numa_node: " << params.numa_node;
+  os << " performance_cores_only: " << params.performance_cores_only;
   // os << " name: " << (params.name ? params.name : L"nullptr");
   os << " set_denormal_as_zero: " << params.set_denormal_as_zero;
   // os << " custom_create_thread_fn: " << (params.custom_create_thread_fn ? "set" : "nullptr");
@@ -92,6 +96,40 @@ static std::vector<LogicalProcessors> ReadThreadAffinityConfig(const std::string
 static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   ThreadOptions to;
+  if (options.numa_node >= 0 && options.affinity_str.empty()) {
+    auto node_affinities = Env::Default().GetNumaNodeThreadAffinities(options.numa_node);
+    if (node_affinities.empty()) {
+      LOGS_DEFAULT(WARNING) << "NUMA node " << options.numa_node
+                            << " was not found or NUMA information is not available. Ignoring the NUMA node setting.";
+    } else {
+      if (options.thread_pool_size <= 0) {
+        options.thread_pool_size = static_cast<int>(node_affinities.size());
+      }
+
+      // the first entry is a placeholder for the main thread, which is dropped during threadpool creation.
+      // if there are more threads than cores on the node, the cores are shared round-robin.
+      to.affinities.reserve(options.thread_pool_size);
+      for (int i = 0; i < options.thread_pool_size; ++i) {
+        to.affinities.push_back(node_affinities[i % node_affinities.size()]);
+      }
+    }
+  } else if (options.performance_cores_only && options.affinity_str.empty()) {
+    auto p_core_affinities = Env::Default().GetPerformanceCoreThreadAffinities();
+    if (p_core_affinities.empty()) {
+      LOGS_DEFAULT(INFO) << "No distinct performance cores were detected. Ignoring the performance cores only setting.";
+    } else {
+      if (options.thread_pool_size <= 0) {
+        options.thread_pool_size = static_cast<int>(p_core_affinities.size());
+      }
+
+      // same as above, the first entry is dropped for the main thread and the cores are shared round-robin.
+      to.affinities.reserve(options.thread_pool_size);
+      for (int i = 0; i < options.thread_pool_size; ++i) {
+        to.affinities.push_back(p_core_affinities[i % p_core_affinities.size()]);
+      }
+    }
+  }
+
   if (options.thread_pool_size <= 0) {  // default
     if (options.auto_set_affinity) {
 #ifdef _WIN32
@@ -151,6 +189,8 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   to.custom_thread_creation_options = options.custom_thread_creation_options;
   to.custom_join_thread_fn = options.custom_join_thread_fn;
   to.dynamic_block_base_ = options.dynamic_block_base_;
+  to.adaptive_cost_model = options.adaptive_cost_model;
+  to.adaptive_spinning = options.adaptive_spinning;
   if (to.custom_create_thread_fn) {
     ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
   }
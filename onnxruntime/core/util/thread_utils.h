@@ -25,6 +25,14 @@ struct OrtThreadPoolParams {
   // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
 
+  // If it is true, the thread pool refines the kernel provided TensorOpCost of ParallelFor call sites from
+  // the measured execution time.
+  bool adaptive_cost_model = false;
+
+  // If it is true and spinning is allowed, the workers shorten their spinning when they keep waiting for work
+  // longer than they spin, and lengthen it again when work arrives soon after they stopped.
+  bool adaptive_spinning = false;
+
   unsigned int stack_size = 0;
 
   // A utf-8 string of affinity settings, format be like:
@@ -37,6 +45,15 @@ struct OrtThreadPoolParams {
   // meaning ith thread will be attached to first 8 logical processors
   std::string affinity_str;
 
+  // If it is non-negative and affinity_str is empty, pin the threads to the physical cores of this NUMA node.
+  // If thread_pool_size is 0, the pool gets one thread per physical core of the node.
+  // As memory is first-touched by the threads that use it, this keeps the arena memory of the session node-local.
+  int numa_node = -1;
+
+  // If it is true, affinity_str is empty and numa_node is negative, pin the threads to the performance cores of a
+  // hybrid CPU. If thread_pool_size is 0, the pool gets one thread per performance core.
+  bool performance_cores_only = false;
+
   const ORTCHAR_T* name = nullptr;
 
   // Set or unset denormal as zero
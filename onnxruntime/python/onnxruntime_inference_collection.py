@@ -4,6 +4,7 @@
 # --------------------------------------------------------------------------
 from __future__ import annotations
 
+import asyncio
 import collections
 import collections.abc
 import os
@@ -32,6 +33,35 @@ def get_ort_device_type(device_type: str, device_index) -> C.OrtDevice:
         raise Exception("Unsupported device type: " + device_type)
 
 
+def _run_async_future(submit):
+    """
+    Returns an asyncio future of the running event loop that is resolved with the results of an asynchronous run.
+
+    :param submit: function that starts the run, given the callback to invoke with ``(results, user_data, err)``.
+    """
+    loop = asyncio.get_running_loop()
+    future = loop.create_future()
+
+    def set_result(results, err):
+        if future.cancelled():
+            return
+        if err:
+            future.set_exception(C.Fail(err))
+        else:
+            future.set_result(results)
+
+    def callback(results, _user_data, err):
+        # invoked from an onnxruntime thread; the future may only be resolved from the thread of its loop
+        try:
+            loop.call_soon_threadsafe(set_result, results, err)
+        except RuntimeError:
+            # the loop was closed before the run completed, nobody is waiting for the results
+            pass
+
+    submit(callback)
+    return future
+
+
 class AdapterFormat:
     """
     This class is used to create adapter files from python structures
@@ -245,25 +275,48 @@ class Session:
                 f"Required inputs ({missing_input_names}) are missing from input feed ({feed_input_names})."
             )
 
-    def run(self, output_names, input_feed, run_options=None):
+    def run(self, output_names, input_feed, run_options=None, output_buffers=None):
         """
         Compute the predictions.
 
         :param output_names: name of the outputs
-        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param input_feed: dictionary ``{ input_name: input_value }``. An input value implementing
+            the ``__dlpack__`` protocol (a torch or cupy tensor for example) is used in place,
+            on CPU or GPU, if onnxruntime was built with DLPack support.
         :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param output_buffers: optional dictionary ``{ output_name: buffer }`` of preallocated outputs.
+            The output is written in place and the buffer is returned as the result. A buffer is
+            a writeable C contiguous numpy array, an :class:`onnxruntime.OrtValue` or an object
+            implementing the ``__dlpack__`` protocol, of the shape and type of the output.
         :return: list of results, every result is either a numpy array,
             a sparse tensor, a list or a dictionary.
 
         ::
 
             sess.run([output_name], {input_name: x})
+            sess.run([output_name], {input_name: x}, output_buffers={output_name: y})
         """
         self._validate_input(list(input_feed.keys()))
         if not output_names:
             output_names = [output.name for output in self._outputs_meta]
+
+        c_output_buffers = {}
+        if output_buffers:
+            for name, buffer in output_buffers.items():
+                c_output_buffers[name] = buffer._ortvalue if isinstance(buffer, OrtValue) else buffer
+
+        def invoke():
+            result = self._sess.run(output_names, input_feed, run_options, c_output_buffers)
+            if output_buffers:
+                # give back the python objects wrapping an OrtValue rather than the native ones
+                result = [
+                    value if output_buffers.get(name) is None else output_buffers[name]
+                    for name, value in zip(output_names, result)
+                ]
+            return result
+
         try:
-            return self._sess.run(output_names, input_feed, run_options)
+            return invoke()
         except C.EPFail as err:
             if self._enable_fallback:
                 print(f"EP Error: {err!s} using {self._providers}")
@@ -271,10 +324,10 @@ class Session:
                 self.set_providers(self._fallback_providers)
                 # Fallback only once.
                 self.disable_fallback()
-                return self._sess.run(output_names, input_feed, run_options)
+                return invoke()
             raise
 
-    def run_async(self, output_names, input_feed, callback, user_data, run_options=None):
+    def run_async(self, output_names, input_feed, callback=None, user_data=None, run_options=None):
         """
         Compute the predictions asynchronously in a separate cxx thread from ort intra-op threadpool.
 
@@ -282,8 +335,12 @@ class Session:
         :param input_feed: dictionary ``{ input_name: input_value }``
         :param callback: python function that accept array of results, and a status string on error.
             The callback will be invoked by a cxx thread from ort intra-op threadpool.
+            If None, an awaitable is returned instead, see below.
         :param run_options: See :class:`onnxruntime.RunOptions`.
 
+        The inputs are converted when the run is submitted, and the GIL is released while the run executes.
+        The python objects of the feeds are kept alive until the run completes.
+
         ::
             class MyData:
                 def __init__(self):
@@ -298,10 +355,23 @@ class Session:
                 # save results to user_data
 
             sess.run_async([output_name], {input_name: x}, callback)
+
+        Without a callback, the call must be made from a coroutine. It returns an asyncio future of the running event
+        loop that resolves to the array of results, or raises on error, so the event loop keeps serving while the
+        run executes::
+
+            async def predict(x):
+                return await sess.run_async([output_name], {input_name: x})
+
+        To coalesce concurrent requests into batched runs, see :class:`RequestBatcher`.
         """
         self._validate_input(list(input_feed.keys()))
         if not output_names:
             output_names = [output.name for output in self._outputs_meta]
+        if callback is None:
+            return _run_async_future(
+                lambda on_done: self._sess.run_async(output_names, input_feed, on_done, None, run_options)
+            )
         return self._sess.run_async(output_names, input_feed, callback, user_data, run_options)
 
     def run_with_ort_values(self, output_names, input_dict_ort_values, run_options=None):
@@ -576,6 +646,75 @@ class InferenceSession(Session):
                 C.register_tensorrt_plugins_as_custom_ops(session_options, providers[i][1])
 
 
+class RequestBatcher:
+    """
+    Coalesces concurrent requests to an :class:`onnxruntime.InferenceSession` into batched runs.
+
+    Every request feeds the same inputs and fetches the same outputs. The feeds of the queued requests are
+    concatenated along ``batch_axis`` and run together once ``max_batch_size`` rows are queued, or once the oldest
+    request has waited ``max_queue_delay_ms``. The outputs of the batch are split back to each request.
+    Only requests whose feeds match in element type and in every other dimension are batched together.
+    Feeds must be numeric CPU tensors, and the outputs of the model must have the same batch axis.
+
+    The batcher pairs with asyncio: each coroutine awaits its own request, while the batcher runs them together::
+
+        batcher = RequestBatcher(sess, max_batch_size=16, max_queue_delay_ms=2)
+
+        async def predict(x):
+            return await batcher.run_async({input_name: x})
+
+        results = await asyncio.gather(*(predict(x) for x in requests))
+    """
+
+    def __init__(
+        self,
+        session: Session,
+        input_names=None,
+        output_names=None,
+        max_batch_size: int = 8,
+        max_queue_delay_ms: float = 1.0,
+        batch_axis: int = 0,
+        run_options=None,
+    ):
+        """
+        :param session: the :class:`onnxruntime.InferenceSession` to run
+        :param input_names: names of the inputs every request feeds, all the inputs of the model by default
+        :param output_names: names of the outputs every request fetches, all the outputs of the model by default
+        :param max_batch_size: maximum number of rows of a batched run, a larger request runs on its own
+        :param max_queue_delay_ms: maximum time the oldest queued request waits for more requests
+        :param batch_axis: axis of the inputs and outputs the requests are concatenated along
+        :param run_options: See :class:`onnxruntime.RunOptions`, used for every batched run.
+        """
+        if not input_names:
+            input_names = [i.name for i in session.get_inputs()]
+        if not output_names:
+            output_names = [o.name for o in session.get_outputs()]
+        self._input_names = list(input_names)
+        self._batcher = C.RequestBatcher(
+            session._sess,
+            self._input_names,
+            list(output_names),
+            max_batch_size,
+            int(max_queue_delay_ms * 1000),
+            batch_axis,
+            run_options,
+        )
+
+    def run_async(self, input_feed, callback=None, user_data=None):
+        """
+        Queues a request.
+
+        :param input_feed: dictionary ``{ input_name: input_value }`` with a value for each input of the batcher
+        :param callback: python function invoked with the array of results of the request, its user data, and a
+            status string on error, from the dispatcher thread of the batcher.
+            If None, the call must be made from a coroutine and returns an asyncio future of the running event loop
+            that resolves to the array of results.
+        """
+        if callback is None:
+            return _run_async_future(lambda on_done: self._batcher.run_async(input_feed, on_done, None))
+        return self._batcher.run_async(input_feed, callback, user_data)
+
+
 class IOBinding:
     """
     This class provides API to bind input/output to a specified device, e.g. GPU.
@@ -625,6 +764,16 @@ class IOBinding:
         """
         self._iobinding.bind_ortvalue_input(name, ortvalue._ortvalue)
 
+    def bind_dlpack_input(self, name, tensor, is_bool_tensor=False):
+        """
+        Binds an input to a tensor implementing the ``__dlpack__`` protocol (a torch or cupy tensor
+        for example), on CPU or GPU, without copying it. Requires onnxruntime built with DLPack support.
+        :param name: input name
+        :param tensor: the tensor to bind
+        :param is_bool_tensor: DLPack has no boolean type, set it if the tensor holds booleans
+        """
+        self._iobinding.bind_dlpack_input(name, tensor, is_bool_tensor)
+
     def synchronize_inputs(self):
         self._iobinding.synchronize_inputs()
 
@@ -683,6 +832,16 @@ class IOBinding:
         """
         self._iobinding.bind_ortvalue_output(name, ortvalue._ortvalue)
 
+    def bind_dlpack_output(self, name, tensor, is_bool_tensor=False):
+        """
+        Binds an output to a preallocated tensor implementing the ``__dlpack__`` protocol, on CPU or
+        GPU, so the output is written in place. Requires onnxruntime built with DLPack support.
+        :param name: output name
+        :param tensor: the tensor to bind, of the shape and type of the output
+        :param is_bool_tensor: DLPack has no boolean type, set it if the tensor holds booleans
+        """
+        self._iobinding.bind_dlpack_output(name, tensor, is_bool_tensor)
+
     def synchronize_outputs(self):
         self._iobinding.synchronize_outputs()
 
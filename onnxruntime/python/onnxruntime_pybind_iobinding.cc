@@ -129,6 +129,15 @@ void addIoBindingMethods(pybind11::module& m) {
           throw std::runtime_error("Error when binding input: " + status.ErrorMessage());
         }
       })
+#if defined(ENABLE_DLPACK)
+      // This binds input to the memory of an object implementing the __dlpack__ protocol, without a copy
+      .def("bind_dlpack_input", [](SessionIOBinding* io_binding, const std::string& name, const py::object& tensor, bool is_bool_tensor) -> void {
+        auto status = io_binding->Get()->BindInput(name, FromDlpackObject(tensor, is_bool_tensor));
+        if (!status.IsOK()) {
+          throw std::runtime_error("Error when binding input: " + status.ErrorMessage());
+        }
+      })
+#endif
       .def("synchronize_inputs", [](SessionIOBinding* io_binding) -> void {
         auto status = io_binding->Get()->SynchronizeInputs();
         if (!status.IsOK()) {
@@ -167,6 +176,15 @@ void addIoBindingMethods(pybind11::module& m) {
           throw std::runtime_error("Error when binding output: " + status.ErrorMessage());
         }
       })
+#if defined(ENABLE_DLPACK)
+      // This binds output to the preallocated memory of an object implementing the __dlpack__ protocol
+      .def("bind_dlpack_output", [](SessionIOBinding* io_binding, const std::string& name, const py::object& tensor, bool is_bool_tensor) -> void {
+        auto status = io_binding->Get()->BindOutput(name, FromDlpackObject(tensor, is_bool_tensor));
+        if (!status.IsOK()) {
+          throw std::runtime_error("Error when binding output: " + status.ErrorMessage());
+        }
+      })
+#endif
       .def("synchronize_outputs", [](SessionIOBinding* io_binding) -> void {
         auto status = io_binding->Get()->SynchronizeOutputs();
         if (!status.IsOK()) {
@@ -665,6 +665,17 @@ static bool CheckIfInputIsSequenceType(const std::string& name_input,
   return type_proto.has_sequence_type();
 }
 
+#if defined(ENABLE_DLPACK)
+static bool IsBoolTensorInput(const std::string& name_input, const InputDefList* input_def_list) {
+  if (input_def_list == nullptr) {
+    return false;
+  }
+  onnx::TypeProto type_proto;
+  return !CheckIfInputIsSequenceType(name_input, input_def_list, type_proto) &&
+         type_proto.tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_BOOL;
+}
+#endif
+
 static void CreateSequenceOfTensors(AllocatorPtr alloc, const std::string& name_input,
                                     const InputDefList* input_def_list, PyObject* pylist_obj, OrtValue* p_mlvalue) {
   onnx::TypeProto type_proto;
@@ -996,6 +1007,12 @@ void CreateGenericMLValue(const onnxruntime::InputDefList* input_def_list, const
     // This should just increase the ref counts of the underlying shared_ptrs in the native OrtValue
     // and the ref count will be decreased when the OrtValue used for Run() is destroyed upon exit.
     *p_mlvalue = *value.attr(PYTHON_ORTVALUE_NATIVE_OBJECT_ATTR).cast<OrtValue*>();
+#if defined(ENABLE_DLPACK)
+  } else if (!accept_only_numpy_array && IsDlpackObject(value)) {
+    // A tensor of another framework, on CPU or on a GPU. It is used in place, the OrtValue keeps it alive.
+    // DLPack has no boolean type so a bool tensor comes as uint8, the model input tells which one it is.
+    *p_mlvalue = FromDlpackObject(value, IsBoolTensorInput(name_input, input_def_list));
+#endif
   } else if (!accept_only_numpy_array) {
     auto iterator = PyObject_GetIter(value.ptr());
     if (iterator == NULL) {
@@ -31,6 +31,7 @@
 #include "core/session/abi_session_options_impl.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/provider_bridge_ort.h"
+#include "core/session/request_batcher.h"
 
 #include "core/session/lora_adapters.h"
 
@@ -98,6 +99,11 @@ struct AsyncResource {
   PyCallback callback;
   py::object user_data;
 
+  // The OrtValues created from numpy arrays share their memory, and the run holds a pointer to the run options,
+  // so the python objects are kept alive until the callback is invoked.
+  std::vector<py::object> feed_objects;
+  py::object run_options_object;
+
   void ReserveFeeds(size_t sz) {
     feeds.reserve(sz);
     feeds_raw.reserve(sz);
@@ -111,6 +117,19 @@ struct AsyncResource {
     fetch_names_raw.reserve(sz);
   }
 
+  // Converts a python feed to an OrtValue. This needs the GIL, so it is the only part of submitting an asynchronous run
+  // that holds it.
+  void AddFeed(const InputDefList* input_def_list, const std::string& name, const py::object& value) {
+    OrtValue ml_value;
+    CreateGenericMLValue(input_def_list, GetAllocator(), name, value, &ml_value);
+    ThrowIfPyErrOccured();
+    feeds.push_back(std::move(ml_value));
+    feeds_raw.push_back(&feeds.back());
+    feed_names.push_back(name);
+    feed_names_raw.push_back(feed_names.back().c_str());
+    feed_objects.push_back(value);
+  }
+
   ~AsyncResource() {
     std::for_each(fetches_raw.begin(), fetches_raw.end(), [](const OrtValue* fetch) {
       if (fetch) {
@@ -166,6 +185,27 @@ void AsyncCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtS
   }
 }
 
+// Owns a RequestBatcher created from python. The batcher runs the queued requests when it is destroyed, and their
+// callbacks acquire the GIL, so the GIL is released while destroying it.
+struct PyRequestBatcher {
+  PyRequestBatcher(PyInferenceSession* sess, std::unique_ptr<RequestBatcher> request_batcher,
+                   std::vector<std::string> input_names, size_t output_count)
+      : session(sess),
+        batcher(std::move(request_batcher)),
+        feed_names(std::move(input_names)),
+        num_fetches(output_count) {}
+
+  ~PyRequestBatcher() {
+    py::gil_scoped_release release;
+    batcher.reset();
+  }
+
+  PyInferenceSession* session;
+  std::unique_ptr<RequestBatcher> batcher;
+  std::vector<std::string> feed_names;
+  size_t num_fetches;
+};
+
 void AppendLoraParametersAsInputs(const RunOptions& run_options,
                                   size_t total_entries,
                                   NameMLValMap& feeds) {
@@ -826,6 +866,14 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_hw_compatible' should be 'True' or 'False'. Default value is 'False'.\n");
             }
+          } else if (option.first == "trt_widen_profile_ranges") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_widen_profile_ranges = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_widen_profile_ranges = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_widen_profile_ranges' should be 'True' or 'False'. Default value is 'False'.\n");
+            }
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -1191,7 +1239,10 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
 #endif
     const auto partitioning_stop_ops_list = session_options.config_options.GetConfigEntry(
         kOrtSessionOptionsConfigNnapiEpPartitioningStopOps);
-    return onnxruntime::NnapiProviderFactoryCreator::Create(0, partitioning_stop_ops_list)->CreateProvider();
+    const auto compilation_cache_dir = session_options.config_options.GetConfigEntry(
+        kOrtSessionOptionsConfigNnapiEpCompilationCacheDir);
+    return onnxruntime::NnapiProviderFactoryCreator::Create(0, partitioning_stop_ops_list, compilation_cache_dir)
+        ->CreateProvider();
 #endif
   } else if (type == kRknpuExecutionProvider) {
 #ifdef USE_RKNPU
@@ -1224,6 +1275,10 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
         if (flags_str.find("COREML_FLAG_CREATE_MLPROGRAM") != std::string::npos) {
           coreml_flags |= COREMLFlags::COREML_FLAG_CREATE_MLPROGRAM;
         }
+
+        if (flags_str.find("COREML_FLAG_ENABLE_MODEL_CACHE") != std::string::npos) {
+          coreml_flags |= COREMLFlags::COREML_FLAG_ENABLE_MODEL_CACHE;
+        }
       }
     }
 
@@ -1543,6 +1598,37 @@ void addGlobalMethods(py::module& m) {
 #endif
 }
 
+// Wraps a buffer given to run() for an output, so the output is written in place. The buffer is either a
+// writeable C contiguous numpy array, an OrtValue or, in a build with DLPack, any object implementing __dlpack__.
+static OrtValue CreateOutputBufferMLValue(const OutputDefList& output_defs, const std::string& name,
+                                          const py::object& buffer) {
+  OrtValue ort_value;
+  if (IsNumericNumpyArray(buffer)) {
+    PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(buffer.ptr());
+    if (!PyArray_IS_C_CONTIGUOUS(arr) || !PyArray_ISWRITEABLE(arr)) {
+      throw std::runtime_error("The buffer for output '" + name + "' must be a writeable C contiguous array.");
+    }
+    Tensor::InitOrtValue(NumpyTypeToOnnxRuntimeTensorType(PyArray_TYPE(arr)),
+                         GetShape(py::reinterpret_borrow<py::array>(buffer)), PyArray_DATA(arr),
+                         GetAllocator()->Info(), ort_value);
+  } else if (py::isinstance<OrtValue>(buffer)) {
+    ort_value = *buffer.cast<OrtValue*>();
+#if defined(ENABLE_DLPACK)
+  } else if (IsDlpackObject(buffer)) {
+    auto def = std::find_if(output_defs.begin(), output_defs.end(),
+                            [&name](const NodeArg* node_arg) { return node_arg->Name() == name; });
+    const bool is_bool_tensor = def != output_defs.end() && (*def)->TypeAsProto() != nullptr &&
+                                (*def)->TypeAsProto()->tensor_type().elem_type() ==
+                                    ONNX_NAMESPACE::TensorProto_DataType_BOOL;
+    ort_value = FromDlpackObject(buffer, is_bool_tensor);
+#endif
+  } else {
+    ORT_UNUSED_PARAMETER(output_defs);
+    throw std::runtime_error("Unsupported buffer type for output '" + name + "'.");
+  }
+  return ort_value;
+}
+
 void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registration_fn) {
   py::enum_<GraphOptimizationLevel>(m, "GraphOptimizationLevel")
       .value("ORT_DISABLE_ALL", GraphOptimizationLevel::ORT_DISABLE_ALL)
@@ -1612,6 +1698,8 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
             ort_arena_cfg->initial_growth_chunk_size_bytes = kvp.second.cast<int>();
           } else if (key == "max_power_of_two_extend_bytes") {
             ort_arena_cfg->max_power_of_two_extend_bytes = kvp.second.cast<int>();
+          } else if (key == "small_block_cache_bytes") {
+            ort_arena_cfg->small_block_cache_bytes = kvp.second.cast<int64_t>();
           } else {
             ORT_THROW("Invalid OrtArenaCfg option: ", key);
           }
@@ -1623,7 +1711,8 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
       .def_readwrite("initial_chunk_size_bytes", &OrtArenaCfg::initial_chunk_size_bytes)
       .def_readwrite("max_dead_bytes_per_chunk", &OrtArenaCfg::max_dead_bytes_per_chunk)
       .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes)
-      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes);
+      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes)
+      .def_readwrite("small_block_cache_bytes", &OrtArenaCfg::small_block_cache_bytes);
 
   py::class_<OrtMemoryInfo> ort_memory_info_binding(m, "OrtMemoryInfo");
   ort_memory_info_binding.def(py::init([](const char* name, OrtAllocatorType type, int id, OrtMemType mem_type) {
@@ -2045,7 +2134,8 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           R"pbdoc(Load a model saved in ONNX or ORT format.)pbdoc")
       .def("run",
            [](PyInferenceSession* sess, const std::vector<std::string>& output_names,
-              const std::map<std::string, const py::object>& pyfeeds, RunOptions* run_options = nullptr)
+              const std::map<std::string, const py::object>& pyfeeds, RunOptions* run_options,
+              const std::map<std::string, py::object>& pyoutput_buffers)
                -> py::list {
              NameMLValMap feeds;
              if (run_options != nullptr && !run_options->active_adapters.empty()) {
@@ -2071,9 +2161,26 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                }
              }
 
+             // the outputs with a buffer are written in place and returned as the object that was passed in
              std::vector<OrtValue> fetches;
-             fetches.reserve(output_names.size());
-             common::Status status;
+             std::vector<py::object> fetch_buffers;
+             if (!pyoutput_buffers.empty()) {
+               auto px = sess->GetSessionHandle()->GetModelOutputs();
+               if (!px.first.IsOK() || !px.second) {
+                 throw std::runtime_error("Either failed to get model outputs from the session object or the output def list was null");
+               }
+               fetches.resize(output_names.size());
+               fetch_buffers.resize(output_names.size());
+               for (size_t i = 0; i < output_names.size(); ++i) {
+                 auto buffer = pyoutput_buffers.find(output_names[i]);
+                 if (buffer != pyoutput_buffers.end() && !buffer->second.is(py::none())) {
+                   fetches[i] = CreateOutputBufferMLValue(*px.second, output_names[i], buffer->second);
+                   fetch_buffers[i] = buffer->second;
+                 }
+               }
+             } else {
+               fetches.reserve(output_names.size());
+             }
 
              {
                // release GIL to allow multiple python threads to invoke Run() in parallel.
@@ -2088,7 +2195,9 @@ including arg name, arg type (contains both type and shape).)pbdoc")
              py::list result;
              size_t pos = 0;
              for (const auto& fet : fetches) {
-               if (fet.IsAllocated()) {
+               if (!fetch_buffers.empty() && fetch_buffers[pos]) {
+                 result.append(fetch_buffers[pos]);
+               } else if (fet.IsAllocated()) {
                  if (fet.IsTensor()) {
                    result.append(AddTensorAsPyObj(fet, nullptr, nullptr));
                  } else if (fet.IsSparseTensor()) {
@@ -2102,7 +2211,9 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                ++pos;
              }
              return result;
-           })
+           },
+           py::arg("output_names"), py::arg("input_feed"), py::arg("run_options") = nullptr,
+           py::arg("output_buffers") = std::map<std::string, py::object>{})
       .def("run_async",
            [](PyInferenceSession* sess,
               const std::vector<std::string>& output_names,
@@ -2119,20 +2230,14 @@ including arg name, arg type (contains both type and shape).)pbdoc")
              async_resource->callback = callback;
              async_resource->user_data = user_data;
              // prepare feeds
+             auto px = sess->GetSessionHandle()->GetModelInputs();
+             if (!px.first.IsOK() || !px.second) {
+               throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+             }
              async_resource->ReserveFeeds(pyfeeds.size());
              for (const auto& feed : pyfeeds) {
                if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 async_resource->feeds.push_back(ml_value);
-                 async_resource->feeds_raw.push_back(&async_resource->feeds.back());
-                 async_resource->feed_names.push_back(feed.first);
-                 async_resource->feed_names_raw.push_back(async_resource->feed_names.back().c_str());
+                 async_resource->AddFeed(px.second, feed.first, feed.second);
                }
              }
              // prepare fetches
@@ -2142,14 +2247,25 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                async_resource->fetch_names_raw.push_back(async_resource->fetch_names.back().c_str());
                async_resource->fetches_raw.push_back({});
              }
-             const RunOptions* run_async_option = run_options ? run_options : &async_resource->default_run_option;
-             common::Status status = sess->GetSessionHandle()->RunAsync(run_async_option,
-                                                                        gsl::span(async_resource->feed_names_raw.data(), async_resource->feed_names_raw.size()),
-                                                                        gsl::span(async_resource->feeds_raw.data(), async_resource->feeds_raw.size()),
-                                                                        gsl::span(async_resource->fetch_names_raw.data(), async_resource->fetch_names_raw.size()),
-                                                                        gsl::span(async_resource->fetches_raw.data(), async_resource->fetches_raw.size()),
-                                                                        AsyncCallback,
-                                                                        async_resource.get());
+             const RunOptions* run_async_option = &async_resource->default_run_option;
+             if (run_options != nullptr) {
+               async_resource->run_options_object = py::cast(run_options, py::return_value_policy::reference);
+               run_async_option = run_options;
+             }
+
+             common::Status status;
+             {
+               // the run is scheduled on the intra op thread pool, and its callback acquires the GIL to convert the
+               // fetches, so the GIL isn't held while submitting it
+               py::gil_scoped_release release;
+               status = sess->GetSessionHandle()->RunAsync(run_async_option,
+                                                           gsl::span(async_resource->feed_names_raw.data(), async_resource->feed_names_raw.size()),
+                                                           gsl::span(async_resource->feeds_raw.data(), async_resource->feeds_raw.size()),
+                                                           gsl::span(async_resource->fetch_names_raw.data(), async_resource->fetch_names_raw.size()),
+                                                           gsl::span(async_resource->fetches_raw.data(), async_resource->fetches_raw.size()),
+                                                           AsyncCallback,
+                                                           async_resource.get());
+             }
              if (status.IsOK()) {
                async_resource.release();
              }
@@ -2295,6 +2411,68 @@ including arg name, arg type (contains both type and shape).)pbdoc")
 #endif
       });
 
+  py::class_<PyRequestBatcher>(m, "RequestBatcher",
+                               R"pbdoc(Coalesces concurrent requests to an InferenceSession into batched runs.)pbdoc")
+      .def(py::init([](PyInferenceSession* sess, std::vector<std::string> input_names,
+                       std::vector<std::string> output_names, size_t max_batch_size, int64_t max_queue_delay_us,
+                       size_t batch_axis, const RunOptions* run_options) {
+             RequestBatcherOptions options;
+             options.max_batch_size = max_batch_size;
+             options.max_queue_delay = std::chrono::microseconds(max_queue_delay_us);
+             options.batch_axis = batch_axis;
+             const size_t num_fetches = output_names.size();
+             auto batcher = std::make_unique<RequestBatcher>(*sess->GetSessionHandle(), options, input_names,
+                                                             std::move(output_names),
+                                                             run_options ? *run_options : RunOptions{});
+             return std::make_unique<PyRequestBatcher>(sess, std::move(batcher), std::move(input_names), num_fetches);
+           }),
+           // the batcher runs the session, so the session must outlive it
+           py::keep_alive<1, 2>(),
+           py::arg("session"), py::arg("input_names"), py::arg("output_names"), py::arg("max_batch_size") = 8,
+           py::arg("max_queue_delay_us") = 1000, py::arg("batch_axis") = 0, py::arg("run_options") = nullptr)
+      .def(
+          "run_async",
+          [](PyRequestBatcher* batcher, const std::map<std::string, py::object>& pyfeeds, PyCallback callback,
+             py::object user_data) -> void {
+            auto px = batcher->session->GetSessionHandle()->GetModelInputs();
+            if (!px.first.IsOK() || !px.second) {
+              throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+            }
+
+            std::unique_ptr<AsyncResource> async_resource = std::make_unique<AsyncResource>();
+            async_resource->callback = callback;
+            async_resource->user_data = user_data;
+            async_resource->ReserveFeeds(batcher->feed_names.size());
+            for (const auto& name : batcher->feed_names) {
+              auto feed = pyfeeds.find(name);
+              if (feed == pyfeeds.end() || feed->second.is(py::none())) {
+                throw std::runtime_error("Missing feed for input '" + name + "' of the request batcher.");
+              }
+              async_resource->AddFeed(px.second, name, feed->second);
+            }
+            // the batcher moves the fetches of the request into these
+            async_resource->ReserveFetches(batcher->num_fetches);
+            for (size_t i = 0; i < batcher->num_fetches; ++i) {
+              async_resource->fetches_raw.push_back(new OrtValue());
+            }
+
+            common::Status status;
+            {
+              py::gil_scoped_release release;
+              status = batcher->batcher->RunAsync(
+                  gsl::span(async_resource->feeds_raw.data(), async_resource->feeds_raw.size()),
+                  gsl::span(async_resource->fetches_raw.data(), async_resource->fetches_raw.size()),
+                  AsyncCallback, async_resource.get());
+            }
+            if (status.IsOK()) {
+              async_resource.release();
+            }
+            OrtPybindThrowIfError(status);
+          },
+          R"pbdoc(Queues a request. The callback is invoked from the dispatcher thread of the batcher with the outputs of
+the request, split from the outputs of its batch.)pbdoc",
+          py::arg("input_feed"), py::arg("callback"), py::arg("user_data") = py::none());
+
   py::enum_<onnxruntime::ArenaExtendStrategy>(m, "ArenaExtendStrategy", py::arithmetic())
       .value("kNextPowerOfTwo", onnxruntime::ArenaExtendStrategy::kNextPowerOfTwo)
       .value("kSameAsRequested", onnxruntime::ArenaExtendStrategy::kSameAsRequested)
@@ -43,7 +43,7 @@ onnxruntime::ROCMExecutionProviderExternalAllocatorInfo external_allocator_info{
 onnxruntime::ArenaExtendStrategy arena_extend_strategy = onnxruntime::ArenaExtendStrategy::kNextPowerOfTwo;
 #endif
 
-#ifdef ENABLE_TRAINING
+#if defined(ENABLE_DLPACK)
 
 void DlpackCapsuleDestructor(PyObject* data) {
   DLManagedTensor* dlmanaged_tensor = reinterpret_cast<DLManagedTensor*>(PyCapsule_GetPointer(data, "dltensor"));
@@ -76,6 +76,16 @@ OrtValue FromDlpack(PyObject* dlpack_tensor, const bool is_bool_tensor) {
   return ort_value;
 }
 
+bool IsDlpackObject(const py::object& obj) {
+  return py::hasattr(obj, "__dlpack__") && py::hasattr(obj, "__dlpack_device__");
+}
+
+OrtValue FromDlpackObject(const py::object& obj, const bool is_bool_tensor) {
+  // no stream is given, so a producer on a GPU synchronizes its work with the default stream before returning
+  py::object capsule = obj.attr("__dlpack__")();
+  return FromDlpack(capsule.ptr(), is_bool_tensor);
+}
+
 #endif
 
 #if !defined(DISABLE_SPARSE_TENSORS)
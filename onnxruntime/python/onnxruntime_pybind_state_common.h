@@ -12,7 +12,7 @@
 #include "core/session/environment.h"
 #include "core/session/abi_session_options_impl.h"
 #include "core/session/inference_session.h"
-#ifdef ENABLE_TRAINING
+#if defined(ENABLE_DLPACK)
 #include "core/dlpack/dlpack_converter.h"
 #endif
 
@@ -413,7 +413,7 @@ bool CheckIfTensor(const std::vector<const NodeArg*>& def_list,
                    const std::string& name,
                    /*out*/ ONNX_NAMESPACE::TypeProto& type_proto);
 
-#ifdef ENABLE_TRAINING
+#if defined(ENABLE_DLPACK)
 
 // Allocate a new Capsule object, which takes the ownership of OrtValue.
 // Caller is responsible for releasing.
@@ -427,6 +427,13 @@ OrtValue FromDlpack(PyObject* dlpack_tensor, const bool is_bool_tensor);
 // Destructor for Capsule object holding a DLPack structure.
 void DlpackCapsuleDestructor(PyObject* data);
 
+// Tells if the object implements the __dlpack__ protocol, a torch or cupy tensor for example.
+bool IsDlpackObject(const pybind11::object& obj);
+
+// Creates an OrtValue over the memory of an object implementing the __dlpack__ protocol, without copying it.
+// The OrtValue keeps the memory of the object alive.
+OrtValue FromDlpackObject(const pybind11::object& obj, const bool is_bool_tensor);
+
 #endif
 
 }  // namespace python
@@ -3,6 +3,7 @@
 #include "core/common/common.h"
 #include "core/common/logging/capture.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/common/logging/sinks/cerr_sink.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/logging/sinks/composite_sink.h"
@@ -10,6 +11,8 @@
 
 #include "test/common/logging/helpers.h"
 
+#include <future>
+
 using namespace ::onnxruntime::logging;
 using InstanceType = LoggingManager::InstanceType;
 
@@ -222,3 +225,74 @@ TEST(LoggingTests, TestGetRemoveSingleSink) {
   EXPECT_EQ(removed_sink.get(), single_mock_sink);  // Check it's the same sink
   EXPECT_FALSE(sink.HasOnlyOneSink());              // Should be empty now
 }
+
+/// <summary>
+/// Tests that the async sink sends the messages to the wrapped sink.
+/// </summary>
+TEST(LoggingTests, TestAsyncSink) {
+  const std::string logid{"TestAsyncSink"};
+  const Severity min_log_level = Severity::kWARNING;
+
+  MockSink* sink_ptr = new MockSink();
+  EXPECT_CALL(*sink_ptr, SendImpl(testing::_, logid, testing::_)).Times(2);
+
+  AsyncSink* async_sink = new AsyncSink(std::unique_ptr<ISink>{sink_ptr});
+  LoggingManager manager{std::unique_ptr<ISink>(async_sink), min_log_level, false, InstanceType::Temporal};
+
+  auto logger = manager.CreateLogger(logid);
+
+  LOGS(*logger, WARNING) << "Warning 1";
+  LOGS(*logger, WARNING) << "Warning 2";
+
+  async_sink->Flush();
+  testing::Mock::VerifyAndClearExpectations(sink_ptr);
+  EXPECT_EQ(async_sink->DroppedCount(), 0U);
+}
+
+namespace {
+// sink that blocks until released, recording the messages
+class BlockingSink : public ISink {
+ public:
+  void Release() { release_.set_value(); }
+  const std::vector<std::string>& Messages() const { return messages_; }
+
+ private:
+  void SendImpl(const Timestamp& /*timestamp*/, const std::string& /*logger_id*/, const Capture& message) override {
+    released_.wait();
+    messages_.push_back(message.Message());
+  }
+
+  std::promise<void> release_;
+  std::shared_future<void> released_{release_.get_future()};
+  std::vector<std::string> messages_;
+};
+}  // namespace
+
+/// <summary>
+/// Tests that the async sink drops messages when its buffer is full and reports how many were dropped.
+/// </summary>
+TEST(LoggingTests, TestAsyncSinkDropsWhenFull) {
+  const Severity min_log_level = Severity::kWARNING;
+  constexpr int kNumMessages = 5;
+
+  BlockingSink* sink_ptr = new BlockingSink();
+  // at most one message is being sent and two are queued while the wrapped sink is blocked
+  AsyncSink* async_sink = new AsyncSink(std::unique_ptr<ISink>{sink_ptr}, 2);
+  LoggingManager manager{std::unique_ptr<ISink>(async_sink), min_log_level, false, InstanceType::Temporal};
+
+  auto logger = manager.CreateLogger("TestAsyncSinkDropsWhenFull");
+  for (int i = 0; i < kNumMessages; ++i) {
+    LOGS(*logger, WARNING) << "Warning " << i;
+  }
+
+  const size_t dropped = async_sink->DroppedCount();
+  EXPECT_GE(dropped, 2U);
+
+  sink_ptr->Release();
+  async_sink->Flush();
+
+  const auto& messages = sink_ptr->Messages();
+  ASSERT_EQ(messages.size(), static_cast<size_t>(kNumMessages) - dropped + 1);
+  EXPECT_EQ(messages[0], "Warning 0");
+  EXPECT_NE(messages.back().find("Dropped " + std::to_string(dropped)), std::string::npos);
+}
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/node_latency_stats.h"
+
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+using profiling::LatencyHistogram;
+using profiling::NodeLatencyStats;
+
+TEST(NodeLatencyStatsTest, BucketRangesCoverEachLatency) {
+  for (uint64_t latency : {uint64_t{0}, uint64_t{7}, uint64_t{8}, uint64_t{15}, uint64_t{16}, uint64_t{1000},
+                           uint64_t{123456789}, std::numeric_limits<uint64_t>::max()}) {
+    const size_t index = LatencyHistogram::BucketIndex(latency);
+    ASSERT_LT(index, LatencyHistogram::kNumBuckets);
+    const auto range = LatencyHistogram::BucketRange(index);
+    EXPECT_LE(range.first, latency);
+    if (latency != std::numeric_limits<uint64_t>::max()) {
+      EXPECT_LT(latency, range.second);
+    }
+  }
+
+  // consecutive buckets are adjacent
+  for (size_t i = 1; i < LatencyHistogram::kNumBuckets; ++i) {
+    EXPECT_EQ(LatencyHistogram::BucketRange(i - 1).second, LatencyHistogram::BucketRange(i).first);
+  }
+}
+
+TEST(NodeLatencyStatsTest, Percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.PercentileNs(50), 0u);
+
+  // 1..1000 us
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.Record(i * 1000);
+  }
+  EXPECT_EQ(histogram.Count(), 1000u);
+  EXPECT_EQ(histogram.MaxNs(), 1000000u);
+  EXPECT_NEAR(static_cast<double>(histogram.PercentileNs(50)), 500000.0, 500000.0 * 0.07);
+  EXPECT_NEAR(static_cast<double>(histogram.PercentileNs(99)), 990000.0, 990000.0 * 0.07);
+}
+
+TEST(NodeLatencyStatsTest, ConcurrentRecordAndSummarize) {
+  NodeLatencyStats stats;
+  stats.Enable(1);
+  LatencyHistogram* conv = stats.GetHistogram("Conv", "CPUExecutionProvider");
+  EXPECT_EQ(conv, stats.GetHistogram("Conv", "CPUExecutionProvider"));
+  LatencyHistogram* relu = stats.GetHistogram("Relu", "CPUExecutionProvider");
+  EXPECT_NE(conv, relu);
+  stats.GetHistogram("Add", "CPUExecutionProvider");
+
+  constexpr int kThreads = 4;
+  constexpr int kRecordsPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < kRecordsPerThread; ++i) {
+        conv->Record(2000);
+        relu->Record(100);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // histograms without records are left out
+  const auto summaries = stats.Summarize();
+  ASSERT_EQ(summaries.size(), 2u);
+  EXPECT_EQ(summaries[0].op_type, "Conv");
+  EXPECT_EQ(summaries[0].count, static_cast<uint64_t>(kThreads * kRecordsPerThread));
+  EXPECT_EQ(summaries[0].total_ns, 2000u * kThreads * kRecordsPerThread);
+  EXPECT_EQ(summaries[1].op_type, "Relu");
+  EXPECT_EQ(summaries[1].max_ns, 100u);
+}
+
+TEST(NodeLatencyStatsTest, SampleExecution) {
+  NodeLatencyStats stats;
+  EXPECT_FALSE(stats.SampleExecution());
+
+  stats.Enable(3);
+  std::vector<bool> sampled;
+  for (int i = 0; i < 6; ++i) {
+    sampled.push_back(stats.SampleExecution());
+  }
+  EXPECT_EQ(sampled, (std::vector<bool>{true, false, false, true, false, false}));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
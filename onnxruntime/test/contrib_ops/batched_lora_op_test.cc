@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// output[b, s, n] = scale * sum_r (sum_d input[b, s, d] * lora_a[i, d, r]) * lora_b[i, r, n] with i the adapter of
+// row b, zero for rows without an adapter.
+std::vector<float> ComputeReference(const std::vector<float>& input, const std::vector<float>& lora_a,
+                                    const std::vector<float>& lora_b, const std::vector<int32_t>& adapter_indices,
+                                    int64_t rows_per_batch, int64_t hidden_size, int64_t rank, int64_t output_size,
+                                    float scale) {
+  const int64_t batch_size = static_cast<int64_t>(adapter_indices.size());
+  std::vector<float> output(static_cast<size_t>(batch_size * rows_per_batch * output_size), 0.f);
+  for (int64_t b = 0; b < batch_size; ++b) {
+    const int32_t adapter = adapter_indices[static_cast<size_t>(b)];
+    if (adapter < 0) {
+      continue;
+    }
+
+    for (int64_t s = 0; s < rows_per_batch; ++s) {
+      const int64_t row = b * rows_per_batch + s;
+      for (int64_t n = 0; n < output_size; ++n) {
+        float sum = 0.f;
+        for (int64_t r = 0; r < rank; ++r) {
+          float projected = 0.f;
+          for (int64_t d = 0; d < hidden_size; ++d) {
+            projected += input[static_cast<size_t>(row * hidden_size + d)] *
+                         lora_a[static_cast<size_t>((adapter * hidden_size + d) * rank + r)];
+          }
+          sum += projected * lora_b[static_cast<size_t>((adapter * rank + r) * output_size + n)];
+        }
+        output[static_cast<size_t>(row * output_size + n)] = scale * sum;
+      }
+    }
+  }
+
+  return output;
+}
+
+void RunBatchedLoRATest(const std::vector<int32_t>& adapter_indices, int64_t rows_per_batch, bool use_3d_input) {
+  constexpr int64_t num_adapters = 3;
+  constexpr int64_t hidden_size = 8;
+  constexpr int64_t rank = 2;
+  constexpr int64_t output_size = 6;
+  constexpr float scale = 0.5f;
+  const int64_t batch_size = static_cast<int64_t>(adapter_indices.size());
+
+  RandomValueGenerator random{};
+  const std::vector<int64_t> input_size{batch_size * rows_per_batch * hidden_size};
+  const std::vector<int64_t> lora_a_size{num_adapters * hidden_size * rank};
+  const std::vector<int64_t> lora_b_size{num_adapters * rank * output_size};
+  const auto input = random.Uniform<float>(input_size, -1.0f, 1.0f);
+  const auto lora_a = random.Uniform<float>(lora_a_size, -1.0f, 1.0f);
+  const auto lora_b = random.Uniform<float>(lora_b_size, -1.0f, 1.0f);
+  const auto expected = ComputeReference(input, lora_a, lora_b, adapter_indices, rows_per_batch, hidden_size, rank,
+                                         output_size, scale);
+
+  std::vector<int64_t> input_dims{batch_size, hidden_size};
+  std::vector<int64_t> output_dims{batch_size, output_size};
+  if (use_3d_input) {
+    input_dims = {batch_size, rows_per_batch, hidden_size};
+    output_dims = {batch_size, rows_per_batch, output_size};
+  }
+
+  for (bool use_cuda : {false, true}) {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    if (use_cuda) {
+      auto cuda_ep = DefaultCudaExecutionProvider();
+      if (cuda_ep == nullptr) {
+        continue;
+      }
+      execution_providers.push_back(std::move(cuda_ep));
+    } else {
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+    }
+
+    OpTester tester("BatchedLoRA", 1, onnxruntime::kMSDomain);
+    tester.AddAttribute<float>("scale", scale);
+    tester.AddInput<float>("input", input_dims, input);
+    tester.AddInput<float>("lora_a", {num_adapters, hidden_size, rank}, lora_a);
+    tester.AddInput<float>("lora_b", {num_adapters, rank, output_size}, lora_b);
+    tester.AddInput<int32_t>("adapter_indices", {batch_size}, adapter_indices);
+    tester.AddOutput<float>("output", output_dims, expected);
+    tester.SetOutputTolerance(1e-4f);
+    tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
+}  // namespace
+
+TEST(BatchedLoRATest, MixedAdapters2D) {
+  RunBatchedLoRATest({0, 0, 2, -1, 1, 1, 0}, 1, false);
+}
+
+TEST(BatchedLoRATest, MixedAdapters3D) {
+  RunBatchedLoRATest({1, -1, -1, 2, 0}, 3, true);
+}
+
+TEST(BatchedLoRATest, NoAdapters) {
+  RunBatchedLoRATest({-1, -1}, 2, true);
+}
+
+TEST(BatchedLoRATest, AdapterIndexOutOfRange) {
+  OpTester tester("BatchedLoRA", 1, onnxruntime::kMSDomain);
+  tester.AddInput<float>("input", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  tester.AddInput<float>("lora_a", {1, 2, 1}, {1.f, 1.f});
+  tester.AddInput<float>("lora_b", {1, 1, 2}, {1.f, 1.f});
+  tester.AddInput<int32_t>("adapter_indices", {2}, {0, 1});
+  tester.AddOutput<float>("output", {2, 2}, {3.f, 3.f, 7.f, 7.f});
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "is out of range", {}, nullptr, &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
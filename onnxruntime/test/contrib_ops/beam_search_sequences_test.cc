@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+#include "gtest/gtest.h"
+#include <gsl/gsl>
+#include "contrib_ops/cpu/transformers/sequences.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::Sequences;
+
+namespace {
+
+std::vector<int32_t> GetSequence(const Sequences& sequences, int beam_index) {
+  auto sequence = sequences.GetSequence(beam_index);
+  return std::vector<int32_t>(sequence.begin(), sequence.end());
+}
+
+void Append(Sequences& sequences, std::vector<int32_t> beam_indices, std::vector<int32_t> next_tokens) {
+  gsl::span<int32_t> beam_indices_span(beam_indices);
+  gsl::span<int32_t> next_tokens_span(next_tokens);
+  sequences.AppendNextTokenToSequences(beam_indices_span, next_tokens_span);
+}
+
+}  // namespace
+
+TEST(BeamSearchSequencesTest, ReorderWithoutReadingEachStep) {
+  constexpr int batch_beam_size = 3;
+  constexpr int max_length = 6;
+  std::vector<int32_t> buffer(2 * batch_beam_size * max_length, -1);
+  for (int i = 0; i < batch_beam_size; i++) {
+    buffer[i * max_length] = 10 + i;  // prompt of length 1
+  }
+
+  Sequences sequences;
+  sequences.Init(buffer, batch_beam_size, 1, max_length);
+
+  Append(sequences, {2, 0, 0}, {1, 2, 3});
+  Append(sequences, {1, 1, 2}, {4, 5, 6});
+
+  ASSERT_EQ(sequences.GetSequenceLength(), 3);
+  EXPECT_EQ(GetSequence(sequences, 0), (std::vector<int32_t>{10, 2, 4}));
+  EXPECT_EQ(GetSequence(sequences, 1), (std::vector<int32_t>{10, 2, 5}));
+  EXPECT_EQ(GetSequence(sequences, 2), (std::vector<int32_t>{10, 3, 6}));
+
+  // Appending after the sequences were read continues from the materialized sequences.
+  Append(sequences, {2, 0, 1}, {7, 8, 9});
+  EXPECT_EQ(GetSequence(sequences, 0), (std::vector<int32_t>{10, 3, 6, 7}));
+  EXPECT_EQ(GetSequence(sequences, 1), (std::vector<int32_t>{10, 2, 4, 8}));
+  EXPECT_EQ(GetSequence(sequences, 2), (std::vector<int32_t>{10, 2, 5, 9}));
+}
+
+TEST(BeamSearchSequencesTest, KeepBeamsInPlace) {
+  constexpr int batch_beam_size = 2;
+  constexpr int max_length = 4;
+  std::vector<int32_t> buffer(2 * batch_beam_size * max_length, -1);
+  buffer[0] = 10;
+  buffer[max_length] = 11;
+
+  Sequences sequences;
+  sequences.Init(buffer, batch_beam_size, 1, max_length);
+
+  // The beams swap twice, so each sequence descends from its own prompt.
+  Append(sequences, {1, 0}, {1, 2});
+  Append(sequences, {1, 0}, {3, 4});
+
+  EXPECT_EQ(GetSequence(sequences, 0), (std::vector<int32_t>{10, 2, 3}));
+  EXPECT_EQ(GetSequence(sequences, 1), (std::vector<int32_t>{11, 1, 4}));
+  EXPECT_EQ(sequences.GetSequence(0).data(), buffer.data());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -9,6 +9,7 @@
 #include "test/util/include/scoped_env_vars.h"
 #include "contrib_ops/cpu/bert/attention_common.h"
 #include "test/contrib_ops/attention_op_test_helper.h"
+#include <cmath>
 #include <limits>
 
 namespace onnxruntime {
@@ -923,5 +924,77 @@ TEST(DecoderMaskedSelfAttentionTest, Test_fp16) {
 
 #endif
 
+// Cross attention with key and value of shape (batch_size, num_heads, kv_sequence_length, head_size), shared by the
+// beams of each batch instead of expanded to (batch_size * beam_width, ...).
+TEST(DecoderMaskedMultiHeadAttentionTest, CrossAttentionSharedKVAcrossBeams) {
+  constexpr int batch_size = 2;
+  constexpr int beam_width = 3;
+  constexpr int num_heads = 2;
+  constexpr int head_size = 4;
+  constexpr int kv_sequence_length = 5;
+  constexpr int hidden_size = num_heads * head_size;
+  constexpr int batch_beam_size = batch_size * beam_width;
+
+  std::vector<float> query(batch_beam_size * hidden_size);
+  for (size_t i = 0; i < query.size(); ++i) {
+    query[i] = static_cast<float>((i * 7) % 11) * 0.1f - 0.5f;
+  }
+
+  std::vector<float> key(batch_size * num_heads * kv_sequence_length * head_size);
+  std::vector<float> value(key.size());
+  for (size_t i = 0; i < key.size(); ++i) {
+    key[i] = static_cast<float>((i * 5) % 13) * 0.1f - 0.6f;
+    value[i] = static_cast<float>((i * 3) % 7) * 0.2f - 0.6f;
+  }
+
+  // Expected output: softmax(Q x K^T / sqrt(head_size)) x V, with the key and value of the batch of each beam
+  std::vector<float> output(batch_beam_size * hidden_size, 0.0f);
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (int b = 0; b < batch_beam_size; ++b) {
+    for (int n = 0; n < num_heads; ++n) {
+      const float* q = query.data() + b * hidden_size + n * head_size;
+      const size_t kv_offset = (static_cast<size_t>(b / beam_width) * num_heads + n) * kv_sequence_length * head_size;
+      float scores[kv_sequence_length];
+      float sum = 0.0f;
+      for (int j = 0; j < kv_sequence_length; ++j) {
+        float dot = 0.0f;
+        for (int h = 0; h < head_size; ++h) {
+          dot += q[h] * key[kv_offset + j * head_size + h];
+        }
+        scores[j] = std::exp(dot * scale);
+        sum += scores[j];
+      }
+      for (int j = 0; j < kv_sequence_length; ++j) {
+        for (int h = 0; h < head_size; ++h) {
+          output[b * hidden_size + n * head_size + h] += scores[j] / sum * value[kv_offset + j * head_size + h];
+        }
+      }
+    }
+  }
+
+  OpTester tester("DecoderMaskedMultiHeadAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(num_heads));
+  tester.AddAttribute<int64_t>("past_present_share_buffer", static_cast<int64_t>(1));
+
+  tester.AddInput<float>("query", {batch_beam_size, 1, hidden_size}, query);
+  tester.AddInput<float>("key", {batch_size, num_heads, kv_sequence_length, head_size}, key);
+  tester.AddInput<float>("value", {batch_size, num_heads, kv_sequence_length, head_size}, value);
+  tester.AddOptionalInputEdge<int32_t>();  // mask_index
+  tester.AddOptionalInputEdge<float>();    // attention_bias
+  tester.AddOptionalInputEdge<float>();    // past_key
+  tester.AddOptionalInputEdge<float>();    // past_value
+  tester.AddOptionalInputEdge<int32_t>();  // past_sequence_length
+  tester.AddInput<int32_t>("beam_width", {1}, {beam_width});
+  tester.AddInput<int32_t>("cache_indirection", {batch_size, beam_width, 1},
+                           std::vector<int32_t>(batch_beam_size, 0));
+
+  tester.AddOutput<float>("output", {batch_beam_size, 1, hidden_size}, output);
+  tester.SetOutputTolerance(0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
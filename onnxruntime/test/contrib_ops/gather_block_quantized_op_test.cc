@@ -58,7 +58,7 @@ void RunGatherBlockQuantized(const std::vector<T1>& data,
 template <typename T1, typename T2>
 typename std::enable_if<
     (boost::mp11::mp_contains<TypeList<BFloat16, MLFloat16, float>, T1>::value && std::is_same<T2, float>::value) ||
-        (std::is_integral<T1>::value && std::is_same<T2, int>::value),
+        (std::is_integral<T1>::value && !std::is_same<T1, uint8_t>::value && std::is_same<T2, int>::value),
     std::vector<T1>>::type
 ToType(const std::vector<T2>& vec) {
   std::vector<T1> result;
@@ -85,6 +85,18 @@ ToType(const std::vector<int>& vec) {
   return result;
 }
 
+// uint8_t data is offset by 128 like the 4-bit unsigned type is offset by 8, so the tests use the same signed values
+template <typename T>
+typename std::enable_if<std::is_same<T, uint8_t>::value, std::vector<T>>::type
+ToType(const std::vector<int>& vec) {
+  std::vector<T> result;
+  for (auto v : vec) {
+    result.push_back(static_cast<T>(v + 128));
+  }
+
+  return result;
+}
+
 template <typename T1, typename T2, typename Tind>
 void Test_Fail_WithZeroPoints(int64_t gather_axis,
                               int64_t quantize_axis,
@@ -122,8 +134,6 @@ void Test_Fail_WithZeroPoints(int64_t gather_axis,
 }
 
 TEST(GatherBlockQuantizedOpTest, UnsupportedTypes) {
-  Test_Fail_WithZeroPoints<int8_t, float, int32_t>(0, 2, 16);
-  Test_Fail_WithZeroPoints<uint8_t, float, int32_t>(0, 2, 16);
   Test_Fail_WithZeroPoints<int16_t, float, int32_t>(0, 2, 16);
   Test_Fail_WithZeroPoints<uint16_t, float, int32_t>(0, 2, 16);
   Test_Fail_WithZeroPoints<int32_t, float, int32_t>(0, 2, 16);
@@ -287,6 +297,9 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis0WithZeroPoints) {
   Test_GatherAxis0_WithZeroPoints<Int4x2, float, int64_t>();
   Test_GatherAxis0_WithZeroPoints<UInt4x2, MLFloat16, int64_t>();
   Test_GatherAxis0_WithZeroPoints<Int4x2, MLFloat16, int64_t>();
+  Test_GatherAxis0_WithZeroPoints<uint8_t, float, int32_t>();
+  Test_GatherAxis0_WithZeroPoints<int8_t, float, int64_t>();
+  Test_GatherAxis0_WithZeroPoints<uint8_t, MLFloat16, int64_t>();
 }
 
 template <typename T1, typename T2, typename Tind>
@@ -401,6 +414,9 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis1) {
   Test_GatherAxis1_WithZeroPoints<Int4x2, float, int64_t>();
   Test_GatherAxis1_WithZeroPoints<UInt4x2, MLFloat16, int64_t>();
   Test_GatherAxis1_WithZeroPoints<Int4x2, MLFloat16, int64_t>();
+  Test_GatherAxis1_WithZeroPoints<uint8_t, float, int32_t>();
+  Test_GatherAxis1_WithZeroPoints<int8_t, float, int64_t>();
+  Test_GatherAxis1_WithZeroPoints<uint8_t, MLFloat16, int64_t>();
 }
 
 template <typename T1, typename T2, typename Tind>
@@ -462,6 +478,51 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis2) {
   Test_GatherAxis2_WithZeroPoints<Int4x2, float, int64_t>();
   Test_GatherAxis2_WithZeroPoints<UInt4x2, MLFloat16, int64_t>();
   Test_GatherAxis2_WithZeroPoints<Int4x2, MLFloat16, int64_t>();
+  Test_GatherAxis2_WithZeroPoints<uint8_t, float, int32_t>();
+  Test_GatherAxis2_WithZeroPoints<int8_t, float, int64_t>();
+  Test_GatherAxis2_WithZeroPoints<uint8_t, MLFloat16, int64_t>();
+}
+
+template <typename T1, typename T2, typename Tind>
+void Test_GatherAxis0_RowwiseScales() {
+  // embedding table with one scale per row: the block is larger than the row
+  constexpr int64_t rows = 5, cols = 40;
+  std::vector<int> data(rows * cols);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int>(i % 15) - 7;
+  }
+  std::vector<int> indices = {3, 0, -1, 3};
+  std::vector<float> scales = {0.5f, 1.0f, 2.0f, 0.25f, 4.0f};
+  std::vector<int> zero_points = {1, -2, 0, 3, -1};
+
+  std::vector<float> output;
+  for (int idx : indices) {
+    const int64_t row = idx < 0 ? idx + rows : idx;
+    for (int64_t c = 0; c < cols; ++c) {
+      output.push_back(static_cast<float>(data[row * cols + c] - zero_points[row]) * scales[row]);
+    }
+  }
+
+  RunGatherBlockQuantized(ToType<T1>(data),
+                          {rows, cols},
+                          ToType<Tind>(indices),
+                          {2, 2},
+                          ToType<T2>(scales),
+                          {rows, 1},
+                          ToType<T1>(zero_points),
+                          0,
+                          1,
+                          64,
+                          ToType<T2>(output),
+                          {2, 2, cols},
+                          OpTester::ExpectResult::kExpectSuccess);
+}
+
+TEST(GatherBlockQuantizedOpTest, GatherAxis0RowwiseScales) {
+  Test_GatherAxis0_RowwiseScales<UInt4x2, float, int32_t>();
+  Test_GatherAxis0_RowwiseScales<Int4x2, MLFloat16, int64_t>();
+  Test_GatherAxis0_RowwiseScales<uint8_t, float, int64_t>();
+  Test_GatherAxis0_RowwiseScales<int8_t, MLFloat16, int32_t>();
 }
 
 }  // namespace test
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test/common/cuda_op_test_utils.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+#if defined(USE_CUDA)
+namespace {
+
+struct PreprocessConfig {
+  int64_t batch_size = 2;
+  int64_t input_height = 5;
+  int64_t input_width = 7;
+  int64_t channels = 3;
+  int64_t output_height = 4;
+  int64_t output_width = 9;
+  bool linear = true;
+  bool reverse_channels = false;
+  bool channels_last = false;
+  float scale = 1.0f / 255.0f;
+  std::vector<float> mean = {0.485f, 0.456f, 0.406f};
+  std::vector<float> std = {0.229f, 0.224f, 0.225f};
+};
+
+std::vector<float> Reference(const PreprocessConfig& config, const std::vector<uint8_t>& input) {
+  const int64_t H = config.input_height, W = config.input_width, C = config.channels;
+  const int64_t OH = config.output_height, OW = config.output_width;
+  const float height_scale = static_cast<float>(H) / OH;
+  const float width_scale = static_cast<float>(W) / OW;
+  std::vector<float> output(config.batch_size * OH * OW * C);
+  for (int64_t n = 0; n < config.batch_size; n++) {
+    const uint8_t* image = input.data() + n * H * W * C;
+    for (int64_t y = 0; y < OH; y++) {
+      for (int64_t x = 0; x < OW; x++) {
+        for (int64_t c = 0; c < C; c++) {
+          const int64_t src = config.reverse_channels ? C - 1 - c : c;
+          auto pixel = [&](int64_t iy, int64_t ix) { return static_cast<float>(image[(iy * W + ix) * C + src]); };
+          float value;
+          if (config.linear) {
+            const float in_y = std::max((y + 0.5f) * height_scale - 0.5f, 0.0f);
+            const float in_x = std::max((x + 0.5f) * width_scale - 0.5f, 0.0f);
+            const int64_t y0 = std::min<int64_t>(static_cast<int64_t>(in_y), H - 1);
+            const int64_t x0 = std::min<int64_t>(static_cast<int64_t>(in_x), W - 1);
+            const int64_t y1 = std::min(y0 + 1, H - 1);
+            const int64_t x1 = std::min(x0 + 1, W - 1);
+            const float dy = in_y - y0, dx = in_x - x0;
+            const float top = pixel(y0, x0) + (pixel(y0, x1) - pixel(y0, x0)) * dx;
+            const float bottom = pixel(y1, x0) + (pixel(y1, x1) - pixel(y1, x0)) * dx;
+            value = top + (bottom - top) * dy;
+          } else {
+            value = pixel(std::min<int64_t>(static_cast<int64_t>(y * height_scale), H - 1),
+                          std::min<int64_t>(static_cast<int64_t>(x * width_scale), W - 1));
+          }
+          const float result = (value * config.scale - config.mean[c]) / config.std[c];
+          const int64_t index = config.channels_last ? ((n * OH + y) * OW + x) * C + c
+                                                     : ((n * C + c) * OH + y) * OW + x;
+          output[index] = result;
+        }
+      }
+    }
+  }
+  return output;
+}
+
+void RunImagePreprocessTest(const PreprocessConfig& config, bool use_float16 = false) {
+  if (!HasCudaEnvironment(use_float16 ? 530 : 0)) {
+    return;
+  }
+
+  std::vector<int64_t> input_dims = {config.batch_size, config.input_height, config.input_width, config.channels};
+  std::vector<uint8_t> input(config.batch_size * config.input_height * config.input_width * config.channels);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<uint8_t>((i * 37 + 11) % 256);
+  }
+  std::vector<int64_t> output_dims =
+      config.channels_last
+          ? std::vector<int64_t>{config.batch_size, config.output_height, config.output_width, config.channels}
+          : std::vector<int64_t>{config.batch_size, config.channels, config.output_height, config.output_width};
+
+  OpTester tester("ImagePreprocess", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<std::vector<int64_t>>("size", {config.output_height, config.output_width});
+  tester.AddAttribute<std::string>("mode", config.linear ? "linear" : "nearest");
+  tester.AddAttribute<float>("scale", config.scale);
+  tester.AddAttribute<std::vector<float>>("mean", config.mean);
+  tester.AddAttribute<std::vector<float>>("std", config.std);
+  tester.AddAttribute<int64_t>("reverse_channels", config.reverse_channels ? 1 : 0);
+  tester.AddAttribute<int64_t>("channels_last", config.channels_last ? 1 : 0);
+  tester.AddInput<uint8_t>("input", input_dims, input);
+
+  const std::vector<float> expected = Reference(config, input);
+  if (use_float16) {
+    tester.AddAttribute<int64_t>("to", ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+    tester.AddOutput<MLFloat16>("output", output_dims, ToFloat16(expected));
+    tester.SetOutputTolerance(0.01f);
+  } else {
+    tester.AddOutput<float>("output", output_dims, expected);
+    tester.SetOutputTolerance(1e-4f);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+TEST(ImagePreprocessTest, LinearToNCHW) {
+  PreprocessConfig config;
+  RunImagePreprocessTest(config);
+}
+
+TEST(ImagePreprocessTest, LinearDownsampleToNHWC_Float16) {
+  PreprocessConfig config;
+  config.input_height = 16;
+  config.input_width = 12;
+  config.output_height = 5;
+  config.output_width = 3;
+  config.channels_last = true;
+  RunImagePreprocessTest(config, true);
+}
+
+TEST(ImagePreprocessTest, NearestReverseChannels) {
+  PreprocessConfig config;
+  config.linear = false;
+  config.reverse_channels = true;
+  RunImagePreprocessTest(config);
+}
+
+#endif  // USE_CUDA
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -260,6 +260,86 @@ void RunTest(const TestOptions& opts,
   test.RunWithConfig();
 }
 
+// Each value of a block of 2b or 3b B occupies `bits` bits of the little-endian bit stream of the block.
+int GetPackedValue(const uint8_t* data, int64_t bits, int64_t index) {
+  const int64_t bit_offset = index * bits;
+  uint32_t value = data[bit_offset / 8];
+  if (bit_offset % 8 + bits > 8) {
+    value |= static_cast<uint32_t>(data[bit_offset / 8 + 1]) << 8;
+  }
+  return static_cast<int>((value >> (bit_offset % 8)) & ((1u << bits) - 1));
+}
+
+void RunLowBitTest(int64_t bits, int64_t M, int64_t N, int64_t K, int64_t block_size, int64_t accuracy_level,
+                   bool has_zero_point, bool has_g_idx) {
+  SCOPED_TRACE(::testing::Message() << "bits:" << bits << ", M:" << M << ", N:" << N << ", K:" << K
+                                    << ", block_size:" << block_size << ", accuracy_level:" << accuracy_level
+                                    << ", has_zero_point:" << has_zero_point << ", has_g_idx:" << has_g_idx);
+
+  const int64_t k_blocks = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size * bits / 8;
+  const int64_t zp_row_size = (k_blocks * bits + 7) / 8;
+
+  RandomValueGenerator random{1234};
+  std::vector<float> input0_vals(random.Gaussian<float>(AsSpan({M, K}), 0.0f, 0.25f));
+  std::vector<uint8_t> input1_vals(random.Uniform<uint8_t>(AsSpan({N, k_blocks, blob_size}), 0, 255));
+  std::vector<float> scales(random.Uniform(AsSpan({N, k_blocks}), 0.01f, 0.1f));
+  std::vector<uint8_t> zp(random.Uniform<uint8_t>(AsSpan({N, zp_row_size}), 0, 255));
+
+  std::vector<float> expected_vals(M * N);
+  for (int64_t n = 0; n < N; n++) {
+    std::vector<float> b(K);
+    for (int64_t k = 0; k < K; k++) {
+      const int64_t block = k / block_size;
+      const int value = GetPackedValue(&input1_vals[(n * k_blocks + block) * blob_size], bits, k % block_size);
+      const int zero_point = has_zero_point ? GetPackedValue(&zp[n * zp_row_size], bits, block) : 1 << (bits - 1);
+      b[k] = (value - zero_point) * scales[n * k_blocks + block];
+    }
+    for (int64_t m = 0; m < M; m++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += input0_vals[m * K + k] * b[k];
+      }
+      expected_vals[m * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("accuracy_level", accuracy_level);
+
+  test.AddInput<float>("A", {M, K}, input0_vals, false);
+  test.AddInput<uint8_t>("B", {N, k_blocks, blob_size}, input1_vals, true);
+  test.AddInput<float>("scales", {N * k_blocks}, scales, true);
+  if (has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {N * zp_row_size}, zp, true);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+  if (has_g_idx) {
+    std::vector<int32_t> g_idx(k_blocks * block_size);
+    for (size_t i = 0; i < g_idx.size(); i++) {
+      g_idx[i] = narrow<int32_t>(static_cast<int64_t>(i) / block_size);
+    }
+    test.AddInput<int32_t>("g_idx", {static_cast<int64_t>(g_idx.size())}, g_idx, true);
+  } else {
+    test.AddOptionalInputEdge<int32_t>();
+  }
+  test.AddOptionalInputEdge<float>();
+
+  test.AddOutput<float>("Y", {M, N}, expected_vals);
+  test.SetOutputAbsErr("Y", 0.0001f);
+
+  // 2b and 3b are only supported by the CPU EP
+  std::vector<std::unique_ptr<IExecutionProvider>> explicit_eps;
+  explicit_eps.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(explicit_eps));
+  test.RunWithConfig();
+}
+
 }  // namespace
 
 template <typename AType, int M, int N, int K, int block_size, int accuracy_level>
@@ -387,6 +467,20 @@ TEST(MatMulNBits, Float32_Accuracy4) {
   TestMatMulNBitsTyped<float, 100, 288, 1234, 16, 4>();
 }
 
+TEST(MatMulNBits, Float32_LowBit) {
+  for (int64_t bits : {2, 3}) {
+    for (bool has_zero_point : {false, true}) {
+      RunLowBitTest(bits, 1, 1, 16, 16, 0, has_zero_point, false);
+      RunLowBitTest(bits, 1, 37, 93, 32, 0, has_zero_point, false);
+      RunLowBitTest(bits, 1, 288, 1234, 64, 4, has_zero_point, false);
+      RunLowBitTest(bits, 3, 21, 200, 128, 0, has_zero_point, false);
+      RunLowBitTest(bits, 100, 288, 1024, 16, 4, has_zero_point, false);
+      RunLowBitTest(bits, 100, 32, 93, 256, 0, has_zero_point, false);
+      RunLowBitTest(bits, 2, 32, 93, 32, 0, has_zero_point, true);
+    }
+  }
+}
+
 #ifdef MLAS_TARGET_AMD64_IX86
 #if !defined(USE_DML)
 // Actual and expected difference is over 0.01 with DmlExecutionProvider.
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
@@ -15,12 +16,15 @@ static void RunMoETest(const std::vector<float>& input, const std::vector<float>
                        const std::vector<float>& fc3_experts_weights, const std::vector<float>& fc1_experts_bias,
                        const std::vector<float>& fc2_experts_bias, const std::vector<float>& output_data, int num_rows,
                        int num_experts, int hidden_size, int inter_size, std::string activation_type,
-                       int normalize_routing_weights = 0, int top_k = 1, bool use_float16 = false) {
+                       int normalize_routing_weights = 0, int top_k = 1, bool use_float16 = false,
+                       int expert_cache_size = 0) {
   constexpr int min_cuda_arch = 700;
   constexpr int max_cuda_arch = 900;
 
   bool enable_cuda = HasCudaEnvironment(min_cuda_arch) && !NeedSkipIfCudaArchGreaterEqualThan(max_cuda_arch);
-  if (enable_cuda) {
+  // the CPU kernel only supports float
+  bool enable_cpu = !use_float16;
+  if (enable_cuda || enable_cpu) {
     OpTester tester("MoE", 1, onnxruntime::kMSDomain);
     tester.AddAttribute<int64_t>("k", static_cast<int64_t>(top_k));
     tester.AddAttribute<std::string>("activation_type", activation_type);
@@ -78,8 +82,22 @@ static void RunMoETest(const std::vector<float>& input, const std::vector<float>
     }
 
     std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
-    execution_providers.push_back(DefaultCudaExecutionProvider());
-    tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+    if (enable_cuda) {
+      execution_providers.push_back(DefaultCudaExecutionProvider());
+    }
+    if (enable_cpu) {
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+    }
+    if (expert_cache_size > 0) {
+      SessionOptions so;
+      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCudaMoEExpertCacheSize,
+                                                        std::to_string(expert_cache_size).c_str()));
+      tester.Config(so)
+          .ConfigEps(std::move(execution_providers))
+          .RunWithConfig();
+    } else {
+      tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+    }
   }
 }
 
@@ -628,6 +646,13 @@ TEST(MoETest, MoETest_Mixtral) {
   RunMoETest(input, router_probs, fc1_experts_weights, fc2_experts_weights, fc3_experts_weights, {}, {}, output,
              num_rows, num_experts, hidden_size, inter_size, "silu", 1, /*normalize_routing_weights*/
              2 /*top_k*/);
+
+#ifdef USE_CUDA_MOE_EXPERT_OFFLOAD
+  // a single device slot, so the experts are evicted and paged in again within every run
+  RunMoETest(input, router_probs, fc1_experts_weights, fc2_experts_weights, fc3_experts_weights, {}, {}, output,
+             num_rows, num_experts, hidden_size, inter_size, "silu", 1, /*normalize_routing_weights*/
+             2 /*top_k*/, false /*use_float16*/, 1 /*expert_cache_size*/);
+#endif
 }
 
 TEST(MoETest, QMoETest_Mixtral_Int4) {
@@ -623,5 +623,77 @@ TEST(MultiHeadAttentionTest, DISABLED_CrossAttention_WithPastPassedInDirectly_No
   RunMultiHeadAttentionTests(data);
 }
 
+// Compares the CPU kernel with a reference over several blocks of queries, with all the masks combined.
+TEST(MultiHeadAttentionTest, SelfAttention_Causal_KeyPaddingMask_AttnBias_CPU) {
+  constexpr int batch_size = 2, num_heads = 2, sequence_length = 129, head_size = 16;
+  constexpr int hidden_size = num_heads * head_size;
+  constexpr float mask_filter_value = -10000.0f;
+
+  RandomValueGenerator random{2024};
+  const std::vector<int64_t> qkv_dims{batch_size, sequence_length, hidden_size};
+  const std::vector<int64_t> attn_bias_dims{1, num_heads, sequence_length, sequence_length};
+  std::vector<float> query = random.Gaussian<float>(qkv_dims, 0.0f, 1.0f);
+  std::vector<float> key = random.Gaussian<float>(qkv_dims, 0.0f, 1.0f);
+  std::vector<float> value = random.Gaussian<float>(qkv_dims, 0.0f, 1.0f);
+  std::vector<float> attn_bias = random.Gaussian<float>(attn_bias_dims, 0.0f, 1.0f);
+  std::vector<int32_t> key_padding_mask(batch_size * sequence_length, 1);
+  for (int i = 100; i < sequence_length; i++) {
+    key_padding_mask[sequence_length + i] = 0;  // right side padding of the second batch
+  }
+
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  std::vector<float> output(batch_size * sequence_length * hidden_size);
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < num_heads; n++) {
+      for (int i = 0; i < sequence_length; i++) {
+        std::vector<double> probs(i + 1);
+        double max = std::numeric_limits<double>::lowest();
+        for (int j = 0; j <= i; j++) {
+          double qk = 0.0;
+          for (int h = 0; h < head_size; h++) {
+            qk += query[(b * sequence_length + i) * hidden_size + n * head_size + h] *
+                  key[(b * sequence_length + j) * hidden_size + n * head_size + h];
+          }
+          probs[j] = qk * scale + attn_bias[(n * sequence_length + i) * sequence_length + j] +
+                     (key_padding_mask[b * sequence_length + j] ? 0.0f : mask_filter_value);
+          max = std::max(max, probs[j]);
+        }
+        double sum = 0.0;
+        for (auto& p : probs) {
+          p = std::exp(p - max);
+          sum += p;
+        }
+        for (int h = 0; h < head_size; h++) {
+          double o = 0.0;
+          for (int j = 0; j <= i; j++) {
+            o += probs[j] * value[(b * sequence_length + j) * hidden_size + n * head_size + h];
+          }
+          output[(b * sequence_length + i) * hidden_size + n * head_size + h] = static_cast<float>(o / sum);
+        }
+      }
+    }
+  }
+
+  for (const char* disable_flash : {"0", "1"}) {
+    ScopedEnvironmentVariables scoped_env_vars{
+        EnvVarMap{{onnxruntime::contrib::attention::kDisableFlashAttention, disable_flash}}};
+    OpTester tester("MultiHeadAttention", 1, onnxruntime::kMSDomain);
+    tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(num_heads));
+    tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(1));
+    tester.AddAttribute<float>("mask_filter_value", mask_filter_value);
+    tester.AddInput<float>("query", qkv_dims, query);
+    tester.AddInput<float>("key", qkv_dims, key);
+    tester.AddInput<float>("value", qkv_dims, value);
+    tester.AddOptionalInputEdge<float>();
+    tester.AddInput<int32_t>("key_padding_mask", {batch_size, sequence_length}, key_padding_mask);
+    tester.AddInput<float>("attention_bias", attn_bias_dims, attn_bias);
+    tester.AddOutput<float>("output", qkv_dims, output, false, 0.0001f, 0.0001f);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
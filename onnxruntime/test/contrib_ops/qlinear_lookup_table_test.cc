@@ -121,6 +121,50 @@ TEST(QLinearLookupTableBasedOperatorTests, QLinearSigmoid_UInt8_0_Y_ZP) {
   run_test(true);
 }
 
+TEST(QLinearLookupTableBasedOperatorTests, QLinearUnary_Tanh_UInt8) {
+  OpTester test("QLinearUnary", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("op_type", "Tanh");
+  float X_scale = 0.025f;
+  uint8_t X_zero_point = 128;
+  float Y_scale = 1.0f / 128.0f;
+  uint8_t Y_zero_point = 128;
+
+  // more than 16 elements to cover the remainder of a vectorized lookup
+  std::vector<int64_t> dims = {20};
+  test.AddInput<uint8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, 128, 129,
+                                     136, 137, 138, 160, 200, 216, 217, 218, 250, 255});
+  test.AddInput<float>("X_scale", {}, {X_scale}, true);
+  test.AddInput<uint8_t>("X_zero_point", {}, {X_zero_point}, true);
+  test.AddInput<float>("Y_scale", {}, {Y_scale}, true);
+  test.AddInput<uint8_t>("Y_zero_point", {}, {Y_zero_point}, true);
+  test.AddOutput<uint8_t>("Y", dims, {0, 1, 1, 1, 1, 33, 35, 125, 128, 131,
+                                      153, 156, 159, 213, 249, 253, 253, 253, 255, 255});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
+TEST(QLinearLookupTableBasedOperatorTests, QLinearUnary_Abs_Int8) {
+  OpTester test("QLinearUnary", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("op_type", "Abs");
+  float scale = 0.05f;
+  int8_t zero_point = -3;
+
+  std::vector<int64_t> dims = {10};
+  // the scales and zero points are not constant, so the table is built in Compute
+  test.AddInput<int8_t>("X", dims, {-128, -100, -64, -1, 0, 1, 5, 64, 100, 127});
+  test.AddInput<float>("X_scale", {}, {scale});
+  test.AddInput<int8_t>("X_zero_point", {}, {zero_point});
+  test.AddInput<float>("Y_scale", {}, {scale});
+  test.AddInput<int8_t>("Y_zero_point", {}, {zero_point});
+  test.AddOutput<int8_t>("Y", dims, {122, 94, 58, -1, 0, 1, 5, 64, 100, 127});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
 /*
 \brief data is generated by pytorch script
 \details model defines
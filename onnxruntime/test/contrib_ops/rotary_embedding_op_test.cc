@@ -74,7 +74,7 @@ static void RunTest(
   if (enable_dml && !disable_dml) {
     execution_providers.push_back(DefaultDmlExecutionProvider());
   }
-  if (tensor_type == TensorType::kFloat && !disable_cpu) {
+  if ((tensor_type == TensorType::kFloat || tensor_type == TensorType::kFloat16) && !disable_cpu) {
     execution_providers.push_back(DefaultCpuExecutionProvider());
   }
   if (execution_providers.size() == 0) {
@@ -174,8 +174,27 @@ static void RunTests(const std::vector<float>& input_data,
           false, /* disable_cuda */
           false /* disable_dml */);
 
-  // FP16 test for CUDA and DML
   if (use_float16) {
+    // FP16 test for CPU
+    RunTest(input_data,
+            position_ids,
+            cos_cache,
+            sin_cache,
+            output_data,
+            batch_size,
+            sequence_length,
+            head_size,
+            rotary_embedding_dim,
+            num_heads,
+            max_sequence_length,
+            interleaved,
+            is_packed_batching,
+            TensorType::kFloat16,
+            false, /* disable_cpu */
+            true,  /* disable_cuda*/
+            true /* disable_dml */);
+
+    // FP16 test for CUDA and DML
     RunTest(input_data,
             position_ids,
             cos_cache,
@@ -861,5 +861,61 @@ TEST(SkipLayerNormTest, SkipLayerNormBatch2_Skip_Broadcast_Batch_Size_1) {
 }
 #endif
 
+
+// The CPU kernel converts MLFloat16 rows to float per thread, and the parameters once per run, or at PrePack
+// time when they are initializers. The skip tensor covers all the rows so each row must use its own skip values.
+TEST(SkipLayerNormTest, SkipLayerNormBatch2_Bias_Float16_Cpu) {
+  const std::vector<int64_t> input_dims = {2, 2, 4};
+  const std::vector<int64_t> param_dims = {4};
+
+  const std::vector<float> input_data = {
+      0.7f, -0.4f, -0.2f, 1.2f,
+      0.4f, 0.3f, 0.1f, -0.4f,
+      0.7f, -0.4f, -0.2f, 1.2f,
+      0.4f, 0.3f, 0.1f, -0.4f};
+
+  const std::vector<float> skip_data = {
+      0.1f, -0.2f, 0.3f, 1.0f,
+      0.5f, 0.1f, 0.4f, 1.6f,
+      1.8f, -0.3f, 0.0f, 1.f,
+      -0.5f, 0.4f, 0.8f, -0.6f};
+
+  const std::vector<float> gamma_data = {0.3f, 0.2f, 4.0f, 2.2f};
+  const std::vector<float> beta_data = {0.2f, 0.1f, 0.4f, 1.6f};
+  const std::vector<float> bias_data = {0.1f, -0.1f, 0.2f, -0.2f};
+
+  const std::vector<float> output_data = {
+      0.28433859348297119f, -0.17090578377246857f, -0.92897164821624756f, 4.6924152374267578f,
+      0.46111652255058289f, -0.21333980560302734f, -0.29631003737449646f, 3.5148544311523438f,
+      0.55470430850982666f, -0.15080101788043976f, -2.3229825496673584f, 3.255286693572998f,
+      0.15631480515003204f, 0.21066918969154358f, 4.9432611465454102f, -1.7957965135574341f};
+
+  std::vector<float> sum_output_data(input_data.size());
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    sum_output_data[i] = input_data[i] + skip_data[i] + bias_data[i % bias_data.size()];
+  }
+
+  for (bool constant_parameters : {false, true}) {
+    OpTester test("SkipLayerNormalization", 1, onnxruntime::kMSDomain);
+    test.AddInput<MLFloat16>("input", input_dims, ToFloat16(input_data));
+    test.AddInput<MLFloat16>("skip", input_dims, ToFloat16(skip_data), constant_parameters);
+    test.AddInput<MLFloat16>("gamma", param_dims, ToFloat16(gamma_data), constant_parameters);
+    test.AddInput<MLFloat16>("beta", param_dims, ToFloat16(beta_data), constant_parameters);
+    test.AddInput<MLFloat16>("bias", param_dims, ToFloat16(bias_data), constant_parameters);
+    test.AddAttribute("epsilon", epsilon_);
+    test.AddOutput<MLFloat16>("output", input_dims, ToFloat16(output_data));
+    test.SetOutputAbsErr("output", 0.01f);
+    // The second and third outputs are reserved for something else
+    test.AddOptionalOutputEdge<MLFloat16>();
+    test.AddOptionalOutputEdge<MLFloat16>();
+    test.AddOutput<MLFloat16>("skip_input_bias_add_output", input_dims, ToFloat16(sum_output_data));
+    test.SetOutputAbsErr("skip_input_bias_add_output", 0.01f);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
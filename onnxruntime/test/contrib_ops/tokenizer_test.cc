@@ -814,6 +814,37 @@ TEST(ContribOpTest, TokenizerExpression_RegChar) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, TokenizerWithSeparators_ManyRowsOfDifferentLengthsNC) {
+  // Enough rows to be tokenized in several blocks, with the longest row in the middle
+  // [N][C] dimensions
+  // Output [N][C][D]
+  constexpr int64_t N = 16, C = 8;
+  constexpr size_t kMaxWords = 7;
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, true, {" "}, 1);
+
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (size_t r = 0; r < static_cast<size_t>(N * C); ++r) {
+    const size_t words = (r * 5 + 3) % (kMaxWords + 1);
+    std::string s;
+    output.push_back(start_mark);
+    for (size_t w = 0; w < words; ++w) {
+      const std::string word = "w" + std::to_string(r) + "_" + std::to_string(w);
+      s += (w == 0 ? "" : " ") + word;
+      output.push_back(word);
+    }
+    output.push_back(end_mark);
+    output.insert(output.end(), kMaxWords - words, padval);
+    input.push_back(s);
+  }
+
+  test.AddInput<std::string>("T", {N, C}, input);
+  test.AddOutput<std::string>("Y", {N, C, int64_t{kMaxWords + 2}}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, Tokenizer_EmptyInput) {
   // Special case of empty input.
   // For [C] empty input we should output [0]
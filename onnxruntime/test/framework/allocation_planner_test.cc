@@ -383,6 +383,7 @@ class PlannerTest : public ::testing::Test {
   const SequentialExecutionPlan& GetPlan() const { return *plan_; }
   const SessionState& GetState() const { return *state_; }
   ExecutionProviders& GetExecutionProviders() { return execution_providers_; }
+  void SetExecutionMode(ExecutionMode execution_mode) { sess_options_->execution_mode = execution_mode; }
   void SetNodePartitionConfigFilePath(const char* config_file_path) {
     ORT_THROW_IF_ERROR(sess_options_->config_options.AddConfigEntry(kNodePartitionConfigFile, config_file_path));
   }
@@ -745,6 +746,93 @@ TEST_F(PlannerTest, PlanOutputTest) {
   }
 }
 
+TEST_F(PlannerTest, DynamicScheduleForParallelExecution) {
+  std::string X("X"), A("A"), B("B"), C("C"), D("D");
+
+  // graph structure: X -> A, A -> B -> D and A -> C
+  AddNormalNode(X, A);
+  AddNormalNode(A, B);
+  AddNormalNode(A, C);
+  AddNormalNode(B, D);
+
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X, shape}, {A, shape}, {B, shape}, {C, shape}, {D, shape}});
+
+  SetExecutionMode(ExecutionMode::ORT_PARALLEL);
+  CreatePlan({}, false);
+
+  const auto* plan = GetState().GetExecutionPlan();
+  ASSERT_EQ(plan->execution_plan.size(), 1U);
+  const auto& steps = plan->execution_plan[0]->steps_;
+  const auto& schedule = plan->dynamic_schedule;
+  ASSERT_EQ(schedule.num_producers.size(), steps.size());
+  ASSERT_EQ(schedule.roots.size(), 1U);
+  const size_t root = schedule.roots[0];
+  EXPECT_EQ(schedule.num_producers[root], 0);
+  // A feeds B and C, which can run concurrently
+  ASSERT_EQ(schedule.consumers[root].size(), 2U);
+  for (auto consumer : schedule.consumers[root]) {
+    EXPECT_EQ(schedule.num_producers[consumer], 1);
+  }
+
+  // the last consumer of A isn't known statically, so both consumers hold a reference to it
+  int a_index;
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(A, a_index));
+  for (const auto& release_action : plan->release_actions) {
+    if (release_action.value_index == static_cast<size_t>(a_index)) {
+      EXPECT_EQ(release_action.ref_count, 2U);
+    }
+  }
+}
+
+TEST_F(PlannerTest, NoDynamicScheduleForSequentialExecution) {
+  std::string X("X"), A("A"), B("B"), C("C");
+
+  AddNormalNode(X, A);
+  AddNormalNode(A, B);
+  AddNormalNode(A, C);
+
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X, shape}, {A, shape}, {B, shape}, {C, shape}});
+
+  CreatePlan({}, false);
+
+  EXPECT_TRUE(GetState().GetExecutionPlan()->dynamic_schedule.Empty());
+}
+
+TEST_F(PlannerTest, FlatKernelLaunchesAndReleaseLists) {
+  std::string X("X"), A("A"), B("B"), C("C"), D("D");
+
+  AddNormalNode(X, A);
+  AddNormalNode(A, B);
+  AddNormalNode(A, C);
+  AddNormalNode(C, D);
+
+  Shape shape1{50, 100};
+  auto shape = &shape1.value;
+  SetShape({{X, shape}, {A, shape}, {B, shape}, {C, shape}, {D, shape}});
+
+  CreatePlan();
+
+  const auto& plan = GetPlan();
+  ASSERT_EQ(plan.execution_plan.size(), 1U);
+  const auto& steps = plan.execution_plan[0]->steps_;
+  ASSERT_EQ(plan.kernel_launch_nodes.size(), steps.size());
+  for (size_t i = 0; i < steps.size(); ++i) {
+    EXPECT_EQ(plan.kernel_launch_nodes[i], steps[i]->GetNodeIndex());
+  }
+
+  ASSERT_EQ(plan.node_release_offsets.size(), plan.node_release_list.size() + 1);
+  EXPECT_EQ(plan.node_release_offsets.back(), plan.node_release_actions.size());
+  for (size_t i = 0; i < plan.node_release_list.size(); ++i) {
+    std::vector<size_t> flat(plan.node_release_actions.begin() + plan.node_release_offsets[i],
+                             plan.node_release_actions.begin() + plan.node_release_offsets[i + 1]);
+    EXPECT_EQ(flat, plan.node_release_list[i]) << "Release list incorrect for node " << i;
+  }
+}
+
 #ifdef USE_CUDA
 TEST_F(PlannerTest, LocationPlanningForPassThroughExplicitAndImplicitSubgraphInputs) {
   // Types
@@ -2129,5 +2217,47 @@ TEST(AllocationPlannerTest, AvoidReuseOfBufferForNodeOutputWithNoConsumers) {
 }
 #endif
 
+// SequenceConstruct may hold its input in the output sequence without copying it, so the buffer of the input must
+// not be updated in place by its last consumer.
+TEST(AllocationPlannerTest, NoInplaceReuseOfTensorHeldBySequence) {
+  onnxruntime::Model model("sequence_input", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  TypeProto sequence_type;
+  *sequence_type.mutable_sequence_type()->mutable_elem_type() = tensor_type;
+
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_type);
+  auto& a = graph.GetOrCreateNodeArg("a", &tensor_type);
+  auto& b = graph.GetOrCreateNodeArg("b", &tensor_type);
+  auto& c = graph.GetOrCreateNodeArg("c", &tensor_type);
+  auto& s = graph.GetOrCreateNodeArg("s", &sequence_type);
+  graph.AddNode("relu0", "Relu", "a", {&x}, {&a});
+  graph.AddNode("construct", "SequenceConstruct", "s holds a", {&a}, {&s});
+  graph.AddNode("relu1", "Relu", "may be in place", {&a}, {&b});
+  graph.AddNode("neg", "Neg", "c", {&b}, {&c});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions sess_opt;
+  sess_opt.graph_optimization_level = TransformerLevel::Default;
+  InferenceSession sess(sess_opt, GetEnvironment());
+  ASSERT_STATUS_OK(sess.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(sess.Initialize());
+
+  const auto& session_state = sess.GetSessionState();
+  const SequentialExecutionPlan* plan = session_state.GetExecutionPlan();
+  OrtValueIndex b_index;
+  ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("b", b_index));
+  EXPECT_EQ(plan->allocation_plan[b_index].alloc_kind, AllocKind::kAllocate);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 #include <absl/base/config.h>
 
 #include "core/framework/allocator.h"
+#include "core/framework/huge_page_allocator.h"
+#include "core/mlas/inc/mlas.h"
 
 #include "test_utils.h"
 #include "gtest/gtest.h"
@@ -32,6 +34,24 @@ TEST(AllocatorTest, CPUAllocatorTest) {
   cpu_arena->Free(bytes);
   // todo: test the used / max api.
 }
+TEST(AllocatorTest, HugePageCPUAllocatorTest) {
+  HugePageCPUAllocator allocator;
+  ASSERT_STREQ(allocator.Info().name, CPU);
+
+  // the small allocations use the default allocation, the large ones huge pages if they are available
+  for (size_t size : {size_t{1024}, HugePageCPUAllocator::kMinHugePageAllocationSize, size_t{5} * 1024 * 1024 + 3}) {
+    auto* bytes = static_cast<uint8_t*>(allocator.Alloc(size));
+    ASSERT_NE(bytes, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(bytes) % MlasGetPreferredBufferAlignment(), 0u);
+    memset(bytes, 0x5A, size);
+    EXPECT_EQ(bytes[0], 0x5A);
+    EXPECT_EQ(bytes[size - 1], 0x5A);
+    allocator.Free(bytes);
+  }
+
+  allocator.Free(nullptr);
+}
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26400)
 #endif
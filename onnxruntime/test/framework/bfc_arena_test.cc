@@ -7,6 +7,7 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -307,6 +308,39 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TestShrinkToWatermark) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+  void* p1m = a.Alloc(1024 * 1024);
+  void* p2m = a.Alloc(2 * 1024 * 1024);
+  void* p4m = a.Alloc(4 * 1024 * 1024);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 3);
+  a.Free(p1m);
+  a.Free(p2m);
+  a.Free(p4m);
+
+  // Only the most recently added region (4M) needs to be released to get below a 5M watermark
+  EXPECT_EQ(a.ShrinkToWatermark(5 * 1024 * 1024), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 2);
+  EXPECT_EQ(stats.num_arena_shrinkages, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, 3 * 1024 * 1024);
+
+  // Nothing to do if the arena is already below the watermark
+  EXPECT_EQ(a.ShrinkToWatermark(3 * 1024 * 1024), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_shrinkages, 1);
+
+  // Regions in use are skipped
+  void* p = a.Alloc(2 * 1024 * 1024);
+  EXPECT_EQ(a.ShrinkToWatermark(1), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_shrinkages, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, 2 * 1024 * 1024);
+  a.Free(p);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
@@ -481,5 +515,121 @@ TEST(BFCArenaTest, TestExtendStrategy) {
   ASSERT_EQ(extend_delta_bytes, extend_limit);
 }
 
+TEST(BFCArenaTest, SmallBlockCache) {
+  constexpr int64_t cache_bytes = 2 * SmallBlockCache::kPageSize;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             cache_bytes);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, cache_bytes);
+
+  // small allocations are served by the cache without extending the arena
+  void* p100 = a.Alloc(100);
+  void* p4k = a.Alloc(4096);
+  ASSERT_NE(p100, nullptr);
+  ASSERT_NE(p4k, nullptr);
+  EXPECT_EQ(a.AllocatedSize(p100), 256u);
+  EXPECT_EQ(a.AllocatedSize(p4k), 4096u);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 0);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.bytes_in_use, 256 + 4096);
+
+  // larger allocations use the arena
+  void* p8k = a.Alloc(8192);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+
+  // freed blocks are reused
+  a.Free(p100);
+  EXPECT_EQ(a.Alloc(200), p100);
+
+  a.Free(p100);
+  a.Free(p4k);
+  a.Free(p8k);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, SmallBlockCacheFallsBackWhenExhausted) {
+  // a single page can hold 16 blocks of 4KB
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             SmallBlockCache::kPageSize);
+
+  std::vector<void*> ptrs;
+  for (size_t i = 0; i < SmallBlockCache::kPageSize / 4096; ++i) {
+    ptrs.push_back(a.Alloc(4096));
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 0);
+
+  // the cache has no pages left so this comes from the arena, as does any other size class
+  ptrs.push_back(a.Alloc(4096));
+  ptrs.push_back(a.Alloc(256));
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+
+  std::sort(ptrs.begin(), ptrs.end());
+  EXPECT_EQ(std::adjacent_find(ptrs.begin(), ptrs.end()), ptrs.end());
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, SmallBlockCacheConcurrentAllocFree) {
+  OrtArenaCfg config(0, -1, -1, -1, -1, -1L, 16 * SmallBlockCache::kPageSize);
+  AllocatorCreationInfo device_info{
+      [](OrtDevice::DeviceId) { return std::make_unique<CPUAllocator>(); },
+      0, true, config};
+  auto allocator = CreateAllocator(device_info);
+  BFCArena& a = *static_cast<BFCArena*>(allocator.get());
+
+  constexpr int num_threads = 8;
+  constexpr int num_iterations = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&a, t]() {
+      std::vector<void*> ptrs;
+      for (int i = 0; i < num_iterations; ++i) {
+        size_t size = static_cast<size_t>((i * 37 + t * 101) % 4096) + 1;
+        auto* p = static_cast<uint8_t*>(a.Alloc(size));
+        // write a thread specific pattern so overlapping blocks would be detected below
+        p[0] = static_cast<uint8_t>(t);
+        p[size - 1] = static_cast<uint8_t>(t);
+        ptrs.push_back(p);
+        if (i % 3 == 2) {
+          for (void* q : ptrs) {
+            EXPECT_EQ(*static_cast<uint8_t*>(q), static_cast<uint8_t>(t));
+            a.Free(q);
+          }
+          ptrs.clear();
+        }
+      }
+      for (void* q : ptrs) {
+        a.Free(q);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.num_allocs, num_threads * num_iterations);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
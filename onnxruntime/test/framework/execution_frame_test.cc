@@ -8,6 +8,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -458,6 +459,238 @@ TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
 }
 #endif
 
+TEST_F(ExecutionFrameTest, FramePoolTest) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           std::unordered_map<std::string, int>{{"", 10}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Clip", "Clip operator", ArgMap{&input_def}, ArgMap{&output_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+
+  KernelRegistryManager kernel_registry_manager;
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_typ, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigExecutionFramePoolSize, "1"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm, edlm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map = state.GetOrtValueNameIdxMap();
+  int x_idx = -1, y_idx = -1;
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("X", x_idx).IsOK());
+  ASSERT_TRUE(mlvalue_name_idx_map.GetIdx("Y", y_idx).IsOK());
+
+  auto cpu_allocator = execution_providers.Get(xp_typ)->CreatePreferredAllocators()[0];
+  OrtValue x_value1, x_value2, x_value3;
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{3, 2}, std::vector<float>(6, 1.0f), &x_value1);
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{3, 2}, std::vector<float>(6, 2.0f), &x_value2);
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{2, 2}, std::vector<float>(4, 3.0f), &x_value3);
+
+  const std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  auto acquire_frame = [&](const OrtValue& feed) {
+    return state.AcquireExecutionFrame(AsSpan({x_idx}), AsSpan({feed}), AsSpan({y_idx}), {}, fetch_allocators
+#ifdef ORT_ENABLE_STREAM
+                                       ,
+                                       nullptr
+#endif
+    );
+  };
+
+  // the first run with the shapes generates their memory patterns, so its frame isn't pooled
+  ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(AsSpan({x_value1}), MemoryPatternGroup()));
+
+  auto frame = acquire_frame(x_value1);
+  ASSERT_FALSE(frame->HasMemoryPatternPlanner());
+  ASSERT_TRUE(frame->IsReusable());
+  const ExecutionFrame* pooled_frame = frame.get();
+  state.RecycleExecutionFrame(std::move(frame));
+
+  // a run with the same shapes reuses the frame, with the values of the run
+  frame = acquire_frame(x_value2);
+  ASSERT_EQ(frame.get(), pooled_frame);
+  const OrtValue* p_ml_value = frame->GetNodeInputOrOutputMLValue(0);
+  ASSERT_TRUE(p_ml_value);
+  ASSERT_EQ(p_ml_value->Get<Tensor>().Data<float>(), x_value2.Get<Tensor>().Data<float>());
+
+  // other shapes need another frame, since the pooled one is in use or has a different memory pattern
+  auto other_frame = acquire_frame(x_value3);
+  ASSERT_NE(other_frame.get(), pooled_frame);
+  state.RecycleExecutionFrame(std::move(frame));
+  other_frame = acquire_frame(x_value3);
+  ASSERT_NE(other_frame.get(), pooled_frame);
+}
+
+TEST_F(ExecutionFrameTest, MemPatternDimBucketsTest) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           std::unordered_map<std::string, int>{{"", 10}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Clip", "Clip operator", ArgMap{&input_def}, ArgMap{&output_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+
+  KernelRegistryManager kernel_registry_manager;
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_typ, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternDimBuckets, "8,4"));
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternCacheSize, "1"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm, edlm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+  ASSERT_TRUE(state.HasMemoryPatternDimBuckets());
+
+  int x_idx = -1;
+  ASSERT_TRUE(state.GetOrtValueNameIdxMap().GetIdx("X", x_idx).IsOK());
+
+  auto cpu_allocator = execution_providers.Get(xp_typ)->CreatePreferredAllocators()[0];
+  auto create_input = [&](std::vector<int64_t> dims) {
+    OrtValue value;
+    const auto size = static_cast<size_t>(TensorShape(dims).Size());
+    CreateMLValue<float>(cpu_allocator, dims, std::vector<float>(size, 1.0f), &value);
+    return value;
+  };
+  auto get_patterns = [&](const OrtValue& feed) {
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+    return state.GetMemoryPatternGroup(AsSpan({feed}), AsSpan({x_idx}), inferred_shapes);
+  };
+
+  // {3, 2} and {4, 1} are both in bucket {4, 4}
+  const OrtValue x_3_2 = create_input({3, 2});
+  ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(AsSpan({x_3_2}), MemoryPatternGroup()));
+  const auto patterns_3_2 = get_patterns(x_3_2);
+  ASSERT_NE(patterns_3_2, nullptr);
+  ASSERT_EQ(get_patterns(create_input({4, 1})), patterns_3_2);
+
+  // larger inputs of the bucket generate patterns that replace those of the smaller inputs
+  const OrtValue x_4_2 = create_input({4, 2});
+  ASSERT_EQ(get_patterns(x_4_2), nullptr);
+  ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(AsSpan({x_4_2}), MemoryPatternGroup()));
+  const auto patterns_4_2 = get_patterns(x_3_2);
+  ASSERT_NE(patterns_4_2, nullptr);
+  ASSERT_NE(patterns_4_2, patterns_3_2);
+  ASSERT_EQ(get_patterns(x_4_2), patterns_4_2);
+
+  // the patterns of another bucket evict the least recently used ones
+  const OrtValue x_8_8 = create_input({8, 8});
+  ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(AsSpan({x_8_8}), MemoryPatternGroup()));
+  ASSERT_NE(get_patterns(create_input({5, 6})), nullptr);
+  ASSERT_EQ(get_patterns(x_3_2), nullptr);
+}
+
+TEST_F(ExecutionFrameTest, SymbolicMemoryPlannerTest) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           std::unordered_map<std::string, int>{{"", 10}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* shape = tensor_float.mutable_tensor_type()->mutable_shape();
+  shape->add_dim()->set_dim_param("batch");
+  shape->add_dim()->set_dim_value(4);
+  onnxruntime::NodeArg input_def("X", &tensor_float), intermediate_def("T", &tensor_float),
+      output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Relu", "Relu operator", ArgMap{&input_def}, ArgMap{&intermediate_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  graph.AddNode("node2", "Relu", "Relu operator", ArgMap{&intermediate_def}, ArgMap{&output_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+
+  KernelRegistryManager kernel_registry_manager;
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_typ, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigSymbolicMemoryPlanning, "1"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm, edlm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+  ASSERT_TRUE(state.NeedsMemoryPatternTrace());
+
+  int x_idx = -1, t_idx = -1;
+  ASSERT_TRUE(state.GetOrtValueNameIdxMap().GetIdx("X", x_idx).IsOK());
+  ASSERT_TRUE(state.GetOrtValueNameIdxMap().GetIdx("T", t_idx).IsOK());
+
+  auto cpu_allocator = execution_providers.Get(xp_typ)->CreatePreferredAllocators()[0];
+  auto create_input = [&](std::vector<int64_t> dims) {
+    OrtValue value;
+    const auto size = static_cast<size_t>(TensorShape(dims).Size());
+    CreateMLValue<float>(cpu_allocator, dims, std::vector<float>(size, 1.0f), &value);
+    return value;
+  };
+  auto storage_size = [](int64_t batch) {
+    size_t size = 0;
+    ORT_THROW_IF_ERROR(Tensor::CalculateTensorStorageSize(DataTypeImpl::GetType<float>(), TensorShape({batch, 4}),
+                                                          kAllocAlignment, size));
+    return size;
+  };
+
+  // the allocations of a run with a batch of 3
+  const OrtValue x_3 = create_input({3, 4});
+  const std::vector<SymbolicMemoryPlanner::TraceEvent> trace{{t_idx, storage_size(3), false}, {t_idx, 0, true}};
+  state.UpdateSymbolicMemoryPlanner(AsSpan({x_idx}), AsSpan({x_3}), trace);
+  ASSERT_FALSE(state.NeedsMemoryPatternTrace());
+
+  // the patterns of a batch of 7 are planned without running it
+  std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+  const OrtValue x_7 = create_input({7, 4});
+  const auto patterns = state.GetMemoryPatternGroup(AsSpan({x_7}), AsSpan({x_idx}), inferred_shapes);
+  ASSERT_NE(patterns, nullptr);
+  ASSERT_EQ(patterns->patterns.size(), 1u);
+  const auto* block = patterns->patterns[0].GetBlock(t_idx);
+  ASSERT_NE(block, nullptr);
+  ASSERT_EQ(block->size_, storage_size(7));
+}
+
 TEST(ExecutionFrameTestWithoutSessionState, BadModelInvalidDimParamUsage) {
   // Model that has 2 inputs with shape {'Symbolic', 'Symbolic'} that is carefully constructed to re-use a
   // buffer the size of one input for output the size of the other input.
@@ -6,10 +6,12 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <filesystem>
 #include <functional>
 #include <iterator>
 #include <thread>
 #include <fstream>
+#include <sstream>
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include "core/common/denormal.h"
@@ -43,6 +45,7 @@
 #include "core/providers/rocm/gpu_data_transfer.h"
 #endif
 #include "core/session/environment.h"
+#include "core/session/graph_capture_shape_buckets.h"
 #include "core/session/IOBinding.h"
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -434,6 +437,75 @@ TEST(InferenceSessionTests, DisableCPUArena) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, GraphCaptureShapeBucketsConfig) {
+  std::unique_ptr<GraphCaptureShapeBuckets> buckets;
+  ASSERT_STATUS_OK(GraphCaptureShapeBuckets::Parse("1:64,32,128", buckets));
+  ASSERT_NE(buckets, nullptr);
+
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(GraphCaptureShapeBuckets::Parse("32,64", buckets), "of the form");
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(GraphCaptureShapeBuckets::Parse("0:32,0", buckets), "bucket size");
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(GraphCaptureShapeBuckets::Parse("0:", buckets), "No graph capture");
+
+  // buckets are ignored by a session that doesn't capture a graph
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigGraphCaptureShapeBuckets, "0:4,8"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  RunModel(session_object, RunOptions());
+}
+
+TEST(InferenceSessionTests, StreamingState) {
+  // mul_1.onnx computes Y = X * X, so feeding Y back into X squares the state on every run
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigStreamingState, "Y:X"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::vector<int64_t> dims = {3, 2};
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims,
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &x);
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+
+  // the state has to be fed in the first run
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session_object.Run(RunOptions(), NameMLValMap{}, output_names, &fetches),
+                                      "needs to be fed");
+
+  ASSERT_STATUS_OK(session_object.Run(RunOptions(), NameMLValMap{{"X", x}}, output_names, &fetches));
+  VerifyOutputs(fetches, dims, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+
+  // X is the Y of the previous run
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(RunOptions(), NameMLValMap{}, output_names, &fetches));
+  VerifyOutputs(fetches, dims, {1.0f, 16.0f, 81.0f, 256.0f, 625.0f, 1296.0f});
+
+  // the state is kept when the output isn't fetched
+  fetches.clear();
+  ASSERT_STATUS_OK(session_object.Run(RunOptions(), NameMLValMap{{"X", x}}, std::vector<std::string>{}, &fetches));
+  ASSERT_TRUE(fetches.empty());
+  ASSERT_STATUS_OK(session_object.Run(RunOptions(), NameMLValMap{}, output_names, &fetches));
+  VerifyOutputs(fetches, dims, {1.0f, 16.0f, 81.0f, 256.0f, 625.0f, 1296.0f});
+
+  RunOptions reset_run_options;
+  ASSERT_STATUS_OK(reset_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigResetStreamingState, "1"));
+  fetches.clear();
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session_object.Run(reset_run_options, NameMLValMap{}, output_names, &fetches),
+                                      "needs to be fed");
+}
+
+TEST(InferenceSessionTests, StreamingStateConfig) {
+  for (const char* config : {"Y", "Y:Z", "Z:X", "Y:X;Y:X"}) {
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigStreamingState, config));
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_FALSE(session_object.Initialize().IsOK()) << config;
+  }
+}
+
 TEST(InferenceSessionTests, TestModelSerialization) {
   // Load model with level 0 transform level
   // and assert that the model has Identity nodes.
@@ -496,6 +568,120 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, TestOptimizedModelCache) {
+  const std::filesystem::path cache_dir = "optimized_model_cache_test";
+  std::filesystem::remove_all(cache_dir);
+
+  const string test_model = "testdata/transform/abs-id-max.onnx";
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestOptimizedModelCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheDir,
+                                                    cache_dir.string().c_str()));
+
+  auto count_cached_models = [&cache_dir]() {
+    int count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+      count += entry.path().extension() == ".onnx" ? 1 : 0;
+    }
+    return count;
+  };
+
+  // the first session optimizes the model and adds it to the cache
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(test_model));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+  ASSERT_EQ(count_cached_models(), 1);
+
+  // the second session loads the optimized model from the cache
+  InferenceSessionWrapper cached_session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(cached_session_object.Load(test_model));
+  ASSERT_STATUS_OK(cached_session_object.Initialize());
+  ASSERT_EQ(CountOpsInGraph(cached_session_object.GetGraph())["Identity"], 0);
+  ASSERT_EQ(cached_session_object.GetGraph().ModelPath().parent_path(), cache_dir);
+  ASSERT_EQ(count_cached_models(), 1);
+
+  // a different optimization level is a different entry
+  so.graph_optimization_level = TransformerLevel::Level2;
+  InferenceSessionWrapper level2_session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(level2_session_object.Load(test_model));
+  ASSERT_STATUS_OK(level2_session_object.Initialize());
+  ASSERT_NE(level2_session_object.GetGraph().ModelPath().parent_path(), cache_dir);
+  ASSERT_EQ(count_cached_models(), 2);
+
+  std::filesystem::remove_all(cache_dir);
+}
+
+TEST(InferenceSessionTests, TestLazyLoadExternalInitializers) {
+  // mnist with its weights in an external data file
+  const std::filesystem::path model_path = "lazy_load_external_initializers_test.onnx";
+  const std::filesystem::path data_path = "lazy_load_external_initializers_test.onnx.data";
+  {
+    std::shared_ptr<Model> model;
+    ASSERT_STATUS_OK(Model::Load(ORT_TSTR("testdata/mnist.onnx"), model, nullptr,
+                                 DefaultLoggingManager().DefaultLogger()));
+    ASSERT_STATUS_OK(Model::SaveWithExternalInitializers(*model, model_path, data_path, 100));
+  }
+
+  OrtValue input;
+  std::vector<float> input_data(28 * 28);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = static_cast<float>(i % 7) * 0.1f;
+  }
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 1, 28, 28}, input_data,
+                       &input);
+  NameMLValMap feeds{{"Input3", input}};
+  const std::vector<std::string> output_names{"Plus214_Output_0"};
+
+  auto count_unloaded_initializers = [](const InferenceSessionWrapper& session) {
+    size_t count = 0;
+    for (const auto& [idx, value] : session.GetSessionState().GetInitializedTensors()) {
+      count += value.Get<Tensor>().DataRaw() == nullptr ? 1 : 0;
+    }
+    return count;
+  };
+
+  auto run = [&](bool lazy, std::vector<OrtValue>& fetches) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.TestLazyLoadExternalInitializers";
+    // keep the initializers in the external data file
+    so.graph_optimization_level = TransformerLevel::Default;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsLazyLoadExternalInitializers,
+                                                      lazy ? "1" : "0"));
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_path.native()));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    if (lazy) {
+      ASSERT_GT(count_unloaded_initializers(session_object), 0u);
+    } else {
+      ASSERT_EQ(count_unloaded_initializers(session_object), 0u);
+    }
+
+    RunOptions run_options;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+    ASSERT_EQ(count_unloaded_initializers(session_object), 0u);
+  };
+
+  std::vector<OrtValue> eager_fetches;
+  run(false, eager_fetches);
+  std::vector<OrtValue> lazy_fetches;
+  run(true, lazy_fetches);
+
+  ASSERT_EQ(eager_fetches.size(), 1u);
+  ASSERT_EQ(lazy_fetches.size(), 1u);
+  const auto eager_output = eager_fetches[0].Get<Tensor>().DataAsSpan<float>();
+  const auto lazy_output = lazy_fetches[0].Get<Tensor>().DataAsSpan<float>();
+  ASSERT_EQ(eager_output.size(), lazy_output.size());
+  for (size_t i = 0; i < eager_output.size(); ++i) {
+    EXPECT_FLOAT_EQ(eager_output[i], lazy_output[i]);
+  }
+
+  std::filesystem::remove(model_path);
+  std::filesystem::remove(data_path);
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -626,6 +812,28 @@ TEST(InferenceSessionTests, CheckRunLogger) {
 
 // WebAssembly will emit profiling data into console
 #if !defined(__wasm__)
+#ifdef USE_CUDA
+TEST(InferenceSessionTests, CostBasedPartitioningMovesSmallNodeToCpu) {
+  SessionOptions so;
+  so.session_logid = "CostBasedPartitioningMovesSmallNodeToCpu";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCostBasedPartitioning, "1"));
+
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(DefaultCudaExecutionProvider()));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the Mul of the model is tiny and its input and output are in host memory, so copying them costs more than
+  // running it on CPU
+  for (const auto& node : session_object.GetGraph().Nodes()) {
+    EXPECT_EQ(node.GetExecutionProviderType(), kCpuExecutionProvider);
+  }
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+}
+#endif
+
 TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
   SessionOptions so;
 
@@ -680,6 +888,31 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
 #endif
 }
 
+TEST(InferenceSessionTests, CheckProfilerRecordsInitializationPhases) {
+  SessionOptions so;
+
+  so.session_logid = "CheckProfilerRecordsInitializationPhases";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_init_phases_test");
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::stringstream contents;
+  contents << profile.rdbuf();
+  const std::string profile_contents = contents.str();
+
+  for (const char* phase : {"model_proto_parse_us", "graph_transform_", "graph_partition_CPUExecutionProvider",
+                            "graph_resolve", "initializer_copy", "kernel_creation", "prepacking",
+                            "session_initialization"}) {
+    EXPECT_NE(profile_contents.find(phase), std::string::npos) << phase;
+  }
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions2) {
   SessionOptions so;
 
@@ -779,6 +1012,42 @@ TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
     count++;
   }
 }
+
+TEST(InferenceSessionTests, CheckRunProfilerTimelineFormat) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerTimelineFormat";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfilingTraceFormat, "timeline"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  session_object.StartProfiling("onnxruntime_profile_timeline");
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  std::stringstream content;
+  content << profile.rdbuf();
+  const std::string trace = content.str();
+  EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+  EXPECT_NE(trace.find(R"("name":"process_name","ph":"M")"), std::string::npos);
+
+  const auto node_event = trace.find(R"("name":"mul_1_kernel_time")");
+  ASSERT_NE(node_event, std::string::npos);
+  EXPECT_NE(trace.find("\"correlation_id\" : ", node_event), std::string::npos);
+  EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+#if !defined(ORT_NO_EXCEPTIONS)
+TEST(InferenceSessionTests, InvalidProfilingTraceFormat) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfilingTraceFormat, "perfetto"));
+  ASSERT_THROW(std::make_unique<InferenceSession>(so, GetEnvironment()), OnnxRuntimeException);
+}
+#endif
 #endif  // __wasm__
 
 TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
@@ -806,6 +1075,73 @@ TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
   ASSERT_TRUE(before_start_time <= profiling_start_time && profiling_start_time <= after_start_time);
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(InferenceSessionTests, MemoryTraceFile) {
+  const std::string trace_file = "memory_trace_test.json";
+  std::remove(trace_file.c_str());
+
+  {
+    SessionOptions so;
+    so.session_logid = "MemoryTraceFile";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMemoryTraceFile, trace_file.c_str()));
+
+    InferenceSession session_object(so, GetEnvironment());
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    RunOptions run_options;
+    RunModel(session_object, run_options);
+    RunModel(session_object, run_options);
+  }
+
+  // the trace is written when the session is destroyed
+  std::ifstream file(trace_file);
+  ASSERT_TRUE(file);
+  std::stringstream content;
+  content << file.rdbuf();
+  const std::string trace = content.str();
+  EXPECT_NE(trace.find("\"traceEvents\":["), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"live_bytes\""), std::string::npos);
+
+  // the output of the Mul node is the only tensor allocated by the run, so it is live at the peak
+  const auto peak = trace.find("\"peakMemory\":[");
+  ASSERT_NE(peak, std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"Y\",", peak), std::string::npos);
+  EXPECT_NE(trace.find("\"op_type\":\"Mul\"", peak), std::string::npos);
+
+  file.close();
+  std::remove(trace_file.c_str());
+}
+#endif
+
+TEST(InferenceSessionTests, NodeLatencyStats) {
+  SessionOptions so;
+  so.session_logid = "NodeLatencyStats";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsNodeLatencySamplingInterval, "2"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  for (int i = 0; i < 4; i++) {
+    RunModel(session_object, run_options);
+  }
+
+  // the stats are recorded without the event profiler
+  ASSERT_FALSE(session_object.GetProfiling().IsEnabled());
+  const auto summaries = session_object.GetProfiling().GetNodeLatencyStats().Summarize();
+  ASSERT_EQ(summaries.size(), 1u);
+  EXPECT_EQ(summaries[0].op_type, "Mul");
+  EXPECT_EQ(summaries[0].provider, kCpuExecutionProvider);
+  EXPECT_EQ(summaries[0].count, 2u);
+  EXPECT_LE(summaries[0].p50_ns, summaries[0].p99_ns);
+
+  const std::string json = session_object.GetProfiling().GetNodeLatencyStats().ToJson();
+  EXPECT_NE(json.find("\"op_type\":\"Mul\""), std::string::npos);
+  EXPECT_NE(json.find("\"count\":2"), std::string::npos);
+}
+
 TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
   SessionOptions session_options;
 
@@ -1148,6 +1484,76 @@ TEST(InferenceSessionTests, TestBindCudaPreallocateOutputOnCpu2) {
                  kCpuExecutionProvider);
 }
 
+#ifdef USE_CUDA
+TEST(InferenceSessionTests, TestCudaPinnedStagingForHostCopies) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestCudaPinnedStagingForHostCopies";
+
+  OrtCUDAProviderOptionsV2 cuda_options;
+  cuda_options.use_pinned_staging_for_host_copies = 1;
+  auto provider = CudaExecutionProviderWithOptions(&cuda_options);
+  ASSERT_NE(provider, nullptr);
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(std::move(provider)));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the staging buffers of a run are reused by the next ones
+  RunOptions run_options;
+  for (int i = 0; i < 3; ++i) {
+    RunModel(session_object, run_options);
+  }
+}
+
+TEST(InferenceSessionTests, TestCudaMempoolAllocator) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestCudaMempoolAllocator";
+
+  OrtCUDAProviderOptionsV2 cuda_options;
+  cuda_options.use_cuda_mempool = 1;
+  cuda_options.cuda_mempool_release_threshold = 1024 * 1024;
+  auto provider = CudaExecutionProviderWithOptions(&cuda_options);
+  ASSERT_NE(provider, nullptr);
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(std::move(provider)));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the memory freed on the stream of a run is reused by the next ones
+  RunOptions run_options;
+  for (int i = 0; i < 3; ++i) {
+    RunModel(session_object, run_options);
+  }
+}
+
+TEST(InferenceSessionTests, TestCudaCopyStreamForFeeds) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestCudaCopyStreamForFeeds";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseCopyStreamForFeeds, "1"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(DefaultCudaExecutionProvider()));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // concurrent runs take different stream collections, each with its own copy stream
+  RunOptions run_options;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&session_object, &run_options]() {
+      for (int j = 0; j < 5; ++j) {
+        RunModel(session_object, run_options);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+#endif
+
 TEST(InferenceSessionTests, TestBindCudaSpecifyOutputDeviceOnCuda) {
   OrtDevice device(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, 0);
 
@@ -2836,6 +3242,68 @@ TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsUseUserAddedInitial
   }
 }
 
+TEST(InferenceSessionTests, InitializerSharing_ShareInitializersAcrossSessions) {
+  auto get_initializer_buffers = [](const InferenceSessionWrapper& session) {
+    std::set<const void*> buffers;
+    for (const auto& [idx, value] : session.GetSessionState().GetInitializedTensors()) {
+      if (value.Get<Tensor>().SizeInBytes() >= 1024) {
+        buffers.insert(value.Get<Tensor>().DataRaw());
+      }
+    }
+    return buffers;
+  };
+
+  auto count_shared = [](const std::set<const void*>& buffers, const std::set<const void*>& other_buffers) {
+    size_t count = 0;
+    for (const void* buffer : buffers) {
+      count += other_buffers.count(buffer);
+    }
+    return count;
+  };
+
+  auto create_session = [](TransformerLevel level, bool share) {
+    SessionOptions so;
+    so.graph_optimization_level = level;
+    EXPECT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShareInitializersAcrossSessions,
+                                                      share ? "1" : "0"));
+    auto session = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+    EXPECT_STATUS_OK(session->Load(ORT_TSTR("testdata/mnist.onnx")));
+    EXPECT_STATUS_OK(session->Initialize());
+    return session;
+  };
+
+  // sessions with different optimization levels share the initializers that are the same in both
+  auto sess1 = create_session(TransformerLevel::Default, true);
+  auto sess2 = create_session(TransformerLevel::Level2, true);
+  auto sess3 = create_session(TransformerLevel::Default, false);
+
+  const auto buffers1 = get_initializer_buffers(*sess1);
+  const auto buffers2 = get_initializer_buffers(*sess2);
+  const auto buffers3 = get_initializer_buffers(*sess3);
+  ASSERT_FALSE(buffers1.empty());
+  EXPECT_GT(count_shared(buffers1, buffers2), 0u);
+  EXPECT_EQ(count_shared(buffers1, buffers3), 0u);
+
+  // the shared initializers stay valid after the session that created them is released
+  sess1.reset();
+  std::vector<float> input_data(28 * 28, 0.5f);
+  OrtValue input;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 1, 28, 28}, input_data,
+                       &input);
+  NameMLValMap feeds{{"Input3", input}};
+  const std::vector<std::string> output_names{"Plus214_Output_0"};
+  std::vector<OrtValue> fetches2;
+  std::vector<OrtValue> fetches3;
+  ASSERT_STATUS_OK(sess2->Run(RunOptions{}, feeds, output_names, &fetches2));
+  ASSERT_STATUS_OK(sess3->Run(RunOptions{}, feeds, output_names, &fetches3));
+  const auto output2 = fetches2[0].Get<Tensor>().DataAsSpan<float>();
+  const auto output3 = fetches3[0].Get<Tensor>().DataAsSpan<float>();
+  ASSERT_EQ(output2.size(), output3.size());
+  for (size_t i = 0; i < output2.size(); ++i) {
+    EXPECT_NEAR(output2[i], output3[i], 1e-4f);
+  }
+}
+
 void RunModelWithDenormalAsZero(InferenceSession& session_object,
                                 const RunOptions& run_options,
                                 bool set_denormal_as_zero) {
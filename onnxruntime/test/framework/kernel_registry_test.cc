@@ -6,7 +6,10 @@
 #include <gtest/gtest.h>
 
 #include "asserts.h"
+#include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
+#include "test/test_environment.h"
 
 namespace onnxruntime::test {
 
@@ -101,4 +104,45 @@ TEST(KernelRegistryTests, two_versions4) {
   ASSERT_STATUS_NOT_OK(RegKernels(r, function_table, CreateFakeKernel));
 }
 
+// Lookups are cached per signature, and registering a kernel invalidates the cache
+TEST(KernelRegistryTests, cached_lookup) {
+  onnxruntime::Model model("elu", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 6}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ONNX_NAMESPACE::TypeProto double_type;
+  double_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_DOUBLE);
+  Node& float_node = graph.AddNode("elu_float", "Elu", "", {&graph.GetOrCreateNodeArg("x", &float_type)},
+                                   {&graph.GetOrCreateNodeArg("y", &float_type)});
+  Node& double_node = graph.AddNode("elu_double", "Elu", "", {&graph.GetOrCreateNodeArg("x_double", &double_type)},
+                                    {&graph.GetOrCreateNodeArg("y_double", &double_type)});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistry r;
+  ASSERT_STATUS_OK(r.Register(
+      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider),
+      CreateFakeKernel));
+
+  OpSchemaKernelTypeStrResolver resolver;
+  const KernelCreateInfo* float_info = nullptr;
+  ASSERT_STATUS_OK(r.TryFindKernel(float_node, kCpuExecutionProvider, resolver, &float_info));
+  ASSERT_NE(float_info, nullptr);
+  const KernelCreateInfo* cached_float_info = nullptr;
+  ASSERT_STATUS_OK(r.TryFindKernel(float_node, kCpuExecutionProvider, resolver, &cached_float_info));
+  EXPECT_EQ(cached_float_info, float_info);
+
+  const KernelCreateInfo* double_info = nullptr;
+  ASSERT_STATUS_NOT_OK(r.TryFindKernel(double_node, kCpuExecutionProvider, resolver, &double_info));
+
+  ASSERT_STATUS_OK(r.Register(
+      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider),
+      CreateFakeKernel));
+  ASSERT_STATUS_OK(r.TryFindKernel(double_node, kCpuExecutionProvider, resolver, &double_info));
+  ASSERT_NE(double_info, nullptr);
+  EXPECT_NE(double_info, float_info);
+  ASSERT_STATUS_OK(r.TryFindKernel(float_node, kCpuExecutionProvider, resolver, &cached_float_info));
+  EXPECT_EQ(cached_float_info, float_info);
+}
+
 }  // namespace onnxruntime::test
@@ -1,8 +1,12 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <filesystem>
+
 #include "core/framework/mem_pattern_planner.h"
+#include "core/framework/memory_pattern_cache.h"
 #include "gtest/gtest.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -35,5 +39,49 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
 }
+
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(MemPatternPlannerTest, MemoryPatternCacheRoundTrip) {
+  constexpr bool using_counters = false;
+  MemPatternPlanner planner{using_counters};
+  planner.TraceAllocation(0, 1024);
+  planner.TraceAllocation(1, 256);
+  planner.TraceFree(0);
+  planner.TraceAllocation(2, 512);
+
+  NodeHashMap<int64_t, MemoryPatternGroup> saved;
+  {
+    MemoryPatternGroup group;
+    group.locations.push_back(OrtDevice());
+    group.patterns.push_back(planner.GenerateMemPattern());
+    saved.emplace(42, std::move(group));
+  }
+
+  const PathString cache_file = ORT_TSTR("mem_pattern_cache_round_trip.json");
+  constexpr uint64_t fingerprint = 0x123456789abcdef0ull;
+  ASSERT_STATUS_OK(MemoryPatternCache::Save(cache_file, fingerprint, {{42, &saved.at(42)}}));
+
+  NodeHashMap<int64_t, MemoryPatternGroup> loaded;
+  ASSERT_STATUS_OK(MemoryPatternCache::Load(cache_file, fingerprint, loaded));
+  ASSERT_EQ(loaded.size(), 1u);
+  const auto* expected = saved.at(42).GetPatterns(OrtDevice());
+  const auto* actual = loaded.at(42).GetPatterns(OrtDevice());
+  ASSERT_NE(actual, nullptr);
+  EXPECT_EQ(actual->PeakSize(), expected->PeakSize());
+  for (int ml_value_idx : {0, 1, 2}) {
+    ASSERT_NE(actual->GetBlock(ml_value_idx), nullptr);
+    EXPECT_EQ(actual->GetBlock(ml_value_idx)->offset_, expected->GetBlock(ml_value_idx)->offset_);
+    EXPECT_EQ(actual->GetBlock(ml_value_idx)->size_, expected->GetBlock(ml_value_idx)->size_);
+  }
+
+  // a cache generated for another execution plan is rejected
+  NodeHashMap<int64_t, MemoryPatternGroup> rejected;
+  EXPECT_FALSE(MemoryPatternCache::Load(cache_file, fingerprint + 1, rejected).IsOK());
+  EXPECT_TRUE(rejected.empty());
+
+  std::filesystem::remove(cache_file);
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
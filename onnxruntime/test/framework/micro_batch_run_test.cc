@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/micro_batch_run.h"
+
+#include <sstream>
+
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+#include "asserts.h"
+#include "test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+// Y = X * S with free shapes, S is broadcast over the rows of X.
+static void LoadScaleModel(InferenceSession& session) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 7}};
+  Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+              {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& s = graph.GetOrCreateNodeArg("S", &tensor_float);
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("scale", "Mul", "Mul", {&x, &s}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  std::stringstream stream(serialized);
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+TEST(MicroBatchRunTest, ConcatenatesMicroBatchFetches) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadScaleModel(session);
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  constexpr int64_t kRows = 5;
+  std::vector<float> x_values(kRows * 3);
+  std::vector<float> expected(x_values.size());
+  const std::vector<float> s_values{1.f, 2.f, 3.f};
+  for (size_t i = 0; i < x_values.size(); ++i) {
+    x_values[i] = static_cast<float>(i);
+    expected[i] = x_values[i] * s_values[i % 3];
+  }
+
+  std::vector<OrtValue> feeds(2);
+  CreateMLValue<float>(allocator, {kRows, 3}, x_values, &feeds[0]);
+  // has no batch dimension, so every micro-batch gets all of it
+  CreateMLValue<float>(allocator, {3}, s_values, &feeds[1]);
+
+  for (const char* count : {"2", "3", "8"}) {
+    RunOptions run_options;
+    ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigMicroBatchCount, count));
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(run_options, AsSpan<std::string>({"X", "S"}), feeds, AsSpan<std::string>({"Y"}),
+                                 &fetches, nullptr));
+
+    ASSERT_EQ(fetches.size(), 1u);
+    const auto& y = fetches[0].Get<Tensor>();
+    ASSERT_EQ(y.Shape(), TensorShape({kRows, 3}));
+    EXPECT_EQ(std::vector<float>(y.Data<float>(), y.Data<float>() + expected.size()), expected);
+  }
+}
+
+TEST(MicroBatchRunTest, RejectsPreallocatedFetches) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadScaleModel(session);
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  std::vector<OrtValue> feeds(2);
+  CreateMLValue<float>(allocator, {2, 2}, {1.f, 2.f, 3.f, 4.f}, &feeds[0]);
+  CreateMLValue<float>(allocator, {2}, {1.f, 1.f}, &feeds[1]);
+  std::vector<OrtValue> fetches(1);
+  CreateMLValue<float>(allocator, {2, 2}, {0.f, 0.f, 0.f, 0.f}, &fetches[0]);
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigMicroBatchCount, "2"));
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session.Run(run_options, AsSpan<std::string>({"X", "S"}), feeds,
+                                                  AsSpan<std::string>({"Y"}), &fetches, nullptr),
+                                      "Pre-allocated fetches are not supported");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
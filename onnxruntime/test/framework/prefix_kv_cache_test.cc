@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/prefix_kv_cache.h"
+
+#include <numeric>
+#include <sstream>
+
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "asserts.h"
+#include "test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+// The cache only uses the allocators and data transfers of the session, so any model works.
+static void LoadIdentityModel(InferenceSession& session) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 7}};
+  Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+              {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("identity", "Identity", "Identity", {&x}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  std::stringstream stream(serialized);
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+// State of shape (1, num_heads, sequence_length, head_size) where each value is its index.
+static OrtValue CreateState(int64_t num_heads, int64_t sequence_length, int64_t head_size) {
+  std::vector<float> values(num_heads * sequence_length * head_size);
+  std::iota(values.begin(), values.end(), 0.f);
+  OrtValue state;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0],
+                       {1, num_heads, sequence_length, head_size}, values, &state);
+  return state;
+}
+
+TEST(PrefixKVCacheTest, LookupReturnsLongestCachedPrefix) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadIdentityModel(session);
+
+  PrefixKVCacheOptions options;
+  options.block_size = 4;
+  PrefixKVCache cache(options);
+
+  std::vector<int64_t> tokens(10);
+  std::iota(tokens.begin(), tokens.end(), int64_t{100});
+  const OrtValue state = CreateState(2, 10, 3);
+  ASSERT_STATUS_OK(cache.Insert(tokens, {&state, 1}));
+
+  // shares the first 9 tokens, of which 8 are whole blocks
+  std::vector<int64_t> prompt(tokens.begin(), tokens.begin() + 9);
+  prompt.push_back(7);
+  prompt.push_back(8);
+  std::vector<OrtValue> past;
+  size_t prefix_length = 0;
+  ASSERT_STATUS_OK(cache.Lookup(session, prompt, past, prefix_length));
+  ASSERT_EQ(prefix_length, 8u);
+  ASSERT_EQ(past.size(), 1u);
+
+  const auto& past_tensor = past[0].Get<Tensor>();
+  ASSERT_EQ(past_tensor.Shape(), TensorShape({1, 2, 8, 3}));
+  const float* data = past_tensor.Data<float>();
+  for (int64_t head = 0; head < 2; ++head) {
+    for (int64_t i = 0; i < 8 * 3; ++i) {
+      ASSERT_EQ(data[head * 8 * 3 + i], static_cast<float>(head * 10 * 3 + i));
+    }
+  }
+
+  // differs in the first block
+  prompt[1] = 0;
+  ASSERT_STATUS_OK(cache.Lookup(session, prompt, past, prefix_length));
+  EXPECT_EQ(prefix_length, 0u);
+  EXPECT_TRUE(past.empty());
+
+  // the last token is always left to run
+  std::vector<int64_t> first_block(tokens.begin(), tokens.begin() + 4);
+  ASSERT_STATUS_OK(cache.Lookup(session, first_block, past, prefix_length));
+  EXPECT_EQ(prefix_length, 0u);
+}
+
+TEST(PrefixKVCacheTest, EvictsLeastRecentlyUsed) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadIdentityModel(session);
+
+  const OrtValue state = CreateState(1, 4, 2);
+  PrefixKVCacheOptions options;
+  options.block_size = 2;
+  options.max_bytes = 2 * state.Get<Tensor>().SizeInBytes();
+  PrefixKVCache cache(options);
+
+  const std::vector<int64_t> a{1, 2, 3, 4};
+  const std::vector<int64_t> b{5, 6, 7, 8};
+  const std::vector<int64_t> c{9, 10, 11, 12};
+  ASSERT_STATUS_OK(cache.Insert(a, {&state, 1}));
+  ASSERT_STATUS_OK(cache.Insert(b, {&state, 1}));
+
+  std::vector<OrtValue> past;
+  size_t prefix_length = 0;
+  ASSERT_STATUS_OK(cache.Lookup(session, a, past, prefix_length));  // a is now the most recently used
+  ASSERT_EQ(prefix_length, 2u);
+
+  ASSERT_STATUS_OK(cache.Insert(c, {&state, 1}));
+  EXPECT_EQ(cache.SizeInBytes(), options.max_bytes);
+
+  ASSERT_STATUS_OK(cache.Lookup(session, b, past, prefix_length));
+  EXPECT_EQ(prefix_length, 0u);
+  ASSERT_STATUS_OK(cache.Lookup(session, a, past, prefix_length));
+  EXPECT_EQ(prefix_length, 2u);
+  ASSERT_STATUS_OK(cache.Lookup(session, c, past, prefix_length));
+  EXPECT_EQ(prefix_length, 2u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/request_batcher.h"
+
+#include <future>
+#include <sstream>
+#include <thread>
+
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "asserts.h"
+#include "test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+// Y = X * X with a free shape, so any number of rows can be run.
+static void LoadSquareModel(InferenceSession& session) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 7}};
+  Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+              {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("square", "Mul", "Mul", {&x, &x}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  std::stringstream stream(serialized);
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+TEST(RequestBatcherTest, SplitsBatchedFetchesToEachRequest) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadSquareModel(session);
+
+  RequestBatcherOptions options;
+  options.max_batch_size = 4;
+  options.max_queue_delay = std::chrono::milliseconds(50);
+  RequestBatcher batcher(session, options, {"X"}, {"Y"});
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  constexpr int kNumRequests = 6;
+  std::vector<std::future<void>> results;
+  for (int r = 0; r < kNumRequests; ++r) {
+    results.push_back(std::async(std::launch::async, [&batcher, &allocator, r]() {
+      // requests have 1 or 2 rows of 3 values
+      const int64_t rows = 1 + r % 2;
+      std::vector<float> values(rows * 3);
+      std::vector<float> expected(values.size());
+      for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<float>(r * 10 + i);
+        expected[i] = values[i] * values[i];
+      }
+
+      OrtValue feed;
+      CreateMLValue<float>(allocator, {rows, 3}, values, &feed);
+      std::vector<OrtValue> fetches;
+      ASSERT_STATUS_OK(batcher.Run({&feed, 1}, fetches));
+
+      ASSERT_EQ(fetches.size(), 1u);
+      const auto& y = fetches[0].Get<Tensor>();
+      ASSERT_EQ(y.Shape(), TensorShape({rows, 3}));
+      EXPECT_EQ(std::vector<float>(y.Data<float>(), y.Data<float>() + expected.size()), expected);
+    }));
+  }
+
+  for (auto& result : results) {
+    result.get();
+  }
+}
+
+TEST(RequestBatcherTest, RunAsyncInvokesCallback) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadSquareModel(session);
+
+  RequestBatcher batcher(session, RequestBatcherOptions{}, {"X"}, {"Y"});
+
+  OrtValue feed;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 2}, {2.f, 3.f}, &feed);
+  const OrtValue* feeds[] = {&feed};
+  OrtValue fetch;
+  OrtValue* fetches[] = {&fetch};
+
+  std::promise<size_t> num_outputs;
+  ASSERT_STATUS_OK(batcher.RunAsync(
+      feeds, fetches,
+      [](void* user_data, OrtValue**, size_t num_outputs, OrtStatusPtr status) {
+        EXPECT_EQ(status, nullptr);
+        static_cast<std::promise<size_t>*>(user_data)->set_value(num_outputs);
+      },
+      &num_outputs));
+
+  ASSERT_EQ(num_outputs.get_future().get(), 1u);
+  const auto& y = fetch.Get<Tensor>();
+  EXPECT_EQ(std::vector<float>(y.Data<float>(), y.Data<float>() + 2), (std::vector<float>{4.f, 9.f}));
+}
+
+TEST(RequestBatcherTest, RejectsFeedsWithoutBatchAxis) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadSquareModel(session);
+
+  RequestBatcherOptions options;
+  options.batch_axis = 2;
+  RequestBatcher batcher(session, options, {"X"}, {"Y"});
+
+  OrtValue feed;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 2}, {2.f, 3.f}, &feed);
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(batcher.Run({&feed, 1}, fetches), "has no batch axis");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
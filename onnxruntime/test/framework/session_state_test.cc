@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <filesystem>
 #include <iostream>
 #include <absl/base/config.h>
 
@@ -9,6 +10,7 @@
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/prepacked_weights_file.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/session_state.h"
 #include "core/graph/graph_utils.h"
@@ -1006,5 +1008,40 @@ INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                                          PrepackingTestParam{true, true}));
 #endif
 
+TEST(SessionStateTest, PrepackedWeightsFileRoundTrip) {
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+
+  PrePackedWeights weights;
+  for (size_t size : {size_t{100}, size_t{3}}) {
+    auto buffer = IAllocator::MakeUniquePtr<void>(cpu_allocator, size);
+    for (size_t i = 0; i < size; ++i) {
+      static_cast<uint8_t*>(buffer.get())[i] = static_cast<uint8_t>(i * 7 + size);
+    }
+    weights.buffers_.push_back(std::move(buffer));
+    weights.buffer_sizes_.push_back(size);
+  }
+
+  const PathString path = ORT_TSTR("prepacked_weights_file_round_trip.bin");
+  ASSERT_STATUS_OK(PrepackedWeightsFile::Save(path, {{"MatMul+1", &weights}}));
+
+  {
+    std::unique_ptr<PrepackedWeightsFile> file;
+    ASSERT_STATUS_OK(PrepackedWeightsFile::Load(Env::Default(), path, file));
+    ASSERT_EQ(file->GetNumberOfElements(), size_t{1});
+    ASSERT_EQ(file->GetWeight("Conv+1"), nullptr);
+
+    const PrePackedWeights* loaded = file->GetWeight("MatMul+1");
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(loaded->buffer_sizes_, weights.buffer_sizes_);
+    for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(loaded->buffers_[i].get()) % 64, 0u);
+      EXPECT_EQ(std::memcmp(loaded->buffers_[i].get(), weights.buffers_[i].get(), weights.buffer_sizes_[i]), 0);
+    }
+    EXPECT_EQ(loaded->GetHash(), weights.GetHash());
+  }
+
+  std::filesystem::remove(path);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
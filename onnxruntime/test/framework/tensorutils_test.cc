@@ -211,6 +211,73 @@ TEST(TensorProtoUtilsTest, UnpackTensorWithExternalData) {
   TestUnpackExternalTensor<bool>(TensorProto_DataType_BOOL, model_path);
 }
 
+namespace {
+// two chunks of 32 bytes, each {0, 1, 2, 3} repeated. the LZ4 block of a chunk has 4 literals, a match of 23 bytes
+// at offset 4 and 5 final literals.
+std::vector<uint8_t> CreateCompressedExternalData() {
+  const std::vector<uint8_t> chunk{0x4F, 0x00, 0x01, 0x02, 0x03, 0x04, 0x00, 0x04, 0x50, 0x03, 0x00, 0x01, 0x02, 0x03};
+  std::vector<uint8_t> data{2, 0, 0, 0, 32, 0, 0, 0, 14, 0, 0, 0, 14, 0, 0, 0};
+  data.insert(data.end(), chunk.begin(), chunk.end());
+  data.insert(data.end(), chunk.begin(), chunk.end());
+  return data;
+}
+
+void CreateTensorWithCompressedExternalData(const std::vector<uint8_t>& data, std::basic_string<ORTCHAR_T>& filename,
+                                            TensorProto& tensor_proto) {
+  FILE* fp;
+  CreateTestFile(fp, filename);
+  WriteDataToFile(fp, data);
+  ASSERT_EQ(0, fclose(fp));
+
+  auto add_entry = [&tensor_proto](const std::string& key, const std::string& value) {
+    onnx::StringStringEntryProto* entry = tensor_proto.mutable_external_data()->Add();
+    entry->set_key(key);
+    entry->set_value(value);
+  };
+  add_entry("location", ToUTF8String(filename));
+  add_entry("length", std::to_string(data.size()));
+  add_entry("compression", "lz4");
+  tensor_proto.mutable_dims()->Add(64);
+  tensor_proto.set_data_location(onnx::TensorProto_DataLocation_EXTERNAL);
+  tensor_proto.set_data_type(TensorProto_DataType_UINT8);
+}
+}  // namespace
+
+TEST(TensorProtoUtilsTest, UnpackTensorWithCompressedExternalData) {
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  TensorProto tensor_proto;
+  CreateTensorWithCompressedExternalData(CreateCompressedExternalData(), filename, tensor_proto);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+
+  std::vector<uint8_t> expected(64);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = static_cast<uint8_t>(i % 4);
+  }
+  UnpackAndValidate(tensor_proto, std::filesystem::path(), expected);
+
+  std::vector<uint8_t> unpacked;
+  ASSERT_STATUS_OK(utils::UnpackInitializerData(tensor_proto, std::filesystem::path(), unpacked));
+  EXPECT_EQ(unpacked, expected);
+}
+
+TEST(TensorProtoUtilsTest, UnpackTensorWithCorruptedCompressedExternalData) {
+  // a match offset beyond the start of the chunk
+  auto data = CreateCompressedExternalData();
+  data[16 + 5] = 0x05;
+
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  TensorProto tensor_proto;
+  CreateTensorWithCompressedExternalData(data, filename, tensor_proto);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+
+  std::vector<uint8_t> unpacked(64);
+  auto status = utils::UnpackTensor(tensor_proto, std::filesystem::path(), unpacked.data(), unpacked.size());
+  EXPECT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), ::testing::HasSubstr("corrupted"));
+}
+
 template <typename T>
 static NodeProto CreateConstantNode(const std::string& attrib_name, AttributeProto_AttributeType type,
                                     std::function<void(AttributeProto&)> add_data) {
@@ -27,6 +27,9 @@ using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+// number of times the type and shape inferencing function of CountInferences_Fake ran
+static int num_count_inferences_fake_inferences = 0;
+
 static bool RegisterCustomSchemas() {
   OPERATOR_SCHEMA(Variable_DFS)
       .SetDoc("Input variable.")
@@ -96,6 +99,17 @@ static bool RegisterCustomSchemas() {
       .Output(0, "output_1", "docstr for output_1.", "T")
       .TypeConstraint("T", {"tensor(int32)", "tensor(float)"}, "input/output types");
 
+  OPERATOR_SCHEMA(CountInferences_Fake)
+      .SetDoc("Identity that counts its type and shape inferencing.")
+      .Input(0, "input_1", "docstr for input_1.", "tensor(int32)")
+      .Output(0, "output_1", "docstr for output_1.", "tensor(int32)")
+      .Attr("tag", "docstr for tag.", AttributeProto::INT, static_cast<int64_t>(0))
+      .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+        ++num_count_inferences_fake_inferences;
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        propagateShapeFromInputToOutput(ctx, 0, 0);
+      });
+
   OPERATOR_SCHEMA(ShapeInferenceThrowsOp)
       .SetDoc("Throw shape inference error.")
       .Input(0, "input_1", "docstr for input_1.", "tensor(int32)")
@@ -1507,6 +1521,54 @@ TEST_F(GraphTest, ShapeInferenceErrorHandling) {
                                       "Node (node_1) Op (ShapeInferenceThrowsOp) [ShapeInferenceError] try harder");
 }
 
+TEST_F(GraphTest, ResolveOnlyInfersChangedNodes) {
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_int32;
+  tensor_int32.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  tensor_int32.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("input", &tensor_int32);
+  auto& arg_1 = graph.GetOrCreateNodeArg("arg_1", nullptr);
+  auto& arg_2 = graph.GetOrCreateNodeArg("arg_2", nullptr);
+  graph.AddNode("node_1", "CountInferences_Fake", "node 1", {&input_arg}, {&arg_1});
+  auto& node_2 = graph.AddNode("node_2", "CountInferences_Fake", "node 2", {&arg_1}, {&arg_2});
+
+  num_count_inferences_fake_inferences = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_count_inferences_fake_inferences, 2);
+
+  // only a new node is inferred
+  auto& arg_3 = graph.GetOrCreateNodeArg("arg_3", nullptr);
+  graph.AddNode("node_3", "CountInferences_Fake", "node 3", {&arg_2}, {&arg_3});
+  num_count_inferences_fake_inferences = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_count_inferences_fake_inferences, 1);
+  ASSERT_NE(arg_3.Shape(), nullptr);
+  EXPECT_EQ(arg_3.Shape()->dim(0).dim_value(), 3);
+
+  // a changed attribute infers the node again, the unchanged output type leaves the downstream node as is
+  node_2.AddAttribute("tag", static_cast<int64_t>(1));
+  graph.SetGraphResolveNeeded();
+  num_count_inferences_fake_inferences = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_count_inferences_fake_inferences, 1);
+
+  // a changed input shape infers the nodes downstream of it. clear the inferred shapes the new one would be merged
+  // with, as a transformation changing the shape would.
+  tensor_int32.mutable_tensor_type()->mutable_shape()->mutable_dim(0)->set_dim_param("N");
+  input_arg.SetShape(tensor_int32.tensor_type().shape());
+  arg_1.ClearShape();
+  arg_2.ClearShape();
+  graph.SetGraphResolveNeeded();
+  num_count_inferences_fake_inferences = 0;
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(num_count_inferences_fake_inferences, 3);
+  ASSERT_NE(arg_2.Shape(), nullptr);
+  EXPECT_EQ(arg_2.Shape()->dim(0).dim_param(), "N");
+}
+
 TEST_F(GraphTest, AddTensorAttribute) {
   OPERATOR_SCHEMA(__Constant)
       .SetDoc("Constant Op.")
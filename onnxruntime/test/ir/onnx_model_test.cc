@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <numeric>
+#include "core/framework/tensorprotoutils.h"
 #include "core/platform/env.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
@@ -189,6 +193,67 @@ TEST_F(ONNXModelsTest, TestModelsWithAnOpContainingAFunctionBody) {
   ASSERT_STATUS_OK(model->MainGraph().Resolve());
 }
 
+// the data of the initializers of at least the minimum size is left in the model file as external data
+TEST_F(ONNXModelsTest, LoadWithInitializersInFile) {
+  ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  model_proto.add_opset_import()->set_version(13);
+  auto* graph_proto = model_proto.mutable_graph();
+  graph_proto->set_name("graph");
+
+  std::vector<float> weight_data(64);
+  std::iota(weight_data.begin(), weight_data.end(), 0.f);
+  std::vector<float> bias_data{1.f};
+  const auto add_initializer = [graph_proto](const std::string& name, const std::vector<float>& data) {
+    auto* initializer = graph_proto->add_initializer();
+    initializer->set_name(name);
+    initializer->set_data_type(TensorProto_DataType_FLOAT);
+    initializer->add_dims(static_cast<int64_t>(data.size()));
+    initializer->set_raw_data(data.data(), data.size() * sizeof(float));
+  };
+  add_initializer("weight", weight_data);
+  add_initializer("bias", bias_data);
+
+  auto* node = graph_proto->add_node();
+  node->set_op_type("Add");
+  node->add_input("weight");
+  node->add_input("bias");
+  node->add_output("Y");
+  auto* output = graph_proto->add_output();
+  output->set_name("Y");
+  output->mutable_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  const PathString model_path = ORT_TSTR("load_with_initializers_in_file.onnx");
+  {
+    std::ofstream model_file(model_path, std::ios::binary);
+    ASSERT_TRUE(model_proto.SerializeToOstream(&model_file));
+  }
+
+  ModelProto loaded_proto;
+  ASSERT_STATUS_OK(Model::LoadWithInitializersInFile(model_path, 64, loaded_proto));
+  ASSERT_EQ(loaded_proto.graph().initializer_size(), 2);
+  ASSERT_EQ(loaded_proto.graph().node_size(), 1);
+  EXPECT_EQ(loaded_proto.opset_import_size(), 1);
+
+  const auto& weight = loaded_proto.graph().initializer(0);
+  EXPECT_EQ(weight.data_location(), TensorProto_DataLocation_EXTERNAL);
+  EXPECT_FALSE(weight.has_raw_data());
+  std::vector<uint8_t> unpacked;
+  ASSERT_STATUS_OK(utils::UnpackInitializerData(weight, model_path, unpacked));
+  ASSERT_EQ(unpacked.size(), weight_data.size() * sizeof(float));
+  EXPECT_EQ(memcmp(unpacked.data(), weight_data.data(), unpacked.size()), 0);
+
+  // smaller than the minimum size
+  const auto& bias = loaded_proto.graph().initializer(1);
+  EXPECT_NE(bias.data_location(), TensorProto_DataLocation_EXTERNAL);
+  EXPECT_EQ(bias.raw_data().size(), sizeof(float));
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(std::move(loaded_proto), model_path, model, nullptr, *logger_));
+
+  std::filesystem::remove(model_path);
+}
+
 // The following tests verify ORT can successfully load models which reference functions
 // present in the ModelProto aka model local functions. This feature was added to ONNX standard starting IRv8
 
@@ -199,6 +199,38 @@ TEST(LoraAdapterTest, Load) {
   }
 }
 
+TEST(LoraAdapterTest, Stack) {
+  lora::LoraAdapter adapter_1;
+  adapter_1.Load(GenerateTestParameters<float>()());
+  lora::LoraAdapter adapter_2;
+  adapter_2.Load(GenerateTestParameters<float>()());
+
+  const std::array<const lora::LoraAdapter*, 2> adapters = {&adapter_1, &adapter_2};
+  lora::LoraAdapter stacked;
+  stacked.Stack(adapters);
+  ASSERT_EQ(0, stacked.AdapterVersion());
+  ASSERT_EQ(2U, stacked.GetParamNum());
+
+  auto [begin, end] = stacked.GetParamIterators();
+  for (; begin != end; ++begin) {
+    const auto& tensor = begin->second.GetMapped().Get<Tensor>();
+    ASSERT_EQ(tensor.Shape(), TensorShape({2, 8, 4}));
+    // both halves hold the same parameter of the two adapters
+    const auto data = tensor.DataAsSpan<float>();
+    const float first = begin->first == "param_1" ? 0.f : 32.f;
+    for (size_t i = 0; i < 32; ++i) {
+      ASSERT_EQ(first + static_cast<float>(i), data[i]);
+      ASSERT_EQ(first + static_cast<float>(i), data[i + 32]);
+    }
+  }
+
+  lora::LoraAdapter other_type;
+  other_type.Load(GenerateTestParameters<double>()());
+  const std::array<const lora::LoraAdapter*, 2> mismatched = {&adapter_1, &other_type};
+  lora::LoraAdapter not_stacked;
+  ASSERT_THROW(not_stacked.Stack(mismatched), OnnxRuntimeException);
+}
+
 #ifdef USE_CUDA
 TEST(LoraAdapterTest, VerifyCudaDeviceCopy) {
   auto cpu_ep = DefaultCpuExecutionProvider();
@@ -230,6 +262,46 @@ TEST(LoraAdapterTest, VerifyCudaDeviceCopy) {
     ASSERT_EQ(expected_span, copy_span);
   }
 }
+
+TEST(LoraAdapterTest, CacheCudaDeviceCopies) {
+  auto cuda_allocator = DefaultCudaExecutionProvider()->CreatePreferredAllocators()[0];
+
+  lora::LoraAdapter adapter_1;
+  adapter_1.Load(GenerateTestParameters<float>()());
+  lora::LoraAdapter adapter_2;
+  adapter_2.Load(GenerateTestParameters<float>()());
+
+  // two float parameters of 8x4 per adapter, room for one adapter only
+  constexpr size_t adapter_size = 2 * 32 * sizeof(float);
+  lora::LoraAdapterCache cache(cuda_allocator, adapter_size + adapter_size / 2);
+
+  const auto first_param_data = [](const lora::LoraAdapterCache::CachedAdapter& cached) {
+    InlinedVector<const char*> names;
+    InlinedVector<const OrtValue*> ort_values;
+    cached.OutputAdapterParameters(std::back_inserter(names), std::back_inserter(ort_values));
+    EXPECT_EQ(2U, ort_values.size());
+    const auto& tensor = ort_values[0]->Get<Tensor>();
+    EXPECT_EQ(0, strcmp(tensor.Location().name, onnxruntime::CUDA));
+    return tensor.DataRaw();
+  };
+
+  std::shared_ptr<const lora::LoraAdapterCache::CachedAdapter> cached_1;
+  ASSERT_STATUS_OK(cache.Acquire(adapter_1, cached_1));
+  std::shared_ptr<const lora::LoraAdapterCache::CachedAdapter> cached_again;
+  ASSERT_STATUS_OK(cache.Acquire(adapter_1, cached_again));
+  // a hit does not copy
+  ASSERT_EQ(cached_1, cached_again);
+
+  cache.Prefetch(adapter_2);
+  std::shared_ptr<const lora::LoraAdapterCache::CachedAdapter> cached_2;
+  ASSERT_STATUS_OK(cache.Acquire(adapter_2, cached_2));
+  ASSERT_NE(first_param_data(*cached_1), first_param_data(*cached_2));
+
+  // adapter_1 was evicted by adapter_2 but the copy held by cached_1 stays valid
+  ASSERT_STATUS_OK(cache.Acquire(adapter_1, cached_again));
+  ASSERT_NE(cached_1, cached_again);
+  ASSERT_NE(nullptr, first_param_data(*cached_1));
+}
 #endif
 
 #ifdef USE_DML
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+static const std::vector<std::string> flashattn_arg_names = {"Batch", "Heads", "SeqLen", "HeadSize", "Threads", "Causal"};
+
+// Self attention over a prompt, with the block sizes the Attention and MultiHeadAttention kernels pick for the
+// L2 cache of the machine.
+void FLASHATTN(benchmark::State& state) {
+  for (int i = 0; i < 5; i++) {
+    if (state.range(i) <= 0) throw std::invalid_argument(flashattn_arg_names[i] + " must greater than 0!");
+  }
+
+  const int batch = static_cast<int>(state.range(0));
+  const int heads = static_cast<int>(state.range(1));
+  const int seq_len = static_cast<int>(state.range(2));
+  const int head_size = static_cast<int>(state.range(3));
+  auto tp = CreateBenchThreadPool(static_cast<size_t>(state.range(4)));
+
+  const int l2_cache_size = onnxruntime::Env::Default().GetL2CacheSize();
+  if (l2_cache_size <= 0) {
+    state.SkipWithMessage("The L2 cache size of the current machine is unknown.");
+    return;
+  }
+
+  const size_t qkv_size = static_cast<size_t>(batch) * heads * seq_len * head_size;
+  const auto query = RandomVectorUniform(qkv_size, -1.0f, 1.0f);
+  const auto key = RandomVectorUniform(qkv_size, -1.0f, 1.0f);
+  const auto value = RandomVectorUniform(qkv_size, -1.0f, 1.0f);
+  std::vector<float> output(qkv_size);
+
+  MlasFlashAttentionThreadedArgs args;
+  args.batch_size = batch;
+  args.num_heads = heads;
+  args.q_sequence_length = seq_len;
+  args.kv_sequence_length = seq_len;
+  args.qk_head_size = head_size;
+  args.v_head_size = head_size;
+  args.scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+
+  // same as AttentionCPUBase::ApplyAttention
+  args.kv_block_size = l2_cache_size / (static_cast<int>(sizeof(float)) * 4 * (2 * head_size));
+  args.kv_block_size = std::max(args.kv_block_size, 1);
+  args.q_block_size = std::min(args.kv_block_size, 2 * head_size);
+  args.kv_block_size = std::min(args.kv_block_size, seq_len);
+  args.q_block_size = std::min(args.q_block_size, seq_len);
+
+  args.thread_count = onnxruntime::concurrency::ThreadPool::DegreeOfParallelism(tp.get());
+  args.buffer_size_per_thread = (static_cast<size_t>(args.q_block_size) * 2 +
+                                 static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.kv_block_size) +
+                                 static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.v_head_size)) *
+                                sizeof(float);
+  std::vector<float> buffer(args.buffer_size_per_thread / sizeof(float) * static_cast<size_t>(args.thread_count));
+  args.buffer = buffer.data();
+
+  args.query = query.data();
+  args.key = key.data();
+  args.value = value.data();
+  args.output = output.data();
+  args.is_causal = state.range(5) != 0;
+
+  for (auto _ : state) {
+    MlasFlashAttention(&args, tp.get());
+  }
+}
+
+static void FlashAttnArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames(flashattn_arg_names);
+
+  b->ArgsProduct({
+      {1},                              // Batch
+      {12, 32},                         // Heads
+      {128, 512, 2048},                 // SeqLen
+      {64, 128},                        // HeadSize
+      {1, 8},                           // Threads
+      {int64_t{false}, int64_t{true}},  // Causal
+  });
+}
+
+BENCHMARK(FLASHATTN)->Apply(FlashAttnArgs)->UseRealTime();
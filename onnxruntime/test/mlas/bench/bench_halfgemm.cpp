@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+#include <vector>
+
+static const std::vector<std::string> halfgemm_arg_names = {"M", "N", "K", "Batch", "Threads"};
+
+void HALFGEMM(benchmark::State& state, bool a_is_fp32) {
+  if (!MlasFp16AccelerationSupported()) {
+    state.SkipWithMessage("Half precision GEMM is not supported on the current machine.");
+    return;
+  }
+
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("Batch must greater than 0!");
+  if (state.range(4) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t batch = static_cast<size_t>(state.range(3));
+  auto tp = CreateBenchThreadPool(static_cast<size_t>(state.range(4)));
+
+  const auto A_fp32 = RandomVectorUniform(M * K * batch, -1.0f, 1.0f);
+  std::vector<MLAS_FP16> A_fp16(a_is_fp32 ? 0 : A_fp32.size());
+  if (!a_is_fp32) {
+    MlasConvertFloatToHalfBuffer(A_fp32.data(), A_fp16.data(), A_fp16.size());
+  }
+  const auto B = RandomVectorUniform(N * K * batch, -1.0f, 1.0f);
+  std::vector<MLAS_FP16> C(M * N * batch);
+
+  // B is a constant initializer in the models, so the kernels see it packed
+  const size_t packed_b_size = MlasHalfGemmPackBSize(N, K, true);
+  std::vector<uint8_t> packed_b(packed_b_size * batch);
+
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> params(batch);
+  for (size_t i = 0; i < batch; i++) {
+    if (a_is_fp32) {
+      params[i].A = A_fp32.data() + M * K * i;
+    } else {
+      params[i].A = A_fp16.data() + M * K * i;
+    }
+    params[i].AIsfp32 = a_is_fp32;
+    params[i].lda = K;
+    MlasHalfGemmConvertPackB(N, K, B.data() + N * K * i, N, packed_b.data() + packed_b_size * i);
+    params[i].B = packed_b.data() + packed_b_size * i;
+    params[i].ldb = 0;
+    params[i].C = C.data() + M * N * i;
+    params[i].ldc = N;
+  }
+
+  for (auto _ : state) {
+    MlasHalfGemmBatch(M, N, K, batch, params.data(), tp.get());
+  }
+}
+
+static void HalfGemmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(halfgemm_arg_names);
+  // Args for "M", "N", "K", "Batch", "Threads"
+
+  b->Args({1, 4096, 4096, 1, 1});
+  b->Args({1, 4096, 4096, 1, 8});
+  b->Args({128, 768, 768, 1, 1});
+  b->Args({128, 768, 3072, 1, 8});
+  b->Args({384, 1024, 1024, 1, 8});
+  b->Args({384, 1024, 4096, 1, 8});
+  b->Args({384, 4096, 1024, 1, 8});
+  b->Args({64, 64, 64, 12, 8});
+}
+
+BENCHMARK_CAPTURE(HALFGEMM, Fp16A, false)->Apply(HalfGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, Fp32A, true)->Apply(HalfGemmSize)->UseRealTime();
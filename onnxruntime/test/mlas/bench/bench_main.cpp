@@ -3,4 +3,48 @@
 
 #include <benchmark/benchmark.h>
 
-BENCHMARK_MAIN();
+#include <cstdlib>
+#include <string>
+
+#include "core/common/cpuid_info.h"
+
+// MLAS selects its kernels once per process, so the results of the ISA specific kernels (qgemm, sqnbitgemm, ...)
+// are compared across ISAs by running the benchmarks once for each ORT_MLAS_MAX_ISA value, for example
+//   ORT_MLAS_MAX_ISA=avx2 onnxruntime_mlas_benchmark --benchmark_filter=QGEMM
+// The ISA cap and the CPU features are recorded in the context of the report, so results from different machines
+// can be told apart.
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  const char* max_isa = std::getenv("ORT_MLAS_MAX_ISA");
+  benchmark::AddCustomContext("mlas_max_isa", max_isa != nullptr ? max_isa : "native");
+
+  const auto& cpuid_info = onnxruntime::CPUIDInfo::GetCPUIDInfo();
+  std::string features;
+  const auto add_feature = [&features](bool has_feature, const char* name) {
+    if (has_feature) {
+      if (!features.empty()) features += ",";
+      features += name;
+    }
+  };
+  add_feature(cpuid_info.HasSSE4_1(), "sse4.1");
+  add_feature(cpuid_info.HasAVX(), "avx");
+  add_feature(cpuid_info.HasAVX2(), "avx2");
+  add_feature(cpuid_info.HasF16C(), "f16c");
+  add_feature(cpuid_info.HasAVX512f(), "avx512f");
+  add_feature(cpuid_info.HasAVX512Skylake(), "avx512core");
+  add_feature(cpuid_info.HasAVX512_BF16(), "avx512bf16");
+  add_feature(cpuid_info.HasAMX_BF16(), "amx-bf16");
+  add_feature(cpuid_info.HasArmNeonDot(), "neon-dot");
+  add_feature(cpuid_info.HasArmNeon_I8MM(), "neon-i8mm");
+  add_feature(cpuid_info.HasArmSVE_I8MM(), "sve-i8mm");
+  add_feature(cpuid_info.HasArmNeon_BF16(), "neon-bf16");
+  benchmark::AddCustomContext("cpu_features", features.empty() ? "none" : features);
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
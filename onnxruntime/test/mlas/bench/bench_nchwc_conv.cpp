@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+#include <vector>
+
+static const std::vector<std::string> nchwc_conv_arg_names = {"N", "C", "H", "W", "F", "Kernel", "Stride", "Threads"};
+
+// The graph transformer reorders the activations to NCHWc once for a chain of convolutions, so only the
+// convolution itself is measured. The input is already in the blocked layout unless it has fewer channels
+// than the block size, which is the NCHW convolution that starts the chain.
+void NCHWC_CONV(benchmark::State& state) {
+  for (int i = 0; i < 8; i++) {
+    if (state.range(i) <= 0) throw std::invalid_argument(nchwc_conv_arg_names[i] + " must greater than 0!");
+  }
+
+  const size_t BlockSize = MlasNchwcGetBlockSize();
+  if (BlockSize <= 1) {
+    state.SkipWithMessage("NCHWc convolution is not supported on the current machine.");
+    return;
+  }
+
+  const int64_t batch = state.range(0);
+  const int64_t channels = state.range(1);
+  const int64_t height = state.range(2);
+  const int64_t width = state.range(3);
+  const int64_t filters = state.range(4);
+  const int64_t kernel = state.range(5);
+  const int64_t stride = state.range(6);
+  auto tp = CreateBenchThreadPool(static_cast<size_t>(state.range(7)));
+
+  const int64_t block = static_cast<int64_t>(BlockSize);
+  const bool nchw_input = channels < block;
+  if (!nchw_input && channels % block != 0) {
+    state.SkipWithMessage("The channel count must be less than or a multiple of the NCHWc block size.");
+    return;
+  }
+
+  const int64_t pad = kernel / 2;
+  const int64_t output_height = (height + 2 * pad - kernel) / stride + 1;
+  const int64_t output_width = (width + 2 * pad - kernel) / stride + 1;
+  const int64_t nchwc_filters = (filters + block - 1) & ~(block - 1);
+
+  int64_t InputShape[] = {batch, channels, height, width};
+  int64_t FilterShape[] = {filters, channels, kernel, kernel};
+  int64_t KernelShape[] = {kernel, kernel};
+  int64_t DilationShape[] = {1, 1};
+  int64_t Padding[] = {pad, pad, pad, pad};
+  int64_t StrideShape[] = {stride, stride};
+  int64_t OutputShape[] = {batch, nchwc_filters, output_height, output_width};
+
+  const auto input = RandomVectorUniform(static_cast<size_t>(batch * channels * height * width), -1.0f, 1.0f);
+  const auto filter = RandomVectorUniform(static_cast<size_t>(filters * channels * kernel * kernel), -1.0f, 1.0f);
+  const auto bias = RandomVectorUniform(static_cast<size_t>(nchwc_filters), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(batch * nchwc_filters * output_height * output_width));
+
+  std::vector<float> reordered_filter(static_cast<size_t>(nchwc_filters * channels * kernel * kernel));
+  if (nchw_input) {
+    MlasReorderFilterOIHWBo(FilterShape, filter.data(), reordered_filter.data());
+  } else {
+    MlasReorderFilterOIHWBiBo(FilterShape, filter.data(), reordered_filter.data());
+  }
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  for (auto _ : state) {
+    MlasNchwcConv(InputShape, KernelShape, DilationShape, Padding, StrideShape, OutputShape, 1,
+                  input.data(), reordered_filter.data(), bias.data(), output.data(),
+                  &activation, true, tp.get());
+  }
+}
+
+static void ResNetShapes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(nchwc_conv_arg_names);
+  // Args for "N", "C", "H", "W", "F", "Kernel", "Stride", "Threads"
+
+  b->Args({1, 3, 224, 224, 64, 7, 2, 8});
+  b->Args({1, 64, 56, 56, 64, 1, 1, 8});
+  b->Args({1, 64, 56, 56, 64, 3, 1, 8});
+  b->Args({1, 64, 56, 56, 256, 1, 1, 8});
+  b->Args({1, 128, 28, 28, 128, 3, 1, 8});
+  b->Args({1, 256, 14, 14, 256, 3, 1, 8});
+  b->Args({1, 512, 7, 7, 512, 3, 1, 8});
+  b->Args({1, 256, 56, 56, 128, 1, 2, 8});
+  b->Args({1, 64, 56, 56, 64, 3, 1, 1});
+}
+
+BENCHMARK(NCHWC_CONV)->Apply(ResNetShapes)->UseRealTime();
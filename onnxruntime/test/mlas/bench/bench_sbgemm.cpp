@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+#include <vector>
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
+
+static const std::vector<std::string> sbgemm_arg_names = {"M", "N", "K", "Batch", "Threads"};
+
+void SBGEMM(benchmark::State& state, bool pack_b) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("Batch must greater than 0!");
+  if (state.range(4) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t batch = static_cast<size_t>(state.range(3));
+
+  if (MlasSBGemmPackBSize(N, K) == 0) {
+    state.SkipWithMessage("Bfloat16 precision GEMM is not supported on the current machine.");
+    return;
+  }
+
+  auto tp = CreateBenchThreadPool(static_cast<size_t>(state.range(4)));
+
+  const auto A = RandomVectorUniform(M * K * batch, -1.0f, 1.0f);
+  const auto B = RandomVectorUniform(N * K * batch, -1.0f, 1.0f);
+  std::vector<float> C(M * N * batch);
+
+  const size_t packed_b_size = pack_b ? MlasSBGemmPackBSize(N, K) : 0;
+  std::vector<uint8_t> packed_b(packed_b_size * batch);
+
+  std::vector<MLAS_SBGEMM_DATA_PARAMS> params(batch);
+  for (size_t i = 0; i < batch; i++) {
+    params[i].A = A.data() + M * K * i;
+    params[i].AIsfp32 = true;
+    params[i].lda = K;
+    if (pack_b) {
+      MlasSBGemmConvertPackB(N, K, B.data() + N * K * i, N, packed_b.data() + packed_b_size * i);
+      params[i].B = packed_b.data() + packed_b_size * i;
+      params[i].ldb = 0;
+    } else {
+      params[i].B = B.data() + N * K * i;
+      params[i].BIsfp32 = true;
+      params[i].ldb = N;
+    }
+    params[i].C = C.data() + M * N * i;
+    params[i].ldc = N;
+  }
+
+  for (auto _ : state) {
+    MlasSBGemmBatch(M, N, K, batch, params.data(), tp.get());
+  }
+}
+
+static void SBGemmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(sbgemm_arg_names);
+  // Args for "M", "N", "K", "Batch", "Threads"
+
+  b->Args({1, 4096, 4096, 1, 1});
+  b->Args({1, 4096, 4096, 1, 8});
+  b->Args({128, 768, 3072, 1, 8});
+  b->Args({384, 1024, 1024, 1, 8});
+  b->Args({384, 1024, 4096, 1, 8});
+  b->Args({384, 4096, 1024, 1, 8});
+  b->Args({1536, 1024, 4096, 1, 16});
+}
+
+BENCHMARK_CAPTURE(SBGEMM, PackB, true)->Apply(SBGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(SBGEMM, NoPackB, false)->Apply(SBGemmSize)->UseRealTime();
+
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
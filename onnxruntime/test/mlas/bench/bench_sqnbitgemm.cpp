@@ -132,6 +132,24 @@ static void SQNBitGemmArgs(benchmark::internal::Benchmark* b) {
 
 BENCHMARK(SQNBITGEMM<4>)->Apply(SQNBitGemmArgs)->UseRealTime();
 
+// Covers every block length and accuracy level the kernels dispatch on, with a GEMV and a GEMM shape.
+static void SQNBitGemmBlkLenArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"BlkLen", "M", "N", "K", "Threads", "Symmetric", "HasBias", "ComputeType"});
+
+  b->ArgsProduct({
+      {16, 32, 64, 128, 256},                  // BlkLen
+      {1, 128},                                // M
+      {4096},                                  // N
+      {4096},                                  // K
+      {1, 8},                                  // Threads
+      {int64_t{true}},                         // Symmetric
+      {int64_t{false}},                        // HasBias
+      {int64_t{CompFp32}, int64_t{CompInt8}},  // ComputeType
+  });
+}
+
+BENCHMARK(SQNBITGEMM<4>)->Name("SQNBITGEMM_BLKLEN<4>")->Apply(SQNBitGemmBlkLenArgs)->UseRealTime();
+
 // This test gets benchmark arguments from environment variables.
 template <size_t BlkBitWidth>
 void SQNBITGEMM_ENV(benchmark::State& state) {
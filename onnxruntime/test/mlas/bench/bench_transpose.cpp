@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+#include <vector>
+
+template <typename T>
+void TRANSPOSE(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  std::vector<T> input(M * N);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<T>(i);
+  }
+  std::vector<T> output(M * N);
+
+  for (auto _ : state) {
+    MlasTranspose(input.data(), output.data(), M, N);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(M * N * sizeof(T)));
+}
+
+static void TransposeSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N"});
+
+  b->ArgsProduct({
+      {3, 64, 768, 4096},
+      {3, 64, 768, 4096},
+  });
+}
+
+BENCHMARK(TRANSPOSE<uint8_t>)->Apply(TransposeSize)->UseRealTime();
+BENCHMARK(TRANSPOSE<uint16_t>)->Apply(TransposeSize)->UseRealTime();
+BENCHMARK(TRANSPOSE<uint32_t>)->Apply(TransposeSize)->UseRealTime();
+BENCHMARK(TRANSPOSE<float>)->Apply(TransposeSize)->UseRealTime();
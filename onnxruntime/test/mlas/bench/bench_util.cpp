@@ -15,6 +15,15 @@ std::vector<int64_t> BenchArgsVector(benchmark::State& state, size_t& start, siz
   return shape;
 }
 
+std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateBenchThreadPool(size_t threads) {
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(threads);
+  tpo.auto_set_affinity = true;
+  return std::unique_ptr<onnxruntime::concurrency::ThreadPool>(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo,
+                                                 onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+}
+
 std::vector<float> RandomVectorUniform(std::vector<int64_t> shape, float min_value, float max_value) {
   int64_t sz = std::accumulate(shape.begin(), shape.end(), 1LL, std::multiplies<int64_t>());
   if (sz <= 0) {
@@ -6,8 +6,11 @@
 #include <benchmark/benchmark.h>
 
 #include <functional>
+#include <memory>
 #include <random>
 
+#include "core/util/thread_utils.h"
+
 template <typename ElementType>
 std::vector<ElementType> RandomVectorUniform(
     size_t N,
@@ -29,3 +32,6 @@ std::vector<ElementType> RandomVectorUniform(
 std::vector<float> RandomVectorUniform(std::vector<int64_t> shape, float min_value, float max_value);
 
 std::vector<int64_t> BenchArgsVector(benchmark::State& state, size_t& start, size_t count);
+
+// Creates the intra op thread pool the kernels run on, nullptr for a single thread.
+std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateBenchThreadPool(size_t threads);
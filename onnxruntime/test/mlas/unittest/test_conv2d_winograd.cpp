@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWorking;
+
+  void Conv2D(size_t BatchCount,
+              size_t GroupCount,
+              size_t InputChannels,
+              size_t InputHeight,
+              size_t InputWidth,
+              size_t FilterCount,
+              const int64_t* Padding,
+              size_t OutputHeight,
+              size_t OutputWidth,
+              bool Winograd,
+              const float* Input,
+              const float* Filter,
+              const float* Bias,
+              float* Output) {
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters,
+                    2,
+                    BatchCount,
+                    GroupCount,
+                    InputChannels,
+                    InputShape,
+                    KernelShape,
+                    DilationShape,
+                    Padding,
+                    StrideShape,
+                    OutputShape,
+                    FilterCount,
+                    &Activation,
+                    &WorkingBufferSize,
+                    0.0f,
+                    GetMlasThreadPool());
+
+    if (Winograd) {
+      ASSERT_TRUE(MlasConvPrepareWinograd(&Parameters, &WorkingBufferSize));
+
+      float* PackedFilter = BufferPackedFilter.GetBuffer(
+          MlasConvWinogradPackFilterSize(GroupCount, FilterCount, InputChannels));
+      MlasConvWinogradPackFilter(GroupCount, FilterCount, InputChannels, Filter, PackedFilter);
+      Filter = PackedFilter;
+    }
+
+    MlasConv(&Parameters,
+             Input,
+             Filter,
+             Bias,
+             BufferWorking.GetBuffer(WorkingBufferSize),
+             Output,
+             GetMlasThreadPool());
+  }
+
+  void Test(size_t BatchCount,
+            size_t GroupCount,
+            size_t InputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t PaddingHeight,
+            size_t PaddingWidth) {
+    int64_t Padding[] = {int64_t(PaddingHeight), int64_t(PaddingWidth), int64_t(PaddingHeight), int64_t(PaddingWidth)};
+
+    if (InputHeight + 2 * PaddingHeight < 3 || InputWidth + 2 * PaddingWidth < 3) {
+      return;
+    }
+
+    size_t OutputHeight = InputHeight + 2 * PaddingHeight - 2;
+    size_t OutputWidth = InputWidth + 2 * PaddingWidth - 2;
+
+    size_t InputElements = BatchCount * GroupCount * InputChannels * InputHeight * InputWidth;
+    size_t FilterElements = GroupCount * FilterCount * InputChannels * 3 * 3;
+    size_t BiasElements = GroupCount * FilterCount;
+    size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputHeight * OutputWidth;
+
+    const float* Input = BufferInput.GetBuffer(InputElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterElements);
+    const float* Bias = BufferBias.GetBuffer(BiasElements);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    Conv2D(BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount, Padding,
+           OutputHeight, OutputWidth, true, Input, Filter, Bias, Output);
+    Conv2D(BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount, Padding,
+           OutputHeight, OutputWidth, false, Input, Filter, Bias, OutputReference);
+
+    // The Winograd transforms change the rounding, so compare relative to the magnitude of the output
+    float MaximumValue = 1.0f;
+    for (size_t i = 0; i < OutputElements; i++) {
+      MaximumValue = std::max(MaximumValue, std::fabs(OutputReference[i]));
+    }
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_LE(std::fabs(Output[i] - OutputReference[i]), MaximumValue * 1e-4f)
+          << " @" << i << " of " << OutputElements << ", "
+          << "B" << BatchCount << "/"
+          << "G" << GroupCount << "/"
+          << "Cpg" << InputChannels << "/"
+          << "Fpg" << FilterCount << "/"
+          << "H" << InputHeight << "/"
+          << "W" << InputWidth << "/"
+          << "Pad" << PaddingHeight << "," << PaddingWidth;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Conv2dWinograd");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t i = 1; i <= 19; i += 3) {
+      Test(1, 1, 16, i, i, 32, 1, 1);
+      Test(1, 1, 16, i, i + 5, 16, 0, 0);
+      Test(1, 1, 24, i + 2, i, 17, 1, 0);
+    }
+
+    Test(2, 1, 32, 28, 28, 64, 1, 1);
+    Test(1, 2, 16, 14, 14, 32, 1, 1);
+    Test(3, 4, 16, 7, 9, 16, 0, 1);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasConv2DWinogradTest>::RegisterShortExecute() : 0;
+});
@@ -167,6 +167,36 @@ class MlasSQNBitGemmTest : public MlasTestBase {
     }
   }
 
+  static uint8_t GetLowBitValue(const uint8_t* Data, size_t Index) {
+    // values occupy BlkBitWidth bits of a little-endian bit stream
+    const size_t BitOffset = Index * BlkBitWidth;
+    uint32_t Value = Data[BitOffset / 8];
+    if (BitOffset % 8 + BlkBitWidth > 8) {
+      Value |= static_cast<uint32_t>(Data[BitOffset / 8 + 1]) << 8;
+    }
+    return static_cast<uint8_t>((Value >> (BitOffset % 8)) & ((1u << BlkBitWidth) - 1));
+  }
+
+  void DequantizeLowBitB(size_t N, size_t K,
+                         const uint8_t* QuantBData,
+                         const float* QuantBScale,
+                         const uint8_t* QuantBZeroPoint,
+                         float* DequantizedBData) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t BlkDataSize = BlkLen * BlkBitWidth / 8;
+    const size_t ZeroPointStride = (BlockCountK * BlkBitWidth + 7) / 8;
+    for (size_t n = 0; n < N; ++n) {
+      for (size_t k = 0; k < K; ++k) {
+        const size_t k_blk = k / BlkLen;
+        const uint8_t b = GetLowBitValue(QuantBData + (n * BlockCountK + k_blk) * BlkDataSize, k % BlkLen);
+        const uint8_t b_zp = QuantBZeroPoint != nullptr
+                                 ? GetLowBitValue(QuantBZeroPoint + n * ZeroPointStride, k_blk)
+                                 : uint8_t{1 << (BlkBitWidth - 1)};
+        DequantizedBData[n * K + k] = (static_cast<float>(b) - b_zp) * QuantBScale[n * BlockCountK + k_blk];
+      }
+    }
+  }
+
   void CallReferenceGemm_CompFp32(size_t M,
                                   size_t N,
                                   size_t K,
@@ -177,9 +207,13 @@ class MlasSQNBitGemmTest : public MlasTestBase {
                                   const float* Bias,
                                   float* C) {
     float* DequantizedBData = BufferDequantizedB.GetBuffer(K * N);
-    MlasDequantizeBlockwise<float, BlkBitWidth>(
-        DequantizedBData, QuantBData, QuantBScale, QuantBZeroPoint, BlkLen, /* columnwise */ true,
-        static_cast<int>(K), static_cast<int>(N), GetMlasThreadPool());
+    if constexpr (BlkBitWidth == 4) {
+      MlasDequantizeBlockwise<float, BlkBitWidth>(
+          DequantizedBData, QuantBData, QuantBScale, QuantBZeroPoint, BlkLen, /* columnwise */ true,
+          static_cast<int>(K), static_cast<int>(N), GetMlasThreadPool());
+    } else {
+      DequantizeLowBitB(N, K, QuantBData, QuantBScale, QuantBZeroPoint, DequantizedBData);
+    }
     // Note: DequantizedBData is in column major layout.
 
     for (size_t m = 0; m < M; m++) {
@@ -244,7 +278,27 @@ class MlasSQNBitGemmTest : public MlasTestBase {
     uint8_t* QuantBData = nullptr;
     float* QuantBScale = nullptr;
     uint8_t* QuantBZeroPoint = nullptr;
-    {
+    if constexpr (BlkBitWidth != 4) {
+      // MlasQuantizeBlockwise only supports 4-bit, use arbitrary quantized values instead
+      const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+      const size_t QuantBDataSizeInBytes = N * BlockCountK * (BlkLen * BlkBitWidth / 8);
+      const size_t QuantBZeroPointSizeInBytes = N * ((BlockCountK * BlkBitWidth + 7) / 8);
+
+      QuantBData = BufferQuantBData.GetBuffer(QuantBDataSizeInBytes);
+      for (size_t i = 0; i < QuantBDataSizeInBytes; ++i) {
+        QuantBData[i] = static_cast<uint8_t>(i * 37 + 11);
+      }
+      QuantBScale = BufferQuantBScale.GetBuffer(N * BlockCountK);
+      for (size_t i = 0; i < N * BlockCountK; ++i) {
+        QuantBScale[i] = 0.01f + static_cast<float>(i % 13) * 0.005f;
+      }
+      if (!Symmetric) {
+        QuantBZeroPoint = BufferQuantBZeroPoint.GetBuffer(QuantBZeroPointSizeInBytes);
+        for (size_t i = 0; i < QuantBZeroPointSizeInBytes; ++i) {
+          QuantBZeroPoint[i] = static_cast<uint8_t>(i * 53 + 7);
+        }
+      }
+    } else {
       size_t QuantBDataSizeInBytes, QuantBScaleSize, QuantBZeroPointSizeInBytes;
       MlasBlockwiseQuantizedBufferSizes(BlkBitWidth, BlkLen, /* columnwise */ true,
                                         static_cast<int>(K), static_cast<int>(N),
@@ -292,7 +346,12 @@ class MlasSQNBitGemmTest : public MlasTestBase {
     if (ComputeType == CompFp32) {
       CallReferenceGemm_CompFp32(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
     } else if (ComputeType == CompInt8) {
-      CallReferenceGemm_CompInt8(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
+      if constexpr (BlkBitWidth == 4) {
+        CallReferenceGemm_CompInt8(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
+      } else {
+        FAIL() << "Test is not implemented for compute type " << ComputeTypeName(ComputeType)
+               << " with " << BlkBitWidth << "-bit quantized B";
+      }
     } else {
       FAIL() << "Test is not implemented for compute type "
              << ComputeType << " (" << ComputeTypeName(ComputeType) << ")";
@@ -428,6 +487,16 @@ static size_t SQNBitGemmRegisterAllShortExecuteTests() {
   count += SQNBitGemmShortExecuteTest<4, 64>::RegisterShortExecuteTests();
   count += SQNBitGemmShortExecuteTest<4, 128>::RegisterShortExecuteTests();
   count += SQNBitGemmShortExecuteTest<4, 256>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 16>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 32>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 64>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 128>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<2, 256>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<3, 16>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<3, 32>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<3, 64>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<3, 128>::RegisterShortExecuteTests();
+  count += SQNBitGemmShortExecuteTest<3, 256>::RegisterShortExecuteTests();
 
   return count;
 }
@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Session creation time of the models of a model zoo, broken down into the initialization phases the session
+// records in its profile: protobuf parsing, graph resolution, each graph transformer, the partitioning for each
+// execution provider, initializer copies, kernel creation and prepacking.
+// Set ORT_SESSION_INIT_BENCH_MODELS to a directory of .onnx models, or to a list of model paths separated by ';'.
+// Each phase is reported as a counter, in microseconds per session creation.
+
+#include <benchmark/benchmark.h>
+#include <core/session/onnxruntime_c_api.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+namespace {
+
+#define ORT_SKIP_ON_ERROR(expr)                                 \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// Adds the duration of the session events of the profile to phase_us.
+void AccumulateInitializationPhases(const std::string& profile_file, std::map<std::string, double>& phase_us) {
+  std::ifstream profile(profile_file);
+  const auto events = nlohmann::json::parse(profile, nullptr, /* allow_exceptions */ false);
+  if (!events.is_array()) {
+    return;
+  }
+
+  for (const auto& event : events) {
+    if (event.value("cat", "") != "Session") {
+      continue;
+    }
+
+    phase_us[event.value("name", "")] += event.value("dur", 0.0);
+
+    // the protobuf is parsed while the model is loaded, so its time is an argument of the loading event
+    const auto args = event.find("args");
+    if (args != event.end() && args->contains("model_proto_parse_us")) {
+      phase_us["model_proto_parse"] += std::stod(args->at("model_proto_parse_us").get<std::string>());
+    }
+  }
+}
+
+void BM_SessionInitialization(benchmark::State& state, const std::filesystem::path& model_path) {
+  const std::filesystem::path profile_prefix = std::filesystem::temp_directory_path() / "ort_session_init_bench";
+
+  OrtSessionOptions* session_options;
+  ORT_SKIP_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  std::unique_ptr<OrtSessionOptions, decltype(g_ort->ReleaseSessionOptions)> session_options_holder(
+      session_options, g_ort->ReleaseSessionOptions);
+  ORT_SKIP_ON_ERROR(g_ort->EnableProfiling(session_options, profile_prefix.native().c_str()));
+
+  OrtAllocator* allocator;
+  ORT_SKIP_ON_ERROR(g_ort->GetAllocatorWithDefaultOptions(&allocator));
+
+  std::map<std::string, double> phase_us;
+  for (auto _ : state) {
+    OrtSession* session;
+    ORT_SKIP_ON_ERROR(g_ort->CreateSession(env, model_path.native().c_str(), session_options, &session));
+
+    state.PauseTiming();
+    char* profile_file = nullptr;
+    OrtStatus* status = g_ort->SessionEndProfiling(session, allocator, &profile_file);
+    g_ort->ReleaseSession(session);
+    ORT_SKIP_ON_ERROR(status);
+    AccumulateInitializationPhases(profile_file, phase_us);
+    std::filesystem::remove(profile_file);
+    allocator->Free(allocator, profile_file);
+    state.ResumeTiming();
+  }
+
+  for (const auto& [phase, us] : phase_us) {
+    state.counters[phase] = benchmark::Counter(us, benchmark::Counter::kAvgIterations);
+  }
+}
+
+std::vector<std::filesystem::path> GetBenchmarkModels() {
+  std::vector<std::filesystem::path> models;
+  const char* models_env = std::getenv("ORT_SESSION_INIT_BENCH_MODELS");
+  if (models_env == nullptr) {
+    return models;
+  }
+
+  std::istringstream paths(models_env);
+  std::string path;
+  while (std::getline(paths, path, ';')) {
+    if (path.empty()) {
+      continue;
+    }
+
+    std::error_code ec;
+    if (std::filesystem::is_directory(path, ec)) {
+      for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".onnx") {
+          models.push_back(entry.path());
+        }
+      }
+    } else {
+      models.emplace_back(path);
+    }
+  }
+
+  std::sort(models.begin(), models.end());
+  return models;
+}
+
+bool RegisterSessionInitializationBenchmarks() {
+  for (const auto& model : GetBenchmarkModels()) {
+    benchmark::RegisterBenchmark(("BM_SessionInitialization/" + model.stem().string()).c_str(),
+                                 BM_SessionInitialization, model)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+  }
+  return true;
+}
+
+const bool session_initialization_benchmarks_registered = RegisterSessionInitializationBenchmarks();
+
+}  // namespace
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+void EnableElementwiseFusion(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableElementwiseFusion, "1"));
+}
+}  // namespace
+
+TEST(ElementwiseFusionTests, ChainWithScalarAndTensorOperands) {
+  // more than one tile, with a partial last tile
+  const std::vector<int64_t> shape = {4, 8, 33, 17};
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* x = builder.MakeInput<float>(shape, -2.f, 2.f);
+    auto* y = builder.MakeInput<float>(shape, -2.f, 2.f);
+    auto* sub_out = builder.MakeIntermediate();
+    auto* abs_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* div_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("Sub", {builder.MakeScalarInitializer<float>(0.5f), x}, {sub_out});
+    builder.AddNode("Abs", {sub_out}, {abs_out});
+    builder.AddNode("Mul", {abs_out, y}, {mul_out});
+    builder.AddNode("Sigmoid", {mul_out}, {sigmoid_out});
+    builder.AddNode("Div", {builder.MakeScalarInitializer<float>(1.5f), sigmoid_out}, {div_out});
+    builder.AddNode("Add", {div_out, builder.MakeInitializer<float>({1}, {-1.f})}, {add_out});
+    builder.AddNode("Relu", {add_out}, {output});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+    EXPECT_EQ(op_to_count["Abs"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+    EXPECT_EQ(op_to_count["Div"], 0);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level3, 14,
+                    1e-5, 1e-5, nullptr, EnableElementwiseFusion);
+}
+
+TEST(ElementwiseFusionTests, ChainReusingInput) {
+  // x - exp(x * x) reads x in the first and the last step
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* x = builder.MakeInput<float>({3, 1000}, -2.f, 2.f);
+    auto* mul_out = builder.MakeIntermediate();
+    auto* exp_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("Mul", {x, x}, {mul_out});
+    builder.AddNode("Exp", {mul_out}, {exp_out});
+    builder.AddNode("Sub", {x, exp_out}, {output});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Exp"], 0);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level3, 13,
+                    1e-5, 1e-5, nullptr, EnableElementwiseFusion);
+}
+
+TEST(ElementwiseFusionTests, StopAtValueWithMultipleConsumers) {
+  // the output of Tanh is also a graph output, so only Abs -> Tanh is fused
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* x = builder.MakeInput<float>({2, 3, 16}, -2.f, 2.f);
+    auto* abs_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeOutput();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("Abs", {x}, {abs_out});
+    builder.AddNode("Tanh", {abs_out}, {tanh_out});
+    builder.AddNode("Neg", {tanh_out}, {output});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Abs"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Neg"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level3, 13,
+                    1e-5, 1e-5, nullptr, EnableElementwiseFusion);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
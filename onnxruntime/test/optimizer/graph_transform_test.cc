@@ -5,6 +5,7 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <filesystem>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -12,6 +13,7 @@
 #include "onnx/defs/parser.h"
 #include "onnx/defs/printer.h"
 
+#include "core/common/path_string.h"
 #include "core/common/span_utils.h"
 #include "core/framework/data_types.h"
 #include "core/framework/ort_value.h"
@@ -54,9 +56,11 @@
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/isinf_reducesum_fusion.h"
 #include "core/optimizer/label_encoder_fusion.h"
+#include "core/optimizer/loop_invariant_hoisting.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/matmul_bn_fusion.h"
 #include "core/optimizer/matmul_nbits_fusion.h"
+#include "core/optimizer/matmul_nbits_sibling_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
@@ -71,6 +75,7 @@
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_transformer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
@@ -119,6 +124,55 @@ TEST_F(GraphTransformationTests, IdentityElimination) {
   ASSERT_TRUE(op_to_count["Identity"] == 0);
 }
 
+// Reports a modification of the graph for the first num_modifications applications, without changing it.
+class ModifyingTransformer : public GraphTransformer {
+ public:
+  ModifyingTransformer(const std::string& name, int num_modifications)
+      : GraphTransformer(name), num_modifications_(num_modifications) {}
+
+  int NumApplied() const { return num_applied_; }
+
+ private:
+  Status ApplyImpl(Graph& /*graph*/, bool& modified, int /*graph_level*/, const logging::Logger&) const override {
+    ++num_applied_;
+    if (num_modifications_ > 0) {
+      --num_modifications_;
+      modified = true;
+    }
+    return Status::OK();
+  }
+
+  mutable int num_modifications_;
+  mutable int num_applied_ = 0;
+};
+
+TEST_F(GraphTransformationTests, TransformersSkippedOnUnmodifiedGraph) {
+  constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "abs-id-max.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger_));
+  Graph& graph = model->MainGraph();
+
+  auto first = std::make_unique<ModifyingTransformer>("First", 0);
+  auto second = std::make_unique<ModifyingTransformer>("Second", 2);
+  auto third = std::make_unique<ModifyingTransformer>("Third", 0);
+  const auto* first_ptr = first.get();
+  const auto* second_ptr = second.get();
+  const auto* third_ptr = third.get();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(first), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(second), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(third), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  // the second transformer modifies the graph in the first two steps and finds nothing to do in the third.
+  // the first transformer runs in every step as the graph was modified after it, the third transformer is skipped in
+  // the last step as nothing modified the graph since it ran in the second.
+  EXPECT_EQ(first_ptr->NumApplied(), 3);
+  EXPECT_EQ(second_ptr->NumApplied(), 3);
+  EXPECT_EQ(third_ptr->NumApplied(), 2);
+}
+
 TEST_F(GraphTransformationTests, IdentityEliminationWithGraphOutput) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "abs-id.onnx";
   std::shared_ptr<Model> model;
@@ -597,6 +651,66 @@ TEST_F(GraphTransformationTests, ConstantFolding) {
   ASSERT_TRUE(op_to_count["Unsqueeze"] == 0);
 }
 
+TEST_F(GraphTransformationTests, ConstantFoldingMemoryBudgetAndExternalDataFile) {
+  constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/fuse-conv-bn-mul-add-unsqueeze.onnx";
+  std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+
+  const auto fold = [&](const ConfigOptions& config_options, std::shared_ptr<Model>& model) {
+    ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger_));
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/, config_options),
+        TransformerLevel::Level1));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(model->MainGraph(), TransformerLevel::Level1,
+                                                                *logger_));
+  };
+
+  // nothing fits in a budget of one byte
+  {
+    ConfigOptions config_options;
+    ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsConstantFoldingMemoryBudget, "1"));
+    std::shared_ptr<Model> model;
+    fold(config_options, model);
+    ASSERT_EQ(CountOpsInGraph(model->MainGraph())["Unsqueeze"], 2);
+  }
+
+  // the folded initializers written to the external data file take no budget and match the ones kept in memory
+  std::shared_ptr<Model> expected_model;
+  fold(ConfigOptions{}, expected_model);
+
+  TemporaryDirectory temp_dir{ORT_TSTR("constant_folding_external_data")};
+  const std::string external_data_file =
+      PathToUTF8String((std::filesystem::absolute(temp_dir.Path()) / ORT_TSTR("folded.bin")).native());
+  ConfigOptions config_options;
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsConstantFoldingMemoryBudget, "1"));
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsConstantFoldingExternalDataFile,
+                                                 external_data_file.c_str()));
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsConstantFoldingExternalDataMinSizeInBytes, "0"));
+  std::shared_ptr<Model> model;
+  fold(config_options, model);
+  const Graph& graph = model->MainGraph();
+  ASSERT_EQ(CountOpsInGraph(graph)["Unsqueeze"], 0);
+
+  int num_external = 0;
+  for (const auto& [name, expected_proto] : expected_model->MainGraph().GetAllInitializedTensors()) {
+    const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+    ASSERT_TRUE(graph.GetInitializedTensor(name, tensor_proto)) << name;
+    if (utils::HasExternalData(*tensor_proto) && !utils::HasExternalData(*expected_proto)) {
+      ++num_external;
+    }
+
+    Initializer expected{*expected_proto, graph.ModelPath()};
+    Initializer actual{*tensor_proto, graph.ModelPath()};
+    ASSERT_EQ(expected.data_type(), actual.data_type()) << name;
+    ASSERT_TRUE(std::equal(expected.DataAsByteSpan().begin(), expected.DataAsByteSpan().end(),
+                           actual.DataAsByteSpan().begin(), actual.DataAsByteSpan().end()))
+        << name;
+  }
+
+  ASSERT_EQ(graph.GetAllInitializedTensors().size(), expected_model->MainGraph().GetAllInitializedTensors().size());
+  ASSERT_GT(num_external, 0);
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingNodesOnDifferentEP) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/fuse-conv-bn-mul-add-unsqueeze.onnx";
   std::shared_ptr<Model> model;
@@ -733,6 +847,77 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+TEST_F(GraphTransformationTests, LoopInvariantHoisting) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  TypeProto int64_scalar_type;
+  int64_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_scalar_type.mutable_tensor_type()->mutable_shape();
+  TypeProto bool_scalar_type;
+  bool_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar_type.mutable_tensor_type()->mutable_shape();
+
+  // body: acc_out = acc_in + x * x, where x comes from the main graph. x * x is loop invariant.
+  GraphProto body_proto;
+  {
+    Model model("LoopInvariantHoisting_body", false, ModelMetaData(), PathString(),
+                IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 16}}, {}, *logger_);
+    auto& body = model.MainGraph();
+
+    auto& iter_num = body.GetOrCreateNodeArg("iter_num", &int64_scalar_type);
+    auto& cond_in = body.GetOrCreateNodeArg("cond_in", &bool_scalar_type);
+    auto& acc_in = body.GetOrCreateNodeArg("acc_in", &float_tensor_type);
+    auto& x = body.GetOrCreateNodeArg("x", &float_tensor_type);
+    body.AddOuterScopeNodeArg("x");
+
+    auto& x_squared = body.GetOrCreateNodeArg("x_squared", &float_tensor_type);
+    body.AddNode("mul", "Mul", "loop invariant", {&x, &x}, {&x_squared});
+    auto& acc_out = body.GetOrCreateNodeArg("acc_out", &float_tensor_type);
+    body.AddNode("add", "Add", "depends on the loop carried value", {&acc_in, &x_squared}, {&acc_out});
+    auto& cond_out = body.GetOrCreateNodeArg("cond_out", &bool_scalar_type);
+    body.AddNode("identity", "Identity", "", {&cond_in}, {&cond_out});
+
+    body.SetInputs({&iter_num, &cond_in, &acc_in});
+    body.SetOutputs({&cond_out, &acc_out});
+    ASSERT_STATUS_OK(body.Resolve());
+    body_proto = body.ToGraphProto();
+  }
+
+  Model model("LoopInvariantHoisting_main_graph", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 16}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+  auto& trip_count = graph.GetOrCreateNodeArg("trip_count", &int64_scalar_type);
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_scalar_type);
+  auto& acc = graph.GetOrCreateNodeArg("acc", &float_tensor_type);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+  auto& loop_out = graph.GetOrCreateNodeArg("loop_out", &float_tensor_type);
+  auto& loop_node = graph.AddNode("loop", "Loop", "", {&trip_count, &cond, &acc}, {&loop_out});
+  loop_node.AddAttribute("body", body_proto);
+  graph.SetInputs({&trip_count, &cond, &acc, &x});
+  graph.SetOutputs({&loop_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ASSERT_EQ(CountOpsInGraph(graph, false)["Mul"], 0);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<LoopInvariantHoisting>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  // Mul moved to the main graph, Add stays in the body
+  auto op_to_count = CountOpsInGraph(graph, false);
+  EXPECT_EQ(op_to_count["Mul"], 1);
+  op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Mul"], 1);
+  EXPECT_EQ(op_to_count["Add"], 1);
+
+  // the body reads the hoisted value as an implicit input of the Loop
+  const auto& implicit_inputs = graph.GetNode(loop_node.Index())->ImplicitInputDefs();
+  EXPECT_TRUE(std::any_of(implicit_inputs.begin(), implicit_inputs.end(),
+                          [](const NodeArg* arg) { return arg->Name() == "x_squared"; }));
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingWithShapeToInitializer) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/constant_folding_with_shape_to_initializer.onnx";
   std::shared_ptr<Model> model;
@@ -7827,6 +8012,162 @@ TEST_F(GraphTransformationTests, MatMulNBitsBiasFusion) {
   }
 }
 
+TEST_F(GraphTransformationTests, MatMulNBitsSiblingFusion) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    constexpr size_t qbits = 4;
+    constexpr size_t block_size = 32;
+
+    constexpr int64_t M = 2, K = 64;
+
+    auto* A = builder.MakeInput<float>(std::vector{M, K}, "A");
+
+    // siblings with different N, e.g. the Q and K projections of grouped query attention
+    for (int64_t N : {16, 8}) {
+      size_t q_data_size_in_bytes, q_scale_size, q_zp_size_in_bytes;
+      MlasBlockwiseQuantizedBufferSizes(qbits, block_size, /* columnwise */ true,
+                                        K, N,
+                                        q_data_size_in_bytes, q_scale_size, &q_zp_size_in_bytes);
+
+      auto* B_data = builder.MakeInitializer<uint8_t>({N, K / static_cast<int64_t>(block_size),
+                                                       static_cast<int64_t>(block_size * qbits / 8)},
+                                                      uint8_t{0}, uint8_t{255});
+      auto* B_scales = builder.MakeInitializer<float>({static_cast<int64_t>(q_scale_size)},
+                                                      1.0f, 2.0f);
+      auto* B_zero_points = builder.MakeInitializer<uint8_t>({static_cast<int64_t>(q_zp_size_in_bytes)},
+                                                             uint8_t{0}, uint8_t{255});
+
+      auto& matmul = builder.AddNode("MatMulNBits",
+                                     {A, B_data, B_scales, B_zero_points},
+                                     {builder.MakeOutput()},
+                                     kMSDomain);
+      matmul.AddAttribute("N", N);
+      matmul.AddAttribute("K", K);
+      matmul.AddAttribute("block_size", static_cast<int64_t>(block_size));
+      matmul.AddAttribute("bits", static_cast<int64_t>(qbits));
+      matmul.AddAttribute("accuracy_level", static_cast<int64_t>(4));
+    }
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    auto op_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_count["com.microsoft.MatMulNBits"], 2);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_count["com.microsoft.MatMulNBits"], 1);
+    EXPECT_EQ(op_count["Split"], 1);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMulNBits") {
+        EXPECT_EQ(node.GetAttributes().at("N").i(), 24);
+        EXPECT_EQ(node.InputDefs()[1]->Shape()->dim(0).dim_value(), 24);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 21, *logger_, std::make_unique<MatMulNBitsSiblingFusion>(),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+}
+
+
+#if defined(ORT_USE_NCCL)
+TEST_F(GraphTransformationTests, TensorParallelMatMulPair) {
+  // W1 is [4, 4] with the value 10 * row + column, W2 is [4, 2] with the value 10 * row + column.
+  std::vector<float> w1_data;
+  for (int row = 0; row < 4; ++row) {
+    for (int column = 0; column < 4; ++column) {
+      w1_data.push_back(static_cast<float>(10 * row + column));
+    }
+  }
+  std::vector<float> w2_data{0.f, 1.f, 10.f, 11.f, 20.f, 21.f, 30.f, 31.f};
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{2, 4}});
+    auto* w1_arg = builder.MakeInitializer<float>({4, 4}, w1_data);
+    auto* bias_arg = builder.MakeInitializer<float>({4}, {0.f, 1.f, 2.f, 3.f});
+    auto* w2_arg = builder.MakeInitializer<float>({4, 2}, w2_data);
+    auto* matmul1_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input_arg, w1_arg}, {matmul1_out});
+    builder.AddNode("Add", {matmul1_out, bias_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("MatMul", {relu_out, w2_arg}, {output_arg});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["com.microsoft.AllReduce"] == 1);
+    TEST_RETURN_IF_NOT(op_count_map["com.microsoft.AllGather"] == 0);
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMul" || node.OpType() == "Add") {
+        const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+        TEST_RETURN_IF_NOT(tensor_proto != nullptr);
+        Initializer shard{*tensor_proto, graph.ModelPath()};
+        const auto values = shard.DataAsSpan<float>();
+        if (node.OpType() == "Add") {
+          // rank 1 of 2 keeps the bias of the columns [2, 4)
+          TEST_RETURN_IF_NOT(values.size() == 2 && values[0] == 2.f && values[1] == 3.f);
+        } else if (graph.GetProducerNode(node.InputDefs()[0]->Name()) == nullptr) {
+          // the columns [2, 4) of W1
+          TEST_RETURN_IF_NOT(shard.dims()[0] == 4 && shard.dims()[1] == 2);
+          TEST_RETURN_IF_NOT(values[0] == 2.f && values[1] == 3.f && values[2] == 12.f && values[7] == 33.f);
+        } else {
+          // the rows [2, 4) of W2
+          TEST_RETURN_IF_NOT(shard.dims()[0] == 2 && shard.dims()[1] == 2);
+          TEST_RETURN_IF_NOT(values[0] == 20.f && values[3] == 31.f);
+        }
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_,
+                                        std::make_unique<TensorParallelTransformer>(1, 2), TransformerLevel::Level1, 2,
+                                        nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, TensorParallelMatMulColumns) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{2, 3, 4}});
+    auto* weight_arg = builder.MakeInitializer<float>({4, 6}, -1.f, 1.f);
+    // not divisible by the world size
+    auto* odd_weight_arg = builder.MakeInitializer<float>({6, 3}, -1.f, 1.f);
+    auto* matmul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input_arg, weight_arg}, {matmul_out});
+    builder.AddNode("MatMul", {matmul_out, odd_weight_arg}, {output_arg});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["com.microsoft.AllReduce"] == 0);
+    TEST_RETURN_IF_NOT(op_count_map["com.microsoft.AllGather"] == 1);
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "AllGather") {
+        TEST_RETURN_IF_NOT(node.GetAttributes().at("axis").i() == 2);
+        TEST_RETURN_IF_NOT(node.GetAttributes().at("group_size").i() == 2);
+        const Node* producer = graph.GetProducerNode(node.InputDefs()[0]->Name());
+        TEST_RETURN_IF_NOT(producer != nullptr && producer->OpType() == "MatMul");
+        const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, producer->InputDefs()[1]->Name());
+        TEST_RETURN_IF_NOT(tensor_proto != nullptr && tensor_proto->dims(1) == 3);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_,
+                                        std::make_unique<TensorParallelTransformer>(0, 2), TransformerLevel::Level1, 2,
+                                        nullptr, post_graph_checker));
+}
+#endif  // defined(ORT_USE_NCCL)
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 }  // namespace test
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+#if defined(USE_CUDA) && !defined(DISABLE_CONTRIB_OPS)
+
+namespace {
+void RunMatMulBiasActivationFusionTest(const std::function<void(ModelTestBuilder& builder)>& build_test_case) {
+  auto ep = DefaultCudaExecutionProvider();
+  if (ep == nullptr) {
+    GTEST_SKIP() << "CUDA execution provider is not available";
+  }
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedMatMulActivation"], 1);
+    EXPECT_EQ(op_to_count["MatMul"], 0);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["com.microsoft.FastGelu"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 14,
+                    1e-4, 1e-4, nullptr, {}, {}, std::move(ep));
+}
+}  // namespace
+
+TEST(MatMulBiasActivationFusionTests, MatMulAddRelu) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x = builder.MakeInput<float>({2, 8, 64}, -1.f, 1.f);
+    auto* matmul_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {x, builder.MakeInitializer<float>({64, 32}, -1.f, 1.f)}, {matmul_out});
+    builder.AddNode("Add", {builder.MakeInitializer<float>({32}, -1.f, 1.f), matmul_out}, {add_out});
+    builder.AddNode("Relu", {add_out}, {output});
+  };
+
+  RunMatMulBiasActivationFusionTest(build_test_case);
+}
+
+TEST(MatMulBiasActivationFusionTests, MatMulFastGeluWithBias) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x = builder.MakeInput<float>({16, 48}, -1.f, 1.f);
+    auto* matmul_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {x, builder.MakeInitializer<float>({48, 40}, -1.f, 1.f)}, {matmul_out});
+    builder.AddNode("FastGelu", {matmul_out, builder.MakeInitializer<float>({40}, -1.f, 1.f)}, {output},
+                    kMSDomain);
+  };
+
+  RunMatMulBiasActivationFusionTest(build_test_case);
+}
+
+#endif  // defined(USE_CUDA) && !defined(DISABLE_CONTRIB_OPS)
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+// Scaled dot product attention as exported for decoder models, with query, key and value in BNSH format.
+void BuildScaledDotProductAttention(ModelTestBuilder& builder, bool scale_query, bool with_mask) {
+  constexpr int64_t batch_size = 2, num_heads = 4, sequence_length = 5, head_size = 8;
+  auto* query = builder.MakeInput<float>({batch_size, num_heads, sequence_length, head_size}, -1.f, 1.f);
+  auto* key = builder.MakeInput<float>({batch_size, num_heads, sequence_length, head_size}, -1.f, 1.f);
+  auto* value = builder.MakeInput<float>({batch_size, num_heads, sequence_length, head_size}, -1.f, 1.f);
+
+  auto* key_transposed = builder.MakeIntermediate();
+  builder.AddNode("Transpose", {key}, {key_transposed}).AddAttribute("perm", std::vector<int64_t>{0, 1, 3, 2});
+
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  auto* scores = builder.MakeIntermediate();
+  if (scale_query) {
+    auto* scaled_query = builder.MakeIntermediate();
+    builder.AddNode("Mul", {builder.MakeScalarInitializer<float>(scale), query}, {scaled_query});
+    builder.AddNode("MatMul", {scaled_query, key_transposed}, {scores});
+  } else {
+    auto* unscaled_scores = builder.MakeIntermediate();
+    builder.AddNode("MatMul", {query, key_transposed}, {unscaled_scores});
+    builder.AddNode("Div", {unscaled_scores, builder.MakeScalarInitializer<float>(1.0f / scale)}, {scores});
+  }
+
+  auto* softmax_input = scores;
+  if (with_mask) {
+    auto* mask = builder.MakeInput<float>({1, 1, sequence_length, sequence_length}, -10.f, 0.f);
+    softmax_input = builder.MakeIntermediate();
+    builder.AddNode("Add", {mask, scores}, {softmax_input});
+  }
+
+  auto* probs = builder.MakeIntermediate();
+  auto* context = builder.MakeIntermediate();
+  auto* context_bsnh = builder.MakeIntermediate();
+  auto* output = builder.MakeOutput();
+  builder.AddNode("Softmax", {softmax_input}, {probs}).AddAttribute("axis", int64_t{-1});
+  builder.AddNode("MatMul", {probs, value}, {context});
+  builder.AddNode("Transpose", {context}, {context_bsnh}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+  builder.AddNode("Reshape", {context_bsnh, builder.Make1DInitializer<int64_t>({0, 0, num_heads * head_size})},
+                  {output});
+}
+
+void RunMultiHeadAttentionFusionTest(bool scale_query, bool with_mask) {
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.MultiHeadAttention"], 1);
+    EXPECT_EQ(op_to_count["Softmax"], 0);
+    EXPECT_EQ(op_to_count["MatMul"], 0);
+  };
+
+  TransformerTester([&](ModelTestBuilder& builder) { BuildScaledDotProductAttention(builder, scale_query, with_mask); },
+                    check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 14, 1e-5, 1e-5);
+}
+}  // namespace
+
+TEST(MultiHeadAttentionFusionTests, ScaledScoresWithMask) {
+  RunMultiHeadAttentionFusionTest(false, true);
+}
+
+TEST(MultiHeadAttentionFusionTests, ScaledQueryWithoutMask) {
+  RunMultiHeadAttentionFusionTest(true, false);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -8,6 +8,8 @@
 #include "graph_transform_test_builder.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -516,6 +518,49 @@ TEST(NhwcTransformerTests, ConvMixTensorRanks) {
                     TransformerLevel::Level3);
 }
 
+TEST(NhwcTransformerTests, ConvDepthwiseFloat) {
+  auto test_case = [&](bool enable_nhwc_float_conv) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({1, 24, 14, 14}, -1.0f, 1.0f);
+      auto* conv1_output_arg = builder.MakeIntermediate();
+      auto* conv2_weight_arg = builder.MakeInitializer<float>({40, 24, 1, 1}, -1.0f, 1.0f);
+      auto* output_arg = builder.MakeOutput();
+      auto* conv1_weight_arg = builder.MakeInitializer<float>({24, 1, 3, 3}, -1.0f, 1.0f);
+
+      Node& conv1_node = builder.AddConvNode(input_arg, conv1_weight_arg, conv1_output_arg);
+      conv1_node.AddAttribute("group", static_cast<int64_t>(24));
+      conv1_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+      builder.AddConvNode(conv1_output_arg, conv2_weight_arg, output_arg);
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], enable_nhwc_float_conv ? 2 : 0);
+      EXPECT_EQ(op_to_count["Transpose"], enable_nhwc_float_conv ? 2 : 0);
+    };
+
+    auto add_session_options = [&](SessionOptions& so) {
+      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableNhwcFloatConv,
+                                                        enable_nhwc_float_conv ? "1" : "0"));
+    };
+
+    // the NCHWc transformer would take the convolutions first on the platforms that have NCHWc kernels
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12,
+                      1e-4,
+                      1e-4,
+                      nullptr,
+                      add_session_options,
+                      {"NchwcTransformer"});
+  };
+
+  test_case(true);
+  test_case(false);
+}
+
 #ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
 
 static std::vector<MLFloat16> ARangeOfFP16Values(const std::vector<int64_t>& shape, MLFloat16 min, MLFloat16 max) {
@@ -7,11 +7,13 @@
 #include "core/framework/compute_capability.h"
 #include "core/framework/node_unit.h"
 #include "core/framework/int4.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/graph/model.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
+#include "core/optimizer/qdq_transformer/qdq_float8_gemm_fusion.h"
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selector_action_transformer.h"
@@ -143,6 +145,66 @@ TEST(QDQTransformerTests, Conv_S8X8S8) {
   QDQTransformerConvTests<int8_t, int8_t, int32_t, int8_t>();
 }
 
+// 4-bit weights are widened to 8 bits so the group still becomes a QLinearConv
+template <typename WeightType>
+void QDQTransformerConvInt4WeightTest(bool per_channel) {
+  auto build_test_case = [per_channel](ModelTestBuilder& builder) {
+    constexpr int64_t output_channels = 16;
+    auto* input_arg = builder.MakeInput<float>({1, 12, 13, 13}, -1.f, 1.f);
+    auto* output_arg = builder.MakeOutput();
+
+    using UnpackedType = typename WeightType::UnpackedType;
+    const WeightType weight_zp(static_cast<UnpackedType>((WeightType::min_val + WeightType::max_val) / 2 + 1), 0);
+    auto* weight = builder.MakeInitializer<WeightType>({output_channels, 12, 3, 3},
+                                                       WeightType(WeightType::min_val, 0),
+                                                       WeightType(WeightType::max_val, 0));
+    auto* dq_w_output = builder.MakeIntermediate();
+    if (per_channel) {
+      std::vector<float> scales(output_channels);
+      for (size_t i = 0; i < scales.size(); ++i) {
+        scales[i] = 0.02f + 0.001f * static_cast<float>(i);
+      }
+      std::vector<WeightType> zero_points(WeightType::CalcNumInt4Pairs(output_channels),
+                                          WeightType(weight_zp.GetElem(0), weight_zp.GetElem(0)));
+      auto& dq_w_node = builder.AddDequantizeLinearNode<WeightType>(weight, scales, zero_points, dq_w_output);
+      dq_w_node.AddAttribute("axis", static_cast<int64_t>(0));
+    } else {
+      builder.AddDequantizeLinearNode<WeightType>(weight, .03f, weight_zp, dq_w_output);
+    }
+
+    auto* conv_output = builder.MakeIntermediate();
+    auto* dq_output = AddQDQNodePair<uint8_t>(builder, input_arg, .04f, 128);
+    builder.AddNode("Conv", {dq_output, dq_w_output}, {conv_output});
+
+    auto* q_output = builder.MakeIntermediate();
+    builder.AddQuantizeLinearNode<uint8_t>(conv_output, .039f, 128, q_output);
+    builder.AddDequantizeLinearNode<uint8_t>(q_output, .039f, 128, output_arg);
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["QLinearConv"], 1);
+    EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+    EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    21 /*opset_version*/,
+                    0.01 /*per_sample_tolerance*/,
+                    0.01 /*relative_per_sample_tolerance*/,
+                    std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+}
+
+TEST(QDQTransformerTests, Conv_U8X4U8) {
+  QDQTransformerConvInt4WeightTest<Int4x2>(false);
+  QDQTransformerConvInt4WeightTest<Int4x2>(true);
+  QDQTransformerConvInt4WeightTest<UInt4x2>(false);
+  QDQTransformerConvInt4WeightTest<UInt4x2>(true);
+}
+
 TEST(QDQTransformerTests, ConvMaxPoolReshape_UInt8) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
                        int opset_version, bool use_contrib_qdq = false) {
@@ -3340,6 +3402,44 @@ TEST(QDQTransformerTests, Softmax_U8U8) {
   QDQTransformerSoftmaxTests<uint8_t, uint8_t>();
 }
 
+template <typename QuantType>
+void QDQTransformerUnaryLookupTableTests(const std::string& op_type) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 12, 37}, -2.f, 2.f);
+    auto* output_arg = builder.MakeOutput();
+    auto* dq_output = AddQDQNodePair<QuantType>(builder, input_arg, .02f, 0);
+    auto* op_output = builder.MakeIntermediate();
+    builder.AddNode(op_type, {dq_output}, {op_output});
+    auto* q_output = builder.MakeIntermediate();
+    builder.AddQuantizeLinearNode<QuantType>(op_output, .04f, 0, q_output);
+    builder.AddDequantizeLinearNode<QuantType>(q_output, .04f, 0, output_arg);
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearUnary"], 1);
+    EXPECT_EQ(op_to_count[op_type], 0);
+    EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+    EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    18 /*opset_version*/,
+                    0.01 /*per_sample_tolerance*/,
+                    0.01 /*relative_per_sample_tolerance*/,
+                    std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+}
+
+TEST(QDQTransformerTests, UnaryLookupTable) {
+  QDQTransformerUnaryLookupTableTests<uint8_t>("Tanh");
+  QDQTransformerUnaryLookupTableTests<int8_t>("Tanh");
+  QDQTransformerUnaryLookupTableTests<uint8_t>("Exp");
+  QDQTransformerUnaryLookupTableTests<int8_t>("Softplus");
+}
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 TEST(QDQTransformerTests, QDQPropagation_QBackward) {
@@ -4846,5 +4946,75 @@ TEST(QDQTransformerTests, DropDQSelectorWithDQProducingGraphOutput) {
 }
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
+
+#if !defined(DISABLE_CONTRIB_OPS) && !defined(DISABLE_FLOAT8_TYPES)
+// Float8 DQ -> MatMul assigned to CUDA is rewritten to GemmFloat8 with a transposed copy of B.
+// Only the graph is checked as GemmFloat8 has no CPU kernel.
+TEST(QDQTransformerTests, Float8GemmFusion) {
+  auto test_case = [](bool zero_point_is_zero) {
+    const std::vector<Float8E4M3FN> b_data = {Float8E4M3FN(1.0f), Float8E4M3FN(2.0f), Float8E4M3FN(3.0f),
+                                              Float8E4M3FN(4.0f), Float8E4M3FN(5.0f), Float8E4M3FN(6.0f)};
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* a = builder.MakeInput<Float8E4M3FN>(std::vector<int64_t>{4, 2});
+      auto* b = builder.MakeInitializer<Float8E4M3FN>({2, 3}, b_data);
+      auto* a_zero_point = builder.MakeScalarInitializer<Float8E4M3FN>(Float8E4M3FN(zero_point_is_zero ? 0.0f : 1.0f));
+      auto* dq_a_output = builder.MakeIntermediate<float>(std::vector<int64_t>{4, 2});
+      auto* dq_b_output = builder.MakeIntermediate<float>(std::vector<int64_t>{2, 3});
+      auto* output = builder.MakeOutput();
+
+      builder.AddNode("DequantizeLinear", {a, builder.MakeScalarInitializer<float>(0.5f), a_zero_point}, {dq_a_output});
+      builder.AddNode("DequantizeLinear", {b, builder.MakeScalarInitializer<float>(0.25f)}, {dq_b_output});
+      builder.AddNode("MatMul", {dq_a_output, dq_b_output}, {output});
+    };
+
+    auto pre_graph_checker = [](Graph& graph) {
+      for (auto& node : graph.Nodes()) {
+        node.SetExecutionProviderType(kCudaExecutionProvider);
+      }
+      return Status::OK();
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      if (!zero_point_is_zero) {
+        TEST_RETURN_IF_NOT(op_to_count["com.microsoft.GemmFloat8"] == 0);
+        TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 1);
+        return Status::OK();
+      }
+
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.GemmFloat8"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["DequantizeLinear"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 0);
+
+      for (const Node& node : graph.Nodes()) {
+        if (node.OpType() != "GemmFloat8") {
+          continue;
+        }
+
+        TEST_RETURN_IF_NOT(node.GetAttributes().at("transB").i() == 1);
+        const ONNX_NAMESPACE::TensorProto* b_proto = graph.GetConstantInitializer(node.InputDefs()[1]->Name(), true);
+        TEST_RETURN_IF_NOT(b_proto != nullptr);
+        TEST_RETURN_IF_NOT(b_proto->dims_size() == 2 && b_proto->dims(0) == 3 && b_proto->dims(1) == 2);
+
+        std::vector<uint8_t> transposed;
+        ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(*b_proto, graph.ModelPath(), transposed));
+        const std::vector<uint8_t> expected = {b_data[0].val, b_data[3].val, b_data[1].val,
+                                               b_data[4].val, b_data[2].val, b_data[5].val};
+        TEST_RETURN_IF_NOT(transposed == expected);
+      }
+
+      return Status::OK();
+    };
+
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 19, DefaultLoggingManager().DefaultLogger(),
+                                          std::make_unique<QDQFloat8GemmFusion>(), TransformerLevel::Level2, 1,
+                                          pre_graph_checker, post_graph_checker));
+  };
+
+  test_case(true);
+  test_case(false);
+}
+#endif  // !defined(DISABLE_CONTRIB_OPS) && !defined(DISABLE_FLOAT8_TYPES)
+
 }  // namespace test
 }  // namespace onnxruntime
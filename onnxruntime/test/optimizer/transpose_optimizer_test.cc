@@ -572,6 +572,38 @@ TEST(TransposeOptimizerTests, TestAdd) {
                     /*opset_version*/ {15, 18});
 }
 
+// Pushing the Transpose through the Add alone doesn't reduce the cost as the other input needs a Transpose, but it
+// cancels with the Transpose after the Relu, which the layout assignment of the region sees.
+TEST(TransposeOptimizerTests, TestLayoutAssignmentThroughBranchMerge) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = builder.MakeInput<float>({4, 6, 10}, 0.0, 1.0);
+    auto* input1_arg = builder.MakeInput<float>({6, 10, 4}, 0.0, 1.0);
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* add_1_out_0 = builder.MakeIntermediate();
+    auto* relu_1_out_0 = builder.MakeIntermediate();
+    auto* transpose_2_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{1, 2, 0});
+    builder.AddNode("Add", {transpose_1_out_0, input1_arg}, {add_1_out_0});
+    builder.AddNode("Relu", {add_1_out_0}, {relu_1_out_0});
+    auto& transpose_2 = builder.AddNode("Transpose", {relu_1_out_0}, {transpose_2_out_0});
+    transpose_2.AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    // only the Transpose of input1 is left
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 3);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ {15, 18});
+}
+
 TEST(TransposeOptimizerTests, TestShape) {
   auto build_test_case_1 = [&](ModelTestBuilder& builder) {
     auto* input0_arg = MakeInput<float>(builder, {{-1, 6, -1}}, {4, 6, 10}, 0.0, 1.0);
@@ -32,8 +32,9 @@ namespace perftest {
   printf(
       "perf_test [options...] model_path [result_file]\n"
       "Options:\n"
-      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration' or 'times'.\n"
+      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration', 'times', 'load' or 'ops'.\n"
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
+      "\t\t'load' and 'ops' are described below.\n"
       "\t-M: Disable memory pattern.\n"
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
@@ -116,6 +117,7 @@ namespace perftest {
       "\t    [TensorRT only] [trt_engine_cache_path]: Specify engine cache path.\n"
       "\t    [TensorRT only] [trt_engine_cache_prefix]: Customize engine cache prefix when trt_engine_cache_enable is true.\n"
       "\t    [TensorRT only] [trt_engine_hw_compatible]: Enable hardware compatibility. Engines ending with '_sm80+' can be re-used across all Ampere+ GPU (a hardware-compatible engine may have lower throughput and/or higher latency than its non-hardware-compatible counterpart).\n"
+      "\t    [TensorRT only] [trt_widen_profile_ranges]: Widen the dynamic dimensions of a rebuilt engine's profile to the enclosing power of 2 range, so that nearby input shapes don't trigger more engine rebuilds.\n"
       "\t    [TensorRT only] [trt_weight_stripped_engine_enable]: Enable weight-stripped engine build.\n"
       "\t    [TensorRT only] [trt_onnx_model_folder_path]: Folder path for the ONNX model with weights.\n"
       "\t    [TensorRT only] [trt_force_sequential_engine_build]: Force TensorRT engines to be built sequentially.\n"
@@ -130,6 +132,7 @@ namespace perftest {
       "\t    [Example] [For NNAPI EP] -e nnapi -i \"NNAPI_FLAG_USE_FP16 NNAPI_FLAG_USE_NCHW NNAPI_FLAG_CPU_DISABLED\"\n"
       "\n"
       "\t    [CoreML only] [COREML_FLAG_CREATE_MLPROGRAM COREML_FLAG_USE_CPU_ONLY COREML_FLAG_USE_CPU_AND_GPU]: Create an ML Program model instead of Neural Network.\n"
+      "\t    [CoreML only] [COREML_FLAG_ENABLE_MODEL_CACHE]: Reuse the compiled CoreML models of previous runs.\n"
       "\t    [Example] [For CoreML EP] -e coreml -i \"COREML_FLAG_CREATE_MLPROGRAM\"\n"
       "\n"
       "\t    [SNPE only] [runtime]: SNPE runtime, options: 'CPU', 'GPU', 'GPU_FLOAT16', 'DSP', 'AIP_FIXED_TF'. \n"
@@ -148,6 +151,24 @@ namespace perftest {
       "\t-n [Exit after session creation]: allow user to measure session creation time to measure impact of enabling any initialization optimizations.\n"
       "\t-l Provide file as binary in memory by using fopen before session creation.\n"
       "\t-R [Register custom op]: allow user to register custom op by .so or .dll file.\n"
+      "\n"
+      "\tLoad mode (-m load) options:\n"
+      "\t  Requests arrive as a Poisson process and are served by -c workers; each request runs one of the sessions.\n"
+      "\t  Latency is measured from the arrival of a request, so it includes the time the request waited for a worker.\n"
+      "\t  The measured phase lasts -t seconds.\n"
+      "\t-Q [requests_per_second]: Mean arrival rate of the requests. 0 runs closed loop, each worker issuing its next\n"
+      "\t    request as soon as the previous one finished. Default:0.\n"
+      "\t-W [warmup_seconds]: Seconds to run the load before the measured phase. Default:0.\n"
+      "\t-N [sessions_per_model]: Number of sessions created for each model. Default:1.\n"
+      "\t-L [model_path]: Additional model to load. Can be repeated.\n"
+      "\t-J [json_file]: Write the latency and throughput report of each session as JSON to this file.\n"
+      "\n"
+      "\tOp benchmark mode (-m ops):\n"
+      "\t  Runs every node of the model on its own, fed with the inputs it saw in a run of the first test data set,\n"
+      "\t  -r times each, and prints the nodes ranked by their median latency. The result_file gets the table as CSV.\n"
+      "\t  Pass a model saved with -u to benchmark the fused nodes produced by the graph optimizers.\n"
+      "\t-K [thread_counts]: Comma separated intra op thread counts to benchmark each node with, e.g. 1,2,4.\n"
+      "\t    0 uses the -x setting. Default:0.\n"
       "\t-h: help\n");
 }
 #ifdef _WIN32
@@ -210,7 +231,7 @@ static bool ParseSessionConfigs(const std::string& configs_string,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:AMPIDZvhsqznlR:"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:Q:W:N:L:J:K:AMPIDZvhsqznlR:"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -235,6 +256,10 @@ static bool ParseSessionConfigs(const std::string& configs_string,
           test_config.run_config.test_mode = TestMode::kFixDurationMode;
         } else if (!CompareCString(optarg, ORT_TSTR("times"))) {
           test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+        } else if (!CompareCString(optarg, ORT_TSTR("load"))) {
+          test_config.run_config.test_mode = TestMode::kLoadMode;
+        } else if (!CompareCString(optarg, ORT_TSTR("ops"))) {
+          test_config.run_config.test_mode = TestMode::kOpBenchmarkMode;
         } else {
           return false;
         }
@@ -301,7 +326,10 @@ static bool ParseSessionConfigs(const std::string& configs_string,
         if (test_config.run_config.repeated_times <= 0) {
           return false;
         }
-        test_config.run_config.test_mode = TestMode::kFixDurationMode;
+        // -t is also the length of the measured phase in load mode
+        if (test_config.run_config.test_mode != TestMode::kLoadMode) {
+          test_config.run_config.test_mode = TestMode::kFixDurationMode;
+        }
         break;
       case 's':
         test_config.run_config.f_dump_statistics = true;
@@ -402,6 +430,49 @@ static bool ParseSessionConfigs(const std::string& configs_string,
       case 'R':
         test_config.run_config.register_custom_op_path = optarg;
         break;
+      case 'Q': {
+        ORT_TRY {
+          test_config.run_config.requests_per_second = std::stod(ToUTF8String(optarg));
+        }
+        ORT_CATCH(...) {
+          return false;
+        }
+        if (test_config.run_config.requests_per_second < 0) {
+          return false;
+        }
+        break;
+      }
+      case 'W':
+        test_config.run_config.warmup_seconds = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        break;
+      case 'N':
+        test_config.run_config.sessions_per_model = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        if (test_config.run_config.sessions_per_model == 0) {
+          return false;
+        }
+        break;
+      case 'L':
+        test_config.run_config.additional_model_paths.emplace_back(optarg);
+        break;
+      case 'J':
+        test_config.run_config.load_result_json_path = optarg;
+        break;
+      case 'K': {
+        std::istringstream ss(ToUTF8String(optarg));
+        std::string token;
+        while (std::getline(ss, token, ',')) {
+          ORT_TRY {
+            test_config.run_config.op_thread_counts.push_back(std::stoi(token));
+          }
+          ORT_CATCH(...) {
+            return false;
+          }
+          if (test_config.run_config.op_thread_counts.back() < 0) {
+            return false;
+          }
+        }
+        break;
+      }
       case '?':
       case 'h':
       default:
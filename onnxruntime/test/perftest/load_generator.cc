@@ -0,0 +1,313 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "load_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace onnxruntime {
+namespace perftest {
+
+namespace {
+
+struct Summary {
+  size_t count{0};
+  double mean{0};
+  double min{0};
+  double p50{0};
+  double p90{0};
+  double p99{0};
+  double p999{0};
+  double max{0};
+};
+
+// nearest rank
+double Percentile(const std::vector<double>& sorted, double p) {
+  const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+  return sorted[std::min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+Summary Summarize(std::vector<double> values) {
+  Summary summary;
+  summary.count = values.size();
+  if (values.empty()) {
+    return summary;
+  }
+
+  std::sort(values.begin(), values.end());
+  summary.mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+  summary.min = values.front();
+  summary.p50 = Percentile(values, 0.5);
+  summary.p90 = Percentile(values, 0.9);
+  summary.p99 = Percentile(values, 0.99);
+  summary.p999 = Percentile(values, 0.999);
+  summary.max = values.back();
+  return summary;
+}
+
+// upper bounds of the latency histogram buckets in ms, 1-2-5 steps from 10us to 100s
+const std::vector<double>& HistogramBounds() {
+  static const std::vector<double> bounds = []() {
+    std::vector<double> result;
+    for (double decade = 0.01; decade < 1e5; decade *= 10) {
+      result.push_back(decade);
+      result.push_back(2 * decade);
+      result.push_back(5 * decade);
+    }
+    result.push_back(1e5);
+    return result;
+  }();
+  return bounds;
+}
+
+// the last bucket counts the latencies above the last bound
+std::vector<size_t> Histogram(const std::vector<double>& latencies) {
+  const auto& bounds = HistogramBounds();
+  std::vector<size_t> counts(bounds.size() + 1, 0);
+  for (double latency : latencies) {
+    const auto it = std::lower_bound(bounds.begin(), bounds.end(), latency * 1000);
+    ++counts[it - bounds.begin()];
+  }
+  return counts;
+}
+
+void PrintResult(const std::string& name, const LoadResult& result, double seconds) {
+  const Summary latency = Summarize(result.latencies);
+  std::cout << name << ": " << latency.count << " requests";
+  if (result.failed_requests > 0) {
+    std::cout << " (" << result.failed_requests << " failed)";
+  }
+  std::cout << ", " << latency.count / seconds << " req/s\n";
+  if (latency.count > 0) {
+    std::cout << "\tLatency (ms): mean " << latency.mean * 1000 << ", p50 " << latency.p50 * 1000
+              << ", p90 " << latency.p90 * 1000 << ", p99 " << latency.p99 * 1000
+              << ", p999 " << latency.p999 * 1000 << ", max " << latency.max * 1000 << "\n";
+    const Summary service_time = Summarize(result.service_times);
+    std::cout << "\tService time (ms): mean " << service_time.mean * 1000 << ", p50 " << service_time.p50 * 1000
+              << ", p99 " << service_time.p99 * 1000 << "\n";
+  }
+}
+
+void WriteJsonString(std::ostream& out, const std::string& value) {
+  out << '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+void WriteSummaryJson(std::ostream& out, const Summary& summary) {
+  out << "{\"mean\": " << summary.mean * 1000 << ", \"min\": " << summary.min * 1000
+      << ", \"p50\": " << summary.p50 * 1000 << ", \"p90\": " << summary.p90 * 1000
+      << ", \"p99\": " << summary.p99 * 1000 << ", \"p999\": " << summary.p999 * 1000
+      << ", \"max\": " << summary.max * 1000 << "}";
+}
+
+template <typename T>
+void WriteJsonArray(std::ostream& out, const std::vector<T>& values) {
+  out << "[";
+  for (size_t i = 0; i < values.size(); ++i) {
+    out << (i > 0 ? ", " : "") << values[i];
+  }
+  out << "]";
+}
+
+void WriteResultJson(std::ostream& out, const LoadResult& result, double seconds) {
+  const Summary latency = Summarize(result.latencies);
+  out << "\"requests\": " << latency.count << ", \"failed_requests\": " << result.failed_requests
+      << ", \"throughput_rps\": " << latency.count / seconds << ",\n      \"latency_ms\": ";
+  WriteSummaryJson(out, latency);
+  out << ",\n      \"service_time_ms\": ";
+  WriteSummaryJson(out, Summarize(result.service_times));
+  out << ",\n      \"latency_histogram_ms\": {\"bounds\": ";
+  WriteJsonArray(out, HistogramBounds());
+  out << ", \"counts\": ";
+  WriteJsonArray(out, Histogram(result.latencies));
+  out << "}";
+}
+
+LoadResult Merge(const std::vector<LoadResult>& results) {
+  LoadResult merged;
+  merged.model_name = "all";
+  for (const auto& result : results) {
+    merged.latencies.insert(merged.latencies.end(), result.latencies.begin(), result.latencies.end());
+    merged.service_times.insert(merged.service_times.end(), result.service_times.begin(),
+                                result.service_times.end());
+    merged.failed_requests += result.failed_requests;
+  }
+  return merged;
+}
+
+}  // namespace
+
+LoadGenerator::LoadGenerator(const RunConfig& run_config, std::vector<PerformanceRunner*> sessions, unsigned seed)
+    : run_config_(run_config), sessions_(std::move(sessions)), seed_(seed) {
+  ORT_ENFORCE(!sessions_.empty(), "The load generator needs at least one session.");
+}
+
+Status LoadGenerator::Run() {
+  const size_t num_workers = std::max<size_t>(run_config_.concurrent_session_runs, 1);
+  const bool closed_loop = run_config_.requests_per_second <= 0;
+
+  const Clock::time_point start = Clock::now();
+  const Clock::time_point measure_start = start + std::chrono::seconds(run_config_.warmup_seconds);
+  const Clock::time_point end = measure_start + std::chrono::seconds(run_config_.duration_in_seconds);
+  measured_seconds_ = static_cast<double>(std::max<size_t>(run_config_.duration_in_seconds, 1));
+
+  OrtMutex mutex;
+  OrtCondVar cv;
+  std::deque<Request> queue;
+  bool done = false;
+  Status first_error;
+
+  // each worker records its own results, they are merged once all the workers finished
+  std::vector<std::vector<LoadResult>> worker_results(num_workers, std::vector<LoadResult>(sessions_.size()));
+  auto serve = [&](size_t worker, const Request& request) {
+    std::chrono::duration<double> service_time(0);
+    Status status = sessions_[request.session]->RunRequest(service_time);
+    const Clock::time_point completion = Clock::now();
+    if (!status.IsOK()) {
+      std::lock_guard<OrtMutex> lock(mutex);
+      if (first_error.IsOK()) {
+        first_error = status;
+      }
+    }
+    if (!request.measured) {
+      return;
+    }
+
+    LoadResult& result = worker_results[worker][request.session];
+    if (!status.IsOK()) {
+      ++result.failed_requests;
+      return;
+    }
+    result.latencies.push_back(std::chrono::duration<double>(completion - request.arrival).count());
+    result.service_times.push_back(service_time.count());
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers);
+  for (size_t w = 0; w < num_workers; ++w) {
+    workers.emplace_back([&, w]() {
+      if (closed_loop) {
+        std::mt19937 engine(seed_ + static_cast<unsigned>(w) + 1);
+        std::uniform_int_distribution<size_t> pick(0, sessions_.size() - 1);
+        for (Clock::time_point now = Clock::now(); now < end; now = Clock::now()) {
+          serve(w, Request{pick(engine), now, now >= measure_start});
+        }
+        return;
+      }
+
+      for (;;) {
+        Request request;
+        {
+          std::unique_lock<OrtMutex> lock(mutex);
+          cv.wait(lock, [&]() { return done || !queue.empty(); });
+          if (queue.empty()) {
+            return;
+          }
+          request = queue.front();
+          queue.pop_front();
+        }
+        serve(w, request);
+      }
+    });
+  }
+
+  if (!closed_loop) {
+    // The arrivals do not wait for a worker to become free, and a request that is dispatched late still counts its
+    // latency from the time it should have arrived.
+    std::mt19937 engine(seed_);
+    std::exponential_distribution<double> inter_arrival(run_config_.requests_per_second);
+    std::uniform_int_distribution<size_t> pick(0, sessions_.size() - 1);
+    Clock::time_point arrival = start;
+    for (;;) {
+      arrival += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(inter_arrival(engine)));
+      if (arrival >= end) {
+        break;
+      }
+      std::this_thread::sleep_until(arrival);
+      {
+        std::lock_guard<OrtMutex> lock(mutex);
+        queue.push_back(Request{pick(engine), arrival, arrival >= measure_start});
+      }
+      cv.notify_one();
+    }
+    {
+      std::lock_guard<OrtMutex> lock(mutex);
+      done = true;
+    }
+    cv.notify_all();
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  results_.assign(sessions_.size(), LoadResult());
+  for (size_t s = 0; s < sessions_.size(); ++s) {
+    std::vector<LoadResult> session_results;
+    for (auto& results : worker_results) {
+      session_results.push_back(std::move(results[s]));
+    }
+    results_[s] = Merge(session_results);
+    results_[s].model_name = sessions_[s]->GetModelName();
+  }
+
+  return first_error;
+}
+
+void LoadGenerator::PrintSummary() const {
+  std::cout << "\nLoad test: " << sessions_.size() << " session(s), " << run_config_.concurrent_session_runs
+            << " worker(s), ";
+  if (run_config_.requests_per_second > 0) {
+    std::cout << run_config_.requests_per_second << " req/s offered";
+  } else {
+    std::cout << "closed loop";
+  }
+  std::cout << ", " << measured_seconds_ << " s measured after " << run_config_.warmup_seconds << " s warmup\n";
+
+  if (results_.size() > 1) {
+    for (size_t s = 0; s < results_.size(); ++s) {
+      PrintResult("[" + std::to_string(s) + "] " + results_[s].model_name, results_[s], measured_seconds_);
+    }
+  }
+  PrintResult("Total", Merge(results_), measured_seconds_);
+}
+
+Status LoadGenerator::DumpToJson(const std::basic_string<ORTCHAR_T>& path) const {
+  std::ofstream out(path);
+  ORT_RETURN_IF_NOT(out.good(), "failed to open load test result file '", ToUTF8String(path), "'");
+
+  out << "{\n  \"requests_per_second\": " << run_config_.requests_per_second
+      << ",\n  \"concurrency\": " << run_config_.concurrent_session_runs
+      << ",\n  \"warmup_seconds\": " << run_config_.warmup_seconds
+      << ",\n  \"duration_seconds\": " << measured_seconds_
+      << ",\n  \"overall\": {\n      ";
+  WriteResultJson(out, Merge(results_), measured_seconds_);
+  out << "\n  },\n  \"sessions\": [";
+  for (size_t s = 0; s < results_.size(); ++s) {
+    out << (s > 0 ? "," : "") << "\n    {\"index\": " << s << ", \"model\": ";
+    WriteJsonString(out, results_[s].model_name);
+    out << ",\n      ";
+    WriteResultJson(out, results_[s], measured_seconds_);
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+
+  ORT_RETURN_IF_NOT(out.good(), "failed to write load test result file '", ToUTF8String(path), "'");
+  return Status::OK();
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
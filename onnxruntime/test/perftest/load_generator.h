@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <core/common/common.h>
+#include <core/common/status.h>
+#include "performance_runner.h"
+#include "test_configuration.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+// Latencies of the requests completed in the measured phase, in seconds.
+struct LoadResult {
+  std::string model_name;
+  std::vector<double> latencies;      // from the arrival of the request to its completion
+  std::vector<double> service_times;  // time spent in Run()
+  size_t failed_requests{0};
+};
+
+// Drives several sessions with an open-loop load: requests arrive as a Poisson process, independent of how fast
+// they are served, and are picked up by a fixed number of workers. Each request runs one of the sessions, chosen
+// at random. As the latency is measured from the arrival of a request, a slow request delays the requests queued
+// behind it instead of delaying the arrivals, so the percentiles are not hidden by coordinated omission.
+// With a rate of 0 each worker issues its next request as soon as the previous one finished (closed loop).
+class LoadGenerator {
+ public:
+  LoadGenerator(const RunConfig& run_config, std::vector<PerformanceRunner*> sessions, unsigned seed);
+
+  Status Run();
+
+  void PrintSummary() const;
+  Status DumpToJson(const std::basic_string<ORTCHAR_T>& path) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LoadGenerator);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Request {
+    size_t session{0};
+    Clock::time_point arrival;
+    bool measured{false};
+  };
+
+  const RunConfig& run_config_;
+  std::vector<PerformanceRunner*> sessions_;
+  unsigned seed_;
+  std::vector<LoadResult> results_;
+  double measured_seconds_{0};
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
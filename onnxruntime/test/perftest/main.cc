@@ -3,14 +3,81 @@
 
 // onnxruntime dependencies
 #include <core/session/onnxruntime_c_api.h>
+#include <memory>
 #include <random>
+#include <vector>
 #include "command_args_parser.h"
+#include "load_generator.h"
+#include "op_benchmark.h"
 #include "performance_runner.h"
 #include <google/protobuf/stubs/common.h>
 
 using namespace onnxruntime;
 const OrtApi* g_ort = NULL;
 
+static int RunOpBenchmark(Ort::Env& env, const perftest::PerformanceTestConfig& test_config, std::random_device& rd) {
+  perftest::PerformanceRunner perf_runner(env, test_config, rd);
+  auto status = perf_runner.Prepare();
+  if (status.IsOK()) {
+    perftest::OpBenchmark op_benchmark(env, test_config, perf_runner.GetOrtSession());
+    status = op_benchmark.Run();
+    if (status.IsOK()) {
+      op_benchmark.PrintReport();
+      if (!test_config.model_info.result_file_path.empty()) {
+        status = op_benchmark.DumpToCsv(test_config.model_info.result_file_path);
+      }
+    }
+  }
+  if (!status.IsOK()) {
+    printf("Run failed:%s\n", status.ErrorMessage().c_str());
+    return -1;
+  }
+
+  return 0;
+}
+
+static int RunLoadTest(Ort::Env& env, const perftest::PerformanceTestConfig& test_config, std::random_device& rd) {
+  const auto& run_config = test_config.run_config;
+  std::vector<std::basic_string<ORTCHAR_T>> model_paths{test_config.model_info.model_file_path};
+  model_paths.insert(model_paths.end(), run_config.additional_model_paths.begin(),
+                     run_config.additional_model_paths.end());
+
+  std::vector<std::unique_ptr<perftest::PerformanceRunner>> runners;
+  std::vector<perftest::PerformanceRunner*> sessions;
+  for (const auto& model_path : model_paths) {
+    perftest::PerformanceTestConfig config = test_config;
+    config.model_info.model_file_path = model_path;
+    for (size_t i = 0; i < run_config.sessions_per_model; ++i) {
+      runners.push_back(std::make_unique<perftest::PerformanceRunner>(env, config, rd));
+      auto status = runners.back()->Prepare();
+      if (!status.IsOK()) {
+        printf("Run failed:%s\n", status.ErrorMessage().c_str());
+        return -1;
+      }
+      sessions.push_back(runners.back().get());
+    }
+  }
+
+  const unsigned seed = run_config.random_seed_for_input_data >= 0
+                            ? static_cast<unsigned>(run_config.random_seed_for_input_data)
+                            : rd();
+  perftest::LoadGenerator load_generator(run_config, std::move(sessions), seed);
+  auto status = load_generator.Run();
+  load_generator.PrintSummary();
+  if (!run_config.load_result_json_path.empty()) {
+    auto dump_status = load_generator.DumpToJson(run_config.load_result_json_path);
+    if (!dump_status.IsOK()) {
+      printf("%s\n", dump_status.ErrorMessage().c_str());
+    }
+  }
+  if (!status.IsOK()) {
+    printf("Run failed:%s\n", status.ErrorMessage().c_str());
+    return -1;
+  }
+
+  return 0;
+}
+
 #ifdef _WIN32
 int real_main(int argc, wchar_t* argv[]) {
 #else
@@ -42,6 +109,13 @@ int real_main(int argc, char* argv[]) {
       return -1;
   }
   std::random_device rd;
+  if (test_config.run_config.test_mode == perftest::TestMode::kLoadMode) {
+    return RunLoadTest(env, test_config, rd);
+  }
+  if (test_config.run_config.test_mode == perftest::TestMode::kOpBenchmarkMode) {
+    return RunOpBenchmark(env, test_config, rd);
+  }
+
   perftest::PerformanceRunner perf_runner(env, test_config, rd);
 
   // Exit if user enabled -n option so that user can measure session creation time
@@ -0,0 +1,393 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "op_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <unordered_set>
+
+#include <core/platform/env.h>
+#include "ort_test_session.h"
+#if !defined(ORT_MINIMAL_BUILD)
+#include "pb_helper.h"
+#endif
+
+namespace onnxruntime {
+namespace perftest {
+
+namespace {
+
+std::string ThreadCountName(int thread_count) {
+  return thread_count > 0 ? std::to_string(thread_count) + " threads" : "default threads";
+}
+
+std::string CsvQuote(const std::string& value) {
+  std::string result = "\"";
+  for (char c : value) {
+    result += c == '"' ? "\"\"" : std::string(1, c);
+  }
+  return result + "\"";
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+Status LoadModel(const std::basic_string<ORTCHAR_T>& path, ONNX_NAMESPACE::ModelProto& model) {
+  int fd;
+  ORT_RETURN_IF_ERROR(Env::Default().FileOpenRd(path, fd));
+  bool parsed;
+  {
+    ::google::protobuf::io::FileInputStream input(fd);
+    parsed = model.ParseFromZeroCopyStream(&input) && input.GetErrno() == 0;
+  }
+  ORT_RETURN_IF_ERROR(Env::Default().FileClose(fd));
+  ORT_RETURN_IF_NOT(parsed, "Failed to load model from ", ToUTF8String(path), " because protobuf parsing failed.");
+  return Status::OK();
+}
+
+Ort::Session CreateSession(Ort::Env& env, const ONNX_NAMESPACE::ModelProto& model,
+                           const Ort::SessionOptions& session_options) {
+  const std::string bytes = model.SerializeAsString();
+  return Ort::Session(env, bytes.data(), bytes.size(), session_options);
+}
+
+std::vector<std::string> GetOutputNames(const Ort::Session& session) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<std::string> names;
+  for (size_t i = 0; i < session.GetOutputCount(); ++i) {
+    names.emplace_back(session.GetOutputNameAllocated(i, allocator).get());
+  }
+  return names;
+}
+
+std::vector<const char*> ToCStrings(const std::vector<std::string>& strings) {
+  std::vector<const char*> result;
+  result.reserve(strings.size());
+  for (const auto& s : strings) {
+    result.push_back(s.c_str());
+  }
+  return result;
+}
+
+// returns 0 for the element types whose data can't be shared by pointer
+size_t DataSizeInBytes(ONNXTensorElementDataType type, size_t count) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return count * 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX64:
+      return count * 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX128:
+      return count * 16;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      return count * 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT8E4M3FN:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT8E4M3FNUZ:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT8E5M2:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT8E5M2FNUZ:
+      return count;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT4:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT4:
+      return (count + 1) / 2;
+    default:
+      return 0;
+  }
+}
+
+// A tensor that shares the data of `value`, so the recorded values can be fed without copying them.
+Status ShareTensor(const Ort::Value& value, Ort::Value& shared) {
+  ORT_RETURN_IF_NOT(value.IsTensor(), "only tensor inputs are supported");
+  auto info = value.GetTensorTypeAndShapeInfo();
+  const auto shape = info.GetShape();
+  const size_t bytes = DataSizeInBytes(info.GetElementType(), info.GetElementCount());
+  ORT_RETURN_IF_NOT(bytes > 0 || info.GetElementCount() == 0, "unsupported input element type ",
+                    static_cast<int>(info.GetElementType()));
+  shared = Ort::Value::CreateTensor(value.GetTensorMemoryInfo(), const_cast<void*>(value.GetTensorRawData()), bytes,
+                                    shape.data(), shape.size(), info.GetElementType());
+  return Status::OK();
+}
+
+std::string ShapeToString(const std::vector<int64_t>& shape) {
+  if (shape.empty()) {
+    return "scalar";
+  }
+  std::string result;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    result += (i > 0 ? "x" : "") + std::to_string(shape[i]);
+  }
+  return result;
+}
+
+double Median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+}  // namespace
+
+OpBenchmark::OpBenchmark(Ort::Env& env, const PerformanceTestConfig& test_config,
+                         const OnnxRuntimeTestSession& session)
+    : env_(env), test_config_(test_config), session_(session), thread_counts_(test_config.run_config.op_thread_counts) {
+  if (thread_counts_.empty()) {
+    thread_counts_.push_back(0);
+  }
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status OpBenchmark::Run() {
+  const auto& model_path = test_config_.model_info.model_file_path;
+  ONNX_NAMESPACE::ModelProto model;
+  ORT_RETURN_IF_ERROR(LoadModel(model_path, model));
+  const auto& graph = model.graph();
+
+  // Record the inputs of every node by running the model once with all the node outputs as model outputs.
+  ONNX_NAMESPACE::ModelProto recording_model = model;
+  std::unordered_set<std::string> outputs;
+  for (const auto& output : graph.output()) {
+    outputs.insert(output.name());
+  }
+  for (const auto& node : graph.node()) {
+    for (const auto& output : node.output()) {
+      if (!output.empty() && outputs.insert(output).second) {
+        recording_model.mutable_graph()->add_output()->set_name(output);
+      }
+    }
+  }
+
+  const auto& input_names = session_.GetInputNames();
+  const auto& inputs = session_.GetTestInputs();
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    values_[input_names[i]] = &inputs[i];
+  }
+
+  Status status;
+  ORT_TRY {
+    Ort::Session recording_session = CreateSession(env_, recording_model, session_.GetSessionOptions());
+    const auto output_names = GetOutputNames(recording_session);
+    const auto output_names_raw = ToCStrings(output_names);
+    recorded_values_ = recording_session.Run(Ort::RunOptions{nullptr}, input_names.data(), inputs.data(),
+                                             inputs.size(), output_names_raw.data(), output_names_raw.size());
+    for (size_t i = 0; i < output_names.size(); ++i) {
+      values_[output_names[i]] = &recorded_values_[i];
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to record the node inputs: ", ex.what());
+    });
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  std::unordered_map<std::string, const ONNX_NAMESPACE::TensorProto*> initializers;
+  for (const auto& initializer : graph.initializer()) {
+    initializers[initializer.name()] = &initializer;
+  }
+
+  const size_t iterations = std::max<size_t>(test_config_.run_config.repeated_times, 1);
+  for (int node_index = 0; node_index < graph.node_size(); ++node_index) {
+    const auto& node = graph.node(node_index);
+    OpBenchmarkResult result;
+    result.node_name = node.name().empty() ? "node_" + std::to_string(node_index) : node.name();
+    result.op_type = node.domain().empty() ? node.op_type() : node.domain() + "." + node.op_type();
+
+    ONNX_NAMESPACE::ModelProto node_model;
+    node_model.set_ir_version(model.ir_version());
+    *node_model.mutable_opset_import() = model.opset_import();
+    *node_model.mutable_functions() = model.functions();
+    auto& node_graph = *node_model.mutable_graph();
+    node_graph.set_name(result.node_name);
+    *node_graph.add_node() = node;
+
+    std::vector<std::string> feed_names;
+    std::vector<Ort::Value> feeds;
+    std::unordered_set<std::string> seen;
+    for (const auto& input : node.input()) {
+      if (input.empty() || !seen.insert(input).second) {
+        continue;
+      }
+
+      auto initializer = initializers.find(input);
+      if (initializer != initializers.end()) {
+        *node_graph.add_initializer() = *initializer->second;
+        continue;
+      }
+
+      auto value = values_.find(input);
+      if (value == values_.end()) {
+        // e.g. an outer scope value used by a subgraph of the node
+        result.error = "input '" + input + "' was not recorded";
+        break;
+      }
+
+      Ort::Value feed{nullptr};
+      auto share_status = ShareTensor(*value->second, feed);
+      if (!share_status.IsOK()) {
+        result.error = share_status.ErrorMessage();
+        break;
+      }
+
+      auto info = feed.GetTensorTypeAndShapeInfo();
+      const auto shape = info.GetShape();
+      auto& graph_input = *node_graph.add_input();
+      graph_input.set_name(input);
+      auto& tensor_type = *graph_input.mutable_type()->mutable_tensor_type();
+      tensor_type.set_elem_type(static_cast<int32_t>(info.GetElementType()));
+      auto& tensor_shape = *tensor_type.mutable_shape();
+      for (int64_t dim : shape) {
+        tensor_shape.add_dim()->set_dim_value(dim);
+      }
+
+      if (!result.input_shapes.empty()) {
+        result.input_shapes += ", ";
+      }
+      result.input_shapes += ShapeToString(shape);
+      feed_names.push_back(input);
+      feeds.push_back(std::move(feed));
+    }
+    for (const auto& output : node.output()) {
+      if (!output.empty()) {
+        node_graph.add_output()->set_name(output);
+      }
+    }
+
+    if (result.error.empty()) {
+      const auto feed_names_raw = ToCStrings(feed_names);
+      ORT_TRY {
+        for (int thread_count : thread_counts_) {
+          Ort::SessionOptions session_options = session_.GetSessionOptions().Clone();
+          if (thread_count > 0) {
+            session_options.SetIntraOpNumThreads(thread_count);
+          }
+          Ort::Session session = CreateSession(env_, node_model, session_options);
+          const auto output_names = GetOutputNames(session);
+          const auto output_names_raw = ToCStrings(output_names);
+
+          // warm up
+          session.Run(Ort::RunOptions{nullptr}, feed_names_raw.data(), feeds.data(), feeds.size(),
+                      output_names_raw.data(), output_names_raw.size());
+
+          std::vector<double> times_us;
+          times_us.reserve(iterations);
+          for (size_t i = 0; i < iterations; ++i) {
+            auto start = std::chrono::high_resolution_clock::now();
+            session.Run(Ort::RunOptions{nullptr}, feed_names_raw.data(), feeds.data(), feeds.size(),
+                        output_names_raw.data(), output_names_raw.size());
+            auto end = std::chrono::high_resolution_clock::now();
+            times_us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+          }
+          result.median_us.push_back(Median(times_us));
+          result.mean_us.push_back(std::accumulate(times_us.begin(), times_us.end(), 0.0) / times_us.size());
+        }
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          result.error = ex.what();
+        });
+      }
+    }
+
+    if (!result.error.empty()) {
+      result.median_us.clear();
+      result.mean_us.clear();
+      fprintf(stderr, "Skipping node %s (%s): %s\n", result.node_name.c_str(), result.op_type.c_str(),
+              result.error.c_str());
+    } else if (test_config_.run_config.f_verbose) {
+      fprintf(stdout, "%s (%s): %.2f us\n", result.node_name.c_str(), result.op_type.c_str(), result.median_us[0]);
+    }
+    results_.push_back(std::move(result));
+  }
+
+  // slowest first, the nodes that could not be benchmarked last
+  std::stable_sort(results_.begin(), results_.end(), [](const OpBenchmarkResult& a, const OpBenchmarkResult& b) {
+    const double a_us = a.median_us.empty() ? -1 : a.median_us[0];
+    const double b_us = b.median_us.empty() ? -1 : b.median_us[0];
+    return a_us > b_us;
+  });
+
+  return Status::OK();
+}
+#else
+Status OpBenchmark::Run() {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "The op benchmark is not supported in a minimal build.");
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+void OpBenchmark::PrintReport() const {
+  double total_us = 0;
+  for (const auto& result : results_) {
+    if (!result.median_us.empty()) {
+      total_us += result.median_us[0];
+    }
+  }
+
+  printf("\nOp benchmark: %zu nodes, %zu iterations each, median latency in us\n", results_.size(),
+         std::max<size_t>(test_config_.run_config.repeated_times, 1));
+  printf("%5s", "Rank");
+  for (int thread_count : thread_counts_) {
+    printf(" %16s", ThreadCountName(thread_count).c_str());
+  }
+  printf(" %7s  %-24s %-32s %s\n", "Share", "Op", "Node", "Input shapes");
+
+  size_t rank = 0;
+  for (const auto& result : results_) {
+    if (result.median_us.empty()) {
+      continue;
+    }
+    printf("%5zu", ++rank);
+    for (double median_us : result.median_us) {
+      printf(" %16.2f", median_us);
+    }
+    printf(" %6.2f%%  %-24s %-32s %s\n", total_us > 0 ? 100 * result.median_us[0] / total_us : 0.0,
+           result.op_type.c_str(), result.node_name.c_str(), result.input_shapes.c_str());
+  }
+
+  const size_t skipped = results_.size() - rank;
+  if (skipped > 0) {
+    printf("%zu node(s) could not be benchmarked on their own\n", skipped);
+  }
+}
+
+Status OpBenchmark::DumpToCsv(const std::basic_string<ORTCHAR_T>& path) const {
+  std::ofstream out(path);
+  ORT_RETURN_IF_NOT(out.good(), "failed to open result file '", ToUTF8String(path), "'");
+
+  out << "rank,node,op_type,input_shapes";
+  for (int thread_count : thread_counts_) {
+    out << ",median_us (" << ThreadCountName(thread_count) << "),mean_us (" << ThreadCountName(thread_count) << ")";
+  }
+  out << ",error\n";
+
+  size_t rank = 0;
+  for (const auto& result : results_) {
+    out << (result.median_us.empty() ? std::string() : std::to_string(++rank)) << "," << CsvQuote(result.node_name)
+        << "," << CsvQuote(result.op_type) << "," << CsvQuote(result.input_shapes);
+    for (size_t i = 0; i < thread_counts_.size(); ++i) {
+      if (i < result.median_us.size()) {
+        out << "," << result.median_us[i] << "," << result.mean_us[i];
+      } else {
+        out << ",,";
+      }
+    }
+    out << "," << CsvQuote(result.error) << "\n";
+  }
+
+  ORT_RETURN_IF_NOT(out.good(), "failed to write result file '", ToUTF8String(path), "'");
+  return Status::OK();
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <core/common/common.h>
+#include <core/common/status.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include "test_configuration.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+class OnnxRuntimeTestSession;
+
+struct OpBenchmarkResult {
+  std::string node_name;
+  std::string op_type;
+  std::string input_shapes;
+  // one entry per thread count, in microseconds
+  std::vector<double> median_us;
+  std::vector<double> mean_us;
+  // set if the node could not be benchmarked
+  std::string error;
+};
+
+// Benchmarks every node of the model on its own. The model is run once with the first test data set, keeping all
+// the intermediate values, so each node is extracted into a single node model that is fed the inputs it saw in
+// that run. The single node models are run with the options of `session`, so with the same execution providers,
+// for each of the thread counts in the run config.
+// Pass a model saved with -u to benchmark the fused nodes the graph optimizers produce.
+class OpBenchmark {
+ public:
+  OpBenchmark(Ort::Env& env, const PerformanceTestConfig& test_config, const OnnxRuntimeTestSession& session);
+
+  Status Run();
+
+  // Prints the nodes ranked by their median latency with the first thread count.
+  void PrintReport() const;
+  Status DumpToCsv(const std::basic_string<ORTCHAR_T>& path) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OpBenchmark);
+
+ private:
+  Ort::Env& env_;
+  const PerformanceTestConfig& test_config_;
+  const OnnxRuntimeTestSession& session_;
+  // 0 uses the intra op thread count of the session options
+  std::vector<int> thread_counts_;
+
+  // the model inputs and every intermediate value of the recording run
+  std::vector<Ort::Value> recorded_values_;
+  std::unordered_map<std::string, const Ort::Value*> values_;
+
+  std::vector<OpBenchmarkResult> results_;
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
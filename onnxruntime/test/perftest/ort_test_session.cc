@@ -431,6 +431,9 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
       } else if (key == "COREML_FLAG_USE_CPU_AND_GPU") {
         coreml_flags |= COREML_FLAG_USE_CPU_AND_GPU;
         std::cout << "CoreML enabled COREML_FLAG_USE_CPU_AND_GPU.\n";
+      } else if (key == "COREML_FLAG_ENABLE_MODEL_CACHE") {
+        coreml_flags |= COREML_FLAG_ENABLE_MODEL_CACHE;
+        std::cout << "CoreML enabled COREML_FLAG_ENABLE_MODEL_CACHE.\n";
       } else if (key.empty()) {
       } else {
         ORT_THROW(
@@ -905,6 +908,8 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
       ORT_THROW("Model file could not be opened.\n");
     }
   }
+  session_options_ = std::move(session_options);
+
   size_t output_count = session_.GetOutputCount();
   output_names_.resize(output_count);
   Ort::AllocatorWithDefaultOptions a;
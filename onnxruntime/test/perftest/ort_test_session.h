@@ -27,6 +27,13 @@ class OnnxRuntimeTestSession : public TestSession {
 
   bool PopulateGeneratedInputTestData(int32_t seed);
 
+  // The options the session was created with, to create other sessions with the same configuration.
+  const Ort::SessionOptions& GetSessionOptions() const { return session_options_; }
+
+  // The inputs of the first test data set, in the order of GetInputNames().
+  const std::vector<Ort::Value>& GetTestInputs() const { return test_inputs_.at(0); }
+  const std::vector<const char*>& GetInputNames() const { return input_names_; }
+
   ~OnnxRuntimeTestSession() = default;
 
   std::chrono::duration<double> Run() override;
@@ -35,6 +42,7 @@ class OnnxRuntimeTestSession : public TestSession {
 
  private:
   Ort::Session session_{nullptr};
+  Ort::SessionOptions session_options_{nullptr};
   std::mt19937 rand_engine_;
   std::uniform_int_distribution<int> dist_;
   std::vector<std::vector<Ort::Value>> test_inputs_;
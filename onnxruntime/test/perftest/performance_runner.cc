@@ -111,6 +111,30 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
   }
 }
 
+Status PerformanceRunner::Prepare() {
+  if (!Initialize()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
+  }
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunRequest(std::chrono::duration<double>& duration) {
+  auto status = Status::OK();
+  ORT_TRY {
+    duration = session_->Run();
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunRequest caught exception: ", ex.what());
+    });
+  }
+  return status;
+}
+
+const OnnxRuntimeTestSession& PerformanceRunner::GetOrtSession() const {
+  return static_cast<const OnnxRuntimeTestSession&>(*session_);
+}
+
 void PerformanceRunner::LogSessionCreationTime() {
   std::chrono::duration<double> session_create_duration = session_create_end_ - session_create_start_;
   std::cout << "\nSession creation time cost: " << session_create_duration.count() << " s\n";
@@ -27,6 +27,8 @@ class TestModelInfo;
 namespace onnxruntime {
 namespace perftest {
 
+class OnnxRuntimeTestSession;
+
 struct PerformanceResult {
   std::chrono::time_point<std::chrono::high_resolution_clock> start;
   std::chrono::time_point<std::chrono::high_resolution_clock> end;
@@ -50,6 +52,17 @@ class PerformanceRunner {
 
   inline const PerformanceResult& GetResult() const { return performance_result_; }
 
+  // Loads the test data without running anything, for drivers like the LoadGenerator that schedule the requests
+  // themselves. Run() does this on its own.
+  Status Prepare();
+
+  // Runs a single inference request. Can be called concurrently once Prepare() succeeded.
+  Status RunRequest(std::chrono::duration<double>& duration);
+
+  inline const std::string& GetModelName() const { return performance_result_.model_name; }
+
+  const OnnxRuntimeTestSession& GetOrtSession() const;
+
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
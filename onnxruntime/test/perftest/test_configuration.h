@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -16,7 +17,9 @@ namespace perftest {
 
 enum class TestMode : std::uint8_t {
   kFixDurationMode = 0,
-  KFixRepeatedTimesMode
+  KFixRepeatedTimesMode,
+  kLoadMode,
+  kOpBenchmarkMode
 };
 
 enum class Platform : std::uint8_t {
@@ -66,6 +69,14 @@ struct RunConfig {
   bool disable_spinning_between_run = false;
   bool exit_after_session_creation = false;
   std::basic_string<ORTCHAR_T> register_custom_op_path;
+  // load mode, see LoadGenerator
+  double requests_per_second{0};
+  size_t warmup_seconds{0};
+  size_t sessions_per_model{1};
+  std::vector<std::basic_string<ORTCHAR_T>> additional_model_paths;
+  std::basic_string<ORTCHAR_T> load_result_json_path;
+  // op benchmark mode, see OpBenchmark
+  std::vector<int> op_thread_counts;
 };
 
 struct PerformanceTestConfig {
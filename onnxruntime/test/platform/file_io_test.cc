@@ -19,6 +19,7 @@
 #include "gtest/gtest.h"
 
 #include "core/common/span_utils.h"
+#include "test/util/include/asserts.h"
 #include "test/util/include/file_util.h"
 
 namespace onnxruntime {
@@ -171,11 +172,6 @@ TEST(FileIoTest, MapFileIntoMemory) {
     const auto offset = offset_and_length.first;
     const auto length = offset_and_length.second;
 
-    // The offset must be a multiple of the allocation granularity
-    if (offset % allocation_granularity != 0) {
-      continue;
-    }
-
     Env::MappedMemoryPtr mapped_memory{};
     auto status = Env::Default().MapFileIntoMemory(
         tmp.path.c_str(), offset, length, mapped_memory);
@@ -191,12 +187,17 @@ TEST(FileIoTest, MapFileIntoMemory) {
   }
 
   {
-    Env::MappedMemoryPtr mapped_memory{};
+    // offsets that are not a multiple of the allocation granularity are mapped too
+    const auto expected_large_data = GenerateData(allocation_granularity * 2);
+    TempFilePath tmp_large(ORT_TSTR("map_file_test_"));
+    WriteDataToFile(gsl::make_span(expected_large_data), tmp_large.path);
 
-    // invalid - offset is not a multiple of the allocation granularity
-    ASSERT_FALSE(Env::Default().MapFileIntoMemory(
-                                   tmp.path.c_str(), allocation_granularity * 3 / 2, page_size / 10, mapped_memory)
-                     .IsOK());
+    const auto offset = allocation_granularity * 3 / 2;
+    const auto length = page_size / 10;
+    Env::MappedMemoryPtr mapped_memory{};
+    ASSERT_STATUS_OK(Env::Default().MapFileIntoMemory(tmp_large.path.c_str(), offset, length, mapped_memory));
+    ASSERT_TRUE(SpanEq(gsl::make_span(mapped_memory.get(), length),
+                       gsl::make_span(expected_large_data.data() + offset, length)));
   }
 
   {
@@ -12,8 +12,10 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -510,6 +512,202 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestLoopBudgetMaxDegreeOfParallelism) {
+  auto tp = std::make_unique<ThreadPool>(&Env::Default(), ThreadOptions{}, nullptr, 4, true);
+  const int default_dop = ThreadPool::DegreeOfParallelism(tp.get());
+  const auto caller_id = std::this_thread::get_id();
+
+  constexpr int num_tasks = 256;
+  auto test_data = CreateTestData(num_tasks);
+  std::atomic<bool> ran_on_caller_only{true};
+  {
+    ThreadPool::ScopedLoopBudget budget(1, ThreadPool::LoopPriority::kNormal);
+    EXPECT_LE(ThreadPool::DegreeOfParallelism(tp.get()), default_dop);
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) {
+      if (std::this_thread::get_id() != caller_id) {
+        ran_on_caller_only = false;
+      }
+      IncrementElement(*test_data, i);
+    });
+  }
+  ValidateTestData(*test_data);
+  EXPECT_TRUE(ran_on_caller_only);
+  EXPECT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), default_dop);
+}
+
+TEST(ThreadPoolTest, TestLoopBudgetLowPriorityYieldsToHighPriority) {
+  auto tp = std::make_unique<ThreadPool>(&Env::Default(), ThreadOptions{}, nullptr, 4, true);
+
+  // Keep a high priority loop running until the low priority loop is done.
+  std::atomic<bool> high_started{false};
+  std::atomic<bool> low_done{false};
+  std::thread high_priority_run([&]() {
+    ThreadPool::ScopedLoopBudget budget(0, ThreadPool::LoopPriority::kHigh);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 4, [&](std::ptrdiff_t i) {
+      if (i == 0) {
+        high_started = true;
+        while (!low_done) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  });
+
+  while (!high_started) {
+    std::this_thread::yield();
+  }
+
+  constexpr int num_tasks = 256;
+  auto test_data = CreateTestData(num_tasks);
+  const auto caller_id = std::this_thread::get_id();
+  std::atomic<bool> ran_on_caller_only{true};
+  {
+    ThreadPool::ScopedLoopBudget budget(0, ThreadPool::LoopPriority::kLow);
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) {
+      if (std::this_thread::get_id() != caller_id) {
+        ran_on_caller_only = false;
+      }
+      IncrementElement(*test_data, i);
+    });
+  }
+  low_done = true;
+  high_priority_run.join();
+
+  ValidateTestData(*test_data);
+  EXPECT_TRUE(ran_on_caller_only);
+}
+
+TEST(ThreadPoolTest, TestAdaptiveCostModel) {
+  ThreadOptions thread_options;
+  thread_options.adaptive_cost_model = true;
+  auto tp = std::make_unique<ThreadPool>(&Env::Default(), thread_options, nullptr, 4, true);
+
+  // A loop body that is much more expensive than the declared cost, and a trivial one that is declared expensive.
+  // Whatever partitioning the measured costs lead to, every iteration must still run exactly once.
+  constexpr int num_tasks = 1000;
+  constexpr int num_loops = 50;
+  auto expensive_data = CreateTestData(num_tasks);
+  auto cheap_data = CreateTestData(num_tasks);
+  ThreadPool::StartProfiling(tp.get());
+  for (int loop = 0; loop < num_loops; ++loop) {
+    ThreadPool::TryParallelFor(tp.get(), num_tasks, TensorOpCost{0, 0, 1}, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        volatile double acc = 0;
+        for (int k = 0; k < 1000; ++k) {
+          acc = acc + k;
+        }
+        IncrementElement(*expensive_data, i);
+      }
+    });
+    ThreadPool::TryParallelFor(tp.get(), num_tasks, TensorOpCost{0, 0, 1e5}, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        IncrementElement(*cheap_data, i);
+      }
+    });
+  }
+  const auto profile = ThreadPool::StopProfiling(tp.get());
+
+  ValidateTestData(*expensive_data, num_loops);
+  ValidateTestData(*cheap_data, num_loops);
+#if !defined(ORT_MINIMAL_BUILD)
+  EXPECT_NE(profile.find("\"adaptive_cost_model\""), std::string::npos) << profile;
+  EXPECT_NE(profile.find("\"declared_compute_cycles\": 100000"), std::string::npos) << profile;
+#else
+  ORT_UNUSED_PARAMETER(profile);
+#endif
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  ThreadOptions thread_options;
+  thread_options.adaptive_spinning = true;
+  auto tp = std::make_unique<ThreadPool>(&Env::Default(), thread_options, nullptr, 4, true);
+
+  // Alternate back-to-back loops, which grow the spin budgets, with pauses that are long enough for the
+  // workers to block and shrink them. Every iteration must still run exactly once.
+  constexpr int num_tasks = 100;
+  constexpr int num_loops = 20;
+  auto test_data = CreateTestData(num_tasks);
+  for (int loop = 0; loop < num_loops; ++loop) {
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    if (loop % 4 == 3) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+
+  ValidateTestData(*test_data, num_loops);
+}
+
+TEST(ThreadPoolTest, TestStats) {
+  // without the low latency hint the workers do not spin
+  auto tp = std::make_unique<ThreadPool>(&Env::Default(), ThreadOptions(), nullptr, 4, false);
+  EXPECT_TRUE(ThreadPool::GetStats(nullptr).workers.empty());
+
+  constexpr int num_tasks = 40;
+  constexpr int num_loops = 10;
+  auto test_data = CreateTestData(num_tasks);
+  for (int loop = 0; loop < num_loops; ++loop) {
+    ThreadPool::TryParallelFor(tp.get(), num_tasks, TensorOpCost{0, 0, 1e7}, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        IncrementElement(*test_data, i);
+      }
+    });
+  }
+  ValidateTestData(*test_data, num_loops);
+
+  const ThreadPoolStats stats = ThreadPool::GetStats(tp.get());
+  // the calling thread is one of the 4 threads
+  ASSERT_EQ(stats.workers.size(), 3u);
+  EXPECT_EQ(stats.parallel_loops, static_cast<uint64_t>(num_loops));
+  uint64_t tasks_run = 0;
+  for (const auto& worker : stats.workers) {
+    tasks_run += worker.tasks_run;
+    EXPECT_LE(worker.tasks_stolen, worker.tasks_run);
+    EXPECT_EQ(worker.spin_ns, 0u);
+    EXPECT_EQ(worker.queue_depth, 0u);
+  }
+  EXPECT_GT(tasks_run, 0u);
+
+  const std::string json = stats.ToJson();
+  EXPECT_NE(json.find("\"parallel_loops\":10,"), std::string::npos) << json;
+  EXPECT_NE(json.find("\"spin_us\":0,"), std::string::npos) << json;
+}
+
+TEST(ThreadPoolTest, TestProfileTaskSpans) {
+  auto tp = std::make_unique<ThreadPool>(&Env::Default(), ThreadOptions(), nullptr, 4, true);
+  constexpr int num_tasks = 40;
+  auto test_data = CreateTestData(num_tasks);
+
+  ThreadPool::StartProfiling(tp.get(), true);
+  ThreadPool::TryParallelFor(tp.get(), num_tasks, TensorOpCost{0, 0, 1e7}, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      IncrementElement(*test_data, i);
+    }
+  });
+  std::vector<ThreadPoolTaskSpan> task_spans;
+  ThreadPool::StopProfiling(tp.get(), &task_spans);
+  ValidateTestData(*test_data);
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // the loop is long enough for the worker threads to pick up tasks
+  ASSERT_FALSE(task_spans.empty());
+  for (const auto& task : task_spans) {
+    EXPECT_LE(task.start, task.end);
+  }
+
+  // nothing is recorded once profiling stopped
+  ThreadPool::StartProfiling(tp.get());
+  ThreadPool::TryParallelFor(tp.get(), num_tasks, TensorOpCost{0, 0, 1e7}, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      IncrementElement(*test_data, i);
+    }
+  });
+  ThreadPool::StopProfiling(tp.get(), &task_spans);
+  EXPECT_TRUE(task_spans.empty());
+#endif
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -613,6 +811,34 @@ TEST(ThreadPoolTest, TestAffinityStringWellShaped) {
   }
 }
 
+TEST(ThreadPoolTest, TestNumaNodeAffinity) {
+  OrtThreadPoolParams tp_params;
+
+  // a node that does not exist is ignored
+  tp_params.numa_node = 1 << 20;
+  tp_params.thread_pool_size = 2;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                          tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+  ASSERT_NE(tp, nullptr);
+
+  auto node_affinities = onnxruntime::Env::Default().GetNumaNodeThreadAffinities(0);
+  if (node_affinities.size() < 2) {
+    return;
+  }
+
+  // with no thread count, the pool gets one thread per core of the node
+  tp_params.numa_node = 0;
+  tp_params.thread_pool_size = 0;
+  tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                     tp_params,
+                                     concurrency::ThreadPoolType::INTRA_OP);
+  ASSERT_NE(tp, nullptr);
+  auto DOP = concurrency::ThreadPool::DegreeOfParallelism(tp.get());
+  ASSERT_TRUE(DOP >= static_cast<int>(node_affinities.size()) &&
+              DOP % static_cast<int>(node_affinities.size()) == 0);  // for hybrid cpu, dop is a multiple
+}
+
 #ifdef _WIN32
 TEST(ThreadPoolTest, TestDefaultAffinity) {
   test::CpuGroup cpu_group = {{0, 1},
@@ -669,6 +895,27 @@ TEST(ThreadPoolTest, TestDefaultAffinity) {
     }
   }
 }
+
+TEST(ThreadPoolTest, TestPerformanceCoreAffinity) {
+  // two hyper-threaded P-cores followed by two E-cores
+  test::CpuGroup cpu_group = {{0, 1},
+                              {2, 3},
+                              {4},
+                              {5}};
+  test::WindowsEnvTester win_env;
+  win_env.SetCpuInfo({cpu_group});
+
+  // without efficiency classes, or with a single class, there are no distinct performance cores
+  ASSERT_TRUE(win_env.GetPerformanceCoreThreadAffinities().empty());
+  ASSERT_TRUE(win_env.SetCoreEfficiencyClasses({0, 0, 0, 0}));
+  ASSERT_TRUE(win_env.GetPerformanceCoreThreadAffinities().empty());
+
+  ASSERT_TRUE(win_env.SetCoreEfficiencyClasses({1, 1, 0, 0}));
+  auto p_core_affinities = win_env.GetPerformanceCoreThreadAffinities();
+  ASSERT_EQ(p_core_affinities.size(), 2u);
+  ASSERT_EQ(p_core_affinities[0], (LogicalProcessors{0, 1}));
+  ASSERT_EQ(p_core_affinities[1], (LogicalProcessors{2, 3}));
+}
 #endif
 #endif
 
@@ -29,6 +29,7 @@ bool WindowsEnvTester::SetCpuInfo(const CpuInfo& cpu_info) {
     return false;
   }
   cores_.clear();
+  core_efficiency_classes_.clear();
   global_processor_info_map_.clear();
   int global_processor_id = 0;
   for (int group_id = 0; group_id < static_cast<int>(cpu_info.size()); ++group_id) {
@@ -47,5 +48,13 @@ bool WindowsEnvTester::SetCpuInfo(const CpuInfo& cpu_info) {
   return true;
 }
 
+bool WindowsEnvTester::SetCoreEfficiencyClasses(const std::vector<BYTE>& efficiency_classes) {
+  if (efficiency_classes.size() != cores_.size()) {
+    return false;
+  }
+  core_efficiency_classes_ = efficiency_classes;
+  return true;
+}
+
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
@@ -17,6 +17,8 @@ class WindowsEnvTester : public WindowsEnv {
   ~WindowsEnvTester() = default;
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WindowsEnvTester);
   bool SetCpuInfo(const CpuInfo& cpu_info);
+  // one efficiency class per core, in the order the cores were given to SetCpuInfo
+  bool SetCoreEfficiencyClasses(const std::vector<BYTE>& efficiency_classes);
 };
 
 }  // namespace test
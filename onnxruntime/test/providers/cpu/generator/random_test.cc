@@ -2,9 +2,13 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <random>
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
@@ -158,6 +162,64 @@ TEST(Random, RandomUniformLikeInferDType) {
   RunRandomUniformLikeTest(infer_dtype);
 }
 
+// the Philox engine doesn't reproduce the sequence of std::default_random_engine, so check the distributions
+TEST(Random, PhiloxRandomUniformAndNormalCpu) {
+  const std::vector<int64_t> dims{255, 255};
+  const int64_t size = TensorShape(dims).Size();
+  constexpr float low = -2.f;
+  constexpr float high = 6.f;
+  constexpr float mean = 1.f;
+  constexpr float scale = 3.f;
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsUsePhiloxRandomGenerator, "1"));
+
+  for (const bool is_normal : {false, true}) {
+    OpTester test(is_normal ? "RandomNormal" : "RandomUniform");
+    if (is_normal) {
+      test.AddAttribute("mean", mean);
+      test.AddAttribute("scale", scale);
+    } else {
+      test.AddAttribute("low", low);
+      test.AddAttribute("high", high);
+    }
+    test.AddAttribute("seed", 123.f);
+    test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
+    test.AddAttribute("shape", dims);
+    test.AddOutput<float>("Y", dims, std::vector<float>(size, 0.f));
+
+    test.SetCustomOutputVerifier([&](const std::vector<OrtValue>& fetches, const std::string& /*provider_type*/) {
+      ASSERT_EQ(fetches.size(), 1u);
+      auto output_span = fetches[0].Get<Tensor>().DataAsSpan<float>();
+      double sum = 0., sum_sq = 0.;
+      for (float value : output_span) {
+        ASSERT_TRUE(std::isfinite(value));
+        if (!is_normal) {
+          ASSERT_GE(value, low);
+          ASSERT_LE(value, high);
+        }
+        sum += value;
+        sum_sq += static_cast<double>(value) * value;
+      }
+      const double actual_mean = sum / size;
+      const double actual_stddev = std::sqrt(sum_sq / size - actual_mean * actual_mean);
+      if (is_normal) {
+        ASSERT_NEAR(actual_mean, mean, 0.05);
+        ASSERT_NEAR(actual_stddev, scale, 0.05);
+      } else {
+        ASSERT_NEAR(actual_mean, (low + high) / 2., 0.05);
+        ASSERT_NEAR(actual_stddev, (high - low) / std::sqrt(12.), 0.05);
+      }
+    });
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
 TEST(Random, InvalidDType) {
   constexpr float seed = 123.f;
 
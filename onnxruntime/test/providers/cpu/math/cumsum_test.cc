@@ -257,5 +257,19 @@ TEST(CumSumTest, _1DTestLong) {
   test.AddOutput<int32_t>("y", {N}, output_value);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+TEST(CumSumTest, _2DTestLongReverseExclusive) {
+  OpTester test("CumSum", 11, onnxruntime::kOnnxDomain);
+  test.AddAttribute<int64_t>("reverse", 1);
+  test.AddAttribute<int64_t>("exclusive", 1);
+  constexpr int N = 100000;
+  std::vector<int64_t> output_value(2 * N);
+  for (int i = 0; i < N; ++i) {
+    output_value[i] = output_value[N + i] = N - 1 - i;
+  }
+  test.AddInput<int64_t>("x", {2, N}, std::vector<int64_t>(2 * N, 1));
+  test.AddInput<int32_t>("axis", {}, {1});
+  test.AddOutput<int64_t>("y", {2, N}, output_value);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
 }  // namespace test
 }  // namespace onnxruntime
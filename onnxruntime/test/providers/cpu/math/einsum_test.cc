@@ -237,6 +237,30 @@ TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
 }
 
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_Reordered) {
+  // contracting 'jk,k' first is cheaper than processing the operands left to right
+  constexpr int64_t I = 2, J = 6, K = 5, B = 3;
+  std::vector<float> x(B * I * J), y(J * K), z(K);
+  for (size_t n = 0; n < x.size(); ++n) x[n] = static_cast<float>(n % 7) - 3.f;
+  for (size_t n = 0; n < y.size(); ++n) y[n] = static_cast<float>(n % 5) - 2.f;
+  for (size_t n = 0; n < z.size(); ++n) z[n] = static_cast<float>(n) + 1.f;
+
+  std::vector<float> o(I * B, 0.f);
+  for (int64_t b = 0; b < B; ++b)
+    for (int64_t i = 0; i < I; ++i)
+      for (int64_t j = 0; j < J; ++j)
+        for (int64_t k = 0; k < K; ++k)
+          o[i * B + b] += x[(b * I + i) * J + j] * y[j * K + k] * z[k];
+
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "bij,jk,k->ib");
+  test.AddInput<float>("x", {B, I, J}, x);
+  test.AddInput<float>("y", {J, K}, y);
+  test.AddInput<float>("z", {K}, z);
+  test.AddOutput<float>("o", {I, B}, o);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
+}
+
 TEST(Einsum, ExplicitEinsumAsBatchedMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
   test.AddAttribute<std::string>("equation", "bij,bjk->bik");
@@ -448,6 +448,56 @@ TEST(MathOpTest, Add_Broadcast_2x1x4_1x3x1) {
 #endif
 }
 
+// more pairs of shapes than the Broadcasters cached per thread, each broadcast twice
+TEST(MathOpTest, Add_Broadcast_RepeatedShapes) {
+  const std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>> shapes{
+      {{3, 2}, {3, 1}}, {{2, 1, 4}, {1, 3, 1}}, {{3, 2}, {2}}, {{}, {2, 3}}, {{2, 3}, {2, 3}}, {{1, 3}, {2, 1}}};
+
+  for (int repeat = 0; repeat < 2; ++repeat) {
+    for (const auto& [a_dims, b_dims] : shapes) {
+      std::vector<int64_t> c_dims;
+      const size_t rank = std::max(a_dims.size(), b_dims.size());
+      for (size_t i = 0; i < rank; ++i) {
+        const int64_t a = i + a_dims.size() >= rank ? a_dims[i + a_dims.size() - rank] : 1;
+        const int64_t b = i + b_dims.size() >= rank ? b_dims[i + b_dims.size() - rank] : 1;
+        c_dims.push_back(std::max(a, b));
+      }
+      const TensorShape a_shape(a_dims), b_shape(b_dims), c_shape(c_dims);
+
+      std::vector<float> a(static_cast<size_t>(a_shape.Size()));
+      std::vector<float> b(static_cast<size_t>(b_shape.Size()));
+      for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<float>(i + 1);
+      for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<float>(10 * (i + 1));
+
+      // the element of an input for an output index, going from the innermost dim
+      auto input_index = [&](const std::vector<int64_t>& dims, int64_t output_index) {
+        int64_t index = 0;
+        int64_t stride = 1;
+        for (size_t i = 0; i < dims.size(); ++i) {
+          const size_t dim = dims.size() - 1 - i;
+          const int64_t output_dim = c_dims[rank - 1 - i];
+          const int64_t coordinate = output_index % output_dim;
+          output_index /= output_dim;
+          index += (dims[dim] == 1 ? 0 : coordinate) * stride;
+          stride *= dims[dim];
+        }
+        return static_cast<size_t>(index);
+      };
+
+      std::vector<float> c(static_cast<size_t>(c_shape.Size()));
+      for (size_t i = 0; i < c.size(); ++i) {
+        c[i] = a[input_index(a_dims, static_cast<int64_t>(i))] + b[input_index(b_dims, static_cast<int64_t>(i))];
+      }
+
+      OpTester test("Add");
+      test.AddInput<float>("A", a_dims, a);
+      test.AddInput<float>("B", b_dims, b);
+      test.AddOutput<float>("C", c_dims, c);
+      test.Run();
+    }
+  }
+}
+
 TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
   OpTester test("Add");
 
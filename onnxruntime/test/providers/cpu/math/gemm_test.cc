@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/framework/run_options.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/common/dnnl_op_test_utils.h"
@@ -829,6 +830,52 @@ TYPED_TEST(GemmOpTypedTests, TestGemmWithAlphaOpset11) {
       .RunWithConfig();
 }
 
+TEST(GemmOpTest, GemmSparseWeightTransB) {
+  constexpr int64_t M = 3, K = 10, N = 9;
+  std::vector<float> a_vals(M * K);
+  for (size_t i = 0; i < a_vals.size(); ++i) a_vals[i] = static_cast<float>(i % 5) - 2.0f;
+
+  // B is N x K with two non-zeros per row
+  std::vector<float> b_vals(N * K, 0.0f);
+  for (int64_t n = 0; n < N; ++n) {
+    b_vals[n * K + n % K] = 1.5f;
+    b_vals[n * K + (n * 3 + 1) % K] = static_cast<float>(n) - 4.0f;
+  }
+  std::vector<float> c_vals(N);
+  for (int64_t n = 0; n < N; ++n) c_vals[n] = static_cast<float>(n) * 0.5f;
+
+  constexpr float alpha = 2.0f, beta = 0.5f;
+  std::vector<float> y_vals(M * N);
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; ++k) {
+        sum += a_vals[m * K + k] * b_vals[n * K + k];
+      }
+      y_vals[m * N + n] = alpha * sum + beta * c_vals[n];
+    }
+  }
+
+  OpTester test("Gemm", 13);
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", alpha);
+  test.AddAttribute("beta", beta);
+  test.AddInput<float>("A", {M, K}, a_vals);
+  test.AddInput<float>("B", {N, K}, b_vals, true);
+  test.AddInput<float>("C", {N}, c_vals);
+  test.AddOutput<float>("Y", {M, N}, y_vals);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSparseWeightDensityThreshold, "0.3"));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Config(so)
+      .ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in training builds so no need to test the feature in a training build.
 TEST(GemmOpTest, SharedPrepackedWeights) {
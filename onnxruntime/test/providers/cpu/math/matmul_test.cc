@@ -1,8 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
+#include <fstream>
+
 #include "gtest/gtest.h"
+#include "nlohmann/json.hpp"
 
+#include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
@@ -210,7 +217,8 @@ TEST(MathOpTest, MatMulFloatType) {
   RunMatMulTest<float>(7, false, true);
 }
 
-#if defined(USE_CUDA) || defined(USE_ROCM) || defined(COREML_ENABLE_MLPROGRAM) || defined(USE_XNNPACK)
+#if defined(USE_CUDA) || defined(USE_ROCM) || defined(COREML_ENABLE_MLPROGRAM) || defined(USE_XNNPACK) || \
+    defined(MLAS_F16VEC_INTRINSICS_SUPPORTED)
 TEST(MathOpTest, MatMulFloat16) {
 #ifdef USE_CUDA
   int min_cuda_architecture = 530;
@@ -276,7 +284,8 @@ TEST(MathOpTest, MatMulZeroKInt32Type) {
   RunMatMulZeroKTest<int32_t>();
 }
 
-#if defined(USE_CUDA) || defined(USE_ROCM) || defined(COREML_ENABLE_MLPROGRAM) || defined(USE_XNNPACK)
+#if defined(USE_CUDA) || defined(USE_ROCM) || defined(COREML_ENABLE_MLPROGRAM) || defined(USE_XNNPACK) || \
+    defined(MLAS_F16VEC_INTRINSICS_SUPPORTED)
 TEST(MathOpTest, MatMul_Float16) {
 #ifdef USE_CUDA
   int min_cuda_architecture = 530;
@@ -352,6 +361,174 @@ TEST(MathOpTest, MatMul_bfloat16) {
 }
 #endif
 
+#if defined(USE_CUDA) && defined(USE_CUSPARSELT)
+TEST(MathOpTest, MatMul_Float16_Sparse2To4) {
+  int min_cuda_architecture = 800;
+  if (!HasCudaEnvironment(min_cuda_architecture)) {
+    LOGS_DEFAULT(WARNING) << "Hardware NOT support 2:4 structured sparsity";
+    return;
+  }
+
+  // M = 10 is not a multiple of the cuSPARSELt alignment. Every group of 4 along K has 2 zeros in each column of B.
+  constexpr int64_t batch = 2, M = 5, K = 32, N = 16;
+  std::vector<float> a_vals(batch * M * K);
+  std::vector<float> b_vals(K * N, 0.0f);
+  for (size_t i = 0; i < a_vals.size(); ++i) a_vals[i] = static_cast<float>(i % 5) - 2.0f;
+  for (int64_t k = 0; k < K; ++k) {
+    for (int64_t n = 0; n < N; ++n) {
+      if (k % 4 == n % 4 || k % 4 == (n + 1) % 4) {
+        b_vals[k * N + n] = static_cast<float>((k + n) % 3) - 1.0f;
+      }
+    }
+  }
+
+  std::vector<float> y_vals(batch * M * N, 0.0f);
+  for (int64_t m = 0; m < batch * M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      for (int64_t k = 0; k < K; ++k) {
+        y_vals[m * N + n] += a_vals[m * K + k] * b_vals[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul", 14);
+  test.AddInput<MLFloat16>("A", {batch, M, K}, ToFloat16(a_vals));
+  test.AddInput<MLFloat16>("B", {K, N}, ToFloat16(b_vals), true);
+  test.AddOutput<MLFloat16>("Y", {batch, M, N}, ToFloat16(y_vals));
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCudaSparseMatMul, "1"));
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCudaExecutionProvider());
+  test.Config(so)
+      .ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+#endif
+
+TEST(MathOpTest, MatMulFloatCpuTunableOp) {
+  // batched MatMul so that every thread partitioning candidate is supported
+  constexpr int64_t batch = 8, M = 16, K = 32, N = 24;
+  std::vector<float> a_vals(batch * M * K);
+  std::vector<float> b_vals(batch * K * N);
+  for (size_t i = 0; i < a_vals.size(); ++i) a_vals[i] = static_cast<float>(i % 7) - 3.0f;
+  for (size_t i = 0; i < b_vals.size(); ++i) b_vals[i] = static_cast<float>(i % 5) - 2.0f;
+
+  std::vector<float> y_vals(batch * M * N, 0.0f);
+  for (int64_t b = 0; b < batch; ++b) {
+    for (int64_t m = 0; m < M; ++m) {
+      for (int64_t n = 0; n < N; ++n) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < K; ++k) {
+          sum += a_vals[(b * M + m) * K + k] * b_vals[(b * K + k) * N + n];
+        }
+        y_vals[(b * M + m) * N + n] = sum;
+      }
+    }
+  }
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuTunableOpEnable, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuTunableOpTuningEnable, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, "10"));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+
+  OpTester test("MatMul", 13);
+  test.AddInput<float>("A", {batch, M, K}, a_vals);
+  test.AddInput<float>("B", {batch, K, N}, b_vals);
+  test.AddOutput<float>("Y", {batch, M, N}, y_vals);
+  test.Config(so)
+      .ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
+TEST(MathOpTest, MatMulFloatSparseWeight) {
+  // N is not a multiple of the block width, so that the last block of every row is partial
+  constexpr int64_t batch = 2, M = 5, K = 12, N = 20;
+  std::vector<float> a_vals(batch * M * K);
+  for (size_t i = 0; i < a_vals.size(); ++i) a_vals[i] = static_cast<float>(i % 7) - 3.0f;
+
+  // contiguous non-zeros are packed in blocks, scattered ones as single elements
+  for (bool blocked : {true, false}) {
+    std::vector<float> b_vals(K * N, 0.0f);
+    for (int64_t k = 0; k < K; k += 3) {
+      if (blocked) {
+        for (int64_t n = 16; n < N; ++n) b_vals[k * N + n] = static_cast<float>(k + n) * 0.25f;
+      } else {
+        b_vals[k * N + (k * 7) % N] = static_cast<float>(k) - 5.0f;
+      }
+    }
+
+    std::vector<float> y_vals(batch * M * N, 0.0f);
+    for (int64_t m = 0; m < batch * M; ++m) {
+      for (int64_t n = 0; n < N; ++n) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < K; ++k) {
+          sum += a_vals[m * K + k] * b_vals[k * N + n];
+        }
+        y_vals[m * N + n] = sum;
+      }
+    }
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSparseWeightDensityThreshold, "0.5"));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+
+    OpTester test("MatMul", 13);
+    test.AddInput<float>("A", {batch, M, K}, a_vals);
+    test.AddInput<float>("B", {K, N}, b_vals, true);
+    test.AddOutput<float>("Y", {batch, M, N}, y_vals);
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
+TEST(MathOpTest, MatMulFloatCpuTunableOpResultsFile) {
+  constexpr int64_t batch = 8, M = 16, K = 32, N = 24;
+  std::vector<float> a_vals(batch * M * K, 1.0f);
+  std::vector<float> b_vals(batch * K * N, 2.0f);
+  std::vector<float> y_vals(batch * M * N, 2.0f * K);
+
+  const std::string results_file = "matmul_tuning_results.json";
+  std::remove(results_file.c_str());
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsTuningResultsFile, results_file.c_str()));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, "10"));
+
+  RunOptions warmup_run_options;
+  ASSERT_STATUS_OK(warmup_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigTuningWarmup, "1"));
+
+  // the warmup run tunes the MatMul and writes the file, the second session loads it
+  for (const RunOptions* options : {&warmup_run_options, static_cast<const RunOptions*>(nullptr)}) {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+
+    OpTester test("MatMul", 13);
+    test.AddInput<float>("A", {batch, M, K}, a_vals);
+    test.AddInput<float>("B", {batch, K, N}, b_vals);
+    test.AddOutput<float>("Y", {batch, M, N}, y_vals);
+    test.Config(so)
+        .Config(options)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+
+    std::ifstream file(results_file);
+    ASSERT_TRUE(file.good());
+    const auto results = nlohmann::json::parse(file);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0]["ep"], kCpuExecutionProvider);
+    EXPECT_FALSE(results[0]["results"].empty());
+  }
+
+  std::remove(results_file.c_str());
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
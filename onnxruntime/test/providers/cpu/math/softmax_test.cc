@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -405,6 +407,35 @@ TEST(SoftmaxOperator, 2DInputReduceOnAxis1WithLargeDim) {
   RunTest(x_vals, expected_vals, dimensions);
 }
 
+// Softmax along the channel axis with enough elements after the axis to process several blocks of columns
+TEST(SoftmaxOperator, ChannelAxisWithLargeInnerDims_opset13) {
+  constexpr int64_t N = 2, C = 6, HW = 35;
+  std::vector<float> x_vals(N * C * HW);
+  for (size_t i = 0; i < x_vals.size(); ++i) {
+    x_vals[i] = static_cast<float>((i * 37) % 23) * 0.25f - 3.0f;
+  }
+
+  std::vector<float> expected_vals(x_vals.size());
+  for (int64_t n = 0; n < N; ++n) {
+    for (int64_t hw = 0; hw < HW; ++hw) {
+      float max_val = std::numeric_limits<float>::lowest();
+      for (int64_t c = 0; c < C; ++c) {
+        max_val = std::max(max_val, x_vals[(n * C + c) * HW + hw]);
+      }
+      float sum = 0.0f;
+      for (int64_t c = 0; c < C; ++c) {
+        sum += std::exp(x_vals[(n * C + c) * HW + hw] - max_val);
+      }
+      for (int64_t c = 0; c < C; ++c) {
+        expected_vals[(n * C + c) * HW + hw] = std::exp(x_vals[(n * C + c) * HW + hw] - max_val) / sum;
+      }
+    }
+  }
+
+  RunTest(x_vals, expected_vals, {N, C, 5, 7}, /*opset*/ 13, /*axis*/ 1,
+          {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 // Regression test for NNAPI handling of a Softmax with opset < 13 where the input has been converted to NHWC.
 // The NNAPI handling of the axis is different so we need to manually coerce the input to 2D, which will negate the
 // layout change. Test model has a GlobalAveragePool -> Softmax which will trigger the layout change due to
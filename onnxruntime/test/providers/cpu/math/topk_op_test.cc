@@ -792,6 +792,47 @@ TEST(TopKOperator, BigArrayBigTopKSorted_double) {
   RunTest(11, 9000, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, 0, 1, 1);
 }
 
+// long rows with few of them are split into chunks that are searched in parallel. repeated values check that the
+// first instance of a value is still selected across chunk boundaries.
+static void LongRowTopK(int64_t k, int64_t largest, int64_t sorted) {
+  constexpr int64_t rows = 2;
+  constexpr int64_t cols = 50000;
+  std::vector<float> input_vals(rows * cols);
+  for (size_t i = 0; i < input_vals.size(); ++i) {
+    input_vals[i] = static_cast<float>((i * 7919) % 1000);
+  }
+
+  std::vector<float> expected_vals;
+  std::vector<int64_t> expected_indices;
+  for (int64_t i = 0; i < rows; ++i) {
+    std::vector<int64_t> row_indices(cols);
+    std::iota(row_indices.begin(), row_indices.end(), 0);
+    const float* row = input_vals.data() + i * cols;
+    std::stable_sort(row_indices.begin(), row_indices.end(), [row, largest](int64_t lhs, int64_t rhs) {
+      return largest ? row[lhs] > row[rhs] : row[lhs] < row[rhs];
+    });
+
+    for (int64_t l = 0; l < k; ++l) {
+      expected_vals.push_back(row[row_indices[l]]);
+      expected_indices.push_back(row_indices[l]);
+    }
+  }
+
+  RunTest(11, k, input_vals, {rows, cols}, expected_vals, expected_indices, {rows, k}, false, 1, largest, sorted);
+}
+
+TEST(TopKOperator, LongRowTopKSorted) {
+  LongRowTopK(1, 1, 1);
+  LongRowTopK(10, 1, 1);
+  LongRowTopK(10, 0, 1);
+  LongRowTopK(2000, 1, 1);
+}
+
+TEST(TopKOperator, LongRowTopKUnsorted) {
+  LongRowTopK(10, 1, 0);
+  LongRowTopK(2000, 0, 0);
+}
+
 template <typename T>
 static void top_3_all_same(int opset_version, int64_t largest = 1) {
   // whether it's largest or smallest we should pick the first instance/s of a number if there are multiple
@@ -511,5 +511,36 @@ TEST(LabelEncoder, DoubleNaNsMappedTogetherOpset4) {
   test.Run();
 }
 
+TEST(LabelEncoder, StringToInt64LargeTableOpset2) {
+  // enough keys that lookups prefetch ahead, and enough rows to split across threads
+  constexpr int64_t num_keys = 70000;
+  constexpr int64_t num_rows = 4096;
+  std::vector<std::string> keys;
+  std::vector<std::int64_t> values;
+  keys.reserve(num_keys);
+  values.reserve(num_keys);
+  for (int64_t i = 0; i < num_keys; ++i) {
+    keys.push_back("cat_" + std::to_string(i));
+    values.push_back(i * 7);
+  }
+
+  std::vector<std::string> input;
+  std::vector<std::int64_t> output;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    // keys past num_keys are unknown categories and map to the default
+    const int64_t key = (i * 4099) % (num_keys + num_keys / 4);
+    input.push_back("cat_" + std::to_string(key));
+    output.push_back(key < num_keys ? key * 7 : -1);
+  }
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+  test.AddAttribute("keys_strings", keys);
+  test.AddAttribute("values_int64s", values);
+  test.AddAttribute("default_int64", (std::int64_t)-1);
+  test.AddInput<std::string>("X", {num_rows}, input);
+  test.AddOutput<std::int64_t>("Y", {num_rows}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+#include <random>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -136,5 +139,47 @@ TEST(MLOpTest, SVMRegressorLinear) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMRegressorRBFManySupportVectors) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  constexpr int64_t n_supports = 67, n_features = 19, n_rows = 45;
+  constexpr float gamma = 0.05f;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> dist(-2.f, 2.f);
+
+  std::vector<float> support_vectors(n_supports * n_features), coefficients(n_supports), X(n_rows * n_features);
+  for (auto& v : support_vectors) v = dist(gen) + 10.f;
+  for (auto& v : coefficients) v = dist(gen);
+  for (auto& v : X) v = dist(gen) + 10.f;
+  std::copy(support_vectors.begin(), support_vectors.begin() + n_features, X.begin());
+  std::vector<float> rho = {0.25f};
+
+  std::vector<float> predictions(n_rows);
+  for (int64_t i = 0; i < n_rows; ++i) {
+    double sum = rho[0];
+    for (int64_t v = 0; v < n_supports; ++v) {
+      double distance = 0;
+      for (int64_t f = 0; f < n_features; ++f) {
+        double diff = static_cast<double>(X[i * n_features + f]) - support_vectors[v * n_features + f];
+        distance += diff * diff;
+      }
+      sum += coefficients[v] * std::exp(-gamma * distance);
+    }
+    predictions[i] = static_cast<float>(sum);
+  }
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", std::vector<float>{gamma, 0.f, 3.f});
+  test.AddAttribute("n_supports", n_supports);
+
+  test.AddInput<float>("X", {n_rows, n_features}, X);
+  test.AddOutput<float>("Y", {n_rows, 1}, predictions, false, 1e-4f, 1e-4f);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+#include <random>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -760,5 +763,82 @@ TEST(MLOpTest, TreeRegressorTrueNodeBeforeNode) {
   test.Run();
 }
 
+void GenCompleteTreesAndRunTest(int64_t n_trees, int64_t depth, bool strict) {
+  constexpr int64_t n_features = 6, n_rows = 120;
+  const int64_t n_internal = (int64_t{1} << depth) - 1, n_tree_nodes = (int64_t{1} << (depth + 1)) - 1;
+  std::mt19937 gen(47);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::uniform_int_distribution<int64_t> feature_dist(0, n_features - 1);
+
+  std::vector<int64_t> nodes_treeids, nodes_nodeids, nodes_featureids, nodes_truenodeids, nodes_falsenodeids;
+  std::vector<float> nodes_values;
+  std::vector<std::string> nodes_modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> target_weights;
+  for (int64_t t = 0; t < n_trees; ++t) {
+    for (int64_t k = 0; k < n_tree_nodes; ++k) {
+      bool leaf = k >= n_internal;
+      nodes_treeids.push_back(t);
+      nodes_nodeids.push_back(k);
+      nodes_featureids.push_back(leaf ? 0 : feature_dist(gen));
+      nodes_values.push_back(leaf ? 0.f : dist(gen));
+      nodes_modes.push_back(leaf ? "LEAF" : (strict ? "BRANCH_LT" : "BRANCH_LEQ"));
+      nodes_truenodeids.push_back(leaf ? 0 : 2 * k + 1);
+      nodes_falsenodeids.push_back(leaf ? 0 : 2 * k + 2);
+      if (leaf) {
+        target_treeids.push_back(t);
+        target_nodeids.push_back(k);
+        target_ids.push_back(0);
+        target_weights.push_back(dist(gen));
+      }
+    }
+  }
+
+  std::vector<float> X(n_rows * n_features);
+  for (auto& x : X) x = dist(gen);
+  X[5] = std::nanf("");
+  std::vector<float> Y(n_rows, 0.f);
+  for (int64_t i = 0; i < n_rows; ++i) {
+    for (int64_t t = 0; t < n_trees; ++t) {
+      int64_t k = 0;
+      while (k < n_internal) {
+        int64_t node = t * n_tree_nodes + k;
+        float val = X[i * n_features + nodes_featureids[node]];
+        k = (strict ? val < nodes_values[node] : val <= nodes_values[node]) ? 2 * k + 1 : 2 * k + 2;
+      }
+      Y[i] += target_weights[t * (n_tree_nodes - n_internal) + k - n_internal];
+    }
+  }
+
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+  test.AddInput<float>("X", {n_rows, n_features}, X);
+  test.AddOutput<float>("Y", {n_rows, 1}, Y);
+  test.Run();
+}
+
+TEST(MLOpTest, TreeRegressorManyDeepTrees) {
+  // Enough trees with at most 64 leaves to go through the QuickScorer evaluator.
+  GenCompleteTreesAndRunTest(40, 5, true);
+  GenCompleteTreesAndRunTest(40, 5, false);
+}
+
+TEST(MLOpTest, TreeRegressorFlatTrees) {
+  // Not enough trees for QuickScorer, trees of depth at most 8 are flattened.
+  GenCompleteTreesAndRunTest(3, 8, false);
+  GenCompleteTreesAndRunTest(3, 7, true);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,8 +1,12 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
+
 #include "gtest/gtest.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 using namespace std;
 namespace onnxruntime {
 namespace test {
@@ -979,5 +983,146 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+#ifdef USE_CUDA
+// With the default EXHAUSTIVE algo search the picked cuDNN frontend plan is written to the plan cache file, and the
+// next session loads it instead of searching again.
+TEST(ConvTest, Conv2D_CudnnPlanCacheFile) {
+  if (DefaultCudaExecutionProvider() == nullptr) {
+    GTEST_SKIP() << "CUDA EP is not available";
+  }
+
+  const std::string cache_file = "conv2d_cudnn_plan_cache.txt";
+  std::remove(cache_file.c_str());
+
+  for (int session = 0; session < 2; ++session) {
+    OpTester test("Conv", 11);
+    test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+    test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+    test.AddInput<float>("X", {1, 1, 3, 3}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f});
+    test.AddInput<float>("W", {1, 1, 3, 3}, vector<float>(9, 1.0f), true);
+    test.AddOutput<float>("Y", {1, 1, 3, 3}, {8.0f, 15.0f, 12.0f, 21.0f, 36.0f, 27.0f, 20.0f, 33.0f, 24.0f});
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCudnnConvPlanCacheFile, cache_file.c_str()));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCudaExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+
+  std::remove(cache_file.c_str());
+}
+#endif
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+
+// Runs a 2D NhwcFusedConv on float tensors and compares it to a direct computation of the convolution.
+void TestNhwcFusedConvFloat(int64_t input_channels, int64_t output_channels, int64_t group, int64_t kernel,
+                            int64_t stride, const std::string& activation, const vector<float>& activation_params,
+                            bool with_sum) {
+  const int64_t height = 11;
+  const int64_t width = 9;
+  const int64_t pad = kernel / 2;
+  const int64_t output_height = (height + 2 * pad - kernel) / stride + 1;
+  const int64_t output_width = (width + 2 * pad - kernel) / stride + 1;
+  const int64_t group_input_channels = input_channels / group;
+  const int64_t group_output_channels = output_channels / group;
+
+  auto values = [](size_t count, size_t seed) {
+    vector<float> data(count);
+    for (size_t i = 0; i < count; i++) {
+      data[i] = static_cast<float>(static_cast<int64_t>((i * 7 + seed) % 17) - 8) * 0.125f;
+    }
+    return data;
+  };
+
+  const vector<float> X = values(static_cast<size_t>(height * width * input_channels), 1);
+  const vector<float> W = values(static_cast<size_t>(output_channels * group_input_channels * kernel * kernel), 3);
+  const vector<float> B = values(static_cast<size_t>(output_channels), 5);
+  const vector<float> Z = values(static_cast<size_t>(output_height * output_width * output_channels), 11);
+
+  vector<float> Y(static_cast<size_t>(output_height * output_width * output_channels));
+  for (int64_t oh = 0; oh < output_height; oh++) {
+    for (int64_t ow = 0; ow < output_width; ow++) {
+      for (int64_t m = 0; m < output_channels; m++) {
+        const int64_t g = m / group_output_channels;
+        float sum = B[m];
+        for (int64_t ic = 0; ic < group_input_channels; ic++) {
+          for (int64_t kh = 0; kh < kernel; kh++) {
+            for (int64_t kw = 0; kw < kernel; kw++) {
+              const int64_t ih = oh * stride - pad + kh;
+              const int64_t iw = ow * stride - pad + kw;
+              if (ih < 0 || ih >= height || iw < 0 || iw >= width) {
+                continue;
+              }
+              sum += X[(ih * width + iw) * input_channels + g * group_input_channels + ic] *
+                     W[((m * group_input_channels + ic) * kernel + kh) * kernel + kw];
+            }
+          }
+        }
+        const size_t y = static_cast<size_t>((oh * output_width + ow) * output_channels + m);
+        if (with_sum) {
+          sum += Z[y];
+        }
+        if (activation == "Relu") {
+          sum = std::max(sum, 0.0f);
+        } else if (activation == "Clip") {
+          sum = std::min(std::max(sum, activation_params[0]), activation_params[1]);
+        } else if (activation == "LeakyRelu") {
+          sum = sum >= 0.0f ? sum : sum * activation_params[0];
+        }
+        Y[y] = sum;
+      }
+    }
+  }
+
+  OpTester test("NhwcFusedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("group", group);
+  test.AddAttribute("kernel_shape", vector<int64_t>{kernel, kernel});
+  test.AddAttribute("pads", vector<int64_t>{pad, pad, pad, pad});
+  test.AddAttribute("strides", vector<int64_t>{stride, stride});
+  if (!activation.empty()) {
+    test.AddAttribute("activation", activation);
+  }
+  if (!activation_params.empty()) {
+    test.AddAttribute("activation_params", activation_params);
+  }
+
+  test.AddInput<float>("X", {1, height, width, input_channels}, X);
+  test.AddInput<float>("W", {output_channels, group_input_channels, kernel, kernel}, W, true);
+  test.AddInput<float>("B", {output_channels}, B, true);
+  if (with_sum) {
+    test.AddInput<float>("Z", {1, output_height, output_width, output_channels}, Z);
+  }
+  test.AddOutput<float>("Y", {1, output_height, output_width, output_channels}, Y, false, 1e-5f, 1e-5f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
+}  // namespace
+
+TEST(ConvTest, NhwcFusedConv_Depthwise) {
+  // 3x3 and 5x5 kernels with unit and double strides, and channel counts that leave partial vectors
+  TestNhwcFusedConvFloat(20, 20, 20, 3, 1, "Relu", {}, false);
+  TestNhwcFusedConvFloat(37, 37, 37, 5, 2, "Clip", {-0.5f, 0.75f}, false);
+  TestNhwcFusedConvFloat(16, 16, 16, 3, 2, "LeakyRelu", {0.1f}, false);
+  TestNhwcFusedConvFloat(7, 7, 7, 5, 1, "", {}, false);
+  TestNhwcFusedConvFloat(19, 19, 19, 3, 1, "Relu", {}, true);
+}
+
+TEST(ConvTest, NhwcFusedConv_Gemm) {
+  TestNhwcFusedConvFloat(5, 7, 1, 3, 1, "Relu", {}, false);
+  TestNhwcFusedConvFloat(8, 12, 2, 3, 2, "Clip", {-1.0f, 1.0f}, true);
+  TestNhwcFusedConvFloat(6, 10, 1, 1, 1, "", {}, true);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
 }  // namespace test
 }  // namespace onnxruntime
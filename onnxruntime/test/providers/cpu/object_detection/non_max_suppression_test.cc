@@ -288,6 +288,45 @@ TEST(NonMaxSuppressionOpTest, SelectFromIdenticalBoxes) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManySelectedBoxesMultipleClasses) {
+  // 16 disjoint boxes with a shifted copy of each that overlaps it, so more boxes are selected than fit in one block
+  // of the IOU checks. the copies have lower scores and are suppressed.
+  constexpr int64_t num_disjoint = 16;
+  constexpr int64_t num_classes = 3;
+  std::vector<float> boxes;
+  for (int64_t i = 0; i < 2 * num_disjoint; ++i) {
+    const float x = 2.0f * static_cast<float>(i % num_disjoint) + (i < num_disjoint ? 0.0f : 0.1f);
+    boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+  }
+
+  // every class orders the disjoint boxes differently (odd multipliers are a permutation of the ranks), and the
+  // copies score below all of them
+  std::vector<float> scores;
+  std::vector<int64_t> expected;
+  for (int64_t c = 0; c < num_classes; ++c) {
+    for (int64_t i = 0; i < 2 * num_disjoint; ++i) {
+      const int64_t rank = (i % num_disjoint * (2 * c + 1) + c) % num_disjoint;
+      scores.push_back((i < num_disjoint ? 1.0f : 0.5f) - 0.01f * static_cast<float>(rank));
+    }
+
+    for (int64_t rank = 0; rank < num_disjoint; ++rank) {
+      for (int64_t i = 0; i < num_disjoint; ++i) {
+        if ((i * (2 * c + 1) + c) % num_disjoint == rank) {
+          expected.insert(expected.end(), {0L, c, i});
+        }
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {1, 2 * num_disjoint, 4}, boxes);
+  test.AddInput<float>("scores", {1, num_classes, 2 * num_disjoint}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {100L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddOutput<int64_t>("selected_indices", {num_classes * num_disjoint, 3}, expected);
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, InconsistentBoxAndScoreShapes) {
   OpTester test("NonMaxSuppression", 10, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
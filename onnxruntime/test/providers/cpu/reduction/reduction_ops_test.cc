@@ -5130,6 +5130,52 @@ TEST(ReductionOpTest, ReduceMean_KRK) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ReduceMean_KRK_parallel) {
+  // a single outer index with columns that span several blocks, as in a mean over the channels of one sample
+  OpTester test("ReduceMean");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)1);
+  constexpr size_t channels = 24;
+  constexpr size_t frames = 1000;
+  std::vector<float> in_data(channels * frames);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (float)(i % 19) - 9.f;
+  test.AddInput<float>("data", {1, channels, frames}, in_data);
+  std::vector<float> expected(frames, 0.f);
+  for (size_t j = 0; j < frames; ++j) {
+    for (size_t c = 0; c < channels; ++c) {
+      expected[j] += in_data[c * frames + j];
+    }
+    expected[j] /= channels;
+  }
+  test.AddOutput<float>("reduced", {1, 1, frames}, expected);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMax_KRK_parallel) {
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  constexpr size_t channels = 7;
+  constexpr size_t frames = 777;
+  std::vector<float> in_data(2 * channels * frames);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = (float)(i % 23) - 11.f;
+  test.AddInput<float>("data", {2, channels, frames}, in_data);
+  std::vector<float> expected(2 * frames);
+  for (size_t d = 0; d < 2; ++d) {
+    for (size_t j = 0; j < frames; ++j) {
+      float v = in_data[d * channels * frames + j];
+      for (size_t c = 1; c < channels; ++c) {
+        v = std::max(v, in_data[(d * channels + c) * frames + j]);
+      }
+      expected[d * frames + j] = v;
+    }
+  }
+  test.AddOutput<float>("reduced", {2, frames}, expected);
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceMean_KRK_keepdims) {
   OpTester test("ReduceMean");
   test.AddAttribute("axes", std::vector<int64_t>{1});
@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <iterator>
 #include <vector>
 
@@ -1235,5 +1236,80 @@ TEST(GRUTest, ONNXRuntime_TestGRUPositiveActivationAlphaBeta) {
   ctx.RunTest(X, batch_size, seq_length, sequence_length, &initial_h, expected_Y, expected_Y_h);
 }
 
+// hidden size that is not a multiple of the block size the gate activations are split into, with the expected output
+// from a reference GRU
+static void LargeHiddenSizeGruTest(bool linear_before_reset) {
+  constexpr int input_size = 3;
+  constexpr int batch_size = 2;
+  constexpr int hidden_size = 300;
+  constexpr int seq_length = 3;
+
+  auto value = [](size_t i, int scale) { return static_cast<float>(static_cast<int>(i * 37 % 17) - 8) / scale; };
+
+  std::vector<float> X(seq_length * batch_size * input_size);
+  std::vector<float> W(3 * hidden_size * input_size);
+  std::vector<float> R(3 * hidden_size * hidden_size);
+  std::vector<float> B(6 * hidden_size);
+  for (size_t i = 0; i < X.size(); ++i) X[i] = value(i, 8);
+  for (size_t i = 0; i < W.size(); ++i) W[i] = value(i + 1, 16);
+  for (size_t i = 0; i < R.size(); ++i) R[i] = value(i + 2, 256);
+  for (size_t i = 0; i < B.size(); ++i) B[i] = value(i + 3, 32);
+
+  auto sigmoid = [](float x) { return 1.0f / (1.0f + std::exp(-x)); };
+
+  std::vector<float> H(batch_size * hidden_size, 0.0f);
+  std::vector<float> Y;
+  for (int t = 0; t < seq_length; ++t) {
+    std::vector<float> H_next(H.size());
+    for (int b = 0; b < batch_size; ++b) {
+      const float* x = X.data() + (t * batch_size + b) * input_size;
+      const float* h_prev = H.data() + b * hidden_size;
+
+      // gate g and hidden unit j: x * W[g * hidden_size + j]^T + bias and state * R[g * hidden_size + j]^T
+      auto input_part = [&](int g, int j) {
+        float sum = B[g * hidden_size + j];
+        for (int k = 0; k < input_size; ++k) sum += x[k] * W[(g * hidden_size + j) * input_size + k];
+        return sum;
+      };
+      auto recurrent_part = [&](int g, int j, const std::vector<float>& state) {
+        float sum = B[(3 + g) * hidden_size + j];
+        for (int k = 0; k < hidden_size; ++k) sum += state[k] * R[(g * hidden_size + j) * hidden_size + k];
+        return sum;
+      };
+
+      std::vector<float> state(h_prev, h_prev + hidden_size);
+      std::vector<float> z(hidden_size);
+      std::vector<float> r(hidden_size);
+      for (int j = 0; j < hidden_size; ++j) {
+        z[j] = sigmoid(input_part(0, j) + recurrent_part(0, j, state));
+        r[j] = sigmoid(input_part(1, j) + recurrent_part(1, j, state));
+      }
+
+      std::vector<float> reset_state(hidden_size);
+      for (int j = 0; j < hidden_size; ++j) reset_state[j] = r[j] * state[j];
+
+      for (int j = 0; j < hidden_size; ++j) {
+        const float h = std::tanh(input_part(2, j) + (linear_before_reset ? r[j] * recurrent_part(2, j, state)
+                                                                          : recurrent_part(2, j, reset_state)));
+        H_next[b * hidden_size + j] = (1.0f - z[j]) * h + z[j] * state[j];
+      }
+    }
+
+    H = H_next;
+    Y.insert(Y.end(), H.begin(), H.end());
+  }
+
+  RunGruTest(X, W, R, Y, H, input_size, batch_size, hidden_size, seq_length, &B, nullptr, nullptr, "forward",
+             9999.f, true, linear_before_reset);
+}
+
+TEST(GRUTest, ForwardLargeHiddenSize) {
+  LargeHiddenSizeGruTest(false);
+}
+
+TEST(GRUTest, ForwardLargeHiddenSizeLinearBeforeReset) {
+  LargeHiddenSizeGruTest(true);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
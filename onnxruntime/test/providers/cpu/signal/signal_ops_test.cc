@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <functional>
 #include <vector>
 
@@ -116,6 +117,53 @@ TEST(SignalOpsTest, DFT20_Float_inverse) {
   TestInverseFloat(kOpsetVersion20);
 }
 
+// naive dft of the real signal x, returning (real, imaginary) pairs for the first output_size frequencies
+static vector<float> NaiveDFT(const float* x, size_t dft_length, size_t output_size) {
+  vector<float> output;
+  for (size_t k = 0; k < output_size; k++) {
+    double real = 0;
+    double imaginary = 0;
+    for (size_t n = 0; n < dft_length; n++) {
+      const double angle = -2.0 * M_PI * static_cast<double>(k * n % dft_length) / static_cast<double>(dft_length);
+      real += x[n] * std::cos(angle);
+      imaginary += x[n] * std::sin(angle);
+    }
+    output.push_back(static_cast<float>(real));
+    output.push_back(static_cast<float>(imaginary));
+  }
+  return output;
+}
+
+// lengths that are not powers of 2 but factor into small radices use the mixed radix fft
+static void TestMixedRadixDFTFloat(int64_t dft_length, bool onesided) {
+  OpTester test("DFT", kMinOpsetVersion);
+
+  constexpr int64_t batch_size = 3;
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<int64_t> input_shape{batch_size, dft_length, 1};
+  vector<float> input = random.Uniform<float>(input_shape, -1.f, 1.f);
+
+  const int64_t output_size = onesided ? (dft_length >> 1) + 1 : dft_length;
+  vector<float> expected_output;
+  for (int64_t b = 0; b < batch_size; b++) {
+    vector<float> batch_output = NaiveDFT(input.data() + b * dft_length, static_cast<size_t>(dft_length),
+                                          static_cast<size_t>(output_size));
+    expected_output.insert(expected_output.end(), batch_output.begin(), batch_output.end());
+  }
+
+  test.AddInput<float>("input", input_shape, input);
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+  test.AddOutput<float>("output", {batch_size, output_size, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.0005f);
+  test.Run();
+}
+
+TEST(SignalOpsTest, DFT17_Float_mixed_radix) {
+  TestMixedRadixDFTFloat(12, false);
+  TestMixedRadixDFTFloat(105, false);
+  TestMixedRadixDFTFloat(400, true);
+}
+
 // Tests that FFT(FFT(x), inverse=true) == x
 static void TestDFTInvertible(bool complex, int since_version) {
   // TODO: test dft_length
@@ -233,6 +281,45 @@ TEST(SignalOpsTest, STFTFloat) {
   test.Run();
 }
 
+TEST(SignalOpsTest, STFTFloat_mixed_radix) {
+  OpTester test("STFT", kMinOpsetVersion);
+
+  constexpr int64_t batch_size = 2;
+  constexpr int64_t signal_size = 100;
+  constexpr int64_t frame_length = 20;
+  constexpr int64_t frame_step = 10;
+  constexpr int64_t n_dfts = (signal_size - frame_length) / frame_step + 1;
+  constexpr int64_t output_size = frame_length / 2 + 1;
+
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<int64_t> signal_shape{batch_size, signal_size, 1};
+  vector<float> signal = random.Uniform<float>(signal_shape, -1.f, 1.f);
+  vector<float> window(frame_length);
+  for (int64_t i = 0; i < frame_length; i++) {
+    window[i] = 0.5f - 0.5f * std::cos(2.0f * static_cast<float>(M_PI) * i / frame_length);
+  }
+
+  vector<float> expected_output;
+  for (int64_t b = 0; b < batch_size; b++) {
+    for (int64_t i = 0; i < n_dfts; i++) {
+      vector<float> frame(frame_length);
+      for (int64_t n = 0; n < frame_length; n++) {
+        frame[n] = signal[b * signal_size + i * frame_step + n] * window[n];
+      }
+      vector<float> frame_output = NaiveDFT(frame.data(), frame_length, output_size);
+      expected_output.insert(expected_output.end(), frame_output.begin(), frame_output.end());
+    }
+  }
+
+  test.AddInput<float>("signal", signal_shape, signal);
+  test.AddInput<int64_t>("frame_step", {}, {frame_step});
+  test.AddInput<float>("window", {frame_length}, window);
+  test.AddInput<int64_t>("frame_length", {}, {frame_length});
+  test.AddOutput<float>("output", {batch_size, n_dfts, output_size, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.0002f);
+  test.Run();
+}
+
 TEST(SignalOpsTest, HannWindowFloat) {
   OpTester test("HannWindow", kMinOpsetVersion);
 
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -444,5 +446,35 @@ TEST(ConcatOpTest, Concat4D_2) {
   test.Run();
 }
 
+// appending a step to a cache in [batch, heads, sequence, head_size] layout, with inputs of different sizes along the
+// axis, including an empty one
+TEST(ConcatOpTest, Concat4D_KVCacheAppend) {
+  OpTester test("Concat", 13);
+  test.AddAttribute("axis", int64_t{2});
+
+  constexpr int64_t batch = 2;
+  constexpr int64_t heads = 3;
+  constexpr int64_t past_length = 4;
+  constexpr int64_t head_size = 5;
+
+  std::vector<int64_t> past(batch * heads * past_length * head_size);
+  std::vector<int64_t> present_step(batch * heads * head_size);
+  std::iota(past.begin(), past.end(), 0);
+  std::iota(present_step.begin(), present_step.end(), 1000);
+
+  std::vector<int64_t> expected;
+  for (int64_t bh = 0; bh < batch * heads; ++bh) {
+    expected.insert(expected.end(), past.begin() + bh * past_length * head_size,
+                    past.begin() + (bh + 1) * past_length * head_size);
+    expected.insert(expected.end(), present_step.begin() + bh * head_size, present_step.begin() + (bh + 1) * head_size);
+  }
+
+  test.AddInput<int64_t>("past", {batch, heads, past_length, head_size}, past);
+  test.AddInput<int64_t>("empty", {batch, heads, 0, head_size}, {});
+  test.AddInput<int64_t>("present_step", {batch, heads, 1, head_size}, present_step);
+  test.AddOutput<int64_t>("concat_result", {batch, heads, past_length + 1, head_size}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -337,6 +337,23 @@ TEST(GatherOpTest, Gather_axis1_indices2d_string) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_axis0_indices2d_string) {
+  // each index selects a row of several strings
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 3},
+                             {"0", "1", "2",
+                              "10", "11", "12",
+                              "20", "21", "22"});
+  test.AddInput<int64_t>("indices", {2, 2},
+                         {2, 0,
+                          -2, 2});
+  test.AddOutput<std::string>("output", {2, 2, 3},
+                              {"20", "21", "22", "0", "1", "2",
+                               "10", "11", "12", "20", "21", "22"});
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_indices2d_bool) {
   OpTester test("Gather");
   test.AddAttribute<int64_t>("axis", 1LL);
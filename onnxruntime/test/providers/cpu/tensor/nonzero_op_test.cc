@@ -99,5 +99,29 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+// large enough to be processed in several blocks
+TEST(NonZeroOpTest, LargeInput) {
+  constexpr int64_t rows = 300, cols = 331;
+  std::vector<float> X(rows * cols, 0.0f);
+  std::vector<int64_t> row_indices, col_indices;
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t c = 0; c < cols; ++c) {
+      if ((r * cols + c) % 7 == 0 || (r + c) % 11 == 0) {
+        X[r * cols + c] = static_cast<float>(r - c) + 0.5f;
+        row_indices.push_back(r);
+        col_indices.push_back(c);
+      }
+    }
+  }
+
+  std::vector<int64_t> Y(row_indices);
+  Y.insert(Y.end(), col_indices.begin(), col_indices.end());
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<float>("X", {rows, cols}, X);
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(row_indices.size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1681,6 +1681,46 @@ TEST(DequantizeLinearOp21BlockedTest, UnsignedInt_UseZeroPoint_LastAxis_Cuda) {
                                                                    DefaultCudaExecutionProvider());
 }
 
+// odd block sizes make the quantize blocks start in the middle of the packed 4-bit elements
+TEST(DequantizeLinearOp21BlockedTest, SignedInt_UseZeroPoint_OddBlocks) {
+  auto make_case = [](int64_t M, int64_t K, int64_t N, int64_t block_size,
+                      std::vector<int>& x, std::vector<float>& x_scale, std::vector<int>& zero_point,
+                      std::vector<float>& y) {
+    const int64_t block_count = (K + block_size - 1) / block_size;
+    for (int64_t i = 0; i < M * block_count * N; ++i) {
+      x_scale.push_back(static_cast<float>(i % 7 + 1) * (i % 2 ? 0.5f : -0.25f));
+      zero_point.push_back(static_cast<int>(i % 16) - 8);
+    }
+    for (int64_t m = 0; m < M; ++m) {
+      for (int64_t k = 0; k < K; ++k) {
+        for (int64_t n = 0; n < N; ++n) {
+          const int v = static_cast<int>((m * K + k) * N + n) % 16 - 8;
+          const size_t param = static_cast<size_t>((m * block_count + k / block_size) * N + n);
+          x.push_back(v);
+          y.push_back(static_cast<float>(v - zero_point[param]) * x_scale[param]);
+        }
+      }
+    }
+  };
+
+  {
+    std::vector<int> x, zero_point;
+    std::vector<float> x_scale, y;
+    make_case(6, 67, 1, 5, x, x_scale, zero_point, y);
+    DequantizeLinearOp21BlockedTest_Int4_Succeed<Int4x2, float>({6, 67}, 1, 5, x, x_scale, zero_point, y);
+    DequantizeLinearOp21BlockedTest_Int4_Succeed<Int4x2, MLFloat16>({6, 67}, 1, 5, x, x_scale, zero_point, y);
+    DequantizeLinearOp21BlockedTest_Int_Succeed<int8_t, float>({6, 67}, 1, 5, x, x_scale, zero_point, y);
+  }
+  {
+    std::vector<int> x, zero_point;
+    std::vector<float> x_scale, y;
+    make_case(3, 37, 5, 3, x, x_scale, zero_point, y);
+    DequantizeLinearOp21BlockedTest_Int4_Succeed<Int4x2, float>({3, 37, 5}, 1, 3, x, x_scale, zero_point, y);
+    DequantizeLinearOp21BlockedTest_Int4_Succeed<Int4x2, MLFloat16>({3, 37, 5}, 1, 3, x, x_scale, zero_point, y);
+    DequantizeLinearOp21BlockedTest_Int_Succeed<int8_t, float>({3, 37, 5}, 1, 3, x, x_scale, zero_point, y);
+  }
+}
+
 #if !defined(DISABLE_FLOAT8_TYPES)
 TEST(DequantizeLinearOp21BlockedTest, Float8_NoZeroPoint_FirstAxis) {
   constexpr int min_cuda_architecture = 11080;
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <exception>
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -724,6 +725,48 @@ TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_asymmetric_scales) {
   run_test(true);
 }
 
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_asymmetric_MultiChannel) {
+  // several images with a few channels each, so the output rows of different images are resized in parallel
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  constexpr int64_t N = 2, C = 3, H = 3, W = 5;
+  constexpr int64_t OH = H * 2, OW = W * 2;
+  std::vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>((i * 7) % 11);
+  }
+
+  std::vector<float> Y;
+  Y.reserve(N * C * OH * OW);
+  for (int64_t image = 0; image < N * C; ++image) {
+    const float* x_data = X.data() + image * H * W;
+    for (int64_t oy = 0; oy < OH; ++oy) {
+      const float in_y = std::min(static_cast<float>(oy) / 2, static_cast<float>(H - 1));
+      const int64_t y1 = static_cast<int64_t>(in_y), y2 = std::min(y1 + 1, H - 1);
+      const float dy = in_y - static_cast<float>(y1);
+      for (int64_t ox = 0; ox < OW; ++ox) {
+        const float in_x = std::min(static_cast<float>(ox) / 2, static_cast<float>(W - 1));
+        const int64_t x1 = static_cast<int64_t>(in_x), x2 = std::min(x1 + 1, W - 1);
+        const float dx = in_x - static_cast<float>(x1);
+        const float top = x_data[y1 * W + x1] * (1 - dx) + x_data[y1 * W + x2] * dx;
+        const float bottom = x_data[y2 * W + x1] * (1 - dx) + x_data[y2 * W + x2] * dx;
+        Y.push_back(top * (1 - dy) + bottom * dy);
+      }
+    }
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales, true);
+  test.AddOutput<float>("Y", {N, C, OH, OW}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
+}
+
 TEST(ResizeOpTest, NhwcResizeOpLinearUpSampleTest_4DBilinear_asymmetric_uint8) {
   // To test NNAPI EP, we need the scales/sizes to be in initializers
   auto run_test = [](bool scales_in_initializer) {
@@ -780,6 +780,46 @@ TEST(TransposeOpTest, DoTransposeEltWise) {
   }
 }
 
+template <typename T>
+static void TransposeBlockedTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  TensorShape shape(input_shape);
+  std::vector<T> input_vals(static_cast<size_t>(shape.Size()));
+  for (size_t i = 0; i < input_vals.size(); ++i) {
+    input_vals[i] = static_cast<T>(i % 251);
+  }
+
+  std::vector<int64_t> expected_shape(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    expected_shape[i] = input_shape[perm[i]];
+  }
+
+  // walk the output in order and compute the matching input offset
+  std::vector<T> expected_vals(input_vals.size());
+  std::vector<int64_t> index(rank, 0);
+  for (size_t out = 0; out < expected_vals.size(); ++out) {
+    int64_t in = 0;
+    for (size_t i = 0; i < rank; ++i) {
+      in += index[i] * shape.SizeFromDimension(perm[i] + 1);
+    }
+    expected_vals[out] = input_vals[static_cast<size_t>(in)];
+    for (size_t i = rank; i > 0 && ++index[i - 1] == expected_shape[i - 1]; --i) {
+      index[i - 1] = 0;
+    }
+  }
+
+  TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals);
+}
+
+TEST(TransposeOpTest, DoTransposeBlocked) {
+  // Configurations where DoTransposeBlocked is called, with planes that are not a multiple of the tile size.
+  TransposeBlockedTest<float>({3, 17, 5, 35}, {1, 3, 0, 2});
+  TransposeBlockedTest<float>({33, 2, 20}, {2, 1, 0});
+  TransposeBlockedTest<double>({4, 6, 19, 9}, {0, 3, 2, 1});
+  TransposeBlockedTest<int16_t>({7, 8, 21, 4}, {3, 2, 1, 0});
+  TransposeBlockedTest<uint8_t>({6, 3, 40, 18}, {3, 2, 1, 0});
+}
+
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
 #elif USE_ROCM
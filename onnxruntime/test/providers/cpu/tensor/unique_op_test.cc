@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -137,6 +141,56 @@ TEST(Unique, Flatten_Sorted_String) {
                              inverse_indices_dims, inverse_indices, counts_dims, counts);
 }
 
+// large enough to be processed in several blocks, with values that first occur in later blocks
+TEST(Unique, Flatten_LargeInput) {
+  constexpr int64_t size = 100000;
+  std::vector<int64_t> X(size);
+  for (int64_t i = 0; i < size; ++i) {
+    X[i] = i < size / 2 ? i % 500 : 999 - i % 1000;
+  }
+
+  for (bool sorted : {false, true}) {
+    // expected output in the order of the first occurrences
+    std::vector<int64_t> Y, indices, counts;
+    std::vector<int64_t> inverse_indices(size);
+    std::unordered_map<int64_t, size_t> unique_idx;
+    for (int64_t i = 0; i < size; ++i) {
+      auto entry = unique_idx.emplace(X[i], Y.size());
+      if (entry.second) {
+        Y.push_back(X[i]);
+        indices.push_back(i);
+        counts.push_back(0);
+      }
+      ++counts[entry.first->second];
+      inverse_indices[i] = static_cast<int64_t>(entry.first->second);
+    }
+
+    if (sorted) {
+      std::vector<size_t> order(Y.size());
+      std::iota(order.begin(), order.end(), size_t{0});
+      std::sort(order.begin(), order.end(), [&Y](size_t lhs, size_t rhs) { return Y[lhs] < Y[rhs]; });
+      std::vector<int64_t> sorted_position(Y.size());
+      std::vector<int64_t> sorted_Y, sorted_indices, sorted_counts;
+      for (size_t i = 0; i < order.size(); ++i) {
+        sorted_position[order[i]] = static_cast<int64_t>(i);
+        sorted_Y.push_back(Y[order[i]]);
+        sorted_indices.push_back(indices[order[i]]);
+        sorted_counts.push_back(counts[order[i]]);
+      }
+      for (auto& inverse_index : inverse_indices) {
+        inverse_index = sorted_position[inverse_index];
+      }
+      Y = std::move(sorted_Y);
+      indices = std::move(sorted_indices);
+      counts = std::move(sorted_counts);
+    }
+
+    const std::vector<int64_t> unique_dims{static_cast<int64_t>(Y.size())};
+    RunUniqueTest<int64_t>({size}, X, nullptr, sorted, unique_dims, Y, unique_dims, indices,
+                           {size}, inverse_indices, unique_dims, counts);
+  }
+}
+
 TEST(Unique, NoOptionalOutput) {
   const std::vector<int64_t> X_dims{2, 4};
   const std::vector<int8_t> X{1, 4, -1, 2, 2, 0, -1, 4};
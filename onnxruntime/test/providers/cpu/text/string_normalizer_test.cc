@@ -230,6 +230,29 @@ TEST(ContribOpTest, StringNormalizerSensitiveFilterOutUpperSameOutput) {
   test.AddOutput<std::string>("Y", {1, 1}, output);
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
+
+TEST(ContribOpTest, StringNormalizerSensitiveFilterOutLowerLargeBatch) {
+  // - casesensitive approach
+  // - filter out monday
+  // - LOWER, with enough rows to be split across the thread pool
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "LOWER", true, {"monday"}, test_locale);
+  const std::vector<std::string> days = {"monday", "Tuesday", "WEDNESDAY", "Thursday"};
+  const std::vector<std::string> lower_days = {"monday", "tuesday", "wednesday", "thursday"};
+  constexpr int64_t kRows = 2000;
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (int64_t i = 0; i < kRows; ++i) {
+    const auto d = static_cast<size_t>(i % 4);
+    input.push_back(days[d]);
+    if (days[d] != "monday") {
+      output.push_back(lower_days[d]);
+    }
+  }
+  test.AddInput<std::string>("T", {kRows}, input);
+  test.AddOutput<std::string>("Y", {static_cast<int64_t>(output.size())}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
 #endif
 
 }  // namespace test
@@ -122,5 +122,32 @@ TEST(StringSplit, NoInputTest) {
   test.Run();
 }
 
+TEST(StringSplit, LargeBatchTest) {
+  // enough rows to be split across the thread pool
+  constexpr int64_t kRows = 1024;
+  std::vector<std::string> input;
+  std::vector<std::string> expected_y;
+  std::vector<int64_t> expected_z;
+  for (int64_t i = 0; i < kRows; ++i) {
+    const auto n_tokens = 1 + (i % 3);
+    std::string s;
+    for (int64_t t = 0; t < n_tokens; ++t) {
+      if (t > 0) s += ",";
+      s += "tok" + std::to_string(i) + "_" + std::to_string(t);
+    }
+    input.push_back(s);
+    for (int64_t t = 0; t < 3; ++t) {
+      expected_y.push_back(t < n_tokens ? "tok" + std::to_string(i) + "_" + std::to_string(t) : "");
+    }
+    expected_z.push_back(n_tokens);
+  }
+  OpTester test("StringSplit", 20);
+  test.AddInput<std::string>("X", {kRows}, input);
+  test.AddAttribute<std::string>("delimiter", ",");
+  test.AddOutput<std::string>("Y", {kRows, 3}, expected_y);
+  test.AddOutput<int64_t>("Z", {kRows}, expected_z);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
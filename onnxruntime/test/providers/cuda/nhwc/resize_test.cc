@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/providers/cuda/nhwc/nhwc_cuda_helper.h"
+
+namespace onnxruntime {
+namespace test {
+
+template <typename T>
+struct ResizeOp {
+  std::vector<int64_t> input_dims;
+  std::vector<float> scales;
+  std::string nearest_mode = "round_prefer_floor";
+
+  std::unique_ptr<CompareOpTester> get_test() {
+    RandomValueGenerator random{};
+
+    auto test = std::make_unique<CompareOpTester>("Resize", 13);
+    std::vector<T> input_data = random.Uniform<T>(input_dims, 0.0f, 1.0f);
+    test->AddInput<T>("X", input_dims, input_data);
+    test->AddOptionalInputEdge<float>();
+    // the scales have to be constant for the layout transformer to convert them
+    test->AddInput<float>("scales", {static_cast<int64_t>(scales.size())}, scales, true);
+
+    test->AddAttribute("mode", "nearest");
+    test->AddAttribute("nearest_mode", nearest_mode);
+
+    std::vector<int64_t> output_dims(input_dims.size());
+    for (size_t i = 0; i < input_dims.size(); ++i) {
+      output_dims[i] = static_cast<int64_t>(input_dims[i] * scales[i]);
+    }
+    std::vector<T> output_data = FillZeros<T>(output_dims);
+    test->AddOutput<T>("Y", output_dims, output_data);
+    return test;
+  }
+};
+
+TYPED_TEST(CudaNhwcTypedTest, ResizeNearestUpsampleNhwc) {
+  auto op = ResizeOp<TypeParam>{};
+  op.input_dims = {2, 16, 15, 17};
+  op.scales = {1.0f, 1.0f, 2.0f, 2.0f};
+
+  MAKE_PROVIDERS_EPS(0.0)
+}
+
+TYPED_TEST(CudaNhwcTypedTest, ResizeNearestDownsampleNhwc) {
+  auto op = ResizeOp<TypeParam>{};
+  op.input_dims = {1, 8, 32, 24};
+  op.scales = {1.0f, 1.0f, 0.5f, 0.75f};
+  op.nearest_mode = "floor";
+
+  MAKE_PROVIDERS_EPS(0.0)
+}
+
+}  // namespace test
+}  // namespace onnxruntime
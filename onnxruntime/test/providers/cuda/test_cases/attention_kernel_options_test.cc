@@ -169,7 +169,9 @@ TEST(AttentionKernelOptionsTest, DefaultOptionWithEnvVar) {
           {onnxruntime::contrib::attention::kEnableFusedCausalAttention, "1"},
           {onnxruntime::contrib::attention::kEnableFusedCausalAttention, "1"},
           {onnxruntime::contrib::attention::kMinSeqLenForFlashAttentionPackedQKV, "128"},
-          {onnxruntime::contrib::attention::kMinSeqLenForEfficientAttentionFp32, "256"}}};
+          {onnxruntime::contrib::attention::kMinSeqLenForEfficientAttentionFp32, "256"},
+          {onnxruntime::contrib::attention::kMinSeqLenForLeanAttention, "4096"},
+          {onnxruntime::contrib::attention::kMaxNumSplitsForFlashAttention, "16"}}};
   AttentionKernelOptions options;
   options.InitializeOnce(value, false);
   ASSERT_TRUE(options.UseFlashAttention());
@@ -183,6 +185,8 @@ TEST(AttentionKernelOptionsTest, DefaultOptionWithEnvVar) {
   ASSERT_TRUE(options.UseTrtCausalAttention());
   EXPECT_EQ(options.MinSeqLenForFlashAttentionPackedQkv(), 128);
   EXPECT_EQ(options.MinSeqLenForEfficientAttentionFp32(), 256);
+  EXPECT_EQ(options.MinSeqLenForLeanAttention(), 4096);
+  EXPECT_EQ(options.MaxNumSplitsForFlashAttention(), 16);
 }
 
 // Test default min sequence lengths when environment variables are not set.
@@ -213,6 +217,10 @@ TEST(AttentionKernelOptionsTest, DefaultMinSeqLens) {
             onnxruntime::contrib::attention::kDefaultMinSeqLenForFlashAttentionPackedQKV);
   EXPECT_EQ(options.MinSeqLenForEfficientAttentionFp32(),
             onnxruntime::contrib::attention::kDefaultMinSeqLenForEfficientAttentionFp32);
+  EXPECT_EQ(options.MinSeqLenForLeanAttention(),
+            onnxruntime::contrib::attention::kDefaultMinSeqLenForLeanAttention);
+  EXPECT_EQ(options.MaxNumSplitsForFlashAttention(),
+            onnxruntime::contrib::attention::kDefaultMaxNumSplitsForFlashAttention);
 }
 
 }  // namespace test
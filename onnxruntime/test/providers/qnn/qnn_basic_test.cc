@@ -672,6 +672,14 @@ TEST_F(QnnHTPBackendTests, MultithreadHtpPowerCfgSessionRunOption) {
                                   output_shapes, output_values, loop_count));
   }
 
+  // "auto" mode, which bursts during the run and relaxes post run
+  RunOptions auto_run_opts;
+  auto_run_opts.run_tag = session_opts.session_logid;
+  ASSERT_TRUE(auto_run_opts.config_options.AddConfigEntry(kOrtRunOptionsConfigQnnPerfMode, "auto").IsOK());
+  threads.push_back(std::thread(RunSessionAndVerify, std::ref(session_obj), auto_run_opts,
+                                model->builder.feeds_, model->builder.output_names_,
+                                output_shapes, output_values, loop_count));
+
   for (auto& th : threads) {
     th.join();
   }
@@ -1125,6 +1125,98 @@ TEST_F(QnnHTPBackendTests, QnnContextShareAcrossSessions2) {
   }
   std::remove(last_qnn_ctx_binary_file_name.c_str());
 }
+
+// 1. Create 2 QDQ models
+// 2. Generate the context models from 2 Ort sessions with ep.share_ep_contexts, and ep.stop_share_ep_contexts on
+// the last one, so the graphs of both models are compiled into one QNN context
+// 3. Both context models refer to the same context binary file, which contains all graphs
+// 4. Start 2 ort sessions from the dumped context models and run the 2nd session, which uses the graph loaded by
+// the 1st session
+TEST_F(QnnHTPBackendTests, QnnContextShareAcrossSessions3) {
+  ProviderOptions provider_options;
+#if defined(_WIN32)
+  provider_options["backend_path"] = "QnnHtp.dll";
+#else
+  provider_options["backend_path"] = "libQnnHtp.so";
+#endif
+  provider_options["enable_htp_weight_sharing"] = "1";
+
+  // Create QDQ models
+  std::vector<std::string> onnx_model_paths{"./weight_share31.onnx", "./weight_share32.onnx"};
+  std::vector<std::string> ctx_model_paths;
+  for (auto model_path : onnx_model_paths) {
+    CreateQdqModel(model_path, DefaultLoggingManager().DefaultLogger());
+    EXPECT_TRUE(std::filesystem::exists(model_path.c_str()));
+    ctx_model_paths.push_back(model_path + "_ctx.onnx");
+  }
+
+  // Generate the context models; the node name prefix avoids the same graph names from the identical models
+  for (size_t i = 0; i < onnx_model_paths.size(); ++i) {
+    Ort::SessionOptions so;
+    so.AddConfigEntry(kOrtSessionOptionEpContextEnable, "1");
+    so.AddConfigEntry(kOrtSessionOptionEpContextEmbedMode, "0");
+    so.AddConfigEntry(kOrtSessionOptionEpContextNodeNamePrefix, ("share" + std::to_string(i)).c_str());
+    so.AddConfigEntry(kOrtSessionOptionShareEpContexts, "1");
+    if (i + 1 == onnx_model_paths.size()) {
+      so.AddConfigEntry(kOrtSessionOptionStopShareEpContexts, "1");
+    }
+    so.AppendExecutionProvider("QNN", provider_options);
+
+    Ort::Session session(*ort_env, ToPathString(onnx_model_paths[i]).c_str(), so);
+    EXPECT_TRUE(std::filesystem::exists(ctx_model_paths[i].c_str()));
+  }
+
+  std::string first_qnn_ctx_binary_file_name;
+  GetLastContextBinaryFileName(ctx_model_paths.front(), first_qnn_ctx_binary_file_name,
+                               DefaultLoggingManager().DefaultLogger());
+  std::string last_qnn_ctx_binary_file_name;
+  GetLastContextBinaryFileName(ctx_model_paths.back(), last_qnn_ctx_binary_file_name,
+                               DefaultLoggingManager().DefaultLogger());
+  EXPECT_TRUE(!last_qnn_ctx_binary_file_name.empty());
+  EXPECT_EQ(first_qnn_ctx_binary_file_name, last_qnn_ctx_binary_file_name);
+
+  Ort::SessionOptions so;
+  so.AddConfigEntry(kOrtSessionOptionShareEpContexts, "1");
+  so.AppendExecutionProvider("QNN", provider_options);
+  Ort::SessionOptions so_last(so.Clone());
+  so_last.AddConfigEntry(kOrtSessionOptionStopShareEpContexts, "1");
+
+  Ort::Session session1(*ort_env, ToPathString(ctx_model_paths[0]).c_str(), so);
+  Ort::Session session2(*ort_env, ToPathString(ctx_model_paths[1]).c_str(), so_last);
+
+  std::vector<std::string> input_names;
+  std::vector<std::string> output_names;
+  GetModelInputNames(ctx_model_paths[1], input_names, output_names,
+                     DefaultLoggingManager().DefaultLogger());
+
+  // Run the 2nd session
+  std::vector<int64_t> input_dim{2, 3};
+  std::vector<float> input_value(2 * 3, 0.0f);
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<Ort::Value> ort_inputs;
+  std::vector<const char*> input_names_c;
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    auto input_tensor = Ort::Value::CreateTensor(info, input_value.data(), input_value.size(),
+                                                 input_dim.data(), input_dim.size());
+    ort_inputs.push_back(std::move(input_tensor));
+    input_names_c.push_back(input_names[i].c_str());
+  }
+  std::vector<const char*> output_names_c;
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    output_names_c.push_back(output_names[i].c_str());
+  }
+
+  auto ort_outputs2 = session2.Run(Ort::RunOptions{}, input_names_c.data(), ort_inputs.data(), ort_inputs.size(),
+                                   output_names_c.data(), 1);
+
+  for (auto model_path : onnx_model_paths) {
+    std::remove(model_path.c_str());
+  }
+  for (auto ctx_model_path : ctx_model_paths) {
+    std::remove(ctx_model_path.c_str());
+  }
+  std::remove(last_qnn_ctx_binary_file_name.c_str());
+}
 #endif  // defined(__aarch64__) || defined(_M_ARM64) || defined(__linux__)
 
 }  // namespace test
@@ -15,6 +15,7 @@
 
 #include "test/common/tensor_op_test_utils.h"
 #include "test/framework/test_utils.h"
+#include "test/providers/provider_test_utils.h"
 #include "test/test_environment.h"
 #include "test/util/include/asserts.h"
 #include "test/util/include/default_providers.h"
@@ -557,6 +558,65 @@ TEST(XnnpackEP, DISABLED_TestResize_u8_and_s8_NHWC_pytorch_half_pixel) {  // [ON
                {ExpectedEPNodeAssignment::Some, 1e-2f /* fp32_abs_err */});
 }
 
+#ifndef ENABLE_TRAINING
+// Prepacking is disabled in full training build so no need to test the feature in a training build.
+TEST(XnnpackEP, MatMulSharedPrepackedWeights) {
+  OpTester test("MatMul");
+
+  std::vector<float> b_init_values(12, 1.0f);
+  test.AddInput<float>("A", {2, 4},
+                       {1.0f, 2.0f, 3.0f, 4.0f,
+                        -1.0f, -2.0f, -3.0f, -4.0f});
+  // B is to be an initializer for triggering pre-packing
+  test.AddInput<float>("B", {4, 3}, b_init_values, true);
+
+  test.AddOutput<float>("Y", {2, 3},
+                        {10.0f, 10.0f, 10.0f,
+                         -10.0f, -10.0f, -10.0f});
+
+  OrtValue b;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({4, 3}),
+                       b_init_values.data(), OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator), b);
+
+  SessionOptions so;
+  // Set up B as a shared initializer to be shared between sessions
+  ASSERT_STATUS_OK(so.AddInitializer("B", &b));
+
+  test.EnableSharingOfPrePackedWeightsAcrossSessions();
+
+  auto xnnpack_ep = []() -> std::vector<std::unique_ptr<IExecutionProvider>> {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultXnnpackExecutionProvider());
+    return execution_providers;
+  };
+
+  size_t number_of_pre_packed_weights_counter_session_1 = 0;
+  size_t number_of_shared_pre_packed_weights_counter = 0;
+
+  // Session 1
+  {
+    test.Config(so)
+        .ConfigEps(xnnpack_ep())
+        .RunWithConfig(&number_of_pre_packed_weights_counter_session_1, &number_of_shared_pre_packed_weights_counter);
+    ASSERT_EQ(number_of_pre_packed_weights_counter_session_1, static_cast<size_t>(1));
+    ASSERT_EQ(number_of_shared_pre_packed_weights_counter, static_cast<size_t>(0));
+  }
+
+  // The weights packed by XNNPACK are in the shared container
+  ASSERT_EQ(test.GetNumPrePackedWeightsShared(), static_cast<size_t>(1));
+
+  // Session 2 uses the packed weights of session 1
+  {
+    size_t number_of_pre_packed_weights_counter_session_2 = 0;
+    test.Config(so)
+        .ConfigEps(xnnpack_ep())
+        .RunWithConfig(&number_of_pre_packed_weights_counter_session_2, &number_of_shared_pre_packed_weights_counter);
+    ASSERT_EQ(number_of_pre_packed_weights_counter_session_2, static_cast<size_t>(1));
+    ASSERT_EQ(number_of_shared_pre_packed_weights_counter, static_cast<size_t>(1));
+  }
+}
+#endif
+
 #endif
 
 }  // namespace test
@@ -10,6 +10,7 @@
 #include <mutex>
 #include <algorithm>
 #include <thread>
+#include <cstdio>
 
 #include <absl/base/config.h>
 #include "gtest/gtest.h"
@@ -2073,6 +2074,81 @@ TEST(CApiTest, io_binding) {
   binding.ClearBoundOutputs();
 }
 
+TEST(CApiTest, run_context) {
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::RunContext run_context(session, input_names, 1, output_names, 1);
+
+  // all the inputs must be bound
+  ASSERT_THROW(session.Run(Ort::RunOptions(), run_context), Ort::Exception);
+
+  run_context.BindInput(0, x);
+  session.Run(Ort::RunOptions(), run_context);
+  {
+    const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+    Ort::ConstValue y = run_context.GetOutput(0);
+    ASSERT_EQ(y.GetTensorTypeAndShapeInfo().GetElementCount(), expected_y.size());
+    const float* y_values = y.GetTensorData<float>();
+    ASSERT_TRUE(std::equal(y_values, y_values + expected_y.size(), std::begin(expected_y)));
+  }
+
+  // the next runs see the new data of the bound input, and write the bound output in place
+  std::array<float, 3 * 2> y_values;
+  Ort::Value bound_y = Ort::Value::CreateTensor(info_cpu, y_values.data(), y_values.size(),
+                                                x_shape.data(), x_shape.size());
+  run_context.BindOutput(0, bound_y);
+  for (int i = 0; i < 3; ++i) {
+    x_values.fill(static_cast<float>(i));
+    session.Run(Ort::RunOptions(), run_context);
+    ASSERT_TRUE(std::all_of(y_values.begin(), y_values.end(),
+                            [i](float y) { return y == static_cast<float>(i * i); }));
+    ASSERT_EQ(run_context.GetOutput(0).GetTensorData<float>(), y_values.data());
+  }
+
+  ASSERT_THROW(run_context.BindInput(1, x), Ort::Exception);
+  ASSERT_THROW(Ort::RunContext(session, output_names, 1, output_names, 1), Ort::Exception);
+}
+
+TEST(CApiTest, session_pipeline) {
+  Ort::SessionOptions session_options;
+  Ort::Session first(*ort_env, MODEL_URI, session_options);
+  Ort::Session second(*ort_env, MODEL_URI, session_options);
+
+  Ort::SessionPipeline pipeline({&first, &second});
+  ASSERT_THROW(pipeline.Link(1, "Y", 0, "X"), Ort::Exception);
+  ASSERT_THROW(pipeline.Link(0, "X", 1, "X"), Ort::Exception);
+  pipeline.Link(0, "Y", 1, "X");
+  ASSERT_THROW(pipeline.Link(0, "Y", 1, "X"), Ort::Exception);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+
+  // X is fed to the first session only, as X of the second one is linked
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  auto outputs = pipeline.Run(Ort::RunOptions(), input_names, &x, 1, output_names, 1);
+  ASSERT_EQ(outputs.size(), 1u);
+
+  const std::array<float, 3 * 2> expected_y = {1.0f, 16.0f, 81.0f, 256.0f, 625.0f, 1296.0f};
+  ASSERT_EQ(outputs[0].GetTensorTypeAndShapeInfo().GetElementCount(), expected_y.size());
+  const float* y_values = outputs[0].GetTensorData<float>();
+  ASSERT_TRUE(std::equal(y_values, y_values + expected_y.size(), std::begin(expected_y)));
+
+  const char* unknown_names[] = {"Z"};
+  ASSERT_THROW(pipeline.Run(Ort::RunOptions(), input_names, &x, 1, unknown_names, 1), Ort::Exception);
+}
+
 #if defined(USE_CUDA) || defined(USE_TENSORRT)
 TEST(CApiTest, io_binding_cuda) {
   Ort::SessionOptions session_options;
@@ -2332,6 +2408,14 @@ TEST(CApiTest, basic_cuda_graph) {
   expected_y = {10.0f, 40.0f, 90.0f, 160.0f, 250.0f, 360.0f};
   ASSERT_THAT(y_values, ::testing::ContainerEq(expected_y));
 
+  // The replay writes to the output buffer of the capturing run, so binding another one is rejected
+  auto other_output_data = allocator.GetAllocation(expected_y.size() * sizeof(float));
+  Ort::Value other_bound_y = Ort::Value::CreateTensor(info_mem, reinterpret_cast<float*>(other_output_data.get()),
+                                                      expected_y.size(), expected_y_shape.data(),
+                                                      expected_y_shape.size());
+  binding.BindOutput("Y", other_bound_y);
+  ASSERT_THROW(session.Run(Ort::RunOptions(), binding), Ort::Exception);
+
   // Clean up
   binding.ClearBoundInputs();
   binding.ClearBoundOutputs();
@@ -2701,6 +2785,29 @@ TEST(CApiTest, fill_string_tensor_directly) {
   }
 }
 
+TEST(CApiTest, fill_string_tensor_from_offsets) {
+  constexpr std::string_view data = "Thisisatest";
+  const int64_t offsets[] = {0, 4, 6, 7, 7, 11};
+  constexpr std::string_view expected[] = {"This", "is", "a", "", "test"};
+  constexpr int64_t expected_len = 5;
+
+  MockedOrtAllocator default_allocator;
+  Ort::Value tensor = Ort::Value::CreateTensor(&default_allocator, &expected_len, 1U,
+                                               ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
+
+  tensor.FillStringTensorFromOffsets(data.data(), data.size(), offsets, std::size(offsets));
+  for (size_t i = 0; i < expected_len; i++) {
+    ASSERT_EQ(expected[i], tensor.GetStringTensorElement(i));
+  }
+
+  // offsets must have one element more than the tensor
+  ASSERT_THROW(tensor.FillStringTensorFromOffsets(data.data(), data.size(), offsets, expected_len), Ort::Exception);
+  // last offset past the end of the buffer
+  const int64_t bad_offsets[] = {0, 4, 6, 7, 7, 12};
+  ASSERT_THROW(tensor.FillStringTensorFromOffsets(data.data(), data.size(), bad_offsets, std::size(bad_offsets)),
+               Ort::Exception);
+}
+
 TEST(CApiTest, get_string_tensor_element) {
   const char* s[] = {"abc", "kmp"};
   constexpr int64_t expected_len = 2;
@@ -4428,6 +4535,56 @@ TEST(CApiTest, RunAsyncFail) {
   EXPECT_THROW(session.RunAsync(run_options, input_names, input_tensors, 1, output_names, output_values, 1, CallbackFail, nullptr), std::exception);
 }
 
+static std::atomic_bool warmup_done{false};
+
+void WarmupCallback(void*, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status_ptr) {
+  Ort::Status status(status_ptr);
+  EXPECT_TRUE(status.IsOK());
+  EXPECT_EQ(outputs, nullptr);
+  EXPECT_EQ(num_outputs, 0UL);
+  warmup_done.store(true);
+}
+
+TEST(CApiTest, WarmupSession) {
+  const std::string shapes_file = "warmup_session_shapes.json";
+  std::remove(shapes_file.c_str());
+
+  const char* input_names[] = {"X"};
+  const int64_t x_dim[] = {3, 2};
+  const int64_t* input_shapes[] = {x_dim};
+  const size_t input_shape_lens[] = {2};
+  {
+    Ort::SessionOptions session_options;
+    session_options.SetIntraOpNumThreads(2);
+    session_options.AddConfigEntry(kOrtSessionOptionsWarmupShapesFile, shapes_file.c_str());
+    Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+    session.Warmup(Ort::RunOptions(), input_names, input_shapes, input_shape_lens, 1);
+
+    const int64_t negative_dim[] = {-1, 2};
+    const int64_t* negative_shapes[] = {negative_dim};
+    ASSERT_THROW(session.Warmup(Ort::RunOptions(), input_names, negative_shapes, input_shape_lens, 1), Ort::Exception);
+
+    session.Warmup(Ort::RunOptions(), input_names, input_shapes, input_shape_lens, 1, WarmupCallback, nullptr);
+    for (int i = 0; i < 100 && !warmup_done.load(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ASSERT_TRUE(warmup_done.load());
+  }
+
+  // the warmup runs recorded the shape of X, so the next session warms up without shapes
+  std::ifstream file(shapes_file);
+  ASSERT_TRUE(file.good());
+  file.close();
+
+  Ort::SessionOptions session_options;
+  session_options.AddConfigEntry(kOrtSessionOptionsWarmupShapesFile, shapes_file.c_str());
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+  session.Warmup(Ort::RunOptions(), nullptr, nullptr, nullptr, 0);
+
+  std::remove(shapes_file.c_str());
+}
+
 static void TestRunWithLoraAdapter(const Ort::LoraAdapter& adapter) {
   constexpr const ORTCHAR_T* model_path = TSTR("testdata/lora/two_params_lora_model.onnx");
 
@@ -10,5 +10,13 @@ inline std::string RecomputeName(const std::string& name) {
   return name + "_recompute";
 }
 
+inline std::string OffloadName(const std::string& name) {
+  return name + "_offload";
+}
+
+inline std::string PrefetchName(const std::string& name) {
+  return name + "_prefetch";
+}
+
 }  // namespace graph_utils
 }  // namespace onnxruntime
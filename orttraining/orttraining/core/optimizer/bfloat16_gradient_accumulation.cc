@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/core/optimizer/bfloat16_gradient_accumulation.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// the suffix of the gradient inputs of the optimizer graph, see onnxblock
+constexpr std::string_view kGradientSuffix = "_grad";
+
+bool IsFloatTensor(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
+
+bool IsOptimizerGraph(const Graph& graph) {
+  return std::any_of(graph.Nodes().begin(), graph.Nodes().end(), [](const Node& node) {
+    return graph_utils::IsSupportedOptypeVersionAndDomain(node, "AdamWOptimizer", {1}, kMSDomain) ||
+           graph_utils::IsSupportedOptypeVersionAndDomain(node, "SGDOptimizerV2", {1}, kMSDomain);
+  });
+}
+
+// the accumulation buffer of a node that accumulates into it without outputting the accumulated value
+bool IsAccumulationBuffer(const NodeArg& graph_input, const std::vector<const Node*>& consumers) {
+  if (consumers.size() != 1) {
+    return false;
+  }
+
+  const Node& node = *consumers.front();
+  const auto& input_defs = node.InputDefs();
+  const auto& output_defs = node.OutputDefs();
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "InPlaceAccumulatorV2", {1}, kMSDomain) &&
+         input_defs.size() >= 2 && input_defs[0] == &graph_input && input_defs[1] != &graph_input &&
+         IsFloatTensor(*input_defs[1]) && (output_defs.size() < 2 || !output_defs[1]->Exists());
+}
+
+}  // namespace
+
+Status BFloat16GradientAccumulation::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                              const logging::Logger& logger) const {
+  // the accumulation buffers and the gradients are inputs of the main graph
+  if (graph.IsSubgraph()) {
+    return Status::OK();
+  }
+
+  const bool is_optimizer_graph = IsOptimizerGraph(graph);
+
+  // copy the inputs as the Cast nodes create new node args
+  const std::vector<const NodeArg*> graph_inputs = graph.GetInputs();
+  for (const NodeArg* graph_input : graph_inputs) {
+    const std::string& name = graph_input->Name();
+    const std::vector<const Node*> consumers = graph.GetConsumerNodes(name);
+    if (!IsFloatTensor(*graph_input) || consumers.empty() ||
+        std::any_of(consumers.begin(), consumers.end(), [this](const Node* consumer) {
+          return !graph_utils::IsSupportedProvider(*consumer, GetCompatibleExecutionProviders());
+        })) {
+      continue;
+    }
+
+    if (is_optimizer_graph) {
+      if (name.size() <= kGradientSuffix.size() ||
+          name.compare(name.size() - kGradientSuffix.size(), kGradientSuffix.size(), kGradientSuffix) != 0) {
+        continue;
+      }
+    } else if (!IsAccumulationBuffer(*graph_input, consumers)) {
+      continue;
+    }
+
+    NodeArg* input_arg = graph.GetNodeArg(name);
+    ONNX_NAMESPACE::TypeProto bfloat16_type = *input_arg->TypeAsProto();
+    bfloat16_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16);
+
+    if (is_optimizer_graph) {
+      // the optimizer updates the weights with the float gradients
+      const std::string cast_name = graph.GenerateNodeName(name + "_cast");
+      NodeArg& float_arg = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(name + "_float"),
+                                                    input_arg->TypeAsProto());
+      const std::string execution_provider = consumers.front()->GetExecutionProviderType();
+      for (Node* consumer : graph.GetMutableConsumerNodes(name)) {
+        auto& input_defs = consumer->MutableInputDefs();
+        for (size_t i = 0; i < input_defs.size(); ++i) {
+          if (input_defs[i] == input_arg) {
+            graph_utils::ReplaceNodeInput(*consumer, static_cast<int>(i), float_arg);
+          }
+        }
+      }
+
+      Node& cast_node = graph.AddNode(cast_name, "Cast", "cast the bfloat16 gradient to float",
+                                      {input_arg}, {&float_arg});
+      cast_node.AddAttribute("to", static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
+      cast_node.SetExecutionProviderType(execution_provider);
+    }
+
+    ORT_RETURN_IF_ERROR(input_arg->UpdateTypeAndShape(bfloat16_type, true, true, logger));
+    modified = true;
+    LOGS(logger, VERBOSE) << "Accumulating gradient " << name << " in bfloat16.";
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
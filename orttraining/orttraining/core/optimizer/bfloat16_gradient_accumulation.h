@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class BFloat16GradientAccumulation
+Accumulate the gradients of an on-device training model in bfloat16 buffers.
+
+In the training graph, a float gradient accumulation buffer that is a graph input and only accumulated into by an
+InPlaceAccumulatorV2 node (its accumulated value is not output) becomes a bfloat16 input. The node adds the float
+gradient to it in float and rounds the sum stochastically to bfloat16.
+In the optimizer graph, the float gradient inputs become bfloat16 inputs that are cast to float before they are used.
+*/
+class BFloat16GradientAccumulation : public GraphTransformer {
+ public:
+  explicit BFloat16GradientAccumulation(
+      const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("BFloat16GradientAccumulation", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
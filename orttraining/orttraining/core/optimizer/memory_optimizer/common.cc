@@ -106,6 +106,8 @@ std::string OptimizationTypeToString(OptimizationType type) {
       return "Recompute";
     case OptimizationType::RecomputeWithCompromise:
       return "RecomputeWithCompromise";
+    case OptimizationType::Offload:
+      return "Offload";
     default:
       ORT_THROW("Unknown optimization type.");
   }
@@ -38,7 +38,8 @@ enum class OptimizationType {
   None = 0,  // Disabled.
   Recompute = 1,
   RecomputeWithCompromise = 2,
-  TypeMax = 3,
+  Offload = 3,  // Copy stashed activations to host memory in forward pass and back before backward pass.
+  TypeMax = 4,
 };
 
 std::string OptimizationTypeToString(OptimizationType type);
@@ -226,6 +226,7 @@ Status FindORTModuleMemoryOpportunity(const GraphViewer& graph_viewer,
                               layer_boundary_ln_nodes,
                               logger, false,
                               can_compromise_stashed_activation);
+    bool found_recompute_plan = recompute_plan != nullptr;
     if (recompute_plan != nullptr) {
       memory_opt_planner.AddNodeOptimizationPlan(p_node, std::move(recompute_plan));
     }
@@ -246,6 +247,16 @@ Status FindORTModuleMemoryOpportunity(const GraphViewer& graph_viewer,
                                 can_compromise_stashed_activation);
       if (recompute_with_compromise_plan != nullptr) {
         memory_opt_planner.AddNodeOptimizationPlan(p_node, std::move(recompute_with_compromise_plan));
+        found_recompute_plan = true;
+      }
+    }
+
+    // Offloading covers the same stashed activations as recompute, as an alternative for the subgraphs that are
+    // expensive to recompute.
+    if (found_recompute_plan) {
+      std::unique_ptr<NodeOffloadPlan> offload_plan = CheckNodeForOffload(*p_node, candidate_output_args_map, logger);
+      if (offload_plan != nullptr) {
+        memory_opt_planner.AddNodeOptimizationPlan(p_node, std::move(offload_plan));
       }
     }
   }
@@ -285,6 +296,10 @@ void GetMemoryRecordsGroupedByNodeClusterId(const MemoryOptimizationPlanner& mem
             if (is_output_reusing_buffers) {
               record.output_port_reuse_recompute_count[output_index] += 1;
             }
+          } else if (plan->GetOptimizationType() == OptimizationType::Offload) {
+            if (is_output_reusing_buffers) {
+              record.output_port_reuse_offload_count[output_index] += 1;
+            }
           }
         }
       }
@@ -324,6 +339,11 @@ void GetMemoryRecordsGroupedByNodeClusterId(const MemoryOptimizationPlanner& mem
                                                  plan->GetActivationOutputDimParamString(output_index),
                                                  byte_count_per_element,
                                                  plan->GetSaveRatio());
+        } else if (plan->GetOptimizationType() == OptimizationType::Offload) {
+          record.offloaded_outputs.emplace_back(output_index,
+                                                plan->GetActivationOutputDimParamString(output_index),
+                                                byte_count_per_element,
+                                                plan->GetSaveRatio());
         }
       }
     }
@@ -370,6 +390,9 @@ void GetMemoryRecordsGroupedByNodeClusterId(const MemoryOptimizationPlanner& mem
         node_cluster_id_to_record_map[node_cluster_id]->actual_recompute_with_compromise_count += 1;
         node_cluster_id_to_record_map[node_cluster_id]->request_recompute_with_compromise_count =
             apply_context->requested_count;
+      } else if (apply_context->type == OptimizationType::Offload) {
+        node_cluster_id_to_record_map[node_cluster_id]->actual_offload_count += 1;
+        node_cluster_id_to_record_map[node_cluster_id]->request_offload_count = apply_context->requested_count;
       } else {
         ORT_THROW("Unsupported optimization type found.");
       }
@@ -637,6 +660,49 @@ void FormatRecomputeMemoryRecords(int option_index,
                    "% saved");
   }
 }
+
+void FormatOffloadMemoryRecords(int option_index,
+                                const MemoryRecord& record,
+                                InlinedVector<std::string>& rows) {
+  const std::string empty_first_col = "|" + ToFixedLengthString(std::string(), kFirstColumnWidth) + "|";
+
+  rows.push_back(empty_first_col);
+  rows.push_back(empty_first_col +
+                 ToFixedLengthString(">>Option " + std::to_string(option_index), kTitleWidthInSecondColumn) + ": " +
+                 OptimizationTypeToString(OptimizationType::Offload) + " to pinned host memory");
+
+  if (record.request_offload_count) {
+    // Only show this if user requested it.
+    rows.push_back(
+        empty_first_col +
+        ToFixedLengthString("  Status", kTitleWidthInSecondColumn) + ": " + "Enabled, requested count=" +
+        std::to_string(record.request_offload_count) +
+        ", actual applied count=" + std::to_string(record.actual_offload_count));
+  } else {
+    rows.push_back(empty_first_col + ToFixedLengthString("  Status", kTitleWidthInSecondColumn) +
+                   ": Disabled.");
+  }
+
+  rows.push_back(empty_first_col + "  Stashed Activations: ");
+
+  if (record.output_port_reuse_offload_count.size() > 0) {
+    std::string reused_buffers_summary = empty_first_col + ToFixedLengthString("   - ReuseFreq", kTitleWidthInSecondColumn) + ": ";
+    for (const auto& p : record.output_port_reuse_offload_count) {
+      reused_buffers_summary += " Output " + std::to_string(p.first) + "(" + std::to_string(p.second) + "),";
+    }
+
+    rows.push_back(reused_buffers_summary);
+  }
+
+  for (const auto& stat : record.offloaded_outputs) {
+    rows.push_back(empty_first_col +
+                   ToFixedLengthString("   - Output " + std::to_string(stat.output_index), kTitleWidthInSecondColumn) +
+                   ": [" + stat.output_shape_str + "], byte/elem: " +
+                   std::to_string(stat.output_byte_count_per_element) +
+                   ", " + std::to_string(static_cast<int>(stat.saving_ratio * 100)) +
+                   "% saved");
+  }
+}
 }  // namespace
 
 std::string SerializeMemoryRecords(
@@ -663,6 +729,11 @@ std::string SerializeMemoryRecords(
       FormatRecomputeMemoryRecords(option_index, record, true, rows);
       option_index++;
     }
+
+    if (record.offloaded_outputs.size() > 0) {
+      FormatOffloadMemoryRecords(option_index, record, rows);
+      option_index++;
+    }
     rows.push_back(kTableRowSeparator);
   }
 
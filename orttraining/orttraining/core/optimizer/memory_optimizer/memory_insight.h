@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "orttraining/core/optimizer/memory_optimizer/common.h"
+#include "orttraining/core/optimizer/memory_optimizer/offload_analysis.h"
 #include "orttraining/core/optimizer/memory_optimizer/optimization_planner.h"
 #include "orttraining/core/optimizer/memory_optimizer/recompute_analysis.h"
 
@@ -53,6 +54,12 @@ class MemoryRecord {
   int actual_recompute_with_compromise_count = 0;
   InlinedHashMap<size_t, int> output_port_reuse_recompute_with_compromise_count;
 
+  // Offload Column
+  InlinedVector<OutputStat> offloaded_outputs;
+  int request_offload_count = 0;
+  int actual_offload_count = 0;
+  InlinedHashMap<size_t, int> output_port_reuse_offload_count;
+
   // Frequency Column
   int freq = 0;
 };
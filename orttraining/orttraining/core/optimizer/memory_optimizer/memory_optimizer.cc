@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <string>
@@ -24,6 +25,9 @@ namespace onnxruntime {
 
 namespace {
 
+// How many nodes ahead of the first backward consumer an offloaded activation is copied back to device memory.
+constexpr ptrdiff_t kOffloadPrefetchDistance = 1;
+
 constexpr bool IsForwardPassOperator(ptrdiff_t op_order_in_topological_sort,
                                      ptrdiff_t boundary_op_order_in_topological_sort) {
   return op_order_in_topological_sort <= boundary_op_order_in_topological_sort;
@@ -88,6 +92,7 @@ bool MemoryOptimizer::ModifyGraph(Graph& graph,
                                       node_index_to_its_order_in_topological_sort_map,
                                   const logging::Logger& logger,
                                   ptrdiff_t boundary_op_order_in_topological_sort,
+                                  gsl::span<const NodeIndex> nodes_in_topological_order,
                                   Node* node,
                                   std::shared_ptr<optimizer::memory_optimizer::NodeOptimizationPlanBase>& node_plan,
                                   std::shared_ptr<optimizer::memory_optimizer::ClusterApplyContext>& apply_context)
@@ -111,6 +116,15 @@ bool MemoryOptimizer::ModifyGraph(Graph& graph,
           dynamic_cast<optimizer::memory_optimizer::NodeRecomputePlan*>(node_plan.get());
       ORT_ENFORCE(recompute_plan != nullptr);
       ORT_ENFORCE(CreateRecomputeGraph(graph, recompute_plan->GetNodesInTopoOrder(), logger, replacement_node_ptr).IsOK());
+    } else if (apply_context->type == optimizer::memory_optimizer::OptimizationType::Offload) {
+      // The copies are connected to the consumers of each activation, there is no replacement node to rewire.
+      ORT_ENFORCE(CreateOffloadGraph(graph, *node, node_plan->GetActivationOutputIndices(),
+                                     node_index_to_its_order_in_topological_sort_map,
+                                     boundary_op_order_in_topological_sort,
+                                     nodes_in_topological_order,
+                                     logger)
+                      .IsOK());
+      return true;
     } else {
       ORT_THROW("unsupported optimization type found.");
     }
@@ -214,6 +228,7 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
       has_been_modified = ModifyGraph(graph, node_index_to_its_order_in_topological_sort_map,
                                       logger,
                                       yield_op_order_in_topological_sort,
+                                      node_ids,
                                       p_node,
                                       node_to_opt_plan_map[p_node],
                                       node_to_apply_context_map[p_node]);
@@ -398,4 +413,105 @@ Status MemoryOptimizer::CreateRecomputeGraph(Graph& graph,
  ** Recompute related function implementation ends   **
  ******************************************************/
 
+Status MemoryOptimizer::CreateOffloadGraph(Graph& graph,
+                                           Node& node,
+                                           gsl::span<const size_t> activation_output_indices,
+                                           const InlinedHashMap<NodeIndex, ptrdiff_t>&
+                                               node_index_to_its_order_in_topological_sort_map,
+                                           ptrdiff_t boundary_op_order_in_topological_sort,
+                                           gsl::span<const NodeIndex> nodes_in_topological_order,
+                                           const logging::Logger& logger) const {
+  for (size_t output_index : activation_output_indices) {
+    NodeArg* activation_arg = node.MutableOutputDefs()[output_index];
+    if (graph.GetNodeArg(graph_utils::OffloadName(activation_arg->Name())) != nullptr) {
+      continue;
+    }
+
+    // Collect the edges to backward consumers, and the earliest of them in topological order.
+    std::vector<graph_utils::GraphEdge> backward_edges;
+    ptrdiff_t first_backward_consumer_order = std::numeric_limits<ptrdiff_t>::max();
+    bool has_consumer_out_of_order = false;
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      if (static_cast<size_t>(it->GetSrcArgIndex()) != output_index) {
+        continue;
+      }
+
+      auto tid = node_index_to_its_order_in_topological_sort_map.find(it->GetNode().Index());
+      // The consumer might be a newly added recompute node, which is treated as a backward op.
+      if (tid == node_index_to_its_order_in_topological_sort_map.end()) {
+        has_consumer_out_of_order = true;
+      } else if (IsForwardPassOperator(tid->second, boundary_op_order_in_topological_sort)) {
+        continue;
+      } else {
+        first_backward_consumer_order = std::min(first_backward_consumer_order, tid->second);
+      }
+
+      backward_edges.push_back(graph_utils::GraphEdge::CreateGraphEdge(node, *it, false));
+    }
+
+    if (backward_edges.empty()) {
+      continue;
+    }
+
+    NodeArg& offload_arg = graph.GetOrCreateNodeArg(graph_utils::OffloadName(activation_arg->Name()),
+                                                    activation_arg->TypeAsProto());
+    NodeArg& prefetch_arg = graph.GetOrCreateNodeArg(graph_utils::PrefetchName(activation_arg->Name()),
+                                                     activation_arg->TypeAsProto());
+
+    Node& offload_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_offload"),
+                                       "MemcpyToHost",
+                                       "Offload of " + activation_arg->Name(),
+                                       {activation_arg},
+                                       {&offload_arg});
+    Node& prefetch_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_prefetch"),
+                                        "MemcpyFromHost",
+                                        "Prefetch of " + activation_arg->Name(),
+                                        {&offload_arg},
+                                        {&prefetch_arg});
+    for (Node* copy_node : {&offload_node, &prefetch_node}) {
+      copy_node->SetExecutionProviderType(node.GetExecutionProviderType());
+      ORT_RETURN_IF_NOT(graph.SetOpSchemaFromRegistryForNode(*copy_node),
+                        "Failed to set op schema for added offload node ", copy_node->OpType(), ".");
+    }
+
+    graph.UpdateProducerNode(offload_arg.Name(), offload_node.Index());
+    graph.UpdateProducerNode(prefetch_arg.Name(), prefetch_node.Index());
+
+    graph.AddEdge(node.Index(), offload_node.Index(), static_cast<int>(output_index), 0);
+    graph.AddConsumerNode(activation_arg->Name(), &offload_node);
+    graph.AddEdge(offload_node.Index(), prefetch_node.Index(), 0, 0);
+    graph.AddConsumerNode(offload_arg.Name(), &prefetch_node);
+
+    for (const auto& backward_edge : backward_edges) {
+      Node* consumer_node = graph.GetNode(backward_edge.dst_node);
+      graph.RemoveEdge(backward_edge.src_node,
+                       backward_edge.dst_node,
+                       backward_edge.src_arg_index,
+                       backward_edge.dst_arg_index);
+      graph.RemoveConsumerNode(activation_arg->Name(), consumer_node);
+
+      // This also updates the consumer's input node arg to the prefetched one.
+      graph.AddEdge(prefetch_node.Index(), backward_edge.dst_node, 0, backward_edge.dst_arg_index);
+      graph.AddConsumerNode(prefetch_arg.Name(), consumer_node);
+    }
+
+    // Without a dependency the topological sort could copy the activation back right after it is offloaded, so
+    // the copy waits for a backward node shortly before the first consumer. This can't create a cycle, since each
+    // node depending on the prefetched activation comes after the first consumer in topological order.
+    if (!has_consumer_out_of_order && boundary_op_order_in_topological_sort >= 0) {
+      const ptrdiff_t trigger_order = std::max(boundary_op_order_in_topological_sort,
+                                               first_backward_consumer_order - kOffloadPrefetchDistance);
+      const Node* trigger_node = graph.GetNode(nodes_in_topological_order[trigger_order]);
+      if (trigger_node != nullptr) {
+        graph.AddControlEdge(trigger_node->Index(), prefetch_node.Index());
+      }
+    }
+
+    LOGS(logger, VERBOSE) << "Offload activation " << activation_arg->Name() << " of Node " << node.Name() << "("
+                          << node.OpType() << ") to " << backward_edges.size() << " backward consumers.";
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -16,7 +16,8 @@ namespace onnxruntime {
 /**
 @Class MemoryOptimizer
 
-Find recompute subgraphs and enable them according to user configs. The way we collect subgraphs
+Find recompute subgraphs, or stashed activations to offload, and enable them according to user configs.
+The way we collect subgraphs
 (in orttraining/orttraining/core/optimizer/memory_optimizer/recompute_analysis.h) in brief is:
 1. Find all nodes that generate stashed activations.
 2. For each node, check it data type is supported to recompute
@@ -24,6 +25,10 @@ Find recompute subgraphs and enable them according to user configs. The way we c
   b. otherwise, stop collecting and return the subgraph (could be empty).
 3. Pick up the input node from the queue, and do 2 again. The process ends when the queue is empty or 2.b happens.
 4. Clone the recomputable subgraphs and insert them back to the original graph.
+
+The stashed activations of the nodes having a recompute subgraph can instead be offloaded: they are copied to pinned
+host memory with a MemcpyToHost after they are produced, and copied back with a MemcpyFromHost right before their first
+backward consumer.
 */
 
 class MemoryOptimizer : public GraphTransformer {
@@ -54,6 +59,7 @@ class MemoryOptimizer : public GraphTransformer {
    *   Used to re-order the collected subgraph nodes.
    * @param logger Logger.
    * @param boundary_op_order_in_topological_sort index of the boundary op between fw and bw.
+   * @param nodes_in_topological_order The node indices in the topological sort of the map above.
    * @param subgraph_stores  A store to maintain all found subgraphs.
    * @param node The node we used to look for corresponding optimization graphs.
    * @return true
@@ -64,6 +70,7 @@ class MemoryOptimizer : public GraphTransformer {
                        node_index_to_its_order_in_topological_sort_map,
                    const logging::Logger& logger,
                    ptrdiff_t boundary_op_order_in_topological_sort,
+                   gsl::span<const NodeIndex> nodes_in_topological_order,
                    Node* node,
                    std::shared_ptr<optimizer::memory_optimizer::NodeOptimizationPlanBase>& node_plan,
                    std::shared_ptr<optimizer::memory_optimizer::ClusterApplyContext>& apply_context) const;
@@ -101,6 +108,27 @@ class MemoryOptimizer : public GraphTransformer {
    ** Recompute-related function definition ends   **
    *************************************************/
 
+  /**
+   * @brief Insert the copies to host memory and back for the stashed activations of a node.
+   *
+   * @param graph Graph to modify.
+   * @param node The node generating the stashed activations.
+   * @param activation_output_indices The output indices of the stashed activations.
+   * @param node_index_to_its_order_in_topological_sort_map The mapping of node index to its order in topological sort.
+   * @param boundary_op_order_in_topological_sort index of the boundary op between fw and bw.
+   * @param nodes_in_topological_order The node indices in the topological sort of the map above.
+   * @param logger Logger.
+   * @return Status
+   */
+  Status CreateOffloadGraph(Graph& graph,
+                            Node& node,
+                            gsl::span<const size_t> activation_output_indices,
+                            const InlinedHashMap<NodeIndex, ptrdiff_t>&
+                                node_index_to_its_order_in_topological_sort_map,
+                            ptrdiff_t boundary_op_order_in_topological_sort,
+                            gsl::span<const NodeIndex> nodes_in_topological_order,
+                            const logging::Logger& logger) const;
+
   // User-enabled map of the subgraph string representation to the alleviation type.
   InlinedHashMap<std::string, optimizer::memory_optimizer::UserConfig> pattern_subgraph_to_user_optimizer_config_map_;
   std::string optimizer_config_file_path_;
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "orttraining/core/optimizer/memory_optimizer/common.h"
+#include "orttraining/core/optimizer/memory_optimizer/offload_analysis.h"
+#include "core/framework/data_types.h"
+#include "core/graph/constants.h"
+
+namespace onnxruntime::optimizer::memory_optimizer {
+
+namespace {
+
+// Providers whose MemcpyToHost outputs to pinned host memory.
+bool IsOffloadSupportedProvider(const std::string& provider_type) {
+  return provider_type == kCudaExecutionProvider || provider_type == kRocmExecutionProvider;
+}
+
+}  // namespace
+
+std::unique_ptr<NodeOffloadPlan> CheckNodeForOffload(const Node& node,
+                                                     const InlinedHashMap<const Node*, InlinedVector<size_t>>&
+                                                         candidate_output_args_map,
+                                                     const logging::Logger& logger) {
+  auto it = candidate_output_args_map.find(&node);
+  if (it == candidate_output_args_map.end()) {
+    return nullptr;
+  }
+
+  if (!IsOffloadSupportedProvider(node.GetExecutionProviderType())) {
+    MO_LOG_DEBUG_INFO(logger, "Node " + node.Name() + "(" + node.OpType() + ") is not offloaded since provider [" +
+                                  node.GetExecutionProviderType() + "] is not supported");
+    return nullptr;
+  }
+
+  for (auto output_index : it->second) {
+    const auto* type_proto = node.OutputDefs()[output_index]->TypeAsProto();
+    if (type_proto == nullptr || !type_proto->has_tensor_type()) {
+      MO_LOG_DEBUG_INFO(logger, "Node " + node.Name() + "(" + node.OpType() + ") is not offloaded since output " +
+                                    std::to_string(output_index) + " is not a tensor");
+      return nullptr;
+    }
+  }
+
+  MO_LOG_DEBUG_INFO(logger, "Node " + node.Name() + "(" + node.OpType() + ") can be offloaded");
+  return std::make_unique<NodeOffloadPlan>(&node, it->second);
+}
+
+std::string NodeOffloadPlan::GetClusterId() const {
+  return node->OpType() + "+";
+}
+
+std::string NodeOffloadPlan::NormalizeForNodeClusterId() const {
+  std::ostringstream oss;
+  oss << "offload:" << node->OpType() << "-";
+  for (auto& output_index : GetActivationOutputIndices()) {
+    oss << output_index << ":" << GetActivationOutputDimParamString(output_index);
+    oss << ":" << node->OutputDefs()[output_index]->TypeAsProto()->tensor_type().elem_type() << "-";
+  }
+
+  return oss.str();
+}
+
+std::string NodeOffloadPlan::GetMemorySavingSymbolicString() const {
+  std::string saving_str;
+  for (auto output_index : GetActivationOutputIndices()) {
+    // If the output is reusing other node's buffer, then no memory saving.
+    std::string cur_output_saving_str = "0";
+    if (reuse_buffers.find(output_index) == reuse_buffers.end()) {
+      const auto& output_def = node->OutputDefs()[output_index];
+      MLDataType ml_data_type = DataTypeImpl::TypeFromProto(*output_def->TypeAsProto());
+      ORT_ENFORCE(ml_data_type->IsTensorType(), "ml_type must be a tensor type, but it is ",
+                  DataTypeImpl::ToString(ml_data_type));
+      const TensorTypeBase* tensor_type_base = ml_data_type->AsTensorType();
+      ORT_ENFORCE(nullptr != tensor_type_base);
+      const auto byte_count_per_element = tensor_type_base->GetElementType()->Size();
+      cur_output_saving_str = GetActivationOutputDimParamString(output_index) + " * " +
+                              std::to_string(byte_count_per_element) + " * " +
+                              std::to_string(GetSaveRatio());
+    }
+
+    if (!saving_str.empty()) {
+      saving_str += " + ";
+    }
+
+    saving_str += "(" + cur_output_saving_str + ")";
+  }
+
+  ORT_ENFORCE(!saving_str.empty(), "saving_str should not be empty for node: ", node->OpType(), " ", node->Name());
+  return "(" + saving_str + ")";
+}
+
+}  // namespace onnxruntime::optimizer::memory_optimizer
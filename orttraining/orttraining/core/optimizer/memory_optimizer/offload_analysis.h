@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "orttraining/core/optimizer/memory_optimizer/common.h"
+#include "orttraining/core/optimizer/memory_optimizer/optimization_planner.h"
+
+namespace onnxruntime::optimizer::memory_optimizer {
+
+/**
+ * @brief A child class used for Offload optimization plan.
+ *
+ * The stashed activations of the node are copied to pinned host memory after they are produced in forward pass,
+ * and copied back to device memory before their first consumer in backward pass.
+ */
+class NodeOffloadPlan : public NodeOptimizationPlanBase {
+ public:
+  NodeOffloadPlan(const Node* node,
+                  const InlinedVector<size_t>& activation_output_indices)
+      : NodeOptimizationPlanBase(node, activation_output_indices, 1.0f) {}
+
+  OptimizationType GetOptimizationType() const override {
+    return OptimizationType::Offload;
+  }
+
+  /**
+   * @brief Get the cluster id for this offload plan.
+   * The cluster id is the op type of the node, in the same format as a single node recompute subgraph, e.g. "Gelu+".
+   * so the config picks either recompute or offload for the activations the recompute probe found.
+   */
+  std::string GetClusterId() const override;
+
+  std::string NormalizeForNodeClusterId() const override;
+
+  std::string GetMemorySavingSymbolicString() const override;
+};
+
+/**
+ * @brief For the node producing stashed activation, check whether its activations can be offloaded or not.
+ * Only the activations in the memory of a device provider, which implements MemcpyToHost and MemcpyFromHost, can be
+ * offloaded.
+ *
+ * @param node The node producing stashed activations.
+ * @param candidate_output_args_map A map from node to its candidate activations.
+ * @param logger Logger.
+ */
+std::unique_ptr<NodeOffloadPlan> CheckNodeForOffload(const Node& node,
+                                                     const InlinedHashMap<const Node*, InlinedVector<size_t>>&
+                                                         candidate_output_args_map,
+                                                     const logging::Logger& logger);
+
+}  // namespace onnxruntime::optimizer::memory_optimizer
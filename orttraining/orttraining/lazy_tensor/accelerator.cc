@@ -8,8 +8,10 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 // Pytorch.
+#include <torch/csrc/jit/passes/canonicalize.h>
 #include <torch/csrc/onnx/onnx.h>
 #include <torch/torch.h>
 // ORT friends.
@@ -65,6 +67,14 @@ bool IsFusable(const torch::jit::Node* node) {
   return !found_not_fusable;
 }
 
+Accelerator::Accelerator(const torch::jit::Node* node)
+    : subgraph_(node->g(torch::jit::attr::Subgraph)),
+      // Value names differ between otherwise identical graphs, so
+      // they are renamed before the graph is printed.
+      graph_key_(torch::jit::Canonicalize(subgraph_, false)->toString(false)),
+      input_types_(subgraph_->inputs().size()),
+      output_types_(subgraph_->outputs().size()) {}
+
 bool Accelerator::Supported(const torch::jit::Node* node) {
   if (!node) {
     return false;
@@ -144,8 +154,9 @@ void Accelerator::OrtRun(torch::jit::Stack& stack) {
   // Compile a callable to execute "subgraph_" on the inputs.
   // If such input schema appears before, we can reuse a cached compiled callable.
   torch::jit::CompleteArgumentSpec spec{false, inputs};
-  if (cache_.find(spec) == cache_.end()) {
-    cache_.emplace(spec, Compile(spec, inputs));
+  auto it = cache_.find(spec);
+  if (it == cache_.end()) {
+    it = cache_.emplace(spec, GetOrCompile(inputs)).first;
   }
 
   if (DumpInputsOutputs()) {
@@ -153,7 +164,7 @@ void Accelerator::OrtRun(torch::jit::Stack& stack) {
   }
 
   // Run the compiled function!
-  auto outputs = cache_[spec].code(inputs);
+  auto outputs = it->second->code(inputs);
 
   // Discard used inputs.
   torch::jit::drop(stack, inputs.size());
@@ -245,9 +256,13 @@ static void CheckArgs(
 // in ORT.
 // TODO(wechi): Allow ORT to accept models without
 // input types. Then, we can remove this function.
+// When "dynamic_shapes" is true, only the ranks of the tensors
+// are stored so the exported model has symbolic dims and can run
+// inputs of any shape.
 static void SetArgTypes(
     const at::ArrayRef<c10::IValue>& inputs,
-    std::shared_ptr<torch::jit::Graph> graph) {
+    std::shared_ptr<torch::jit::Graph> graph,
+    const bool dynamic_shapes) {
   TORCH_CHECK(graph->inputs().size() == inputs.size(),
               "Number of provided inputs must match captured sub-graph's schema.");
   for (size_t i = 0; i < graph->inputs().size(); ++i) {
@@ -260,7 +275,11 @@ static void SetArgTypes(
       // representations in Pytorch.
       continue;
     }
-    input_symbol->setType(input_value.type());
+    if (dynamic_shapes) {
+      input_symbol->setType(input_value.type()->expect<c10::TensorType>()->dimensionedOnly());
+    } else {
+      input_symbol->setType(input_value.type());
+    }
   }
 }
 
@@ -271,7 +290,8 @@ static void SetArgTypes(
 // ONNX file.
 static std::string ExportToOnnx(
     std::shared_ptr<torch::jit::Graph> graph,
-    const at::ArrayRef<c10::IValue>& args) {
+    const at::ArrayRef<c10::IValue>& args,
+    const bool dynamic_shapes) {
 #ifdef USE_CUDA
   NvtxRange range(__func__);
 #endif
@@ -288,7 +308,7 @@ static std::string ExportToOnnx(
               .attr("_export_jit_graph_to_onnx_model_proto"));
   // Fill types up. The sub-graphp from LazyTensor doesn't
   // contain input shapes.
-  SetArgTypes(args, new_subgraph);
+  SetArgTypes(args, new_subgraph, dynamic_shapes);
   // Execute Python function.
   auto result = export_to_onnx(new_subgraph, ::torch::onnx::OperatorExportTypes::ONNX);
   return result.cast<std::string>();
@@ -395,22 +415,86 @@ void Accelerator::ExampleRun(at::ArrayRef<c10::IValue> inputs) {
   }
 }
 
-CompiledObject Accelerator::Compile(
-    torch::jit::CompleteArgumentSpec spec, at::ArrayRef<c10::IValue>& args) {
+// Signature of the inputs a compiled session can run. With dynamic
+// shapes, tensors are only described by their type, device and rank,
+// so one shape-polymorphic session runs all their shapes.
+static std::string InputSignature(const at::ArrayRef<c10::IValue>& args, const bool dynamic_shapes) {
+  std::ostringstream signature;
+  signature << (dynamic_shapes ? "dynamic" : "static");
+  for (const auto& arg : args) {
+    signature << ';';
+    if (arg.isTensor()) {
+      const auto& tensor = arg.toTensor();
+      signature << "tensor," << c10::toString(tensor.scalar_type()) << ',' << tensor.device() << ','
+                << tensor.dim();
+      if (!dynamic_shapes) {
+        signature << ',' << tensor.sizes();
+      }
+    } else {
+      // Scalars are fed as tensors without shape, whose type is
+      // fixed by the exported model.
+      signature << "scalar," << arg.type()->str();
+    }
+  }
+  return signature.str();
+}
+
+// Compiled graphs of all Accelerators in the process, keyed by the
+// canonical graph and the input signature.
+class CompiledGraphCache {
+ public:
+  static CompiledGraphCache& GetInstance() {
+    static CompiledGraphCache instance;
+    return instance;
+  }
+
+  template <typename TCompile>
+  std::shared_ptr<CompiledObject> GetOrCompile(const std::string& key, TCompile&& compile) {
+    // Compilation calls into Python, which may run another Accelerator,
+    // so the lock isn't held while compiling. A graph compiled twice
+    // concurrently is compiled by both callers and the first one is kept.
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = compiled_.find(key);
+      if (it != compiled_.end()) {
+        return it->second;
+      }
+    }
+
+    auto compiled = compile();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return compiled_.emplace(key, std::move(compiled)).first->second;
+  }
+
+ private:
+  CompiledGraphCache() = default;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<CompiledObject>> compiled_;
+};
+
+std::shared_ptr<CompiledObject> Accelerator::GetOrCompile(at::ArrayRef<c10::IValue>& args) {
+  const bool dynamic_shapes = UseDynamicShapes();
+  const std::string key = graph_key_ + "\n" + InputSignature(args, dynamic_shapes);
+  return CompiledGraphCache::GetInstance().GetOrCompile(
+      key, [this, &args, dynamic_shapes]() { return Compile(args, dynamic_shapes); });
+}
+
+std::shared_ptr<CompiledObject> Accelerator::Compile(at::ArrayRef<c10::IValue>& args, const bool dynamic_shapes) {
   CheckArgs(args);
   DynamicSettings::GetInstance().SetOnnxFusionFlag(false);
   ExampleRun(args);
   DynamicSettings::GetInstance().SetOnnxFusionFlag(true);
   // Storage of compilation.
-  CompiledObject compiled;
+  auto compiled = std::make_shared<CompiledObject>();
   // Create an empty session.
-  compiled.sess = CreateSession();
+  compiled->sess = CreateSession();
   // Let's get the empty session and initialize it.
-  onnxruntime::InferenceSession& sess = *compiled.sess;
+  onnxruntime::InferenceSession& sess = *compiled->sess;
   // Export subgraph_ to ONNX.
   // The exporter should never fail. If it does, please modify
   // Accelerator::Supported to filter out unsupported operators.
-  const std::string serialized_model = ExportToOnnx(subgraph_, args);
+  const std::string serialized_model = ExportToOnnx(subgraph_, args, dynamic_shapes);
   // Memory info for all tensors.
   // Assume all inputs are on the same device.
   OrtDevice shared_device = CheckAndGetTensorDevice(args);
@@ -432,9 +516,17 @@ CompiledObject Accelerator::Compile(
   // Duplicate device info for putting output tensors on the shared device.
   std::vector<OrtDevice> fetches_device_info(fetch_names.size(), shared_device);
 
+  // Whether each input of the graph is a tensor.
+  std::vector<bool> is_tensor_input;
+  for (const auto* input : subgraph_->inputs()) {
+    is_tensor_input.push_back(input->type()->kind() == c10::TypeKind::TensorType);
+  }
+
   // Create a callable which feeds inputs to ORT
   // session's Run(...) and returns outputs.
-  auto code = [this, run_options,
+  // It may be used by other Accelerators with the same graph, so it
+  // copies what it needs from this one instead of capturing it.
+  auto code = [is_tensor_input, output_types = output_types_, run_options,
                feed_names, fetch_names,
                fetches_device_info, &sess](at::ArrayRef<c10::IValue>& args) {
     // Inputs of ORT session.
@@ -447,7 +539,7 @@ CompiledObject Accelerator::Compile(
       NvtxRange range("Prepare inputs");
 #endif
       // Prepare inputs.
-      const auto num_inputs = subgraph_->inputs().size();
+      const auto num_inputs = is_tensor_input.size();
       for (size_t i = 0; i < num_inputs; ++i) {
         // The value can be either tensor or scalar.
         // Scalar is a tensor with empty shape vector.
@@ -458,7 +550,7 @@ CompiledObject Accelerator::Compile(
           feeds.push_back(CreateOrtScalarValue(args.at(i).toScalar()));
         } else if (args.at(i).isTensor()) {
           // Tensor.
-          ORT_ENFORCE(subgraph_->inputs().at(i)->type()->kind() == c10::TypeKind::TensorType);
+          ORT_ENFORCE(is_tensor_input.at(i));
           feeds.push_back(CreateOrtTensorValue(args.at(i).toTensor()));
         } else {
           // Looks like LTC only passes scalars and tensors into backend, so we don't care
@@ -487,12 +579,12 @@ CompiledObject Accelerator::Compile(
       // Convert ORT output to Pytorch format.
       for (size_t i = 0; i < fetches.size(); ++i) {
         // Get the expected type of the i-th output.
-        const c10::TypePtr type = output_types_.at(i);
+        const c10::TypePtr type = output_types.at(i);
         // Convert ORTValue to IValue.
         if (type->isSubtypeOf(*c10::TensorType::get())) {
           ORT_ENFORCE(fetches.at(i).IsTensor(), "Only ORT tensor can be translated to Pytorch tensor.");
           auto value = CreateC10IvalueTensor(fetches.at(i));
-          auto expected_scalar_type = output_types_.at(i)->cast<c10::TensorType>()->scalarType().value();
+          auto expected_scalar_type = output_types.at(i)->cast<c10::TensorType>()->scalarType().value();
           outputs.push_back(value.toTensor().to(expected_scalar_type));
         } else if (type->isSubtypeOf(*c10::NumberType::get())) {
           // ORT represents scalar as tensor without shape.
@@ -508,7 +600,7 @@ CompiledObject Accelerator::Compile(
     return outputs;
   };
 
-  compiled.code = code;
+  compiled->code = code;
   return compiled;
 }
 }  // namespace lazytensor
@@ -10,6 +10,9 @@ namespace onnxruntime {
 namespace lazytensor {
 
 // Type of JIT compilation result.
+// It may be shared by all Accelerators with the same graph and
+// input signature, so "code" must not refer to the Accelerator
+// which compiled it.
 struct CompiledObject {
   // Callable to execute the computation represented by torch::jit::Graph.
   // It processes tensors across ORT and Pytorch and invokes "sess".
@@ -21,10 +24,7 @@ struct CompiledObject {
 // Custom JIT engine called by Pytorch.
 class Accelerator {
  public:
-  Accelerator(const torch::jit::Node* node)
-      : subgraph_(node->g(torch::jit::attr::Subgraph)),
-        input_types_(subgraph_->inputs().size()),
-        output_types_(subgraph_->outputs().size()) {}
+  Accelerator(const torch::jit::Node* node);
   // Execute a call to the torch::jit::Graph represented by "subgraph_".
   // This function could compile the graph and cache the result
   // for repeated uses.
@@ -47,12 +47,18 @@ class Accelerator {
   void PytorchRun(torch::jit::Stack& stack);
   // Create callable to execute "subgraph_" given "args" as inputs.
   // This calllable is cached for repeated uses.
-  CompiledObject Compile(
-      torch::jit::CompleteArgumentSpec spec, at::ArrayRef<c10::IValue>& args);
+  std::shared_ptr<CompiledObject> Compile(at::ArrayRef<c10::IValue>& args, bool dynamic_shapes);
+  // Return the compiled callable for "args" from the process-wide cache
+  // of compiled graphs, compiling it if no Accelerator did before.
+  std::shared_ptr<CompiledObject> GetOrCompile(at::ArrayRef<c10::IValue>& args);
   // The graph to be compiled and executed by ORT.
   std::shared_ptr<torch::jit::Graph> subgraph_;
-  // Previously compiled results.
-  std::unordered_map<torch::jit::CompleteArgumentSpec, CompiledObject> cache_;
+  // Structural representation of "subgraph_" with canonical value names.
+  // Structurally identical graphs share their compiled sessions.
+  std::string graph_key_;
+  // Previously compiled results for exact input schemas, so repeated
+  // inputs don't need to look up the process-wide cache.
+  std::unordered_map<torch::jit::CompleteArgumentSpec, std::shared_ptr<CompiledObject>> cache_;
   // Types of the inputs (typed to IValue) we got when compile the subgraph.
   // Since the subgraph is compiled for these type, feeding
   // inputs with different types may fail.
@@ -75,5 +75,10 @@ bool DumpOnnxFusion() {
   return IsEnvironmentVariableOne("LORT_DUMP_ONNX_FUSION");
 }
 
+bool UseDynamicShapes() {
+  // Enabled unless explicitly disabled.
+  return std::getenv("LORT_DYNAMIC_SHAPES") == nullptr || IsEnvironmentVariableOne("LORT_DYNAMIC_SHAPES");
+}
+
 }  // namespace lazytensor
 }  // namespace onnxruntime
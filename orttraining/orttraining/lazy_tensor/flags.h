@@ -43,6 +43,11 @@ double AbsoluteTolerance();
 // |value-expected| <= |expected| * relative_tol + absolute_tol
 double RelativeTolerance();
 bool DumpOnnxFusion();
+// If this function returns true, graphs are compiled into sessions
+// with symbolic input dims, which are reused by inputs of all shapes
+// with the same types, devices and ranks. Set LORT_DYNAMIC_SHAPES=0
+// to compile a session for each input shape instead.
+bool UseDynamicShapes();
 
 class DynamicSettings {
  public:
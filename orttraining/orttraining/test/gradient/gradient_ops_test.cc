@@ -2228,6 +2228,20 @@ TEST(GradientUtilsTest, InPlaceAccumulatorV2Overwrite) {
   test.Run();
 }
 
+TEST(GradientUtilsTest, InPlaceAccumulatorV2_BFloat16Buffer_CPU) {
+  OpTester test("InPlaceAccumulatorV2", 1, onnxruntime::kMSDomain);
+
+  // the sums are bfloat16 values, so the stochastic rounding is exact
+  test.AddInput<BFloat16>("old_sum", {3}, {BFloat16(1.f), BFloat16(2.f), BFloat16(3.f)});
+  test.AddInput<float>("value", {3}, {0.5f, 0.25f, -1.f});
+  test.AddOutput<bool>("updated", {1}, {true});
+  test.AddOutput<BFloat16>("new_sum", {3}, {BFloat16(1.5f), BFloat16(2.25f), BFloat16(2.f)});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> providers;
+  providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &providers);
+}
+
 #if defined(USE_CUDA)
 // TODO: Add rocm kernel defs
 TEST(GradientUtilsTest, InPlaceAccumulatorV2_GPU) {
@@ -101,6 +101,56 @@ TEST(MemoryOptimizerTests, GeluRecompute) {
   ASSERT_EQ(recompute_gelu_node->MutableInputDefs()[0]->Name(), original_gelu_node->MutableInputDefs()[0]->Name());
 }
 
+TEST(MemoryOptimizerTests, GeluOffload) {
+  const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
+  auto model_uri = MODEL_FOLDER "recompute_gelu.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger));
+  Graph& graph = model->MainGraph();
+
+  // Only the activations in device memory are offloaded.
+  std::string gelu_output_name;
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCudaExecutionProvider);
+    if (node.OpType().compare("Gelu") == 0) {
+      gelu_output_name = node.OutputDefs()[0]->Name();
+    }
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+
+  const std::string alleviation_config("Gelu+:3:-1");
+  onnxruntime::test::TemporaryDirectory tmp_dir{ORT_TSTR("memory_optimizer_test_tmp_dir")};
+  PathString config_path{ConcatPathComponent(tmp_dir.Path(),
+                                             ORT_TSTR("geluoffload.json"))};
+  const std::string config_path_str = ToUTF8String(config_path);
+  std::ofstream outfile(config_path_str);
+  outfile << "[\"" << alleviation_config << "\"]" << std::endl;
+  outfile.close();
+
+  const std::string probe_config("1:0");
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<MemoryOptimizer>(config_path_str, probe_config), TransformerLevel::Level3));
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["com.microsoft.Gelu"] == 1);
+  ASSERT_TRUE(op_to_count["MemcpyToHost"] == 1);
+  ASSERT_TRUE(op_to_count["MemcpyFromHost"] == 1);
+
+  // The backward consumers read the activation copied back from host memory.
+  bool has_prefetched_consumer = false;
+  for (auto& node : graph.Nodes()) {
+    for (const auto* input_def : node.InputDefs()) {
+      if (input_def->Name() == gelu_output_name + "_prefetch") {
+        has_prefetched_consumer = true;
+      }
+    }
+  }
+  ASSERT_TRUE(has_prefetched_consumer);
+}
+
 TEST(MemoryOptimizerTests, TileRecompute) {
   const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
   auto model_uri = MODEL_FOLDER "recompute_tile.onnx";
@@ -581,4 +581,55 @@ TEST(CheckpointApiTest, SaveOnnxModelAsCheckpoint_ThenLoad_WithExternalData) {
   }
 }
 
+/**
+ * Load a checkpoint with external data, update a parameter in place and save it to the same path,
+ * Then load it again and check the parameters of both checkpoint states.
+ */
+TEST(CheckpointApiTest, LoadCheckpointWithExternalData_ThenSaveToSamePath) {
+  auto model_uri = MODEL_FOLDER "transform/computation_reduction/gathernd/e2e.onnx";
+  auto logger_ptr = std::make_unique<logging::Logger>(logging::LoggingManager::DefaultLogger());
+  std::shared_ptr<Model> p_model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, p_model, nullptr, *logger_ptr));
+
+  std::vector<ONNX_NAMESPACE::TensorProto> trainable_param_values;
+  for (const auto& [initializer_name, tensor_proto] : p_model->MainGraph().GetAllInitializedTensors()) {
+    trainable_param_values.emplace_back(static_cast<ONNX_NAMESPACE::TensorProto>(*tensor_proto));
+  }
+
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+  PathString checkpoint_path{
+      ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("e2e_ckpt_save_cpu"))};
+  ASSERT_STATUS_OK(SaveCheckpoint(trainable_param_values, {}, checkpoint_path,
+                                  false /* nominal checkpoint */, 0 /* external_data_threshold */));
+
+  CheckpointState checkpoint_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, checkpoint_state));
+  ASSERT_TRUE(checkpoint_state.has_external_data);
+
+  const std::string param_name = "cls.predictions.bias";
+  Tensor& param_tensor = *checkpoint_state.module_checkpoint_state.named_parameters.at(param_name)
+                              ->Data()
+                              .GetMutable<Tensor>();
+  ASSERT_TRUE(param_tensor.IsDataType<float>());
+  param_tensor.MutableData<float>()[0] = 42.0f;
+
+  ASSERT_STATUS_OK(SaveCheckpoint(checkpoint_state, checkpoint_path, false /* include_optimizer_state */));
+  ASSERT_TRUE(std::filesystem::exists(ExternalCheckpointDataPath(checkpoint_path)));
+
+  CheckpointState reloaded_checkpoint_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, reloaded_checkpoint_state));
+  const auto& named_parameters = checkpoint_state.module_checkpoint_state.named_parameters;
+  const auto& reloaded_named_parameters = reloaded_checkpoint_state.module_checkpoint_state.named_parameters;
+  ASSERT_EQ(named_parameters.size(), reloaded_named_parameters.size());
+  for (const auto& [name, param] : named_parameters) {
+    const Tensor& tensor = param->Data().Get<Tensor>();
+    const Tensor& reloaded_tensor = reloaded_named_parameters.at(name)->Data().Get<Tensor>();
+    ASSERT_EQ(tensor.SizeInBytes(), reloaded_tensor.SizeInBytes());
+    ASSERT_EQ(std::memcmp(tensor.DataRaw(), reloaded_tensor.DataRaw(), tensor.SizeInBytes()), 0);
+  }
+
+  ASSERT_EQ(reloaded_named_parameters.at(param_name)->Data().Get<Tensor>().Data<float>()[0], 42.0f);
+}
+
 }  // namespace onnxruntime::training::test
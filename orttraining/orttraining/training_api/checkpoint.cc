@@ -3,6 +3,8 @@
 
 #include "orttraining/training_api/checkpoint.h"
 
+#include <filesystem>
+
 #include "core/flatbuffers/checkpoint_version.h"
 #include "core/flatbuffers/schema/ort_training_checkpoint.fbs.h"
 #include "core/framework/framework_common.h"
@@ -129,6 +131,56 @@ Status FlatbufferTensorFromOrtValue(
   return Status::OK();
 }
 
+/**
+ * The checkpoint's external data file mapped into memory. The CPU tensors loaded from it point into the mapping
+ * instead of owning a copy of their data, and keep the mapping alive until the last of them is released.
+ */
+struct MappedExternalData {
+  std::shared_ptr<char[]> data;
+  size_t size = 0;
+};
+
+/**
+ * @brief Create OrtValue object whose tensor data is backed by the mapped external data.
+ *
+ * @param fbs_tensor Flatbuffer tensor with its data at an offset in the external data.
+ * @param mapped_external_data Mapped external data of the checkpoint.
+ * @param tensor_name Name of the tensor.
+ * @param ort_value OrtValue object to be populated.
+ * @return Status of the operation.
+ */
+Status OrtValueFromMappedExternalData(const fbs::Tensor& fbs_tensor, const MappedExternalData& mapped_external_data,
+                                      std::string& tensor_name, OrtValue& ort_value) {
+  auto* fbs_tensor_name = fbs_tensor.name();
+  ORT_RETURN_IF_NOT(fbs_tensor_name, "Flatbuffer tensor is invalid. Expected: A valid tensor name. Actual: nullptr.");
+  tensor_name = fbs_tensor_name->str();
+
+  auto* tensor_dims = fbs_tensor.dims();
+  ORT_RETURN_IF_NOT(tensor_dims, "Flatbuffer tensor is invalid. Expected: Valid tensor dims. Actual: nullptr.");
+
+  const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(static_cast<int32_t>(fbs_tensor.data_type()));
+  ORT_RETURN_IF_NOT(tensor_type, "Flatbuffer tensor ", tensor_name, " has an unsupported data type.");
+  const auto* tensor_dtype = tensor_type->GetElementType();
+  const TensorShape tensor_shape(tensor_dims->data(), tensor_dims->size());
+
+  size_t size_in_bytes = 0;
+  ORT_RETURN_IF_ERROR(Tensor::CalculateTensorStorageSize(tensor_dtype, tensor_shape, 0, size_in_bytes));
+
+  const auto offset = static_cast<uint64_t>(fbs_tensor.external_data_offset());
+  ORT_RETURN_IF(offset > mapped_external_data.size || size_in_bytes > mapped_external_data.size - offset,
+                "External data of tensor ", tensor_name, " is out of the bounds of the external data file. ",
+                "Checkpoint file is invalid.");
+
+  // The mapping is copy-on-write, so updating the tensor doesn't modify the external data file.
+  MappedExternalData mapping = mapped_external_data;
+  auto ort_tensor = std::make_unique<Tensor>(tensor_dtype, tensor_shape, mapping.data.get() + offset,
+                                             OrtMemoryInfo{onnxruntime::CPU, OrtDeviceAllocator});
+  ort_value.Init(ort_tensor.release(), DataTypeImpl::GetType<onnxruntime::Tensor>(),
+                 [mapping = std::move(mapping)](void* tensor) { delete static_cast<Tensor*>(tensor); });
+
+  return Status::OK();
+}
+
 /**
  * @brief Create OrtValue object from flatbuffer tensor
  *
@@ -136,11 +188,17 @@ Status FlatbufferTensorFromOrtValue(
  * @param tensor_name Name of the tensor.
  * @param ort_value OrtValue object to be populated.
  * @param external_data_reader delegate to read initializer data from an external file or buffer
+ * @param mapped_external_data Optional mapped external data that backs the tensors with external data.
  * @return Status of the operation.
  */
 Status OrtValueFromFlatbufferTensor(const fbs::Tensor& fbs_tensor,
                                     std::string& tensor_name, OrtValue& ort_value,
-                                    const fbs::utils::ExternalDataReader& external_data_reader) {
+                                    const fbs::utils::ExternalDataReader& external_data_reader,
+                                    const MappedExternalData* mapped_external_data) {
+  if (mapped_external_data && fbs_tensor.external_data_offset() >= 0) {
+    return OrtValueFromMappedExternalData(fbs_tensor, *mapped_external_data, tensor_name, ort_value);
+  }
+
   // The assumption is that the flatbuffer buffer will be destructed once the checkpoint has been loaded.
   // And so, we must allocate a buffer where the tensor data can be copied using the cpu allocator.
   // This buffer is owned by the OrtValue.
@@ -196,17 +254,20 @@ Status FlatbufferTensorsFromOrtValues(
  * @param flatbuffer_tensors Flatbuffer tensors.
  * @param name_to_ort_value Name to OrtValue map to be populated.
  * @param external_data_reader delegate to read initializer data from an external file or buffer
+ * @param mapped_external_data Optional mapped external data that backs the tensors with external data.
  * @return Status of the operation.
  */
 Status OrtValuesFromFlatbufferTensors(
     const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::Tensor>>& flatbuffer_tensors,
-    InlinedHashMap<std::string, OrtValue>& name_to_ort_value, const fbs::utils::ExternalDataReader& external_data_reader) {
+    InlinedHashMap<std::string, OrtValue>& name_to_ort_value, const fbs::utils::ExternalDataReader& external_data_reader,
+    const MappedExternalData* mapped_external_data = nullptr) {
   for (const auto* fbs_tensor : flatbuffer_tensors) {
     ORT_RETURN_IF_NOT(fbs_tensor, "Encountered a nullptr flatbuffer tensor. Checkpoint file is invalid.");
 
     std::string tensor_name;
     OrtValue ort_value;
-    ORT_RETURN_IF_ERROR(OrtValueFromFlatbufferTensor(*fbs_tensor, tensor_name, ort_value, external_data_reader));
+    ORT_RETURN_IF_ERROR(OrtValueFromFlatbufferTensor(*fbs_tensor, tensor_name, ort_value, external_data_reader,
+                                                     mapped_external_data));
     name_to_ort_value.emplace(std::move(tensor_name), std::move(ort_value));
   }
 
@@ -438,11 +499,13 @@ Status FromModuleState(const ModuleCheckpointState& module_state,
  *                        and second order momentums ...).
  * @param builder Flatbuffer builder.
  * @param fbs_optimizer_groups Flatbuffer optimizer groups to be populated.
+ * @param external_data_writer Optional delegate to write tensor data to an external file.
  * @return Status of the operation.
  */
 Status FromOptimizerState(const OptimizerCheckpointState& optimizer_state,
                           flatbuffers::FlatBufferBuilder& builder,
-                          std::vector<flatbuffers::Offset<fbs::OptimizerGroup>>& fbs_optimizer_groups) {
+                          std::vector<flatbuffers::Offset<fbs::OptimizerGroup>>& fbs_optimizer_groups,
+                          fbs::utils::ExternalDataWriter external_data_writer = nullptr) {
   if (optimizer_state.group_named_optimizer_states.empty()) {
     return Status::OK();
   }
@@ -462,7 +525,7 @@ Status FromOptimizerState(const OptimizerCheckpointState& optimizer_state,
       ORT_RETURN_IF_ERROR(FlatbufferTensorsFromOrtValues(
           param_optimizer_state,
           optimizer_state.optimizer_session_data_transfer_mgr,
-          builder, momentums));
+          builder, momentums, external_data_writer));
 
       const auto fbs_param_name = builder.CreateString(param_name);
       const auto fbs_momentums = builder.CreateVector(momentums);
@@ -546,9 +609,46 @@ Status FromPropertyBag(const PropertyBag& property_bag, flatbuffers::FlatBufferB
   return Status::OK();
 }
 
+/**
+ * @brief Get the size in bytes of the tensor data of a checkpoint state.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param include_optimizer_state Whether to include the size of the optimizer state.
+ * @return Size of the tensor data in bytes.
+ */
+size_t TensorDataSizeInBytes(const CheckpointState& state, const bool include_optimizer_state) {
+  size_t size_in_bytes = 0;
+  const auto add_size = [&size_in_bytes](const OrtValue& ort_value) {
+    if (ort_value.IsTensor()) {
+      size_in_bytes += ort_value.Get<Tensor>().SizeInBytes();
+    }
+  };
+
+  for (const auto& [name, param] : state.module_checkpoint_state.named_parameters) {
+    add_size(param->Data());
+  }
+
+  if (include_optimizer_state) {
+    for (const auto& [group_name, group_state] : state.optimizer_checkpoint_state.group_named_optimizer_states) {
+      for (const auto& [param_name, param_states] : group_state->param_named_optimizer_states) {
+        for (const auto& [state_name, ort_value] : param_states) {
+          add_size(ort_value);
+        }
+      }
+    }
+  }
+
+  return size_in_bytes;
+}
+
 /**
  * @brief Save from a checkpoint state to a checkpoint file.
  *
+ * The tensor data is written to the external data file one tensor at a time if the checkpoint state was loaded with
+ * external data, or if it is too large for the 32-bit offsets of the flatbuffer. The external data file is written
+ * to a temporary file first and then moved in place, so a checkpoint loaded from the same path (whose parameters may
+ * still be mapped from the previous external data file) is not overwritten while it is in use.
+ *
  * @param state parameter/optimizer and other user defined training states.
  * @param checkpoint_path file where checkpoint is saved.
  * @param include_optimizer_state Whether to include optimizer state in the checkpoint.
@@ -558,14 +658,21 @@ Status FromCheckpointState(
     const CheckpointState& state, const PathString& checkpoint_path, const bool include_optimizer_state) {
   flatbuffers::FlatBufferBuilder builder(1024);
 
+  // The loader only reads external data if the module state has external data, so there must be parameters.
+  const bool use_external_data =
+      !state.module_checkpoint_state.named_parameters.empty() &&
+      (state.has_external_data ||
+       TensorDataSizeInBytes(state, include_optimizer_state) >= kCheckpointExternalDataThreshold);
+
   fbs::utils::ExternalDataWriter external_data_writer = nullptr;
   std::optional<std::ofstream> external_data_stream;
-  if (state.has_external_data) {
-    auto data_path = ExternalCheckpointDataPath(checkpoint_path);
-    external_data_stream = std::ofstream(data_path, std::ios::binary);
+  const auto data_path = ExternalCheckpointDataPath(checkpoint_path);
+  const PathString temp_data_path = data_path + ORT_TSTR(".tmp");
+  if (use_external_data) {
+    external_data_stream = std::ofstream(temp_data_path, std::ios::binary);
 
     ORT_RETURN_IF(external_data_stream->fail(), "Failed to create checkpoint's external data file: ",
-                  ToUTF8String(data_path));
+                  ToUTF8String(temp_data_path));
 
     // setup the data writer to write aligned data to external_data_stream
     external_data_writer = [&external_data_stream](int32_t data_type, gsl::span<const uint8_t> bytes,
@@ -581,7 +688,18 @@ Status FromCheckpointState(
   // Write optimizer state tensors files.
   std::vector<flatbuffers::Offset<fbs::OptimizerGroup>> optimizer_groups;
   if (include_optimizer_state) {
-    ORT_RETURN_IF_ERROR(FromOptimizerState(state.optimizer_checkpoint_state, builder, optimizer_groups));
+    ORT_RETURN_IF_ERROR(FromOptimizerState(state.optimizer_checkpoint_state, builder, optimizer_groups,
+                                           external_data_writer));
+  }
+
+  if (external_data_stream) {
+    external_data_stream->close();
+    ORT_RETURN_IF(external_data_stream->fail(), "Failed writing external checkpoint data.");
+
+    std::error_code error_code;
+    std::filesystem::rename(temp_data_path, data_path, error_code);
+    ORT_RETURN_IF(error_code, "Failed to move the checkpoint's external data file to ", ToUTF8String(data_path),
+                  ". ", error_code.message());
   }
 
   flatbuffers::Offset<fbs::PropertyBag> property_bag;
@@ -632,18 +750,20 @@ Status FromFile(const PathString& checkpoint_path, InlinedVector<uint8_t>& check
  * @param fbs_module_state Flatbuffer module state.
  * @param module_state Module state to be populated.
  * @param external_data_reader delegate to read initializer data from an external file or buffer
+ * @param mapped_external_data Optional mapped external data that backs the tensors with external data.
  * @return Status of the operation.
  */
 Status ToModuleState(
     const onnxruntime::fbs::ModuleState& fbs_module_state, ModuleCheckpointState& module_state,
-    const fbs::utils::ExternalDataReader& external_data_reader) {
+    const fbs::utils::ExternalDataReader& external_data_reader, const MappedExternalData* mapped_external_data) {
   const auto* requires_grad_params = fbs_module_state.requires_grad_params();
   ORT_RETURN_IF_NOT(requires_grad_params, "Expected: Valid trainable tensors flatbuffer.",
                     " Actual: Encountered a nullptr. Checkpoint file is invalid");
   flatbuffers::uoffset_t trainable_params_size = requires_grad_params->size();
   InlinedHashMap<std::string, OrtValue> trainable_params;
   trainable_params.reserve(trainable_params_size);
-  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*requires_grad_params, trainable_params, external_data_reader));
+  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*requires_grad_params, trainable_params, external_data_reader,
+                                                     mapped_external_data));
 
   for (auto& [name, value] : trainable_params) {
     auto param = std::make_shared<Parameter>(name, value, true);
@@ -656,7 +776,8 @@ Status ToModuleState(
   flatbuffers::uoffset_t non_trainable_params_size = frozen_params->size();
   InlinedHashMap<std::string, OrtValue> non_trainable_params;
   non_trainable_params.reserve(non_trainable_params_size);
-  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*frozen_params, non_trainable_params, external_data_reader));
+  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*frozen_params, non_trainable_params, external_data_reader,
+                                                     mapped_external_data));
 
   for (auto& [name, value] : non_trainable_params) {
     auto param = std::make_shared<Parameter>(name, value, false);
@@ -674,11 +795,13 @@ Status ToModuleState(
  * @param optimizer_groups Flatbuffer optimizer groups.
  * @param optimizer_state Optimizer state to be populated.
  * @param external_data_reader delegate to read initializer data from an external file or buffer
+ * @param mapped_external_data Optional mapped external data that backs the tensors with external data.
  * @return Status of the operation.
  */
 Status ToOptimizerState(
     const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::OptimizerGroup>>& optimizer_groups,
-    OptimizerCheckpointState& optimizer_state, const fbs::utils::ExternalDataReader& external_data_reader) {
+    OptimizerCheckpointState& optimizer_state, const fbs::utils::ExternalDataReader& external_data_reader,
+    const MappedExternalData* mapped_external_data) {
   for (const auto* optimizer_group : optimizer_groups) {
     ORT_RETURN_IF_NOT(optimizer_group, "Expected: Valid optimizer groups flatbuffer.",
                       " Actual: Encountered a nullptr. Checkpoint file is invalid");
@@ -706,7 +829,8 @@ Status ToOptimizerState(
       ORT_RETURN_IF_NOT(momentums, "Expected: Valid optimizer momentum tensors flatbuffer.",
                         " Actual: Encountered a nullptr. Checkpoint file is invalid");
       ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(
-          *momentums, optimizer_state_it->second->param_named_optimizer_states[param_name], external_data_reader));
+          *momentums, optimizer_state_it->second->param_named_optimizer_states[param_name], external_data_reader,
+          mapped_external_data));
     }
   }
 
@@ -877,6 +1001,7 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
   std::optional<std::ifstream> external_data_stream;
+  std::optional<MappedExternalData> mapped_external_data;
 
   state.has_external_data = false;
   if (nullptr != fbs_module_state && fbs_module_state->has_external_data()) {
@@ -896,15 +1021,31 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
     external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
       return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
     };
+
+#if !defined(_WIN32)
+    // Back the tensors with a copy-on-write mapping of the external data instead of reading it into memory, so
+    // loading a large checkpoint doesn't need the memory for all of its tensors up front. A file mapped on Windows
+    // can't be replaced, which a save to the same checkpoint path needs, so the data is read there.
+    size_t data_size = 0;
+    ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(data_path.c_str(), data_size));
+    if (data_size > 0) {
+      Env::MappedMemoryPtr mapped_data;
+      ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(data_path.c_str(), 0, data_size, mapped_data));
+      mapped_external_data = MappedExternalData{std::shared_ptr<char[]>(std::move(mapped_data)), data_size};
+    }
+#endif
   }
 
+  const MappedExternalData* mapped_data_ptr = mapped_external_data ? &*mapped_external_data : nullptr;
   if (nullptr != fbs_module_state) {
-    ORT_RETURN_IF_ERROR(ToModuleState(*fbs_module_state, state.module_checkpoint_state, external_data_reader));
+    ORT_RETURN_IF_ERROR(ToModuleState(*fbs_module_state, state.module_checkpoint_state, external_data_reader,
+                                      mapped_data_ptr));
   }
 
   const auto* fbs_optimizer_groups = fbs_checkpoint->optimizer_groups();
   if (nullptr != fbs_optimizer_groups) {
-    ORT_RETURN_IF_ERROR(ToOptimizerState(*fbs_optimizer_groups, state.optimizer_checkpoint_state, external_data_reader));
+    ORT_RETURN_IF_ERROR(ToOptimizerState(*fbs_optimizer_groups, state.optimizer_checkpoint_state, external_data_reader,
+                                         mapped_data_ptr));
   }
 
   const auto* fbs_property_bag = fbs_checkpoint->property_bag();
@@ -21,10 +21,18 @@
  * The checkpoint file is a single flatbuffer file containing all the states highlighted above.
  * The flatbuffer schema is defined in onnxruntime/core/flatbuffers/schema/ort_training_checkpoint.fbs
  *
+ * The tensor data of large checkpoints is stored in an external data file next to the checkpoint file (see
+ * ExternalCheckpointDataPath), which is written one tensor at a time and, where supported, mapped into memory
+ * when the checkpoint is loaded.
+ *
  */
 
 namespace onnxruntime::training::api {
 
+// Threshold in bytes of the tensor data of a checkpoint over which the data is saved in an external data file.
+// It leaves room for the tensor names and shapes in a checkpoint file that must be <2GB due to the 32-bit offsets.
+constexpr size_t kCheckpointExternalDataThreshold = 1800 * 1024 * 1024;  // 1.8GB
+
 struct CheckpointState {
  public:
   ModuleCheckpointState module_checkpoint_state;
@@ -45,6 +53,8 @@ PathString ExternalCheckpointDataPath(const PathString& checkpoint_path);
  *
  * @param state parameter/optimizer and other user defined training states.
  * @param checkpoint_path file where checkpoint is saved.
+ * @remarks The parameters and optimizer states are saved in an external data file if the state was loaded with
+ *          external data or if their size is kCheckpointExternalDataThreshold or more.
  * @return Status
  */
 Status SaveCheckpoint(const CheckpointState& state, const PathString& checkpoint_path,
@@ -69,7 +79,7 @@ Status SaveCheckpoint(const CheckpointState& state, const PathString& checkpoint
 Status SaveCheckpoint(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_tensor_protos,
                       gsl::span<const ONNX_NAMESPACE::TensorProto> non_trainable_tensor_protos,
                       const PathString& checkpoint_path, const bool nominal_checkpoint,
-                      const size_t external_data_threshold = 1800 * 1024 * 1024);  // 1.8GB default
+                      const size_t external_data_threshold = kCheckpointExternalDataThreshold);
 #endif
 
 /**
@@ -77,6 +87,8 @@ Status SaveCheckpoint(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_ten
  *
  * @param checkpoint_path file where checkpoint is stored.
  * @param checkpoint_states parameter/optimizer and other user defined training states.
+ * @remarks On platforms other than Windows, the tensors with external data are backed by a copy-on-write mapping of
+ *          the external data file instead of being read into memory.
  * @return Status
  */
 Status LoadCheckpoint(const PathString& checkpoint_path,
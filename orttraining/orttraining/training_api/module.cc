@@ -180,8 +180,18 @@ Status LoadParameter(const std::string& param_name, const Tensor& src_weight_ten
     const size_t grad_input_index = grad_it->second;
     auto& param_grad_name = grad_names[grad_input_index];
 
+    // The accumulation buffer has the element type of the graph input, which is bfloat16 instead of the parameter's
+    // type if the gradients are accumulated in bfloat16.
+    MLDataType grad_element_type = nullptr;
+    if (const auto* grad_arg = session_state.GetGraphViewer().GetNodeArg(param_grad_name);
+        grad_arg != nullptr && grad_arg->TypeAsProto() != nullptr && grad_arg->TypeAsProto()->has_tensor_type()) {
+      grad_element_type = DataTypeImpl::TensorTypeFromONNXEnum(grad_arg->TypeAsProto()->tensor_type().elem_type())
+                              ->GetElementType();
+    }
+
     OrtValue param_grad;
-    ORT_THROW_IF_ERROR(utils::CreateZeroValuedOrtValueLike(session_state, param.Data(), param_grad));
+    ORT_THROW_IF_ERROR(utils::CreateZeroValuedOrtValueLike(session_state, param.Data(), param_grad,
+                                                           grad_element_type));
     ORT_THROW_IF_ERROR(param.SetGrad(param_grad_name, param_grad));
   }
 
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "orttraining/training_ops/cpu/optimizer/adamw/adamw.h"
+
+#include <algorithm>
+#include <utility>
+
 #include "orttraining/training_ops/cpu/optimizer/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
@@ -9,10 +13,18 @@
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+
+// Number of elements of a weight updated by one iteration of the parallel loop.
+constexpr std::ptrdiff_t kChunkSize = 16 * 1024;
+
+}  // namespace
+
 Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimizerBase::Prepare& prepare) const {
   prepare.learning_rate = ctx->Input<Tensor>(0);
   prepare.step = ctx->Input<Tensor>(1);
@@ -90,46 +102,48 @@ ONNX_OPERATOR_KERNEL_EX(
     AdamWOptimizer<float>);
 
 template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float alpha_correction, float beta_correction) const {
+void AdamWOptimizer<T>::AdamWComputeMode0(T* weight_ptr, const T* gradient_ptr, T* momentums_1_ptr,
+                                          T* momentums_2_ptr, std::ptrdiff_t count,
+                                          float lr, float alpha_correction, float beta_correction) const {
+  EigenVectorArrayMap<T> weight(weight_ptr, count);
+  ConstEigenVectorArrayMap<T> gradient(gradient_ptr, count);
+  EigenVectorArrayMap<T> momentums_1(momentums_1_ptr, count);
+  EigenVectorArrayMap<T> momentums_2(momentums_2_ptr, count);
+
   // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (MakeEigenArrayMap<T>(weight) * lr * weight_decay_);
+  weight = weight - (weight * lr * weight_decay_);
 
   // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
+  momentums_1 = alpha_ * momentums_1 + (1.f - alpha_) * gradient;
 
   // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
+  momentums_2 = beta_ * momentums_2 + (1.f - beta_) * gradient * gradient;
 
   // Compute the new weight.
-  auto denom = (MakeEigenArrayMap<T>(momentums_2) / beta_correction).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr * MakeEigenArrayMap<T>(momentums_1)) / (alpha_correction * denom);
-
-  return Status::OK();
+  auto denom = (momentums_2 / beta_correction).sqrt() + epsilon_;
+  weight = weight - (lr * momentums_1) / (alpha_correction * denom);
 }
 
 template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float lr_corrected) const {
+void AdamWOptimizer<T>::AdamWComputeMode1(T* weight_ptr, const T* gradient_ptr, T* momentums_1_ptr,
+                                          T* momentums_2_ptr, std::ptrdiff_t count,
+                                          float lr, float lr_corrected) const {
+  EigenVectorArrayMap<T> weight(weight_ptr, count);
+  ConstEigenVectorArrayMap<T> gradient(gradient_ptr, count);
+  EigenVectorArrayMap<T> momentums_1(momentums_1_ptr, count);
+  EigenVectorArrayMap<T> momentums_2(momentums_2_ptr, count);
+
   // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
+  momentums_1 = alpha_ * momentums_1 + (1.f - alpha_) * gradient;
 
   // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
+  momentums_2 = beta_ * momentums_2 + (1.f - beta_) * gradient * gradient;
 
-  auto denom = MakeEigenArrayMap<T>(momentums_2).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr_corrected * MakeEigenArrayMap<T>(momentums_1) / denom);
+  auto denom = momentums_2.sqrt() + epsilon_;
+  weight = weight - (lr_corrected * momentums_1 / denom);
 
   // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (lr * weight_decay_ * MakeEigenArrayMap<T>(weight));
-
-  return Status::OK();
+  weight = weight - (lr * weight_decay_ * weight);
 }
 
 template <typename T>
@@ -165,23 +179,42 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
     //         bias correction is applied on learning rate, then use lr_corrected for subsequent computations.
     //         weight decay is applied after weight is updated.
 
+    // All the weights are updated in one parallel loop over fixed size chunks, like the multi-tensor apply of the
+    // CUDA kernel, so many small weights (e.g. LoRA adapters) are not updated one after the other.
+    // Each element is updated independently, so the result doesn't depend on the chunking.
+    InlinedVector<std::pair<size_t, std::ptrdiff_t>> chunks;  // (weight index, offset of the chunk in the weight)
     for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-      Tensor& momentums_1 = const_cast<Tensor&>(p.momentums_1->Get(weight_index));
-      Tensor& momentums_2 = const_cast<Tensor&>(p.momentums_2->Get(weight_index));
-
-      if (adam_mode_ == 0) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, lr, alpha_correction, beta_correction));
-      } else if (adam_mode_ == 1) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, lr, lr_corrected));
-      } else {
-        ORT_THROW("Unsupported Adamw optimizer mode.");
+      const std::ptrdiff_t size = p.grouped_tensor_sizes[weight_index];
+      for (std::ptrdiff_t offset = 0; offset < size; offset += kChunkSize) {
+        chunks.emplace_back(weight_index, offset);
       }
     }
 
+    // Per element, the weight, gradient and momentums are loaded, the weight and momentums are stored.
+    const TensorOpCost chunk_cost{static_cast<double>(4 * sizeof(T) * kChunkSize),
+                                  static_cast<double>(3 * sizeof(T) * kChunkSize),
+                                  static_cast<double>(16 * kChunkSize)};
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(chunks.size()), chunk_cost,
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t chunk_index = begin; chunk_index != end; ++chunk_index) {
+            const auto [weight_index, offset] = chunks[chunk_index];
+            const auto& pointers = p.grouped_tensor_pointers[weight_index];
+            const std::ptrdiff_t count =
+                std::min<std::ptrdiff_t>(kChunkSize, p.grouped_tensor_sizes[weight_index] - offset);
+            T* weight = static_cast<T*>(pointers[0]) + offset;
+            const T* gradient = static_cast<const T*>(pointers[1]) + offset;
+            T* momentums_1 = static_cast<T*>(pointers[2]) + offset;
+            T* momentums_2 = static_cast<T*>(pointers[3]) + offset;
+            if (adam_mode_ == 0) {
+              AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, count,
+                                lr, alpha_correction, beta_correction);
+            } else {
+              AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, count, lr, lr_corrected);
+            }
+          }
+        });
+
     *updated_flag_ptr = true;
   } else {
     *updated_flag_ptr = false;
@@ -3,7 +3,11 @@
 
 #include "gradient_control.h"
 
+#include <cmath>
+#include <random>
+
 #include "core/framework/op_kernel.h"
+#include "core/framework/random_generator.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 
@@ -86,19 +90,60 @@ ONNX_OPERATOR_KERNEL_EX(
     kCpuExecutionProvider,
     KernelDefBuilder()
         .Alias(0, 1)  // accumulate tensors in-place
-        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+        .TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<BFloat16>()})
+        .TypeConstraint("T_GRAD", DataTypeImpl::GetTensorType<float>()),
     InPlaceAccumulatorV2<float>);
 
+namespace {
+
+// Round to one of the two nearest bfloat16 values with a probability proportional to how close the value is to it.
+// Unlike round to nearest, the rounding errors of repeated accumulations cancel out in expectation, so gradients
+// that are small relative to the accumulated sum are not lost.
+BFloat16 StochasticRoundToBFloat16(float value, uint32_t random_bits) {
+  if (std::isnan(value)) {
+    return BFloat16(value);
+  }
+
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  bits += random_bits & 0xFFFFu;
+  return BFloat16(static_cast<uint16_t>(bits >> 16), BFloat16::FromBits());
+}
+
+// Accumulate the fp32 gradient into the bfloat16 accumulation buffer, rounding the fp32 sum stochastically.
+Status AccumulateBFloat16(Tensor& accumulation_buffer, const Tensor& new_value, bool overwrite) {
+  ORT_RETURN_IF_NOT(new_value.IsDataType<float>(),
+                    "A bfloat16 accumulation buffer can only accumulate float gradients.");
+  ORT_RETURN_IF_NOT(accumulation_buffer.Shape() == new_value.Shape(),
+                    "Broadcasting into a bfloat16 accumulation buffer is not supported. Buffer shape: ",
+                    accumulation_buffer.Shape(), ", gradient shape: ", new_value.Shape());
+
+  auto buffer = accumulation_buffer.MutableDataAsSpan<BFloat16>();
+  const auto gradient = new_value.DataAsSpan<float>();
+
+  std::mt19937 rng(gsl::narrow_cast<std::mt19937::result_type>(RandomGenerator::Default().NextSeed()));
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    const float sum = overwrite ? gradient[i] : buffer[i].ToFloat() + gradient[i];
+    buffer[i] = StochasticRoundToBFloat16(sum, rng());
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
 template <typename T>
 Status InPlaceAccumulatorV2<T>::Compute(OpKernelContext* context) const {
   Tensor* accumulation_buffer = const_cast<Tensor*>(context->Input<Tensor>(0));
   const Tensor* new_value = context->Input<Tensor>(1);
   const Tensor* overwrite_tensor = context->Input<Tensor>(2);
 
-  void* accumulation_buffer_data = accumulation_buffer->template MutableData<T>();
+  void* accumulation_buffer_data = accumulation_buffer->MutableDataRaw();
   const bool overwrite = overwrite_tensor != nullptr ? *(overwrite_tensor->template Data<bool>()) : false;
 
-  if (overwrite) {
+  if (accumulation_buffer->IsDataType<BFloat16>()) {
+    ORT_RETURN_IF_ERROR(AccumulateBFloat16(*accumulation_buffer, *new_value, overwrite));
+  } else if (overwrite) {
     const void* updated_data = new_value->template Data<T>();
     memcpy(accumulation_buffer_data, updated_data, new_value->SizeInBytes());
   } else {
@@ -119,9 +164,9 @@ Status InPlaceAccumulatorV2<T>::Compute(OpKernelContext* context) const {
 
   Tensor* accumulated_value_out = context->Output(1, new_value->Shape());
   if (nullptr != accumulated_value_out) {
-    void* output_data = accumulated_value_out->template MutableData<T>();
+    void* output_data = accumulated_value_out->MutableDataRaw();
     if (output_data != accumulation_buffer_data) {
-      memcpy(output_data, accumulation_buffer_data, new_value->SizeInBytes());
+      memcpy(output_data, accumulation_buffer_data, accumulation_buffer->SizeInBytes());
     }
   }
 
@@ -194,6 +194,49 @@ ComPtr<ID3D12Resource> VideoFrameToTensorConverter::ShareD3D11Texture(
   return d3d12Resource;
 }
 
+bool VideoFrameToTensorConverter::CanTensorizeTextureDirectly(
+  const D3D11_TEXTURE2D_DESC& texture_desc, const wgi::BitmapBounds& bounds
+) {
+  // The tensorization shader reads the whole top mip of a single texture, and textures behind a keyed mutex would
+  // need to be acquired first
+  return bounds.X == 0 && bounds.Y == 0 && bounds.Width == texture_desc.Width && bounds.Height == texture_desc.Height &&
+    texture_desc.MipLevels == 1 && texture_desc.ArraySize == 1 && texture_desc.SampleDesc.Count == 1 &&
+    (texture_desc.MiscFlags & D3D11_RESOURCE_MISC_SHARED_NTHANDLE) != 0 &&
+    (texture_desc.MiscFlags & D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX) == 0;
+}
+
+ComPtr<ID3D12Resource> VideoFrameToTensorConverter::GetD3D12ResourceOfTexture(
+  ID3D11Texture2D* pTexture, ID3D12Device* pDevice
+) {
+  assert(pTexture != nullptr);
+  assert(pDevice != nullptr);
+
+  // The D3D12 resource is cached on the texture, so a frame that is bound on every evaluation is opened only once
+  ComPtr<ID3D12Resource> d3d12Resource;
+  UINT comPtrSize = static_cast<UINT>(sizeof(d3d12Resource.GetAddressOf()));
+  if (SUCCEEDED(pTexture->GetPrivateData(d3d12_resource_GUID_, &comPtrSize, d3d12Resource.GetAddressOf())) &&
+      d3d12Resource) {
+    ComPtr<ID3D12Device> spResourceDevice;
+    WINML_THROW_IF_FAILED(d3d12Resource->GetDevice(IID_PPV_ARGS(&spResourceDevice)));
+    if (spResourceDevice.Get() == pDevice) {
+      return d3d12Resource;
+    }
+    d3d12Resource.Reset();
+  }
+
+  ComPtr<IDXGIResource1> spDxgiResource;
+  WINML_THROW_IF_FAILED(pTexture->QueryInterface(IID_PPV_ARGS(&spDxgiResource)));
+
+  HANDLE hSharedTexture;
+  WINML_THROW_IF_FAILED(spDxgiResource->CreateSharedHandle(nullptr, GENERIC_ALL, nullptr, &hSharedTexture));
+
+  wil::unique_handle safeHandle(hSharedTexture);
+  WINML_THROW_IF_FAILED(pDevice->OpenSharedHandle(safeHandle.get(), IID_PPV_ARGS(&d3d12Resource)));
+  WINML_THROW_IF_FAILED(pTexture->SetPrivateDataInterface(d3d12_resource_GUID_, d3d12Resource.Get()));
+
+  return d3d12Resource;
+}
+
 void VideoFrameToTensorConverter::VideoFrameToDX12Tensor(
   _In_ const UINT32 batchIdx,
   _In_ winml::LearningModelSession& session,
@@ -262,7 +305,12 @@ void VideoFrameToTensorConverter::VideoFrameToDX12Tensor(
     D3D11_TEXTURE2D_DESC videoFrameTextureDesc;
     spVideoFrameTexture->GetDesc(&videoFrameTextureDesc);
 
-    if (_winmli::TextureIsOnDevice(spVideoFrameTexture.Get(), pDeviceCache->GetD3D11Device())) {
+    ComPtr<ID3D12Resource> spDirectD3D12Resource;
+    if (_winmli::TextureIsOnDevice(spVideoFrameTexture.Get(), pDeviceCache->GetD3D11Device()) &&
+        CanTensorizeTextureDirectly(videoFrameTextureDesc, scaledBounds)) {
+      // The texture is on our device and already shareable, so tensorize it in place instead of copying it first
+      spDirectD3D12Resource = GetD3D12ResourceOfTexture(spVideoFrameTexture.Get(), pDeviceCache->GetD3D12Device());
+    } else if (_winmli::TextureIsOnDevice(spVideoFrameTexture.Get(), pDeviceCache->GetD3D11Device())) {
       // The texture is on our device, so we can just create own texture, share it and cache it
       if (!D3D11_cached_texture_) {
         WINML_THROW_IF_FAILED(
@@ -317,12 +365,18 @@ void VideoFrameToTensorConverter::VideoFrameToDX12Tensor(
       CopyTextureIntoTexture(spVideoFrameTexture.Get(), scaledBounds, spSharedD3D11Texture.Get());
     }
 
-    // Sync to make sure that the D3D11 texture is done copying
+    // Sync to make sure that the D3D11 texture is done copying, or done being written when it is tensorized in place
     SyncD3D11ToD3D12(*pDeviceCache, spVideoFrameTexture.Get());
 
     // We cropped the texture, shared it and converted it to a known color format, so it's time to tensorize
     // TODO: merge all videoframes to a single DX12Texture Resource before call ConvertDX12TextureToGPUTensor.
-    ConvertDX12TextureToGPUTensor(batchIdx, input_D3D12_resource_.Get(), *pDeviceCache, tensorDesc, pOutputTensor);
+    ConvertDX12TextureToGPUTensor(
+      batchIdx,
+      spDirectD3D12Resource ? spDirectD3D12Resource.Get() : input_D3D12_resource_.Get(),
+      *pDeviceCache,
+      tensorDesc,
+      pOutputTensor
+    );
   } else {
     // Invalid video frame
     WINML_THROW_IF_FAILED(E_INVALIDARG);
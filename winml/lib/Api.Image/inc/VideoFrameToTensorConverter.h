@@ -56,12 +56,22 @@ class VideoFrameToTensorConverter : public ImageConverter {
     0xce43264e, 0x41f7, 0x4882, {0x9e, 0x20, 0xfa, 0xa5, 0x1e, 0x37, 0x64, 0xfc}
   };
   ;  // CE43264E-41F7-4882-9E20-FAA51E3764FC
+  GUID d3d12_resource_GUID_ = {
+    0x7c1f6a2d, 0x5b3e, 0x4c8a, {0x9d, 0x41, 0x2e, 0x6b, 0x83, 0xf0, 0x1a, 0x57}
+  };  // {7C1F6A2D-5B3E-4C8A-9D41-2E6B83F01A57}
   Microsoft::WRL::ComPtr<ID3D12Resource> upload_heap_;
   Microsoft::WRL::ComPtr<ID3D12Resource> input_D3D12_resource_;
   HANDLE shared_handle_;
 
   Microsoft::WRL::ComPtr<ID3D12Resource> ShareD3D11Texture(ID3D11Texture2D* pTexture, ID3D12Device* pDevice);
 
+  // Whether a texture of the device can be tensorized without copying it into a texture of our own first, which is
+  // when the bounds cover the whole texture and it can be opened in D3D12
+  static bool CanTensorizeTextureDirectly(const D3D11_TEXTURE2D_DESC& texture_desc, const wgi::BitmapBounds& bounds);
+
+  // The texture opened as a D3D12 resource of the device, cached on the texture
+  Microsoft::WRL::ComPtr<ID3D12Resource> GetD3D12ResourceOfTexture(ID3D11Texture2D* pTexture, ID3D12Device* pDevice);
+
   void ConvertSoftwareBitmapToGPUTensor(
     _In_ const UINT32 batch_index,
     _In_ const wm::IVideoFrame& videoFrame,